@@ -54,3 +54,418 @@ uint32_t ant_channel_init(ant_channel_config_t const * p_config)
     
     return err_code;
 }
+
+#if ANT_CONFIG_CHANNEL_SCHED_ENABLED
+
+#if ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED == 0
+    #error The channel scheduler requires ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED to be at least 1.
+#endif
+
+/**@brief States of a scheduled channel. */
+typedef enum
+{
+    SCHED_CHANNEL_UNUSED,           ///< The channel is not scheduled.
+    SCHED_CHANNEL_PENDING,          ///< The channel is to be opened at the next event of the reference channel of its group.
+    SCHED_CHANNEL_OPEN,             ///< The channel is open.
+    SCHED_CHANNEL_MOVING,           ///< The channel is closing, to be opened again in the largest gap of its group.
+    SCHED_CHANNEL_CLOSING,          ///< The channel is closing.
+} sched_channel_state_t;
+
+/**@brief Scheduled channel. */
+typedef struct
+{
+    uint16_t period;                ///< Channel period, shared by the group.
+    uint16_t phase;                 ///< Time of the channel events after the events of the reference channel, in 32 kHz counts.
+    uint8_t  state;                 ///< Channel state, see @ref sched_channel_state_t.
+    bool     is_reference;          ///< The channel is the reference of its group.
+} sched_channel_t;
+
+static sched_channel_t m_sched_channels[ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED]; ///< Scheduled channels, indexed by channel number.
+
+
+/**@brief Function for finding the reference channel of a group.
+ *
+ * @return Channel number of the reference channel, or ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED if the
+ *         group has no reference channel.
+ */
+static uint8_t sched_reference_find(uint16_t period)
+{
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        if ((m_sched_channels[i].state != SCHED_CHANNEL_UNUSED) &&
+            (m_sched_channels[i].period == period) &&
+            m_sched_channels[i].is_reference)
+        {
+            return i;
+        }
+    }
+
+    return ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED;
+}
+
+
+/**@brief Function for finding the smallest and the largest gap between the channels of a group.
+ *
+ * @param[in]  period          Period of the group.
+ * @param[out] p_count         Number of channels of the group, including those to be opened.
+ * @param[out] p_small_channel Channel at the end of the smallest gap, never the reference channel.
+ * @param[out] p_small_gap     Length of the smallest gap.
+ * @param[out] p_large_start   Start of the largest gap.
+ * @param[out] p_large_gap     Length of the largest gap.
+ *
+ * @return Number of channels placed in the group.
+ */
+static uint32_t sched_gaps_find(uint16_t   period,
+                                uint32_t * p_count,
+                                uint8_t  * p_small_channel,
+                                uint32_t * p_small_gap,
+                                uint32_t * p_large_start,
+                                uint32_t * p_large_gap)
+{
+    uint8_t  order[ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED];
+    uint32_t placed = 0;
+
+    *p_count = 0;
+
+    // Sort the placed channels of the group by phase.
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        sched_channel_t const * p_channel = &m_sched_channels[i];
+
+        if ((p_channel->state == SCHED_CHANNEL_UNUSED) ||
+            (p_channel->state == SCHED_CHANNEL_CLOSING) ||
+            (p_channel->period != period))
+        {
+            continue;
+        }
+
+        (*p_count)++;
+
+        if (p_channel->state != SCHED_CHANNEL_OPEN)
+        {
+            // Not placed yet.
+            continue;
+        }
+
+        uint32_t j = placed++;
+        while ((j > 0) && (m_sched_channels[order[j - 1]].phase > p_channel->phase))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    *p_small_gap   = period;
+    *p_large_gap   = 0;
+    *p_large_start = 0;
+
+    for (uint32_t j = 0; j < placed; j++)
+    {
+        uint32_t start = m_sched_channels[order[j]].phase;
+        uint8_t  next  = order[(j + 1) % placed];
+        uint32_t gap   = (j + 1 < placed) ? (m_sched_channels[next].phase - start)
+                                          : (period - start + m_sched_channels[next].phase);
+
+        if (gap > *p_large_gap)
+        {
+            *p_large_gap   = gap;
+            *p_large_start = start;
+        }
+
+        if ((placed > 1) && (gap < *p_small_gap))
+        {
+            *p_small_gap     = gap;
+            *p_small_channel = m_sched_channels[next].is_reference ? order[j] : next;
+        }
+    }
+
+    return placed;
+}
+
+
+/**@brief Function for moving, if needed, a channel which is too close to another one.
+ *
+ * @details A single channel of the group is moved at a time.
+ */
+static void sched_group_rebalance(uint16_t period)
+{
+    uint32_t count;
+    uint8_t  small_channel;
+    uint32_t small_gap;
+    uint32_t large_start;
+    uint32_t large_gap;
+
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        if ((m_sched_channels[i].period == period) &&
+            ((m_sched_channels[i].state == SCHED_CHANNEL_PENDING) ||
+             (m_sched_channels[i].state == SCHED_CHANNEL_MOVING)))
+        {
+            // Wait until the group is settled.
+            return;
+        }
+    }
+
+    if ((sched_gaps_find(period, &count, &small_channel, &small_gap, &large_start, &large_gap) < 2) ||
+        (small_gap >= (period / count) / 2))
+    {
+        return;
+    }
+
+    if (sd_ant_channel_close(small_channel) == NRF_SUCCESS)
+    {
+        m_sched_channels[small_channel].state = SCHED_CHANNEL_MOVING;
+    }
+}
+
+
+/**@brief Function for opening the pending channels of a group, at an event of its reference
+ *        channel.
+ */
+static void sched_group_open(uint16_t period)
+{
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        sched_channel_t * p_channel = &m_sched_channels[i];
+
+        if ((p_channel->state != SCHED_CHANNEL_PENDING) || (p_channel->period != period))
+        {
+            continue;
+        }
+
+        uint32_t count;
+        uint8_t  small_channel;
+        uint32_t small_gap;
+        uint32_t large_start;
+        uint32_t large_gap;
+
+        UNUSED_RETURN_VALUE(sched_gaps_find(period,
+                                            &count,
+                                            &small_channel,
+                                            &small_gap,
+                                            &large_start,
+                                            &large_gap));
+
+        p_channel->phase = (large_start + (large_gap / 2)) % period;
+
+        if (sd_ant_channel_open_with_offset(i, p_channel->phase) == NRF_SUCCESS)
+        {
+            p_channel->state = SCHED_CHANNEL_OPEN;
+        }
+    }
+
+    sched_group_rebalance(period);
+}
+
+
+/**@brief Function for electing a new reference channel for a group which has none.
+ *
+ * @details An open channel is preferred, and the phases of the group are made relative to it.
+ *          Otherwise, a channel waiting to be opened is opened right away.
+ */
+static void sched_reference_elect(uint16_t period)
+{
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        sched_channel_t * p_ref = &m_sched_channels[i];
+
+        if ((p_ref->period == period) && (p_ref->state == SCHED_CHANNEL_OPEN))
+        {
+            uint16_t ref_phase = p_ref->phase;
+
+            for (uint8_t j = 0; j < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; j++)
+            {
+                if ((m_sched_channels[j].state != SCHED_CHANNEL_UNUSED) &&
+                    (m_sched_channels[j].period == period))
+                {
+                    m_sched_channels[j].phase =
+                        (m_sched_channels[j].phase + period - ref_phase) % period;
+                }
+            }
+
+            p_ref->is_reference = true;
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        sched_channel_t * p_ref = &m_sched_channels[i];
+
+        if ((p_ref->period == period) &&
+            (p_ref->state == SCHED_CHANNEL_PENDING) &&
+            (sd_ant_channel_open(i) == NRF_SUCCESS))
+        {
+            p_ref->state        = SCHED_CHANNEL_OPEN;
+            p_ref->phase        = 0;
+            p_ref->is_reference = true;
+            return;
+        }
+    }
+}
+
+
+/**@brief Function for removing a channel from its group.
+ */
+static void sched_channel_remove(uint8_t channel_number)
+{
+    sched_channel_t * p_channel = &m_sched_channels[channel_number];
+    uint16_t          period    = p_channel->period;
+
+    p_channel->state = SCHED_CHANNEL_UNUSED;
+
+    if (p_channel->is_reference)
+    {
+        p_channel->is_reference = false;
+        sched_reference_elect(period);
+    }
+
+    sched_group_rebalance(period);
+}
+
+
+uint32_t ant_channel_sched_open(ant_channel_config_t const * p_config)
+{
+    uint32_t             err_code;
+    ant_channel_config_t config;
+
+    VERIFY_PARAM_NOT_NULL(p_config);
+
+    if ((p_config->channel_number >= ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED) ||
+        (p_config->channel_period == 0) ||
+        ((p_config->channel_type != CHANNEL_TYPE_MASTER) &&
+         (p_config->channel_type != CHANNEL_TYPE_MASTER_TX_ONLY)))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    sched_channel_t * p_channel = &m_sched_channels[p_config->channel_number];
+
+    if (p_channel->state != SCHED_CHANNEL_UNUSED)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // Join the group with the closest period within the tolerance.
+    config = *p_config;
+
+    uint32_t best_diff = ANT_CONFIG_CHANNEL_SCHED_PERIOD_TOLERANCE + 1;
+
+    for (uint8_t i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
+    {
+        if (m_sched_channels[i].state == SCHED_CHANNEL_UNUSED)
+        {
+            continue;
+        }
+
+        uint32_t diff = (m_sched_channels[i].period > p_config->channel_period)
+                      ? (m_sched_channels[i].period - p_config->channel_period)
+                      : (p_config->channel_period - m_sched_channels[i].period);
+
+        if (diff < best_diff)
+        {
+            best_diff             = diff;
+            config.channel_period = m_sched_channels[i].period;
+        }
+    }
+
+    err_code = ant_channel_init(&config);
+    VERIFY_SUCCESS(err_code);
+
+    p_channel->period       = config.channel_period;
+    p_channel->phase        = 0;
+    p_channel->is_reference = false;
+
+    if (sched_reference_find(config.channel_period) == ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED)
+    {
+        // First channel of the group, open it right away.
+        err_code = sd_ant_channel_open(config.channel_number);
+        VERIFY_SUCCESS(err_code);
+
+        p_channel->state        = SCHED_CHANNEL_OPEN;
+        p_channel->is_reference = true;
+    }
+    else
+    {
+        p_channel->state = SCHED_CHANNEL_PENDING;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ant_channel_sched_close(uint8_t channel_number)
+{
+    uint32_t err_code;
+
+    if ((channel_number >= ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED) ||
+        (m_sched_channels[channel_number].state == SCHED_CHANNEL_UNUSED))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    switch (m_sched_channels[channel_number].state)
+    {
+        case SCHED_CHANNEL_PENDING:
+            // Not opened yet.
+            sched_channel_remove(channel_number);
+            break;
+
+        case SCHED_CHANNEL_OPEN:
+            err_code = sd_ant_channel_close(channel_number);
+            VERIFY_SUCCESS(err_code);
+            // Fall through.
+
+        default:
+            // Already closing when moved, remove it once it is closed.
+            m_sched_channels[channel_number].state = SCHED_CHANNEL_CLOSING;
+            break;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void ant_channel_sched_evt_handler(ant_evt_t * p_ant_evt)
+{
+    if (p_ant_evt->channel >= ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED)
+    {
+        return;
+    }
+
+    sched_channel_t * p_channel = &m_sched_channels[p_ant_evt->channel];
+
+    switch (p_ant_evt->event)
+    {
+        case EVENT_TX:
+        case EVENT_TRANSFER_TX_COMPLETED:
+        case EVENT_TRANSFER_TX_FAILED:
+            if ((p_channel->state == SCHED_CHANNEL_OPEN) && p_channel->is_reference)
+            {
+                sched_group_open(p_channel->period);
+            }
+            break;
+
+        case EVENT_CHANNEL_CLOSED:
+            if (p_channel->state == SCHED_CHANNEL_MOVING)
+            {
+                p_channel->state = SCHED_CHANNEL_PENDING;
+
+                if (sched_reference_find(p_channel->period) == ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED)
+                {
+                    sched_reference_elect(p_channel->period);
+                }
+            }
+            else if (p_channel->state != SCHED_CHANNEL_UNUSED)
+            {
+                sched_channel_remove(p_ant_evt->channel);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+#endif // ANT_CONFIG_CHANNEL_SCHED_ENABLED
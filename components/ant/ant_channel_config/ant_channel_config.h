@@ -19,6 +19,18 @@
     #include "ant_encrypt_config.h"
 #endif
 
+#ifndef ANT_CONFIG_CHANNEL_SCHED_ENABLED
+    #define ANT_CONFIG_CHANNEL_SCHED_ENABLED            0   ///< Enable the channel scheduler, see @ref ant_channel_sched_open.
+#endif
+
+#ifndef ANT_CONFIG_CHANNEL_SCHED_PERIOD_TOLERANCE
+    #define ANT_CONFIG_CHANNEL_SCHED_PERIOD_TOLERANCE   0   ///< Largest difference, in 32 kHz counts, between the period of a channel and the period of a group of scheduled channels for the channel to be given the period of the group.
+#endif
+
+#if ANT_CONFIG_CHANNEL_SCHED_ENABLED
+    #include "ant_stack_handler_types.h"
+#endif
+
 /**@brief ANT channel configuration structure. */
 typedef struct
 {
@@ -46,5 +58,51 @@ typedef struct
  */
 uint32_t ant_channel_init(ant_channel_config_t const * p_config);
 
+#if ANT_CONFIG_CHANNEL_SCHED_ENABLED
+/**@brief Function for configuring and opening a master channel at a scheduled time.
+ *
+ * @details Channels opened with this function which have the same period form a group, and
+ *          the scheduler spreads the transmissions of a group evenly over the period, so that
+ *          the channels do not collide. A channel whose period differs from the period of a group
+ *          by at most ANT_CONFIG_CHANNEL_SCHED_PERIOD_TOLERANCE counts is given the period of the
+ *          group, so that the channels do not drift into each other.
+ *
+ *          The first channel of a group is opened right away and is the reference of the group.
+ *          The other channels are opened, with an offset, when the next transmission event of the
+ *          reference channel is received. When channels open or close, the channels which have
+ *          come too close to each other are closed and opened again in the largest gap of the
+ *          group, one at a time, which costs each moved channel a few channel periods.
+ *
+ *          All ANT events must be forwarded to @ref ant_channel_sched_evt_handler.
+ *
+ * @param[in]  p_config        Pointer to the channel configuration structure. The channel type must
+ *                             be a master channel type.
+ *
+ * @retval     NRF_SUCCESS             If the channel was configured and will be opened.
+ * @retval     NRF_ERROR_INVALID_PARAM If the channel number, type or period is not valid.
+ * @retval     NRF_ERROR_INVALID_STATE If the channel is already scheduled.
+ * @return     Otherwise, an error code returned by the SoftDevice.
+ */
+uint32_t ant_channel_sched_open(ant_channel_config_t const * p_config);
+
+/**@brief Function for closing a channel opened with @ref ant_channel_sched_open.
+ *
+ * @details The remaining channels of the group are rebalanced when the channel is closed.
+ *
+ * @param[in]  channel_number  Channel number.
+ *
+ * @retval     NRF_SUCCESS             If the channel is being closed.
+ * @retval     NRF_ERROR_INVALID_PARAM If the channel is not scheduled.
+ * @return     Otherwise, an error code returned by the SoftDevice.
+ */
+uint32_t ant_channel_sched_close(uint8_t channel_number);
+
+/**@brief Function for handling ANT events for the channel scheduler.
+ *
+ * @param[in]  p_ant_evt       Pointer to the ANT event.
+ */
+void ant_channel_sched_evt_handler(ant_evt_t * p_ant_evt);
+#endif // ANT_CONFIG_CHANNEL_SCHED_ENABLED
+
 #endif // ANT_CHANNEL_CONFIG_H__
 /** @} */
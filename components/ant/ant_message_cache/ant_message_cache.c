@@ -0,0 +1,153 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "ant_message_cache.h"
+#include <string.h>
+#include "nrf_assert.h"
+
+/**@brief Function for hashing the compared bytes of a payload (FNV-1a). */
+static uint16_t payload_hash(ant_message_cache_t const * p_cache, uint8_t const * p_payload)
+{
+    uint32_t hash = 2166136261UL;
+
+    for (uint32_t i = 0; i < ANT_STANDARD_DATA_PAYLOAD_SIZE; i++)
+    {
+        if ((p_cache->ignore_mask & (1u << i)) == 0)
+        {
+            hash = (hash ^ p_payload[i]) * 16777619UL;
+        }
+    }
+
+    return (uint16_t)((hash ^ (hash >> 16)) & (p_cache->hash_size - 1));
+}
+
+
+/**@brief Function for comparing the compared bytes of two payloads. */
+static bool payload_match(ant_message_cache_t const * p_cache,
+                          uint8_t const             * p_payload_a,
+                          uint8_t const             * p_payload_b)
+{
+    for (uint32_t i = 0; i < ANT_STANDARD_DATA_PAYLOAD_SIZE; i++)
+    {
+        if (((p_cache->ignore_mask & (1u << i)) == 0) && (p_payload_a[i] != p_payload_b[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**@brief Function for removing the oldest entry.
+ *
+ * @details The oldest entry is the last entry of its hash chain.
+ */
+static void front_remove(ant_message_cache_t * p_cache)
+{
+    uint16_t   index  = p_cache->front;
+    uint16_t * p_link = &p_cache->p_heads[payload_hash(p_cache, p_cache->p_entries[index].payload)];
+
+    while (*p_link != index)
+    {
+        ASSERT(*p_link != ANT_MESSAGE_CACHE_INDEX_INVALID);
+        p_link = &p_cache->p_entries[*p_link].next;
+    }
+    *p_link = ANT_MESSAGE_CACHE_INDEX_INVALID;
+
+    p_cache->front = (index + 1 == p_cache->size) ? 0 : index + 1;
+    p_cache->count--;
+}
+
+
+void ant_message_cache_init(ant_message_cache_t * p_cache)
+{
+    ASSERT(p_cache != NULL);
+    ASSERT((p_cache->hash_size & (p_cache->hash_size - 1)) == 0);
+
+    for (uint32_t i = 0; i < p_cache->hash_size; i++)
+    {
+        p_cache->p_heads[i] = ANT_MESSAGE_CACHE_INDEX_INVALID;
+    }
+
+    for (uint32_t i = 0; i < p_cache->max_ticks; i++)
+    {
+        p_cache->p_tick_counts[i] = 0;
+    }
+
+    p_cache->front = 0;
+    p_cache->count = 0;
+    p_cache->tick  = 0;
+}
+
+
+void ant_message_cache_add(ant_message_cache_t * p_cache, uint8_t const * p_payload)
+{
+    if (p_cache->count == p_cache->size)
+    {
+        front_remove(p_cache);
+
+        // The dropped entry belongs to the oldest tick with entries left.
+        uint8_t tick = p_cache->tick;
+        do
+        {
+            tick = (tick + 1 == p_cache->max_ticks) ? 0 : tick + 1;
+        }
+        while (p_cache->p_tick_counts[tick] == 0);
+
+        p_cache->p_tick_counts[tick]--;
+    }
+
+    uint32_t                    index   = p_cache->front + p_cache->count;
+    index                              -= (index >= p_cache->size) ? p_cache->size : 0;
+    ant_message_cache_entry_t * p_entry = &p_cache->p_entries[index];
+    uint16_t                    hash    = payload_hash(p_cache, p_payload);
+
+    memcpy(p_entry->payload, p_payload, ANT_STANDARD_DATA_PAYLOAD_SIZE);
+    p_entry->next           = p_cache->p_heads[hash];
+    p_cache->p_heads[hash]  = (uint16_t)index;
+
+    p_cache->p_tick_counts[p_cache->tick]++;
+    p_cache->count++;
+}
+
+
+bool ant_message_cache_find(ant_message_cache_t const * p_cache, uint8_t const * p_payload)
+{
+    uint16_t index = p_cache->p_heads[payload_hash(p_cache, p_payload)];
+
+    while (index != ANT_MESSAGE_CACHE_INDEX_INVALID)
+    {
+        if (payload_match(p_cache, p_cache->p_entries[index].payload, p_payload))
+        {
+            return true;
+        }
+
+        index = p_cache->p_entries[index].next;
+    }
+
+    return false;
+}
+
+
+void ant_message_cache_tick(ant_message_cache_t * p_cache)
+{
+    p_cache->tick = (p_cache->tick + 1 == p_cache->max_ticks) ? 0 : p_cache->tick + 1;
+
+    // The slot of the new tick holds the entries added max_ticks ticks ago.
+    for (uint32_t i = p_cache->p_tick_counts[p_cache->tick]; i > 0; i--)
+    {
+        front_remove(p_cache);
+    }
+
+    p_cache->p_tick_counts[p_cache->tick] = 0;
+}
@@ -0,0 +1,124 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef ANT_MESSAGE_CACHE_H__
+#define ANT_MESSAGE_CACHE_H__
+
+/** @file
+ *
+ * @defgroup ant_sdk_message_cache ANT message cache
+ * @{
+ * @ingroup ant_sdk_utils
+ * @brief Cache of recently seen ANT message payloads.
+ *
+ * @details The cache keeps the payloads most recently added, for example to discard the copies
+ *          of a message that is relayed by several nodes of a network. Payloads are kept in a ring
+ *          in the order they were added, and are chained by hash, so that looking a payload up
+ *          only compares it with the payloads that have the same hash. Selected payload bytes,
+ *          for example reserved bytes, can be left out of the comparison.
+ *
+ *          Payloads expire after a number of ticks of @ref ant_message_cache_tick. The number of
+ *          payloads added during each tick is counted, so expiring payloads only removes them
+ *          from the front of the ring, without going through the payloads that are kept. When
+ *          the cache is full, adding a payload drops the oldest one.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ant_parameters.h"
+#include "app_util.h"
+
+#define ANT_MESSAGE_CACHE_INDEX_INVALID     0xFFFF  ///< Invalid entry index.
+
+/**@brief Cache entry. */
+typedef struct
+{
+    uint8_t     payload[ANT_STANDARD_DATA_PAYLOAD_SIZE];    ///< Message payload.
+    uint16_t    next;                                       ///< Next older entry with the same hash. For internal use only.
+} ant_message_cache_entry_t;
+
+/**@brief Cache instance. */
+typedef struct
+{
+    ant_message_cache_entry_t * p_entries;      ///< Entry ring.
+    uint16_t                  * p_heads;        ///< Newest entry of each hash chain.
+    uint16_t                  * p_tick_counts;  ///< Number of entries added during each of the last ticks.
+    uint16_t                    size;           ///< Number of entries.
+    uint16_t                    hash_size;      ///< Number of hash chains. Must be a power of two.
+    uint8_t                     max_ticks;      ///< Number of ticks after which an entry expires.
+    uint8_t                     ignore_mask;    ///< Payload bytes left out of the comparison, one bit per byte.
+    uint16_t                    front;          ///< Oldest entry.
+    uint16_t                    count;          ///< Number of entries in the cache.
+    uint8_t                     tick;           ///< Tick count slot of the current tick.
+} ant_message_cache_t;
+
+/**@brief Macro for defining a cache instance.
+ *
+ * @param[in]  NAME         Name of the instance.
+ * @param[in]  SIZE         Number of entries, up to 65534.
+ * @param[in]  HASH_SIZE    Number of hash chains, a power of two. The size rounded up is a
+ *                          good choice.
+ * @param[in]  MAX_TICKS    Number of ticks after which an entry expires, from 1 to 255.
+ * @param[in]  IGNORE_MASK  Payload bytes left out of the comparison: bit n set for byte n.
+ */
+#define ANT_MESSAGE_CACHE_DEF(NAME, SIZE, HASH_SIZE, MAX_TICKS, IGNORE_MASK)    \
+    STATIC_ASSERT((SIZE) > 0 && (SIZE) < ANT_MESSAGE_CACHE_INDEX_INVALID);      \
+    STATIC_ASSERT(((HASH_SIZE) & ((HASH_SIZE) - 1)) == 0);                      \
+    STATIC_ASSERT((MAX_TICKS) > 0 && (MAX_TICKS) <= 0xFF);                      \
+    static ant_message_cache_entry_t NAME##_entries[SIZE];                      \
+    static uint16_t                  NAME##_heads[HASH_SIZE];                   \
+    static uint16_t                  NAME##_tick_counts[MAX_TICKS];             \
+    static ant_message_cache_t       NAME =                                     \
+    {                                                                           \
+        .p_entries     = NAME##_entries,                                        \
+        .p_heads       = NAME##_heads,                                          \
+        .p_tick_counts = NAME##_tick_counts,                                    \
+        .size          = (SIZE),                                                \
+        .hash_size     = (HASH_SIZE),                                           \
+        .max_ticks     = (MAX_TICKS),                                           \
+        .ignore_mask   = (IGNORE_MASK),                                         \
+    }
+
+/**@brief Function for emptying a cache.
+ *
+ * @param[in]  p_cache  Pointer to the cache.
+ */
+void ant_message_cache_init(ant_message_cache_t * p_cache);
+
+/**@brief Function for adding a payload.
+ *
+ * @details The payload is added even if it is already in the cache.
+ *
+ * @param[in]  p_cache      Pointer to the cache.
+ * @param[in]  p_payload    Payload of @ref ANT_STANDARD_DATA_PAYLOAD_SIZE bytes.
+ */
+void ant_message_cache_add(ant_message_cache_t * p_cache, uint8_t const * p_payload);
+
+/**@brief Function for checking if a payload is in the cache.
+ *
+ * @param[in]  p_cache      Pointer to the cache.
+ * @param[in]  p_payload    Payload of @ref ANT_STANDARD_DATA_PAYLOAD_SIZE bytes.
+ *
+ * @return     True if a matching payload is in the cache.
+ */
+bool ant_message_cache_find(ant_message_cache_t const * p_cache, uint8_t const * p_payload);
+
+/**@brief Function for advancing the time of a cache.
+ *
+ * @details The payloads added @ref ant_message_cache_t::max_ticks ticks ago are removed.
+ *
+ * @param[in]  p_cache  Pointer to the cache.
+ */
+void ant_message_cache_tick(ant_message_cache_t * p_cache);
+
+#endif // ANT_MESSAGE_CACHE_H__
+/** @} */
@@ -0,0 +1,192 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stddef.h>
+#include "ant_node_registry.h"
+#include "nrf_assert.h"
+
+/**@brief Slot states. */
+typedef enum
+{
+    SLOT_EMPTY = 0,     ///< Never used since the last time the probe sequence was cleaned up.
+    SLOT_USED,          ///< Holds a node.
+    SLOT_DELETED,       ///< Held a node which was removed. Probes continue past it.
+} slot_state_t;
+
+
+/**@brief Function for getting the first slot of the probe sequence of a node. */
+static uint16_t slot_home_get(ant_node_registry_t const * p_registry, uint16_t node_id)
+{
+    // Fold the upper byte so that both 8-bit node addresses and 16-bit device numbers spread.
+    return (node_id ^ (node_id >> 8)) & (p_registry->size - 1);
+}
+
+
+/**@brief Function for getting the next slot of a probe sequence. */
+static uint16_t slot_next_get(ant_node_registry_t const * p_registry, uint16_t index)
+{
+    return (index + 1) & (p_registry->size - 1);
+}
+
+
+void ant_node_registry_init(ant_node_registry_t * p_registry)
+{
+    ASSERT(p_registry != NULL);
+    ASSERT((p_registry->size & (p_registry->size - 1)) == 0);
+
+    for (uint32_t i = 0; i < p_registry->size; i++)
+    {
+        p_registry->p_slots[i].state = SLOT_EMPTY;
+    }
+
+    p_registry->count = 0;
+}
+
+
+uint16_t ant_node_registry_find(ant_node_registry_t const * p_registry, uint16_t node_id)
+{
+    uint16_t index = slot_home_get(p_registry, node_id);
+
+    for (uint32_t i = 0; i < p_registry->size; i++)
+    {
+        ant_node_registry_slot_t const * p_slot = &p_registry->p_slots[index];
+
+        if (p_slot->state == SLOT_EMPTY)
+        {
+            break;
+        }
+
+        if (p_slot->state == SLOT_USED && p_slot->node_id == node_id)
+        {
+            return index;
+        }
+
+        index = slot_next_get(p_registry, index);
+    }
+
+    return ANT_NODE_REGISTRY_INDEX_INVALID;
+}
+
+
+ret_code_t ant_node_registry_add(ant_node_registry_t * p_registry,
+                                 uint16_t              node_id,
+                                 uint16_t            * p_index)
+{
+    uint16_t index      = slot_home_get(p_registry, node_id);
+    uint16_t free_index = ANT_NODE_REGISTRY_INDEX_INVALID;
+
+    // Look for the node along the whole probe sequence, and remember the first free slot.
+    for (uint32_t i = 0; i < p_registry->size; i++)
+    {
+        ant_node_registry_slot_t const * p_slot = &p_registry->p_slots[index];
+
+        if (p_slot->state == SLOT_USED)
+        {
+            if (p_slot->node_id == node_id)
+            {
+                if (p_index != NULL)
+                {
+                    *p_index = index;
+                }
+                return NRF_ERROR_INVALID_STATE;
+            }
+        }
+        else
+        {
+            if (free_index == ANT_NODE_REGISTRY_INDEX_INVALID)
+            {
+                free_index = index;
+            }
+
+            if (p_slot->state == SLOT_EMPTY)
+            {
+                break;
+            }
+        }
+
+        index = slot_next_get(p_registry, index);
+    }
+
+    if (free_index == ANT_NODE_REGISTRY_INDEX_INVALID)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_registry->p_slots[free_index].node_id = node_id;
+    p_registry->p_slots[free_index].state   = SLOT_USED;
+    p_registry->count++;
+
+    if (p_index != NULL)
+    {
+        *p_index = free_index;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ant_node_registry_remove(ant_node_registry_t * p_registry, uint16_t node_id)
+{
+    uint16_t index = ant_node_registry_find(p_registry, node_id);
+
+    if (index == ANT_NODE_REGISTRY_INDEX_INVALID)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    p_registry->count--;
+
+    if (p_registry->p_slots[slot_next_get(p_registry, index)].state != SLOT_EMPTY)
+    {
+        // Other probe sequences may go through this slot.
+        p_registry->p_slots[index].state = SLOT_DELETED;
+        return NRF_SUCCESS;
+    }
+
+    // The slot ends a probe sequence: it and the deleted slots before it can be reclaimed.
+    do
+    {
+        p_registry->p_slots[index].state = SLOT_EMPTY;
+        index = (index - 1) & (p_registry->size - 1);
+    }
+    while (p_registry->p_slots[index].state == SLOT_DELETED);
+
+    return NRF_SUCCESS;
+}
+
+
+bool ant_node_registry_is_used(ant_node_registry_t const * p_registry, uint16_t index)
+{
+    return (index < p_registry->size) && (p_registry->p_slots[index].state == SLOT_USED);
+}
+
+
+uint16_t ant_node_registry_next(ant_node_registry_t const * p_registry, uint16_t index)
+{
+    if (p_registry->count == 0)
+    {
+        return ANT_NODE_REGISTRY_INDEX_INVALID;
+    }
+
+    if (index >= p_registry->size)
+    {
+        index = p_registry->size - 1;
+    }
+
+    do
+    {
+        index = slot_next_get(p_registry, index);
+    }
+    while (p_registry->p_slots[index].state != SLOT_USED);
+
+    return index;
+}
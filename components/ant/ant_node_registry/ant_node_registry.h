@@ -0,0 +1,131 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef ANT_NODE_REGISTRY_H__
+#define ANT_NODE_REGISTRY_H__
+
+/** @file
+ *
+ * @defgroup ant_sdk_node_registry ANT node registry
+ * @{
+ * @ingroup ant_sdk_utils
+ * @brief Hashed registry of ANT nodes.
+ *
+ * @details The registry maps node identifiers, for example node addresses of a network or
+ *          ANT device numbers, to the slots of a table, so that the application can keep its
+ *          per-node records in an array of the same size indexed by the slot. Lookups hash the
+ *          identifier and probe the table linearly from there, stopping at the first slot which
+ *          was never used, so the cost of a lookup does not depend on the number of nodes.
+ *          The slot of a node does not change until the node is removed.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+#include "app_util.h"
+
+#define ANT_NODE_REGISTRY_INDEX_INVALID     0xFFFF  ///< Invalid slot index.
+
+/**@brief Registry slot. */
+typedef struct
+{
+    uint16_t    node_id;    ///< Identifier of the node in the slot.
+    uint8_t     state;      ///< Slot state. For internal use only.
+} ant_node_registry_slot_t;
+
+/**@brief Registry instance. */
+typedef struct
+{
+    ant_node_registry_slot_t  * p_slots;    ///< Slot table.
+    uint16_t                    size;       ///< Number of slots. Must be a power of two.
+    uint16_t                    count;      ///< Number of registered nodes.
+} ant_node_registry_t;
+
+/**@brief Macro for defining a registry instance.
+ *
+ * @param[in]  NAME     Name of the instance.
+ * @param[in]  SIZE     Number of slots, a power of two up to 32768.
+ */
+#define ANT_NODE_REGISTRY_DEF(NAME, SIZE)                                       \
+    STATIC_ASSERT(((SIZE) & ((SIZE) - 1)) == 0 && (SIZE) <= 0x8000);            \
+    static ant_node_registry_slot_t NAME##_slots[SIZE];                         \
+    static ant_node_registry_t      NAME =                                      \
+    {                                                                           \
+        .p_slots = NAME##_slots,                                                \
+        .size    = (SIZE),                                                      \
+        .count   = 0,                                                           \
+    }
+
+/**@brief Function for clearing a registry.
+ *
+ * @param[in]  p_registry   Pointer to the registry.
+ */
+void ant_node_registry_init(ant_node_registry_t * p_registry);
+
+/**@brief Function for adding a node.
+ *
+ * @param[in]  p_registry   Pointer to the registry.
+ * @param[in]  node_id      Identifier of the node.
+ * @param[out] p_index      Slot of the node. Can be NULL.
+ *
+ * @retval     NRF_SUCCESS              The node was added.
+ * @retval     NRF_ERROR_INVALID_STATE  The node is already registered. p_index is set to its slot.
+ * @retval     NRF_ERROR_NO_MEM         All slots are used.
+ */
+ret_code_t ant_node_registry_add(ant_node_registry_t * p_registry,
+                                 uint16_t              node_id,
+                                 uint16_t            * p_index);
+
+/**@brief Function for removing a node.
+ *
+ * @param[in]  p_registry   Pointer to the registry.
+ * @param[in]  node_id      Identifier of the node.
+ *
+ * @retval     NRF_SUCCESS              The node was removed.
+ * @retval     NRF_ERROR_NOT_FOUND      The node is not registered.
+ */
+ret_code_t ant_node_registry_remove(ant_node_registry_t * p_registry, uint16_t node_id);
+
+/**@brief Function for looking up the slot of a node.
+ *
+ * @param[in]  p_registry   Pointer to the registry.
+ * @param[in]  node_id      Identifier of the node.
+ *
+ * @return     Slot of the node, or @ref ANT_NODE_REGISTRY_INDEX_INVALID if it is not registered.
+ */
+uint16_t ant_node_registry_find(ant_node_registry_t const * p_registry, uint16_t node_id);
+
+/**@brief Function for checking if a slot holds a node.
+ *
+ * @param[in]  p_registry   Pointer to the registry.
+ * @param[in]  index        Slot.
+ *
+ * @return     True if a node is registered in the slot.
+ */
+bool ant_node_registry_is_used(ant_node_registry_t const * p_registry, uint16_t index);
+
+/**@brief Function for getting the slot of the next node, in slot order.
+ *
+ * @details The search wraps around the end of the table, so that all nodes can be visited in
+ *          turn by passing the previous result.
+ *
+ * @param[in]  p_registry   Pointer to the registry.
+ * @param[in]  index        Slot to start after, or @ref ANT_NODE_REGISTRY_INDEX_INVALID to start
+ *                          from the beginning of the table.
+ *
+ * @return     Slot of the next node, or @ref ANT_NODE_REGISTRY_INDEX_INVALID if the registry is
+ *             empty.
+ */
+uint16_t ant_node_registry_next(ant_node_registry_t const * p_registry, uint16_t index);
+
+#endif // ANT_NODE_REGISTRY_H__
+/** @} */
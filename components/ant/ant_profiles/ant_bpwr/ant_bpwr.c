@@ -16,6 +16,7 @@
 #include "app_util.h"
 #include "ant_bpwr.h"
 #include "ant_bpwr_page_logger.h"
+#include "ant_page_codec.h"
 #include "app_error.h"
 
 #define BPWR_CALIB_INT_TIMEOUT ((ANT_CLOCK_FREQUENCY * BPWR_CALIBRATION_TIMOUT_S) / BPWR_MSG_PERIOD) // calibration timeout in ant message period's unit
@@ -34,6 +35,58 @@ typedef struct
     uint8_t page_payload[7];
 } ant_bpwr_message_layout_t;
 
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_1_codec, ant_bpwr_page_1_encode, ant_bpwr_page_1_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_16_codec, ant_bpwr_page_16_encode, ant_bpwr_page_16_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_17_codec, ant_bpwr_page_17_encode, ant_bpwr_page_17_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_18_codec, ant_bpwr_page_18_encode, ant_bpwr_page_18_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_cadence_codec, ant_bpwr_cadence_encode, ant_bpwr_cadence_decode);
+
+static ant_page_part_t const m_page_1_parts[] =
+{
+    ANT_PAGE_PART(&m_page_1_codec, ant_bpwr_profile_t, page_1),
+};
+
+static ant_page_part_t const m_page_16_parts[] =
+{
+    ANT_PAGE_PART(&m_page_16_codec, ant_bpwr_profile_t, page_16),
+    ANT_PAGE_PART(&m_cadence_codec, ant_bpwr_profile_t, common),
+};
+
+static ant_page_part_t const m_page_17_parts[] =
+{
+    ANT_PAGE_PART(&m_page_17_codec, ant_bpwr_profile_t, page_17),
+    ANT_PAGE_PART(&m_cadence_codec, ant_bpwr_profile_t, common),
+};
+
+static ant_page_part_t const m_page_18_parts[] =
+{
+    ANT_PAGE_PART(&m_page_18_codec, ant_bpwr_profile_t, page_18),
+    ANT_PAGE_PART(&m_cadence_codec, ant_bpwr_profile_t, common),
+};
+
+static ant_page_part_t const m_page_80_parts[] =
+{
+    ANT_PAGE_PART(&ant_common_page_80_codec, ant_bpwr_profile_t, page_80),
+};
+
+static ant_page_part_t const m_page_81_parts[] =
+{
+    ANT_PAGE_PART(&ant_common_page_81_codec, ant_bpwr_profile_t, page_81),
+};
+
+/**@brief Bicycle power pages. */
+static ant_page_desc_t const m_pages[] =
+{
+    ANT_PAGE_DESC(ANT_BPWR_PAGE_1, m_page_1_parts),
+    ANT_PAGE_DESC(ANT_BPWR_PAGE_16, m_page_16_parts),
+    ANT_PAGE_DESC(ANT_BPWR_PAGE_17, m_page_17_parts),
+    ANT_PAGE_DESC(ANT_BPWR_PAGE_18, m_page_18_parts),
+    ANT_PAGE_DESC(ANT_COMMON_PAGE_80, m_page_80_parts),
+    ANT_PAGE_DESC(ANT_COMMON_PAGE_81, m_page_81_parts),
+};
+
+ANT_PAGE_TABLE_DEF(m_page_table, m_pages);
+
 
 /**@brief Function for initializing the ANT Bicycle Power Profile instance.
  *
@@ -172,43 +225,20 @@ static void sens_message_encode(ant_bpwr_profile_t * p_profile, uint8_t * p_mess
 {
     ant_bpwr_message_layout_t * p_bpwr_message_payload =
         (ant_bpwr_message_layout_t *)p_message_payload;
+    ant_page_desc_t const     * p_page;
 
     p_bpwr_message_payload->page_number = next_page_number_get(p_profile);
 
     LOG_BPWR("B-PWR tx page: %u\r\n", p_bpwr_message_payload->page_number);
 
-    switch (p_bpwr_message_payload->page_number)
-    {
-        case ANT_BPWR_PAGE_1:
-            ant_bpwr_page_1_encode(p_bpwr_message_payload->page_payload, &(p_profile->page_1));
-            break;
-
-        case ANT_BPWR_PAGE_16:
-            ant_bpwr_page_16_encode(p_bpwr_message_payload->page_payload, &(p_profile->page_16));
-            ant_bpwr_cadence_encode(p_bpwr_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_BPWR_PAGE_17:
-            ant_bpwr_page_17_encode(p_bpwr_message_payload->page_payload, &(p_profile->page_17));
-            ant_bpwr_cadence_encode(p_bpwr_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_BPWR_PAGE_18:
-            ant_bpwr_page_18_encode(p_bpwr_message_payload->page_payload, &(p_profile->page_18));
-            ant_bpwr_cadence_encode(p_bpwr_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_COMMON_PAGE_80:
-            ant_common_page_80_encode(p_bpwr_message_payload->page_payload, &(p_profile->page_80));
-            break;
+    p_page = ant_page_table_find(&m_page_table, p_bpwr_message_payload->page_number);
 
-        case ANT_COMMON_PAGE_81:
-            ant_common_page_81_encode(p_bpwr_message_payload->page_payload, &(p_profile->page_81));
-            break;
-
-        default:
-            return;
+    if (p_page == NULL)
+    {
+        return;
     }
+
+    ant_page_encode(p_page, p_bpwr_message_payload->page_payload, p_profile);
     LOG_BPWR("\r\n");
     p_profile->evt_handler(p_profile, (ant_bpwr_evt_t)p_bpwr_message_payload->page_number);
 
@@ -247,42 +277,23 @@ static void disp_message_decode(ant_bpwr_profile_t * p_profile, uint8_t * p_mess
 {
     const ant_bpwr_message_layout_t * p_bpwr_message_payload =
         (ant_bpwr_message_layout_t *)p_message_payload;
+    ant_page_desc_t const           * p_page;
 
     LOG_BPWR("B-PWR rx page: %u\r\n", p_bpwr_message_payload->page_number);
 
-    switch (p_bpwr_message_payload->page_number)
-    {
-        case ANT_BPWR_PAGE_1:
-            ant_bpwr_page_1_decode(p_bpwr_message_payload->page_payload, &(p_profile->page_1));
-            p_profile->_cb.p_disp_cb->calib_stat = BPWR_DISP_CALIB_NONE;
-            break;
+    p_page = ant_page_table_find(&m_page_table, p_bpwr_message_payload->page_number);
 
-        case ANT_BPWR_PAGE_16:
-            ant_bpwr_page_16_decode(p_bpwr_message_payload->page_payload, &(p_profile->page_16));
-            ant_bpwr_cadence_decode(p_bpwr_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_BPWR_PAGE_17:
-            ant_bpwr_page_17_decode(p_bpwr_message_payload->page_payload, &(p_profile->page_17));
-            ant_bpwr_cadence_decode(p_bpwr_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_BPWR_PAGE_18:
-            ant_bpwr_page_18_decode(p_bpwr_message_payload->page_payload, &(p_profile->page_18));
-            ant_bpwr_cadence_decode(p_bpwr_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_COMMON_PAGE_80:
-            ant_common_page_80_decode(p_bpwr_message_payload->page_payload, &(p_profile->page_80));
-            break;
+    if (p_page == NULL)
+    {
+        LOG_BPWR("\r\n");
+        return;
+    }
 
-        case ANT_COMMON_PAGE_81:
-            ant_common_page_81_decode(p_bpwr_message_payload->page_payload, &(p_profile->page_81));
-            break;
+    ant_page_decode(p_page, p_bpwr_message_payload->page_payload, p_profile);
 
-        default:
-            LOG_BPWR("\r\n");
-            return;
+    if (p_bpwr_message_payload->page_number == ANT_BPWR_PAGE_1)
+    {
+        p_profile->_cb.p_disp_cb->calib_stat = BPWR_DISP_CALIB_NONE;
     }
     LOG_BPWR("\r\n");
     p_profile->evt_handler(p_profile, (ant_bpwr_evt_t)p_bpwr_message_payload->page_number);
@@ -17,6 +17,7 @@
 #include "ant_bsc.h"
 #include "ant_bsc_utils.h"
 #include "ant_bsc_page_logger.h"
+#include "ant_page_codec.h"
 #include "app_error.h"
 
 #define MAIN_DATA_INTERVAL          4       /**< The number of background data pages sent between main data pages.*/
@@ -43,6 +44,48 @@ typedef union
     ant_bsc_combined_message_layout_t   combined;
 }ant_bsc_message_layout_t;
 
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_4_codec, ant_bsc_page_4_encode, ant_bsc_page_4_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_5_codec, ant_bsc_page_5_encode, ant_bsc_page_5_decode);
+
+static ant_page_part_t const m_page_1_parts[] =
+{
+    ANT_PAGE_PART(&ant_bsc_page_1_codec, ant_bsc_profile_t, page_1),
+};
+
+static ant_page_part_t const m_page_2_parts[] =
+{
+    ANT_PAGE_PART(&ant_bsc_page_2_codec, ant_bsc_profile_t, page_2),
+};
+
+static ant_page_part_t const m_page_3_parts[] =
+{
+    ANT_PAGE_PART(&ant_bsc_page_3_codec, ant_bsc_profile_t, page_3),
+};
+
+static ant_page_part_t const m_page_4_parts[] =
+{
+    ANT_PAGE_PART(&m_page_4_codec, ant_bsc_profile_t, page_4),
+};
+
+static ant_page_part_t const m_page_5_parts[] =
+{
+    ANT_PAGE_PART(&m_page_5_codec, ant_bsc_profile_t, page_5),
+};
+
+/**@brief Speed or cadence sensor pages. Page 0 is present in each message, so it is not part of
+ *        the other pages. */
+static ant_page_desc_t const m_pages[] =
+{
+    ANT_PAGE_DESC_EMPTY(ANT_BSC_PAGE_0),
+    ANT_PAGE_DESC(ANT_BSC_PAGE_1, m_page_1_parts),
+    ANT_PAGE_DESC(ANT_BSC_PAGE_2, m_page_2_parts),
+    ANT_PAGE_DESC(ANT_BSC_PAGE_3, m_page_3_parts),
+    ANT_PAGE_DESC(ANT_BSC_PAGE_4, m_page_4_parts),
+    ANT_PAGE_DESC(ANT_BSC_PAGE_5, m_page_5_parts),
+};
+
+ANT_PAGE_TABLE_DEF(m_page_table, m_pages);
+
 
 /**@brief Function for initializing the ANT BSC profile instance.
  *
@@ -184,12 +227,14 @@ static void sens_message_encode(ant_bsc_profile_t * p_profile, uint8_t * p_messa
 {
     ant_bsc_message_layout_t * p_bsc_message_payload = (ant_bsc_message_layout_t *)p_message_payload;
     ant_bsc_evt_t              bsc_sens_event;
+    ant_page_desc_t const    * p_page;
 
     if (p_profile->_cb.p_sens_cb->device_type == BSC_COMBINED_DEVICE_TYPE)
     {
         LOG_BSC("%-30s \"Combined Speed & Cadence Page\"\n\r", "BSC TX Page:");
-        ant_bsc_combined_page_0_encode(p_bsc_message_payload->combined.page_payload,
-                                       &(p_profile->page_comb_0));
+        ant_page_codec_encode(&ant_bsc_combined_page_0_codec,
+                              p_bsc_message_payload->combined.page_payload,
+                              &(p_profile->page_comb_0));
         bsc_sens_event = (ant_bsc_evt_t) ANT_BSC_COMB_PAGE_0_UPDATED;
     }
     else
@@ -199,38 +244,18 @@ static void sens_message_encode(ant_bsc_profile_t * p_profile, uint8_t * p_messa
         LOG_BSC("%-30s %u\n\r", "BSC TX Page number:",
                 p_bsc_message_payload->speed_or_cadence.page_number);
 
-        ant_bsc_page_0_encode(p_bsc_message_payload->speed_or_cadence.page_payload,
+        ant_page_codec_encode(&ant_bsc_page_0_codec,
+                              p_bsc_message_payload->speed_or_cadence.page_payload,
                               &(p_profile->page_0));
         bsc_sens_event = (ant_bsc_evt_t) p_bsc_message_payload->speed_or_cadence.page_number;
 
-        switch(p_bsc_message_payload->speed_or_cadence.page_number)
+        p_page = ant_page_table_find(&m_page_table,
+                                     p_bsc_message_payload->speed_or_cadence.page_number);
+        if (p_page != NULL)
         {
-            case ANT_BSC_PAGE_0:
-                // No implementation needed
-                break;
-            case  ANT_BSC_PAGE_1:
-                ant_bsc_page_1_encode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_1));
-                break;
-            case ANT_BSC_PAGE_2:
-                ant_bsc_page_2_encode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_2));
-                break;
-            case ANT_BSC_PAGE_3:
-                ant_bsc_page_3_encode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_3));
-                break;
-            case ANT_BSC_PAGE_4:
-                ant_bsc_page_4_encode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_4));
-                break;
-            case ANT_BSC_PAGE_5:
-                ant_bsc_page_5_encode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_5));
-                break;
-            default:
-                // No implementation needed
-                break;
+            ant_page_encode(p_page,
+                            p_bsc_message_payload->speed_or_cadence.page_payload,
+                            p_profile);
         }
     }
     LOG_BSC("\r\n");
@@ -302,56 +327,32 @@ static void disp_message_decode(ant_bsc_profile_t * p_profile, uint8_t * p_messa
     const ant_bsc_message_layout_t * p_bsc_message_payload = 
                                     (ant_bsc_message_layout_t *)p_message_payload;
     ant_bsc_evt_t                    bsc_disp_event;
+    ant_page_desc_t const          * p_page;
 
     if (p_profile->_cb.p_disp_cb->device_type == BSC_COMBINED_DEVICE_TYPE)
     {
         LOG_BSC("%-30s \"Combined Speed & Cadence Page\"\n\r", "BSC RX Page Number:");
-        ant_bsc_combined_page_0_decode(p_bsc_message_payload->combined.page_payload,
-                                       &(p_profile->page_comb_0));
+        ant_page_codec_decode(&ant_bsc_combined_page_0_codec,
+                              p_bsc_message_payload->combined.page_payload,
+                              &(p_profile->page_comb_0));
         bsc_disp_event = (ant_bsc_evt_t) ANT_BSC_COMB_PAGE_0_UPDATED;
     }
     else
     {
         LOG_BSC("%-30s %u\n\r", "BSC RX Page Number:",
                 p_bsc_message_payload->speed_or_cadence.page_number);
-        ant_bsc_page_0_decode(p_bsc_message_payload->speed_or_cadence.page_payload,
+        ant_page_codec_decode(&ant_bsc_page_0_codec,
+                              p_bsc_message_payload->speed_or_cadence.page_payload,
                               &(p_profile->page_0)); // Page 0 is present in each message
         bsc_disp_event = (ant_bsc_evt_t) p_bsc_message_payload->speed_or_cadence.page_number;
 
-        switch (p_bsc_message_payload->speed_or_cadence.page_number)
+        p_page = ant_page_table_find(&m_page_table,
+                                     p_bsc_message_payload->speed_or_cadence.page_number);
+        if (p_page != NULL)
         {
-            case ANT_BSC_PAGE_0:
-                // No implementation needed
-                break;
-
-            case ANT_BSC_PAGE_1:
-                ant_bsc_page_1_decode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_1));
-                break;
-
-            case ANT_BSC_PAGE_2:
-                ant_bsc_page_2_decode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_2));
-                break;
-
-            case ANT_BSC_PAGE_3:
-                ant_bsc_page_3_decode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_3));
-                break;
-
-            case ANT_BSC_PAGE_4:
-                ant_bsc_page_4_decode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_4));
-                break;
-
-            case ANT_BSC_PAGE_5:
-                ant_bsc_page_5_decode(p_bsc_message_payload->speed_or_cadence.page_payload,
-                                      &(p_profile->page_5));
-                break;
-
-            default:
-                // No implementation needed
-                break;
+            ant_page_decode(p_page,
+                            p_bsc_message_payload->speed_or_cadence.page_payload,
+                            p_profile);
         }
     }
     LOG_BSC("\r\n");
@@ -13,23 +13,24 @@
 #include "ant_bsc_combined_page_0.h"
 #include "ant_bsc_utils.h"
 #include "ant_bsc_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief BSC page 0 data layout structure. */
-typedef struct
+/**@brief Combined page 0 fields. */
+static ant_page_field_t const m_combined_page0_fields[] =
 {
-    uint8_t cadence_evt_time_LSB;
-    uint8_t cadence_evt_time_MSB;
-    uint8_t cadence_rev_count_LSB;
-    uint8_t cadence_rev_count_MSB;
-    uint8_t speed_evt_time_LSB;
-    uint8_t speed_evt_time_MSB;
-    uint8_t speed_rev_count_LSB;
-    uint8_t speed_rev_count_MSB;
-}ant_bsc_combined_page0_data_layout_t;
+    ANT_PAGE_FIELD(ant_bsc_combined_page0_data_t, cadence_event_time, 0, 16),
+    ANT_PAGE_FIELD(ant_bsc_combined_page0_data_t, cadence_rev_count, 16, 16),
+    ANT_PAGE_FIELD(ant_bsc_combined_page0_data_t, speed_event_time, 32, 16),
+    ANT_PAGE_FIELD(ant_bsc_combined_page0_data_t, speed_rev_count, 48, 16),
+};
 
 /**@brief Function for printing combined speed and cadence page0 data. */
-static void comb_page0_data_log(ant_bsc_combined_page0_data_t const * p_page_data)
+static void comb_page0_data_log(void const * p_data)
 {
+    ant_bsc_combined_page0_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_COMB_PAGE0("%-30s %u\n\r",
                    "Cadence Revolution count:",
                    (unsigned int)p_page_data->cadence_rev_count);
@@ -50,45 +51,17 @@ static void comb_page0_data_log(ant_bsc_combined_page0_data_t const * p_page_dat
     LOG_COMB_PAGE0("%03us\n\r", (unsigned int)ANT_BSC_EVENT_TIME_MSEC(p_page_data->speed_event_time));
 }
 
-void ant_bsc_combined_page_0_encode(uint8_t * p_page_buffer, ant_bsc_combined_page0_data_t const * p_page_data)
-{
-    ant_bsc_combined_page0_data_layout_t * p_outcoming_data = (ant_bsc_combined_page0_data_layout_t *) p_page_buffer;
 
-    uint16_t cadence_event_time = p_page_data->cadence_event_time;
-    uint16_t cadence_rev_count  = p_page_data->cadence_rev_count;
-    uint16_t speed_event_time   = p_page_data->speed_event_time;
-    uint16_t speed_rev_count    = p_page_data->speed_rev_count;
+ANT_PAGE_CODEC_FIELDS_DEF(ant_bsc_combined_page_0_codec, m_combined_page0_fields, comb_page0_data_log);
 
-    p_outcoming_data->cadence_evt_time_LSB  = (uint8_t)(cadence_event_time & UINT8_MAX);
-    p_outcoming_data->cadence_evt_time_MSB  = (uint8_t)((cadence_event_time >> 8) & UINT8_MAX);
-    p_outcoming_data->cadence_rev_count_LSB = (uint8_t)(cadence_rev_count & UINT8_MAX);
-    p_outcoming_data->cadence_rev_count_MSB = (uint8_t)((cadence_rev_count >> 8) & UINT8_MAX);
-    p_outcoming_data->speed_evt_time_LSB    = (uint8_t)(speed_event_time & UINT8_MAX);
-    p_outcoming_data->speed_evt_time_MSB    = (uint8_t)((speed_event_time >> 8) & UINT8_MAX);
-    p_outcoming_data->speed_rev_count_LSB   = (uint8_t)(speed_rev_count & UINT8_MAX);
-    p_outcoming_data->speed_rev_count_MSB   = (uint8_t)((speed_rev_count >> 8) & UINT8_MAX);
 
-    comb_page0_data_log(p_page_data);
+void ant_bsc_combined_page_0_encode(uint8_t * p_page_buffer, ant_bsc_combined_page0_data_t const * p_page_data)
+{
+    ant_page_codec_encode(&ant_bsc_combined_page_0_codec, p_page_buffer, p_page_data);
 }
 
+
 void ant_bsc_combined_page_0_decode(uint8_t const * p_page_buffer, ant_bsc_combined_page0_data_t * p_page_data)
 {
-    ant_bsc_combined_page0_data_layout_t const * p_incoming_data = (ant_bsc_combined_page0_data_layout_t *)p_page_buffer;
-
-    uint16_t cadence_event_time = (uint16_t)((p_incoming_data->cadence_evt_time_MSB << 8) 
-                                  + p_incoming_data->cadence_evt_time_LSB);
-    uint16_t cadence_revolution_count = (uint16_t) ((p_incoming_data->cadence_rev_count_MSB << 8)
-                                        + p_incoming_data->cadence_rev_count_LSB);
-    uint16_t speed_event_time = (uint16_t)((p_incoming_data->speed_evt_time_MSB << 8) 
-                                + p_incoming_data->speed_evt_time_LSB);
-    uint16_t speed_revolution_count = (uint16_t) ((p_incoming_data->speed_rev_count_MSB << 8)
-                                      + p_incoming_data->speed_rev_count_LSB);
-
-    p_page_data->cadence_event_time = cadence_event_time;
-    p_page_data->cadence_rev_count  = cadence_revolution_count;
-    p_page_data->speed_event_time   = speed_event_time;
-    p_page_data->speed_rev_count    = speed_revolution_count;
-
-    comb_page0_data_log(p_page_data);
+    ant_page_codec_decode(&ant_bsc_combined_page_0_codec, p_page_buffer, p_page_data);
 }
-
@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for Bicycle Combined Speed and Cadence data page 0.
  *
@@ -44,6 +45,9 @@ typedef struct
         .speed_rev_count    = 0,         \
     }
 
+/**@brief Codec of combined page 0, for use in a page table. */
+extern ant_page_codec_t const ant_bsc_combined_page_0_codec;
+
 /**@brief Function for encoding page 0.
  *
  * @param[in]  p_page_data      Pointer to the page data.
@@ -12,20 +12,23 @@
 #include "ant_bsc_page_0.h"
 #include "ant_bsc_utils.h"
 #include "ant_bsc_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief BSC page 0 data layout structure. */
-typedef struct
+/**@brief Page 0 fields. */
+static ant_page_field_t const m_page0_fields[] =
 {
-    uint8_t reserved[3];
-    uint8_t bsc_evt_time_LSB;
-    uint8_t bsc_evt_time_MSB;
-    uint8_t bsc_rev_count_LSB;
-    uint8_t bsc_rev_count_MSB;
-}ant_bsc_page0_data_layout_t;
+    ANT_PAGE_RESERVED(0, 24),
+    ANT_PAGE_FIELD(ant_bsc_page0_data_t, event_time, 24, 16),
+    ANT_PAGE_FIELD(ant_bsc_page0_data_t, rev_count, 40, 16),
+};
 
 /**@brief Function for printing speed or cadence page0 data. */
-static void page0_data_log(ant_bsc_page0_data_t const * p_page_data)
+static void page0_data_log(void const * p_data)
 {
+    ant_bsc_page0_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE0("%-30s %u\n\r", "Revolution count:", (unsigned int)p_page_data->rev_count);
 
     LOG_PAGE0("%-30s %u.",
@@ -35,36 +38,17 @@ static void page0_data_log(ant_bsc_page0_data_t const * p_page_data)
     LOG_PAGE0("%03us\n\r", (unsigned int)ANT_BSC_EVENT_TIME_MSEC(p_page_data->event_time));
 }
 
-void ant_bsc_page_0_encode(uint8_t * p_page_buffer, ant_bsc_page0_data_t const * p_page_data)
-{
-    ant_bsc_page0_data_layout_t * p_outcoming_data = (ant_bsc_page0_data_layout_t *) p_page_buffer;
-    uint16_t                      event_time       = p_page_data->event_time;
-    uint16_t                      rev_count        = p_page_data->rev_count;
 
-    p_outcoming_data->reserved[0]       = UINT8_MAX;
-    p_outcoming_data->reserved[1]       = UINT8_MAX;
-    p_outcoming_data->reserved[2]       = UINT8_MAX;
-    p_outcoming_data->bsc_evt_time_LSB  = (uint8_t)(event_time & UINT8_MAX);
-    p_outcoming_data->bsc_evt_time_MSB  = (uint8_t)((event_time >> 8) & UINT8_MAX);
-    p_outcoming_data->bsc_rev_count_LSB = (uint8_t)(rev_count & UINT8_MAX);
-    p_outcoming_data->bsc_rev_count_MSB = (uint8_t)((rev_count >> 8) & UINT8_MAX);
+ANT_PAGE_CODEC_FIELDS_DEF(ant_bsc_page_0_codec, m_page0_fields, page0_data_log);
 
-    page0_data_log(p_page_data);
-}
 
-void ant_bsc_page_0_decode(uint8_t const * p_page_buffer, ant_bsc_page0_data_t * p_page_data)
+void ant_bsc_page_0_encode(uint8_t * p_page_buffer, ant_bsc_page0_data_t const * p_page_data)
 {
-    ant_bsc_page0_data_layout_t const * p_incoming_data = (ant_bsc_page0_data_layout_t *)p_page_buffer;
-
-    uint16_t event_time = (uint16_t)((p_incoming_data->bsc_evt_time_MSB << 8) 
-                          + p_incoming_data->bsc_evt_time_LSB);
-
-    uint16_t revolution_count = (uint16_t) ((p_incoming_data->bsc_rev_count_MSB << 8)
-                                + p_incoming_data->bsc_rev_count_LSB);
+    ant_page_codec_encode(&ant_bsc_page_0_codec, p_page_buffer, p_page_data);
+}
 
-    p_page_data->event_time = event_time;
-    p_page_data->rev_count  = revolution_count;
 
-    page0_data_log(p_page_data);
+void ant_bsc_page_0_decode(uint8_t const * p_page_buffer, ant_bsc_page0_data_t * p_page_data)
+{
+    ant_page_codec_decode(&ant_bsc_page_0_codec, p_page_buffer, p_page_data);
 }
-
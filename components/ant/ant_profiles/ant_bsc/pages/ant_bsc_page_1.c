@@ -15,16 +15,19 @@
 #include "app_util.h"
 #include "nordic_common.h"
 
-/**@brief BSC page 1 data layout structure. */
-typedef struct
+/**@brief Page 1 fields. */
+static ant_page_field_t const m_page1_fields[] =
 {
-    uint8_t cumulative_operating_time[3];
-    uint8_t reserved[4];
-}ant_bsc_page1_data_layout_t;
+    ANT_PAGE_FIELD(ant_bsc_page1_data_t, operating_time, 0, 24),
+};
 
 /**@brief Function for printing speed or cadence page1 data. */
-static void page1_data_log(ant_bsc_page1_data_t const * p_page_data)
+static void page1_data_log(void const * p_data)
 {
+    ant_bsc_page1_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE1("%-30s %ud ",
               "Cumulative operating time:",
               (unsigned int)ANT_BSC_OPERATING_DAYS(p_page_data->operating_time));
@@ -33,23 +36,17 @@ static void page1_data_log(ant_bsc_page1_data_t const * p_page_data)
     LOG_PAGE1("%us\n\r", (unsigned int)ANT_BSC_OPERATING_SECONDS(p_page_data->operating_time));
 }
 
+
+ANT_PAGE_CODEC_FIELDS_DEF(ant_bsc_page_1_codec, m_page1_fields, page1_data_log);
+
+
 void ant_bsc_page_1_encode(uint8_t * p_page_buffer, ant_bsc_page1_data_t const * p_page_data)
 {
-    ant_bsc_page1_data_layout_t * p_outcoming_data = (ant_bsc_page1_data_layout_t *)p_page_buffer;
-
-    UNUSED_PARAMETER(uint24_encode(p_page_data->operating_time,
-                     p_outcoming_data->cumulative_operating_time));
-    page1_data_log( p_page_data);
+    ant_page_codec_encode(&ant_bsc_page_1_codec, p_page_buffer, p_page_data);
 }
 
+
 void ant_bsc_page_1_decode(uint8_t const * p_page_buffer, ant_bsc_page1_data_t * p_page_data)
 {
-    ant_bsc_page1_data_layout_t const * p_incoming_data = (ant_bsc_page1_data_layout_t *)p_page_buffer;
-
-    p_page_data->operating_time = uint24_decode(p_incoming_data->cumulative_operating_time);
-
-    page1_data_log( p_page_data);
+    ant_page_codec_decode(&ant_bsc_page_1_codec, p_page_buffer, p_page_data);
 }
-
-
-
@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for BSC data page 1.
  *
@@ -38,6 +39,9 @@ typedef struct
         .operating_time      = 0,   \
     }
 
+/**@brief Codec of page 1, for use in a page table. */
+extern ant_page_codec_t const ant_bsc_page_1_codec;
+
 /**@brief Function for encoding page 1.
  *
  * @param[in]  p_page_data      Pointer to the page data.
@@ -11,46 +11,39 @@
  */
 #include "ant_bsc_page_2.h"
 #include "ant_bsc_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief BSC page 2 data layout structure. */
-typedef struct
+/**@brief Page 2 fields. */
+static ant_page_field_t const m_page2_fields[] =
 {
-    uint8_t manuf_id;
-    uint8_t serial_num_LSB;
-    uint8_t serial_num_MSB;
-    uint8_t reserved[4];
-}ant_bsc_page2_data_layout_t;
+    ANT_PAGE_FIELD(ant_bsc_page2_data_t, manuf_id, 0, 8),
+    ANT_PAGE_FIELD(ant_bsc_page2_data_t, serial_num, 8, 16),
+};
 
 /**@brief Function for printing speed or cadence page2 data. */
-static void page2_data_log(ant_bsc_page2_data_t const * p_page_data)
+static void page2_data_log(void const * p_data)
 {
+    ant_bsc_page2_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE2("%-30s %u\n\r", "Manufacturer ID:", (unsigned int)p_page_data->manuf_id);
     LOG_PAGE2("%-30s 0x%X\n\r",
               "Serial No (upper 16-bits):",
               (unsigned int)p_page_data->serial_num);
 }
 
+
+ANT_PAGE_CODEC_FIELDS_DEF(ant_bsc_page_2_codec, m_page2_fields, page2_data_log);
+
+
 void ant_bsc_page_2_encode(uint8_t * p_page_buffer, ant_bsc_page2_data_t const * p_page_data)
 {
-    ant_bsc_page2_data_layout_t * p_outcoming_data = (ant_bsc_page2_data_layout_t *)p_page_buffer;
-    uint32_t serial_num                            = p_page_data->serial_num;
-
-    p_outcoming_data->manuf_id       = (uint8_t)p_page_data->manuf_id;
-    p_outcoming_data->serial_num_LSB = (uint8_t)(serial_num & UINT8_MAX);
-    p_outcoming_data->serial_num_MSB = (uint8_t)((serial_num >> 8) & UINT8_MAX);
-    
-    page2_data_log( p_page_data);
+    ant_page_codec_encode(&ant_bsc_page_2_codec, p_page_buffer, p_page_data);
 }
 
+
 void ant_bsc_page_2_decode(uint8_t const * p_page_buffer, ant_bsc_page2_data_t * p_page_data)
 {
-    ant_bsc_page2_data_layout_t const * p_incoming_data = (ant_bsc_page2_data_layout_t *)p_page_buffer;
-    uint32_t serial_num = (uint32_t)((p_incoming_data->serial_num_MSB << 8) 
-                          + p_incoming_data->serial_num_LSB);
-
-    p_page_data->manuf_id            = (uint32_t)p_incoming_data->manuf_id;
-    p_page_data->serial_num          = serial_num;
-
-    page2_data_log( p_page_data);
+    ant_page_codec_decode(&ant_bsc_page_2_codec, p_page_buffer, p_page_data);
 }
-
@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for BSC data page 2.
  *
@@ -40,6 +41,9 @@ typedef struct
         .serial_num    = 0,         \
     }
 
+/**@brief Codec of page 2, for use in a page table. */
+extern ant_page_codec_t const ant_bsc_page_2_codec;
+
 /**@brief Function for encoding page 2.
  *
  * @param[in]  p_page_data      Pointer to the page data.
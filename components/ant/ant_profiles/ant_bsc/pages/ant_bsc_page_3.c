@@ -11,43 +11,39 @@
  */
 #include "ant_bsc_page_3.h"
 #include "ant_bsc_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief BSC page 3 data layout structure. */
-typedef struct
+/**@brief Page 3 fields. */
+static ant_page_field_t const m_page3_fields[] =
 {
-    uint8_t hw_version;
-    uint8_t sw_version;
-    uint8_t model_num;
-    uint8_t reserved[4];
-}ant_bsc_page3_data_layout_t;
+    ANT_PAGE_FIELD(ant_bsc_page3_data_t, hw_version, 0, 8),
+    ANT_PAGE_FIELD(ant_bsc_page3_data_t, sw_version, 8, 8),
+    ANT_PAGE_FIELD(ant_bsc_page3_data_t, model_num, 16, 8),
+};
 
 /**@brief Function for printing speed or cadence page3 data. */
-static void page3_data_log(ant_bsc_page3_data_t const * p_page_data)
+static void page3_data_log(void const * p_data)
 {
+    ant_bsc_page3_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE3("%-30s %u\n\r", "Hardware Rev ID:", (unsigned int)p_page_data->hw_version);
     LOG_PAGE3("%-30s %u\n\r", "Model:", (unsigned int)p_page_data->model_num);
     LOG_PAGE3("%-30s %u\n\r", "Software Ver ID:", (unsigned int)p_page_data->sw_version);
 }
 
+
+ANT_PAGE_CODEC_FIELDS_DEF(ant_bsc_page_3_codec, m_page3_fields, page3_data_log);
+
+
 void ant_bsc_page_3_encode(uint8_t * p_page_buffer, ant_bsc_page3_data_t const * p_page_data)
 {
-    ant_bsc_page3_data_layout_t * p_outcoming_data = (ant_bsc_page3_data_layout_t *)p_page_buffer;
-
-    p_outcoming_data->hw_version = (uint8_t)p_page_data->hw_version;
-    p_outcoming_data->sw_version = (uint8_t)p_page_data->sw_version;
-    p_outcoming_data->model_num  = (uint8_t)p_page_data->model_num;
-    
-    page3_data_log( p_page_data);
+    ant_page_codec_encode(&ant_bsc_page_3_codec, p_page_buffer, p_page_data);
 }
 
+
 void ant_bsc_page_3_decode(uint8_t const * p_page_buffer, ant_bsc_page3_data_t * p_page_data)
 {
-    ant_bsc_page3_data_layout_t const * p_incoming_data = (ant_bsc_page3_data_layout_t *)p_page_buffer;
-
-    p_page_data->hw_version          = (uint32_t)p_incoming_data->hw_version;
-    p_page_data->sw_version          = (uint32_t)p_incoming_data->sw_version;
-    p_page_data->model_num           = (uint32_t)p_incoming_data->model_num;
-
-    page3_data_log( p_page_data);
+    ant_page_codec_decode(&ant_bsc_page_3_codec, p_page_buffer, p_page_data);
 }
-
@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for BSC data page 3.
  *
@@ -42,6 +43,9 @@ typedef struct
         .model_num     = 0,         \
     }
 
+/**@brief Codec of page 3, for use in a page table. */
+extern ant_page_codec_t const ant_bsc_page_3_codec;
+
 /**@brief Function for encoding page 3.
  *
  * @param[in]  p_page_data      Pointer to the page data.
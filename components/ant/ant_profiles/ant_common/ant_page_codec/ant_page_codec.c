@@ -0,0 +1,210 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <string.h>
+#include "ant_page_codec.h"
+#include "nrf_assert.h"
+
+
+/**@brief Function for reading the member described by a field. */
+static uint32_t field_value_get(ant_page_field_t const * p_field, void const * p_data)
+{
+    uint8_t const * p_member = (uint8_t const *)p_data + p_field->data_offset;
+
+    switch (p_field->data_size)
+    {
+        case sizeof(uint8_t):
+            return *p_member;
+
+        case sizeof(uint16_t):
+        {
+            uint16_t value;
+            memcpy(&value, p_member, sizeof(value));
+            return value;
+        }
+
+        case sizeof(uint32_t):
+        {
+            uint32_t value;
+            memcpy(&value, p_member, sizeof(value));
+            return value;
+        }
+
+        default:
+            // Reserved field.
+            return UINT32_MAX;
+    }
+}
+
+
+/**@brief Function for writing the member described by a field. */
+static void field_value_set(ant_page_field_t const * p_field, void * p_data, uint32_t value)
+{
+    uint8_t * p_member = (uint8_t *)p_data + p_field->data_offset;
+
+    switch (p_field->data_size)
+    {
+        case sizeof(uint8_t):
+            *p_member = (uint8_t)value;
+            break;
+
+        case sizeof(uint16_t):
+        {
+            uint16_t member = (uint16_t)value;
+            memcpy(p_member, &member, sizeof(member));
+            break;
+        }
+
+        case sizeof(uint32_t):
+            memcpy(p_member, &value, sizeof(value));
+            break;
+
+        default:
+            // Reserved field.
+            break;
+    }
+}
+
+
+void ant_page_codec_encode(ant_page_codec_t const * p_codec,
+                           uint8_t                * p_page_buffer,
+                           void const             * p_data)
+{
+    ASSERT(p_codec != NULL);
+
+    for (uint32_t i = 0; i < p_codec->field_count; i++)
+    {
+        ant_page_field_t const * p_field = &p_codec->p_fields[i];
+        uint32_t                 value   = field_value_get(p_field, p_data);
+        uint32_t                 bit     = p_field->bit_offset;
+        uint32_t                 width   = p_field->bit_width;
+
+        while (width > 0)
+        {
+            uint32_t shift = bit % 8;
+            uint32_t count = (8 - shift < width) ? (8 - shift) : width;
+            uint8_t  mask  = (uint8_t)(((1u << count) - 1) << shift);
+
+            p_page_buffer[bit / 8] = (p_page_buffer[bit / 8] & ~mask)
+                                   | ((uint8_t)(value << shift) & mask);
+
+            value >>= count;
+            bit    += count;
+            width  -= count;
+        }
+    }
+
+    if (p_codec->encode_hook != NULL)
+    {
+        p_codec->encode_hook(p_page_buffer, p_data);
+    }
+
+    if (p_codec->log != NULL)
+    {
+        p_codec->log(p_data);
+    }
+}
+
+
+void ant_page_codec_decode(ant_page_codec_t const * p_codec,
+                           uint8_t const          * p_page_buffer,
+                           void                   * p_data)
+{
+    ASSERT(p_codec != NULL);
+
+    for (uint32_t i = 0; i < p_codec->field_count; i++)
+    {
+        ant_page_field_t const * p_field = &p_codec->p_fields[i];
+        uint32_t                 value   = 0;
+        uint32_t                 bit     = p_field->bit_offset;
+        uint32_t                 done    = 0;
+
+        if (p_field->data_size == 0)
+        {
+            continue;
+        }
+
+        while (done < p_field->bit_width)
+        {
+            uint32_t shift = bit % 8;
+            uint32_t count = (8 - shift < p_field->bit_width - done) ?
+                             (8 - shift) : (p_field->bit_width - done);
+            uint32_t bits  = (p_page_buffer[bit / 8] >> shift) & ((1u << count) - 1);
+
+            value |= bits << done;
+            bit   += count;
+            done  += count;
+        }
+
+        field_value_set(p_field, p_data, value);
+    }
+
+    if (p_codec->decode_hook != NULL)
+    {
+        p_codec->decode_hook(p_page_buffer, p_data);
+    }
+
+    if (p_codec->log != NULL)
+    {
+        p_codec->log(p_data);
+    }
+}
+
+
+ant_page_desc_t const * ant_page_table_find(ant_page_table_t const * p_table, uint8_t page_number)
+{
+    ASSERT(p_table != NULL);
+
+    for (uint32_t i = 0; i < p_table->page_count; i++)
+    {
+        if (p_table->p_pages[i].page_number == page_number)
+        {
+            return &p_table->p_pages[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+void ant_page_encode(ant_page_desc_t const * p_page,
+                     uint8_t               * p_page_buffer,
+                     void const            * p_profile)
+{
+    ASSERT(p_page != NULL);
+
+    for (uint32_t i = 0; i < p_page->part_count; i++)
+    {
+        ant_page_part_t const * p_part = &p_page->p_parts[i];
+
+        ant_page_codec_encode(p_part->p_codec,
+                              p_page_buffer,
+                              (uint8_t const *)p_profile + p_part->data_offset);
+    }
+}
+
+
+void ant_page_decode(ant_page_desc_t const * p_page,
+                     uint8_t const         * p_page_buffer,
+                     void                  * p_profile)
+{
+    ASSERT(p_page != NULL);
+
+    for (uint32_t i = 0; i < p_page->part_count; i++)
+    {
+        ant_page_part_t const * p_part = &p_page->p_parts[i];
+
+        ant_page_codec_decode(p_part->p_codec,
+                              p_page_buffer,
+                              (uint8_t *)p_profile + p_part->data_offset);
+    }
+}
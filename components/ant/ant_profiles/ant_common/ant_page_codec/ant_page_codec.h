@@ -0,0 +1,255 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup ant_page_codec ANT+ page codec
+ * @{
+ * @ingroup ant_sdk_utils
+ *
+ * @brief   Module for encoding and decoding ANT+ data pages from tables.
+ *
+ * @details A page codec describes how the data structure of a page maps onto the page payload:
+ *          a table of fields, each copying a member of the structure to a range of bits of the
+ *          payload, and optional hooks for the values which cannot be copied as they are (scaled,
+ *          split or bit field values). Bits are numbered from the least significant bit of the
+ *          first payload byte, multi-byte values are little endian as required by ANT+.
+ *
+ *          A profile describes each of its pages with a page descriptor, the list of the codecs
+ *          which make up the payload, each with the offset of its data in the profile instance,
+ *          and looks up the descriptor of the page number being sent or received in its page
+ *          table instead of dispatching on the page number.
+ */
+
+#ifndef ANT_PAGE_CODEC_H__
+#define ANT_PAGE_CODEC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**@brief Page field descriptor. */
+typedef struct
+{
+    uint16_t data_offset;   ///< Offset of the member in the page data structure.
+    uint8_t  data_size;     ///< Size of the member (1, 2 or 4 bytes). 0 for a reserved field.
+    uint8_t  bit_offset;    ///< Position of the field in the page payload, in bits.
+    uint8_t  bit_width;     ///< Width of the field, from 1 to 32 bits.
+} ant_page_field_t;
+
+/**@brief Macro for describing a field copied from a member of a page data structure.
+ *
+ * @param[in]  TYPE         Page data structure type.
+ * @param[in]  MEMBER       Member of the structure. Bit field members cannot be used.
+ * @param[in]  BIT_OFFSET   Position of the field in the page payload, in bits.
+ * @param[in]  BIT_WIDTH    Width of the field, in bits.
+ */
+#define ANT_PAGE_FIELD(TYPE, MEMBER, BIT_OFFSET, BIT_WIDTH) \
+    {                                                       \
+        .data_offset = offsetof(TYPE, MEMBER),              \
+        .data_size   = sizeof(((TYPE *)0)->MEMBER),         \
+        .bit_offset  = (BIT_OFFSET),                        \
+        .bit_width   = (BIT_WIDTH),                         \
+    }
+
+/**@brief Macro for describing a reserved field, set to all ones when encoding and ignored when
+ *        decoding.
+ *
+ * @param[in]  BIT_OFFSET   Position of the field in the page payload, in bits.
+ * @param[in]  BIT_WIDTH    Width of the field, in bits.
+ */
+#define ANT_PAGE_RESERVED(BIT_OFFSET, BIT_WIDTH) \
+    {                                            \
+        .data_offset = 0,                        \
+        .data_size   = 0,                        \
+        .bit_offset  = (BIT_OFFSET),             \
+        .bit_width   = (BIT_WIDTH),              \
+    }
+
+/**@brief Page encoding hook, called after the fields are encoded. */
+typedef void (*ant_page_encode_hook_t)(uint8_t * p_page_buffer, void const * p_data);
+
+/**@brief Page decoding hook, called after the fields are decoded. */
+typedef void (*ant_page_decode_hook_t)(uint8_t const * p_page_buffer, void * p_data);
+
+/**@brief Page data tracing function, called after the page is encoded or decoded. */
+typedef void (*ant_page_log_t)(void const * p_data);
+
+/**@brief Page codec. */
+typedef struct
+{
+    ant_page_field_t const * p_fields;      ///< Field table. Can be NULL.
+    uint8_t                  field_count;   ///< Number of fields.
+    ant_page_encode_hook_t   encode_hook;   ///< Encoding hook. Can be NULL.
+    ant_page_decode_hook_t   decode_hook;   ///< Decoding hook. Can be NULL.
+    ant_page_log_t           log;           ///< Tracing function. Can be NULL.
+} ant_page_codec_t;
+
+/**@brief Macro for defining a codec built from a field table.
+ *
+ * @param[in]  NAME     Name of the codec.
+ * @param[in]  FIELDS   Field table, an array of @ref ant_page_field_t.
+ * @param[in]  LOG      Tracing function, or NULL.
+ */
+#define ANT_PAGE_CODEC_FIELDS_DEF(NAME, FIELDS, LOG)                    \
+    ant_page_codec_t const NAME =                                       \
+    {                                                                   \
+        .p_fields    = (FIELDS),                                        \
+        .field_count = sizeof(FIELDS) / sizeof((FIELDS)[0]),            \
+        .encode_hook = NULL,                                            \
+        .decode_hook = NULL,                                            \
+        .log         = (LOG),                                           \
+    }
+
+/**@brief Macro for defining a static codec wrapping the encoding and decoding functions of a
+ *        page which cannot be described with fields.
+ *
+ * @param[in]  NAME     Name of the codec.
+ * @param[in]  ENCODE   Page encoding function, taking the payload and the page data.
+ * @param[in]  DECODE   Page decoding function, taking the payload and the page data.
+ */
+#define ANT_PAGE_CODEC_HOOKS_DEF(NAME, ENCODE, DECODE)                      \
+    static void NAME##_encode(uint8_t * p_page_buffer, void const * p_data) \
+    {                                                                       \
+        ENCODE(p_page_buffer, p_data);                                      \
+    }                                                                       \
+    static void NAME##_decode(uint8_t const * p_page_buffer, void * p_data) \
+    {                                                                       \
+        DECODE(p_page_buffer, p_data);                                      \
+    }                                                                       \
+    static ant_page_codec_t const NAME =                                    \
+    {                                                                       \
+        .p_fields    = NULL,                                                \
+        .field_count = 0,                                                   \
+        .encode_hook = NAME##_encode,                                       \
+        .decode_hook = NAME##_decode,                                       \
+        .log         = NULL,                                                \
+    }
+
+/**@brief Part of a page payload: a codec and the location of its data in the profile. */
+typedef struct
+{
+    ant_page_codec_t const * p_codec;       ///< Codec.
+    uint16_t                 data_offset;   ///< Offset of the codec data in the profile instance.
+} ant_page_part_t;
+
+/**@brief Macro for describing a page part.
+ *
+ * @param[in]  CODEC    Pointer to the codec.
+ * @param[in]  TYPE     Profile instance type.
+ * @param[in]  MEMBER   Member of the profile instance holding the codec data.
+ */
+#define ANT_PAGE_PART(CODEC, TYPE, MEMBER)              \
+    {                                                   \
+        .p_codec     = (CODEC),                         \
+        .data_offset = offsetof(TYPE, MEMBER),          \
+    }
+
+/**@brief Page descriptor. */
+typedef struct
+{
+    uint8_t                 page_number;    ///< Page number.
+    uint8_t                 part_count;     ///< Number of parts.
+    ant_page_part_t const * p_parts;        ///< Parts, encoded and decoded in order. Can be NULL.
+} ant_page_desc_t;
+
+/**@brief Macro for describing a page made of the parts of an array.
+ *
+ * @param[in]  PAGE_NUMBER  Page number.
+ * @param[in]  PARTS        Array of @ref ant_page_part_t.
+ */
+#define ANT_PAGE_DESC(PAGE_NUMBER, PARTS)                       \
+    {                                                           \
+        .page_number = (PAGE_NUMBER),                           \
+        .part_count  = sizeof(PARTS) / sizeof((PARTS)[0]),      \
+        .p_parts     = (PARTS),                                 \
+    }
+
+/**@brief Macro for describing a page with no data of its own. */
+#define ANT_PAGE_DESC_EMPTY(PAGE_NUMBER)    \
+    {                                       \
+        .page_number = (PAGE_NUMBER),       \
+        .part_count  = 0,                   \
+        .p_parts     = NULL,                \
+    }
+
+/**@brief Page table. */
+typedef struct
+{
+    ant_page_desc_t const * p_pages;        ///< Page descriptors.
+    uint8_t                 page_count;     ///< Number of page descriptors.
+} ant_page_table_t;
+
+/**@brief Macro for defining a static page table from an array of page descriptors.
+ *
+ * @param[in]  NAME     Name of the table.
+ * @param[in]  PAGES    Array of @ref ant_page_desc_t.
+ */
+#define ANT_PAGE_TABLE_DEF(NAME, PAGES)                         \
+    static ant_page_table_t const NAME =                        \
+    {                                                           \
+        .p_pages    = (PAGES),                                  \
+        .page_count = sizeof(PAGES) / sizeof((PAGES)[0]),       \
+    }
+
+/**@brief Function for encoding page data with a codec.
+ *
+ * @details Only the bits of the fields are written, so that several codecs can share a payload.
+ *
+ * @param[in]  p_codec          Pointer to the codec.
+ * @param[out] p_page_buffer    Pointer to the page payload.
+ * @param[in]  p_data           Pointer to the page data.
+ */
+void ant_page_codec_encode(ant_page_codec_t const * p_codec,
+                           uint8_t                * p_page_buffer,
+                           void const             * p_data);
+
+/**@brief Function for decoding page data with a codec.
+ *
+ * @param[in]  p_codec          Pointer to the codec.
+ * @param[in]  p_page_buffer    Pointer to the page payload.
+ * @param[out] p_data           Pointer to the page data.
+ */
+void ant_page_codec_decode(ant_page_codec_t const * p_codec,
+                           uint8_t const          * p_page_buffer,
+                           void                   * p_data);
+
+/**@brief Function for looking up a page descriptor.
+ *
+ * @param[in]  p_table      Pointer to the page table.
+ * @param[in]  page_number  Page number.
+ *
+ * @return     Pointer to the page descriptor, or NULL if the page is not in the table.
+ */
+ant_page_desc_t const * ant_page_table_find(ant_page_table_t const * p_table, uint8_t page_number);
+
+/**@brief Function for encoding all parts of a page.
+ *
+ * @param[in]  p_page           Pointer to the page descriptor.
+ * @param[out] p_page_buffer    Pointer to the page payload.
+ * @param[in]  p_profile        Pointer to the profile instance.
+ */
+void ant_page_encode(ant_page_desc_t const * p_page,
+                     uint8_t               * p_page_buffer,
+                     void const            * p_profile);
+
+/**@brief Function for decoding all parts of a page.
+ *
+ * @param[in]  p_page           Pointer to the page descriptor.
+ * @param[in]  p_page_buffer    Pointer to the page payload.
+ * @param[out] p_profile        Pointer to the profile instance.
+ */
+void ant_page_decode(ant_page_desc_t const * p_page,
+                     uint8_t const         * p_page_buffer,
+                     void                  * p_profile);
+
+#endif // ANT_PAGE_CODEC_H__
+/** @} */
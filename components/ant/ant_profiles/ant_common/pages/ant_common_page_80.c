@@ -16,58 +16,44 @@
 #include "app_util.h"
 #include "nordic_common.h"
 
-/**@brief ant+ common page 80 data layout structure. */
-typedef struct
+/**@brief Page 80 fields. */
+static ant_page_field_t const m_page80_fields[] =
 {
-    uint8_t reserved[2]; ///< unused, fill by 0xFF
-    uint8_t hw_revision;
-    uint8_t manufacturer_id[2];
-    uint8_t model_number[2];
-}ant_common_page80_data_layout_t;
+    ANT_PAGE_RESERVED(0, 16),
+    ANT_PAGE_FIELD(ant_common_page80_data_t, hw_revision, 16, 8),
+    ANT_PAGE_FIELD(ant_common_page80_data_t, manufacturer_id, 24, 16),
+    ANT_PAGE_FIELD(ant_common_page80_data_t, model_number, 40, 16),
+};
 
 
 /**@brief Function for tracing page 80 data.
  *
- * @param[in]  p_page_data      Pointer to the page 80 data.
+ * @param[in]  p_data           Pointer to the page 80 data.
  */
-static void page80_data_log(volatile ant_common_page80_data_t const * p_page_data)
+static void page80_data_log(void const * p_data)
 {
+    volatile ant_common_page80_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE80("hw revision:                      %u\n\r", p_page_data->hw_revision);
     LOG_PAGE80("manufacturer id:                  %u\n\r", p_page_data->manufacturer_id);
     LOG_PAGE80("model number:                     %u\n\r", p_page_data->model_number);
 }
 
 
+ANT_PAGE_CODEC_FIELDS_DEF(ant_common_page_80_codec, m_page80_fields, page80_data_log);
+
+
 void ant_common_page_80_encode(uint8_t                                 * p_page_buffer,
                                volatile ant_common_page80_data_t const * p_page_data)
 {
-    ant_common_page80_data_layout_t * p_outcoming_data =
-        (ant_common_page80_data_layout_t *)p_page_buffer;
-
-    memset(p_page_buffer, UINT8_MAX, sizeof (p_outcoming_data->reserved));
-
-    p_outcoming_data->hw_revision = p_page_data->hw_revision;
-
-    UNUSED_PARAMETER(uint16_encode(p_page_data->manufacturer_id,
-                                   p_outcoming_data->manufacturer_id));
-    UNUSED_PARAMETER(uint16_encode(p_page_data->model_number, p_outcoming_data->model_number));
-
-    page80_data_log(p_page_data);
+    ant_page_codec_encode(&ant_common_page_80_codec, p_page_buffer, (void const *)p_page_data);
 }
 
 
 void ant_common_page_80_decode(uint8_t const                     * p_page_buffer,
                                volatile ant_common_page80_data_t * p_page_data)
 {
-    ant_common_page80_data_layout_t const * p_incoming_data =
-        (ant_common_page80_data_layout_t *)p_page_buffer;
-
-    p_page_data->hw_revision = p_incoming_data->hw_revision;
-
-    p_page_data->manufacturer_id = uint16_decode(p_incoming_data->manufacturer_id);
-    p_page_data->model_number    = uint16_decode(p_incoming_data->model_number);
-
-    page80_data_log(p_page_data);
+    ant_page_codec_decode(&ant_common_page_80_codec, p_page_buffer, (void *)p_page_data);
 }
-
-
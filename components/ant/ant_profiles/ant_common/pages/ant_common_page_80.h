@@ -30,6 +30,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 #define ANT_COMMON_PAGE_80 (80) ///< @brief ID value of common page 80.
 
@@ -64,6 +65,9 @@ typedef struct
         .model_number    = (mod_num),               \
     }
 
+/**@brief Codec of page 80, for use in a page table. */
+extern ant_page_codec_t const ant_common_page_80_codec;
+
 /**@brief Function for encoding page 80.
  *
  * @param[in]  p_page_data      Pointer to the page data.
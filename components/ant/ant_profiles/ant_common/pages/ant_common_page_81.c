@@ -15,22 +15,26 @@
 #include "app_util.h"
 #include "nordic_common.h"
 
-/**@brief ant+ common page 81 data layout structure. */
-typedef struct
+/**@brief Page 81 fields. */
+static ant_page_field_t const m_page81_fields[] =
 {
-    uint8_t reserved; ///< unused, fill by 0xFF
-    uint8_t sw_revision_minor;
-    uint8_t sw_revision_major;
-    uint8_t serial_number[4];
-}ant_common_page81_data_layout_t;
+    ANT_PAGE_RESERVED(0, 8),
+    ANT_PAGE_FIELD(ant_common_page81_data_t, sw_revision_minor, 8, 8),
+    ANT_PAGE_FIELD(ant_common_page81_data_t, sw_revision_major, 16, 8),
+    ANT_PAGE_FIELD(ant_common_page81_data_t, serial_number, 24, 32),
+};
 
 
 /**@brief Function for tracing page 80 data.
  *
- * @param[in]  p_page_data      Pointer to the page 80 data.
+ * @param[in]  p_data           Pointer to the page 80 data.
  */
-static void page81_data_log(volatile ant_common_page81_data_t const * p_page_data)
+static void page81_data_log(void const * p_data)
 {
+    volatile ant_common_page81_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     if (p_page_data->sw_revision_minor != UINT8_MAX)
     {
         LOG_PAGE81("sw revision:                      %u.%u\n\r",
@@ -46,35 +50,18 @@ static void page81_data_log(volatile ant_common_page81_data_t const * p_page_dat
 }
 
 
+ANT_PAGE_CODEC_FIELDS_DEF(ant_common_page_81_codec, m_page81_fields, page81_data_log);
+
+
 void ant_common_page_81_encode(uint8_t                                 * p_page_buffer,
                                volatile ant_common_page81_data_t const * p_page_data)
 {
-    ant_common_page81_data_layout_t * p_outcoming_data =
-        (ant_common_page81_data_layout_t *)p_page_buffer;
-
-    p_outcoming_data->reserved = UINT8_MAX;
-
-    p_outcoming_data->sw_revision_minor = p_page_data->sw_revision_minor;
-    p_outcoming_data->sw_revision_major = p_page_data->sw_revision_major;
-
-    UNUSED_PARAMETER(uint32_encode(p_page_data->serial_number, p_outcoming_data->serial_number));
-
-    page81_data_log(p_page_data);
+    ant_page_codec_encode(&ant_common_page_81_codec, p_page_buffer, (void const *)p_page_data);
 }
 
 
 void ant_common_page_81_decode(uint8_t const                     * p_page_buffer,
                                volatile ant_common_page81_data_t * p_page_data)
 {
-    ant_common_page81_data_layout_t const * p_incoming_data =
-        (ant_common_page81_data_layout_t *)p_page_buffer;
-
-    p_page_data->sw_revision_minor = p_incoming_data->sw_revision_minor;
-    p_page_data->sw_revision_major = p_incoming_data->sw_revision_major;
-
-    p_page_data->serial_number = uint32_decode(p_incoming_data->serial_number);
-
-    page81_data_log(p_page_data);
+    ant_page_codec_decode(&ant_common_page_81_codec, p_page_buffer, (void *)p_page_data);
 }
-
-
@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 #define ANT_COMMON_PAGE_81 (81) ///< @brief ID value of common page 81.
 
@@ -55,6 +56,9 @@ typedef struct
         .serial_number     = (seril_no),                                \
     }
 
+/**@brief Codec of page 81, for use in a page table. */
+extern ant_page_codec_t const ant_common_page_81_codec;
+
 /**@brief Function for encoding page 81.
  *
  * @param[in]  p_page_data      Pointer to the page data.
@@ -16,6 +16,7 @@
 #include "ant_hrm.h"
 #include "ant_hrm_utils.h"
 #include "ant_hrm_page_logger.h"
+#include "ant_page_codec.h"
 #include "app_error.h"
 
 #define BACKGROUND_DATA_INTERVAL 64 /**< The number of main data pages sent between background data page.
@@ -30,6 +31,38 @@ typedef struct
     uint8_t        page_payload[7];
 } ant_hrm_message_layout_t;
 
+static ant_page_part_t const m_page_1_parts[] =
+{
+    ANT_PAGE_PART(&ant_hrm_page_1_codec, ant_hrm_profile_t, page_1),
+};
+
+static ant_page_part_t const m_page_2_parts[] =
+{
+    ANT_PAGE_PART(&ant_hrm_page_2_codec, ant_hrm_profile_t, page_2),
+};
+
+static ant_page_part_t const m_page_3_parts[] =
+{
+    ANT_PAGE_PART(&ant_hrm_page_3_codec, ant_hrm_profile_t, page_3),
+};
+
+static ant_page_part_t const m_page_4_parts[] =
+{
+    ANT_PAGE_PART(&ant_hrm_page_4_codec, ant_hrm_profile_t, page_4),
+};
+
+/**@brief HRM pages. Page 0 is present in each message, so it is not part of the other pages. */
+static ant_page_desc_t const m_pages[] =
+{
+    ANT_PAGE_DESC_EMPTY(ANT_HRM_PAGE_0),
+    ANT_PAGE_DESC(ANT_HRM_PAGE_1, m_page_1_parts),
+    ANT_PAGE_DESC(ANT_HRM_PAGE_2, m_page_2_parts),
+    ANT_PAGE_DESC(ANT_HRM_PAGE_3, m_page_3_parts),
+    ANT_PAGE_DESC(ANT_HRM_PAGE_4, m_page_4_parts),
+};
+
+ANT_PAGE_TABLE_DEF(m_page_table, m_pages);
+
 /**@brief Function for initializing the ANT HRM profile instance.
  *
  * @param[in]  p_profile        Pointer to the profile instance.
@@ -142,41 +175,27 @@ static void sens_message_encode(ant_hrm_profile_t * p_profile, uint8_t * p_messa
 {
     ant_hrm_message_layout_t * p_hrm_message_payload =
         (ant_hrm_message_layout_t *)p_message_payload;
-    ant_hrm_sens_cb_t * p_hrm_cb = p_profile->_cb.p_sens_cb;
+    ant_hrm_sens_cb_t     * p_hrm_cb = p_profile->_cb.p_sens_cb;
+    ant_page_desc_t const * p_page;
 
     p_hrm_message_payload->page_number = next_page_number_get(p_profile);
     p_hrm_message_payload->toggle_bit  = p_hrm_cb->toggle_bit;
 
     LOG_HRM("HRM TX Page number:               %u\n\r", p_hrm_message_payload->page_number);
 
-    ant_hrm_page_0_encode(p_hrm_message_payload->page_payload, &(p_profile->page_0)); // Page 0 is present in each message
-
-    switch (p_hrm_message_payload->page_number)
-    {
-        case ANT_HRM_PAGE_0:
-            // No implementation needed
-            break;
-
-        case ANT_HRM_PAGE_1:
-            ant_hrm_page_1_encode(p_hrm_message_payload->page_payload, &(p_profile->page_1));
-            break;
-
-        case ANT_HRM_PAGE_2:
-            ant_hrm_page_2_encode(p_hrm_message_payload->page_payload, &(p_profile->page_2));
-            break;
-
-        case ANT_HRM_PAGE_3:
-            ant_hrm_page_3_encode(p_hrm_message_payload->page_payload, &(p_profile->page_3));
-            break;
+    ant_page_codec_encode(&ant_hrm_page_0_codec,
+                          p_hrm_message_payload->page_payload,
+                          &(p_profile->page_0)); // Page 0 is present in each message
 
-        case ANT_HRM_PAGE_4:
-            ant_hrm_page_4_encode(p_hrm_message_payload->page_payload, &(p_profile->page_4));
-            break;
+    p_page = ant_page_table_find(&m_page_table, p_hrm_message_payload->page_number);
 
-        default:
-            LOG_HRM("\r\n");
-            return;
+    if (p_page == NULL)
+    {
+        LOG_HRM("\r\n");
+        return;
     }
+
+    ant_page_encode(p_page, p_hrm_message_payload->page_payload, p_profile);
     LOG_HRM("\r\n");
     p_profile->evt_handler(p_profile, (ant_hrm_evt_t)p_hrm_message_payload->page_number);
 }
@@ -246,37 +265,23 @@ static void disp_message_decode(ant_hrm_profile_t * p_profile, uint8_t * p_messa
 {
     const ant_hrm_message_layout_t * p_hrm_message_payload =
         (ant_hrm_message_layout_t *)p_message_payload;
+    ant_page_desc_t const * p_page;
 
     LOG_HRM("HRM RX Page Number:               %u\n\r", p_hrm_message_payload->page_number);
 
-    ant_hrm_page_0_decode(p_hrm_message_payload->page_payload, &(p_profile->page_0)); // Page 0 is present in each message
+    ant_page_codec_decode(&ant_hrm_page_0_codec,
+                          p_hrm_message_payload->page_payload,
+                          &(p_profile->page_0)); // Page 0 is present in each message
 
-    switch (p_hrm_message_payload->page_number)
-    {
-        case ANT_HRM_PAGE_0:
-            // No implementation needed
-            break;
+    p_page = ant_page_table_find(&m_page_table, p_hrm_message_payload->page_number);
 
-        case ANT_HRM_PAGE_1:
-            ant_hrm_page_1_decode(p_hrm_message_payload->page_payload, &(p_profile->page_1));
-            break;
-
-        case ANT_HRM_PAGE_2:
-            ant_hrm_page_2_decode(p_hrm_message_payload->page_payload, &(p_profile->page_2));
-            break;
-
-        case ANT_HRM_PAGE_3:
-            ant_hrm_page_3_decode(p_hrm_message_payload->page_payload, &(p_profile->page_3));
-            break;
-
-        case ANT_HRM_PAGE_4:
-            ant_hrm_page_4_decode(p_hrm_message_payload->page_payload, &(p_profile->page_4));
-            break;
-
-        default:
-            LOG_HRM("\r\n");
-            return;
+    if (p_page == NULL)
+    {
+        LOG_HRM("\r\n");
+        return;
     }
+
+    ant_page_decode(p_page, p_hrm_message_payload->page_payload, p_profile);
     LOG_HRM("\r\n");
 
     p_profile->evt_handler(p_profile, (ant_hrm_evt_t)p_hrm_message_payload->page_number);
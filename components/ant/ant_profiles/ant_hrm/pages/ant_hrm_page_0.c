@@ -12,24 +12,28 @@
 #include "ant_hrm_page_0.h"
 #include "ant_hrm_utils.h"
 #include "ant_hrm_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief HRM page 0 data layout structure. */
-typedef struct
+/**@brief Page 0 fields. */
+static ant_page_field_t const m_page0_fields[] =
 {
-    uint8_t reserved[3];
-    uint8_t heart_beat_evt_time_LSB;
-    uint8_t heart_beat_evt_time_MSB;
-    uint8_t heart_beat_count;
-    uint8_t computed_heart_rate;
-}ant_hrm_page0_data_layout_t;
+    ANT_PAGE_RESERVED(0, 24),
+    ANT_PAGE_FIELD(ant_hrm_page0_data_t, beat_time, 24, 16),
+    ANT_PAGE_FIELD(ant_hrm_page0_data_t, beat_count, 40, 8),
+    ANT_PAGE_FIELD(ant_hrm_page0_data_t, computed_heart_rate, 48, 8),
+};
 
 /**@brief Function for tracing page 0 and common data.
  *
  * @param[in]  p_common_data    Pointer to the common data.
- * @param[in]  p_page_data      Pointer to the page 0 data.
+ * @param[in]  p_data           Pointer to the page 0 data.
  */
-static void page0_data_log(ant_hrm_page0_data_t const * p_page_data)
+static void page0_data_log(void const * p_data)
 {
+    ant_hrm_page0_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE0("Heart beat count:                 %u\n\r", (unsigned int)p_page_data->beat_count);
     LOG_PAGE0("Computed heart rate:              %u\n\r",
               (unsigned int)p_page_data->computed_heart_rate);
@@ -39,38 +43,18 @@ static void page0_data_log(ant_hrm_page0_data_t const * p_page_data)
 }
 
 
+ANT_PAGE_CODEC_FIELDS_DEF(ant_hrm_page_0_codec, m_page0_fields, page0_data_log);
+
+
 void ant_hrm_page_0_encode(uint8_t                    * p_page_buffer,
                            ant_hrm_page0_data_t const * p_page_data)
 {
-    ant_hrm_page0_data_layout_t * p_outcoming_data = (ant_hrm_page0_data_layout_t *)p_page_buffer;
-    uint32_t                      beat_time        = p_page_data->beat_time;
-
-    p_outcoming_data->reserved[0]             = UINT8_MAX;
-    p_outcoming_data->reserved[1]             = UINT8_MAX;
-    p_outcoming_data->reserved[2]             = UINT8_MAX;
-    p_outcoming_data->heart_beat_evt_time_LSB = (uint8_t)(beat_time & UINT8_MAX);
-    p_outcoming_data->heart_beat_evt_time_MSB = (uint8_t)((beat_time >> 8) & UINT8_MAX);
-    p_outcoming_data->heart_beat_count        = (uint8_t)p_page_data->beat_count;
-    p_outcoming_data->computed_heart_rate     = (uint8_t)p_page_data->computed_heart_rate;
-
-    page0_data_log(p_page_data);
+    ant_page_codec_encode(&ant_hrm_page_0_codec, p_page_buffer, p_page_data);
 }
 
 
 void ant_hrm_page_0_decode(uint8_t const        * p_page_buffer,
                            ant_hrm_page0_data_t * p_page_data)
 {
-    ant_hrm_page0_data_layout_t const * p_incoming_data =
-        (ant_hrm_page0_data_layout_t *)p_page_buffer;
-
-    uint32_t beat_time = (uint32_t)((p_incoming_data->heart_beat_evt_time_MSB << 8)
-                                    + p_incoming_data->heart_beat_evt_time_LSB);
-
-    p_page_data->beat_count          = (uint32_t)p_incoming_data->heart_beat_count;
-    p_page_data->computed_heart_rate = (uint32_t)p_incoming_data->computed_heart_rate;
-    p_page_data->beat_time           = beat_time;
-
-    page0_data_log(p_page_data);
+    ant_page_codec_decode(&ant_hrm_page_0_codec, p_page_buffer, p_page_data);
 }
-
-
@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for HRM data page 0.
  *
@@ -42,6 +43,9 @@ typedef struct
         .beat_time           = 0, \
     }
 
+/**@brief Codec of page 0, for use in a page table. */
+extern ant_page_codec_t const ant_hrm_page_0_codec;
+
 /**@brief Function for encoding page 0.
  *
  * @param[in]  p_page_data      Pointer to the page data.
@@ -15,20 +15,23 @@
 #include "app_util.h"
 #include "nordic_common.h"
 
-/**@brief HRM page 1 data layout structure. */
-typedef struct
+/**@brief Page 1 fields. */
+static ant_page_field_t const m_page1_fields[] =
 {
-    uint8_t cumulative_operating_time[3];
-    uint8_t reserved[4];
-}ant_hrm_page1_data_layout_t;
+    ANT_PAGE_FIELD(ant_hrm_page1_data_t, operating_time, 0, 24),
+};
 
 /**@brief Function for tracing page 1 and common data.
  *
  * @param[in]  p_common_data    Pointer to the common data.
- * @param[in]  p_page_data      Pointer to the page 1 data.
+ * @param[in]  p_data           Pointer to the page 1 data.
  */
-static void page1_data_log(ant_hrm_page1_data_t const * p_page_data)
+static void page1_data_log(void const * p_data)
 {
+    ant_hrm_page1_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE1("Cumulative operating time:        %ud ",
               (unsigned int)ANT_HRM_OPERATING_DAYS(p_page_data->operating_time));
     LOG_PAGE1("%uh ", (unsigned int)ANT_HRM_OPERATING_HOURS(p_page_data->operating_time));
@@ -37,28 +40,18 @@ static void page1_data_log(ant_hrm_page1_data_t const * p_page_data)
 }
 
 
+ANT_PAGE_CODEC_FIELDS_DEF(ant_hrm_page_1_codec, m_page1_fields, page1_data_log);
+
+
 void ant_hrm_page_1_encode(uint8_t                    * p_page_buffer,
                            ant_hrm_page1_data_t const * p_page_data)
 {
-    ant_hrm_page1_data_layout_t * p_outcoming_data = (ant_hrm_page1_data_layout_t *)p_page_buffer;
-    uint32_t                      operating_time   = p_page_data->operating_time;
-
-    UNUSED_PARAMETER(uint24_encode(operating_time, p_outcoming_data->cumulative_operating_time));
-    page1_data_log(p_page_data);
+    ant_page_codec_encode(&ant_hrm_page_1_codec, p_page_buffer, p_page_data);
 }
 
 
 void ant_hrm_page_1_decode(uint8_t const        * p_page_buffer,
                            ant_hrm_page1_data_t * p_page_data)
 {
-    ant_hrm_page1_data_layout_t const * p_incoming_data =
-        (ant_hrm_page1_data_layout_t *)p_page_buffer;
-
-    uint32_t operating_time = uint24_decode(p_incoming_data->cumulative_operating_time);
-
-    p_page_data->operating_time = operating_time;
-
-    page1_data_log(p_page_data);
+    ant_page_codec_decode(&ant_hrm_page_1_codec, p_page_buffer, p_page_data);
 }
-
-
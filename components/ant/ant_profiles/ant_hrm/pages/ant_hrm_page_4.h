@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for HRM data page 4.
  *
@@ -40,6 +41,9 @@ typedef struct
         .prev_beat  = 0,        \
     }
 
+/**@brief Codec of page 4, for use in a page table. */
+extern ant_page_codec_t const ant_hrm_page_4_codec;
+
 /**@brief Function for encoding page 4.
  *
  * @param[in]  p_page_data      Pointer to the page data.
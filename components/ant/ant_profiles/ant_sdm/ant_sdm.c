@@ -18,6 +18,7 @@
 #include "app_error.h"
 #include "ant_sdm_page_logger.h"
 #include "ant_sdm_utils.h"
+#include "ant_page_codec.h"
 #include "nordic_common.h"
 
 #define COMMON_DATA_INTERVAL 64          /**< Common data page is sent every 65th message. */
@@ -29,6 +30,92 @@ typedef struct
     uint8_t         page_payload[7];
 }ant_sdm_message_layout_t;
 
+/**@brief Function for encoding page 1, which uses both the page 1 and the common data. */
+static void page_1_encode(uint8_t * p_page_buffer, void const * p_data)
+{
+    ant_sdm_profile_t const * p_profile = p_data;
+
+    ant_sdm_page_1_encode(p_page_buffer, &(p_profile->page_1), &(p_profile->common));
+}
+
+/**@brief Function for decoding page 1, which updates both the page 1 and the common data. */
+static void page_1_decode(uint8_t const * p_page_buffer, void * p_data)
+{
+    ant_sdm_profile_t * p_profile = p_data;
+
+    ant_sdm_page_1_decode(p_page_buffer, &(p_profile->page_1), &(p_profile->common));
+}
+
+/**@brief Page 1 codec, working on the whole profile instance. */
+static ant_page_codec_t const m_page_1_codec =
+{
+    .p_fields    = NULL,
+    .field_count = 0,
+    .encode_hook = page_1_encode,
+    .decode_hook = page_1_decode,
+    .log         = NULL,
+};
+
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_2_codec, ant_sdm_page_2_encode, ant_sdm_page_2_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_page_16_codec, ant_sdm_page_16_encode, ant_sdm_page_16_decode);
+ANT_PAGE_CODEC_HOOKS_DEF(m_speed_codec, ant_sdm_speed_encode, ant_sdm_speed_decode);
+
+static ant_page_part_t const m_page_1_parts[] =
+{
+    {
+        .p_codec     = &m_page_1_codec,
+        .data_offset = 0,
+    },
+    ANT_PAGE_PART(&m_speed_codec, ant_sdm_profile_t, common),
+};
+
+static ant_page_part_t const m_page_2_parts[] =
+{
+    ANT_PAGE_PART(&m_page_2_codec, ant_sdm_profile_t, page_2),
+    ANT_PAGE_PART(&m_speed_codec, ant_sdm_profile_t, common),
+};
+
+static ant_page_part_t const m_page_3_parts[] =
+{
+    ANT_PAGE_PART(&m_page_2_codec, ant_sdm_profile_t, page_2),
+    ANT_PAGE_PART(&ant_sdm_page_3_codec, ant_sdm_profile_t, page_3),
+    ANT_PAGE_PART(&m_speed_codec, ant_sdm_profile_t, common),
+};
+
+static ant_page_part_t const m_page_16_parts[] =
+{
+    ANT_PAGE_PART(&m_page_16_codec, ant_sdm_profile_t, common),
+};
+
+static ant_page_part_t const m_page_22_parts[] =
+{
+    ANT_PAGE_PART(&ant_sdm_page_22_codec, ant_sdm_profile_t, page_22),
+};
+
+static ant_page_part_t const m_page_80_parts[] =
+{
+    ANT_PAGE_PART(&ant_common_page_80_codec, ant_sdm_profile_t, page_80),
+};
+
+static ant_page_part_t const m_page_81_parts[] =
+{
+    ANT_PAGE_PART(&ant_common_page_81_codec, ant_sdm_profile_t, page_81),
+};
+
+/**@brief SDM pages. */
+static ant_page_desc_t const m_pages[] =
+{
+    ANT_PAGE_DESC(ANT_SDM_PAGE_1, m_page_1_parts),
+    ANT_PAGE_DESC(ANT_SDM_PAGE_2, m_page_2_parts),
+    ANT_PAGE_DESC(ANT_SDM_PAGE_3, m_page_3_parts),
+    ANT_PAGE_DESC(ANT_SDM_PAGE_16, m_page_16_parts),
+    ANT_PAGE_DESC(ANT_SDM_PAGE_22, m_page_22_parts),
+    ANT_PAGE_DESC(ANT_SDM_PAGE_80, m_page_80_parts),
+    ANT_PAGE_DESC(ANT_SDM_PAGE_81, m_page_81_parts),
+};
+
+ANT_PAGE_TABLE_DEF(m_page_table, m_pages);
+
 /**@brief Function for initializing the ANT SDM profile instance.
  *
  * @param[in]  p_profile        Pointer to the profile instance.
@@ -165,50 +252,21 @@ static ant_sdm_page_t next_page_number_get(ant_sdm_profile_t * p_profile)
 static void sens_message_encode(ant_sdm_profile_t * p_profile, uint8_t * p_message_payload)
 {
     ant_sdm_message_layout_t * p_sdm_message_payload = (ant_sdm_message_layout_t *)p_message_payload;
+    ant_page_desc_t const    * p_page;
 
     p_sdm_message_payload->page_number = next_page_number_get(p_profile);
 
     LOG_SDM("SDM Page number   %u\n\r", p_sdm_message_payload->page_number);
 
-    switch (p_sdm_message_payload->page_number)
+    p_page = ant_page_table_find(&m_page_table, p_sdm_message_payload->page_number);
+
+    if (p_page == NULL)
     {
-        case ANT_SDM_PAGE_1:
-            ant_sdm_page_1_encode(p_sdm_message_payload->page_payload, &(p_profile->page_1),
-                                  &(p_profile->common));
-            ant_sdm_speed_encode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_2:
-            ant_sdm_page_2_encode(p_sdm_message_payload->page_payload, &(p_profile->page_2));
-            ant_sdm_speed_encode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_3:
-            ant_sdm_page_2_encode(p_sdm_message_payload->page_payload, &(p_profile->page_2));
-            ant_sdm_page_3_encode(p_sdm_message_payload->page_payload, &(p_profile->page_3));
-            ant_sdm_speed_encode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_16:
-            ant_sdm_page_16_encode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_22:
-            ant_sdm_page_22_encode(p_sdm_message_payload->page_payload, &(p_profile->page_22));
-            break;
-
-        case ANT_SDM_PAGE_80:
-            ant_common_page_80_encode(p_sdm_message_payload->page_payload, &(p_profile->page_80));
-            break;
-
-        case ANT_SDM_PAGE_81:
-            ant_common_page_81_encode(p_sdm_message_payload->page_payload, &(p_profile->page_81));
-            break;
-
-        default:
-            LOG_SDM("\r\n");
-            return;
+        LOG_SDM("\r\n");
+        return;
     }
+
+    ant_page_encode(p_page, p_sdm_message_payload->page_payload, p_profile);
     LOG_SDM("\r\n");
 
 
@@ -284,44 +342,19 @@ ret_code_t ant_sdm_sens_open(ant_sdm_profile_t * p_profile)
 static void disp_message_decode(ant_sdm_profile_t * p_profile, uint8_t * p_message_payload)
 {
     const ant_sdm_message_layout_t * p_sdm_message_payload  = (ant_sdm_message_layout_t *)p_message_payload;
+    ant_page_desc_t const          * p_page;
 
     LOG_SDM("SDM Page number   %u\n\r", p_sdm_message_payload->page_number);
 
-    switch (p_sdm_message_payload->page_number)
+    p_page = ant_page_table_find(&m_page_table, p_sdm_message_payload->page_number);
+
+    if (p_page == NULL)
     {
-        case ANT_SDM_PAGE_1:
-            ant_sdm_page_1_decode(p_sdm_message_payload->page_payload, &(p_profile->page_1), &(p_profile->common));
-            ant_sdm_speed_decode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_3:
-            ant_sdm_page_3_decode(p_sdm_message_payload->page_payload, &(p_profile->page_3));
-            /* fall through */
-        case ANT_SDM_PAGE_2:
-            ant_sdm_page_2_decode(p_sdm_message_payload->page_payload, &(p_profile->page_2));
-            ant_sdm_speed_decode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_16:
-            ant_sdm_page_16_decode(p_sdm_message_payload->page_payload, &(p_profile->common));
-            break;
-
-        case ANT_SDM_PAGE_22:
-            ant_sdm_page_22_decode(p_sdm_message_payload->page_payload, &(p_profile->page_22));
-            break;
-
-        case ANT_SDM_PAGE_80:
-            ant_common_page_80_decode(p_sdm_message_payload->page_payload, &(p_profile->page_80));
-            break;
-
-        case ANT_SDM_PAGE_81:
-            ant_common_page_81_decode(p_sdm_message_payload->page_payload, &(p_profile->page_81));
-            break;
-
-        default:
-            LOG_SDM("\n");
-            return;
+        LOG_SDM("\n");
+        return;
     }
+
+    ant_page_decode(p_page, p_sdm_message_payload->page_payload, p_profile);
     LOG_SDM("\n");
 
     p_profile->evt_handler(p_profile, (ant_sdm_evt_t)p_sdm_message_payload->page_number);
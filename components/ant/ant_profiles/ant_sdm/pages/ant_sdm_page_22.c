@@ -14,20 +14,25 @@
 #include "ant_sdm_page_22.h"
 #include "ant_sdm_utils.h"
 #include "ant_sdm_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief SDM page 22 data layout structure. */
-typedef struct
+/**@brief Page 22 fields. */
+static ant_page_field_t const m_page22_fields[] =
 {
-    uint8_t capabilities;
-    uint8_t reserved[6];
-}ant_sdm_page22_data_layout_t;
+    ANT_PAGE_FIELD(ant_sdm_page22_data_t, capabilities.byte, 0, 8),
+    ANT_PAGE_RESERVED(8, 48),
+};
 
 /**@brief Function for tracing page 22 data.
  *
- * @param[in]  p_page_data      Pointer to the page 22 data.
+ * @param[in]  p_data           Pointer to the page 22 data.
  */
-static void page_22_data_log(ant_sdm_page22_data_t const * p_page_data)
+static void page_22_data_log(void const * p_data)
 {
+    ant_sdm_page22_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE22("Capabilities:    ");
 
     if (p_page_data->capabilities.items.time_is_valid)
@@ -63,27 +68,18 @@ static void page_22_data_log(ant_sdm_page22_data_t const * p_page_data)
 }
 
 
+ANT_PAGE_CODEC_FIELDS_DEF(ant_sdm_page_22_codec, m_page22_fields, page_22_data_log);
+
+
 void ant_sdm_page_22_encode(uint8_t                     * p_page_buffer,
                             ant_sdm_page22_data_t const * p_page_data)
 {
-    ant_sdm_page22_data_layout_t * p_outcoming_data = (ant_sdm_page22_data_layout_t *)p_page_buffer;
-
-    p_outcoming_data->capabilities = p_page_data->capabilities.byte;
-    memset(p_outcoming_data->reserved, UINT8_MAX, sizeof (p_outcoming_data->reserved));
-
-    page_22_data_log(p_page_data);
+    ant_page_codec_encode(&ant_sdm_page_22_codec, p_page_buffer, p_page_data);
 }
 
 
 void ant_sdm_page_22_decode(uint8_t const         * p_page_buffer,
                             ant_sdm_page22_data_t * p_page_data)
 {
-    ant_sdm_page22_data_layout_t const * p_incoming_data =
-        (ant_sdm_page22_data_layout_t *)p_page_buffer;
-
-    p_page_data->capabilities.byte = p_incoming_data->capabilities;
-
-    page_22_data_log(p_page_data);
+    ant_page_codec_decode(&ant_sdm_page_22_codec, p_page_buffer, p_page_data);
 }
-
-
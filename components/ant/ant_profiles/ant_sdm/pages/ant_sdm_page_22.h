@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 #include <stdbool.h>
 
 /**@brief Data structure for SDM data page 22.
@@ -50,6 +51,9 @@ typedef struct
         .capabilities.byte = 0,  \
     }
 
+/**@brief Codec of page 22, for use in a page table. */
+extern ant_page_codec_t const ant_sdm_page_22_codec;
+
 /**@brief Function for encoding page 22.
  *
  * @param[in]  p_page_data      Pointer to the page data.
@@ -13,40 +13,36 @@
 #include "ant_sdm_page_3.h"
 #include "ant_sdm_utils.h"
 #include "ant_sdm_page_logger.h"
+#include "nordic_common.h"
 
-/**@brief SDM page 3 data layout structure. */
-typedef struct
+/**@brief Page 3 fields. */
+static ant_page_field_t const m_page3_fields[] =
 {
-    uint8_t reserved0[5];
-    uint8_t calories;
-    uint8_t reserved1;
-}ant_sdm_page3_data_layout_t;
+    ANT_PAGE_FIELD(ant_sdm_page3_data_t, calories, 40, 8),
+};
 
-static void page_3_data_log(ant_sdm_page3_data_t const * p_page_data)
+static void page_3_data_log(void const * p_data)
 {
+    ant_sdm_page3_data_t const * p_page_data = p_data;
+
+    UNUSED_VARIABLE(p_page_data);
+
     LOG_PAGE3("Calories:                         %u\n\r", p_page_data->calories);
 }
 
 
+ANT_PAGE_CODEC_FIELDS_DEF(ant_sdm_page_3_codec, m_page3_fields, page_3_data_log);
+
+
 void ant_sdm_page_3_encode(uint8_t                    * p_page_buffer,
                            ant_sdm_page3_data_t const * p_page_data)
 {
-    ant_sdm_page3_data_layout_t * p_outcoming_data = (ant_sdm_page3_data_layout_t *)p_page_buffer;
-
-    p_outcoming_data->calories = p_page_data->calories;
-    page_3_data_log(p_page_data);
+    ant_page_codec_encode(&ant_sdm_page_3_codec, p_page_buffer, p_page_data);
 }
 
 
 void ant_sdm_page_3_decode(uint8_t const        * p_page_buffer,
                            ant_sdm_page3_data_t * p_page_data)
 {
-    ant_sdm_page3_data_layout_t const * p_incoming_data =
-        (ant_sdm_page3_data_layout_t *)p_page_buffer;
-
-    p_page_data->calories = p_incoming_data->calories;
-
-    page_3_data_log(p_page_data);
+    ant_page_codec_decode(&ant_sdm_page_3_codec, p_page_buffer, p_page_data);
 }
-
-
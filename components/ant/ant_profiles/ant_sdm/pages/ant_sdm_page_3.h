@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include "ant_page_codec.h"
 
 /**@brief Data structure for SDM data page 3.
  */
@@ -37,6 +38,9 @@ typedef struct
         .calories = 0,          \
     }
 
+/**@brief Codec of page 3, for use in a page table. */
+extern ant_page_codec_t const ant_sdm_page_3_codec;
+
 /**@brief Function for encoding page 3.
  *
  * @param[in]  p_page_data      Pointer to the page data.
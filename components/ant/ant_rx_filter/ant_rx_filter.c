@@ -0,0 +1,150 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <string.h>
+#include "ant_rx_filter.h"
+#include "ant_parameters.h"
+#include "app_util.h"
+#include "sdk_common.h"
+#include "nordic_common.h"
+
+#define DEVICE_TYPE_PAIRING_BIT     0x80    ///< Pairing bit of the device type.
+
+/**@brief Filter stages, in the order the channel ID fields are matched. */
+typedef enum
+{
+    MATCH_NONE,             ///< No entry matches the device number.
+    MATCH_DEVICE_NUMBER,    ///< Some entry matches the device number.
+    MATCH_DEVICE_TYPE,      ///< Some entry matches the device number and type.
+    MATCH_ALL,              ///< Some entry matches the whole channel ID.
+} match_t;
+
+
+/**@brief Function for matching a channel ID against an accepted channel ID. */
+static match_t id_match(ant_rx_filter_id_t const * p_id,
+                        uint16_t                   device_number,
+                        uint8_t                    device_type,
+                        uint8_t                    transmission_type)
+{
+    if ((p_id->device_number != ANT_RX_FILTER_DEVICE_NUMBER_ANY)
+     && (p_id->device_number != device_number))
+    {
+        return MATCH_NONE;
+    }
+
+    if ((p_id->device_type != ANT_RX_FILTER_DEVICE_TYPE_ANY)
+     && (p_id->device_type != device_type))
+    {
+        return MATCH_DEVICE_NUMBER;
+    }
+
+    if ((p_id->transmission_type != ANT_RX_FILTER_TRANS_TYPE_ANY)
+     && (p_id->transmission_type != transmission_type))
+    {
+        return MATCH_DEVICE_TYPE;
+    }
+
+    return MATCH_ALL;
+}
+
+
+ret_code_t ant_rx_filter_init(ant_rx_filter_t          * p_filter,
+                              uint8_t                    channel_number,
+                              ant_rx_filter_id_t const * p_ids,
+                              uint8_t                    id_count)
+{
+    VERIFY_PARAM_NOT_NULL(p_filter);
+
+    if ((p_ids == NULL) && (id_count != 0))
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    p_filter->channel_number = channel_number;
+    p_filter->p_ids          = p_ids;
+    p_filter->id_count       = id_count;
+    ant_rx_filter_stats_clear(p_filter);
+
+    return NRF_SUCCESS;
+}
+
+
+bool ant_rx_filter_check(ant_rx_filter_t * p_filter, ant_evt_t const * p_ant_evt)
+{
+    if ((p_ant_evt->channel != p_filter->channel_number) || (p_ant_evt->event != EVENT_RX))
+    {
+        return true;
+    }
+
+    ANT_MESSAGE const * p_message = (ANT_MESSAGE const *)p_ant_evt->msg.evt_buffer;
+
+    if ((p_message->ANT_MESSAGE_ucMesgID != MESG_BROADCAST_DATA_ID)
+     && (p_message->ANT_MESSAGE_ucMesgID != MESG_ACKNOWLEDGED_DATA_ID)
+     && (p_message->ANT_MESSAGE_ucMesgID != MESG_BURST_DATA_ID))
+    {
+        return true;
+    }
+
+    if (p_filter->id_count == 0)
+    {
+        p_filter->stats.passed++;
+        return true;
+    }
+
+    if (!p_message->ANT_MESSAGE_stExtMesgBF.bANTDeviceID)
+    {
+        p_filter->stats.dropped_no_channel_id++;
+        return false;
+    }
+
+    // The channel ID is the first field of the extended data.
+    uint16_t device_number     = uint16_decode(&p_message->ANT_MESSAGE_aucExtData[0]);
+    uint8_t  device_type       = p_message->ANT_MESSAGE_aucExtData[2] & ~DEVICE_TYPE_PAIRING_BIT;
+    uint8_t  transmission_type = p_message->ANT_MESSAGE_aucExtData[3];
+    match_t  best_match        = MATCH_NONE;
+
+    for (uint32_t i = 0; i < p_filter->id_count; i++)
+    {
+        match_t match = id_match(&p_filter->p_ids[i], device_number, device_type, transmission_type);
+
+        if (match == MATCH_ALL)
+        {
+            p_filter->stats.passed++;
+            return true;
+        }
+
+        best_match = MAX(best_match, match);
+    }
+
+    switch (best_match)
+    {
+        case MATCH_NONE:
+            p_filter->stats.dropped_device_number++;
+            break;
+
+        case MATCH_DEVICE_NUMBER:
+            p_filter->stats.dropped_device_type++;
+            break;
+
+        default:
+            p_filter->stats.dropped_trans_type++;
+            break;
+    }
+
+    return false;
+}
+
+
+void ant_rx_filter_stats_clear(ant_rx_filter_t * p_filter)
+{
+    memset(&p_filter->stats, 0, sizeof(p_filter->stats));
+}
@@ -0,0 +1,108 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef ANT_RX_FILTER_H__
+#define ANT_RX_FILTER_H__
+
+/** @file
+ *
+ * @defgroup ant_sdk_rx_filter ANT receive filter
+ * @{
+ * @ingroup ant_sdk_utils
+ * @brief Channel ID filter for the messages received on an ANT channel.
+ *
+ * @details A channel with a wildcard channel ID, for example a background scanning channel,
+ *          receives the messages of all the devices in range. The filter matches the channel ID
+ *          carried in the extended data of each received message against a list of channel IDs,
+ *          so that the messages of other devices can be dropped before they are dispatched to
+ *          the application and the profiles, see @ref softdevice_ant_evt_filter_set. The
+ *          channel must be configured to report the channel ID, with
+ *          @ref ANT_LIB_CONFIG_MESG_OUT_INC_DEVICE_ID.
+ *
+ *          The number of messages dropped is counted by reason, to show how much of the traffic
+ *          on the channel is of interest, and how often messages are received without their
+ *          channel ID.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ant_stack_handler_types.h"
+#include "sdk_errors.h"
+
+#define ANT_RX_FILTER_DEVICE_NUMBER_ANY     0x0000  ///< Wildcard device number.
+#define ANT_RX_FILTER_DEVICE_TYPE_ANY       0x00    ///< Wildcard device type.
+#define ANT_RX_FILTER_TRANS_TYPE_ANY        0x00    ///< Wildcard transmission type.
+
+/**@brief Channel ID accepted by a filter. Zero fields are wildcards. */
+typedef struct
+{
+    uint16_t device_number;         ///< Device number, or @ref ANT_RX_FILTER_DEVICE_NUMBER_ANY.
+    uint8_t  device_type;           ///< Device type, without the pairing bit, or @ref ANT_RX_FILTER_DEVICE_TYPE_ANY.
+    uint8_t  transmission_type;     ///< Transmission type, or @ref ANT_RX_FILTER_TRANS_TYPE_ANY.
+} ant_rx_filter_id_t;
+
+/**@brief Filter counters. */
+typedef struct
+{
+    uint32_t passed;                    ///< Messages passed.
+    uint32_t dropped_device_number;     ///< Messages dropped because no entry matches their device number.
+    uint32_t dropped_device_type;       ///< Messages dropped because their device number matched, but no entry matches their device type.
+    uint32_t dropped_trans_type;        ///< Messages dropped because their device number and type matched, but no entry matches their transmission type.
+    uint32_t dropped_no_channel_id;     ///< Messages dropped because they do not carry their channel ID.
+} ant_rx_filter_stats_t;
+
+/**@brief Filter instance. */
+typedef struct
+{
+    uint8_t                     channel_number;     ///< Filtered channel. Events of other channels are passed.
+    uint8_t                     id_count;           ///< Number of accepted channel IDs.
+    ant_rx_filter_id_t const  * p_ids;              ///< Accepted channel IDs. If there are none, all channel IDs are accepted.
+    ant_rx_filter_stats_t       stats;              ///< Counters.
+} ant_rx_filter_t;
+
+/**@brief Function for initializing a filter.
+ *
+ * @param[out] p_filter         Pointer to the filter.
+ * @param[in]  channel_number   Filtered channel.
+ * @param[in]  p_ids            Accepted channel IDs. The list must stay in memory as long as the
+ *                              filter is used.
+ * @param[in]  id_count         Number of accepted channel IDs.
+ *
+ * @retval     NRF_SUCCESS      The filter was initialized.
+ * @retval     NRF_ERROR_NULL   p_filter is NULL, or p_ids is NULL while id_count is not 0.
+ */
+ret_code_t ant_rx_filter_init(ant_rx_filter_t          * p_filter,
+                              uint8_t                    channel_number,
+                              ant_rx_filter_id_t const * p_ids,
+                              uint8_t                    id_count);
+
+/**@brief Function for checking an ANT event against a filter.
+ *
+ * @details Only data messages received on the filtered channel are checked. A message passes
+ *          if one of the accepted channel IDs matches the channel ID of the message. All other
+ *          events pass.
+ *
+ * @param[in]  p_filter     Pointer to the filter.
+ * @param[in]  p_ant_evt    ANT event.
+ *
+ * @return     True if the event passes the filter.
+ */
+bool ant_rx_filter_check(ant_rx_filter_t * p_filter, ant_evt_t const * p_ant_evt);
+
+/**@brief Function for clearing the counters of a filter.
+ *
+ * @param[in]  p_filter     Pointer to the filter.
+ */
+void ant_rx_filter_stats_clear(ant_rx_filter_t * p_filter);
+
+#endif // ANT_RX_FILTER_H__
+/** @} */
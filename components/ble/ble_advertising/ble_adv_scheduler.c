@@ -0,0 +1,140 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+#include "ble_adv_scheduler.h"
+#include "app_timer.h"
+#include "sdk_common.h"
+
+
+static ble_adv_frame_t *               mp_frames;          /**< Frames, in the order they are sent. */
+static uint8_t                         m_frame_count;      /**< Number of frames. */
+static uint8_t                         m_frame_index;      /**< Index of the frame set in the stack. */
+static uint8_t                         m_events_left;      /**< Advertising events left for the current frame. */
+static uint32_t                        m_adv_count;        /**< Advertising events since initialization. */
+static ble_advertising_error_handler_t m_error_handler;    /**< Handler for the errors of the stack. */
+
+
+/**@brief Function for refreshing a frame if its refresh interval has passed, and passing it to
+ *        the stack.
+ *
+ * @param[in] p_frame  Frame to send.
+ *
+ * @return The error code returned by @ref ble_advdata_cache_apply.
+ */
+static uint32_t frame_apply(ble_adv_frame_t * p_frame)
+{
+    if (p_frame->refresh_handler != NULL)
+    {
+        uint32_t now;
+        uint32_t elapsed;
+
+        (void)app_timer_cnt_get(&now);
+        (void)app_timer_cnt_diff_compute(now, p_frame->refresh_ticks, &elapsed);
+
+        if (elapsed >= p_frame->refresh_interval)
+        {
+            p_frame->refresh_ticks = now;
+            p_frame->refresh_handler(p_frame);
+        }
+    }
+
+    return ble_advdata_cache_apply(p_frame->p_cache);
+}
+
+
+/**@brief Function for finding the next frame with a non-zero weight.
+ *
+ * @param[in] index  Index of the current frame.
+ */
+static uint8_t frame_next(uint8_t index)
+{
+    do
+    {
+        index = (index + 1 == m_frame_count) ? 0 : index + 1;
+    } while (mp_frames[index].weight == 0);
+
+    return index;
+}
+
+
+uint32_t ble_adv_scheduler_init(ble_adv_frame_t *                     p_frames,
+                                uint8_t                               frame_count,
+                                ble_advertising_error_handler_t const error_handler)
+{
+    uint32_t now;
+    bool     has_weight = false;
+
+    VERIFY_PARAM_NOT_NULL(p_frames);
+
+    (void)app_timer_cnt_get(&now);
+
+    for (uint8_t i = 0; i < frame_count; i++)
+    {
+        VERIFY_PARAM_NOT_NULL(p_frames[i].p_cache);
+
+        // Make every frame due for a refresh the first time it is sent.
+        p_frames[i].refresh_ticks = now - p_frames[i].refresh_interval;
+        has_weight               |= (p_frames[i].weight != 0);
+    }
+    if (!has_weight)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    mp_frames       = p_frames;
+    m_frame_count   = frame_count;
+    m_frame_index   = frame_next(frame_count - 1);
+    m_events_left   = mp_frames[m_frame_index].weight;
+    m_adv_count     = 0;
+    m_error_handler = error_handler;
+
+    return frame_apply(&mp_frames[m_frame_index]);
+}
+
+
+void ble_adv_scheduler_on_radio_evt(bool radio_active)
+{
+    if (radio_active || (mp_frames == NULL))
+    {
+        return;
+    }
+
+    m_adv_count++;
+
+    if (--m_events_left != 0)
+    {
+        return;
+    }
+
+    uint8_t next = frame_next(m_frame_index);
+
+    m_events_left = mp_frames[next].weight;
+
+    // A single frame without a refresh handler never changes.
+    if ((next != m_frame_index) || (mp_frames[next].refresh_handler != NULL))
+    {
+        uint32_t err_code;
+
+        m_frame_index = next;
+        err_code      = frame_apply(&mp_frames[next]);
+        if ((err_code != NRF_SUCCESS) && (m_error_handler != NULL))
+        {
+            m_error_handler(err_code);
+        }
+    }
+}
+
+
+uint32_t ble_adv_scheduler_adv_count_get(void)
+{
+    return m_adv_count;
+}
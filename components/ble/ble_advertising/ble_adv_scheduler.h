@@ -0,0 +1,105 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+/**@file
+ *
+ * @defgroup ble_sdk_lib_adv_scheduler Advertising Frame Scheduler
+ * @{
+ * @ingroup  ble_sdk_lib_advertising
+ * @brief    Module for interleaving several advertising frames in one advertising set.
+ *
+ * @details  Beacons that send several frame types, for example the Eddystone UID, URL, TLM, and
+ *           EID frames, keep advertising all the time. The frames are encoded once into
+ *           @ref ble_advdata_cache_t structures, and the scheduler passes the next frame to the
+ *           stack at the end of each advertising event, so the frame changes at the next event
+ *           without stopping and restarting advertising.
+ *
+ *           Each frame is sent in weight advertising events in a row, then the next frame with a
+ *           non-zero weight is sent. A frame with changing fields, such as TLM counters or a
+ *           rotating EID, has a refresh handler. It is only called when the frame is about to be
+ *           sent and at least refresh_interval app_timer ticks have passed since its last refresh.
+ *           The handler updates the fields with @ref ble_advdata_field_update.
+ *
+ *           The end of the advertising events is signalled by the Radio Notification: the
+ *           application forwards it with @ref ble_adv_scheduler_on_radio_evt. Every radio event
+ *           is counted, so the scheduler is meant for devices that only advertise. The app_timer
+ *           module must be initialized if refresh handlers are used.
+ *
+ * @code
+ * err_code = ble_adv_scheduler_init(m_frames, FRAME_COUNT, error_handler);
+ * APP_ERROR_CHECK(err_code);
+ * err_code = ble_radio_notification_init(APP_IRQ_PRIORITY_LOW,
+ *                                        NRF_RADIO_NOTIFICATION_DISTANCE_800US,
+ *                                        ble_adv_scheduler_on_radio_evt);
+ * APP_ERROR_CHECK(err_code);
+ * err_code = sd_ble_gap_adv_start(&m_adv_params);
+ * @endcode
+ */
+
+#ifndef BLE_ADV_SCHEDULER_H__
+#define BLE_ADV_SCHEDULER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_advdata.h"
+#include "ble_advertising.h"
+
+typedef struct ble_adv_frame_s ble_adv_frame_t;
+
+/**@brief Frame refresh handler type. Called from the Radio Notification interrupt. */
+typedef void (*ble_adv_frame_refresh_handler_t) (ble_adv_frame_t * p_frame);
+
+/**@brief Advertising frame. */
+struct ble_adv_frame_s
+{
+    ble_advdata_cache_t *           p_cache;          /**< Encoded frame, set with @ref ble_advdata_cache_set. */
+    uint8_t                         weight;           /**< Number of advertising events in a row that send the frame. 0 to skip the frame. */
+    uint32_t                        refresh_interval; /**< Minimum time between two refreshes, in app_timer ticks. 0 to refresh the frame every time it is sent. */
+    ble_adv_frame_refresh_handler_t refresh_handler;  /**< Refresh handler, or NULL if the frame does not change. */
+    void *                          p_context;        /**< Context of the refresh handler. */
+    uint32_t                        refresh_ticks;    /**< Time of the last refresh. Internal to the module. */
+};
+
+/**@brief Function for initializing the scheduler and passing the first frame to the stack.
+ *
+ * @details The first frame with a non-zero weight is refreshed, if it has a refresh handler,
+ *          and set as the advertising data. The frames must stay valid while the scheduler is
+ *          used.
+ *
+ * @param[in] p_frames       Frames, in the order they are sent.
+ * @param[in] frame_count    Number of frames.
+ * @param[in] error_handler  Handler for the errors of the stack when a frame is set, or NULL.
+ *
+ * @retval NRF_SUCCESS              If the first frame was set.
+ * @retval NRF_ERROR_NULL           If p_frames or the cache of a frame is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  If no frame has a non-zero weight.
+ * @retval -                        Any error code returned by @ref ble_advdata_cache_apply.
+ */
+uint32_t ble_adv_scheduler_init(ble_adv_frame_t *                     p_frames,
+                                uint8_t                               frame_count,
+                                ble_advertising_error_handler_t const error_handler);
+
+/**@brief Radio Notification handler. Register it with ble_radio_notification_init, or call it
+ *        from the Radio Notification handler of the application.
+ *
+ * @param[in] radio_active  False at the end of a radio event.
+ */
+void ble_adv_scheduler_on_radio_evt(bool radio_active);
+
+/**@brief Function for getting the number of advertising events since initialization, for
+ *        example for the advertising count of an Eddystone TLM frame.
+ */
+uint32_t ble_adv_scheduler_adv_count_get(void);
+
+#endif // BLE_ADV_SCHEDULER_H__
+
+/** @} */
@@ -17,6 +17,7 @@
 #include "pstorage.h"
 #include "fstorage.h"
 #include "sdk_common.h"
+#include "app_boot_trace.h"
 
 
 #define ADV_LOG(...)
@@ -171,6 +172,7 @@ uint32_t ble_advertising_init(ble_advdata_t const                 * p_advdata,
     return err_code;
 }
 
+#if (BLE_ADVERTISING_WAIT_FOR_FLASH)
 /** @brief Function to determine if a flash access in in progress. If it is the case, we can not
 *          start advertising until it is finished. attempted restart
 *          in @ref ble_advertising_on_sys_evt
@@ -208,6 +210,7 @@ static bool flash_access_in_progress()
         return false;
     }
 }
+#endif
 
 uint32_t ble_advertising_start(ble_adv_mode_t advertising_mode)
 {
@@ -216,6 +219,7 @@ uint32_t ble_advertising_start(ble_adv_mode_t advertising_mode)
 
     m_adv_mode_current = advertising_mode;
 
+#if (BLE_ADVERTISING_WAIT_FOR_FLASH)
     // Verify if there are any pending flash operations. If so, delay starting advertising until
     // the flash operations are complete.
     if(flash_access_in_progress())
@@ -223,6 +227,7 @@ uint32_t ble_advertising_start(ble_adv_mode_t advertising_mode)
         m_advertising_start_pending = true;
         return NRF_SUCCESS;
     }
+#endif
 
     ADV_LOG("[ADV]: no flash operations in progress, prepare advertising.\r\n");
     // Fetch the peer address.
@@ -363,6 +368,15 @@ uint32_t ble_advertising_start(ble_adv_mode_t advertising_mode)
     {
         err_code = sd_ble_gap_adv_start(&adv_params);
         VERIFY_SUCCESS(err_code);
+
+#if (APP_BOOT_TRACE_ENABLED)
+        static bool adv_start_traced = false;
+        if (!adv_start_traced)
+        {
+            adv_start_traced = true;
+            APP_BOOT_TRACE("adv_start");
+        }
+#endif
     }
     if (m_evt_handler != NULL)
     {
@@ -39,6 +39,17 @@
 #include "nrf_error.h"
 #include "ble_advdata.h"
 
+/**@brief Whether @ref ble_advertising_start waits for pending flash operations to complete before
+ *        starting advertising.
+ *
+ * @details Set to 0 to start advertising while the modules that use flash, such as FDS and the
+ *          Peer Manager, are still initializing. These modules must then handle requests made
+ *          before they are ready, see FDS_LAZY_INIT and PDS_LAZY_INIT.
+ */
+#ifndef BLE_ADVERTISING_WAIT_FOR_FLASH
+#define BLE_ADVERTISING_WAIT_FOR_FLASH 1
+#endif
+
 /**@brief Advertising modes.
 */
 typedef enum
@@ -15,6 +15,9 @@
 #include "nrf_log.h"
 
 #include "sdk_common.h"
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+#include "peer_manager.h"
+#endif
 
 #define SRV_DISC_START_HANDLE  0x0001                    /**< The start handle value used during service discovery. */
 #define DB_DISCOVERY_MAX_USERS BLE_DB_DISCOVERY_MAX_SRV  /**< The maximum number of users/registrations allowed by this module. */
@@ -25,20 +28,7 @@
 static ble_uuid_t m_registered_handlers[DB_DISCOVERY_MAX_USERS];
 
 
-/**@brief   Array of structures containing pending events to be sent to the application modules.
- *
- * @details Whenever a discovery related event is to be raised to a user module, it will be stored
- *          in this array first. When all services needed to be discovered have been
- *          discovered, all pending events will be sent to the corresponding user modules.
- **/
-static struct
-{
-    ble_db_discovery_evt_t         evt;          /**< The pending event. */
-    ble_db_discovery_evt_handler_t evt_handler;  /**< The event handler which should be called to raise this event. */
-} m_pending_user_evts[DB_DISCOVERY_MAX_USERS];
-
 static ble_db_discovery_evt_handler_t m_evt_handler;
-static uint32_t m_pending_usr_evt_index;    /**< The index to the pending user event array, pointing to the last added pending user event. */
 static uint32_t m_num_of_handlers_reg;      /**< The number of handlers registered with the DB Discovery module. */
 static bool     m_initialized = false;      /**< This variable Indicates if the module is initialized or not. */
 
@@ -98,18 +88,39 @@ static uint32_t registered_handler_set(const ble_uuid_t * const       p_srv_uuid
 }
 
 
-/**@brief Function for sending all pending discovery events to the corresponding user modules.
+/**@brief Function for sending all pending discovery events of a connection to the user modules.
+ *
+ * @details The pending events are built from the services of the DB discovery structure, in the
+ *          order in which they were discovered. A service which was not found at the peer has an
+ *          invalid handle range.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ * @param[in] conn_handle    Connection Handle.
  */
-static void pending_user_evts_send(void)
+static void pending_user_evts_send(ble_db_discovery_t * const p_db_discovery,
+                                   uint16_t const             conn_handle)
 {
-    uint32_t i = 0;
+    uint32_t               i;
+    ble_db_discovery_evt_t evt;
 
-    for (i = 0; i < m_num_of_handlers_reg; i++)
+    for (i = 0; i < p_db_discovery->pending_usr_evt_index; i++)
     {
-        // Pass the event to the corresponding event handler.
-        m_pending_user_evts[i].evt_handler(&(m_pending_user_evts[i].evt));
+        evt.conn_handle          = conn_handle;
+        evt.params.discovered_db = p_db_discovery->services[i];
+
+        if (p_db_discovery->services[i].handle_range.start_handle != BLE_GATT_HANDLE_INVALID)
+        {
+            evt.evt_type = BLE_DB_DISCOVERY_COMPLETE;
+        }
+        else
+        {
+            evt.evt_type = BLE_DB_DISCOVERY_SRV_NOT_FOUND;
+        }
+
+        // Pass the event to the registered event handler.
+        m_evt_handler(&evt);
     }
-    m_pending_usr_evt_index = 0;
+    p_db_discovery->pending_usr_evt_index = 0;
 }
 
 
@@ -154,8 +165,9 @@ static void discovery_error_evt_trigger(ble_db_discovery_t * const p_db_discover
  *
  * @details   This function will fetch the event handler based on the UUID of the service being
  *            discovered. (The event handler is registered by the application beforehand).
- *            It then triggers an event indicating the completion of the service discovery.
- *            If no event handler was found, then this function will do nothing.
+ *            It then adds an event indicating the completion of the service discovery to the
+ *            pending events of the connection. If no event handler was found, then this function
+ *            will do nothing.
  *
  * @param[in] p_db_discovery Pointer to the DB discovery structure.
  * @param[in] is_srv_found   Variable to indicate if the service was found at the peer.
@@ -174,32 +186,23 @@ static void discovery_complete_evt_trigger(ble_db_discovery_t * const p_db_disco
 
     if (p_evt_handler != NULL)
     {
-        if (m_pending_usr_evt_index < DB_DISCOVERY_MAX_USERS)
+        if (p_db_discovery->pending_usr_evt_index < DB_DISCOVERY_MAX_USERS)
         {
-            // Insert an event into the pending event list.
-            m_pending_user_evts[m_pending_usr_evt_index].evt.conn_handle = conn_handle;
-
-            m_pending_user_evts[m_pending_usr_evt_index].evt.params.discovered_db =
-                *p_srv_being_discovered;
-            if (is_srv_found)
+            if (!is_srv_found)
             {
-                m_pending_user_evts[m_pending_usr_evt_index].evt.evt_type =
-                    BLE_DB_DISCOVERY_COMPLETE;
+                // Pending events are built from the services, a service which was not found is
+                // recognized by its handle range.
+                p_srv_being_discovered->handle_range.start_handle = BLE_GATT_HANDLE_INVALID;
+                p_srv_being_discovered->handle_range.end_handle   = BLE_GATT_HANDLE_INVALID;
             }
-            else
-            {
-                m_pending_user_evts[m_pending_usr_evt_index].evt.evt_type =
-                    BLE_DB_DISCOVERY_SRV_NOT_FOUND;
-            }
-            m_pending_user_evts[m_pending_usr_evt_index].evt_handler = p_evt_handler;
 
-            m_pending_usr_evt_index++;
+            p_db_discovery->pending_usr_evt_index++;
 
-            if (m_pending_usr_evt_index == m_num_of_handlers_reg)
+            if (p_db_discovery->pending_usr_evt_index == m_num_of_handlers_reg)
             {
                 // All registered modules have pending events. Send all pending events to the user
                 // modules.
-                pending_user_evts_send();
+                pending_user_evts_send(p_db_discovery, conn_handle);
             }
             else
             {
@@ -210,6 +213,148 @@ static void discovery_complete_evt_trigger(ble_db_discovery_t * const p_db_disco
 }
 
 
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+/**@brief     Function for finding the value handle of the Service Changed characteristic among
+ *            the discovered services.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ */
+static void service_changed_handle_find(ble_db_discovery_t * const p_db_discovery)
+{
+    uint32_t i;
+    uint32_t j;
+
+    p_db_discovery->service_changed_handle = BLE_GATT_HANDLE_INVALID;
+
+    for (i = 0; i < p_db_discovery->srv_count; i++)
+    {
+        ble_gatt_db_srv_t * p_srv = &(p_db_discovery->services[i]);
+
+        if ((p_srv->srv_uuid.type != BLE_UUID_TYPE_BLE) || (p_srv->srv_uuid.uuid != BLE_UUID_GATT))
+        {
+            continue;
+        }
+
+        for (j = 0; j < p_srv->char_count; j++)
+        {
+            if (p_srv->charateristics[j].characteristic.uuid.uuid ==
+                BLE_UUID_GATT_CHARACTERISTIC_SERVICE_CHANGED)
+            {
+                p_db_discovery->service_changed_handle =
+                    p_srv->charateristics[j].characteristic.handle_value;
+                return;
+            }
+        }
+    }
+}
+
+
+/**@brief     Function for storing the discovered services as the remote DB of a bonded peer.
+ *
+ * @details   Nothing is stored if the peer is not bonded. The services array is the source of the
+ *            flash write, which completes asynchronously.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ */
+static void cache_store(ble_db_discovery_t * const p_db_discovery)
+{
+    pm_peer_id_t peer_id;
+    uint32_t     err_code;
+
+    if ((pm_peer_id_get(p_db_discovery->conn_handle, &peer_id) != NRF_SUCCESS) ||
+        (peer_id == PM_PEER_ID_INVALID))
+    {
+        return;
+    }
+
+    // The Peer Manager stores whole words. Any padding is read from the memory following the
+    // last service, which is still within the DB discovery structure.
+    err_code = pm_peer_data_remote_db_store(peer_id,
+                                            p_db_discovery->services,
+                                            ALIGN_NUM(4, p_db_discovery->srv_count *
+                                                         sizeof(ble_gatt_db_srv_t)),
+                                            NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        DB_LOG("[DB]: Storing the remote DB of peer %d failed, reason %d\r\n", peer_id, err_code);
+    }
+}
+
+
+/**@brief     Function for raising the discovery events from the remote DB stored for a bonded
+ *            peer.
+ *
+ * @details   The stored DB is used only if it holds exactly the registered services, in the order
+ *            of registration. Services which were not found at the peer are stored with an
+ *            invalid handle range.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ *
+ * @retval    true  If the events were raised from the stored DB.
+ * @retval    false If a full discovery must be performed.
+ */
+static bool cache_replay(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
+{
+    pm_peer_id_t peer_id;
+    uint16_t     len = ALIGN_NUM(4, sizeof(p_db_discovery->services));
+    uint32_t     i;
+
+    if ((pm_peer_id_get(conn_handle, &peer_id) != NRF_SUCCESS) ||
+        (peer_id == PM_PEER_ID_INVALID))
+    {
+        return false;
+    }
+
+    // The load may write up to three padding bytes past the services array. The fields it can
+    // touch are all reset below or in the discovery procedure.
+    if (pm_peer_data_remote_db_load(peer_id, p_db_discovery->services, &len) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    if ((len / sizeof(ble_gatt_db_srv_t)) != m_num_of_handlers_reg)
+    {
+        return false;
+    }
+
+    for (i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        if (!BLE_UUID_EQ(&(p_db_discovery->services[i].srv_uuid), &(m_registered_handlers[i])))
+        {
+            return false;
+        }
+    }
+
+    DB_LOG("[DB]: Using the stored remote DB of peer %d for Connection handle %d\r\n",
+           peer_id, conn_handle);
+
+    p_db_discovery->conn_handle       = conn_handle;
+    p_db_discovery->srv_count         = m_num_of_handlers_reg;
+    p_db_discovery->curr_char_ind     = 0;
+    p_db_discovery->discoveries_count = 0;
+
+    p_db_discovery->pending_usr_evt_index = 0;
+
+    service_changed_handle_find(p_db_discovery);
+
+    for (i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        p_db_discovery->curr_srv_ind = i;
+
+        discovery_complete_evt_trigger(p_db_discovery,
+                                       (p_db_discovery->services[i].handle_range.start_handle !=
+                                        BLE_GATT_HANDLE_INVALID),
+                                       conn_handle);
+
+        p_db_discovery->discoveries_count++;
+    }
+
+    return true;
+}
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
+
 /**@brief     Function for handling service discovery completion.
  *
  * @details   This function will be used to determine if there are more services to be discovered,
@@ -261,10 +406,6 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
             // Indicate the error to the registered user application.
             discovery_error_evt_trigger(p_db_discovery, err_code, conn_handle);
 
-            m_pending_user_evts[0].evt.evt_type    = BLE_DB_DISCOVERY_AVAILABLE;
-            m_pending_user_evts[0].evt.conn_handle = conn_handle;
-//            m_evt_handler(&m_pending_user_evts[0].evt);
-
             return;
         }
     }
@@ -272,9 +413,13 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
     {
         // No more service discovery is needed.
         p_db_discovery->discovery_in_progress  = false;
-        m_pending_user_evts[0].evt.evt_type    = BLE_DB_DISCOVERY_AVAILABLE;
-        m_pending_user_evts[0].evt.conn_handle = conn_handle;
-        //m_evt_handler(&m_pending_user_evts[0].evt);
+
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+        p_db_discovery->srv_count = p_db_discovery->discoveries_count;
+
+        service_changed_handle_find(p_db_discovery);
+        cache_store(p_db_discovery);
+#endif
     }
 }
 
@@ -553,15 +698,12 @@ static void on_primary_srv_discovery_rsp(ble_db_discovery_t * const    p_db_disc
             discovery_error_evt_trigger(p_db_discovery,
                                         err_code,
                                         p_ble_gattc_evt->conn_handle);
-
-            m_pending_user_evts[0].evt.evt_type    = BLE_DB_DISCOVERY_AVAILABLE;
-            m_pending_user_evts[0].evt.conn_handle = p_ble_gattc_evt->conn_handle;
-            //m_evt_handler(&m_pending_user_evts[0].evt);
         }
     }
     else
     {
         DB_LOG("Service UUID 0x%x Not found\r\n", p_srv_being_discovered->srv_uuid.uuid);
+
         // Trigger Service Not Found event to the application.
         discovery_complete_evt_trigger(p_db_discovery,
                                        false,
@@ -659,10 +801,6 @@ static void on_characteristic_discovery_rsp(ble_db_discovery_t * const    p_db_d
                                             err_code,
                                             p_ble_gattc_evt->conn_handle);
 
-                m_pending_user_evts[0].evt.evt_type    = BLE_DB_DISCOVERY_AVAILABLE;
-                m_pending_user_evts[0].evt.conn_handle = p_ble_gattc_evt->conn_handle;
-                //m_evt_handler(&m_pending_user_evts[0].evt);
-
                 return;
             }
         }
@@ -692,10 +830,6 @@ static void on_characteristic_discovery_rsp(ble_db_discovery_t * const    p_db_d
                                         err_code,
                                         p_ble_gattc_evt->conn_handle);
 
-            m_pending_user_evts[0].evt.evt_type    = BLE_DB_DISCOVERY_AVAILABLE;
-            m_pending_user_evts[0].evt.conn_handle = p_ble_gattc_evt->conn_handle;
-            //m_evt_handler(&m_pending_user_evts[0].evt);
-
             return;
         }
         if (raise_discov_complete)
@@ -792,9 +926,6 @@ static void on_descriptor_discovery_rsp(ble_db_discovery_t * const    p_db_disco
                                         err_code,
                                         p_ble_gattc_evt->conn_handle);
 
-            m_pending_user_evts[0].evt.evt_type    = BLE_DB_DISCOVERY_AVAILABLE;
-            m_pending_user_evts[0].evt.conn_handle = p_ble_gattc_evt->conn_handle;
-
             return;
         }
     }
@@ -822,7 +953,6 @@ uint32_t ble_db_discovery_init(const ble_db_discovery_evt_handler_t evt_handler)
 
     m_num_of_handlers_reg      = 0;
     m_initialized              = true;
-    m_pending_usr_evt_index    = 0;
     m_evt_handler              = evt_handler;
 
     return err_code;
@@ -834,7 +964,6 @@ uint32_t ble_db_discovery_close()
 {
     m_num_of_handlers_reg      = 0;
     m_initialized              = false;
-    m_pending_usr_evt_index    = 0;
 
     return NRF_SUCCESS;
 }
@@ -849,34 +978,29 @@ uint32_t ble_db_discovery_evt_register(const ble_uuid_t * const p_uuid)
 }
 
 
-uint32_t ble_db_discovery_start(ble_db_discovery_t * const p_db_discovery,
+/**@brief     Function for starting the discovery of the first registered service.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ *
+ * @return    The error code returned by the SoftDevice API @ref
+ *            sd_ble_gattc_primary_services_discover.
+ */
+static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery,
                                 uint16_t                   conn_handle)
 {
-    VERIFY_PARAM_NOT_NULL(p_db_discovery);
-    VERIFY_MODULE_INITIALIZED();
-
-    if (m_num_of_handlers_reg == 0)
-    {
-        // No user modules were registered. There are no services to discover.
-        return NRF_ERROR_INVALID_STATE;
-    }
-
-    if (p_db_discovery->discovery_in_progress)
-    {
-        return NRF_ERROR_BUSY;
-    }
-
     p_db_discovery->conn_handle = conn_handle;
     ble_gatt_db_srv_t * p_srv_being_discovered;
 
-    m_pending_usr_evt_index   = 0;
-
-    p_db_discovery->discoveries_count = 0;
+    p_db_discovery->pending_usr_evt_index = 0;
+    p_db_discovery->discoveries_count     = 0;
     p_db_discovery->curr_srv_ind = 0;
+    p_db_discovery->curr_char_ind = 0;
 
     p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
 
-    p_srv_being_discovered->srv_uuid = m_registered_handlers[p_db_discovery->curr_srv_ind];
+    p_srv_being_discovered->srv_uuid   = m_registered_handlers[p_db_discovery->curr_srv_ind];
+    p_srv_being_discovered->char_count = 0;
 
     DB_LOG("[DB]: Starting discovery of service with UUID 0x%x for Connection handle %d\r\n",
            p_srv_being_discovered->srv_uuid.uuid, conn_handle);
@@ -893,6 +1017,34 @@ uint32_t ble_db_discovery_start(ble_db_discovery_t * const p_db_discovery,
 }
 
 
+uint32_t ble_db_discovery_start(ble_db_discovery_t * const p_db_discovery,
+                                uint16_t                   conn_handle)
+{
+    VERIFY_PARAM_NOT_NULL(p_db_discovery);
+    VERIFY_MODULE_INITIALIZED();
+
+    if (m_num_of_handlers_reg == 0)
+    {
+        // No user modules were registered. There are no services to discover.
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (p_db_discovery->discovery_in_progress)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+    if (cache_replay(p_db_discovery, conn_handle))
+    {
+        return NRF_SUCCESS;
+    }
+#endif
+
+    return discovery_start(p_db_discovery, conn_handle);
+}
+
+
 /**@brief     Function for handling disconnected event.
  *
  * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
@@ -908,6 +1060,57 @@ static void on_disconnected(ble_db_discovery_t * const  p_db_discovery,
 }
 
 
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+/**@brief     Function for handling the Handle Value Notification or Indication event.
+ *
+ * @details   A Service Changed indication from the peer deletes the remote DB stored for it and
+ *            starts a new discovery.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_hvx(ble_db_discovery_t * const    p_db_discovery,
+                   const ble_gattc_evt_t * const p_ble_gattc_evt)
+{
+    pm_peer_id_t peer_id;
+    uint32_t     err_code;
+
+    if ((p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle) ||
+        (p_db_discovery->service_changed_handle == BLE_GATT_HANDLE_INVALID) ||
+        (p_ble_gattc_evt->params.hvx.handle != p_db_discovery->service_changed_handle))
+    {
+        return;
+    }
+
+    if (p_ble_gattc_evt->params.hvx.type == BLE_GATT_HVX_INDICATION)
+    {
+        (void)sd_ble_gattc_hv_confirm(p_ble_gattc_evt->conn_handle,
+                                      p_ble_gattc_evt->params.hvx.handle);
+    }
+
+    DB_LOG("[DB]: Service Changed indicated for Connection handle %d\r\n",
+           p_ble_gattc_evt->conn_handle);
+
+    p_db_discovery->service_changed_handle = BLE_GATT_HANDLE_INVALID;
+
+    if ((pm_peer_id_get(p_ble_gattc_evt->conn_handle, &peer_id) == NRF_SUCCESS) &&
+        (peer_id != PM_PEER_ID_INVALID))
+    {
+        (void)pm_peer_data_delete(peer_id, PM_PEER_DATA_ID_GATT_REMOTE);
+    }
+
+    if (!p_db_discovery->discovery_in_progress)
+    {
+        err_code = discovery_start(p_db_discovery, p_ble_gattc_evt->conn_handle);
+        if (err_code != NRF_SUCCESS)
+        {
+            discovery_error_evt_trigger(p_db_discovery, err_code, p_ble_gattc_evt->conn_handle);
+        }
+    }
+}
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
+
 void ble_db_discovery_on_ble_evt(ble_db_discovery_t * const p_db_discovery,
                                  const ble_evt_t * const    p_ble_evt)
 {
@@ -933,6 +1136,12 @@ void ble_db_discovery_on_ble_evt(ble_db_discovery_t * const p_db_discovery,
             on_disconnected(p_db_discovery, &(p_ble_evt->evt.gap_evt));
             break;
 
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+        case BLE_GATTC_EVT_HVX:
+            on_hvx(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+#endif
+
         default:
             break;
     }
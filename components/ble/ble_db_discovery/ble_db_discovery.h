@@ -51,6 +51,10 @@
 
 #define BLE_DB_DISCOVERY_MAX_SRV          6  /**< Maximum number of services supported by this module. This also indicates the maximum number of users allowed to be registered to this module. (one user per service). */
 
+#ifndef BLE_DB_DISCOVERY_CACHE_ENABLED
+#define BLE_DB_DISCOVERY_CACHE_ENABLED    0  /**< Set to 1 to use the GATT client cache of the Peer Manager for bonded peers (see @ref ble_db_discovery_start). */
+#endif
+
 
 /**@brief   Type of the DB Discovery event.
  */
@@ -67,7 +71,9 @@ typedef enum
 /**@brief   Structure for holding the information related to the GATT database at the server.
  *
  * @details This module identifies a remote database. Use one instance of this structure per 
- *          connection.
+ *          connection. All discovery state, including the events pending for the application,
+ *          is kept in this structure, so discoveries on different connections can run
+ *          concurrently.
  *
  * @warning This structure must be zero-initialized.
  */
@@ -79,7 +85,11 @@ typedef struct
     uint8_t             curr_srv_ind;                        /**< Index of the current service being discovered. This is intended for internal use during service discovery.*/
     bool                discovery_in_progress;               /**< Variable to indicate if there is a service discovery in progress. */
     uint8_t             discoveries_count;                   /**< Number of service discoveries made, both successful and unsuccessful. */
+    uint8_t             pending_usr_evt_index;               /**< Number of discovery events pending for the application. The events are sent when all registered services have been discovered. This is intended for internal use during service discovery. */
     uint16_t            conn_handle;                         /**< Connection handle on which the discovery is started*/
+#if (BLE_DB_DISCOVERY_CACHE_ENABLED == 1)
+    uint16_t            service_changed_handle;              /**< Value handle of the Service Changed characteristic of the peer, or BLE_GATT_HANDLE_INVALID if it is not known. This is intended for internal use. */
+#endif
 } ble_db_discovery_t;
 
 
@@ -145,6 +155,16 @@ uint32_t ble_db_discovery_evt_register(const ble_uuid_t * const             p_uu
 
                                        
 /**@brief Function for starting the discovery of the GATT database at the server.
+ *
+ * @details If @ref BLE_DB_DISCOVERY_CACHE_ENABLED is set and the peer is bonded, the remote
+ *          database stored by the Peer Manager is checked first. If it holds the services
+ *          registered with @ref ble_db_discovery_evt_register, the discovery events are raised
+ *          from the stored database before this function returns, and no GATT procedures are
+ *          started. Otherwise, a full discovery is performed and its result is stored for the
+ *          bonded peer when it completes. The stored database is deleted and the discovery is
+ *          repeated when the peer indicates Service Changed. To receive this indication, the
+ *          application must register the Generic Attribute service (@ref BLE_UUID_GATT) and
+ *          enable indications on its Service Changed characteristic.
  *
  * @warning p_db_discovery structure must be zero-initialized.
  *
@@ -0,0 +1,165 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+#include "ble_eddystone_eid.h"
+#include <string.h>
+#include "nrf_soc.h"
+#include "sdk_common.h"
+
+
+#define TEMP_KEY_SALT       0xFF    /**< Byte 11 of the cleartext of the temporary key. */
+#define TIME_PERIOD(time)   ((uint16_t)((time) >> 16))  /**< Period of the temporary key of a beacon time. */
+
+
+/**@brief Function for computing the temporary key of a beacon time, unless it is cached.
+ *
+ * @param[in,out] p_eid  Ephemeral ID state.
+ * @param[in]     time   Beacon time, in seconds.
+ */
+static ret_code_t temp_key_compute(ble_eddystone_eid_t * p_eid, uint32_t time)
+{
+    nrf_ecb_hal_data_t ecb_data;
+    ret_code_t         err_code;
+
+    if (p_eid->temp_key_valid && (p_eid->temp_key_period == TIME_PERIOD(time)))
+    {
+        return NRF_SUCCESS;
+    }
+
+    // 11 zero bytes, the salt, 2 zero bytes, and the upper 16 bits of the time, big endian.
+    memcpy(ecb_data.key, p_eid->identity_key, sizeof(ecb_data.key));
+    memset(ecb_data.cleartext, 0, sizeof(ecb_data.cleartext));
+    ecb_data.cleartext[11] = TEMP_KEY_SALT;
+    ecb_data.cleartext[14] = (uint8_t)(time >> 24);
+    ecb_data.cleartext[15] = (uint8_t)(time >> 16);
+
+    p_eid->temp_key_valid = false;
+    err_code = sd_ecb_block_encrypt(&ecb_data);
+    VERIFY_SUCCESS(err_code);
+
+    memcpy(p_eid->temp_key, ecb_data.ciphertext, sizeof(p_eid->temp_key));
+    p_eid->temp_key_period = TIME_PERIOD(time);
+    p_eid->temp_key_valid  = true;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for computing the EID of a beacon time.
+ *
+ * @param[in,out] p_eid     Ephemeral ID state.
+ * @param[in]     eid_time  Beacon time, with the K lowest bits cleared.
+ * @param[out]    p_out     EID.
+ */
+static ret_code_t eid_compute(ble_eddystone_eid_t * p_eid, uint32_t eid_time, uint8_t * p_out)
+{
+    nrf_ecb_hal_data_t ecb_data;
+    ret_code_t         err_code;
+
+    err_code = temp_key_compute(p_eid, eid_time);
+    VERIFY_SUCCESS(err_code);
+
+    // 11 zero bytes, K, and the time, big endian.
+    memcpy(ecb_data.key, p_eid->temp_key, sizeof(ecb_data.key));
+    memset(ecb_data.cleartext, 0, sizeof(ecb_data.cleartext));
+    ecb_data.cleartext[11] = p_eid->k;
+    (void)uint32_big_encode(eid_time, &ecb_data.cleartext[12]);
+
+    err_code = sd_ecb_block_encrypt(&ecb_data);
+    VERIFY_SUCCESS(err_code);
+
+    memcpy(p_out, ecb_data.ciphertext, BLE_EDDYSTONE_EID_LEN);
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for clearing the K lowest bits of a beacon time. */
+static uint32_t eid_time_get(ble_eddystone_eid_t const * p_eid, uint32_t time)
+{
+    return time & ~((1UL << p_eid->k) - 1);
+}
+
+
+ret_code_t ble_eddystone_eid_init(ble_eddystone_eid_t * p_eid,
+                                  uint8_t const       * p_identity_key,
+                                  uint8_t               k,
+                                  uint32_t              time)
+{
+    VERIFY_PARAM_NOT_NULL(p_eid);
+    VERIFY_PARAM_NOT_NULL(p_identity_key);
+
+    if (k > BLE_EDDYSTONE_EID_K_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_eid, 0, sizeof(ble_eddystone_eid_t));
+    memcpy(p_eid->identity_key, p_identity_key, sizeof(p_eid->identity_key));
+    p_eid->k        = k;
+    p_eid->eid_time = eid_time_get(p_eid, time);
+
+    return eid_compute(p_eid, p_eid->eid_time, p_eid->eid);
+}
+
+
+ret_code_t ble_eddystone_eid_update(ble_eddystone_eid_t * p_eid, uint32_t time, bool * p_changed)
+{
+    uint32_t   eid_time = eid_time_get(p_eid, time);
+    ret_code_t err_code = NRF_SUCCESS;
+    bool       changed  = false;
+
+    if (eid_time != p_eid->eid_time)
+    {
+        if (p_eid->next_eid_valid && (p_eid->next_eid_time == eid_time))
+        {
+            memcpy(p_eid->eid, p_eid->next_eid, sizeof(p_eid->eid));
+            p_eid->next_eid_valid = false;
+        }
+        else
+        {
+            err_code = eid_compute(p_eid, eid_time, p_eid->eid);
+        }
+
+        if (err_code == NRF_SUCCESS)
+        {
+            p_eid->eid_time = eid_time;
+            changed         = true;
+        }
+    }
+
+    if (p_changed != NULL)
+    {
+        *p_changed = changed;
+    }
+    return err_code;
+}
+
+
+ret_code_t ble_eddystone_eid_precompute(ble_eddystone_eid_t * p_eid)
+{
+    uint32_t   next_time = ble_eddystone_eid_next_rotation_get(p_eid);
+    ret_code_t err_code;
+
+    if (p_eid->next_eid_valid && (p_eid->next_eid_time == next_time))
+    {
+        return NRF_SUCCESS;
+    }
+
+    p_eid->next_eid_valid = false;
+    err_code = eid_compute(p_eid, next_time, p_eid->next_eid);
+    VERIFY_SUCCESS(err_code);
+
+    p_eid->next_eid_time  = next_time;
+    p_eid->next_eid_valid = true;
+
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+/**@file
+ *
+ * @defgroup ble_sdk_lib_eddystone_eid Eddystone Ephemeral ID
+ * @{
+ * @ingroup  ble_sdk_lib
+ * @brief    Module for computing the ephemeral identifier of Eddystone-EID frames.
+ *
+ * @details  The ephemeral identifier (EID) changes every 2^K seconds of beacon time. Each EID
+ *           takes two AES-128 operations: the temporary key, derived from the identity key and
+ *           the upper 16 bits of the beacon time, and the EID, derived from the temporary key.
+ *
+ *           The temporary key only changes every 2^16 seconds, so it is cached. The next EID is
+ *           computed ahead of its rotation by @ref ble_eddystone_eid_precompute, to be called
+ *           when the application is idle, for example from the main loop. The rotation done by
+ *           @ref ble_eddystone_eid_update, for example from the refresh handler of an advertising
+ *           frame, is then a copy of the precomputed EID.
+ *
+ *           AES is done by the SoftDevice. The functions of an instance are not reentrant and
+ *           must be called from the same interrupt priority.
+ */
+
+#ifndef BLE_EDDYSTONE_EID_H__
+#define BLE_EDDYSTONE_EID_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_abstraction.h"
+#include "sdk_errors.h"
+
+#define BLE_EDDYSTONE_EID_KEY_LEN       16  /**< Length of the identity key, in bytes. */
+#define BLE_EDDYSTONE_EID_LEN           8   /**< Length of the ephemeral identifier, in bytes. */
+#define BLE_EDDYSTONE_EID_K_MAX         15  /**< Largest rotation period exponent. */
+
+/**@brief Ephemeral ID state. The fields are internal to the module. */
+typedef struct
+{
+    uint8_t  identity_key[BLE_EDDYSTONE_EID_KEY_LEN]; /**< Identity key shared with the resolver. */
+    uint8_t  k;                                       /**< Rotation period exponent. */
+    uint8_t  temp_key[BLE_EDDYSTONE_EID_KEY_LEN];     /**< Cached temporary key. */
+    uint16_t temp_key_period;                         /**< Upper 16 bits of the beacon time of the cached temporary key. */
+    bool     temp_key_valid;                          /**< The temporary key is cached. */
+    uint32_t eid_time;                                /**< Beacon time of the current EID, with the K lowest bits cleared. */
+    uint8_t  eid[BLE_EDDYSTONE_EID_LEN];              /**< Current EID. */
+    uint32_t next_eid_time;                           /**< Beacon time of the precomputed EID. */
+    uint8_t  next_eid[BLE_EDDYSTONE_EID_LEN];         /**< Precomputed EID. */
+    bool     next_eid_valid;                          /**< The next EID is precomputed. */
+} ble_eddystone_eid_t;
+
+/**@brief Function for initializing an ephemeral ID and computing the current EID.
+ *
+ * @param[out] p_eid           Ephemeral ID state.
+ * @param[in]  p_identity_key  Identity key.
+ * @param[in]  k               Rotation period exponent, at most @ref BLE_EDDYSTONE_EID_K_MAX.
+ * @param[in]  time            Beacon time, in seconds.
+ *
+ * @retval NRF_SUCCESS              If the EID was computed.
+ * @retval NRF_ERROR_NULL           If a pointer is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  If k is too large.
+ * @retval -                        Any error code returned by sd_ecb_block_encrypt.
+ */
+ret_code_t ble_eddystone_eid_init(ble_eddystone_eid_t * p_eid,
+                                  uint8_t const       * p_identity_key,
+                                  uint8_t               k,
+                                  uint32_t              time);
+
+/**@brief Function for rotating the EID when its period has passed.
+ *
+ * @details If the EID of the given time was precomputed, it is copied. Otherwise, it is computed.
+ *
+ * @param[in,out] p_eid      Ephemeral ID state.
+ * @param[in]     time       Beacon time, in seconds.
+ * @param[out]    p_changed  Set to whether the EID changed. Can be NULL.
+ *
+ * @retval NRF_SUCCESS  If the EID is the one of the given time.
+ * @retval -            Any error code returned by sd_ecb_block_encrypt.
+ */
+ret_code_t ble_eddystone_eid_update(ble_eddystone_eid_t * p_eid, uint32_t time, bool * p_changed);
+
+/**@brief Function for computing the EID of the next rotation period, if it is not done yet.
+ *
+ * @param[in,out] p_eid  Ephemeral ID state.
+ *
+ * @retval NRF_SUCCESS  If the next EID is precomputed.
+ * @retval -            Any error code returned by sd_ecb_block_encrypt.
+ */
+ret_code_t ble_eddystone_eid_precompute(ble_eddystone_eid_t * p_eid);
+
+/**@brief Function for getting the current EID, @ref BLE_EDDYSTONE_EID_LEN bytes. */
+static __INLINE uint8_t const * ble_eddystone_eid_get(ble_eddystone_eid_t const * p_eid)
+{
+    return p_eid->eid;
+}
+
+/**@brief Function for getting the beacon time of the next rotation, in seconds. */
+static __INLINE uint32_t ble_eddystone_eid_next_rotation_get(ble_eddystone_eid_t const * p_eid)
+{
+    return p_eid->eid_time + (1UL << p_eid->k);
+}
+
+#endif // BLE_EDDYSTONE_EID_H__
+
+/** @} */
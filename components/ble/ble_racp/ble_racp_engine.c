@@ -0,0 +1,365 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+#include "ble_racp_engine.h"
+#include <string.h>
+#include "sdk_common.h"
+
+
+#define RACP_RESPONSE_MAX_LEN   4   /**< Length of the longest response: op code, operator, and a 2-byte operand. */
+
+
+/**@brief Function for reporting an error to the service. */
+static void error_report(ble_racp_engine_t * p_engine, ret_code_t err_code)
+{
+    if (p_engine->error_handler != NULL)
+    {
+        p_engine->error_handler(err_code);
+    }
+}
+
+
+/**@brief Function for sending the response as an indication.
+ *
+ * @details The response waits until the TX buffers of the reported records are released.
+ *
+ * @param[in,out] p_engine  Engine.
+ */
+static void response_send(ble_racp_engine_t * p_engine)
+{
+    ret_code_t             err_code;
+    uint8_t                encoded_resp[RACP_RESPONSE_MAX_LEN];
+    uint8_t                len;
+    uint16_t               hvx_len;
+    ble_gatts_hvx_params_t hvx_params;
+
+    if ((p_engine->state != BLE_RACP_ENGINE_STATE_RESPONSE_PENDING) && (p_engine->in_flight > 0))
+    {
+        p_engine->state = BLE_RACP_ENGINE_STATE_RESPONSE_PENDING;
+        return;
+    }
+
+    len     = ble_racp_encode(&p_engine->response, encoded_resp);
+    hvx_len = len;
+
+    memset(&hvx_params, 0, sizeof(hvx_params));
+
+    hvx_params.handle = p_engine->racp_value_handle;
+    hvx_params.type   = BLE_GATT_HVX_INDICATION;
+    hvx_params.offset = 0;
+    hvx_params.p_len  = &hvx_len;
+    hvx_params.p_data = encoded_resp;
+
+    err_code = sd_ble_gatts_hvx(p_engine->conn_handle, &hvx_params);
+    if ((err_code == NRF_SUCCESS) && (hvx_len != len))
+    {
+        err_code = NRF_ERROR_DATA_SIZE;
+    }
+
+    switch (err_code)
+    {
+        case NRF_SUCCESS:
+            // Wait for HVC event.
+            p_engine->state = BLE_RACP_ENGINE_STATE_RESPONSE_IND_VERIF;
+            break;
+
+        case BLE_ERROR_NO_TX_PACKETS:
+            // Wait for TX_COMPLETE event to retry transmission.
+            p_engine->state = BLE_RACP_ENGINE_STATE_RESPONSE_PENDING;
+            break;
+
+        case NRF_ERROR_INVALID_STATE:
+            // Indication is probably not enabled.
+            p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+            break;
+
+        default:
+            error_report(p_engine, err_code);
+            p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+            break;
+    }
+}
+
+
+/**@brief Function for sending a response with a Response Code op code.
+ *
+ * @param[in,out] p_engine  Engine.
+ * @param[in]     opcode    Op code of the request.
+ * @param[in]     value     Response code value.
+ */
+static void response_code_send(ble_racp_engine_t * p_engine, uint8_t opcode, uint8_t value)
+{
+    p_engine->response.opcode      = RACP_OPCODE_RESPONSE_CODE;
+    p_engine->response.operator    = RACP_OPERATOR_NULL;
+    p_engine->response.operand_len = 2;
+    p_engine->response.p_operand   = p_engine->response_operand;
+
+    p_engine->response_operand[0] = opcode;
+    p_engine->response_operand[1] = value;
+
+    response_send(p_engine);
+}
+
+
+/**@brief Function for sending a Number of Stored Records response. */
+static void num_records_send(ble_racp_engine_t * p_engine, uint16_t num_records)
+{
+    p_engine->response.opcode      = RACP_OPCODE_NUM_RECS_RESPONSE;
+    p_engine->response.operator    = RACP_OPERATOR_NULL;
+    p_engine->response.operand_len = sizeof(uint16_t);
+    p_engine->response.p_operand   = p_engine->response_operand;
+
+    (void)uint16_encode(num_records, p_engine->response_operand);
+
+    response_send(p_engine);
+}
+
+
+/**@brief Function for reporting records until the range is done or no TX buffer is free.
+ *
+ * @param[in,out] p_engine  Engine.
+ */
+static void records_report(ble_racp_engine_t * p_engine)
+{
+    while (p_engine->state == BLE_RACP_ENGINE_STATE_REPORTING)
+    {
+        ret_code_t err_code;
+
+        if (p_engine->index >= p_engine->end)
+        {
+            p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+            response_code_send(p_engine,
+                               RACP_OPCODE_REPORT_RECS,
+                               (p_engine->reported > 0) ? RACP_RESPONSE_SUCCESS
+                                                        : RACP_RESPONSE_NO_RECORDS_FOUND);
+            return;
+        }
+
+        err_code = p_engine->p_backend->record_send(p_engine->p_context, p_engine->index);
+        switch (err_code)
+        {
+            case NRF_SUCCESS:
+                p_engine->index++;
+                p_engine->reported++;
+                p_engine->in_flight++;
+                break;
+
+            case BLE_ERROR_NO_TX_PACKETS:
+                // Wait for TX_COMPLETE event to resume transmission.
+                return;
+
+            case NRF_ERROR_INVALID_STATE:
+                // Notification is probably not enabled. Ignore request.
+                p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+                return;
+
+            default:
+                error_report(p_engine, err_code);
+                p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+                return;
+        }
+    }
+}
+
+
+/**@brief Function for deleting a range of records.
+ *
+ * @return The response code value.
+ */
+static uint8_t records_delete(ble_racp_engine_t * p_engine, uint16_t first, uint16_t end)
+{
+    if (first >= end)
+    {
+        return RACP_RESPONSE_NO_RECORDS_FOUND;
+    }
+
+    // Delete from the end so that the remaining indices stay valid.
+    while (end > first)
+    {
+        ret_code_t err_code = p_engine->p_backend->record_delete(p_engine->p_context, end - 1);
+        if (err_code != NRF_SUCCESS)
+        {
+            error_report(p_engine, err_code);
+            return RACP_RESPONSE_PROCEDURE_NOT_DONE;
+        }
+        end--;
+    }
+    return RACP_RESPONSE_SUCCESS;
+}
+
+
+/**@brief Function for executing an Abort Operation request. */
+static void abort_execute(ble_racp_engine_t * p_engine, ble_racp_value_t const * p_request)
+{
+    uint8_t response_code;
+
+    if (p_engine->state != BLE_RACP_ENGINE_STATE_REPORTING)
+    {
+        response_code = RACP_RESPONSE_ABORT_FAILED;
+    }
+    else if (p_request->operator != RACP_OPERATOR_NULL)
+    {
+        response_code = RACP_RESPONSE_INVALID_OPERATOR;
+    }
+    else if (p_request->operand_len != 0)
+    {
+        response_code = RACP_RESPONSE_INVALID_OPERAND;
+    }
+    else
+    {
+        response_code = RACP_RESPONSE_SUCCESS;
+    }
+
+    // Any response to an abort ends the running procedure.
+    p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+    response_code_send(p_engine, RACP_OPCODE_ABORT_OPERATION, response_code);
+}
+
+
+ret_code_t ble_racp_engine_init(ble_racp_engine_t * p_engine, ble_racp_engine_init_t const * p_init)
+{
+    VERIFY_PARAM_NOT_NULL(p_engine);
+    VERIFY_PARAM_NOT_NULL(p_init);
+    VERIFY_PARAM_NOT_NULL(p_init->p_backend);
+    VERIFY_PARAM_NOT_NULL(p_init->p_backend->range_get);
+    VERIFY_PARAM_NOT_NULL(p_init->p_backend->record_send);
+    VERIFY_PARAM_NOT_NULL(p_init->p_backend->record_delete);
+
+    memset(p_engine, 0, sizeof(ble_racp_engine_t));
+
+    p_engine->p_backend         = p_init->p_backend;
+    p_engine->p_context         = p_init->p_context;
+    p_engine->racp_value_handle = p_init->racp_value_handle;
+    p_engine->error_handler     = p_init->error_handler;
+    p_engine->conn_handle       = BLE_CONN_HANDLE_INVALID;
+    p_engine->state             = BLE_RACP_ENGINE_STATE_IDLE;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ble_racp_engine_request_check(ble_racp_engine_t const * p_engine,
+                                         ble_racp_value_t const  * p_request)
+{
+    if ((p_request->opcode != RACP_OPCODE_ABORT_OPERATION)
+        && (p_engine->state != BLE_RACP_ENGINE_STATE_IDLE))
+    {
+        return NRF_ERROR_BUSY;
+    }
+    return NRF_SUCCESS;
+}
+
+
+void ble_racp_engine_request_execute(ble_racp_engine_t * p_engine, ble_racp_value_t const * p_request)
+{
+    uint16_t first = 0;
+    uint16_t end   = 0;
+    uint8_t  response_code;
+
+    switch (p_request->opcode)
+    {
+        case RACP_OPCODE_ABORT_OPERATION:
+            abort_execute(p_engine, p_request);
+            return;
+
+        case RACP_OPCODE_REPORT_RECS:
+        case RACP_OPCODE_REPORT_NUM_RECS:
+        case RACP_OPCODE_DELETE_RECS:
+            response_code = p_engine->p_backend->range_get(p_engine->p_context,
+                                                           p_request,
+                                                           &first,
+                                                           &end);
+            end           = MAX(first, end);
+            break;
+
+        default:
+            response_code = RACP_RESPONSE_OPCODE_UNSUPPORTED;
+            break;
+    }
+
+    if (response_code != RACP_RESPONSE_SUCCESS)
+    {
+        p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+        response_code_send(p_engine, p_request->opcode, response_code);
+        return;
+    }
+
+    switch (p_request->opcode)
+    {
+        case RACP_OPCODE_REPORT_RECS:
+            p_engine->state    = BLE_RACP_ENGINE_STATE_REPORTING;
+            p_engine->index    = first;
+            p_engine->end      = end;
+            p_engine->reported = 0;
+            records_report(p_engine);
+            break;
+
+        case RACP_OPCODE_REPORT_NUM_RECS:
+            num_records_send(p_engine, end - first);
+            break;
+
+        default:
+            response_code_send(p_engine, RACP_OPCODE_DELETE_RECS, records_delete(p_engine, first, end));
+            break;
+    }
+}
+
+
+void ble_racp_engine_on_ble_evt(ble_racp_engine_t * p_engine, ble_evt_t const * p_ble_evt)
+{
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            p_engine->conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            p_engine->state       = BLE_RACP_ENGINE_STATE_IDLE;
+            p_engine->in_flight   = 0;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            p_engine->conn_handle = BLE_CONN_HANDLE_INVALID;
+            p_engine->state       = BLE_RACP_ENGINE_STATE_IDLE;
+            p_engine->in_flight   = 0;
+            break;
+
+        case BLE_EVT_TX_COMPLETE:
+            p_engine->in_flight = 0;
+
+            if (p_engine->state == BLE_RACP_ENGINE_STATE_RESPONSE_PENDING)
+            {
+                response_send(p_engine);
+            }
+            else if (p_engine->state == BLE_RACP_ENGINE_STATE_REPORTING)
+            {
+                records_report(p_engine);
+            }
+            break;
+
+        case BLE_GATTS_EVT_HVC:
+            if (p_ble_evt->evt.gatts_evt.params.hvc.handle == p_engine->racp_value_handle)
+            {
+                if (p_engine->state == BLE_RACP_ENGINE_STATE_RESPONSE_IND_VERIF)
+                {
+                    // Indication has been acknowledged. Return to default state.
+                    p_engine->state = BLE_RACP_ENGINE_STATE_IDLE;
+                }
+                else
+                {
+                    // We did not expect this event in this state.
+                    error_report(p_engine, NRF_ERROR_INVALID_STATE);
+                }
+            }
+            break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
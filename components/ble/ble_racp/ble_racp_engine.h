@@ -0,0 +1,159 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_lib_racp_engine Record Access Control Point engine
+ * @{
+ * @ingroup ble_sdk_lib_racp
+ * @brief Record transfer engine for services with a Record Access Control Point.
+ *
+ * @details The engine runs the Record Access Control Point procedures of a service: Report
+ *          Stored Records, Report Number of Stored Records, Delete Stored Records and Abort
+ *          Operation, and sends their responses as indications.
+ *
+ *          The records are kept by a storage backend of the service and addressed by index, from
+ *          the oldest record. The backend maps the operator and the operand of a request to a
+ *          range of indices, and sends the record of an index as a notification. Records are
+ *          sent until the SoftDevice has no free TX buffer, and sending resumes at each
+ *          TX_COMPLETE event, so records are reported at the rate of the link. The response of
+ *          a procedure is sent once the TX buffers of its records are released.
+ *
+ *          The service checks the CCCDs and replies to the write authorization request of the
+ *          Record Access Control Point. It calls @ref ble_racp_engine_request_check before the
+ *          reply, and @ref ble_racp_engine_request_execute after it.
+ */
+
+#ifndef BLE_RACP_ENGINE_H__
+#define BLE_RACP_ENGINE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "ble_racp.h"
+#include "ble_srv_common.h"
+#include "sdk_errors.h"
+
+/**@brief Storage backend of a record access service. */
+typedef struct
+{
+    /**@brief Function for finding the records of a request.
+     *
+     * @details Called for the Report Stored Records, Report Number of Stored Records and Delete
+     *          Stored Records procedures. An empty range is reported as no records found.
+     *
+     * @param[in]  p_context  Context of the backend.
+     * @param[in]  p_request  Request.
+     * @param[out] p_first    Index of the first matching record.
+     * @param[out] p_end      Index after the last matching record.
+     *
+     * @return RACP_RESPONSE_SUCCESS if the operator and the operand are valid, otherwise the
+     *         response code to send.
+     */
+    uint8_t (*range_get)(void                   * p_context,
+                         ble_racp_value_t const * p_request,
+                         uint16_t               * p_first,
+                         uint16_t               * p_end);
+
+    /**@brief Function for sending a record as a notification.
+     *
+     * @param[in] p_context  Context of the backend.
+     * @param[in] index      Index of the record.
+     *
+     * @retval NRF_SUCCESS              If the record was sent.
+     * @retval BLE_ERROR_NO_TX_PACKETS  If there is no free TX buffer. The record is sent again
+     *                                  after the next TX_COMPLETE event.
+     * @retval -                        Any other error code ends the procedure.
+     */
+    ret_code_t (*record_send)(void * p_context, uint16_t index);
+
+    /**@brief Function for deleting a record. Records are deleted from the last one of the range,
+     *        so the indices of the remaining records do not change.
+     */
+    ret_code_t (*record_delete)(void * p_context, uint16_t index);
+} ble_racp_engine_backend_t;
+
+/**@brief Initialization parameters. */
+typedef struct
+{
+    ble_racp_engine_backend_t const * p_backend;          /**< Storage backend. */
+    void                            * p_context;          /**< Context passed to the backend. */
+    uint16_t                          racp_value_handle;  /**< Value handle of the Record Access Control Point. */
+    ble_srv_error_handler_t           error_handler;      /**< Function to be called in case of an error. */
+} ble_racp_engine_init_t;
+
+/**@brief Engine state. */
+typedef enum
+{
+    BLE_RACP_ENGINE_STATE_IDLE,                           /**< No procedure is running. */
+    BLE_RACP_ENGINE_STATE_REPORTING,                      /**< Records are being reported. */
+    BLE_RACP_ENGINE_STATE_RESPONSE_PENDING,               /**< A response is waiting for a free TX buffer. */
+    BLE_RACP_ENGINE_STATE_RESPONSE_IND_VERIF              /**< A response is waiting for its confirmation. */
+} ble_racp_engine_state_t;
+
+/**@brief Record access engine. The fields are internal to the module. */
+typedef struct
+{
+    ble_racp_engine_backend_t const * p_backend;            /**< Storage backend. */
+    void                            * p_context;            /**< Context passed to the backend. */
+    uint16_t                          racp_value_handle;    /**< Value handle of the Record Access Control Point. */
+    ble_srv_error_handler_t           error_handler;        /**< Function to be called in case of an error. */
+    uint16_t                          conn_handle;          /**< Handle of the current connection. */
+    ble_racp_engine_state_t           state;                /**< Procedure state. */
+    uint16_t                          index;                /**< Index of the next record to report. */
+    uint16_t                          end;                  /**< Index after the last record to report. */
+    uint16_t                          reported;             /**< Number of records reported by the procedure. */
+    uint16_t                          in_flight;            /**< Records sent since the last TX_COMPLETE event. */
+    ble_racp_value_t                  response;             /**< Response to send. */
+    uint8_t                           response_operand[2];  /**< Operand of the response. */
+} ble_racp_engine_t;
+
+/**@brief Function for initializing a record access engine.
+ *
+ * @param[out] p_engine  Engine.
+ * @param[in]  p_init    Initialization parameters.
+ *
+ * @retval NRF_SUCCESS     If the engine was initialized.
+ * @retval NRF_ERROR_NULL  If a pointer or a function of the backend is NULL.
+ */
+ret_code_t ble_racp_engine_init(ble_racp_engine_t * p_engine, ble_racp_engine_init_t const * p_init);
+
+/**@brief Function for checking if a request can be executed.
+ *
+ * @param[in] p_engine   Engine.
+ * @param[in] p_request  Decoded request.
+ *
+ * @retval NRF_SUCCESS     If the request is to be executed, or answered with a response code.
+ * @retval NRF_ERROR_BUSY  If a procedure is in progress and the request is not an abort. The
+ *                         service rejects the write.
+ */
+ret_code_t ble_racp_engine_request_check(ble_racp_engine_t const * p_engine,
+                                         ble_racp_value_t const  * p_request);
+
+/**@brief Function for executing a request accepted by @ref ble_racp_engine_request_check.
+ *
+ * @details Invalid requests are answered with a response code, and end the running procedure.
+ *
+ * @param[in,out] p_engine   Engine.
+ * @param[in]     p_request  Decoded request.
+ */
+void ble_racp_engine_request_execute(ble_racp_engine_t * p_engine, ble_racp_value_t const * p_request);
+
+/**@brief Function for handling BLE events.
+ *
+ * @param[in,out] p_engine   Engine.
+ * @param[in]     p_ble_evt  Event received from the BLE stack.
+ */
+void ble_racp_engine_on_ble_evt(ble_racp_engine_t * p_engine, ble_evt_t const * p_ble_evt);
+
+#endif // BLE_RACP_ENGINE_H__
+
+/** @} */
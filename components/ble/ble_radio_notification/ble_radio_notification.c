@@ -11,11 +11,178 @@
 
 #include "ble_radio_notification.h"
 #include <stdlib.h>
+#include "nrf_error.h"
+#include "nordic_common.h"
+#if (BLE_RADIO_NOTIFICATION_JOBS_ENABLED)
+#include "app_timer.h"
+#include "app_util_platform.h"
+#endif
 
 
+/**@brief Converts app_timer ticks to microseconds. */
+#define TICKS_TO_US(ticks) \
+    ((uint32_t)(((uint64_t)(ticks) * 1000000 * (BLE_RADIO_NOTIFICATION_TIMER_PRESCALER + 1)) / 32768))
+
+/**@brief Converts microseconds to app_timer ticks, rounding up. */
+#define US_TO_TICKS(us) \
+    ((uint32_t)(((uint64_t)(us) * 32768 + 1000000 * (BLE_RADIO_NOTIFICATION_TIMER_PRESCALER + 1) - 1) / \
+                (1000000 * (BLE_RADIO_NOTIFICATION_TIMER_PRESCALER + 1))))
+
+/**@brief Posted job. */
+typedef struct
+{
+    ble_radio_notification_job_t job;            /**< Job to run. */
+    void                       * p_context;      /**< Context passed to the job. */
+    uint32_t                     duration_us;    /**< Estimated duration of the job. */
+} radio_job_t;
+
 static bool                                 m_radio_active = false;  /**< Current radio state. */
 static ble_radio_notification_evt_handler_t m_evt_handler  = NULL;   /**< Application event handler for handling Radio Notification events. */
 
+#if (BLE_RADIO_NOTIFICATION_JOBS_ENABLED)
+static radio_job_t m_jobs[BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE];   /**< Queue of posted jobs. */
+static uint8_t     m_jobs_rp;                                        /**< Index of the first posted job. */
+static uint8_t     m_jobs_count;                                     /**< Number of posted jobs. */
+static bool        m_jobs_running;                                   /**< True while jobs are processed, so that another interrupt does not run them too. */
+static uint32_t    m_gaps[BLE_RADIO_NOTIFICATION_GAP_HISTORY];       /**< Last measured gaps, in ticks. 0 if not measured. */
+static uint8_t     m_gaps_index;                                     /**< Index of the oldest measured gap. */
+static bool        m_gap_started  = false;                           /**< True if an Inactive event has been received. */
+static uint32_t    m_gap_start;                                      /**< Time of the last Inactive event, in ticks. */
+APP_TIMER_DEF(m_job_timer);                                          /**< Timer used to run jobs when the radio is idle. */
+
+
+/**@brief Function for getting the expected length of the next gap, in ticks, or 0 if no gap has
+ *        been measured.
+ */
+static uint32_t gap_ticks_get(void)
+{
+    uint32_t gap = 0;
+
+    for (uint32_t i = 0; i < BLE_RADIO_NOTIFICATION_GAP_HISTORY; i++)
+    {
+        if ((m_gaps[i] != 0) && ((gap == 0) || (m_gaps[i] < gap)))
+        {
+            gap = m_gaps[i];
+        }
+    }
+
+    return gap;
+}
+
+
+/**@brief Function for running the posted jobs which fit in the rest of the current gap.
+ *
+ * @details If the next job does not fit, the timer is started to end with the gap, so that the
+ *          jobs are run if the radio stays idle.
+ */
+static void jobs_process(void)
+{
+    bool run;
+
+    CRITICAL_REGION_ENTER();
+    run            = !m_jobs_running;
+    m_jobs_running = true;
+    CRITICAL_REGION_EXIT();
+
+    if (!run)
+    {
+        // The jobs are being processed in another interrupt, which checks the radio state before
+        // each job.
+        return;
+    }
+
+    for (;;)
+    {
+        radio_job_t job;
+        bool        done;
+        uint32_t    gap = gap_ticks_get();
+        uint32_t    ticks;
+        uint32_t    elapsed;
+
+        CRITICAL_REGION_ENTER();
+        done = (m_jobs_count == 0) || m_radio_active;
+        if (done)
+        {
+            // The next Inactive event resumes the processing.
+            m_jobs_running = false;
+        }
+        job = m_jobs[m_jobs_rp];
+        CRITICAL_REGION_EXIT();
+
+        if (done)
+        {
+            return;
+        }
+
+        (void)app_timer_cnt_get(&ticks);
+        (void)app_timer_cnt_diff_compute(ticks, m_gap_start, &elapsed);
+
+        if (m_gap_started && (gap != 0) && (elapsed < gap) &&
+            (TICKS_TO_US(gap - elapsed) < job.duration_us + BLE_RADIO_NOTIFICATION_MARGIN_US))
+        {
+            // Wait for the next gap. If the radio does not become active shortly after this gap
+            // is expected to end, it is idle.
+            uint32_t timeout = gap - elapsed + US_TO_TICKS(BLE_RADIO_NOTIFICATION_MARGIN_US);
+
+            timeout = (timeout > APP_TIMER_MIN_TIMEOUT_TICKS) ? timeout : APP_TIMER_MIN_TIMEOUT_TICKS;
+
+            (void)app_timer_stop(m_job_timer);
+            (void)app_timer_start(m_job_timer, timeout, NULL);
+
+            m_jobs_running = false;
+            return;
+        }
+
+        // The job fits, or there is no information about the next radio event.
+        CRITICAL_REGION_ENTER();
+        m_jobs_rp = (m_jobs_rp + 1) % BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE;
+        m_jobs_count--;
+        CRITICAL_REGION_EXIT();
+
+        job.job(job.p_context);
+    }
+}
+
+
+/**@brief Function for handling the timeout of the job timer. */
+static void job_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    jobs_process();
+}
+
+
+/**@brief Function for measuring the gaps and running the jobs on Radio Notification events.
+ *
+ * @param[in]  radio_active   Whether the radio is about to become active or has become inactive.
+ */
+static void jobs_on_radio_evt(bool radio_active)
+{
+    uint32_t ticks;
+
+    (void)app_timer_cnt_get(&ticks);
+
+    if (radio_active)
+    {
+        if (m_gap_started)
+        {
+            (void)app_timer_cnt_diff_compute(ticks, m_gap_start, &m_gaps[m_gaps_index]);
+            m_gaps_index = (m_gaps_index + 1) % BLE_RADIO_NOTIFICATION_GAP_HISTORY;
+        }
+
+        (void)app_timer_stop(m_job_timer);
+    }
+    else
+    {
+        m_gap_started = true;
+        m_gap_start   = ticks;
+
+        jobs_process();
+    }
+}
+#endif // BLE_RADIO_NOTIFICATION_JOBS_ENABLED
+
 
 void SWI1_IRQHandler(void)
 {
@@ -24,6 +191,10 @@ void SWI1_IRQHandler(void)
     {
         m_evt_handler(m_radio_active);
     }
+
+#if (BLE_RADIO_NOTIFICATION_JOBS_ENABLED)
+    jobs_on_radio_evt(m_radio_active);
+#endif
 }
 
 
@@ -35,6 +206,14 @@ uint32_t ble_radio_notification_init(uint32_t                             irq_pr
 
     m_evt_handler = evt_handler;
 
+#if (BLE_RADIO_NOTIFICATION_JOBS_ENABLED)
+    err_code = app_timer_create(&m_job_timer, APP_TIMER_MODE_SINGLE_SHOT, job_timeout_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+#endif
+
     // Initialize Radio Notification software interrupt
     err_code = sd_nvic_ClearPendingIRQ(SWI1_IRQn);
     if (err_code != NRF_SUCCESS)
@@ -57,3 +236,60 @@ uint32_t ble_radio_notification_init(uint32_t                             irq_pr
     // Configure the event
     return sd_radio_notification_cfg_set(NRF_RADIO_NOTIFICATION_TYPE_INT_ON_BOTH, distance);
 }
+
+
+uint32_t ble_radio_notification_job_post(ble_radio_notification_job_t job,
+                                         void                       * p_context,
+                                         uint32_t                     duration_us)
+{
+#if (BLE_RADIO_NOTIFICATION_JOBS_ENABLED)
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (job == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (m_jobs_count < BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE)
+    {
+        radio_job_t * p_job = &m_jobs[(m_jobs_rp + m_jobs_count) % BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE];
+
+        p_job->job         = job;
+        p_job->p_context   = p_context;
+        p_job->duration_us = duration_us;
+        m_jobs_count++;
+    }
+    else
+    {
+        err_code = NRF_ERROR_NO_MEM;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if ((err_code == NRF_SUCCESS) && !m_radio_active)
+    {
+        // Run the job from the timer handler if it fits in the current gap. Otherwise the timer is
+        // restarted to end with the gap.
+        (void)app_timer_stop(m_job_timer);
+        (void)app_timer_start(m_job_timer, APP_TIMER_MIN_TIMEOUT_TICKS, NULL);
+    }
+
+    return err_code;
+#else
+    UNUSED_PARAMETER(job);
+    UNUSED_PARAMETER(p_context);
+    UNUSED_PARAMETER(duration_us);
+
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t ble_radio_notification_gap_get(void)
+{
+#if (BLE_RADIO_NOTIFICATION_JOBS_ENABLED)
+    return TICKS_TO_US(gap_ticks_get());
+#else
+    return 0;
+#endif
+}
@@ -15,6 +15,14 @@
  * @{
  * @ingroup ble_sdk_lib
  * @brief Module for propagating Radio Notification events to the application.
+ *
+ * @details The module can also run jobs in the gaps between radio events. A job is posted with
+ *          an estimate of its duration, and is run at the start of the first gap that is long
+ *          enough for it. The length of the gaps is measured from the Radio Notification
+ *          events, so the module must be initialized with a distance that leaves time for
+ *          the SoftDevice to stop the job (see @ref ble_radio_notification_job_post).
+ *          This option is enabled with @ref BLE_RADIO_NOTIFICATION_JOBS_ENABLED, and requires the
+ *          app_timer module.
  */
 
 #ifndef BLE_RADIO_NOTIFICATION_H__
@@ -24,9 +32,35 @@
 #include <stdbool.h>
 #include "nrf_soc.h"
 
+#ifndef BLE_RADIO_NOTIFICATION_JOBS_ENABLED
+#define BLE_RADIO_NOTIFICATION_JOBS_ENABLED     0       /**< Enables running jobs in the gaps between radio events. */
+#endif
+
+#ifndef BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE
+#define BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE   4       /**< Maximum number of posted jobs. */
+#endif
+
+#ifndef BLE_RADIO_NOTIFICATION_GAP_HISTORY
+#define BLE_RADIO_NOTIFICATION_GAP_HISTORY      4       /**< Number of measured gaps. The shortest of them is the expected length of the next gap, as gaps of connections and advertising alternate. */
+#endif
+
+#ifndef BLE_RADIO_NOTIFICATION_TIMER_PRESCALER
+#define BLE_RADIO_NOTIFICATION_TIMER_PRESCALER  0       /**< Prescaler used to initialize the app_timer module. */
+#endif
+
+#ifndef BLE_RADIO_NOTIFICATION_MARGIN_US
+#define BLE_RADIO_NOTIFICATION_MARGIN_US        300     /**< Time subtracted from each gap, in microseconds, for the interrupt latency and the variation of the gaps. */
+#endif
+
 /**@brief Application radio notification event handler type. */
 typedef void (*ble_radio_notification_evt_handler_t) (bool radio_active);
 
+/**@brief Job run in a gap between radio events.
+ *
+ * @param[in]  p_context      Context passed to @ref ble_radio_notification_job_post.
+ */
+typedef void (*ble_radio_notification_job_t) (void * p_context);
+
 /**@brief Function for initializing the Radio Notification module.
  *
  * @param[in]  irq_priority   Interrupt priority for the Radio Notification interrupt handler.
@@ -40,6 +74,43 @@ uint32_t ble_radio_notification_init(uint32_t                             irq_pr
                                      nrf_radio_notification_distance_t    distance,
                                      ble_radio_notification_evt_handler_t evt_handler);
 
+/**@brief Function for posting a job to be run in a gap between radio events.
+ *
+ * @details The job is run at the start of the first gap which is expected to last at least
+ *          @p duration_us, in the Radio Notification interrupt, after the event handler. Jobs
+ *          are run in the order in which they were posted. If the radio does not become active
+ *          when a gap is expected to end, the radio is considered idle, and the jobs are run
+ *          from the app_timer handler. They are also run from there when no gap has been measured
+ *          yet.
+ *
+ *          A gap is measured from the Inactive event to the next Active event, which comes the
+ *          distance given to @ref ble_radio_notification_init before the radio is used. The
+ *          shortest of the last @ref BLE_RADIO_NOTIFICATION_GAP_HISTORY gaps is the expected length
+ *          of the next gap. A job which is longer than the gaps runs when the radio becomes idle.
+ *
+ * @note    The app_timer module must be initialized before @ref ble_radio_notification_init is
+ *          called.
+ *
+ * @param[in]  job            Job to run.
+ * @param[in]  p_context      Context passed to the job.
+ * @param[in]  duration_us    Estimated duration of the job, in microseconds.
+ *
+ * @retval     NRF_SUCCESS             If the job was posted.
+ * @retval     NRF_ERROR_NULL          If @p job is NULL.
+ * @retval     NRF_ERROR_NO_MEM        If @ref BLE_RADIO_NOTIFICATION_JOB_QUEUE_SIZE jobs are posted.
+ * @retval     NRF_ERROR_NOT_SUPPORTED If @ref BLE_RADIO_NOTIFICATION_JOBS_ENABLED is not set.
+ */
+uint32_t ble_radio_notification_job_post(ble_radio_notification_job_t job,
+                                         void                       * p_context,
+                                         uint32_t                     duration_us);
+
+/**@brief Function for getting the expected length of the next gap between radio events.
+ *
+ * @return     Expected length in microseconds, without @ref BLE_RADIO_NOTIFICATION_MARGIN_US,
+ *             or 0 if no gap has been measured.
+ */
+uint32_t ble_radio_notification_gap_get(void);
+
 #endif // BLE_RADIO_NOTIFICATION_H__
 
 /** @} */
@@ -0,0 +1,255 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+#include "ble_scan_filter.h"
+#include <string.h>
+#include "app_timer.h"
+#include "sdk_common.h"
+
+
+#define FNV_OFFSET_BASIS    2166136261UL    /**< FNV-1a offset basis. */
+#define FNV_PRIME           16777619UL      /**< FNV-1a prime. */
+#define UUID16_SIZE         2               /**< Size of a 16-bit UUID, in bytes. */
+#define UUID128_SIZE        16              /**< Size of a 128-bit UUID, in bytes. */
+
+
+/**@brief Function for hashing an address. The hash is never 0, which marks free cache entries. */
+static uint32_t addr_hash(ble_gap_addr_t const * p_addr)
+{
+    uint32_t hash = (FNV_OFFSET_BASIS ^ p_addr->addr_type) * FNV_PRIME;
+
+    for (uint32_t i = 0; i < BLE_GAP_ADDR_LEN; i++)
+    {
+        hash = (hash ^ p_addr->addr[i]) * FNV_PRIME;
+    }
+
+    return (hash == 0) ? 1 : hash;
+}
+
+
+/**@brief Function for checking if an address is in the address list. */
+static bool addr_match(ble_scan_filter_init_t const * p_config, ble_gap_addr_t const * p_addr)
+{
+    for (uint32_t i = 0; i < p_config->addr_count; i++)
+    {
+        ble_gap_addr_t const * p_entry = &p_config->p_addrs[i];
+
+        if ((p_entry->addr_type == p_addr->addr_type)
+            && (memcmp(p_entry->addr, p_addr->addr, BLE_GAP_ADDR_LEN) == 0))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**@brief Function for checking if a name field starts with the name prefix. */
+static bool name_match(ble_scan_filter_t const * p_filter, uint8_t const * p_name, uint8_t len)
+{
+    return (len >= p_filter->name_len)
+           && (memcmp(p_name, p_filter->config.p_name_prefix, p_filter->name_len) == 0);
+}
+
+
+/**@brief Function for checking if a UUID field has one of the 16-bit UUIDs. */
+static bool uuid16_match(ble_scan_filter_init_t const * p_config, uint8_t const * p_uuids, uint8_t len)
+{
+    for (uint32_t offset = 0; offset + UUID16_SIZE <= len; offset += UUID16_SIZE)
+    {
+        uint16_t uuid = uint16_decode(&p_uuids[offset]);
+
+        for (uint32_t i = 0; i < p_config->uuid16_count; i++)
+        {
+            if (p_config->p_uuids16[i] == uuid)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+/**@brief Function for checking if a UUID field has one of the 128-bit UUIDs. */
+static bool uuid128_match(ble_scan_filter_init_t const * p_config, uint8_t const * p_uuids, uint8_t len)
+{
+    for (uint32_t offset = 0; offset + UUID128_SIZE <= len; offset += UUID128_SIZE)
+    {
+        for (uint32_t i = 0; i < p_config->uuid128_count; i++)
+        {
+            if (memcmp(p_config->p_uuids128[i].uuid128, &p_uuids[offset], UUID128_SIZE) == 0)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+/**@brief Function for checking the name and the UUIDs of the advertising data in one pass. */
+static bool data_match(ble_scan_filter_t const * p_filter, uint8_t const * p_data, uint16_t len)
+{
+    ble_scan_filter_init_t const * p_config = &p_filter->config;
+
+    bool     name_ok = (p_config->p_name_prefix == NULL);
+    bool     uuid_ok = (p_config->uuid16_count == 0) && (p_config->uuid128_count == 0);
+    uint32_t index   = 0;
+
+    while (!(name_ok && uuid_ok) && (index + 1 < len))
+    {
+        uint8_t         field_length = p_data[index];
+        uint8_t         field_type   = p_data[index + 1];
+        uint8_t const * p_field      = &p_data[index + 2];
+
+        if ((field_length == 0) || (index + 1 + field_length > len))
+        {
+            break;
+        }
+
+        switch (field_type)
+        {
+            case BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME:
+            case BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME:
+                name_ok = name_ok || name_match(p_filter, p_field, field_length - 1);
+                break;
+
+            case BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE:
+            case BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE:
+                uuid_ok = uuid_ok || uuid16_match(p_config, p_field, field_length - 1);
+                break;
+
+            case BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE:
+            case BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE:
+                uuid_ok = uuid_ok || uuid128_match(p_config, p_field, field_length - 1);
+                break;
+
+            default:
+                break;
+        }
+
+        index += field_length + 1;
+    }
+
+    return name_ok && uuid_ok;
+}
+
+
+ret_code_t ble_scan_filter_init(ble_scan_filter_t * p_filter, ble_scan_filter_init_t const * p_init)
+{
+    VERIFY_PARAM_NOT_NULL(p_filter);
+    VERIFY_PARAM_NOT_NULL(p_init);
+
+    if (((p_init->addr_count != 0) && (p_init->p_addrs == NULL))
+        || ((p_init->uuid16_count != 0) && (p_init->p_uuids16 == NULL))
+        || ((p_init->uuid128_count != 0) && (p_init->p_uuids128 == NULL)))
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    memset(p_filter, 0, sizeof(ble_scan_filter_t));
+    p_filter->config = *p_init;
+
+    if (p_init->p_name_prefix != NULL)
+    {
+        p_filter->name_len = (uint8_t)MIN(strlen(p_init->p_name_prefix), BLE_GAP_ADV_MAX_SIZE);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+bool ble_scan_filter_match(ble_scan_filter_t * p_filter, ble_gap_evt_adv_report_t const * p_report)
+{
+    ble_scan_filter_init_t const * p_config = &p_filter->config;
+    ble_scan_filter_dedup_t *      p_entry  = NULL;
+    uint32_t                       hash     = 0;
+    uint32_t                       now      = 0;
+
+    if (p_report->rssi < p_config->rssi_min)
+    {
+        return false;
+    }
+
+    if ((p_config->p_addrs != NULL) && !addr_match(p_config, &p_report->peer_addr))
+    {
+        return false;
+    }
+
+    if (p_config->dedup_timeout != 0)
+    {
+        hash    = addr_hash(&p_report->peer_addr);
+        p_entry = &p_filter->dedup[hash & (BLE_SCAN_FILTER_DEDUP_SIZE - 1)];
+
+        (void)app_timer_cnt_get(&now);
+
+        if (p_entry->hash == hash)
+        {
+            uint32_t elapsed;
+
+            (void)app_timer_cnt_diff_compute(now, p_entry->ticks, &elapsed);
+            if (elapsed < p_config->dedup_timeout)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!data_match(p_filter, p_report->data, p_report->dlen))
+    {
+        return false;
+    }
+
+    if (p_entry != NULL)
+    {
+        // A device that collides with the entry replaces it.
+        p_entry->hash  = hash;
+        p_entry->ticks = now;
+    }
+    return true;
+}
+
+
+void ble_scan_filter_dedup_clear(ble_scan_filter_t * p_filter)
+{
+    memset(p_filter->dedup, 0, sizeof(p_filter->dedup));
+}
+
+
+ret_code_t ble_scan_filter_ad_find(uint8_t         type,
+                                   uint8_t const * p_data,
+                                   uint16_t        len,
+                                   uint8_array_t * p_typedata)
+{
+    uint32_t index = 0;
+
+    while (index + 1 < len)
+    {
+        uint8_t field_length = p_data[index];
+
+        if ((field_length == 0) || (index + 1 + field_length > len))
+        {
+            break;
+        }
+
+        if (p_data[index + 1] == type)
+        {
+            p_typedata->p_data = (uint8_t *)&p_data[index + 2];
+            p_typedata->size   = field_length - 1;
+            return NRF_SUCCESS;
+        }
+
+        index += field_length + 1;
+    }
+    return NRF_ERROR_NOT_FOUND;
+}
@@ -0,0 +1,145 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+/**@file
+ *
+ * @defgroup ble_sdk_lib_scan_filter Scan Report Filter
+ * @{
+ * @ingroup  ble_sdk_lib
+ * @brief    Module for filtering and deduplicating advertising reports in central applications.
+ *
+ * @details  The filter is set up once with @ref ble_scan_filter_init, and each
+ *           BLE_GAP_EVT_ADV_REPORT event is passed to @ref ble_scan_filter_match, which returns
+ *           true only for the reports of matching devices. All the configured filters must match:
+ *           the RSSI threshold, one of the addresses, the name prefix, and one of the service
+ *           UUIDs. Filters that are not configured match any report.
+ *
+ *           The cheapest checks are done first, so most reports are rejected without parsing
+ *           their data: the RSSI, the address list, and the deduplication cache. The cache keeps
+ *           a hash of the address of each device that matched, and rejects its reports until
+ *           the dedup timeout has passed. The name and the UUIDs are then found in one pass over
+ *           the advertising data, so they must be in the same advertising or scan response
+ *           report. The app_timer module must be initialized if deduplication is used.
+ *
+ * @code
+ * static ble_scan_filter_t m_scan_filter;
+ *
+ * ble_scan_filter_init_t init = {0};
+ *
+ * init.rssi_min      = BLE_SCAN_FILTER_RSSI_ANY;
+ * init.p_name_prefix = "Nordic";
+ * init.dedup_timeout = APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER);
+ * err_code = ble_scan_filter_init(&m_scan_filter, &init);
+ *
+ * // On BLE_GAP_EVT_ADV_REPORT:
+ * if (ble_scan_filter_match(&m_scan_filter, &p_gap_evt->params.adv_report))
+ * {
+ *     // Connect.
+ * }
+ * @endcode
+ */
+
+#ifndef BLE_SCAN_FILTER_H__
+#define BLE_SCAN_FILTER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_gap.h"
+#include "ble_types.h"
+#include "app_util.h"
+#include "sdk_errors.h"
+
+#ifndef BLE_SCAN_FILTER_DEDUP_SIZE
+#define BLE_SCAN_FILTER_DEDUP_SIZE  16                  /**< Entries of the deduplication cache. Must be a power of two. */
+#endif
+
+#define BLE_SCAN_FILTER_RSSI_ANY    (-128)              /**< RSSI threshold that matches any report. */
+
+STATIC_ASSERT(IS_POWER_OF_TWO(BLE_SCAN_FILTER_DEDUP_SIZE));
+
+/**@brief Filter configuration. The lists and the name must stay valid while the filter is used. */
+typedef struct
+{
+    int8_t                 rssi_min;        /**< Lowest RSSI of a matching report, in dBm, or @ref BLE_SCAN_FILTER_RSSI_ANY. */
+    ble_gap_addr_t const * p_addrs;         /**< Addresses, or NULL to match any address. */
+    uint8_t                addr_count;      /**< Number of addresses. */
+    char const *           p_name_prefix;   /**< Prefix of the complete or short local name, or NULL to match any name. */
+    uint16_t const *       p_uuids16;       /**< 16-bit service UUIDs. */
+    uint8_t                uuid16_count;    /**< Number of 16-bit service UUIDs. */
+    ble_uuid128_t const *  p_uuids128;      /**< 128-bit service UUIDs, little endian. */
+    uint8_t                uuid128_count;   /**< Number of 128-bit service UUIDs. No UUID filter if both counts are 0. */
+    uint32_t               dedup_timeout;   /**< Time a matching device is rejected for, in app_timer ticks. 0 to disable deduplication. */
+} ble_scan_filter_init_t;
+
+/**@brief Deduplication cache entry. */
+typedef struct
+{
+    uint32_t hash;                          /**< Hash of the address, or 0 if the entry is free. */
+    uint32_t ticks;                         /**< Time of the last match. */
+} ble_scan_filter_dedup_t;
+
+/**@brief Scan filter. The fields are internal to the module. */
+typedef struct
+{
+    ble_scan_filter_init_t  config;                                 /**< Filter configuration. */
+    uint8_t                 name_len;                               /**< Length of the name prefix. */
+    ble_scan_filter_dedup_t dedup[BLE_SCAN_FILTER_DEDUP_SIZE];      /**< Deduplication cache, indexed by address hash. */
+} ble_scan_filter_t;
+
+/**@brief Function for initializing a scan filter.
+ *
+ * @param[out] p_filter  Scan filter.
+ * @param[in]  p_init    Filter configuration.
+ *
+ * @retval NRF_SUCCESS     If the filter was initialized.
+ * @retval NRF_ERROR_NULL  If a pointer is NULL, or a list with a non-zero count is NULL.
+ */
+ret_code_t ble_scan_filter_init(ble_scan_filter_t * p_filter, ble_scan_filter_init_t const * p_init);
+
+/**@brief Function for checking an advertising report against the filter.
+ *
+ * @details A matching device is added to the deduplication cache, so its next reports are
+ *          rejected until the dedup timeout has passed.
+ *
+ * @param[in,out] p_filter  Scan filter.
+ * @param[in]     p_report  Advertising report of a BLE_GAP_EVT_ADV_REPORT event.
+ *
+ * @retval true   If the report matches and its device is not in the deduplication cache.
+ * @retval false  Otherwise.
+ */
+bool ble_scan_filter_match(ble_scan_filter_t * p_filter, ble_gap_evt_adv_report_t const * p_report);
+
+/**@brief Function for removing all devices from the deduplication cache, for example when
+ *        scanning is restarted.
+ */
+void ble_scan_filter_dedup_clear(ble_scan_filter_t * p_filter);
+
+/**@brief Function for finding a field in advertising data.
+ *
+ * @details Malformed fields end the search.
+ *
+ * @param[in]  type        AD type of the field.
+ * @param[in]  p_data      Advertising data.
+ * @param[in]  len         Length of the advertising data.
+ * @param[out] p_typedata  Data of the field, without its length and type.
+ *
+ * @retval NRF_SUCCESS          If the field was found.
+ * @retval NRF_ERROR_NOT_FOUND  If the field was not found.
+ */
+ret_code_t ble_scan_filter_ad_find(uint8_t         type,
+                                   uint8_t const * p_data,
+                                   uint16_t        len,
+                                   uint8_array_t * p_typedata);
+
+#endif // BLE_SCAN_FILTER_H__
+
+/** @} */
@@ -40,6 +40,10 @@
 
 #define BLE_ANCS_MAX_DISCOVERED_CENTRALS DEVICE_MANAGER_MAX_BONDS /**< Maximum number of discovered services that can be stored in the flash. This number should be identical to maximum number of bonded peer devices. */
 
+#define REQUEST_QUEUED                   0                        /**< Attribute request waiting to be written to the Control Point. */
+#define REQUEST_SENT                     1                        /**< Attribute request passed to the SoftDevice, not acknowledged yet. */
+#define REQUEST_ACKED                    2                        /**< Attribute request acknowledged by the Notification Provider, waiting for its response. */
+
 #define TIME_STRING_LEN                  15                       /**< Unicode Technical Standard (UTS) #35 date format pattern "yyyyMMdd'T'HHmmSS" + "'\0'". */
 
 #define DISCOVERED_SERVICE_DB_SIZE \
@@ -81,6 +85,10 @@ typedef struct
 static tx_message_t m_tx_buffer[TX_BUFFER_SIZE];                           /**< Transmit buffer for messages to be transmitted to the Notification Provider. */
 static uint32_t     m_tx_insert_index = 0;                                 /**< Current index in the transmit buffer where the next message should be inserted. */
 static uint32_t     m_tx_index        = 0;                                 /**< Current index in the transmit buffer from where the next message to be transmitted resides. */
+static uint16_t     m_tx_handle       = BLE_GATT_HANDLE_INVALID;           /**< Handle of the last message passed to the SoftDevice. */
+
+// Leave room in the transmit buffer for the CCCD writes.
+STATIC_ASSERT(BLE_ANCS_C_REQUESTS_MAX <= TX_BUFFER_SIZE - 3);
 
 
 /**@brief 128-bit service UUID for the Apple Notification Center Service.
@@ -143,7 +151,10 @@ static void on_disconnected(ble_ancs_c_t * p_ancs, const ble_evt_t * p_ble_evt)
 {
     if (p_ancs->conn_handle == p_ble_evt->evt.gap_evt.conn_handle)
     {
-        p_ancs->conn_handle = BLE_CONN_HANDLE_INVALID;
+        p_ancs->conn_handle        = BLE_CONN_HANDLE_INVALID;
+        p_ancs->request_count      = 0;
+        p_ancs->parse_state        = COMMAND_ID_AND_NOTIF_UID;
+        p_ancs->current_attr_index = 0;
     }
 }
 
@@ -216,19 +227,22 @@ static void tx_buffer_process(void)
     {
         uint32_t err_code;
 
+        uint16_t handle;
+
         if (m_tx_buffer[m_tx_index].type == READ_REQ)
         {
-            err_code = sd_ble_gattc_read(m_tx_buffer[m_tx_index].conn_handle,
-                                         m_tx_buffer[m_tx_index].req.read_handle,
-                                         0);
+            handle   = m_tx_buffer[m_tx_index].req.read_handle;
+            err_code = sd_ble_gattc_read(m_tx_buffer[m_tx_index].conn_handle, handle, 0);
         }
         else
         {
+            handle   = m_tx_buffer[m_tx_index].req.write_req.gattc_params.handle;
             err_code = sd_ble_gattc_write(m_tx_buffer[m_tx_index].conn_handle,
                                           &m_tx_buffer[m_tx_index].req.write_req.gattc_params);
         }
         if (err_code == NRF_SUCCESS)
         {
+            m_tx_handle = handle;
             ++m_tx_index;
             m_tx_index &= TX_BUFFER_MASK;
         }
@@ -236,11 +250,151 @@ static void tx_buffer_process(void)
 }
 
 
+uint32_t ble_ancs_get_notif_attrs(ble_ancs_c_t * p_ancs, const uint32_t p_uid);
+
+
+/**@brief Function for finding a queued attribute request.
+ *
+ * @param[in] p_ancs    Pointer to an ANCS instance.
+ * @param[in] notif_uid UID of the notification.
+ *
+ * @return Index of the request in the queue, or p_ancs->request_count if it is not queued.
+ */
+static uint32_t request_find(const ble_ancs_c_t * p_ancs, uint32_t notif_uid)
+{
+    uint32_t i;
+
+    for (i = 0; i < p_ancs->request_count; i++)
+    {
+        if (p_ancs->requests[i].notif_uid == notif_uid)
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+
+/**@brief Function for removing an attribute request from the queue.
+ *
+ * @param[in] p_ancs Pointer to an ANCS instance.
+ * @param[in] index  Index of the request in the queue.
+ */
+static void request_remove(ble_ancs_c_t * p_ancs, uint32_t index)
+{
+    if (index < p_ancs->request_count)
+    {
+        p_ancs->request_count--;
+        memmove(&p_ancs->requests[index],
+                &p_ancs->requests[index + 1],
+                (p_ancs->request_count - index) * sizeof(ble_ancs_c_request_t));
+    }
+}
+
+
+/**@brief Function for writing the queued attribute requests to the Control Point.
+ *
+ * @details Requests are written in the order they were queued, as long as fewer than
+ *          @ref BLE_ANCS_C_REQUESTS_MAX of them wait for their response. The Notification
+ *          Provider answers them in the same order.
+ *
+ * @param[in] p_ancs Pointer to an ANCS instance.
+ */
+static void requests_send(ble_ancs_c_t * p_ancs)
+{
+    uint32_t in_flight = 0;
+
+    for (uint32_t i = 0; i < p_ancs->request_count; i++)
+    {
+        if (p_ancs->requests[i].state != REQUEST_QUEUED)
+        {
+            in_flight++;
+            continue;
+        }
+        if (in_flight == BLE_ANCS_C_REQUESTS_MAX)
+        {
+            break;
+        }
+        if (ble_ancs_get_notif_attrs(p_ancs, p_ancs->requests[i].notif_uid) != NRF_SUCCESS)
+        {
+            // The transmit buffer is full. Retried when a write response is received.
+            break;
+        }
+        p_ancs->requests[i].state = REQUEST_SENT;
+        in_flight++;
+    }
+}
+
+
+/**@brief Function for queuing an attribute request.
+ *
+ * @param[in] p_ancs    Pointer to an ANCS instance.
+ * @param[in] notif_uid UID of the notification.
+ *
+ * @retval NRF_SUCCESS      If the request was queued, or was already in the queue.
+ * @retval NRF_ERROR_NO_MEM If the queue is full.
+ */
+static uint32_t request_queue(ble_ancs_c_t * p_ancs, uint32_t notif_uid)
+{
+    if (request_find(p_ancs, notif_uid) < p_ancs->request_count)
+    {
+        return NRF_SUCCESS;
+    }
+    if (p_ancs->request_count == BLE_ANCS_C_REQUEST_QUEUE_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_ancs->requests[p_ancs->request_count].notif_uid = notif_uid;
+    p_ancs->requests[p_ancs->request_count].state     = REQUEST_QUEUED;
+    p_ancs->request_count++;
+
+    requests_send(p_ancs);
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for ending the parsing of a response.
+ *        Used in the @ref parse_get_notif_attrs_response state machine.
+ *
+ * @details The request of the notification is removed from the queue, and the next GATTC
+ *          notification data is parsed as the start of a new response. If the response could
+ *          not be parsed, its notification is unknown and the oldest written request is removed.
+ *
+ * @param[in] p_ancs   Pointer to an ANCS instance to which the event belongs.
+ * @param[in] complete Whether all attributes of the response were received.
+ *
+ * @return The next parse state.
+ */
+static ble_ancs_c_parse_state_t response_end(ble_ancs_c_t * p_ancs, bool complete)
+{
+    uint32_t index = 0;
+
+    if (complete)
+    {
+        index = request_find(p_ancs, p_ancs->evt.attr.notif_uid);
+    }
+    else
+    {
+        while ((index < p_ancs->request_count) && (p_ancs->requests[index].state == REQUEST_QUEUED))
+        {
+            index++;
+        }
+    }
+    request_remove(p_ancs, index);
+    requests_send(p_ancs);
+
+    p_ancs->current_attr_index = 0;
+    return complete ? COMMAND_ID_AND_NOTIF_UID : DONE;
+}
+
+
 /**@brief Function for parsing command id and notification id.
  *        Used in the @ref parse_get_notif_attrs_response state machine.
  *
  * @details UID and command ID will be received only once at the beginning of the first 
  *          GATTC notification of a new attribute request for a given iOS notification.
+ *          They are parsed one byte at a time, using current_attr_index as the byte count.
  *
  * @param[in] p_ancs     Pointer to an ANCS instance to which the event belongs.
  * @param[in] p_data_src Pointer to data that was received from the Notification Provider.
@@ -252,27 +406,45 @@ static ble_ancs_c_parse_state_t command_id_and_notif_parse(ble_ancs_c_t * p_ancs
                                                            const uint8_t * p_data_src,
                                                            uint32_t * index)
 {
-    ble_ancs_c_command_id_values_t command_id;
+    if (p_ancs->current_attr_index == 0)
+    {
+        ble_ancs_c_command_id_values_t command_id;
 
-    command_id = (ble_ancs_c_command_id_values_t) p_data_src[(*index)++];
-    
-    if(command_id != BLE_ANCS_COMMAND_ID_GET_NOTIF_ATTRIBUTES)
+        command_id = (ble_ancs_c_command_id_values_t) p_data_src[(*index)++];
+
+        if (command_id != BLE_ANCS_COMMAND_ID_GET_NOTIF_ATTRIBUTES)
+        {
+            ANCS_LOG("[ANCS]: Invalid Command ID");
+            return response_end(p_ancs, false);
+        }
+        p_ancs->evt.attr.notif_uid = 0;
+    }
+    else
     {
-        ANCS_LOG("[ANCS]: Invalid Command ID");
-        return DONE;
+        p_ancs->evt.attr.notif_uid |=
+            (uint32_t)p_data_src[(*index)++] << (8 * (p_ancs->current_attr_index - 1));
     }
 
-     p_ancs->evt.attr.notif_uid  = uint32_decode(&p_data_src[*index]);
-     *index                     += sizeof(uint32_t);
-     return ATTR_ID;
+    if (++p_ancs->current_attr_index <= sizeof(uint32_t))
+    {
+        return COMMAND_ID_AND_NOTIF_UID;
+    }
+
+    p_ancs->current_attr_index       = 0;
+    p_ancs->expected_number_of_attrs = p_ancs->number_of_requested_attr;
 
+    if (p_ancs->expected_number_of_attrs == 0)
+    {
+        return response_end(p_ancs, true);
+    }
+    return ATTR_ID;
 }
 
 /**@brief Function for parsing the id of an iOS attribute.
  *        Used in the @ref parse_get_notif_attrs_response state machine.
  *
- * @details We only request attributes that are registered with @ref ble_ancs_c_attr_add
- *          once they have been reveiced we stop parsing.
+ * @details The attributes are parsed in the order they are received. The data of attributes
+ *          that are not registered with @ref ble_ancs_c_attr_add is skipped.
  *
  * @param[in] p_ancs     Pointer to an ANCS instance to which the event belongs.
  * @param[in] p_data_src Pointer to data that was received from the Notification Provider.
@@ -284,25 +456,17 @@ static ble_ancs_c_parse_state_t attr_id_parse(ble_ancs_c_t * p_ancs,
                                               const uint8_t * p_data_src,
                                               uint32_t * index)
 {
-    p_ancs->evt.attr.attr_id     = (ble_ancs_c_notif_attr_id_values_t) p_data_src[(*index)++];
-    p_ancs->evt.attr.p_attr_data = p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id].p_attr_data;
+    p_ancs->evt.attr.attr_id = (ble_ancs_c_notif_attr_id_values_t) p_data_src[(*index)++];
 
-    if (p_ancs->expected_number_of_attrs == 0)
-    {
-        ANCS_LOG("[ANCS]: All requested attributes received\n\r");
-       // (*index)++;
-        return DONE;
-    }
-    else if (p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id].get == true)
-    {
-        ANCS_LOG("[ANCS]: Attribute ID %i \n\r", p_ancs->evt.attr.attr_id);
-        return ATTR_LEN1;
-    }
-    else
+    if (p_ancs->evt.attr.attr_id >= BLE_ANCS_NB_OF_ATTRS)
     {
-        p_ancs->expected_number_of_attrs--;
-        return ATTR_ID;
+        ANCS_LOG("[ANCS]: Invalid Attribute ID %i \n\r", p_ancs->evt.attr.attr_id);
+        return response_end(p_ancs, false);
     }
+
+    ANCS_LOG("[ANCS]: Attribute ID %i \n\r", p_ancs->evt.attr.attr_id);
+    p_ancs->evt.attr.p_attr_data = p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id].p_attr_data;
+    return ATTR_LEN1;
 }
 
 
@@ -325,6 +489,46 @@ static ble_ancs_c_parse_state_t attr_len1_parse(ble_ancs_c_t * p_ancs, const uin
     return ATTR_LEN2;
 }
 
+
+/**@brief Function for ending the parsing of an iOS attribute.
+ *        Used in the @ref parse_get_notif_attrs_response state machine.
+ *
+ * @details Requested attributes are passed to the application. The response ends when all
+ *          requested attributes are received.
+ *
+ * @param[in] p_ancs     Pointer to an ANCS instance to which the event belongs.
+ *
+ * @return The next parse state.
+ */
+static ble_ancs_c_parse_state_t attr_end(ble_ancs_c_t * p_ancs)
+{
+    ble_ancs_c_attr_list_t * p_attr = &p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id];
+
+    if (!p_attr->get)
+    {
+        return ATTR_ID;
+    }
+
+    if (p_attr->p_attr_data != NULL)
+    {
+        p_attr->p_attr_data[MIN(p_ancs->current_attr_index, p_attr->attr_len)] = '\0';
+    }
+    ANCS_LOG("[ANCS]: Attribute finished!\n\r");
+    p_ancs->evt.evt_type = BLE_ANCS_C_EVT_NOTIF_ATTRIBUTE;
+    p_ancs->evt_handler(&p_ancs->evt);
+
+    if (p_ancs->expected_number_of_attrs > 0)
+    {
+        p_ancs->expected_number_of_attrs--;
+    }
+    if (p_ancs->expected_number_of_attrs == 0)
+    {
+        ANCS_LOG("[ANCS]: All requested attributes received\n\r");
+        return response_end(p_ancs, true);
+    }
+    return ATTR_ID;
+}
+
 /**@brief Function for parsing the length of an iOS attribute.
  *        Used in the @ref parse_get_notif_attrs_response state machine.
  *
@@ -349,52 +553,65 @@ static ble_ancs_c_parse_state_t attr_len2_parse(ble_ancs_c_t * p_ancs, const uin
     else
     {
         ANCS_LOG("[ANCS]: Attribute LEN %i \n\r", p_ancs->evt.attr.attr_len);
-        p_ancs->evt.evt_type = BLE_ANCS_C_EVT_NOTIF_ATTRIBUTE;
-        p_ancs->evt_handler(&p_ancs->evt);
-        return ATTR_ID;
+        return attr_end(p_ancs);
     }
 }
 
 /**@brief Function for parsing the data of an iOS attribute.
  *        Used in the @ref parse_get_notif_attrs_response state machine.
  *
- * @details Read the data of the attribute into our local buffer.
+ * @details All the attribute data in the GATTC notification is handled at once. It is passed to
+ *          the sink of the attribute, or copied into the attribute buffer up to its size. The
+ *          data of attributes that were not requested, and data beyond the size of the
+ *          buffer, is skipped.
  *
- * @param[in] p_ancs     Pointer to an ANCS instance to which the event belongs.
- * @param[in] p_data_src Pointer to data that was received from the Notification Provider.
- * @param[in] index      Pointer to an index that helps us keep track of the current data to be parsed.
+ * @param[in] p_ancs       Pointer to an ANCS instance to which the event belongs.
+ * @param[in] p_data_src   Pointer to data that was received from the Notification Provider.
+ * @param[in] index        Pointer to an index that helps us keep track of the current data to be parsed.
+ * @param[in] hvx_data_len Length of the data that was received from the Notification Provider.
  *
  * @return The next parse state.
  */
-static ble_ancs_c_parse_state_t attr_data_parse(ble_ancs_c_t * p_ancs, const uint8_t * p_data_src, uint32_t * index)
+static ble_ancs_c_parse_state_t attr_data_parse(ble_ancs_c_t  * p_ancs,
+                                                const uint8_t * p_data_src,
+                                                uint32_t      * index,
+                                                const uint16_t  hvx_data_len)
 {
-    // We have not reached the end of the attribute, nor our max allocated internal size.
-    // Proceed with copying data over to our buffer.
-    if (   (p_ancs->current_attr_index < p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id].attr_len)
-        && (p_ancs->current_attr_index < p_ancs->evt.attr.attr_len))
+    ble_ancs_c_attr_list_t * p_attr = &p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id];
+    uint16_t                 len    = MIN(p_ancs->evt.attr.attr_len - p_ancs->current_attr_index,
+                                          hvx_data_len - *index);
+
+    if (!p_attr->get)
     {
-        p_ancs->evt.attr.p_attr_data[p_ancs->current_attr_index++] = p_data_src[(*index)++];
+        // Skip the data.
     }
+    else if (p_attr->sink != NULL)
+    {
+        ble_ancs_c_attr_chunk_t chunk;
+
+        chunk.notif_uid = p_ancs->evt.attr.notif_uid;
+        chunk.attr_id   = p_ancs->evt.attr.attr_id;
+        chunk.attr_len  = p_ancs->evt.attr.attr_len;
+        chunk.offset    = p_ancs->current_attr_index;
+        chunk.len       = len;
+        chunk.p_data    = &p_data_src[*index];
+        p_attr->sink(&chunk);
+    }
+    else if (p_ancs->current_attr_index < p_attr->attr_len)
+    {
+        memcpy(&p_attr->p_attr_data[p_ancs->current_attr_index],
+               &p_data_src[*index],
+               MIN(len, p_attr->attr_len - p_ancs->current_attr_index));
+    }
+
+    *index                     += len;
+    p_ancs->current_attr_index += len;
 
-    // We have reached the end of the attribute, or our max allocated internal size.
-    // Stop copying data over to our buffer. NUL-terminate at the current index.
-    if ( (p_ancs->current_attr_index == p_ancs->evt.attr.attr_len) ||
-         (p_ancs->current_attr_index == p_ancs->ancs_attr_list[p_ancs->evt.attr.attr_id].attr_len))
+    if (p_ancs->current_attr_index < p_ancs->evt.attr.attr_len)
     {
-        p_ancs->evt.attr.p_attr_data[p_ancs->current_attr_index] = '\0';
-        
-        // If our max buffer size is smaller than the remaining attribute data, we must
-        // increase index to skip the data until the start of the next attribute.
-        if (p_ancs->current_attr_index < p_ancs->evt.attr.attr_len)
-        {
-            (*index) += (p_ancs->evt.attr.attr_len - p_ancs->current_attr_index);
-        }
-        ANCS_LOG("[ANCS]: Attribute finished!\n\r");
-        p_ancs->evt.evt_type = BLE_ANCS_C_EVT_NOTIF_ATTRIBUTE;
-        p_ancs->evt_handler(&p_ancs->evt);
-        return ATTR_ID;
+        return ATTR_DATA;
     }
-    return ATTR_DATA;
+    return attr_end(p_ancs);
 }
 
 /**@brief Function for parsing received notification attribute response data.
@@ -405,8 +622,9 @@ static ble_ancs_c_parse_state_t attr_data_parse(ble_ancs_c_t * p_ancs, const uin
  *          UID and command ID will be received only once at the beginning of the first
  *          GATTC notification of a new attribute request for a given iOS notification.
  *          After this, we can loop several ATTR_ID > LENGTH > DATA > ATTR_ID > LENGTH > DATA until
- *          we have received all attributes we wanted as a Notification Consumer.
- *          The Notification Provider can also simply stop sending attributes.
+ *          we have received all attributes we wanted as a Notification Consumer. The next
+ *          response, to the next queued request, starts right after the last attribute.
+ *          If a response cannot be parsed, the rest of the GATTC notification is dropped.
  *
  *    |1 Byte  |  4 Bytes    |1 Byte |2 Bytes | X Bytes            |1 Bytes| 2 Bytes| X Bytes   
  *    +--------+-------------+-------+--------+- - - - - - - - - - +-------+--------+- - - - - - -
@@ -423,6 +641,12 @@ static void parse_get_notif_attrs_response(ble_ancs_c_t  * p_ancs,
 {
     uint32_t index;
 
+    if (p_ancs->parse_state == DONE)
+    {
+        p_ancs->parse_state        = COMMAND_ID_AND_NOTIF_UID;
+        p_ancs->current_attr_index = 0;
+    }
+
     for (index = 0; index < hvx_data_len;)
     {
         switch (p_ancs->parse_state)
@@ -444,7 +668,7 @@ static void parse_get_notif_attrs_response(ble_ancs_c_t  * p_ancs,
                 break;
 
             case ATTR_DATA:
-                p_ancs->parse_state = attr_data_parse(p_ancs, p_data_src, &index);
+                p_ancs->parse_state = attr_data_parse(p_ancs, p_data_src, &index, hvx_data_len);
                 break;
 
             case DONE:
@@ -484,9 +708,9 @@ static uint32_t ble_ancs_verify_notification_format(const ble_ancs_c_evt_notif_t
  * @param[in] p_data_src Pointer to data that was received from the Notification Provider.
  * @param[in] hvx_len    Length of the data that was received by the Notification Provider.
  */
-static void parse_notif(const ble_ancs_c_t * p_ancs,
-                        const uint8_t      * p_data_src,
-                        const uint16_t       hvx_data_len)
+static void parse_notif(ble_ancs_c_t   * p_ancs,
+                        const uint8_t  * p_data_src,
+                        const uint16_t   hvx_data_len)
 {
     ble_ancs_c_evt_t ancs_evt;
     uint32_t         err_code;
@@ -494,6 +718,7 @@ static void parse_notif(const ble_ancs_c_t * p_ancs,
     {
         ancs_evt.evt_type = BLE_ANCS_C_EVT_INVALID_NOTIF;
         p_ancs->evt_handler(&ancs_evt);
+        return;
     }
 
     /*lint --e{415} --e{416} -save suppress Warning 415: possible access out of bond */
@@ -533,6 +758,30 @@ static void parse_notif(const ble_ancs_c_t * p_ancs,
     }
 
     p_ancs->evt_handler(&ancs_evt);
+
+    if (ancs_evt.evt_type != BLE_ANCS_C_EVT_NOTIF)
+    {
+        return;
+    }
+
+    if (ancs_evt.notif.evt_id == BLE_ANCS_EVENT_ID_NOTIFICATION_REMOVED)
+    {
+        // No need to request the attributes of a removed notification.
+        uint32_t index = request_find(p_ancs, ancs_evt.notif.notif_uid);
+
+        if ((index < p_ancs->request_count) && (p_ancs->requests[index].state == REQUEST_QUEUED))
+        {
+            request_remove(p_ancs, index);
+        }
+    }
+    else if (p_ancs->prefetch)
+    {
+        if (request_queue(p_ancs, ancs_evt.notif.notif_uid) != NRF_SUCCESS)
+        {
+            ANCS_LOG("[ANCS]: Request queue full, notification %i not prefetched\n\r",
+                     ancs_evt.notif.notif_uid);
+        }
+    }
 }
 
 
@@ -576,8 +825,33 @@ static void on_write_rsp(ble_ancs_c_t * p_ancs, const ble_evt_t * p_ble_evt)
     {
         return;
     }
+    // Requests written to the Control Point are answered in order. A request rejected by the
+    // Notification Provider, for example for a removed notification, gets no response.
+    if (m_tx_handle == p_ancs->service.control_point_char.handle_value)
+    {
+        uint32_t index = 0;
+
+        while ((index < p_ancs->request_count) && (p_ancs->requests[index].state != REQUEST_SENT))
+        {
+            index++;
+        }
+        if (index < p_ancs->request_count)
+        {
+            if (p_ble_evt->evt.gattc_evt.gatt_status == BLE_GATT_STATUS_SUCCESS)
+            {
+                p_ancs->requests[index].state = REQUEST_ACKED;
+            }
+            else
+            {
+                request_remove(p_ancs, index);
+            }
+        }
+    }
+    m_tx_handle = BLE_GATT_HANDLE_INVALID;
+
     // Check if there is any message to be sent across to the peer and send it.
     tx_buffer_process();
+    requests_send(p_ancs);
 }
 
 
@@ -615,6 +889,8 @@ uint32_t ble_ancs_c_init(ble_ancs_c_t * p_ancs, const ble_ancs_c_init_t * p_ancs
     p_ancs->parse_state = COMMAND_ID_AND_NOTIF_UID;
     p_ancs->p_data_dest = NULL;
     p_ancs->current_attr_index = 0;
+    p_ancs->request_count      = 0;
+    p_ancs->prefetch           = p_ancs_init->prefetch;
 
     p_ancs->evt_handler    = p_ancs_init->evt_handler;
     p_ancs->error_handler  = p_ancs_init->error_handler;
@@ -714,6 +990,12 @@ uint32_t ble_ancs_get_notif_attrs(ble_ancs_c_t       * p_ancs,
     tx_message_t * p_msg;
 
     uint32_t index                   = 0;
+
+    if (((m_tx_insert_index + 1) & TX_BUFFER_MASK) == m_tx_index)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
     p_ancs->number_of_requested_attr = 0;
     p_msg              = &m_tx_buffer[m_tx_insert_index++];
     m_tx_insert_index &= TX_BUFFER_MASK;
@@ -772,6 +1054,28 @@ uint32_t ble_ancs_c_attr_add(ble_ancs_c_t                          * p_ancs,
     p_ancs->ancs_attr_list[id].get         = true;
     p_ancs->ancs_attr_list[id].attr_len    = len;
     p_ancs->ancs_attr_list[id].p_attr_data = p_data;
+    p_ancs->ancs_attr_list[id].sink        = NULL;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_ancs_c_attr_sink_add(ble_ancs_c_t                          * p_ancs,
+                                  const ble_ancs_c_notif_attr_id_values_t id,
+                                  ble_ancs_c_attr_sink_t                  sink,
+                                  const uint16_t                          len)
+{
+    VERIFY_PARAM_NOT_NULL(sink);
+
+    if (len == 0)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_ancs->ancs_attr_list[id].get         = true;
+    p_ancs->ancs_attr_list[id].attr_len    = len;
+    p_ancs->ancs_attr_list[id].p_attr_data = NULL;
+    p_ancs->ancs_attr_list[id].sink        = sink;
 
     return NRF_SUCCESS;
 }
@@ -784,11 +1088,7 @@ uint32_t ble_ancs_c_request_attrs(ble_ancs_c_t * p_ancs,
     err_code = ble_ancs_verify_notification_format(p_notif);
     VERIFY_SUCCESS(err_code);
 
-    err_code            = ble_ancs_get_notif_attrs(p_ancs, p_notif->notif_uid);
-    p_ancs->parse_state = COMMAND_ID_AND_NOTIF_UID;
-    VERIFY_SUCCESS(err_code);
-
-    return NRF_SUCCESS;
+    return request_queue(p_ancs, p_notif->notif_uid);
 }
 
 uint32_t ble_ancs_c_handles_assign(ble_ancs_c_t * p_ancs,
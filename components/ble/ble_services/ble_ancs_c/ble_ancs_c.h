@@ -72,6 +72,16 @@
  * |||;
  * @endmsc
  *
+ * Attribute requests are queued by notification UID. Up to @ref BLE_ANCS_C_REQUESTS_MAX
+ * Get Notification Attributes commands are written to the Control Point before the first one is
+ * answered, so the Notification Provider sends the responses back to back. With
+ * ble_ancs_c_init_t::prefetch set, the attributes of each added or modified iOS notification are
+ * requested when it arrives, in arrival order, without a call to @ref ble_ancs_c_request_attrs.
+ *
+ * An attribute registered with @ref ble_ancs_c_attr_sink_add is not copied: its data is passed to
+ * the sink in chunks pointing into the received GATTC notifications, so it can be longer than
+ * @ref BLE_ANCS_ATTR_DATA_MAX.
+ *
  * @note The application must propagate BLE stack events to this module
  *       by calling ble_ancs_c_on_ble_evt() from the @ref softdevice_handler callback.
  */
@@ -90,6 +100,14 @@
 #define BLE_ANCS_NB_OF_ATTRS                8   /**< Number of iOS notification attributes: AppIdentifier, Title, Subtitle, Message, MessageSize, Date, PositiveActionLabel, NegativeActionLabel. */
 #define BLE_ANCS_NB_OF_EVT_ID               3   /**< Number of iOS notification events: Added, Modified, Removed.*/
 
+#ifndef BLE_ANCS_C_REQUESTS_MAX
+#define BLE_ANCS_C_REQUESTS_MAX             4   /**< Maximum number of Get Notification Attributes commands sent to the Notification Provider and not answered yet. */
+#endif
+
+#ifndef BLE_ANCS_C_REQUEST_QUEUE_SIZE
+#define BLE_ANCS_C_REQUEST_QUEUE_SIZE       8   /**< Maximum number of iOS notifications whose attributes are requested or waiting to be requested. */
+#endif
+
 /** @brief Length of the iOS notification data.
  *
  * @details 8 bytes:
@@ -213,6 +231,22 @@ typedef struct
 } ble_ancs_c_evt_notif_attr_t;
 
 
+/**@brief Chunk of iOS notification attribute data, passed to an attribute sink. */
+typedef struct
+{
+    uint32_t                          notif_uid;    /**< UID of the notification that the attribute belongs to. */
+    ble_ancs_c_notif_attr_id_values_t attr_id;      /**< Classification of the attribute type, for example, title or date. */
+    uint16_t                          attr_len;     /**< Total length of the attribute data. */
+    uint16_t                          offset;       /**< Offset of this chunk in the attribute data. The attribute is complete when offset + len is attr_len. */
+    uint16_t                          len;          /**< Length of this chunk. */
+    uint8_t const                   * p_data;       /**< Chunk data. Points into the received GATTC notification and is only valid during the call. */
+} ble_ancs_c_attr_chunk_t;
+
+
+/**@brief Attribute sink type. Called for each chunk of attribute data, in order. */
+typedef void (*ble_ancs_c_attr_sink_t) (ble_ancs_c_attr_chunk_t const * p_chunk);
+
+
 /**@brief iOS notification attribute content wanted by our application. */
 typedef struct
 {
@@ -220,9 +254,18 @@ typedef struct
     ble_ancs_c_notif_attr_id_values_t attr_id;      /**< Attribute ID: AppIdentifier(0), Title(1), Subtitle(2), Message(3), MessageSize(4), Date(5), PositiveActionLabel(6), NegativeActionLabel(7). */
     uint16_t                          attr_len;     /**< Length of the attribute. If more data is received from the Notification Provider, all data beyond this length is discarded. */
     uint8_t                         * p_attr_data;  /**< Pointer to where the memory is allocated for storing incoming attributes. */
+    ble_ancs_c_attr_sink_t            sink;         /**< Sink receiving the attribute data, or NULL if it is stored in p_attr_data. */
 } ble_ancs_c_attr_list_t;
 
 
+/**@brief Queued attribute request. */
+typedef struct
+{
+    uint32_t                          notif_uid;    /**< UID of the notification whose attributes are requested. */
+    uint8_t                           state;        /**< Whether the command is waiting, written, or acknowledged by the Notification Provider. */
+} ble_ancs_c_request_t;
+
+
 /**@brief Structure used for holding the Apple Notification Center Service found during the
           discovery process.
  */
@@ -270,6 +313,9 @@ typedef struct
     uint8_t                * p_data_dest;                             /**< Attribute that the parsed data will be copied into. */
     uint16_t                 current_attr_index;                      /**< Variable to keep track of how much (for a given attribute) we are done parsing. */
     ble_ancs_c_evt_t         evt;                                     /**< The event is filled with several iteration of the parse_get_notif_attrs_response function when requesting iOS notification attributes. So we must allocate memory for it here.*/
+    ble_ancs_c_request_t     requests[BLE_ANCS_C_REQUEST_QUEUE_SIZE]; /**< Attribute requests, in the order they were queued. */
+    uint8_t                  request_count;                           /**< Number of queued attribute requests. */
+    bool                     prefetch;                                /**< Request the attributes of added and modified iOS notifications when they arrive. */
 } ble_ancs_c_t;
 
 
@@ -279,6 +325,7 @@ typedef struct
 {
     ble_ancs_c_evt_handler_t evt_handler;    /**< Event handler to be called for handling events in the Battery Service. */
     ble_srv_error_handler_t  error_handler;  /**< Function to be called in case of an error. */
+    bool                     prefetch;       /**< Request the attributes of added and modified iOS notifications when they arrive. */
 } ble_ancs_c_init_t;
 
 
@@ -381,14 +428,43 @@ uint32_t ble_ancs_c_attr_add(ble_ancs_c_t                          * p_ancs,
                              const uint16_t                          len);
 
 
+/**@brief Function for registering an attribute whose data is passed to a sink instead of being
+ *        stored.
+ *
+ * @details The sink is called from @ref ble_ancs_c_on_ble_evt with every chunk of the attribute
+ *          data as it is received. @ref BLE_ANCS_C_EVT_NOTIF_ATTRIBUTE is still sent when the
+ *          attribute is complete, with a NULL data pointer.
+ *
+ * @param[in] p_ancs ANCS client instance on which the attribute will be registered.
+ * @param[in] id     ID of the attribute that will be added.
+ * @param[in] sink   Sink receiving the attribute data.
+ * @param[in] len    Maximum length of the attribute requested from the Notification Provider.
+ *                   Only used for the Title, Subtitle, and Message attributes.
+ *
+ * @retval NRF_SUCCESS              If the attribute was registered.
+ * @retval NRF_ERROR_NULL           If sink is NULL.
+ * @retval NRF_ERROR_INVALID_LENGTH If len is 0.
+ */
+uint32_t ble_ancs_c_attr_sink_add(ble_ancs_c_t                          * p_ancs,
+                                  const ble_ancs_c_notif_attr_id_values_t id,
+                                  ble_ancs_c_attr_sink_t                  sink,
+                                  const uint16_t                          len);
+
+
 /**@brief Function for requesting attributes for a notification.
+ *
+ * @details The request is queued. The command is written to the Control Point when fewer than
+ *          @ref BLE_ANCS_C_REQUESTS_MAX commands are waiting for their response. Requesting the
+ *          attributes of a notification that is already queued has no effect.
  *
  * @param[in] p_ancs   iOS notification structure. This structure must be supplied by
  *                     the application. It identifies the particular client instance to use.
  * @param[in] p_notif  Pointer to the notification whose attributes will be requested from
  *                     the Notification Provider.
  *
- * @retval NRF_SUCCESS If all operations were successful. Otherwise, an error code is returned.
+ * @retval NRF_SUCCESS             If the request was queued.
+ * @retval NRF_ERROR_INVALID_PARAM If the notification is invalid.
+ * @retval NRF_ERROR_NO_MEM        If @ref BLE_ANCS_C_REQUEST_QUEUE_SIZE requests are queued.
  */
 uint32_t ble_ancs_c_request_attrs(ble_ancs_c_t                 * p_ancs,
                                   const ble_ancs_c_evt_notif_t * p_notif);
@@ -0,0 +1,694 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdlib.h> // definition of NULL
+#include <string.h>
+
+#include "ble.h"
+#include "ble_dfu_c.h"
+#include "ble_gattc.h"
+#include "ble_srv_common.h"
+#include "app_util.h"
+#include "sdk_common.h"
+
+#define START_PACKET_LEN        (3 * sizeof(uint32_t))  /**< Length of the image sizes written after Start DFU. */
+
+/**@brief DFU Control Point op codes, see @ref ble_sdk_srv_dfu. */
+enum
+{
+    OP_CODE_START_DFU          = 1,
+    OP_CODE_RECEIVE_INIT       = 2,
+    OP_CODE_RECEIVE_FW         = 3,
+    OP_CODE_VALIDATE           = 4,
+    OP_CODE_ACTIVATE_N_RESET   = 5,
+    OP_CODE_PKT_RCPT_NOTIF_REQ = 8,
+    OP_CODE_RESPONSE           = 16,
+    OP_CODE_PKT_RCPT_NOTIF     = 17
+};
+
+#define INIT_RX                 0x00                    /**< Receive Init parameter: init packet follows. */
+#define INIT_COMPLETE           0x01                    /**< Receive Init parameter: init packet complete. */
+
+
+/**@brief Function for checking whether an update is in progress. */
+static bool update_in_progress(ble_dfu_c_t const * p_ble_dfu_c)
+{
+    return (p_ble_dfu_c->state != BLE_DFU_C_STATE_IDLE)
+        && (p_ble_dfu_c->state != BLE_DFU_C_STATE_COMPLETE)
+        && (p_ble_dfu_c->state != BLE_DFU_C_STATE_ERROR);
+}
+
+
+static void evt_send(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_evt_t * p_evt)
+{
+    p_evt->conn_handle = p_ble_dfu_c->conn_handle;
+
+    if (p_ble_dfu_c->evt_handler != NULL)
+    {
+        p_ble_dfu_c->evt_handler(p_ble_dfu_c, p_evt);
+    }
+}
+
+
+/**@brief Function for aborting the update and reporting the error to the application.
+ *
+ * @param[in] p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[in] error       DFU response value of the peer, or error code of the SoftDevice.
+ */
+static void error_report(ble_dfu_c_t * p_ble_dfu_c, uint32_t error)
+{
+    ble_dfu_c_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.evt_type = BLE_DFU_C_EVT_ERROR;
+    evt.state    = p_ble_dfu_c->state;
+    evt.error    = error;
+
+    p_ble_dfu_c->state = BLE_DFU_C_STATE_ERROR;
+    evt_send(p_ble_dfu_c, &evt);
+}
+
+
+static void progress_report(ble_dfu_c_t * p_ble_dfu_c)
+{
+    ble_dfu_c_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.evt_type = BLE_DFU_C_EVT_PROGRESS;
+
+    evt_send(p_ble_dfu_c, &evt);
+}
+
+
+/**@brief Function for writing to a characteristic with a write request.
+ */
+static uint32_t write_req(ble_dfu_c_t * p_ble_dfu_c, uint16_t handle, uint8_t * p_data, uint16_t len)
+{
+    const ble_gattc_write_params_t write_params = {
+        .write_op = BLE_GATT_OP_WRITE_REQ,
+        .flags    = BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE,
+        .handle   = handle,
+        .offset   = 0,
+        .len      = len,
+        .p_value  = p_data
+    };
+
+    return sd_ble_gattc_write(p_ble_dfu_c->conn_handle, &write_params);
+}
+
+
+/**@brief Function for writing a command to the Control Point and moving to the state waiting for
+ *        its result.
+ */
+static void ctrl_pt_write(ble_dfu_c_t *     p_ble_dfu_c,
+                          ble_dfu_c_state_t next_state,
+                          uint8_t *         p_data,
+                          uint16_t          len)
+{
+    uint32_t err_code;
+
+    p_ble_dfu_c->state = next_state;
+
+    err_code = write_req(p_ble_dfu_c, p_ble_dfu_c->handles.ctrl_pt_handle, p_data, len);
+    if (err_code != NRF_SUCCESS)
+    {
+        error_report(p_ble_dfu_c, err_code);
+    }
+}
+
+
+static void ctrl_pt_opcode_write(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_state_t next_state, uint8_t opcode)
+{
+    ctrl_pt_write(p_ble_dfu_c, next_state, &opcode, sizeof(opcode));
+}
+
+
+/**@brief Function for filling the next write command of the init packet or of the firmware.
+ *
+ * @retval true  If a write command was filled.
+ * @retval false If there is nothing to be sent now, or the update failed.
+ */
+static bool packet_fill(ble_dfu_c_t * p_ble_dfu_c)
+{
+    ble_dfu_c_image_t const * p_image = p_ble_dfu_c->p_image;
+    uint32_t                  length;
+    uint32_t                  err_code;
+
+    switch (p_ble_dfu_c->state)
+    {
+        case BLE_DFU_C_STATE_INIT_DATA:
+            if (p_ble_dfu_c->offset >= p_image->init_data_len)
+            {
+                return false;
+            }
+            length = MIN(BLE_DFU_C_MAX_DATA_LEN, p_image->init_data_len - p_ble_dfu_c->offset);
+            memcpy(p_ble_dfu_c->packet, &p_image->p_init_data[p_ble_dfu_c->offset], length);
+            break;
+
+        case BLE_DFU_C_STATE_STREAM:
+            if (p_ble_dfu_c->offset >= p_ble_dfu_c->stats.bytes_total)
+            {
+                return false;
+            }
+            // Wait for the peer to catch up.
+            if ( (p_ble_dfu_c->prn != 0)
+               &&(p_ble_dfu_c->offset - p_ble_dfu_c->stats.bytes_acked >=
+                  (uint32_t)p_ble_dfu_c->prn * p_ble_dfu_c->prn_window * BLE_DFU_C_MAX_DATA_LEN)
+               )
+            {
+                if (!p_ble_dfu_c->window_full)
+                {
+                    p_ble_dfu_c->window_full = true;
+                    p_ble_dfu_c->stats.window_count++;
+                }
+                return false;
+            }
+            length   = MIN(BLE_DFU_C_MAX_DATA_LEN, p_ble_dfu_c->stats.bytes_total - p_ble_dfu_c->offset);
+            err_code = p_image->read(p_ble_dfu_c->offset, p_ble_dfu_c->packet, (uint16_t)length);
+            if (err_code != NRF_SUCCESS)
+            {
+                error_report(p_ble_dfu_c, err_code);
+                return false;
+            }
+            break;
+
+        default:
+            return false;
+    }
+
+    p_ble_dfu_c->packet_len = (uint8_t)length;
+    return true;
+}
+
+
+/**@brief Function for queuing write commands to the DFU Packet characteristic in the SoftDevice
+ *        until it runs out of TX buffers or there is nothing more to be sent.
+ *
+ * @details When the init packet or the firmware has been queued completely, the update moves on to
+ *          the next state.
+ */
+static void packets_queue(ble_dfu_c_t * p_ble_dfu_c)
+{
+    ble_gattc_write_params_t write_params;
+    uint32_t                 err_code;
+
+    for (;;)
+    {
+        if ((p_ble_dfu_c->packet_len == 0) && !packet_fill(p_ble_dfu_c))
+        {
+            break;
+        }
+
+        memset(&write_params, 0, sizeof(write_params));
+
+        write_params.write_op = BLE_GATT_OP_WRITE_CMD;
+        write_params.flags    = BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE;
+        write_params.handle   = p_ble_dfu_c->handles.packet_handle;
+        write_params.offset   = 0;
+        write_params.len      = p_ble_dfu_c->packet_len;
+        write_params.p_value  = p_ble_dfu_c->packet;
+
+        err_code = sd_ble_gattc_write(p_ble_dfu_c->conn_handle, &write_params);
+        if (err_code == BLE_ERROR_NO_TX_PACKETS)
+        {
+            // The packet is kept and sent again on the next TX complete event.
+            p_ble_dfu_c->stats.stall_count++;
+            return;
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            error_report(p_ble_dfu_c, err_code);
+            return;
+        }
+
+        if (p_ble_dfu_c->state == BLE_DFU_C_STATE_STREAM)
+        {
+            p_ble_dfu_c->stats.bytes_sent += p_ble_dfu_c->packet_len;
+        }
+        p_ble_dfu_c->offset    += p_ble_dfu_c->packet_len;
+        p_ble_dfu_c->packet_len = 0;
+    }
+
+    if ( (p_ble_dfu_c->state == BLE_DFU_C_STATE_INIT_DATA)
+       &&(p_ble_dfu_c->offset >= p_ble_dfu_c->p_image->init_data_len)
+       )
+    {
+        // ATT PDUs are sent in order, so the write request follows the init packet.
+        uint8_t cmd[] = {OP_CODE_RECEIVE_INIT, INIT_COMPLETE};
+
+        ctrl_pt_write(p_ble_dfu_c, BLE_DFU_C_STATE_INIT_RSP, cmd, sizeof(cmd));
+    }
+    else if ( (p_ble_dfu_c->state == BLE_DFU_C_STATE_STREAM)
+            &&(p_ble_dfu_c->offset >= p_ble_dfu_c->stats.bytes_total)
+            )
+    {
+        p_ble_dfu_c->state = BLE_DFU_C_STATE_STREAM_RSP;
+    }
+}
+
+
+/**@brief Function for handling the Write Response event, which acknowledges a write request to the
+ *        CCCD or the Control Point.
+ */
+static void on_write_rsp(ble_dfu_c_t * p_ble_dfu_c, ble_evt_t const * p_ble_evt)
+{
+    ble_gattc_evt_t const * p_gattc_evt = &p_ble_evt->evt.gattc_evt;
+    uint16_t                handle      = p_gattc_evt->params.write_rsp.handle;
+
+    if ( (handle != p_ble_dfu_c->handles.ctrl_pt_handle)
+       &&(handle != p_ble_dfu_c->handles.ctrl_pt_cccd_handle)
+       )
+    {
+        return;
+    }
+    if (!update_in_progress(p_ble_dfu_c))
+    {
+        return;
+    }
+    if (p_gattc_evt->gatt_status != BLE_GATT_STATUS_SUCCESS)
+    {
+        error_report(p_ble_dfu_c, p_gattc_evt->gatt_status);
+        return;
+    }
+
+    switch (p_ble_dfu_c->state)
+    {
+        case BLE_DFU_C_STATE_CCCD:
+        {
+            uint8_t cmd[] = {OP_CODE_START_DFU, p_ble_dfu_c->p_image->update_mode};
+
+            ctrl_pt_write(p_ble_dfu_c, BLE_DFU_C_STATE_START, cmd, sizeof(cmd));
+            break;
+        }
+
+        case BLE_DFU_C_STATE_START:
+        {
+            ble_dfu_c_image_t const * p_image = p_ble_dfu_c->p_image;
+
+            // The image sizes are sent as a write command, the peer responds once it has
+            // prepared its flash.
+            p_ble_dfu_c->state = BLE_DFU_C_STATE_START_RSP;
+
+            (void)uint32_encode(p_image->sd_size,  &p_ble_dfu_c->packet[0]);
+            (void)uint32_encode(p_image->bl_size,  &p_ble_dfu_c->packet[4]);
+            (void)uint32_encode(p_image->app_size, &p_ble_dfu_c->packet[8]);
+            p_ble_dfu_c->packet_len = START_PACKET_LEN;
+
+            packets_queue(p_ble_dfu_c);
+            break;
+        }
+
+        case BLE_DFU_C_STATE_INIT:
+            p_ble_dfu_c->state  = BLE_DFU_C_STATE_INIT_DATA;
+            p_ble_dfu_c->offset = 0;
+            packets_queue(p_ble_dfu_c);
+            break;
+
+        case BLE_DFU_C_STATE_PRN:
+            ctrl_pt_opcode_write(p_ble_dfu_c, BLE_DFU_C_STATE_RECEIVE_FW, OP_CODE_RECEIVE_FW);
+            break;
+
+        case BLE_DFU_C_STATE_RECEIVE_FW:
+            p_ble_dfu_c->state       = BLE_DFU_C_STATE_STREAM;
+            p_ble_dfu_c->offset      = 0;
+            p_ble_dfu_c->window_full = false;
+            packets_queue(p_ble_dfu_c);
+            break;
+
+        case BLE_DFU_C_STATE_ACTIVATE:
+        {
+            ble_dfu_c_evt_t evt;
+
+            memset(&evt, 0, sizeof(evt));
+            evt.evt_type       = BLE_DFU_C_EVT_COMPLETE;
+            p_ble_dfu_c->state = BLE_DFU_C_STATE_COMPLETE;
+            evt_send(p_ble_dfu_c, &evt);
+            break;
+        }
+
+        default:
+            // The write response of a command answered with a notification.
+            break;
+    }
+}
+
+
+/**@brief Function for handling a response notification of the Control Point.
+ *
+ * @param[in] p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[in] procedure   Procedure the response is for, see @ref ble_dfu_procedure_t.
+ * @param[in] result      Response value, see @ref ble_dfu_resp_val_t.
+ */
+static void on_response(ble_dfu_c_t * p_ble_dfu_c, uint8_t procedure, uint8_t result)
+{
+    if (result != BLE_DFU_RESP_VAL_SUCCESS)
+    {
+        error_report(p_ble_dfu_c, result);
+        return;
+    }
+
+    switch (p_ble_dfu_c->state)
+    {
+        case BLE_DFU_C_STATE_START_RSP:
+            if (procedure == BLE_DFU_START_PROCEDURE)
+            {
+                uint8_t cmd[] = {OP_CODE_RECEIVE_INIT, INIT_RX};
+
+                ctrl_pt_write(p_ble_dfu_c, BLE_DFU_C_STATE_INIT, cmd, sizeof(cmd));
+            }
+            break;
+
+        case BLE_DFU_C_STATE_INIT_RSP:
+            if (procedure != BLE_DFU_INIT_PROCEDURE)
+            {
+                break;
+            }
+            if (p_ble_dfu_c->prn != 0)
+            {
+                uint8_t cmd[3] = {OP_CODE_PKT_RCPT_NOTIF_REQ};
+
+                (void)uint16_encode(p_ble_dfu_c->prn, &cmd[1]);
+                ctrl_pt_write(p_ble_dfu_c, BLE_DFU_C_STATE_PRN, cmd, sizeof(cmd));
+            }
+            else
+            {
+                ctrl_pt_opcode_write(p_ble_dfu_c, BLE_DFU_C_STATE_RECEIVE_FW, OP_CODE_RECEIVE_FW);
+            }
+            break;
+
+        case BLE_DFU_C_STATE_STREAM_RSP:
+            if (procedure == BLE_DFU_RECEIVE_APP_PROCEDURE)
+            {
+                p_ble_dfu_c->stats.bytes_acked = p_ble_dfu_c->stats.bytes_total;
+                progress_report(p_ble_dfu_c);
+
+                ctrl_pt_opcode_write(p_ble_dfu_c, BLE_DFU_C_STATE_VALIDATE, OP_CODE_VALIDATE);
+            }
+            break;
+
+        case BLE_DFU_C_STATE_VALIDATE:
+            if (procedure == BLE_DFU_VALIDATE_PROCEDURE)
+            {
+                // The peer may reset before the write response.
+                ctrl_pt_opcode_write(p_ble_dfu_c, BLE_DFU_C_STATE_ACTIVATE, OP_CODE_ACTIVATE_N_RESET);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief Function for handling a Packet Receipt Notification.
+ *
+ * @param[in] p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[in] bytes       Firmware bytes received by the peer.
+ */
+static void on_pkt_rcpt_notif(ble_dfu_c_t * p_ble_dfu_c, uint32_t bytes)
+{
+    if ( (p_ble_dfu_c->state != BLE_DFU_C_STATE_STREAM)
+       &&(p_ble_dfu_c->state != BLE_DFU_C_STATE_STREAM_RSP)
+       )
+    {
+        return;
+    }
+    if ((bytes > p_ble_dfu_c->stats.bytes_sent) || (bytes < p_ble_dfu_c->stats.bytes_acked))
+    {
+        // The peer missed data, or reports data that was never sent.
+        error_report(p_ble_dfu_c, NRF_ERROR_INVALID_DATA);
+        return;
+    }
+
+    p_ble_dfu_c->stats.bytes_acked = bytes;
+    p_ble_dfu_c->window_full       = false;
+    progress_report(p_ble_dfu_c);
+
+    packets_queue(p_ble_dfu_c);
+}
+
+
+/**@brief Function for handling Handle Value Notifications of the Control Point.
+ */
+static void on_hvx(ble_dfu_c_t * p_ble_dfu_c, ble_evt_t const * p_ble_evt)
+{
+    ble_gattc_evt_hvx_t const * p_hvx = &p_ble_evt->evt.gattc_evt.params.hvx;
+
+    if ( (p_ble_dfu_c->handles.ctrl_pt_handle == BLE_GATT_HANDLE_INVALID)
+       ||(p_hvx->handle != p_ble_dfu_c->handles.ctrl_pt_handle)
+       ||!update_in_progress(p_ble_dfu_c)
+       )
+    {
+        return;
+    }
+
+    if ((p_hvx->len >= 3) && (p_hvx->data[0] == OP_CODE_RESPONSE))
+    {
+        on_response(p_ble_dfu_c, p_hvx->data[1], p_hvx->data[2]);
+    }
+    else if ((p_hvx->len >= 1 + sizeof(uint32_t)) && (p_hvx->data[0] == OP_CODE_PKT_RCPT_NOTIF))
+    {
+        on_pkt_rcpt_notif(p_ble_dfu_c, uint32_decode(&p_hvx->data[1]));
+    }
+}
+
+
+/**@brief Function for handling the TX complete event from the SoftDevice.
+ */
+static void on_tx_complete(ble_dfu_c_t * p_ble_dfu_c)
+{
+    if ( (p_ble_dfu_c->state == BLE_DFU_C_STATE_START_RSP)
+       ||(p_ble_dfu_c->state == BLE_DFU_C_STATE_INIT_DATA)
+       ||(p_ble_dfu_c->state == BLE_DFU_C_STATE_STREAM)
+       )
+    {
+        packets_queue(p_ble_dfu_c);
+    }
+}
+
+
+static void on_disconnected(ble_dfu_c_t * p_ble_dfu_c)
+{
+    ble_dfu_c_evt_t evt;
+
+    if (p_ble_dfu_c->state == BLE_DFU_C_STATE_ACTIVATE)
+    {
+        // The peer has reset into the new image.
+        memset(&evt, 0, sizeof(evt));
+        evt.evt_type       = BLE_DFU_C_EVT_COMPLETE;
+        p_ble_dfu_c->state = BLE_DFU_C_STATE_COMPLETE;
+        evt_send(p_ble_dfu_c, &evt);
+    }
+    else if (update_in_progress(p_ble_dfu_c))
+    {
+        error_report(p_ble_dfu_c, BLE_ERROR_INVALID_CONN_HANDLE);
+    }
+
+    memset(&evt, 0, sizeof(evt));
+    evt.evt_type = BLE_DFU_C_EVT_DISCONNECTED;
+    evt_send(p_ble_dfu_c, &evt);
+
+    p_ble_dfu_c->conn_handle                 = BLE_CONN_HANDLE_INVALID;
+    p_ble_dfu_c->handles.ctrl_pt_handle      = BLE_GATT_HANDLE_INVALID;
+    p_ble_dfu_c->handles.ctrl_pt_cccd_handle = BLE_GATT_HANDLE_INVALID;
+    p_ble_dfu_c->handles.packet_handle       = BLE_GATT_HANDLE_INVALID;
+    p_ble_dfu_c->packet_len                  = 0;
+}
+
+
+uint32_t ble_dfu_c_init(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_init_t const * p_ble_dfu_c_init)
+{
+    uint32_t      err_code;
+    ble_uuid_t    dfu_uuid;
+    ble_uuid128_t dfu_base_uuid = DFU_BASE_UUID;
+
+    VERIFY_PARAM_NOT_NULL(p_ble_dfu_c);
+    VERIFY_PARAM_NOT_NULL(p_ble_dfu_c_init);
+
+    if ((p_ble_dfu_c_init->prn != 0) && (p_ble_dfu_c_init->prn_window == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_ble_dfu_c, 0, sizeof(ble_dfu_c_t));
+
+    err_code = sd_ble_uuid_vs_add(&dfu_base_uuid, &p_ble_dfu_c->uuid_type);
+    VERIFY_SUCCESS(err_code);
+
+    dfu_uuid.type = p_ble_dfu_c->uuid_type;
+    dfu_uuid.uuid = BLE_DFU_SERVICE_UUID;
+
+    p_ble_dfu_c->conn_handle                 = BLE_CONN_HANDLE_INVALID;
+    p_ble_dfu_c->handles.ctrl_pt_handle      = BLE_GATT_HANDLE_INVALID;
+    p_ble_dfu_c->handles.ctrl_pt_cccd_handle = BLE_GATT_HANDLE_INVALID;
+    p_ble_dfu_c->handles.packet_handle       = BLE_GATT_HANDLE_INVALID;
+    p_ble_dfu_c->evt_handler                 = p_ble_dfu_c_init->evt_handler;
+    p_ble_dfu_c->prn                         = p_ble_dfu_c_init->prn;
+    p_ble_dfu_c->prn_window                  = p_ble_dfu_c_init->prn_window;
+    p_ble_dfu_c->state                       = BLE_DFU_C_STATE_IDLE;
+
+    return ble_db_discovery_evt_register(&dfu_uuid);
+}
+
+
+void ble_dfu_c_on_db_disc_evt(ble_dfu_c_t * p_ble_dfu_c, ble_db_discovery_evt_t const * p_evt)
+{
+    ble_dfu_c_evt_t            dfu_c_evt;
+    ble_gatt_db_char_t const * p_chars = p_evt->params.discovered_db.charateristics;
+
+    if ( (p_evt->evt_type != BLE_DB_DISCOVERY_COMPLETE)
+       ||(p_evt->params.discovered_db.srv_uuid.uuid != BLE_DFU_SERVICE_UUID)
+       ||(p_evt->params.discovered_db.srv_uuid.type != p_ble_dfu_c->uuid_type)
+       )
+    {
+        return;
+    }
+
+    memset(&dfu_c_evt, 0, sizeof(dfu_c_evt));
+    dfu_c_evt.handles.ctrl_pt_handle      = BLE_GATT_HANDLE_INVALID;
+    dfu_c_evt.handles.ctrl_pt_cccd_handle = BLE_GATT_HANDLE_INVALID;
+    dfu_c_evt.handles.packet_handle       = BLE_GATT_HANDLE_INVALID;
+
+    for (uint32_t i = 0; i < p_evt->params.discovered_db.char_count; i++)
+    {
+        switch (p_chars[i].characteristic.uuid.uuid)
+        {
+            case BLE_DFU_CTRL_PT_UUID:
+                dfu_c_evt.handles.ctrl_pt_handle      = p_chars[i].characteristic.handle_value;
+                dfu_c_evt.handles.ctrl_pt_cccd_handle = p_chars[i].cccd_handle;
+                break;
+
+            case BLE_DFU_PKT_CHAR_UUID:
+                dfu_c_evt.handles.packet_handle = p_chars[i].characteristic.handle_value;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (p_ble_dfu_c->evt_handler != NULL)
+    {
+        dfu_c_evt.evt_type    = BLE_DFU_C_EVT_DISCOVERY_COMPLETE;
+        dfu_c_evt.conn_handle = p_evt->conn_handle;
+        p_ble_dfu_c->evt_handler(p_ble_dfu_c, &dfu_c_evt);
+    }
+}
+
+
+void ble_dfu_c_on_ble_evt(ble_dfu_c_t * p_ble_dfu_c, ble_evt_t const * p_ble_evt)
+{
+    if ((p_ble_dfu_c == NULL) || (p_ble_evt == NULL))
+    {
+        return;
+    }
+    if (p_ble_dfu_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return;
+    }
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GATTC_EVT_WRITE_RSP:
+            if (p_ble_evt->evt.gattc_evt.conn_handle == p_ble_dfu_c->conn_handle)
+            {
+                on_write_rsp(p_ble_dfu_c, p_ble_evt);
+            }
+            break;
+
+        case BLE_GATTC_EVT_HVX:
+            if (p_ble_evt->evt.gattc_evt.conn_handle == p_ble_dfu_c->conn_handle)
+            {
+                on_hvx(p_ble_dfu_c, p_ble_evt);
+            }
+            break;
+
+        case BLE_EVT_TX_COMPLETE:
+            if (p_ble_evt->evt.common_evt.conn_handle == p_ble_dfu_c->conn_handle)
+            {
+                on_tx_complete(p_ble_dfu_c);
+            }
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if (p_ble_evt->evt.gap_evt.conn_handle == p_ble_dfu_c->conn_handle)
+            {
+                on_disconnected(p_ble_dfu_c);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+uint32_t ble_dfu_c_handles_assign(ble_dfu_c_t *               p_ble_dfu_c,
+                                  uint16_t                    conn_handle,
+                                  ble_dfu_c_handles_t const * p_peer_handles)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_dfu_c);
+
+    p_ble_dfu_c->conn_handle = conn_handle;
+    if (p_peer_handles != NULL)
+    {
+        p_ble_dfu_c->handles = *p_peer_handles;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_dfu_c_start(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_image_t const * p_image)
+{
+    uint8_t  cccd[BLE_CCCD_VALUE_LEN] = {BLE_GATT_HVX_NOTIFICATION, 0};
+    uint32_t bytes_total;
+    uint32_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_ble_dfu_c);
+    VERIFY_PARAM_NOT_NULL(p_image);
+    VERIFY_PARAM_NOT_NULL(p_image->read);
+
+    if ( (p_ble_dfu_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+       ||(p_ble_dfu_c->handles.ctrl_pt_handle == BLE_GATT_HANDLE_INVALID)
+       ||(p_ble_dfu_c->handles.ctrl_pt_cccd_handle == BLE_GATT_HANDLE_INVALID)
+       ||(p_ble_dfu_c->handles.packet_handle == BLE_GATT_HANDLE_INVALID)
+       ||update_in_progress(p_ble_dfu_c)
+       )
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    bytes_total = p_image->sd_size + p_image->bl_size + p_image->app_size;
+    if (bytes_total == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    err_code = write_req(p_ble_dfu_c, p_ble_dfu_c->handles.ctrl_pt_cccd_handle, cccd, sizeof(cccd));
+    VERIFY_SUCCESS(err_code);
+
+    memset(&p_ble_dfu_c->stats, 0, sizeof(p_ble_dfu_c->stats));
+    p_ble_dfu_c->stats.bytes_total = bytes_total;
+    p_ble_dfu_c->p_image           = p_image;
+    p_ble_dfu_c->offset            = 0;
+    p_ble_dfu_c->packet_len        = 0;
+    p_ble_dfu_c->state             = BLE_DFU_C_STATE_CCCD;
+
+    return NRF_SUCCESS;
+}
+
+
+void ble_dfu_c_stats_get(ble_dfu_c_t const * p_ble_dfu_c, ble_dfu_c_stats_t * p_stats)
+{
+    *p_stats = p_ble_dfu_c->stats;
+}
@@ -0,0 +1,237 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/**@file
+ *
+ * @defgroup ble_sdk_srv_dfu_c   DFU Service Client
+ * @{
+ * @ingroup  ble_sdk_srv
+ * @brief    DFU Controller for the Device Firmware Update Service.
+ *
+ * @details  This module runs the DFU Controller side of the @ref ble_sdk_srv_dfu procedure
+ *           against the bootloader of a peer, so that a central can update its peripherals. Each
+ *           instance drives one link, so several peers can be updated at the same time with one
+ *           instance per link. All instances can share the same @ref ble_dfu_c_image_t.
+ *
+ *           The procedure is: enable notifications of the Control Point, Start DFU with the image
+ *           sizes, send the init packet, request Packet Receipt Notifications, stream the firmware
+ *           and then Validate and Activate & Reset. The firmware is streamed in write commands, as
+ *           many as the SoftDevice accepts at once, refilled on @ref BLE_EVT_TX_COMPLETE. Sending
+ *           is paused when more than @ref ble_dfu_c_init_t::prn_window Packet Receipt
+ *           Notification intervals are not yet acknowledged, so the peer is never more than a
+ *           bounded number of packets behind.
+ *
+ * @note     The application must propagate BLE stack events to this module by calling
+ *           ble_dfu_c_on_ble_evt(), and all the functions of the module must be called from the
+ *           same interrupt priority as the BLE stack events.
+ */
+
+#ifndef BLE_DFU_C_H__
+#define BLE_DFU_C_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "ble_gatt.h"
+#include "ble_db_discovery.h"
+#include "ble_dfu.h"
+
+#define DFU_BASE_UUID                  {{0x23, 0xD1, 0xBC, 0xEA, 0x5F, 0x78, 0x23, 0x15, 0xDE, 0xEF, 0x12, 0x12, 0x00, 0x00, 0x00, 0x00}} /**< Used vendor specific UUID. */
+
+#define BLE_DFU_C_MAX_DATA_LEN         (GATT_MTU_SIZE_DEFAULT - 3) /**< Maximum length (in bytes) of a write to the DFU Packet characteristic. */
+
+#define BLE_DFU_C_UPDATE_SD            0x01                        /**< Image contains a SoftDevice. */
+#define BLE_DFU_C_UPDATE_BL            0x02                        /**< Image contains a bootloader. */
+#define BLE_DFU_C_UPDATE_APP           0x04                        /**< Image contains an application. */
+
+/**@brief Function for reading firmware data of the image.
+ *
+ * @details The data is read in order for each peer, but peers progress at different rates, so
+ *          the function must allow reading at any offset.
+ *
+ * @param[in]  offset  Offset from the start of the firmware data, in bytes.
+ * @param[out] p_data  Buffer for the data.
+ * @param[in]  length  Number of bytes to read, at most @ref BLE_DFU_C_MAX_DATA_LEN.
+ *
+ * @retval NRF_SUCCESS If the data was read. Otherwise, the update of the peer is aborted with
+ *                     @ref BLE_DFU_C_EVT_ERROR.
+ */
+typedef uint32_t (* ble_dfu_c_image_read_t)(uint32_t offset, uint8_t * p_data, uint16_t length);
+
+/**@brief Firmware image to be sent to the peers. */
+typedef struct
+{
+    uint8_t                update_mode;     /**< Content of the image, a combination of @ref BLE_DFU_C_UPDATE_SD, @ref BLE_DFU_C_UPDATE_BL and @ref BLE_DFU_C_UPDATE_APP. */
+    uint32_t               sd_size;         /**< Size of the SoftDevice, 0 if not included. */
+    uint32_t               bl_size;         /**< Size of the bootloader, 0 if not included. */
+    uint32_t               app_size;        /**< Size of the application, 0 if not included. */
+    uint8_t const *        p_init_data;     /**< Init packet. */
+    uint16_t               init_data_len;   /**< Length of the init packet. */
+    ble_dfu_c_image_read_t read;            /**< Function reading the firmware data: SoftDevice, bootloader and application, in this order. */
+} ble_dfu_c_image_t;
+
+/**@brief DFU Client event type. */
+typedef enum
+{
+    BLE_DFU_C_EVT_DISCOVERY_COMPLETE = 1, /**< Event indicating that the DFU Service and its characteristics were found. */
+    BLE_DFU_C_EVT_PROGRESS,               /**< Event indicating that the peer has acknowledged more firmware data. */
+    BLE_DFU_C_EVT_COMPLETE,               /**< Event indicating that the peer has validated the image and was asked to activate it. */
+    BLE_DFU_C_EVT_ERROR,                  /**< Event indicating that the update of the peer failed. */
+    BLE_DFU_C_EVT_DISCONNECTED            /**< Event indicating that the peer has disconnected. */
+} ble_dfu_c_evt_type_t;
+
+/**@brief State of the update of a peer. */
+typedef enum
+{
+    BLE_DFU_C_STATE_IDLE,                 /**< No update in progress. */
+    BLE_DFU_C_STATE_CCCD,                 /**< Enabling notifications of the Control Point. */
+    BLE_DFU_C_STATE_START,                /**< Start DFU written, waiting for its acknowledgment. */
+    BLE_DFU_C_STATE_START_RSP,            /**< Image sizes written, waiting for the response of the peer. */
+    BLE_DFU_C_STATE_INIT,                 /**< Receive Init written, waiting for its acknowledgment. */
+    BLE_DFU_C_STATE_INIT_DATA,            /**< Sending the init packet. */
+    BLE_DFU_C_STATE_INIT_RSP,             /**< Init packet complete, waiting for the response of the peer. */
+    BLE_DFU_C_STATE_PRN,                  /**< Packet Receipt Notification request written, waiting for its acknowledgment. */
+    BLE_DFU_C_STATE_RECEIVE_FW,           /**< Receive Firmware written, waiting for its acknowledgment. */
+    BLE_DFU_C_STATE_STREAM,               /**< Streaming the firmware data. */
+    BLE_DFU_C_STATE_STREAM_RSP,           /**< All firmware data sent, waiting for the response of the peer. */
+    BLE_DFU_C_STATE_VALIDATE,             /**< Validate written, waiting for the response of the peer. */
+    BLE_DFU_C_STATE_ACTIVATE,             /**< Activate & Reset written. */
+    BLE_DFU_C_STATE_COMPLETE,             /**< Update complete. */
+    BLE_DFU_C_STATE_ERROR                 /**< Update failed. */
+} ble_dfu_c_state_t;
+
+/**@brief Handles on the connected peer device needed to interact with it. */
+typedef struct
+{
+    uint16_t ctrl_pt_handle;              /**< Handle of the DFU Control Point characteristic as provided by a discovery. */
+    uint16_t ctrl_pt_cccd_handle;         /**< Handle of the CCCD of the DFU Control Point characteristic as provided by a discovery. */
+    uint16_t packet_handle;               /**< Handle of the DFU Packet characteristic as provided by a discovery. */
+} ble_dfu_c_handles_t;
+
+/**@brief Update statistics of a peer. */
+typedef struct
+{
+    uint32_t bytes_total;                 /**< Firmware bytes to be sent. */
+    uint32_t bytes_sent;                  /**< Firmware bytes queued in the SoftDevice. */
+    uint32_t bytes_acked;                 /**< Firmware bytes acknowledged by the peer in Packet Receipt Notifications. */
+    uint32_t stall_count;                 /**< Number of times a write could not be queued because the SoftDevice had no free TX buffers. */
+    uint32_t window_count;                /**< Number of times sending paused for a Packet Receipt Notification. */
+} ble_dfu_c_stats_t;
+
+/**@brief Structure containing the DFU Client event data. */
+typedef struct
+{
+    ble_dfu_c_evt_type_t evt_type;
+    uint16_t             conn_handle;
+    ble_dfu_c_handles_t  handles;         /**< Handles of the DFU Service characteristics. Filled if evt_type is @ref BLE_DFU_C_EVT_DISCOVERY_COMPLETE. */
+    ble_dfu_c_state_t    state;           /**< State in which the update failed. Filled if evt_type is @ref BLE_DFU_C_EVT_ERROR. */
+    uint32_t             error;           /**< DFU response value of the peer (see @ref ble_dfu_resp_val_t), or error code of the SoftDevice if no response value was received. Filled if evt_type is @ref BLE_DFU_C_EVT_ERROR. */
+} ble_dfu_c_evt_t;
+
+// Forward declaration of the ble_dfu_c_t type.
+typedef struct ble_dfu_c_s ble_dfu_c_t;
+
+/**@brief Event handler type. */
+typedef void (* ble_dfu_c_evt_handler_t)(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_evt_t const * p_evt);
+
+/**@brief DFU Client structure. */
+struct ble_dfu_c_s
+{
+    uint8_t                   uuid_type;                       /**< UUID type. */
+    uint16_t                  conn_handle;                     /**< Handle of the current connection. Set with @ref ble_dfu_c_handles_assign when connected. */
+    ble_dfu_c_handles_t       handles;                         /**< Handles on the connected peer device needed to interact with it. */
+    ble_dfu_c_evt_handler_t   evt_handler;                     /**< Application event handler. */
+    uint16_t                  prn;                             /**< Packets per Packet Receipt Notification, 0 to disable them. */
+    uint8_t                   prn_window;                      /**< Packet Receipt Notification intervals that can be in flight. */
+    ble_dfu_c_state_t         state;                           /**< State of the update. */
+    ble_dfu_c_image_t const * p_image;                         /**< Image being sent. */
+    uint32_t                  offset;                          /**< Offset of the next data to be sent, in the init packet or the firmware. */
+    uint8_t                   packet[BLE_DFU_C_MAX_DATA_LEN];  /**< Data of the write command that is being queued in the SoftDevice. */
+    uint8_t                   packet_len;                      /**< Length of the write command that is being queued, 0 if none. */
+    bool                      window_full;                     /**< Sending is paused for a Packet Receipt Notification. */
+    ble_dfu_c_stats_t         stats;                           /**< Update statistics. */
+};
+
+/**@brief DFU Client initialization structure. */
+typedef struct
+{
+    ble_dfu_c_evt_handler_t evt_handler;  /**< Application event handler. */
+    uint16_t                prn;          /**< Packets per Packet Receipt Notification, 0 to disable them. The bootloader must buffer at least prn * prn_window packets while it writes to flash. */
+    uint8_t                 prn_window;   /**< Packet Receipt Notification intervals that can be in flight, at least 1. */
+} ble_dfu_c_init_t;
+
+/**@brief Function for initializing a DFU Client instance.
+ *
+ * @details This function registers with the Database Discovery module for the DFU Service.
+ *
+ * @param[in] p_ble_dfu_c      Pointer to the DFU Client structure.
+ * @param[in] p_ble_dfu_c_init Pointer to the initialization structure.
+ *
+ * @retval NRF_SUCCESS             If the module was initialized successfully.
+ * @retval NRF_ERROR_NULL          If a parameter is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If prn is not 0 and prn_window is 0.
+ * @return Otherwise, the error code of @ref sd_ble_uuid_vs_add or
+ *         @ref ble_db_discovery_evt_register.
+ */
+uint32_t ble_dfu_c_init(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_init_t const * p_ble_dfu_c_init);
+
+/**@brief Function for handling events from the database discovery module.
+ *
+ * @param[in] p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[in] p_evt       Pointer to the event received from the database discovery module.
+ */
+void ble_dfu_c_on_db_disc_evt(ble_dfu_c_t * p_ble_dfu_c, ble_db_discovery_evt_t const * p_evt);
+
+/**@brief Function for handling BLE events from the SoftDevice.
+ *
+ * @param[in] p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[in] p_ble_evt   Pointer to the BLE event.
+ */
+void ble_dfu_c_on_ble_evt(ble_dfu_c_t * p_ble_dfu_c, ble_evt_t const * p_ble_evt);
+
+/**@brief Function for assigning a link and handles to an instance.
+ *
+ * @param[in] p_ble_dfu_c    Pointer to the DFU Client structure.
+ * @param[in] conn_handle    Connection handle of the link.
+ * @param[in] p_peer_handles Handles of the DFU Service at the peer, or NULL if they are not known
+ *                           yet. Provided by the @ref BLE_DFU_C_EVT_DISCOVERY_COMPLETE event.
+ *
+ * @retval NRF_SUCCESS    If the operation was successful.
+ * @retval NRF_ERROR_NULL If p_ble_dfu_c is NULL.
+ */
+uint32_t ble_dfu_c_handles_assign(ble_dfu_c_t *               p_ble_dfu_c,
+                                  uint16_t                    conn_handle,
+                                  ble_dfu_c_handles_t const * p_peer_handles);
+
+/**@brief Function for starting the update of the peer.
+ *
+ * @param[in] p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[in] p_image     Image to be sent. Must stay valid until the update is complete.
+ *
+ * @retval NRF_SUCCESS             If the update was started.
+ * @retval NRF_ERROR_NULL          If a parameter is NULL.
+ * @retval NRF_ERROR_INVALID_STATE If the handles are not assigned, or an update is in progress.
+ * @retval NRF_ERROR_INVALID_PARAM If the image is empty.
+ * @return Otherwise, the error code of @ref sd_ble_gattc_write.
+ */
+uint32_t ble_dfu_c_start(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_image_t const * p_image);
+
+/**@brief Function for getting the update statistics.
+ *
+ * @param[in]  p_ble_dfu_c Pointer to the DFU Client structure.
+ * @param[out] p_stats     Update statistics.
+ */
+void ble_dfu_c_stats_get(ble_dfu_c_t const * p_ble_dfu_c, ble_dfu_c_stats_t * p_stats);
+
+#endif // BLE_DFU_C_H__
+
+/** @} */
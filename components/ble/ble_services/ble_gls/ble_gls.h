@@ -33,6 +33,7 @@
 #include <stdbool.h>
 #include "ble.h"
 #include "ble_srv_common.h"
+#include "ble_racp_engine.h"
 #include "ble_date_time.h"
 
 /**@brief Glucose feature */
@@ -222,6 +223,7 @@ struct ble_gls_s
     uint16_t                  conn_handle;                     /**< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection). */
     uint16_t                  feature;
     bool                      is_context_supported;
+    ble_racp_engine_t         racp_engine;                     /**< Record access engine of the Record Access Control Point. */
 };
 
 /**@brief Function for initializing the Glucose Service.
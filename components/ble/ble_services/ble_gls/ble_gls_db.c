@@ -10,8 +10,396 @@
  */
 
 #include "ble_gls_db.h"
+#include <string.h>
+#include "app_util.h"
+#if (BLE_GLS_DB_FDS_ENABLED == 1)
+#include "fds.h"
+#endif
 
 
+#if (BLE_GLS_DB_FDS_ENABLED == 1)
+
+#define RECORD_WORDS                CEIL_DIV(sizeof(ble_gls_rec_t), sizeof(uint32_t))  /**< Size of a stored glucose record, in 4-byte words. */
+
+/**@brief Entry of the RAM index of the records stored in flash. */
+typedef struct
+{
+    uint32_t record_id;                                 /**< FDS record ID of the record. */
+    uint16_t seq_num;                                   /**< Sequence number of the record. */
+} index_entry_t;
+
+/**@brief Record which has been queued for writing but not yet written to flash. */
+typedef struct
+{
+    bool     in_use_flag;                               /**< TRUE if the entry holds a queued record. */
+    bool     delete_pending;                            /**< TRUE if the record was deleted before it was written. */
+    uint32_t record_id;                                 /**< FDS record ID of the record. */
+    uint32_t data[RECORD_WORDS];                        /**< Record data, kept until the write has completed. */
+} write_entry_t;
+
+static index_entry_t m_index[BLE_GLS_DB_MAX_RECORDS];   /**< Stored records, in increasing order of sequence number. */
+static write_entry_t m_write_queue[BLE_GLS_DB_WRITE_QUEUE_SIZE];
+static uint16_t      m_num_records;
+static bool          m_index_loaded;
+static bool          m_fds_registered;
+
+
+/**@brief Function for converting an FDS return value to an nRF error code.
+ *
+ * @param[in] ret  Return value from FDS.
+ *
+ * @return    Corresponding nRF error code.
+ */
+static uint32_t fds_ret_convert(ret_code_t ret)
+{
+    switch (ret)
+    {
+        case FDS_SUCCESS:
+            return NRF_SUCCESS;
+
+        case FDS_ERR_NO_SPACE_IN_QUEUES:
+        case FDS_ERR_BUSY:
+            return NRF_ERROR_BUSY;
+
+        case FDS_ERR_NO_SPACE_IN_FLASH:
+            return NRF_ERROR_NO_MEM;
+
+        case FDS_ERR_NOT_INITIALIZED:
+            return NRF_ERROR_INVALID_STATE;
+
+        default:
+            return NRF_ERROR_INTERNAL;
+    }
+}
+
+
+/**@brief Function for finding a record in the write queue.
+ *
+ * @param[in] record_id  FDS record ID of the record.
+ *
+ * @return    Queued entry, or NULL if the record is not in the write queue.
+ */
+static write_entry_t * write_entry_find(uint32_t record_id)
+{
+    for (uint32_t i = 0; i < BLE_GLS_DB_WRITE_QUEUE_SIZE; i++)
+    {
+        if (m_write_queue[i].in_use_flag && (m_write_queue[i].record_id == record_id))
+        {
+            return &m_write_queue[i];
+        }
+    }
+    return NULL;
+}
+
+
+/**@brief Function for inserting a record in the index, keeping the index sorted.
+ *
+ * @details Records are normally added with increasing sequence numbers, so the search for the
+ *          insertion point starts at the end of the index.
+ *
+ * @param[in] record_id  FDS record ID of the record.
+ * @param[in] seq_num    Sequence number of the record.
+ */
+static void index_insert(uint32_t record_id, uint16_t seq_num)
+{
+    uint16_t i = m_num_records;
+
+    while ((i > 0) && (m_index[i - 1].seq_num > seq_num))
+    {
+        m_index[i] = m_index[i - 1];
+        i--;
+    }
+
+    m_index[i].record_id = record_id;
+    m_index[i].seq_num   = seq_num;
+    m_num_records++;
+}
+
+
+/**@brief Function for removing an entry from the index.
+ *
+ * @param[in] rec_ndx  Index of the entry to remove.
+ */
+static void index_remove(uint16_t rec_ndx)
+{
+    m_num_records--;
+    memmove(&m_index[rec_ndx],
+            &m_index[rec_ndx + 1],
+            (m_num_records - rec_ndx) * sizeof(index_entry_t));
+}
+
+
+/**@brief Function for building the index from the records stored in flash.
+ */
+static void index_load(void)
+{
+    fds_record_desc_t  desc;
+    fds_find_token_t   token;
+    fds_flash_record_t flash_record;
+
+    memset(&token, 0, sizeof(token));
+
+    while (   (m_num_records < BLE_GLS_DB_MAX_RECORDS)
+           && (fds_record_find(BLE_GLS_DB_FILE_ID, BLE_GLS_DB_RECORD_KEY, &desc, &token)
+               == FDS_SUCCESS))
+    {
+        if (fds_record_open(&desc, &flash_record) == FDS_SUCCESS)
+        {
+            ble_gls_rec_t const * p_rec = (ble_gls_rec_t const *)flash_record.p_data;
+
+            index_insert(desc.record_id, p_rec->meas.sequence_number);
+            (void)fds_record_close(&desc);
+        }
+    }
+
+    m_index_loaded = true;
+}
+
+
+/**@brief Function for deleting a record from flash.
+ *
+ * @param[in] record_id  FDS record ID of the record.
+ *
+ * @return    NRF_SUCCESS on success, otherwise an error code.
+ */
+static uint32_t record_flash_delete(uint32_t record_id)
+{
+    fds_record_desc_t desc;
+    ret_code_t        ret;
+
+    ret = fds_descriptor_from_rec_id(&desc, record_id);
+    if (ret == FDS_SUCCESS)
+    {
+        ret = fds_record_delete(&desc);
+    }
+
+    return fds_ret_convert(ret);
+}
+
+
+/**@brief Function for handling FDS events.
+ *
+ * @param[in] p_evt  Event received from FDS.
+ */
+static void fds_evt_handler(fds_evt_t const * const p_evt)
+{
+    switch (p_evt->id)
+    {
+        case FDS_EVT_INIT:
+            if ((p_evt->result == FDS_SUCCESS) && !m_index_loaded)
+            {
+                index_load();
+            }
+            break;
+
+        case FDS_EVT_WRITE:
+        {
+            write_entry_t * p_entry;
+
+            if (p_evt->write.file_id != BLE_GLS_DB_FILE_ID)
+            {
+                break;
+            }
+
+            p_entry = write_entry_find(p_evt->write.record_id);
+            if (p_entry == NULL)
+            {
+                break;
+            }
+
+            if (p_evt->result != FDS_SUCCESS)
+            {
+                // The record was lost, remove it from the index.
+                for (uint16_t i = 0; i < m_num_records; i++)
+                {
+                    if (m_index[i].record_id == p_entry->record_id)
+                    {
+                        index_remove(i);
+                        break;
+                    }
+                }
+            }
+            else if (p_entry->delete_pending)
+            {
+                (void)record_flash_delete(p_entry->record_id);
+            }
+
+            p_entry->in_use_flag = false;
+        } break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
+
+
+uint32_t ble_gls_db_init(void)
+{
+    uint32_t err_code;
+
+    memset(m_write_queue, 0, sizeof(m_write_queue));
+    m_num_records  = 0;
+    m_index_loaded = false;
+
+    if (!m_fds_registered)
+    {
+        err_code = fds_ret_convert(fds_register(fds_evt_handler));
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+        m_fds_registered = true;
+    }
+
+    // If FDS is installed already, the index is loaded before this call returns.
+    return fds_ret_convert(fds_init());
+}
+
+
+uint16_t ble_gls_db_num_records_get(void)
+{
+    return m_num_records;
+}
+
+
+uint32_t ble_gls_db_record_get(uint16_t rec_ndx, ble_gls_rec_t * p_rec)
+{
+    fds_record_desc_t  desc;
+    fds_flash_record_t flash_record;
+    write_entry_t    * p_entry;
+    ret_code_t         ret;
+
+    if (rec_ndx >= m_num_records)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_entry = write_entry_find(m_index[rec_ndx].record_id);
+    if (p_entry != NULL)
+    {
+        memcpy(p_rec, p_entry->data, sizeof(ble_gls_rec_t));
+        return NRF_SUCCESS;
+    }
+
+    ret = fds_descriptor_from_rec_id(&desc, m_index[rec_ndx].record_id);
+    if (ret == FDS_SUCCESS)
+    {
+        ret = fds_record_open(&desc, &flash_record);
+    }
+    if (ret != FDS_SUCCESS)
+    {
+        return fds_ret_convert(ret);
+    }
+
+    memcpy(p_rec, flash_record.p_data, sizeof(ble_gls_rec_t));
+
+    return fds_ret_convert(fds_record_close(&desc));
+}
+
+
+uint32_t ble_gls_db_record_add(ble_gls_rec_t * p_rec)
+{
+    fds_record_desc_t  desc;
+    fds_record_chunk_t chunk;
+    fds_record_t       record;
+    write_entry_t    * p_entry = NULL;
+    ret_code_t         ret;
+
+    if (!m_index_loaded)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (m_num_records == BLE_GLS_DB_MAX_RECORDS)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    for (uint32_t i = 0; i < BLE_GLS_DB_WRITE_QUEUE_SIZE; i++)
+    {
+        if (!m_write_queue[i].in_use_flag)
+        {
+            p_entry = &m_write_queue[i];
+            break;
+        }
+    }
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    memset(p_entry->data, 0, sizeof(p_entry->data));
+    memcpy(p_entry->data, p_rec, sizeof(ble_gls_rec_t));
+
+    chunk.p_data       = p_entry->data;
+    chunk.length_words = RECORD_WORDS;
+
+    record.file_id         = BLE_GLS_DB_FILE_ID;
+    record.key             = BLE_GLS_DB_RECORD_KEY;
+    record.data.p_chunks   = &chunk;
+    record.data.num_chunks = 1;
+
+    ret = fds_record_write(&desc, &record);
+    if (ret != FDS_SUCCESS)
+    {
+        return fds_ret_convert(ret);
+    }
+
+    p_entry->in_use_flag    = true;
+    p_entry->delete_pending = false;
+    p_entry->record_id      = desc.record_id;
+
+    index_insert(desc.record_id, p_rec->meas.sequence_number);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_gls_db_record_delete(uint16_t rec_ndx)
+{
+    write_entry_t * p_entry;
+    uint32_t        err_code;
+
+    if (rec_ndx >= m_num_records)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    p_entry = write_entry_find(m_index[rec_ndx].record_id);
+    if (p_entry != NULL)
+    {
+        // Delete the record once it has been written.
+        p_entry->delete_pending = true;
+    }
+    else
+    {
+        err_code = record_flash_delete(m_index[rec_ndx].record_id);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    index_remove(rec_ndx);
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for getting the sequence number of a record.
+ *
+ * @param[in] rec_ndx  Index of the record.
+ *
+ * @return    Sequence number of the record.
+ */
+static uint16_t seq_num_get(uint16_t rec_ndx)
+{
+    return m_index[rec_ndx].seq_num;
+}
+
+#else // BLE_GLS_DB_FDS_ENABLED
+
 typedef struct
 {
     bool          in_use_flag;
@@ -19,7 +407,7 @@ typedef struct
 } database_entry_t;
 
 static database_entry_t m_database[BLE_GLS_DB_MAX_RECORDS];
-static uint8_t          m_database_crossref[BLE_GLS_DB_MAX_RECORDS];
+static uint16_t         m_database_crossref[BLE_GLS_DB_MAX_RECORDS];
 static uint16_t         m_num_records;
 
 
@@ -30,7 +418,7 @@ uint32_t ble_gls_db_init(void)
     for (i = 0; i < BLE_GLS_DB_MAX_RECORDS; i++)
     {
         m_database[i].in_use_flag = false;
-        m_database_crossref[i]    = 0xFF;
+        m_database_crossref[i]    = 0xFFFF;
     }
 
     m_num_records = 0;
@@ -45,7 +433,7 @@ uint16_t ble_gls_db_num_records_get(void)
 }
 
 
-uint32_t ble_gls_db_record_get(uint8_t rec_ndx, ble_gls_rec_t * p_rec)
+uint32_t ble_gls_db_record_get(uint16_t rec_ndx, ble_gls_rec_t * p_rec)
 {
     if (rec_ndx >= m_num_records)
     {
@@ -73,10 +461,21 @@ uint32_t ble_gls_db_record_add(ble_gls_rec_t * p_rec)
     {
         if (!m_database[i].in_use_flag)
         {
+            uint16_t ndx = m_num_records;
+
             m_database[i].in_use_flag = true;
             m_database[i].record      = *p_rec;
 
-            m_database_crossref[m_num_records] = i;
+            // keep cross references sorted by sequence number
+            while (   (ndx > 0)
+                   && (m_database[m_database_crossref[ndx - 1]].record.meas.sequence_number
+                       > p_rec->meas.sequence_number))
+            {
+                m_database_crossref[ndx] = m_database_crossref[ndx - 1];
+                ndx--;
+            }
+
+            m_database_crossref[ndx] = i;
             m_num_records++;
 
             return NRF_SUCCESS;
@@ -87,7 +486,7 @@ uint32_t ble_gls_db_record_add(ble_gls_rec_t * p_rec)
 }
 
 
-uint32_t ble_gls_db_record_delete(uint8_t rec_ndx)
+uint32_t ble_gls_db_record_delete(uint16_t rec_ndx)
 {
     int i;
 
@@ -110,3 +509,48 @@ uint32_t ble_gls_db_record_delete(uint8_t rec_ndx)
 
     return NRF_SUCCESS;
 }
+
+
+/**@brief Function for getting the sequence number of a record.
+ *
+ * @param[in] rec_ndx  Index of the record.
+ *
+ * @return    Sequence number of the record.
+ */
+static uint16_t seq_num_get(uint16_t rec_ndx)
+{
+    return m_database[m_database_crossref[rec_ndx]].record.meas.sequence_number;
+}
+
+#endif // BLE_GLS_DB_FDS_ENABLED
+
+
+uint32_t ble_gls_db_record_index_find(uint16_t seq_num, uint16_t * p_rec_ndx)
+{
+    uint16_t low  = 0;
+    uint16_t high = m_num_records;
+
+    // Binary search for the first record with a sequence number >= seq_num.
+    while (low < high)
+    {
+        uint16_t mid = low + (high - low) / 2;
+
+        if (seq_num_get(mid) < seq_num)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    if (low == m_num_records)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_rec_ndx = low;
+
+    return NRF_SUCCESS;
+}
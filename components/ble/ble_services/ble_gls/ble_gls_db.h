@@ -18,6 +18,10 @@
  *
  * @details This module implements at database of stored glucose measurement values.
  *
+ *          Records are kept in increasing order of sequence number. By default they are stored in
+ *          RAM. If BLE_GLS_DB_FDS_ENABLED is 1, they are stored in flash using @ref fds and a RAM
+ *          index of their sequence numbers is rebuilt from flash on initialization.
+ *
  * @note Attention! 
  *  To maintain compliance with Nordic Semiconductor ASA Bluetooth profile 
  *  qualification listings, These APIs must not be modified. However, the corresponding
@@ -30,12 +34,38 @@
 #include <stdint.h>
 #include "ble_gls.h"
 
-#define BLE_GLS_DB_MAX_RECORDS      20
+#ifndef BLE_GLS_DB_FDS_ENABLED
+#define BLE_GLS_DB_FDS_ENABLED      0                   /**< Store the records in flash using FDS. */
+#endif
+
+#ifndef BLE_GLS_DB_MAX_RECORDS
+#define BLE_GLS_DB_MAX_RECORDS      20                  /**< Maximum number of records in the database. */
+#endif
+
+#if (BLE_GLS_DB_FDS_ENABLED == 1)
+
+#ifndef BLE_GLS_DB_FILE_ID
+#define BLE_GLS_DB_FILE_ID          0x6C51              /**< FDS file ID of the glucose records. */
+#endif
+
+#ifndef BLE_GLS_DB_RECORD_KEY
+#define BLE_GLS_DB_RECORD_KEY       0x6C51              /**< FDS record key of the glucose records. */
+#endif
+
+#ifndef BLE_GLS_DB_WRITE_QUEUE_SIZE
+#define BLE_GLS_DB_WRITE_QUEUE_SIZE 4                   /**< Number of records which can wait to be written to flash. */
+#endif
+
+#endif // BLE_GLS_DB_FDS_ENABLED
 
 /**@brief Function for initializing the glucose record database.
  *
  * @details This call initializes the database holding glucose records.
  *
+ *          When the records are stored in flash, this call registers with FDS and calls
+ *          fds_init(). The records already stored are indexed when FDS reports that it is
+ *          initialized, which happens before this call returns if FDS is installed already.
+ *
  * @return      NRF_SUCCESS on success. 
  */
 uint32_t ble_gls_db_init(void);
@@ -57,15 +87,20 @@ uint16_t ble_gls_db_num_records_get(void);
  * 
  * @return      NRF_SUCCESS on success.
  */
-uint32_t ble_gls_db_record_get(uint8_t record_num, ble_gls_rec_t * p_rec);
+uint32_t ble_gls_db_record_get(uint16_t record_num, ble_gls_rec_t * p_rec);
 
 /**@brief Function for adding a record at the end of the database.
  *
- * @details This call adds a record as the last record in the database.
+ * @details This call adds a record as the last record in the database. A record with a lower
+ *          sequence number than the last record is inserted in sequence number order.
  *
  * @param[in]   p_rec   Pointer to record to add to database.
  * 
  * @return      NRF_SUCCESS on success.
+ * @return      NRF_ERROR_NO_MEM if the database is full.
+ * @return      NRF_ERROR_BUSY if the records are stored in flash and too many writes are pending.
+ * @return      NRF_ERROR_INVALID_STATE if the records are stored in flash and FDS is not yet
+ *              initialized.
  */
 uint32_t ble_gls_db_record_add(ble_gls_rec_t * p_rec);
 
@@ -77,7 +112,18 @@ uint32_t ble_gls_db_record_add(ble_gls_rec_t * p_rec);
  * 
  * @return      NRF_SUCCESS on success.
  */
-uint32_t ble_gls_db_record_delete(uint8_t record_num);
+uint32_t ble_gls_db_record_delete(uint16_t record_num);
+
+/**@brief Function for finding the first record with a sequence number greater than or equal to a
+ *        given value.
+ *
+ * @param[in]   seq_num     Sequence number to look for.
+ * @param[out]  p_rec_ndx   Index of the first record with a sequence number >= seq_num.
+ *
+ * @return      NRF_SUCCESS on success.
+ * @return      NRF_ERROR_NOT_FOUND if all records have lower sequence numbers.
+ */
+uint32_t ble_gls_db_record_index_find(uint16_t seq_num, uint16_t * p_rec_ndx);
 
 #endif // BLE_GLS_DB_H__
 
@@ -41,6 +41,9 @@
 #define BOOT_MOUSE_INPUT_REPORT_MIN_SIZE 3                           /**< Minimum size of a Boot Mouse Input Report (as per Appendix B in Device Class Definition for Human Interface Devices (HID), Version 1.11). */
 #define BOOT_MOUSE_INPUT_REPORT_MAX_SIZE 8                           /**< Maximum size of a Boot Mouse Input Report (as per Appendix B in Device Class Definition for Human Interface Devices (HID), Version 1.11). */
 
+#define BOOT_KB_INP_REP_QUEUE            BLE_HIDS_MAX_INPUT_REP      /**< Index of the Boot Keyboard Input Report queue. */
+#define BOOT_MOUSE_INP_REP_QUEUE         (BLE_HIDS_MAX_INPUT_REP + 1)/**< Index of the Boot Mouse Input Report queue. */
+
 
 /**@brief Function for making a HID Service characteristic id.
  *
@@ -107,7 +110,65 @@ static void on_disconnect(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
 {
     UNUSED_PARAMETER(p_ble_evt);
     p_hids->conn_handle = BLE_CONN_HANDLE_INVALID;
+
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+    // Discard the queued reports.
+    for (uint32_t i = 0; i < BLE_HIDS_INP_REP_QUEUE_COUNT; i++)
+    {
+        p_hids->inp_rep_queues[i].count = 0;
+    }
+#endif
+}
+
+
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+/**@brief Function for handling the TX Complete event.
+ *
+ * @details Notifies the queued reports until the SoftDevice runs out of TX buffers. A report
+ *          that cannot be notified for another reason, for example because notifications were
+ *          disabled, is discarded.
+ *
+ * @param[in]   p_hids      HID Service structure.
+ */
+static void on_tx_complete(ble_hids_t * p_hids)
+{
+    for (uint32_t i = 0; i < BLE_HIDS_INP_REP_QUEUE_COUNT; i++)
+    {
+        ble_hids_rep_queue_t * p_queue = &p_hids->inp_rep_queues[i];
+
+        while (p_queue->count != 0)
+        {
+            ble_gatts_hvx_params_t hvx_params;
+            uint16_t               hvx_len = p_queue->rep_len[p_queue->read_idx];
+            uint32_t               err_code;
+
+            memset(&hvx_params, 0, sizeof(hvx_params));
+
+            hvx_params.handle = p_queue->value_handle;
+            hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+            hvx_params.offset = 0;
+            hvx_params.p_len  = &hvx_len;
+            hvx_params.p_data = p_queue->rep[p_queue->read_idx];
+
+            err_code = sd_ble_gatts_hvx(p_hids->conn_handle, &hvx_params);
+            if (err_code == BLE_ERROR_NO_TX_PACKETS)
+            {
+                return;
+            }
+            if ((err_code != NRF_SUCCESS)                     &&
+                (err_code != NRF_ERROR_INVALID_STATE)         &&
+                (err_code != BLE_ERROR_GATTS_SYS_ATTR_MISSING) &&
+                (p_hids->error_handler != NULL))
+            {
+                p_hids->error_handler(err_code);
+            }
+
+            p_queue->read_idx = (p_queue->read_idx + 1) % BLE_HIDS_INP_REP_QUEUE_SIZE;
+            p_queue->count--;
+        }
+    }
 }
+#endif
 
 
 /**@brief Function for handling write events to the HID Control Point value.
@@ -416,6 +477,13 @@ void ble_hids_on_ble_evt(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
         case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
             on_rw_authorize_request(p_hids, p_ble_evt);
             break;
+
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+        case BLE_EVT_TX_COMPLETE:
+            on_tx_complete(p_hids);
+            break;
+#endif
+
         default:
             // No implementation needed.
             break;
@@ -1109,6 +1177,15 @@ uint32_t ble_hids_init(ble_hids_t * p_hids, const ble_hids_init_t * p_hids_init)
     p_hids->feature_rep_count = p_hids_init->feature_rep_count;
     p_hids->conn_handle       = BLE_CONN_HANDLE_INVALID;
 
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+    memset(p_hids->inp_rep_queues, 0, sizeof(p_hids->inp_rep_queues));
+    for (uint32_t i = 0; i < p_hids_init->inp_rep_count; i++)
+    {
+        p_hids->inp_rep_queues[i].merge_handler = p_hids_init->p_inp_rep_array[i].merge_handler;
+    }
+    p_hids->inp_rep_queues[BOOT_MOUSE_INP_REP_QUEUE].merge_handler = ble_hids_boot_mouse_rep_merge;
+#endif
+
     // Add service.
     BLE_UUID_BLE_ASSIGN(ble_uuid, BLE_UUID_HUMAN_INTERFACE_DEVICE_SERVICE);
 
@@ -1218,6 +1295,96 @@ uint32_t ble_hids_init(ble_hids_t * p_hids, const ble_hids_init_t * p_hids_init)
 }
 
 
+/**@brief Function for notifying an Input Report, or queuing it if needed.
+ *
+ * @details Without queuing, the report is passed to the SoftDevice. With queuing, the report is
+ *          queued if the queue of the characteristic is not empty, or if the SoftDevice has no
+ *          free TX buffers. It is then merged with the last queued report if possible.
+ *
+ * @param[in]   p_hids        HID Service structure.
+ * @param[in]   queue_index   Index of the queue of the characteristic.
+ * @param[in]   p_hvx_params  Notification parameters.
+ *
+ * @return      Error code of sd_ble_gatts_hvx, or NRF_ERROR_NO_MEM if the queue is full.
+ */
+static uint32_t inp_rep_notify(ble_hids_t             * p_hids,
+                               uint8_t                  queue_index,
+                               ble_gatts_hvx_params_t * p_hvx_params)
+{
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+    ble_hids_rep_queue_t * p_queue = &p_hids->inp_rep_queues[queue_index];
+    uint16_t const         len     = *p_hvx_params->p_len;
+
+    if (p_queue->count == 0)
+    {
+        uint32_t err_code = sd_ble_gatts_hvx(p_hids->conn_handle, p_hvx_params);
+
+        if ((err_code != BLE_ERROR_NO_TX_PACKETS) || (len > BLE_HIDS_INP_REP_QUEUE_MAX_LEN))
+        {
+            return err_code;
+        }
+    }
+    else
+    {
+        uint32_t const last = (p_queue->read_idx + p_queue->count - 1) % BLE_HIDS_INP_REP_QUEUE_SIZE;
+
+        if (len > BLE_HIDS_INP_REP_QUEUE_MAX_LEN)
+        {
+            // Sending the report now would overtake the queued reports.
+            return BLE_ERROR_NO_TX_PACKETS;
+        }
+        if ((p_queue->merge_handler != NULL) &&
+            (p_queue->rep_len[last] == len)  &&
+            p_queue->merge_handler(p_queue->rep[last], p_hvx_params->p_data, len))
+        {
+            return NRF_SUCCESS;
+        }
+    }
+
+    if (p_queue->count == BLE_HIDS_INP_REP_QUEUE_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    uint32_t const idx = (p_queue->read_idx + p_queue->count) % BLE_HIDS_INP_REP_QUEUE_SIZE;
+
+    memcpy(p_queue->rep[idx], p_hvx_params->p_data, len);
+    p_queue->rep_len[idx]  = (uint8_t)len;
+    p_queue->value_handle  = p_hvx_params->handle;
+    p_queue->count++;
+
+    return NRF_SUCCESS;
+#else
+    UNUSED_PARAMETER(queue_index);
+    return sd_ble_gatts_hvx(p_hids->conn_handle, p_hvx_params);
+#endif
+}
+
+
+bool ble_hids_boot_mouse_rep_merge(uint8_t * p_queued, uint8_t const * p_rep, uint16_t len)
+{
+    if ((len < BOOT_MOUSE_INPUT_REPORT_MIN_SIZE) ||
+        (p_queued[0] != p_rep[0])                ||
+        (memcmp(&p_queued[3], &p_rep[3], len - BOOT_MOUSE_INPUT_REPORT_MIN_SIZE) != 0))
+    {
+        return false;
+    }
+
+    int32_t const x = (int32_t)(int8_t)p_queued[1] + (int8_t)p_rep[1];
+    int32_t const y = (int32_t)(int8_t)p_queued[2] + (int8_t)p_rep[2];
+
+    if ((x < INT8_MIN) || (x > INT8_MAX) || (y < INT8_MIN) || (y > INT8_MAX))
+    {
+        return false;
+    }
+
+    p_queued[1] = (uint8_t)(int8_t)x;
+    p_queued[2] = (uint8_t)(int8_t)y;
+
+    return true;
+}
+
+
 uint32_t ble_hids_inp_rep_send(ble_hids_t * p_hids,
                                uint8_t      rep_index,
                                uint16_t     len,
@@ -1242,7 +1409,7 @@ uint32_t ble_hids_inp_rep_send(ble_hids_t * p_hids,
             hvx_params.p_len  = &hvx_len;
             hvx_params.p_data = p_data;
 
-            err_code = sd_ble_gatts_hvx(p_hids->conn_handle, &hvx_params);
+            err_code = inp_rep_notify(p_hids, rep_index, &hvx_params);
             if ((err_code == NRF_SUCCESS) && (hvx_len != len))
             {
                 err_code = NRF_ERROR_DATA_SIZE;
@@ -1279,7 +1446,7 @@ uint32_t ble_hids_boot_kb_inp_rep_send(ble_hids_t * p_hids, uint16_t len, uint8_
         hvx_params.p_len  = &hvx_len;
         hvx_params.p_data = p_data;
 
-        err_code = sd_ble_gatts_hvx(p_hids->conn_handle, &hvx_params);
+        err_code = inp_rep_notify(p_hids, BOOT_KB_INP_REP_QUEUE, &hvx_params);
         if ((err_code == NRF_SUCCESS) && (hvx_len != len))
         {
             err_code = NRF_ERROR_DATA_SIZE;
@@ -1333,7 +1500,7 @@ uint32_t ble_hids_boot_mouse_inp_rep_send(ble_hids_t * p_hids,
             hvx_params.p_len  = &hvx_len;
             hvx_params.p_data = buffer;
 
-            err_code = sd_ble_gatts_hvx(p_hids->conn_handle, &hvx_params);
+            err_code = inp_rep_notify(p_hids, BOOT_MOUSE_INP_REP_QUEUE, &hvx_params);
             if ((err_code == NRF_SUCCESS) &&
                 (hvx_len != BOOT_MOUSE_INPUT_REPORT_MIN_SIZE + optional_data_len)
                )
@@ -25,6 +25,14 @@
  *          If enabled, notification of Input Report characteristics is performed when the
  *          application calls the corresponding ble_hids_xx_input_report_send() function.
  *
+ *          If @ref BLE_HIDS_INP_REP_QUEUE_ENABLED is set, Input Reports that cannot be notified
+ *          because the SoftDevice has no free TX buffers are queued per characteristic, and
+ *          notified on @ref BLE_EVT_TX_COMPLETE. A report sent while the queue of its
+ *          characteristic is not empty can be merged with the last queued report by a merge
+ *          handler, for example to accumulate the motion of relative pointer reports. Without a
+ *          merge handler, for example for keyboard reports, every report is queued. The send
+ *          functions must then be called from the interrupt priority of ble_hids_on_ble_evt().
+ *
  *          If an event handler is supplied by the application, the Human Interface Device Service
  *          will generate Human Interface Device Service events to the application.
  *
@@ -62,6 +70,20 @@
 #define HID_INFO_FLAG_REMOTE_WAKE_MSK           0x01
 #define HID_INFO_FLAG_NORMALLY_CONNECTABLE_MSK  0x02
 
+#ifndef BLE_HIDS_INP_REP_QUEUE_ENABLED
+#define BLE_HIDS_INP_REP_QUEUE_ENABLED          0           /**< Queue Input Reports while the SoftDevice has no free TX buffers. */
+#endif
+
+#ifndef BLE_HIDS_INP_REP_QUEUE_SIZE
+#define BLE_HIDS_INP_REP_QUEUE_SIZE             4           /**< Number of reports queued per Input Report characteristic. */
+#endif
+
+#ifndef BLE_HIDS_INP_REP_QUEUE_MAX_LEN
+#define BLE_HIDS_INP_REP_QUEUE_MAX_LEN          8           /**< Maximum length of a queued report. Longer reports are not queued. */
+#endif
+
+#define BLE_HIDS_INP_REP_QUEUE_COUNT            (BLE_HIDS_MAX_INPUT_REP + 2)    /**< Input Report, Boot Keyboard and Boot Mouse Input Report queues. */
+
 /**@brief HID Service characteristic id. */
 typedef struct
 {
@@ -123,6 +145,33 @@ typedef struct
     ble_srv_security_mode_t       security_mode;    /**< Security mode for the HID Information characteristic. */
 } ble_hids_hid_information_t;
 
+/**@brief Input Report merge handler type.
+ *
+ * @details Called when a report is sent while reports of the same characteristic and length are
+ *          queued.
+ *
+ * @param[inout] p_queued  Last queued report, to be updated with the merged report.
+ * @param[in]    p_rep     Report being sent.
+ * @param[in]    len       Length of both reports.
+ *
+ * @retval true   If the report was merged into the queued report.
+ * @retval false  If the report must be queued separately.
+ */
+typedef bool (*ble_hids_rep_merge_t)(uint8_t * p_queued, uint8_t const * p_rep, uint16_t len);
+
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+/**@brief Queue of an Input Report characteristic. */
+typedef struct
+{
+    uint8_t                       rep[BLE_HIDS_INP_REP_QUEUE_SIZE][BLE_HIDS_INP_REP_QUEUE_MAX_LEN]; /**< Queued reports. */
+    uint8_t                       rep_len[BLE_HIDS_INP_REP_QUEUE_SIZE];                             /**< Lengths of the queued reports. */
+    uint8_t                       read_idx;         /**< Index of the oldest queued report. */
+    uint8_t                       count;            /**< Number of queued reports. */
+    uint16_t                      value_handle;     /**< Handle of the characteristic value. */
+    ble_hids_rep_merge_t          merge_handler;    /**< Merge handler, or NULL to queue every report. */
+} ble_hids_rep_queue_t;
+#endif
+
 /**@brief HID Service Input Report characteristic init structure. This contains all options and 
  *        data needed for initialization of one Input Report characteristic. */
 typedef struct
@@ -131,6 +180,9 @@ typedef struct
     ble_srv_report_ref_t          rep_ref;          /**< Value of the Report Reference descriptor. */
     ble_srv_cccd_security_mode_t  security_mode;    /**< Security mode for the HID Input Report characteristic, including cccd. */
     uint8_t                       read_resp : 1;    /**< Should application generate a response to read requests. */
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+    ble_hids_rep_merge_t          merge_handler;    /**< Merge handler of queued reports, or NULL to queue every report. */
+#endif
 } ble_hids_inp_rep_init_t;
 
 /**@brief HID Service Output Report characteristic init structure. This contains all options and 
@@ -217,6 +269,9 @@ struct ble_hids_s
     ble_gatts_char_handles_t      hid_information_handles;                      /**< Handles related to the Report Map characteristic. */
     ble_gatts_char_handles_t      hid_control_point_handles;                    /**< Handles related to the Report Map characteristic. */
     uint16_t                      conn_handle;                                  /**< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection). */
+#if BLE_HIDS_INP_REP_QUEUE_ENABLED
+    ble_hids_rep_queue_t          inp_rep_queues[BLE_HIDS_INP_REP_QUEUE_COUNT]; /**< Queues of the Input Report characteristics, then of the Boot Keyboard and Boot Mouse Input Reports. */
+#endif
 };
 
 /**@brief Function for initializing the HID Service.
@@ -249,7 +304,8 @@ void ble_hids_on_ble_evt(ble_hids_t * p_hids, ble_evt_t * p_ble_evt);
  * @param[in]   len          Length of data to be sent.
  * @param[in]   p_data       Pointer to data to be sent.
  *
- * @return      NRF_SUCCESS on successful sending of input report, otherwise an error code.
+ * @return      NRF_SUCCESS on successful sending or queuing of input report, otherwise an error
+ *              code. NRF_ERROR_NO_MEM if the report could not be queued because the queue is full.
  */
 uint32_t ble_hids_inp_rep_send(ble_hids_t * p_hids, 
                                uint8_t      rep_index, 
@@ -264,7 +320,7 @@ uint32_t ble_hids_inp_rep_send(ble_hids_t * p_hids,
  * @param[in]   len          Length of data to be sent.
  * @param[in]   p_data       Pointer to data to be sent.
  *
- * @return      NRF_SUCCESS on successful sending of the report, otherwise an error code.
+ * @return      NRF_SUCCESS on successful sending or queuing of the report, otherwise an error code.
  */
 uint32_t ble_hids_boot_kb_inp_rep_send(ble_hids_t * p_hids, 
                                        uint16_t     len, 
@@ -272,7 +328,8 @@ uint32_t ble_hids_boot_kb_inp_rep_send(ble_hids_t * p_hids,
 
 /**@brief Function for sending Boot Mouse Input Report.
  *
- * @details Sends data on an Boot Mouse Input Report characteristic.
+ * @details Sends data on an Boot Mouse Input Report characteristic. When the report is queued,
+ *          its movement is merged by @ref ble_hids_boot_mouse_rep_merge.
  *
  * @param[in]   p_hids              HID Service structure.
  * @param[in]   buttons             State of mouse buttons.
@@ -281,7 +338,7 @@ uint32_t ble_hids_boot_kb_inp_rep_send(ble_hids_t * p_hids,
  * @param[in]   optional_data_len   Length of optional part of Boot Mouse Input Report.
  * @param[in]   p_optional_data     Optional part of Boot Mouse Input Report.
  *
- * @return      NRF_SUCCESS on successful sending of the report, otherwise an error code.
+ * @return      NRF_SUCCESS on successful sending or queuing of the report, otherwise an error code.
  */
 uint32_t ble_hids_boot_mouse_inp_rep_send(ble_hids_t * p_hids, 
                                           uint8_t      buttons, 
@@ -290,6 +347,14 @@ uint32_t ble_hids_boot_mouse_inp_rep_send(ble_hids_t * p_hids,
                                           uint16_t     optional_data_len,
                                           uint8_t *    p_optional_data);
 
+/**@brief Merge handler for reports with the Boot Mouse Input Report layout.
+ *
+ * @details The reports are merged if their buttons (first byte) and optional data are the same.
+ *          The X and Y movements (signed second and third bytes) are added, unless the sum
+ *          overflows. Can be used as merge handler of Input Reports with the same layout.
+ */
+bool ble_hids_boot_mouse_rep_merge(uint8_t * p_queued, uint8_t const * p_rep, uint16_t len);
+
 /**@brief Function for getting the current value of Output Report from the stack.
  *
  * @details Fetches the current value of the output report characteristic from the stack.
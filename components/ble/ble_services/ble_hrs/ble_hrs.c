@@ -128,15 +128,39 @@ void ble_hrs_on_ble_evt(ble_hrs_t * p_hrs, ble_evt_t * p_ble_evt)
 }
 
 
+/**@brief Function for removing sent RR Interval measurements from the start of the buffer.
+ *
+ * @param[in]   p_hrs   Heart Rate Service structure.
+ * @param[in]   count   Number of measurements to remove.
+ */
+static void rr_interval_consume(ble_hrs_t * p_hrs, uint16_t count)
+{
+    if (count < p_hrs->rr_interval_count)
+    {
+        memmove(&p_hrs->rr_interval[0],
+                &p_hrs->rr_interval[count],
+                (p_hrs->rr_interval_count - count) * sizeof(uint16_t));
+    }
+    p_hrs->rr_interval_count -= count;
+}
+
+
 /**@brief Function for encoding a Heart Rate Measurement.
+ *
+ * @details The encoded RR Interval measurements are left in the buffer, see
+ *          @ref rr_interval_consume.
  *
  * @param[in]   p_hrs              Heart Rate Service structure.
  * @param[in]   heart_rate         Measurement to be encoded.
  * @param[out]  p_encoded_buffer   Buffer where the encoded data will be written.
+ * @param[out]  p_rr_count         Number of RR Interval measurements encoded.
  *
  * @return      Size of encoded data.
  */
-static uint8_t hrm_encode(ble_hrs_t * p_hrs, uint16_t heart_rate, uint8_t * p_encoded_buffer)
+static uint8_t hrm_encode(ble_hrs_t * p_hrs,
+                          uint16_t    heart_rate,
+                          uint8_t   * p_encoded_buffer,
+                          uint16_t  * p_rr_count)
 {
     uint8_t flags = 0;
     uint8_t len   = 1;
@@ -172,16 +196,12 @@ static uint8_t hrm_encode(ble_hrs_t * p_hrs, uint16_t heart_rate, uint8_t * p_en
     {
         if (len + sizeof(uint16_t) > MAX_HRM_LEN)
         {
-            // Not all stored rr_interval values can fit into the encoded hrm,
-            // move the remaining values to the start of the buffer.
-            memmove(&p_hrs->rr_interval[0],
-                    &p_hrs->rr_interval[i],
-                    (p_hrs->rr_interval_count - i) * sizeof(uint16_t));
+            // Not all stored rr_interval values can fit into the encoded hrm.
             break;
         }
         len += uint16_encode(p_hrs->rr_interval[i], &p_encoded_buffer[len]);
     }
-    p_hrs->rr_interval_count -= i;
+    *p_rr_count = (uint16_t)i;
 
     // Add flags
     p_encoded_buffer[0] = flags;
@@ -206,6 +226,7 @@ static uint32_t heart_rate_measurement_char_add(ble_hrs_t            * p_hrs,
     ble_uuid_t          ble_uuid;
     ble_gatts_attr_md_t attr_md;
     uint8_t             encoded_initial_hrm[MAX_HRM_LEN];
+    uint16_t            rr_count;
 
     memset(&cccd_md, 0, sizeof(cccd_md));
 
@@ -237,7 +258,10 @@ static uint32_t heart_rate_measurement_char_add(ble_hrs_t            * p_hrs,
 
     attr_char_value.p_uuid    = &ble_uuid;
     attr_char_value.p_attr_md = &attr_md;
-    attr_char_value.init_len  = hrm_encode(p_hrs, INITIAL_VALUE_HRM, encoded_initial_hrm);
+    attr_char_value.init_len  = hrm_encode(p_hrs,
+                                           INITIAL_VALUE_HRM,
+                                           encoded_initial_hrm,
+                                           &rr_count);
     attr_char_value.init_offs = 0;
     attr_char_value.max_len   = MAX_HRM_LEN;
     attr_char_value.p_value   = encoded_initial_hrm;
@@ -306,10 +330,12 @@ uint32_t ble_hrs_init(ble_hrs_t * p_hrs, const ble_hrs_init_t * p_hrs_init)
 
     // Initialize service structure
     p_hrs->evt_handler                 = p_hrs_init->evt_handler;
-    p_hrs->is_sensor_contact_supported = p_hrs_init->is_sensor_contact_supported;
-    p_hrs->conn_handle                 = BLE_CONN_HANDLE_INVALID;
-    p_hrs->is_sensor_contact_detected  = false;
-    p_hrs->rr_interval_count           = 0;
+    p_hrs->is_sensor_contact_supported  = p_hrs_init->is_sensor_contact_supported;
+    p_hrs->is_rr_interval_split_enabled = p_hrs_init->is_rr_interval_split_enabled;
+    p_hrs->conn_handle                  = BLE_CONN_HANDLE_INVALID;
+    p_hrs->is_sensor_contact_detected   = false;
+    p_hrs->rr_interval_count            = 0;
+    p_hrs->rr_interval_dropped_count    = 0;
 
     // Add service
     BLE_UUID_BLE_ASSIGN(ble_uuid, BLE_UUID_HEART_RATE_SERVICE);
@@ -354,24 +380,37 @@ uint32_t ble_hrs_heart_rate_measurement_send(ble_hrs_t * p_hrs, uint16_t heart_r
         uint8_t                encoded_hrm[MAX_HRM_LEN];
         uint16_t               len;
         uint16_t               hvx_len;
+        uint16_t               rr_count;
         ble_gatts_hvx_params_t hvx_params;
 
-        len     = hrm_encode(p_hrs, heart_rate, encoded_hrm);
-        hvx_len = len;
+        do
+        {
+            len     = hrm_encode(p_hrs, heart_rate, encoded_hrm, &rr_count);
+            hvx_len = len;
 
-        memset(&hvx_params, 0, sizeof(hvx_params));
+            memset(&hvx_params, 0, sizeof(hvx_params));
 
-        hvx_params.handle = p_hrs->hrm_handles.value_handle;
-        hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
-        hvx_params.offset = 0;
-        hvx_params.p_len  = &hvx_len;
-        hvx_params.p_data = encoded_hrm;
+            hvx_params.handle = p_hrs->hrm_handles.value_handle;
+            hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+            hvx_params.offset = 0;
+            hvx_params.p_len  = &hvx_len;
+            hvx_params.p_data = encoded_hrm;
 
-        err_code = sd_ble_gatts_hvx(p_hrs->conn_handle, &hvx_params);
-        if ((err_code == NRF_SUCCESS) && (hvx_len != len))
-        {
-            err_code = NRF_ERROR_DATA_SIZE;
-        }
+            err_code = sd_ble_gatts_hvx(p_hrs->conn_handle, &hvx_params);
+
+            // When splitting, keep the RR Interval values until they have been queued.
+            if ((err_code == NRF_SUCCESS) || !p_hrs->is_rr_interval_split_enabled)
+            {
+                rr_interval_consume(p_hrs, rr_count);
+            }
+
+            if ((err_code == NRF_SUCCESS) && (hvx_len != len))
+            {
+                err_code = NRF_ERROR_DATA_SIZE;
+            }
+        } while (   p_hrs->is_rr_interval_split_enabled
+                 && (err_code == NRF_SUCCESS)
+                 && (p_hrs->rr_interval_count > 0));
     }
     else
     {
@@ -387,10 +426,8 @@ void ble_hrs_rr_interval_add(ble_hrs_t * p_hrs, uint16_t rr_interval)
     if (p_hrs->rr_interval_count == BLE_HRS_MAX_BUFFERED_RR_INTERVALS)
     {
         // The rr_interval buffer is full, delete the oldest value
-        memmove(&p_hrs->rr_interval[0],
-                &p_hrs->rr_interval[1],
-                (BLE_HRS_MAX_BUFFERED_RR_INTERVALS - 1) * sizeof(uint16_t));
-        p_hrs->rr_interval_count--;
+        rr_interval_consume(p_hrs, 1);
+        p_hrs->rr_interval_dropped_count++;
     }
 
     // Add new value
@@ -58,7 +58,9 @@
 #define BLE_HRS_BODY_SENSOR_LOCATION_EAR_LOBE   5
 #define BLE_HRS_BODY_SENSOR_LOCATION_FOOT       6
 
+#ifndef BLE_HRS_MAX_BUFFERED_RR_INTERVALS
 #define BLE_HRS_MAX_BUFFERED_RR_INTERVALS       20      /**< Size of RR Interval buffer inside service. */
+#endif
 
 /**@brief Heart Rate Service event type. */
 typedef enum
@@ -85,6 +87,7 @@ typedef struct
 {
     ble_hrs_evt_handler_t        evt_handler;                                          /**< Event handler to be called for handling events in the Heart Rate Service. */
     bool                         is_sensor_contact_supported;                          /**< Determines if sensor contact detection is to be supported. */
+    bool                         is_rr_interval_split_enabled;                         /**< If TRUE, a Heart Rate Measurement is split over as many notifications as needed to send all buffered RR Interval measurements. */
     uint8_t *                    p_body_sensor_location;                               /**< If not NULL, initial value of the Body Sensor Location characteristic. */
     ble_srv_cccd_security_mode_t hrs_hrm_attr_md;                                      /**< Initial security level for heart rate service measurement attribute */
     ble_srv_security_mode_t      hrs_bsl_attr_md;                                      /**< Initial security level for body sensor location attribute */
@@ -96,6 +99,7 @@ struct ble_hrs_s
     ble_hrs_evt_handler_t        evt_handler;                                          /**< Event handler to be called for handling events in the Heart Rate Service. */
     bool                         is_expended_energy_supported;                         /**< TRUE if Expended Energy measurement is supported. */
     bool                         is_sensor_contact_supported;                          /**< TRUE if sensor contact detection is supported. */
+    bool                         is_rr_interval_split_enabled;                         /**< TRUE if a Heart Rate Measurement is split over several notifications to send all buffered RR Interval measurements. */
     uint16_t                     service_handle;                                       /**< Handle of Heart Rate Service (as provided by the BLE stack). */
     ble_gatts_char_handles_t     hrm_handles;                                          /**< Handles related to the Heart Rate Measurement characteristic. */
     ble_gatts_char_handles_t     bsl_handles;                                          /**< Handles related to the Body Sensor Location characteristic. */
@@ -104,6 +108,7 @@ struct ble_hrs_s
     bool                         is_sensor_contact_detected;                           /**< TRUE if sensor contact has been detected. */
     uint16_t                     rr_interval[BLE_HRS_MAX_BUFFERED_RR_INTERVALS];       /**< Set of RR Interval measurements since the last Heart Rate Measurement transmission. */
     uint16_t                     rr_interval_count;                                    /**< Number of RR Interval measurements since the last Heart Rate Measurement transmission. */
+    uint32_t                     rr_interval_dropped_count;                            /**< Number of RR Interval measurements deleted from a full buffer before they could be sent. */
 };
 
 /**@brief Function for initializing the Heart Rate Service.
@@ -132,6 +137,12 @@ void ble_hrs_on_ble_evt(ble_hrs_t * p_hrs, ble_evt_t * p_ble_evt);
  *          If notification has been enabled, the heart rate measurement data is encoded and sent to
  *          the client.
  *
+ *          If RR Interval splitting is enabled, the measurement is repeated in further
+ *          notifications until all buffered RR Interval measurements are sent, or until the
+ *          SoftDevice runs out of transmit buffers. RR Interval measurements are only removed from
+ *          the buffer once the notification carrying them has been queued, so a
+ *          @ref BLE_ERROR_NO_TX_PACKETS return leaves the remaining values for the next call.
+ *
  * @param[in]   p_hrs                    Heart Rate Service structure.
  * @param[in]   heart_rate               New heart rate measurement.
  *
@@ -143,7 +154,8 @@ uint32_t ble_hrs_heart_rate_measurement_send(ble_hrs_t * p_hrs, uint16_t heart_r
  *
  * @details All buffered RR Interval measurements will be included in the next heart rate
  *          measurement message, up to the maximum number of measurements that will fit into the
- *          message. If the buffer is full, the oldest measurement in the buffer will be deleted.
+ *          message. If the buffer is full, the oldest measurement in the buffer will be deleted
+ *          and counted in rr_interval_dropped_count.
  *
  * @param[in]   p_hrs        Heart Rate Service structure.
  * @param[in]   rr_interval  New RR Interval measurement (will be buffered until the next
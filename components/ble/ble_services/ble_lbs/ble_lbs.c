@@ -73,144 +73,58 @@ void ble_lbs_on_ble_evt(ble_lbs_t * p_lbs, ble_evt_t * p_ble_evt)
 }
 
 
-/**@brief Function for adding the LED Characteristic.
- *
- * @param[in] p_lbs      LED Button Service structure.
- * @param[in] p_lbs_init LED Button Service initialization structure.
- *
- * @retval NRF_SUCCESS on success, else an error value from the SoftDevice
- */
-static uint32_t led_char_add(ble_lbs_t * p_lbs, const ble_lbs_init_t * p_lbs_init)
-{
-    ble_gatts_char_md_t char_md;
-    ble_gatts_attr_t    attr_char_value;
-    ble_uuid_t          ble_uuid;
-    ble_gatts_attr_md_t attr_md;
-
-    memset(&char_md, 0, sizeof(char_md));
-
-    char_md.char_props.read   = 1;
-    char_md.char_props.write  = 1;
-    char_md.p_char_user_desc  = NULL;
-    char_md.p_char_pf         = NULL;
-    char_md.p_user_desc_md    = NULL;
-    char_md.p_cccd_md         = NULL;
-    char_md.p_sccd_md         = NULL;
-
-    ble_uuid.type = p_lbs->uuid_type;
-    ble_uuid.uuid = LBS_UUID_LED_CHAR;
-    
-    memset(&attr_md, 0, sizeof(attr_md));
-
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.read_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.write_perm);
-    attr_md.vloc       = BLE_GATTS_VLOC_STACK;
-    attr_md.rd_auth    = 0;
-    attr_md.wr_auth    = 0;
-    attr_md.vlen       = 0;
-    
-    memset(&attr_char_value, 0, sizeof(attr_char_value));
-
-    attr_char_value.p_uuid       = &ble_uuid;
-    attr_char_value.p_attr_md    = &attr_md;
-    attr_char_value.init_len     = sizeof(uint8_t);
-    attr_char_value.init_offs    = 0;
-    attr_char_value.max_len      = sizeof(uint8_t);
-    attr_char_value.p_value      = NULL;
-
-    return sd_ble_gatts_characteristic_add(p_lbs->service_handle,
-                                           &char_md,
-                                           &attr_char_value,
-                                           &p_lbs->led_char_handles);
-}
-
-
-/**@brief Function for adding the Button Characteristic.
- *
- * @param[in] p_lbs      LED Button Service structure.
- * @param[in] p_lbs_init LED Button Service initialization structure.
- *
- * @retval NRF_SUCCESS on success, else an error value from the SoftDevice
- */
-static uint32_t button_char_add(ble_lbs_t * p_lbs, const ble_lbs_init_t * p_lbs_init)
+/**@brief GATT table of the LED Button Service. */
+static const ble_srv_table_entry_t m_lbs_table[] =
 {
-    ble_gatts_char_md_t char_md;
-    ble_gatts_attr_md_t cccd_md;
-    ble_gatts_attr_t    attr_char_value;
-    ble_uuid_t          ble_uuid;
-    ble_gatts_attr_md_t attr_md;
-
-    memset(&cccd_md, 0, sizeof(cccd_md));
+    {
+        .type              = BLE_SRV_TABLE_SERVICE,
+        .uuid_type         = 1,
+        .uuid              = LBS_UUID_SERVICE,
+        .handle_offset     = offsetof(ble_lbs_t, service_handle),
+    },
+    {
+        .type              = BLE_SRV_TABLE_CHAR,
+        .uuid_type         = 1,
+        .uuid              = LBS_UUID_BUTTON_CHAR,
+        .handle_offset     = offsetof(ble_lbs_t, button_char_handles),
+        .char_props        = {.read = 1, .notify = 1},
+        .read_access       = SEC_OPEN,
+        .write_access      = SEC_NO_ACCESS,
+        .cccd_write_access = SEC_OPEN,
+        .max_len           = sizeof(uint8_t),
+        .init_len          = sizeof(uint8_t),
+    },
+    {
+        .type              = BLE_SRV_TABLE_CHAR,
+        .uuid_type         = 1,
+        .uuid              = LBS_UUID_LED_CHAR,
+        .handle_offset     = offsetof(ble_lbs_t, led_char_handles),
+        .char_props        = {.read = 1, .write = 1},
+        .read_access       = SEC_OPEN,
+        .write_access      = SEC_OPEN,
+        .max_len           = sizeof(uint8_t),
+        .init_len          = sizeof(uint8_t),
+    },
+};
 
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.read_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.write_perm);
-    cccd_md.vloc = BLE_GATTS_VLOC_STACK;
-    
-    memset(&char_md, 0, sizeof(char_md));
-    
-    char_md.char_props.read   = 1;
-    char_md.char_props.notify = 1;
-    char_md.p_char_user_desc  = NULL;
-    char_md.p_char_pf         = NULL;
-    char_md.p_user_desc_md    = NULL;
-    char_md.p_cccd_md         = &cccd_md;
-    char_md.p_sccd_md         = NULL;
-
-    ble_uuid.type = p_lbs->uuid_type;
-    ble_uuid.uuid = LBS_UUID_BUTTON_CHAR;
-
-    memset(&attr_md, 0, sizeof(attr_md));
-
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.read_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_NO_ACCESS(&attr_md.write_perm);
-    attr_md.vloc       = BLE_GATTS_VLOC_STACK;
-    attr_md.rd_auth    = 0;
-    attr_md.wr_auth    = 0;
-    attr_md.vlen       = 0;
-
-    memset(&attr_char_value, 0, sizeof(attr_char_value));
-
-    attr_char_value.p_uuid       = &ble_uuid;
-    attr_char_value.p_attr_md    = &attr_md;
-    attr_char_value.init_len     = sizeof(uint8_t);
-    attr_char_value.init_offs    = 0;
-    attr_char_value.max_len      = sizeof(uint8_t);
-    attr_char_value.p_value      = NULL;
-
-    return sd_ble_gatts_characteristic_add(p_lbs->service_handle,
-                                               &char_md,
-                                               &attr_char_value,
-                                               &p_lbs->button_char_handles);
-}
 
 uint32_t ble_lbs_init(ble_lbs_t * p_lbs, const ble_lbs_init_t * p_lbs_init)
 {
-    uint32_t   err_code;
-    ble_uuid_t ble_uuid;
+    uint32_t err_code;
 
     // Initialize service structure.
     p_lbs->conn_handle       = BLE_CONN_HANDLE_INVALID;
     p_lbs->led_write_handler = p_lbs_init->led_write_handler;
 
-    // Add service.
     ble_uuid128_t base_uuid = {LBS_UUID_BASE};
     err_code = sd_ble_uuid_vs_add(&base_uuid, &p_lbs->uuid_type);
     VERIFY_SUCCESS(err_code);
 
-    ble_uuid.type = p_lbs->uuid_type;
-    ble_uuid.uuid = LBS_UUID_SERVICE;
-
-    err_code = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY, &ble_uuid, &p_lbs->service_handle);
-    VERIFY_SUCCESS(err_code);
-
-    // Add characteristics.
-    err_code = button_char_add(p_lbs, p_lbs_init);
-    VERIFY_SUCCESS(err_code);
-
-    err_code = led_char_add(p_lbs, p_lbs_init);
-    VERIFY_SUCCESS(err_code);
-
-    return NRF_SUCCESS;
+    // Add service and characteristics.
+    return ble_srv_table_add(m_lbs_table,
+                             sizeof(m_lbs_table) / sizeof(m_lbs_table[0]),
+                             &p_lbs->uuid_type,
+                             p_lbs);
 }
 
 uint32_t ble_lbs_on_button_change(ble_lbs_t * p_lbs, uint8_t button_state)
@@ -13,6 +13,9 @@
 #include "ble_nus.h"
 #include "ble_srv_common.h"
 #include "sdk_common.h"
+#if BLE_NUS_STREAM_ENABLED
+#include "app_util_platform.h"
+#endif
 
 #define BLE_UUID_NUS_TX_CHARACTERISTIC 0x0002                      /**< The UUID of the TX Characteristic. */
 #define BLE_UUID_NUS_RX_CHARACTERISTIC 0x0003                      /**< The UUID of the RX Characteristic. */
@@ -22,6 +25,153 @@
 
 #define NUS_BASE_UUID                  {{0x9E, 0xCA, 0xDC, 0x24, 0x0E, 0xE5, 0xA9, 0xE0, 0x93, 0xF3, 0xA3, 0xB5, 0x00, 0x00, 0x40, 0x6E}} /**< Used vendor specific UUID. */
 
+#if BLE_NUS_STREAM_ENABLED
+/**@brief Function for queuing stream notifications in the SoftDevice until it runs out of TX
+ *        buffers or there is no more data.
+ *
+ * @param[in] p_nus     Nordic UART Service structure.
+ */
+static void stream_notifications_queue(ble_nus_t * p_nus)
+{
+    ble_gatts_hvx_params_t hvx_params;
+    uint32_t               err_code;
+    uint16_t               length;
+
+    if ((p_nus->conn_handle == BLE_CONN_HANDLE_INVALID) || (!p_nus->is_notification_enabled))
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        if ((p_nus->stream_packet_len == 0) && p_nus->stream_framed)
+        {
+            uint32_t fifo_length = 0;
+            uint8_t  frame_length;
+
+            // The length is written before the frame, so wait until the whole frame is there.
+            if ((app_fifo_peek(&p_nus->stream_fifo, 0, &frame_length) != NRF_SUCCESS) ||
+                (app_fifo_read(&p_nus->stream_fifo, NULL, &fifo_length) != NRF_SUCCESS) ||
+                (fifo_length < 1 + (uint32_t)frame_length))
+            {
+                return;
+            }
+
+            fifo_length = frame_length;
+            (void)app_fifo_get(&p_nus->stream_fifo, &frame_length);
+            (void)app_fifo_read(&p_nus->stream_fifo, p_nus->stream_packet, &fifo_length);
+            p_nus->stream_packet_len = frame_length;
+        }
+        else if (p_nus->stream_packet_len == 0)
+        {
+            uint32_t fifo_length = BLE_NUS_MAX_DATA_LEN;
+
+            if (app_fifo_read(&p_nus->stream_fifo, NULL, &fifo_length) != NRF_SUCCESS)
+            {
+                return;
+            }
+            // Wait for more data to fill a whole notification while the link is busy anyway.
+            if ((fifo_length < BLE_NUS_MAX_DATA_LEN) && (p_nus->stream_tx_pending != 0))
+            {
+                return;
+            }
+
+            fifo_length = BLE_NUS_MAX_DATA_LEN;
+            (void)app_fifo_read(&p_nus->stream_fifo, p_nus->stream_packet, &fifo_length);
+            p_nus->stream_packet_len = (uint16_t)fifo_length;
+        }
+
+        length = p_nus->stream_packet_len;
+
+        memset(&hvx_params, 0, sizeof(hvx_params));
+
+        hvx_params.handle = p_nus->rx_handles.value_handle;
+        hvx_params.p_data = p_nus->stream_packet;
+        hvx_params.p_len  = &length;
+        hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+
+        err_code = sd_ble_gatts_hvx(p_nus->conn_handle, &hvx_params);
+        if (err_code != NRF_SUCCESS)
+        {
+            // The notification is kept and sent again on the next TX complete event.
+            if (err_code == BLE_ERROR_NO_TX_PACKETS)
+            {
+                p_nus->stream_stats.stall_count++;
+            }
+            return;
+        }
+
+        p_nus->stream_stats.bytes_sent += p_nus->stream_packet_len;
+        p_nus->stream_packet_len        = 0;
+
+        CRITICAL_REGION_ENTER();
+        p_nus->stream_tx_pending++;
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+/**@brief Function for sending the streamed data.
+ *
+ * @details The function can be called both from the application and from the BLE event handler.
+ *          If it is called while the notifications are being queued in another context, the
+ *          queuing is repeated by that context instead.
+ *
+ * @param[in] p_nus     Nordic UART Service structure.
+ */
+static void stream_send(ble_nus_t * p_nus)
+{
+    bool owner;
+
+    CRITICAL_REGION_ENTER();
+    p_nus->stream_kick = true;
+    owner = !p_nus->stream_busy;
+    p_nus->stream_busy = true;
+    CRITICAL_REGION_EXIT();
+
+    while (owner)
+    {
+        p_nus->stream_kick = false;
+
+        stream_notifications_queue(p_nus);
+
+        CRITICAL_REGION_ENTER();
+        if (!p_nus->stream_kick)
+        {
+            p_nus->stream_busy = false;
+            owner              = false;
+        }
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+/**@brief Function for handling the @ref BLE_EVT_TX_COMPLETE event from the SoftDevice.
+ *
+ * @param[in] p_nus     Nordic UART Service structure.
+ * @param[in] p_ble_evt Pointer to the event received from BLE stack.
+ */
+static void on_tx_complete(ble_nus_t * p_nus, ble_evt_t * p_ble_evt)
+{
+    if ((p_nus->stream_fifo.p_buf == NULL) ||
+        (p_ble_evt->evt.common_evt.conn_handle != p_nus->conn_handle))
+    {
+        return;
+    }
+
+    // The count includes packets not sent by this service, so it is only an upper bound.
+    uint8_t count = p_ble_evt->evt.common_evt.params.tx_complete.count;
+
+    CRITICAL_REGION_ENTER();
+    p_nus->stream_tx_pending = (p_nus->stream_tx_pending > count) ?
+                               (p_nus->stream_tx_pending - count) : 0;
+    CRITICAL_REGION_EXIT();
+
+    stream_send(p_nus);
+}
+#endif // BLE_NUS_STREAM_ENABLED
+
+
 /**@brief Function for handling the @ref BLE_GAP_EVT_CONNECTED event from the S110 SoftDevice.
  *
  * @param[in] p_nus     Nordic UART Service structure.
@@ -42,6 +192,15 @@ static void on_disconnect(ble_nus_t * p_nus, ble_evt_t * p_ble_evt)
 {
     UNUSED_PARAMETER(p_ble_evt);
     p_nus->conn_handle = BLE_CONN_HANDLE_INVALID;
+
+#if BLE_NUS_STREAM_ENABLED
+    if (p_nus->stream_fifo.p_buf != NULL)
+    {
+        (void)app_fifo_flush(&p_nus->stream_fifo);
+        p_nus->stream_packet_len = 0;
+        p_nus->stream_tx_pending = 0;
+    }
+#endif
 }
 
 
@@ -63,6 +222,14 @@ static void on_write(ble_nus_t * p_nus, ble_evt_t * p_ble_evt)
         if (ble_srv_is_notification_enabled(p_evt_write->data))
         {
             p_nus->is_notification_enabled = true;
+
+#if BLE_NUS_STREAM_ENABLED
+            // Send the data that was buffered before notifications were enabled.
+            if (p_nus->stream_fifo.p_buf != NULL)
+            {
+                stream_send(p_nus);
+            }
+#endif
         }
         else
         {
@@ -218,6 +385,12 @@ void ble_nus_on_ble_evt(ble_nus_t * p_nus, ble_evt_t * p_ble_evt)
             on_write(p_nus, p_ble_evt);
             break;
 
+#if BLE_NUS_STREAM_ENABLED
+        case BLE_EVT_TX_COMPLETE:
+            on_tx_complete(p_nus, p_ble_evt);
+            break;
+#endif
+
         default:
             // No implementation needed.
             break;
@@ -239,6 +412,25 @@ uint32_t ble_nus_init(ble_nus_t * p_nus, const ble_nus_init_t * p_nus_init)
     p_nus->data_handler            = p_nus_init->data_handler;
     p_nus->is_notification_enabled = false;
 
+#if BLE_NUS_STREAM_ENABLED
+    memset(&p_nus->stream_fifo, 0, sizeof(p_nus->stream_fifo));
+    memset(&p_nus->stream_stats, 0, sizeof(p_nus->stream_stats));
+    p_nus->stream_packet_len = 0;
+    p_nus->stream_tx_pending = 0;
+    p_nus->stream_busy       = false;
+    p_nus->stream_kick       = false;
+
+    p_nus->stream_framed     = p_nus_init->stream_framed;
+
+    if (p_nus_init->p_stream_buffer != NULL)
+    {
+        err_code = app_fifo_init(&p_nus->stream_fifo,
+                                 p_nus_init->p_stream_buffer,
+                                 p_nus_init->stream_buffer_size);
+        VERIFY_SUCCESS(err_code);
+    }
+#endif
+
     /**@snippet [Adding proprietary Service to S110 SoftDevice] */
     // Add a custom base UUID.
     err_code = sd_ble_uuid_vs_add(&nus_base_uuid, &p_nus->uuid_type);
@@ -293,3 +485,66 @@ uint32_t ble_nus_string_send(ble_nus_t * p_nus, uint8_t * p_string, uint16_t len
 }
 
 
+
+
+#if BLE_NUS_STREAM_ENABLED
+uint32_t ble_nus_stream_write(ble_nus_t * p_nus, uint8_t const * p_data, uint32_t * p_length)
+{
+    uint32_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_nus);
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_length);
+
+    if ((p_nus->stream_fifo.p_buf == NULL) || p_nus->stream_framed)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    err_code = app_fifo_write(&p_nus->stream_fifo, p_data, p_length);
+    VERIFY_SUCCESS(err_code);
+
+    stream_send(p_nus);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_nus_stream_frame_write(ble_nus_t * p_nus, uint8_t const * p_frame, uint16_t length)
+{
+    uint32_t free_length  = 0;
+    uint32_t frame_length = length;
+    uint8_t  header       = (uint8_t)length;
+
+    VERIFY_PARAM_NOT_NULL(p_nus);
+    VERIFY_PARAM_NOT_NULL(p_frame);
+
+    if ((p_nus->stream_fifo.p_buf == NULL) || !p_nus->stream_framed)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if ((length == 0) || (length > BLE_NUS_MAX_DATA_LEN))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    (void)app_fifo_write(&p_nus->stream_fifo, NULL, &free_length);
+    if (free_length < 1 + frame_length)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    (void)app_fifo_put(&p_nus->stream_fifo, header);
+    (void)app_fifo_write(&p_nus->stream_fifo, p_frame, &frame_length);
+
+    stream_send(p_nus);
+
+    return NRF_SUCCESS;
+}
+
+
+void ble_nus_stream_stats_get(ble_nus_t const * p_nus, ble_nus_stream_stats_t * p_stats)
+{
+    *p_stats = p_nus->stream_stats;
+}
+#endif // BLE_NUS_STREAM_ENABLED
@@ -40,6 +40,21 @@
 #define BLE_UUID_NUS_SERVICE 0x0001                      /**< The UUID of the Nordic UART Service. */
 #define BLE_NUS_MAX_DATA_LEN (GATT_MTU_SIZE_DEFAULT - 3) /**< Maximum length of data (in bytes) that can be transmitted to the peer by the Nordic UART service module. */
 
+#ifndef BLE_NUS_STREAM_ENABLED
+#define BLE_NUS_STREAM_ENABLED 0                         /**< Enable the streaming API (@ref ble_nus_stream_write). Requires the FIFO library. */
+#endif
+
+#if BLE_NUS_STREAM_ENABLED
+#include "app_fifo.h"
+
+/**@brief Nordic UART Service streaming statistics. */
+typedef struct
+{
+    uint32_t bytes_sent;  /**< Number of bytes queued in the SoftDevice for transmission. */
+    uint32_t stall_count; /**< Number of times a notification could not be queued because the SoftDevice had no free TX buffers. */
+} ble_nus_stream_stats_t;
+#endif
+
 /* Forward declaration of the ble_nus_t type. */
 typedef struct ble_nus_s ble_nus_t;
 
@@ -55,6 +70,11 @@ typedef void (*ble_nus_data_handler_t) (ble_nus_t * p_nus, uint8_t * p_data, uin
 typedef struct
 {
     ble_nus_data_handler_t data_handler; /**< Event handler to be called for handling received data. */
+#if BLE_NUS_STREAM_ENABLED
+    uint8_t *              p_stream_buffer;    /**< Buffer for data to be streamed, or NULL if streaming is not used. */
+    uint16_t               stream_buffer_size; /**< Size of the stream buffer. Must be a power of two. */
+    bool                   stream_framed;      /**< Send the stream as frames written with @ref ble_nus_stream_frame_write, one frame in each notification, instead of a byte stream. */
+#endif
 } ble_nus_init_t;
 
 /**@brief Nordic UART Service structure.
@@ -70,6 +90,16 @@ struct ble_nus_s
     uint16_t                 conn_handle;             /**< Handle of the current connection (as provided by the SoftDevice). BLE_CONN_HANDLE_INVALID if not in a connection. */
     bool                     is_notification_enabled; /**< Variable to indicate if the peer has enabled notification of the RX characteristic.*/
     ble_nus_data_handler_t   data_handler;            /**< Event handler to be called for handling received data. */
+#if BLE_NUS_STREAM_ENABLED
+    app_fifo_t               stream_fifo;                         /**< Data waiting to be streamed. */
+    uint8_t                  stream_packet[BLE_NUS_MAX_DATA_LEN]; /**< Data of the notification that is being queued in the SoftDevice. */
+    uint16_t                 stream_packet_len;                   /**< Length of the notification that is being queued, 0 if none. */
+    volatile uint8_t         stream_tx_pending;                   /**< Number of notifications queued in the SoftDevice and not yet transmitted. */
+    volatile bool            stream_busy;                         /**< Notifications are being queued. */
+    volatile bool            stream_kick;                         /**< Queuing was requested again while it was in progress. */
+    bool                     stream_framed;                       /**< The stream buffer holds frames, each preceded by its length. */
+    ble_nus_stream_stats_t   stream_stats;                        /**< Streaming statistics. */
+#endif
 };
 
 /**@brief Function for initializing the Nordic UART Service.
@@ -109,6 +139,54 @@ void ble_nus_on_ble_evt(ble_nus_t * p_nus, ble_evt_t * p_ble_evt);
  */
 uint32_t ble_nus_string_send(ble_nus_t * p_nus, uint8_t * p_string, uint16_t length);
 
+#if BLE_NUS_STREAM_ENABLED
+/**@brief Function for adding data to the stream sent to the peer.
+ *
+ * @details The data is buffered and sent in notifications of the maximum length. As many
+ *          notifications as the SoftDevice accepts are queued at once, and the queue is refilled
+ *          on @ref BLE_EVT_TX_COMPLETE, so the application does not have to retry. A notification
+ *          shorter than the maximum length is only sent when no other notification is pending.
+ *          The buffered data is discarded on disconnection.
+ *
+ * @param[in]    p_nus    Pointer to the Nordic UART Service structure.
+ * @param[in]    p_data   Data to be sent.
+ * @param[inout] p_length Number of bytes to be sent. When the function returns, contains the number
+ *                        of bytes that were buffered.
+ *
+ * @retval NRF_SUCCESS             If the data was buffered, possibly only partially.
+ * @retval NRF_ERROR_INVALID_STATE If no stream buffer was provided during initialization, or if
+ *                                 the stream is framed.
+ * @retval NRF_ERROR_NO_MEM        If the stream buffer is full.
+ */
+uint32_t ble_nus_stream_write(ble_nus_t * p_nus, uint8_t const * p_data, uint32_t * p_length);
+
+/**@brief Function for adding a frame to a framed stream.
+ *
+ * @details The frame is sent in a notification of its own, so the peer receives the frame
+ *          boundaries. The frames are sent in order, as many at once as the SoftDevice accepts.
+ *          The function can be used as the frame handler of the sensor stream codec
+ *          (@ref app_sensor_codec) through a wrapper that passes the service structure.
+ *
+ * @param[in] p_nus    Pointer to the Nordic UART Service structure.
+ * @param[in] p_frame  Frame to be sent.
+ * @param[in] length   Length of the frame, at most @ref BLE_NUS_MAX_DATA_LEN.
+ *
+ * @retval NRF_SUCCESS              If the frame was buffered.
+ * @retval NRF_ERROR_INVALID_STATE  If the stream is not framed.
+ * @retval NRF_ERROR_INVALID_LENGTH If the frame is empty or too long.
+ * @retval NRF_ERROR_NO_MEM         If there is no space for the whole frame in the stream
+ *                                  buffer. Nothing is buffered.
+ */
+uint32_t ble_nus_stream_frame_write(ble_nus_t * p_nus, uint8_t const * p_frame, uint16_t length);
+
+/**@brief Function for getting the streaming statistics.
+ *
+ * @param[in]  p_nus   Pointer to the Nordic UART Service structure.
+ * @param[out] p_stats Streaming statistics.
+ */
+void ble_nus_stream_stats_get(ble_nus_t const * p_nus, ble_nus_stream_stats_t * p_stats);
+#endif
+
 #endif // BLE_NUS_H__
 
 /** @} */
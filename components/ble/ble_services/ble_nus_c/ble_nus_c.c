@@ -6,6 +6,131 @@
 #include "ble_srv_common.h"
 #include "app_error.h"
 #include "sdk_common.h"
+#if BLE_NUS_C_STREAM_ENABLED
+#include "app_util_platform.h"
+#endif
+
+
+#if BLE_NUS_C_STREAM_ENABLED
+/**@brief Function for queuing stream writes in the SoftDevice until it runs out of TX buffers or
+ *        there is no more data.
+ */
+static void stream_writes_queue(ble_nus_c_t * p_ble_nus_c)
+{
+    ble_gattc_write_params_t write_params;
+    uint32_t                 err_code;
+
+    if ( (p_ble_nus_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+       ||(p_ble_nus_c->handles.nus_tx_handle == BLE_GATT_HANDLE_INVALID)
+       )
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        if (p_ble_nus_c->stream_packet_len == 0)
+        {
+            uint32_t fifo_length = BLE_NUS_MAX_DATA_LEN;
+
+            if (app_fifo_read(&p_ble_nus_c->stream_fifo, NULL, &fifo_length) != NRF_SUCCESS)
+            {
+                return;
+            }
+            // Wait for more data to fill a whole packet while the link is busy anyway.
+            if ((fifo_length < BLE_NUS_MAX_DATA_LEN) && (p_ble_nus_c->stream_tx_pending != 0))
+            {
+                return;
+            }
+
+            fifo_length = BLE_NUS_MAX_DATA_LEN;
+            (void)app_fifo_read(&p_ble_nus_c->stream_fifo, p_ble_nus_c->stream_packet, &fifo_length);
+            p_ble_nus_c->stream_packet_len = (uint16_t)fifo_length;
+        }
+
+        memset(&write_params, 0, sizeof(write_params));
+
+        write_params.write_op = BLE_GATT_OP_WRITE_CMD;
+        write_params.flags    = BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE;
+        write_params.handle   = p_ble_nus_c->handles.nus_tx_handle;
+        write_params.offset   = 0;
+        write_params.len      = p_ble_nus_c->stream_packet_len;
+        write_params.p_value  = p_ble_nus_c->stream_packet;
+
+        err_code = sd_ble_gattc_write(p_ble_nus_c->conn_handle, &write_params);
+        if (err_code != NRF_SUCCESS)
+        {
+            // The packet is kept and sent again on the next TX complete event.
+            if (err_code == BLE_ERROR_NO_TX_PACKETS)
+            {
+                p_ble_nus_c->stream_stats.stall_count++;
+            }
+            return;
+        }
+
+        p_ble_nus_c->stream_stats.bytes_sent += p_ble_nus_c->stream_packet_len;
+        p_ble_nus_c->stream_packet_len        = 0;
+
+        CRITICAL_REGION_ENTER();
+        p_ble_nus_c->stream_tx_pending++;
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+/**@brief Function for sending the streamed data.
+ *
+ * @details The function can be called both from the application and from the BLE event handler.
+ *          If it is called while the writes are being queued in another context, the queuing is
+ *          repeated by that context instead.
+ */
+static void stream_send(ble_nus_c_t * p_ble_nus_c)
+{
+    bool owner;
+
+    if (p_ble_nus_c->stream_fifo.p_buf == NULL)
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    p_ble_nus_c->stream_kick = true;
+    owner = !p_ble_nus_c->stream_busy;
+    p_ble_nus_c->stream_busy = true;
+    CRITICAL_REGION_EXIT();
+
+    while (owner)
+    {
+        p_ble_nus_c->stream_kick = false;
+
+        stream_writes_queue(p_ble_nus_c);
+
+        CRITICAL_REGION_ENTER();
+        if (!p_ble_nus_c->stream_kick)
+        {
+            p_ble_nus_c->stream_busy = false;
+            owner                    = false;
+        }
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+/**@brief Function for handling the TX complete event from the SoftDevice.
+ */
+static void on_tx_complete(ble_nus_c_t * p_ble_nus_c, const ble_evt_t * p_ble_evt)
+{
+    // The count includes packets not sent by this module, so it is only an upper bound.
+    uint8_t count = p_ble_evt->evt.common_evt.params.tx_complete.count;
+
+    CRITICAL_REGION_ENTER();
+    p_ble_nus_c->stream_tx_pending = (p_ble_nus_c->stream_tx_pending > count) ?
+                                     (p_ble_nus_c->stream_tx_pending - count) : 0;
+    CRITICAL_REGION_EXIT();
+
+    stream_send(p_ble_nus_c);
+}
+#endif // BLE_NUS_C_STREAM_ENABLED
 
 
 void ble_nus_c_on_db_disc_evt(ble_nus_c_t * p_ble_nus_c, ble_db_discovery_evt_t * p_evt)
@@ -69,6 +194,25 @@ static void on_hvx(ble_nus_c_t * p_ble_nus_c, const ble_evt_t * p_ble_evt)
     {
         ble_nus_c_evt_t ble_nus_c_evt;
 
+#if BLE_NUS_C_CODEC_ENABLED
+        if (p_ble_nus_c->p_decoder != NULL)
+        {
+            // Frames that cannot be decoded are counted in the decoder statistics.
+            if (app_sensor_codec_decode(p_ble_nus_c->p_decoder,
+                                        p_ble_evt->evt.gattc_evt.params.hvx.data,
+                                        p_ble_evt->evt.gattc_evt.params.hvx.len,
+                                        &ble_nus_c_evt.p_samples,
+                                        &ble_nus_c_evt.sample_set_count) == NRF_SUCCESS)
+            {
+                ble_nus_c_evt.evt_type    = BLE_NUS_C_EVT_NUS_SAMPLES;
+                ble_nus_c_evt.conn_handle = p_ble_nus_c->conn_handle;
+
+                p_ble_nus_c->evt_handler(p_ble_nus_c, &ble_nus_c_evt);
+            }
+            return;
+        }
+#endif
+
         ble_nus_c_evt.evt_type = BLE_NUS_C_EVT_NUS_RX_EVT;
         ble_nus_c_evt.p_data   = (uint8_t *)p_ble_evt->evt.gattc_evt.params.hvx.data;
         ble_nus_c_evt.data_len = p_ble_evt->evt.gattc_evt.params.hvx.len;
@@ -96,6 +240,27 @@ uint32_t ble_nus_c_init(ble_nus_c_t * p_ble_nus_c, ble_nus_c_init_t * p_ble_nus_
     p_ble_nus_c->evt_handler           = p_ble_nus_c_init->evt_handler;
     p_ble_nus_c->handles.nus_rx_handle = BLE_GATT_HANDLE_INVALID;
     p_ble_nus_c->handles.nus_tx_handle = BLE_GATT_HANDLE_INVALID;
+
+#if BLE_NUS_C_CODEC_ENABLED
+    p_ble_nus_c->p_decoder = p_ble_nus_c_init->p_decoder;
+#endif
+
+#if BLE_NUS_C_STREAM_ENABLED
+    memset(&p_ble_nus_c->stream_fifo, 0, sizeof(p_ble_nus_c->stream_fifo));
+    memset(&p_ble_nus_c->stream_stats, 0, sizeof(p_ble_nus_c->stream_stats));
+    p_ble_nus_c->stream_packet_len = 0;
+    p_ble_nus_c->stream_tx_pending = 0;
+    p_ble_nus_c->stream_busy       = false;
+    p_ble_nus_c->stream_kick       = false;
+
+    if (p_ble_nus_c_init->p_stream_buffer != NULL)
+    {
+        err_code = app_fifo_init(&p_ble_nus_c->stream_fifo,
+                                 p_ble_nus_c_init->p_stream_buffer,
+                                 p_ble_nus_c_init->stream_buffer_size);
+        VERIFY_SUCCESS(err_code);
+    }
+#endif
     
     return ble_db_discovery_evt_register(&uart_uuid);
 }
@@ -119,8 +284,36 @@ void ble_nus_c_on_ble_evt(ble_nus_c_t * p_ble_nus_c, const ble_evt_t * p_ble_evt
         case BLE_GATTC_EVT_HVX:
             on_hvx(p_ble_nus_c, p_ble_evt);
             break;
+
+#if BLE_NUS_C_STREAM_ENABLED
+        case BLE_EVT_TX_COMPLETE:
+            if (p_ble_evt->evt.common_evt.conn_handle == p_ble_nus_c->conn_handle)
+            {
+                on_tx_complete(p_ble_nus_c, p_ble_evt);
+            }
+            break;
+#endif
                 
         case BLE_GAP_EVT_DISCONNECTED:
+#if BLE_NUS_C_STREAM_ENABLED
+            if ( (p_ble_evt->evt.gap_evt.conn_handle == p_ble_nus_c->conn_handle)
+               &&(p_ble_nus_c->stream_fifo.p_buf != NULL)
+               )
+            {
+                (void)app_fifo_flush(&p_ble_nus_c->stream_fifo);
+                p_ble_nus_c->stream_packet_len = 0;
+                p_ble_nus_c->stream_tx_pending = 0;
+            }
+#endif
+#if BLE_NUS_C_CODEC_ENABLED
+            // The peer starts the stream again with a key frame.
+            if ( (p_ble_evt->evt.gap_evt.conn_handle == p_ble_nus_c->conn_handle)
+               &&(p_ble_nus_c->p_decoder != NULL)
+               )
+            {
+                app_sensor_codec_decoder_reset(p_ble_nus_c->p_decoder);
+            }
+#endif
             if (p_ble_evt->evt.gap_evt.conn_handle == p_ble_nus_c->conn_handle
                     && p_ble_nus_c->evt_handler != NULL)
             {
@@ -208,5 +401,40 @@ uint32_t ble_nus_c_handles_assign(ble_nus_c_t * p_ble_nus,
         p_ble_nus->handles.nus_rx_handle      = p_peer_handles->nus_rx_handle;
         p_ble_nus->handles.nus_tx_handle      = p_peer_handles->nus_tx_handle;    
     }
+
+#if BLE_NUS_C_STREAM_ENABLED
+    // Send the data that was buffered before the link was associated.
+    stream_send(p_ble_nus);
+#endif
     return NRF_SUCCESS;
 }
+
+
+#if BLE_NUS_C_STREAM_ENABLED
+uint32_t ble_nus_c_stream_write(ble_nus_c_t * p_ble_nus_c, uint8_t const * p_data, uint32_t * p_length)
+{
+    uint32_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_ble_nus_c);
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_length);
+
+    if (p_ble_nus_c->stream_fifo.p_buf == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    err_code = app_fifo_write(&p_ble_nus_c->stream_fifo, p_data, p_length);
+    VERIFY_SUCCESS(err_code);
+
+    stream_send(p_ble_nus_c);
+
+    return NRF_SUCCESS;
+}
+
+
+void ble_nus_c_stream_stats_get(ble_nus_c_t const * p_ble_nus_c, ble_nus_c_stream_stats_t * p_stats)
+{
+    *p_stats = p_ble_nus_c->stream_stats;
+}
+#endif // BLE_NUS_C_STREAM_ENABLED
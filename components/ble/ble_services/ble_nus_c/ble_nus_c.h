@@ -40,13 +40,37 @@
 
 #define BLE_NUS_MAX_DATA_LEN           (GATT_MTU_SIZE_DEFAULT - 3) /**< Maximum length of data (in bytes) that can be transmitted to the peer by the Nordic UART service module. */
 
+#ifndef BLE_NUS_C_STREAM_ENABLED
+#define BLE_NUS_C_STREAM_ENABLED       0                           /**< Enable the streaming API (@ref ble_nus_c_stream_write). Requires the FIFO library. */
+#endif
+
+#ifndef BLE_NUS_C_CODEC_ENABLED
+#define BLE_NUS_C_CODEC_ENABLED        0                           /**< Enable decoding of the notifications with the sensor stream codec (@ref app_sensor_codec). */
+#endif
+
+#if BLE_NUS_C_CODEC_ENABLED
+#include "app_sensor_codec.h"
+#endif
+
+#if BLE_NUS_C_STREAM_ENABLED
+#include "app_fifo.h"
+
+/**@brief NUS Client streaming statistics. */
+typedef struct
+{
+    uint32_t bytes_sent;  /**< Number of bytes queued in the SoftDevice for transmission. */
+    uint32_t stall_count; /**< Number of times a write could not be queued because the SoftDevice had no free TX buffers. */
+} ble_nus_c_stream_stats_t;
+#endif
+
 
 /**@brief NUS Client event type. */
 typedef enum 
 {
     BLE_NUS_C_EVT_DISCOVERY_COMPLETE = 1, /**< Event indicating that the NUS service and its characteristics was found. */
     BLE_NUS_C_EVT_NUS_RX_EVT,             /**< Event indicating that the central has received something from a peer. */
-    BLE_NUS_C_EVT_DISCONNECTED            /**< Event indicating that the NUS server has disconnected. */
+    BLE_NUS_C_EVT_DISCONNECTED,           /**< Event indicating that the NUS server has disconnected. */
+    BLE_NUS_C_EVT_NUS_SAMPLES             /**< Event indicating that samples were decoded from a notification. Only generated if a decoder is set, see @ref BLE_NUS_C_CODEC_ENABLED. */
 } ble_nus_c_evt_type_t;
 
 
@@ -66,6 +90,10 @@ typedef struct {
     uint8_t            * p_data;
     uint8_t              data_len;
     ble_nus_c_handles_t  handles;     /**< Handles on which the Nordic Uart service characteristics was discovered on the peer device. This will be filled if the evt_type is @ref BLE_NUS_C_EVT_DISCOVERY_COMPLETE.*/
+#if BLE_NUS_C_CODEC_ENABLED
+    int16_t const *      p_samples;        /**< Decoded sample sets, channel by channel, if the evt_type is @ref BLE_NUS_C_EVT_NUS_SAMPLES. Valid until the event handler returns. */
+    uint16_t             sample_set_count; /**< Number of decoded sample sets. */
+#endif
 } ble_nus_c_evt_t;
 
 
@@ -88,12 +116,31 @@ struct ble_nus_c_s
     uint16_t                conn_handle;        /**< Handle of the current connection. Set with @ref ble_nus_c_handles_assign when connected. */
     ble_nus_c_handles_t     handles;            /**< Handles on the connected peer device needed to interact with it. */
     ble_nus_c_evt_handler_t evt_handler;        /**< Application event handler to be called when there is an event related to the NUS. */
+#if BLE_NUS_C_CODEC_ENABLED
+    app_sensor_codec_decoder_t * p_decoder;     /**< Decoder of the notifications, or NULL. */
+#endif
+#if BLE_NUS_C_STREAM_ENABLED
+    app_fifo_t               stream_fifo;                         /**< Data waiting to be streamed. */
+    uint8_t                  stream_packet[BLE_NUS_MAX_DATA_LEN]; /**< Data of the write that is being queued in the SoftDevice. */
+    uint16_t                 stream_packet_len;                   /**< Length of the write that is being queued, 0 if none. */
+    volatile uint8_t         stream_tx_pending;                   /**< Number of writes queued in the SoftDevice and not yet transmitted. */
+    volatile bool            stream_busy;                         /**< Writes are being queued. */
+    volatile bool            stream_kick;                         /**< Queuing was requested again while it was in progress. */
+    ble_nus_c_stream_stats_t stream_stats;                        /**< Streaming statistics. */
+#endif
 };
 
 /**@brief NUS Client initialization structure.
  */
 typedef struct {
     ble_nus_c_evt_handler_t evt_handler;
+#if BLE_NUS_C_CODEC_ENABLED
+    app_sensor_codec_decoder_t * p_decoder;     /**< Initialized decoder for frames sent with @ref ble_nus_stream_frame_write, or NULL to pass the notifications to the application as data. */
+#endif
+#if BLE_NUS_C_STREAM_ENABLED
+    uint8_t *               p_stream_buffer;    /**< Buffer for data to be streamed, or NULL if streaming is not used. */
+    uint16_t                stream_buffer_size; /**< Size of the stream buffer. Must be a power of two. */
+#endif
 } ble_nus_c_init_t;
 
 
@@ -166,6 +213,34 @@ uint32_t ble_nus_c_rx_notif_enable(ble_nus_c_t * p_ble_nus_c);
  */
 uint32_t ble_nus_c_string_send(ble_nus_c_t * p_ble_nus_c, uint8_t * p_string, uint16_t length);
 
+#if BLE_NUS_C_STREAM_ENABLED
+/**@brief Function for adding data to the stream sent to the server.
+ *
+ * @details The data is buffered and sent in writes without response of the maximum length. As
+ *          many writes as the SoftDevice accepts are queued at once, and the queue is refilled on
+ *          @ref BLE_EVT_TX_COMPLETE. A write shorter than the maximum length is only sent when no
+ *          other write is pending. Sending starts when the handles are assigned with
+ *          @ref ble_nus_c_handles_assign, and the buffered data is discarded on disconnection.
+ *
+ * @param[in]    p_ble_nus_c Pointer to the NUS client structure.
+ * @param[in]    p_data      Data to be sent.
+ * @param[inout] p_length    Number of bytes to be sent. When the function returns, contains the
+ *                           number of bytes that were buffered.
+ *
+ * @retval NRF_SUCCESS             If the data was buffered, possibly only partially.
+ * @retval NRF_ERROR_INVALID_STATE If no stream buffer was provided during initialization.
+ * @retval NRF_ERROR_NO_MEM        If the stream buffer is full.
+ */
+uint32_t ble_nus_c_stream_write(ble_nus_c_t * p_ble_nus_c, uint8_t const * p_data, uint32_t * p_length);
+
+/**@brief Function for getting the streaming statistics.
+ *
+ * @param[in]  p_ble_nus_c Pointer to the NUS client structure.
+ * @param[out] p_stats     Streaming statistics.
+ */
+void ble_nus_c_stream_stats_get(ble_nus_c_t const * p_ble_nus_c, ble_nus_c_stream_stats_t * p_stats);
+#endif
+
 
 /**@brief Function for assigning handles to a this instance of nus_c.
  *
@@ -43,6 +43,7 @@
 #define LOC_SPEED_FLAG_SPEED_AND_DIST_FORMAT             (0x01 << 9)         /**< Speed and Distance Format. */
 #define LOC_SPEED_FLAG_ELEVATION_SOURCE                  (0x03 << 10)        /**< Elevation Source bits(2). */
 #define LOC_SPEED_FLAG_HEADING_SOURCE                    (0x01 << 12)        /**< Heading Source. */
+#define LOC_SPEED_FLAGS_LEN                              2                   /**< Length of the Location and Speed flags field. */
 
 // Position Quality flag bits
 #define POS_QUAL_FLAG_NUM_SATS_IN_SOLUTION_PRESENT       (0x01 << 0)         /**< Number of Satellites in Solution Present bit. */
@@ -67,30 +68,160 @@
 #define BLE_LNS_NAV_MAX_LEN                             19 /**< The length of a navigation notification when all features are enabled. See @ref ble_lns_navigation_t to see what this represents, or check https://developer.bluetooth.org/gatt/characteristics/Pages/CharacteristicViewer.aspx?u=org.bluetooth.characteristic.navigation.xml. */
 
 
-static void notification_buffer_process(ble_lns_t * p_lns)
+/**@brief Get the next notification waiting to be sent.
+ *
+ * @param[in]   p_lns       Location and Navigation Service structure.
+ *
+ * @return      Pending notification, or NULL if no notification is pending.
+ */
+static notification_t * notification_next_get(ble_lns_t * p_lns)
 {
-    notification_t * p_notification;
-
-    // See if a notification is pending
     if (p_lns->pending_loc_speed_notifications[0].is_pending == true)
     {
-        p_notification = &p_lns->pending_loc_speed_notifications[0];
+        return &p_lns->pending_loc_speed_notifications[0];
     }
     else if (p_lns->pending_loc_speed_notifications[1].is_pending == true)
     {
-        p_notification = &p_lns->pending_loc_speed_notifications[1];
+        return &p_lns->pending_loc_speed_notifications[1];
     }
     else if (p_lns->pending_navigation_notification.is_pending == true)
     {
-        p_notification = &p_lns->pending_navigation_notification;
+        return &p_lns->pending_navigation_notification;
     }
-    else
+    return NULL;
+}
+
+
+/**@brief Record the Location and Speed fields of a sent notification as known by the client.
+ *
+ * @details The fields included in the notification are read back from its flags field.
+ *
+ * @param[in]   p_lns           Location and Navigation Service structure.
+ * @param[in]   p_notification  Notification which was sent.
+ */
+static void loc_speed_sent_update(ble_lns_t * p_lns, notification_t const * p_notification)
+{
+    ble_lns_loc_speed_t const * p_new  = &p_lns->loc_speed_pending;
+    ble_lns_loc_speed_t       * p_sent = &p_lns->loc_speed_sent;
+    uint16_t                    flags;
+
+    if (   (p_notification != &p_lns->pending_loc_speed_notifications[0])
+        && (p_notification != &p_lns->pending_loc_speed_notifications[1]))
     {
-        p_notification = NULL;
+        return;
     }
 
-    // send the notification if necessary
-    if (p_notification != NULL)
+    flags = uint16_decode(&p_notification->data[0]);
+
+    if (flags & LOC_SPEED_FLAG_INSTANT_SPEED_PRESENT)
+    {
+        p_sent->instant_speed                      = p_new->instant_speed;
+        p_sent->data_format                        = p_new->data_format;
+        p_lns->loc_speed_sent_fields.instantaneous_speed = 1;
+    }
+    if (flags & LOC_SPEED_FLAG_TOTAL_DISTANCE_PRESENT)
+    {
+        p_sent->total_distance                     = p_new->total_distance;
+        p_lns->loc_speed_sent_fields.total_distance = 1;
+    }
+    if (flags & LOC_SPEED_FLAG_LOCATION_PRESENT)
+    {
+        p_sent->latitude                           = p_new->latitude;
+        p_sent->longitude                          = p_new->longitude;
+        p_sent->position_status                    = p_new->position_status;
+        p_lns->loc_speed_sent_fields.location      = 1;
+    }
+    if (flags & LOC_SPEED_FLAG_ELEVATION_PRESENT)
+    {
+        p_sent->elevation                          = p_new->elevation;
+        p_sent->elevation_source                   = p_new->elevation_source;
+        p_lns->loc_speed_sent_fields.elevation     = 1;
+    }
+    if (flags & LOC_SPEED_FLAG_HEADING_PRESENT)
+    {
+        p_sent->heading                            = p_new->heading;
+        p_sent->heading_source                     = p_new->heading_source;
+        p_lns->loc_speed_sent_fields.heading       = 1;
+    }
+    if (flags & LOC_SPEED_FLAG_ROLLING_TIME_PRESENT)
+    {
+        p_sent->rolling_time                       = p_new->rolling_time;
+        p_lns->loc_speed_sent_fields.rolling_time  = 1;
+    }
+    if (flags & LOC_SPEED_FLAG_UTC_TIME_PRESENT)
+    {
+        p_sent->utc_time                           = p_new->utc_time;
+        p_lns->loc_speed_sent_fields.utc_time      = 1;
+    }
+}
+
+
+/**@brief Get the Location and Speed fields which hold the same value as last sent to the client.
+ *
+ * @param[in]   p_lns       Location and Navigation Service structure.
+ * @param[in]   p_new       Location and Speed data to be sent.
+ *
+ * @return      Mask of the unchanged fields.
+ */
+static ble_lncp_mask_t loc_speed_unchanged_fields_get(ble_lns_t           const * p_lns,
+                                                      ble_lns_loc_speed_t const * p_new)
+{
+    ble_lns_loc_speed_t const * p_sent = &p_lns->loc_speed_sent;
+    ble_lncp_mask_t     const   sent   = p_lns->loc_speed_sent_fields;
+    ble_lncp_mask_t             unchanged;
+
+    unchanged.flags = 0;
+
+    unchanged.instantaneous_speed = sent.instantaneous_speed
+                                    && (p_new->instant_speed == p_sent->instant_speed)
+                                    && (p_new->data_format   == p_sent->data_format);
+    unchanged.total_distance      = sent.total_distance
+                                    && (p_new->total_distance == p_sent->total_distance);
+    unchanged.location            = sent.location
+                                    && (p_new->latitude        == p_sent->latitude)
+                                    && (p_new->longitude       == p_sent->longitude)
+                                    && (p_new->position_status == p_sent->position_status);
+    unchanged.elevation           = sent.elevation
+                                    && (p_new->elevation        == p_sent->elevation)
+                                    && (p_new->elevation_source == p_sent->elevation_source);
+    unchanged.heading             = sent.heading
+                                    && (p_new->heading        == p_sent->heading)
+                                    && (p_new->heading_source == p_sent->heading_source);
+    unchanged.rolling_time        = sent.rolling_time
+                                    && (p_new->rolling_time == p_sent->rolling_time);
+    unchanged.utc_time            = sent.utc_time
+                                    && (p_new->utc_time.year    == p_sent->utc_time.year)
+                                    && (p_new->utc_time.month   == p_sent->utc_time.month)
+                                    && (p_new->utc_time.day     == p_sent->utc_time.day)
+                                    && (p_new->utc_time.hours   == p_sent->utc_time.hours)
+                                    && (p_new->utc_time.minutes == p_sent->utc_time.minutes)
+                                    && (p_new->utc_time.seconds == p_sent->utc_time.seconds);
+
+    return unchanged;
+}
+
+
+/**@brief Reset the notification scheduler, for example when a client (re)enables notifications.
+ *
+ * @param[in]   p_lns       Location and Navigation Service structure.
+ */
+static void notification_scheduler_reset(ble_lns_t * p_lns)
+{
+    p_lns->loc_speed_sent_fields.flags = 0;
+    p_lns->loc_speed_rate_divider      = 1;
+    p_lns->loc_speed_update_count      = 0;
+}
+
+
+/**@brief Send pending notifications until none are left or the SoftDevice runs out of buffers.
+ *
+ * @param[in]   p_lns       Location and Navigation Service structure.
+ */
+static void notification_buffer_process(ble_lns_t * p_lns)
+{
+    notification_t * p_notification = notification_next_get(p_lns);
+
+    while (p_notification != NULL)
     {
         uint32_t               err_code;
         ble_gatts_hvx_params_t hvx_params;
@@ -107,10 +238,16 @@ static void notification_buffer_process(ble_lns_t * p_lns)
 
         err_code = sd_ble_gatts_hvx(p_lns->conn_handle, &hvx_params);
 
-        if ((err_code == NRF_SUCCESS) && (hvx_len == p_notification->len))
+        if ((err_code != NRF_SUCCESS) || (hvx_len != p_notification->len))
         {
-            p_notification->is_pending = false;
+            // Retry on the next TX_COMPLETE event.
+            return;
         }
+
+        p_notification->is_pending = false;
+        loc_speed_sent_update(p_lns, p_notification);
+
+        p_notification = notification_next_get(p_lns);
     }
 }
 
@@ -128,6 +265,8 @@ static void on_connect(ble_lns_t * p_lns, ble_evt_t const * p_ble_evt)
     p_lns->pending_loc_speed_notifications[0].is_pending    = false;
     p_lns->pending_loc_speed_notifications[1].is_pending    = false;
     p_lns->pending_navigation_notification.is_pending       = false;
+
+    notification_scheduler_reset(p_lns);
 }
 
 
@@ -187,6 +326,7 @@ static void on_loc_speed_cccd_write(ble_lns_t                   * p_lns,
     {
         // CCCD written, update notification state
         p_lns->is_loc_speed_notification_enabled = ble_srv_is_notification_enabled(p_evt_write->data);
+        notification_scheduler_reset(p_lns);
         if (p_lns->evt_handler != NULL)
         {
             ble_lns_evt_t evt;
@@ -349,6 +489,7 @@ static uint8_t pos_qual_encode(ble_lns_t             const * p_lns,
  *
  * @param[in]   p_lns              Location and Navigation Service structure.
  * @param[in]   p_loc_speed        Location and Speed data to be encoded.
+ * @param[in]   mask               Fields which are not to be encoded.
  * @param[out]  p_encoded_buffer   Pointer to buffer buffer where encoded data will be written.
  *
  * @return      Size of encoded data.
@@ -356,13 +497,12 @@ static uint8_t pos_qual_encode(ble_lns_t             const * p_lns,
  */
 static uint8_t loc_speed_encode_packet1(ble_lns_t           const * p_lns,
                                         ble_lns_loc_speed_t const * p_loc_speed,
+                                        ble_lncp_mask_t             mask,
                                         uint8_t                   * p_encoded_buffer)
 {
     uint16_t flags = 0;
     uint8_t  len   = 2;
 
-    const ble_lncp_mask_t mask = ble_lncp_mask_get(&p_lns->ctrl_pt);
-
     // Instantaneous Speed
     if (p_lns->available_features & BLE_LNS_FEATURE_INSTANT_SPEED_SUPPORTED)
     {
@@ -408,6 +548,7 @@ static uint8_t loc_speed_encode_packet1(ble_lns_t           const * p_lns,
  *
  * @param[in]   p_lns              Location and Navigation Service structure.
  * @param[in]   p_loc_speed        Location and Speed data to be encoded.
+ * @param[in]   mask               Fields which are not to be encoded.
  * @param[out]  p_encoded_buffer   Pointer to buffer buffer where encoded data will be written.
  *
  * @return      Size of encoded data.
@@ -415,13 +556,12 @@ static uint8_t loc_speed_encode_packet1(ble_lns_t           const * p_lns,
  */
 static uint8_t loc_speed_encode_packet2(ble_lns_t           const * p_lns,
                                         ble_lns_loc_speed_t const * p_loc_speed,
+                                        ble_lncp_mask_t             mask,
                                         uint8_t                   * p_encoded_buffer)
 {
     uint16_t flags = 0;
     uint8_t  len   = 2;
 
-    const ble_lncp_mask_t mask = ble_lncp_mask_get(&p_lns->ctrl_pt);
-
     flags = 0;
     len = 2;
 
@@ -586,7 +726,10 @@ static ret_code_t loc_speed_char_add(ble_lns_t * p_lns, ble_lns_init_t const * p
     uint8_t               len;
     ble_add_char_params_t add_char_params;
 
-    len = loc_speed_encode_packet1(p_lns, p_lns_init->p_location_speed, &encoded_initial_loc_speed1[0]);
+    len = loc_speed_encode_packet1(p_lns,
+                                   p_lns_init->p_location_speed,
+                                   ble_lncp_mask_get(&p_lns->ctrl_pt),
+                                   &encoded_initial_loc_speed1[0]);
 
     memset(&add_char_params, 0, sizeof(add_char_params));
 
@@ -809,6 +952,11 @@ ret_code_t ble_lns_init(ble_lns_t * p_lns, ble_lns_init_t const * p_lns_init)
     p_lns->is_loc_speed_notification_enabled             = false;
     p_lns->is_nav_notification_enabled                   = false;
 
+    p_lns->is_changed_fields_only                        = p_lns_init->is_changed_fields_only;
+    p_lns->notif_coalesced_count                         = 0;
+    p_lns->notif_dropped_count                           = 0;
+    notification_scheduler_reset(p_lns);
+
     ble_ln_db_init();
 
     // Add service
@@ -898,23 +1046,54 @@ ret_code_t ble_lns_loc_speed_send(ble_lns_t * p_lns)
 
     notification_t * notif1 = &p_lns->pending_loc_speed_notifications[0];
     notification_t * notif2 = &p_lns->pending_loc_speed_notifications[1];
+    ble_lncp_mask_t  mask;
+
+    // Skip updates while the rate is lowered.
+    if (++p_lns->loc_speed_update_count < p_lns->loc_speed_rate_divider)
+    {
+        p_lns->notif_dropped_count++;
+        return NRF_SUCCESS;
+    }
+    p_lns->loc_speed_update_count = 0;
+
+    if (notif1->is_pending || notif2->is_pending)
+    {
+        // The previous update is still waiting for a TX buffer. Replace it, and lower the rate.
+        p_lns->notif_coalesced_count++;
+        if (p_lns->loc_speed_rate_divider < BLE_LNS_MAX_RATE_DIVIDER)
+        {
+            p_lns->loc_speed_rate_divider *= 2;
+        }
+    }
+    else if (p_lns->loc_speed_rate_divider > 1)
+    {
+        p_lns->loc_speed_rate_divider--;
+    }
 
     // clear previous unsent data. Previous data is invalid.
     notif1->is_pending = false;
     notif2->is_pending = false;
 
+    // Keep the data being sent, including the values owned by the control point.
+    p_lns->loc_speed_pending                = *p_lns->p_location_speed;
+    p_lns->loc_speed_pending.total_distance = ble_lncp_total_distance_get(&p_lns->ctrl_pt);
+    p_lns->loc_speed_pending.elevation      = ble_lncp_elevation_get(&p_lns->ctrl_pt);
+
+    mask = ble_lncp_mask_get(&p_lns->ctrl_pt);
+    if (p_lns->is_changed_fields_only)
+    {
+        mask.flags |= loc_speed_unchanged_fields_get(p_lns, &p_lns->loc_speed_pending).flags;
+    }
+
     // check if it is necessary to send packet 1
     if (p_lns->available_features & (BLE_LNS_FEATURE_INSTANT_SPEED_SUPPORTED
                                     | BLE_LNS_FEATURE_TOTAL_DISTANCE_SUPPORTED
                                     | BLE_LNS_FEATURE_LOCATION_SUPPORTED))
     {
         // encode
-        notif1->len        = loc_speed_encode_packet1(p_lns, p_lns->p_location_speed, &notif1->data[0]);
+        notif1->len        = loc_speed_encode_packet1(p_lns, &p_lns->loc_speed_pending, mask, &notif1->data[0]);
         notif1->handle     = p_lns->loc_speed_handles.value_handle;
-        notif1->is_pending = true;
-
-        // send
-        notification_buffer_process(p_lns);
+        notif1->is_pending = !p_lns->is_changed_fields_only || (notif1->len > LOC_SPEED_FLAGS_LEN);
     }
 
     // check if it is necessary to send packet 2
@@ -923,14 +1102,14 @@ ret_code_t ble_lns_loc_speed_send(ble_lns_t * p_lns)
                                     | BLE_LNS_FEATURE_ROLLING_TIME_SUPPORTED
                                     | BLE_LNS_FEATURE_UTC_TIME_SUPPORTED))
     {
-        notif2->len        = loc_speed_encode_packet2(p_lns, p_lns->p_location_speed, &notif2->data[0]);
+        notif2->len        = loc_speed_encode_packet2(p_lns, &p_lns->loc_speed_pending, mask, &notif2->data[0]);
         notif2->handle     = p_lns->loc_speed_handles.value_handle;
-        notif2->is_pending = true;
-
-        // send
-        notification_buffer_process(p_lns);
+        notif2->is_pending = !p_lns->is_changed_fields_only || (notif2->len > LOC_SPEED_FLAGS_LEN);
     }
 
+    // send
+    notification_buffer_process(p_lns);
+
     return NRF_SUCCESS;
 }
 
@@ -947,7 +1126,11 @@ ret_code_t ble_lns_navigation_send(ble_lns_t * p_lns)
     notification_t * notif = &p_lns->pending_navigation_notification;
 
     // clear previous unsent data. Previous data is invalid.
-    notif->is_pending = false;
+    if (notif->is_pending)
+    {
+        p_lns->notif_coalesced_count++;
+        notif->is_pending = false;
+    }
 
     if (!p_lns->is_navigation_present)
     {
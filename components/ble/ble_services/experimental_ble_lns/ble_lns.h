@@ -36,6 +36,10 @@
 #include "ble_ln_cp.h"
 #include "sdk_common.h"
 
+#ifndef BLE_LNS_MAX_RATE_DIVIDER
+#define BLE_LNS_MAX_RATE_DIVIDER 8                                       /**< Largest factor by which the Location and Speed update rate is lowered when notifications cannot be sent. */
+#endif
+
 /** @brief Location and Navigation event type. This list defines the possible events types from the Location and Navigation Service. */
 typedef enum {
     BLE_LNS_CTRLPT_EVT_INDICATION_ENABLED,         /**< Control Point value indication was enabled. */
@@ -94,6 +98,7 @@ struct ble_lns_init_s
     ble_lns_loc_speed_t         * p_location_speed;                      /**< Initial Location and Speed. */
     ble_lns_pos_quality_t       * p_position_quality;                    /**< Initial Position Quality. */
     ble_lns_navigation_t        * p_navigation;                          /**< Initial Navigation data structure. */
+    bool                        is_changed_fields_only;                  /**< If set to true, Location and Speed notifications only carry the fields that changed since they were last sent. */
 };
 
 
@@ -105,35 +110,6 @@ typedef struct
 } ble_lns_route_t;
 
 
-/**@brief Location and Navigation Service structure. This structure contains various status information for the service. */
-struct ble_lns_s
-{
-    ble_lns_evt_handler_t             evt_handler;                                       /**< Event handler to be called for handling events in the Location and Navigation Service. */
-    ble_srv_error_handler_t           error_handler;                                     /**< Error handler. */
-
-    bool                              is_navigation_present;                             /**< If set to true, the navigation characteristic is present. Else not. */
-
-    uint16_t                          conn_handle;                                       /**< Handle of the current connection (as provided by the BLE stack; BLE_CONN_HANDLE_INVALID if not in a connection). */
-    uint16_t                          service_handle;                                    /**< Handle of Location and Navigation Service (as provided by the BLE stack). */
-    ble_gatts_char_handles_t          loc_speed_handles;                                 /**< Handles related to the Location and Speed characteristic. */
-    ble_gatts_char_handles_t          feature_handles;                                   /**< Handles related to the Location and Navigation Feature characteristic. */
-    ble_gatts_char_handles_t          navigation_handles;                                /**< Handles related to the Navigation characteristic. */
-    ble_gatts_char_handles_t          pos_qual_handles;                                  /**< Handles related to the Position Quality characteristic. */
-    ble_gatts_char_handles_t          ctrlpt_handles;
-    uint32_t                          available_features;                                /**< Value of Location and Navigation feature. */
-
-    bool                              is_loc_speed_notification_enabled;                 /**< True if notification is enabled on the Location and Speed characteristic. */
-    bool                              is_nav_notification_enabled;                       /**< True if notification is enabled on the Navigation characteristic. */
-
-    notification_t                    pending_loc_speed_notifications[2];                /**< This buffer holds location and speed notifications. */
-    notification_t                    pending_navigation_notification;                   /**< This buffer holds navigation notifications. */
-    ble_lns_loc_speed_t               * p_location_speed;                                /**< Location and Speed. */
-    ble_lns_pos_quality_t             * p_position_quality;                              /**< Position measurement quality. */
-    ble_lns_navigation_t              * p_navigation;                                    /**< Navigation data structure. */
-    ble_lncp_t                        ctrl_pt;
-};
-
-
 /** @brief Position status. This enumeration defines how to interpret the position data. */
 typedef enum
 {
@@ -243,6 +219,44 @@ struct ble_lns_navigation_s
 };
 
 
+/**@brief Location and Navigation Service structure. This structure contains various status information for the service. */
+struct ble_lns_s
+{
+    ble_lns_evt_handler_t             evt_handler;                                       /**< Event handler to be called for handling events in the Location and Navigation Service. */
+    ble_srv_error_handler_t           error_handler;                                     /**< Error handler. */
+
+    bool                              is_navigation_present;                             /**< If set to true, the navigation characteristic is present. Else not. */
+
+    uint16_t                          conn_handle;                                       /**< Handle of the current connection (as provided by the BLE stack; BLE_CONN_HANDLE_INVALID if not in a connection). */
+    uint16_t                          service_handle;                                    /**< Handle of Location and Navigation Service (as provided by the BLE stack). */
+    ble_gatts_char_handles_t          loc_speed_handles;                                 /**< Handles related to the Location and Speed characteristic. */
+    ble_gatts_char_handles_t          feature_handles;                                   /**< Handles related to the Location and Navigation Feature characteristic. */
+    ble_gatts_char_handles_t          navigation_handles;                                /**< Handles related to the Navigation characteristic. */
+    ble_gatts_char_handles_t          pos_qual_handles;                                  /**< Handles related to the Position Quality characteristic. */
+    ble_gatts_char_handles_t          ctrlpt_handles;
+    uint32_t                          available_features;                                /**< Value of Location and Navigation feature. */
+
+    bool                              is_loc_speed_notification_enabled;                 /**< True if notification is enabled on the Location and Speed characteristic. */
+    bool                              is_nav_notification_enabled;                       /**< True if notification is enabled on the Navigation characteristic. */
+
+    notification_t                    pending_loc_speed_notifications[2];                /**< This buffer holds location and speed notifications. */
+    notification_t                    pending_navigation_notification;                   /**< This buffer holds navigation notifications. */
+    ble_lns_loc_speed_t               * p_location_speed;                                /**< Location and Speed. */
+    ble_lns_pos_quality_t             * p_position_quality;                              /**< Position measurement quality. */
+    ble_lns_navigation_t              * p_navigation;                                    /**< Navigation data structure. */
+    ble_lncp_t                        ctrl_pt;
+
+    bool                              is_changed_fields_only;                            /**< True if only changed Location and Speed fields are sent. */
+    ble_lns_loc_speed_t               loc_speed_pending;                                 /**< Location and Speed data of the pending notifications. */
+    ble_lns_loc_speed_t               loc_speed_sent;                                    /**< Location and Speed data last sent to the client. */
+    ble_lncp_mask_t                   loc_speed_sent_fields;                             /**< Fields of loc_speed_sent which have been sent to the client. */
+    uint8_t                           loc_speed_rate_divider;                            /**< Only every n-th call to @ref ble_lns_loc_speed_send is sent. Raised while notifications are coalesced. */
+    uint8_t                           loc_speed_update_count;                            /**< Number of calls to @ref ble_lns_loc_speed_send since the last one that was sent. */
+    uint32_t                          notif_coalesced_count;                             /**< Number of notifications replaced by newer data before they could be sent. */
+    uint32_t                          notif_dropped_count;                               /**< Number of Location and Speed updates skipped because of a lowered rate. */
+};
+
+
 /**@brief Function for initializing the Location and Navigation Service.
  *
  * @param[out]    p_lns                  Location and Navigation Service structure. This structure must be supplied by
@@ -275,6 +289,12 @@ void ble_lns_on_ble_evt(ble_lns_t * p_lns, ble_evt_t const * p_ble_evt);
  *          If notification has been enabled, the location and speed data is encoded and sent to
  *          the client.
  *
+ *          Data which is still waiting for a TX buffer is replaced by the new data. When that
+ *          happens, the update rate is halved (up to @ref BLE_LNS_MAX_RATE_DIVIDER) by skipping
+ *          calls, and it is raised again step by step once updates go out in time. If
+ *          is_changed_fields_only was set at initialization, fields holding the same value as
+ *          last sent are left out, and a notification without any fields is not sent.
+ *
  * @param[in]     p_lns                   Location and Navigation Service structure holding the location and speed data.
  *
  * @retval        NRF_SUCCESS             If the data was sent successfully.
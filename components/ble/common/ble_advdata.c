@@ -759,3 +759,118 @@ uint32_t ble_advdata_set(const ble_advdata_t * p_advdata, const ble_advdata_t *
     // Pass encoded advertising data and/or scan response data to the stack.
     return sd_ble_gap_adv_data_set(p_encoded_advdata, len_advdata, p_encoded_srdata, len_srdata);
 }
+
+
+/**@brief Function for recording the location of each AD structure in an encoded buffer.
+ */
+static void encoded_fields_index(ble_advdata_encoded_t * p_encoded)
+{
+    uint16_t offset = 0;
+
+    p_encoded->field_count = 0;
+
+    while (((offset + ADV_AD_DATA_OFFSET) <= p_encoded->len) &&
+           (p_encoded->field_count < BLE_ADVDATA_CACHE_MAX_FIELDS))
+    {
+        uint8_t ad_len = p_encoded->data[offset];
+
+        if (ad_len == 0)
+        {
+            break;
+        }
+
+        p_encoded->fields[p_encoded->field_count].type   = p_encoded->data[offset + ADV_LENGTH_FIELD_SIZE];
+        p_encoded->fields[p_encoded->field_count].offset = (uint8_t)(offset + ADV_AD_DATA_OFFSET);
+        p_encoded->fields[p_encoded->field_count].length = (uint8_t)(ad_len - ADV_AD_TYPE_FIELD_SIZE);
+        p_encoded->field_count++;
+
+        offset += ADV_LENGTH_FIELD_SIZE + ad_len;
+    }
+}
+
+
+uint32_t ble_advdata_cache_set(ble_advdata_cache_t       * p_cache,
+                               const ble_advdata_t       * p_advdata,
+                               const ble_advdata_t       * p_srdata)
+{
+    uint32_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_cache);
+
+    p_cache->advdata.len         = 0;
+    p_cache->advdata.field_count = 0;
+    p_cache->srdata.len          = 0;
+    p_cache->srdata.field_count  = 0;
+
+    // Encode advertising data (if supplied).
+    if (p_advdata != NULL)
+    {
+        err_code = advdata_check(p_advdata);
+        VERIFY_SUCCESS(err_code);
+
+        p_cache->advdata.len = BLE_GAP_ADV_MAX_SIZE;
+        err_code = adv_data_encode(p_advdata, p_cache->advdata.data, &p_cache->advdata.len);
+        VERIFY_SUCCESS(err_code);
+        encoded_fields_index(&p_cache->advdata);
+    }
+
+    // Encode scan response data (if supplied).
+    if (p_srdata != NULL)
+    {
+        err_code = srdata_check(p_srdata);
+        VERIFY_SUCCESS(err_code);
+
+        p_cache->srdata.len = BLE_GAP_ADV_MAX_SIZE;
+        err_code = adv_data_encode(p_srdata, p_cache->srdata.data, &p_cache->srdata.len);
+        VERIFY_SUCCESS(err_code);
+        encoded_fields_index(&p_cache->srdata);
+    }
+
+    return ble_advdata_cache_apply(p_cache);
+}
+
+
+uint32_t ble_advdata_field_update(ble_advdata_cache_t * p_cache,
+                                  bool                  scan_rsp,
+                                  uint8_t               ad_type,
+                                  uint8_t               offset,
+                                  uint8_t const       * p_data,
+                                  uint8_t               len)
+{
+    ble_advdata_encoded_t * p_encoded;
+    uint8_t                 i;
+
+    VERIFY_PARAM_NOT_NULL(p_cache);
+    VERIFY_PARAM_NOT_NULL(p_data);
+
+    p_encoded = scan_rsp ? &p_cache->srdata : &p_cache->advdata;
+
+    for (i = 0; i < p_encoded->field_count; i++)
+    {
+        if (p_encoded->fields[i].type == ad_type)
+        {
+            if (((uint16_t)offset + len) > p_encoded->fields[i].length)
+            {
+                return NRF_ERROR_INVALID_LENGTH;
+            }
+
+            memcpy(&p_encoded->data[p_encoded->fields[i].offset + offset], p_data, len);
+
+            return NRF_SUCCESS;
+        }
+    }
+
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+uint32_t ble_advdata_cache_apply(ble_advdata_cache_t const * p_cache)
+{
+    VERIFY_PARAM_NOT_NULL(p_cache);
+
+    // The stack copies the data, so the cache can be changed again directly after this call.
+    return sd_ble_gap_adv_data_set(p_cache->advdata.data,
+                                   p_cache->advdata.len,
+                                   p_cache->srdata.data,
+                                   p_cache->srdata.len);
+}
@@ -71,6 +71,8 @@
 #define AD_TYPE_SEC_MGR_OOB_ADDRESS_TYPE_RANDOM        1UL                     /**< Security Manager OOB Random Address type. */
 #define AD_TYPE_SEC_MGR_OOB_FLAG_ADDRESS_TYPE_POS      3UL                     /**< Security Manager OOB Address type Flag (0 = Public Address, 1 = Random Address) position. */
 
+#define BLE_ADVDATA_CACHE_MAX_FIELDS       (BLE_GAP_ADV_MAX_SIZE / ADV_AD_DATA_OFFSET) /**< Maximum number of AD structures in one encoded Advertising or Scan Response packet. */
+
 
 /**@brief Security Manager TK value. */
 typedef struct
@@ -148,6 +150,31 @@ typedef struct
     uint8_t *                    p_sec_mgr_oob_flags;                 /**< Security Manager Out Of Band Flags field. Included when different from NULL. @warning This field can be used only for NFC. For BLE advertising, set it to NULL.*/
 } ble_advdata_t;
 
+/**@brief Location of one AD structure in an encoded buffer. */
+typedef struct
+{
+    uint8_t                      type;                                /**< AD type of the structure. */
+    uint8_t                      offset;                              /**< Offset of the AD data of the structure in the encoded buffer. */
+    uint8_t                      length;                              /**< Length of the AD data of the structure. */
+} ble_advdata_field_t;
+
+/**@brief Encoded Advertising or Scan Response data, with the location of each AD structure. */
+typedef struct
+{
+    uint8_t                      data[BLE_GAP_ADV_MAX_SIZE];          /**< Encoded data. */
+    uint16_t                     len;                                 /**< Length of the encoded data. */
+    ble_advdata_field_t          fields[BLE_ADVDATA_CACHE_MAX_FIELDS]; /**< AD structures in the encoded data, in order of appearance. */
+    uint8_t                      field_count;                         /**< Number of AD structures in the encoded data. */
+} ble_advdata_encoded_t;
+
+/**@brief Cached Advertising and Scan Response data. This structure holds the data passed to the
+ *        stack, so that single fields can be updated without encoding the data again. */
+typedef struct
+{
+    ble_advdata_encoded_t        advdata;                             /**< Encoded advertising data. */
+    ble_advdata_encoded_t        srdata;                              /**< Encoded scan response data. */
+} ble_advdata_cache_t;
+
 /**@brief Function for encoding data in the Advertising and Scan Response data format
  *        (AD structures).
  *
@@ -207,6 +234,75 @@ uint32_t adv_data_encode(ble_advdata_t const * const p_advdata,
  */
 uint32_t ble_advdata_set(const ble_advdata_t * p_advdata, const ble_advdata_t * p_srdata);
 
+
+/**@brief Function for encoding the advertising data and scan response data into a cache and
+ *        setting them.
+ *
+ * @details This function works as @ref ble_advdata_set, but the data is encoded into
+ *          @p p_cache and the location of each AD structure is recorded. Single fields can then
+ *          be changed with @ref ble_advdata_field_update and passed to the stack with
+ *          @ref ble_advdata_cache_apply, without encoding the data again.
+ *
+ * @note Unlike @ref ble_advdata_set, a NULL pointer clears the corresponding data in the stack,
+ *       since the cache always describes both the advertising and the scan response packet.
+ *
+ * @param[out]  p_cache     Cache to encode the data into.
+ * @param[in]   p_advdata   Structure for specifying the content of the advertising data.
+ *                          Set to NULL if there is no advertising data.
+ * @param[in]   p_srdata    Structure for specifying the content of the scan response data.
+ *                          Set to NULL if there is no scan response data.
+ *
+ * @retval NRF_SUCCESS             If the operation was successful.
+ * @retval NRF_ERROR_NULL          If @p p_cache was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If the operation failed because a wrong parameter was provided in \p p_advdata.
+ * @retval NRF_ERROR_DATA_SIZE     If the operation failed because not all the requested data could fit into the
+ *                                 advertising packet. The maximum size of the advertisement packet
+ *                                 is @ref BLE_GAP_ADV_MAX_SIZE.
+ */
+uint32_t ble_advdata_cache_set(ble_advdata_cache_t       * p_cache,
+                               const ble_advdata_t       * p_advdata,
+                               const ble_advdata_t       * p_srdata);
+
+
+/**@brief Function for changing the data of one AD structure in the cache.
+ *
+ * @details The first AD structure of type @p ad_type is changed in place. Its length cannot
+ *          change. The new data is passed to the stack by @ref ble_advdata_cache_apply, so that
+ *          several fields can be changed at once.
+ *
+ * @param[in,out] p_cache   Cache set by @ref ble_advdata_cache_set.
+ * @param[in]     scan_rsp  True to change the scan response data, false to change the
+ *                          advertising data.
+ * @param[in]     ad_type   AD type of the structure to change, for example
+ *                          @ref BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA.
+ * @param[in]     offset    Offset within the AD data of the structure. For Manufacturer Specific
+ *                          Data and Service Data, the data starts with the 2-octet company
+ *                          identifier or UUID.
+ * @param[in]     p_data    New data.
+ * @param[in]     len       Length of @p p_data.
+ *
+ * @retval NRF_SUCCESS              If the data was changed.
+ * @retval NRF_ERROR_NULL           If a pointer parameter was NULL.
+ * @retval NRF_ERROR_NOT_FOUND      If there is no AD structure of type @p ad_type in the data.
+ * @retval NRF_ERROR_INVALID_LENGTH If @p offset and @p len exceed the AD data of the structure.
+ */
+uint32_t ble_advdata_field_update(ble_advdata_cache_t * p_cache,
+                                  bool                  scan_rsp,
+                                  uint8_t               ad_type,
+                                  uint8_t               offset,
+                                  uint8_t const       * p_data,
+                                  uint8_t               len);
+
+
+/**@brief Function for passing the cached advertising and scan response data to the stack.
+ *
+ * @param[in] p_cache   Cache set by @ref ble_advdata_cache_set.
+ *
+ * @retval NRF_ERROR_NULL If @p p_cache was NULL.
+ * @return Otherwise the error code returned by @ref sd_ble_gap_adv_data_set.
+ */
+uint32_t ble_advdata_cache_apply(ble_advdata_cache_t const * p_cache);
+
 #endif // BLE_ADVDATA_H__
 
 /** @} */
@@ -12,6 +12,7 @@
 
 #include "ble_conn_params.h"
 #include <stdlib.h>
+#include <string.h>
 #include "nordic_common.h"
 #include "ble_hci.h"
 #include "app_timer.h"
@@ -19,24 +20,97 @@
 #include "app_util.h"
 
 
-static ble_conn_params_init_t m_conn_params_config;     /**< Configuration as specified by the application. */
-static ble_gap_conn_params_t  m_preferred_conn_params;  /**< Connection parameters preferred by the application. */
-static uint8_t                m_update_count;           /**< Number of Connection Parameter Update messages that has currently been sent. */
-static uint16_t               m_conn_handle;            /**< Current connection handle. */
-static ble_gap_conn_params_t  m_current_conn_params;    /**< Connection parameters received in the most recent Connect event. */
-APP_TIMER_DEF(m_conn_params_timer_id);                  /**< Connection parameters timer. */
+/**@brief Negotiation state of one connection. */
+typedef struct
+{
+    uint16_t                  conn_handle;            /**< Connection handle, BLE_CONN_HANDLE_INVALID if the record is free. */
+    uint8_t                   update_count;           /**< Number of Connection Parameter Update messages that has currently been sent. */
+    bool                      change_param;           /**< Set when the preferred parameters were changed on this connection and the update has been requested directly. */
+    ble_conn_params_profile_t profile;                /**< Profile of the preferred parameters of this connection. */
+    ble_gap_conn_params_t     current_conn_params;    /**< Connection parameters received in the most recent Connect or Connection Parameter Update event. */
+    uint32_t                  packet_count;           /**< Number of packets sent and received since the last traffic check. */
+    app_timer_t               timer_data;             /**< Memory of the update timer of this connection. */
+    app_timer_id_t            timer_id;               /**< Update timer of this connection. */
+} conn_params_record_t;
+
+
+static ble_conn_params_init_t m_conn_params_config;                  /**< Configuration as specified by the application. */
+static ble_gap_conn_params_t  m_preferred_conn_params;               /**< Connection parameters preferred by the application (low power profile). */
+static ble_gap_conn_params_t  m_high_throughput_conn_params;         /**< Connection parameters of the high throughput profile. */
+static bool                   m_high_throughput_supported;           /**< Whether the high throughput profile was given at initialization. */
+static conn_params_record_t   m_records[BLE_CONN_PARAMS_MAX_CONNS];  /**< Negotiation state of each connection. */
+APP_TIMER_DEF(m_traffic_timer_id);                                   /**< Timer for the automatic profile selection. */
+
+
+/**@brief Function for getting the preferred connection parameters of a connection. */
+static ble_gap_conn_params_t * preferred_conn_params_get(conn_params_record_t * p_record)
+{
+    if (p_record->profile == BLE_CONN_PARAMS_PROFILE_HIGH_THROUGHPUT)
+    {
+        return &m_high_throughput_conn_params;
+    }
+    return &m_preferred_conn_params;
+}
+
+
+/**@brief Function for finding the record of a connection.
+ *
+ * @return Pointer to the record, or NULL if the connection is not handled by this module.
+ */
+static conn_params_record_t * record_get(uint16_t conn_handle)
+{
+    uint32_t i;
+
+    if (conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < BLE_CONN_PARAMS_MAX_CONNS; i++)
+    {
+        if (m_records[i].conn_handle == conn_handle)
+        {
+            return &m_records[i];
+        }
+    }
+    return NULL;
+}
+
+
+static void evt_send(conn_params_record_t * p_record, ble_conn_params_evt_type_t evt_type)
+{
+    if (m_conn_params_config.evt_handler != NULL)
+    {
+        ble_conn_params_evt_t evt;
+
+        evt.evt_type    = evt_type;
+        evt.conn_handle = p_record->conn_handle;
+        m_conn_params_config.evt_handler(&evt);
+    }
+}
+
+
+static void error_report(uint32_t err_code)
+{
+    if ((err_code != NRF_SUCCESS) && (m_conn_params_config.error_handler != NULL))
+    {
+        m_conn_params_config.error_handler(err_code);
+    }
+}
 
-static bool m_change_param = false;
 
-static bool is_conn_params_ok(ble_gap_conn_params_t * p_conn_params)
+static bool is_conn_params_ok(conn_params_record_t * p_record)
 {
+    ble_gap_conn_params_t * p_conn_params      = &p_record->current_conn_params;
+    ble_gap_conn_params_t * p_preferred_params = preferred_conn_params_get(p_record);
+
     // Check if interval is within the acceptable range.
     // NOTE: Using max_conn_interval in the received event data because this contains
     //       the client's connection interval.
     if (
-        (p_conn_params->max_conn_interval >= m_preferred_conn_params.min_conn_interval)
+        (p_conn_params->max_conn_interval >= p_preferred_params->min_conn_interval)
         && 
-        (p_conn_params->max_conn_interval <= m_preferred_conn_params.max_conn_interval)
+        (p_conn_params->max_conn_interval <= p_preferred_params->max_conn_interval)
        )
     {
         return true;
@@ -50,48 +124,100 @@ static bool is_conn_params_ok(ble_gap_conn_params_t * p_conn_params)
 
 static void update_timeout_handler(void * p_context)
 {
-    UNUSED_PARAMETER(p_context);
+    conn_params_record_t * p_record = (conn_params_record_t *)p_context;
 
-    if (m_conn_handle != BLE_CONN_HANDLE_INVALID)
+    if (p_record->conn_handle != BLE_CONN_HANDLE_INVALID)
     {
         // Check if we have reached the maximum number of attempts
-        m_update_count++;
-        if (m_update_count <= m_conn_params_config.max_conn_params_update_count)
+        p_record->update_count++;
+        if (p_record->update_count <= m_conn_params_config.max_conn_params_update_count)
         {
             uint32_t err_code;
 
             // Parameters are not ok, send connection parameters update request.
-            err_code = sd_ble_gap_conn_param_update(m_conn_handle, &m_preferred_conn_params);
-            if ((err_code != NRF_SUCCESS) && (m_conn_params_config.error_handler != NULL))
-            {
-                m_conn_params_config.error_handler(err_code);
-            }
+            err_code = sd_ble_gap_conn_param_update(p_record->conn_handle,
+                                                    preferred_conn_params_get(p_record));
+            error_report(err_code);
         }
         else
         {
-            m_update_count = 0;
+            p_record->update_count = 0;
 
             // Negotiation failed, disconnect automatically if this has been configured
             if (m_conn_params_config.disconnect_on_fail)
             {
                 uint32_t err_code;
 
-                err_code = sd_ble_gap_disconnect(m_conn_handle, BLE_HCI_CONN_INTERVAL_UNACCEPTABLE);
-                if ((err_code != NRF_SUCCESS) && (m_conn_params_config.error_handler != NULL))
-                {
-                    m_conn_params_config.error_handler(err_code);
-                }
+                err_code = sd_ble_gap_disconnect(p_record->conn_handle,
+                                                 BLE_HCI_CONN_INTERVAL_UNACCEPTABLE);
+                error_report(err_code);
             }
 
             // Notify the application that the procedure has failed
-            if (m_conn_params_config.evt_handler != NULL)
-            {
-                ble_conn_params_evt_t evt;
+            evt_send(p_record, BLE_CONN_PARAMS_EVT_FAILED);
+        }
+    }
+}
 
-                evt.evt_type = BLE_CONN_PARAMS_EVT_FAILED;
-                m_conn_params_config.evt_handler(&evt);
-            }
+
+/**@brief Function for switching the profile of a connection and requesting its parameters.
+ */
+static uint32_t profile_apply(conn_params_record_t    * p_record,
+                              ble_conn_params_profile_t profile)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    p_record->profile = profile;
+
+    // Stop a pending update of the previous profile.
+    (void)app_timer_stop(p_record->timer_id);
+
+    if (!is_conn_params_ok(p_record))
+    {
+        p_record->change_param = true;
+        err_code = sd_ble_gap_conn_param_update(p_record->conn_handle,
+                                                preferred_conn_params_get(p_record));
+        p_record->update_count = 1;
+    }
+    else
+    {
+        // Notify the application that the procedure has succeded
+        evt_send(p_record, BLE_CONN_PARAMS_EVT_SUCCEEDED);
+    }
+    return err_code;
+}
+
+
+/**@brief Function for selecting the profile of each connection from the traffic since the last
+ *        check.
+ */
+static void traffic_timeout_handler(void * p_context)
+{
+    uint32_t i;
+
+    UNUSED_PARAMETER(p_context);
+
+    for (i = 0; i < BLE_CONN_PARAMS_MAX_CONNS; i++)
+    {
+        conn_params_record_t * p_record = &m_records[i];
+
+        if (p_record->conn_handle == BLE_CONN_HANDLE_INVALID)
+        {
+            continue;
+        }
+
+        if (   (p_record->profile == BLE_CONN_PARAMS_PROFILE_LOW_POWER)
+            && (p_record->packet_count >= m_conn_params_config.high_throughput_threshold))
+        {
+            error_report(profile_apply(p_record, BLE_CONN_PARAMS_PROFILE_HIGH_THROUGHPUT));
+        }
+        else if (   (p_record->profile == BLE_CONN_PARAMS_PROFILE_HIGH_THROUGHPUT)
+                 && (p_record->packet_count < m_conn_params_config.low_power_threshold))
+        {
+            error_report(profile_apply(p_record, BLE_CONN_PARAMS_PROFILE_LOW_POWER));
         }
+
+        p_record->packet_count = 0;
     }
 }
 
@@ -99,9 +225,9 @@ static void update_timeout_handler(void * p_context)
 uint32_t ble_conn_params_init(const ble_conn_params_init_t * p_init)
 {
     uint32_t err_code;
+    uint32_t i;
 
     m_conn_params_config = *p_init;
-    m_change_param = false;
     if (p_init->p_conn_params != NULL)
     {
         m_preferred_conn_params = *p_init->p_conn_params;
@@ -123,43 +249,92 @@ uint32_t ble_conn_params_init(const ble_conn_params_init_t * p_init)
         }
     }
 
-    m_conn_handle  = BLE_CONN_HANDLE_INVALID;
-    m_update_count = 0;
+    m_high_throughput_supported = (p_init->p_high_throughput_conn_params != NULL);
+    if (m_high_throughput_supported)
+    {
+        m_high_throughput_conn_params = *p_init->p_high_throughput_conn_params;
+    }
+    else if (p_init->traffic_check_interval != 0)
+    {
+        // Automatic profile selection needs a high throughput profile.
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < BLE_CONN_PARAMS_MAX_CONNS; i++)
+    {
+        memset(&m_records[i], 0, sizeof(m_records[i]));
+
+        m_records[i].conn_handle = BLE_CONN_HANDLE_INVALID;
+        m_records[i].profile     = BLE_CONN_PARAMS_PROFILE_LOW_POWER;
+        m_records[i].timer_id    = &m_records[i].timer_data;
+
+        err_code = app_timer_create(&m_records[i].timer_id,
+                                    APP_TIMER_MODE_SINGLE_SHOT,
+                                    update_timeout_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    if (p_init->traffic_check_interval != 0)
+    {
+        err_code = app_timer_create(&m_traffic_timer_id,
+                                    APP_TIMER_MODE_REPEATED,
+                                    traffic_timeout_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+        return app_timer_start(m_traffic_timer_id, p_init->traffic_check_interval, NULL);
+    }
 
-    return app_timer_create(&m_conn_params_timer_id,
-                            APP_TIMER_MODE_SINGLE_SHOT,
-                            update_timeout_handler);
+    return NRF_SUCCESS;
 }
 
 
 uint32_t ble_conn_params_stop(void)
 {
-    return app_timer_stop(m_conn_params_timer_id);
+    uint32_t err_code;
+    uint32_t i;
+
+    if (m_conn_params_config.traffic_check_interval != 0)
+    {
+        err_code = app_timer_stop(m_traffic_timer_id);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    for (i = 0; i < BLE_CONN_PARAMS_MAX_CONNS; i++)
+    {
+        err_code = app_timer_stop(m_records[i].timer_id);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+    return NRF_SUCCESS;
 }
 
 
-static void conn_params_negotiation(void)
+static void conn_params_negotiation(conn_params_record_t * p_record)
 {
     // Start negotiation if the received connection parameters are not acceptable
-    if (!is_conn_params_ok(&m_current_conn_params))
+    if (!is_conn_params_ok(p_record))
     {
         uint32_t err_code;
         uint32_t timeout_ticks;
 
-        if (m_change_param)
+        if (p_record->change_param)
         {
             // Notify the application that the procedure has failed
-            if (m_conn_params_config.evt_handler != NULL)
-            {
-                ble_conn_params_evt_t evt;
-
-                evt.evt_type = BLE_CONN_PARAMS_EVT_FAILED;
-                m_conn_params_config.evt_handler(&evt);
-            }
+            evt_send(p_record, BLE_CONN_PARAMS_EVT_FAILED);
         }
         else
         {
-            if (m_update_count == 0)
+            if (p_record->update_count == 0)
             {
                 // First connection parameter update
                 timeout_ticks = m_conn_params_config.first_conn_params_update_delay;
@@ -169,63 +344,87 @@ static void conn_params_negotiation(void)
                 timeout_ticks = m_conn_params_config.next_conn_params_update_delay;
             }
 
-            err_code = app_timer_start(m_conn_params_timer_id, timeout_ticks, NULL);
-            if ((err_code != NRF_SUCCESS) && (m_conn_params_config.error_handler != NULL))
-            {
-                m_conn_params_config.error_handler(err_code);
-            }
+            err_code = app_timer_start(p_record->timer_id, timeout_ticks, p_record);
+            error_report(err_code);
         }
     }
     else
     {
         // Notify the application that the procedure has succeded
-        if (m_conn_params_config.evt_handler != NULL)
-        {
-            ble_conn_params_evt_t evt;
-
-            evt.evt_type = BLE_CONN_PARAMS_EVT_SUCCEEDED;
-            m_conn_params_config.evt_handler(&evt);
-        }
+        evt_send(p_record, BLE_CONN_PARAMS_EVT_SUCCEEDED);
     }
-    m_change_param = false;
+    p_record->change_param = false;
 }
 
 
 static void on_connect(ble_evt_t * p_ble_evt)
 {
+    conn_params_record_t * p_record = record_get(p_ble_evt->evt.gap_evt.conn_handle);
+    uint32_t               i;
+
+    for (i = 0; (i < BLE_CONN_PARAMS_MAX_CONNS) && (p_record == NULL); i++)
+    {
+        if (m_records[i].conn_handle == BLE_CONN_HANDLE_INVALID)
+        {
+            p_record = &m_records[i];
+        }
+    }
+
+    if (p_record == NULL)
+    {
+        // All records are in use. As when only one connection was tracked, the newest
+        // connection takes over the first record.
+        p_record = &m_records[0];
+        (void)app_timer_stop(p_record->timer_id);
+    }
+
     // Save connection parameters
-    m_conn_handle         = p_ble_evt->evt.gap_evt.conn_handle;
-    m_current_conn_params = p_ble_evt->evt.gap_evt.params.connected.conn_params;
-    m_update_count        = 0;  // Connection parameter negotiation should re-start every connection
+    p_record->conn_handle         = p_ble_evt->evt.gap_evt.conn_handle;
+    p_record->current_conn_params = p_ble_evt->evt.gap_evt.params.connected.conn_params;
+    p_record->update_count        = 0;  // Connection parameter negotiation should re-start every connection
+    p_record->change_param        = false;
+    p_record->profile             = BLE_CONN_PARAMS_PROFILE_LOW_POWER;
+    p_record->packet_count        = 0;
 
     // Check if we shall handle negotiation on connect
     if (m_conn_params_config.start_on_notify_cccd_handle == BLE_GATT_HANDLE_INVALID)
     {
-        conn_params_negotiation();
+        conn_params_negotiation(p_record);
     }
 }
 
 
 static void on_disconnect(ble_evt_t * p_ble_evt)
 {
-    uint32_t err_code;
+    uint32_t               err_code;
+    conn_params_record_t * p_record = record_get(p_ble_evt->evt.gap_evt.conn_handle);
 
-    m_conn_handle = BLE_CONN_HANDLE_INVALID;
+    if (p_record == NULL)
+    {
+        return;
+    }
+
+    p_record->conn_handle = BLE_CONN_HANDLE_INVALID;
 
     // Stop timer if running
-    m_update_count = 0; // Connection parameters updates should happen during every connection
+    p_record->update_count = 0; // Connection parameters updates should happen during every connection
 
-    err_code = app_timer_stop(m_conn_params_timer_id);
-    if ((err_code != NRF_SUCCESS) && (m_conn_params_config.error_handler != NULL))
-    {
-        m_conn_params_config.error_handler(err_code);
-    }
+    err_code = app_timer_stop(p_record->timer_id);
+    error_report(err_code);
 }
 
 
 static void on_write(ble_evt_t * p_ble_evt)
 {
     ble_gatts_evt_write_t * p_evt_write = &p_ble_evt->evt.gatts_evt.params.write;
+    conn_params_record_t  * p_record    = record_get(p_ble_evt->evt.gatts_evt.conn_handle);
+
+    if (p_record == NULL)
+    {
+        return;
+    }
+
+    p_record->packet_count++;
 
     // Check if this the correct CCCD
     if (
@@ -238,18 +437,15 @@ static void on_write(ble_evt_t * p_ble_evt)
         if (ble_srv_is_notification_enabled(p_evt_write->data))
         {
             // Do connection parameter negotiation if necessary
-            conn_params_negotiation();
+            conn_params_negotiation(p_record);
         }
         else
         {
             uint32_t err_code;
 
             // Stop timer if running
-            err_code = app_timer_stop(m_conn_params_timer_id);
-            if ((err_code != NRF_SUCCESS) && (m_conn_params_config.error_handler != NULL))
-            {
-                m_conn_params_config.error_handler(err_code);
-            }
+            err_code = app_timer_stop(p_record->timer_id);
+            error_report(err_code);
         }
     }
 }
@@ -257,10 +453,30 @@ static void on_write(ble_evt_t * p_ble_evt)
 
 static void on_conn_params_update(ble_evt_t * p_ble_evt)
 {
+    conn_params_record_t * p_record = record_get(p_ble_evt->evt.gap_evt.conn_handle);
+
+    if (p_record == NULL)
+    {
+        return;
+    }
+
     // Copy the parameters
-    m_current_conn_params = p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params;
+    p_record->current_conn_params = p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params;
 
-    conn_params_negotiation();
+    conn_params_negotiation(p_record);
+}
+
+
+/**@brief Function for counting the packets of a connection for the automatic profile selection.
+ */
+static void on_traffic(uint16_t conn_handle, uint32_t packets)
+{
+    conn_params_record_t * p_record = record_get(conn_handle);
+
+    if (p_record != NULL)
+    {
+        p_record->packet_count += packets;
+    }
 }
 
 
@@ -284,6 +500,15 @@ void ble_conn_params_on_ble_evt(ble_evt_t * p_ble_evt)
             on_conn_params_update(p_ble_evt);
             break;
 
+        case BLE_EVT_TX_COMPLETE:
+            on_traffic(p_ble_evt->evt.common_evt.conn_handle,
+                       p_ble_evt->evt.common_evt.params.tx_complete.count);
+            break;
+
+        case BLE_GATTC_EVT_HVX:
+            on_traffic(p_ble_evt->evt.gattc_evt.conn_handle, 1);
+            break;
+
         default:
             // No implementation needed.
             break;
@@ -294,30 +519,43 @@ void ble_conn_params_on_ble_evt(ble_evt_t * p_ble_evt)
 uint32_t ble_conn_params_change_conn_params(ble_gap_conn_params_t * new_params)
 {
     uint32_t err_code;
+    uint32_t i;
 
     m_preferred_conn_params = *new_params;
     // Set the connection params in stack
     err_code = sd_ble_gap_ppcp_set(&m_preferred_conn_params);
-    if (err_code == NRF_SUCCESS)
+
+    for (i = 0; (i < BLE_CONN_PARAMS_MAX_CONNS) && (err_code == NRF_SUCCESS); i++)
     {
-        if (!is_conn_params_ok(&m_current_conn_params))
+        if (   (m_records[i].conn_handle != BLE_CONN_HANDLE_INVALID)
+            && (m_records[i].profile == BLE_CONN_PARAMS_PROFILE_LOW_POWER))
         {
-            m_change_param = true;
-            err_code = sd_ble_gap_conn_param_update(m_conn_handle, &m_preferred_conn_params);
-            m_update_count = 1;
-        }
-        else
-        {
-            // Notify the application that the procedure has succeded
-            if (m_conn_params_config.evt_handler != NULL)
-            {
-                ble_conn_params_evt_t evt;
-
-                evt.evt_type = BLE_CONN_PARAMS_EVT_SUCCEEDED;
-                m_conn_params_config.evt_handler(&evt);
-            }
-            err_code = NRF_SUCCESS;
+            err_code = profile_apply(&m_records[i], BLE_CONN_PARAMS_PROFILE_LOW_POWER);
         }
     }
     return err_code;
 }
+
+
+uint32_t ble_conn_params_profile_set(uint16_t conn_handle, ble_conn_params_profile_t profile)
+{
+    conn_params_record_t * p_record = record_get(conn_handle);
+
+    if (p_record == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    if (   (profile == BLE_CONN_PARAMS_PROFILE_HIGH_THROUGHPUT)
+        && !m_high_throughput_supported)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    if (profile == p_record->profile)
+    {
+        return NRF_SUCCESS;
+    }
+
+    return profile_apply(p_record, profile);
+}
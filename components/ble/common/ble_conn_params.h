@@ -25,6 +25,10 @@
 #include "ble.h"
 #include "ble_srv_common.h"
 
+#ifndef BLE_CONN_PARAMS_MAX_CONNS
+#define BLE_CONN_PARAMS_MAX_CONNS 1                                 /**< Number of connections negotiated concurrently. Each connection has its own update timer and profile. */
+#endif
+
 /**@brief Connection Parameters Module event type. */
 typedef enum
 {
@@ -36,8 +40,16 @@ typedef enum
 typedef struct
 {
     ble_conn_params_evt_type_t evt_type;                            /**< Type of event. */
+    uint16_t                   conn_handle;                         /**< Connection the event applies to. */
 } ble_conn_params_evt_t;
 
+/**@brief Preferred connection parameter profiles. */
+typedef enum
+{
+    BLE_CONN_PARAMS_PROFILE_LOW_POWER,                              /**< The parameters given in @ref ble_conn_params_init_t::p_conn_params. Used for new connections. */
+    BLE_CONN_PARAMS_PROFILE_HIGH_THROUGHPUT                         /**< The parameters given in @ref ble_conn_params_init_t::p_high_throughput_conn_params. */
+} ble_conn_params_profile_t;
+
 /**@brief Connection Parameters Module event handler type. */
 typedef void (*ble_conn_params_evt_handler_t) (ble_conn_params_evt_t * p_evt);
 
@@ -53,6 +65,10 @@ typedef struct
     bool                          disconnect_on_fail;               /**< Set to TRUE if a failed connection parameters update shall cause an automatic disconnection, set to FALSE otherwise. */
     ble_conn_params_evt_handler_t evt_handler;                      /**< Event handler to be called for handling events in the Connection Parameters. */
     ble_srv_error_handler_t       error_handler;                    /**< Function to be called in case of an error. */
+    ble_gap_conn_params_t *       p_high_throughput_conn_params;    /**< Pointer to the connection parameters of the high throughput profile, typically a short connection interval and no slave latency. Set to NULL if the profile is not used. */
+    uint32_t                      traffic_check_interval;           /**< Interval of the automatic profile selection (in number of timer ticks). Every interval, a connection with at least high_throughput_threshold packets switches to the high throughput profile, and one with less than low_power_threshold packets switches back. Set to 0 to select profiles only with @ref ble_conn_params_profile_set. */
+    uint16_t                      high_throughput_threshold;        /**< Packets per traffic check interval to switch to the high throughput profile. */
+    uint16_t                      low_power_threshold;              /**< Packets per traffic check interval below which to switch back to the low power profile. */
 } ble_conn_params_init_t;
 
 
@@ -62,8 +78,13 @@ typedef struct
  *       any characteristic is enabled by the peer, then this function must be called after
  *       having initialized the services.
  *
+ * @note Up to @ref BLE_CONN_PARAMS_MAX_CONNS connections are negotiated independently. When all
+ *       are in use, a new connection replaces the one tracked in the first record.
+ *
  * @param[in]   p_init  This contains information needed to initialize this module.
  *
+ * @retval      NRF_ERROR_INVALID_PARAM If traffic_check_interval is set without
+ *                                      p_high_throughput_conn_params.
  * @return      NRF_SUCCESS on successful initialization, otherwise an error code.
  */
 uint32_t ble_conn_params_init(const ble_conn_params_init_t * p_init);
@@ -91,6 +112,8 @@ uint32_t ble_conn_params_stop(void);
  *       amount of data.
  *       If the given parameters does not match the current connection's parameters
  *       this function initiates a new negotiation.
+ *       The new parameters replace the low power profile, and are negotiated on all connections
+ *       using that profile.
  *
  * @param[in]   new_params  This contains the new connections parameters to setup.
  *
@@ -98,6 +121,24 @@ uint32_t ble_conn_params_stop(void);
  */
 uint32_t ble_conn_params_change_conn_params(ble_gap_conn_params_t *new_params);
 
+/**@brief Function for selecting the profile of the preferred parameters of one connection.
+ *
+ * @details If the current parameters of the connection do not match the profile, an update is
+ *          requested directly. The result is reported with a @ref BLE_CONN_PARAMS_EVT_SUCCEEDED
+ *          or @ref BLE_CONN_PARAMS_EVT_FAILED event for the connection. With automatic profile
+ *          selection enabled, the profile may be changed again at the next traffic check.
+ *
+ * @param[in]   conn_handle  Connection to change the profile of.
+ * @param[in]   profile      New profile.
+ *
+ * @retval      NRF_SUCCESS             If the profile was selected.
+ * @retval      NRF_ERROR_NOT_FOUND     If the connection is not handled by this module.
+ * @retval      NRF_ERROR_NOT_SUPPORTED If no high throughput parameters were given at
+ *                                      initialization.
+ * @return      Otherwise the error code returned by @ref sd_ble_gap_conn_param_update.
+ */
+uint32_t ble_conn_params_profile_set(uint16_t conn_handle, ble_conn_params_profile_t profile);
+
 /**@brief Function for handling the Application's BLE Stack events.
  *
  * @details Handles all events from the BLE stack that are of interest to this module.
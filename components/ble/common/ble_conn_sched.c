@@ -0,0 +1,275 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+#include "ble_conn_sched.h"
+#include <string.h>
+#include "app_timer.h"
+#include "app_util.h"
+#include "sdk_common.h"
+
+
+#define CONN_INTERVAL_UNIT_US   1250    /**< Connection interval unit, in microseconds. */
+
+
+/**@brief Throughput counters of a link, with the time of their reset. */
+typedef struct
+{
+    uint32_t rx_bytes;                  /**< Bytes of notifications and indications received. */
+    uint32_t rx_count;                  /**< Number of notifications and indications received. */
+    uint32_t start_ticks;               /**< Time of the reset. */
+} link_stats_t;
+
+static ble_gap_conn_params_t m_conn_params;                     /**< Connection parameters of the packed links. */
+static uint8_t               m_conn_bw;                         /**< Bandwidth of the central links. */
+static ble_conn_bw_counts_t  m_bw_counts;                       /**< Bandwidth memory pools of the SoftDevice. */
+static bool                  m_connecting;                      /**< A connection is being established. */
+static link_stats_t          m_stats[BLE_CONN_SCHED_LINKS_MAX]; /**< Throughput counters, by connection handle. */
+
+
+/**@brief Function for getting the approximate connection event length of a bandwidth, in
+ *        microseconds.
+ */
+static uint32_t event_len_get(uint8_t conn_bw)
+{
+    switch (conn_bw)
+    {
+        case BLE_CONN_BW_HIGH:
+            return BLE_CONN_SCHED_PACKETS_HIGH * BLE_CONN_SCHED_PACKET_PAIR_US;
+
+        case BLE_CONN_BW_MID:
+            return BLE_CONN_SCHED_PACKETS_MID * BLE_CONN_SCHED_PACKET_PAIR_US;
+
+        default:
+            return BLE_CONN_SCHED_PACKETS_LOW * BLE_CONN_SCHED_PACKET_PAIR_US;
+    }
+}
+
+
+/**@brief Function for adding a bandwidth to pool counts. */
+static void bw_count_add(ble_conn_bw_count_t * p_count, uint8_t conn_bw, uint8_t links)
+{
+    switch (conn_bw)
+    {
+        case BLE_CONN_BW_HIGH:
+            p_count->high_count += links;
+            break;
+
+        case BLE_CONN_BW_MID:
+            p_count->mid_count += links;
+            break;
+
+        default:
+            p_count->low_count += links;
+            break;
+    }
+}
+
+
+/**@brief Function for resetting the throughput counters of a link. */
+static void stats_reset(uint16_t conn_handle)
+{
+    if (conn_handle < BLE_CONN_SCHED_LINKS_MAX)
+    {
+        memset(&m_stats[conn_handle], 0, sizeof(link_stats_t));
+        (void)app_timer_cnt_get(&m_stats[conn_handle].start_ticks);
+    }
+}
+
+
+ret_code_t ble_conn_sched_init(ble_conn_sched_init_t const * p_init,
+                               ble_enable_params_t         * p_enable_params)
+{
+    uint32_t max_us;
+    uint32_t busy_us;
+    uint8_t  periph_count;
+    uint16_t interval;
+
+    VERIFY_PARAM_NOT_NULL(p_init);
+    VERIFY_PARAM_NOT_NULL(p_enable_params);
+
+    if ((p_init->link_count == 0)
+        || (p_init->link_count > p_enable_params->gap_enable_params.central_conn_count))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Pick the highest bandwidth for which the events of all the links fit in the interval.
+    max_us    = (uint32_t)p_init->max_conn_interval * CONN_INTERVAL_UNIT_US;
+    m_conn_bw = BLE_CONN_BW_HIGH;
+    while (p_init->link_count * event_len_get(m_conn_bw) > max_us)
+    {
+        if (m_conn_bw == BLE_CONN_BW_LOW)
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+        m_conn_bw--;
+    }
+
+    // Pick the shortest interval that fits the events of all the links.
+    busy_us  = p_init->link_count * event_len_get(m_conn_bw);
+    interval = (uint16_t)CEIL_DIV(busy_us, CONN_INTERVAL_UNIT_US);
+    interval = MAX(interval, BLE_GAP_CP_MIN_CONN_INTVL_MIN);
+
+    m_conn_params.min_conn_interval = interval;
+    m_conn_params.max_conn_interval = interval;
+    m_conn_params.slave_latency     = p_init->slave_latency;
+    m_conn_params.conn_sup_timeout  = p_init->conn_sup_timeout;
+
+    // Every connection takes a TX and an RX pool. Unused central connections and the peripheral
+    // connections keep the defaults of the SoftDevice.
+    periph_count = p_enable_params->gap_enable_params.periph_conn_count;
+    memset(&m_bw_counts, 0, sizeof(m_bw_counts));
+    bw_count_add(&m_bw_counts.tx_counts, m_conn_bw, p_init->link_count);
+    bw_count_add(&m_bw_counts.rx_counts, m_conn_bw, p_init->link_count);
+    bw_count_add(&m_bw_counts.tx_counts, BLE_CONN_BW_MID,
+                 p_enable_params->gap_enable_params.central_conn_count - p_init->link_count);
+    bw_count_add(&m_bw_counts.rx_counts, BLE_CONN_BW_MID,
+                 p_enable_params->gap_enable_params.central_conn_count - p_init->link_count);
+    bw_count_add(&m_bw_counts.tx_counts, BLE_CONN_BW_HIGH, periph_count);
+    bw_count_add(&m_bw_counts.rx_counts, BLE_CONN_BW_HIGH, periph_count);
+
+    p_enable_params->common_enable_params.p_conn_bw_counts = &m_bw_counts;
+
+    m_connecting = false;
+    memset(m_stats, 0, sizeof(m_stats));
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ble_conn_sched_bw_set(void)
+{
+    ble_opt_t opt;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.common_opt.conn_bw.role               = BLE_GAP_ROLE_CENTRAL;
+    opt.common_opt.conn_bw.conn_bw.conn_bw_tx = m_conn_bw;
+    opt.common_opt.conn_bw.conn_bw.conn_bw_rx = m_conn_bw;
+
+    return sd_ble_opt_set(BLE_COMMON_OPT_CONN_BW, &opt);
+}
+
+
+ble_gap_conn_params_t const * ble_conn_sched_conn_params_get(void)
+{
+    return &m_conn_params;
+}
+
+
+uint8_t ble_conn_sched_bw_get(void)
+{
+    return m_conn_bw;
+}
+
+
+ret_code_t ble_conn_sched_connect(ble_gap_addr_t const        * p_peer_addr,
+                                  ble_gap_scan_params_t const * p_scan_params)
+{
+    ret_code_t err_code;
+
+    // Only one connection is established at a time, so the SoftDevice places each new link
+    // after the ones that are already established.
+    if (m_connecting)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    err_code = sd_ble_gap_connect(p_peer_addr, p_scan_params, &m_conn_params);
+    if (err_code == NRF_SUCCESS)
+    {
+        m_connecting = true;
+    }
+    return err_code;
+}
+
+
+ret_code_t ble_conn_sched_stats_get(uint16_t                 conn_handle,
+                                    ble_conn_sched_stats_t * p_stats,
+                                    bool                     reset)
+{
+    uint32_t now;
+
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    if (conn_handle >= BLE_CONN_SCHED_LINKS_MAX)
+    {
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+
+    (void)app_timer_cnt_get(&now);
+
+    p_stats->rx_bytes = m_stats[conn_handle].rx_bytes;
+    p_stats->rx_count = m_stats[conn_handle].rx_count;
+    (void)app_timer_cnt_diff_compute(now, m_stats[conn_handle].start_ticks, &p_stats->ticks);
+
+    if (reset)
+    {
+        m_stats[conn_handle].rx_bytes    = 0;
+        m_stats[conn_handle].rx_count    = 0;
+        m_stats[conn_handle].start_ticks = now;
+    }
+    return NRF_SUCCESS;
+}
+
+
+void ble_conn_sched_on_ble_evt(ble_evt_t const * p_ble_evt)
+{
+    ble_gap_evt_t const * p_gap_evt = &p_ble_evt->evt.gap_evt;
+    ret_code_t            err_code;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            if (p_gap_evt->params.connected.role != BLE_GAP_ROLE_CENTRAL)
+            {
+                break;
+            }
+            m_connecting = false;
+            stats_reset(p_gap_evt->conn_handle);
+
+            if (p_gap_evt->params.connected.conn_params.max_conn_interval
+                != m_conn_params.max_conn_interval)
+            {
+                err_code = sd_ble_gap_conn_param_update(p_gap_evt->conn_handle, &m_conn_params);
+                UNUSED_VARIABLE(err_code);
+            }
+            break;
+
+        case BLE_GAP_EVT_TIMEOUT:
+            if (p_gap_evt->params.timeout.src == BLE_GAP_TIMEOUT_SRC_CONN)
+            {
+                m_connecting = false;
+            }
+            break;
+
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE_REQUEST:
+            // Keep the link in the packed schedule instead of the interval of the peer.
+            err_code = sd_ble_gap_conn_param_update(p_gap_evt->conn_handle, &m_conn_params);
+            UNUSED_VARIABLE(err_code);
+            break;
+
+        case BLE_GATTC_EVT_HVX:
+        {
+            uint16_t conn_handle = p_ble_evt->evt.gattc_evt.conn_handle;
+
+            if (conn_handle < BLE_CONN_SCHED_LINKS_MAX)
+            {
+                m_stats[conn_handle].rx_bytes += p_ble_evt->evt.gattc_evt.params.hvx.len;
+                m_stats[conn_handle].rx_count++;
+            }
+        } break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
@@ -0,0 +1,156 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+
+/**
+ * @file
+ *
+ * @defgroup ble_conn_sched Central connection scheduling
+ * @ingroup ble_sdk_lib
+ * @{
+ * @brief Module for packing the connections of a multilink central.
+ *
+ * @details The SoftDevice reserves a connection event length for each link, set by the bandwidth
+ *          configuration of the link, and places central links that have the same connection
+ *          interval one after the other. This module picks the highest bandwidth for which the
+ *          events of all the links fit in the maximum connection interval, and the shortest
+ *          interval that fits them, so the links share the airtime without gaps.
+ *
+ *          Every central link is given this interval: at connection, and when the peer requests
+ *          a connection parameter update. The application must not reply to
+ *          BLE_GAP_EVT_CONN_PARAM_UPDATE_REQUEST itself. Connections are established one at a
+ *          time through @ref ble_conn_sched_connect, so each new link is placed after the
+ *          existing ones.
+ *
+ *          The module also counts the notification and indication bytes received on each link.
+ *
+ *          The module must be provided with BLE events through @ref ble_conn_sched_on_ble_evt.
+ *          The app_timer module must be initialized to use the throughput counters.
+ *
+ * @note The approximate event lengths are derived from the packets per event of each bandwidth
+ *       configuration, see the SoftDevice Specification. They can be changed with the
+ *       BLE_CONN_SCHED_PACKETS_* and @ref BLE_CONN_SCHED_PACKET_PAIR_US definitions.
+ */
+
+#ifndef BLE_CONN_SCHED_H__
+#define BLE_CONN_SCHED_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "ble_gap.h"
+#include "sdk_errors.h"
+
+#ifndef BLE_CONN_SCHED_LINKS_MAX
+#define BLE_CONN_SCHED_LINKS_MAX        8       /**< Largest connection handle + 1 with throughput counters. */
+#endif
+
+#ifndef BLE_CONN_SCHED_PACKETS_LOW
+#define BLE_CONN_SCHED_PACKETS_LOW      1       /**< Packets per connection event with @ref BLE_CONN_BW_LOW. */
+#endif
+
+#ifndef BLE_CONN_SCHED_PACKETS_MID
+#define BLE_CONN_SCHED_PACKETS_MID      3       /**< Packets per connection event with @ref BLE_CONN_BW_MID. */
+#endif
+
+#ifndef BLE_CONN_SCHED_PACKETS_HIGH
+#define BLE_CONN_SCHED_PACKETS_HIGH     6       /**< Packets per connection event with @ref BLE_CONN_BW_HIGH. */
+#endif
+
+#ifndef BLE_CONN_SCHED_PACKET_PAIR_US
+#define BLE_CONN_SCHED_PACKET_PAIR_US   708     /**< Airtime of an empty central packet and a 27-byte peripheral packet, with their inter-frame spaces, in microseconds. */
+#endif
+
+/**@brief Initialization parameters. */
+typedef struct
+{
+    uint8_t  link_count;            /**< Number of central links to pack. */
+    uint16_t max_conn_interval;     /**< Longest acceptable connection interval, in units of 1.25 ms. */
+    uint16_t slave_latency;         /**< Slave latency of the links. */
+    uint16_t conn_sup_timeout;      /**< Supervision timeout of the links, in units of 10 ms. */
+} ble_conn_sched_init_t;
+
+/**@brief Throughput counters of a link. */
+typedef struct
+{
+    uint32_t rx_bytes;              /**< Bytes of notifications and indications received. */
+    uint32_t rx_count;              /**< Number of notifications and indications received. */
+    uint32_t ticks;                 /**< Time since the counters were reset, in app_timer ticks. */
+} ble_conn_sched_stats_t;
+
+/**@brief Function for computing the schedule and setting the bandwidth pools of the SoftDevice.
+ *
+ * @details Call this function before the SoftDevice is enabled. It sets the bandwidth memory pool
+ *          counts of the enable parameters: the central links get the chosen bandwidth, and the
+ *          peripheral links the default @ref BLE_CONN_BW_HIGH. The RAM needed by the
+ *          SoftDevice depends on these counts.
+ *
+ * @param[in]    p_init           Initialization parameters.
+ * @param[inout] p_enable_params  Enable parameters, with the connection counts set.
+ *
+ * @retval NRF_SUCCESS              If the schedule was computed.
+ * @retval NRF_ERROR_NULL           If a pointer is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  If the link count is 0 or larger than the central connection
+ *                                  count, or if the links do not fit in the maximum interval even
+ *                                  with @ref BLE_CONN_BW_LOW.
+ */
+ret_code_t ble_conn_sched_init(ble_conn_sched_init_t const * p_init,
+                               ble_enable_params_t         * p_enable_params);
+
+/**@brief Function for setting the bandwidth of the central connections in the SoftDevice.
+ *
+ * @details Call this function after the SoftDevice is enabled.
+ *
+ * @return The error code returned by sd_ble_opt_set.
+ */
+ret_code_t ble_conn_sched_bw_set(void);
+
+/**@brief Function for getting the connection parameters of the packed links. */
+ble_gap_conn_params_t const * ble_conn_sched_conn_params_get(void);
+
+/**@brief Function for getting the bandwidth of the central links, see @ref BLE_CONN_BWS. */
+uint8_t ble_conn_sched_bw_get(void);
+
+/**@brief Function for requesting a connection with the packed connection parameters.
+ *
+ * @param[in] p_peer_addr    Address of the peer.
+ * @param[in] p_scan_params  Scan parameters.
+ *
+ * @retval NRF_SUCCESS     If the connection request was sent.
+ * @retval NRF_ERROR_BUSY  If a connection is being established.
+ * @retval -               Any error code returned by sd_ble_gap_connect.
+ */
+ret_code_t ble_conn_sched_connect(ble_gap_addr_t const        * p_peer_addr,
+                                  ble_gap_scan_params_t const * p_scan_params);
+
+/**@brief Function for reading the throughput counters of a link.
+ *
+ * @param[in]  conn_handle  Connection handle.
+ * @param[out] p_stats      Counters.
+ * @param[in]  reset        Reset the counters after reading them.
+ *
+ * @retval NRF_SUCCESS                    If the counters were read.
+ * @retval NRF_ERROR_NULL                 If p_stats is NULL.
+ * @retval BLE_ERROR_INVALID_CONN_HANDLE  If the connection handle has no counters.
+ */
+ret_code_t ble_conn_sched_stats_get(uint16_t                 conn_handle,
+                                    ble_conn_sched_stats_t * p_stats,
+                                    bool                     reset);
+
+/**@brief Function for handling BLE events.
+ *
+ * @param[in] p_ble_evt  Event received from the BLE stack.
+ */
+void ble_conn_sched_on_ble_evt(ble_evt_t const * p_ble_evt);
+
+#endif // BLE_CONN_SCHED_H__
+
+/** @} */
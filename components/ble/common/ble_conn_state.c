@@ -17,6 +17,7 @@
 #include "ble.h"
 #include "sdk_mapped_flags.h"
 #include "app_error.h"
+#include "nordic_common.h"
 
 
 #if defined(__CC_ARM)
@@ -32,6 +33,9 @@
 #define BLE_CONN_STATE_N_DEFAULT_FLAGS 5                                                       /**< The number of flags kept for each connection, excluding user flags. */
 #define BLE_CONN_STATE_N_FLAGS (BLE_CONN_STATE_N_DEFAULT_FLAGS + BLE_CONN_STATE_N_USER_FLAGS)  /**< The number of flags kept for each connection, including user flags. */
 
+// The acquired user flags are kept in a 32-bit bitmap.
+STATIC_ASSERT(BLE_CONN_STATE_N_USER_FLAGS <= 32);
+
 
 /**@brief Structure containing all the flag collections maintained by the Connection State module.
  */
@@ -80,61 +84,115 @@ void bcs_internal_state_reset(void)
 }
 
 
-/**@brief Function for activating a connection record.
+/**@brief Function for getting the state of a flag in a collection by record index.
  *
- * @param p_record     The record to activate.
- * @param conn_handle  The connection handle to copy into the record.
- * @param role         The role of the connection.
+ * @param[in]  flags  The flag collection.
+ * @param[in]  index  The record index, or @ref SDK_MAPPED_FLAGS_INVALID_INDEX.
  *
- * @return whether the record was activated successfully.
+ * @return  The state of the flag, false if the index is invalid.
  */
-static bool record_activate(uint16_t conn_handle)
+static bool flag_get(sdk_mapped_flags_t flags, uint16_t index)
 {
-    uint16_t available_index = sdk_mapped_flags_first_key_index_get(~m_bcs.flags.valid_flags);
+    return (index < SDK_MAPPED_FLAGS_N_KEYS) && ((flags & (1UL << index)) != 0);
+}
 
-    if (available_index != SDK_MAPPED_FLAGS_INVALID_INDEX)
+
+/**@brief Function for setting the state of a flag in a collection by record index.
+ *
+ * @param[out] p_flags  The flag collection.
+ * @param[in]  index    The record index, or @ref SDK_MAPPED_FLAGS_INVALID_INDEX.
+ * @param[in]  value    The state to set the flag to.
+ */
+static void flag_update(sdk_mapped_flags_t * p_flags, uint16_t index, bool value)
+{
+    if (index < SDK_MAPPED_FLAGS_N_KEYS)
     {
-        m_bcs.valid_conn_handles[available_index] = conn_handle;
-        sdk_mapped_flags_update_by_key(m_bcs.valid_conn_handles,
-                                      &m_bcs.flags.connected_flags,
-                                       conn_handle,
-                                       1);
-        sdk_mapped_flags_update_by_key(m_bcs.valid_conn_handles,
-                                      &m_bcs.flags.valid_flags,
-                                       conn_handle,
-                                       1);
-
-        return true;
+        if (value)
+        {
+            *p_flags |= (sdk_mapped_flags_t)(1UL << index);
+        }
+        else
+        {
+            *p_flags &= (sdk_mapped_flags_t)~(1UL << index);
+        }
     }
+}
+
 
-    return false;
+/**@brief Function for finding the record of a connection handle.
+ *
+ * @details Records are placed at the index equal to their connection handle when possible (see
+ *          @ref record_activate), so the connection handles assigned by the SoftDevice are found
+ *          without searching the key list.
+ *
+ * @param[in]  conn_handle  The connection handle.
+ *
+ * @return  The index of the valid record of the connection handle, or
+ *          @ref SDK_MAPPED_FLAGS_INVALID_INDEX if there is none.
+ */
+static uint16_t record_index_get(uint16_t conn_handle)
+{
+    if (   (conn_handle < SDK_MAPPED_FLAGS_N_KEYS)
+        && (m_bcs.valid_conn_handles[conn_handle] == conn_handle)
+        && flag_get(m_bcs.flags.valid_flags, conn_handle))
+    {
+        return conn_handle;
+    }
+
+    for (uint16_t i = 0; i < SDK_MAPPED_FLAGS_N_KEYS; i++)
+    {
+        if ((m_bcs.valid_conn_handles[i] == conn_handle) && flag_get(m_bcs.flags.valid_flags, i))
+        {
+            return i;
+        }
+    }
+
+    return SDK_MAPPED_FLAGS_INVALID_INDEX;
 }
 
 
-/**@brief Function for marking a connection record as invalid and resetting the values.
+/**@brief Function for activating a connection record.
+ *
+ * @param conn_handle  The connection handle to copy into the record.
  *
- * @param p_record  The record to invalidate.
+ * @return  The index of the activated record, or @ref SDK_MAPPED_FLAGS_INVALID_INDEX if no
+ *          record was available.
  */
-static void record_invalidate(uint16_t conn_handle)
+static uint16_t record_activate(uint16_t conn_handle)
 {
-    sdk_mapped_flags_bulk_update_by_key(m_bcs.valid_conn_handles,
-                                        m_bcs.flag_array,
-                                        BLE_CONN_STATE_N_FLAGS,
-                                        conn_handle,
-                                        0);
+    uint16_t available_index;
+
+    if ((conn_handle < SDK_MAPPED_FLAGS_N_KEYS) && !flag_get(m_bcs.flags.valid_flags, conn_handle))
+    {
+        // Direct-indexed record, see @ref record_index_get.
+        available_index = conn_handle;
+    }
+    else
+    {
+        available_index = sdk_mapped_flags_first_key_index_get(~m_bcs.flags.valid_flags);
+    }
+
+    if (available_index != SDK_MAPPED_FLAGS_INVALID_INDEX)
+    {
+        m_bcs.valid_conn_handles[available_index] = conn_handle;
+        flag_update(&m_bcs.flags.connected_flags, available_index, true);
+        flag_update(&m_bcs.flags.valid_flags,     available_index, true);
+    }
+
+    return available_index;
 }
 
 
-/**@brief Function for marking a connection as disconnected. See @ref BLE_CONN_STATUS_DISCONNECTED.
+/**@brief Function for marking a connection record as invalid and resetting the values.
  *
- * @param p_record   The record of the connection to set as disconnected.
+ * @param index  The index of the record to invalidate.
  */
-static void record_set_disconnected(uint16_t conn_handle)
+static void record_invalidate(uint16_t index)
 {
-    sdk_mapped_flags_update_by_key(m_bcs.valid_conn_handles,
-                                  &m_bcs.flags.connected_flags,
-                                   conn_handle,
-                                   0);
+    for (uint32_t i = 0; i < BLE_CONN_STATE_N_FLAGS; i++)
+    {
+        flag_update(&m_bcs.flag_array[i], index, false);
+    }
 }
 
 
@@ -143,15 +201,16 @@ static void record_set_disconnected(uint16_t conn_handle)
  */
 static void record_purge_disconnected()
 {
-    sdk_mapped_flags_key_list_t disconnected_list;
+    sdk_mapped_flags_t disconnected_flags;
 
-    disconnected_list = sdk_mapped_flags_key_list_get(
-                                   m_bcs.valid_conn_handles,
-                                 (~m_bcs.flags.connected_flags) & (m_bcs.flags.valid_flags));
+    disconnected_flags = (~m_bcs.flags.connected_flags) & (m_bcs.flags.valid_flags);
 
-    for (uint32_t i = 0; i < disconnected_list.len; i++)
+    for (uint16_t i = 0; i < SDK_MAPPED_FLAGS_N_KEYS; i++)
     {
-        record_invalidate(disconnected_list.flag_keys[i]);
+        if (flag_get(disconnected_flags, i))
+        {
+            record_invalidate(i);
+        }
     }
 }
 
@@ -164,7 +223,7 @@ static void record_purge_disconnected()
  */
 static bool user_flag_is_acquired(ble_conn_state_user_flag_id_t flag_id)
 {
-    return ((m_bcs.acquired_flags & (1 << flag_id)) != 0);
+    return ((flag_id < BLE_CONN_STATE_N_USER_FLAGS) && ((m_bcs.acquired_flags & (1UL << flag_id)) != 0));
 }
 
 
@@ -174,7 +233,7 @@ static bool user_flag_is_acquired(ble_conn_state_user_flag_id_t flag_id)
  */
 static void user_flag_acquire(ble_conn_state_user_flag_id_t flag_id)
 {
-    m_bcs.acquired_flags |= (1 << flag_id);
+    m_bcs.acquired_flags |= (1UL << flag_id);
 }
 
 
@@ -186,12 +245,16 @@ void ble_conn_state_init(void)
 
 void ble_conn_state_on_ble_evt(ble_evt_t * p_ble_evt)
 {
+    uint16_t index;
+
     switch (p_ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_CONNECTED:
             record_purge_disconnected();
 
-            if ( !record_activate(p_ble_evt->evt.gap_evt.conn_handle) )
+            index = record_activate(p_ble_evt->evt.gap_evt.conn_handle);
+
+            if (index == SDK_MAPPED_FLAGS_INVALID_INDEX)
             {
                 // No more records available. Should not happen.
                 APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
@@ -201,29 +264,24 @@ void ble_conn_state_on_ble_evt(ble_evt_t * p_ble_evt)
                 bool is_central =
                         (p_ble_evt->evt.gap_evt.params.connected.role == BLE_GAP_ROLE_CENTRAL);
 
-                sdk_mapped_flags_update_by_key(m_bcs.valid_conn_handles,
-                                              &m_bcs.flags.central_flags,
-                                               p_ble_evt->evt.gap_evt.conn_handle,
-                                               is_central);
+                flag_update(&m_bcs.flags.central_flags, index, is_central);
             }
 
             break;
 
         case BLE_GAP_EVT_DISCONNECTED:
-            record_set_disconnected(p_ble_evt->evt.gap_evt.conn_handle);
+            index = record_index_get(p_ble_evt->evt.gap_evt.conn_handle);
+            flag_update(&m_bcs.flags.connected_flags, index, false);
             break;
 
         case BLE_GAP_EVT_CONN_SEC_UPDATE:
-            sdk_mapped_flags_update_by_key(
-                          m_bcs.valid_conn_handles,
-                         &m_bcs.flags.encrypted_flags,
-                          p_ble_evt->evt.gap_evt.conn_handle,
-                         (p_ble_evt->evt.gap_evt.params.conn_sec_update.conn_sec.sec_mode.lv > 1));
-            sdk_mapped_flags_update_by_key(
-                          m_bcs.valid_conn_handles,
-                         &m_bcs.flags.mitm_protected_flags,
-                          p_ble_evt->evt.gap_evt.conn_handle,
-                         (p_ble_evt->evt.gap_evt.params.conn_sec_update.conn_sec.sec_mode.lv > 2));
+            index = record_index_get(p_ble_evt->evt.gap_evt.conn_handle);
+            flag_update(&m_bcs.flags.encrypted_flags,
+                         index,
+                        (p_ble_evt->evt.gap_evt.params.conn_sec_update.conn_sec.sec_mode.lv > 1));
+            flag_update(&m_bcs.flags.mitm_protected_flags,
+                         index,
+                        (p_ble_evt->evt.gap_evt.params.conn_sec_update.conn_sec.sec_mode.lv > 2));
             break;
     }
 }
@@ -231,21 +289,18 @@ void ble_conn_state_on_ble_evt(ble_evt_t * p_ble_evt)
 
 bool ble_conn_state_valid(uint16_t conn_handle)
 {
-    return sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                       m_bcs.flags.valid_flags,
-                                       conn_handle);
+    return (record_index_get(conn_handle) != SDK_MAPPED_FLAGS_INVALID_INDEX);
 }
 
 
 uint8_t ble_conn_state_role(uint16_t conn_handle)
 {
-    uint8_t role = BLE_GAP_ROLE_INVALID;
+    uint8_t  role  = BLE_GAP_ROLE_INVALID;
+    uint16_t index = record_index_get(conn_handle);
 
-    if ( sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles, m_bcs.flags.valid_flags, conn_handle) )
+    if (index != SDK_MAPPED_FLAGS_INVALID_INDEX)
     {
-        bool central = sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                                   m_bcs.flags.central_flags,
-                                                   conn_handle);
+        bool central = flag_get(m_bcs.flags.central_flags, index);
 
         role = central ? BLE_GAP_ROLE_CENTRAL : BLE_GAP_ROLE_PERIPH;
     }
@@ -257,15 +312,11 @@ uint8_t ble_conn_state_role(uint16_t conn_handle)
 ble_conn_state_status_t ble_conn_state_status(uint16_t conn_handle)
 {
     ble_conn_state_status_t conn_status = BLE_CONN_STATUS_INVALID;
-    bool valid = sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                             m_bcs.flags.valid_flags,
-                                             conn_handle);
+    uint16_t                index       = record_index_get(conn_handle);
 
-    if (valid)
+    if (index != SDK_MAPPED_FLAGS_INVALID_INDEX)
     {
-        bool connected = sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                                     m_bcs.flags.connected_flags,
-                                                     conn_handle);
+        bool connected = flag_get(m_bcs.flags.connected_flags, index);
 
         conn_status = connected ? BLE_CONN_STATUS_CONNECTED : BLE_CONN_STATUS_DISCONNECTED;
     }
@@ -276,17 +327,13 @@ ble_conn_state_status_t ble_conn_state_status(uint16_t conn_handle)
 
 bool ble_conn_state_encrypted(uint16_t conn_handle)
 {
-    return sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                       m_bcs.flags.encrypted_flags,
-                                       conn_handle);
+    return flag_get(m_bcs.flags.encrypted_flags, record_index_get(conn_handle));
 }
 
 
 bool ble_conn_state_mitm_protected(uint16_t conn_handle)
 {
-    return sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                       m_bcs.flags.mitm_protected_flags,
-                                       conn_handle);
+    return flag_get(m_bcs.flags.mitm_protected_flags, record_index_get(conn_handle));
 }
 
 
@@ -349,9 +396,7 @@ bool ble_conn_state_user_flag_get(uint16_t conn_handle, ble_conn_state_user_flag
 {
     if (user_flag_is_acquired(flag_id))
     {
-        return sdk_mapped_flags_get_by_key(m_bcs.valid_conn_handles,
-                                           m_bcs.flags.user_flags[flag_id],
-                                           conn_handle);
+        return flag_get(m_bcs.flags.user_flags[flag_id], record_index_get(conn_handle));
     }
     else
     {
@@ -366,10 +411,7 @@ void ble_conn_state_user_flag_set(uint16_t                      conn_handle,
 {
     if (user_flag_is_acquired(flag_id))
     {
-        sdk_mapped_flags_update_by_key(m_bcs.valid_conn_handles,
-                                      &m_bcs.flags.user_flags[flag_id],
-                                       conn_handle,
-                                       value);
+        flag_update(&m_bcs.flags.user_flags[flag_id], record_index_get(conn_handle), value);
     }
 }
 
@@ -54,7 +54,9 @@ typedef enum
     BLE_CONN_STATUS_CONNECTED,     /**< The connection handle refers to an active connection. */
 } ble_conn_state_status_t;
 
-#define BLE_CONN_STATE_N_USER_FLAGS 24  /**< The number of available user flags. */
+#ifndef BLE_CONN_STATE_N_USER_FLAGS
+#define BLE_CONN_STATE_N_USER_FLAGS 24  /**< The number of available user flags. Can be raised to at most 32, at the cost of one flag collection per flag. */
+#endif
 
 
 /**@brief One ID for each user flag collection.
@@ -87,7 +89,15 @@ typedef enum
     BLE_CONN_STATE_USER_FLAG21,
     BLE_CONN_STATE_USER_FLAG22,
     BLE_CONN_STATE_USER_FLAG23,
-    BLE_CONN_STATE_USER_FLAG_INVALID,
+    BLE_CONN_STATE_USER_FLAG24,
+    BLE_CONN_STATE_USER_FLAG25,
+    BLE_CONN_STATE_USER_FLAG26,
+    BLE_CONN_STATE_USER_FLAG27,
+    BLE_CONN_STATE_USER_FLAG28,
+    BLE_CONN_STATE_USER_FLAG29,
+    BLE_CONN_STATE_USER_FLAG30,
+    BLE_CONN_STATE_USER_FLAG31,
+    BLE_CONN_STATE_USER_FLAG_INVALID = BLE_CONN_STATE_N_USER_FLAGS, /**< Never returned as an acquired flag. Equal to the first flag beyond @ref BLE_CONN_STATE_N_USER_FLAGS. */
 } ble_conn_state_user_flag_id_t;
 
 
@@ -126,11 +126,8 @@ uint32_t characteristic_add(uint16_t                   service_handle,
     attr_char_value.p_uuid    = &char_uuid;
     attr_char_value.p_attr_md = &attr_md;
     attr_char_value.max_len   = p_char_props->max_len;
-    if (p_char_props->p_init_value != NULL)
-    {
-        attr_char_value.init_len  = p_char_props->init_len;
-        attr_char_value.p_value   = p_char_props->p_init_value;
-    }
+    attr_char_value.init_len  = p_char_props->init_len;
+    attr_char_value.p_value   = p_char_props->p_init_value;
     if (p_char_props->p_user_descr != NULL)
     {
         memset(&user_descr_attr_md, 0, sizeof(ble_gatts_attr_md_t));
@@ -195,3 +192,116 @@ uint32_t descriptor_add(uint16_t                   char_handle,
 
     return sd_ble_gatts_descriptor_add(char_handle, &descr_params, p_descr_handle);
 }
+
+
+uint32_t ble_srv_table_add(ble_srv_table_entry_t const * p_table,
+                           uint32_t                      entry_count,
+                           uint8_t const *               p_uuid_types,
+                           void *                        p_service)
+{
+    uint32_t                   err_code       = NRF_SUCCESS;
+    uint16_t                   service_handle = BLE_GATT_HANDLE_INVALID;
+    uint16_t                   char_handle    = BLE_GATT_HANDLE_INVALID;
+    ble_gatts_char_handles_t   char_handles;
+    uint16_t                   handle;
+    uint8_t                    uuid_type;
+
+    for (uint32_t i = 0; (i < entry_count) && (err_code == NRF_SUCCESS); i++)
+    {
+        ble_srv_table_entry_t const * p_entry = &p_table[i];
+        uint8_t                     * p_dest  = NULL;
+
+        uuid_type = (p_entry->uuid_type == 0) ? BLE_UUID_TYPE_BLE : p_uuid_types[p_entry->uuid_type - 1];
+
+        if (p_entry->handle_offset != BLE_SRV_TABLE_NO_HANDLE)
+        {
+            p_dest = (uint8_t *)p_service + p_entry->handle_offset;
+        }
+
+        switch (p_entry->type)
+        {
+            case BLE_SRV_TABLE_SERVICE:
+            {
+                ble_uuid_t service_uuid;
+
+                service_uuid.type = uuid_type;
+                service_uuid.uuid = p_entry->uuid;
+
+                err_code = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY,
+                                                    &service_uuid,
+                                                    &service_handle);
+                char_handle = BLE_GATT_HANDLE_INVALID;
+                if ((err_code == NRF_SUCCESS) && (p_dest != NULL))
+                {
+                    memcpy(p_dest, &service_handle, sizeof(service_handle));
+                }
+            } break;
+
+            case BLE_SRV_TABLE_CHAR:
+            {
+                ble_add_char_params_t add_char_params;
+
+                if (service_handle == BLE_GATT_HANDLE_INVALID)
+                {
+                    return NRF_ERROR_INVALID_PARAM;
+                }
+
+                memset(&add_char_params, 0, sizeof(add_char_params));
+                add_char_params.uuid              = p_entry->uuid;
+                add_char_params.uuid_type         = uuid_type;
+                add_char_params.max_len           = p_entry->max_len;
+                add_char_params.init_len          = p_entry->init_len;
+                add_char_params.p_init_value      = (uint8_t *)p_entry->p_init_value;
+                add_char_params.is_var_len        = p_entry->is_var_len;
+                add_char_params.char_props        = p_entry->char_props;
+                add_char_params.is_defered_read   = p_entry->is_defered_read;
+                add_char_params.is_defered_write  = p_entry->is_defered_write;
+                add_char_params.read_access       = (security_req_t)p_entry->read_access;
+                add_char_params.write_access      = (security_req_t)p_entry->write_access;
+                add_char_params.cccd_write_access = (security_req_t)p_entry->cccd_write_access;
+                add_char_params.is_value_user     = p_entry->is_value_user;
+
+                err_code = characteristic_add(service_handle, &add_char_params, &char_handles);
+                char_handle = char_handles.value_handle;
+                if ((err_code == NRF_SUCCESS) && (p_dest != NULL))
+                {
+                    memcpy(p_dest, &char_handles, sizeof(char_handles));
+                }
+            } break;
+
+            case BLE_SRV_TABLE_DESCR:
+            {
+                ble_add_descr_params_t add_descr_params;
+
+                if (char_handle == BLE_GATT_HANDLE_INVALID)
+                {
+                    return NRF_ERROR_INVALID_PARAM;
+                }
+
+                memset(&add_descr_params, 0, sizeof(add_descr_params));
+                add_descr_params.uuid             = p_entry->uuid;
+                add_descr_params.uuid_type        = uuid_type;
+                add_descr_params.is_defered_read  = p_entry->is_defered_read;
+                add_descr_params.is_defered_write = p_entry->is_defered_write;
+                add_descr_params.is_var_len       = p_entry->is_var_len;
+                add_descr_params.read_access      = (security_req_t)p_entry->read_access;
+                add_descr_params.write_access     = (security_req_t)p_entry->write_access;
+                add_descr_params.is_value_user    = p_entry->is_value_user;
+                add_descr_params.init_len         = p_entry->init_len;
+                add_descr_params.max_len          = p_entry->max_len;
+                add_descr_params.p_value          = (uint8_t *)p_entry->p_init_value;
+
+                err_code = descriptor_add(char_handle, &add_descr_params, &handle);
+                if ((err_code == NRF_SUCCESS) && (p_dest != NULL))
+                {
+                    memcpy(p_dest, &handle, sizeof(handle));
+                }
+            } break;
+
+            default:
+                return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return err_code;
+}
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "ble_types.h"
 #include "app_util.h"
 #include "ble.h"
@@ -299,7 +300,7 @@ typedef struct
     uint8_t                     uuid_type;                /**< Base UUID. If 0, the Bluetooth SIG UUID will be used. Otherwise, this should be a value returned by @ref sd_ble_uuid_vs_add when adding the base UUID.*/
     uint16_t                    max_len;                  /**< Maximum length of the characteristic value.*/
     uint16_t                    init_len;                 /**< Initial length of the characteristic value.*/
-    uint8_t *                   p_init_value;             /**< Initial encoded value of the characteristic.*/
+    uint8_t *                   p_init_value;             /**< Initial encoded value of the characteristic, or NULL for init_len zeros.*/
     bool                        is_var_len;               /**< Indicates if the characteristic value has variable length.*/
     ble_gatt_char_props_t       char_props;               /**< Characteristic properties.*/
     bool                        is_defered_read;          /**< Indicate if deferred read operations are supported.*/
@@ -362,6 +363,94 @@ uint32_t descriptor_add(uint16_t                   char_handle,
                         uint16_t *                 p_descr_handle);
 
 
+/** @defgroup BLE_SRV_TABLE GATT table registration
+ * @{
+ * @brief Registration of services, characteristics, and descriptors from a const table.
+ *
+ * @details A service describes its attributes once, in a const table in flash, instead of
+ *          filling the SoftDevice structures in one function per characteristic. The table is
+ *          walked by @ref ble_srv_table_add, which stores the handles given by the SoftDevice in
+ *          the service structure at the offsets given in the table, so one table serves all
+ *          instances of the service. Characteristics are added to the last service of the table,
+ *          and descriptors to the last characteristic.
+ *
+ * @code
+ * static const ble_srv_table_entry_t m_table[] =
+ * {
+ *     {
+ *         .type          = BLE_SRV_TABLE_SERVICE,
+ *         .uuid          = BLE_UUID_BATTERY_SERVICE,
+ *         .handle_offset = offsetof(my_service_t, service_handle),
+ *     },
+ *     {
+ *         .type              = BLE_SRV_TABLE_CHAR,
+ *         .uuid              = BLE_UUID_BATTERY_LEVEL_CHAR,
+ *         .handle_offset     = offsetof(my_service_t, level_handles),
+ *         .char_props        = {.read = 1, .notify = 1},
+ *         .read_access       = SEC_OPEN,
+ *         .cccd_write_access = SEC_OPEN,
+ *         .max_len           = sizeof(uint8_t),
+ *         .init_len          = sizeof(uint8_t),
+ *     },
+ * };
+ *
+ * err_code = ble_srv_table_add(m_table, sizeof(m_table) / sizeof(m_table[0]), NULL, p_service);
+ * @endcode
+ */
+
+#define BLE_SRV_TABLE_NO_HANDLE     0xFFFF  /**< Handle offset of an entry whose handle is not stored. */
+
+/**@brief GATT table entry types. */
+typedef enum
+{
+    BLE_SRV_TABLE_SERVICE,                  /**< Primary service. */
+    BLE_SRV_TABLE_CHAR,                     /**< Characteristic of the last service. */
+    BLE_SRV_TABLE_DESCR                     /**< Descriptor of the last characteristic. */
+} ble_srv_table_type_t;
+
+/**@brief GATT table entry. Fields that do not apply to the entry type are ignored. */
+typedef struct
+{
+    uint8_t               type;                  /**< Entry type, see @ref ble_srv_table_type_t. */
+    uint8_t               uuid_type;             /**< 0 for a Bluetooth SIG UUID. Otherwise, index + 1 of the UUID type in the array passed to @ref ble_srv_table_add. */
+    uint16_t              uuid;                  /**< 16-bit UUID. */
+    uint16_t              handle_offset;         /**< Offset of the handle in the service structure, or @ref BLE_SRV_TABLE_NO_HANDLE. The handle is a ble_gatts_char_handles_t for characteristics and a uint16_t otherwise. */
+    ble_gatt_char_props_t char_props;            /**< Characteristic properties. */
+    uint8_t               read_access       : 3; /**< Security requirement for reading the value, see @ref security_req_t. */
+    uint8_t               write_access      : 3; /**< Security requirement for writing the value, see @ref security_req_t. */
+    uint8_t               cccd_write_access : 3; /**< Security requirement for writing the CCCD of a characteristic with notify or indicate, see @ref security_req_t. */
+    uint8_t               is_var_len        : 1; /**< The value has variable length. */
+    uint8_t               is_defered_read   : 1; /**< Deferred read operations are supported. */
+    uint8_t               is_defered_write  : 1; /**< Deferred write operations are supported. */
+    uint8_t               is_value_user     : 1; /**< The value is stored in the application, at p_init_value. */
+    uint16_t              max_len;               /**< Maximum length of the value. */
+    uint16_t              init_len;              /**< Initial length of the value. */
+    void const *          p_init_value;          /**< Initial value, or NULL for zeros. Copied by the SoftDevice unless is_value_user is set. */
+} ble_srv_table_entry_t;
+
+/**@brief Function for adding the services, characteristics, and descriptors of a GATT table.
+ *
+ * @param[in]  p_table       GATT table.
+ * @param[in]  entry_count   Number of entries in the table.
+ * @param[in]  p_uuid_types  UUID types returned by @ref sd_ble_uuid_vs_add, indexed by the
+ *                           uuid_type field of the entries minus one. Can be NULL if the table
+ *                           only has Bluetooth SIG UUIDs.
+ * @param[out] p_service     Service structure where the handles are stored.
+ *
+ * @retval NRF_SUCCESS              If all entries were added.
+ * @retval NRF_ERROR_INVALID_PARAM  If a characteristic comes before the first service, or a
+ *                                  descriptor before the first characteristic.
+ * @retval -                        Any error code of the SoftDevice. The entries before the
+ *                                  failing one are added.
+ */
+uint32_t ble_srv_table_add(ble_srv_table_entry_t const * p_table,
+                           uint32_t                      entry_count,
+                           uint8_t const *               p_uuid_types,
+                           void *                        p_service);
+
+/** @} */
+
+
 #endif // BLE_SRV_COMMON_H__
 
 /** @} */
@@ -71,6 +71,21 @@
 #include "ble_gap.h"
 #include "device_manager_cnfg.h"
 
+/**
+ * @brief Write batching.
+ *
+ * @details When set to 1, the module keeps a copy of the device context last written to each
+ *          bond block, and writes only the parts of the context that changed. The parts written
+ *          by one store operation are applied with @ref pstorage_update_batch, which erases the
+ *          flash page once for all of them. Service context updates requested with
+ *          @ref dm_service_context_set are written on disconnection, or when the flush timeout
+ *          given in @ref dm_init_param_t expires. No event is notified for parts that are not
+ *          written. Requires the app_timer module when a flush timeout is used.
+ */
+#ifndef DEVICE_MANAGER_WRITE_BATCHING
+#define DEVICE_MANAGER_WRITE_BATCHING   0
+#endif
+
 /**
  * @defgroup dm_service_cntext_types Service/Protocol Types
  *
@@ -378,12 +393,13 @@ typedef ret_code_t (*dm_event_cb_t)(dm_handle_t const * p_handle,
 /**
  * @brief Initialization Parameters.
  *
- * @details Indicates the application parameters. Currently this only encompasses clearing
- *          all persistent data.
+ * @details Indicates the application parameters: clearing all persistent data, and the flush
+ *          timeout of deferred context updates.
  */
 typedef struct
 {
-    bool clear_persistent_data; /**< Set to true in case the module should clear all persistent data. */
+    bool     clear_persistent_data; /**< Set to true in case the module should clear all persistent data. */
+    uint32_t flush_timeout_ticks;   /**< Time in app_timer ticks after which a deferred service context update is written while the peer is connected. 0 to write it on disconnection only. Used when @ref DEVICE_MANAGER_WRITE_BATCHING is 1. */
 } dm_init_param_t;
 
 /**
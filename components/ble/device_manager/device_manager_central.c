@@ -15,6 +15,9 @@
 #include "pstorage.h"
 #include "ble_hci.h"
 #include "app_error.h"
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+#include "app_timer.h"
+#endif // DEVICE_MANAGER_WRITE_BATCHING
 
 #define INVALID_ADDR_TYPE 0xFF /**< Identifier for an invalid address type. */
 
@@ -171,6 +174,17 @@ typedef enum
 
 #define DM_GATTS_INVALID_SIZE        0xFFFFFFFF                                     /**< Identifer for GATTS invalid size. */
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+#define DM_BATCH_MAX_UPDATES         3                                                   /**< Maximum number of updates in a batch: peer identification, bond information and service context. */
+#define DM_UPDATE_QUEUE_SIZE         4                                                   /**< Maximum number of batches waiting to be written. */
+#define DM_DEVICE_CACHE_SIZE         (DEVICE_CONTEXT_SIZE + SERVICE_CONTEXT_SIZE)        /**< Size of the cached part of a device block. */
+#define DM_CONTEXT_STORE             device_cache_store                                  /**< Function for storing a part of the device context in an empty block. */
+#define DM_CONTEXT_UPDATE            update_batch_add                                    /**< Function for updating a part of the device context. */
+#else
+#define DM_CONTEXT_STORE             pstorage_store                                      /**< Function for storing a part of the device context in an empty block. */
+#define DM_CONTEXT_UPDATE            pstorage_update                                     /**< Function for updating a part of the device context. */
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
 /**
  * @defgroup api_param_check API Parameters check macros.
  *
@@ -425,6 +439,15 @@ typedef uint32_t (* storage_operation)(pstorage_handle_t * p_dest,
                                        uint8_t           * p_src,
                                        pstorage_size_t     size,
                                        pstorage_size_t     offset);
+
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+/**@brief Updates of a device block applied with one batched update. */
+typedef struct
+{
+    pstorage_update_desc_t update[DM_BATCH_MAX_UPDATES]; /**< Updates, sorted by offset. Must stay resident until notified. */
+    uint32_t               count;                        /**< Number of updates. */
+} update_batch_t;
+#endif // DEVICE_MANAGER_WRITE_BATCHING
 /** @} */
 
 /**
@@ -446,6 +469,18 @@ static pstorage_handle_t       m_storage_handle;
 static uint32_t                m_peer_addr_update;                                    /**< 32-bit bitmap to remember peer device address update. */
 static ble_gap_id_key_t        m_local_id_info;                                       /**< ID information of central in case resolvable address is used. */
 static bool                    m_module_initialized = false;                          /**< State indicating if module is initialized or not. */
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+__ALIGN(sizeof(uint32_t))
+static uint8_t                 m_device_cache[DEVICE_MANAGER_MAX_BONDS][DM_DEVICE_CACHE_SIZE]; /**< Copy of the context last written to each device block. */
+static uint32_t                m_device_cache_invalid;                                /**< Bitmap of devices whose cache may differ from flash, because a write failed. */
+static update_batch_t          m_update_batch;                                        /**< Batch being built by a store operation. */
+static update_batch_t          m_update_queue[DM_UPDATE_QUEUE_SIZE];                  /**< Batches handed to pstorage, in the order they are notified. */
+static uint32_t                m_update_queue_rp;                                     /**< Index of the oldest batch in the queue. */
+static uint32_t                m_update_queue_count;                                  /**< Number of batches in the queue. */
+static uint32_t                m_context_update_pending;                              /**< Bitmap of connection instances with a deferred service context update. */
+static uint32_t                m_flush_timeout_ticks;                                 /**< Time after which deferred updates are written, in app_timer ticks. */
+APP_TIMER_DEF(m_flush_timer_id);                                                      /**< Timer writing the deferred updates of connected peers. */
+#endif // DEVICE_MANAGER_WRITE_BATCHING
 
 SDK_MUTEX_DEFINE(m_dm_mutex) /**< Mutex variable. Currently unused, this declaration does not occupy any space in RAM. */
 /** @} */
@@ -547,6 +582,225 @@ static __INLINE bool update_status_bit_is_set(uint32_t index)
 }
 
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+/**@brief Function for resetting the cache of a device whose block is cleared.
+ *
+ * @param[in] index Device identifier.
+ */
+static __INLINE void device_cache_reset(uint32_t index)
+{
+    memset(m_device_cache[index], 0xFF, DM_DEVICE_CACHE_SIZE);
+    m_device_cache_invalid &= (~((uint32_t)BIT_0 << index));
+}
+
+
+/**@brief Function for marking the cache of a device as possibly different from flash. Writes to
+ *        the device block are no longer skipped until the block is cleared.
+ *
+ * @param[in] index Device identifier.
+ */
+static __INLINE void device_cache_invalidate(uint32_t index)
+{
+    m_device_cache_invalid |= (BIT_0 << index);
+}
+
+
+/**@brief Function for providing the device identifier of a storage block.
+ *
+ * @param[in] p_block Storage block identifier.
+ *
+ * @retval Device identifier.
+ */
+static __INLINE uint32_t device_index_get(pstorage_handle_t const * p_block)
+{
+    return (p_block->block_id - m_storage_handle.block_id) / ALL_CONTEXT_SIZE;
+}
+
+
+/**@brief Function for storing a part of the device context in an empty block, and in the cache.
+ *
+ * @details Same parameters and return value as @ref pstorage_store.
+ */
+static uint32_t device_cache_store(pstorage_handle_t * p_dest,
+                                   uint8_t           * p_src,
+                                   pstorage_size_t     size,
+                                   pstorage_size_t     offset)
+{
+    uint32_t err_code = pstorage_store(p_dest, p_src, size, offset);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        memcpy(&m_device_cache[device_index_get(p_dest)][offset], p_src, size);
+    }
+
+    return err_code;
+}
+
+
+/**@brief Function for adding an update of a part of the device context to the batch being built.
+ *
+ * @details Same parameters as @ref pstorage_update. The update is skipped if the data is the same
+ *          as last written to the block, unless the application has requested an update of the
+ *          peer address.
+ *
+ * @retval NRF_SUCCESS      If the update was added to the batch, or skipped.
+ * @retval NRF_ERROR_NO_MEM If the batch is full.
+ */
+static uint32_t update_batch_add(pstorage_handle_t * p_dest,
+                                 uint8_t           * p_src,
+                                 pstorage_size_t     size,
+                                 pstorage_size_t     offset)
+{
+    pstorage_update_desc_t * p_update;
+    uint32_t const           index = device_index_get(p_dest);
+
+    if (((m_device_cache_invalid & (BIT_0 << index)) == 0) &&
+        (memcmp(&m_device_cache[index][offset], p_src, size) == 0) &&
+        ((offset != PEER_ID_STORAGE_OFFSET) || (update_status_bit_is_set(index) == false)))
+    {
+        DM_LOG("[DM]:[0x%02X]: No change at offset 0x%04X, update skipped.\r\n", index, offset);
+        return NRF_SUCCESS;
+    }
+
+    if (m_update_batch.count == DM_BATCH_MAX_UPDATES)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    memcpy(&m_device_cache[index][offset], p_src, size);
+
+    p_update           = &m_update_batch.update[m_update_batch.count++];
+    p_update->block_id = (*p_dest);
+    p_update->p_src    = p_src;
+    p_update->size     = size;
+    p_update->offset   = offset;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for writing the batch built by a store operation.
+ *
+ * @details The batch is kept in a queue until pstorage notifies its last update. If the device
+ *          block spans two flash pages, the updates are applied one by one.
+ */
+static void update_batch_commit(void)
+{
+    update_batch_t * p_batch;
+    uint32_t         index;
+    uint32_t         queued   = 0;
+    uint32_t         err_code = NRF_ERROR_NO_MEM;
+
+    if (m_update_batch.count == 0)
+    {
+        return;
+    }
+
+    index = device_index_get(&m_update_batch.update[0].block_id);
+
+    if (m_update_queue_count < DM_UPDATE_QUEUE_SIZE)
+    {
+        p_batch    = &m_update_queue[(m_update_queue_rp + m_update_queue_count) %
+                                     DM_UPDATE_QUEUE_SIZE];
+        (*p_batch) = m_update_batch;
+
+        err_code = pstorage_update_batch(p_batch->update, p_batch->count);
+
+        if (err_code == NRF_SUCCESS)
+        {
+            queued = p_batch->count;
+        }
+        else if (err_code == NRF_ERROR_INVALID_PARAM)
+        {
+            for (queued = 0; queued < p_batch->count; queued++)
+            {
+                err_code = pstorage_update(&p_batch->update[queued].block_id,
+                                           p_batch->update[queued].p_src,
+                                           p_batch->update[queued].size,
+                                           p_batch->update[queued].offset);
+                if (err_code != NRF_SUCCESS)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (queued != 0)
+        {
+            p_batch->count = queued;
+            m_update_queue_count++;
+        }
+    }
+
+    if (err_code != NRF_SUCCESS)
+    {
+        DM_ERR("[DM]:[0x%02X]: Failed to update device context, reason 0x%08X\r\n",
+               index,
+               err_code);
+
+        device_cache_invalidate(index);
+    }
+
+    m_update_batch.count = 0;
+}
+
+
+/**@brief Function for removing the oldest batch from the queue when its last update is notified.
+ *
+ * @param[in] p_data Source of the update notified by pstorage.
+ */
+static __INLINE void update_queue_notify(uint8_t const * p_data)
+{
+    update_batch_t const * p_batch = &m_update_queue[m_update_queue_rp];
+
+    if ((m_update_queue_count != 0) && (p_batch->update[p_batch->count - 1].p_src == p_data))
+    {
+        m_update_queue_rp = (m_update_queue_rp + 1) % DM_UPDATE_QUEUE_SIZE;
+        m_update_queue_count--;
+    }
+}
+
+
+/**@brief Function for deferring the write of the service context of a connection instance.
+ *
+ * @param[in] index Connection instance.
+ *
+ * @retval NRF_SUCCESS On success, else an error code from @ref app_timer_start.
+ */
+static __INLINE ret_code_t context_update_defer(uint32_t index)
+{
+    ret_code_t err_code = NRF_SUCCESS;
+
+    if ((m_context_update_pending == 0) && (m_flush_timeout_ticks != 0))
+    {
+        err_code = app_timer_start(m_flush_timer_id, m_flush_timeout_ticks, NULL);
+    }
+
+    m_context_update_pending |= (BIT_0 << index);
+
+    return err_code;
+}
+
+
+/**@brief Function for providing whether the write of the service context of a connection
+ *        instance is deferred.
+ *
+ * @param[in] index Connection instance.
+ *
+ * @retval true if the write is deferred, false otherwise.
+ */
+static __INLINE bool context_update_is_pending(uint32_t index)
+{
+    return ((m_context_update_pending & (BIT_0 << index)) ? true : false);
+}
+#else
+static __INLINE bool context_update_is_pending(uint32_t index)
+{
+    return false;
+}
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
+
 /**@brief Function for initialiasing the application instance identified by 'index'.
  *
  * @param[in] index Device identifier.
@@ -574,6 +828,10 @@ static __INLINE void connection_instance_init(uint32_t index)
     m_connection_table[index].bonded_dev_id = DM_INVALID_ID;
     
     memset(&m_connection_table[index].peer_addr, 0, sizeof (ble_gap_addr_t));
+
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+    m_context_update_pending &= (~((uint32_t)BIT_0 << index));
+#endif // DEVICE_MANAGER_WRITE_BATCHING
 }
 
 
@@ -730,6 +988,9 @@ static __INLINE ret_code_t device_instance_free(uint32_t device_index)
         if (err_code == NRF_SUCCESS)
         {
             peer_instance_init(device_index);
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+            device_cache_reset(device_index);
+#endif // DEVICE_MANAGER_WRITE_BATCHING
         }
     }
 
@@ -895,6 +1156,10 @@ static __INLINE void device_context_store(dm_handle_t const * p_handle, device_s
 
     DM_LOG("[DM]: --> device_context_store\r\n");
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+    m_context_update_pending &= (~((uint32_t)BIT_0 << p_handle->connection_id));
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
     err_code = pstorage_block_identifier_get(&m_storage_handle,
                                              p_handle->device_id,
                                              &block_handle);
@@ -908,14 +1173,14 @@ static __INLINE void device_context_store(dm_handle_t const * p_handle, device_s
             DM_LOG("[DM]:[DI %02X]:[CI %02X]: -> Updating bonding information.\r\n",
                    p_handle->device_id, p_handle->connection_id);
 
-            store_fn = pstorage_update;
+            store_fn = DM_CONTEXT_UPDATE;
         }
         else if (state == FIRST_BOND_STORE)
         {
             DM_LOG("[DM]:[DI %02X]:[CI %02X]: -> Storing bonding information.\r\n",
                    p_handle->device_id, p_handle->connection_id);
 
-            store_fn = pstorage_store;
+            store_fn = DM_CONTEXT_STORE;
         }
         else
         {
@@ -966,6 +1231,10 @@ static __INLINE void device_context_store(dm_handle_t const * p_handle, device_s
         }
     }
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+    update_batch_commit();
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
     if (err_code != NRF_SUCCESS)
     {
         //Notify application of an error event.
@@ -1037,14 +1306,14 @@ static __INLINE ret_code_t gatts_context_store(pstorage_handle_t const * p_block
                 //There is data already stored in persistent memory, therefore an update is needed.
                 DM_LOG("[DM]:[0x%02X]: Updating stored service context\r\n", p_handle->device_id);
 
-                store_fn = pstorage_update;
+                store_fn = DM_CONTEXT_UPDATE;
             }
             else
             {
                 //Fresh write, a store is needed.
                 DM_LOG("[DM]:[0x%02X]: Storing service context\r\n", p_handle->device_id);
 
-                store_fn = pstorage_store;
+                store_fn = DM_CONTEXT_STORE;
             }
 
             m_gatts_table[p_handle->connection_id].size = attr_len;
@@ -1403,6 +1672,19 @@ static void dm_pstorage_cb_handler(pstorage_handle_t * p_handle,
         }
     }
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+    if (op_code == PSTORAGE_UPDATE_OP_CODE)
+    {
+        update_queue_notify(p_data);
+    }
+
+    if ((result != NRF_SUCCESS) && (dm_handle.device_id != DM_INVALID_ID))
+    {
+        //The content of the block is not known.
+        device_cache_invalidate(dm_handle.device_id);
+    }
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
     if (dm_handle.device_id != DM_INVALID_ID)
     {
         if (op_code == PSTORAGE_CLEAR_OP_CODE)
@@ -1570,6 +1852,40 @@ static void dm_pstorage_cb_handler(pstorage_handle_t * p_handle,
 }
 
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+/**@brief Function for writing the deferred updates of connected peers, on expiry of the flush
+ *        timer.
+ *
+ * @param[in] p_context Unused.
+ */
+static void flush_timeout_handler(void * p_context)
+{
+    dm_handle_t handle;
+
+    UNUSED_PARAMETER(p_context);
+
+    DM_MUTEX_LOCK();
+
+    for (uint32_t index = 0; index < DEVICE_MANAGER_MAX_CONNECTIONS; index++)
+    {
+        if (context_update_is_pending(index) &&
+            (m_connection_table[index].bonded_dev_id != DM_INVALID_ID))
+        {
+            (void)dm_handle_initialize(&handle);
+
+            handle.appl_id       = 0;
+            handle.connection_id = index;
+            handle.device_id     = m_connection_table[index].bonded_dev_id;
+
+            device_context_store(&handle, STORE_ALL_CONTEXT);
+        }
+    }
+
+    DM_MUTEX_UNLOCK();
+}
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
+
 ret_code_t dm_init(dm_init_param_t const * const p_init_param)
 {
     pstorage_module_param_t param;
@@ -1603,6 +1919,27 @@ ret_code_t dm_init(dm_init_param_t const * const p_init_param)
         peer_instance_init(index);
     }
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+    m_update_batch.count     = 0;
+    m_update_queue_rp        = 0;
+    m_update_queue_count     = 0;
+    m_device_cache_invalid   = 0;
+    m_flush_timeout_ticks    = p_init_param->flush_timeout_ticks;
+
+    if (m_flush_timeout_ticks != 0)
+    {
+        err_code = app_timer_create(&m_flush_timer_id,
+                                    APP_TIMER_MODE_SINGLE_SHOT,
+                                    flush_timeout_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            DM_ERR("[DM]: Failed to create flush timer, reason 0x%08X.\r\n", err_code);
+            DM_MUTEX_UNLOCK();
+            return err_code;
+        }
+    }
+#endif // DEVICE_MANAGER_WRITE_BATCHING
+
     //All context with respect to a particular device is stored contiguously.
     param.block_size  = ALL_CONTEXT_SIZE;
     param.block_count = DEVICE_MANAGER_MAX_BONDS;
@@ -1635,6 +1972,15 @@ ret_code_t dm_init(dm_init_param_t const * const p_init_param)
                                              &block_handle,
                                              sizeof(peer_id_t),
                                              0);
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+                    if (err_code == NRF_SUCCESS)
+                    {
+                        err_code = pstorage_load(m_device_cache[index],
+                                                 &block_handle,
+                                                 DM_DEVICE_CACHE_SIZE,
+                                                 0);
+                    }
+#endif // DEVICE_MANAGER_WRITE_BATCHING
 
                     if (err_code != NRF_SUCCESS)
                     {
@@ -1679,6 +2025,12 @@ ret_code_t dm_init(dm_init_param_t const * const p_init_param)
         else
         {
             err_code = pstorage_clear(&m_storage_handle, (param.block_size * param.block_count));
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+            for (index = 0; index < DEVICE_MANAGER_MAX_BONDS; index++)
+            {
+                device_cache_reset(index);
+            }
+#endif // DEVICE_MANAGER_WRITE_BATCHING
             DM_ERR("[DM]: Successfully requested clear of persistent data.\r\n");
         }
     }
@@ -1985,12 +2337,18 @@ ret_code_t dm_service_context_set(dm_handle_t const          * p_handle,
         }
     }
 
+#if (DEVICE_MANAGER_WRITE_BATCHING == 1)
+    //The service context is written with the device context on disconnection, or on expiry of
+    //the flush timer.
+    uint32_t err_code = context_update_defer(p_handle->connection_id);
+#else
     pstorage_handle_t block_handle;
     uint32_t          err_code = pstorage_block_identifier_get(&m_storage_handle,
                                                                p_handle->device_id,
                                                                &block_handle);
 
     err_code = m_service_context_store[p_context->service_type](&block_handle, p_handle);
+#endif // DEVICE_MANAGER_WRITE_BATCHING
 
     DM_TRC("[DM]: << dm_service_context_set\r\n");
 
@@ -2564,7 +2922,8 @@ void dm_ble_evt_handler(ble_evt_t * p_ble_evt)
 
             if ((m_connection_table[index].state & STATE_BONDED) == STATE_BONDED)
             {
-                if ((m_connection_table[index].state & STATE_LINK_ENCRYPTED) == STATE_LINK_ENCRYPTED)
+                if (((m_connection_table[index].state & STATE_LINK_ENCRYPTED) == STATE_LINK_ENCRYPTED) ||
+                    context_update_is_pending(index))
                 {
                     //Write bond information persistently.
                     device_context_store(&handle, STORE_ALL_CONTEXT);
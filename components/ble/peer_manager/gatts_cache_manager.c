@@ -33,6 +33,7 @@ typedef struct
 {
     gscm_evt_handler_t evt_handler; /**< The event handler to use for outbound GSCM events. */
     pm_peer_id_t       current_sc_store_peer_id;
+    uint32_t           n_skipped_writes; /**< The number of local database updates that were not written because flash already held the same data. */
 } gscm_t;
 
 static gscm_t m_gscm =
@@ -55,6 +56,30 @@ static void internal_state_reset(gscm_t * p_gscm)
 }
 
 
+/**@brief Function for checking whether the stored local database of a peer equals a new one.
+ *
+ * @param[in]  peer_id          The peer.
+ * @param[in]  p_local_gatt_db  The new local database.
+ *
+ * @return Whether the stored local database is identical to the new one.
+ */
+static bool local_db_is_stored(pm_peer_id_t peer_id, pm_peer_data_local_gatt_db_t const * p_local_gatt_db)
+{
+    pm_peer_data_flash_t peer_data;
+
+    if (pdb_read_buf_get(peer_id, PM_PEER_DATA_ID_GATT_LOCAL, &peer_data, NULL) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    return (   (peer_data.p_local_gatt_db->flags == p_local_gatt_db->flags)
+            && (peer_data.p_local_gatt_db->len   == p_local_gatt_db->len)
+            && (memcmp(peer_data.p_local_gatt_db->data,
+                       p_local_gatt_db->data,
+                       p_local_gatt_db->len) == 0));
+}
+
+
 //lint -save -e550
 /**@brief Function for storing service_changed_pending = true to flash for all peers, in sequence.
  *
@@ -171,7 +196,17 @@ ret_code_t gscm_local_db_cache_update(uint16_t conn_handle)
 
                 err_code = sd_ble_gatts_sys_attr_get(conn_handle, &p_local_gatt_db->data[0], &p_local_gatt_db->len, p_local_gatt_db->flags);
 
-                if (err_code == NRF_SUCCESS)
+                if ((err_code == NRF_SUCCESS) && local_db_is_stored(peer_id, p_local_gatt_db))
+                {
+                    // Flash already holds these sys attributes.
+                    m_gscm.n_skipped_writes++;
+                    err_code = pdb_write_buf_release(peer_id, PM_PEER_DATA_ID_GATT_LOCAL);
+                    if (err_code != NRF_SUCCESS)
+                    {
+                        err_code = NRF_ERROR_INTERNAL;
+                    }
+                }
+                else if (err_code == NRF_SUCCESS)
                 {
                     err_code = pdb_write_buf_store(peer_id, PM_PEER_DATA_ID_GATT_LOCAL);
                 }
@@ -207,6 +242,12 @@ ret_code_t gscm_local_db_cache_update(uint16_t conn_handle)
 }
 
 
+uint32_t gscm_local_db_cache_skipped_writes_get(void)
+{
+    return m_gscm.n_skipped_writes;
+}
+
+
 ret_code_t gscm_local_db_cache_apply(uint16_t conn_handle)
 {
     VERIFY_MODULE_INITIALIZED();
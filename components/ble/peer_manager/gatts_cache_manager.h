@@ -83,6 +83,9 @@ ret_code_t gscm_init(gscm_evt_handler_t evt_handler);
 /**@brief Function for triggering local GATT database data to be stored persistently. Values are
  *        retrieved from the SoftDevice and written to persistent storage.
  *
+ * @details If persistent storage already holds the same values, nothing is written. See
+ *          @ref gscm_local_db_cache_skipped_writes_get.
+ *
  * @param[in]  conn_handle  Connection handle to perform update on.
  *
  * @retval NRF_SUCCESS                    Store operation started.
@@ -99,6 +102,14 @@ ret_code_t gscm_init(gscm_evt_handler_t evt_handler);
 ret_code_t gscm_local_db_cache_update(uint16_t conn_handle);
 
 
+/**@brief Function for getting the number of times @ref gscm_local_db_cache_update did not write
+ *        to persistent storage because the stored values were unchanged.
+ *
+ * @return The number of skipped writes since @ref gscm_init.
+ */
+uint32_t gscm_local_db_cache_skipped_writes_get(void);
+
+
 /**@brief Function for applying stored local GATT database data to the SoftDevice. Values are
  *        retrieved from persistent storage and given to the SoftDevice.
  *
@@ -30,6 +30,14 @@
 #define IM_ADDR_CLEARTEXT_LENGTH    3
 #define IM_ADDR_CIPHERTEXT_LENGTH   3
 
+#ifndef IM_RPA_CACHE_SIZE
+#define IM_RPA_CACHE_SIZE           8                   /**< The number of resolvable private addresses whose resolution result is kept in RAM. */
+#endif
+
+#ifndef IM_WHITELIST_CACHE_SIZE
+#define IM_WHITELIST_CACHE_SIZE     WHITELIST_MAX_COUNT /**< The number of peers whose whitelist address and IRK are kept in RAM. */
+#endif
+
 typedef struct
 {
     pm_peer_id_t   peer_id;
@@ -37,6 +45,26 @@ typedef struct
     ble_gap_addr_t peer_address;
 } im_connection_t;
 
+/**@brief The whitelist address and IRK of a peer, as read from its bonding data.
+ */
+typedef struct
+{
+    pm_peer_id_t   peer_id;    /**< The peer, or @ref PM_PEER_ID_INVALID if the entry is unused. */
+    bool           addr_valid; /**< Whether the peer has a public or static address to whitelist. */
+    bool           irk_valid;  /**< Whether the peer has a valid IRK to whitelist. */
+    ble_gap_addr_t addr;       /**< The identity address of the peer. */
+    ble_gap_irk_t  irk;        /**< The IRK of the peer. */
+} im_whitelist_entry_t;
+
+/**@brief The result of resolving a resolvable private address against all stored IRKs.
+ */
+typedef struct
+{
+    uint8_t      addr[BLE_GAP_ADDR_LEN]; /**< The resolvable private address. */
+    pm_peer_id_t peer_id;                /**< The peer whose IRK resolved the address, or @ref PM_PEER_ID_INVALID if none did. */
+    bool         valid;                  /**< Whether the entry is in use. */
+} im_rpa_entry_t;
+
 typedef struct
 {
     im_evt_handler_t              evt_handlers[MAX_REGISTRANTS];
@@ -46,6 +74,10 @@ typedef struct
     ble_gap_irk_t                 whitelist_irks[BLE_GAP_WHITELIST_IRK_MAX_COUNT];
     ble_gap_addr_t                whitelist_addrs[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];
     uint8_t                       n_irk_whitelist_peer_ids;
+    im_whitelist_entry_t          whitelist_cache[IM_WHITELIST_CACHE_SIZE];
+    uint8_t                       whitelist_cache_next;
+    im_rpa_entry_t                rpa_cache[IM_RPA_CACHE_SIZE];
+    uint8_t                       rpa_cache_next;
     ble_conn_state_user_flag_id_t conn_state_user_flag_id;
 } im_t;
 
@@ -64,6 +96,10 @@ static void internal_state_reset()
     {
         m_im.connections[i].conn_handle = BLE_CONN_HANDLE_INVALID;
     }
+    for (uint32_t i = 0; i < IM_WHITELIST_CACHE_SIZE; i++)
+    {
+        m_im.whitelist_cache[i].peer_id = PM_PEER_ID_INVALID;
+    }
 }
 
 
@@ -212,7 +248,6 @@ bool addr_compare(ble_gap_addr_t const * p_addr1, ble_gap_addr_t const * p_addr2
 
 void im_ble_evt_handler(ble_evt_t * ble_evt)
 {
-    ret_code_t err_code;
     switch (ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_CONNECTED:
@@ -225,60 +260,10 @@ void im_ble_evt_handler(ble_evt_t * ble_evt)
                 bonded_matching_peer_id
                         = m_im.irk_whitelist_peer_ids[ble_evt->evt.gap_evt.params.connected.irk_match_idx];
             }
-            else if (   ble_evt->evt.gap_evt.params.connected.peer_addr.addr_type
-                     != BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE)
+            else
             {
-                /* Search the database for bonding data matching the one that triggered the event.
-                 * Public and static addresses can be matched on address alone, while resolvable
-                 * random addresses can be resolved agains known IRKs. Non-resolvable random addresses
-                 * are never matching because they are not longterm form of identification.
-                 */
-                pm_peer_id_t compared_peer_id = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
-                while (   (compared_peer_id        != PM_PEER_ID_INVALID)
-                       && (bonded_matching_peer_id == PM_PEER_ID_INVALID))
-                {
-                    pm_peer_data_flash_t compared_data;
-                    switch (ble_evt->evt.gap_evt.params.connected.peer_addr.addr_type)
-                    {
-                        case BLE_GAP_ADDR_TYPE_PUBLIC:
-                            /* fall-through */
-                        case BLE_GAP_ADDR_TYPE_RANDOM_STATIC:
-                            err_code = pdb_read_buf_get(compared_peer_id,
-                                                        PM_PEER_DATA_ID_BONDING,
-                                                        &compared_data,
-                                                        NULL);
-                            if ((err_code == NRF_SUCCESS) &&
-                                addr_compare(&ble_evt->evt.gap_evt.params.connected.peer_addr,
-                                             &compared_data.p_bonding_data->peer_id.id_addr_info)
-                            )
-                            {
-                                bonded_matching_peer_id = compared_peer_id;
-                            }
-                            break;
-
-                        case BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE:
-                            err_code = pdb_read_buf_get(compared_peer_id,
-                                                        PM_PEER_DATA_ID_BONDING,
-                                                        &compared_data,
-                                                        NULL);
-                            if (err_code == NRF_SUCCESS &&
-                                im_address_resolve(&ble_evt->evt.gap_evt.params.connected.peer_addr,
-                                                   &compared_data.p_bonding_data->peer_id.id_info)
-                            )
-                            {
-                                bonded_matching_peer_id = compared_peer_id;
-                            }
-                            break;
-
-                        case BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE:
-                            // Should not happen.
-                            break;
-
-                        default:
-                            break;
-                    }
-                    compared_peer_id = pdb_next_peer_id_get(compared_peer_id);
-                }
+                bonded_matching_peer_id
+                        = im_peer_id_get_by_addr(&ble_evt->evt.gap_evt.params.connected.peer_addr);
             }
             uint8_t new_index = new_connection(ble_evt->evt.gap_evt.conn_handle, &ble_evt->evt.gap_evt.params.connected.peer_addr);
             UNUSED_VARIABLE(new_index);
@@ -322,6 +307,150 @@ bool is_duplicate_bonding_data(pm_peer_data_bonding_t const * p_bonding_data1,
 }
 
 
+/**@brief Function for filling a whitelist cache entry from bonding data.
+ *
+ * @param[out] p_entry         The entry to fill.
+ * @param[in]  peer_id         The peer the bonding data belongs to.
+ * @param[in]  p_bonding_data  The bonding data.
+ */
+static void whitelist_entry_fill(im_whitelist_entry_t         * p_entry,
+                                 pm_peer_id_t                   peer_id,
+                                 pm_peer_data_bonding_t const * p_bonding_data)
+{
+    uint8_t addr_type = p_bonding_data->peer_id.id_addr_info.addr_type;
+
+    p_entry->peer_id    = peer_id;
+    p_entry->addr_valid = (addr_type != BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE) &&
+                          (addr_type != BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE);
+    p_entry->irk_valid  = is_valid_irk(&p_bonding_data->peer_id.id_info);
+    p_entry->addr       = p_bonding_data->peer_id.id_addr_info;
+    p_entry->irk        = p_bonding_data->peer_id.id_info;
+}
+
+
+/**@brief Function for finding the whitelist cache entry of a peer.
+ *
+ * @param[in]  peer_id  The peer.
+ *
+ * @return The entry, or NULL if the peer is not cached.
+ */
+static im_whitelist_entry_t * whitelist_entry_find(pm_peer_id_t peer_id)
+{
+    for (uint32_t i = 0; i < IM_WHITELIST_CACHE_SIZE; i++)
+    {
+        if (m_im.whitelist_cache[i].peer_id == peer_id)
+        {
+            return &m_im.whitelist_cache[i];
+        }
+    }
+    return NULL;
+}
+
+
+/**@brief Function for getting the whitelist address and IRK of a peer.
+ *
+ * @details The bonding data is only read from flash if the peer is not cached. The entry it
+ *          is read into is reused in round-robin order.
+ *
+ * @param[in]  peer_id   The peer.
+ * @param[out] pp_entry  The whitelist address and IRK of the peer.
+ *
+ * @return Any error from @ref pdb_read_buf_get.
+ */
+static ret_code_t whitelist_entry_get(pm_peer_id_t peer_id, im_whitelist_entry_t const ** pp_entry)
+{
+    im_whitelist_entry_t * p_entry = whitelist_entry_find(peer_id);
+
+    if ((p_entry == NULL) || (peer_id == PM_PEER_ID_INVALID))
+    {
+        pm_peer_data_flash_t peer_data;
+        ret_code_t           err_code;
+
+        err_code = pdb_read_buf_get(peer_id, PM_PEER_DATA_ID_BONDING, &peer_data, NULL);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+
+        p_entry = &m_im.whitelist_cache[m_im.whitelist_cache_next];
+        m_im.whitelist_cache_next = (m_im.whitelist_cache_next + 1) % IM_WHITELIST_CACHE_SIZE;
+
+        whitelist_entry_fill(p_entry, peer_id, peer_data.p_bonding_data);
+    }
+
+    *pp_entry = p_entry;
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for forgetting all cached address resolution results.
+ *
+ * @details Called when bonding data is written or peers are freed, since the stored IRKs change.
+ */
+static void rpa_cache_clear(void)
+{
+    for (uint32_t i = 0; i < IM_RPA_CACHE_SIZE; i++)
+    {
+        m_im.rpa_cache[i].valid = false;
+    }
+}
+
+
+/**@brief Function for looking up a resolvable private address in the cache.
+ *
+ * @param[in]  p_addr  The address.
+ *
+ * @return The cache entry, or NULL if the address has not been resolved recently.
+ */
+static im_rpa_entry_t const * rpa_cache_find(ble_gap_addr_t const * p_addr)
+{
+    for (uint32_t i = 0; i < IM_RPA_CACHE_SIZE; i++)
+    {
+        if (   m_im.rpa_cache[i].valid
+            && (memcmp(m_im.rpa_cache[i].addr, p_addr->addr, BLE_GAP_ADDR_LEN) == 0))
+        {
+            return &m_im.rpa_cache[i];
+        }
+    }
+    return NULL;
+}
+
+
+/**@brief Function for remembering the result of resolving a resolvable private address.
+ *
+ * @details Entries are reused in round-robin order.
+ *
+ * @param[in]  p_addr   The address.
+ * @param[in]  peer_id  The peer that owns the address, or @ref PM_PEER_ID_INVALID.
+ */
+static void rpa_cache_store(ble_gap_addr_t const * p_addr, pm_peer_id_t peer_id)
+{
+    im_rpa_entry_t * p_entry = &m_im.rpa_cache[m_im.rpa_cache_next];
+
+    m_im.rpa_cache_next = (m_im.rpa_cache_next + 1) % IM_RPA_CACHE_SIZE;
+
+    memcpy(p_entry->addr, p_addr->addr, BLE_GAP_ADDR_LEN);
+    p_entry->peer_id = peer_id;
+    p_entry->valid   = true;
+}
+
+
+/**@brief Function for dropping the cached whitelist entries of peers that have been freed.
+ */
+static void whitelist_cache_prune(void)
+{
+    for (uint32_t i = 0; i < IM_WHITELIST_CACHE_SIZE; i++)
+    {
+        pm_peer_id_t peer_id = m_im.whitelist_cache[i].peer_id;
+
+        if ((peer_id != PM_PEER_ID_INVALID) && !pdb_peer_id_is_allocated(peer_id))
+        {
+            m_im.whitelist_cache[i].peer_id = PM_PEER_ID_INVALID;
+        }
+    }
+}
+
+
 /**@brief Event handler for events from the peer_database module.
  *
  * @param[in]  p_event The event that has happend with peer id and flags.
@@ -329,16 +458,52 @@ bool is_duplicate_bonding_data(pm_peer_data_bonding_t const * p_bonding_data1,
 static void pdb_evt_handler(pdb_evt_t const * p_event)
 {
     ret_code_t err_code;
-    if ((p_event != NULL) && (p_event->evt_id == PDB_EVT_WRITE_BUF_STORED))
+
+    if (p_event == NULL)
+    {
+        return;
+    }
+
+    if (   (p_event->evt_id == PDB_EVT_PEER_FREED)
+        || (p_event->evt_id == PDB_EVT_PEERS_FREED)
+        || (p_event->evt_id == PDB_EVT_PEERS_FREE_FAILED))
+    {
+        whitelist_cache_prune();
+        rpa_cache_clear();
+    }
+    else if (   (p_event->evt_id == PDB_EVT_RAW_STORED)
+             && (p_event->data_id == PM_PEER_DATA_ID_BONDING))
+    {
+        im_whitelist_entry_t * p_entry = whitelist_entry_find(p_event->peer_id);
+
+        rpa_cache_clear();
+
+        if (p_entry != NULL)
+        {
+            // Reloaded from flash on the next whitelist creation.
+            p_entry->peer_id = PM_PEER_ID_INVALID;
+        }
+    }
+
+    if (p_event->evt_id == PDB_EVT_WRITE_BUF_STORED)
     {
         // If new data about peer id has been stored it is compared to other peers peer ids in
         // search of duplicates.
         if (p_event->data_id == PM_PEER_DATA_ID_BONDING)
         {
             pm_peer_data_flash_t written_data;
+
+            rpa_cache_clear();
             err_code = pdb_read_buf_get(p_event->peer_id, PM_PEER_DATA_ID_BONDING, &written_data, NULL);
             if (err_code == NRF_SUCCESS)
             {
+                im_whitelist_entry_t * p_entry = whitelist_entry_find(p_event->peer_id);
+
+                if (p_entry != NULL)
+                {
+                    whitelist_entry_fill(p_entry, p_event->peer_id, written_data.p_bonding_data);
+                }
+
                 pm_peer_id_t compared_peer_id = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
                 while (compared_peer_id != PM_PEER_ID_INVALID)
                 {
@@ -445,6 +610,66 @@ bool im_master_ids_compare(ble_gap_master_id_t const * p_master_id1,
 }
 
 
+pm_peer_id_t im_peer_id_get_by_addr(ble_gap_addr_t const * p_addr)
+{
+    im_rpa_entry_t const * p_entry;
+    pm_peer_id_t           matching_peer_id = PM_PEER_ID_INVALID;
+    pm_peer_id_t           compared_peer_id;
+
+    if ((p_addr == NULL) || (p_addr->addr_type == BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE))
+    {
+        // Non-resolvable random addresses are not a long-term form of identification.
+        return PM_PEER_ID_INVALID;
+    }
+
+    if (p_addr->addr_type == BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE)
+    {
+        p_entry = rpa_cache_find(p_addr);
+        if (p_entry != NULL)
+        {
+            return p_entry->peer_id;
+        }
+    }
+
+    /* Search the database for bonding data matching the address. Public and static addresses can
+     * be matched on address alone, while resolvable random addresses can be resolved against known
+     * IRKs.
+     */
+    compared_peer_id = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
+    while ((compared_peer_id != PM_PEER_ID_INVALID) && (matching_peer_id == PM_PEER_ID_INVALID))
+    {
+        pm_peer_data_flash_t compared_data;
+        ret_code_t           err_code = pdb_read_buf_get(compared_peer_id,
+                                                         PM_PEER_DATA_ID_BONDING,
+                                                         &compared_data,
+                                                         NULL);
+        if (err_code == NRF_SUCCESS)
+        {
+            if (p_addr->addr_type == BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE)
+            {
+                if (im_address_resolve(p_addr, &compared_data.p_bonding_data->peer_id.id_info))
+                {
+                    matching_peer_id = compared_peer_id;
+                }
+            }
+            else if (addr_compare(p_addr, &compared_data.p_bonding_data->peer_id.id_addr_info))
+            {
+                matching_peer_id = compared_peer_id;
+            }
+        }
+        compared_peer_id = pdb_next_peer_id_get(compared_peer_id);
+    }
+
+    if (p_addr->addr_type == BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE)
+    {
+        // Misses are cached too, since most addresses seen while scanning belong to unknown devices.
+        rpa_cache_store(p_addr, matching_peer_id);
+    }
+
+    return matching_peer_id;
+}
+
+
 pm_peer_id_t im_peer_id_get_by_master_id(ble_gap_master_id_t * p_master_id)
 {
     ret_code_t err_code;
@@ -559,6 +784,27 @@ ret_code_t im_peer_free(pm_peer_id_t peer_id)
 }
 
 
+ret_code_t im_peers_free(pm_peer_id_filter_t filter)
+{
+    VERIFY_MODULE_INITIALIZED();
+
+    ret_code_t err_code = pdb_peers_free(filter);
+    if (err_code == NRF_SUCCESS)
+    {
+        for (uint32_t i = 0; i < IM_MAX_CONN_HANDLES; i++)
+        {
+            pm_peer_id_t peer_id = m_im.connections[i].peer_id;
+
+            if ((peer_id != PM_PEER_ID_INVALID) && !pdb_peer_id_is_allocated(peer_id))
+            {
+                m_im.connections[i].peer_id = PM_PEER_ID_INVALID;
+            }
+        }
+    }
+    return err_code;
+}
+
+
 ret_code_t im_whitelist_create(pm_peer_id_t *        p_peer_ids,
                                uint8_t               n_peer_ids,
                                ble_gap_whitelist_t * p_whitelist)
@@ -574,39 +820,30 @@ ret_code_t im_whitelist_create(pm_peer_id_t *        p_peer_ids,
         uint16_t conn_handle = im_conn_handle_get(p_peer_ids[peer_index]);
         if (ble_conn_state_status(conn_handle) != BLE_CONN_STATUS_CONNECTED)
         {
-            pm_peer_data_flash_t peer_data;
-            err_code = pdb_read_buf_get(p_peer_ids[peer_index], PM_PEER_DATA_ID_BONDING, &peer_data, NULL);
+            im_whitelist_entry_t const * p_entry;
+            err_code = whitelist_entry_get(p_peer_ids[peer_index], &p_entry);
             if (err_code == NRF_ERROR_INVALID_PARAM || err_code == NRF_ERROR_NOT_FOUND)
             {
                 return NRF_ERROR_INVALID_PARAM;
             }
-            if (p_whitelist->pp_addrs != NULL &&
-                peer_data.p_bonding_data->peer_id.id_addr_info.addr_type
-                        != BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE &&
-                peer_data.p_bonding_data->peer_id.id_addr_info.addr_type
-                        != BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE
-            )
+            else if (err_code != NRF_SUCCESS)
             {
-                memcpy(m_im.whitelist_addrs[peer_index].addr,
-                    peer_data.p_bonding_data->peer_id.id_addr_info.addr,
-                    BLE_GAP_ADDR_LEN
-                );
-                m_im.whitelist_addrs[peer_index].addr_type =
-                    peer_data.p_bonding_data->peer_id.id_addr_info.addr_type;
-                p_whitelist->pp_addrs[peer_index] = &m_im.whitelist_addrs[peer_index];
+                return err_code;
+            }
+            if (p_whitelist->pp_addrs != NULL && p_entry->addr_valid)
+            {
+                m_im.whitelist_addrs[p_whitelist->addr_count] = p_entry->addr;
+                p_whitelist->pp_addrs[p_whitelist->addr_count] =
+                    &m_im.whitelist_addrs[p_whitelist->addr_count];
                 p_whitelist->addr_count++;
             }
-            if (p_whitelist->pp_irks != NULL &&
-                is_valid_irk(&(peer_data.p_bonding_data->peer_id.id_info))
-            )
+            if (p_whitelist->pp_irks != NULL && p_entry->irk_valid)
             {
-                memcpy(m_im.whitelist_irks[peer_index].irk,
-                    peer_data.p_bonding_data->peer_id.id_info.irk,
-                    BLE_GAP_SEC_KEY_LEN
-                );
-                p_whitelist->pp_irks[peer_index] = &m_im.whitelist_irks[peer_index];
+                m_im.whitelist_irks[p_whitelist->irk_count] = p_entry->irk;
+                p_whitelist->pp_irks[p_whitelist->irk_count] =
+                    &m_im.whitelist_irks[p_whitelist->irk_count];
+                m_im.irk_whitelist_peer_ids[p_whitelist->irk_count] = p_peer_ids[peer_index];
                 p_whitelist->irk_count++;
-                m_im.irk_whitelist_peer_ids[peer_index] = p_peer_ids[peer_index];
                 m_im.n_irk_whitelist_peer_ids++;
             }
         }
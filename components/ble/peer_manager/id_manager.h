@@ -19,6 +19,7 @@
 #include "ble.h"
 #include "ble_gap.h"
 #include "peer_manager_types.h"
+#include "peer_manager_internal.h"
 
 
 /**
@@ -90,6 +91,21 @@ void im_ble_evt_handler(ble_evt_t * p_ble_evt);
 pm_peer_id_t im_peer_id_get_by_conn_handle(uint16_t conn_handle);
 
 
+/**@brief Function for finding the bonded peer using an address.
+ *
+ * @details Public and static addresses are compared with the stored identity addresses. Resolvable
+ *          private addresses are resolved against the stored IRKs. The result of resolving a
+ *          resolvable private address, also when no peer matched, is cached until bonding data
+ *          changes, so addresses seen repeatedly, e.g. in advertising reports, are resolved
+ *          without using the ECB.
+ *
+ * @param[in]  p_addr  The address.
+ *
+ * @return The peer ID of the peer, or @ref PM_PEER_ID_INVALID if no bonded peer matched.
+ */
+pm_peer_id_t im_peer_id_get_by_addr(ble_gap_addr_t const * p_addr);
+
+
 /**@brief Function for getting the corresponding peer ID from a master ID (EDIV and rand).
  *
  * @param[in]  p_master_id  The master ID.
@@ -173,6 +189,16 @@ void im_new_peer_id(uint16_t conn_handle, pm_peer_id_t peer_id);
 ret_code_t im_peer_free(pm_peer_id_t peer_id);
 
 
+/**@brief Function for deleting the data of many peers from flash in one operation, and
+ *        disassociating them from any connection handles they are associated with.
+ *
+ * @param[in]  filter  Function selecting the peers to free, or NULL to free all peers.
+ *
+ * @return Any error code returned by @ref pdb_peers_free.
+ */
+ret_code_t im_peers_free(pm_peer_id_filter_t filter);
+
+
 /**@brief Function for informing this module of what whitelist will be used.
  *
  * @details This function is meant to be used when the app wants to use a custom whitelist.
@@ -199,6 +225,9 @@ ret_code_t im_whitelist_custom(ble_gap_whitelist_t const * p_whitelist);
 /**
  * @brief Function for constructing a whitelist for use when advertising.
  *
+ * @details The addresses and IRKs of recently whitelisted peers are kept in RAM, and are
+ *          updated when their bonding data changes, so repeated calls do not read flash.
+ *
  * @note When advertising with whitelist, always use the whitelist created/set by the most recent
  *       call to this function or to @ref im_whitelist_custom, whichever happened most recently.
  * @note Do not call this function while advertising with another whitelist.
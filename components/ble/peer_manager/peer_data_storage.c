@@ -22,6 +22,7 @@
 #include "peer_data.h"
 #include "fds.h"
 #include "sdk_common.h"
+#include "app_boot_trace.h"
 
 
 // The number of user that can register with the module.
@@ -60,6 +61,25 @@ do                                          \
 } while (0)
 
 
+#if (PDS_LAZY_INIT)
+// Expression which is true when FDS has been initialized, so that peer data can be read.
+#define FDS_READY (m_pds.fds_ready)
+#else
+#define FDS_READY (true)
+#endif
+
+
+// Macro for verifying that FDS has been initialized.
+#define VERIFY_FDS_READY()                  \
+do                                          \
+{                                           \
+    if (!FDS_READY)                         \
+    {                                       \
+        return NRF_ERROR_BUSY;              \
+    }                                       \
+} while (0)
+
+
 // Macro for initializing the peer ID tracking system if it is not already initialized.
 #define PEER_IDS_INITIALIZE()               \
 do                                          \
@@ -71,13 +91,36 @@ do                                          \
 } while (0)
 
 
+#if (PDS_CACHE_SIZE > 0)
+// A cached record location. The record data itself stays in flash; the cache only saves the
+// page scans needed to find it.
+typedef struct
+{
+    pm_peer_id_t        peer_id;
+    pm_peer_data_id_t   data_id;
+    uint32_t            last_used;  // Value of the LRU counter when the entry was last hit.
+    fds_record_desc_t   desc;
+} pds_cache_entry_t;
+#endif
+
+
 typedef struct
 {
     bool                peer_ids_initialized;
+#if (PDS_LAZY_INIT)
+    bool                fds_ready;          // FDS_EVT_INIT has been received.
+#endif
     pds_evt_handler_t   evt_handlers[MAX_REGISTRANTS];
     uint8_t             n_registrants;
     bool                clearing;
     bool                clear_queued;
+    bool                bulk_clearing;      // A call to pds_peer_ids_free() is being processed.
+    bool                bulk_compressing;   // The final garbage collection of a bulk clear has been requested.
+    ret_code_t          bulk_result;        // The first error that happened during a bulk clear.
+#if (PDS_CACHE_SIZE > 0)
+    pds_cache_entry_t   cache[PDS_CACHE_SIZE];
+    uint32_t            cache_lru_counter;
+#endif
 } pds_t;
 
 
@@ -90,9 +133,17 @@ static pds_t m_pds = { .n_registrants = 0 };
 static void internal_state_reset(pds_t * p_pds)
 {
     memset(p_pds, 0, sizeof(pds_t));
+
+#if (PDS_CACHE_SIZE > 0)
+    for (uint32_t i = 0; i < PDS_CACHE_SIZE; i++)
+    {
+        p_pds->cache[i].peer_id = PM_PEER_ID_INVALID;
+    }
+#endif
 }
 
 
+
 // Function for dispatching outbound events to all registered event handlers.
 static void pds_evt_send(pds_evt_t * p_event)
 {
@@ -131,6 +182,156 @@ static pm_peer_data_id_t record_key_to_peer_data_id(uint16_t record_key)
 }
 
 
+#if (PDS_CACHE_SIZE > 0)
+// Function for finding the cache entry of a piece of peer data. Returns NULL if not cached.
+static pds_cache_entry_t * cache_entry_find(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
+{
+    for (uint32_t i = 0; i < PDS_CACHE_SIZE; i++)
+    {
+        if ((m_pds.cache[i].peer_id == peer_id) && (m_pds.cache[i].data_id == data_id))
+        {
+            return &m_pds.cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+// Function for storing the location of a piece of peer data, evicting the least recently used
+// entry if the cache is full.
+static void cache_entry_store(pm_peer_id_t              peer_id,
+                              pm_peer_data_id_t         data_id,
+                              fds_record_desc_t const * p_desc)
+{
+    pds_cache_entry_t * p_entry = cache_entry_find(peer_id, data_id);
+
+    if (p_entry == NULL)
+    {
+        p_entry = &m_pds.cache[0];
+
+        for (uint32_t i = 0; i < PDS_CACHE_SIZE; i++)
+        {
+            if (m_pds.cache[i].peer_id == PM_PEER_ID_INVALID)
+            {
+                p_entry = &m_pds.cache[i];
+                break;
+            }
+            if (m_pds.cache[i].last_used < p_entry->last_used)
+            {
+                p_entry = &m_pds.cache[i];
+            }
+        }
+    }
+
+    p_entry->peer_id   = peer_id;
+    p_entry->data_id   = data_id;
+    p_entry->last_used = ++m_pds.cache_lru_counter;
+    p_entry->desc      = *p_desc;
+    p_entry->desc.record_is_open = false;
+}
+
+
+// Function for dropping cached locations. PM_PEER_DATA_ID_INVALID drops all data of the peer.
+static void cache_invalidate(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
+{
+    for (uint32_t i = 0; i < PDS_CACHE_SIZE; i++)
+    {
+        if (   (m_pds.cache[i].peer_id == peer_id)
+            && ((data_id == PM_PEER_DATA_ID_INVALID) || (m_pds.cache[i].data_id == data_id)))
+        {
+            m_pds.cache[i].peer_id = PM_PEER_ID_INVALID;
+        }
+    }
+}
+
+
+// Function for opening a record from its cached location.
+// FDS only validates the address and record ID of a descriptor, so the header is also checked
+// against the expected file ID and record key to discard stale entries.
+static bool cache_record_open(pm_peer_id_t         peer_id,
+                              pm_peer_data_id_t    data_id,
+                              fds_record_desc_t  * p_desc,
+                              fds_flash_record_t * p_record)
+{
+    pds_cache_entry_t * p_entry = cache_entry_find(peer_id, data_id);
+
+    if (p_entry == NULL)
+    {
+        return false;
+    }
+
+    if (fds_record_open(&p_entry->desc, p_record) == FDS_SUCCESS)
+    {
+        if (   (p_record->p_header->ic.file_id    == peer_id_to_file_id(peer_id))
+            && (p_record->p_header->tl.record_key == peer_data_id_to_record_key(data_id)))
+        {
+            p_entry->last_used = ++m_pds.cache_lru_counter;
+            *p_desc = p_entry->desc;
+            p_entry->desc.record_is_open = false;
+            return true;
+        }
+
+        (void)fds_record_close(&p_entry->desc);
+    }
+
+    p_entry->peer_id = PM_PEER_ID_INVALID;
+    return false;
+}
+
+#define CACHE_INVALIDATE(peer_id, data_id)  cache_invalidate((peer_id), (data_id))
+#else
+#define CACHE_INVALIDATE(peer_id, data_id)
+#endif // PDS_CACHE_SIZE > 0
+
+
+// Function for ending a bulk clear and reporting the outcome.
+static void bulk_clear_finish(ret_code_t result)
+{
+    pds_evt_t pds_evt;
+
+    if (m_pds.bulk_result == NRF_SUCCESS)
+    {
+        m_pds.bulk_result = result;
+    }
+
+    pds_evt.evt_id      = (m_pds.bulk_result == NRF_SUCCESS) ? PDS_EVT_PEERS_CLEAR :
+                                                               PDS_EVT_ERROR_PEERS_CLEAR;
+    pds_evt.peer_id     = PM_PEER_ID_INVALID;
+    pds_evt.data_id     = PM_PEER_DATA_ID_INVALID;
+    pds_evt.store_token = PM_STORE_TOKEN_INVALID;
+    pds_evt.result      = m_pds.bulk_result;
+
+    m_pds.bulk_clearing    = false;
+    m_pds.bulk_compressing = false;
+    m_pds.bulk_result      = NRF_SUCCESS;
+
+    pds_evt_send(&pds_evt);
+}
+
+
+// Function for starting the garbage collection which ends a bulk clear.
+static void bulk_clear_compress()
+{
+    ret_code_t retval;
+
+    // Set before the call, since FDS can report completion before fds_gc() returns.
+    m_pds.bulk_compressing = true;
+
+    retval = fds_gc();
+
+    if (retval == FDS_ERR_NO_SPACE_IN_QUEUES)
+    {
+        m_pds.bulk_compressing = false;
+        m_pds.clear_queued     = true;
+    }
+    else if (retval != FDS_SUCCESS)
+    {
+        bulk_clear_finish(retval);
+    }
+}
+
+
 // Function for clearing all peer data of one peer.
 // These operations will be sent to FDS one at a time.
 static void peer_data_clear()
@@ -173,8 +374,23 @@ static void peer_data_clear()
             pds_evt.result      = retval;
 
             pds_evt_send(&pds_evt);
+
+            if (m_pds.bulk_clearing)
+            {
+                bulk_clear_finish(retval);
+            }
         }
     }
+
+    if (   m_pds.bulk_clearing
+        && !m_pds.bulk_compressing
+        && !m_pds.clearing
+        && !m_pds.clear_queued
+        && (peer_id == PM_PEER_ID_INVALID))
+    {
+        // All files have been deleted. Reclaim the space with a single garbage collection.
+        bulk_clear_compress();
+    }
 }
 
 
@@ -240,6 +456,8 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
             pds_evt.data_id     = record_key_to_peer_data_id(p_fds_evt->write.record_key);
             pds_evt.result      = p_fds_evt->result;
             pds_evt.store_token = p_fds_evt->write.record_id;
+
+            CACHE_INVALIDATE(pds_evt.peer_id, pds_evt.data_id);
             break;
 
         case FDS_EVT_UPDATE:
@@ -250,6 +468,8 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
             pds_evt.data_id     = record_key_to_peer_data_id(p_fds_evt->write.record_key);
             pds_evt.result      = p_fds_evt->result;
             pds_evt.store_token = p_fds_evt->write.record_id;
+
+            CACHE_INVALIDATE(pds_evt.peer_id, pds_evt.data_id);
             break;
 
         case FDS_EVT_DEL_RECORD:
@@ -259,6 +479,8 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
             pds_evt.peer_id     = file_id_to_peer_id(p_fds_evt->del.file_id);
             pds_evt.data_id     = record_key_to_peer_data_id(p_fds_evt->del.record_key);
             pds_evt.store_token = p_fds_evt->del.record_id;
+
+            CACHE_INVALIDATE(pds_evt.peer_id, pds_evt.data_id);
             break;
 
         case FDS_EVT_DEL_FILE:
@@ -270,6 +492,7 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
                     pds_evt.data_id = record_key_to_peer_data_id(p_fds_evt->del.record_key);
 
                     pds_evt.data_id = PM_PEER_DATA_ID_INVALID;
+                    CACHE_INVALIDATE(pds_evt.peer_id, PM_PEER_DATA_ID_INVALID);
                     if (p_fds_evt->result == FDS_SUCCESS)
                     {
                         pds_evt.evt_id = PDS_EVT_PEER_ID_CLEAR;
@@ -278,7 +501,14 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
                     else
                     {
                         pds_evt.evt_id = PDS_EVT_ERROR_PEER_ID_CLEAR;
+                        if (m_pds.bulk_clearing && (m_pds.bulk_result == NRF_SUCCESS))
+                        {
+                            m_pds.bulk_result = p_fds_evt->result;
+                        }
                     }
+
+                    // The outcome of a bulk clear is reported in a single event.
+                    send_event = !m_pds.bulk_clearing;
                     m_pds.clearing = false;
                     m_pds.clear_queued = false;
 
@@ -291,6 +521,28 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
             pds_evt.evt_id = PDS_EVT_COMPRESSED;
             break;
 
+        case FDS_EVT_INIT:
+            send_event = false;
+#if (PDS_LAZY_INIT)
+            // FDS sends this event again whenever fds_init() is called.
+            if ((p_fds_evt->result == FDS_SUCCESS) && !m_pds.fds_ready)
+            {
+                m_pds.fds_ready = true;
+                peer_ids_init();
+
+                pds_evt.evt_id  = PDS_EVT_INITIALIZED;
+                pds_evt.peer_id = PM_PEER_ID_INVALID;
+                pds_evt.data_id = PM_PEER_DATA_ID_INVALID;
+                pds_evt.result  = NRF_SUCCESS;
+                send_event      = true;
+            }
+#endif
+            if (p_fds_evt->result == FDS_SUCCESS)
+            {
+                APP_BOOT_TRACE("pm_ready");
+            }
+            break;
+
         default:
             send_event = false;
             break;
@@ -301,6 +553,11 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
         pds_evt_send(&pds_evt);
     }
 
+    if ((p_fds_evt->id == FDS_EVT_GC) && m_pds.bulk_compressing)
+    {
+        bulk_clear_finish(p_fds_evt->result);
+    }
+
     if (m_pds.clear_queued)
     {
         m_pds.clear_queued = false;
@@ -355,18 +612,28 @@ ret_code_t pds_peer_data_read_ptr_get(pm_peer_id_t            peer_id,
     fds_record_desc_t  record_desc;
 
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     VERIFY_PEER_DATA_ID_IN_RANGE(data_id);
     VERIFY_PARAM_NOT_NULL(p_data);
 
-    retval = find_fds_item(peer_id, data_id, &record_desc);
-    if (retval != FDS_SUCCESS)
+#if (PDS_CACHE_SIZE > 0)
+    if (!cache_record_open(peer_id, data_id, &record_desc, &record))
+#endif
     {
-        return NRF_ERROR_NOT_FOUND;
-    }
+        retval = find_fds_item(peer_id, data_id, &record_desc);
+        if (retval != FDS_SUCCESS)
+        {
+            return NRF_ERROR_NOT_FOUND;
+        }
 
-    // Shouldn't fail, unless the record was deleted.
-    (void)fds_record_open(&record_desc, &record);
+        // Shouldn't fail, unless the record was deleted.
+        (void)fds_record_open(&record_desc, &record);
+
+#if (PDS_CACHE_SIZE > 0)
+        cache_entry_store(peer_id, data_id, &record_desc);
+#endif
+    }
 
     if (p_data != NULL)
     {
@@ -452,6 +719,7 @@ ret_code_t pds_peer_data_write_prepare(pm_peer_data_const_t const * p_peer_data,
     ret_code_t retval;
 
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PARAM_NOT_NULL(p_peer_data);
     VERIFY_PEER_DATA_ID_IN_RANGE(p_peer_data->data_id);
     //VERIFY_PARAM_NOT_NULL(p_prepare_token);  redundant, see fds_reserve().
@@ -513,11 +781,14 @@ ret_code_t pds_peer_data_write_prepared(pm_peer_id_t                 peer_id,
     uint16_t           n_chunks;
 
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     VERIFY_PARAM_NOT_NULL(p_peer_data);
     VERIFY_PEER_DATA_ID_IN_RANGE(p_peer_data->data_id);
     VERIFY_PARAM_NOT_ZERO(prepare_token);
 
+    CACHE_INVALIDATE(peer_id, p_peer_data->data_id);
+
     // Create chunks.
     peer_data_parts_get(p_peer_data, chunks, &n_chunks);
 
@@ -565,10 +836,13 @@ ret_code_t pds_peer_data_write(pm_peer_id_t                 peer_id,
     uint16_t           n_chunks;
 
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     VERIFY_PARAM_NOT_NULL(p_peer_data);
     VERIFY_PEER_DATA_ID_IN_RANGE(p_peer_data->data_id);
 
+    CACHE_INVALIDATE(peer_id, p_peer_data->data_id);
+
     // Create chunks.
     peer_data_parts_get(p_peer_data, chunks, &n_chunks);
 
@@ -618,10 +892,13 @@ ret_code_t pds_peer_data_update(pm_peer_id_t                 peer_id,
     uint16_t           n_chunks;
 
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     VERIFY_PARAM_NOT_NULL(p_peer_data);
     VERIFY_PEER_DATA_ID_IN_RANGE(p_peer_data->data_id);
 
+    CACHE_INVALIDATE(peer_id, p_peer_data->data_id);
+
     // Create chunks.
     peer_data_parts_get(p_peer_data, chunks, &n_chunks);
 
@@ -671,9 +948,12 @@ ret_code_t pds_peer_data_clear(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
     fds_find_token_t  find_tok = {0};
 
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     VERIFY_PEER_DATA_ID_IN_RANGE(data_id);
 
+    CACHE_INVALIDATE(peer_id, data_id);
+
     file_id    = peer_id_to_file_id(peer_id);
     record_key = peer_data_id_to_record_key(data_id);
 
@@ -701,7 +981,7 @@ ret_code_t pds_peer_data_clear(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
 
 pm_peer_id_t pds_peer_id_allocate(void)
 {
-    if (!MODULE_INITIALIZED)
+    if (!MODULE_INITIALIZED || !FDS_READY)
     {
         return PM_PEER_ID_INVALID;
     }
@@ -713,10 +993,50 @@ pm_peer_id_t pds_peer_id_allocate(void)
 ret_code_t pds_peer_id_free(pm_peer_id_t peer_id)
 {
     VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     PEER_IDS_INITIALIZE();
 
+    if (m_pds.bulk_clearing)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
     (void)peer_id_delete(peer_id);
+    CACHE_INVALIDATE(peer_id, PM_PEER_DATA_ID_INVALID);
+    peer_data_clear();
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pds_peer_ids_free(pm_peer_id_filter_t filter)
+{
+    VERIFY_MODULE_INITIALIZED();
+    VERIFY_FDS_READY();
+    PEER_IDS_INITIALIZE();
+
+    if (m_pds.bulk_clearing)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    pm_peer_id_t peer_id = peer_id_get_next_used(PM_PEER_ID_INVALID);
+
+    while (peer_id != PM_PEER_ID_INVALID)
+    {
+        if ((filter == NULL) || filter(peer_id))
+        {
+            (void)peer_id_delete(peer_id);
+            CACHE_INVALIDATE(peer_id, PM_PEER_DATA_ID_INVALID);
+        }
+
+        peer_id = peer_id_get_next_used(peer_id);
+    }
+
+    m_pds.bulk_clearing = true;
+    m_pds.bulk_result   = NRF_SUCCESS;
+
     peer_data_clear();
 
     return NRF_SUCCESS;
@@ -725,7 +1045,7 @@ ret_code_t pds_peer_id_free(pm_peer_id_t peer_id)
 
 bool pds_peer_id_is_allocated(pm_peer_id_t peer_id)
 {
-    if (!MODULE_INITIALIZED)
+    if (!MODULE_INITIALIZED || !FDS_READY)
     {
         return false;
     }
@@ -737,7 +1057,7 @@ bool pds_peer_id_is_allocated(pm_peer_id_t peer_id)
 
 pm_peer_id_t pds_next_peer_id_get(pm_peer_id_t prev_peer_id)
 {
-    if (!MODULE_INITIALIZED)
+    if (!MODULE_INITIALIZED || !FDS_READY)
     {
         return PM_PEER_ID_INVALID;
     }
@@ -749,7 +1069,7 @@ pm_peer_id_t pds_next_peer_id_get(pm_peer_id_t prev_peer_id)
 
 uint32_t pds_n_peers(void)
 {
-    if (!MODULE_INITIALIZED)
+    if (!MODULE_INITIALIZED || !FDS_READY)
     {
         return 0;
     }
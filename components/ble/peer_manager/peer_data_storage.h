@@ -33,6 +33,14 @@
 
 #define PDS_PREPARE_TOKEN_INVALID   0  /**< Invalid value for prepare token. */
 
+#ifndef PDS_CACHE_SIZE
+#define PDS_CACHE_SIZE              0  /**< Number of (peer ID, data ID) record locations kept in RAM. A value of 0 disables the cache. */
+#endif
+
+#ifndef PDS_LAZY_INIT
+#define PDS_LAZY_INIT               0  /**< If 1, requests made before FDS is initialized are rejected with NRF_ERROR_BUSY instead of reading an uninitialized file system, and @ref PDS_EVT_INITIALIZED is sent once they can be retried. */
+#endif
+
 enum
 {
     PEER_ID_TO_FILE_ID         = 0xC000,
@@ -55,7 +63,10 @@ typedef enum
     PDS_EVT_PEER_ID_CLEAR,          /**< The peer id has been successfully cleared. */
     PDS_EVT_ERROR_PEER_ID_CLEAR,    /**< The peer id has been successfully cleared. */
     PDS_EVT_COMPRESSED,             /**< A compress procedure has finished successfully. */
+    PDS_EVT_PEERS_CLEAR,            /**< A call to @ref pds_peer_ids_free has finished, including the flash compression. */
+    PDS_EVT_ERROR_PEERS_CLEAR,      /**< A call to @ref pds_peer_ids_free has finished, but at least one peer could not be cleared or the compression failed. */
     PDS_EVT_ERROR_UNEXPECTED,       /**< An unexpected, possibly fatal error occurred. The unexpected error is included in the event structure. */
+    PDS_EVT_INITIALIZED,            /**< FDS has been initialized. Requests that were rejected with NRF_ERROR_BUSY can be retried. Only sent if @ref PDS_LAZY_INIT is 1. */
 } pds_evt_id_t;
 
 
@@ -309,10 +320,29 @@ pm_peer_id_t pds_peer_id_allocate(void);
  * @retval NRF_SUCCESS             The clear was initiated successfully.
  * @retval NRF_ERROR_INVALID_STATE Module not initialized.
  * @retval NRF_ERROR_INVALID_PARAM Invalid peer ID.
+ * @retval NRF_ERROR_BUSY          A bulk clear started by @ref pds_peer_ids_free is ongoing.
  */
 ret_code_t pds_peer_id_free(pm_peer_id_t peer_id);
 
 
+/**@brief Function for freeing many peer IDs and clearing all their data in one operation.
+ *
+ * @details Every selected peer ID is marked as deleted at once, and the files are deleted one
+ *          after the other. When all files are deleted, flash is compressed once. No events are
+ *          sent for the individual peers; expect a single @ref PDS_EVT_PEERS_CLEAR or
+ *          @ref PDS_EVT_ERROR_PEERS_CLEAR event when everything is done.
+ *
+ * @param[in]  filter  Function selecting the peers to free. The function is called once for
+ *                     every peer ID in use, before this function returns. If NULL, all peers
+ *                     are freed.
+ *
+ * @retval NRF_SUCCESS             The clear was initiated successfully.
+ * @retval NRF_ERROR_BUSY          A bulk clear is already ongoing.
+ * @retval NRF_ERROR_INVALID_STATE Module not initialized.
+ */
+ret_code_t pds_peer_ids_free(pm_peer_id_filter_t filter);
+
+
 /**@brief Function for finding out whether a peer ID is in use.
  *
  * @param[in]  peer_id  The peer ID to inquire about.
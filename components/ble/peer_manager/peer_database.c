@@ -23,7 +23,11 @@
 
 #define MAX_REGISTRANTS    6                         /**< The number of user that can register with the module. */
 
-#define N_WRITE_BUFFERS        8                     /**< The number of write buffers available. */
+#ifndef PM_FLASH_BUFFERS
+#define PM_FLASH_BUFFERS       8                     /**< The number of write buffer blocks available. Must be less than @ref BUFFER_INVALID_ID. */
+#endif
+
+#define N_WRITE_BUFFERS        (PM_FLASH_BUFFERS)    /**< The number of write buffers available. */
 #define N_WRITE_BUFFER_RECORDS (N_WRITE_BUFFERS)     /**< The number of write buffer records. */
 
 /**@brief Macro for verifying that the data ID is among the values eligible for using the write buffer.
@@ -285,6 +289,16 @@ static void pds_evt_handler(pds_evt_t const * p_event)
             event.params.peer_free_failed_evt.err_code = p_event->result;
             pdb_evt_send(&event);
             break;
+        case PDS_EVT_PEERS_CLEAR:
+            retry_flash_full = true;
+            event.evt_id = PDB_EVT_PEERS_FREED;
+            pdb_evt_send(&event);
+            break;
+        case PDS_EVT_ERROR_PEERS_CLEAR:
+            event.evt_id = PDB_EVT_PEERS_FREE_FAILED;
+            event.params.peer_free_failed_evt.err_code = p_event->result;
+            pdb_evt_send(&event);
+            break;
         case PDS_EVT_COMPRESSED:
             retry_flash_full = true;
             event.evt_id = PDB_EVT_COMPRESSED;
@@ -404,9 +418,10 @@ ret_code_t pdb_peer_free(pm_peer_id_t peer_id)
         {
             // No action needed.
         }
-        else if (err_code_in == NRF_ERROR_INVALID_PARAM)
+        else if (   (err_code_in == NRF_ERROR_INVALID_PARAM)
+                 || (err_code_in == NRF_ERROR_BUSY))
         {
-            err_code_out = NRF_ERROR_INVALID_PARAM;
+            err_code_out = err_code_in;
         }
         else
         {
@@ -418,6 +433,32 @@ ret_code_t pdb_peer_free(pm_peer_id_t peer_id)
 }
 
 
+ret_code_t pdb_peers_free(pm_peer_id_filter_t filter)
+{
+    VERIFY_MODULE_INITIALIZED();
+
+    ret_code_t err_code = pds_peer_ids_free(filter);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    // Drop the write buffers of the peers that were just freed.
+    for (uint32_t i = 0; i < N_WRITE_BUFFER_RECORDS; i++)
+    {
+        pm_peer_id_t peer_id = m_pdb.write_buffer_records[i].peer_id;
+
+        if ((peer_id != PM_PEER_ID_INVALID) && !pds_peer_id_is_allocated(peer_id))
+        {
+            (void)pdb_write_buf_release(peer_id, m_pdb.write_buffer_records[i].data_id);
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 ret_code_t pdb_read_buf_get(pm_peer_id_t           peer_id,
                             pm_peer_data_id_t      data_id,
                             pm_peer_data_flash_t * p_peer_data,
@@ -735,6 +776,24 @@ ret_code_t pdb_clear(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
 }
 
 
+ret_code_t pdb_write_buffer_stats_get(pm_buffer_stats_t * p_stats)
+{
+    VERIFY_MODULE_INITIALIZED();
+    return pm_buffer_stats_get(&m_pdb.write_buffer, p_stats);
+}
+
+
+bool pdb_peer_id_is_allocated(pm_peer_id_t peer_id)
+{
+    if (!MODULE_INITIALIZED)
+    {
+        return false;
+    }
+
+    return pds_peer_id_is_allocated(peer_id);
+}
+
+
 uint32_t pdb_n_peers(void)
 {
     if (!MODULE_INITIALIZED)
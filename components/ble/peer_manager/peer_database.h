@@ -42,6 +42,8 @@ typedef enum
     PDB_EVT_CLEAR_FAILED,       /**< A @ref pdb_clear operation has failed. */
     PDB_EVT_PEER_FREED,         /**< A @ref pdb_peer_free operation has completed successfully. All associated data has been erased. */
     PDB_EVT_PEER_FREE_FAILED,   /**< A @ref pdb_peer_free operation has failed. */
+    PDB_EVT_PEERS_FREED,        /**< A @ref pdb_peers_free operation has completed successfully. All associated data has been erased and the flash has been compressed. */
+    PDB_EVT_PEERS_FREE_FAILED,  /**< A @ref pdb_peers_free operation has failed. */
     PDB_EVT_COMPRESSED,         /**< A compress procedure has completed. */
     PDB_EVT_ERROR_NO_MEM,       /**< An operation is blocked because the flash is full. It will be reattempted automatically after the next compress procedure. */
     PDB_EVT_ERROR_UNEXPECTED,   /**< An unexpected error occurred. This is a fatal error. */
@@ -76,7 +78,7 @@ typedef struct
         struct
         {
             ret_code_t err_code;           /**< The error that occurred. */
-        } peer_free_failed_evt;            /**< Additional information pertaining to the @ref PDB_EVT_PEER_FREE_FAILED event. */
+        } peer_free_failed_evt;            /**< Additional information pertaining to the @ref PDB_EVT_PEER_FREE_FAILED and @ref PDB_EVT_PEERS_FREE_FAILED events. */
         struct
         {
             ret_code_t err_code;           /**< The unexpected error that occurred. */
@@ -121,11 +123,27 @@ pm_peer_id_t pdb_peer_allocate(void);
  *
  * @retval NRF_SUCCESS              Peer ID was released and clear operation was initiated successfully.
  * @retval NRF_ERROR_INVALID_PARAM  Peer ID was invalid.
+ * @retval NRF_ERROR_BUSY           A @ref pdb_peers_free operation is ongoing.
  * @retval NRF_ERROR_INVALID_STATE  Module is not initialized.
  */
 ret_code_t pdb_peer_free(pm_peer_id_t peer_id);
 
 
+/**@brief Function for freeing the persistent bond storage of many peers in one operation.
+ *
+ * @details Write buffers of the freed peers are released. No @ref PDB_EVT_PEER_FREED events are
+ *          sent; a single @ref PDB_EVT_PEERS_FREED or @ref PDB_EVT_PEERS_FREE_FAILED event is sent
+ *          when all data has been erased and the flash has been compressed.
+ *
+ * @param[in] filter  Function selecting the peers to free, or NULL to free all peers.
+ *
+ * @retval NRF_SUCCESS              The operation was initiated successfully.
+ * @retval NRF_ERROR_BUSY           A @ref pdb_peers_free operation is already ongoing.
+ * @retval NRF_ERROR_INVALID_STATE  Module is not initialized.
+ */
+ret_code_t pdb_peers_free(pm_peer_id_filter_t filter);
+
+
 /**@brief Function for retrieving pointers to read-only peer data.
  *
  * @note  Reading this pointer is not safe in the strictest sense. If a safe read is required:
@@ -263,6 +281,27 @@ ret_code_t pdb_write_buf_store(pm_peer_id_t      peer_id,
 ret_code_t pdb_clear(pm_peer_id_t peer_id, pm_peer_data_id_t data_id);
 
 
+/**@brief Function for getting the occupancy statistics of the write buffer.
+ *
+ * @param[out] p_stats  The statistics.
+ *
+ * @retval NRF_SUCCESS              The statistics were copied to p_stats.
+ * @retval NRF_ERROR_NULL           p_stats was NULL.
+ * @retval NRF_ERROR_INVALID_STATE  Module is not initialized.
+ */
+ret_code_t pdb_write_buffer_stats_get(pm_buffer_stats_t * p_stats);
+
+
+/**@brief Function for finding out whether a peer ID is in use.
+ *
+ * @param[in]  peer_id  The peer ID to inquire about.
+ *
+ * @retval  true   peer_id is in use.
+ * @retval  false  peer_id is free, is being freed, or the module is not initialized.
+ */
+bool pdb_peer_id_is_allocated(pm_peer_id_t peer_id);
+
+
 /**@brief Function for querying the number of valid peer IDs available. I.E the number of peers
  *        in persistent storage.
  *
@@ -28,6 +28,20 @@
 
 #define MAX_REGISTRANTS 3  /**< The number of event handlers that can be registered with the module. */
 
+#ifndef PM_PEER_RANK_LIST_SIZE
+#define PM_PEER_RANK_LIST_SIZE 8 /**< The number of peer ranks kept in RAM, ordered from highest to lowest. */
+#endif
+
+
+/**@brief A peer rank kept in RAM.
+ */
+typedef struct
+{
+    pm_peer_id_t peer_id; /**< The peer. */
+    uint32_t     rank;    /**< The rank of the peer. */
+    bool         dirty;   /**< Whether the rank has yet to be written to flash. */
+} pm_rank_entry_t;
+
 
 /**@brief Internal state of the module.
  */
@@ -35,10 +49,15 @@ typedef struct
 {
     uint8_t                       initialized           : 1;     /**< Whether or not @ref pm_init has been called successfully. */
     uint8_t                       peer_rank_initialized : 1;     /**< Whether or not @ref rank_init has been called successfully. */
-    uint8_t                       deleting_all          : 1;     /**< True from when @ref pm_peers_delete is called until all peers have been deleted. */
+    uint8_t                       deleting_all          : 1;     /**< True from when @ref pm_peers_delete or @ref pm_peers_delete_low_ranked is called until the deletion has finished. */
     pm_store_token_t              peer_rank_token;               /**< The store token of an ongoing peer rank update via a call to @ref pm_peer_rank_highest. If @ref PM_STORE_TOKEN_INVALID, there is no ongoing update. */
     uint32_t                      current_highest_peer_rank;     /**< The current highest peer rank. Used by @ref pm_peer_rank_highest. */
+    uint32_t                      delete_rank_threshold;         /**< Peers ranked lower than this are deleted by @ref pm_peers_delete_low_ranked. */
     pm_peer_id_t                  highest_ranked_peer;           /**< The peer with the highest peer rank. Used by @ref pm_peer_rank_highest. */
+    pm_rank_entry_t               rank_list[PM_PEER_RANK_LIST_SIZE]; /**< The highest ranked peers, ordered from highest to lowest rank. */
+    uint8_t                       rank_list_len;                 /**< The number of entries in @ref pm_t::rank_list. */
+    bool                          rank_list_complete;            /**< Whether @ref pm_t::rank_list holds every ranked peer, so peers not in it have no rank. */
+    uint32_t                      rank_store_value;              /**< The rank being written to flash. Must stay valid until the write has completed. */
     pm_evt_handler_t              evt_handlers[MAX_REGISTRANTS]; /**< The subscribers to Peer Manager events, as registered through @ref pm_register. */
     uint8_t                       n_registrants;                 /**< The number of event handlers registered through @ref pm_register. */
     ble_conn_state_user_flag_id_t pairing_flag_id;               /**< The flag ID for which connections are paired. */
@@ -67,6 +86,252 @@ static void evt_send(pm_evt_t * p_pm_evt)
 }
 
 
+/**@brief Function for reading the rank of a peer.
+ *
+ * @param[in]  peer_id  The peer.
+ *
+ * @return The rank of the peer, or 0 if it has none.
+ */
+static uint32_t peer_rank_get(pm_peer_id_t peer_id)
+{
+    uint32_t       peer_rank = 0;
+    //lint -save -e65 -e64
+    pm_peer_data_t peer_data = {.length_words = BYTES_TO_WORDS(sizeof(peer_rank)),
+                                .p_peer_rank  = &peer_rank};
+    //lint -restore
+
+    if (pdb_raw_read(peer_id, PM_PEER_DATA_ID_PEER_RANK, &peer_data) != NRF_SUCCESS)
+    {
+        return 0;
+    }
+
+    return peer_rank;
+}
+
+
+/**@brief Function for finding the entry of a peer in the rank list.
+ *
+ * @param[in]  peer_id  The peer.
+ *
+ * @return The index of the entry, or @ref pm_t::rank_list_len if the peer is not in the list.
+ */
+static uint32_t rank_list_find(pm_peer_id_t peer_id)
+{
+    uint32_t index;
+
+    for (index = 0; index < m_pm.rank_list_len; index++)
+    {
+        if (m_pm.rank_list[index].peer_id == peer_id)
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+
+/**@brief Function for removing a peer from the rank list, if it is in it.
+ *
+ * @param[in]  peer_id  The peer.
+ */
+static void rank_list_remove(pm_peer_id_t peer_id)
+{
+    uint32_t index = rank_list_find(peer_id);
+
+    if (index < m_pm.rank_list_len)
+    {
+        m_pm.rank_list_len--;
+        memmove(&m_pm.rank_list[index],
+                &m_pm.rank_list[index + 1],
+                (m_pm.rank_list_len - index) * sizeof(pm_rank_entry_t));
+    }
+}
+
+
+/**@brief Function for putting a peer at its place in the rank list.
+ *
+ * @details Peers without a rank are not kept in the list. If the list is full, the lowest rank is
+ *          dropped from it, and the list no longer holds every ranked peer.
+ *
+ * @param[in]  peer_id  The peer.
+ * @param[in]  rank     The rank of the peer.
+ * @param[in]  dirty    Whether the rank has yet to be written to flash.
+ *
+ * @retval NRF_SUCCESS     If the list was updated.
+ * @retval NRF_ERROR_BUSY  If the list is full, and the rank that would be dropped has not been
+ *                         written to flash yet.
+ */
+static ret_code_t rank_list_insert(pm_peer_id_t peer_id, uint32_t rank, bool dirty)
+{
+    uint32_t index;
+
+    rank_list_remove(peer_id);
+
+    if (rank == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    if (m_pm.rank_list_len == PM_PEER_RANK_LIST_SIZE)
+    {
+        if (m_pm.rank_list[m_pm.rank_list_len - 1].rank > rank)
+        {
+            // The new rank is the one that is dropped.
+            m_pm.rank_list_complete = false;
+            return NRF_SUCCESS;
+        }
+        if (m_pm.rank_list[m_pm.rank_list_len - 1].dirty)
+        {
+            return NRF_ERROR_BUSY;
+        }
+        m_pm.rank_list_len--;
+        m_pm.rank_list_complete = false;
+    }
+
+    for (index = 0; index < m_pm.rank_list_len; index++)
+    {
+        if (m_pm.rank_list[index].rank < rank)
+        {
+            break;
+        }
+    }
+
+    memmove(&m_pm.rank_list[index + 1],
+            &m_pm.rank_list[index],
+            (m_pm.rank_list_len - index) * sizeof(pm_rank_entry_t));
+
+    m_pm.rank_list[index].peer_id = peer_id;
+    m_pm.rank_list[index].rank    = rank;
+    m_pm.rank_list[index].dirty   = dirty;
+    m_pm.rank_list_len++;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for building the rank list and the highest rank from the ranks in flash.
+ */
+static void rank_init(void)
+{
+    pm_peer_id_t peer_id = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
+
+    m_pm.rank_list_len             = 0;
+    m_pm.rank_list_complete        = true;
+    m_pm.current_highest_peer_rank = 0;
+    m_pm.highest_ranked_peer       = PM_PEER_ID_INVALID;
+
+    while (peer_id != PM_PEER_ID_INVALID)
+    {
+        uint32_t peer_rank = peer_rank_get(peer_id);
+
+        if (peer_rank > m_pm.current_highest_peer_rank)
+        {
+            m_pm.current_highest_peer_rank = peer_rank;
+            m_pm.highest_ranked_peer       = peer_id;
+        }
+
+        // Cannot fail, because no entry is dirty.
+        (void)rank_list_insert(peer_id, peer_rank, false);
+
+        peer_id = pdb_next_peer_id_get(peer_id);
+    }
+
+    m_pm.peer_rank_initialized = true;
+}
+
+
+/**@brief Function for getting the current rank of a peer.
+ *
+ * @details The rank is taken from the rank list, which can be ahead of flash. Flash is only read
+ *          if the list does not hold every ranked peer.
+ *
+ * @param[in]  peer_id  The peer.
+ *
+ * @return The rank of the peer, or 0 if it has none.
+ */
+static uint32_t rank_get(pm_peer_id_t peer_id)
+{
+    uint32_t index;
+
+    if (!m_pm.peer_rank_initialized)
+    {
+        rank_init();
+    }
+
+    index = rank_list_find(peer_id);
+
+    if (index < m_pm.rank_list_len)
+    {
+        return m_pm.rank_list[index].rank;
+    }
+    if (m_pm.rank_list_complete)
+    {
+        return 0;
+    }
+    return peer_rank_get(peer_id);
+}
+
+
+/**@brief Function for writing the next rank that has only been updated in RAM to flash.
+ *
+ * @details Only one rank is written at a time. The next one is written when the write completes.
+ *          If the write cannot be started, it is retried on the next flash event.
+ */
+static void rank_store_next(void)
+{
+    //lint -save -e65 -e64
+    pm_peer_data_const_t peer_data = {.length_words = BYTES_TO_WORDS(sizeof(m_pm.rank_store_value)),
+                                      .data_id      = PM_PEER_DATA_ID_PEER_RANK,
+                                      .p_peer_rank  = &m_pm.rank_store_value};
+    //lint -restore
+
+    if (m_pm.peer_rank_token != PM_STORE_TOKEN_INVALID)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_pm.rank_list_len; i++)
+    {
+        if (m_pm.rank_list[i].dirty)
+        {
+            m_pm.rank_store_value = m_pm.rank_list[i].rank;
+
+            if (pdb_raw_store(m_pm.rank_list[i].peer_id, &peer_data, &m_pm.peer_rank_token)
+                != NRF_SUCCESS)
+            {
+                m_pm.peer_rank_token = PM_STORE_TOKEN_INVALID;
+            }
+            return;
+        }
+    }
+}
+
+
+/**@brief Function for removing the peers that no longer exist from the rank list.
+ */
+static void rank_list_prune(void)
+{
+    uint32_t index = 0;
+
+    while (index < m_pm.rank_list_len)
+    {
+        if (pdb_peer_id_is_allocated(m_pm.rank_list[index].peer_id))
+        {
+            index++;
+        }
+        else
+        {
+            rank_list_remove(m_pm.rank_list[index].peer_id);
+        }
+    }
+
+    if (!pdb_peer_id_is_allocated(m_pm.highest_ranked_peer))
+    {
+        m_pm.highest_ranked_peer = PM_PEER_ID_INVALID;
+    }
+}
+
+
 /**@brief Event handler for events from the Peer Database module.
  *
  * @param[in]  p_pdb_evt  The incoming Peer Database event.
@@ -101,11 +366,33 @@ static void pdb_evt_handler(pdb_evt_t const * p_pdb_evt)
             if(    (m_pm.peer_rank_token != PM_STORE_TOKEN_INVALID)
                 && (m_pm.peer_rank_token == p_pdb_evt->params.raw_stored_evt.store_token))
             {
-                m_pm.peer_rank_token     = PM_STORE_TOKEN_INVALID;
-                m_pm.highest_ranked_peer = pm_evt.peer_id;
+                uint32_t index = rank_list_find(pm_evt.peer_id);
+
+                m_pm.peer_rank_token = PM_STORE_TOKEN_INVALID;
+
+                // The rank may have been raised again while it was being written.
+                if ((index < m_pm.rank_list_len)
+                    && (m_pm.rank_list[index].rank == m_pm.rank_store_value))
+                {
+                    m_pm.rank_list[index].dirty = false;
+                }
 
                 pm_evt.params.peer_data_update_succeeded.token = PM_STORE_TOKEN_INVALID;
             }
+            else if (   (p_pdb_evt->data_id == PM_PEER_DATA_ID_PEER_RANK)
+                     && m_pm.peer_rank_initialized)
+            {
+                // The rank was written through the peer data API.
+                uint32_t peer_rank = peer_rank_get(pm_evt.peer_id);
+
+                (void)rank_list_insert(pm_evt.peer_id, peer_rank, false);
+                if (peer_rank > m_pm.current_highest_peer_rank)
+                {
+                    m_pm.current_highest_peer_rank = peer_rank;
+                    m_pm.highest_ranked_peer       = pm_evt.peer_id;
+                }
+            }
+            rank_store_next();
             break;
 
         case PDB_EVT_RAW_STORE_FAILED:
@@ -120,8 +407,8 @@ static void pdb_evt_handler(pdb_evt_t const * p_pdb_evt)
             if(    (m_pm.peer_rank_token != PM_STORE_TOKEN_INVALID)
                 && (m_pm.peer_rank_token == p_pdb_evt->params.raw_stored_evt.store_token))
             {
-                m_pm.peer_rank_token            = PM_STORE_TOKEN_INVALID;
-                m_pm.current_highest_peer_rank -= 1;
+                // The rank stays dirty, and the write is retried on the next flash event.
+                m_pm.peer_rank_token = PM_STORE_TOKEN_INVALID;
 
                 pm_evt.params.peer_data_update_succeeded.token = PM_STORE_TOKEN_INVALID;
             }
@@ -143,48 +430,47 @@ static void pdb_evt_handler(pdb_evt_t const * p_pdb_evt)
             break;
 
         case PDB_EVT_PEER_FREED:
-            pm_evt.evt_id = PM_EVT_PEER_DELETE_SUCCEEDED;
-            if (m_pm.deleting_all && (pdb_next_peer_id_get(PM_PEER_ID_INVALID) == PM_PEER_ID_INVALID))
+            if (m_pm.peer_rank_initialized)
             {
-                // pm_peers_delete() has been called and this is the last peer to be deleted.
-
-                m_pm.deleting_all = false;
-
-                pm_evt_t pm_delete_all_evt;
-                memset(&pm_delete_all_evt, 0, sizeof(pm_evt_t));
-                pm_delete_all_evt.evt_id      = PM_EVT_PEERS_DELETE_SUCCEEDED;
-                pm_delete_all_evt.peer_id     = PM_PEER_ID_INVALID;
-                pm_delete_all_evt.conn_handle = BLE_CONN_HANDLE_INVALID;
-
-                evt_send(&pm_delete_all_evt);
+                rank_list_prune();
             }
+            pm_evt.evt_id = PM_EVT_PEER_DELETE_SUCCEEDED;
             break;
 
         case PDB_EVT_PEER_FREE_FAILED:
             pm_evt.evt_id = PM_EVT_PEER_DELETE_FAILED;
             pm_evt.params.peer_delete_failed.error
                                                 = p_pdb_evt->params.peer_free_failed_evt.err_code;
-            if (m_pm.deleting_all)
-            {
-                // pm_peers_delete() has been called and has thus failed.
+            break;
 
-                m_pm.deleting_all = false;
+        case PDB_EVT_PEERS_FREED:
+            // pm_peers_delete() or pm_peers_delete_low_ranked() has finished.
+            m_pm.deleting_all = false;
+            if (m_pm.peer_rank_initialized)
+            {
+                rank_list_prune();
+            }
 
-                pm_evt_t pm_delete_all_evt;
-                memset(&pm_delete_all_evt, 0, sizeof(pm_evt_t));
-                pm_delete_all_evt.evt_id      = PM_EVT_PEERS_DELETE_FAILED;
-                pm_delete_all_evt.peer_id     = PM_PEER_ID_INVALID;
-                pm_delete_all_evt.conn_handle = BLE_CONN_HANDLE_INVALID;
-                pm_delete_all_evt.params.peers_delete_failed_evt.error
-                                              = p_pdb_evt->params.peer_free_failed_evt.err_code;
+            pm_evt.evt_id      = PM_EVT_PEERS_DELETE_SUCCEEDED;
+            pm_evt.conn_handle = BLE_CONN_HANDLE_INVALID;
+            break;
 
-                evt_send(&pm_delete_all_evt);
+        case PDB_EVT_PEERS_FREE_FAILED:
+            m_pm.deleting_all = false;
+            if (m_pm.peer_rank_initialized)
+            {
+                rank_list_prune();
             }
+
+            pm_evt.evt_id      = PM_EVT_PEERS_DELETE_FAILED;
+            pm_evt.conn_handle = BLE_CONN_HANDLE_INVALID;
+            pm_evt.params.peers_delete_failed_evt.error
+                                                = p_pdb_evt->params.peer_free_failed_evt.err_code;
             break;
 
         case PDB_EVT_COMPRESSED:
             send_evt = false;
-            // Do nothing
+            rank_store_next();
             break;
 
         case PDB_EVT_ERROR_NO_MEM:
@@ -629,6 +915,27 @@ ret_code_t pm_lesc_public_key_set(ble_gap_lesc_p256_pk_t * p_public_key)
 }
 
 
+ret_code_t pm_lesc_private_key_set(uint8_t const * p_private_key)
+{
+    VERIFY_MODULE_INITIALIZED();
+    return sm_lesc_private_key_set(p_private_key);
+}
+
+
+ret_code_t pm_lesc_keypair_rotate(void)
+{
+    VERIFY_MODULE_INITIALIZED();
+    return sm_lesc_keypair_rotate();
+}
+
+
+ret_code_t pm_lesc_timing_get(uint16_t conn_handle, pm_lesc_timing_t * p_timing)
+{
+    VERIFY_MODULE_INITIALIZED();
+    return sm_lesc_timing_get(conn_handle, p_timing);
+}
+
+
 ret_code_t pm_conn_handle_get(pm_peer_id_t peer_id, uint16_t * p_conn_handle)
 {
     VERIFY_MODULE_INITIALIZED();
@@ -647,6 +954,24 @@ ret_code_t pm_peer_id_get(uint16_t conn_handle, pm_peer_id_t * p_peer_id)
 }
 
 
+ret_code_t pm_peer_id_get_by_addr(ble_gap_addr_t const * p_addr, pm_peer_id_t * p_peer_id)
+{
+    VERIFY_MODULE_INITIALIZED();
+    VERIFY_PARAM_NOT_NULL(p_addr);
+    VERIFY_PARAM_NOT_NULL(p_peer_id);
+    *p_peer_id = im_peer_id_get_by_addr(p_addr);
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_flash_buffer_stats_get(pm_buffer_stats_t * p_stats)
+{
+    VERIFY_MODULE_INITIALIZED();
+    VERIFY_PARAM_NOT_NULL(p_stats);
+    return pdb_write_buffer_stats_get(p_stats);
+}
+
+
 uint32_t pm_peer_count(void)
 {
     if (!MODULE_INITIALIZED)
@@ -843,25 +1168,91 @@ ret_code_t pm_peer_delete(pm_peer_id_t peer_id)
 }
 
 
+/**@brief Function for starting a bulk deletion of peers.
+ *
+ * @param[in]  filter  Function selecting the peers to delete, or NULL to delete all peers.
+ */
+static ret_code_t peers_delete(pm_peer_id_filter_t filter)
+{
+    ret_code_t err_code;
+
+    if (m_pm.deleting_all)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    // Set before starting, since the completion event can be sent before im_peers_free() returns.
+    m_pm.deleting_all = true;
+
+    err_code = im_peers_free(filter);
+    if (err_code != NRF_SUCCESS)
+    {
+        m_pm.deleting_all = false;
+        return (err_code == NRF_ERROR_BUSY) ? NRF_ERROR_BUSY : NRF_ERROR_INTERNAL;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Filter selecting the peers ranked lower than @ref pm_t::delete_rank_threshold.
+ */
+static bool peer_is_low_ranked(pm_peer_id_t peer_id)
+{
+    return (rank_get(peer_id) < m_pm.delete_rank_threshold);
+}
+
+
 ret_code_t pm_peers_delete(void)
 {
     VERIFY_MODULE_INITIALIZED();
 
-    m_pm.deleting_all = true;
+    return peers_delete(NULL);
+}
+
+
+ret_code_t pm_peers_delete_low_ranked(uint32_t n_peers_to_keep)
+{
+    VERIFY_MODULE_INITIALIZED();
+
+    // Ranks start at 1, so peers without a rank are always below the threshold.
+    uint32_t threshold = 1;
 
-    pm_peer_id_t current_peer_id = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
-    while (current_peer_id != PM_PEER_ID_INVALID)
+    if (n_peers_to_keep == 0)
     {
-        ret_code_t err_code = pm_peer_delete(current_peer_id);
-        if (err_code != NRF_SUCCESS)
+        return peers_delete(NULL);
+    }
+
+    // Find the rank of the n_peers_to_keep'th highest ranked peer. Ranks are unique.
+    for (uint32_t i = 0; i < n_peers_to_keep; i++)
+    {
+        uint32_t     next_rank = 0;
+        pm_peer_id_t peer_id   = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
+
+        while (peer_id != PM_PEER_ID_INVALID)
+        {
+            uint32_t peer_rank = rank_get(peer_id);
+
+            if ((peer_rank > next_rank) && ((i == 0) || (peer_rank < threshold)))
+            {
+                next_rank = peer_rank;
+            }
+
+            peer_id = pdb_next_peer_id_get(peer_id);
+        }
+
+        if (next_rank == 0)
         {
-            return NRF_ERROR_INTERNAL;
+            // Fewer than n_peers_to_keep peers have a rank.
+            break;
         }
 
-        current_peer_id = pdb_next_peer_id_get(current_peer_id);
+        threshold = next_rank;
     }
 
-    return NRF_SUCCESS;
+    m_pm.delete_rank_threshold = threshold;
+
+    return peers_delete(peer_is_low_ranked);
 }
 
 
@@ -873,82 +1264,69 @@ ret_code_t pm_peer_ranks_get(pm_peer_id_t * p_highest_ranked_peer,
     VERIFY_MODULE_INITIALIZED();
 
     pm_peer_id_t         peer_id      = pdb_next_peer_id_get(PM_PEER_ID_INVALID);
-    uint32_t             peer_rank    = 0;
-    //lint -save -e65 -e64
-    pm_peer_data_t       peer_data    = {.length_words = BYTES_TO_WORDS(sizeof(peer_rank)),
-                                         .p_peer_rank  = &peer_rank};
-    //lint -restore
-    ret_code_t           err_code     = pdb_raw_read(peer_id, PM_PEER_DATA_ID_PEER_RANK, &peer_data);
     uint32_t             highest_rank = 0;
     uint32_t             lowest_rank  = 0xFFFFFFFF;
     pm_peer_id_t         highest_ranked_peer = PM_PEER_ID_INVALID;
     pm_peer_id_t         lowest_ranked_peer  = PM_PEER_ID_INVALID;
 
-    if (err_code == NRF_ERROR_INVALID_PARAM)
+    if (peer_id == PM_PEER_ID_INVALID)
     {
         // No peer IDs exist.
         return NRF_ERROR_NOT_FOUND;
     }
 
-    while ((err_code == NRF_SUCCESS) || (err_code == NRF_ERROR_NOT_FOUND))
+    if (!m_pm.peer_rank_initialized)
     {
-        if (err_code == NRF_ERROR_NOT_FOUND)
-        {
-            peer_rank = 0;
-        }
-        if (peer_rank >= highest_rank)
-        {
-            highest_rank      = peer_rank;
-            highest_ranked_peer = peer_id;
-        }
-        if (peer_rank < lowest_rank)
-        {
-            lowest_rank      = peer_rank;
-            lowest_ranked_peer = peer_id;
-        }
-        peer_id = pdb_next_peer_id_get(peer_id);
-        err_code = pdb_raw_read(peer_id, PM_PEER_DATA_ID_PEER_RANK, &peer_data);
+        rank_init();
     }
-    if (peer_id == PM_PEER_ID_INVALID)
+
+    if (   m_pm.rank_list_complete
+        && (m_pm.rank_list_len > 0)
+        && (m_pm.rank_list_len == pdb_n_peers()))
     {
-        err_code = NRF_SUCCESS;
-        if (p_highest_ranked_peer != NULL)
-        {
-            *p_highest_ranked_peer = highest_ranked_peer;
-        }
-        if (p_highest_rank != NULL)
-        {
-            *p_highest_rank = highest_rank;
-        }
-        if (p_lowest_ranked_peer != NULL)
-        {
-            *p_lowest_ranked_peer = lowest_ranked_peer;
-        }
-        if (p_lowest_rank != NULL)
-        {
-            *p_lowest_rank = lowest_rank;
-        }
+        // Every peer is ranked, so the answer is at the ends of the list.
+        highest_ranked_peer = m_pm.rank_list[0].peer_id;
+        highest_rank        = m_pm.rank_list[0].rank;
+        lowest_ranked_peer  = m_pm.rank_list[m_pm.rank_list_len - 1].peer_id;
+        lowest_rank         = m_pm.rank_list[m_pm.rank_list_len - 1].rank;
     }
     else
     {
-        err_code = NRF_ERROR_INTERNAL;
-    }
-    return err_code;
-}
+        while (peer_id != PM_PEER_ID_INVALID)
+        {
+            uint32_t peer_rank = rank_get(peer_id);
 
+            if (peer_rank >= highest_rank)
+            {
+                highest_rank      = peer_rank;
+                highest_ranked_peer = peer_id;
+            }
+            if (peer_rank < lowest_rank)
+            {
+                lowest_rank      = peer_rank;
+                lowest_ranked_peer = peer_id;
+            }
+            peer_id = pdb_next_peer_id_get(peer_id);
+        }
+    }
 
-/**@brief Function for initializing peer rank statistics.
- */
-static void rank_init(void)
-{
-    ret_code_t err_code = pm_peer_ranks_get(&m_pm.highest_ranked_peer,
-                                            &m_pm.current_highest_peer_rank,
-                                            NULL,
-                                            NULL);
-    if ((err_code == NRF_SUCCESS) || (err_code == NRF_ERROR_NOT_FOUND))
+    if (p_highest_ranked_peer != NULL)
+    {
+        *p_highest_ranked_peer = highest_ranked_peer;
+    }
+    if (p_highest_rank != NULL)
+    {
+        *p_highest_rank = highest_rank;
+    }
+    if (p_lowest_ranked_peer != NULL)
+    {
+        *p_lowest_ranked_peer = lowest_ranked_peer;
+    }
+    if (p_lowest_rank != NULL)
     {
-        m_pm.peer_rank_initialized = true;
+        *p_lowest_rank = lowest_rank;
     }
+    return NRF_SUCCESS;
 }
 
 
@@ -957,56 +1335,46 @@ ret_code_t pm_peer_rank_highest(pm_peer_id_t peer_id)
     VERIFY_MODULE_INITIALIZED();
 
     ret_code_t err_code;
-    //lint -save -e65 -e64
-    pm_peer_data_const_t peer_data   = {.length_words = BYTES_TO_WORDS(sizeof(m_pm.current_highest_peer_rank)),
-                                        .data_id      = PM_PEER_DATA_ID_PEER_RANK,
-                                        .p_peer_rank  = &m_pm.current_highest_peer_rank};
-    //lint -restore
-
 
     if (!m_pm.peer_rank_initialized)
     {
         rank_init();
     }
 
-    if (!m_pm.peer_rank_initialized || (m_pm.peer_rank_token != PM_STORE_TOKEN_INVALID))
+    if (!pdb_peer_id_is_allocated(peer_id))
     {
-        err_code = NRF_ERROR_BUSY;
+        return NRF_ERROR_INVALID_PARAM;
     }
-    else
-    {
-        if ((peer_id == m_pm.highest_ranked_peer) && (m_pm.current_highest_peer_rank > 0))
-        {
-            pm_evt_t pm_evt;
 
-            // The reported peer is already regarded as highest (provided it has an index at all)
-            err_code = NRF_SUCCESS;
+    if ((peer_id == m_pm.highest_ranked_peer) && (m_pm.current_highest_peer_rank > 0))
+    {
+        pm_evt_t pm_evt;
+
+        // The reported peer is already regarded as highest (provided it has an index at all)
+        memset(&pm_evt, 0, sizeof(pm_evt));
+        pm_evt.evt_id      = PM_EVT_PEER_DATA_UPDATE_SUCCEEDED;
+        pm_evt.conn_handle = im_conn_handle_get(peer_id);
+        pm_evt.peer_id     = peer_id;
+        pm_evt.params.peer_data_update_succeeded.data_id       = PM_PEER_DATA_ID_PEER_RANK;
+        pm_evt.params.peer_data_update_succeeded.action        = PM_PEER_DATA_OP_UPDATE;
+        pm_evt.params.peer_data_update_succeeded.token         = PM_STORE_TOKEN_INVALID;
+        pm_evt.params.peer_data_update_succeeded.flash_changed = false;
 
-            memset(&pm_evt, 0, sizeof(pm_evt));
-            pm_evt.evt_id      = PM_EVT_PEER_DATA_UPDATE_SUCCEEDED;
-            pm_evt.conn_handle = im_conn_handle_get(peer_id);
-            pm_evt.peer_id     = peer_id;
-            pm_evt.params.peer_data_update_succeeded.data_id       = PM_PEER_DATA_ID_PEER_RANK;
-            pm_evt.params.peer_data_update_succeeded.action        = PM_PEER_DATA_OP_UPDATE;
-            pm_evt.params.peer_data_update_succeeded.token         = PM_STORE_TOKEN_INVALID;
-            pm_evt.params.peer_data_update_succeeded.flash_changed = false;
+        evt_send(&pm_evt);
+        return NRF_SUCCESS;
+    }
 
-            evt_send(&pm_evt);
-        }
-        else
-        {
-            m_pm.current_highest_peer_rank += 1;
-            err_code = pdb_raw_store(peer_id, &peer_data, &m_pm.peer_rank_token);
-            if (err_code != NRF_SUCCESS)
-            {
-                m_pm.peer_rank_token    = PM_STORE_TOKEN_INVALID;
-                m_pm.current_highest_peer_rank -= 1;
-                if ((err_code != NRF_ERROR_BUSY) && (err_code != NRF_ERROR_NO_MEM))
-                {
-                    err_code = NRF_ERROR_INTERNAL;
-                }
-            }
-        }
+    // Rank the peer in RAM right away. The rank is written to flash when flash is available.
+    err_code = rank_list_insert(peer_id, m_pm.current_highest_peer_rank + 1, true);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
     }
-    return err_code;
+
+    m_pm.current_highest_peer_rank += 1;
+    m_pm.highest_ranked_peer        = peer_id;
+
+    rank_store_next();
+
+    return NRF_SUCCESS;
 }
@@ -65,8 +65,8 @@ typedef enum
     PM_EVT_PEER_DATA_UPDATE_FAILED,         /**< @brief A piece of peer data could not be stored, updated, or cleared in flash storage. This event is sent instead of @ref PM_EVT_PEER_DATA_UPDATE_SUCCEEDED for the failed operation. */
     PM_EVT_PEER_DELETE_SUCCEEDED,           /**< @brief A peer was cleared from flash storage, for example because a call to @ref pm_peer_delete succeeded. This event can also be sent as part of a call to @ref pm_peers_delete or internal cleanup. */
     PM_EVT_PEER_DELETE_FAILED,              /**< @brief A peer could not be cleared from flash storage. This event is sent instead of @ref PM_EVT_PEER_DELETE_SUCCEEDED for the failed operation. */
-    PM_EVT_PEERS_DELETE_SUCCEEDED,          /**< @brief A call to @ref pm_peers_delete has completed successfully. Flash storage now contains no peer data. */
-    PM_EVT_PEERS_DELETE_FAILED,             /**< @brief A call to @ref pm_peers_delete has failed, which means that at least one of the peers could not be deleted. Other peers might have been deleted, or might still be queued to be deleted. No more @ref PM_EVT_PEERS_DELETE_SUCCEEDED or @ref PM_EVT_PEERS_DELETE_FAILED events are sent until the next time @ref pm_peers_delete is called. */
+    PM_EVT_PEERS_DELETE_SUCCEEDED,          /**< @brief A call to @ref pm_peers_delete or @ref pm_peers_delete_low_ranked has completed successfully. Flash storage now contains no data for the deleted peers, and the flash has been compressed. */
+    PM_EVT_PEERS_DELETE_FAILED,             /**< @brief A call to @ref pm_peers_delete or @ref pm_peers_delete_low_ranked has failed, which means that at least one of the peers could not be deleted, or the flash could not be compressed. Other peers might have been deleted. No more @ref PM_EVT_PEERS_DELETE_SUCCEEDED or @ref PM_EVT_PEERS_DELETE_FAILED events are sent until the next bulk deletion is started. */
     PM_EVT_LOCAL_DB_CACHE_APPLIED,          /**< @brief Local database values for a peer (taken from flash storage) have been provided to the SoftDevice. */
     PM_EVT_LOCAL_DB_CACHE_APPLY_FAILED,     /**< @brief Local database values for a peer (taken from flash storage) were rejected by the SoftDevice, which means that either the database has changed or the user has manually set the local database to an invalid value (using @ref pm_peer_data_store). */
     PM_EVT_SERVICE_CHANGED_IND_SENT,        /**< @brief A service changed indication has been sent to a peer, as a result of a call to @ref pm_local_database_has_changed. This event will be followed by a @ref PM_EVT_SERVICE_CHANGED_IND_CONFIRMED event if the peer acknowledges the indication. */
@@ -314,6 +314,59 @@ ret_code_t pm_conn_sec_status_get(uint16_t conn_handle, pm_conn_sec_status_t * p
 ret_code_t pm_lesc_public_key_set(ble_gap_lesc_p256_pk_t * p_public_key);
 
 
+/**@brief Experimental function for letting Peer Manager compute LESC DH keys.
+ *
+ * @details When a private key is set, Peer Manager replies to @ref BLE_GAP_EVT_LESC_DHKEY_REQUEST
+ *          itself. The DH key is computed from the scheduler (see @ref app_scheduler), one link
+ *          at a time, so the computation does not block the BLE event handler. When the key is
+ *          NULL, the application must compute the DH key.
+ *
+ * @note Requires Peer Manager to be compiled with @c PM_LESC_ENABLED set to 1. The key must be
+ *       word aligned and continue to reside in application memory.
+ *
+ * @param[in]  p_private_key  The private key matching the public key given to
+ *                            @ref pm_lesc_public_key_set, or NULL.
+ *
+ * @retval NRF_SUCCESS              The key was set.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Peer Manager was compiled without @c PM_LESC_ENABLED.
+ * @retval NRF_ERROR_INVALID_STATE  Peer Manager is not initialized.
+ */
+ret_code_t pm_lesc_private_key_set(uint8_t const * p_private_key);
+
+
+/**@brief Experimental function for switching to a fresh LESC key pair.
+ *
+ * @details The key pair is taken from the ECC key pool (see @ref ecc_keypool_keypair_get), which
+ *          generates key pairs ahead of time. It replaces the keys given to
+ *          @ref pm_lesc_public_key_set and @ref pm_lesc_private_key_set. Call this during
+ *          initialization, after @ref ecc_keypool_init, and again when no pairing is in progress,
+ *          for example after a pairing has completed.
+ *
+ * @note Requires Peer Manager to be compiled with @c PM_LESC_ENABLED set to 1.
+ *
+ * @retval NRF_SUCCESS              The keys were switched.
+ * @retval NRF_ERROR_INTERNAL       No key pair could be generated.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Peer Manager was compiled without @c PM_LESC_ENABLED.
+ * @retval NRF_ERROR_INVALID_STATE  Peer Manager is not initialized.
+ */
+ret_code_t pm_lesc_keypair_rotate(void);
+
+
+/**@brief Function for getting the timing of the DH key computation of the last LESC pairing on a
+ *        connection.
+ *
+ * @param[in]  conn_handle  The connection.
+ * @param[out] p_timing     The timing.
+ *
+ * @retval NRF_SUCCESS              The timing was returned.
+ * @retval NRF_ERROR_NOT_FOUND      Peer Manager has not computed a DH key for the connection.
+ * @retval NRF_ERROR_NULL           p_timing was NULL.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Peer Manager was compiled without @c PM_LESC_ENABLED.
+ * @retval NRF_ERROR_INVALID_STATE  Peer Manager is not initialized.
+ */
+ret_code_t pm_lesc_timing_get(uint16_t conn_handle, pm_lesc_timing_t * p_timing);
+
+
 /**
  * @brief Function for constructing a whitelist for use when advertising.
  *
@@ -394,6 +447,21 @@ ret_code_t pm_conn_handle_get(pm_peer_id_t peer_id, uint16_t * p_conn_handle);
 ret_code_t pm_peer_id_get(uint16_t conn_handle, pm_peer_id_t * p_peer_id);
 
 
+/**@brief Function for getting the peer ID of the bonded peer that uses an address.
+ *
+ * @details Resolvable private addresses are resolved against the IRKs of all bonded peers. The
+ *          results are cached, so this function can be called for every advertising report.
+ *
+ * @param[in]  p_addr     The address, for example from an advertising report.
+ * @param[out] p_peer_id  Peer ID, or @ref PM_PEER_ID_INVALID if no bonded peer uses the address.
+ *
+ * @retval NRF_SUCCESS              If the search was performed.
+ * @retval NRF_ERROR_NULL           If @p p_addr or @p p_peer_id was NULL.
+ * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
+ */
+ret_code_t pm_peer_id_get_by_addr(ble_gap_addr_t const * p_addr, pm_peer_id_t * p_peer_id);
+
+
 /**@brief Function for getting the next peer ID in the sequence of all used peer IDs.
  *
  * @details This function can be used to loop through all used peer IDs. The order in which
@@ -428,6 +496,22 @@ pm_peer_id_t pm_next_peer_id_get(pm_peer_id_t prev_peer_id);
 uint32_t pm_peer_count(void);
 
 
+/**@brief Function for getting the occupancy statistics of the flash write buffers.
+ *
+ * @details Peer data is staged in these buffers before it is written to flash. A
+ *          @ref pm_buffer_stats_t::max_blocks_in_use close to the number of blocks, or a nonzero
+ *          @ref pm_buffer_stats_t::n_acquire_failures, means that @c PM_FLASH_BUFFERS is too
+ *          small for the application.
+ *
+ * @param[out] p_stats  The statistics.
+ *
+ * @retval NRF_SUCCESS              The statistics were copied to p_stats.
+ * @retval NRF_ERROR_NULL           p_stats was NULL.
+ * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
+ */
+ret_code_t pm_flash_buffer_stats_get(pm_buffer_stats_t * p_stats);
+
+
 
 
 /**@anchor PM_PEER_DATA_FUNCTIONS
@@ -607,6 +691,7 @@ ret_code_t pm_peer_new(pm_peer_id_t           * p_new_peer_id,
  *
  * @retval NRF_SUCCESS              If the operation was initiated successfully.
  * @retval NRF_ERROR_INVALID_PARAM  If the peer ID was not valid.
+ * @retval NRF_ERROR_BUSY           If a bulk deletion is ongoing.
  * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
  */
 ret_code_t pm_peer_delete(pm_peer_id_t peer_id);
@@ -614,21 +699,36 @@ ret_code_t pm_peer_delete(pm_peer_id_t peer_id);
 
 /**@brief Function for deleting all data stored for all peers.
  *
- * @details This function sends either a @ref PM_EVT_PEERS_DELETE_SUCCEEDED or a @ref
- *          PM_EVT_PEERS_DELETE_FAILED event. In addition, a @ref PM_EVT_PEER_DELETE_SUCCEEDED or
- *          @ref PM_EVT_PEER_DELETE_FAILED event is sent for each deleted peer.
- *
- * @note No event is sent when there is no peer data in flash.
+ * @details The file of each peer is deleted in turn, followed by a single flash compression.
+ *          When everything is done, either a @ref PM_EVT_PEERS_DELETE_SUCCEEDED or a @ref
+ *          PM_EVT_PEERS_DELETE_FAILED event is sent. No events are sent for the individual peers.
  *
  * @warning Use this function only when not connected or connectable. If a peer is or becomes
  *          connected or a @ref PM_PEER_DATA_FUNCTIONS function is used during this procedure (until
  *          the success or failure event happens), the behavior is undefined.
  *
  * @retval NRF_SUCCESS              If the deletion process was initiated successfully.
+ * @retval NRF_ERROR_BUSY           If a bulk deletion is already ongoing.
  * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
  * @retval NRF_ERROR_INTERNAL       If another error occurred.
  */
 ret_code_t pm_peers_delete(void);
+
+
+/**@brief Function for deleting all peers except the highest ranked ones.
+ *
+ * @details Works like @ref pm_peers_delete, but keeps the @p n_peers_to_keep peers with the highest
+ *          rank, see @ref pm_peer_rank_highest. Peers that have never been ranked are always
+ *          deleted.
+ *
+ * @param[in]  n_peers_to_keep  The number of peers to keep. If 0, all peers are deleted.
+ *
+ * @retval NRF_SUCCESS              If the deletion process was initiated successfully.
+ * @retval NRF_ERROR_BUSY           If a bulk deletion is already ongoing.
+ * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
+ * @retval NRF_ERROR_INTERNAL       If another error occurred.
+ */
+ret_code_t pm_peers_delete_low_ranked(uint32_t n_peers_to_keep);
 /** @}*/
 
 
@@ -667,13 +767,15 @@ ret_code_t pm_peer_ranks_get(pm_peer_id_t * p_highest_ranked_peer,
 
 /**@brief Function for updating the rank of a peer to be highest among all stored peers.
  *
- * @details If this function returns @ref NRF_SUCCESS, either a @ref PM_EVT_PEER_DATA_UPDATE_SUCCEEDED or a
- *          @ref PM_EVT_PEER_DATA_UPDATE_FAILED event is sent with a @ref
- *          PM_STORE_TOKEN_INVALID store token when the operation is complete. Until the operation
- *          is complete, this function returns @ref NRF_ERROR_BUSY.
+ * @details The peer is ranked highest in RAM right away, and is the highest ranked peer as
+ *          reported by @ref pm_peer_ranks_get when this function returns. The new rank is
+ *          written to flash in the background, one peer at a time. When a rank has been written,
+ *          a @ref PM_EVT_PEER_DATA_UPDATE_SUCCEEDED event is sent with a @ref
+ *          PM_STORE_TOKEN_INVALID store token. If the write fails, a @ref
+ *          PM_EVT_PEER_DATA_UPDATE_FAILED event is sent and the write is retried later.
  *
- *          When the operation is complete, the peer is the highest ranked peer as reported by
- *          @ref pm_peer_ranks_get.
+ *          The ranks of the @c PM_PEER_RANK_LIST_SIZE highest ranked peers are kept in RAM, so
+ *          most rank lookups do not read flash.
  *
  * @note The @ref PM_EVT_PEER_DATA_UPDATE_SUCCEEDED event can arrive before the function returns if the peer
  *       is already ranked highest. In this case, the @ref pm_peer_data_update_succeeded_evt_t::flash_changed flag
@@ -681,11 +783,10 @@ ret_code_t pm_peer_ranks_get(pm_peer_id_t * p_highest_ranked_peer,
  *
  * @param[in]  peer_id  The peer to rank highest.
  *
- * @retval NRF_SUCCESS              If the peer's rank is, or will be updated to be highest.
- * @retval NRF_ERROR_BUSY           If the underlying flash handler is busy with other flash
- *                                  operations, or if a previous call to this function has not
- *                                  completed. Try again after receiving a Peer Manager event.
- * @retval NRF_ERROR_INTERNAL       If another error occurred.
+ * @retval NRF_SUCCESS              If the peer's rank was updated to be highest.
+ * @retval NRF_ERROR_INVALID_PARAM  If the peer ID was invalid or unallocated.
+ * @retval NRF_ERROR_BUSY           If the ranks kept in RAM are all waiting to be written to
+ *                                  flash. Try again after receiving a Peer Manager event.
  * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
  */
 ret_code_t pm_peer_rank_highest(pm_peer_id_t peer_id);
@@ -32,6 +32,15 @@
 
 ANON_UNIONS_ENABLE
 
+/**@brief Function for selecting peers for a bulk operation.
+ *
+ * @param[in]  peer_id  The peer to examine.
+ *
+ * @retval true   The operation applies to this peer.
+ * @retval false  The peer is left alone.
+ */
+typedef bool (*pm_peer_id_filter_t)(pm_peer_id_t peer_id);
+
 /**@brief One piece of data associated with a peer, together with its type.
  *
  * @note This type is deprecated.
@@ -130,6 +130,28 @@ typedef struct
 } pm_conn_sec_config_t;
 
 
+/**@brief Occupancy statistics of the Peer Manager flash write buffers.
+ *
+ * @details Can be used to find a suitable value for @c PM_FLASH_BUFFERS.
+ */
+typedef struct
+{
+    uint32_t n_blocks;           /**< @brief The number of blocks in the buffer. */
+    uint32_t n_blocks_in_use;    /**< @brief The number of blocks currently acquired. */
+    uint32_t max_blocks_in_use;  /**< @brief The highest number of blocks that have been acquired at the same time. */
+    uint32_t n_acquire_failures; /**< @brief The number of times blocks could not be acquired because no long enough run of free blocks was available. */
+} pm_buffer_stats_t;
+
+
+/**@brief Timing of the LESC DH key computation of a pairing, in app_timer (RTC) ticks.
+ */
+typedef struct
+{
+    uint32_t queued_ticks;  /**< @brief The time from the DH key request until the computation started. */
+    uint32_t compute_ticks; /**< @brief The time the computation took. */
+} pm_lesc_timing_t;
+
+
 /**@brief Data associated with a bond to a peer.
  */
 typedef struct
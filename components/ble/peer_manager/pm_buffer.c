@@ -47,6 +47,9 @@ ret_code_t pm_buffer_init(pm_buffer_t * p_buffer,
         p_buffer->block_size = block_size;
         pm_mutex_init(p_buffer->p_mutex, n_blocks);
 
+        memset(&p_buffer->stats, 0, sizeof(pm_buffer_stats_t));
+        p_buffer->stats.n_blocks = n_blocks;
+
         return NRF_SUCCESS;
     }
     else
@@ -63,32 +66,23 @@ uint8_t pm_buffer_block_acquire(pm_buffer_t * p_buffer, uint32_t n_blocks)
         return ( BUFFER_INVALID_ID );
     }
 
-    uint8_t first_locked_mutex = BUFFER_INVALID_ID;
+    uint16_t first_locked_mutex = pm_mutex_lock_range(p_buffer->p_mutex,
+                                                      p_buffer->n_blocks,
+                                                      n_blocks);
+
+    if (first_locked_mutex >= p_buffer->n_blocks)
+    {
+        p_buffer->stats.n_acquire_failures++;
+        return ( BUFFER_INVALID_ID );
+    }
 
-    for (uint8_t i = 0; i < p_buffer->n_blocks; i++)
+    p_buffer->stats.n_blocks_in_use += n_blocks;
+    if (p_buffer->stats.n_blocks_in_use > p_buffer->stats.max_blocks_in_use)
     {
-        if (pm_mutex_lock(p_buffer->p_mutex, i))
-        {
-            if (first_locked_mutex == BUFFER_INVALID_ID)
-            {
-                first_locked_mutex = i;
-            }
-            if ((i - first_locked_mutex + 1) == n_blocks)
-            {
-                return first_locked_mutex;
-            }
-        }
-        else if (first_locked_mutex != BUFFER_INVALID_ID)
-        {
-            for (uint8_t j = first_locked_mutex; j < i; j++)
-            {
-                pm_buffer_release(p_buffer, j);
-            }
-            first_locked_mutex = BUFFER_INVALID_ID;
-        }
+        p_buffer->stats.max_blocks_in_use = p_buffer->stats.n_blocks_in_use;
     }
 
-    return ( BUFFER_INVALID_ID );
+    return (uint8_t)first_locked_mutex;
 }
 
 
@@ -118,5 +112,24 @@ void pm_buffer_release(pm_buffer_t * p_buffer, uint8_t id)
        &&   pm_mutex_lock_status_get(p_buffer->p_mutex, id))
     {
         pm_mutex_unlock(p_buffer->p_mutex, id);
+        p_buffer->stats.n_blocks_in_use--;
+    }
+}
+
+
+ret_code_t pm_buffer_stats_get(pm_buffer_t const * p_buffer, pm_buffer_stats_t * p_stats)
+{
+    if (p_stats == NULL)
+    {
+        return NRF_ERROR_NULL;
     }
+
+    if (!BUFFER_IS_VALID(p_buffer))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    *p_stats = p_buffer->stats;
+
+    return NRF_SUCCESS;
 }
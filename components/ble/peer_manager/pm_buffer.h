@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 #include "sdk_errors.h"
+#include "peer_manager_types.h"
 #include "pm_mutex.h"
 
 
@@ -51,6 +52,7 @@ typedef struct
     uint8_t * p_mutex;    /**< A mutex group with one mutex for each buffer entry. */
     uint32_t  n_blocks;   /**< The number of allocatable blocks in the buffer. */
     uint32_t  block_size; /**< The size of each block in the buffer. */
+    pm_buffer_stats_t stats; /**< Occupancy statistics. */
 } pm_buffer_t;
 
 /**@brief Function for initializing a buffer instance.
@@ -78,6 +80,9 @@ ret_code_t pm_buffer_init(pm_buffer_t * p_buffer,
 
 
 /**@brief Function for acquiring a buffer block in a buffer.
+ *
+ * @details All n_blocks blocks are reserved in one operation. Release them one at a time with
+ *          @ref pm_buffer_release.
  *
  * @param[in]  p_buffer  The buffer instance acquire from.
  * @param[in]  n_blocks  The number of contiguous blocks to acquire.
@@ -107,6 +112,18 @@ uint8_t * pm_buffer_ptr_get(pm_buffer_t * p_buffer, uint8_t id);
 void pm_buffer_release(pm_buffer_t * p_buffer, uint8_t id);
 
 
+/**@brief Function for getting the occupancy statistics of a buffer.
+ *
+ * @param[in]  p_buffer  The buffer instance.
+ * @param[out] p_stats   The statistics.
+ *
+ * @retval NRF_SUCCESS              The statistics were copied to p_stats.
+ * @retval NRF_ERROR_NULL           p_stats was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  The buffer instance was invalid.
+ */
+ret_code_t pm_buffer_stats_get(pm_buffer_t const * p_buffer, pm_buffer_stats_t * p_stats);
+
+
 #endif // BUFFER_H__
 
 /**
@@ -19,6 +19,102 @@
 #include "app_util_platform.h"
 
 
+#define MUTEX_WORD_BITS 32  /**< The number of mutexes examined at a time when searching a mutex group. */
+
+#if defined(__CORTEX_M) && (__CORTEX_M >= 0x03)
+#define MUTEX_EXCLUSIVE_ACCESS 1  /**< Update single mutexes with LDREXB/STREXB instead of critical regions. */
+#else
+#define MUTEX_EXCLUSIVE_ACCESS 0  /**< Exclusive accesses are not available on Cortex-M0. */
+#endif
+
+
+/**@brief Returns the index of the lowest set bit in a word.
+ *
+ * @param word  The word to examine. Must be different from 0.
+ */
+static uint32_t lowest_set_bit_get(uint32_t word)
+{
+#if (MUTEX_EXCLUSIVE_ACCESS == 1)
+    return __CLZ(__RBIT(word));
+#else
+    uint32_t bit = 0;
+
+    if ((word & 0xFFFF) == 0) { word >>= 16; bit += 16; }
+    if ((word & 0x00FF) == 0) { word >>= 8;  bit += 8;  }
+    if ((word & 0x000F) == 0) { word >>= 4;  bit += 4;  }
+    if ((word & 0x0003) == 0) { word >>= 2;  bit += 2;  }
+    if ((word & 0x0001) == 0) {              bit += 1;  }
+
+    return bit;
+#endif
+}
+
+
+/**@brief Reads the lock status of 32 mutexes.
+ *
+ * @param p_mutex     pointer to the mutex storage.
+ * @param mutex_size  the size of the mutex group.
+ * @param word_start  the id of the first mutex to read. Must be a multiple of 32.
+ *
+ * @return one bit per mutex, set if the mutex is locked. Bits beyond the mutex group are set.
+ */
+static uint32_t word_get(uint8_t const * p_mutex, uint16_t mutex_size, uint16_t word_start)
+{
+    uint32_t word = 0;
+
+    for (uint32_t i = 0; (i < MUTEX_WORD_BITS) && ((word_start + i) < mutex_size); i += 8)
+    {
+        word |= ((uint32_t)p_mutex[(word_start + i) >> 3]) << i;
+    }
+
+    if ((mutex_size - word_start) < MUTEX_WORD_BITS)
+    {
+        word |= 0xFFFFFFFF << (mutex_size - word_start);
+    }
+
+    return word;
+}
+
+
+/**@brief Finds the first mutex with a given lock status.
+ *
+ * @param p_mutex     pointer to the mutex storage.
+ * @param mutex_size  the size of the mutex group.
+ * @param start       the id of the first mutex to examine.
+ * @param locked      the lock status to look for.
+ *
+ * @return the id of the first mutex from start with the given status, or mutex_size if none.
+ */
+static uint16_t mutex_find(uint8_t const * p_mutex, uint16_t mutex_size, uint16_t start, bool locked)
+{
+    uint16_t word_start = start & ~(MUTEX_WORD_BITS - 1);
+    uint32_t mask       = 0xFFFFFFFF << (start - word_start);
+
+    while (word_start < mutex_size)
+    {
+        uint32_t word = word_get(p_mutex, mutex_size, word_start);
+
+        if (!locked)
+        {
+            word = ~word;
+        }
+
+        word &= mask;
+
+        if (word != 0)
+        {
+            uint16_t mutex_id = word_start + lowest_set_bit_get(word);
+
+            return (mutex_id < mutex_size) ? mutex_id : mutex_size;
+        }
+
+        word_start += MUTEX_WORD_BITS;
+        mask        = 0xFFFFFFFF;
+    }
+
+    return mutex_size;
+}
+
 
 /**@brief Locks the mutex defined by the mask.
  *
@@ -30,6 +126,22 @@
  */
 static bool lock_by_mask(uint8_t * p_mutex, uint8_t mutex_mask)
 {
+#if (MUTEX_EXCLUSIVE_ACCESS == 1)
+    uint8_t mutex_byte;
+
+    do
+    {
+        mutex_byte = __LDREXB(p_mutex);
+
+        if ((mutex_byte & mutex_mask) != 0)
+        {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXB(mutex_byte | mutex_mask, p_mutex) != 0);
+
+    return true;
+#else
     bool success = false;
 
     if ( (*p_mutex & mutex_mask) == 0 )
@@ -45,6 +157,29 @@ static bool lock_by_mask(uint8_t * p_mutex, uint8_t mutex_mask)
     }
 
     return ( success );
+#endif
+}
+
+
+/**@brief Unlocks the mutex defined by the mask.
+ *
+ * @param p_mutex pointer to the mutex storage.
+ * @param mutex_mask the mask identifying the mutex position.
+ */
+static void unlock_by_mask(uint8_t * p_mutex, uint8_t mutex_mask)
+{
+#if (MUTEX_EXCLUSIVE_ACCESS == 1)
+    uint8_t mutex_byte;
+
+    do
+    {
+        mutex_byte = __LDREXB(p_mutex);
+    } while (__STREXB(mutex_byte & ~mutex_mask, p_mutex) != 0);
+#else
+    CRITICAL_REGION_ENTER();
+    *p_mutex &= ~mutex_mask;
+    CRITICAL_REGION_EXIT();
+#endif
 }
 
 
@@ -78,9 +213,7 @@ void pm_mutex_unlock(uint8_t * p_mutex, uint16_t mutex_id)
     if   ((p_mutex != NULL)
        && (p_mutex[mutex_base] & mutex_mask))
     {
-        CRITICAL_REGION_ENTER();
-        p_mutex[mutex_base] &= ~mutex_mask;
-        CRITICAL_REGION_EXIT();
+        unlock_by_mask(&p_mutex[mutex_base], mutex_mask);
     }
 }
 
@@ -89,12 +222,17 @@ uint16_t pm_mutex_lock_first_available(uint8_t * p_mutex, uint16_t mutex_size)
 {
     if (p_mutex != NULL)
     {
-        for ( uint16_t i = 0; i < mutex_size; i++ )
+        uint16_t i = mutex_find(p_mutex, mutex_size, 0, false);
+
+        while (i < mutex_size)
         {
-            if ( lock_by_mask(&(p_mutex[i >> 3]), 1 << (i & 0x07)) )
+            if (lock_by_mask(&(p_mutex[i >> 3]), 1 << (i & 0x07)))
             {
                 return ( i );
             }
+
+            // The mutex was locked by someone else after it was found, look further.
+            i = mutex_find(p_mutex, mutex_size, i, false);
         }
     }
 
@@ -102,6 +240,45 @@ uint16_t pm_mutex_lock_first_available(uint8_t * p_mutex, uint16_t mutex_size)
 }
 
 
+uint16_t pm_mutex_lock_range(uint8_t * p_mutex, uint16_t mutex_size, uint16_t n_mutexes)
+{
+    uint16_t first_mutex = mutex_size;
+
+    if ((p_mutex != NULL) && (n_mutexes != 0) && (n_mutexes <= mutex_size))
+    {
+        // A run can span several bytes, so it is locked in a critical region. An exclusive access
+        // interrupted by this region fails and is retried, since exception entry clears the
+        // exclusive monitor.
+        CRITICAL_REGION_ENTER();
+
+        uint16_t start = mutex_find(p_mutex, mutex_size, 0, false);
+
+        while ((mutex_size - start) >= n_mutexes)
+        {
+            // The first locked mutex after start ends the run of unlocked mutexes.
+            uint16_t end = mutex_find(p_mutex, mutex_size, start, true);
+
+            if ((end - start) >= n_mutexes)
+            {
+                for (uint16_t i = start; i < (start + n_mutexes); i++)
+                {
+                    p_mutex[i >> 3] |= (1 << (i & 0x07));
+                }
+
+                first_mutex = start;
+                break;
+            }
+
+            start = mutex_find(p_mutex, mutex_size, end, false);
+        }
+
+        CRITICAL_REGION_EXIT();
+    }
+
+    return ( first_mutex );
+}
+
+
 bool pm_mutex_lock_status_get(uint8_t * p_mutex, uint16_t mutex_id)
 {
     if (p_mutex != NULL)
@@ -64,6 +64,21 @@ bool pm_mutex_lock(uint8_t * p_mutex, uint16_t mutex_bit_id);
 uint16_t pm_mutex_lock_first_available(uint8_t * p_mutex, uint16_t mutex_size);
 
 
+/**@brief Locks the first run of contiguous unlocked mutexes of the given length.
+ *
+ * @details The whole run is locked in one operation, so it cannot be partially taken by a
+ *          concurrent lock.
+ *
+ * @param[in, out] p_mutex     Pointer to the mutex group.
+ * @param[in]      mutex_size  The size of the mutex group.
+ * @param[in]      n_mutexes   The number of contiguous mutexes to lock.
+ *
+ * @return The id of the first mutex in the locked run.
+ * @retval group-size  if there was no run of unlocked mutexes long enough.
+ */
+uint16_t pm_mutex_lock_range(uint8_t * p_mutex, uint16_t mutex_size, uint16_t n_mutexes);
+
+
 /**@brief Unlocks the mutex specified by the bit id.
  *
  * @param[in, out] p_mutex       Pointer to the mutex group.
@@ -21,6 +21,42 @@
 
 #define MAX_REGISTRANTS 3                           /**< The number of user that can register with the module. */
 
+#ifndef PM_LESC_ENABLED
+#define PM_LESC_ENABLED 0                           /**< Whether the module computes LESC DH keys itself. Requires the crypto library with an ECDH backend, the ECC key pool, the scheduler, and the app_timer. */
+#endif
+
+#ifndef SM_LESC_MAX_PENDING
+#define SM_LESC_MAX_PENDING 2                       /**< The number of links that can wait for a DH key computation at the same time. */
+#endif
+
+#if PM_LESC_ENABLED
+#include "nrf_crypto.h"
+#include "ecc_keypool.h"
+#include "app_scheduler.h"
+#include "app_timer.h"
+
+/**@brief States of a DH key computation.
+ */
+typedef enum
+{
+    SM_LESC_FREE,    /**< The entry is unused. */
+    SM_LESC_PENDING, /**< The DH key has been requested, but not computed yet. */
+    SM_LESC_DONE,    /**< The DH key has been computed and given to the SoftDevice. */
+} sm_lesc_state_t;
+
+/**@brief A DH key computation for one link. The keys come first so they are word aligned.
+ */
+typedef struct
+{
+    ble_gap_lesc_p256_pk_t peer_pk;       /**< Copy of the public key of the peer. */
+    ble_gap_lesc_dhkey_t   dhkey;         /**< The computed DH key. */
+    uint32_t               request_ticks; /**< The RTC counter when the DH key was requested. */
+    pm_lesc_timing_t       timing;        /**< The timing of the computation, valid in state @ref SM_LESC_DONE. */
+    uint16_t               conn_handle;   /**< The link. */
+    sm_lesc_state_t        state;         /**< The state of the computation. */
+} sm_lesc_dhkey_t;
+#endif
+
 typedef struct
 {
     sm_evt_handler_t              evt_handlers[MAX_REGISTRANTS];
@@ -36,6 +72,11 @@ typedef struct
     bool                          sec_params_valid;
     ble_gap_sec_params_t          sec_params;
     ble_gap_lesc_p256_pk_t      * p_public_key;
+#if PM_LESC_ENABLED
+    uint8_t               const * p_private_key;        /**< The LESC private key. If NULL, DH keys are left to the application. */
+    bool                          lesc_sched_pending;   /**< Whether a DH key computation has been put in the scheduler queue. */
+    sm_lesc_dhkey_t               lesc[SM_LESC_MAX_PENDING];
+#endif
 } sm_t;
 
 static sm_t m_sm = {.flag_id_link_secure_pending_busy        = BLE_CONN_STATE_USER_FLAG_INVALID,
@@ -339,6 +380,8 @@ static void pdb_evt_handler(pdb_evt_t const * p_event)
         case PDB_EVT_CLEAR_FAILED:
         case PDB_EVT_PEER_FREED:
         case PDB_EVT_PEER_FREE_FAILED:
+        case PDB_EVT_PEERS_FREED:
+        case PDB_EVT_PEERS_FREE_FAILED:
             params_reply_pending_process(m_sm.flag_id_params_reply_pending_busy);
             link_secure_pending_process(m_sm.flag_id_link_secure_pending_busy);
             break;
@@ -349,6 +392,165 @@ static void pdb_evt_handler(pdb_evt_t const * p_event)
 }
 
 
+#if PM_LESC_ENABLED
+static void lesc_dhkey_sched_handler(void * p_event_data, uint16_t event_size);
+
+
+/**@brief Function for putting a DH key computation in the scheduler queue, if any is pending.
+ *
+ * @details If the queue is full, this is retried on the next BLE event.
+ */
+static void lesc_dhkey_schedule(void)
+{
+    if (m_sm.lesc_sched_pending)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < SM_LESC_MAX_PENDING; i++)
+    {
+        if (m_sm.lesc[i].state == SM_LESC_PENDING)
+        {
+            m_sm.lesc_sched_pending = (app_sched_event_put(NULL, 0, lesc_dhkey_sched_handler)
+                                       == NRF_SUCCESS);
+            return;
+        }
+    }
+}
+
+
+/**@brief Function for computing a DH key and giving it to the SoftDevice.
+ *
+ * @param[in]  p_lesc  The computation.
+ *
+ * @return The return value of @ref sd_ble_gap_lesc_dhkey_reply.
+ */
+static ret_code_t lesc_dhkey_compute(sm_lesc_dhkey_t * p_lesc)
+{
+    uint32_t   start_ticks = 0;
+    uint32_t   end_ticks   = 0;
+    ret_code_t err_code;
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&start_ticks));
+
+    err_code = nrf_crypto_ecdh_p256_shared_secret_compute(m_sm.p_private_key,
+                                                          p_lesc->peer_pk.pk,
+                                                          p_lesc->dhkey.key);
+    if (err_code != NRF_SUCCESS)
+    {
+        // The peer's key is not on the curve. A wrong DH key makes the pairing fail.
+        memset(&p_lesc->dhkey, 0, sizeof(p_lesc->dhkey));
+    }
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&end_ticks));
+    UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(start_ticks,
+                                                   p_lesc->request_ticks,
+                                                   &p_lesc->timing.queued_ticks));
+    UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(end_ticks,
+                                                   start_ticks,
+                                                   &p_lesc->timing.compute_ticks));
+    p_lesc->state = SM_LESC_DONE;
+
+    return sd_ble_gap_lesc_dhkey_reply(p_lesc->conn_handle, &p_lesc->dhkey);
+}
+
+
+/**@brief Scheduler handler computing one pending DH key.
+ *
+ * @details One key is computed per call, so that other scheduled events, including BLE events
+ *          for other links, run between the computations.
+ */
+static void lesc_dhkey_sched_handler(void * p_event_data, uint16_t event_size)
+{
+    m_sm.lesc_sched_pending = false;
+
+    for (uint32_t i = 0; i < SM_LESC_MAX_PENDING; i++)
+    {
+        if (m_sm.lesc[i].state == SM_LESC_PENDING)
+        {
+            ret_code_t err_code = lesc_dhkey_compute(&m_sm.lesc[i]);
+            events_send_from_err_code(m_sm.lesc[i].conn_handle, err_code);
+            break;
+        }
+    }
+
+    lesc_dhkey_schedule();
+}
+
+
+/**@brief Function for finding the DH key computation of a link.
+ *
+ * @param[in]  conn_handle  The link.
+ *
+ * @return The computation, or NULL if the link has none.
+ */
+static sm_lesc_dhkey_t * lesc_find(uint16_t conn_handle)
+{
+    for (uint32_t i = 0; i < SM_LESC_MAX_PENDING; i++)
+    {
+        if ((m_sm.lesc[i].state != SM_LESC_FREE) && (m_sm.lesc[i].conn_handle == conn_handle))
+        {
+            return &m_sm.lesc[i];
+        }
+    }
+    return NULL;
+}
+
+
+/**@brief Function for processing the @ref BLE_GAP_EVT_LESC_DHKEY_REQUEST event.
+ *
+ * @details The request is queued and the DH key is computed from the scheduler, outside the
+ *          BLE event handler. If no entry is available, the key is computed right away.
+ *
+ * @param[in]  p_gap_evt  The event.
+ */
+static void lesc_dhkey_request_process(ble_gap_evt_t const * p_gap_evt)
+{
+    sm_lesc_dhkey_t * p_lesc = lesc_find(p_gap_evt->conn_handle);
+
+    if (m_sm.p_private_key == NULL)
+    {
+        // The application computes the DH key.
+        return;
+    }
+
+    for (uint32_t i = 0; (p_lesc == NULL) && (i < SM_LESC_MAX_PENDING); i++)
+    {
+        if (m_sm.lesc[i].state == SM_LESC_FREE)
+        {
+            p_lesc = &m_sm.lesc[i];
+        }
+    }
+    for (uint32_t i = 0; (p_lesc == NULL) && (i < SM_LESC_MAX_PENDING); i++)
+    {
+        if (m_sm.lesc[i].state == SM_LESC_DONE)
+        {
+            p_lesc = &m_sm.lesc[i];
+        }
+    }
+
+    if (p_lesc == NULL)
+    {
+        sm_lesc_dhkey_t lesc;
+
+        lesc.conn_handle = p_gap_evt->conn_handle;
+        lesc.peer_pk     = *p_gap_evt->params.lesc_dhkey_request.p_pk_peer;
+        UNUSED_RETURN_VALUE(app_timer_cnt_get(&lesc.request_ticks));
+        events_send_from_err_code(lesc.conn_handle, lesc_dhkey_compute(&lesc));
+        return;
+    }
+
+    // The peer key is copied because the dispatcher's key buffer is shared by all links.
+    p_lesc->conn_handle = p_gap_evt->conn_handle;
+    p_lesc->peer_pk     = *p_gap_evt->params.lesc_dhkey_request.p_pk_peer;
+    p_lesc->state       = SM_LESC_PENDING;
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&p_lesc->request_ticks));
+
+    lesc_dhkey_schedule();
+}
+#endif
+
+
 /**@brief Funtion for initializing a BLE Connection State user flag.
  *
  * @param[out] flag_id  The flag to initialize.
@@ -418,6 +620,22 @@ void sm_ble_evt_handler(ble_evt_t * p_ble_evt)
 
     smd_ble_evt_handler(p_ble_evt);
 
+#if PM_LESC_ENABLED
+    if (p_ble_evt->header.evt_id == BLE_GAP_EVT_LESC_DHKEY_REQUEST)
+    {
+        lesc_dhkey_request_process(&p_ble_evt->evt.gap_evt);
+    }
+    else if (p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED)
+    {
+        sm_lesc_dhkey_t * p_lesc = lesc_find(p_ble_evt->evt.gap_evt.conn_handle);
+        if (p_lesc != NULL)
+        {
+            p_lesc->state = SM_LESC_FREE;
+        }
+    }
+    lesc_dhkey_schedule();
+#endif
+
     link_secure_pending_process(m_sm.flag_id_link_secure_pending_busy);
 }
 
@@ -537,6 +755,60 @@ ret_code_t sm_lesc_public_key_set(ble_gap_lesc_p256_pk_t * p_public_key)
 }
 
 
+ret_code_t sm_lesc_private_key_set(uint8_t const * p_private_key)
+{
+    VERIFY_MODULE_INITIALIZED();
+#if PM_LESC_ENABLED
+    m_sm.p_private_key = p_private_key;
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t sm_lesc_keypair_rotate(void)
+{
+    VERIFY_MODULE_INITIALIZED();
+#if PM_LESC_ENABLED
+    ecc_keypair_t const * p_keypair;
+    ret_code_t            err_code = ecc_keypool_keypair_get(&p_keypair);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    //lint -save -e740 -e826
+    m_sm.p_public_key  = (ble_gap_lesc_p256_pk_t *)p_keypair->pk;
+    //lint -restore
+    m_sm.p_private_key = p_keypair->sk;
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t sm_lesc_timing_get(uint16_t conn_handle, pm_lesc_timing_t * p_timing)
+{
+    VERIFY_MODULE_INITIALIZED();
+    VERIFY_PARAM_NOT_NULL(p_timing);
+#if PM_LESC_ENABLED
+    sm_lesc_dhkey_t const * p_lesc = lesc_find(conn_handle);
+
+    if ((p_lesc == NULL) || (p_lesc->state != SM_LESC_DONE))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+    *p_timing = p_lesc->timing;
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
 ret_code_t sm_sec_params_reply(uint16_t conn_handle, ble_gap_sec_params_t * p_sec_params)
 {
     VERIFY_MODULE_INITIALIZED();
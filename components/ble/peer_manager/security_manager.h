@@ -134,6 +134,49 @@ void sm_conn_sec_config_reply(uint16_t conn_handle, pm_conn_sec_config_t * p_con
 ret_code_t sm_lesc_public_key_set(ble_gap_lesc_p256_pk_t * p_public_key);
 
 
+/**@brief Experimental function for specifying the private key to compute LESC DH keys with.
+ *
+ * @details When a private key is set, DH keys requested by the SoftDevice are computed from the
+ *          scheduler instead of in the BLE event handler, so other links and timers keep running.
+ *          When it is NULL, the application must reply to @ref BLE_GAP_EVT_LESC_DHKEY_REQUEST.
+ *
+ * @note The key must be word aligned and continue to reside in application memory.
+ *
+ * @param[in]  p_private_key  The private key matching the public key, or NULL.
+ *
+ * @retval NRF_SUCCESS              The key was set.
+ * @retval NRF_ERROR_NOT_SUPPORTED  The module was compiled without @c PM_LESC_ENABLED.
+ * @retval NRF_ERROR_INVALID_STATE  Module is not initialized.
+ */
+ret_code_t sm_lesc_private_key_set(uint8_t const * p_private_key);
+
+
+/**@brief Function for switching to the next key pair from the ECC key pool.
+ *
+ * @details Both the public and the private key are taken from @ref ecc_keypool_keypair_get.
+ *
+ * @retval NRF_SUCCESS              The keys were switched.
+ * @retval NRF_ERROR_INTERNAL       No key pair could be generated.
+ * @retval NRF_ERROR_NOT_SUPPORTED  The module was compiled without @c PM_LESC_ENABLED.
+ * @retval NRF_ERROR_INVALID_STATE  Module is not initialized.
+ */
+ret_code_t sm_lesc_keypair_rotate(void);
+
+
+/**@brief Function for getting the timing of the last DH key computation on a link.
+ *
+ * @param[in]  conn_handle  The link.
+ * @param[out] p_timing     The timing.
+ *
+ * @retval NRF_SUCCESS              The timing was returned.
+ * @retval NRF_ERROR_NOT_FOUND      No DH key has been computed by this module for the link.
+ * @retval NRF_ERROR_NULL           p_timing was NULL.
+ * @retval NRF_ERROR_NOT_SUPPORTED  The module was compiled without @c PM_LESC_ENABLED.
+ * @retval NRF_ERROR_INVALID_STATE  Module is not initialized.
+ */
+ret_code_t sm_lesc_timing_get(uint16_t conn_handle, pm_lesc_timing_t * p_timing);
+
+
 /**@brief Function for providing pairing and bonding parameters to use for the current pairing
  *        procedure on a connection.
  *
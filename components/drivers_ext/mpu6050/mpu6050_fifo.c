@@ -0,0 +1,394 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "mpu6050_fifo.h"
+#include <stddef.h>
+#include "nrf_error.h"
+#include "nordic_common.h"
+#include "app_util_platform.h"
+#include "nrf_drv_gpiote.h"
+
+#define REG_SMPLRT_DIV          0x19
+#define REG_CONFIG              0x1A
+#define REG_FIFO_EN             0x23
+#define REG_INT_PIN_CFG         0x37
+#define REG_INT_ENABLE          0x38
+#define REG_INT_STATUS          0x3A
+#define REG_USER_CTRL           0x6A
+#define REG_PWR_MGMT_1          0x6B
+#define REG_FIFO_COUNTH         0x72
+#define REG_FIFO_R_W            0x74
+#define REG_WHO_AM_I            0x75
+
+#define CONFIG_DLPF_184HZ       0x01    /**< Low-pass filter on, gyroscope output rate 1 kHz. */
+#define FIFO_EN_ACCEL_GYRO      0x78    /**< XG, YG, ZG and ACCEL FIFO enable bits. */
+#define INT_PIN_CFG_LATCH       0x20    /**< INT held until INT_STATUS is read. */
+#define INT_FIFO_OFLOW          0x10    /**< FIFO overflow interrupt bit. */
+#define USER_CTRL_FIFO_EN       0x40
+#define USER_CTRL_FIFO_RESET    0x04
+#define PWR_MGMT_1_CLK_PLL_X    0x01    /**< Awake, clocked by the X gyroscope PLL. */
+#define WHO_AM_I_VALUE          0x68
+
+#define SAMPLES_PER_READ        (255 / MPU6050_FIFO_SAMPLE_SIZE)  /**< app_twi transfers are limited to 255 bytes. */
+
+static uint8_t const m_reg_int_status = REG_INT_STATUS;
+static uint8_t const m_reg_fifo_count = REG_FIFO_COUNTH;
+static uint8_t const m_reg_fifo_rw    = REG_FIFO_R_W;
+static uint8_t const m_reg_who_am_i   = REG_WHO_AM_I;
+static uint8_t const m_fifo_reset[]   = { REG_USER_CTRL, USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RESET };
+
+static app_twi_t *                 mp_app_twi;
+static mpu6050_fifo_evt_handler_t  m_evt_handler;
+static mpu6050_fifo_raw_t *        mp_ring;
+static uint16_t                    m_ring_size;
+static uint16_t volatile           m_read_idx;      /**< Oldest sample of the ring. */
+static uint16_t volatile           m_write_idx;     /**< Next free slot of the ring. */
+static uint16_t                    m_drain_idx;     /**< Write index after the read transaction. */
+static uint32_t                    m_drain_count;   /**< Samples read by the read transaction. */
+static bool                        m_drain_more;    /**< Complete samples are left in the FIFO. */
+static bool                        m_ring_full;
+static bool volatile               m_busy;
+
+static uint8_t                     m_status[3];     /**< INT_STATUS, FIFO_COUNTH and FIFO_COUNTL. */
+static app_twi_transfer_t          m_status_transfers[4];
+static app_twi_transfer_t          m_read_transfers[2 * MPU6050_FIFO_READS_MAX];
+static app_twi_transfer_t          m_reset_transfer;
+static app_twi_transaction_t       m_status_transaction;
+static app_twi_transaction_t       m_read_transaction;
+static app_twi_transaction_t       m_reset_transaction;
+
+
+static void evt_send(mpu6050_fifo_evt_type_t type, uint32_t param)
+{
+    if (m_evt_handler != NULL)
+    {
+        mpu6050_fifo_evt_t evt;
+
+        evt.type                = type;
+        evt.params.sample_count = param;
+        m_evt_handler(&evt);
+    }
+}
+
+
+/**@brief Function for ending a drain, and reporting the given event. */
+static void drain_end(mpu6050_fifo_evt_type_t type, uint32_t param)
+{
+    m_busy = false;
+    evt_send(type, param);
+}
+
+
+static void drain_schedule(app_twi_transaction_t const * p_transaction)
+{
+    ret_code_t err_code = app_twi_schedule(mp_app_twi, p_transaction);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        drain_end(MPU6050_FIFO_EVT_ERROR, err_code);
+    }
+}
+
+
+static uint32_t ring_free_get(void)
+{
+    uint32_t const used = (m_write_idx + m_ring_size - m_read_idx) % m_ring_size;
+
+    return m_ring_size - 1 - used;
+}
+
+
+static void reset_done(ret_code_t result, void * p_user_data)
+{
+    UNUSED_PARAMETER(p_user_data);
+
+    if (result != NRF_SUCCESS)
+    {
+        drain_end(MPU6050_FIFO_EVT_ERROR, result);
+    }
+    else
+    {
+        drain_end(MPU6050_FIFO_EVT_OVERFLOW, 0);
+    }
+}
+
+
+static void read_done(ret_code_t result, void * p_user_data)
+{
+    UNUSED_PARAMETER(p_user_data);
+
+    if (result != NRF_SUCCESS)
+    {
+        drain_end(MPU6050_FIFO_EVT_ERROR, result);
+        return;
+    }
+
+    m_write_idx = m_drain_idx;
+
+    if (m_drain_more)
+    {
+        evt_send(MPU6050_FIFO_EVT_DATA, m_drain_count);
+        drain_schedule(&m_status_transaction);
+    }
+    else if (m_ring_full)
+    {
+        evt_send(MPU6050_FIFO_EVT_DATA, m_drain_count);
+        drain_end(MPU6050_FIFO_EVT_RING_FULL, 0);
+    }
+    else
+    {
+        drain_end(MPU6050_FIFO_EVT_DATA, m_drain_count);
+    }
+}
+
+
+static void status_done(ret_code_t result, void * p_user_data)
+{
+    UNUSED_PARAMETER(p_user_data);
+
+    if (result != NRF_SUCCESS)
+    {
+        drain_end(MPU6050_FIFO_EVT_ERROR, result);
+        return;
+    }
+
+    if (m_status[0] & INT_FIFO_OFLOW)
+    {
+        // The FIFO is no longer aligned on samples.
+        drain_schedule(&m_reset_transaction);
+        return;
+    }
+
+    uint32_t samples = (((uint32_t)m_status[1] << 8) | m_status[2]) / MPU6050_FIFO_SAMPLE_SIZE;
+    uint32_t room    = ring_free_get();
+    uint32_t reads   = 0;
+    uint32_t idx     = m_write_idx;
+
+    m_ring_full = (samples > room);
+    if (m_ring_full)
+    {
+        samples = room;
+    }
+
+    m_drain_count = 0;
+    while ((samples != 0) && (reads < MPU6050_FIFO_READS_MAX))
+    {
+        // One burst read per contiguous part of the ring.
+        uint32_t chunk = MIN(samples, SAMPLES_PER_READ);
+        chunk = MIN(chunk, m_ring_size - idx);
+
+        m_read_transfers[2 * reads].p_data     = (uint8_t *)&m_reg_fifo_rw;
+        m_read_transfers[2 * reads].length     = 1;
+        m_read_transfers[2 * reads].operation  = m_status_transfers[0].operation;
+        m_read_transfers[2 * reads].flags      = APP_TWI_NO_STOP;
+
+        m_read_transfers[2 * reads + 1].p_data    = mp_ring[idx].data;
+        m_read_transfers[2 * reads + 1].length    = (uint8_t)(chunk * MPU6050_FIFO_SAMPLE_SIZE);
+        m_read_transfers[2 * reads + 1].operation = m_status_transfers[1].operation;
+        m_read_transfers[2 * reads + 1].flags     = 0;
+
+        idx = (idx + chunk) % m_ring_size;
+        samples       -= chunk;
+        m_drain_count += chunk;
+        reads++;
+    }
+    m_drain_more = (samples != 0);
+    m_drain_idx  = (uint16_t)idx;
+
+    if (reads == 0)
+    {
+        drain_end(m_ring_full ? MPU6050_FIFO_EVT_RING_FULL : MPU6050_FIFO_EVT_DATA, 0);
+        return;
+    }
+
+    m_read_transaction.number_of_transfers = (uint8_t)(2 * reads);
+    drain_schedule(&m_read_transaction);
+}
+
+
+static void int_pin_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    UNUSED_PARAMETER(pin);
+    UNUSED_PARAMETER(action);
+
+    // If a drain is running, the next one reads INT_STATUS and handles the overflow.
+    (void)mpu6050_fifo_drain();
+}
+
+
+ret_code_t mpu6050_fifo_init(mpu6050_fifo_config_t const * p_config)
+{
+    ret_code_t err_code;
+
+    if ((p_config == NULL) || (p_config->p_app_twi == NULL) || (p_config->p_ring == NULL))
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (p_config->ring_size < 2)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t const address = p_config->address;
+    uint8_t       who_am_i;
+
+    app_twi_transfer_t const id_transfers[] =
+    {
+        APP_TWI_WRITE(address, &m_reg_who_am_i, 1, APP_TWI_NO_STOP),
+        APP_TWI_READ (address, &who_am_i,       1, 0)
+    };
+
+    err_code = app_twi_perform(p_config->p_app_twi, id_transfers,
+                               sizeof(id_transfers) / sizeof(id_transfers[0]), NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+    if (who_am_i != WHO_AM_I_VALUE)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    uint8_t const pwr_mgmt[]    = { REG_PWR_MGMT_1,  PWR_MGMT_1_CLK_PLL_X };
+    uint8_t const config[]      = { REG_CONFIG,      CONFIG_DLPF_184HZ };
+    uint8_t const smplrt_div[]  = { REG_SMPLRT_DIV,  p_config->sample_rate_div };
+    uint8_t const fifo_en[]     = { REG_FIFO_EN,     FIFO_EN_ACCEL_GYRO };
+    uint8_t const int_pin_cfg[] = { REG_INT_PIN_CFG, INT_PIN_CFG_LATCH };
+    // The overflow interrupt is also enabled without interrupt pin, to be flagged in INT_STATUS.
+    uint8_t const int_enable[]  = { REG_INT_ENABLE,  INT_FIFO_OFLOW };
+
+    app_twi_transfer_t const config_transfers[] =
+    {
+        APP_TWI_WRITE(address, pwr_mgmt,     sizeof(pwr_mgmt),     0),
+        APP_TWI_WRITE(address, config,       sizeof(config),       0),
+        APP_TWI_WRITE(address, smplrt_div,   sizeof(smplrt_div),   0),
+        APP_TWI_WRITE(address, fifo_en,      sizeof(fifo_en),      0),
+        APP_TWI_WRITE(address, int_pin_cfg,  sizeof(int_pin_cfg),  0),
+        APP_TWI_WRITE(address, int_enable,   sizeof(int_enable),   0),
+        APP_TWI_WRITE(address, m_fifo_reset, sizeof(m_fifo_reset), 0)
+    };
+
+    err_code = app_twi_perform(p_config->p_app_twi, config_transfers,
+                               sizeof(config_transfers) / sizeof(config_transfers[0]), NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    mp_app_twi    = p_config->p_app_twi;
+    m_evt_handler = p_config->evt_handler;
+    mp_ring       = p_config->p_ring;
+    m_ring_size   = p_config->ring_size;
+    m_read_idx    = 0;
+    m_write_idx   = 0;
+    m_busy        = false;
+
+    m_status_transfers[0] = (app_twi_transfer_t)APP_TWI_WRITE(address, &m_reg_int_status, 1,
+                                                              APP_TWI_NO_STOP);
+    m_status_transfers[1] = (app_twi_transfer_t)APP_TWI_READ(address, &m_status[0], 1, 0);
+    m_status_transfers[2] = (app_twi_transfer_t)APP_TWI_WRITE(address, &m_reg_fifo_count, 1,
+                                                              APP_TWI_NO_STOP);
+    m_status_transfers[3] = (app_twi_transfer_t)APP_TWI_READ(address, &m_status[1], 2, 0);
+    m_reset_transfer      = (app_twi_transfer_t)APP_TWI_WRITE(address, m_fifo_reset,
+                                                              sizeof(m_fifo_reset), 0);
+
+    m_status_transaction.callback            = status_done;
+    m_status_transaction.p_user_data         = NULL;
+    m_status_transaction.p_transfers         = m_status_transfers;
+    m_status_transaction.number_of_transfers = sizeof(m_status_transfers) /
+                                               sizeof(m_status_transfers[0]);
+
+    m_read_transaction.callback              = read_done;
+    m_read_transaction.p_user_data           = NULL;
+    m_read_transaction.p_transfers           = m_read_transfers;
+    m_read_transaction.number_of_transfers   = 0;
+
+    m_reset_transaction.callback             = reset_done;
+    m_reset_transaction.p_user_data          = NULL;
+    m_reset_transaction.p_transfers          = &m_reset_transfer;
+    m_reset_transaction.number_of_transfers  = 1;
+
+    if (p_config->int_pin != MPU6050_FIFO_PIN_NONE)
+    {
+        if (!nrf_drv_gpiote_is_init())
+        {
+            err_code = nrf_drv_gpiote_init();
+            if (err_code != NRF_SUCCESS)
+            {
+                return err_code;
+            }
+        }
+
+        // The latched INT line is sensed with a PORT event, which needs no high-frequency clock.
+        nrf_drv_gpiote_in_config_t const pin_config = GPIOTE_CONFIG_IN_SENSE_LOTOHI(false);
+
+        err_code = nrf_drv_gpiote_in_init(p_config->int_pin, &pin_config, int_pin_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+        nrf_drv_gpiote_in_event_enable(p_config->int_pin, true);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t mpu6050_fifo_drain(void)
+{
+    bool busy;
+
+    CRITICAL_REGION_ENTER();
+    busy = m_busy;
+    m_busy = true;
+    CRITICAL_REGION_EXIT();
+
+    if (busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    ret_code_t err_code = app_twi_schedule(mp_app_twi, &m_status_transaction);
+    if (err_code != NRF_SUCCESS)
+    {
+        m_busy = false;
+    }
+    return err_code;
+}
+
+
+bool mpu6050_fifo_sample_get(mpu6050_sample_t * p_sample)
+{
+    uint32_t const idx = m_read_idx;
+
+    if (idx == m_write_idx)
+    {
+        return false;
+    }
+
+    uint8_t const * p_data = mp_ring[idx].data;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        p_sample->accel[i] = (int16_t)(((uint16_t)p_data[2 * i] << 8) | p_data[2 * i + 1]);
+        p_sample->gyro[i]  = (int16_t)(((uint16_t)p_data[6 + 2 * i] << 8) | p_data[6 + 2 * i + 1]);
+    }
+
+    m_read_idx = (uint16_t)((idx + 1) % m_ring_size);
+    return true;
+}
+
+
+uint32_t mpu6050_fifo_sample_count(void)
+{
+    return (m_write_idx + m_ring_size - m_read_idx) % m_ring_size;
+}
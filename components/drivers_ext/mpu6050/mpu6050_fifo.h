@@ -0,0 +1,141 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef MPU6050_FIFO_H
+#define MPU6050_FIFO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_twi.h"
+#include "sdk_errors.h"
+
+/** @file
+ * @brief MPU6050 FIFO batching driver.
+ *
+ * @defgroup nrf_drivers_mpu6050_fifo MPU6050 FIFO batching driver
+ * @{
+ * @ingroup nrf_drivers_mpu6050
+ * @brief Batched reading of MPU6050 accelerometer and gyroscope samples through app_twi.
+ *
+ * @details The MPU6050 samples the accelerometer and the gyroscope at the configured rate and
+ *          stores the samples in its 1024-byte FIFO, without any activity of the CPU. Each call
+ *          to @ref mpu6050_fifo_drain reads the FIFO level and then all the complete samples
+ *          with burst reads, in non-blocking app_twi transactions, into a sample ring provided
+ *          by the application. The application calls it from a timer, once per batch.
+ *
+ *          The MPU6050 has no FIFO watermark interrupt. When an interrupt pin is configured, its
+ *          FIFO overflow interrupt starts a drain through GPIOTE, so a late timer loses one batch
+ *          at most. At 200 Hz, the FIFO holds 85 samples, or 425 ms.
+ *
+ *          This driver uses the hardware TWI through app_twi and does not use the functions of
+ *          mpu6050.h, which use the twi_master bit-banging driver.
+ */
+
+#define MPU6050_FIFO_SAMPLE_SIZE   12       /**< Bytes per sample in the FIFO: accelerometer, then gyroscope. */
+
+#define MPU6050_FIFO_PIN_NONE      0xFF     /**< No interrupt pin. */
+
+#ifndef MPU6050_FIFO_READS_MAX
+#define MPU6050_FIFO_READS_MAX     4        /**< Burst reads per transaction. Each read gets up to 21 samples. */
+#endif
+
+/**@brief Raw sample, as read from the FIFO. */
+typedef struct
+{
+    uint8_t data[MPU6050_FIFO_SAMPLE_SIZE]; /**< Big-endian accelerometer X, Y, Z and gyroscope X, Y, Z. */
+} mpu6050_fifo_raw_t;
+
+/**@brief Decoded sample. */
+typedef struct
+{
+    int16_t accel[3];                   /**< Accelerometer X, Y, Z. */
+    int16_t gyro[3];                    /**< Gyroscope X, Y, Z. */
+} mpu6050_sample_t;
+
+/**@brief Event types. */
+typedef enum
+{
+    MPU6050_FIFO_EVT_DATA,              /**< Samples were added to the ring. */
+    MPU6050_FIFO_EVT_RING_FULL,         /**< The ring is full. Samples are left in the FIFO. */
+    MPU6050_FIFO_EVT_OVERFLOW,          /**< The FIFO overflowed. It was cleared and its samples were lost. */
+    MPU6050_FIFO_EVT_ERROR              /**< A TWI transaction failed. */
+} mpu6050_fifo_evt_type_t;
+
+/**@brief Event. */
+typedef struct
+{
+    mpu6050_fifo_evt_type_t type;       /**< Event type. */
+    union
+    {
+        uint32_t   sample_count;        /**< Number of samples added, for @ref MPU6050_FIFO_EVT_DATA. */
+        ret_code_t err_code;            /**< TWI error, for @ref MPU6050_FIFO_EVT_ERROR. */
+    } params;
+} mpu6050_fifo_evt_t;
+
+/**@brief Event handler type. Called from the TWI interrupt. */
+typedef void (*mpu6050_fifo_evt_handler_t)(mpu6050_fifo_evt_t const * p_evt);
+
+/**@brief Configuration. */
+typedef struct
+{
+    app_twi_t *                p_app_twi;       /**< TWI transaction manager. */
+    mpu6050_fifo_raw_t *       p_ring;          /**< Sample ring. */
+    uint16_t                   ring_size;       /**< Number of samples in the ring. One slot is kept free. */
+    uint8_t                    address;         /**< Device address in bits [6:0]. */
+    uint8_t                    sample_rate_div; /**< Sample rate divider: the rate is 1 kHz / (1 + sample_rate_div). */
+    uint8_t                    int_pin;         /**< Pin connected to INT, or @ref MPU6050_FIFO_PIN_NONE. */
+    mpu6050_fifo_evt_handler_t evt_handler;     /**< Event handler, or NULL. */
+} mpu6050_fifo_config_t;
+
+/**@brief Function for initializing the MPU6050 and starting the FIFO.
+ *
+ * @details The device is configured with blocking app_twi transfers. If an interrupt pin is used,
+ *          the GPIOTE driver is initialized if needed.
+ *
+ * @param[in] p_config  Configuration.
+ *
+ * @retval NRF_SUCCESS              If the FIFO was started.
+ * @retval NRF_ERROR_NULL           If a pointer of the configuration is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  If the ring has less than 2 slots.
+ * @retval NRF_ERROR_NOT_FOUND      If the device is not an MPU6050.
+ * @retval -                        Other error codes of app_twi_perform or the GPIOTE driver.
+ */
+ret_code_t mpu6050_fifo_init(mpu6050_fifo_config_t const * p_config);
+
+/**@brief Function for reading the FIFO into the ring.
+ *
+ * @details Non-blocking. Can be called from any interrupt priority, for example from an app_timer
+ *          handler. The samples are reported by @ref MPU6050_FIFO_EVT_DATA.
+ *
+ * @retval NRF_SUCCESS     If the FIFO is being read.
+ * @retval NRF_ERROR_BUSY  If the FIFO is already being read.
+ * @retval -               Other error codes of app_twi_schedule.
+ */
+ret_code_t mpu6050_fifo_drain(void);
+
+/**@brief Function for taking the oldest sample from the ring.
+ *
+ * @param[out] p_sample  Decoded sample.
+ *
+ * @retval true   If a sample was taken.
+ * @retval false  If the ring is empty.
+ */
+bool mpu6050_fifo_sample_get(mpu6050_sample_t * p_sample);
+
+/**@brief Function for reading the number of samples in the ring. */
+uint32_t mpu6050_fifo_sample_count(void);
+
+/**
+ *@}
+ **/
+
+#endif // MPU6050_FIFO_H
@@ -15,6 +15,12 @@
 #include "nrf_assert.h"
 #include "app_util_platform.h"
 #include "app_util.h"
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+#include "nrf_drv_ppi.h"
+
+#define CONTINUOUS_CHANNELS_MAX  NRF_TIMER_CC_CHANNEL_COUNT(0) ///< One timer compare channel is used for each ADC channel.
+#define CONTINUOUS_INTERVAL_MAX  2000000UL                     ///< Longest scan interval in microseconds, with the 16-bit timer at 31250 Hz.
+#endif
 
 typedef struct
 {
@@ -25,6 +31,16 @@ typedef struct
     uint8_t                     size;
     uint8_t                     idx;
     nrf_drv_state_t             state;
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+    nrf_drv_adc_continuous_config_t continuous;          ///< Continuous sampling configuration.
+    volatile uint32_t           free_mask;               ///< Ring buffers not owned by the application.
+    uint32_t                    overrun_count;           ///< Number of buffers lost in continuous mode.
+    nrf_ppi_channel_t           ppi[CONTINUOUS_CHANNELS_MAX]; ///< PPI channels connecting the timer to the START task.
+    uint8_t                     channel_count;           ///< Number of channels sampled in continuous mode.
+    volatile bool               continuous_on;           ///< True if continuous sampling is ongoing.
+    uint8_t                     fill_idx;                ///< Ring buffer being filled.
+    uint16_t                    fill_pos;                ///< Position in the ring buffer being filled.
+#endif
 } adc_cb_t;
 
 static adc_cb_t m_cb;
@@ -48,6 +64,9 @@ ret_code_t nrf_drv_adc_init(nrf_drv_adc_config_t const * p_config,
         nrf_drv_common_irq_enable(ADC_IRQn, p_config->interrupt_priority);
     }
     m_cb.event_handler = event_handler;
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+    m_cb.continuous_on = false;
+#endif
     m_cb.state = NRF_DRV_STATE_INITIALIZED;
 
     return NRF_SUCCESS;
@@ -55,6 +74,9 @@ ret_code_t nrf_drv_adc_init(nrf_drv_adc_config_t const * p_config,
 
 void nrf_drv_adc_uninit(void)
 {
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+    nrf_drv_adc_continuous_stop();
+#endif
     m_cb.p_head = NULL;
     nrf_drv_common_irq_disable(ADC_IRQn);
     nrf_adc_int_disable(NRF_ADC_INT_END_MASK);
@@ -221,6 +243,328 @@ ret_code_t nrf_drv_adc_buffer_convert(nrf_adc_value_t * buffer, uint16_t size)
     }
 }
 
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+static nrf_adc_value_t * ring_buffer_get(uint8_t idx)
+{
+    return m_cb.continuous.p_buffer + (uint32_t)idx * m_cb.continuous.buffer_size;
+}
+
+
+// Averages groups of 'decimation' consecutive scans in place and returns the
+// number of the resulting samples.
+static uint16_t ring_buffer_decimate(nrf_adc_value_t * p_buffer)
+{
+    uint8_t  decimation = m_cb.continuous.decimation;
+    uint8_t  channels   = m_cb.channel_count;
+    uint16_t size       = m_cb.continuous.buffer_size / decimation;
+    uint16_t out;
+
+    if (decimation == 1)
+    {
+        return m_cb.continuous.buffer_size;
+    }
+
+    for (out = 0; out < size; ++out)
+    {
+        nrf_adc_value_t const * p_in = &p_buffer[(out / channels) * channels * decimation +
+                                                 (out % channels)];
+        int32_t sum = 0;
+        uint8_t i;
+
+        for (i = 0; i < decimation; ++i)
+        {
+            sum += p_in[i * channels];
+        }
+        p_buffer[out] = (nrf_adc_value_t)(sum / decimation);
+    }
+
+    return size;
+}
+
+
+static void continuous_irq_handler(void)
+{
+    nrf_adc_event_clear(NRF_ADC_EVENT_END);
+
+    nrf_adc_value_t * p_buffer = ring_buffer_get(m_cb.fill_idx);
+    p_buffer[m_cb.fill_pos++] = (nrf_adc_value_t)nrf_adc_result_get();
+
+    // The next START task comes from the timer, only the input has to be
+    // selected before.
+    if (m_cb.p_head->p_next != NULL)
+    {
+        m_cb.p_current_conv = (m_cb.p_current_conv->p_next == NULL) ? m_cb.p_head :
+                              m_cb.p_current_conv->p_next;
+        nrf_adc_disable();
+        nrf_adc_config_set(m_cb.p_current_conv->config.data);
+        nrf_adc_enable();
+    }
+
+    if (m_cb.fill_pos < m_cb.continuous.buffer_size)
+    {
+        return;
+    }
+
+    nrf_drv_adc_evt_t evt;
+    uint8_t next_idx = m_cb.fill_idx + 1;
+    if (next_idx == m_cb.continuous.buffer_count)
+    {
+        next_idx = 0;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (m_cb.free_mask & (1UL << next_idx))
+    {
+        m_cb.free_mask &= ~(1UL << next_idx);
+    }
+    else
+    {
+        next_idx = m_cb.fill_idx;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (next_idx == m_cb.fill_idx)
+    {
+        // No buffer is available, the current one is filled again.
+        evt.type = NRF_DRV_ADC_EVT_OVERRUN;
+        evt.data.overrun.count = ++m_cb.overrun_count;
+    }
+    else
+    {
+        evt.type = NRF_DRV_ADC_EVT_DONE;
+        evt.data.done.p_buffer = p_buffer;
+        evt.data.done.size     = ring_buffer_decimate(p_buffer);
+        m_cb.fill_idx = next_idx;
+    }
+    m_cb.fill_pos = 0;
+    m_cb.event_handler(&evt);
+}
+
+
+static void continuous_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+
+// Returns the highest frequency at which the interval fits in the 16-bit timer.
+static nrf_timer_frequency_t continuous_frequency_get(uint32_t interval_us)
+{
+    nrf_timer_frequency_t frequency = NRF_TIMER_FREQ_16MHz;
+
+    while ((frequency < NRF_TIMER_FREQ_31250Hz) &&
+           (nrf_timer_us_to_ticks(interval_us, frequency) > UINT16_MAX))
+    {
+        frequency = (nrf_timer_frequency_t)(frequency + 1);
+    }
+    return frequency;
+}
+
+
+static void continuous_ppi_free(uint8_t count)
+{
+    uint8_t i;
+
+    for (i = 0; i < count; ++i)
+    {
+        (void)nrf_drv_ppi_channel_free(m_cb.ppi[i]);
+    }
+}
+
+
+static ret_code_t continuous_resources_setup(nrf_timer_frequency_t frequency,
+                                             uint32_t              period_ticks,
+                                             uint32_t              step_ticks)
+{
+    nrf_drv_timer_t const * p_timer = m_cb.continuous.p_timer;
+    nrf_drv_timer_config_t  timer_config;
+    ret_code_t              err_code;
+    uint8_t                 i;
+
+    err_code = nrf_drv_ppi_init();
+    if ((err_code != NRF_SUCCESS) && (err_code != MODULE_ALREADY_INITIALIZED))
+    {
+        return err_code;
+    }
+
+    timer_config.frequency          = frequency;
+    timer_config.mode               = NRF_TIMER_MODE_TIMER;
+    timer_config.bit_width          = NRF_TIMER_BIT_WIDTH_16;
+    timer_config.interrupt_priority = NVIC_GetPriority(ADC_IRQn);
+    timer_config.p_context          = NULL;
+    err_code = nrf_drv_timer_init(p_timer, &timer_config, continuous_timer_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    // Compare channel 0 starts a scan and restarts the timer. Compare channel i
+    // starts the conversion of the channel i of the scan.
+    nrf_drv_timer_extended_compare(p_timer,
+                                   NRF_TIMER_CC_CHANNEL0,
+                                   period_ticks,
+                                   NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
+                                   false);
+
+    for (i = 0; i < m_cb.channel_count; ++i)
+    {
+        if (i > 0)
+        {
+            nrf_drv_timer_compare(p_timer, (nrf_timer_cc_channel_t)i, i * step_ticks, false);
+        }
+
+        err_code = nrf_drv_ppi_channel_alloc(&m_cb.ppi[i]);
+        if (err_code != NRF_SUCCESS)
+        {
+            break;
+        }
+
+        err_code = nrf_drv_ppi_channel_assign(m_cb.ppi[i],
+                                              nrf_drv_timer_compare_event_address_get(p_timer, i),
+                                              nrf_drv_adc_start_task_get());
+        if (err_code != NRF_SUCCESS)
+        {
+            ++i;
+            break;
+        }
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        continuous_ppi_free(i);
+        nrf_drv_timer_uninit(p_timer);
+    }
+    return err_code;
+}
+
+
+ret_code_t nrf_drv_adc_continuous_start(nrf_drv_adc_continuous_config_t const * p_config)
+{
+    ASSERT(m_cb.state != NRF_DRV_STATE_UNINITIALIZED);
+    ASSERT(m_cb.event_handler);
+    ASSERT(p_config);
+
+    nrf_drv_adc_channel_t const * p_channel;
+    nrf_timer_frequency_t         frequency;
+    uint32_t                      period_ticks;
+    uint32_t                      step_ticks;
+    ret_code_t                    err_code;
+    uint8_t                       count = 0;
+    uint8_t                       i;
+
+    for (p_channel = m_cb.p_head; p_channel != NULL; p_channel = p_channel->p_next)
+    {
+        ++count;
+    }
+
+    if ((p_config->p_buffer == NULL) || (p_config->p_timer == NULL) ||
+        (p_config->buffer_count < 2) || (p_config->buffer_count > 32) ||
+        (p_config->decimation == 0) || (count == 0) ||
+        (p_config->buffer_size == 0) ||
+        ((p_config->buffer_size % (count * p_config->decimation)) != 0) ||
+        (p_config->interval_us == 0) || (p_config->interval_us > CONTINUOUS_INTERVAL_MAX))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if ((count > CONTINUOUS_CHANNELS_MAX) || (count > p_config->p_timer->cc_channel_count))
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    // The step is rounded up, so that conversions are never closer than requested.
+    frequency    = continuous_frequency_get(p_config->interval_us);
+    period_ticks = nrf_timer_us_to_ticks(p_config->interval_us, frequency);
+    step_ticks   = nrf_timer_us_to_ticks(p_config->step_us, NRF_TIMER_FREQ_16MHz);
+    step_ticks   = (step_ticks + (1UL << frequency) - 1) >> frequency;
+    if ((count > 1) && ((step_ticks == 0) || (count * step_ticks > period_ticks)))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (m_cb.state == NRF_DRV_STATE_POWERED_ON)
+    {
+        return NRF_ERROR_BUSY;
+    }
+    m_cb.state = NRF_DRV_STATE_POWERED_ON;
+
+    m_cb.continuous    = *p_config;
+    m_cb.channel_count = count;
+    err_code = continuous_resources_setup(frequency, period_ticks, step_ticks);
+    if (err_code != NRF_SUCCESS)
+    {
+        m_cb.state = NRF_DRV_STATE_INITIALIZED;
+        return err_code;
+    }
+
+    m_cb.free_mask      = ((p_config->buffer_count == 32) ? 0xFFFFFFFFUL :
+                           ((1UL << p_config->buffer_count) - 1)) & ~1UL;
+    m_cb.overrun_count  = 0;
+    m_cb.fill_idx       = 0;
+    m_cb.fill_pos       = 0;
+    m_cb.p_current_conv = m_cb.p_head;
+    m_cb.continuous_on  = true;
+
+    nrf_adc_config_set(m_cb.p_current_conv->config.data);
+    nrf_adc_event_clear(NRF_ADC_EVENT_END);
+    nrf_adc_enable();
+    nrf_adc_int_enable(NRF_ADC_INT_END_MASK);
+    for (i = 0; i < count; ++i)
+    {
+        (void)nrf_drv_ppi_channel_enable(m_cb.ppi[i]);
+    }
+
+    // The first scan starts now, the timer counts from it.
+    nrf_drv_timer_enable(p_config->p_timer);
+    nrf_adc_start();
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_adc_buffer_release(nrf_adc_value_t * p_buffer)
+{
+    ASSERT(p_buffer >= m_cb.continuous.p_buffer);
+
+    uint8_t idx = (uint8_t)((uint32_t)(p_buffer - m_cb.continuous.p_buffer) /
+                            m_cb.continuous.buffer_size);
+
+    ASSERT(idx < m_cb.continuous.buffer_count);
+
+    CRITICAL_REGION_ENTER();
+    m_cb.free_mask |= (1UL << idx);
+    CRITICAL_REGION_EXIT();
+}
+
+
+void nrf_drv_adc_continuous_stop(void)
+{
+    uint8_t i;
+
+    if (!m_cb.continuous_on)
+    {
+        return;
+    }
+
+    nrf_drv_timer_disable(m_cb.continuous.p_timer);
+    for (i = 0; i < m_cb.channel_count; ++i)
+    {
+        (void)nrf_drv_ppi_channel_disable(m_cb.ppi[i]);
+    }
+
+    nrf_adc_int_disable(NRF_ADC_INT_END_MASK);
+    nrf_adc_stop();
+    nrf_adc_event_clear(NRF_ADC_EVENT_END);
+    nrf_adc_disable();
+
+    continuous_ppi_free(m_cb.channel_count);
+    nrf_drv_timer_uninit(m_cb.continuous.p_timer);
+
+    m_cb.continuous_on = false;
+    m_cb.state = NRF_DRV_STATE_INITIALIZED;
+}
+#endif // (ADC_CONTINUOUS_SUPPORT == 1)
+
 bool nrf_drv_adc_is_busy(void)
 {
     ASSERT(mp_state != NRF_DRV_STATE_UNINITIALIZED);
@@ -229,6 +573,13 @@ bool nrf_drv_adc_is_busy(void)
 
 void ADC_IRQHandler(void)
 {
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+    if (m_cb.continuous_on)
+    {
+        continuous_irq_handler();
+    }
+    else
+#endif
     if (m_cb.p_buffer == NULL)
     {
         nrf_adc_event_clear(NRF_ADC_EVENT_END);
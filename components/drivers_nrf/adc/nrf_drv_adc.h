@@ -14,6 +14,9 @@
 #include "nrf_drv_config.h"
 #include "sdk_errors.h"
 #include <stdbool.h>
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+#include "nrf_drv_timer.h"
+#endif
 
 /**
  * @addtogroup nrf_adc ADC HAL and driver
@@ -36,6 +39,7 @@ typedef enum
 {
     NRF_DRV_ADC_EVT_DONE,    ///< Event generated when the buffer is filled with samples.
     NRF_DRV_ADC_EVT_SAMPLE,  ///< Event generated when the requested channel is sampled.
+    NRF_DRV_ADC_EVT_OVERRUN, ///< Event generated when a buffer of samples is lost in continuous mode.
 } nrf_drv_adc_evt_type_t;
 
 typedef int16_t nrf_adc_value_t;
@@ -57,6 +61,14 @@ typedef struct
     nrf_adc_value_t   sample; ///< Converted sample.
 } nrf_drv_adc_sample_evt_t;
 
+/**
+ * @brief Analog-to-digital converter driver OVERRUN event.
+ */
+typedef struct
+{
+    uint32_t          count;  ///< Number of buffers lost since continuous sampling was started.
+} nrf_drv_adc_overrun_evt_t;
+
 /**
  * @brief Analog-to-digital converter driver event.
  */
@@ -67,6 +79,7 @@ typedef struct
     {
         nrf_drv_adc_done_evt_t   done;   ///< Data for DONE event.
         nrf_drv_adc_sample_evt_t sample; ///< Data for SAMPLE event.
+        nrf_drv_adc_overrun_evt_t overrun; ///< Data for OVERRUN event.
     } data;
 } nrf_drv_adc_evt_t;
 
@@ -136,6 +149,22 @@ typedef struct
  */
 typedef void (*nrf_drv_adc_event_handler_t)(nrf_drv_adc_evt_t const * p_event);
 
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+/**
+ * @brief Continuous sampling configuration.
+ */
+typedef struct
+{
+    nrf_adc_value_t       * p_buffer;     ///< Memory for the ring of buffers (buffer_count * buffer_size samples).
+    uint16_t                buffer_size;  ///< Size of a single buffer in samples. It must be a multiple of the number of enabled channels times decimation.
+    uint8_t                 buffer_count; ///< Number of buffers, from 2 to 32.
+    uint8_t                 decimation;   ///< Number of consecutive samples of each channel averaged into one reported sample. 1 disables decimation.
+    uint32_t                interval_us;  ///< Scan interval, at most 2 s.
+    uint16_t                step_us;      ///< Time between the conversions of two consecutive channels in a scan. It must be longer than the conversion time plus the ADC interrupt latency. Not used with one channel.
+    nrf_drv_timer_t const * p_timer;      ///< Timer instance used to trigger sampling.
+} nrf_drv_adc_continuous_config_t;
+#endif
+
 /**
  * @brief Function for initializing the ADC.
  *
@@ -231,6 +260,53 @@ ret_code_t nrf_drv_adc_sample_convert(nrf_drv_adc_channel_t const * const p_chan
  */
 ret_code_t nrf_drv_adc_buffer_convert(nrf_adc_value_t * buffer, uint16_t size);
 
+#if (ADC_CONTINUOUS_SUPPORT == 1)
+/**
+ * @brief Function for starting continuous sampling of all enabled channels into a ring of
+ *        buffers.
+ *
+ * The timer triggers the START task through PPI for each channel of a scan: the first channel
+ * every interval_us, and the next ones step_us apart. The conversions are therefore evenly
+ * spaced, whatever the interrupt latency. The END interrupt only stores the result and selects
+ * the next channel. Each filled buffer is reported with @ref NRF_DRV_ADC_EVT_DONE. If decimation
+ * is enabled, the reported buffer holds buffer_size / decimation averaged samples.
+ *
+ * A reported buffer belongs to the application until it is returned with
+ * @ref nrf_drv_adc_buffer_release. If the next buffer in the ring has not been returned when
+ * it is needed, the current buffer is filled again, its previous content is lost, and
+ * @ref NRF_DRV_ADC_EVT_OVERRUN is generated instead of @ref NRF_DRV_ADC_EVT_DONE.
+ *
+ * The driver must be initialized in non-blocking mode. The timer instance must be enabled in
+ * nrf_drv_config.h and must not be initialized by the application. One PPI channel is used
+ * for each enabled ADC channel.
+ *
+ * @param[in] p_config Continuous sampling configuration. It is copied by the driver.
+ *
+ * @retval NRF_SUCCESS             If sampling was started.
+ * @retval NRF_ERROR_BUSY          If the ADC is busy.
+ * @retval NRF_ERROR_INVALID_PARAM If the configuration is invalid.
+ * @retval NRF_ERROR_NOT_SUPPORTED If more channels are enabled than the timer has
+ *                                 capture/compare channels.
+ * @return Error code returned by the timer or PPI driver.
+ */
+ret_code_t nrf_drv_adc_continuous_start(nrf_drv_adc_continuous_config_t const * p_config);
+
+/**
+ * @brief Function for returning a buffer reported in continuous mode to the driver.
+ *
+ * @param[in] p_buffer Buffer from @ref NRF_DRV_ADC_EVT_DONE event.
+ */
+void nrf_drv_adc_buffer_release(nrf_adc_value_t * p_buffer);
+
+/**
+ * @brief Function for stopping continuous sampling.
+ *
+ * Samples in the buffer that is being filled are discarded. The timer and PPI channels are
+ * released.
+ */
+void nrf_drv_adc_continuous_stop(void);
+#endif
+
 /**
  * @brief Function for retrieving the ADC state.
  *
@@ -0,0 +1,787 @@
+/* Copyright (c) 2015 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nrf.h"
+#include "nrf_drv_aes.h"
+#include "nrf_drv_common.h"
+#include "nrf_assert.h"
+#include "nordic_common.h"
+#include "nrf_error.h"
+#include "app_util.h"
+#include "sdk_common.h"
+#ifdef SOFTDEVICE_PRESENT
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+
+#define AES_SLOT_COUNT  AES_CONFIG_SD_BATCH_SIZE    /**< Number of blocks passed to the SoftDevice in one call. */
+#else
+#define AES_SLOT_COUNT  2                           /**< Number of blocks in progress: one encrypted by the ECB peripheral, one prepared. */
+#define AES_NO_SLOT     0xFF                        /**< Value of the running slot when the ECB peripheral is idle. */
+#endif // SOFTDEVICE_PRESENT
+
+#define AES_CMAC_RB     0x87                        /**< Constant of the CMAC subkey generation, R_128. */
+
+/**@brief Modes of operation. */
+typedef enum
+{
+    AES_MODE_CTR,
+    AES_MODE_CCM_ENCRYPT,
+    AES_MODE_CCM_DECRYPT,
+    AES_MODE_CMAC
+} aes_mode_t;
+
+/**@brief Types of block operations. */
+typedef enum
+{
+    AES_OP_NONE,                                    /**< No operation. */
+    AES_OP_CTR,                                     /**< Encryption of a counter block, giving a keystream block. */
+    AES_OP_MAC                                      /**< Encryption of a CBC-MAC block. */
+} aes_op_type_t;
+
+/**@brief Data structure accessed by the ECB peripheral. */
+typedef struct
+{
+    uint8_t key[NRF_DRV_AES_BLOCK_SIZE];
+    uint8_t cleartext[NRF_DRV_AES_BLOCK_SIZE];
+    uint8_t ciphertext[NRF_DRV_AES_BLOCK_SIZE];
+} aes_ecb_data_t;
+
+/**@brief Block operation held by a slot. */
+typedef struct
+{
+    aes_op_type_t type;
+    uint32_t      index;                            /**< Index of the block in the keystream or in the CBC-MAC. */
+} aes_op_t;
+
+typedef struct
+{
+    nrf_drv_state_t       state;
+    nrf_drv_aes_handler_t handler;
+    volatile bool         busy;                     /**< True while an operation is in progress. */
+    ret_code_t            result;                   /**< Result of the last operation. */
+    aes_mode_t            mode;
+    aes_ecb_data_t        ecb[AES_SLOT_COUNT];
+    aes_op_t              op[AES_SLOT_COUNT];
+#ifndef SOFTDEVICE_PRESENT
+    uint8_t               running;                  /**< Slot being encrypted by the ECB peripheral. */
+#endif // SOFTDEVICE_PRESENT
+    uint8_t const *       p_in;
+    uint8_t       *       p_out;
+    uint32_t              length;
+    uint8_t const *       p_adata;
+    uint32_t              adata_len;
+    uint32_t              adata_blocks;             /**< Number of CBC-MAC blocks of the formatted additional data. */
+    uint8_t       *       p_result;                 /**< Counter block (CTR), MIC (CCM encryption) or MAC (CMAC) written on completion. */
+    uint8_t const *       p_mic;                    /**< Received MIC (CCM decryption). */
+    uint8_t               mic_len;
+    uint8_t               counter[NRF_DRV_AES_BLOCK_SIZE];  /**< Next counter block. */
+    uint8_t               block0[NRF_DRV_AES_BLOCK_SIZE];   /**< First CBC-MAC block: B0 (CCM) or zero block (CMAC). */
+    uint8_t               mac[NRF_DRV_AES_BLOCK_SIZE];      /**< CBC-MAC chaining value. */
+    uint8_t               aux[NRF_DRV_AES_BLOCK_SIZE];      /**< Encrypted first counter block S0 (CCM) or subkey of the last block (CMAC). */
+    uint32_t              ctr_total;
+    uint32_t              ctr_issued;
+    uint32_t              ctr_done;
+    uint32_t              mac_total;
+    uint32_t              mac_issued;
+    uint32_t              mac_done;
+} nrf_drv_aes_cb_t;
+
+static nrf_drv_aes_cb_t m_aes_cb;
+#ifndef SOFTDEVICE_PRESENT
+static const nrf_drv_aes_config_t m_default_config = NRF_DRV_AES_DEFAULT_CONFIG;
+#endif // SOFTDEVICE_PRESENT
+
+
+static void aes_xor(uint8_t * p_dst, uint8_t const * p_a, uint8_t const * p_b, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        p_dst[i] = p_a[i] ^ p_b[i];
+    }
+}
+
+
+/**@brief Function for copying a block of data, zero padded.
+ *
+ * @return Number of bytes of data copied.
+ */
+static uint32_t aes_data_block_get(uint8_t * p_block, uint8_t const * p_data, uint32_t index)
+{
+    uint32_t offset = index * NRF_DRV_AES_BLOCK_SIZE;
+    uint32_t length = MIN(NRF_DRV_AES_BLOCK_SIZE, m_aes_cb.length - offset);
+
+    memcpy(p_block, &p_data[offset], length);
+    memset(&p_block[length], 0, NRF_DRV_AES_BLOCK_SIZE - length);
+
+    return length;
+}
+
+
+/**@brief Function for getting a block of the CCM additional data, formatted with its length.
+ */
+static void ccm_adata_block_get(uint8_t * p_block, uint32_t index)
+{
+    for (uint32_t i = 0; i < NRF_DRV_AES_BLOCK_SIZE; i++)
+    {
+        uint32_t position = (index * NRF_DRV_AES_BLOCK_SIZE) + i;
+
+        if (position < sizeof(uint16_t))
+        {
+            p_block[i] = (uint8_t)(m_aes_cb.adata_len >> ((position == 0) ? 8 : 0));
+        }
+        else if ((position - sizeof(uint16_t)) < m_aes_cb.adata_len)
+        {
+            p_block[i] = m_aes_cb.p_adata[position - sizeof(uint16_t)];
+        }
+        else
+        {
+            p_block[i] = 0;
+        }
+    }
+}
+
+
+/**@brief Function for computing the input of a CBC-MAC block.
+ */
+static void aes_mac_block_get(uint8_t * p_block, uint32_t index)
+{
+    if (index == 0)
+    {
+        memcpy(p_block, m_aes_cb.block0, NRF_DRV_AES_BLOCK_SIZE);
+    }
+    else if (m_aes_cb.mode == AES_MODE_CMAC)
+    {
+        uint32_t length = aes_data_block_get(p_block, m_aes_cb.p_in, index - 1);
+
+        if ((index + 1) == m_aes_cb.mac_total)
+        {
+            if (length < NRF_DRV_AES_BLOCK_SIZE)
+            {
+                p_block[length] = 0x80;
+            }
+            aes_xor(p_block, p_block, m_aes_cb.aux, NRF_DRV_AES_BLOCK_SIZE);
+        }
+    }
+    else if (index <= m_aes_cb.adata_blocks)
+    {
+        ccm_adata_block_get(p_block, index - 1);
+    }
+    else
+    {
+        // The plaintext is authenticated: the input data when encrypting, the output data when
+        // decrypting.
+        UNUSED_RETURN_VALUE(aes_data_block_get(p_block,
+                                               (m_aes_cb.mode == AES_MODE_CCM_ENCRYPT) ?
+                                               m_aes_cb.p_in : m_aes_cb.p_out,
+                                               index - 1 - m_aes_cb.adata_blocks));
+    }
+
+    aes_xor(p_block, p_block, m_aes_cb.mac, NRF_DRV_AES_BLOCK_SIZE);
+}
+
+
+/**@brief Function for checking if the next CBC-MAC block can be computed.
+ *
+ * @details The CBC-MAC blocks are chained, hence only one can be in progress at a time. When
+ *          decrypting, a block of the data is authenticated once it has been decrypted.
+ */
+static bool aes_mac_ready(void)
+{
+    if ((m_aes_cb.mac_issued == m_aes_cb.mac_total) || (m_aes_cb.mac_issued != m_aes_cb.mac_done))
+    {
+        return false;
+    }
+
+    if ((m_aes_cb.mode == AES_MODE_CCM_DECRYPT) && (m_aes_cb.mac_issued > m_aes_cb.adata_blocks))
+    {
+        // Keystream block 0 is S0, data block j is decrypted by keystream block j + 1.
+        uint32_t data_block = m_aes_cb.mac_issued - 1 - m_aes_cb.adata_blocks;
+
+        return (m_aes_cb.ctr_done > (data_block + 1));
+    }
+
+    return true;
+}
+
+
+/**@brief Function for checking if the next keystream block can be computed.
+ *
+ * @details When encrypting with CCM, a block of the data is authenticated before it is encrypted,
+ *          so that the data can be encrypted in place.
+ */
+static bool aes_ctr_ready(void)
+{
+    if (m_aes_cb.ctr_issued == m_aes_cb.ctr_total)
+    {
+        return false;
+    }
+
+    if ((m_aes_cb.mode == AES_MODE_CCM_ENCRYPT) && (m_aes_cb.ctr_issued != 0))
+    {
+        return (m_aes_cb.mac_issued > (m_aes_cb.adata_blocks + m_aes_cb.ctr_issued));
+    }
+
+    return true;
+}
+
+
+static void aes_counter_increment(void)
+{
+    for (uint32_t i = NRF_DRV_AES_BLOCK_SIZE; i-- > 0; )
+    {
+        if (++m_aes_cb.counter[i] != 0)
+        {
+            break;
+        }
+    }
+}
+
+
+/**@brief Function for preparing the next block operation which can be performed in a slot.
+ *
+ * @details The CBC-MAC chain is the longest path, hence it is given priority over the keystream.
+ *
+ * @return True if an operation has been prepared.
+ */
+static bool aes_op_prepare(uint32_t slot)
+{
+    aes_op_t * p_op = &m_aes_cb.op[slot];
+
+    if (aes_mac_ready())
+    {
+        p_op->type  = AES_OP_MAC;
+        p_op->index = m_aes_cb.mac_issued++;
+        aes_mac_block_get(m_aes_cb.ecb[slot].cleartext, p_op->index);
+    }
+    else if (aes_ctr_ready())
+    {
+        p_op->type  = AES_OP_CTR;
+        p_op->index = m_aes_cb.ctr_issued++;
+        memcpy(m_aes_cb.ecb[slot].cleartext, m_aes_cb.counter, NRF_DRV_AES_BLOCK_SIZE);
+        aes_counter_increment();
+    }
+    else
+    {
+        p_op->type = AES_OP_NONE;
+    }
+
+    return (p_op->type != AES_OP_NONE);
+}
+
+
+/**@brief Function for deriving the CMAC subkey of the last block from L = AES(K, 0).
+ */
+static void cmac_subkey_set(uint8_t const * p_l)
+{
+    // K1 is used if the last block is complete, K2 otherwise.
+    uint32_t count = ((m_aes_cb.length != 0) &&
+                      ((m_aes_cb.length % NRF_DRV_AES_BLOCK_SIZE) == 0)) ? 1 : 2;
+
+    memcpy(m_aes_cb.aux, p_l, NRF_DRV_AES_BLOCK_SIZE);
+
+    while (count-- != 0)
+    {
+        uint8_t msb = m_aes_cb.aux[0] & 0x80;
+
+        for (uint32_t i = 0; i < (NRF_DRV_AES_BLOCK_SIZE - 1); i++)
+        {
+            m_aes_cb.aux[i] = (uint8_t)((m_aes_cb.aux[i] << 1) | (m_aes_cb.aux[i + 1] >> 7));
+        }
+        m_aes_cb.aux[NRF_DRV_AES_BLOCK_SIZE - 1] <<= 1;
+
+        if (msb != 0)
+        {
+            m_aes_cb.aux[NRF_DRV_AES_BLOCK_SIZE - 1] ^= AES_CMAC_RB;
+        }
+    }
+}
+
+
+/**@brief Function for processing the output of a block operation.
+ */
+static void aes_op_complete(uint32_t slot)
+{
+    aes_op_t      * p_op     = &m_aes_cb.op[slot];
+    uint8_t const * p_output = m_aes_cb.ecb[slot].ciphertext;
+
+    if (p_op->type == AES_OP_MAC)
+    {
+        if ((m_aes_cb.mode == AES_MODE_CMAC) && (p_op->index == 0))
+        {
+            cmac_subkey_set(p_output);
+        }
+        else
+        {
+            memcpy(m_aes_cb.mac, p_output, NRF_DRV_AES_BLOCK_SIZE);
+        }
+        m_aes_cb.mac_done++;
+    }
+    else if (p_op->type == AES_OP_CTR)
+    {
+        uint32_t index = p_op->index;
+
+        if ((m_aes_cb.mode != AES_MODE_CTR) && (index-- == 0))
+        {
+            memcpy(m_aes_cb.aux, p_output, NRF_DRV_AES_BLOCK_SIZE);
+        }
+        else
+        {
+            uint32_t offset = index * NRF_DRV_AES_BLOCK_SIZE;
+
+            aes_xor(&m_aes_cb.p_out[offset],
+                    &m_aes_cb.p_in[offset],
+                    p_output,
+                    MIN(NRF_DRV_AES_BLOCK_SIZE, m_aes_cb.length - offset));
+        }
+        m_aes_cb.ctr_done++;
+    }
+
+    p_op->type = AES_OP_NONE;
+}
+
+
+/**@brief Function for computing the result of the operation once all the blocks are done.
+ */
+static ret_code_t aes_result_get(void)
+{
+    uint8_t  diff = 0;
+    uint8_t  mic[NRF_DRV_AES_BLOCK_SIZE];
+
+    switch (m_aes_cb.mode)
+    {
+        case AES_MODE_CTR:
+            memcpy(m_aes_cb.p_result, m_aes_cb.counter, NRF_DRV_AES_BLOCK_SIZE);
+            break;
+
+        case AES_MODE_CCM_ENCRYPT:
+            aes_xor(m_aes_cb.p_result, m_aes_cb.mac, m_aes_cb.aux, m_aes_cb.mic_len);
+            break;
+
+        case AES_MODE_CCM_DECRYPT:
+            aes_xor(mic, m_aes_cb.mac, m_aes_cb.aux, m_aes_cb.mic_len);
+
+            // Compare all the bytes, so that the time taken does not depend on the MIC.
+            for (uint32_t i = 0; i < m_aes_cb.mic_len; i++)
+            {
+                diff |= mic[i] ^ m_aes_cb.p_mic[i];
+            }
+
+            if (diff != 0)
+            {
+                memset(m_aes_cb.p_out, 0, m_aes_cb.length);
+                return NRF_ERROR_INVALID_DATA;
+            }
+            break;
+
+        case AES_MODE_CMAC:
+            memcpy(m_aes_cb.p_result, m_aes_cb.mac, NRF_DRV_AES_BLOCK_SIZE);
+            break;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for ending the operation in progress.
+ */
+static void aes_op_end(ret_code_t result)
+{
+    if (result == NRF_SUCCESS)
+    {
+        result = aes_result_get();
+    }
+
+    m_aes_cb.result = result;
+    m_aes_cb.busy   = false;
+
+    if (m_aes_cb.handler != NULL)
+    {
+        m_aes_cb.handler(result);
+    }
+}
+
+
+#ifndef SOFTDEVICE_PRESENT
+static void aes_ecb_start(uint32_t slot)
+{
+    m_aes_cb.running        = slot;
+    NRF_ECB->ECBDATAPTR     = (uint32_t)&m_aes_cb.ecb[slot];
+    NRF_ECB->TASKS_STARTECB = 1;
+}
+
+
+/**@brief Function for handling the end of the encryption of a block by the ECB peripheral.
+ *
+ * @details The block prepared in the other slot is started first, and its successor is prepared
+ *          once the output of the block has been processed, so that the peripheral is kept busy
+ *          while the CPU XORs the keystream or chains the CBC-MAC.
+ */
+static void aes_ecb_end_handle(void)
+{
+    uint32_t done = m_aes_cb.running;
+    uint32_t next = done ^ 1;
+
+    m_aes_cb.running = AES_NO_SLOT;
+    if (m_aes_cb.op[next].type != AES_OP_NONE)
+    {
+        aes_ecb_start(next);
+    }
+
+    aes_op_complete(done);
+
+    if (m_aes_cb.running == AES_NO_SLOT)
+    {
+        // No block was ready: it depended on the output of the block which has just been
+        // processed, or all the blocks are done.
+        if (!aes_op_prepare(done))
+        {
+            aes_op_end(NRF_SUCCESS);
+            return;
+        }
+        aes_ecb_start(done);
+    }
+
+    UNUSED_RETURN_VALUE(aes_op_prepare(m_aes_cb.running ^ 1));
+}
+
+
+static ret_code_t aes_op_run(void)
+{
+    m_aes_cb.op[1].type = AES_OP_NONE;
+
+    if (!aes_op_prepare(0))
+    {
+        // Empty input.
+        aes_op_end(NRF_SUCCESS);
+    }
+    else
+    {
+        NRF_ECB->EVENTS_ENDECB   = 0;
+        NRF_ECB->EVENTS_ERRORECB = 0;
+        aes_ecb_start(0);
+        UNUSED_RETURN_VALUE(aes_op_prepare(1));
+
+        if (m_aes_cb.handler == NULL)
+        {
+            while (m_aes_cb.busy)
+            {
+                if (NRF_ECB->EVENTS_ERRORECB != 0)
+                {
+                    NRF_ECB->EVENTS_ERRORECB = 0;
+                    aes_op_end(NRF_ERROR_INTERNAL);
+                }
+                else if (NRF_ECB->EVENTS_ENDECB != 0)
+                {
+                    NRF_ECB->EVENTS_ENDECB = 0;
+                    aes_ecb_end_handle();
+                }
+            }
+        }
+    }
+
+    return (m_aes_cb.handler == NULL) ? m_aes_cb.result : NRF_SUCCESS;
+}
+#else
+/**@brief Function for performing the operation with the SoftDevice.
+ *
+ * @details All the blocks which are ready, at most one CBC-MAC block and the following keystream
+ *          blocks, are encrypted in a single call.
+ */
+static ret_code_t aes_op_run(void)
+{
+    nrf_ecb_hal_data_block_t blocks[AES_SLOT_COUNT];
+    ret_code_t               err_code = NRF_SUCCESS;
+    uint32_t                 count;
+
+    do
+    {
+        for (count = 0; (count < AES_SLOT_COUNT) && aes_op_prepare(count); count++)
+        {
+            blocks[count].p_key        = (soc_ecb_key_t *)m_aes_cb.ecb[count].key;
+            blocks[count].p_cleartext  = (soc_ecb_cleartext_t *)m_aes_cb.ecb[count].cleartext;
+            blocks[count].p_ciphertext = (soc_ecb_ciphertext_t *)m_aes_cb.ecb[count].ciphertext;
+        }
+
+        if (count != 0)
+        {
+            err_code = sd_ecb_blocks_encrypt((uint8_t)count, blocks);
+        }
+
+        for (uint32_t i = 0; (i < count) && (err_code == NRF_SUCCESS); i++)
+        {
+            aes_op_complete(i);
+        }
+    } while ((count != 0) && (err_code == NRF_SUCCESS));
+
+    aes_op_end(err_code);
+
+    return (m_aes_cb.handler == NULL) ? m_aes_cb.result : NRF_SUCCESS;
+}
+#endif // SOFTDEVICE_PRESENT
+
+
+/**@brief Function for setting up an operation.
+ */
+static void aes_op_setup(aes_mode_t      mode,
+                         uint8_t const * p_key,
+                         uint8_t const * p_in,
+                         uint8_t       * p_out,
+                         uint32_t        length)
+{
+    m_aes_cb.busy       = true;
+    m_aes_cb.mode       = mode;
+    m_aes_cb.p_in       = p_in;
+    m_aes_cb.p_out      = p_out;
+    m_aes_cb.length     = length;
+    m_aes_cb.ctr_total  = 0;
+    m_aes_cb.ctr_issued = 0;
+    m_aes_cb.ctr_done   = 0;
+    m_aes_cb.mac_total  = 0;
+    m_aes_cb.mac_issued = 0;
+    m_aes_cb.mac_done   = 0;
+    memset(m_aes_cb.mac, 0, NRF_DRV_AES_BLOCK_SIZE);
+
+    for (uint32_t i = 0; i < AES_SLOT_COUNT; i++)
+    {
+        memcpy(m_aes_cb.ecb[i].key, p_key, NRF_DRV_AES_BLOCK_SIZE);
+    }
+}
+
+
+static ret_code_t ccm_params_check(nrf_drv_aes_ccm_params_t const * p_params, uint32_t length)
+{
+    uint32_t length_size = (NRF_DRV_AES_BLOCK_SIZE - 1) - p_params->nonce_len;
+
+    if ((p_params->nonce_len < NRF_DRV_AES_CCM_NONCE_MIN) ||
+        (p_params->nonce_len > NRF_DRV_AES_CCM_NONCE_MAX) ||
+        (p_params->mic_len < NRF_DRV_AES_CCM_MIC_MIN)     ||
+        (p_params->mic_len > NRF_DRV_AES_BLOCK_SIZE)      ||
+        ((p_params->mic_len & 1) != 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if ((p_params->adata_len > NRF_DRV_AES_CCM_ADATA_MAX) ||
+        ((length_size < sizeof(uint32_t)) && ((length >> (8 * length_size)) != 0)))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for setting up a CCM operation: first counter block A0 and CBC-MAC block B0.
+ */
+static void ccm_setup(nrf_drv_aes_ccm_params_t const * p_params, uint32_t length)
+{
+    uint32_t length_size = (NRF_DRV_AES_BLOCK_SIZE - 1) - p_params->nonce_len;
+
+    memset(m_aes_cb.counter, 0, NRF_DRV_AES_BLOCK_SIZE);
+    m_aes_cb.counter[0] = (uint8_t)(length_size - 1);
+    memcpy(&m_aes_cb.counter[1], p_params->p_nonce, p_params->nonce_len);
+
+    memcpy(m_aes_cb.block0, m_aes_cb.counter, NRF_DRV_AES_BLOCK_SIZE);
+    m_aes_cb.block0[0] |= (uint8_t)((((p_params->mic_len - 2) / 2) << 3) |
+                                    ((p_params->adata_len != 0) ? 0x40 : 0));
+    for (uint32_t i = 0; i < MIN(length_size, sizeof(uint32_t)); i++)
+    {
+        m_aes_cb.block0[(NRF_DRV_AES_BLOCK_SIZE - 1) - i] = (uint8_t)(length >> (8 * i));
+    }
+
+    m_aes_cb.p_adata      = p_params->p_adata;
+    m_aes_cb.adata_len    = p_params->adata_len;
+    m_aes_cb.adata_blocks = (p_params->adata_len != 0) ?
+                            CEIL_DIV(p_params->adata_len + sizeof(uint16_t), NRF_DRV_AES_BLOCK_SIZE) : 0;
+    m_aes_cb.mic_len      = p_params->mic_len;
+    m_aes_cb.ctr_total    = 1 + CEIL_DIV(length, NRF_DRV_AES_BLOCK_SIZE);
+    m_aes_cb.mac_total    = 1 + m_aes_cb.adata_blocks + CEIL_DIV(length, NRF_DRV_AES_BLOCK_SIZE);
+}
+
+
+ret_code_t nrf_drv_aes_init(nrf_drv_aes_config_t const * p_config, nrf_drv_aes_handler_t handler)
+{
+    uint32_t result = NRF_SUCCESS;
+
+    if (m_aes_cb.state == NRF_DRV_STATE_UNINITIALIZED)
+    {
+#ifndef SOFTDEVICE_PRESENT
+        if (p_config == NULL)
+        {
+            p_config = &m_default_config;
+        }
+
+        if (handler != NULL)
+        {
+            NRF_ECB->INTENSET = ECB_INTENSET_ENDECB_Msk | ECB_INTENSET_ERRORECB_Msk;
+            nrf_drv_common_irq_enable(ECB_IRQn, p_config->interrupt_priority);
+        }
+#else
+        UNUSED_VARIABLE(p_config);
+        uint8_t softdevice_is_enabled;
+        result = sd_softdevice_is_enabled(&softdevice_is_enabled);
+
+        if (!softdevice_is_enabled)
+        {
+            result = NRF_ERROR_SOFTDEVICE_NOT_ENABLED;
+        }
+#endif // SOFTDEVICE_PRESENT
+
+        if (result == NRF_SUCCESS)
+        {
+            m_aes_cb.handler = handler;
+            m_aes_cb.busy    = false;
+            m_aes_cb.state   = NRF_DRV_STATE_INITIALIZED;
+        }
+    }
+    else
+    {
+        result = NRF_ERROR_INVALID_STATE;
+    }
+    return result;
+}
+
+
+void nrf_drv_aes_uninit(void)
+{
+    ASSERT(m_aes_cb.state == NRF_DRV_STATE_INITIALIZED);
+
+    m_aes_cb.state = NRF_DRV_STATE_UNINITIALIZED;
+#ifndef SOFTDEVICE_PRESENT
+    NRF_ECB->INTENCLR      = ECB_INTENCLR_ENDECB_Msk | ECB_INTENCLR_ERRORECB_Msk;
+    NRF_ECB->TASKS_STOPECB = 1;
+    nrf_drv_common_irq_disable(ECB_IRQn);
+#endif // SOFTDEVICE_PRESENT
+}
+
+
+ret_code_t nrf_drv_aes_ctr_crypt(uint8_t const * p_key,
+                                 uint8_t       * p_counter,
+                                 uint8_t const * p_in,
+                                 uint8_t       * p_out,
+                                 uint32_t        length)
+{
+    ASSERT(m_aes_cb.state == NRF_DRV_STATE_INITIALIZED);
+
+    if (m_aes_cb.busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    aes_op_setup(AES_MODE_CTR, p_key, p_in, p_out, length);
+    memcpy(m_aes_cb.counter, p_counter, NRF_DRV_AES_BLOCK_SIZE);
+    m_aes_cb.p_result  = p_counter;
+    m_aes_cb.ctr_total = CEIL_DIV(length, NRF_DRV_AES_BLOCK_SIZE);
+
+    return aes_op_run();
+}
+
+
+ret_code_t nrf_drv_aes_ccm_encrypt(nrf_drv_aes_ccm_params_t const * p_params,
+                                   uint8_t const                  * p_in,
+                                   uint8_t                        * p_out,
+                                   uint32_t                         length,
+                                   uint8_t                        * p_mic)
+{
+    ret_code_t err_code;
+
+    ASSERT(m_aes_cb.state == NRF_DRV_STATE_INITIALIZED);
+
+    if (m_aes_cb.busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    err_code = ccm_params_check(p_params, length);
+    VERIFY_SUCCESS(err_code);
+
+    aes_op_setup(AES_MODE_CCM_ENCRYPT, p_params->p_key, p_in, p_out, length);
+    ccm_setup(p_params, length);
+    m_aes_cb.p_result = p_mic;
+
+    return aes_op_run();
+}
+
+
+ret_code_t nrf_drv_aes_ccm_decrypt(nrf_drv_aes_ccm_params_t const * p_params,
+                                   uint8_t const                  * p_in,
+                                   uint8_t                        * p_out,
+                                   uint32_t                         length,
+                                   uint8_t const                  * p_mic)
+{
+    ret_code_t err_code;
+
+    ASSERT(m_aes_cb.state == NRF_DRV_STATE_INITIALIZED);
+
+    if (m_aes_cb.busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    err_code = ccm_params_check(p_params, length);
+    VERIFY_SUCCESS(err_code);
+
+    aes_op_setup(AES_MODE_CCM_DECRYPT, p_params->p_key, p_in, p_out, length);
+    ccm_setup(p_params, length);
+    m_aes_cb.p_mic = p_mic;
+
+    return aes_op_run();
+}
+
+
+ret_code_t nrf_drv_aes_cmac(uint8_t const * p_key,
+                            uint8_t const * p_in,
+                            uint32_t        length,
+                            uint8_t       * p_mac)
+{
+    ASSERT(m_aes_cb.state == NRF_DRV_STATE_INITIALIZED);
+
+    if (m_aes_cb.busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    aes_op_setup(AES_MODE_CMAC, p_key, p_in, NULL, length);
+    memset(m_aes_cb.block0, 0, NRF_DRV_AES_BLOCK_SIZE);
+    m_aes_cb.p_result  = p_mac;
+    m_aes_cb.mac_total = 1 + MAX(1, CEIL_DIV(length, NRF_DRV_AES_BLOCK_SIZE));
+
+    return aes_op_run();
+}
+
+
+#ifndef SOFTDEVICE_PRESENT
+void ECB_IRQHandler(void)
+{
+    if (NRF_ECB->EVENTS_ERRORECB != 0)
+    {
+        NRF_ECB->EVENTS_ERRORECB = 0;
+        if (m_aes_cb.busy)
+        {
+            aes_op_end(NRF_ERROR_INTERNAL);
+        }
+    }
+
+    if (NRF_ECB->EVENTS_ENDECB != 0)
+    {
+        NRF_ECB->EVENTS_ENDECB = 0;
+        if (m_aes_cb.busy)
+        {
+            aes_ecb_end_handle();
+        }
+    }
+}
+#endif // SOFTDEVICE_PRESENT
@@ -0,0 +1,192 @@
+/* Copyright (c) 2015 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef NRF_DRV_AES_H__
+#define NRF_DRV_AES_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+#include "nrf_drv_config.h"
+
+/**
+ * @addtogroup nrf_ecb AES ECB encryption
+ * @{
+ * @ingroup nrf_drivers
+ *
+ * @defgroup nrf_drv_aes AES driver
+ * @{
+ * @ingroup nrf_ecb
+ * @brief Driver for AES-128 CTR, CCM and CMAC on top of the AES ECB peripheral.
+ *
+ * @details The driver computes all the blocks of an operation, keystream and CBC-MAC blocks,
+ *          with the ECB peripheral. Two blocks are in progress at a time: while the peripheral
+ *          encrypts one block, the output of the previous one is processed and the next one is
+ *          prepared, so the peripheral runs back to back and the CPU only handles one interrupt
+ *          per block. When the SoftDevice is present, the ECB peripheral is used through
+ *          @ref sd_ecb_blocks_encrypt, with all the blocks which are ready passed in a single call,
+ *          and the operation is completed before the function returns.
+ *
+ *          All the buffers passed to the driver must be valid until the operation has completed.
+ *
+ * @note The driver and @ref nrf_ecb use the same peripheral and must not be used at the same time.
+ */
+
+#define NRF_DRV_AES_BLOCK_SIZE      16  /**< Size of an AES block and of an AES-128 key, in bytes. */
+#define NRF_DRV_AES_CCM_NONCE_MIN   7   /**< Minimum length of a CCM nonce, in bytes. */
+#define NRF_DRV_AES_CCM_NONCE_MAX   13  /**< Maximum length of a CCM nonce, in bytes. */
+#define NRF_DRV_AES_CCM_MIC_MIN     4   /**< Minimum length of a CCM MIC, in bytes. */
+#define NRF_DRV_AES_CCM_ADATA_MAX   0xFEFF  /**< Maximum length of the CCM additional authenticated data, in bytes. */
+
+/**@brief Struct for AES configuration. */
+typedef struct
+{
+    uint8_t interrupt_priority;     /**< Interrupt priority of the ECB peripheral. */
+} nrf_drv_aes_config_t;
+
+/**@brief AES default configuration. */
+#define NRF_DRV_AES_DEFAULT_CONFIG                                                    \
+    {                                                                                 \
+        .interrupt_priority = AES_CONFIG_IRQ_PRIORITY,                                \
+    }
+
+/**@brief Struct for the parameters of a CCM operation. */
+typedef struct
+{
+    uint8_t const * p_key;          /**< Pointer to the 16-byte key. */
+    uint8_t const * p_nonce;        /**< Pointer to the nonce. */
+    uint8_t         nonce_len;      /**< Length of the nonce, from @ref NRF_DRV_AES_CCM_NONCE_MIN to @ref NRF_DRV_AES_CCM_NONCE_MAX. */
+    uint8_t         mic_len;        /**< Length of the MIC, an even number from @ref NRF_DRV_AES_CCM_MIC_MIN to @ref NRF_DRV_AES_BLOCK_SIZE. */
+    uint8_t const * p_adata;        /**< Pointer to the additional authenticated data. Can be NULL if adata_len is 0. */
+    uint32_t        adata_len;      /**< Length of the additional authenticated data, at most @ref NRF_DRV_AES_CCM_ADATA_MAX. */
+} nrf_drv_aes_ccm_params_t;
+
+/**
+ * @brief AES operation completion handler.
+ *
+ * @param[in] result  NRF_SUCCESS if the operation was completed, NRF_ERROR_INVALID_DATA if the MIC
+ *                    of a CCM decryption did not match, NRF_ERROR_INTERNAL if the ECB peripheral
+ *                    aborted, or the error returned by the SoftDevice.
+ */
+typedef void (*nrf_drv_aes_handler_t)(ret_code_t result);
+
+/**
+ * @brief Function for initializing the nrf_drv_aes module.
+ *
+ * @param[in]  p_config   Initial configuration. Default configuration used if NULL.
+ * @param[in]  handler    Handler called on completion of each operation. If NULL, blocking mode is
+ *                        enabled and the result of an operation is returned by the function which
+ *                        starts it.
+ *
+ * @retval  NRF_SUCCESS                       Driver was successfully initialized.
+ * @retval  NRF_ERROR_INVALID_STATE           Driver was already initialized.
+ * @retval  NRF_ERROR_SOFTDEVICE_NOT_ENABLED  SoftDevice is present, but not enabled.
+ */
+ret_code_t nrf_drv_aes_init(nrf_drv_aes_config_t const * p_config, nrf_drv_aes_handler_t handler);
+
+/**
+ * @brief Function for uninitializing the nrf_drv_aes module.
+ */
+void nrf_drv_aes_uninit(void);
+
+/**
+ * @brief Function for encrypting or decrypting data in CTR mode.
+ *
+ * @details The counter block is incremented as a 128-bit big-endian number for each block of
+ *          data. On completion, p_counter holds the counter block following the last one used, so
+ *          a stream can be processed in several calls.
+ *
+ * @param[in]     p_key      Pointer to the 16-byte key.
+ * @param[in,out] p_counter  Pointer to the 16-byte initial counter block.
+ * @param[in]     p_in       Pointer to the data to be encrypted or decrypted.
+ * @param[out]    p_out      Pointer to the result. Can be the same as p_in.
+ * @param[in]     length     Length of the data, in bytes. Does not have to be a multiple of the
+ *                           block size.
+ *
+ * @retval  NRF_SUCCESS          The operation was started, or completed in blocking mode.
+ * @retval  NRF_ERROR_BUSY       Another operation is in progress.
+ * @return  In blocking mode, the result of the operation, see @ref nrf_drv_aes_handler_t.
+ */
+ret_code_t nrf_drv_aes_ctr_crypt(uint8_t const * p_key,
+                                 uint8_t       * p_counter,
+                                 uint8_t const * p_in,
+                                 uint8_t       * p_out,
+                                 uint32_t        length);
+
+/**
+ * @brief Function for encrypting and authenticating data in CCM mode (RFC 3610).
+ *
+ * @param[in]  p_params  Pointer to the parameters of the operation.
+ * @param[in]  p_in      Pointer to the data to be encrypted.
+ * @param[out] p_out     Pointer to the encrypted data. Can be the same as p_in.
+ * @param[in]  length    Length of the data, in bytes.
+ * @param[out] p_mic     Pointer to the MIC, p_params->mic_len bytes.
+ *
+ * @retval  NRF_SUCCESS               The operation was started, or completed in blocking mode.
+ * @retval  NRF_ERROR_BUSY            Another operation is in progress.
+ * @retval  NRF_ERROR_INVALID_PARAM   The nonce or MIC length is not valid.
+ * @retval  NRF_ERROR_INVALID_LENGTH  The data or the additional data is too long for the nonce.
+ * @return  In blocking mode, the result of the operation, see @ref nrf_drv_aes_handler_t.
+ */
+ret_code_t nrf_drv_aes_ccm_encrypt(nrf_drv_aes_ccm_params_t const * p_params,
+                                   uint8_t const                  * p_in,
+                                   uint8_t                        * p_out,
+                                   uint32_t                         length,
+                                   uint8_t                        * p_mic);
+
+/**
+ * @brief Function for decrypting and verifying data in CCM mode (RFC 3610).
+ *
+ * @details If the MIC does not match, the operation completes with NRF_ERROR_INVALID_DATA and the
+ *          decrypted data is cleared.
+ *
+ * @param[in]  p_params  Pointer to the parameters of the operation.
+ * @param[in]  p_in      Pointer to the data to be decrypted.
+ * @param[out] p_out     Pointer to the decrypted data. Can be the same as p_in.
+ * @param[in]  length    Length of the data, in bytes.
+ * @param[in]  p_mic     Pointer to the received MIC, p_params->mic_len bytes.
+ *
+ * @retval  NRF_SUCCESS               The operation was started, or completed in blocking mode.
+ * @retval  NRF_ERROR_BUSY            Another operation is in progress.
+ * @retval  NRF_ERROR_INVALID_PARAM   The nonce or MIC length is not valid.
+ * @retval  NRF_ERROR_INVALID_LENGTH  The data or the additional data is too long for the nonce.
+ * @return  In blocking mode, the result of the operation, see @ref nrf_drv_aes_handler_t.
+ */
+ret_code_t nrf_drv_aes_ccm_decrypt(nrf_drv_aes_ccm_params_t const * p_params,
+                                   uint8_t const                  * p_in,
+                                   uint8_t                        * p_out,
+                                   uint32_t                         length,
+                                   uint8_t const                  * p_mic);
+
+/**
+ * @brief Function for computing the AES-CMAC of data (RFC 4493).
+ *
+ * @param[in]  p_key   Pointer to the 16-byte key.
+ * @param[in]  p_in    Pointer to the data.
+ * @param[in]  length  Length of the data, in bytes.
+ * @param[out] p_mac   Pointer to the 16-byte MAC.
+ *
+ * @retval  NRF_SUCCESS      The operation was started, or completed in blocking mode.
+ * @retval  NRF_ERROR_BUSY   Another operation is in progress.
+ * @return  In blocking mode, the result of the operation, see @ref nrf_drv_aes_handler_t.
+ */
+ret_code_t nrf_drv_aes_cmac(uint8_t const * p_key,
+                            uint8_t const * p_in,
+                            uint32_t        length,
+                            uint8_t       * p_mac);
+
+/**
+ *@}
+ *@}
+ **/
+#endif // NRF_DRV_AES_H__
@@ -13,6 +13,7 @@
 #include "nrf_drv_clock.h"
 #include "nrf_error.h"
 #include "nordic_common.h"
+#include "app_energy.h"
 
 #ifdef SOFTDEVICE_PRESENT
 #include "nrf_sdm.h"
@@ -21,6 +22,9 @@
 #else
 #include "app_util_platform.h"
 #endif // SOFTDEVICE_PRESENT
+#if CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+#include "app_timer.h"
+#endif
 
 /*lint -save -e652 */
 #define NRF_CLOCK_LFCLK_RC    CLOCK_LFCLKSRC_SRC_RC
@@ -30,6 +34,9 @@
 
 #define INT_MAX 0xFFFFFFFF
 
+#define RTC_COUNTER_MASK      0x00FFFFFF  /**< RTC1 counter range used by app_timer. */
+#define RTC_COUNTER_HALF      0x00800000  /**< Differences above this are in the past. */
+
 #if (CLOCK_CONFIG_LF_SRC == NRF_CLOCK_LFCLK_RC) && !defined(SOFTDEVICE_PRESENT)
 #define CALIBRATION_SUPPORT 1
 #else
@@ -90,6 +97,7 @@ static void lfclk_stop(void)
 #endif
 static void hfclk_start(void)
 {
+    APP_ENERGY_SOURCE_ON(APP_ENERGY_SOURCE_HFXO);
 #ifndef SOFTDEVICE_PRESENT
     nrf_clock_event_clear(NRF_CLOCK_EVENT_HFCLKSTARTED);
     nrf_clock_int_enable(NRF_CLOCK_INT_HF_STARTED_MASK);
@@ -108,6 +116,7 @@ static void hfclk_stop(void)
 #else
     UNUSED_VARIABLE(sd_clock_hfclk_release());
 #endif
+    APP_ENERGY_SOURCE_OFF(APP_ENERGY_SOURCE_HFXO);
 }
 
 ret_code_t nrf_drv_clock_init(void)
@@ -293,6 +302,160 @@ void nrf_drv_clock_hfclk_release(void)
     //enable interrupts CLOCK or SoftDevice events
 }
 
+#if CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+APP_TIMER_DEF(m_hfclk_sched_timer_id);                          /**< Timer of the scheduled requests. */
+static bool                          m_hfclk_sched_timer_created;
+static nrf_drv_clock_hfclk_sched_t * mp_hfclk_sched_head;       /**< Pending requests, earliest first. */
+
+/**@brief Function for computing the number of ticks until a counter value, 0 if it is past. */
+static uint32_t hfclk_sched_ticks_left(uint32_t tick, uint32_t now)
+{
+    uint32_t diff = (tick - now) & RTC_COUNTER_MASK;
+    return (diff > RTC_COUNTER_HALF) ? 0 : diff;
+}
+
+/**@brief Function for making the due requests and restarting the timer for the next one. */
+static void hfclk_sched_process(void)
+{
+    nrf_drv_clock_hfclk_sched_t * p_due;
+    uint32_t                      ticks = 0;
+    uint32_t                      now;
+
+    do
+    {
+        p_due = NULL;
+        CRITICAL_REGION_ENTER();
+        UNUSED_VARIABLE(app_timer_cnt_get(&now));
+        if ((mp_hfclk_sched_head != NULL) &&
+            (hfclk_sched_ticks_left(mp_hfclk_sched_head->request_tick, now) < APP_TIMER_MIN_TIMEOUT_TICKS))
+        {
+            p_due               = mp_hfclk_sched_head;
+            mp_hfclk_sched_head = p_due->p_next;
+            p_due->pending      = false;
+        }
+        else if (mp_hfclk_sched_head != NULL)
+        {
+            ticks = hfclk_sched_ticks_left(mp_hfclk_sched_head->request_tick, now);
+        }
+        else
+        {
+            ticks = 0;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (p_due != NULL)
+        {
+            nrf_drv_clock_hfclk_request(p_due->p_handler_item);
+        }
+    } while (p_due != NULL);
+
+    UNUSED_VARIABLE(app_timer_stop(m_hfclk_sched_timer_id));
+    if (ticks != 0)
+    {
+        UNUSED_VARIABLE(app_timer_start(m_hfclk_sched_timer_id, ticks, NULL));
+    }
+}
+
+static void hfclk_sched_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+    hfclk_sched_process();
+}
+#endif // CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+
+ret_code_t nrf_drv_clock_hfclk_request_at(nrf_drv_clock_hfclk_sched_t  * p_sched,
+                                          uint32_t                       use_tick,
+                                          nrf_drv_clock_handler_item_t * p_handler_item)
+{
+#if CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+    ASSERT(m_clock_cb.module_initialized);
+    ASSERT(p_sched != NULL);
+
+    ret_code_t err_code = NRF_SUCCESS;
+    uint32_t   now;
+
+    if (!m_hfclk_sched_timer_created)
+    {
+        // Created on first use, as the app_timer module is usually initialized after this driver.
+        err_code = app_timer_create(&m_hfclk_sched_timer_id, APP_TIMER_MODE_SINGLE_SHOT,
+                                    hfclk_sched_timeout_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+        m_hfclk_sched_timer_created = true;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (p_sched->pending)
+    {
+        err_code = NRF_ERROR_BUSY;
+    }
+    else
+    {
+        nrf_drv_clock_hfclk_sched_t ** pp_pos = &mp_hfclk_sched_head;
+        uint32_t                       ticks;
+
+        UNUSED_VARIABLE(app_timer_cnt_get(&now));
+        p_sched->p_handler_item = p_handler_item;
+        p_sched->request_tick   = (use_tick - CLOCK_CONFIG_HFCLK_STARTUP_TICKS) & RTC_COUNTER_MASK;
+        p_sched->pending        = true;
+
+        ticks = hfclk_sched_ticks_left(p_sched->request_tick, now);
+        while ((*pp_pos != NULL) && (hfclk_sched_ticks_left((*pp_pos)->request_tick, now) <= ticks))
+        {
+            pp_pos = &(*pp_pos)->p_next;
+        }
+        p_sched->p_next = *pp_pos;
+        *pp_pos         = p_sched;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (err_code == NRF_SUCCESS)
+    {
+        hfclk_sched_process();
+    }
+    return err_code;
+#else
+    UNUSED_PARAMETER(p_sched);
+    UNUSED_PARAMETER(use_tick);
+    UNUSED_PARAMETER(p_handler_item);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif // CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+}
+
+ret_code_t nrf_drv_clock_hfclk_request_cancel(nrf_drv_clock_hfclk_sched_t * p_sched)
+{
+#if CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+    ASSERT(p_sched != NULL);
+
+    ret_code_t err_code = NRF_ERROR_INVALID_STATE;
+
+    CRITICAL_REGION_ENTER();
+    if (p_sched->pending)
+    {
+        nrf_drv_clock_hfclk_sched_t ** pp_pos = &mp_hfclk_sched_head;
+
+        while ((*pp_pos != NULL) && (*pp_pos != p_sched))
+        {
+            pp_pos = &(*pp_pos)->p_next;
+        }
+        if (*pp_pos != NULL)
+        {
+            *pp_pos = p_sched->p_next;
+        }
+        p_sched->pending = false;
+        err_code         = NRF_SUCCESS;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+#else
+    UNUSED_PARAMETER(p_sched);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif // CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+}
+
 bool nrf_drv_clock_hfclk_is_running(void)
 {
     bool result;
@@ -21,6 +21,14 @@
 #include "nrf_drv_config.h"
 #include "nrf_drv_common.h"
 
+#ifndef CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED
+#define CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED 0   ///< Enable @ref nrf_drv_clock_hfclk_request_at. Requires the app_timer module.
+#endif
+
+#ifndef CLOCK_CONFIG_HFCLK_STARTUP_TICKS
+#define CLOCK_CONFIG_HFCLK_STARTUP_TICKS    33  ///< HFCLK start-up time, plus margin, in app_timer ticks (1 ms with prescaler 0).
+#endif
+
 /**
  *
  * @addtogroup nrf_clock Clock HAL and driver
@@ -62,6 +70,20 @@ struct nrf_drv_clock_handler_item_s
     nrf_drv_clock_event_handler_t  event_handler; ///< Function to be called when the clock is started.
 };
 
+// Forward declaration of the nrf_drv_clock_hfclk_sched_t type.
+typedef struct nrf_drv_clock_hfclk_sched_s nrf_drv_clock_hfclk_sched_t;
+
+/**
+ * @brief Scheduled HFCLK request. The fields are internal to the driver.
+ */
+struct nrf_drv_clock_hfclk_sched_s
+{
+    nrf_drv_clock_hfclk_sched_t  * p_next;         ///< A pointer to the next pending scheduled request.
+    nrf_drv_clock_handler_item_t * p_handler_item; ///< Handler item passed to @ref nrf_drv_clock_hfclk_request, or NULL.
+    uint32_t                       request_tick;   ///< RTC1 counter value at which the HFCLK is requested.
+    volatile bool                  pending;        ///< True until the HFCLK is requested.
+};
+
 /**
  * @brief Function for initializing the nrf_drv_clock module.
  *
@@ -155,6 +177,38 @@ void nrf_drv_clock_hfclk_release(void);
  */
 bool nrf_drv_clock_hfclk_is_running(void);
 
+/**
+ * @brief Function for requesting the high-accuracy source HFCLK ahead of a known future use.
+ *
+ * The request is made with @ref nrf_drv_clock_hfclk_request @ref CLOCK_CONFIG_HFCLK_STARTUP_TICKS
+ * before @p use_tick, from the app_timer interrupt, so that the crystal start-up overlaps the
+ * remaining sleep instead of delaying the user. All scheduled requests share one app_timer.
+ * Once made, the request counts like any other and must be released with
+ * @ref nrf_drv_clock_hfclk_release. If @p use_tick is too close, the request is made at once.
+ * @note The handler item and the schedule structure cannot be automatic variables.
+ * @param[in] p_sched         A pointer to the schedule structure.
+ * @param[in] use_tick        RTC1 counter value (see app_timer_cnt_get()) at which the clock is
+ *                            needed. Must be less than half the counter range ahead.
+ * @param[in] p_handler_item  NULL or a pointer to the event handler structure.
+ * @retval    NRF_SUCCESS               If the request was scheduled or made.
+ * @retval    NRF_ERROR_BUSY            If @p p_sched is already pending.
+ * @retval    NRF_ERROR_NOT_SUPPORTED   If CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED is 0.
+ * @return    Other values returned by app_timer_create().
+ */
+ret_code_t nrf_drv_clock_hfclk_request_at(nrf_drv_clock_hfclk_sched_t  * p_sched,
+                                          uint32_t                       use_tick,
+                                          nrf_drv_clock_handler_item_t * p_handler_item);
+
+/**
+ * @brief Function for cancelling a scheduled HFCLK request.
+ * @param[in] p_sched         A pointer to the schedule structure.
+ * @retval    NRF_SUCCESS               If the request was cancelled before being made.
+ * @retval    NRF_ERROR_INVALID_STATE   If the request was already made, and must be released
+ *                                      with @ref nrf_drv_clock_hfclk_release.
+ * @retval    NRF_ERROR_NOT_SUPPORTED   If CLOCK_CONFIG_HFCLK_SCHEDULE_ENABLED is 0.
+ */
+ret_code_t nrf_drv_clock_hfclk_request_cancel(nrf_drv_clock_hfclk_sched_t * p_sched);
+
 /**
  * @brief Function for starting a single calibration process.
  *
@@ -19,6 +19,12 @@
 #include "nrf_soc.h"
 #endif
 
+#if NRF_DRV_IRQ_MONITOR_ENABLED
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf_drv_ppi.h"
+#endif
+
 
 #if PERIPHERAL_RESOURCE_SHARING_ENABLED
 
@@ -206,3 +212,231 @@ void nrf_drv_common_irq_enable(IRQn_Type IRQn, uint8_t priority)
     NVIC_ClearPendingIRQ(IRQn);
     NVIC_EnableIRQ(IRQn);
 }
+
+
+#if NRF_DRV_IRQ_MONITOR_ENABLED
+
+#ifdef NRF52
+#define IRQ_MONITOR_TIMER_MASK      0xFFFFFFFFUL
+#define IRQ_MONITOR_TIMER_BITMODE   TIMER_BITMODE_BITMODE_32Bit
+#else
+#define IRQ_MONITOR_TIMER_MASK      0xFFFFUL
+#define IRQ_MONITOR_TIMER_BITMODE   TIMER_BITMODE_BITMODE_16Bit
+#endif
+
+// Conversion of timer ticks to microseconds.
+#if (NRF_DRV_IRQ_MONITOR_PRESCALER >= 4)
+#define IRQ_MONITOR_TICKS_TO_US(ticks)  ((ticks) << (NRF_DRV_IRQ_MONITOR_PRESCALER - 4))
+#else
+#define IRQ_MONITOR_TICKS_TO_US(ticks)  ((ticks) >> (4 - NRF_DRV_IRQ_MONITOR_PRESCALER))
+#endif
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t exec_ticks;
+    uint32_t exec_max_ticks;
+    uint32_t latency_max_ticks;
+} irq_monitor_stats_t;
+
+static irq_monitor_stats_t m_irq_stats[NRF_DRV_IRQ_MONITOR_IRQ_COUNT];      // Current window.
+static irq_monitor_stats_t m_irq_stats_last[NRF_DRV_IRQ_MONITOR_IRQ_COUNT]; // Last closed window.
+static uint8_t             m_latency_irqn[NRF_DRV_IRQ_MONITOR_LATENCY_SOURCES];
+static uint8_t             m_latency_source_count;
+static uint32_t            m_nested_ticks;     // Time spent in the handlers preempting the current context.
+static uint32_t            m_window_start;
+static uint32_t            m_idle_ticks;
+static uint32_t            m_irq_ticks;
+
+static uint32_t irq_monitor_time_get(void)
+{
+    NRF_DRV_IRQ_MONITOR_TIMER->TASKS_CAPTURE[0] = 1;
+    return NRF_DRV_IRQ_MONITOR_TIMER->CC[0];
+}
+
+void nrf_drv_irq_monitor_init(void)
+{
+    NRF_DRV_IRQ_MONITOR_TIMER->TASKS_STOP  = 1;
+    NRF_DRV_IRQ_MONITOR_TIMER->MODE        = TIMER_MODE_MODE_Timer;
+    NRF_DRV_IRQ_MONITOR_TIMER->BITMODE     = IRQ_MONITOR_TIMER_BITMODE;
+    NRF_DRV_IRQ_MONITOR_TIMER->PRESCALER   = NRF_DRV_IRQ_MONITOR_PRESCALER;
+    NRF_DRV_IRQ_MONITOR_TIMER->INTENCLR    = 0xFFFFFFFF;
+    NRF_DRV_IRQ_MONITOR_TIMER->SHORTS      = 0;
+    NRF_DRV_IRQ_MONITOR_TIMER->TASKS_CLEAR = 1;
+    NRF_DRV_IRQ_MONITOR_TIMER->TASKS_START = 1;
+
+    CRITICAL_REGION_ENTER();
+    memset(m_irq_stats, 0, sizeof(m_irq_stats));
+    memset(m_irq_stats_last, 0, sizeof(m_irq_stats_last));
+    m_nested_ticks = 0;
+    m_idle_ticks   = 0;
+    m_irq_ticks    = 0;
+    m_window_start = irq_monitor_time_get();
+    CRITICAL_REGION_EXIT();
+}
+
+ret_code_t nrf_drv_irq_monitor_latency_source_set(IRQn_Type IRQn, uint32_t event_address)
+{
+    nrf_ppi_channel_t channel;
+    ret_code_t        err_code;
+
+    if (m_latency_source_count >= NRF_DRV_IRQ_MONITOR_LATENCY_SOURCES)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    err_code = nrf_drv_ppi_channel_alloc(&channel);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    // CC[0] is used to read the timer, latency sources start at CC[1].
+    err_code = nrf_drv_ppi_channel_assign(channel, event_address,
+        (uint32_t)&NRF_DRV_IRQ_MONITOR_TIMER->TASKS_CAPTURE[1 + m_latency_source_count]);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_enable(channel);
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        (void)nrf_drv_ppi_channel_free(channel);
+        return err_code;
+    }
+
+    m_latency_irqn[m_latency_source_count] = (uint8_t)IRQn;
+    m_latency_source_count++;
+
+    return NRF_SUCCESS;
+}
+
+static void irq_monitor_context_begin(nrf_drv_irq_monitor_ctx_t * p_ctx)
+{
+    p_ctx->start        = irq_monitor_time_get();
+    p_ctx->outer_nested = m_nested_ticks;
+    m_nested_ticks      = 0;
+}
+
+// Returns the time spent in the context itself, and adds the whole context time to the nested
+// time of the preempted context.
+static uint32_t irq_monitor_context_end(nrf_drv_irq_monitor_ctx_t * p_ctx)
+{
+    uint32_t total = (irq_monitor_time_get() - p_ctx->start) & IRQ_MONITOR_TIMER_MASK;
+    uint32_t own   = (total > m_nested_ticks) ? (total - m_nested_ticks) : 0;
+
+    m_nested_ticks = p_ctx->outer_nested + total;
+    return own;
+}
+
+void nrf_drv_irq_monitor_enter(IRQn_Type IRQn, nrf_drv_irq_monitor_ctx_t * p_ctx)
+{
+    CRITICAL_REGION_ENTER();
+    irq_monitor_context_begin(p_ctx);
+
+    for (uint32_t i = 0; i < m_latency_source_count; i++)
+    {
+        if (((uint32_t)IRQn < NRF_DRV_IRQ_MONITOR_IRQ_COUNT) && (m_latency_irqn[i] == (uint8_t)IRQn))
+        {
+            uint32_t latency = (p_ctx->start - NRF_DRV_IRQ_MONITOR_TIMER->CC[1 + i]) &
+                               IRQ_MONITOR_TIMER_MASK;
+
+            if (latency > m_irq_stats[IRQn].latency_max_ticks)
+            {
+                m_irq_stats[IRQn].latency_max_ticks = latency;
+            }
+        }
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+void nrf_drv_irq_monitor_exit(IRQn_Type IRQn, nrf_drv_irq_monitor_ctx_t * p_ctx)
+{
+    CRITICAL_REGION_ENTER();
+    uint32_t exec = irq_monitor_context_end(p_ctx);
+
+    if ((uint32_t)IRQn < NRF_DRV_IRQ_MONITOR_IRQ_COUNT)
+    {
+        irq_monitor_stats_t * p_stats = &m_irq_stats[IRQn];
+
+        p_stats->count++;
+        p_stats->exec_ticks += exec;
+        if (exec > p_stats->exec_max_ticks)
+        {
+            p_stats->exec_max_ticks = exec;
+        }
+    }
+    m_irq_ticks += exec;
+    CRITICAL_REGION_EXIT();
+}
+
+void nrf_drv_irq_monitor_idle_begin(nrf_drv_irq_monitor_ctx_t * p_ctx)
+{
+    CRITICAL_REGION_ENTER();
+    irq_monitor_context_begin(p_ctx);
+    CRITICAL_REGION_EXIT();
+}
+
+void nrf_drv_irq_monitor_idle_end(nrf_drv_irq_monitor_ctx_t * p_ctx)
+{
+    CRITICAL_REGION_ENTER();
+    m_idle_ticks += irq_monitor_context_end(p_ctx);
+    CRITICAL_REGION_EXIT();
+}
+
+void nrf_drv_irq_monitor_window_end(nrf_drv_irq_window_t * p_window)
+{
+    uint32_t window_ticks;
+    uint32_t idle_ticks;
+    uint32_t irq_ticks;
+
+    CRITICAL_REGION_ENTER();
+    uint32_t now = irq_monitor_time_get();
+
+    window_ticks   = (now - m_window_start) & IRQ_MONITOR_TIMER_MASK;
+    idle_ticks     = m_idle_ticks;
+    irq_ticks      = m_irq_ticks;
+    m_window_start = now;
+    m_idle_ticks   = 0;
+    m_irq_ticks    = 0;
+    memcpy(m_irq_stats_last, m_irq_stats, sizeof(m_irq_stats));
+    memset(m_irq_stats, 0, sizeof(m_irq_stats));
+    CRITICAL_REGION_EXIT();
+
+    if (p_window != NULL)
+    {
+        p_window->window_us = IRQ_MONITOR_TICKS_TO_US(window_ticks);
+        p_window->idle_us   = IRQ_MONITOR_TICKS_TO_US(idle_ticks);
+        p_window->irq_us    = IRQ_MONITOR_TICKS_TO_US(irq_ticks);
+        p_window->cpu_load  = 0;
+        p_window->irq_load  = 0;
+        if (window_ticks != 0)
+        {
+            uint32_t busy_ticks = (window_ticks > idle_ticks) ? (window_ticks - idle_ticks) : 0;
+
+            p_window->cpu_load = (uint16_t)(((uint64_t)busy_ticks * 1000) / window_ticks);
+            p_window->irq_load = (uint16_t)(((uint64_t)MIN(irq_ticks, window_ticks) * 1000) /
+                                            window_ticks);
+        }
+    }
+}
+
+ret_code_t nrf_drv_irq_monitor_stats_get(IRQn_Type IRQn, nrf_drv_irq_stats_t * p_stats)
+{
+    if (((uint32_t)IRQn >= NRF_DRV_IRQ_MONITOR_IRQ_COUNT) || (p_stats == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    irq_monitor_stats_t const * p_last = &m_irq_stats_last[IRQn];
+
+    p_stats->count          = p_last->count;
+    p_stats->exec_us        = IRQ_MONITOR_TICKS_TO_US(p_last->exec_ticks);
+    p_stats->exec_max_us    = IRQ_MONITOR_TICKS_TO_US(p_last->exec_max_ticks);
+    p_stats->latency_max_us = IRQ_MONITOR_TICKS_TO_US(p_last->latency_max_ticks);
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+#endif // NRF_DRV_IRQ_MONITOR_ENABLED
@@ -52,6 +52,182 @@ typedef enum
 typedef void (*nrf_drv_irq_handler_t)(void);
 
 
+#ifndef NRF_DRV_IRQ_MONITOR_ENABLED
+#define NRF_DRV_IRQ_MONITOR_ENABLED 0
+#endif
+
+#if NRF_DRV_IRQ_MONITOR_ENABLED
+
+/**
+ * @brief TIMER instance used as time base by the interrupt monitor.
+ *
+ * The timer runs in 32-bit mode on nRF52 devices. On nRF51 devices, only TIMER0 supports
+ * 32-bit mode and it is used by the SoftDevice, so the timer runs in 16-bit mode, and windows
+ * and sleep periods must be shorter than the timer period.
+ */
+#ifndef NRF_DRV_IRQ_MONITOR_TIMER
+#define NRF_DRV_IRQ_MONITOR_TIMER       NRF_TIMER2
+#endif
+
+/**
+ * @brief Prescaler of the interrupt monitor timer.
+ *
+ * The defaults give 1 us ticks on nRF52 devices, and 32 us ticks with a 2 s period on nRF51
+ * devices.
+ */
+#ifndef NRF_DRV_IRQ_MONITOR_PRESCALER
+#ifdef NRF52
+#define NRF_DRV_IRQ_MONITOR_PRESCALER   4
+#else
+#define NRF_DRV_IRQ_MONITOR_PRESCALER   9
+#endif
+#endif
+
+/**
+ * @brief Number of interrupts monitored, from interrupt number 0.
+ */
+#ifndef NRF_DRV_IRQ_MONITOR_IRQ_COUNT
+#ifdef NRF52
+#define NRF_DRV_IRQ_MONITOR_IRQ_COUNT   39
+#else
+#define NRF_DRV_IRQ_MONITOR_IRQ_COUNT   32
+#endif
+#endif
+
+/**
+ * @brief Number of interrupts for which the latency can be measured. Each one uses a PPI channel
+ *        and a capture register of the timer, from CC[1].
+ */
+#define NRF_DRV_IRQ_MONITOR_LATENCY_SOURCES 3
+
+/**
+ * @brief Interrupt monitor context of one handler execution, or of one sleep period.
+ */
+typedef struct
+{
+    uint32_t start;         /**< Timer value at handler entry. */
+    uint32_t outer_nested;  /**< Nested time of the preempted context. */
+} nrf_drv_irq_monitor_ctx_t;
+
+/**
+ * @brief Interrupt statistics over a window.
+ */
+typedef struct
+{
+    uint32_t count;         /**< Number of handler executions. */
+    uint32_t exec_us;       /**< Total execution time, excluding nested application interrupts. */
+    uint32_t exec_max_us;   /**< Longest execution. */
+    uint32_t latency_max_us;/**< Longest latency from the event source to the handler entry. Only if a latency source is set. */
+} nrf_drv_irq_stats_t;
+
+/**
+ * @brief Window statistics.
+ */
+typedef struct
+{
+    uint32_t window_us;     /**< Length of the window. */
+    uint32_t idle_us;       /**< Time spent sleeping, measured by @ref NRF_DRV_IRQ_MONITOR_IDLE_BEGIN. */
+    uint32_t irq_us;        /**< Time spent in the monitored interrupt handlers. */
+    uint16_t cpu_load;      /**< CPU utilization in per mille: time not spent sleeping. */
+    uint16_t irq_load;      /**< Utilization by the monitored interrupt handlers, in per mille. */
+} nrf_drv_irq_window_t;
+
+/**
+ * @brief Function for starting the interrupt monitor, and its first window.
+ */
+void nrf_drv_irq_monitor_init(void);
+
+/**
+ * @brief Function for measuring the latency of an interrupt from a peripheral event.
+ *
+ * The event is captured by the timer through PPI. On handler entry, the latency is the time
+ * since the last occurrence of the event.
+ *
+ * @param[in] IRQn           Interrupt id.
+ * @param[in] event_address  Address of the event register.
+ *
+ * @retval NRF_SUCCESS        If the latency source was set.
+ * @retval NRF_ERROR_NO_MEM   If @ref NRF_DRV_IRQ_MONITOR_LATENCY_SOURCES sources are already set.
+ * @return Other errors from @ref nrf_drv_ppi_channel_alloc.
+ */
+ret_code_t nrf_drv_irq_monitor_latency_source_set(IRQn_Type IRQn, uint32_t event_address);
+
+/**
+ * @brief Function called on interrupt handler entry, see @ref NRF_DRV_IRQ_MONITOR_ENTER.
+ */
+void nrf_drv_irq_monitor_enter(IRQn_Type IRQn, nrf_drv_irq_monitor_ctx_t * p_ctx);
+
+/**
+ * @brief Function called on interrupt handler exit, see @ref NRF_DRV_IRQ_MONITOR_EXIT.
+ */
+void nrf_drv_irq_monitor_exit(IRQn_Type IRQn, nrf_drv_irq_monitor_ctx_t * p_ctx);
+
+/**
+ * @brief Function called before going to sleep, see @ref NRF_DRV_IRQ_MONITOR_IDLE_BEGIN.
+ */
+void nrf_drv_irq_monitor_idle_begin(nrf_drv_irq_monitor_ctx_t * p_ctx);
+
+/**
+ * @brief Function called after waking up, see @ref NRF_DRV_IRQ_MONITOR_IDLE_END.
+ */
+void nrf_drv_irq_monitor_idle_end(nrf_drv_irq_monitor_ctx_t * p_ctx);
+
+/**
+ * @brief Function for closing the current window and starting the next one.
+ *
+ * @param[out] p_window  Statistics of the closed window. Can be NULL.
+ */
+void nrf_drv_irq_monitor_window_end(nrf_drv_irq_window_t * p_window);
+
+/**
+ * @brief Function for reading the statistics of an interrupt over the last closed window.
+ *
+ * @param[in]  IRQn     Interrupt id.
+ * @param[out] p_stats  Statistics.
+ *
+ * @retval NRF_SUCCESS              If the statistics were read.
+ * @retval NRF_ERROR_INVALID_PARAM  If the interrupt is not monitored.
+ */
+ret_code_t nrf_drv_irq_monitor_stats_get(IRQn_Type IRQn, nrf_drv_irq_stats_t * p_stats);
+
+/**
+ * @brief Macro to be placed at the start of a monitored interrupt handler.
+ */
+#define NRF_DRV_IRQ_MONITOR_ENTER(IRQn)                                 \
+    nrf_drv_irq_monitor_ctx_t irq_monitor_ctx;                          \
+    nrf_drv_irq_monitor_enter(IRQn, &irq_monitor_ctx)
+
+/**
+ * @brief Macro to be placed at the end of a monitored interrupt handler, in the same scope as
+ *        @ref NRF_DRV_IRQ_MONITOR_ENTER.
+ */
+#define NRF_DRV_IRQ_MONITOR_EXIT(IRQn)  nrf_drv_irq_monitor_exit(IRQn, &irq_monitor_ctx)
+
+/**
+ * @brief Macro to be placed before the call to sd_app_evt_wait() in the main loop.
+ *
+ * The monitored interrupt handlers executed before sd_app_evt_wait() returns are not counted
+ * as idle time.
+ */
+#define NRF_DRV_IRQ_MONITOR_IDLE_BEGIN()                                \
+    nrf_drv_irq_monitor_ctx_t irq_monitor_idle_ctx;                     \
+    nrf_drv_irq_monitor_idle_begin(&irq_monitor_idle_ctx)
+
+/**
+ * @brief Macro to be placed after the call to sd_app_evt_wait() in the main loop.
+ */
+#define NRF_DRV_IRQ_MONITOR_IDLE_END()  nrf_drv_irq_monitor_idle_end(&irq_monitor_idle_ctx)
+
+#else
+
+#define NRF_DRV_IRQ_MONITOR_ENTER(IRQn)
+#define NRF_DRV_IRQ_MONITOR_EXIT(IRQn)
+#define NRF_DRV_IRQ_MONITOR_IDLE_BEGIN()
+#define NRF_DRV_IRQ_MONITOR_IDLE_END()
+
+#endif // NRF_DRV_IRQ_MONITOR_ENABLED
+
+
 #if PERIPHERAL_RESOURCE_SHARING_ENABLED
 
 /**
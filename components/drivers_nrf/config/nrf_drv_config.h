@@ -145,7 +145,17 @@
 #if (RNG_ENABLED == 1)
 #define RNG_CONFIG_ERROR_CORRECTION true
 #define RNG_CONFIG_POOL_SIZE        8
+#define RNG_CONFIG_POOL_WATERMARK   8
 #define RNG_CONFIG_IRQ_PRIORITY     APP_IRQ_PRIORITY_LOW
+#define RNG_CONFIG_DRBG_ENABLED     0
+#endif
+
+/* AES */
+#define AES_ENABLED 0
+
+#if (AES_ENABLED == 1)
+#define AES_CONFIG_IRQ_PRIORITY     APP_IRQ_PRIORITY_LOW
+#define AES_CONFIG_SD_BATCH_SIZE    8
 #endif
 
 /* PWM */
@@ -298,6 +308,8 @@
 //Compile time flag
 #define UART_EASY_DMA_SUPPORT     1
 #define UART_LEGACY_SUPPORT       1
+//Compile time flag, requires UART_EASY_DMA_SUPPORT and the timer and PPI drivers
+#define UART_RX_STREAM_SUPPORT    0
 #endif //NRF52
 #endif
 
@@ -381,6 +393,8 @@
 
 #if (ADC_ENABLED == 1)
 #define ADC_CONFIG_IRQ_PRIORITY APP_IRQ_PRIORITY_LOW
+//Compile time flag, requires the timer and PPI drivers
+#define ADC_CONTINUOUS_SUPPORT  0
 #endif
 
 
@@ -391,6 +405,8 @@
 #define SAADC_CONFIG_RESOLUTION      NRF_SAADC_RESOLUTION_10BIT
 #define SAADC_CONFIG_OVERSAMPLE      NRF_SAADC_OVERSAMPLE_DISABLED
 #define SAADC_CONFIG_IRQ_PRIORITY    APP_IRQ_PRIORITY_LOW
+//Compile time flag, requires the timer and PPI drivers
+#define SAADC_CONTINUOUS_SUPPORT     0
 #endif
 
 /* PDM */
@@ -457,6 +473,9 @@
 #define I2S_CONFIG_CHANNELS     NRF_I2S_CHANNELS_STEREO
 #define I2S_CONFIG_MCK_SETUP    NRF_I2S_MCK_32MDIV8
 #define I2S_CONFIG_RATIO        NRF_I2S_RATIO_256X
+//Compile time flag, enables the buffer queue mode
+#define I2S_QUEUE_SUPPORT       0
+#define I2S_CONFIG_QUEUE_SIZE   4
 #endif
 
 #include "nrf_drv_config_validation.h"
@@ -459,6 +459,8 @@ uint32_t nrf_drv_gpiote_in_event_addr_get(nrf_drv_gpiote_pin_t pin)
 
 void GPIOTE_IRQHandler(void)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(GPIOTE_IRQn);
+
     uint32_t status = 0;
     uint32_t input = 0;
 
@@ -576,5 +578,7 @@ void GPIOTE_IRQHandler(void)
         }
         while (repeat);
     }
+
+    NRF_DRV_IRQ_MONITOR_EXIT(GPIOTE_IRQn);
 }
 //lint -restore
@@ -21,6 +21,23 @@
     #error "I2S not enabled in driver configuration file."
 #endif
 
+#if (I2S_QUEUE_SUPPORT == 1)
+#ifndef I2S_CONFIG_QUEUE_SIZE
+    #define I2S_CONFIG_QUEUE_SIZE 4
+#endif
+
+// Queue of buffers for one direction of the transfer.
+typedef struct
+{
+    uint32_t * p_buffers[I2S_CONFIG_QUEUE_SIZE];
+    uint8_t    read_idx;
+    uint8_t    count;
+    uint32_t * p_current; // Buffer in use by the peripheral.
+    uint32_t * p_next;    // Buffer to be used after the next pointer update.
+    uint32_t   underruns;
+} i2s_queue_t;
+#endif
+
 // Control block - driver instance local data.
 typedef struct
 {
@@ -34,6 +51,12 @@ typedef struct
     uint16_t   buffer_half_size;
     uint32_t * p_rx_buffer;
     uint32_t * p_tx_buffer;
+#if (I2S_QUEUE_SUPPORT == 1)
+    bool        queue_mode;
+    uint16_t    buffer_size;
+    i2s_queue_t rx_queue;
+    i2s_queue_t tx_queue;
+#endif
 } i2s_control_block_t;
 static i2s_control_block_t m_cb;
 
@@ -238,15 +261,211 @@ void nrf_drv_i2s_stop(void)
 
     nrf_i2s_disable(NRF_I2S);
 
+#if (I2S_QUEUE_SUPPORT == 1)
+    // All buffers are given back to the application.
+    m_cb.queue_mode = false;
+    memset(&m_cb.rx_queue, 0, sizeof(m_cb.rx_queue));
+    memset(&m_cb.tx_queue, 0, sizeof(m_cb.tx_queue));
+#endif
+
     m_cb.state = NRF_DRV_STATE_INITIALIZED;
 }
 
 
+#if (I2S_QUEUE_SUPPORT == 1)
+static ret_code_t buffer_queue(i2s_queue_t * p_queue, uint32_t * p_buffer)
+{
+    ASSERT(p_buffer != NULL);
+
+    if (!nrf_drv_is_in_RAM(p_buffer))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+
+    if ((m_cb.state == NRF_DRV_STATE_UNINITIALIZED) ||
+        // [buffers cannot be added to a direction that is not enabled]
+        ((m_cb.state == NRF_DRV_STATE_POWERED_ON) &&
+         (!m_cb.queue_mode || (p_queue->p_next == NULL))))
+    {
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else if (p_queue->count >= I2S_CONFIG_QUEUE_SIZE)
+    {
+        err_code = NRF_ERROR_NO_MEM;
+    }
+    else
+    {
+        uint8_t idx = (p_queue->read_idx + p_queue->count) %
+                      I2S_CONFIG_QUEUE_SIZE;
+        p_queue->p_buffers[idx] = p_buffer;
+        ++p_queue->count;
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+
+static uint32_t * buffer_dequeue(i2s_queue_t * p_queue)
+{
+    uint32_t * p_buffer = NULL;
+
+    if (p_queue->count > 0)
+    {
+        p_buffer = p_queue->p_buffers[p_queue->read_idx];
+        p_queue->read_idx = (p_queue->read_idx + 1) % I2S_CONFIG_QUEUE_SIZE;
+        --p_queue->count;
+    }
+
+    return p_buffer;
+}
+
+
+// Called on the pointer update event. Returns the buffer that has been
+// completed (or NULL if there is none) and sets up the one to be used next.
+static uint32_t * queue_advance(i2s_queue_t * p_queue)
+{
+    uint32_t * p_completed = NULL;
+
+    // If the buffer in use was set up again because of an underrun, it is
+    // not completed yet - the peripheral is just starting to use it again.
+    if (p_queue->p_current != p_queue->p_next)
+    {
+        p_completed = p_queue->p_current;
+    }
+    p_queue->p_current = p_queue->p_next;
+
+    p_queue->p_next = buffer_dequeue(p_queue);
+    if (p_queue->p_next == NULL)
+    {
+        p_queue->p_next = p_queue->p_current;
+        ++p_queue->underruns;
+    }
+
+    return p_completed;
+}
+
+
+ret_code_t nrf_drv_i2s_rx_buffer_queue(uint32_t * p_buffer)
+{
+    return buffer_queue(&m_cb.rx_queue, p_buffer);
+}
+
+
+ret_code_t nrf_drv_i2s_tx_buffer_queue(uint32_t * p_buffer)
+{
+    return buffer_queue(&m_cb.tx_queue, p_buffer);
+}
+
+
+ret_code_t nrf_drv_i2s_queue_start(uint16_t buffer_size)
+{
+    ASSERT(buffer_size != 0);
+
+    VERIFY_MODULE_INITIALIZED();
+
+    if ((m_cb.rx_queue.count == 0) && (m_cb.tx_queue.count == 0))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_cb.rx_queue.p_current = NULL;
+    m_cb.rx_queue.p_next    = buffer_dequeue(&m_cb.rx_queue);
+    m_cb.rx_queue.underruns = 0;
+    m_cb.tx_queue.p_current = NULL;
+    m_cb.tx_queue.p_next    = buffer_dequeue(&m_cb.tx_queue);
+    m_cb.tx_queue.underruns = 0;
+
+    // The first pointer update events occur right after the transfer is
+    // started, when the peripheral takes the buffers set up here.
+    nrf_i2s_transfer_set(NRF_I2S, buffer_size,
+        m_cb.rx_queue.p_next, m_cb.tx_queue.p_next);
+
+    m_cb.buffer_size = buffer_size;
+    m_cb.queue_mode  = true;
+
+    nrf_i2s_enable(NRF_I2S);
+
+    m_cb.state = NRF_DRV_STATE_POWERED_ON;
+
+    nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_RXPTRUPD);
+    nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD);
+    nrf_i2s_int_enable(NRF_I2S,
+        NRF_I2S_INT_RXPTRUPD_MASK | NRF_I2S_INT_TXPTRUPD_MASK);
+    nrf_i2s_task_trigger(NRF_I2S, NRF_I2S_TASK_START);
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_i2s_underrun_count_get(uint32_t * p_rx_underruns,
+                                    uint32_t * p_tx_underruns)
+{
+    if (p_rx_underruns != NULL)
+    {
+        *p_rx_underruns = m_cb.rx_queue.underruns;
+    }
+    if (p_tx_underruns != NULL)
+    {
+        *p_tx_underruns = m_cb.tx_queue.underruns;
+    }
+}
+
+
+static void queue_irq_handler(void)
+{
+    uint32_t * p_data_received = NULL;
+    uint32_t * p_data_sent     = NULL;
+
+    if (nrf_i2s_event_check(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD))
+    {
+        nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD);
+
+        // [the 'p_next' pointer is never NULL for an enabled direction]
+        if (m_cb.tx_queue.p_next != NULL)
+        {
+            p_data_sent = queue_advance(&m_cb.tx_queue);
+            nrf_i2s_tx_buffer_set(NRF_I2S, m_cb.tx_queue.p_next);
+        }
+    }
+
+    if (nrf_i2s_event_check(NRF_I2S, NRF_I2S_EVENT_RXPTRUPD))
+    {
+        nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_RXPTRUPD);
+
+        if (m_cb.rx_queue.p_next != NULL)
+        {
+            p_data_received = queue_advance(&m_cb.rx_queue);
+            nrf_i2s_rx_buffer_set(NRF_I2S, m_cb.rx_queue.p_next);
+        }
+    }
+
+    if ((p_data_received != NULL) || (p_data_sent != NULL))
+    {
+        m_cb.handler(p_data_received, p_data_sent, m_cb.buffer_size);
+    }
+}
+#endif // (I2S_QUEUE_SUPPORT == 1)
+
+
 void I2S_IRQHandler(void)
 {
     uint32_t * p_data_received = NULL;
     uint32_t * p_data_to_send  = NULL;
 
+#if (I2S_QUEUE_SUPPORT == 1)
+    if (m_cb.queue_mode)
+    {
+        queue_irq_handler();
+        return;
+    }
+#endif
+
     if (nrf_i2s_event_check(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD))
     {
         nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD);
@@ -125,6 +125,13 @@ typedef struct
  *                             (in 32-bit words). This value is always equal to
  *                             half the size of the buffers set by the call
  *                             to the @ref nrf_drv_i2s_start function.
+ *
+ * @note In the queue mode (see @ref nrf_drv_i2s_queue_start), the handler is
+ *       called when a queued buffer is completed: @p p_data_received points
+ *       to a filled RX buffer and @p p_data_to_send points to a TX buffer that
+ *       has been sent and is returned to the application. In this mode,
+ *       @p number_of_words is equal to the buffer size passed to
+ *       @ref nrf_drv_i2s_queue_start.
  */
 typedef void (* nrf_drv_i2s_data_handler_t)(uint32_t const * p_data_received,
                                             uint32_t       * p_data_to_send,
@@ -211,9 +218,82 @@ ret_code_t nrf_drv_i2s_start(uint32_t * p_rx_buffer,
 
 /**
  * @brief Function for stopping the I2S transfer.
+ *
+ * @note In the queue mode, all buffers that are still queued or in use by
+ *       the peripheral are returned to the application without a call to
+ *       the data handler.
  */
 void       nrf_drv_i2s_stop(void);
 
+#if (I2S_QUEUE_SUPPORT == 1)
+/**
+ * @brief Function for adding a buffer to the receive queue.
+ *
+ * Buffers can be queued before the transfer is started with
+ * @ref nrf_drv_i2s_queue_start and while it is running. The driver sets up
+ * the peripheral to use the next queued buffer on its own, so the data handler
+ * does not have to respond within a single buffer period.
+ *
+ * @param[in] p_buffer Pointer to the buffer. Its size is defined by the call
+ *                     to @ref nrf_drv_i2s_queue_start.
+ *
+ * @retval NRF_SUCCESS             If the buffer was queued.
+ * @retval NRF_ERROR_INVALID_STATE If the driver has not been initialized or
+ *                                 the transfer was started without reception.
+ * @retval NRF_ERROR_INVALID_ADDR  If the buffer is not placed in the Data RAM
+ *                                 region.
+ * @retval NRF_ERROR_NO_MEM        If the queue is full.
+ */
+ret_code_t nrf_drv_i2s_rx_buffer_queue(uint32_t * p_buffer);
+
+/**
+ * @brief Function for adding a buffer with data to be sent to the transmit
+ *        queue.
+ *
+ * @param[in] p_buffer Pointer to the buffer. Its size is defined by the call
+ *                     to @ref nrf_drv_i2s_queue_start.
+ *
+ * @retval NRF_SUCCESS             If the buffer was queued.
+ * @retval NRF_ERROR_INVALID_STATE If the driver has not been initialized or
+ *                                 the transfer was started without
+ *                                 transmission.
+ * @retval NRF_ERROR_INVALID_ADDR  If the buffer is not placed in the Data RAM
+ *                                 region.
+ * @retval NRF_ERROR_NO_MEM        If the queue is full.
+ */
+ret_code_t nrf_drv_i2s_tx_buffer_queue(uint32_t * p_buffer);
+
+/**
+ * @brief Function for starting the continuous I2S transfer in the queue mode.
+ *
+ * The directions of the transfer are selected by the queues that are not
+ * empty when this function is called. Every time the peripheral switches to
+ * the next buffer, the previous one is passed to the data handler. If
+ * the queue of a given direction is empty at that moment, the buffer currently
+ * in use is set up again (received data is overwritten or sent data is
+ * repeated) and an underrun is counted. At least two buffers should be queued
+ * for each enabled direction to avoid an underrun at start.
+ *
+ * @param[in] buffer_size Size of each queued buffer (in 32-bit words).
+ *
+ * @retval NRF_SUCCESS             If the operation was successful.
+ * @retval NRF_ERROR_INVALID_STATE If a transfer was already started, the driver
+ *                                 has not been initialized, or no buffers
+ *                                 were queued.
+ */
+ret_code_t nrf_drv_i2s_queue_start(uint16_t buffer_size);
+
+/**
+ * @brief Function for getting the number of underruns since the transfer
+ *        in the queue mode was started.
+ *
+ * @param[out] p_rx_underruns Number of receive underruns. Can be NULL.
+ * @param[out] p_tx_underruns Number of transmit underruns. Can be NULL.
+ */
+void       nrf_drv_i2s_underrun_count_get(uint32_t * p_rx_underruns,
+                                          uint32_t * p_tx_underruns);
+#endif // (I2S_QUEUE_SUPPORT == 1)
+
 #endif // NRF_DRV_I2S_H__
 
 /** @} */
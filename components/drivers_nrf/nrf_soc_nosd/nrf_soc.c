@@ -13,9 +13,12 @@
 #include <stdlib.h>
 #include "nrf_soc.h"
 #include "nrf_error.h"
+#include "nrf_drv_common.h"
 
 uint32_t sd_app_evt_wait(void)
 {
+    NRF_DRV_IRQ_MONITOR_IDLE_BEGIN();
     __WFE();
+    NRF_DRV_IRQ_MONITOR_IDLE_END();
     return NRF_SUCCESS;
 }
@@ -33,6 +33,8 @@ typedef struct
     nrf_drv_pdm_event_handler_t event_handler;    ///< Event handler function pointer.
     uint16_t                    buffer_length;    ///< Length of a single buffer in 16-bit words.
     uint32_t *                  buffers[2];       ///< Sample buffers.
+    uint32_t *                  p_active_buffer;  ///< Buffer being filled.
+    nrf_drv_pdm_buffer_request_handler_t buffer_request_handler; ///< Buffer request handler function pointer.
 } nrf_drv_pdm_cb_t;
 
 static nrf_drv_pdm_cb_t m_cb;
@@ -45,29 +47,33 @@ void PDM_IRQHandler(void)
         nrf_pdm_event_clear(NRF_PDM_EVENT_END);
         
         //Buffer is ready to process.
-        if (nrf_pdm_buffer_get() == m_cb.buffers[0])
-        {
-            m_cb.event_handler(m_cb.buffers[1], m_cb.buffer_length);
-        }
-        else
-        {
-            m_cb.event_handler(m_cb.buffers[0], m_cb.buffer_length);
-        }
+        m_cb.event_handler(m_cb.p_active_buffer, m_cb.buffer_length);
     }
     else if (nrf_pdm_event_check(NRF_PDM_EVENT_STARTED))
     {
         nrf_pdm_event_clear(NRF_PDM_EVENT_STARTED);
         m_cb.status = NRF_PDM_STATE_RUNNING;
         
-        //Swap buffer.
-        if (nrf_pdm_buffer_get() == m_cb.buffers[0])
+        //The buffer address has been latched, set up the next buffer.
+        uint32_t * p_next_buffer;
+        m_cb.p_active_buffer = nrf_pdm_buffer_get();
+        if (m_cb.buffer_request_handler)
+        {
+            p_next_buffer = (uint32_t *)m_cb.buffer_request_handler();
+            if (p_next_buffer == NULL)
+            {
+                p_next_buffer = m_cb.p_active_buffer;
+            }
+        }
+        else if (m_cb.p_active_buffer == m_cb.buffers[0])
         {
-            nrf_pdm_buffer_set(m_cb.buffers[1],m_cb.buffer_length);
+            p_next_buffer = m_cb.buffers[1];
         }
         else
         {
-            nrf_pdm_buffer_set(m_cb.buffers[0],m_cb.buffer_length);
+            p_next_buffer = m_cb.buffers[0];
         }
+        nrf_pdm_buffer_set(p_next_buffer,m_cb.buffer_length);
     }
     else if (nrf_pdm_event_check(NRF_PDM_EVENT_STOPPED))
     {
@@ -101,6 +107,7 @@ ret_code_t nrf_drv_pdm_init(nrf_drv_pdm_config_t const * p_config,
     m_cb.buffers[1] = (uint32_t*)p_config->buffer_b;
     m_cb.buffer_length = p_config->buffer_length;
     m_cb.event_handler = event_handler;
+    m_cb.buffer_request_handler = NULL;
     m_cb.status = NRF_PDM_STATE_IDLE;
     
     nrf_pdm_buffer_set(m_cb.buffers[0],m_cb.buffer_length);
@@ -144,6 +151,7 @@ ret_code_t nrf_drv_pdm_start(void)
     }
     m_cb.status = NRF_PDM_STATE_TRANSITION;
     m_cb.drv_state = NRF_DRV_STATE_POWERED_ON;
+    nrf_pdm_buffer_set(m_cb.buffers[0],m_cb.buffer_length);
     nrf_pdm_enable();
     nrf_pdm_event_clear(NRF_PDM_EVENT_STARTED);
     nrf_pdm_task_trigger(NRF_PDM_TASK_START);
@@ -168,3 +176,10 @@ ret_code_t nrf_drv_pdm_stop(void)
     nrf_pdm_task_trigger(NRF_PDM_TASK_STOP);
     return NRF_SUCCESS;
 }
+
+
+void nrf_drv_pdm_buffer_request_handler_set(nrf_drv_pdm_buffer_request_handler_t handler)
+{
+    ASSERT(m_cb.drv_state != NRF_DRV_STATE_UNINITIALIZED);
+    m_cb.buffer_request_handler = handler;
+}
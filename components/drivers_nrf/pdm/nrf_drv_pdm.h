@@ -93,6 +93,18 @@ typedef struct
 typedef void (*nrf_drv_pdm_event_handler_t)(uint32_t * buffer, uint16_t length);
 
 
+/**
+ * @brief   Handler for PDM interface buffer requests.
+ *
+ * This handler is called when the PDM interface has started filling a buffer, to get
+ * the buffer that should be filled next.
+ *
+ * @return Pointer to the next buffer (of the length given in the configuration), or NULL
+ *         if no buffer is available. In such case, the current buffer is filled again.
+ */
+typedef int16_t * (*nrf_drv_pdm_buffer_request_handler_t)(void);
+
+
 /**
  * @brief Function for initializing the PDM interface.
  *
@@ -162,6 +174,19 @@ ret_code_t nrf_drv_pdm_start(void);
 ret_code_t nrf_drv_pdm_stop(void);
 
 
+/**
+ * @brief   Function for setting the buffer request handler.
+ *
+ * By default, the driver fills buffer A and buffer B alternately. When the request handler
+ * is set, buffer A is filled first and the following buffers are obtained from the handler,
+ * so that any number of buffers can be used. The handler should be set when sampling is
+ * stopped.
+ *
+ * @param[in] handler Buffer request handler, or NULL to use buffer A and buffer B.
+ */
+void nrf_drv_pdm_buffer_request_handler_set(nrf_drv_pdm_buffer_request_handler_t handler);
+
+
 #endif // NRF_DRV_PDM_H__
 
 /** @} */
@@ -405,6 +405,123 @@ uint32_t nrf_drv_ppi_channels_remove_from_group(uint32_t channel_mask,
     return NRF_SUCCESS;
 }
 
+/**@brief  Resolve a task address of a chain connection.
+ * @param[in]  tep      Task address or @ref NRF_DRV_PPI_CHAIN_SELF_DISABLE.
+ * @param[in]  group    Group of the chain.
+ * @retval     Task address.
+ */
+__STATIC_INLINE uint32_t chain_tep_get(uint32_t tep, nrf_ppi_channel_group_t group)
+{
+    if (tep == NRF_DRV_PPI_CHAIN_SELF_DISABLE)
+    {
+        return nrf_drv_ppi_task_addr_group_disable_get(group);
+    }
+    return tep;
+}
+
+
+uint32_t nrf_drv_ppi_chain_alloc(nrf_drv_ppi_chain_t *      p_chain,
+                                 nrf_drv_ppi_link_t const * p_links,
+                                 uint8_t                    link_count)
+{
+    uint32_t err_code = NRF_ERROR_NO_MEM;
+    uint32_t channel_mask = 0;
+    uint32_t free_mask;
+    nrf_ppi_channel_t channel;
+    nrf_ppi_channel_group_t group;
+    uint8_t i;
+
+    if ((link_count == 0) || (link_count > NRF_DRV_PPI_CHAIN_MAX_LINKS))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    for (i = 0; i < link_count; i++)
+    {
+        VERIFY_PARAM_NOT_NULL((uint32_t *)p_links[i].eep);
+        VERIFY_PARAM_NOT_NULL((uint32_t *)p_links[i].tep);
+#ifdef NRF51
+        if (p_links[i].fork_tep != 0)
+        {
+            return NRF_ERROR_NOT_SUPPORTED;
+        }
+#endif
+    }
+
+    // All the resources are reserved in one step, so that a chain is either
+    // allocated completely or not at all.
+    CRITICAL_REGION_ENTER();
+    free_mask = NRF_PPI_ALL_APP_GROUPS_MASK & ~m_groups_allocated;
+    for (group = NRF_PPI_CHANNEL_GROUP0; free_mask != 0; group++)
+    {
+        if (free_mask & group_to_mask(group))
+        {
+            break;
+        }
+    }
+    if (free_mask != 0)
+    {
+        i         = 0;
+        free_mask = NRF_PPI_PROG_APP_CHANNELS_MASK & ~m_channels_allocated;
+        for (channel = NRF_PPI_CHANNEL0; (free_mask != 0) && (i < link_count); channel++)
+        {
+            if (free_mask & nrf_drv_ppi_channel_to_mask(channel))
+            {
+                free_mask &= ~nrf_drv_ppi_channel_to_mask(channel);
+                channel_mask |= nrf_drv_ppi_channel_to_mask(channel);
+                p_chain->channels[i++] = channel;
+            }
+        }
+        if (i == link_count)
+        {
+            m_channels_allocated |= channel_mask;
+            group_allocated_set(group);
+            err_code = NRF_SUCCESS;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+    VERIFY_SUCCESS(err_code);
+
+    p_chain->link_count = link_count;
+    p_chain->group      = group;
+
+    for (i = 0; i < link_count; i++)
+    {
+        nrf_ppi_channel_endpoint_setup(p_chain->channels[i], p_links[i].eep,
+                                       chain_tep_get(p_links[i].tep, group));
+#ifdef NRF52
+        nrf_ppi_fork_endpoint_setup(p_chain->channels[i],
+            (p_links[i].fork_tep != 0) ? chain_tep_get(p_links[i].fork_tep, group) : 0);
+#endif
+    }
+
+    nrf_ppi_group_disable(group);
+    CRITICAL_REGION_ENTER();
+    nrf_ppi_channel_group_clear(group);
+    nrf_ppi_channels_include_in_group(channel_mask, group);
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_ppi_chain_free(nrf_drv_ppi_chain_t * p_chain)
+{
+    uint8_t i;
+
+    nrf_ppi_group_disable(p_chain->group);
+    for (i = 0; i < p_chain->link_count; i++)
+    {
+        (void)nrf_drv_ppi_channel_free(p_chain->channels[i]);
+    }
+    CRITICAL_REGION_ENTER();
+    nrf_ppi_channel_group_clear(p_chain->group);
+    group_allocated_clr(p_chain->group);
+    CRITICAL_REGION_EXIT();
+
+    p_chain->link_count = 0;
+}
+
+
 uint32_t nrf_drv_ppi_channels_include_in_group(uint32_t channel_mask,
                                                nrf_ppi_channel_group_t group)
 {
@@ -51,6 +51,39 @@
 
 #endif
 
+/**@brief Macro for checking if a fixed PPI channel can be programmed by the application.
+ *
+ * @details The result is a constant expression, so it can be used in STATIC_ASSERT
+ *          to detect a collision with the channels reserved by the SoftDevice
+ *          at compile time.
+ */
+#define NRF_DRV_PPI_CHANNEL_IS_APP(channel) \
+    ((NRF_PPI_PROG_APP_CHANNELS_MASK & (1uL << (uint32_t)(channel))) != 0)
+
+#ifndef NRF_DRV_PPI_CHAIN_MAX_LINKS
+#define NRF_DRV_PPI_CHAIN_MAX_LINKS 4 /**< Maximum number of connections in a chain. */
+#endif
+
+#define NRF_DRV_PPI_CHAIN_SELF_DISABLE 1uL /**< Task address placeholder referring to the task that disables the chain which the connection belongs to. */
+
+/**@brief Connection of an event to a task and an optional fork task. */
+typedef struct
+{
+    uint32_t eep;      /**< Event end point address. */
+    uint32_t tep;      /**< Task end point address, or @ref NRF_DRV_PPI_CHAIN_SELF_DISABLE. */
+    uint32_t fork_tep; /**< Fork task end point address, @ref NRF_DRV_PPI_CHAIN_SELF_DISABLE, or 0 if not used. */
+} nrf_drv_ppi_link_t;
+
+/**@brief Chain of connections that are enabled and disabled together.
+ *
+ * @details The content is internal to the driver. */
+typedef struct
+{
+    nrf_ppi_channel_t       channels[NRF_DRV_PPI_CHAIN_MAX_LINKS]; /**< Channels allocated for the connections. */
+    uint8_t                 link_count;                            /**< Number of connections. */
+    nrf_ppi_channel_group_t group;                                 /**< Group containing all the channels. */
+} nrf_drv_ppi_chain_t;
+
 
 /**@brief Function for initializing PPI module.
  *
@@ -276,6 +309,78 @@ __STATIC_INLINE uint32_t nrf_drv_ppi_task_addr_group_disable_get(nrf_ppi_channel
     return (uint32_t) nrf_ppi_task_group_disable_address_get(group);
 }
 
+/**@brief Function for allocating and setting up a chain of connections.
+ *
+ * @details The channels and the group are allocated at once: if any of them
+ *          is not available, nothing is allocated. The chain is created
+ *          disabled.
+ *
+ * @param[out] p_chain                 Pointer to the chain.
+ * @param[in]  p_links                 Array of connections.
+ * @param[in]  link_count              Number of connections (at most @ref NRF_DRV_PPI_CHAIN_MAX_LINKS).
+ *
+ * @retval     NRF_SUCCESS             If the chain was successfully allocated.
+ * @retval     NRF_ERROR_INVALID_PARAM If a connection has no event or task, or there are too many connections.
+ * @retval     NRF_ERROR_NOT_SUPPORTED If a fork is requested but not supported by the chip.
+ * @retval     NRF_ERROR_NO_MEM        If there are not enough available channels or no available group.
+ */
+uint32_t nrf_drv_ppi_chain_alloc(nrf_drv_ppi_chain_t *      p_chain,
+                                 nrf_drv_ppi_link_t const * p_links,
+                                 uint8_t                    link_count);
+
+/**@brief Function for freeing a chain of connections.
+ * @details The chain is disabled and its channels and group are freed.
+ *
+ * @param[in]  p_chain                 Pointer to the chain.
+ */
+void nrf_drv_ppi_chain_free(nrf_drv_ppi_chain_t * p_chain);
+
+/**@brief Function for enabling all the channels of a chain at once.
+ *
+ * @param[in]  p_chain                 Pointer to the chain.
+ */
+__STATIC_INLINE void nrf_drv_ppi_chain_enable(nrf_drv_ppi_chain_t const * p_chain)
+{
+    (void)nrf_drv_ppi_group_enable(p_chain->group);
+}
+
+/**@brief Function for disabling all the channels of a chain at once.
+ *
+ * @param[in]  p_chain                 Pointer to the chain.
+ */
+__STATIC_INLINE void nrf_drv_ppi_chain_disable(nrf_drv_ppi_chain_t const * p_chain)
+{
+    (void)nrf_drv_ppi_group_disable(p_chain->group);
+}
+
+/**@brief Function for getting the address of the task that enables a chain.
+ *
+ * @details The task can be connected to another chain, so that the chain is
+ *          enabled by hardware.
+ *
+ * @param[in]  p_chain                 Pointer to the chain.
+ *
+ * @retval     Task address.
+ */
+__STATIC_INLINE uint32_t nrf_drv_ppi_chain_enable_task_addr_get(nrf_drv_ppi_chain_t const * p_chain)
+{
+    return nrf_drv_ppi_task_addr_group_enable_get(p_chain->group);
+}
+
+/**@brief Function for getting the address of the task that disables a chain.
+ *
+ * @details To make a chain disable itself, use @ref NRF_DRV_PPI_CHAIN_SELF_DISABLE
+ *          in its connections instead.
+ *
+ * @param[in]  p_chain                 Pointer to the chain.
+ *
+ * @retval     Task address.
+ */
+__STATIC_INLINE uint32_t nrf_drv_ppi_chain_disable_task_addr_get(nrf_drv_ppi_chain_t const * p_chain)
+{
+    return nrf_drv_ppi_task_addr_group_disable_get(p_chain->group);
+}
+
 /**
  *@}
  **/
@@ -51,6 +51,43 @@ static __INLINE uint32_t pstorage_flash_page_end()
 #define PSTORAGE_MAX_BLOCK_SIZE     PSTORAGE_FLASH_PAGE_SIZE                                    /**< Maximum size of block that can be registered with the module. Should be configured based on system requirements. And should be greater than or equal to the minimum size. */
 #define PSTORAGE_CMD_QUEUE_SIZE     10                                                          /**< Maximum number of flash access commands that can be maintained by the module for all applications. Configurable. */
 
+/* Asynchronous flash access of the implementation without a SoftDevice (pstorage_nosd.c).
+ * Flash operations are queued and run in small steps from a software interrupt, so that
+ * higher priority interrupts, for example of a Gazell or ESB radio protocol, only wait for one
+ * step. Results are notified from the software interrupt. When disabled, flash operations
+ * complete before the API functions return. */
+#ifndef PSTORAGE_NOSD_ASYNC_ENABLED
+#define PSTORAGE_NOSD_ASYNC_ENABLED         0
+#endif
+
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+#ifndef PSTORAGE_NOSD_SWI_IRQn
+#ifdef NRF51
+#define PSTORAGE_NOSD_SWI_IRQn              SWI5_IRQn                                           /**< Software interrupt running the flash operation steps. */
+#define PSTORAGE_NOSD_SWI_IRQHandler        SWI5_IRQHandler                                     /**< Handler of the software interrupt running the flash operation steps. */
+#else
+#define PSTORAGE_NOSD_SWI_IRQn              SWI5_EGU5_IRQn                                      /**< Software interrupt running the flash operation steps. */
+#define PSTORAGE_NOSD_SWI_IRQHandler        SWI5_EGU5_IRQHandler                                /**< Handler of the software interrupt running the flash operation steps. */
+#endif
+#endif
+
+#ifndef PSTORAGE_NOSD_IRQ_PRIORITY
+#define PSTORAGE_NOSD_IRQ_PRIORITY          APP_IRQ_PRIORITY_LOWEST                             /**< Priority of the software interrupt. */
+#endif
+
+#ifndef PSTORAGE_NOSD_WRITE_WORDS_PER_STEP
+#define PSTORAGE_NOSD_WRITE_WORDS_PER_STEP  16                                                  /**< Number of words written in one step. */
+#endif
+
+#ifndef PSTORAGE_NOSD_PARTIAL_ERASE_MS
+#define PSTORAGE_NOSD_PARTIAL_ERASE_MS      10                                                  /**< Duration of one partial erase step, on devices that support partial erase. */
+#endif
+
+#ifndef PSTORAGE_NOSD_PAGE_ERASE_MS
+#define PSTORAGE_NOSD_PAGE_ERASE_MS         85                                                  /**< Total partial erase time needed to erase a page. */
+#endif
+#endif // PSTORAGE_NOSD_ASYNC_ENABLED
+
 
 /** Abstracts persistently memory block identifier. */
 typedef uint32_t pstorage_block_t;
@@ -23,6 +23,7 @@
 #include "app_error.h"
 
 #define INVALID_OPCODE             0x00                                /**< Invalid op code identifier. */
+#define UPDATE_BATCH_OP_CODE       0x05                                /**< Batched update op code identifier. Notified to the application as @ref PSTORAGE_UPDATE_OP_CODE. */
 #define SOC_MAX_WRITE_SIZE         PSTORAGE_FLASH_PAGE_SIZE            /**< Maximum write size allowed for a single call to \ref sd_flash_write as specified in the SoC API. */
 #define RAW_MODE_APP_ID            (PSTORAGE_NUM_OF_PAGES + 1)         /**< Application id for raw mode. */
 
@@ -146,6 +147,7 @@ typedef enum
     STATE_STORE,                                                       /**< State for storing data when using store/update API. */
     STATE_DATA_ERASE_WITH_SWAP,                                        /**< State for erasing the data page when using update/clear API when use of swap page is required. */
     STATE_DATA_ERASE,                                                  /**< State for erasing the data page when using update/clear API without the need to use the swap page. */
+    STATE_UPDATE_BATCH,                                                /**< State for applying several updates to a data page when using the batched update API. */
     STATE_ERROR                                                        /**< State entered when command processing is terminated abnormally. */
 } pstorage_state_t;  
 
@@ -160,6 +162,16 @@ typedef enum
     SWAP_SUB_STATE_MAX                                                 /**< Enumeration upper bound. */   
 } flash_swap_sub_state_t;
 
+/**@brief Sub state machine contained by @ref STATE_UPDATE_BATCH super state machine. */
+typedef enum
+{
+    STATE_BATCH_ERASE_SWAP,                                            /**< State for erasing the swap page. */
+    STATE_BATCH_WRITE_SWAP,                                            /**< State for writing the data page, with the updates applied, into the swap page one area at a time. */
+    STATE_BATCH_ERASE_DATA_PAGE,                                       /**< State for erasing the data page. */
+    STATE_BATCH_RESTORE,                                               /**< State for writing the swap page back to the data page. */
+    BATCH_SUB_STATE_MAX                                                /**< Enumeration upper bound. */
+} batch_sub_state_t;
+
 /**@brief Application registration information.
  *
  * @details Defines application specific information that the application needs to maintain to be able 
@@ -229,6 +241,9 @@ static pstorage_module_table_t m_app_table[PSTORAGE_NUM_OF_PAGES];     /**< Regi
 static uint32_t                m_num_of_bytes_written;                 /**< Variable for tracking the number of bytes written by the store operation. */
 static uint32_t                m_app_data_size;                        /**< Variable for storing the application command size parameter internally. */
 static uint32_t                m_flags = 0;                            /**< Storage for boolean flags for state tracking. */
+static batch_sub_state_t       m_batch_sub_state;                      /**< Batched update state tracking variable. */
+static uint32_t                m_batch_page_offset;                    /**< Offset within the data page up to which the swap page has been written by the batched update. */
+static uint32_t                m_batch_index;                          /**< Index of the next update to be written to the swap page by the batched update. */
 
 #ifdef PSTORAGE_RAW_MODE_ENABLE
 static pstorage_raw_module_table_t m_raw_app_table;                    /**< Registered application information table for raw mode. */
@@ -242,6 +257,7 @@ static void cmd_queue_element_init(uint32_t index);
 static void cmd_queue_dequeue(void);
 static void sm_state_change(pstorage_state_t new_state);
 static void swap_sub_state_state_change(flash_swap_sub_state_t new_state); 
+static void state_update_batch_entry_run(void);
 
 /**@brief Function for consuming a command queue element.
  *
@@ -469,6 +485,10 @@ static void state_entry_action_run(void)
         case STATE_DATA_ERASE:
             state_data_erase_entry_run();        
             break;
+
+        case STATE_UPDATE_BATCH:
+            state_update_batch_entry_run();
+            break;
                         
         default:
             // No action needed.
@@ -691,6 +711,27 @@ static void app_notify(uint32_t result, cmd_queue_element_t * p_elem)
     pstorage_ntf_cb_t ntf_cb;
     const uint8_t     op_code = p_elem->op_code;
 
+    if (op_code == UPDATE_BATCH_OP_CODE)
+    {
+        // Notify the application of each of the updates in the batch.
+        const pstorage_update_desc_t * p_updates = (pstorage_update_desc_t *)p_elem->p_data_addr;
+
+        ntf_cb = m_app_table[p_elem->storage_addr.module_id].cb;
+
+        for (uint32_t index = 0; index < p_elem->size; index++)
+        {
+            pstorage_handle_t block_id = p_updates[index].block_id;
+
+            ntf_cb(&block_id, 
+                   PSTORAGE_UPDATE_OP_CODE, 
+                   result, 
+                   p_updates[index].p_src, 
+                   p_updates[index].size);
+        }
+
+        return;
+    }
+
 #ifdef PSTORAGE_RAW_MODE_ENABLE
     if (p_elem->storage_addr.module_id == RAW_MODE_APP_ID)
     {
@@ -1050,6 +1091,174 @@ static void store_sub_state_sm_run(void)
 }
 
 
+/**@brief Function for fetching the updates of the batched update command in progress.
+ *
+ * @return Pointer to the array of updates, which holds as many elements as the command size.
+ */
+static const pstorage_update_desc_t * batch_updates_get(void)
+{
+    return (const pstorage_update_desc_t *)m_cmd_queue.cmd[m_cmd_queue.rp].p_data_addr;
+}
+
+
+/**@brief Function for calculating the address of the data page of the batched update command in 
+ *        progress.
+ */
+static uint32_t batch_page_address_get(void)
+{
+    const pstorage_update_desc_t * p_updates = batch_updates_get();
+    const uint32_t                 address   = p_updates[0].block_id.block_id + p_updates[0].offset;
+
+    return address - (address % PSTORAGE_FLASH_PAGE_SIZE);
+}
+
+
+/**@brief Function for calculating the offset within the data page at which the next update of the 
+ *        batched update command in progress begins.
+ *
+ * @return Offset of the next update, or the flash page size if all updates have been written.
+ */
+static uint32_t batch_next_update_offset_get(void)
+{
+    const cmd_queue_element_t *    p_cmd     = &m_cmd_queue.cmd[m_cmd_queue.rp];
+    const pstorage_update_desc_t * p_updates = batch_updates_get();
+
+    if (m_batch_index < p_cmd->size)
+    {
+        return (p_updates[m_batch_index].block_id.block_id + p_updates[m_batch_index].offset) - 
+               batch_page_address_get();
+    }
+
+    return PSTORAGE_FLASH_PAGE_SIZE;
+}
+
+
+/**@brief Function for write data to the swap state entry action of the batched update.
+ *
+ * @details Writes either the next update, or the data page area up to the next update, to the swap 
+ *          page. The number of bytes written is stored in @ref m_num_of_bytes_written.
+ */
+static void state_batch_write_swap_entry_run(void)
+{
+    const uint32_t update_offset = batch_next_update_offset_get();
+
+    if (m_batch_page_offset == update_offset)
+    {
+        const pstorage_update_desc_t * p_update = &batch_updates_get()[m_batch_index];
+
+        flash_write((uint32_t *)(PSTORAGE_SWAP_ADDR + m_batch_page_offset),
+                    (uint32_t *)p_update->p_src,
+                    p_update->size / sizeof(uint32_t));
+
+        m_num_of_bytes_written = p_update->size;
+    }
+    else
+    {
+        flash_write((uint32_t *)(PSTORAGE_SWAP_ADDR + m_batch_page_offset),
+                    (uint32_t *)(batch_page_address_get() + m_batch_page_offset),
+                    (update_offset - m_batch_page_offset) / sizeof(uint32_t));
+
+        m_num_of_bytes_written = update_offset - m_batch_page_offset;
+    }
+}
+
+
+/**@brief Function for batched update state entry action.
+ *
+ * @details Function for batched update state entry action, which includes issuing the flash 
+ *          operation for the current sub state.
+ */
+static void state_update_batch_entry_run(void)
+{
+    switch (m_batch_sub_state)
+    {
+        case STATE_BATCH_ERASE_SWAP:
+            flash_page_erase(PSTORAGE_SWAP_ADDR / PSTORAGE_FLASH_PAGE_SIZE);
+            break;
+
+        case STATE_BATCH_WRITE_SWAP:
+            state_batch_write_swap_entry_run();
+            break;
+
+        case STATE_BATCH_ERASE_DATA_PAGE:
+            flash_page_erase(batch_page_address_get() / PSTORAGE_FLASH_PAGE_SIZE);
+            break;
+
+        case STATE_BATCH_RESTORE:
+            flash_write((uint32_t *)batch_page_address_get(),
+                        (uint32_t *)PSTORAGE_SWAP_ADDR,
+                        PSTORAGE_FLASH_PAGE_SIZE / sizeof(uint32_t));
+            break;
+
+        default:
+            // No action needed.
+            break;
+    }
+}
+
+
+/**@brief Function for changing the batched update sub state and dispatching state entry action.
+ *
+ * @param[in] new_state New batched update sub state to transit to.
+ */
+static void batch_sub_state_change(batch_sub_state_t new_state)
+{
+    m_batch_sub_state = new_state;
+    state_update_batch_entry_run();
+}
+
+
+/**@brief Function for doing batched update state action upon flash operation success event.
+ */
+static void update_batch_sub_state_sm_run(void)
+{
+    if (m_flags & MASK_FLASH_API_ERR_BUSY)
+    {
+        // As operation request was rejected by the flash API reissue the request.
+        main_state_err_busy_process();
+        return;
+    }
+
+    switch (m_batch_sub_state)
+    {
+        case STATE_BATCH_ERASE_SWAP:
+            batch_sub_state_change(STATE_BATCH_WRITE_SWAP);
+            break;
+
+        case STATE_BATCH_WRITE_SWAP:
+            if (m_batch_page_offset == batch_next_update_offset_get())
+            {
+                // An update has been written to the swap page.
+                ++m_batch_index;
+            }
+
+            m_batch_page_offset += m_num_of_bytes_written;
+
+            if (m_batch_page_offset < PSTORAGE_FLASH_PAGE_SIZE)
+            {
+                batch_sub_state_change(STATE_BATCH_WRITE_SWAP);
+            }
+            else
+            {
+                batch_sub_state_change(STATE_BATCH_ERASE_DATA_PAGE);
+            }
+            break;
+
+        case STATE_BATCH_ERASE_DATA_PAGE:
+            batch_sub_state_change(STATE_BATCH_RESTORE);
+            break;
+
+        case STATE_BATCH_RESTORE:
+            command_end_procedure_run();
+            break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
+
+
 /**@brief Function for doing action upon flash operation success event.
  */
 static void flash_operation_success_run(void)
@@ -1067,6 +1276,10 @@ static void flash_operation_success_run(void)
         case STATE_DATA_ERASE_WITH_SWAP:
             swap_sub_state_sm_run();                        
             break;                        
+
+        case STATE_UPDATE_BATCH:
+            update_batch_sub_state_sm_run();
+            break;
             
         default:
             // No implementation needed.
@@ -1254,6 +1467,22 @@ static void update_operation_execute(void)
 }
 
 
+/**@brief Function for executing the batched update operation.
+ *
+ * @details The data page is written to the swap page with all updates applied, then it is erased 
+ *          and restored from the swap page. This requires only two page erase operations, 
+ *          regardless of the number of updates.
+ */
+static void update_batch_operation_execute(void)
+{
+    m_batch_page_offset = 0;
+    m_batch_index       = 0;
+    m_batch_sub_state   = STATE_BATCH_ERASE_SWAP;
+
+    sm_state_change(STATE_UPDATE_BATCH);
+}
+
+
 /**@brief Function for dispatching the flash access operation.
  */  
 static void cmd_process(void)
@@ -1275,6 +1504,10 @@ static void cmd_process(void)
             update_operation_execute();
             break;
 
+        case UPDATE_BATCH_OP_CODE:
+            update_batch_operation_execute();
+            break;
+
         default:
             // No action required.
             break;
@@ -1422,6 +1655,101 @@ uint32_t pstorage_update(pstorage_handle_t * p_dest,
 }
 
 
+uint32_t pstorage_store_blocks(pstorage_handle_t * p_dest,
+                               uint8_t           * p_src,
+                               pstorage_size_t     block_count)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_src);
+    NULL_PARAM_CHECK(p_dest);
+    MODULE_ID_RANGE_CHECK(p_dest);
+    BLOCK_ID_RANGE_CHECK(p_dest);
+
+    if ((!is_word_aligned(p_src)) || 
+        (!is_word_aligned((uint32_t *)p_dest->block_id)))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    const uint32_t size = (uint32_t)MODULE_BLOCK_SIZE(p_dest) * block_count;
+
+    const pstorage_block_t allocation_end_address = m_app_table[p_dest->module_id].base_id + 
+                                                    (m_app_table[p_dest->module_id].block_size * 
+                                                    m_app_table[p_dest->module_id].block_count);
+
+    // Check that the request neither is empty, overflows the size parameter, nor would lead to a 
+    // buffer overrun.
+    if ((block_count == 0) || 
+        (size > UINT16_MAX) || 
+        ((p_dest->block_id + size) > allocation_end_address))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    return cmd_queue_enqueue(PSTORAGE_STORE_OP_CODE, p_dest, p_src, (pstorage_size_t)size, 0);
+}
+
+
+uint32_t pstorage_update_batch(pstorage_update_desc_t const * p_updates, uint32_t count)
+{
+    uint32_t page_address = 0;
+    uint32_t prev_end     = 0;
+
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_updates);
+
+    if ((count == 0) || (count > UINT16_MAX))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        const pstorage_update_desc_t * p_update = &p_updates[index];
+
+        NULL_PARAM_CHECK(p_update->p_src);
+        MODULE_ID_RANGE_CHECK(&p_update->block_id);
+        BLOCK_ID_RANGE_CHECK(&p_update->block_id);
+        SIZE_CHECK(&p_update->block_id, p_update->size);
+        OFFSET_CHECK(&p_update->block_id, p_update->offset, p_update->size);
+
+        if ((!is_word_aligned(p_update->p_src))                    || 
+            (!is_word_aligned((void *)(uint32_t)p_update->size))   || 
+            (!is_word_aligned((void *)(uint32_t)p_update->offset)) || 
+            (!is_word_aligned((uint32_t *)p_update->block_id.block_id)))
+        {
+            return NRF_ERROR_INVALID_ADDR;
+        }
+
+        const uint32_t start = p_update->block_id.block_id + p_update->offset;
+        const uint32_t end   = start + p_update->size;
+
+        if (index == 0)
+        {
+            page_address = start - (start % PSTORAGE_FLASH_PAGE_SIZE);
+            prev_end     = page_address;
+        }
+
+        // Check that all updates are for the same module, are sorted, do not overlap and are 
+        // located in the same flash page.
+        if ((p_update->block_id.module_id != p_updates[0].block_id.module_id) || 
+            (start < prev_end)                                                || 
+            (end > (page_address + PSTORAGE_FLASH_PAGE_SIZE)))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        prev_end = end;
+    }
+
+    return cmd_queue_enqueue(UPDATE_BATCH_OP_CODE, 
+                             (pstorage_handle_t *)&p_updates[0].block_id, 
+                             (uint8_t *)p_updates, 
+                             (pstorage_size_t)count, 
+                             0);
+}
+
+
 uint32_t pstorage_load(uint8_t           * p_dest,
                        pstorage_handle_t * p_src,
                        pstorage_size_t     size,
@@ -91,6 +91,15 @@ typedef struct
     pstorage_size_t   block_count;    /** Number of blocks requested by the module; minimum values is 1. */
 } pstorage_module_param_t;
 
+/**@brief Struct describing one of the block updates applied by @ref pstorage_update_batch. */
+typedef struct
+{
+    pstorage_handle_t block_id;       /**< Identifier of the block to be updated. */
+    uint8_t *         p_src;          /**< Source address containing data to be stored. Must be word aligned and resident memory. */
+    pstorage_size_t   size;           /**< Size of data to be stored expressed in bytes. Must be word aligned and size + offset must be <= block size. */
+    pstorage_size_t   offset;         /**< Offset in bytes to be applied when writing to the block. Must be word aligned. */
+} pstorage_update_desc_t;
+
 /**@} */
 
 /**@defgroup pstorage_routines Persistent Storage Access Routines
@@ -230,6 +239,59 @@ uint32_t pstorage_update(pstorage_handle_t * p_dest,
                          pstorage_size_t     size,
                          pstorage_size_t     offset);
 
+/**@brief Function for persistently storing data spanning several contiguous blocks.
+ *
+ * @details Equivalent to calling @ref pstorage_store for each of the blocks, but the data is 
+ *          written using a single command. The application is notified once, with the handle of 
+ *          the first block and the total size of the data.
+ *
+ * @param[in]  p_dest      Identifier of the first block to be written.
+ * @param[in]  p_src       Source address containing data to be stored. API assumes this to be 
+ *                         resident memory and no intermediate copy of data is made by the API. 
+ *                         Must be word aligned.
+ * @param[in]  block_count Number of blocks to be written, starting at @p p_dest.
+ *
+ * @retval     NRF_SUCCESS             Operation success. 
+ * @retval     NRF_ERROR_INVALID_STATE Operation failure. API is called without module 
+ *                                     initialization.
+ * @retval     NRF_ERROR_NULL          Operation failure. NULL parameter has been passed.
+ * @retval     NRF_ERROR_INVALID_PARAM Operation failure. Invalid parameter has been passed.
+ * @retval     NRF_ERROR_INVALID_ADDR  Operation failure. Parameter is not aligned.
+ * @retval     NRF_ERROR_NO_MEM        Operation failure. No storage space available.
+ *
+ * @warning    No copy of the data is made, meaning memory provided for the data source that is to 
+ *             be written to flash cannot be freed or reused by the application until this procedure
+ *             is complete.
+ */
+uint32_t pstorage_store_blocks(pstorage_handle_t * p_dest,
+                               uint8_t *           p_src,
+                               pstorage_size_t     block_count);
+
+/**@brief Function for applying several block updates within one flash page.
+ *
+ * @details Equivalent to calling @ref pstorage_update for each of the updates, but the flash page 
+ *          is copied to the swap page and erased only once for all of them. The application is 
+ *          notified once for each update, with the @ref PSTORAGE_UPDATE_OP_CODE operation code.
+ *
+ * @param[in]  p_updates   Array of updates. All blocks must belong to the same module and be 
+ *                         located in the same flash page. The updated areas must not overlap and 
+ *                         must be sorted by address. API assumes the array and the data to be 
+ *                         resident memory.
+ * @param[in]  count       Number of updates in the array.
+ *
+ * @retval     NRF_SUCCESS             Operation success. 
+ * @retval     NRF_ERROR_INVALID_STATE Operation failure. API is called without module 
+ *                                     initialization.
+ * @retval     NRF_ERROR_NULL          Operation failure. NULL parameter has been passed.
+ * @retval     NRF_ERROR_INVALID_PARAM Operation failure. Invalid parameter has been passed.
+ * @retval     NRF_ERROR_INVALID_ADDR  Operation failure. Parameter is not aligned.
+ * @retval     NRF_ERROR_NO_MEM        Operation failure. No storage space available.
+ *
+ * @warning    Neither the array nor the data it points to can be freed or reused by the 
+ *             application until all updates have been notified.
+ */
+uint32_t pstorage_update_batch(pstorage_update_desc_t const * p_updates, uint32_t count);
+
 /**@brief Function for loading persistently stored data of length 'size' from 'p_src' address
  *        to 'p_dest' address. Equivalent to Storage Read.
  *
@@ -15,6 +15,9 @@
 #include "nrf_error.h"
 #include "ble_flash.h"
 #include "app_util.h"
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+#include "app_util_platform.h"
+#endif
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
@@ -22,6 +25,10 @@
 
 #define no_SUPPORT_MODULES_LARGER_THAN_PAGE
 
+#if PSTORAGE_NOSD_ASYNC_ENABLED && defined(SUPPORT_MODULES_LARGER_THAN_PAGE)
+#error "Asynchronous flash access does not support modules larger than a page."
+#endif
+
 /**
  * @defgroup api_param_check API Parameters check macros.
  *
@@ -153,6 +160,49 @@ static uint32_t m_next_page_addr;                                         /**< P
 
 static bool     m_module_initialized = false;                             /**< Flag for checking if module has been initialized. */
 
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+/**@brief Number of steps of the longest operation, an update through the swap page. */
+#define MAX_STAGE_COUNT     6
+
+#if defined(NVMC_ERASEPAGEPARTIALCFG_DURATION_Msk)
+/**@brief Number of partial erase steps needed to erase a page. */
+#define PARTIAL_ERASE_COUNT CEIL_DIV(PSTORAGE_NOSD_PAGE_ERASE_MS, PSTORAGE_NOSD_PARTIAL_ERASE_MS)
+#endif
+
+/**@brief Command queue element. Each element holds the parameters of a queued flash access. */
+typedef struct
+{
+    uint8_t           op_code;          /**< Flash access operation. */
+    pstorage_size_t   size;             /**< Size in bytes requested for the operation. */
+    pstorage_size_t   offset;           /**< Offset requested for the operation. */
+    pstorage_handle_t storage_addr;     /**< Identifier of the persistent memory. */
+    uint8_t *         p_data_addr;      /**< Data memory. It must stay valid until the operation is notified. */
+} cmd_queue_element_t;
+
+/**@brief Command queue, first in first out. When it is not empty, rp points to the command in
+ *        progress or to the command to be started next. */
+typedef struct
+{
+    uint8_t             rp;                             /**< Read pointer. */
+    uint8_t             count;                          /**< Number of elements in the queue. */
+    cmd_queue_element_t cmd[PSTORAGE_CMD_QUEUE_SIZE];   /**< Queued commands. */
+} cmd_queue_t;
+
+/**@brief Part of a flash operation: a page erase or a write of consecutive words. */
+typedef struct
+{
+    uint32_t *       p_dst;             /**< Page to erase or first word to write. */
+    uint32_t const * p_src;             /**< Words to write, or NULL to erase the page. */
+    uint16_t         word_count;        /**< Number of words to write. */
+} flash_stage_t;
+
+static cmd_queue_t   m_cmd_queue;                   /**< Flash access command queue. */
+static flash_stage_t m_stages[MAX_STAGE_COUNT];     /**< Stages of the command in progress. */
+static uint8_t       m_stage_count;                 /**< Number of stages of the command in progress, 0 if no command is in progress. */
+static uint8_t       m_stage_index;                 /**< Stage in progress. */
+static uint16_t      m_stage_progress;              /**< Words written or partial erase steps done in the stage in progress. */
+#endif // PSTORAGE_NOSD_ASYNC_ENABLED
+
 
 /**
  * @brief Routine to notify application of any errors.
@@ -180,11 +230,236 @@ static __INLINE void app_notify(pstorage_handle_t    * p_handle,
 }
 
 
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+/**@brief Function for queuing a flash access command and triggering its processing.
+ *
+ * @retval NRF_SUCCESS      If the command was queued.
+ * @retval NRF_ERROR_NO_MEM If the queue is full.
+ */
+static uint32_t cmd_queue_enqueue(uint8_t             op_code,
+                                  pstorage_handle_t * p_storage_addr,
+                                  uint8_t           * p_data_addr,
+                                  pstorage_size_t     size,
+                                  pstorage_size_t     offset)
+{
+    uint32_t retval = NRF_ERROR_NO_MEM;
+
+    CRITICAL_REGION_ENTER();
+    if (m_cmd_queue.count != PSTORAGE_CMD_QUEUE_SIZE)
+    {
+        uint32_t              index  = (m_cmd_queue.rp + m_cmd_queue.count) % PSTORAGE_CMD_QUEUE_SIZE;
+        cmd_queue_element_t * p_elem = &m_cmd_queue.cmd[index];
+
+        p_elem->op_code      = op_code;
+        p_elem->storage_addr = (*p_storage_addr);
+        p_elem->p_data_addr  = p_data_addr;
+        p_elem->size         = size;
+        p_elem->offset       = offset;
+        m_cmd_queue.count++;
+        retval = NRF_SUCCESS;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (retval == NRF_SUCCESS)
+    {
+        NVIC_SetPendingIRQ(PSTORAGE_NOSD_SWI_IRQn);
+    }
+
+    return retval;
+}
+
+
+static void stage_add(uint32_t * p_dst, uint32_t const * p_src, uint16_t word_count)
+{
+    if ((p_src == NULL) || (word_count != 0))
+    {
+        m_stages[m_stage_count].p_dst      = p_dst;
+        m_stages[m_stage_count].p_src      = p_src;
+        m_stages[m_stage_count].word_count = word_count;
+        m_stage_count++;
+    }
+}
+
+
+/**@brief Function for splitting a command into stages, following the synchronous implementation. */
+static void cmd_stages_plan(cmd_queue_element_t const * p_elem)
+{
+    uint32_t * p_block = (uint32_t *)(p_elem->storage_addr.block_id + p_elem->offset);
+
+    m_stage_count    = 0;
+    m_stage_index    = 0;
+    m_stage_progress = 0;
+
+    switch (p_elem->op_code)
+    {
+        case PSTORAGE_STORE_OP_CODE:
+            stage_add(p_block, (uint32_t *)p_elem->p_data_addr, p_elem->size / sizeof(uint32_t));
+            break;
+
+        case PSTORAGE_UPDATE_OP_CODE:
+        {
+            uint32_t * p_swap_addr     = (uint32_t *)PSTORAGE_SWAP_ADDR;
+            uint32_t * p_page_addr     = (uint32_t *)PAGE_BASE_ADDR((uint32_t)p_block);
+            uint16_t   page_word_count = BLE_FLASH_PAGE_SIZE / sizeof(uint32_t);
+            uint16_t   head_word_count = (uint16_t)(p_block - p_page_addr);
+            uint16_t   body_word_count = p_elem->size / sizeof(uint32_t);
+            uint16_t   tail_word_count = page_word_count - head_word_count - body_word_count;
+
+            stage_add(p_swap_addr, NULL, 0);
+            stage_add(p_swap_addr, p_page_addr, head_word_count);
+            stage_add(p_swap_addr + head_word_count,
+                      (uint32_t *)p_elem->p_data_addr,
+                      body_word_count);
+            stage_add(p_swap_addr + head_word_count + body_word_count,
+                      p_page_addr + head_word_count + body_word_count,
+                      tail_word_count);
+            stage_add(p_page_addr, NULL, 0);
+            stage_add(p_page_addr, p_swap_addr, page_word_count);
+            break;
+        }
+
+        case PSTORAGE_CLEAR_OP_CODE:
+            stage_add((uint32_t *)PAGE_BASE_ADDR(p_elem->storage_addr.block_id), NULL, 0);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief Function for erasing a page, or part of it on devices that support partial erase.
+ *
+ * @return true if the page is erased.
+ */
+static bool page_erase_step(uint32_t * p_page)
+{
+#if defined(NVMC_ERASEPAGEPARTIALCFG_DURATION_Msk)
+    NRF_NVMC->ERASEPAGEPARTIALCFG = PSTORAGE_NOSD_PARTIAL_ERASE_MS;
+    NRF_NVMC->CONFIG              = (NVMC_CONFIG_WEN_Een << NVMC_CONFIG_WEN_Pos);
+    while (NRF_NVMC->READY == NVMC_READY_READY_Busy)
+    {
+        // Do nothing.
+    }
+    NRF_NVMC->ERASEPAGEPARTIAL = (uint32_t)p_page;
+    while (NRF_NVMC->READY == NVMC_READY_READY_Busy)
+    {
+        // Do nothing.
+    }
+    NRF_NVMC->CONFIG = (NVMC_CONFIG_WEN_Ren << NVMC_CONFIG_WEN_Pos);
+    while (NRF_NVMC->READY == NVMC_READY_READY_Busy)
+    {
+        // Do nothing.
+    }
+
+    return (++m_stage_progress == PARTIAL_ERASE_COUNT);
+#else
+    (void) ble_flash_page_erase((uint32_t)p_page / BLE_FLASH_PAGE_SIZE);
+
+    return true;
+#endif
+}
+
+
+/**@brief Function for running one step of the stage in progress.
+ *
+ * @return Result of the flash access.
+ */
+static uint32_t stage_step_run(void)
+{
+    flash_stage_t const * p_stage = &m_stages[m_stage_index];
+    uint32_t              retval  = NRF_SUCCESS;
+    bool                  done;
+
+    if (p_stage->p_src == NULL)
+    {
+        done = page_erase_step(p_stage->p_dst);
+    }
+    else
+    {
+        uint16_t word_count = MIN(p_stage->word_count - m_stage_progress,
+                                  PSTORAGE_NOSD_WRITE_WORDS_PER_STEP);
+
+        retval = ble_flash_block_write(p_stage->p_dst + m_stage_progress,
+                                       (uint32_t *)p_stage->p_src + m_stage_progress,
+                                       word_count);
+        m_stage_progress += word_count;
+        done              = (m_stage_progress == p_stage->word_count);
+    }
+
+    if (done)
+    {
+        m_stage_index++;
+        m_stage_progress = 0;
+    }
+
+    return retval;
+}
+
+
+/**@brief Software interrupt handler, running one step of the flash access in progress.
+ *
+ * @details The interrupt is pended again while steps are left, so that interrupts of higher
+ *          priority run between the steps.
+ */
+void PSTORAGE_NOSD_SWI_IRQHandler(void)
+{
+    cmd_queue_element_t elem;
+    uint32_t            retval;
+    bool                pending;
+
+    if (m_cmd_queue.count == 0)
+    {
+        return;
+    }
+
+    if (m_stage_count == 0)
+    {
+        cmd_stages_plan(&m_cmd_queue.cmd[m_cmd_queue.rp]);
+    }
+
+    retval = (m_stage_count != 0) ? stage_step_run() : NRF_SUCCESS;
+
+    if ((retval != NRF_SUCCESS) || (m_stage_index == m_stage_count))
+    {
+        elem          = m_cmd_queue.cmd[m_cmd_queue.rp];
+        m_stage_count = 0;
+
+        CRITICAL_REGION_ENTER();
+        m_cmd_queue.rp = (m_cmd_queue.rp + 1) % PSTORAGE_CMD_QUEUE_SIZE;
+        m_cmd_queue.count--;
+        CRITICAL_REGION_EXIT();
+
+        // The handler may queue new commands.
+        app_notify(&elem.storage_addr, elem.p_data_addr, elem.op_code, elem.size, retval);
+    }
+
+    CRITICAL_REGION_ENTER();
+    pending = (m_cmd_queue.count != 0);
+    CRITICAL_REGION_EXIT();
+
+    if (pending)
+    {
+        NVIC_SetPendingIRQ(PSTORAGE_NOSD_SWI_IRQn);
+    }
+}
+#endif // PSTORAGE_NOSD_ASYNC_ENABLED
+
+
 uint32_t pstorage_init(void)
 {
     m_next_app_instance  = 0;
     m_next_page_addr     = PSTORAGE_DATA_START_ADDR;
     m_module_initialized = true;
+
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+    memset(&m_cmd_queue, 0, sizeof(m_cmd_queue));
+    m_stage_count = 0;
+
+    NVIC_ClearPendingIRQ(PSTORAGE_NOSD_SWI_IRQn);
+    NVIC_SetPriority(PSTORAGE_NOSD_SWI_IRQn, PSTORAGE_NOSD_IRQ_PRIORITY);
+    NVIC_EnableIRQ(PSTORAGE_NOSD_SWI_IRQn);
+#endif
     return NRF_SUCCESS;
 }
 
@@ -294,6 +569,9 @@ uint32_t pstorage_store(pstorage_handle_t * p_dest,
         return NRF_ERROR_INVALID_ADDR;
     }
 
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+    return cmd_queue_enqueue(PSTORAGE_STORE_OP_CODE, p_dest, p_src, size, offset);
+#else
     uint32_t storage_addr = p_dest->block_id + offset;
 
     uint32_t retval = ble_flash_block_write((uint32_t *)storage_addr,
@@ -303,6 +581,7 @@ uint32_t pstorage_store(pstorage_handle_t * p_dest,
     app_notify(p_dest, p_src, PSTORAGE_STORE_OP_CODE, size, retval);
     
     return retval;
+#endif
 }
 
 /** @brief Function for handling flash updates using swap page
@@ -354,6 +633,15 @@ uint32_t pstorage_update(pstorage_handle_t * p_dest,
     {
         return NRF_ERROR_INVALID_ADDR;
     }
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+    UNUSED_VARIABLE(p_swap_addr);
+    UNUSED_VARIABLE(head_word_count);
+    UNUSED_VARIABLE(body_word_count);
+    UNUSED_VARIABLE(tail_word_count);
+    UNUSED_VARIABLE(retval);
+
+    return cmd_queue_enqueue(PSTORAGE_UPDATE_OP_CODE, p_dest, p_src, size, offset);
+#else
     // erase swap page
     (void) ble_flash_page_erase(PSTORAGE_SWAP_ADDR / BLE_FLASH_PAGE_SIZE);
 #ifdef SUPPORT_MODULES_LARGER_THAN_PAGE
@@ -453,9 +741,87 @@ uint32_t pstorage_update(pstorage_handle_t * p_dest,
 #endif
     app_notify(p_dest, p_src, PSTORAGE_UPDATE_OP_CODE, size, retval);
     return retval;
+#endif // PSTORAGE_NOSD_ASYNC_ENABLED
 
 }
 
+
+uint32_t pstorage_store_blocks(pstorage_handle_t * p_dest,
+                               uint8_t           * p_src,
+                               pstorage_size_t     block_count)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_src);
+    NULL_PARAM_CHECK(p_dest);
+    MODULE_ID_RANGE_CHECK(p_dest);
+    BLOCK_ID_RANGE_CHECK(p_dest);
+
+    // Verify word alignment.
+    if (!is_word_aligned(p_src))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    uint32_t size     = (uint32_t)MODULE_BLOCK_SIZE(p_dest) * block_count;
+    uint32_t end_addr = m_app_table[p_dest->module_id].base_id +
+                        (m_app_table[p_dest->module_id].block_size *
+                         m_app_table[p_dest->module_id].block_count);
+
+    if ((block_count == 0) || (size > UINT16_MAX) || ((p_dest->block_id + size) > end_addr))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+    return cmd_queue_enqueue(PSTORAGE_STORE_OP_CODE, p_dest, p_src, (pstorage_size_t)size, 0);
+#else
+    uint32_t retval = ble_flash_block_write((uint32_t *)p_dest->block_id,
+                                            (uint32_t *)p_src,
+                                            (size / sizeof(uint32_t)));
+
+    app_notify(p_dest, p_src, PSTORAGE_STORE_OP_CODE, size, retval);
+
+    return retval;
+#endif
+}
+
+
+uint32_t pstorage_update_batch(pstorage_update_desc_t const * p_updates, uint32_t count)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_updates);
+
+    if (count == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+    // The updates are queued together, so that none of them is queued if they do not all fit.
+    if (count > PSTORAGE_CMD_QUEUE_SIZE - m_cmd_queue.count)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+#endif
+
+    // The updates are applied in order. Each one notifies the application.
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pstorage_handle_t block_id = p_updates[i].block_id;
+
+        uint32_t retval = pstorage_update(&block_id,
+                                          p_updates[i].p_src,
+                                          p_updates[i].size,
+                                          p_updates[i].offset);
+        if (retval != NRF_SUCCESS)
+        {
+            return retval;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
 uint32_t pstorage_load(uint8_t *           p_dest,
                        pstorage_handle_t * p_src,
                        pstorage_size_t     size,
@@ -493,6 +859,13 @@ uint32_t pstorage_clear(pstorage_handle_t * p_dest, pstorage_size_t size)
     NULL_PARAM_CHECK(p_dest);
     MODULE_ID_RANGE_CHECK(p_dest);
 
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+    UNUSED_VARIABLE(page_addr);
+    UNUSED_VARIABLE(retval);
+    UNUSED_VARIABLE(page_count);
+
+    return cmd_queue_enqueue(PSTORAGE_CLEAR_OP_CODE, p_dest, NULL, size, 0);
+#else
     page_addr = p_dest->block_id / BLE_FLASH_PAGE_SIZE;
 
     retval = NRF_SUCCESS;
@@ -508,6 +881,7 @@ uint32_t pstorage_clear(pstorage_handle_t * p_dest, pstorage_size_t size)
     }
     app_notify(p_dest, NULL, PSTORAGE_CLEAR_OP_CODE, size, retval);
     return retval;
+#endif
 }
 
 void pstorage_sys_event_handler(uint32_t sys_evt)
@@ -519,7 +893,11 @@ uint32_t pstorage_access_status_get(uint32_t * p_count)
 {
     if (p_count)
     {
+#if PSTORAGE_NOSD_ASYNC_ENABLED
+        *p_count = m_cmd_queue.count;
+#else
         *p_count = 0;
+#endif
     }
     return NRF_SUCCESS;
 }
@@ -26,6 +26,7 @@ typedef struct
 {
     nrf_drv_pwm_handler_t    handler;
     nrf_drv_state_t volatile state;
+    nrf_drv_pwm_stream_config_t const * p_stream;
 } pwm_control_block_t;
 static pwm_control_block_t m_cb[PWM_COUNT];
 
@@ -182,6 +183,8 @@ void nrf_drv_pwm_simple_playback(nrf_drv_pwm_t const * const p_instance,
     ASSERT(playback_count > 0);
     ASSERT(nrf_drv_is_in_RAM(p_sequence->values.p_raw));
 
+    p_cb->p_stream = NULL;
+
     // To take advantage of the looping mechanism, we need to use both sequences
     // (single sequence can be played back only once).
     nrf_pwm_sequence_set(p_instance->p_registers, 0, p_sequence);
@@ -222,6 +225,8 @@ void nrf_drv_pwm_complex_playback(nrf_drv_pwm_t const * const p_instance,
     ASSERT(nrf_drv_is_in_RAM(p_sequence_0->values.p_raw));
     ASSERT(nrf_drv_is_in_RAM(p_sequence_1->values.p_raw));
 
+    p_cb->p_stream = NULL;
+
     nrf_pwm_sequence_set(p_instance->p_registers, 0, p_sequence_0);
     nrf_pwm_sequence_set(p_instance->p_registers, 1, p_sequence_1);
     nrf_pwm_loop_set(p_instance->p_registers, playback_count);
@@ -245,6 +250,122 @@ void nrf_drv_pwm_complex_playback(nrf_drv_pwm_t const * const p_instance,
 }
 
 
+ret_code_t nrf_drv_pwm_stream_playback(nrf_drv_pwm_t const * const         p_instance,
+                                       nrf_drv_pwm_stream_config_t const * p_config)
+{
+    pwm_control_block_t * p_cb  = &m_cb[p_instance->drv_inst_idx];
+    ASSERT(p_cb->state != NRF_DRV_STATE_UNINITIALIZED);
+    ASSERT(p_config->handler != NULL);
+    ASSERT(p_config->length > 0);
+
+    // The buffers are refilled in the interrupt handler.
+    if (p_cb->handler == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (!nrf_drv_is_in_RAM(p_config->p_buffers[0]) ||
+        !nrf_drv_is_in_RAM(p_config->p_buffers[1]))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    nrf_pwm_sequence_t sequence;
+    sequence.repeats   = p_config->repeats;
+    sequence.end_delay = 0;
+
+    sequence.values.p_raw = p_config->p_buffers[0];
+    sequence.length       = p_config->handler(p_config->p_buffers[0],
+                                p_config->length, p_config->p_context);
+    if (sequence.length == 0)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    nrf_pwm_sequence_set(p_instance->p_registers, 0, &sequence);
+
+    sequence.values.p_raw = p_config->p_buffers[1];
+    sequence.length       = p_config->handler(p_config->p_buffers[1],
+                                p_config->length, p_config->p_context);
+
+    uint32_t flags = NRF_DRV_PWM_FLAG_NO_EVT_FINISHED;
+    if (sequence.length == 0)
+    {
+        // The whole waveform fits in the first buffer.
+        nrf_pwm_loop_set(p_instance->p_registers, 0);
+        nrf_pwm_shorts_set(p_instance->p_registers,
+            NRF_PWM_SHORT_SEQEND0_STOP_MASK);
+    }
+    else
+    {
+        nrf_pwm_sequence_set(p_instance->p_registers, 1, &sequence);
+
+        // With one loop and the shortcut starting sequence 0 again, both
+        // sequences are played back alternately until the shortcuts are
+        // changed at the end of the stream.
+        nrf_pwm_loop_set(p_instance->p_registers, 1);
+        nrf_pwm_shorts_set(p_instance->p_registers,
+            NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK);
+        flags |= NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ0 |
+                 NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ1;
+    }
+
+    p_cb->p_stream = p_config;
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_SEQEND0);
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_SEQEND1);
+
+    start_playback(p_instance, p_cb, flags, NRF_PWM_TASK_SEQSTART0);
+
+    return NRF_SUCCESS;
+}
+
+
+uint16_t nrf_drv_pwm_stream_ring_write(nrf_drv_pwm_stream_ring_t * p_ring,
+                                       uint16_t const *            p_values,
+                                       uint16_t                    count)
+{
+    ASSERT((p_ring->size != 0) && ((p_ring->size & (p_ring->size - 1)) == 0));
+
+    uint16_t write_idx = p_ring->write_idx;
+    uint16_t free_size = p_ring->size - (uint16_t)(write_idx - p_ring->read_idx);
+    uint16_t i;
+
+    if (count > free_size)
+    {
+        count = free_size;
+    }
+    for (i = 0; i < count; ++i)
+    {
+        p_ring->p_buffer[(uint16_t)(write_idx + i) & (p_ring->size - 1)] = p_values[i];
+    }
+    p_ring->write_idx = write_idx + count;
+
+    return count;
+}
+
+
+uint16_t nrf_drv_pwm_stream_ring_refill(uint16_t * p_values,
+                                        uint16_t   length,
+                                        void *     p_context)
+{
+    nrf_drv_pwm_stream_ring_t * p_ring = (nrf_drv_pwm_stream_ring_t *)p_context;
+
+    uint16_t read_idx = p_ring->read_idx;
+    uint16_t count    = (uint16_t)(p_ring->write_idx - read_idx);
+    uint16_t i;
+
+    if (count > length)
+    {
+        count = length;
+    }
+    for (i = 0; i < count; ++i)
+    {
+        p_values[i] = p_ring->p_buffer[(uint16_t)(read_idx + i) & (p_ring->size - 1)];
+    }
+    p_ring->read_idx = read_idx + count;
+
+    return count;
+}
+
+
 bool nrf_drv_pwm_stop(nrf_drv_pwm_t const * const p_instance,
                       bool wait_until_stopped)
 {
@@ -290,23 +411,73 @@ bool nrf_drv_pwm_is_stopped(nrf_drv_pwm_t const * const p_instance)
 }
 
 
+static void stream_refill(NRF_PWM_Type * p_pwm, pwm_control_block_t * p_cb,
+                          uint8_t seq_id)
+{
+    nrf_drv_pwm_stream_config_t const * p_stream = p_cb->p_stream;
+
+    uint16_t length = p_stream->handler(p_stream->p_buffers[seq_id],
+                                        p_stream->length, p_stream->p_context);
+    if (length != 0)
+    {
+        nrf_pwm_seq_cnt_set(p_pwm, seq_id, length);
+        return;
+    }
+
+    // End of the stream - stop after the other sequence is played back.
+    if (seq_id == 0)
+    {
+        // Sequence 1 is played back now, and then the loop is done.
+        nrf_pwm_shorts_set(p_pwm, NRF_PWM_SHORT_LOOPSDONE_STOP_MASK);
+    }
+    else
+    {
+        // Sequence 0 is (or will be shortly) started by the loop shortcut.
+        nrf_pwm_shorts_set(p_pwm, NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK |
+                                  NRF_PWM_SHORT_SEQEND0_STOP_MASK);
+    }
+    nrf_pwm_int_disable(p_pwm, NRF_PWM_INT_SEQEND0_MASK |
+                               NRF_PWM_INT_SEQEND1_MASK);
+}
+
+
 static void irq_handler(NRF_PWM_Type * p_pwm, pwm_control_block_t * p_cb)
 {
     ASSERT(p_cb->handler);
 
-    // The SEQEND0 and SEQEND1 events are only handled when the user asked for
-    // it (by setting proper flags when starting the playback).
-    if (nrf_pwm_int_enable_check(p_pwm, NRF_PWM_INT_SEQEND0_MASK) &&
-        nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND0))
+    // In the streaming playback, the SEQEND0 and SEQEND1 events are used
+    // to refill the sequence that has just been loaded.
+    if (p_cb->p_stream != NULL)
     {
-        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND0);
-        p_cb->handler(NRF_DRV_PWM_EVT_END_SEQ0);
+        if (nrf_pwm_int_enable_check(p_pwm, NRF_PWM_INT_SEQEND0_MASK) &&
+            nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND0))
+        {
+            nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND0);
+            stream_refill(p_pwm, p_cb, 0);
+        }
+        if (nrf_pwm_int_enable_check(p_pwm, NRF_PWM_INT_SEQEND1_MASK) &&
+            nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND1))
+        {
+            nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND1);
+            stream_refill(p_pwm, p_cb, 1);
+        }
     }
-    if (nrf_pwm_int_enable_check(p_pwm, NRF_PWM_INT_SEQEND1_MASK) &&
-        nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND1))
+    // The SEQEND0 and SEQEND1 events are only handled when the user asked for
+    // it (by setting proper flags when starting the playback).
+    else
     {
-        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND1);
-        p_cb->handler(NRF_DRV_PWM_EVT_END_SEQ1);
+        if (nrf_pwm_int_enable_check(p_pwm, NRF_PWM_INT_SEQEND0_MASK) &&
+            nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND0))
+        {
+            nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND0);
+            p_cb->handler(NRF_DRV_PWM_EVT_END_SEQ0);
+        }
+        if (nrf_pwm_int_enable_check(p_pwm, NRF_PWM_INT_SEQEND1_MASK) &&
+            nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND1))
+        {
+            nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND1);
+            p_cb->handler(NRF_DRV_PWM_EVT_END_SEQ1);
+        }
     }
 
     // The LOOPSDONE event is handled by default, but this can be disabled.
@@ -321,7 +492,8 @@ static void irq_handler(NRF_PWM_Type * p_pwm, pwm_control_block_t * p_cb)
     {
         nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_STOPPED);
 
-        p_cb->state = NRF_DRV_STATE_INITIALIZED;
+        p_cb->state    = NRF_DRV_STATE_INITIALIZED;
+        p_cb->p_stream = NULL;
 
         p_cb->handler(NRF_DRV_PWM_EVT_STOPPED);
     }
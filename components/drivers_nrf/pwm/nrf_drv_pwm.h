@@ -146,6 +146,52 @@ typedef enum
  */
 typedef void (* nrf_drv_pwm_handler_t)(nrf_drv_pwm_evt_type_t event_type);
 
+/**
+ * @brief PWM streaming refill handler type.
+ *
+ * Called from the PWM interrupt when one of the two sequences has been loaded
+ * and its buffer can be written with the next portion of the waveform, while
+ * the other sequence is played back.
+ *
+ * @param[out] p_values  Buffer to be filled with duty cycle values.
+ * @param[in]  length    Capacity of the buffer (in 16-bit values).
+ * @param[in]  p_context Context specified when the streaming was started.
+ *
+ * @return Number of values written. If it is less than @p length, only these
+ *         values are played back. Return 0 to end the stream after the other
+ *         sequence is played back.
+ */
+typedef uint16_t (* nrf_drv_pwm_refill_handler_t)(uint16_t * p_values,
+                                                  uint16_t   length,
+                                                  void *     p_context);
+
+/**
+ * @brief PWM streaming configuration structure.
+ */
+typedef struct
+{
+    uint16_t *                   p_buffers[2]; ///< Buffers alternately played back as sequence 0 and sequence 1. Must be in Data RAM.
+    uint16_t                     length;       ///< Capacity of each buffer (in 16-bit values).
+    uint32_t                     repeats;      ///< Number of times that each duty cycle should be repeated (after being played once).
+    nrf_drv_pwm_refill_handler_t handler;      ///< Refill handler.
+    void *                       p_context;    ///< Context passed to the refill handler.
+} nrf_drv_pwm_stream_config_t;
+
+/**
+ * @brief Ring buffer used to stream duty cycle values.
+ *
+ * @details The application writes values with @ref nrf_drv_pwm_stream_ring_write
+ *          and @ref nrf_drv_pwm_stream_ring_refill is used as the refill
+ *          handler, with the pointer to the ring buffer as its context.
+ */
+typedef struct
+{
+    uint16_t *        p_buffer;  ///< Memory for the values.
+    uint16_t          size;      ///< Size of the memory (in 16-bit values). Must be a power of two.
+    volatile uint16_t write_idx; ///< Write counter.
+    volatile uint16_t read_idx;  ///< Read counter.
+} nrf_drv_pwm_stream_ring_t;
+
 
 /**
  * @brief Function for initializing the PWM driver.
@@ -223,6 +269,61 @@ void nrf_drv_pwm_complex_playback(nrf_drv_pwm_t const * const p_instance,
                                   uint16_t                   playback_count,
                                   uint32_t                   flags);
 
+/**
+ * @brief Function for starting a streaming playback.
+ *
+ * The two buffers are played back alternately as sequence 0 and sequence 1.
+ * Each time a sequence has been loaded, its buffer is refilled by the refill
+ * handler with the next portion of the waveform while the other sequence is
+ * played back, so a waveform of any length can be played back with only two
+ * buffers in RAM. Both buffers are filled before the playback starts.
+ *
+ * The stream ends when the refill handler returns 0, and then
+ * the @ref NRF_DRV_PWM_EVT_STOPPED event is generated. The SEQEND events are
+ * used by the driver and not passed to the event handler.
+ *
+ * @note The driver must be initialized with an event handler, as the refill
+ *       is done in the PWM interrupt.
+ *
+ * @param[in] p_instance Pointer to the driver instance structure.
+ * @param[in] p_config   Pointer to the streaming configuration. It must be
+ *                       kept until the stream ends.
+ *
+ * @retval NRF_SUCCESS             If the playback was started.
+ * @retval NRF_ERROR_INVALID_STATE If the driver was initialized without
+ *                                 an event handler.
+ * @retval NRF_ERROR_INVALID_ADDR  If the buffers are not placed in Data RAM.
+ * @retval NRF_ERROR_INVALID_LENGTH If the refill handler provided no values
+ *                                  for the first buffer.
+ */
+ret_code_t nrf_drv_pwm_stream_playback(nrf_drv_pwm_t const * const         p_instance,
+                                       nrf_drv_pwm_stream_config_t const * p_config);
+
+/**
+ * @brief Function for writing duty cycle values to a streaming ring buffer.
+ *
+ * @param[in] p_ring   Pointer to the ring buffer.
+ * @param[in] p_values Values to be written.
+ * @param[in] count    Number of values.
+ *
+ * @return Number of values written (less than @p count if the ring buffer
+ *         is full).
+ */
+uint16_t nrf_drv_pwm_stream_ring_write(nrf_drv_pwm_stream_ring_t * p_ring,
+                                       uint16_t const *            p_values,
+                                       uint16_t                    count);
+
+/**
+ * @brief Refill handler that takes values from a streaming ring buffer.
+ *
+ * @details Pass a pointer to @ref nrf_drv_pwm_stream_ring_t as the context.
+ *          The stream ends when the ring buffer is empty at the moment of
+ *          refill.
+ */
+uint16_t nrf_drv_pwm_stream_ring_refill(uint16_t * p_values,
+                                        uint16_t   length,
+                                        void *     p_context);
+
 /**
  * @brief Function for advancing the active sequence.
  *
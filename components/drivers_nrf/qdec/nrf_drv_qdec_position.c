@@ -0,0 +1,201 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "nrf_drv_qdec_position.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include "nrf_error.h"
+#include "nrf_qdec.h"
+#include "nrf_timer.h"
+#include "nrf_drv_ppi.h"
+#include "app_util_platform.h"
+#include "app_error.h"
+#include "nrf_assert.h"
+
+static nrf_drv_timer_t                 m_timer;             /**< TIMER instance counting the samples. */
+static nrf_drv_qdec_position_handler_t m_handler;           /**< Handler of the batch reports. */
+static nrf_ppi_channel_t               m_ppi_sample;        /**< SAMPLERDY to TIMER COUNT. */
+static nrf_ppi_channel_t               m_ppi_batch;         /**< TIMER COMPARE0 to READCLRACC. */
+static volatile int32_t                m_position;          /**< Position up to the last handled batch. */
+static volatile int16_t                m_velocity;          /**< Transitions in the last handled batch. */
+static bool                            m_initialized;
+
+
+/**@brief Function for reading the transitions not yet added to the position.
+ *
+ * @details These are the transitions of the current batch, in the ACC register, and those of a
+ *          batch that has ended but whose interrupt has not been handled yet, in the ACCREAD
+ *          register. Must be called in a critical region.
+ */
+static int32_t pending_transitions_get(void)
+{
+    bool    batch_ended;
+    int32_t transitions;
+
+    // Read again if a batch ends while the registers are read.
+    do
+    {
+        batch_ended = nrf_timer_event_check(m_timer.p_reg, NRF_TIMER_EVENT_COMPARE0);
+        transitions = (int16_t)nrf_qdec_acc_get();
+        if (batch_ended)
+        {
+            transitions += (int16_t)nrf_qdec_accread_get();
+        }
+    } while (batch_ended != nrf_timer_event_check(m_timer.p_reg, NRF_TIMER_EVENT_COMPARE0));
+
+    return transitions;
+}
+
+
+static void timer_event_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    nrf_drv_qdec_position_report_t report;
+
+    if (event_type != NRF_TIMER_EVENT_COMPARE0)
+    {
+        return;
+    }
+
+    report.velocity = (int16_t)nrf_qdec_accread_get();
+    report.accdbl   = (uint16_t)nrf_qdec_accdblread_get();
+
+    m_velocity  = report.velocity;
+    m_position += report.velocity;
+
+    if (m_handler != NULL)
+    {
+        report.position = m_position;
+        m_handler(&report);
+    }
+}
+
+
+ret_code_t nrf_drv_qdec_position_init(nrf_drv_timer_t const *         p_timer,
+                                      uint16_t                        batch_samples,
+                                      nrf_drv_qdec_position_handler_t handler)
+{
+    ret_code_t err_code;
+
+    if (m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if ((batch_samples == 0) || (batch_samples > NRF_DRV_QDEC_POSITION_MAX_BATCH))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrf_drv_timer_config_t const timer_config =
+    {
+        .frequency          = NRF_TIMER_FREQ_16MHz,
+        .mode               = NRF_TIMER_MODE_COUNTER,
+        .bit_width          = NRF_TIMER_BIT_WIDTH_16,
+        .interrupt_priority = QDEC_CONFIG_IRQ_PRIORITY,
+        .p_context          = NULL,
+    };
+
+    err_code = nrf_drv_timer_init(p_timer, &timer_config, timer_event_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    err_code = nrf_drv_ppi_channel_alloc(&m_ppi_sample);
+    if (err_code != NRF_SUCCESS)
+    {
+        nrf_drv_timer_uninit(p_timer);
+        return err_code;
+    }
+
+    err_code = nrf_drv_ppi_channel_alloc(&m_ppi_batch);
+    if (err_code != NRF_SUCCESS)
+    {
+        (void)nrf_drv_ppi_channel_free(m_ppi_sample);
+        nrf_drv_timer_uninit(p_timer);
+        return err_code;
+    }
+
+    m_timer     = *p_timer;
+    m_handler   = handler;
+    m_position  = 0;
+    m_velocity  = 0;
+
+    // The transitions are only moved to ACCREAD at the end of a batch.
+    nrf_qdec_shorts_disable(NRF_QDEC_SHORT_REPORTRDY_READCLRACC_MASK);
+    nrf_qdec_int_disable(NRF_QDEC_INT_REPORTRDY_MASK | NRF_QDEC_INT_SAMPLERDY_MASK);
+    nrf_qdec_task_trigger(NRF_QDEC_TASK_READCLRACC);
+
+    nrf_drv_timer_extended_compare(p_timer, NRF_TIMER_CC_CHANNEL0, batch_samples,
+                                   NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, true);
+    nrf_drv_timer_clear(p_timer);
+    nrf_drv_timer_enable(p_timer);
+
+    APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_sample,
+                        (uint32_t)nrf_qdec_event_address_get(NRF_QDEC_EVENT_SAMPLERDY),
+                        nrf_drv_timer_task_address_get(p_timer, NRF_TIMER_TASK_COUNT)));
+    APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_batch,
+                        nrf_drv_timer_compare_event_address_get(p_timer, NRF_TIMER_CC_CHANNEL0),
+                        (uint32_t)nrf_qdec_task_address_get(NRF_QDEC_TASK_READCLRACC)));
+    APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_sample));
+    APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_batch));
+
+    m_initialized = true;
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_qdec_position_uninit(void)
+{
+    ASSERT(m_initialized);
+
+    (void)nrf_drv_ppi_channel_disable(m_ppi_sample);
+    (void)nrf_drv_ppi_channel_disable(m_ppi_batch);
+    (void)nrf_drv_ppi_channel_free(m_ppi_sample);
+    (void)nrf_drv_ppi_channel_free(m_ppi_batch);
+
+    nrf_drv_timer_uninit(&m_timer);
+
+    nrf_qdec_shorts_enable(NRF_QDEC_SHORT_REPORTRDY_READCLRACC_MASK);
+
+    m_initialized = false;
+}
+
+
+int32_t nrf_drv_qdec_position_get(void)
+{
+    int32_t position;
+
+    ASSERT(m_initialized);
+
+    CRITICAL_REGION_ENTER();
+    position = m_position + pending_transitions_get();
+    CRITICAL_REGION_EXIT();
+
+    return position;
+}
+
+
+void nrf_drv_qdec_position_set(int32_t position)
+{
+    ASSERT(m_initialized);
+
+    CRITICAL_REGION_ENTER();
+    m_position = position - pending_transitions_get();
+    CRITICAL_REGION_EXIT();
+}
+
+
+int16_t nrf_drv_qdec_velocity_get(void)
+{
+    return m_velocity;
+}
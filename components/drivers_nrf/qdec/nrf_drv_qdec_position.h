@@ -0,0 +1,97 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef NRF_DRV_QDEC_POSITION_H__
+#define NRF_DRV_QDEC_POSITION_H__
+
+#include <stdint.h>
+#include "nrf_drv_qdec.h"
+#include "nrf_drv_timer.h"
+#include "sdk_errors.h"
+
+/**
+ * @defgroup nrf_drv_qdec_position QDEC position tracking
+ * @{
+ * @ingroup nrf_qdec
+ * @brief Absolute position of a quadrature encoder, accumulated with one interrupt per batch of
+ *        samples.
+ *
+ * @details The SAMPLERDY events of the QDEC are counted by a TIMER instance in counter mode,
+ *          through a PPI channel. When a batch of samples is complete, the compare event of the
+ *          TIMER triggers the READCLRACC task through a second PPI channel, so the transitions of
+ *          the batch are moved to the ACCREAD register on the exact sample, whatever the interrupt
+ *          latency. The TIMER interrupt then adds them to a 32-bit position.
+ *
+ *          The ACC register of the QDEC counts at most one transition per sample, so it cannot
+ *          overflow within a batch of up to @ref NRF_DRV_QDEC_POSITION_MAX_BATCH samples. The
+ *          REPORTRDY and SAMPLERDY interrupts of the QDEC driver are not used.
+ *
+ *          The position can be read at any time, including the transitions of the current batch.
+ *          The velocity is the number of transitions in the last complete batch.
+ */
+
+#define NRF_DRV_QDEC_POSITION_MAX_BATCH 1023  /**< Largest number of samples per batch. */
+
+/**@brief Position report, passed to the handler at the end of each batch. */
+typedef struct
+{
+    int32_t  position;  /**< Position at the end of the batch, in transitions. */
+    int16_t  velocity;  /**< Transitions in the batch. */
+    uint16_t accdbl;    /**< Double transitions in the batch, not included in the position. */
+} nrf_drv_qdec_position_report_t;
+
+/**@brief Handler called from the TIMER interrupt at the end of each batch. */
+typedef void (*nrf_drv_qdec_position_handler_t)(nrf_drv_qdec_position_report_t const * p_report);
+
+/**@brief Function for starting position tracking.
+ *
+ * @details The QDEC driver must be initialized, and @ref nrf_drv_qdec_enable called after this
+ *          function. The TIMER instance is initialized and enabled by this function, with the
+ *          interrupt priority of the QDEC. Two PPI channels are allocated, so the PPI driver must
+ *          be initialized first.
+ *
+ * @param[in] p_timer        TIMER instance used to count the samples.
+ * @param[in] batch_samples  Number of samples per batch, from 1 to
+ *                           @ref NRF_DRV_QDEC_POSITION_MAX_BATCH. The interrupt rate is the
+ *                           sample rate divided by this number.
+ * @param[in] handler        Handler of the batch reports, or NULL.
+ *
+ * @retval NRF_SUCCESS              If position tracking was started.
+ * @retval NRF_ERROR_INVALID_STATE  If position tracking or the TIMER instance is already
+ *                                  initialized.
+ * @retval NRF_ERROR_INVALID_PARAM  If batch_samples is out of range.
+ * @retval NRF_ERROR_NO_MEM         If no PPI channels are available.
+ */
+ret_code_t nrf_drv_qdec_position_init(nrf_drv_timer_t const *         p_timer,
+                                      uint16_t                        batch_samples,
+                                      nrf_drv_qdec_position_handler_t handler);
+
+/**@brief Function for stopping position tracking, and releasing the TIMER instance and the PPI
+ *        channels. The REPORTRDY to READCLRACC shortcut of the QDEC driver is restored.
+ */
+void nrf_drv_qdec_position_uninit(void);
+
+/**@brief Function for reading the position, in transitions.
+ *
+ * @details Must not be called from an interrupt of higher priority than the QDEC.
+ */
+int32_t nrf_drv_qdec_position_get(void);
+
+/**@brief Function for setting the position, for example when a reference point is reached. */
+void nrf_drv_qdec_position_set(int32_t position);
+
+/**@brief Function for reading the velocity, in transitions per batch of samples. */
+int16_t nrf_drv_qdec_velocity_get(void);
+
+/** @} */
+
+#endif // NRF_DRV_QDEC_POSITION_H__
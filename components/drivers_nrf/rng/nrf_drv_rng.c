@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "nrf_drv_rng.h"
 #include "nrf_assert.h"
@@ -34,7 +35,34 @@ static __INLINE uint32_t fifo_length(app_fifo_t * p_fifo)
 
 #define FIFO_LENGTH(fifo) fifo_length(&(fifo))  /**< Macro for calculating the FIFO length. */
 
+#if (RNG_CONFIG_POOL_SIZE > 128)
+#error "RNG_CONFIG_POOL_SIZE must be at most 128, sizes are reported as uint8_t."
+#endif
+
+#if (RNG_CONFIG_POOL_WATERMARK < 1) || (RNG_CONFIG_POOL_WATERMARK > RNG_CONFIG_POOL_SIZE)
+#error "RNG_CONFIG_POOL_WATERMARK must be from 1 to RNG_CONFIG_POOL_SIZE."
+#endif
+
 #endif // SOFTDEVICE_PRESENT
+
+#if RNG_CONFIG_DRBG_ENABLED
+#if !defined(AES_ENABLED) || (AES_ENABLED != 1)
+#error "RNG_CONFIG_DRBG_ENABLED requires AES_ENABLED."
+#endif
+#include "nrf_drv_aes.h"
+
+#define DRBG_SEED_LEN       (2 * NRF_DRV_AES_BLOCK_SIZE)   /**< Seed length of AES-128 CTR-DRBG: key and V. */
+#define DRBG_MAX_REQUEST    0x10000                         /**< Maximum number of bytes per generate, 2^19 bits. */
+
+/**@brief State of the CTR-DRBG. */
+typedef struct
+{
+    uint8_t  key[NRF_DRV_AES_BLOCK_SIZE];
+    uint8_t  counter[NRF_DRV_AES_BLOCK_SIZE];   /**< V + 1, the next counter block. */
+    uint32_t reseed_counter;                    /**< Generate calls since the last reseed, 0 before the DRBG is seeded. */
+} drbg_t;
+#endif // RNG_CONFIG_DRBG_ENABLED
+
 typedef struct
 {
     nrf_drv_state_t state;
@@ -42,6 +70,9 @@ typedef struct
     app_fifo_t rand_pool;
     uint8_t    buffer[RNG_CONFIG_POOL_SIZE];
 #endif // SOFTDEVICE_PRESENT
+#if RNG_CONFIG_DRBG_ENABLED
+    drbg_t     drbg;
+#endif // RNG_CONFIG_DRBG_ENABLED
 } nrf_drv_rng_cb_t;
 
 static nrf_drv_rng_cb_t m_rng_cb;
@@ -49,7 +80,7 @@ static nrf_drv_rng_cb_t m_rng_cb;
 static const nrf_drv_rng_config_t m_default_config = NRF_DRV_RNG_DEFAULT_CONFIG;
 static void rng_start(void)
 {
-    if (FIFO_LENGTH(m_rng_cb.rand_pool) <= m_rng_cb.rand_pool.buf_size_mask)
+    if (FIFO_LENGTH(m_rng_cb.rand_pool) < RNG_CONFIG_POOL_WATERMARK)
     {
         nrf_rng_event_clear(NRF_RNG_EVENT_VALRDY);
         nrf_rng_int_enable(NRF_RNG_INT_VALRDY_MASK);
@@ -111,6 +142,18 @@ ret_code_t nrf_drv_rng_init(nrf_drv_rng_config_t const * p_config)
             result = NRF_ERROR_SOFTDEVICE_NOT_ENABLED;
         }
 #endif // SOFTDEVICE_PRESENT
+#if RNG_CONFIG_DRBG_ENABLED
+        if (result == NRF_SUCCESS)
+        {
+            // Seeded on the first request. The AES driver may already have been initialized by
+            // the application, in blocking mode.
+            memset(&m_rng_cb.drbg, 0, sizeof(m_rng_cb.drbg));
+            if (nrf_drv_aes_init(NULL, NULL) == NRF_ERROR_SOFTDEVICE_NOT_ENABLED)
+            {
+                result = NRF_ERROR_SOFTDEVICE_NOT_ENABLED;
+            }
+        }
+#endif // RNG_CONFIG_DRBG_ENABLED
     }
     else
     {
@@ -129,6 +172,9 @@ void nrf_drv_rng_uninit(void)
     rng_stop();
     nrf_drv_common_irq_disable(RNG_IRQn);
 #endif // SOFTDEVICE_PRESENT
+#if RNG_CONFIG_DRBG_ENABLED
+    memset(&m_rng_cb.drbg, 0, sizeof(m_rng_cb.drbg));
+#endif // RNG_CONFIG_DRBG_ENABLED
 }
 
 ret_code_t nrf_drv_rng_bytes_available(uint8_t * p_bytes_available)
@@ -199,11 +245,11 @@ ret_code_t nrf_drv_rng_rand(uint8_t * p_buff, uint8_t length)
     return result;
 }
 
-ret_code_t nrf_drv_rng_block_rand(uint8_t * p_buff, uint32_t length)
+/* Blocking read of bytes from the pool. */
+static ret_code_t pool_block_rand(uint8_t * p_buff, uint32_t length)
 {
     uint32_t count = 0, poolsz = 0;
     ret_code_t result;
-    ASSERT(m_rng_cb.state == NRF_DRV_STATE_INITIALIZED);
 
     result = nrf_drv_rng_pool_capacity((uint8_t *) &poolsz);
     if(result != NRF_SUCCESS)
@@ -231,6 +277,116 @@ ret_code_t nrf_drv_rng_block_rand(uint8_t * p_buff, uint32_t length)
 }
 
 
+#if RNG_CONFIG_DRBG_ENABLED
+static void drbg_counter_increment(uint8_t * p_counter)
+{
+    for (int i = NRF_DRV_AES_BLOCK_SIZE - 1; (i >= 0) && (++p_counter[i] == 0); i--)
+    {
+        // Carry into the next byte.
+    }
+}
+
+
+/* CTR_DRBG_Update: (key, V) = (E(key, V + 1) || E(key, V + 2)) XOR provided data. */
+static ret_code_t drbg_update(uint8_t * p_provided)
+{
+    drbg_t   * p_drbg = &m_rng_cb.drbg;
+    ret_code_t result;
+
+    result = nrf_drv_aes_ctr_crypt(p_drbg->key, p_drbg->counter, p_provided, p_provided, DRBG_SEED_LEN);
+    if (result == NRF_SUCCESS)
+    {
+        memcpy(p_drbg->key, p_provided, NRF_DRV_AES_BLOCK_SIZE);
+        memcpy(p_drbg->counter, &p_provided[NRF_DRV_AES_BLOCK_SIZE], NRF_DRV_AES_BLOCK_SIZE);
+        drbg_counter_increment(p_drbg->counter);
+    }
+    memset(p_provided, 0, DRBG_SEED_LEN);
+    return result;
+}
+
+
+/* Instantiate, or reseed, from 32 bytes of the pool. */
+static ret_code_t drbg_seed(void)
+{
+    drbg_t   * p_drbg = &m_rng_cb.drbg;
+    uint8_t    seed[DRBG_SEED_LEN];
+    ret_code_t result;
+
+    result = pool_block_rand(seed, sizeof(seed));
+    if (result != NRF_SUCCESS)
+    {
+        return result;
+    }
+
+    if (p_drbg->reseed_counter == 0)
+    {
+        // Key 0 and V 0.
+        memset(p_drbg, 0, sizeof(drbg_t));
+        drbg_counter_increment(p_drbg->counter);
+    }
+
+    result = drbg_update(seed);
+    if (result == NRF_SUCCESS)
+    {
+        p_drbg->reseed_counter = 1;
+    }
+    return result;
+}
+
+
+/* CTR_DRBG_Generate, without additional input: the keystream from V + 1, then a key update. */
+static ret_code_t drbg_generate(uint8_t * p_buff, uint32_t length)
+{
+    drbg_t   * p_drbg = &m_rng_cb.drbg;
+    uint8_t    provided[DRBG_SEED_LEN];
+    ret_code_t result;
+
+    if ((p_drbg->reseed_counter == 0) || (p_drbg->reseed_counter > RNG_CONFIG_DRBG_RESEED_INTERVAL))
+    {
+        result = drbg_seed();
+        if (result != NRF_SUCCESS)
+        {
+            return result;
+        }
+    }
+
+    memset(p_buff, 0, length);
+    result = nrf_drv_aes_ctr_crypt(p_drbg->key, p_drbg->counter, p_buff, p_buff, length);
+    if (result != NRF_SUCCESS)
+    {
+        return result;
+    }
+
+    memset(provided, 0, sizeof(provided));
+    result = drbg_update(provided);
+    p_drbg->reseed_counter++;
+    return result;
+}
+#endif // RNG_CONFIG_DRBG_ENABLED
+
+
+ret_code_t nrf_drv_rng_block_rand(uint8_t * p_buff, uint32_t length)
+{
+    ASSERT(m_rng_cb.state == NRF_DRV_STATE_INITIALIZED);
+
+#if RNG_CONFIG_DRBG_ENABLED
+    ret_code_t result = NRF_SUCCESS;
+
+    while ((length > 0) && (result == NRF_SUCCESS))
+    {
+        uint32_t len = (length > DRBG_MAX_REQUEST) ? DRBG_MAX_REQUEST : length;
+
+        result  = drbg_generate(p_buff, len);
+        p_buff += len;
+        length -= len;
+    }
+    return result;
+#else
+    return pool_block_rand(p_buff, length);
+#endif // RNG_CONFIG_DRBG_ENABLED
+}
+
+
 #ifndef SOFTDEVICE_PRESENT
 void RNG_IRQHandler(void)
 {
@@ -20,6 +20,18 @@
 #include "sdk_errors.h"
 #include "nrf_drv_config.h"
 
+#ifndef RNG_CONFIG_POOL_WATERMARK
+#define RNG_CONFIG_POOL_WATERMARK RNG_CONFIG_POOL_SIZE  /**< Without a SoftDevice, the RNG is started when fewer bytes than this are in the pool, and then runs until the pool is full. */
+#endif
+
+#ifndef RNG_CONFIG_DRBG_ENABLED
+#define RNG_CONFIG_DRBG_ENABLED 0                       /**< If 1, @ref nrf_drv_rng_block_rand returns the output of a CTR-DRBG seeded from the pool. Requires @ref nrf_drv_aes. */
+#endif
+
+#ifndef RNG_CONFIG_DRBG_RESEED_INTERVAL
+#define RNG_CONFIG_DRBG_RESEED_INTERVAL 1024            /**< Number of @ref nrf_drv_rng_block_rand calls between two reseeds of the CTR-DRBG from the pool. */
+#endif
+
 /**
  * @addtogroup nrf_rng RNG HAL and driver
  * @ingroup nrf_drivers
@@ -31,6 +43,13 @@
  * @{
  * @ingroup nrf_rng
  * @brief Driver for managing the random number generator (RNG).
+ *
+ * @details Without a SoftDevice, the random bytes are kept in a pool of @ref RNG_CONFIG_POOL_SIZE
+ *          bytes, refilled in the background. With @ref RNG_CONFIG_DRBG_ENABLED, bulk requests
+ *          through @ref nrf_drv_rng_block_rand are served by a CTR-DRBG (NIST SP 800-90A, AES-128
+ *          without derivation function), so they do not wait for the peripheral. The DRBG is
+ *          seeded with 32 bytes from the pool on the first request and reseeded every
+ *          @ref RNG_CONFIG_DRBG_RESEED_INTERVAL requests.
  */
 
 /**@brief Struct for RNG configuration. */
@@ -100,12 +119,15 @@ ret_code_t nrf_drv_rng_rand(uint8_t * p_buff, uint8_t length);
  * @brief Blocking function for getting an arbitrary array of random numbers.
  *
  * @note This function may execute for a substantial amount of time depending on the length of the buffer
- *       required and on the state of the current internal pool of random numbers.
+ *       required and on the state of the current internal pool of random numbers. With
+ *       @ref RNG_CONFIG_DRBG_ENABLED, it only waits for the pool when the DRBG is seeded or
+ *       reseeded, and @ref nrf_drv_aes must be used in blocking mode. The function is not reentrant.
  *
  * @param[out] p_buff                               Pointer to uint8_t buffer for storing the bytes.
  * @param[in]  length                               Number of bytes place in p_buff.
  *
  * @retval     NRF_SUCCESS                          If the requested bytes were written to p_buff.
+ * @return     With @ref RNG_CONFIG_DRBG_ENABLED, an error returned by @ref nrf_drv_aes_ctr_crypt.
  */
 ret_code_t nrf_drv_rng_block_rand(uint8_t * p_buff, uint32_t length);
 
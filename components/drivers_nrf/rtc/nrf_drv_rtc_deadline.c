@@ -0,0 +1,333 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "nrf_drv_rtc_deadline.h"
+#include <stddef.h>
+#include "nrf_error.h"
+#include "nrf_rtc.h"
+#include "nordic_common.h"
+#include "app_util_platform.h"
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+#include "nrf_drv_ppi.h"
+#endif
+
+static nrf_drv_rtc_t            m_rtc;          /**< RTC instance. */
+static nrf_drv_rtc_handler_t    m_handler;      /**< Handler of the other RTC events. */
+static uint32_t                 m_cc_channel;   /**< Compare channel of the deadlines. */
+static nrf_drv_rtc_deadline_t * mp_head;        /**< Queue of the pending deadlines. */
+static nrf_drv_rtc_deadline_t * mp_armed;       /**< Deadline programmed in the compare channel. */
+static bool                     m_initialized;
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+static nrf_ppi_channel_t        m_ppi_channel;  /**< PPI channel connecting the compare event to the task of mp_armed. */
+#endif
+
+/**@brief Function for computing the ticks from one counter value to another. */
+__STATIC_INLINE uint32_t ticks_diff(uint32_t to, uint32_t from)
+{
+    return RTC_WRAP((to - from));
+}
+
+/**@brief Function for checking if a tick is reached, within half the counter range. */
+__STATIC_INLINE bool tick_reached(uint32_t tick, uint32_t now)
+{
+    return ticks_diff(now, tick) <= NRF_DRV_RTC_DEADLINE_MAX_TICKS;
+}
+
+/**@brief Function for programming the first deadline in the compare channel.
+ *
+ * @details Must be called in a critical region, every time the head of the queue changes.
+ */
+static void head_arm(void)
+{
+    if ((mp_head != NULL) && (mp_head == mp_armed))
+    {
+        return;
+    }
+
+    uint32_t task = 0;
+
+    if (nrf_drv_rtc_cc_disable(&m_rtc, m_cc_channel) == NRF_ERROR_TIMEOUT && (mp_armed != NULL))
+    {
+        // The armed deadline expired before its interrupt was handled, and its task was
+        // triggered. Keep it armed, so it is removed without triggering the task again.
+    }
+    else
+    {
+        mp_armed = mp_head;
+        if (mp_head == NULL)
+        {
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+            (void)nrf_drv_ppi_channel_disable(m_ppi_channel);
+#endif
+            return;
+        }
+        task = mp_head->task;
+    }
+
+    // The compare event is missed if the compare value is less than 2 ticks ahead.
+    uint32_t const now  = nrf_drv_rtc_counter_get(&m_rtc);
+    uint32_t       tick = mp_armed->tick;
+
+    if (tick_reached(tick, now) || (ticks_diff(tick, now) < NRF_DRV_RTC_DEADLINE_MIN_TICKS))
+    {
+        tick = now + NRF_DRV_RTC_DEADLINE_MIN_TICKS;
+    }
+
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+    if (task != 0)
+    {
+        nrf_rtc_event_t const event = RTC_CHANNEL_EVENT_ADDR(m_cc_channel);
+
+        (void)nrf_drv_ppi_channel_assign(m_ppi_channel,
+                                         nrf_drv_rtc_event_address_get(&m_rtc, event),
+                                         task);
+        (void)nrf_drv_ppi_channel_enable(m_ppi_channel);
+    }
+    else
+    {
+        (void)nrf_drv_ppi_channel_disable(m_ppi_channel);
+    }
+#else
+    UNUSED_VARIABLE(task);
+#endif
+    (void)nrf_drv_rtc_cc_set(&m_rtc, m_cc_channel, tick, true);
+}
+
+/**@brief Function for handling the compare event of the deadlines.
+ *
+ * @details The expired deadlines are removed from the queue one by one, and their handlers are
+ *          called outside of the critical region. The first one was triggered by the compare
+ *          event. The tasks of the next ones, which expired while the handlers were running, are
+ *          triggered here.
+ */
+static void deadlines_expire(void)
+{
+    bool hw_triggered = true;
+
+    for (;;)
+    {
+        nrf_drv_rtc_deadline_t * p_expired = NULL;
+
+        CRITICAL_REGION_ENTER();
+        if (hw_triggered && (mp_armed != NULL) && (mp_armed == mp_head))
+        {
+            // Expired deadlines stay ahead of the started ones, so mp_armed is the head.
+            p_expired = mp_armed;
+            mp_armed  = NULL;
+        }
+        else if ((mp_head != NULL) &&
+                 (tick_reached(mp_head->tick, nrf_drv_rtc_counter_get(&m_rtc))) &&
+                 (mp_head != mp_armed))
+        {
+            p_expired = mp_head;
+            if (p_expired->task != 0)
+            {
+                *(volatile uint32_t *)p_expired->task = 1;
+            }
+        }
+
+        if (p_expired != NULL)
+        {
+            mp_head            = p_expired->p_next;
+            p_expired->p_next  = NULL;
+            p_expired->pending = false;
+        }
+        else
+        {
+            head_arm();
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (p_expired == NULL)
+        {
+            break;
+        }
+        hw_triggered = false;
+
+        if (p_expired->handler != NULL)
+        {
+            p_expired->handler(p_expired->p_context);
+        }
+    }
+}
+
+static void rtc_handler(nrf_drv_rtc_int_type_t int_type)
+{
+    if ((uint32_t)int_type == (uint32_t)NRF_DRV_RTC_INT_COMPARE0 + m_cc_channel)
+    {
+        deadlines_expire();
+    }
+    else if (m_handler != NULL)
+    {
+        m_handler(int_type);
+    }
+}
+
+ret_code_t nrf_drv_rtc_deadline_init(nrf_drv_rtc_t const *        p_instance,
+                                     nrf_drv_rtc_config_t const * p_config,
+                                     uint32_t                     cc_channel,
+                                     nrf_drv_rtc_handler_t        handler)
+{
+    ret_code_t err_code;
+
+    if (m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (cc_channel >= p_instance->cc_channel_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+    err_code = nrf_drv_ppi_channel_alloc(&m_ppi_channel);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+#endif
+
+    m_rtc        = *p_instance;
+    m_handler    = handler;
+    m_cc_channel = cc_channel;
+    mp_head      = NULL;
+    mp_armed     = NULL;
+
+    err_code = nrf_drv_rtc_init(&m_rtc, p_config, rtc_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+        (void)nrf_drv_ppi_channel_free(m_ppi_channel);
+#endif
+        return err_code;
+    }
+    nrf_drv_rtc_enable(&m_rtc);
+
+    m_initialized = true;
+    return NRF_SUCCESS;
+}
+
+void nrf_drv_rtc_deadline_uninit(void)
+{
+    if (!m_initialized)
+    {
+        return;
+    }
+
+    nrf_drv_rtc_uninit(&m_rtc);
+#if NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+    (void)nrf_drv_ppi_channel_free(m_ppi_channel);
+#endif
+
+    while (mp_head != NULL)
+    {
+        mp_head->pending = false;
+        mp_head          = mp_head->p_next;
+    }
+    mp_armed      = NULL;
+    m_initialized = false;
+}
+
+ret_code_t nrf_drv_rtc_deadline_create(nrf_drv_rtc_deadline_t *       p_deadline,
+                                       nrf_drv_rtc_deadline_handler_t handler,
+                                       void *                         p_context,
+                                       uint32_t                       task)
+{
+    if (p_deadline == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+#if !NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+    if (task != 0)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+#endif
+
+    p_deadline->p_next    = NULL;
+    p_deadline->handler   = handler;
+    p_deadline->p_context = p_context;
+    p_deadline->task      = task;
+    p_deadline->tick      = 0;
+    p_deadline->pending   = false;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_drv_rtc_deadline_start(nrf_drv_rtc_deadline_t * p_deadline, uint32_t ticks)
+{
+    ret_code_t err_code = NRF_SUCCESS;
+
+    if ((ticks == 0) || (ticks > NRF_DRV_RTC_DEADLINE_MAX_TICKS))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (!m_initialized || p_deadline->pending)
+    {
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        uint32_t const now = nrf_drv_rtc_counter_get(&m_rtc);
+
+        p_deadline->tick    = RTC_WRAP((now + ticks));
+        p_deadline->pending = true;
+
+        // Deadlines with the same expiry tick expire in the order they were started.
+        nrf_drv_rtc_deadline_t ** pp_prev = &mp_head;
+        while ((*pp_prev != NULL) &&
+               (tick_reached((*pp_prev)->tick, now) || (ticks_diff((*pp_prev)->tick, now) <= ticks)))
+        {
+            pp_prev = &(*pp_prev)->p_next;
+        }
+        p_deadline->p_next = *pp_prev;
+        *pp_prev           = p_deadline;
+
+        head_arm();
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+ret_code_t nrf_drv_rtc_deadline_stop(nrf_drv_rtc_deadline_t * p_deadline)
+{
+    ret_code_t err_code = NRF_ERROR_INVALID_STATE;
+
+    CRITICAL_REGION_ENTER();
+    if (p_deadline->pending)
+    {
+        nrf_drv_rtc_deadline_t ** pp_prev = &mp_head;
+        while ((*pp_prev != NULL) && (*pp_prev != p_deadline))
+        {
+            pp_prev = &(*pp_prev)->p_next;
+        }
+        if (*pp_prev == p_deadline)
+        {
+            *pp_prev            = p_deadline->p_next;
+            p_deadline->p_next  = NULL;
+            p_deadline->pending = false;
+            err_code            = NRF_SUCCESS;
+
+            if (mp_armed == p_deadline)
+            {
+                mp_armed = NULL;
+            }
+            head_arm();
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef NRF_DRV_RTC_DEADLINE_H
+#define NRF_DRV_RTC_DEADLINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_drv_rtc.h"
+#include "sdk_errors.h"
+
+/**
+ * @defgroup nrf_drv_rtc_deadline RTC virtual compare channels
+ * @{
+ * @ingroup nrf_rtc
+ * @brief Any number of deadlines multiplexed on one compare channel of an RTC instance.
+ *
+ * @details The pending deadlines are kept in a queue sorted by expiry tick, and only the first
+ *          one is programmed in the compare channel. When it expires, its handler is called from
+ *          the RTC interrupt and the next deadline is programmed.
+ *
+ *          A deadline can also trigger a task of any peripheral. The compare event is connected
+ *          to the task of the first deadline through a PPI channel, so the task is triggered on
+ *          the exact tick, whatever the interrupt latency. The interrupt only advances the queue.
+ *
+ *          Deadlines are limited to half the counter range, 2^23 ticks. A deadline that is less
+ *          than @ref NRF_DRV_RTC_DEADLINE_MIN_TICKS ticks away when it reaches the head of the
+ *          queue is delayed to that distance, so it is never triggered early.
+ */
+
+#ifndef NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+#define NRF_DRV_RTC_DEADLINE_PPI_ENABLED 1  /**< Enable deadlines triggering a task. Requires the PPI driver. */
+#endif
+
+#define NRF_DRV_RTC_DEADLINE_MIN_TICKS   3  /**< Smallest distance at which a compare value is programmed. */
+
+#define NRF_DRV_RTC_DEADLINE_MAX_TICKS   (RTC_COUNTER_COUNTER_Msk >> 1) /**< Longest deadline, in ticks. */
+
+/**@brief Deadline handler type. Called from the RTC interrupt. */
+typedef void (*nrf_drv_rtc_deadline_handler_t)(void * p_context);
+
+typedef struct nrf_drv_rtc_deadline_s nrf_drv_rtc_deadline_t;
+
+/**@brief Deadline. The fields are internal to the driver. */
+struct nrf_drv_rtc_deadline_s
+{
+    nrf_drv_rtc_deadline_t       * p_next;    /**< Next deadline of the queue. */
+    nrf_drv_rtc_deadline_handler_t handler;   /**< Handler, or NULL. */
+    void                         * p_context; /**< Handler context. */
+    uint32_t                       task;      /**< Address of the task to trigger, or 0. */
+    uint32_t                       tick;      /**< Expiry tick. */
+    bool                           pending;   /**< Deadline is in the queue. */
+};
+
+/**@brief Function for initializing the driver and starting the RTC instance.
+ *
+ * @details The RTC driver instance is initialized and enabled by this function. Its events, except
+ *          the compare events of cc_channel, are passed to handler. If
+ *          @ref NRF_DRV_RTC_DEADLINE_PPI_ENABLED is set, a PPI channel is allocated, so the PPI
+ *          driver must be initialized first.
+ *
+ * @param[in] p_instance  RTC instance.
+ * @param[in] p_config    RTC configuration. Default configuration used if NULL.
+ * @param[in] cc_channel  Compare channel used for the deadlines.
+ * @param[in] handler     Handler of the other RTC events, or NULL.
+ *
+ * @retval NRF_SUCCESS              If the driver was initialized.
+ * @retval NRF_ERROR_INVALID_STATE  If the driver or the RTC instance is already initialized.
+ * @retval NRF_ERROR_INVALID_PARAM  If cc_channel is not a channel of the instance.
+ * @retval NRF_ERROR_NO_MEM         If no PPI channel is available.
+ */
+ret_code_t nrf_drv_rtc_deadline_init(nrf_drv_rtc_t const *        p_instance,
+                                     nrf_drv_rtc_config_t const * p_config,
+                                     uint32_t                     cc_channel,
+                                     nrf_drv_rtc_handler_t        handler);
+
+/**@brief Function for uninitializing the driver and the RTC instance.
+ *
+ * @details The pending deadlines are discarded.
+ */
+void nrf_drv_rtc_deadline_uninit(void);
+
+/**@brief Function for initializing a deadline.
+ *
+ * @param[out] p_deadline  Deadline.
+ * @param[in]  handler     Handler called when the deadline expires, or NULL.
+ * @param[in]  p_context   Handler context.
+ * @param[in]  task        Address of the task triggered when the deadline expires, or 0.
+ *
+ * @retval NRF_SUCCESS              If the deadline was initialized.
+ * @retval NRF_ERROR_NULL           If p_deadline is NULL.
+ * @retval NRF_ERROR_NOT_SUPPORTED  If a task is given and @ref NRF_DRV_RTC_DEADLINE_PPI_ENABLED
+ *                                  is not set.
+ */
+ret_code_t nrf_drv_rtc_deadline_create(nrf_drv_rtc_deadline_t *       p_deadline,
+                                       nrf_drv_rtc_deadline_handler_t handler,
+                                       void *                         p_context,
+                                       uint32_t                       task);
+
+/**@brief Function for starting a deadline.
+ *
+ * @details Can be called from the handler of a deadline, to restart it.
+ *
+ * @param[in] p_deadline  Deadline.
+ * @param[in] ticks       Ticks from now, from 1 to @ref NRF_DRV_RTC_DEADLINE_MAX_TICKS.
+ *
+ * @retval NRF_SUCCESS              If the deadline was started.
+ * @retval NRF_ERROR_INVALID_STATE  If the driver is not initialized or the deadline is pending.
+ * @retval NRF_ERROR_INVALID_PARAM  If ticks is out of range.
+ */
+ret_code_t nrf_drv_rtc_deadline_start(nrf_drv_rtc_deadline_t * p_deadline, uint32_t ticks);
+
+/**@brief Function for stopping a pending deadline.
+ *
+ * @details A deadline stopped less than @ref NRF_DRV_RTC_DEADLINE_MIN_TICKS ticks before it
+ *          expires may still have triggered its task.
+ *
+ * @param[in] p_deadline  Deadline.
+ *
+ * @retval NRF_SUCCESS              If the deadline was stopped.
+ * @retval NRF_ERROR_INVALID_STATE  If the deadline is not pending.
+ */
+ret_code_t nrf_drv_rtc_deadline_stop(nrf_drv_rtc_deadline_t * p_deadline);
+
+/**@brief Function for checking if a deadline is pending. */
+__STATIC_INLINE bool nrf_drv_rtc_deadline_is_pending(nrf_drv_rtc_deadline_t const * p_deadline)
+{
+    return p_deadline->pending;
+}
+
+/** @} */
+
+#endif // NRF_DRV_RTC_DEADLINE_H
@@ -15,6 +15,9 @@
 #include "nordic_common.h"
 #include "nrf_drv_common.h"
 #include "app_util_platform.h"
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+#include "nrf_drv_ppi.h"
+#endif
 
 
 typedef enum
@@ -51,6 +54,16 @@ typedef struct
     uint8_t                       scan_pos;                      ///< Current channel scanning position.
 #endif
     uint8_t                       active_channels;               ///< Number of enabled SAADC channels.
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+    nrf_drv_saadc_continuous_config_t continuous;                ///< Continuous sampling configuration.
+    volatile uint32_t             free_mask;                     ///< Ring buffers not owned by the application.
+    uint32_t                      overrun_count;                 ///< Number of buffers lost in continuous mode.
+    nrf_ppi_channel_t             ppi_sample;                    ///< PPI channel connecting the timer to the SAMPLE task.
+    nrf_ppi_channel_t             ppi_restart;                   ///< PPI channel connecting the END event to the START task.
+    volatile bool                 continuous_on;                 ///< True if continuous sampling is ongoing.
+    uint8_t                       fill_idx;                      ///< Ring buffer being filled.
+    uint8_t                       next_idx;                      ///< Ring buffer set up for the next conversion.
+#endif
 } nrf_drv_saadc_cb_t;
 
 static nrf_drv_saadc_cb_t m_cb;
@@ -64,8 +77,117 @@ static nrf_drv_saadc_cb_t m_cb;
 #define HW_TIMEOUT 10000
 
 
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+static nrf_saadc_value_t * ring_buffer_get(uint8_t idx)
+{
+    return m_cb.continuous.p_buffer + (uint32_t)idx * m_cb.continuous.buffer_size;
+}
+
+
+// Averages groups of 'decimation' consecutive scans in place and returns the
+// number of the resulting samples.
+static uint16_t ring_buffer_decimate(nrf_saadc_value_t * p_buffer)
+{
+    uint8_t  decimation = m_cb.continuous.decimation;
+    uint8_t  channels   = m_cb.active_channels;
+    uint16_t size       = m_cb.continuous.buffer_size / decimation;
+    uint16_t out;
+
+    if (decimation == 1)
+    {
+        return m_cb.continuous.buffer_size;
+    }
+
+    for (out = 0; out < size; ++out)
+    {
+        nrf_saadc_value_t const * p_in = &p_buffer[(out / channels) * channels * decimation +
+                                                   (out % channels)];
+        int32_t sum = 0;
+        uint8_t i;
+
+        for (i = 0; i < decimation; ++i)
+        {
+            sum += p_in[i * channels];
+        }
+        p_buffer[out] = (nrf_saadc_value_t)(sum / decimation);
+    }
+
+    return size;
+}
+
+
+static void continuous_irq_handler(void)
+{
+    // [END of the previous conversion has to be handled before STARTED of the
+    //  next one, if both are pending]
+    if (nrf_saadc_event_check(NRF_SAADC_EVENT_END))
+    {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+        nrf_drv_saadc_evt_t evt;
+        uint8_t fill_idx = m_cb.fill_idx;
+
+        if (m_cb.next_idx == fill_idx)
+        {
+            // No buffer was available and the conversion was restarted into
+            // the same buffer.
+            evt.type = NRF_DRV_SAADC_EVT_OVERRUN;
+            evt.data.overrun.count = ++m_cb.overrun_count;
+        }
+        else
+        {
+            nrf_saadc_value_t * p_buffer = ring_buffer_get(fill_idx);
+
+            evt.type = NRF_DRV_SAADC_EVT_DONE;
+            evt.data.done.p_buffer = p_buffer;
+            evt.data.done.size = ring_buffer_decimate(p_buffer);
+            m_cb.fill_idx = m_cb.next_idx;
+        }
+        m_cb.event_handler(&evt);
+    }
+
+    if (nrf_saadc_event_check(NRF_SAADC_EVENT_STARTED))
+    {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+
+        // The buffer address has been latched, so the one for the next
+        // conversion can be set up already.
+        uint8_t next_idx = m_cb.fill_idx + 1;
+        if (next_idx == m_cb.continuous.buffer_count)
+        {
+            next_idx = 0;
+        }
+
+        CRITICAL_REGION_ENTER();
+        if (m_cb.free_mask & (1UL << next_idx))
+        {
+            m_cb.free_mask &= ~(1UL << next_idx);
+        }
+        else
+        {
+            next_idx = m_cb.fill_idx;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (next_idx != m_cb.fill_idx)
+        {
+            nrf_saadc_buffer_init(ring_buffer_get(next_idx), m_cb.continuous.buffer_size);
+        }
+        m_cb.next_idx = next_idx;
+    }
+}
+#endif // (SAADC_CONTINUOUS_SUPPORT == 1)
+
+
 void SAADC_IRQHandler(void)
 {
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+    if (m_cb.continuous_on)
+    {
+        continuous_irq_handler();
+    }
+    else
+#endif
     if (nrf_saadc_event_check(NRF_SAADC_EVENT_END))
     {
         nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
@@ -208,6 +330,9 @@ ret_code_t nrf_drv_saadc_init(nrf_drv_saadc_config_t const * p_config,
 #ifdef NRF52_PAN_28
     m_cb.buffer_pos = 0;
 #endif
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+    m_cb.continuous_on = false;
+#endif
 
     nrf_saadc_int_disable(NRF_SAADC_INT_ALL);
     nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
@@ -223,6 +348,9 @@ ret_code_t nrf_drv_saadc_init(nrf_drv_saadc_config_t const * p_config,
 void nrf_drv_saadc_uninit(void)
 {
     ASSERT(m_cb.state != NRF_DRV_STATE_UNINITIALIZED);
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+    nrf_drv_saadc_continuous_stop();
+#endif
     nrf_drv_common_irq_disable(SAADC_IRQn);
     nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
 
@@ -431,6 +559,212 @@ ret_code_t nrf_drv_saadc_buffer_convert(nrf_saadc_value_t * p_buffer, uint16_t s
     return NRF_SUCCESS;
 }
 
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+static void continuous_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+
+static ret_code_t continuous_resources_setup(uint8_t interrupt_priority)
+{
+    nrf_drv_timer_t const * p_timer = m_cb.continuous.p_timer;
+    nrf_drv_timer_config_t  timer_config;
+    ret_code_t              err_code;
+
+    err_code = nrf_drv_ppi_init();
+    if ((err_code != NRF_SUCCESS) && (err_code != MODULE_ALREADY_INITIALIZED))
+    {
+        return err_code;
+    }
+
+    timer_config.frequency          = NRF_TIMER_FREQ_16MHz;
+    timer_config.mode               = NRF_TIMER_MODE_TIMER;
+    timer_config.bit_width          = NRF_TIMER_BIT_WIDTH_32;
+    timer_config.interrupt_priority = interrupt_priority;
+    timer_config.p_context          = NULL;
+    err_code = nrf_drv_timer_init(p_timer, &timer_config, continuous_timer_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    err_code = nrf_drv_ppi_channel_alloc(&m_cb.ppi_sample);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_alloc(&m_cb.ppi_restart);
+        if (err_code != NRF_SUCCESS)
+        {
+            (void)nrf_drv_ppi_channel_free(m_cb.ppi_sample);
+        }
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        nrf_drv_timer_uninit(p_timer);
+        return err_code;
+    }
+
+    nrf_drv_timer_extended_compare(p_timer,
+                                   NRF_TIMER_CC_CHANNEL0,
+                                   nrf_drv_timer_us_to_ticks(p_timer, m_cb.continuous.interval_us),
+                                   NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
+                                   false);
+
+    err_code = nrf_drv_ppi_channel_assign(m_cb.ppi_sample,
+                                          nrf_drv_timer_compare_event_address_get(p_timer, 0),
+                                          nrf_saadc_task_address_get(NRF_SAADC_TASK_SAMPLE));
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_assign(m_cb.ppi_restart,
+                       (uint32_t)nrf_saadc_event_address_get(NRF_SAADC_EVENT_END),
+                       nrf_saadc_task_address_get(NRF_SAADC_TASK_START));
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        (void)nrf_drv_ppi_channel_free(m_cb.ppi_restart);
+        (void)nrf_drv_ppi_channel_free(m_cb.ppi_sample);
+        nrf_drv_timer_uninit(p_timer);
+    }
+    return err_code;
+}
+
+
+ret_code_t nrf_drv_saadc_continuous_start(nrf_drv_saadc_continuous_config_t const * p_config)
+{
+    ASSERT(m_cb.state != NRF_DRV_STATE_UNINITIALIZED);
+    ASSERT(p_config);
+
+    ret_code_t err_code;
+    uint8_t    channel = 0;
+
+    if ((p_config->p_buffer == NULL) || (p_config->p_timer == NULL) ||
+        (p_config->buffer_count < 2) || (p_config->buffer_count > 32) ||
+        (p_config->decimation == 0) || (m_cb.active_channels == 0) ||
+        (p_config->buffer_size == 0) ||
+        ((p_config->buffer_size % (m_cb.active_channels * p_config->decimation)) != 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+#ifdef NRF52_PAN_28
+    // Scan mode is emulated by interrupts, which cannot be combined with
+    // restarting conversions through PPI.
+    if (m_cb.active_channels > 1)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+    while (!m_cb.psel[channel].pselp)
+    {
+        ++channel;
+    }
+#endif
+
+    nrf_saadc_int_disable(NRF_SAADC_INT_END);
+    if (m_cb.adc_state == NRF_SAADC_STATE_BUSY)
+    {
+        nrf_saadc_int_enable(NRF_SAADC_INT_END);
+        return NRF_ERROR_BUSY;
+    }
+    m_cb.adc_state = NRF_SAADC_STATE_BUSY;
+
+    m_cb.continuous = *p_config;
+    err_code = continuous_resources_setup(NVIC_GetPriority(SAADC_IRQn));
+    if (err_code != NRF_SUCCESS)
+    {
+        m_cb.adc_state = NRF_SAADC_STATE_IDLE;
+        nrf_saadc_int_enable(NRF_SAADC_INT_END);
+        return err_code;
+    }
+
+#ifdef NRF52_PAN_28
+    nrf_saadc_channel_input_set(channel, m_cb.psel[channel].pselp, m_cb.psel[channel].pseln);
+#else
+    UNUSED_VARIABLE(channel);
+#endif
+
+    m_cb.free_mask     = ((p_config->buffer_count == 32) ? 0xFFFFFFFFUL :
+                          ((1UL << p_config->buffer_count) - 1)) & ~1UL;
+    m_cb.overrun_count = 0;
+    m_cb.fill_idx      = 0;
+    m_cb.next_idx      = 0;
+    m_cb.continuous_on = true;
+
+    nrf_saadc_buffer_init(ring_buffer_get(0), p_config->buffer_size);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+    nrf_saadc_int_enable(NRF_SAADC_INT_END | NRF_SAADC_INT_STARTED);
+    (void)nrf_drv_ppi_channel_enable(m_cb.ppi_restart);
+    (void)nrf_drv_ppi_channel_enable(m_cb.ppi_sample);
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+    nrf_drv_timer_enable(p_config->p_timer);
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_saadc_buffer_release(nrf_saadc_value_t * p_buffer)
+{
+    ASSERT(p_buffer >= m_cb.continuous.p_buffer);
+
+    uint8_t idx = (uint8_t)((uint32_t)(p_buffer - m_cb.continuous.p_buffer) /
+                            m_cb.continuous.buffer_size);
+
+    ASSERT(idx < m_cb.continuous.buffer_count);
+
+    // [the buffer is set up in the next STARTED interrupt, writing the buffer
+    //  address here could race with a restart done through PPI]
+    CRITICAL_REGION_ENTER();
+    m_cb.free_mask |= (1UL << idx);
+    CRITICAL_REGION_EXIT();
+}
+
+
+void nrf_drv_saadc_continuous_stop(void)
+{
+    if (!m_cb.continuous_on)
+    {
+        return;
+    }
+
+    nrf_drv_timer_disable(m_cb.continuous.p_timer);
+    (void)nrf_drv_ppi_channel_disable(m_cb.ppi_sample);
+    (void)nrf_drv_ppi_channel_disable(m_cb.ppi_restart);
+
+    nrf_saadc_int_disable(NRF_SAADC_INT_END | NRF_SAADC_INT_STARTED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+
+    // Wait for ADC being stopped.
+    uint32_t timeout = HW_TIMEOUT;
+    while (nrf_saadc_event_check(NRF_SAADC_EVENT_STOPPED) == 0 && timeout > 0)
+    {
+        --timeout;
+    }
+    ASSERT(timeout > 0);
+
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+    (void)nrf_drv_ppi_channel_free(m_cb.ppi_sample);
+    (void)nrf_drv_ppi_channel_free(m_cb.ppi_restart);
+    nrf_drv_timer_uninit(m_cb.continuous.p_timer);
+
+#ifdef NRF52_PAN_28
+    for (uint8_t i = 0; i < NRF_SAADC_CHANNEL_COUNT; ++i)
+    {
+        nrf_saadc_channel_input_set(i, NRF_SAADC_INPUT_DISABLED, NRF_SAADC_INPUT_DISABLED);
+    }
+#endif
+
+    m_cb.continuous_on = false;
+    m_cb.adc_state = NRF_SAADC_STATE_IDLE;
+    nrf_saadc_int_enable(NRF_SAADC_INT_END);
+}
+#endif // (SAADC_CONTINUOUS_SUPPORT == 1)
+
+
 ret_code_t nrf_drv_saadc_sample()
 {
     ASSERT(m_cb.state != NRF_DRV_STATE_UNINITIALIZED);
@@ -30,6 +30,9 @@
 #include "nrf_drv_config.h"
 #include "nrf_saadc.h"
 #include "sdk_errors.h"
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+#include "nrf_drv_timer.h"
+#endif
 
 /**
  * @brief Value that should be set as high limit to disable limit detection.
@@ -104,6 +107,7 @@ typedef enum
 {
     NRF_DRV_SAADC_EVT_DONE,    ///< Event generated when the buffer is filled with samples.
     NRF_DRV_SAADC_EVT_LIMIT,   ///< Event generated after one of the limits is reached.
+    NRF_DRV_SAADC_EVT_OVERRUN, ///< Event generated when a buffer of samples is lost in continuous mode.
 } nrf_drv_saadc_evt_type_t;
 
 /**
@@ -124,6 +128,14 @@ typedef struct
     nrf_saadc_limit_t        limit_type; ///< Type of limit detected.
 } nrf_drv_saadc_limit_evt_t;
 
+/**
+ * @brief Analog-to-digital converter driver overrun event data.
+ */
+typedef struct
+{
+    uint32_t                 count;      ///< Number of buffers lost since continuous sampling was started.
+} nrf_drv_saadc_overrun_evt_t;
+
 /**
  * @brief Analog-to-digital converter driver event structure.
  */
@@ -134,6 +146,7 @@ typedef struct
     {
         nrf_drv_saadc_done_evt_t  done; ///< Data for @ref NRF_DRV_SAADC_EVT_DONE event.
         nrf_drv_saadc_limit_evt_t limit;///< Data for @ref NRF_DRV_SAADC_EVT_LIMIT event.
+        nrf_drv_saadc_overrun_evt_t overrun; ///< Data for @ref NRF_DRV_SAADC_EVT_OVERRUN event.
     } data;
 } nrf_drv_saadc_evt_t;
 
@@ -146,6 +159,21 @@ typedef struct
  */
 typedef void (*nrf_drv_saadc_event_handler_t)(nrf_drv_saadc_evt_t const * p_event);
 
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+/**
+ * @brief Continuous sampling configuration structure.
+ */
+typedef struct
+{
+    nrf_saadc_value_t     * p_buffer;     ///< Memory for the ring of buffers (buffer_count * buffer_size words).
+    uint16_t                buffer_size;  ///< Size of a single buffer in words. It must be a multiple of the number of enabled channels times decimation.
+    uint8_t                 buffer_count; ///< Number of buffers, from 2 to 32.
+    uint8_t                 decimation;   ///< Number of consecutive samples of each channel averaged into one reported sample. 1 disables decimation.
+    uint32_t                interval_us;  ///< Sampling interval.
+    nrf_drv_timer_t const * p_timer;      ///< Timer instance used to trigger sampling.
+} nrf_drv_saadc_continuous_config_t;
+#endif
+
 /**
  * @brief Function for initializing the SAADC.
  *
@@ -241,6 +269,51 @@ ret_code_t nrf_drv_saadc_sample_convert(uint8_t channel, nrf_saadc_value_t * p_v
  */
 ret_code_t nrf_drv_saadc_buffer_convert(nrf_saadc_value_t * buffer, uint16_t size);
 
+#if (SAADC_CONTINUOUS_SUPPORT == 1)
+/**
+ * @brief Function for starting continuous sampling into a ring of buffers.
+ *
+ * The timer triggers the SAMPLE task through PPI, and the END event restarts the conversion
+ * through PPI, so sampling goes on without CPU involvement. Conversion is done on all enabled
+ * channels. The next buffer in the ring is set up in the STARTED interrupt, and each filled
+ * buffer is reported with @ref NRF_DRV_SAADC_EVT_DONE. If decimation is enabled, the reported
+ * buffer holds buffer_size / decimation averaged samples.
+ *
+ * A reported buffer belongs to the application until it is returned with
+ * @ref nrf_drv_saadc_buffer_release. If the next buffer in the ring has not been returned when
+ * it is needed, the current buffer is filled again, its previous content is lost, and
+ * @ref NRF_DRV_SAADC_EVT_OVERRUN is generated instead of @ref NRF_DRV_SAADC_EVT_DONE.
+ *
+ * The timer instance must be enabled in nrf_drv_config.h and must not be initialized by the
+ * application. The interrupt latency must be shorter than the time needed to fill one buffer.
+ *
+ * @param[in] p_config Continuous sampling configuration. It is copied by the driver.
+ *
+ * @retval NRF_SUCCESS             If sampling was started.
+ * @retval NRF_ERROR_BUSY          If the ADC is busy.
+ * @retval NRF_ERROR_INVALID_PARAM If the configuration is invalid.
+ * @retval NRF_ERROR_NOT_SUPPORTED If more than one channel is enabled and scan mode has to be
+ *                                 emulated (PAN-28).
+ * @return Error code returned by the timer or PPI driver.
+ */
+ret_code_t nrf_drv_saadc_continuous_start(nrf_drv_saadc_continuous_config_t const * p_config);
+
+/**
+ * @brief Function for returning a buffer reported in continuous mode to the driver.
+ *
+ * @param[in] p_buffer Buffer from @ref NRF_DRV_SAADC_EVT_DONE event.
+ */
+void nrf_drv_saadc_buffer_release(nrf_saadc_value_t * p_buffer);
+
+/**
+ * @brief Function for stopping continuous sampling.
+ *
+ * Samples in the buffer that is being filled are discarded. The timer and PPI channels are
+ * released.
+ */
+void nrf_drv_saadc_continuous_stop(void);
+#endif
+
 /**
  * @brief Function for retrieving the SAADC state.
  *
@@ -82,6 +82,13 @@ typedef struct
     volatile uint8_t *            rx_buffer;       //!< SPI slave RX buffer.
     nrf_drv_state_t               state;           //!< driver initialization state.
     volatile nrf_drv_spis_state_t spi_state;       //!< SPI slave state.
+    nrf_drv_spis_ring_buffers_t const * p_ring;    //!< Buffer ring, NULL if not used.
+    uint8_t                       ring_count;      //!< Number of buffers in the ring.
+    uint8_t                       ring_next;       //!< Index of the next buffers to set.
+    uint8_t                       ring_xfer;       //!< Index of the buffers set for the transaction.
+    volatile uint8_t              ring_held;       //!< Number of buffers held by the application.
+    volatile bool                 ring_xfer_set;   //!< Buffers are set for the transaction.
+    volatile bool                 ring_waiting;    //!< Semaphore held, waiting for buffers to be released.
 } spis_cb_t;
 
 static spis_cb_t m_cb[SPIS_COUNT];
@@ -201,6 +208,7 @@ ret_code_t nrf_drv_spis_init(nrf_drv_spis_t const * const  p_instance,
     
     m_cb[p_instance->instance_id].spi_state = SPIS_STATE_INIT;
     m_cb[p_instance->instance_id].handler = event_handler;
+    m_cb[p_instance->instance_id].p_ring  = NULL;
 
     
     // Enable IRQ.
@@ -233,7 +241,8 @@ void nrf_drv_spis_uninit(nrf_drv_spis_t const * const  p_instance)
     nrf_drv_common_per_res_release(p_spis);
 #endif
 
-    p_cb->state = NRF_DRV_STATE_UNINITIALIZED;
+    p_cb->p_ring = NULL;
+    p_cb->state  = NRF_DRV_STATE_UNINITIALIZED;
 }
 
 
@@ -306,6 +315,11 @@ ret_code_t nrf_drv_spis_buffers_set(nrf_drv_spis_t const * const  p_instance,
     {
         return NRF_ERROR_INVALID_ADDR;
     }
+
+    if (p_cb->p_ring != NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
     
     switch (p_cb->spi_state)
     {
@@ -334,8 +348,154 @@ ret_code_t nrf_drv_spis_buffers_set(nrf_drv_spis_t const * const  p_instance,
     return err_code;
 }
 
+
+/**@brief Function for setting the next buffers of the ring, while the semaphore is held by the CPU.
+ *
+ * If all buffers are held by the application, the semaphore is kept until buffers are released.
+ */
+static void spis_ring_buffers_set(NRF_SPIS_Type * p_spis, spis_cb_t * p_cb)
+{
+    if (p_cb->ring_held < p_cb->ring_count)
+    {
+        nrf_drv_spis_ring_buffers_t const * p_buffers = &p_cb->p_ring[p_cb->ring_next];
+
+        nrf_spis_tx_buffer_set(p_spis, (uint8_t *)p_buffers->p_tx_buffer, p_buffers->tx_buffer_length);
+        nrf_spis_rx_buffer_set(p_spis, p_buffers->p_rx_buffer, p_buffers->rx_buffer_length);
+
+        p_cb->ring_xfer     = p_cb->ring_next;
+        p_cb->ring_next     = (p_cb->ring_next + 1) % p_cb->ring_count;
+        p_cb->ring_xfer_set = true;
+        p_cb->ring_waiting  = false;
+
+        nrf_spis_task_trigger(p_spis, NRF_SPIS_TASK_RELEASE);
+    }
+    else
+    {
+        nrf_drv_spis_event_t event;
+
+        p_cb->ring_waiting = true;
+
+        event.evt_type  = NRF_DRV_SPIS_OVERRUN;
+        event.rx_amount = 0;
+        event.tx_amount = 0;
+        p_cb->handler(event);
+    }
+}
+
+
+ret_code_t nrf_drv_spis_ring_set(nrf_drv_spis_t const * const         p_instance,
+                                 nrf_drv_spis_ring_buffers_t const * p_ring,
+                                 uint8_t                             count)
+{
+    spis_cb_t * p_cb = &m_cb[p_instance->instance_id];
+
+    VERIFY_PARAM_NOT_NULL(p_ring);
+
+    if (count == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        VERIFY_PARAM_NOT_NULL(p_ring[i].p_rx_buffer);
+        VERIFY_PARAM_NOT_NULL(p_ring[i].p_tx_buffer);
+
+        if (!nrf_drv_is_in_RAM(p_ring[i].p_tx_buffer) || !nrf_drv_is_in_RAM(p_ring[i].p_rx_buffer))
+        {
+            return NRF_ERROR_INVALID_ADDR;
+        }
+    }
+
+    // The ring is only set when the semaphore is not given to the SPI slave device, or when the
+    // device has not been used yet.
+    if ((p_cb->p_ring != NULL) ||
+        ((p_cb->spi_state != SPIS_STATE_INIT) && (p_cb->spi_state != SPIS_XFER_COMPLETED)))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    p_cb->ring_count    = count;
+    p_cb->ring_next     = 0;
+    p_cb->ring_held     = 0;
+    p_cb->ring_xfer_set = false;
+    p_cb->ring_waiting  = false;
+    p_cb->p_ring        = p_ring;
+
+    nrf_spis_task_trigger(p_instance->p_reg, NRF_SPIS_TASK_ACQUIRE);
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_drv_spis_ring_release(nrf_drv_spis_t const * const p_instance)
+{
+    spis_cb_t * p_cb = &m_cb[p_instance->instance_id];
+    ret_code_t  err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if ((p_cb->p_ring == NULL) || (p_cb->ring_held == 0))
+    {
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        p_cb->ring_held--;
+        if (p_cb->ring_waiting)
+        {
+            spis_ring_buffers_set(p_instance->p_reg, p_cb);
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+
+/**@brief Function for processing the events when a buffer ring is used. */
+static void spis_ring_irq_handler(NRF_SPIS_Type * p_spis, spis_cb_t * p_cb)
+{
+    // The END event of a transaction is processed before the ACQUIRED event that follows it
+    // through the END_ACQUIRE shortcut.
+    if (nrf_spis_event_check(p_spis, NRF_SPIS_EVENT_END))
+    {
+        nrf_spis_event_clear(p_spis, NRF_SPIS_EVENT_END);
+
+        // END is also generated for transactions done before the ring was set.
+        if (p_cb->ring_xfer_set)
+        {
+            nrf_drv_spis_event_t event;
+
+            p_cb->ring_xfer_set = false;
+            p_cb->ring_held++;
+
+            event.evt_type   = NRF_DRV_SPIS_XFER_DONE;
+            event.rx_amount  = nrf_spis_rx_amount_get(p_spis);
+            event.tx_amount  = nrf_spis_tx_amount_get(p_spis);
+            event.ring_index = p_cb->ring_xfer;
+            p_cb->handler(event);
+        }
+    }
+
+    if (nrf_spis_event_check(p_spis, NRF_SPIS_EVENT_ACQUIRED))
+    {
+        nrf_spis_event_clear(p_spis, NRF_SPIS_EVENT_ACQUIRED);
+
+        if (!p_cb->ring_waiting)
+        {
+            spis_ring_buffers_set(p_spis, p_cb);
+        }
+    }
+}
+
 static void spis_irq_handler(NRF_SPIS_Type * p_spis, spis_cb_t * p_cb)
 {
+    if (p_cb->p_ring != NULL)
+    {
+        spis_ring_irq_handler(p_spis, p_cb);
+        return;
+    }
+
     // @note: as multiple events can be pending for processing, the correct event processing order 
     // is as follows:
     // - SPI semaphore acquired event.
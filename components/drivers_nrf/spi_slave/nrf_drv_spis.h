@@ -85,6 +85,7 @@ typedef enum
 {
     NRF_DRV_SPIS_BUFFERS_SET_DONE,          /**< Memory buffer set event. Memory buffers have been set successfully to the SPI slave device, and SPI transactions can be done. */
     NRF_DRV_SPIS_XFER_DONE,                 /**< SPI transaction event. SPI transaction has been completed. */  
+    NRF_DRV_SPIS_OVERRUN,                   /**< Buffer ring overrun event. All buffers of the ring are held by the application, so transactions are ignored until one is released. */
     NRF_DRV_SPIS_EVT_TYPE_MAX                    /**< Enumeration upper bound. */      
 } nrf_drv_spis_event_type_t;
 
@@ -94,8 +95,18 @@ typedef struct
     nrf_drv_spis_event_type_t evt_type;     //!< Type of event.
     uint32_t                  rx_amount;    //!< Number of bytes received in last transaction. This parameter is only valid for @ref NRF_DRV_SPIS_XFER_DONE events.
     uint32_t                  tx_amount;    //!< Number of bytes transmitted in last transaction. This parameter is only valid for @ref NRF_DRV_SPIS_XFER_DONE events.
+    uint8_t                   ring_index;   //!< Index in the buffer ring of the buffers used in last transaction. This parameter is only valid for @ref NRF_DRV_SPIS_XFER_DONE events when a buffer ring is used.
 } nrf_drv_spis_event_t;
 
+/** @brief Buffers of one SPI transaction in a buffer ring, see @ref nrf_drv_spis_ring_set. */
+typedef struct
+{
+    const uint8_t * p_tx_buffer;            //!< Pointer to the TX buffer.
+    uint8_t *       p_rx_buffer;            //!< Pointer to the RX buffer.
+    uint8_t         tx_buffer_length;       //!< Length of the TX buffer in bytes.
+    uint8_t         rx_buffer_length;       //!< Length of the RX buffer in bytes.
+} nrf_drv_spis_ring_buffers_t;
+
 /** @brief SPI slave driver instance data structure. */
 typedef struct
 {
@@ -218,6 +229,55 @@ ret_code_t nrf_drv_spis_buffers_set(nrf_drv_spis_t const * const  p_instance,
                                     uint8_t * p_rx_buffer, 
                                     uint8_t   rx_buffer_length);
 
+/** @brief Function for preparing the SPI slave instance for continuous SPI transactions.
+ *
+ * This function gives the SPI slave device a ring of buffers, used in turn for consecutive
+ * SPI transactions. The buffers for the next transaction are set in the interrupt that follows
+ * the end of a transaction, so the master can start the next transaction without waiting for
+ * the application.
+ *
+ * After each transaction, the @ref NRF_DRV_SPIS_XFER_DONE event gives the index of the buffers
+ * used. These buffers are then held by the application, which processes the received data,
+ * fills the TX buffer for a later transaction, and gives the buffers back with
+ * @ref nrf_drv_spis_ring_release. If all buffers are held by the application when a transaction
+ * ends, the @ref NRF_DRV_SPIS_OVERRUN event is generated, and the transactions of the master are
+ * ignored, with the DEF character clocked out, until buffers are released.
+ *
+ * The ring is used until the driver is uninitialized, and @ref nrf_drv_spis_buffers_set cannot
+ * be used meanwhile.
+ *
+ * @note The ring array and the buffers must stay valid while the ring is used. The buffers must
+ * be placed in the Data RAM region.
+ *
+ * @param[in] p_instance            SPIS instance.
+ * @param[in] p_ring                Pointer to the array of buffers.
+ * @param[in] count                 Number of elements in the array.
+ *
+ * @retval NRF_SUCCESS              If the operation was successful.
+ * @retval NRF_ERROR_NULL           If a NULL pointer was supplied.
+ * @retval NRF_ERROR_INVALID_PARAM  If @p count is 0.
+ * @retval NRF_ERROR_INVALID_STATE  If buffers are already set, or a ring is already used.
+ * @retval NRF_ERROR_INVALID_ADDR   If the provided buffers are not placed in the Data
+ *                                  RAM region.
+ */
+ret_code_t nrf_drv_spis_ring_set(nrf_drv_spis_t const * const         p_instance,
+                                 nrf_drv_spis_ring_buffers_t const * p_ring,
+                                 uint8_t                             count);
+
+/** @brief Function for giving back to the driver the oldest buffers of the ring held by the
+ *         application.
+ *
+ * Buffers are released in the order of the @ref NRF_DRV_SPIS_XFER_DONE events.
+ *
+ * @note This function can be called from the callback function context.
+ *
+ * @param[in] p_instance            SPIS instance.
+ *
+ * @retval NRF_SUCCESS              If the operation was successful.
+ * @retval NRF_ERROR_INVALID_STATE  If no ring is used or no buffers are held by the application.
+ */
+ret_code_t nrf_drv_spis_ring_release(nrf_drv_spis_t const * const p_instance);
+
 #endif // SPI_SLAVE_H__
 
 /** @} */
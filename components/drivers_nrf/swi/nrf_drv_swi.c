@@ -308,6 +308,129 @@ void nrf_drv_swi_trigger(nrf_swi_t swi, uint8_t flag_number)
 }
 
 
+static nrf_drv_swi_workq_t * m_workqs[SWI_ARRAY_SIZE];  ///< Work queue of each SWI.
+
+/**@brief SWI handler of the work queues: runs the posted items until the queue is empty. */
+static void workq_swi_handler(nrf_swi_t swi, nrf_swi_flags_t flags)
+{
+    UNUSED_PARAMETER(flags);
+    nrf_drv_swi_workq_t * p_workq = m_workqs[swi - SWI_START_NUMBER];
+
+    for (;;)
+    {
+        nrf_drv_swi_work_t * p_work;
+
+        CRITICAL_REGION_ENTER();
+        p_work = p_workq->p_head;
+        if (p_work != NULL)
+        {
+            p_workq->p_head = p_work->p_next;
+            if (p_workq->p_head == NULL)
+            {
+                p_workq->p_tail = NULL;
+            }
+            p_work->p_next  = NULL;
+            // Cleared before the handler runs, so that the item can be posted again meanwhile.
+            p_work->pending = false;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (p_work == NULL)
+        {
+            break;
+        }
+        p_work->handler(p_work->p_context);
+    }
+}
+
+
+ret_code_t nrf_drv_swi_workq_init(nrf_drv_swi_workq_t * p_workq, uint32_t priority)
+{
+    ASSERT(p_workq);
+    ret_code_t err_code;
+
+    p_workq->p_head = NULL;
+    p_workq->p_tail = NULL;
+
+    err_code = nrf_drv_swi_alloc(&p_workq->swi, workq_swi_handler, priority);
+    if (err_code == NRF_SUCCESS)
+    {
+        m_workqs[p_workq->swi - SWI_START_NUMBER] = p_workq;
+    }
+    return err_code;
+}
+
+
+void nrf_drv_swi_workq_uninit(nrf_drv_swi_workq_t * p_workq)
+{
+    ASSERT(p_workq);
+    nrf_swi_t swi = p_workq->swi;
+
+    nrf_drv_swi_free(&p_workq->swi);
+    m_workqs[swi - SWI_START_NUMBER] = NULL;
+
+    CRITICAL_REGION_ENTER();
+    while (p_workq->p_head != NULL)
+    {
+        nrf_drv_swi_work_t * p_work = p_workq->p_head;
+
+        p_workq->p_head = p_work->p_next;
+        p_work->p_next  = NULL;
+        p_work->pending = false;
+    }
+    p_workq->p_tail = NULL;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void nrf_drv_swi_work_init(nrf_drv_swi_work_t       * p_work,
+                           nrf_drv_swi_work_handler_t handler,
+                           void                     * p_context)
+{
+    ASSERT(p_work);
+    ASSERT(handler);
+    p_work->handler   = handler;
+    p_work->p_context = p_context;
+    p_work->p_next    = NULL;
+    p_work->pending   = false;
+}
+
+
+ret_code_t nrf_drv_swi_work_post(nrf_drv_swi_workq_t * p_workq, nrf_drv_swi_work_t * p_work)
+{
+    ASSERT(p_workq);
+    ASSERT(p_work && p_work->handler);
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (p_work->pending)
+    {
+        err_code = NRF_ERROR_BUSY;
+    }
+    else
+    {
+        p_work->pending = true;
+        p_work->p_next  = NULL;
+        if (p_workq->p_tail == NULL)
+        {
+            p_workq->p_head = p_work;
+        }
+        else
+        {
+            p_workq->p_tail->p_next = p_work;
+        }
+        p_workq->p_tail = p_work;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (err_code == NRF_SUCCESS)
+    {
+        nrf_drv_swi_trigger(p_workq->swi, 0);
+    }
+    return err_code;
+}
+
+
 #if EGU_ENABLED > 0
 
 uint32_t nrf_drv_swi_task_trigger_address_get(nrf_swi_t swi, uint8_t channel)
@@ -95,6 +95,39 @@ typedef void (* nrf_swi_handler_t)(nrf_swi_t, nrf_swi_flags_t);
 /**@brief Default SWI priority. */
 #define SWI_DEFAULT_PRIORITY APP_IRQ_PRIORITY_LOW
 
+/** @brief   Work item handler function.
+ *
+ *  Takes one argument: the context of the work item.
+ */
+typedef void (* nrf_drv_swi_work_handler_t)(void * p_context);
+
+/**@brief Work item. Must be statically allocated, and initialized with
+ *        @ref nrf_drv_swi_work_init or @ref NRF_DRV_SWI_WORK_DEF. */
+typedef struct nrf_drv_swi_work_s
+{
+    nrf_drv_swi_work_handler_t           handler;   ///< Handler.
+    void                               * p_context; ///< Context passed to the handler.
+    struct nrf_drv_swi_work_s * volatile p_next;    ///< Next item in the queue.
+    volatile bool                        pending;   ///< True while the item is in a queue.
+} nrf_drv_swi_work_t;
+
+/**@brief Work queue. Runs the posted work items, in order, in the handler of one SWI. */
+typedef struct
+{
+    nrf_drv_swi_work_t * volatile p_head;   ///< First item to run.
+    nrf_drv_swi_work_t * volatile p_tail;   ///< Last item to run.
+    nrf_swi_t                     swi;      ///< SWI of the queue.
+} nrf_drv_swi_workq_t;
+
+/**@brief Macro for defining an initialized work item.
+ *
+ * @param[in]  NAME     Name of the work item variable.
+ * @param[in]  HANDLER  Handler of the work item.
+ * @param[in]  CONTEXT  Context passed to the handler.
+ */
+#define NRF_DRV_SWI_WORK_DEF(NAME, HANDLER, CONTEXT) \
+    static nrf_drv_swi_work_t NAME = { .handler = (HANDLER), .p_context = (CONTEXT) }
+
 
 /**@brief Function for initializing the SWI module.
  *
@@ -139,6 +172,57 @@ void nrf_drv_swi_free(nrf_swi_t * p_swi);
 void nrf_drv_swi_trigger(nrf_swi_t swi, uint8_t flag_number);
 
 
+/**@brief Function for initializing a work queue.
+ *
+ * @details The queue allocates an SWI with @ref nrf_drv_swi_alloc, so the work items posted to it
+ *          run at the given interrupt priority. Queues with different priorities can be used to
+ *          run urgent deferred work before less urgent work.
+ *
+ * @param[out] p_workq   Work queue.
+ * @param[in]  priority  Interrupt priority at which the work items run.
+ *
+ * @retval     NRF_SUCCESS             If the queue was initialized.
+ * @retval     NRF_ERROR_NO_MEM        If there is no available SWI to be used.
+ */
+ret_code_t nrf_drv_swi_workq_init(nrf_drv_swi_workq_t * p_workq, uint32_t priority);
+
+
+/**@brief Function for uninitializing a work queue and freeing its SWI.
+ *
+ * @details The items still in the queue are not run.
+ *
+ * @param[in]  p_workq   Work queue.
+ */
+void nrf_drv_swi_workq_uninit(nrf_drv_swi_workq_t * p_workq);
+
+
+/**@brief Function for initializing a work item.
+ *
+ * @param[out] p_work     Work item.
+ * @param[in]  handler    Handler of the work item.
+ * @param[in]  p_context  Context passed to the handler.
+ */
+void nrf_drv_swi_work_init(nrf_drv_swi_work_t       * p_work,
+                           nrf_drv_swi_work_handler_t handler,
+                           void                     * p_context);
+
+
+/**@brief Function for posting a work item to a work queue.
+ *
+ * @details This function can be called from any interrupt priority. The item is run once,
+ *          after the items posted before it, when the SWI of the queue is not blocked by a
+ *          higher-priority interrupt. Posting an item again before it runs has no effect. An
+ *          item may post itself again from its handler.
+ *
+ * @param[in]  p_workq   Work queue.
+ * @param[in]  p_work    Work item.
+ *
+ * @retval     NRF_SUCCESS             If the item was posted.
+ * @retval     NRF_ERROR_BUSY          If the item was already pending.
+ */
+ret_code_t nrf_drv_swi_work_post(nrf_drv_swi_workq_t * p_workq, nrf_drv_swi_work_t * p_work);
+
+
 #if EGU_ENABLED > 0
 
 /**@brief Function for returning the EGU trigger task address.
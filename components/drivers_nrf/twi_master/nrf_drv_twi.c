@@ -950,23 +950,31 @@ static void irq_handler_twi(NRF_TWI_Type * p_twi, twi_control_block_t * p_cb)
 #if TWI0_ENABLED
 IRQ_HANDLER(0)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(nrf_drv_get_IRQn(NRF_TWI0));
+
     #if (TWI0_USE_EASY_DMA == 1) && defined(NRF52)
         irq_handler_twim(NRF_TWIM0,
     #else
         irq_handler_twi(NRF_TWI0,
     #endif
             &m_cb[TWI0_INSTANCE_INDEX]);
+
+    NRF_DRV_IRQ_MONITOR_EXIT(nrf_drv_get_IRQn(NRF_TWI0));
 }
 #endif // TWI0_ENABLED
 
 #if TWI1_ENABLED
 IRQ_HANDLER(1)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(nrf_drv_get_IRQn(NRF_TWI1));
+
     #if (TWI1_USE_EASY_DMA == 1)
         irq_handler_twim(NRF_TWIM1,
     #else
         irq_handler_twi(NRF_TWI1,
     #endif
             &m_cb[TWI1_INSTANCE_INDEX]);
+
+    NRF_DRV_IRQ_MONITOR_EXIT(nrf_drv_get_IRQn(NRF_TWI1));
 }
 #endif // TWI1_ENABLED
@@ -53,6 +53,24 @@ typedef struct
     NRF_TWIS_Type * const p_reg; ///< Peripheral registry address
 } nrf_drv_twis_const_inst_t;
 
+/**
+ * @brief Buffer ring state
+ *
+ * State of the ring of buffers used in one direction.
+ * Buffers are prepared, used and held by the application in the order of the ring,
+ * so the held buffers are always the ones before the active and prepared ones.
+ */
+typedef struct
+{
+    nrf_drv_twis_buf_t const * p_bufs;     ///< Buffers of the ring, NULL if the ring is not used
+    uint8_t                    count;      ///< Number of buffers in the ring
+    uint8_t                    next;       ///< Index of the next buffer to prepare
+    uint8_t                    active_idx; ///< Index of the buffer used by the ongoing transfer
+    volatile uint8_t           held;       ///< Number of buffers held by the application
+    volatile bool              prepared;   ///< A buffer is prepared for the next transfer
+    volatile bool              active;     ///< A buffer is used by the ongoing transfer
+}nrf_drv_twis_ring_t;
+
 /**
  * @brief Variable instance part
  *
@@ -72,6 +90,8 @@ typedef struct
                                                   *   Always use Atomic load-store when updating
                                                   *   this value in main loop.
                                                   */
+    nrf_drv_twis_ring_t              rx_ring;    ///< Ring of buffers for write requests
+    nrf_drv_twis_ring_t              tx_ring;    ///< Ring of buffers for read requests
 }nrf_drv_twis_var_inst_t;
 
 
@@ -309,20 +329,23 @@ static inline uint32_t nrf_drv_twis_clear_bit(uint32_t flags, nrf_twis_event_t e
  * If given @em error parameter has zero value the @ref NRF_DRV_TWIS_ERROR_UNEXPECTED_EVENT
  * would be set.
  *
- * @param instNr Instance number
- * @param ev     What error event raport to event handler
- * @param error  Error flags
+ * @param instNr   Instance number
+ * @param ev       What error event raport to event handler
+ * @param error    Error flags
+ * @param ring_idx Index of the ring buffer used by the transfer
  */
 static inline void nrf_drv_twis_process_error(
         uint8_t instNr,
         nrf_drv_twis_evt_type_t ev,
-        uint32_t error)
+        uint32_t error,
+        uint8_t ring_idx)
 {
     if(0 == error)
         error = NRF_DRV_TWIS_ERROR_UNEXPECTED_EVENT;
     nrf_drv_twis_evt_t evdata;
     evdata.type = ev;
     evdata.data.error = error;
+    evdata.ring_idx   = ring_idx;
 
     m_var_inst[instNr].error |= error;
 
@@ -330,6 +353,87 @@ static inline void nrf_drv_twis_process_error(
 }
 
 
+/**
+ * @brief Prepare the next buffer of the ring
+ *
+ * The buffer is prepared if no buffer is prepared yet and a buffer is not held by the application.
+ * The EasyDMA pointer is double-buffered, so a buffer can be prepared during an ongoing transfer.
+ * @param instNr Instance number
+ * @param p_ring Ring to process
+ * @param rx     True for the receiving ring, false for the sending one
+ */
+static void nrf_drv_twis_ring_prepare(uint8_t instNr, nrf_drv_twis_ring_t * const p_ring, bool rx)
+{
+    NRF_TWIS_Type * const p_reg = m_const_inst[instNr].p_reg;
+    nrf_drv_twis_buf_t const * p_buf;
+
+    if((NULL == p_ring->p_bufs) || p_ring->prepared ||
+       (p_ring->held + (p_ring->active ? 1U : 0U) >= p_ring->count))
+    {
+        return;
+    }
+
+    p_buf = &p_ring->p_bufs[p_ring->next];
+    if(rx)
+    {
+        nrf_twis_rx_prepare(p_reg, (uint8_t *)p_buf->p_buf, (nrf_twis_amount_t)p_buf->size);
+    }
+    else
+    {
+        nrf_twis_tx_prepare(p_reg, (uint8_t const *)p_buf->p_buf, (nrf_twis_amount_t)p_buf->size);
+    }
+    p_ring->next     = (p_ring->next + 1) % p_ring->count;
+    p_ring->prepared = true;
+}
+
+/**
+ * @brief Process the start of a transfer into or from the prepared ring buffer
+ * @param instNr Instance number
+ * @param p_ring Ring to process
+ * @param rx     True for the receiving ring, false for the sending one
+ */
+static void nrf_drv_twis_ring_started(uint8_t instNr, nrf_drv_twis_ring_t * const p_ring, bool rx)
+{
+    if((NULL == p_ring->p_bufs) || !p_ring->prepared)
+    {
+        return;
+    }
+    p_ring->active_idx = (p_ring->next + p_ring->count - 1) % p_ring->count;
+    p_ring->active     = true;
+    p_ring->prepared   = false;
+    nrf_drv_twis_ring_prepare(instNr, p_ring, rx);
+}
+
+/**
+ * @brief Process the end of a transfer
+ * @param instNr Instance number
+ * @param p_ring Ring to process
+ * @param rx     True for the receiving ring, false for the sending one
+ * @return Index of the buffer now held by the application, or @ref NRF_DRV_TWIS_RING_IDX_NONE
+ */
+static uint8_t nrf_drv_twis_ring_finished(uint8_t instNr, nrf_drv_twis_ring_t * const p_ring, bool rx)
+{
+    if(!p_ring->active)
+    {
+        return NRF_DRV_TWIS_RING_IDX_NONE;
+    }
+    p_ring->active = false;
+    p_ring->held++;
+    nrf_drv_twis_ring_prepare(instNr, p_ring, rx);
+    return p_ring->active_idx;
+}
+
+/**
+ * @brief Check if the ring of given direction is used and has no buffer prepared
+ * @param p_ring Ring to check
+ * @retval true  Ring is used and all its buffers are held by the application
+ * @retval false Ring is not used or a buffer is prepared
+ */
+static inline bool nrf_drv_twis_ring_overrun(nrf_drv_twis_ring_t const * const p_ring)
+{
+    return (NULL != p_ring->p_bufs) && !p_ring->prepared;
+}
+
 /**
  * @brief State machine main function
  *
@@ -351,8 +455,12 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
     }
 
     NRF_TWIS_Type * const p_reg = m_const_inst[instNr].p_reg;
+    /* Variable instance part */
+    nrf_drv_twis_var_inst_t * const p_var_inst = &m_var_inst[instNr];
     /* Event data structure to be passed into event handler */
     nrf_drv_twis_evt_t evdata;
+    /* No ring buffer reported unless set otherwise */
+    evdata.ring_idx = NRF_DRV_TWIS_RING_IDX_NONE;
     /* Current substate copy  */
     nrf_drv_twis_substate_t substate = m_var_inst[instNr].substate;
     /* Event flags */
@@ -379,17 +487,24 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             }
             else if(nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_READ))
             {
-                evdata.type = TWIS_EVT_READ_REQ;
                 if(nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_TXSTARTED))
                 {
                     substate = NRF_DRV_TWIS_SUBSTATE_READ_PENDING;
                     evdata.data.buf_req = false;
+                    nrf_drv_twis_ring_started(instNr, &p_var_inst->tx_ring, false);
                 }
                 else
                 {
                     substate = NRF_DRV_TWIS_SUBSTATE_READ_WAITING;
-                    evdata.data.buf_req = true;
+                    evdata.data.buf_req = (NULL == p_var_inst->tx_ring.p_bufs) ||
+                                          nrf_drv_twis_ring_overrun(&p_var_inst->tx_ring);
+                    if(nrf_drv_twis_ring_overrun(&p_var_inst->tx_ring))
+                    {
+                        evdata.type = TWIS_EVT_READ_OVERRUN;
+                        nrf_drv_call_event_handler(instNr, &evdata);
+                    }
                 }
+                evdata.type = TWIS_EVT_READ_REQ;
                 nrf_drv_call_event_handler(instNr, &evdata);
                 ev = nrf_drv_twis_clear_bit(ev, NRF_TWIS_EVENT_READ);
                 ev = nrf_drv_twis_clear_bit(ev, NRF_TWIS_EVENT_TXSTARTED);
@@ -398,17 +513,24 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             }
             else if(nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_WRITE))
             {
-                evdata.type = TWIS_EVT_WRITE_REQ;
                 if(nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_RXSTARTED))
                 {
                     substate = NRF_DRV_TWIS_SUBSTATE_WRITE_PENDING;
                     evdata.data.buf_req = false;
+                    nrf_drv_twis_ring_started(instNr, &p_var_inst->rx_ring, true);
                 }
                 else
                 {
                     substate = NRF_DRV_TWIS_SUBSTATE_WRITE_WAITING;
-                    evdata.data.buf_req = true;
+                    evdata.data.buf_req = (NULL == p_var_inst->rx_ring.p_bufs) ||
+                                          nrf_drv_twis_ring_overrun(&p_var_inst->rx_ring);
+                    if(nrf_drv_twis_ring_overrun(&p_var_inst->rx_ring))
+                    {
+                        evdata.type = TWIS_EVT_WRITE_OVERRUN;
+                        nrf_drv_call_event_handler(instNr, &evdata);
+                    }
                 }
+                evdata.type = TWIS_EVT_WRITE_REQ;
                 nrf_drv_call_event_handler(instNr, &evdata);
                 ev = nrf_drv_twis_clear_bit(ev, NRF_TWIS_EVENT_READ);
                 ev = nrf_drv_twis_clear_bit(ev, NRF_TWIS_EVENT_TXSTARTED);
@@ -417,7 +539,8 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             }
             else
             {
-                nrf_drv_twis_process_error(instNr, TWIS_EVT_GENERAL_ERROR, nrf_twis_error_source_get_and_clear(p_reg));
+                nrf_drv_twis_process_error(instNr, TWIS_EVT_GENERAL_ERROR, nrf_twis_error_source_get_and_clear(p_reg),
+                                           NRF_DRV_TWIS_RING_IDX_NONE);
                 ev = 0;
             }
             break;
@@ -428,12 +551,17 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
                nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_STOPPED))
             {
                 substate = NRF_DRV_TWIS_SUBSTATE_READ_PENDING;
+                if(nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_TXSTARTED))
+                {
+                    nrf_drv_twis_ring_started(instNr, &p_var_inst->tx_ring, false);
+                }
                 /* Any other bits requires further processing in PENDING substate */
                 ev = nrf_drv_twis_clear_bit(ev, NRF_TWIS_EVENT_TXSTARTED);
             }
             else
             {
-                nrf_drv_twis_process_error(instNr, TWIS_EVT_READ_ERROR, nrf_twis_error_source_get_and_clear(p_reg));
+                nrf_drv_twis_process_error(instNr, TWIS_EVT_READ_ERROR, nrf_twis_error_source_get_and_clear(p_reg),
+                                           NRF_DRV_TWIS_RING_IDX_NONE);
                 substate = NRF_DRV_TWIS_SUBSTATE_IDLE;
                 ev = 0;
             }
@@ -445,6 +573,7 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             {
                 evdata.type = TWIS_EVT_READ_DONE;
                 evdata.data.tx_amount = nrf_twis_tx_amount_get(p_reg);
+                evdata.ring_idx = nrf_drv_twis_ring_finished(instNr, &p_var_inst->tx_ring, false);
                 nrf_drv_call_event_handler(instNr, &evdata);
                 /* Go to idle and repeat the state machine if READ or WRITE events detected.
                  * This time READ or WRITE would be started */
@@ -453,7 +582,8 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             }
             else
             {
-                nrf_drv_twis_process_error(instNr, TWIS_EVT_READ_ERROR, nrf_twis_error_source_get_and_clear(p_reg));
+                nrf_drv_twis_process_error(instNr, TWIS_EVT_READ_ERROR, nrf_twis_error_source_get_and_clear(p_reg),
+                                           nrf_drv_twis_ring_finished(instNr, &p_var_inst->tx_ring, false));
                 substate = NRF_DRV_TWIS_SUBSTATE_IDLE;
                 ev = 0;
             }
@@ -465,12 +595,17 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
                nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_STOPPED))
             {
                 substate = NRF_DRV_TWIS_SUBSTATE_WRITE_PENDING;
+                if(nrf_drv_twis_check_bit(ev, NRF_TWIS_EVENT_RXSTARTED))
+                {
+                    nrf_drv_twis_ring_started(instNr, &p_var_inst->rx_ring, true);
+                }
                 /* Any other bits requires further processing in PENDING substate */
                 ev = nrf_drv_twis_clear_bit(ev, NRF_TWIS_EVENT_RXSTARTED);
             }
             else
             {
-                nrf_drv_twis_process_error(instNr, TWIS_EVT_WRITE_ERROR, nrf_twis_error_source_get_and_clear(p_reg));
+                nrf_drv_twis_process_error(instNr, TWIS_EVT_WRITE_ERROR, nrf_twis_error_source_get_and_clear(p_reg),
+                                           NRF_DRV_TWIS_RING_IDX_NONE);
                 substate = NRF_DRV_TWIS_SUBSTATE_IDLE;
                 ev = 0;
             }
@@ -482,6 +617,7 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             {
                 evdata.type = TWIS_EVT_WRITE_DONE;
                 evdata.data.rx_amount = nrf_twis_rx_amount_get(p_reg);
+                evdata.ring_idx = nrf_drv_twis_ring_finished(instNr, &p_var_inst->rx_ring, true);
                 nrf_drv_call_event_handler(instNr, &evdata);
                 /* Go to idle and repeat the state machine if READ or WRITE events detected.
                  * This time READ or WRITE would be started */
@@ -490,7 +626,8 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
             }
             else
             {
-                nrf_drv_twis_process_error(instNr, TWIS_EVT_WRITE_ERROR, nrf_twis_error_source_get_and_clear(p_reg));
+                nrf_drv_twis_process_error(instNr, TWIS_EVT_WRITE_ERROR, nrf_twis_error_source_get_and_clear(p_reg),
+                                           nrf_drv_twis_ring_finished(instNr, &p_var_inst->rx_ring, true));
                 substate = NRF_DRV_TWIS_SUBSTATE_IDLE;
                 ev = 0;
             }
@@ -502,7 +639,7 @@ static void nrf_drv_twis_state_machine(uint8_t instNr)
         }
     }
 
-    m_var_inst[instNr].substate = substate;
+    p_var_inst->substate = substate;
     if(!TWIS_NO_SYNC_MODE)
     {
         m_sm_semaphore[instNr] = 0;
@@ -651,8 +788,10 @@ void nrf_drv_twis_uninit(nrf_drv_twis_t const * const p_inst)
 #endif
 
     /* Clear variables */
-    m_var_inst[instNr].ev_handler = NULL;
-    m_var_inst[instNr].state      = NRF_DRV_STATE_UNINITIALIZED;
+    m_var_inst[instNr].ev_handler     = NULL;
+    m_var_inst[instNr].rx_ring.p_bufs = NULL;
+    m_var_inst[instNr].tx_ring.p_bufs = NULL;
+    m_var_inst[instNr].state          = NRF_DRV_STATE_UNINITIALIZED;
 }
 
 
@@ -689,6 +828,8 @@ void nrf_drv_twis_disable(nrf_drv_twis_t const * const p_inst)
     nrf_twis_int_disable(p_reg, m_used_ints_mask);
 
     nrf_twis_disable(p_reg);
+    m_var_inst[instNr].rx_ring.p_bufs = NULL;
+    m_var_inst[instNr].tx_ring.p_bufs = NULL;
     m_var_inst[instNr].state    = NRF_DRV_STATE_INITIALIZED;
 }
 
@@ -796,6 +937,11 @@ ret_code_t nrf_drv_twis_tx_prepare(
         return NRF_ERROR_INVALID_LENGTH;
     }
 
+    if(NULL != p_var_inst->tx_ring.p_bufs)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
     nrf_twis_tx_prepare(p_reg, (uint8_t const *)p_buf, (nrf_twis_amount_t)size);
     return NRF_SUCCESS;
 
@@ -836,6 +982,11 @@ ret_code_t nrf_drv_twis_rx_prepare(
         return NRF_ERROR_INVALID_LENGTH;
     }
 
+    if(NULL != p_var_inst->rx_ring.p_bufs)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
     nrf_twis_rx_prepare(p_reg, (uint8_t *)p_buf, (nrf_twis_amount_t)size);
     return NRF_SUCCESS;
 }
@@ -850,6 +1001,128 @@ size_t nrf_drv_twis_rx_amount(nrf_drv_twis_t const * const p_inst)
 }
 
 
+/**
+ * @brief Start using a ring of buffers
+ *
+ * Common implementation of @ref nrf_drv_twis_rx_ring_set and @ref nrf_drv_twis_tx_ring_set.
+ * @param instNr Instance number
+ * @param p_ring Ring state
+ * @param p_bufs Array of buffers
+ * @param count  Number of buffers
+ * @param maxcnt Mask of the MAXCNT register for the direction
+ * @param rx     True for the receiving ring, false for the sending one
+ * @return Error code as described for the interface functions
+ */
+static ret_code_t nrf_drv_twis_ring_set(
+        uint8_t instNr,
+        nrf_drv_twis_ring_t * const p_ring,
+        nrf_drv_twis_buf_t const * const p_bufs,
+        uint8_t count,
+        uint32_t maxcnt,
+        bool rx)
+{
+    ret_code_t err_code = NRF_SUCCESS;
+
+    if(NULL == p_bufs)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if((0 == count) || (count >= NRF_DRV_TWIS_RING_IDX_NONE))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    for(uint8_t i = 0; i < count; i++)
+    {
+        if(!nrf_drv_is_in_RAM(p_bufs[i].p_buf))
+        {
+            return NRF_ERROR_INVALID_ADDR;
+        }
+        if((p_bufs[i].size & maxcnt) != p_bufs[i].size)
+        {
+            return NRF_ERROR_INVALID_LENGTH;
+        }
+    }
+
+    CRITICAL_REGION_ENTER();
+    if((m_var_inst[instNr].state != NRF_DRV_STATE_POWERED_ON) || (NULL != p_ring->p_bufs))
+    {
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        p_ring->count    = count;
+        p_ring->next     = 0;
+        p_ring->held     = 0;
+        p_ring->prepared = false;
+        p_ring->active   = false;
+        p_ring->p_bufs   = p_bufs;
+        nrf_drv_twis_ring_prepare(instNr, p_ring, rx);
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+/**
+ * @brief Release the oldest buffer of the ring held by the application
+ *
+ * Common implementation of @ref nrf_drv_twis_rx_ring_release and @ref nrf_drv_twis_tx_ring_release.
+ * @param instNr Instance number
+ * @param p_ring Ring state
+ * @param rx     True for the receiving ring, false for the sending one
+ * @return Error code as described for the interface functions
+ */
+static ret_code_t nrf_drv_twis_ring_release(uint8_t instNr, nrf_drv_twis_ring_t * const p_ring, bool rx)
+{
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if((NULL == p_ring->p_bufs) || (0 == p_ring->held))
+    {
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        p_ring->held--;
+        nrf_drv_twis_ring_prepare(instNr, p_ring, rx);
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+ret_code_t nrf_drv_twis_rx_ring_set(
+        nrf_drv_twis_t     const * const p_inst,
+        nrf_drv_twis_buf_t const * const p_bufs,
+        uint8_t count)
+{
+    uint8_t instNr = p_inst->instNr;
+    return nrf_drv_twis_ring_set(instNr, &m_var_inst[instNr].rx_ring, p_bufs, count,
+                                 TWIS_RXD_MAXCNT_MAXCNT_Msk, true);
+}
+
+ret_code_t nrf_drv_twis_rx_ring_release(nrf_drv_twis_t const * const p_inst)
+{
+    uint8_t instNr = p_inst->instNr;
+    return nrf_drv_twis_ring_release(instNr, &m_var_inst[instNr].rx_ring, true);
+}
+
+ret_code_t nrf_drv_twis_tx_ring_set(
+        nrf_drv_twis_t     const * const p_inst,
+        nrf_drv_twis_buf_t const * const p_bufs,
+        uint8_t count)
+{
+    uint8_t instNr = p_inst->instNr;
+    return nrf_drv_twis_ring_set(instNr, &m_var_inst[instNr].tx_ring, p_bufs, count,
+                                 TWIS_TXD_MAXCNT_MAXCNT_Msk, false);
+}
+
+ret_code_t nrf_drv_twis_tx_ring_release(nrf_drv_twis_t const * const p_inst)
+{
+    uint8_t instNr = p_inst->instNr;
+    return nrf_drv_twis_ring_release(instNr, &m_var_inst[instNr].tx_ring, false);
+}
+
 bool nrf_drv_twis_is_busy(nrf_drv_twis_t const * const p_inst)
 {
     nrf_drv_twis_preprocess_status(p_inst->instNr);
@@ -82,9 +82,22 @@ typedef enum
                                 */
     TWIS_EVT_WRITE_DONE,   ///< Write request has finished - process data
     TWIS_EVT_WRITE_ERROR,  ///< Write request finished with error
-    TWIS_EVT_GENERAL_ERROR ///< Error that happens not inside WRITE or READ transaction
+    TWIS_EVT_GENERAL_ERROR,///< Error that happens not inside WRITE or READ transaction
+    TWIS_EVT_READ_OVERRUN, ///< Read request detected while all buffers of the tx ring are held
+                           /**< The master waits until a buffer is released with
+                                @ref nrf_drv_twis_tx_ring_release.
+                                */
+    TWIS_EVT_WRITE_OVERRUN ///< Write request detected while all buffers of the rx ring are held
+                           /**< The master waits until a buffer is released with
+                                @ref nrf_drv_twis_rx_ring_release.
+                                */
 } nrf_drv_twis_evt_type_t;
 
+/**
+ * @brief Value of the ring_idx member of the event if no ring buffer was used
+ */
+#define NRF_DRV_TWIS_RING_IDX_NONE 0xFF
+
 /**
  * @brief TWIS driver instance structure
  *
@@ -111,8 +124,26 @@ typedef struct
         uint32_t rx_amount; ///< Data for @ref TWIS_EVT_WRITE_DONE
         uint32_t error;     ///< Data for @ref TWIS_EVT_GENERAL_ERROR
     }data;
+    uint8_t ring_idx;       ///< Index of the ring buffer used by the finished transfer
+                            /**< Valid for @ref TWIS_EVT_READ_DONE, @ref TWIS_EVT_READ_ERROR,
+                                 @ref TWIS_EVT_WRITE_DONE and @ref TWIS_EVT_WRITE_ERROR.
+                                 @ref NRF_DRV_TWIS_RING_IDX_NONE if no ring buffer was used,
+                                 otherwise the buffer is held by the application until released.
+                                 */
 }nrf_drv_twis_evt_t;
 
+/**
+ * @brief Buffer of a TWIS buffer ring
+ *
+ * @sa nrf_drv_twis_rx_ring_set
+ * @sa nrf_drv_twis_tx_ring_set
+ */
+typedef struct
+{
+    void * p_buf; ///< Buffer, placed in RAM
+    size_t size;  ///< Size of the buffer
+}nrf_drv_twis_buf_t;
+
 /**
  * @brief TWI slave event callback function type.
  *
@@ -280,7 +311,7 @@ uint32_t nrf_drv_twis_error_get_and_clear(nrf_drv_twis_t const * const p_inst);
  * @retval NRF_SUCCESS              Preparation finished properly
  * @retval NRF_ERROR_INVALID_ADDR   Given @em p_buf is not placed inside the RAM
  * @retval NRF_ERROR_INVALID_LENGTH Wrong value in @em size parameter
- * @retval NRF_ERROR_INVALID_STATE  Module not initialized or not enabled
+ * @retval NRF_ERROR_INVALID_STATE  Module not initialized or not enabled, or a ring is used
  */
 ret_code_t nrf_drv_twis_tx_prepare(
         nrf_drv_twis_t const * const p_inst,
@@ -312,7 +343,7 @@ size_t nrf_drv_twis_tx_amount(nrf_drv_twis_t const * const p_inst);
  * @retval NRF_SUCCESS              Preparation finished properly
  * @retval NRF_ERROR_INVALID_ADDR   Given @em p_buf is not placed inside the RAM
  * @retval NRF_ERROR_INVALID_LENGTH Wrong value in @em size parameter
- * @retval NRF_ERROR_INVALID_STATE  Module not initialized or not enabled
+ * @retval NRF_ERROR_INVALID_STATE  Module not initialized or not enabled, or a ring is used
  */
 ret_code_t nrf_drv_twis_rx_prepare(
         nrf_drv_twis_t const * const p_inst,
@@ -331,6 +362,86 @@ ret_code_t nrf_drv_twis_rx_prepare(
  */
 size_t nrf_drv_twis_rx_amount(nrf_drv_twis_t const * const p_inst);
 
+/**
+ * @brief Use a ring of buffers for receiving
+ *
+ * The buffers are prepared in turn for consecutive write requests.
+ * The next buffer is prepared as soon as the transfer into the previous one starts,
+ * so there is no need to respond to @ref TWIS_EVT_WRITE_REQ events.
+ * After @ref TWIS_EVT_WRITE_DONE the buffer given in the event is held by the application
+ * until it is released with @ref nrf_drv_twis_rx_ring_release.
+ * If all buffers are held when a write request comes, @ref TWIS_EVT_WRITE_OVERRUN is generated.
+ *
+ * The ring is used until the driver is disabled.
+ * @ref nrf_drv_twis_rx_prepare cannot be used meanwhile.
+ *
+ * @param[in] p_inst  TWIS driver instance.
+ * @param[in] p_bufs  Array of buffers.
+ * @attention         The array and the buffers have to stay valid while the ring is used.
+ *                    The buffers have to be placed in RAM.
+ * @param     count   Number of buffers in the array.
+ *
+ * @retval NRF_SUCCESS              The ring is used
+ * @retval NRF_ERROR_NULL           @em p_bufs is NULL
+ * @retval NRF_ERROR_INVALID_ADDR   One of the buffers is not placed inside the RAM
+ * @retval NRF_ERROR_INVALID_LENGTH Wrong value in @em count or in the size of a buffer
+ * @retval NRF_ERROR_INVALID_STATE  Module not enabled, or a ring for receiving is already used
+ */
+ret_code_t nrf_drv_twis_rx_ring_set(
+        nrf_drv_twis_t     const * const p_inst,
+        nrf_drv_twis_buf_t const * const p_bufs,
+        uint8_t count);
+
+/**
+ * @brief Release the oldest receiving ring buffer held by the application
+ *
+ * Buffers are released in the order they were given in the events.
+ * @param[in] p_inst TWIS driver instance.
+ * @retval NRF_SUCCESS             Buffer released
+ * @retval NRF_ERROR_INVALID_STATE No ring used, or no buffer held by the application
+ */
+ret_code_t nrf_drv_twis_rx_ring_release(nrf_drv_twis_t const * const p_inst);
+
+/**
+ * @brief Use a ring of buffers for sending
+ *
+ * The buffers are prepared in turn for consecutive read requests.
+ * The next buffer is prepared as soon as the transfer from the previous one starts,
+ * so there is no need to respond to @ref TWIS_EVT_READ_REQ events.
+ * After @ref TWIS_EVT_READ_DONE the buffer given in the event is held by the application,
+ * that fills it with new data and releases it with @ref nrf_drv_twis_tx_ring_release.
+ * If all buffers are held when a read request comes, @ref TWIS_EVT_READ_OVERRUN is generated.
+ *
+ * The ring is used until the driver is disabled.
+ * @ref nrf_drv_twis_tx_prepare cannot be used meanwhile.
+ *
+ * @param[in] p_inst  TWIS driver instance.
+ * @param[in] p_bufs  Array of buffers, filled with the data to send.
+ * @attention         The array and the buffers have to stay valid while the ring is used.
+ *                    The buffers have to be placed in RAM.
+ * @param     count   Number of buffers in the array.
+ *
+ * @retval NRF_SUCCESS              The ring is used
+ * @retval NRF_ERROR_NULL           @em p_bufs is NULL
+ * @retval NRF_ERROR_INVALID_ADDR   One of the buffers is not placed inside the RAM
+ * @retval NRF_ERROR_INVALID_LENGTH Wrong value in @em count or in the size of a buffer
+ * @retval NRF_ERROR_INVALID_STATE  Module not enabled, or a ring for sending is already used
+ */
+ret_code_t nrf_drv_twis_tx_ring_set(
+        nrf_drv_twis_t     const * const p_inst,
+        nrf_drv_twis_buf_t const * const p_bufs,
+        uint8_t count);
+
+/**
+ * @brief Release the oldest sending ring buffer held by the application
+ *
+ * Buffers are released in the order they were given in the events.
+ * @param[in] p_inst TWIS driver instance.
+ * @retval NRF_SUCCESS             Buffer released
+ * @retval NRF_ERROR_INVALID_STATE No ring used, or no buffer held by the application
+ */
+ret_code_t nrf_drv_twis_tx_ring_release(nrf_drv_twis_t const * const p_inst);
+
 /**
  * @brief Function checks if driver is busy right now
  *
@@ -16,6 +16,9 @@
 #include "nrf_drv_common.h"
 #include "nrf_gpio.h"
 #include "app_util_platform.h"
+#if (UART_RX_STREAM_SUPPORT == 1)
+#include "nrf_drv_ppi.h"
+#endif
 
 // This set of macros makes it possible to exclude parts of code, when one type
 // of supported peripherals is not used.
@@ -47,11 +50,22 @@
     #error "Wrong configuration."
 #endif
 
+#if (UART_RX_STREAM_SUPPORT == 1)
+#if !defined(UARTE_IN_USE)
+    #error "UART_RX_STREAM_SUPPORT requires UART_EASY_DMA_SUPPORT."
+#endif
+#define UARTE_RX_STREAM_IN_USE
+#endif
+
 #ifndef IS_EASY_DMA_RAM_ADDRESS
     #define IS_EASY_DMA_RAM_ADDRESS(addr) (((uint32_t)addr & 0xFFFF0000) == 0x20000000)
 #endif
 
-#define TX_COUNTER_ABORT_REQ_VALUE 256
+#define TX_COUNTER_ABORT_REQ_VALUE SIZE_MAX
+
+// RXD.MAXCNT and TXD.MAXCNT of UARTE are 8 bits wide. Longer transfers are split
+// into chunks of this size.
+#define UARTE_MAX_XFER_LENGTH      255
 
 typedef struct
 {
@@ -60,16 +74,32 @@ typedef struct
     uint8_t          const * p_tx_buffer;
     uint8_t                * p_rx_buffer;
     uint8_t                * p_rx_secondary_buffer;
-    volatile uint16_t        tx_counter;
-    uint8_t                  tx_buffer_length;
-    uint8_t                  rx_buffer_length;
-    uint8_t                  rx_secondary_buffer_length;
-    volatile uint8_t         rx_counter;
+    volatile size_t          tx_counter;
+    size_t                   tx_buffer_length;
+    size_t                   rx_buffer_length;
+    size_t                   rx_secondary_buffer_length;
+    volatile size_t          rx_counter;
     bool                     rx_enabled;
     nrf_drv_state_t          state;
+    uint8_t                  interrupt_priority;
 #if (defined(UARTE_IN_USE) && defined(UART_IN_USE))
     bool                     use_easy_dma;
 #endif
+#if defined(UARTE_IN_USE)
+    size_t                   rx_armed_length;    // Bytes of the primary buffer handed over to EasyDMA.
+    bool                     rx_secondary_armed; // First chunk of the secondary buffer handed over to EasyDMA.
+    bool                     rx_next_pending;    // RXD.PTR holds a transfer that has not started yet.
+#endif
+#if defined(UARTE_RX_STREAM_IN_USE)
+    nrf_drv_uart_rx_stream_config_t rx_stream;
+    bool                     rx_stream_active;
+    bool                     rx_stream_stopping;
+    uint8_t                  rx_stream_next;     // Index of the buffer to be queued next.
+    size_t                   rx_stream_reported; // Bytes of the current buffer passed to the user.
+    uint32_t                 rx_stream_total;    // Bytes passed to the user since the stream was started.
+    nrf_ppi_channel_t        rx_stream_ppi_count;
+    nrf_ppi_channel_t        rx_stream_ppi_start;
+#endif
 } uart_control_block_t;
 
 static uart_control_block_t m_cb;
@@ -118,10 +148,12 @@ __STATIC_INLINE void interrupts_enable(uint8_t interrupt_priority)
         nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDTX);
         nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ERROR);
         nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXSTARTED);
         nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ENDRX_MASK |
                                          NRF_UARTE_INT_ENDTX_MASK |
                                          NRF_UARTE_INT_ERROR_MASK |
-                                         NRF_UARTE_INT_RXTO_MASK);
+                                         NRF_UARTE_INT_RXTO_MASK  |
+                                         NRF_UARTE_INT_RXSTARTED_MASK);
     )
     CODE_FOR_UART
     (
@@ -140,7 +172,8 @@ __STATIC_INLINE void interrupts_disable(void)
         nrf_uarte_int_disable(NRF_UARTE0, NRF_UARTE_INT_ENDRX_MASK |
                                           NRF_UARTE_INT_ENDTX_MASK |
                                           NRF_UARTE_INT_ERROR_MASK |
-                                          NRF_UARTE_INT_RXTO_MASK);
+                                          NRF_UARTE_INT_RXTO_MASK  |
+                                          NRF_UARTE_INT_RXSTARTED_MASK);
     )
     CODE_FOR_UART
     (
@@ -225,6 +258,7 @@ ret_code_t nrf_drv_uart_init(nrf_drv_uart_config_t const * p_config,
 
     m_cb.handler = event_handler;
     m_cb.p_context = p_config->p_context;
+    m_cb.interrupt_priority = p_config->interrupt_priority;
 
     if (m_cb.handler)
     {
@@ -275,7 +309,7 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_tx_for_uart()
 
     if (m_cb.handler == NULL)
     {
-        while (m_cb.tx_counter < (uint16_t) m_cb.tx_buffer_length)
+        while (m_cb.tx_counter < m_cb.tx_buffer_length)
         {
             while (!nrf_uart_event_check(NRF_UART0, NRF_UART_EVENT_TXDRDY) &&
                     m_cb.tx_counter != TX_COUNTER_ABORT_REQ_VALUE)
@@ -306,14 +340,25 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_tx_for_uart()
 #endif
 
 #if defined(UARTE_IN_USE)
+__STATIC_INLINE size_t uarte_chunk_length(size_t remaining)
+{
+    return (remaining > UARTE_MAX_XFER_LENGTH) ? UARTE_MAX_XFER_LENGTH : remaining;
+}
+
+__STATIC_INLINE void uarte_tx_chunk_start(void)
+{
+    nrf_uarte_tx_buffer_set(NRF_UARTE0, &m_cb.p_tx_buffer[m_cb.tx_counter],
+                            uarte_chunk_length(m_cb.tx_buffer_length - m_cb.tx_counter));
+    nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STARTTX);
+}
+
 __STATIC_INLINE ret_code_t nrf_drv_uart_tx_for_uarte()
 {    
     ret_code_t err_code = NRF_SUCCESS;
     
     nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDTX);
     nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_TXSTOPPED);
-    nrf_uarte_tx_buffer_set(NRF_UARTE0, m_cb.p_tx_buffer, m_cb.tx_buffer_length);
-    nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STARTTX);
+    uarte_tx_chunk_start();
 
     if (m_cb.handler == NULL)
     {
@@ -321,10 +366,25 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_tx_for_uarte()
         bool txstopped;
         do
         {
-            endtx     = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ENDTX);
-            txstopped = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_TXSTOPPED);
-        }
-        while ((!endtx) && (!txstopped));
+            do
+            {
+                endtx     = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ENDTX);
+                txstopped = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_TXSTOPPED);
+            }
+            while ((!endtx) && (!txstopped));
+
+            if (txstopped)
+            {
+                break;
+            }
+
+            nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDTX);
+            m_cb.tx_counter += nrf_uarte_tx_amount_get(NRF_UARTE0);
+            if (m_cb.tx_counter < m_cb.tx_buffer_length)
+            {
+                uarte_tx_chunk_start();
+            }
+        } while (m_cb.tx_counter < m_cb.tx_buffer_length);
 
         if (txstopped)
         {
@@ -337,7 +397,7 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_tx_for_uarte()
 }
 #endif
 
-ret_code_t nrf_drv_uart_tx(uint8_t const * const p_data, uint8_t length)
+ret_code_t nrf_drv_uart_tx(uint8_t const * const p_data, size_t length)
 {
     ASSERT(m_cb.state == NRF_DRV_STATE_INITIALIZED);
     ASSERT(length>0);
@@ -398,7 +458,7 @@ __STATIC_INLINE void rx_byte(void)
     m_cb.rx_counter++;
 }
 
-__STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uart(uint8_t * p_data, uint8_t length, bool second_buffer)
+__STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uart(uint8_t * p_data, size_t length, bool second_buffer)
 {
     if ((!m_cb.rx_enabled) && (!second_buffer))
     {
@@ -457,18 +517,111 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uart(uint8_t * p_data, uint8_t le
 #endif
 
 #if defined(UARTE_IN_USE)
-__STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uarte(uint8_t * p_data, uint8_t length, bool second_buffer)
+/**
+ * @brief Function for starting reception into the primary buffer.
+ *
+ * Only the first chunk is programmed here. Following chunks, and the secondary
+ * buffer, are armed from the RXSTARTED event, see @ref uarte_rx_next_arm.
+ */
+__STATIC_INLINE void uarte_rx_start(void)
+{
+    size_t length = uarte_chunk_length(m_cb.rx_buffer_length);
+
+    nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+    nrf_uarte_rx_buffer_set(NRF_UARTE0, m_cb.p_rx_buffer, length);
+    m_cb.rx_armed_length    = length;
+    m_cb.rx_secondary_armed = false;
+    m_cb.rx_next_pending    = true;
+    nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STARTRX);
+}
+
+__STATIC_INLINE void uarte_rx_chunk_arm(uint8_t * p_data, size_t length)
 {
-    nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
-    nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
     nrf_uarte_rx_buffer_set(NRF_UARTE0, p_data, length);
-    if (!second_buffer)
+    nrf_uarte_shorts_enable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+    m_cb.rx_next_pending = true;
+}
+
+/**
+ * @brief Function for arming the transfer that follows the one just started.
+ *
+ * Called on RXSTARTED, when RXD.PTR and RXD.MAXCNT have been latched and can be
+ * reprogrammed. The ENDRX_STARTRX shortcut then starts the armed transfer without
+ * CPU intervention. If there is nothing to arm, the shortcut is disabled so that
+ * the current transfer is not repeated.
+ */
+__STATIC_INLINE void uarte_rx_next_arm(void)
+{
+    m_cb.rx_next_pending = false;
+
+#if defined(UARTE_RX_STREAM_IN_USE)
+    if (m_cb.rx_stream_stopping)
+    {
+        nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+        return;
+    }
+#endif
+
+    if (m_cb.rx_armed_length < m_cb.rx_buffer_length)
     {
-        nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STARTRX);
+        size_t length = uarte_chunk_length(m_cb.rx_buffer_length - m_cb.rx_armed_length);
+        uarte_rx_chunk_arm(&m_cb.p_rx_buffer[m_cb.rx_armed_length], length);
+        m_cb.rx_armed_length += length;
+    }
+    else if (m_cb.rx_secondary_buffer_length && !m_cb.rx_secondary_armed)
+    {
+        uarte_rx_chunk_arm(m_cb.p_rx_secondary_buffer,
+                           uarte_chunk_length(m_cb.rx_secondary_buffer_length));
+        m_cb.rx_secondary_armed = true;
     }
     else
     {
-        nrf_uarte_shorts_enable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+        nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+    }
+}
+
+/**
+ * @brief Function for making the secondary buffer the primary one.
+ */
+__STATIC_INLINE void uarte_rx_secondary_switch(void)
+{
+    m_cb.p_rx_buffer                = m_cb.p_rx_secondary_buffer;
+    m_cb.rx_buffer_length           = m_cb.rx_secondary_buffer_length;
+    m_cb.rx_secondary_buffer_length = 0;
+    m_cb.rx_counter                 = 0;
+
+    if (m_cb.rx_secondary_armed)
+    {
+        m_cb.rx_armed_length    = uarte_chunk_length(m_cb.rx_buffer_length);
+        m_cb.rx_secondary_armed = false;
+    }
+    else
+    {
+        // The primary buffer was filled before the secondary one could be armed.
+        uarte_rx_start();
+    }
+}
+
+__STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uarte(uint8_t * p_data, size_t length, bool second_buffer)
+{
+    if (!second_buffer)
+    {
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXSTARTED);
+        uarte_rx_start();
+    }
+    else if (!m_cb.rx_next_pending && (m_cb.rx_armed_length == m_cb.rx_buffer_length))
+    {
+        // The last chunk of the primary buffer is in progress, arm the secondary buffer now.
+        uarte_rx_chunk_arm(p_data, uarte_chunk_length(length));
+        m_cb.rx_secondary_armed = true;
+        if (nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX) &&
+            !nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_RXSTARTED))
+        {
+            // The primary buffer got filled before the shortcut was enabled.
+            nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STARTRX);
+        }
     }
 
     if (m_cb.handler == NULL)
@@ -476,11 +629,28 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uarte(uint8_t * p_data, uint8_t l
         bool endrx;
         bool rxto;
         bool error;
-        do {
-            endrx  = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
-            rxto   = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
-            error  = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ERROR);
-        }while ((!endrx) && (!rxto) && (!error));
+        do
+        {
+            do {
+                endrx  = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
+                rxto   = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
+                error  = nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ERROR);
+            }while ((!endrx) && (!rxto) && (!error));
+
+            if (rxto || error)
+            {
+                break;
+            }
+
+            nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
+            m_cb.rx_counter += nrf_uarte_rx_amount_get(NRF_UARTE0);
+            if (m_cb.rx_counter < m_cb.rx_buffer_length)
+            {
+                nrf_uarte_rx_buffer_set(NRF_UARTE0, &m_cb.p_rx_buffer[m_cb.rx_counter],
+                                        uarte_chunk_length(m_cb.rx_buffer_length - m_cb.rx_counter));
+                nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STARTRX);
+            }
+        } while (m_cb.rx_counter < m_cb.rx_buffer_length);
 
         m_cb.rx_buffer_length = 0;
 
@@ -496,13 +666,15 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uarte(uint8_t * p_data, uint8_t l
     }
     else
     {
-        nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK | NRF_UARTE_INT_ENDRX_MASK);
+        nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK |
+                                         NRF_UARTE_INT_ENDRX_MASK |
+                                         NRF_UARTE_INT_RXSTARTED_MASK);
     }
     return NRF_SUCCESS;
 }
 #endif
 
-ret_code_t nrf_drv_uart_rx(uint8_t * p_data, uint8_t length)
+ret_code_t nrf_drv_uart_rx(uint8_t * p_data, size_t length)
 {
     ASSERT(m_cb.state == NRF_DRV_STATE_INITIALIZED);
     ASSERT(length>0);
@@ -517,13 +689,22 @@ ret_code_t nrf_drv_uart_rx(uint8_t * p_data, uint8_t length)
         }
     )
 
+#if defined(UARTE_RX_STREAM_IN_USE)
+    if (m_cb.rx_stream_active)
+    {
+        return NRF_ERROR_BUSY;
+    }
+#endif
+
     bool second_buffer = false;
 
     if (m_cb.handler)
     {
         CODE_FOR_UARTE
         (
-            nrf_uarte_int_disable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK | NRF_UARTE_INT_ENDRX_MASK);
+            nrf_uarte_int_disable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK |
+                                              NRF_UARTE_INT_ENDRX_MASK |
+                                              NRF_UARTE_INT_RXSTARTED_MASK);
         )
         CODE_FOR_UART
         (
@@ -538,7 +719,9 @@ ret_code_t nrf_drv_uart_rx(uint8_t * p_data, uint8_t length)
             {
                 CODE_FOR_UARTE
                 (
-                    nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK | NRF_UARTE_INT_ENDRX_MASK);
+                    nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK |
+                                                     NRF_UARTE_INT_ENDRX_MASK |
+                                                     NRF_UARTE_INT_RXSTARTED_MASK);
                 )
                 CODE_FOR_UART
                 (
@@ -620,7 +803,7 @@ uint32_t nrf_drv_uart_errorsrc_get(void)
     return errsrc;
 }
 
-__STATIC_INLINE void rx_done_event(uint8_t bytes, uint8_t * p_data)
+__STATIC_INLINE void rx_done_event(size_t bytes, uint8_t * p_data)
 {
     nrf_drv_uart_event_t event;
 
@@ -631,7 +814,7 @@ __STATIC_INLINE void rx_done_event(uint8_t bytes, uint8_t * p_data)
     m_cb.handler(&event,m_cb.p_context);
 }
 
-__STATIC_INLINE void tx_done_event(uint8_t bytes)
+__STATIC_INLINE void tx_done_event(size_t bytes)
 {
     nrf_drv_uart_event_t event;
 
@@ -673,6 +856,7 @@ void nrf_drv_uart_rx_abort(void)
 {
     CODE_FOR_UARTE
     (
+        nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
         nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STOPRX);
     )
     CODE_FOR_UART
@@ -682,6 +866,304 @@ void nrf_drv_uart_rx_abort(void)
     )
 }
 
+#if defined(UARTE_RX_STREAM_IN_USE)
+/**
+ * @brief Function for passing the received part of the current stream buffer to the user.
+ *
+ * @param[in] filled Number of bytes stored so far in the current buffer.
+ */
+static void rx_stream_data_report(size_t filled)
+{
+    if (filled > m_cb.rx_stream_reported)
+    {
+        nrf_drv_uart_event_t event;
+
+        event.type             = NRF_DRV_UART_EVT_RX_DATA;
+        event.data.rxtx.bytes  = filled - m_cb.rx_stream_reported;
+        event.data.rxtx.p_data = &m_cb.p_rx_buffer[m_cb.rx_stream_reported];
+
+        m_cb.rx_stream_reported  = filled;
+        m_cb.rx_stream_total    += event.data.rxtx.bytes;
+
+        m_cb.handler(&event, m_cb.p_context);
+    }
+}
+
+static void rx_stream_buffer_queue(void)
+{
+    m_cb.p_rx_secondary_buffer      = &m_cb.rx_stream.p_buffer[m_cb.rx_stream_next *
+                                                               m_cb.rx_stream.buffer_size];
+    m_cb.rx_secondary_buffer_length = m_cb.rx_stream.buffer_size;
+
+    m_cb.rx_stream_next++;
+    if (m_cb.rx_stream_next == m_cb.rx_stream.buffer_count)
+    {
+        m_cb.rx_stream_next = 0;
+    }
+}
+
+static void rx_stream_endrx(size_t amount)
+{
+    rx_stream_data_report(amount);
+
+    // A shorter transfer means that the stream is being stopped. Once stopping,
+    // only a buffer already started by the shortcut is followed.
+    if ((amount == m_cb.rx_buffer_length) && m_cb.rx_secondary_buffer_length &&
+        (!m_cb.rx_stream_stopping || m_cb.rx_secondary_armed))
+    {
+        uarte_rx_secondary_switch();
+        m_cb.rx_stream_reported = 0;
+        if (!m_cb.rx_stream_stopping)
+        {
+            rx_stream_buffer_queue();
+        }
+    }
+}
+
+static void rx_stream_timeout_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    if ((event_type == NRF_TIMER_EVENT_COMPARE0) && m_cb.rx_stream_active)
+    {
+        uint32_t received = nrf_drv_timer_capture(m_cb.rx_stream.p_counter_timer,
+                                                  NRF_TIMER_CC_CHANNEL0);
+        size_t   filled   = m_cb.rx_stream_reported + (received - m_cb.rx_stream_total);
+
+        // Bytes beyond the current buffer are reported on its ENDRX.
+        rx_stream_data_report(MIN(filled, m_cb.rx_buffer_length));
+    }
+}
+
+static void rx_stream_counter_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+static void rx_stream_timers_release(void)
+{
+    (void)nrf_drv_ppi_channel_disable(m_cb.rx_stream_ppi_count);
+    (void)nrf_drv_ppi_channel_disable(m_cb.rx_stream_ppi_start);
+    (void)nrf_drv_ppi_channel_free(m_cb.rx_stream_ppi_count);
+    (void)nrf_drv_ppi_channel_free(m_cb.rx_stream_ppi_start);
+    nrf_drv_timer_uninit(m_cb.rx_stream.p_timeout_timer);
+    nrf_drv_timer_uninit(m_cb.rx_stream.p_counter_timer);
+}
+
+static void rx_stream_finish(void)
+{
+    if (m_cb.rx_stream.timeout_us)
+    {
+        rx_stream_timers_release();
+    }
+
+    m_cb.rx_stream_active           = false;
+    m_cb.rx_stream_stopping         = false;
+    m_cb.rx_buffer_length           = 0;
+    m_cb.rx_secondary_buffer_length = 0;
+
+    rx_done_event(0, NULL);
+}
+
+/**
+ * @brief Function for setting up the byte counter and idle timeout.
+ *
+ * Every received byte increments the counter timer and restarts the timeout timer,
+ * which stops itself and generates an interrupt when the line has been idle for
+ * the configured time.
+ */
+static ret_code_t rx_stream_timers_setup(void)
+{
+    nrf_drv_uart_rx_stream_config_t const * p_config = &m_cb.rx_stream;
+    nrf_drv_timer_config_t timer_config;
+    ret_code_t             err_code;
+
+    err_code = nrf_drv_ppi_init();
+    if ((err_code != NRF_SUCCESS) && (err_code != MODULE_ALREADY_INITIALIZED))
+    {
+        return err_code;
+    }
+
+    timer_config.frequency          = NRF_TIMER_FREQ_16MHz;
+    timer_config.mode               = NRF_TIMER_MODE_COUNTER;
+    timer_config.bit_width          = NRF_TIMER_BIT_WIDTH_32;
+    timer_config.interrupt_priority = m_cb.interrupt_priority;
+    timer_config.p_context          = NULL;
+    err_code = nrf_drv_timer_init(p_config->p_counter_timer, &timer_config,
+                                  rx_stream_counter_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    // The timeout timer interrupt must not preempt the UARTE interrupt, so both
+    // use the same priority.
+    timer_config.frequency = NRF_TIMER_FREQ_1MHz;
+    timer_config.mode      = NRF_TIMER_MODE_TIMER;
+    err_code = nrf_drv_timer_init(p_config->p_timeout_timer, &timer_config,
+                                  rx_stream_timeout_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        nrf_drv_timer_uninit(p_config->p_counter_timer);
+        return err_code;
+    }
+
+    err_code = nrf_drv_ppi_channel_alloc(&m_cb.rx_stream_ppi_count);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_alloc(&m_cb.rx_stream_ppi_start);
+        if (err_code != NRF_SUCCESS)
+        {
+            (void)nrf_drv_ppi_channel_free(m_cb.rx_stream_ppi_count);
+        }
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        nrf_drv_timer_uninit(p_config->p_timeout_timer);
+        nrf_drv_timer_uninit(p_config->p_counter_timer);
+        return err_code;
+    }
+
+    nrf_drv_timer_extended_compare(p_config->p_timeout_timer,
+                                   NRF_TIMER_CC_CHANNEL0,
+                                   nrf_drv_timer_us_to_ticks(p_config->p_timeout_timer,
+                                                             p_config->timeout_us),
+                                   NRF_TIMER_SHORT_COMPARE0_STOP_MASK,
+                                   true);
+
+    // The timeout timer is started by the first received byte.
+    nrf_drv_timer_enable(p_config->p_timeout_timer);
+    nrf_drv_timer_pause(p_config->p_timeout_timer);
+    nrf_drv_timer_clear(p_config->p_timeout_timer);
+    nrf_drv_timer_enable(p_config->p_counter_timer);
+    nrf_drv_timer_clear(p_config->p_counter_timer);
+
+    // The UARTE register map does not list EVENTS_RXDRDY, but the event is located
+    // at the same offset as in UART.
+    uint32_t rxdrdy = nrf_uart_event_address_get(NRF_UART0, NRF_UART_EVENT_RXDRDY);
+
+    err_code = nrf_drv_ppi_channel_assign(m_cb.rx_stream_ppi_count, rxdrdy,
+        nrf_drv_timer_task_address_get(p_config->p_counter_timer, NRF_TIMER_TASK_COUNT));
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_fork_assign(m_cb.rx_stream_ppi_count,
+            nrf_drv_timer_task_address_get(p_config->p_timeout_timer, NRF_TIMER_TASK_CLEAR));
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_assign(m_cb.rx_stream_ppi_start, rxdrdy,
+            nrf_drv_timer_task_address_get(p_config->p_timeout_timer, NRF_TIMER_TASK_START));
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_enable(m_cb.rx_stream_ppi_count);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_enable(m_cb.rx_stream_ppi_start);
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        rx_stream_timers_release();
+    }
+    return err_code;
+}
+#endif // defined(UARTE_RX_STREAM_IN_USE)
+
+#if (UART_RX_STREAM_SUPPORT == 1)
+ret_code_t nrf_drv_uart_rx_stream_start(nrf_drv_uart_rx_stream_config_t const * p_config)
+{
+    ASSERT(m_cb.state == NRF_DRV_STATE_INITIALIZED);
+    ASSERT(p_config);
+
+    CODE_FOR_UARTE
+    (
+        ret_code_t err_code;
+
+        if (m_cb.handler == NULL)
+        {
+            return NRF_ERROR_INVALID_STATE;
+        }
+
+        if ((p_config->buffer_count < 2) || (p_config->buffer_size == 0) ||
+            ((p_config->timeout_us != 0) &&
+             ((p_config->p_counter_timer == NULL) || (p_config->p_timeout_timer == NULL))))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        // EasyDMA requires that transfer buffers are placed in DataRAM,
+        // signal error if the are not.
+        if (!IS_EASY_DMA_RAM_ADDRESS(p_config->p_buffer))
+        {
+            return NRF_ERROR_INVALID_ADDR;
+        }
+
+        if (m_cb.rx_buffer_length != 0)
+        {
+            return NRF_ERROR_BUSY;
+        }
+
+        m_cb.rx_stream = *p_config;
+        if (p_config->timeout_us)
+        {
+            err_code = rx_stream_timers_setup();
+            if (err_code != NRF_SUCCESS)
+            {
+                return err_code;
+            }
+        }
+
+        nrf_uarte_int_disable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK |
+                                          NRF_UARTE_INT_ENDRX_MASK |
+                                          NRF_UARTE_INT_RXSTARTED_MASK);
+
+        m_cb.rx_stream_active   = true;
+        m_cb.rx_stream_stopping = false;
+        m_cb.rx_stream_reported = 0;
+        m_cb.rx_stream_total    = 0;
+        m_cb.rx_counter         = 0;
+
+        m_cb.p_rx_buffer      = p_config->p_buffer;
+        m_cb.rx_buffer_length = p_config->buffer_size;
+        m_cb.rx_stream_next   = 1;
+        rx_stream_buffer_queue();
+
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXSTARTED);
+        uarte_rx_start();
+
+        nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ERROR_MASK |
+                                         NRF_UARTE_INT_ENDRX_MASK |
+                                         NRF_UARTE_INT_RXSTARTED_MASK);
+        return NRF_SUCCESS;
+    )
+    CODE_FOR_UART
+    (
+        return NRF_ERROR_NOT_SUPPORTED;
+    )
+}
+
+void nrf_drv_uart_rx_stream_stop(void)
+{
+    CODE_FOR_UARTE
+    (
+        if (m_cb.rx_stream_active && !m_cb.rx_stream_stopping)
+        {
+            nrf_uarte_int_disable(NRF_UARTE0, NRF_UARTE_INT_ENDRX_MASK |
+                                              NRF_UARTE_INT_RXSTARTED_MASK);
+            m_cb.rx_stream_stopping = true;
+            nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+            nrf_uarte_task_trigger(NRF_UARTE0, NRF_UARTE_TASK_STOPRX);
+            nrf_uarte_int_enable(NRF_UARTE0, NRF_UARTE_INT_ENDRX_MASK |
+                                             NRF_UARTE_INT_RXSTARTED_MASK);
+        }
+    )
+}
+#endif // (UART_RX_STREAM_SUPPORT == 1)
+
 
 #if defined(UART_IN_USE)
 __STATIC_INLINE void uart_irq_handler()
@@ -716,7 +1198,7 @@ __STATIC_INLINE void uart_irq_handler()
             if (m_cb.rx_secondary_buffer_length)
             {
                 uint8_t * p_data     = m_cb.p_rx_buffer;
-                uint8_t   rx_counter = m_cb.rx_counter;
+                size_t    rx_counter = m_cb.rx_counter;
                 
                 //Switch to secondary buffer.
                 m_cb.rx_buffer_length = m_cb.rx_secondary_buffer_length;
@@ -740,7 +1222,7 @@ __STATIC_INLINE void uart_irq_handler()
 
     if (nrf_uart_event_check(NRF_UART0, NRF_UART_EVENT_TXDRDY))
     {
-        if (m_cb.tx_counter < (uint16_t) m_cb.tx_buffer_length)
+        if (m_cb.tx_counter < m_cb.tx_buffer_length)
         {
             tx_byte();
         }
@@ -783,47 +1265,83 @@ __STATIC_INLINE void uarte_irq_handler()
 
         event.type                   = NRF_DRV_UART_EVT_ERROR;
         event.data.error.error_mask  = nrf_uarte_errorsrc_get_and_clear(NRF_UARTE0);
-        event.data.error.rxtx.bytes  = nrf_uarte_rx_amount_get(NRF_UARTE0);
+        event.data.error.rxtx.bytes  = m_cb.rx_counter + nrf_uarte_rx_amount_get(NRF_UARTE0);
         event.data.error.rxtx.p_data = m_cb.p_rx_buffer;
 
-        //abort transfer
-        m_cb.rx_buffer_length = 0;
-        m_cb.rx_secondary_buffer_length = 0;
+#if defined(UARTE_RX_STREAM_IN_USE)
+        // Streaming reception is not aborted, the error is only reported.
+        if (m_cb.rx_stream_active)
+        {
+            event.data.error.rxtx.bytes = 0;
+        }
+        else
+#endif
+        {
+            //abort transfer
+            nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
+            m_cb.rx_buffer_length = 0;
+            m_cb.rx_secondary_buffer_length = 0;
+        }
 
         m_cb.handler(&event,m_cb.p_context);
     }
     else if (nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX))
     {
         nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDRX);
-        uint8_t amount = nrf_uarte_rx_amount_get(NRF_UARTE0);
+        size_t amount = nrf_uarte_rx_amount_get(NRF_UARTE0);
+#if defined(UARTE_RX_STREAM_IN_USE)
+        if (m_cb.rx_stream_active)
+        {
+            rx_stream_endrx(amount);
+        }
+        else
+#endif
         // If the transfer was stopped before completion, amount of transfered bytes
-        // will not be equal to the buffer length. Interrupted trunsfer is ignored.
-        if (amount == m_cb.rx_buffer_length)
+        // will not be equal to the chunk length. Interrupted trunsfer is ignored.
+        if (m_cb.rx_buffer_length &&
+            (amount == uarte_chunk_length(m_cb.rx_buffer_length - m_cb.rx_counter)))
         {
-            if (m_cb.rx_secondary_buffer_length)
+            m_cb.rx_counter += amount;
+            // The next chunk of the buffer has already been started by the shortcut.
+            if (m_cb.rx_counter == m_cb.rx_buffer_length)
             {
                 uint8_t * p_data = m_cb.p_rx_buffer;
-                nrf_uarte_shorts_disable(NRF_UARTE0, NRF_UARTE_SHORT_ENDRX_STARTRX);
-                m_cb.rx_buffer_length = m_cb.rx_secondary_buffer_length;
-                m_cb.p_rx_buffer = m_cb.p_rx_secondary_buffer;
-                m_cb.rx_secondary_buffer_length = 0;
-                rx_done_event(amount, p_data);
-            }
-            else
-            {
-                m_cb.rx_buffer_length = 0;
-                rx_done_event(amount, m_cb.p_rx_buffer);
+                size_t    bytes  = m_cb.rx_counter;
+
+                if (m_cb.rx_secondary_buffer_length)
+                {
+                    uarte_rx_secondary_switch();
+                }
+                else
+                {
+                    m_cb.rx_buffer_length = 0;
+                }
+                rx_done_event(bytes, p_data);
             }
         }
     }
 
+    if (nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_RXSTARTED))
+    {
+        nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXSTARTED);
+        uarte_rx_next_arm();
+    }
+
     if (nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_RXTO))
     {
         nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_RXTO);
+#if defined(UARTE_RX_STREAM_IN_USE)
+        if (m_cb.rx_stream_active)
+        {
+            rx_stream_finish();
+        }
+        else
+#endif
         if (m_cb.rx_buffer_length)
         {
             m_cb.rx_buffer_length = 0;
-            rx_done_event(nrf_uarte_rx_amount_get(NRF_UARTE0), m_cb.p_rx_buffer);
+            m_cb.rx_secondary_buffer_length = 0;
+            rx_done_event(m_cb.rx_counter + nrf_uarte_rx_amount_get(NRF_UARTE0), m_cb.p_rx_buffer);
         }
     }
 
@@ -832,7 +1350,20 @@ __STATIC_INLINE void uarte_irq_handler()
         nrf_uarte_event_clear(NRF_UARTE0, NRF_UARTE_EVENT_ENDTX);
         if (m_cb.tx_buffer_length)
         {
-            tx_done_event(nrf_uarte_tx_amount_get(NRF_UARTE0));
+            size_t chunk = uarte_chunk_length(m_cb.tx_buffer_length - m_cb.tx_counter);
+            size_t amount = nrf_uarte_tx_amount_get(NRF_UARTE0);
+
+            m_cb.tx_counter += amount;
+            // A shorter transfer or TXSTOPPED means that the transmission was aborted.
+            if ((amount == chunk) && (m_cb.tx_counter < m_cb.tx_buffer_length) &&
+                !nrf_uarte_event_check(NRF_UARTE0, NRF_UARTE_EVENT_TXSTOPPED))
+            {
+                uarte_tx_chunk_start();
+            }
+            else
+            {
+                tx_done_event(m_cb.tx_counter);
+            }
         }
     }
 }
@@ -840,6 +1371,8 @@ __STATIC_INLINE void uarte_irq_handler()
 
 void UART0_IRQHandler(void)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(UART0_IRQn);
+
     CODE_FOR_UARTE
     (
         uarte_irq_handler();
@@ -848,4 +1381,6 @@ void UART0_IRQHandler(void)
     (
         uart_irq_handler();
     )
+
+    NRF_DRV_IRQ_MONITOR_EXIT(UART0_IRQn);
 }
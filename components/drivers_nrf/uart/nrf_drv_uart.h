@@ -33,6 +33,9 @@
 
 #include "sdk_errors.h"
 #include "nrf_drv_config.h"
+#if (UART_RX_STREAM_SUPPORT == 1)
+#include "nrf_drv_timer.h"
+#endif
 
 /**
  * @brief Types of UART driver events.
@@ -42,6 +45,7 @@ typedef enum
     NRF_DRV_UART_EVT_TX_DONE, ///< Requested TX transfer completed.
     NRF_DRV_UART_EVT_RX_DONE, ///< Requested RX transfer completed.
     NRF_DRV_UART_EVT_ERROR,   ///< Error reported by UART peripheral.
+    NRF_DRV_UART_EVT_RX_DATA, ///< Data received in streaming mode (see @ref nrf_drv_uart_rx_stream_start).
 } nrf_drv_uart_evt_type_t;
 
 /**@brief Structure for UART configuration. */
@@ -102,7 +106,7 @@ typedef struct
 typedef struct
 {
     uint8_t * p_data; ///< Pointer to memory used for transfer.
-    uint8_t   bytes;  ///< Number of bytes transfered.
+    size_t    bytes;  ///< Number of bytes transfered.
 } nrf_drv_uart_xfer_evt_t;
 
 /**@brief Structure for UART error event. */
@@ -132,6 +136,19 @@ typedef struct
  */
 typedef void (*nrf_uart_event_handler_t)(nrf_drv_uart_event_t * p_event, void * p_context);
 
+#if (UART_RX_STREAM_SUPPORT == 1)
+/**@brief Structure for UARTE streaming reception configuration. */
+typedef struct
+{
+    uint8_t               * p_buffer;        ///< Memory for the rotating buffers (buffer_count * buffer_size bytes, in Data RAM).
+    uint8_t                 buffer_size;     ///< Size of a single buffer.
+    uint8_t                 buffer_count;    ///< Number of buffers, at least 2.
+    uint32_t                timeout_us;      ///< Line idle time after which received data is reported. 0 disables the timeout.
+    nrf_drv_timer_t const * p_counter_timer; ///< Timer instance used to count received bytes (required if timeout_us is not 0).
+    nrf_drv_timer_t const * p_timeout_timer; ///< Timer instance used to detect the idle line (required if timeout_us is not 0).
+} nrf_drv_uart_rx_stream_config_t;
+#endif
+
 /**
  * @brief Function for initializing the UART driver.
  *
@@ -182,6 +199,8 @@ __STATIC_INLINE uint32_t nrf_drv_uart_event_address_get(nrf_uart_event_t event);
  * @note Peripherals using EasyDMA (i.e. UARTE) require that the transfer buffers
  *       are placed in the Data RAM region. If they are not and UARTE instance is
  *       used, this function will fail with error code NRF_ERROR_INVALID_ADDR.
+ * @note UARTE transfers at most 255 bytes at a time. Longer buffers are sent in
+ *       consecutive chunks and a single event is generated for the whole buffer.
  *
  * @param[in] p_data Pointer to data.
  * @param[in] length Number of bytes to send.
@@ -192,7 +211,7 @@ __STATIC_INLINE uint32_t nrf_drv_uart_event_address_get(nrf_uart_event_t event);
  *                                   (blocking mode only, also see @ref nrf_drv_uart_rx_disable).
  * @retval    NRF_ERROR_INVALID_ADDR If p_data does not point to RAM buffer (UARTE only).
  */
-ret_code_t nrf_drv_uart_tx(uint8_t const * const p_data, uint8_t length);
+ret_code_t nrf_drv_uart_tx(uint8_t const * const p_data, size_t length);
 
 /**
  * @brief Function for checking if UART is currently transmitting.
@@ -227,6 +246,9 @@ void nrf_drv_uart_tx_abort(void);
  * @note Peripherals using EasyDMA (i.e. UARTE) require that the transfer buffers
  *       are placed in the Data RAM region. If they are not and UARTE instance is
  *       used, this function will fail with error code NRF_ERROR_INVALID_ADDR.
+ * @note UARTE receives at most 255 bytes at a time. Longer buffers are filled in
+ *       consecutive chunks chained with the ENDRX_STARTRX shortcut, and a single
+ *       event is generated for the whole buffer.
  * @param[in] p_data Pointer to data.
  * @param[in] length Number of bytes to receive.
  *
@@ -239,7 +261,49 @@ void nrf_drv_uart_tx_abort(void);
  * @retval    NRF_ERROR_INTERNAL If UART peripheral reported an error.
  * @retval    NRF_ERROR_INVALID_ADDR If p_data does not point to RAM buffer (UARTE only).
  */
-ret_code_t nrf_drv_uart_rx(uint8_t * p_data, uint8_t length);
+ret_code_t nrf_drv_uart_rx(uint8_t * p_data, size_t length);
+
+#if (UART_RX_STREAM_SUPPORT == 1)
+/**
+ * @brief Function for starting continuous reception (UARTE only).
+ *
+ * Reception rotates through @p buffer_count buffers. The next buffer is armed as soon
+ * as the current one has started, and the ENDRX_STARTRX shortcut switches between
+ * them in hardware, so no bytes are lost between buffers. Received data is passed
+ * to the event handler with @ref NRF_DRV_UART_EVT_RX_DATA events when a buffer is
+ * filled and, if @p timeout_us is set, when the line has been idle for that time.
+ * Each event covers only the bytes not reported before.
+ *
+ * The idle timeout uses two TIMER instances and two PPI channels: RXDRDY increments
+ * the counter timer and restarts the timeout timer. Both timer instances must be
+ * enabled in nrf_drv_config.h and must not be initialized by the application.
+ *
+ * Errors are reported with @ref NRF_DRV_UART_EVT_ERROR, but reception continues.
+ *
+ * @note Data in an event is valid until the driver wraps around to the same buffer,
+ *       that is for the time needed to receive (buffer_count - 1) * buffer_size bytes.
+ *
+ * @param[in] p_config Streaming configuration. It is copied by the driver.
+ *
+ * @retval    NRF_SUCCESS             If reception was started.
+ * @retval    NRF_ERROR_INVALID_STATE If the driver works in blocking mode.
+ * @retval    NRF_ERROR_INVALID_PARAM If the configuration is invalid.
+ * @retval    NRF_ERROR_INVALID_ADDR  If the buffers are not placed in Data RAM.
+ * @retval    NRF_ERROR_BUSY          If the driver is already receiving.
+ * @retval    NRF_ERROR_NOT_SUPPORTED If the driver does not use EasyDMA.
+ * @return    Error code returned by the timer or PPI driver.
+ */
+ret_code_t nrf_drv_uart_rx_stream_start(nrf_drv_uart_rx_stream_config_t const * p_config);
+
+/**
+ * @brief Function for stopping continuous reception.
+ *
+ * Data received so far is reported with @ref NRF_DRV_UART_EVT_RX_DATA. When the
+ * receiver has stopped, @ref NRF_DRV_UART_EVT_RX_DONE with no data is generated and
+ * the timers and PPI channels are released.
+ */
+void nrf_drv_uart_rx_stream_stop(void);
+#endif
 
 /**
  * @brief Function for enabling receiver.
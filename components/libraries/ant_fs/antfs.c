@@ -190,6 +190,8 @@ static ulong_union_t   m_bytes_remaining;                                 /**< T
 static ulong_union_t   m_max_transfer_index;                              /**< Upper limit of the current Tx burst block (bytes). */
 static uint32_t        m_bytes_to_write;                                  /**< Number of bytes to write to file (upload). */
 static const uint8_t * mp_upload_data;                                    /**< Address of begin of the buffer that holds data received from upload. */
+static const uint8_t * mp_download_data;                                  /**< Address of the memory mapped file of the current download, NULL if the application provides the data. */
+static bool            m_is_mapped_data_pending;                          /**< Data from the memory mapped file is to be sent. */
 #ifdef ANTFS_INCLUDE_UPLOAD
     static ulong_union_t m_block_size;                                    /**< Number of bytes the client can receive in a single burst. */
 #endif // ANTFS_INCLUDE_UPLOAD
@@ -315,6 +317,9 @@ static void beacon_transmit(uint32_t message_type)
     }
     else if(message_type == MESG_BURST_DATA_ID)
     {
+        // A pipelined download block may still be read by the burst handler.
+        wait_burst_request_to_complete();
+
         // Send as the first packet of a burst.
         const uint32_t err_code = sd_ant_burst_handler_request(ANTFS_CHANNEL,
                                                                 sizeof(tx_buffer),
@@ -575,6 +580,23 @@ static void event_queue_write(antfs_event_t event_code)
 }
 
 
+/**@brief Function for requesting the next block of data of the current download.
+ *
+ * The data is requested from the application, unless the file is memory mapped.
+ */
+static void download_data_request(void)
+{
+    if (mp_download_data != NULL)
+    {
+        m_is_mapped_data_pending = true;
+    }
+    else
+    {
+        event_queue_write(ANTFS_EVENT_DOWNLOAD_REQUEST_DATA);
+    }
+}
+
+
 /**@brief Function for transmitting download request response message.
  *
  * @param[in] response         Download response code.
@@ -659,8 +681,13 @@ static void download_request_response_transmit(uint8_t response)
 }
 
 
-void antfs_download_req_resp_prepare(uint8_t response,
-                                     const antfs_request_info_t * const p_request_info)
+/**@brief Function for doing calculations prior downloading the data to the ANT-FS host.
+ *
+ * @param[in] response         The download request response code.
+ * @param[in] p_request_info   ANT-FS request info structure.
+ */
+static void download_req_resp_prepare(uint8_t response,
+                                      const antfs_request_info_t * const p_request_info)
 {
     // This function should only be called after receiving a download request.
     APP_ERROR_CHECK_BOOL((m_current_state.state == ANTFS_STATE_TRANS) &&
@@ -750,13 +777,47 @@ void antfs_download_req_resp_prepare(uint8_t response,
         m_is_data_request_pending = true;
 
         // Request data from application.
-        event_queue_write(ANTFS_EVENT_DOWNLOAD_REQUEST_DATA);
+        download_data_request();
 
         m_current_state.sub_state.trans_sub_state = ANTFS_TRANS_SUBSTATE_VERIFY_CRC;
     }
 }
 
 
+void antfs_download_req_resp_prepare(uint8_t response,
+                                     const antfs_request_info_t * const p_request_info)
+{
+    mp_download_data = NULL;
+
+    download_req_resp_prepare(response, p_request_info);
+}
+
+
+void antfs_download_req_resp_prepare_mapped(uint8_t response,
+                                            const antfs_request_info_t * const p_request_info,
+                                            const uint8_t * p_file_data)
+{
+    APP_ERROR_CHECK_BOOL((response != 0) || (p_file_data != NULL));
+
+    mp_download_data         = p_file_data;
+    m_is_mapped_data_pending = false;
+
+    download_req_resp_prepare(response, p_request_info);
+
+    // Burst the rest of the block straight from the file. When resuming, a first pass may only
+    // verify the CRC of the data before the requested offset.
+    while (m_is_mapped_data_pending)
+    {
+        m_is_mapped_data_pending = false;
+
+        UNUSED_VARIABLE(antfs_input_data_download(m_file_index.data,
+                                                  m_link_burst_index.data,
+                                                  m_max_transfer_index.data - m_link_burst_index.data,
+                                                  &mp_download_data[m_link_burst_index.data]));
+    }
+}
+
+
 uint32_t antfs_input_data_download(uint16_t index,
                                    uint32_t offset,
                                    uint32_t num_bytes,
@@ -861,7 +922,7 @@ uint32_t antfs_input_data_download(uint16_t index,
                 m_transfer_crc = crc_crc16_update(m_transfer_crc, p_message, num_bytes);
 
                 // Request more data.
-                event_queue_write(ANTFS_EVENT_DOWNLOAD_REQUEST_DATA);
+                download_data_request();
             }
         }
 
@@ -878,6 +939,11 @@ uint32_t antfs_input_data_download(uint16_t index,
                 num_of_bytes_to_burst += BURST_PACKET_SIZE;
             }
 
+#if defined(ANTFS_DOWNLOAD_PIPELINED)
+            // Wait for the burst handler to be done with the previous block.
+            wait_burst_request_to_complete();
+#endif // ANTFS_DOWNLOAD_PIPELINED
+
             uint32_t err_code = sd_ant_burst_handler_request(ANTFS_CHANNEL,
                                                              num_of_bytes_to_burst,
                                                              (uint8_t*)&(p_message[block_offset]),
@@ -889,7 +955,9 @@ uint32_t antfs_input_data_download(uint16_t index,
                 APP_ERROR_CHECK(err_code);
             }
 
+#if !defined(ANTFS_DOWNLOAD_PIPELINED)
             wait_burst_request_to_complete();
+#endif // ANTFS_DOWNLOAD_PIPELINED
 
             // Update current burst index.
             m_link_burst_index.data += num_bytes;
@@ -921,7 +989,7 @@ uint32_t antfs_input_data_download(uint16_t index,
                 // If we have not finished the download.
 
                 // Request more data.
-                event_queue_write(ANTFS_EVENT_DOWNLOAD_REQUEST_DATA);
+                download_data_request();
 
                 m_is_data_request_pending = true;
             }
@@ -940,6 +1008,9 @@ uint32_t antfs_input_data_download(uint16_t index,
                 tx_buffer[6] = (uint8_t)m_transfer_crc;
                 tx_buffer[7] = (uint8_t)(m_transfer_crc >> 8u);
 
+                // Wait for the burst handler to be done with the last block.
+                wait_burst_request_to_complete();
+
                 err_code = sd_ant_burst_handler_request(ANTFS_CHANNEL,
                                                         sizeof(tx_buffer),
                                                         tx_buffer,
@@ -278,7 +278,29 @@ bool antfs_pairing_resp_transmit(bool accept);
 void antfs_download_req_resp_prepare(uint8_t response,
                                              const antfs_request_info_t * const p_request_info);
 
+/**@brief Function for doing calculations prior downloading a memory mapped file to the ANT-FS
+ *        host, and downloading it.
+ *
+ * Same as @ref antfs_download_req_resp_prepare, but the data is burst straight from the file, in
+ * a single burst request, instead of being requested from the application block by block with
+ * @ref ANTFS_EVENT_DOWNLOAD_REQUEST_DATA events. The file must stay unchanged until the download
+ * completes or fails, and must be readable up to the next multiple of 8 bytes past its end.
+ *
+ * @param[in] response            The download request response code.
+ * @param[in] p_request_info      ANT-FS request info structure.
+ * @param[in] p_file_data         Address of the first byte of the file, for example in flash. Can
+ *                                be NULL if the download request is rejected.
+ */
+void antfs_download_req_resp_prepare_mapped(uint8_t response,
+                                            const antfs_request_info_t * const p_request_info,
+                                            const uint8_t * p_file_data);
+
 /**@brief Function for downloading requested data.
+ *
+ * @note If ANTFS_DOWNLOAD_PIPELINED is defined, the function returns as soon as the data is handed
+ *       to the burst handler, so that the application can read the next block while this one is
+ *       sent. The buffer is read by the burst handler until the next call to this function
+ *       returns, so the application must alternate between two buffers.
  *
  * @param[in] index               Index of the current file downloaded.
  * @param[in] offset              Offset specified by client.
@@ -0,0 +1,131 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_adpcm.h"
+
+static const int16_t m_step_table[APP_ADPCM_STEP_INDEX_MAX + 1] =
+{
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,
+    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+    5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t m_index_table[8] =
+{
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+
+/**@brief Function for updating the state with a code, as both the encoder and the decoder do.
+ */
+static void state_update(app_adpcm_state_t * p_state, uint8_t code)
+{
+    int32_t const step  = m_step_table[p_state->step_index];
+    int32_t       diff  = step >> 3;
+    int32_t       value = p_state->predictor;
+    int32_t       index = p_state->step_index + m_index_table[code & 0x07];
+
+    if (code & 0x04)
+    {
+        diff += step;
+    }
+    if (code & 0x02)
+    {
+        diff += step >> 1;
+    }
+    if (code & 0x01)
+    {
+        diff += step >> 2;
+    }
+
+    value += (code & 0x08) ? -diff : diff;
+    value  = (value > INT16_MAX) ? INT16_MAX : ((value < INT16_MIN) ? INT16_MIN : value);
+    index  = (index < 0) ? 0 : ((index > APP_ADPCM_STEP_INDEX_MAX) ? APP_ADPCM_STEP_INDEX_MAX : index);
+
+    p_state->predictor  = (int16_t)value;
+    p_state->step_index = (uint8_t)index;
+}
+
+
+static uint8_t sample_encode(app_adpcm_state_t * p_state, int16_t sample)
+{
+    int32_t step  = m_step_table[p_state->step_index];
+    int32_t diff  = (int32_t)sample - p_state->predictor;
+    uint8_t code  = 0;
+
+    if (diff < 0)
+    {
+        code = 0x08;
+        diff = -diff;
+    }
+    if (diff >= step)
+    {
+        code |= 0x04;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step)
+    {
+        code |= 0x02;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step)
+    {
+        code |= 0x01;
+    }
+
+    state_update(p_state, code);
+
+    return code;
+}
+
+
+void app_adpcm_encode(app_adpcm_state_t * p_state,
+                      int16_t const *     p_samples,
+                      uint32_t            count,
+                      uint8_t *           p_out)
+{
+    uint32_t i;
+
+    for (i = 0; i + 1 < count; i += 2)
+    {
+        uint8_t const low = sample_encode(p_state, p_samples[i]);
+
+        *p_out++ = low | (uint8_t)(sample_encode(p_state, p_samples[i + 1]) << 4);
+    }
+    if (i < count)
+    {
+        *p_out = sample_encode(p_state, p_samples[i]);
+    }
+}
+
+
+void app_adpcm_decode(app_adpcm_state_t * p_state,
+                      uint8_t const *     p_data,
+                      uint32_t            count,
+                      int16_t *           p_samples)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint8_t const code = (i & 1) ? (p_data[i >> 1] >> 4) : (p_data[i >> 1] & 0x0F);
+
+        state_update(p_state, code);
+        p_samples[i] = p_state->predictor;
+    }
+}
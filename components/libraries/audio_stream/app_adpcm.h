@@ -0,0 +1,70 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_ADPCM_H__
+#define APP_ADPCM_H__
+
+#include <stdint.h>
+
+/**
+ * @defgroup app_adpcm IMA ADPCM codec
+ * @{
+ * @ingroup app_common
+ *
+ * @brief Module for encoding and decoding 16-bit PCM samples as 4-bit IMA ADPCM.
+ *
+ * @details Two samples are stored in each byte, the first one in the low nibble. The codec
+ *          state can be stored in a packet header, so that each packet can be decoded on its
+ *          own.
+ */
+
+#define APP_ADPCM_STEP_INDEX_MAX 88 /**< Largest step index. */
+
+/**
+ * @brief Codec state.
+ */
+typedef struct
+{
+    int16_t predictor;  ///< Predicted value of the next sample.
+    uint8_t step_index; ///< Index into the step size table, from 0 to @ref APP_ADPCM_STEP_INDEX_MAX.
+} app_adpcm_state_t;
+
+/**
+ * @brief Function for encoding samples.
+ *
+ * @param[in,out] p_state   Codec state, updated by the function.
+ * @param[in]     p_samples Samples.
+ * @param         count     Number of samples. If it is odd, the high nibble of the last byte is
+ *                          set to zero.
+ * @param[out]    p_out     Encoded data, (count + 1) / 2 bytes.
+ */
+void app_adpcm_encode(app_adpcm_state_t * p_state,
+                      int16_t const *     p_samples,
+                      uint32_t            count,
+                      uint8_t *           p_out);
+
+/**
+ * @brief Function for decoding samples.
+ *
+ * @param[in,out] p_state   Codec state, updated by the function.
+ * @param[in]     p_data    Encoded data, (count + 1) / 2 bytes.
+ * @param         count     Number of samples.
+ * @param[out]    p_samples Decoded samples.
+ */
+void app_adpcm_decode(app_adpcm_state_t * p_state,
+                      uint8_t const *     p_data,
+                      uint32_t            count,
+                      int16_t *           p_samples);
+
+/** @} */
+
+#endif // APP_ADPCM_H__
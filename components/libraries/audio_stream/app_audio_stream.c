@@ -0,0 +1,354 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_audio_stream.h"
+#include <string.h>
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+#define TX_QUEUE_MASK   (APP_AUDIO_STREAM_TX_QUEUE_SIZE - 1)
+#define RX_QUEUE_MASK   (APP_AUDIO_STREAM_RX_QUEUE_SIZE - 1)
+
+// The queues are indexed with free-running 8-bit counters and sequence numbers.
+STATIC_ASSERT((APP_AUDIO_STREAM_TX_QUEUE_SIZE & TX_QUEUE_MASK) == 0);
+STATIC_ASSERT(APP_AUDIO_STREAM_TX_QUEUE_SIZE <= 128);
+STATIC_ASSERT((APP_AUDIO_STREAM_RX_QUEUE_SIZE & RX_QUEUE_MASK) == 0);
+STATIC_ASSERT(APP_AUDIO_STREAM_RX_QUEUE_SIZE <= 32);
+STATIC_ASSERT(APP_AUDIO_STREAM_MAX_FRAME_SIZE > APP_AUDIO_STREAM_HEADER_SIZE);
+
+
+static bool frame_size_valid(uint16_t frame_size)
+{
+    return (frame_size > APP_AUDIO_STREAM_HEADER_SIZE) &&
+           (frame_size <= APP_AUDIO_STREAM_MAX_FRAME_SIZE);
+}
+
+
+static void frame_encode(app_audio_stream_tx_t * p_tx)
+{
+    uint8_t   discarded[APP_AUDIO_STREAM_MAX_FRAME_SIZE];
+    uint8_t   write  = p_tx->queue_write;
+    uint8_t   queued = (uint8_t)(write - p_tx->queue_read);
+    uint8_t * p_frame;
+
+    if (queued == APP_AUDIO_STREAM_TX_QUEUE_SIZE)
+    {
+        // The frame is still encoded to keep the codec state, and its sequence number is used,
+        // so the receiver conceals it.
+        p_frame = discarded;
+        p_tx->stats.frames_dropped++;
+    }
+    else
+    {
+        p_frame = p_tx->queue[write & TX_QUEUE_MASK];
+    }
+
+    p_frame[0] = p_tx->sequence++;
+    p_frame[1] = p_tx->state.step_index;
+    (void)uint16_encode((uint16_t)p_tx->state.predictor, &p_frame[2]);
+
+    app_adpcm_encode(&p_tx->state,
+                     p_tx->pcm,
+                     p_tx->pcm_count,
+                     &p_frame[APP_AUDIO_STREAM_HEADER_SIZE]);
+    p_tx->pcm_count = 0;
+
+    if (p_frame != discarded)
+    {
+        p_tx->queue_write = write + 1;
+        if (queued + 1 > p_tx->stats.max_queued)
+        {
+            p_tx->stats.max_queued = queued + 1;
+        }
+    }
+}
+
+
+ret_code_t app_audio_stream_tx_init(app_audio_stream_tx_t *              p_tx,
+                                    app_audio_stream_tx_config_t const * p_config)
+{
+    VERIFY_PARAM_NOT_NULL(p_tx);
+    VERIFY_PARAM_NOT_NULL(p_config);
+    VERIFY_PARAM_NOT_NULL(p_config->send);
+
+    if (!frame_size_valid(p_config->frame_size))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_tx, 0, sizeof(*p_tx));
+    p_tx->config = *p_config;
+
+    return NRF_SUCCESS;
+}
+
+
+void app_audio_stream_tx_put(app_audio_stream_tx_t * p_tx,
+                             int16_t const *         p_pcm,
+                             uint16_t                length,
+                             uint32_t                sequence)
+{
+    uint16_t const frame_samples = APP_AUDIO_STREAM_FRAME_SAMPLES(p_tx->config.frame_size);
+
+    if (p_tx->input_started && (sequence != p_tx->input_sequence))
+    {
+        p_tx->stats.input_gaps += sequence - p_tx->input_sequence;
+    }
+    p_tx->input_started  = true;
+    p_tx->input_sequence = sequence + 1;
+
+    while (length != 0)
+    {
+        uint16_t const count = MIN(length, frame_samples - p_tx->pcm_count);
+
+        memcpy(&p_tx->pcm[p_tx->pcm_count], p_pcm, count * sizeof(int16_t));
+        p_tx->pcm_count += count;
+        p_pcm           += count;
+        length          -= count;
+
+        if (p_tx->pcm_count == frame_samples)
+        {
+            frame_encode(p_tx);
+        }
+    }
+
+    app_audio_stream_tx_process(p_tx);
+}
+
+
+void app_audio_stream_tx_process(app_audio_stream_tx_t * p_tx)
+{
+    bool owner;
+
+    // If the frames are being sent in another context, that context sends the new ones too.
+    CRITICAL_REGION_ENTER();
+    p_tx->kick = true;
+    owner      = !p_tx->busy;
+    p_tx->busy = true;
+    CRITICAL_REGION_EXIT();
+
+    while (owner)
+    {
+        p_tx->kick = false;
+
+        while (p_tx->queue_read != p_tx->queue_write)
+        {
+            uint8_t const read = p_tx->queue_read;
+
+            if (p_tx->config.send(p_tx->queue[read & TX_QUEUE_MASK],
+                                  p_tx->config.frame_size,
+                                  p_tx->config.p_context) != NRF_SUCCESS)
+            {
+                break;
+            }
+            p_tx->queue_read = read + 1;
+            p_tx->stats.frames_sent++;
+        }
+
+        CRITICAL_REGION_ENTER();
+        if (!p_tx->kick)
+        {
+            p_tx->busy = false;
+            owner      = false;
+        }
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+void app_audio_stream_tx_reset(app_audio_stream_tx_t * p_tx)
+{
+    CRITICAL_REGION_ENTER();
+    p_tx->queue_read = p_tx->queue_write;
+    CRITICAL_REGION_EXIT();
+
+    memset(&p_tx->state, 0, sizeof(p_tx->state));
+    p_tx->pcm_count     = 0;
+    p_tx->input_started = false;
+}
+
+
+void app_audio_stream_tx_stats_get(app_audio_stream_tx_t const * p_tx,
+                                   app_audio_stream_tx_stats_t * p_stats)
+{
+    *p_stats = p_tx->stats;
+}
+
+
+ret_code_t app_audio_stream_rx_init(app_audio_stream_rx_t *              p_rx,
+                                    app_audio_stream_rx_config_t const * p_config)
+{
+    VERIFY_PARAM_NOT_NULL(p_rx);
+    VERIFY_PARAM_NOT_NULL(p_config);
+
+    if (!frame_size_valid(p_config->frame_size) ||
+        (p_config->prefill == 0) ||
+        (p_config->prefill > APP_AUDIO_STREAM_RX_QUEUE_SIZE))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_rx, 0, sizeof(*p_rx));
+    p_rx->config = *p_config;
+
+    return NRF_SUCCESS;
+}
+
+
+void app_audio_stream_rx_put(app_audio_stream_rx_t * p_rx, uint8_t const * p_frame, uint16_t length)
+{
+    uint8_t const sequence = p_frame[0];
+    uint8_t       offset;
+
+    if (length != p_rx->config.frame_size)
+    {
+        p_rx->stats.frames_invalid++;
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    if (!p_rx->started)
+    {
+        p_rx->started       = true;
+        p_rx->play_sequence = sequence;
+    }
+
+    offset = (uint8_t)(sequence - p_rx->play_sequence);
+    if (offset >= 0x80)
+    {
+        // The frame is behind the playout.
+        p_rx->stats.frames_late++;
+    }
+    else
+    {
+        // If the frame is too far ahead, the playout skips the oldest frames to make room.
+        while (offset >= APP_AUDIO_STREAM_RX_QUEUE_SIZE)
+        {
+            uint32_t const mask = 1UL << (p_rx->play_sequence & RX_QUEUE_MASK);
+
+            if (p_rx->valid_mask & mask)
+            {
+                p_rx->valid_mask &= ~mask;
+                p_rx->stats.frames_overflow++;
+            }
+            p_rx->play_sequence++;
+            p_rx->depth = (p_rx->depth != 0) ? (p_rx->depth - 1) : 0;
+            offset--;
+        }
+
+        uint32_t const mask = 1UL << (sequence & RX_QUEUE_MASK);
+
+        if (p_rx->valid_mask & mask)
+        {
+            p_rx->stats.frames_late++;
+        }
+        else
+        {
+            memcpy(p_rx->queue[sequence & RX_QUEUE_MASK], p_frame, length);
+            p_rx->valid_mask |= mask;
+            p_rx->depth       = MAX(p_rx->depth, offset + 1);
+            p_rx->stats.frames_received++;
+        }
+    }
+
+    CRITICAL_REGION_EXIT();
+}
+
+
+ret_code_t app_audio_stream_rx_get(app_audio_stream_rx_t * p_rx, int16_t * p_pcm)
+{
+    uint16_t const    frame_samples = APP_AUDIO_STREAM_FRAME_SAMPLES(p_rx->config.frame_size);
+    uint8_t           frame[APP_AUDIO_STREAM_MAX_FRAME_SIZE];
+    bool              playing;
+    bool              found = false;
+
+    CRITICAL_REGION_ENTER();
+
+    if (!p_rx->playing && (p_rx->depth >= p_rx->config.prefill))
+    {
+        p_rx->playing = true;
+    }
+    else if (p_rx->playing && (p_rx->depth == 0))
+    {
+        p_rx->playing = false;
+        p_rx->stats.underruns++;
+    }
+
+    playing = p_rx->playing;
+    if (playing)
+    {
+        uint8_t const  slot = p_rx->play_sequence & RX_QUEUE_MASK;
+        uint32_t const mask = 1UL << slot;
+
+        if (p_rx->valid_mask & mask)
+        {
+            memcpy(frame, p_rx->queue[slot], p_rx->config.frame_size);
+            p_rx->valid_mask &= ~mask;
+            found = true;
+        }
+        p_rx->play_sequence++;
+        p_rx->depth--;
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    if (!playing)
+    {
+        memset(p_pcm, 0, frame_samples * sizeof(int16_t));
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    if (found)
+    {
+        app_adpcm_state_t state;
+
+        state.step_index = frame[1];
+        state.predictor  = (int16_t)uint16_decode(&frame[2]);
+        state.step_index = MIN(state.step_index, APP_ADPCM_STEP_INDEX_MAX);
+        app_adpcm_decode(&state, &frame[APP_AUDIO_STREAM_HEADER_SIZE], frame_samples, p_pcm);
+        p_rx->last_sample = p_pcm[frame_samples - 1];
+    }
+    else
+    {
+        // Fade out from the last sample instead of jumping to silence.
+        for (uint32_t i = 0; i < frame_samples; i++)
+        {
+            p_pcm[i] = (int16_t)(((int32_t)p_rx->last_sample * (int32_t)(frame_samples - 1 - i)) /
+                                 frame_samples);
+        }
+        p_rx->last_sample = 0;
+        p_rx->stats.frames_concealed++;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void app_audio_stream_rx_reset(app_audio_stream_rx_t * p_rx)
+{
+    CRITICAL_REGION_ENTER();
+    p_rx->valid_mask = 0;
+    p_rx->depth      = 0;
+    p_rx->started    = false;
+    p_rx->playing    = false;
+    CRITICAL_REGION_EXIT();
+
+    p_rx->last_sample = 0;
+}
+
+
+void app_audio_stream_rx_stats_get(app_audio_stream_rx_t const * p_rx,
+                                   app_audio_stream_rx_stats_t * p_stats)
+{
+    *p_stats = p_rx->stats;
+}
@@ -0,0 +1,281 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_AUDIO_STREAM_H__
+#define APP_AUDIO_STREAM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_adpcm.h"
+#include "sdk_errors.h"
+
+/**
+ * @defgroup app_audio_stream Audio streaming
+ * @{
+ * @ingroup app_common
+ *
+ * @brief Module for sending 16-bit mono audio as IMA ADPCM frames, and for playing out
+ *        the received frames.
+ *
+ * @details On the sending side, PCM buffers from @ref app_pdm_stream or from the I2S queue
+ *          mode are split into frames, encoded, and kept in a queue until the transport, for
+ *          example @ref ble_nus_stream_frame_write, accepts them. On the receiving side, the
+ *          frames are kept in a jitter buffer and played out one frame at a time. Missing frames
+ *          are concealed, and the playout waits for a number of frames to be buffered when it
+ *          starts and after it runs out of frames.
+ *
+ *          Frame format:
+ *          - Sequence number (1 byte).
+ *          - Step index of the codec at the start of the frame (1 byte).
+ *          - Predictor of the codec at the start of the frame (2 bytes, little endian).
+ *          - Encoded samples, two in each byte (@ref app_adpcm).
+ *
+ *          Because each frame holds the codec state, a lost frame only affects its own samples.
+ *
+ *          A 16 kHz stream produces 8000 bytes of encoded samples per second. With the default
+ *          frame size of 20 bytes, the length of a notification with the default ATT MTU, a
+ *          frame holds 32 samples (2 ms), which gives 500 notifications per second, or 3.75 in
+ *          each connection event with a 7.5 ms connection interval. The link should use the
+ *          high bandwidth configuration (@ref BLE_CONN_BW_HIGH) for transmission, and the
+ *          default queue of 16 frames absorbs 32 ms of connection events without transmission.
+ */
+
+#ifndef APP_AUDIO_STREAM_MAX_FRAME_SIZE
+#define APP_AUDIO_STREAM_MAX_FRAME_SIZE 20  /**< Maximum frame size in bytes. */
+#endif
+
+#ifndef APP_AUDIO_STREAM_TX_QUEUE_SIZE
+#define APP_AUDIO_STREAM_TX_QUEUE_SIZE  16  /**< Number of frames waiting to be sent. Must be a power of two. */
+#endif
+
+#ifndef APP_AUDIO_STREAM_RX_QUEUE_SIZE
+#define APP_AUDIO_STREAM_RX_QUEUE_SIZE  16  /**< Number of frames in the jitter buffer. Must be a power of two, at most 32. */
+#endif
+
+#define APP_AUDIO_STREAM_HEADER_SIZE    4   /**< Size of the frame header. */
+
+/**@brief Number of samples in a frame of a given size. */
+#define APP_AUDIO_STREAM_FRAME_SAMPLES(frame_size) (2 * ((frame_size) - APP_AUDIO_STREAM_HEADER_SIZE))
+
+#define APP_AUDIO_STREAM_MAX_SAMPLES    APP_AUDIO_STREAM_FRAME_SAMPLES(APP_AUDIO_STREAM_MAX_FRAME_SIZE) /**< Maximum number of samples in a frame. */
+
+/**
+ * @brief Transport prototype.
+ *
+ * @param[in] p_frame   Frame. The buffer is valid until the function returns.
+ * @param     length    Length of the frame.
+ * @param[in] p_context Context from the configuration.
+ *
+ * @retval NRF_SUCCESS If the frame was accepted. Otherwise, the frame is kept in the queue and
+ *                     passed again on the next call to @ref app_audio_stream_tx_process.
+ */
+typedef ret_code_t (* app_audio_stream_send_t)(uint8_t const * p_frame,
+                                               uint16_t        length,
+                                               void *          p_context);
+
+/**
+ * @brief Sending configuration.
+ */
+typedef struct
+{
+    uint16_t                frame_size; ///< Frame size, header included, from APP_AUDIO_STREAM_HEADER_SIZE + 1 to @ref APP_AUDIO_STREAM_MAX_FRAME_SIZE.
+    app_audio_stream_send_t send;       ///< Transport.
+    void *                  p_context;  ///< Context passed to the transport.
+} app_audio_stream_tx_config_t;
+
+/**
+ * @brief Sending statistics.
+ */
+typedef struct
+{
+    uint32_t frames_sent;    ///< Number of frames accepted by the transport.
+    uint32_t frames_dropped; ///< Number of frames dropped because the queue was full.
+    uint32_t input_gaps;     ///< Number of PCM buffers missing from the input sequence.
+    uint8_t  max_queued;     ///< Maximum number of frames in the queue.
+} app_audio_stream_tx_stats_t;
+
+/**
+ * @brief Sending instance. Its content is private to the module.
+ */
+typedef struct
+{
+    app_audio_stream_tx_config_t config;
+    app_adpcm_state_t            state;                                                         ///< Encoder state.
+    int16_t                      pcm[APP_AUDIO_STREAM_MAX_SAMPLES];                             ///< Samples of the frame being filled.
+    uint16_t                     pcm_count;                                                     ///< Number of samples in the frame being filled.
+    uint8_t                      sequence;                                                      ///< Sequence number of the next frame.
+    uint32_t                     input_sequence;                                                ///< Expected sequence number of the next PCM buffer.
+    bool                         input_started;                                                 ///< A PCM buffer has been received.
+    uint8_t                      queue[APP_AUDIO_STREAM_TX_QUEUE_SIZE][APP_AUDIO_STREAM_MAX_FRAME_SIZE]; ///< Frames waiting to be sent.
+    volatile uint8_t             queue_write;                                                   ///< Queue write counter.
+    volatile uint8_t             queue_read;                                                    ///< Queue read counter.
+    volatile bool                busy;                                                          ///< Frames are being sent.
+    volatile bool                kick;                                                          ///< Sending was requested again while it was in progress.
+    app_audio_stream_tx_stats_t  stats;
+} app_audio_stream_tx_t;
+
+/**
+ * @brief Receiving configuration.
+ */
+typedef struct
+{
+    uint16_t frame_size; ///< Frame size, as configured by the sender.
+    uint8_t  prefill;    ///< Number of frames buffered before the playout starts, from 1 to @ref APP_AUDIO_STREAM_RX_QUEUE_SIZE.
+} app_audio_stream_rx_config_t;
+
+/**
+ * @brief Receiving statistics.
+ */
+typedef struct
+{
+    uint32_t frames_received;  ///< Number of frames put in the jitter buffer.
+    uint32_t frames_late;      ///< Number of frames received after their playout time, or twice.
+    uint32_t frames_overflow;  ///< Number of frames dropped because the jitter buffer was full.
+    uint32_t frames_invalid;   ///< Number of frames with a wrong length.
+    uint32_t frames_concealed; ///< Number of missing frames replaced during the playout.
+    uint32_t underruns;        ///< Number of times the playout ran out of frames.
+} app_audio_stream_rx_stats_t;
+
+/**
+ * @brief Receiving instance. Its content is private to the module.
+ */
+typedef struct
+{
+    app_audio_stream_rx_config_t config;
+    uint8_t                      queue[APP_AUDIO_STREAM_RX_QUEUE_SIZE][APP_AUDIO_STREAM_MAX_FRAME_SIZE]; ///< Jitter buffer, indexed by sequence number.
+    uint32_t                     valid_mask;   ///< Slots of the jitter buffer holding a frame.
+    uint8_t                      play_sequence; ///< Sequence number of the next frame to play.
+    uint8_t                      depth;         ///< Number of frames from the next one to play to the newest one.
+    bool                         started;       ///< A frame has been received.
+    bool                         playing;       ///< The prefill is complete.
+    int16_t                      last_sample;   ///< Last sample played, for concealment.
+    app_audio_stream_rx_stats_t  stats;
+} app_audio_stream_rx_t;
+
+/**
+ * @brief Function for initializing a sending instance.
+ *
+ * @param[out] p_tx     Sending instance.
+ * @param[in]  p_config Configuration. It is copied to the instance.
+ *
+ * @retval NRF_SUCCESS             If the instance was initialized.
+ * @retval NRF_ERROR_NULL          If a parameter or the transport is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If the frame size is out of range.
+ */
+ret_code_t app_audio_stream_tx_init(app_audio_stream_tx_t *              p_tx,
+                                    app_audio_stream_tx_config_t const * p_config);
+
+/**
+ * @brief Function for adding a PCM buffer to the stream.
+ *
+ * Full frames are encoded and sent. The remaining samples are kept for the next buffer.
+ * The function matches @ref app_pdm_stream_frame_handler_t apart from the instance, and is
+ * called from the frame handler. With the I2S queue mode and 16-bit mono samples, each word
+ * of a completed buffer holds two samples.
+ *
+ * @param[in] p_tx      Sending instance.
+ * @param[in] p_pcm     Samples.
+ * @param     length    Number of samples.
+ * @param     sequence  Sequence number of the buffer. Gaps are counted in the statistics.
+ */
+void app_audio_stream_tx_put(app_audio_stream_tx_t * p_tx,
+                             int16_t const *         p_pcm,
+                             uint16_t                length,
+                             uint32_t                sequence);
+
+/**
+ * @brief Function for sending the queued frames.
+ *
+ * Call the function when the transport can accept more frames, for example on
+ * @ref BLE_EVT_TX_COMPLETE. It can be called from a context other than the one that adds the
+ * PCM buffers.
+ *
+ * @param[in] p_tx Sending instance.
+ */
+void app_audio_stream_tx_process(app_audio_stream_tx_t * p_tx);
+
+/**
+ * @brief Function for discarding the queued frames and the codec state, for example on
+ *        disconnection.
+ *
+ * The function must not be called while PCM buffers are being added.
+ *
+ * @param[in] p_tx Sending instance.
+ */
+void app_audio_stream_tx_reset(app_audio_stream_tx_t * p_tx);
+
+/**
+ * @brief Function for getting the sending statistics.
+ *
+ * @param[in]  p_tx    Sending instance.
+ * @param[out] p_stats Statistics.
+ */
+void app_audio_stream_tx_stats_get(app_audio_stream_tx_t const * p_tx,
+                                   app_audio_stream_tx_stats_t * p_stats);
+
+/**
+ * @brief Function for initializing a receiving instance.
+ *
+ * @param[out] p_rx     Receiving instance.
+ * @param[in]  p_config Configuration. It is copied to the instance.
+ *
+ * @retval NRF_SUCCESS             If the instance was initialized.
+ * @retval NRF_ERROR_NULL          If a parameter is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If the frame size or the prefill is out of range.
+ */
+ret_code_t app_audio_stream_rx_init(app_audio_stream_rx_t *              p_rx,
+                                    app_audio_stream_rx_config_t const * p_config);
+
+/**
+ * @brief Function for putting a received frame in the jitter buffer.
+ *
+ * If the frame is too far ahead of the playout, the oldest frames are dropped.
+ *
+ * @param[in] p_rx    Receiving instance.
+ * @param[in] p_frame Frame.
+ * @param     length  Length of the frame.
+ */
+void app_audio_stream_rx_put(app_audio_stream_rx_t * p_rx, uint8_t const * p_frame, uint16_t length);
+
+/**
+ * @brief Function for getting the samples of the next frame to play.
+ *
+ * Call the function once for each frame period, for example when an I2S buffer is needed.
+ * It can be called from a context other than the one that puts the frames.
+ *
+ * @param[in]  p_rx  Receiving instance.
+ * @param[out] p_pcm Buffer for @ref APP_AUDIO_STREAM_FRAME_SAMPLES samples.
+ *
+ * @retval NRF_SUCCESS         If the samples were decoded or, for a missing frame, concealed.
+ * @retval NRF_ERROR_NOT_FOUND If the jitter buffer is being filled. The buffer holds silence.
+ */
+ret_code_t app_audio_stream_rx_get(app_audio_stream_rx_t * p_rx, int16_t * p_pcm);
+
+/**
+ * @brief Function for emptying the jitter buffer, for example on disconnection.
+ *
+ * @param[in] p_rx Receiving instance.
+ */
+void app_audio_stream_rx_reset(app_audio_stream_rx_t * p_rx);
+
+/**
+ * @brief Function for getting the receiving statistics.
+ *
+ * @param[in]  p_rx    Receiving instance.
+ * @param[out] p_stats Statistics.
+ */
+void app_audio_stream_rx_stats_get(app_audio_stream_rx_t const * p_rx,
+                                   app_audio_stream_rx_stats_t * p_stats);
+
+/** @} */
+
+#endif // APP_AUDIO_STREAM_H__
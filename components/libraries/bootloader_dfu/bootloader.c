@@ -16,9 +16,11 @@
 #include "bootloader_settings.h"
 #include "dfu.h"
 #include "dfu_transport.h"
+#include <stddef.h>
 #include "nrf.h"
 #include "app_error.h"
 #include "nrf_sdm.h"
+#include "nrf_soc.h"
 #include "nrf_mbr.h"
 #include "nordic_common.h"
 #include "crc16.h"
@@ -30,6 +32,16 @@
 #define IRQ_ENABLED             0x01                    /**< Field identifying if an interrupt is enabled. */
 #define MAX_NUMBER_INTERRUPTS   32                      /**< Maximum number of interrupts available. */
 
+#ifndef BOOTLOADER_CRC_CACHE_ENABLED
+#define BOOTLOADER_CRC_CACHE_ENABLED    0               /**< Check the CRC of bank 0 once after each update instead of on every boot. */
+#endif
+
+#ifndef BOOTLOADER_CRC_SAMPLE_RATE
+#define BOOTLOADER_CRC_SAMPLE_RATE      0               /**< If not 0, the CRC of an image already checked is checked again on one boot in this number, on average. Must be a power of two, up to 256. */
+#endif
+
+#define BANK_0_VALIDATED_KEY    0x5A5A5A5A              /**< Combined with the generation of bank 0 to mark the image as checked. */
+
 /**@brief Enumeration for specifying current bootloader status.
  */
 typedef enum
@@ -43,6 +55,10 @@ typedef enum
 
 static pstorage_handle_t        m_bootsettings_handle;  /**< Pstorage handle to use for registration and identifying the bootloader module on subsequent calls to the pstorage module for load and store of bootloader setting in flash. */
 static bootloader_status_t      m_update_status;        /**< Current update status for the bootloader module to ensure correct behaviour when updating settings and when update completes. */
+static bool                     m_bank_0_checked;       /**< The CRC of bank 0 has been checked since reset, and the settings have not been saved since. */
+#if (BOOTLOADER_CRC_CACHE_ENABLED == 1)
+static uint32_t                 m_bank_0_validated;     /**< Value of the bank_0_validated setting being stored. */
+#endif
 
 /**@brief   Function for handling callbacks from pstorage module.
  *
@@ -96,6 +112,71 @@ static void wait_for_events(void)
 }
 
 
+#if (BOOTLOADER_CRC_CACHE_ENABLED == 1)
+/**@brief Function for checking if the CRC of the image in bank 0 has already been checked.
+ *
+ * @details If @ref BOOTLOADER_CRC_SAMPLE_RATE is not 0 and random values are available from the
+ *          SoftDevice, the CRC is checked again on a random sample of the boots.
+ */
+static bool bank_0_crc_is_cached(bootloader_settings_t const * p_settings)
+{
+    if (p_settings->bank_0_validated != (p_settings->bank_0_generation ^ BANK_0_VALIDATED_KEY))
+    {
+        return false;
+    }
+
+#if (BOOTLOADER_CRC_SAMPLE_RATE > 0)
+    uint8_t sample;
+
+    if ((sd_rand_application_vector_get(&sample, sizeof(sample)) == NRF_SUCCESS) &&
+        ((sample % BOOTLOADER_CRC_SAMPLE_RATE) == 0))
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+
+/**@brief Function for storing the result of a CRC check of the image in bank 0.
+ *
+ * @details Flash bits can only be cleared without erasing the settings page, so the
+ *          bank_0_validated word is written once to mark the image as checked, and once more to
+ *          clear the mark if a sampled check fails. Both writes are blocking.
+ */
+static void bank_0_crc_result_store(bootloader_settings_t const * p_settings, bool crc_valid)
+{
+    uint32_t const mark = p_settings->bank_0_generation ^ BANK_0_VALIDATED_KEY;
+
+    if (crc_valid && (p_settings->bank_0_validated == EMPTY_FLASH_MASK))
+    {
+        m_bank_0_validated = mark;
+    }
+    else if (!crc_valid && (p_settings->bank_0_validated == mark))
+    {
+        m_bank_0_validated = 0;
+    }
+    else
+    {
+        return;
+    }
+
+    m_update_status = BOOTLOADER_SETTINGS_SAVING;
+
+    uint32_t err_code = pstorage_store(&m_bootsettings_handle,
+                                       (uint8_t *)&m_bank_0_validated,
+                                       sizeof(m_bank_0_validated),
+                                       offsetof(bootloader_settings_t, bank_0_validated));
+    APP_ERROR_CHECK(err_code);
+
+    wait_for_events();
+
+    m_update_status = BOOTLOADER_UPDATING;
+}
+#endif // BOOTLOADER_CRC_CACHE_ENABLED == 1
+
+
 bool bootloader_app_is_valid(uint32_t app_addr)
 {
     const bootloader_settings_t * p_bootloader_settings;
@@ -113,17 +194,32 @@ bool bootloader_app_is_valid(uint32_t app_addr)
     // The application in CODE region 1 is flagged as valid during update.
     if (p_bootloader_settings->bank_0 == BANK_VALID_APP)
     {
-        uint16_t image_crc = 0;
+        uint16_t image_crc;
 
         // A stored crc value of 0 indicates that CRC checking is not used.
-        if (p_bootloader_settings->bank_0_crc != 0)
+        // It is not checked again if it already passed since reset.
+        if ((p_bootloader_settings->bank_0_crc == 0) || m_bank_0_checked)
         {
-            image_crc = crc16_compute((uint8_t *)DFU_BANK_0_REGION_START,
-                                      p_bootloader_settings->bank_0_size,
-                                      NULL);
+            return true;
         }
+#if (BOOTLOADER_CRC_CACHE_ENABLED == 1)
+        if (bank_0_crc_is_cached(p_bootloader_settings))
+        {
+            m_bank_0_checked = true;
+            return true;
+        }
+#endif
+
+        image_crc = crc16_compute((uint8_t *)DFU_BANK_0_REGION_START,
+                                  p_bootloader_settings->bank_0_size,
+                                  NULL);
+
+        success          = (image_crc == p_bootloader_settings->bank_0_crc);
+        m_bank_0_checked = success;
 
-        success = (image_crc == p_bootloader_settings->bank_0_crc);
+#if (BOOTLOADER_CRC_CACHE_ENABLED == 1)
+        bank_0_crc_result_store(p_bootloader_settings, success);
+#endif
     }
 
     return success;
@@ -132,17 +228,37 @@ bool bootloader_app_is_valid(uint32_t app_addr)
 
 static void bootloader_settings_save(bootloader_settings_t * p_settings)
 {
+    m_bank_0_checked = false;
+
     uint32_t err_code = pstorage_clear(&m_bootsettings_handle, sizeof(bootloader_settings_t));
     APP_ERROR_CHECK(err_code);
 
+    // The bank_0_validated word is left erased, to be written once the CRC has been checked.
     err_code = pstorage_store(&m_bootsettings_handle,
                               (uint8_t *)p_settings,
-                              sizeof(bootloader_settings_t),
+                              offsetof(bootloader_settings_t, bank_0_validated),
                               0);
     APP_ERROR_CHECK(err_code);
 }
 
 
+/**@brief Function for getting the generation of the next image in bank 0.
+ *
+ * @details The values for which the validation mark would be 0 or erased flash are skipped.
+ */
+static uint32_t bank_0_generation_next(uint32_t generation)
+{
+    generation++;
+
+    if ((generation == BANK_0_VALIDATED_KEY) || (generation == ~BANK_0_VALIDATED_KEY))
+    {
+        generation++;
+    }
+
+    return generation;
+}
+
+
 void bootloader_dfu_update_process(dfu_update_status_t update_status)
 {
     static bootloader_settings_t  settings;
@@ -157,6 +273,8 @@ void bootloader_dfu_update_process(dfu_update_status_t update_status)
         settings.bank_0      = BANK_VALID_APP;
         settings.bank_1      = BANK_INVALID_APP;
 
+        settings.bank_0_generation = bank_0_generation_next(p_bootloader_settings->bank_0_generation);
+
         m_update_status      = BOOTLOADER_SETTINGS_SAVING;
         bootloader_settings_save(&settings);
     }
@@ -173,6 +291,8 @@ void bootloader_dfu_update_process(dfu_update_status_t update_status)
         settings.app_image_size = update_status.app_size;
         settings.sd_image_start = update_status.sd_image_start;
 
+        settings.bank_0_generation = bank_0_generation_next(p_bootloader_settings->bank_0_generation);
+
         m_update_status         = BOOTLOADER_SETTINGS_SAVING;
         bootloader_settings_save(&settings);
     }
@@ -186,6 +306,8 @@ void bootloader_dfu_update_process(dfu_update_status_t update_status)
         settings.bl_image_size  = update_status.bl_size;
         settings.app_image_size = update_status.app_size;
 
+        settings.bank_0_generation = p_bootloader_settings->bank_0_generation;
+
         m_update_status         = BOOTLOADER_SETTINGS_SAVING;
         bootloader_settings_save(&settings);
     }
@@ -196,6 +318,8 @@ void bootloader_dfu_update_process(dfu_update_status_t update_status)
             settings.bank_0_crc     = 0;
             settings.bank_0_size    = 0;
             settings.bank_0         = BANK_INVALID_APP;
+
+            settings.bank_0_generation = bank_0_generation_next(p_bootloader_settings->bank_0_generation);
         }
         // This handles cases where SoftDevice was not updated, hence bank0 keeps its settings.
         else
@@ -203,6 +327,8 @@ void bootloader_dfu_update_process(dfu_update_status_t update_status)
             settings.bank_0         = p_bootloader_settings->bank_0;
             settings.bank_0_crc     = p_bootloader_settings->bank_0_crc;
             settings.bank_0_size    = p_bootloader_settings->bank_0_size;
+
+            settings.bank_0_generation = p_bootloader_settings->bank_0_generation;
         }
 
         settings.bank_1         = BANK_INVALID_APP;
@@ -228,6 +354,8 @@ void bootloader_dfu_update_process(dfu_update_status_t update_status)
         settings.bank_0      = BANK_INVALID_APP;
         settings.bank_1      = p_bootloader_settings->bank_1;
 
+        settings.bank_0_generation = bank_0_generation_next(p_bootloader_settings->bank_0_generation);
+
         bootloader_settings_save(&settings);
     }
     else if (update_status.status_code == DFU_RESET)
@@ -378,5 +506,8 @@ void bootloader_settings_get(bootloader_settings_t * const p_settings)
     p_settings->bl_image_size  = p_bootloader_settings->bl_image_size;
     p_settings->app_image_size = p_bootloader_settings->app_image_size;
     p_settings->sd_image_start = p_bootloader_settings->sd_image_start;
+
+    p_settings->bank_0_generation = p_bootloader_settings->bank_0_generation;
+    p_settings->bank_0_validated  = p_bootloader_settings->bank_0_validated;
 }
 
@@ -52,6 +52,8 @@ typedef struct
     uint32_t               bl_image_size;   /**< Size of Bootloader image in bank0 if bank_0 code is BANK_VALID_SD. */
     uint32_t               app_image_size;  /**< Size of Application image in bank0 if bank_0 code is BANK_VALID_SD. */
     uint32_t               sd_image_start;  /**< Location in flash where SoftDevice image is stored for SoftDevice update. */
+    uint32_t               bank_0_generation; /**< Incremented each time the image in bank 0 is replaced or erased. */
+    uint32_t               bank_0_validated;  /**< Set from bank_0_generation once the CRC of the image in bank 0 has been checked, otherwise erased flash. Written separately from the other fields. */
 } bootloader_settings_t;
 
 #endif // BOOTLOADER_TYPES_H__ 
@@ -29,6 +29,8 @@ static void                    dfu_app_reset_prepare(void);             /**< For
 static dfu_app_reset_prepare_t m_reset_prepare = dfu_app_reset_prepare; /**< Callback function to application to prepare for system reset. Allows application to clean up service and memory before reset. */
 static dfu_ble_peer_data_t     m_peer_data;                             /**< Peer data to be used for data exchange when resetting into DFU mode. */
 static dm_handle_t             m_dm_handle;                             /**< Device Manager handle with instance IDs of current BLE connection. */
+static dfu_ble_gatt_cache_t    m_gatt_cache;                            /**< Handles of the DFU Service to be used by the peer in DFU mode. */
+static uint16_t                m_att_table_id;                          /**< Identifier of the ATT table of the application, or 0 if the peer does not keep its handles in DFU mode. */
 
 
 /**@brief Function for reset_prepare handler if the application has not registered a handler.
@@ -63,6 +65,97 @@ static void interrupts_disable(void)
 }
 
 
+/**@brief Function for computing an identifier of the ATT table of the application.
+ *
+ * @details The identifier is a hash of the handles, UUIDs and UUID types of all attributes. It is
+ *          never 0.
+ */
+static uint16_t att_table_id_get(void)
+{
+    uint32_t   hash   = 5381;
+    uint16_t   handle = 1;
+    ble_uuid_t uuid;
+
+    while (sd_ble_gatts_attr_get(handle, &uuid, NULL) == NRF_SUCCESS)
+    {
+        hash = (hash * 33) ^ handle;
+        hash = (hash * 33) ^ uuid.uuid;
+        hash = (hash * 33) ^ uuid.type;
+        handle++;
+    }
+
+    hash ^= (hash >> 16);
+
+    return ((uint16_t)hash == 0) ? 1 : (uint16_t)hash;
+}
+
+
+/**@brief Function for storing the handles of the DFU Service and the identifier of the ATT table
+ *        before the SoftDevice is disabled.
+ *
+ * @param[in] p_dfu DFU Service structure of the connection requesting DFU mode.
+ */
+static void dfu_app_gatt_cache_fill(ble_dfu_t * p_dfu)
+{
+    uint32_t          err_code;
+    uint16_t          cccd = 0;
+    ble_gatts_value_t gatts_value;
+
+    gatts_value.len     = sizeof(cccd);
+    gatts_value.offset  = 0;
+    gatts_value.p_value = (uint8_t *)&cccd;
+
+    err_code = sd_ble_gatts_value_get(p_dfu->conn_handle,
+                                      p_dfu->dfu_ctrl_pt_handles.cccd_handle,
+                                      &gatts_value);
+    if (err_code != NRF_SUCCESS)
+    {
+        // The notification setting is unknown; the peer must then enable notifications in DFU
+        // mode.
+        cccd = 0;
+    }
+
+    m_gatt_cache.service_handle      = p_dfu->service_handle;
+    m_gatt_cache.end_handle          = p_dfu->dfu_rev_handles.value_handle;
+    m_gatt_cache.pkt_handle          = p_dfu->dfu_pkt_handles.value_handle;
+    m_gatt_cache.ctrl_pt_handle      = p_dfu->dfu_ctrl_pt_handles.value_handle;
+    m_gatt_cache.ctrl_pt_cccd_handle = p_dfu->dfu_ctrl_pt_handles.cccd_handle;
+    m_gatt_cache.ctrl_pt_cccd        = cccd;
+
+    if (p_dfu->service_handle == BOOTLOADER_DFU_SERVICE_HANDLE)
+    {
+        m_att_table_id = att_table_id_get();
+    }
+    else
+    {
+        // The bootloader cannot have its DFU Service at the same handles, so the peer discovers
+        // the services of the bootloader in DFU mode.
+        m_att_table_id = 0;
+    }
+}
+
+
+/**@brief Function for providing the handles of the DFU Service to DFU, so that the peer does not
+ *        have to discover the DFU Service in DFU mode.
+ *
+ * @return Identifier of the ATT table to store in the application-specific context, or 0 if the
+ *         bootloader does not support the GATT cache.
+ */
+static uint16_t dfu_app_gatt_cache_set(void)
+{
+    uint32_t err_code = dfu_ble_svc_gatt_cache_set(&m_gatt_cache);
+
+    if (err_code == NRF_ERROR_SVC_HANDLER_MISSING)
+    {
+        // The bootloader does not support the GATT cache and indicates a service change.
+        return 0;
+    }
+    APP_ERROR_CHECK(err_code);
+
+    return m_att_table_id;
+}
+
+
 /**@brief Function for providing peer information to DFU for re-establishing a bonded connection in
  *        DFU mode.
  *
@@ -94,6 +187,7 @@ static void dfu_app_peer_data_set(uint16_t conn_handle)
             APP_ERROR_CHECK(err_code);
 
             app_context_data   = (DFU_APP_ATT_TABLE_CHANGED << DFU_APP_ATT_TABLE_POS);
+            app_context_data  |= ((uint32_t)dfu_app_gatt_cache_set() << DFU_APP_ATT_TABLE_ID_POS);
             app_context.len    = sizeof(app_context_data);
             app_context.p_data = (uint8_t *)&app_context_data;
             app_context.flags  = 0;
@@ -109,6 +203,8 @@ static void dfu_app_peer_data_set(uint16_t conn_handle)
 
             err_code = dfu_ble_svc_peer_data_set(&m_peer_data);
             APP_ERROR_CHECK(err_code);
+
+            (void)dfu_app_gatt_cache_set();
         }
     }
 /** [DFU bond sharing] */
@@ -117,11 +213,12 @@ static void dfu_app_peer_data_set(uint16_t conn_handle)
 
 /**@brief Function for preparing the reset, disabling SoftDevice, and jumping to the bootloader.
  *
- * @param[in] conn_handle Connection handle for peer requesting to enter DFU mode.
+ * @param[in] p_dfu DFU Service structure of the connection for peer requesting to enter DFU mode.
  */
-static void bootloader_start(uint16_t conn_handle)
+static void bootloader_start(ble_dfu_t * p_dfu)
 {
     uint32_t err_code;
+    uint16_t conn_handle       = p_dfu->conn_handle;
     uint16_t sys_serv_attr_len = sizeof(m_peer_data.sys_serv_attr);
 
     err_code = sd_ble_gatts_sys_attr_get(conn_handle,
@@ -135,6 +232,8 @@ static void bootloader_start(uint16_t conn_handle)
         // is still possible to establish.
     }
 
+    dfu_app_gatt_cache_fill(p_dfu);
+
     m_reset_prepare();
 
     err_code = sd_power_gpregret_set(BOOTLOADER_DFU_START);
@@ -160,7 +259,7 @@ void dfu_app_on_dfu_evt(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
     {
         case BLE_DFU_START:
             // Starting the bootloader - will cause reset.
-            bootloader_start(p_dfu->conn_handle);
+            bootloader_start(p_dfu);
             break;
 
         default:
@@ -177,6 +276,20 @@ void dfu_app_on_dfu_evt(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
 }
 
 
+bool dfu_app_att_table_changed(uint32_t app_context_data)
+{
+    uint16_t att_table_id = (uint16_t)(app_context_data >> DFU_APP_ATT_TABLE_ID_POS);
+
+    if ((app_context_data & (DFU_APP_ATT_TABLE_CHANGED << DFU_APP_ATT_TABLE_POS)) == 0)
+    {
+        return false;
+    }
+
+    // An identifier of 0 means that the peer discovered the services of the bootloader.
+    return (att_table_id == 0) || (att_table_id != att_table_id_get());
+}
+
+
 void dfu_app_reset_prepare_set(dfu_app_reset_prepare_t reset_prepare_func)
 {
     m_reset_prepare = reset_prepare_func;
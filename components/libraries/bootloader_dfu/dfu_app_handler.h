@@ -34,6 +34,7 @@
 #ifndef DFU_APP_HANDLER_H__
 #define DFU_APP_HANDLER_H__
 
+#include <stdbool.h>
 #include "ble_dfu.h"
 #include "nrf_svc.h"
 #include "bootloader_types.h"
@@ -41,6 +42,7 @@
 
 #define DFU_APP_ATT_TABLE_POS     0                     /**< Position for the ATT table changed setting. */
 #define DFU_APP_ATT_TABLE_CHANGED 1                     /**< Value indicating that the ATT table might have changed. This value will be set in the application-specific context in Device Manager when entering DFU mode. */
+#define DFU_APP_ATT_TABLE_ID_POS  16                    /**< Position for the identifier of the ATT table of the application that entered DFU mode. 0 if the peer discovered the services of the bootloader. See @ref dfu_app_att_table_changed. */
 
 /**@brief DFU application reset_prepare function. This function is a callback that allows the 
  *        application to prepare for an upcoming application reset. 
@@ -81,6 +83,23 @@ void dfu_app_reset_prepare_set(dfu_app_reset_prepare_t reset_prepare_func);
  */
 void dfu_app_dm_appl_instance_set(dm_application_instance_t app_instance);
 
+/**@brief Function for checking if the ATT table changed in an update.
+ *
+ * @details Call this function with the application-specific context from Device Manager when a
+ *          bonded peer connects, instead of checking only @ref DFU_APP_ATT_TABLE_CHANGED. If the
+ *          peer kept the handles of the application in DFU mode, and the new application has the
+ *          same attributes as the application that entered DFU mode, the peer can use the handles
+ *          it discovered before the update, and no Service Changed Indication is needed.
+ *
+ * @note The peer keeps its handles in DFU mode if the DFU Service is the first service of the
+ *       application and the bootloader supports @ref dfu_ble_svc_gatt_cache_set.
+ *
+ * @param[in] app_context_data Application-specific context data set when entering DFU mode.
+ *
+ * @return True if a Service Changed Indication must be sent to the peer, false otherwise.
+ */
+bool dfu_app_att_table_changed(uint32_t app_context_data);
+
 #endif // DFU_APP_HANDLER_H__
 
 /** @} */
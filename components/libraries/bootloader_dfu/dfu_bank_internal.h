@@ -27,6 +27,10 @@
 
 #include <dfu_types.h>
 
+#ifndef DFU_IMAGE_READ_BACK_VALIDATE
+#define DFU_IMAGE_READ_BACK_VALIDATE 0                                              /**< Set to 1 to also validate the whole image read back from flash after the transfer, in addition to the digest computed during reception. */
+#endif
+
 /**@brief States of the DFU state machine. */
 typedef enum
 {
@@ -46,11 +50,18 @@ typedef enum
 #define IS_UPDATING_SD(START_PKT)   ((START_PKT).dfu_update_mode & DFU_UPDATE_SD)   /**< Macro for determining if a SoftDevice update is ongoing. */
 #define IS_UPDATING_BL(START_PKT)   ((START_PKT).dfu_update_mode & DFU_UPDATE_BL)   /**< Macro for determining if a Bootloader update is ongoing. */
 #define IS_UPDATING_APP(START_PKT)  ((START_PKT).dfu_update_mode & DFU_UPDATE_APP)  /**< Macro for determining if a Application update is ongoing. */
+#define IS_UPDATING_APP_PATCH(START_PKT) \
+        ((START_PKT).dfu_update_mode & DFU_UPDATE_APP_PATCH)                        /**< Macro for determining if the Application is being updated with a patch. */
+#define IS_UPDATING_APP_COMPRESSED(START_PKT) \
+        ((START_PKT).dfu_update_mode & DFU_UPDATE_APP_COMPRESSED)                   /**< Macro for determining if the Application is being updated with a compressed image. */
+#define IS_RECEIVING_STREAM(START_PKT) \
+        ((START_PKT).dfu_update_mode & (DFU_UPDATE_APP_PATCH | DFU_UPDATE_APP_COMPRESSED)) /**< Macro for determining if the image is produced from the received data, rather than being the received data. */
 #define IMAGE_WRITE_IN_PROGRESS()   (m_data_received > 0)                           /**< Macro for determining if an image write is in progress. */
 #define IS_WORD_SIZED(SIZE)         ((SIZE & (sizeof(uint32_t) - 1)) == 0)          /**< Macro for checking that the provided is word sized. */
 
 /**@cond NO_DOXYGEN */
 static uint32_t                     m_data_received;                                /**< Amount of received data. */
+static uint32_t                     m_data_digested;                                /**< Amount of data written to flash and added to the image digest, see \ref dfu_init_digest_update. */
 /**@endcond */
 
 /**@brief     Type definition of function used for preparing of the bank before receiving of a
@@ -42,11 +42,13 @@
 
 #define BOOTLOADER_SVC_BASE     0x0     /**< The number of the lowest SVC number reserved for the bootloader. */
 #define SYSTEM_SERVICE_ATT_SIZE 8       /**< Size of the system service attribute length including CRC-16 at the end. */  
+#define BOOTLOADER_DFU_SERVICE_HANDLE 0x000C    /**< Handle of the DFU Service in the bootloader, where it is the first service. */
 
 /**@brief The SVC numbers used by the SVC functions in the SoC library. */
 enum BOOTLOADER_SVCS
 {
     DFU_BLE_SVC_PEER_DATA_SET = BOOTLOADER_SVC_BASE,    /**< SVC number for the setting of peer data call. */
+    DFU_BLE_SVC_GATT_CACHE_SET,                         /**< SVC number for the setting of GATT cache call. */
     BOOTLOADER_SVC_LAST
 };
 
@@ -65,6 +67,26 @@ typedef struct
     uint8_t             sys_serv_attr[SYSTEM_SERVICE_ATT_SIZE]; /**< System service attributes for restoring of Service Changed Indication setting in DFU mode. */
 } dfu_ble_peer_data_t;
 
+/**@brief   DFU GATT cache structure.
+ *
+ * @details This structure contains the handles of the DFU Service in the application, which the
+ *          DFU peer has discovered, and the notification setting of its Control Point. If the
+ *          bootloader has its DFU Service at the same handles, the peer can use the handles it
+ *          knows: the bootloader then restores the notification setting, and does not indicate
+ *          a Service Changed. This is the case when the DFU Service is the first service of the
+ *          application, see @ref BOOTLOADER_DFU_SERVICE_HANDLE, and the bootloader uses the same
+ *          DFU Service module. See @ref dfu_ble_svc_gatt_cache_set.
+ */
+typedef struct
+{
+    uint16_t            service_handle;                         /**< Handle of the DFU Service. */
+    uint16_t            end_handle;                             /**< Last handle of the DFU Service. */
+    uint16_t            pkt_handle;                             /**< Value handle of the DFU Packet characteristic. */
+    uint16_t            ctrl_pt_handle;                         /**< Value handle of the DFU Control Point characteristic. */
+    uint16_t            ctrl_pt_cccd_handle;                    /**< Handle of the CCCD of the DFU Control Point characteristic. */
+    uint16_t            ctrl_pt_cccd;                           /**< Value of the CCCD of the DFU Control Point characteristic. */
+} dfu_ble_gatt_cache_t;
+
 /**@brief   SVC Function for setting peer data containing address, IRK, and LTK to establish bonded
  *          connection in DFU mode.
  *
@@ -75,6 +97,18 @@ typedef struct
  */
 SVCALL(DFU_BLE_SVC_PEER_DATA_SET, uint32_t, dfu_ble_svc_peer_data_set(dfu_ble_peer_data_t * p_peer_data));
 
+/**@brief   SVC Function for setting the handles of the DFU Service in the application, so that the
+ *          DFU peer does not have to discover the DFU Service in DFU mode.
+ *
+ * @param[in] p_gatt_cache  Pointer to the handles and the Control Point notification setting.
+ *
+ * @retval NRF_ERROR_NULL                If a NULL pointer was provided as argument.
+ * @retval NRF_ERROR_SVC_HANDLER_MISSING If the bootloader does not support the call. The peer then
+ *                                       discovers the DFU Service in DFU mode.
+ * @retval NRF_SUCCESS                   If the function completed successfully.
+ */
+SVCALL(DFU_BLE_SVC_GATT_CACHE_SET, uint32_t, dfu_ble_svc_gatt_cache_set(dfu_ble_gatt_cache_t * p_gatt_cache));
+
 #endif // DFU_BLE_SVC_H__
 
 /** @} */
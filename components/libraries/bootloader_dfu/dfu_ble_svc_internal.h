@@ -38,6 +38,16 @@
  */
 uint32_t dfu_ble_peer_data_get(dfu_ble_peer_data_t * p_peer_data);
 
+/**@brief Internal bootloader/DFU function for retrieving the GATT cache provided from application.
+ *
+ * @param[out] p_gatt_cache GATT cache set by application to be used for DFU connection.
+ *
+ * @retval NRF_SUCCESS            If the GATT cache is valid.
+ * @retval NRF_ERROR_NULL         If p_gatt_cache is a NULL pointer.
+ * @retval NRF_ERROR_INVALID_DATA If the GATT cache is not available or invalid.
+ */
+uint32_t dfu_ble_gatt_cache_get(dfu_ble_gatt_cache_t * p_gatt_cache);
+
 #endif // DFU_BLE_SVC_INTERNAL_H__
 
 /** @} */
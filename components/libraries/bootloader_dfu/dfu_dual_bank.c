@@ -25,6 +25,27 @@
 #include "dfu_init.h"
 #include "sdk_common.h"
 
+#ifndef DFU_STREAM_PKT_QUEUE_SIZE
+#define DFU_STREAM_PKT_QUEUE_SIZE           8                           /**< Maximum number of received patch or compressed image data packets waiting to be applied. Must be at least the number of data packets the transport can have in flight. */
+#endif
+
+/**@brief States of the decoder of a patch or compressed image stream. */
+typedef enum
+{
+    STREAM_STATE_HEADER,                                                /**< State for: receiving the header. */
+    STREAM_STATE_PATCH_CMD,                                             /**< State for: receiving a patch command word. */
+    STREAM_STATE_PATCH_COPY_OFFSET,                                     /**< State for: receiving the source offset of a patch copy command. */
+    STREAM_STATE_PATCH_COPY,                                            /**< State for: copying data from bank 0. */
+    STREAM_STATE_PATCH_DATA,                                            /**< State for: receiving the data of a patch insert command. */
+    STREAM_STATE_LZ_TAG,                                                /**< State for: receiving the tag bit of the next compressed element. */
+    STREAM_STATE_LZ_LITERAL,                                            /**< State for: receiving a literal byte. */
+    STREAM_STATE_LZ_INDEX,                                              /**< State for: receiving the index of a back reference. */
+    STREAM_STATE_LZ_COUNT,                                              /**< State for: receiving the count of a back reference. */
+    STREAM_STATE_LZ_COPY,                                               /**< State for: copying the data of a back reference. */
+    STREAM_STATE_DONE,                                                  /**< State for: the whole image has been produced. */
+    STREAM_STATE_ERROR                                                  /**< State for: invalid stream or flash error, the stream is not applied any further. */
+} stream_state_t;
+
 static dfu_state_t                  m_dfu_state;                /**< Current DFU state. */
 static uint32_t                     m_image_size;               /**< Size of the image that will be transmitted. */
 
@@ -39,10 +60,41 @@ static bool                         m_dfu_timed_out = false;    /**< Boolean fla
 static pstorage_handle_t            m_storage_handle_swap;      /**< Pstorage handle for the swap area (bank 1). Bank used when updating an application or bootloader without SoftDevice. */
 static pstorage_handle_t            m_storage_handle_app;       /**< Pstorage handle for the application area (bank 0). Bank used when updating a SoftDevice w/wo bootloader. Handle also used when swapping received application from bank 1 to bank 0. */
 static pstorage_handle_t          * mp_storage_handle_active;   /**< Pointer to the pstorage handle for the active bank for receiving of data packets. */
+static uint32_t                     m_erased_size;              /**< Size of the area, from the start of the active bank, which has been erased for the image being received. */
+static uint32_t                     m_erase_limit;              /**< Size of the area of the active bank to be erased for the image being received, a multiple of the flash page size. */
 
 static dfu_callback_t               m_data_pkt_cb;              /**< Callback from DFU Bank module for notification of asynchronous operation such as flash prepare. */
 static dfu_bank_func_t              m_functions;                /**< Structure holding operations for the selected update process. */
 
+static stream_state_t               m_stream_state;             /**< State of the patch or compressed image decoder. */
+static union
+{
+    dfu_patch_header_t              patch;                      /**< Header of a patch. */
+    dfu_compressed_header_t         compressed;                 /**< Header of a compressed image. */
+    uint32_t                        words[sizeof(dfu_patch_header_t) / sizeof(uint32_t)];
+}                                   m_stream_header;            /**< Header of the patch or compressed image being received. */
+static uint32_t                     m_stream_header_len;        /**< Number of words of the header received. */
+static uint32_t                     m_stream_target_size;       /**< Size of the image produced, in bytes, as given by the header. */
+static uint32_t                     m_stream_target_len;        /**< Number of bytes of the image produced, including the bytes in the output buffer. */
+static uint32_t                     m_stream_written;           /**< Number of bytes of the image written to flash. */
+static uint32_t                     m_stream_page[CODE_PAGE_SIZE / sizeof(uint32_t)]; /**< Output buffer, holding the next page of the image to be written to flash. */
+static uint32_t                     m_stream_page_len;          /**< Number of bytes in the output buffer. */
+static bool                         m_stream_page_pending;      /**< True while the output buffer is being written to flash. */
+static uint32_t                   * mp_stream_pkt[DFU_STREAM_PKT_QUEUE_SIZE];   /**< Received data packets waiting to be applied, oldest at m_stream_pkt_first. */
+static uint32_t                     m_stream_pkt_len[DFU_STREAM_PKT_QUEUE_SIZE];/**< Lengths in bytes of the queued data packets. */
+static uint32_t                     m_stream_pkt_first;         /**< Index of the oldest queued data packet. */
+static uint32_t                     m_stream_pkt_count;         /**< Number of queued data packets. */
+static uint32_t                     m_stream_pkt_offset;        /**< Number of bytes of the oldest queued data packet which have been applied. */
+static uint32_t                     m_patch_cmd_len;            /**< Number of bytes still to be produced by the current patch command. */
+static uint32_t                     m_patch_copy_offset;        /**< Offset in bank 0 of the next byte to be copied by the current patch copy command. */
+static uint32_t                     m_lz_bits;                  /**< Bits of the compressed data received and not decoded yet. */
+static uint32_t                     m_lz_bit_count;             /**< Number of bits in m_lz_bits. */
+static uint32_t                     m_lz_distance;              /**< Distance back in the image of the data of the current back reference. */
+static uint32_t                     m_lz_count;                 /**< Number of bytes still to be copied by the current back reference. */
+
+
+static void stream_page_stored(uint32_t result, uint32_t length);
+
 
 /**@brief Function for handling callbacks from pstorage module.
  *
@@ -58,21 +110,22 @@ static void pstorage_callback_handler(pstorage_handle_t * p_handle,
     switch (op_code)
     {
         case PSTORAGE_STORE_OP_CODE:
-            if ((m_dfu_state == DFU_STATE_RX_DATA_PKT) && (m_data_pkt_cb != NULL))
+            if ((m_dfu_state == DFU_STATE_RX_DATA_PKT) && (result == NRF_SUCCESS))
             {
-                m_data_pkt_cb(DATA_PACKET, result, p_data);
+                // The data is added to the image digest as read back from flash, while the
+                // following data is being received.
+                dfu_init_digest_update((uint8_t *)mp_storage_handle_active->block_id + m_data_digested,
+                                       data_len);
+                m_data_digested += data_len;
             }
-            break;
 
-        case PSTORAGE_CLEAR_OP_CODE:
-            if (m_dfu_state == DFU_STATE_PREPARING)
+            if ((m_dfu_state == DFU_STATE_RX_DATA_PKT) && (p_data == (uint8_t *)m_stream_page))
             {
-                m_functions.cleared();
-                m_dfu_state = DFU_STATE_RDY;
-                if (m_data_pkt_cb != NULL)
-                {
-                    m_data_pkt_cb(START_PACKET, result, p_data);
-                }
+                stream_page_stored(result, data_len);
+            }
+            else if ((m_dfu_state == DFU_STATE_RX_DATA_PKT) && (m_data_pkt_cb != NULL))
+            {
+                m_data_pkt_cb(DATA_PACKET, result, p_data);
             }
             break;
 
@@ -125,43 +178,35 @@ static uint32_t dfu_timer_restart(void)
 
 /**@brief   Function for preparing of flash before receiving SoftDevice image.
  *
- * @details This function will erase current application area to ensure sufficient amount of
- *          storage for the SoftDevice image. Upon erase complete a callback will be done.
+ * @details This function will select current application area for storage of the SoftDevice
+ *          image. The area is erased while the image is received, see \ref dfu_bank_erase_ahead.
  *          See \ref dfu_bank_prepare_t for further details.
  */
 static void dfu_prepare_func_app_erase(uint32_t image_size)
 {
-    uint32_t err_code;
-
-    mp_storage_handle_active = &m_storage_handle_app;
-
     // Doing a SoftDevice update thus current application must be cleared to ensure enough space
     // for new SoftDevice.
-    m_dfu_state = DFU_STATE_PREPARING;
-    err_code    = pstorage_clear(&m_storage_handle_app, m_image_size);
-    APP_ERROR_CHECK(err_code);
+    mp_storage_handle_active = &m_storage_handle_app;
+    m_erased_size            = 0;
+    m_erase_limit            = (image_size + (CODE_PAGE_SIZE - 1)) & ~(CODE_PAGE_SIZE - 1);
 }
 
 
 /**@brief   Function for preparing swap before receiving application or bootloader image.
  *
- * @details This function will erase current swap area to ensure flash is ready for storage of the
- *          Application or Bootloader image. Upon erase complete a callback will be done.
- *          See \ref dfu_bank_prepare_t for further details.
+ * @details This function will select current swap area for storage of the Application or
+ *          Bootloader image. The area is erased while the image is received, see
+ *          \ref dfu_bank_erase_ahead. See \ref dfu_bank_prepare_t for further details.
  */
 static void dfu_prepare_func_swap_erase(uint32_t image_size)
 {
-    uint32_t err_code;
-
     mp_storage_handle_active = &m_storage_handle_swap;
-
-    m_dfu_state = DFU_STATE_PREPARING;
-    err_code    = pstorage_clear(&m_storage_handle_swap, DFU_IMAGE_MAX_SIZE_BANKED);
-    APP_ERROR_CHECK(err_code);
+    m_erased_size            = 0;
+    m_erase_limit            = (image_size + (CODE_PAGE_SIZE - 1)) & ~(CODE_PAGE_SIZE - 1);
 }
 
 
-/**@brief   Function for handling behaviour when clear operation has completed.
+/**@brief   Function for handling behaviour when the bank has been prepared.
  */
 static void dfu_cleared_func_swap(void)
 {
@@ -169,7 +214,10 @@ static void dfu_cleared_func_swap(void)
 }
 
 
-/**@brief   Function for handling behaviour when clear operation has completed.
+/**@brief   Function for handling behaviour when the bank has been prepared.
+ *
+ * @details The application is invalidated before the first page of it is erased, as the erase
+ *          operations are queued after the bootloader settings update.
  */
 static void dfu_cleared_func_app(void)
 {
@@ -178,6 +226,571 @@ static void dfu_cleared_func_app(void)
 }
 
 
+/**@brief   Function for erasing the active bank ahead of the data to be written.
+ *
+ * @details Flash is erased one page at a time while the image is received, instead of erasing the
+ *          whole bank before the first data packet can be accepted. The page following the data is
+ *          erased too, so erasing is overlapped with the reception of the next data packets. Erase
+ *          operations are queued in pstorage before the store of the data and are executed in
+ *          order.
+ *
+ * @param[in] data_end  Offset in the active bank of the end of the data to be written.
+ *
+ * @return NRF_SUCCESS on success. Error code returned by pstorage otherwise.
+ */
+static uint32_t dfu_bank_erase_ahead(uint32_t data_end)
+{
+    uint32_t          err_code;
+    pstorage_handle_t page_handle = *mp_storage_handle_active;
+    const uint32_t    erase_end   = MIN(data_end + CODE_PAGE_SIZE, m_erase_limit);
+
+    while (m_erased_size < erase_end)
+    {
+        page_handle.block_id = mp_storage_handle_active->block_id + m_erased_size;
+
+        err_code = pstorage_clear(&page_handle, CODE_PAGE_SIZE);
+        VERIFY_SUCCESS(err_code);
+
+        m_erased_size += CODE_PAGE_SIZE;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for aborting the image stream being applied.
+ *
+ * @details The error is reported for the oldest queued data packet, and no further data packets
+ *          are accepted.
+ *
+ * @param[in] err_code  Error to report.
+ */
+static void stream_error(uint32_t err_code)
+{
+    m_stream_state  = STREAM_STATE_ERROR;
+    m_data_received = 0xFFFFFFFF;
+
+    if ((m_stream_pkt_count != 0) && (m_data_pkt_cb != NULL))
+    {
+        m_data_pkt_cb(DATA_PACKET, err_code, (uint8_t *)mp_stream_pkt[m_stream_pkt_first]);
+    }
+    m_stream_pkt_count = 0;
+}
+
+
+/**@brief   Function for writing the output buffer of the image stream to flash.
+ */
+static void stream_page_flush(void)
+{
+    uint32_t err_code;
+
+    err_code = dfu_bank_erase_ahead(m_stream_written + m_stream_page_len);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = pstorage_store(mp_storage_handle_active,
+                                  (uint8_t *)m_stream_page,
+                                  m_stream_page_len,
+                                  m_stream_written);
+    }
+
+    if (err_code == NRF_SUCCESS)
+    {
+        m_stream_page_pending = true;
+    }
+    else
+    {
+        stream_error(err_code);
+    }
+}
+
+
+/**@brief   Function for adding a byte of the image to the output buffer.
+ */
+static __INLINE void stream_byte_put(uint8_t byte)
+{
+    ((uint8_t *)m_stream_page)[m_stream_page_len++] = byte;
+    m_stream_target_len++;
+}
+
+
+/**@brief   Function for preparing the bank for the image produced by the stream.
+ *
+ * @param[in] image_size  Size of the image given by the stream header.
+ *
+ * @return  NRF_SUCCESS if the image fits in the bank.
+ */
+static uint32_t stream_image_size_set(uint32_t image_size)
+{
+    if ((image_size == 0) || !IS_WORD_SIZED(image_size) || (image_size > DFU_IMAGE_MAX_SIZE_BANKED))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    // From now on the application image is the image produced: it is the one validated and
+    // activated.
+    m_stream_target_size          = image_size;
+    m_start_packet.app_image_size = image_size;
+    m_erase_limit                 = (image_size + (CODE_PAGE_SIZE - 1)) & ~(CODE_PAGE_SIZE - 1);
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for validating the patch header.
+ *
+ * @return  NRF_SUCCESS if the patch can be applied to the application in bank 0.
+ */
+static uint32_t patch_header_handle(void)
+{
+    const dfu_patch_header_t * p_header = &m_stream_header.patch;
+
+    if ((p_header->magic != DFU_PATCH_MAGIC)                ||
+        !IS_WORD_SIZED(p_header->source_size)               ||
+        (p_header->source_size > DFU_IMAGE_MAX_SIZE_BANKED))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    // The patch is only applied to the application it has been made against.
+    uint32_t err_code = dfu_init_patch_source_validate((uint8_t *)DFU_BANK_0_REGION_START,
+                                                       p_header->source_size);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = stream_image_size_set(p_header->target_size);
+    VERIFY_SUCCESS(err_code);
+
+    m_stream_state = STREAM_STATE_PATCH_CMD;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for validating the compressed image header.
+ *
+ * @return  NRF_SUCCESS if the compressed image can be decompressed.
+ */
+static uint32_t compressed_header_handle(void)
+{
+    const dfu_compressed_header_t * p_header = &m_stream_header.compressed;
+
+    if ((p_header->magic != DFU_COMPRESSED_MAGIC)                    ||
+        (p_header->window_sz2 < DFU_COMPRESSED_WINDOW_SZ2_MIN)       ||
+        (p_header->window_sz2 > DFU_COMPRESSED_WINDOW_SZ2_MAX)       ||
+        (p_header->lookahead_sz2 < DFU_COMPRESSED_LOOKAHEAD_SZ2_MIN) ||
+        (p_header->lookahead_sz2 >= p_header->window_sz2))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    uint32_t err_code = stream_image_size_set(p_header->image_size);
+    VERIFY_SUCCESS(err_code);
+
+    m_lz_bits      = 0;
+    m_lz_bit_count = 0;
+    m_stream_state = STREAM_STATE_LZ_TAG;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for setting the state following a command producing data of the image.
+ */
+static void stream_cmd_end(stream_state_t next_state)
+{
+    m_stream_state = (m_stream_target_len == m_stream_target_size) ? STREAM_STATE_DONE : next_state;
+}
+
+
+/**@brief   Function for handling a word of the stream header or of the patch.
+ *
+ * @param[in] word  Word of the stream.
+ *
+ * @return  NRF_SUCCESS on success, NRF_ERROR_INVALID_DATA if the stream is not valid.
+ */
+static uint32_t stream_word_handle(uint32_t word)
+{
+    uint32_t length;
+
+    switch (m_stream_state)
+    {
+        case STREAM_STATE_HEADER:
+            m_stream_header.words[m_stream_header_len++] = word;
+            if (m_stream_header_len == (sizeof(m_stream_header.words) / sizeof(uint32_t)))
+            {
+                return IS_UPDATING_APP_PATCH(m_start_packet) ? patch_header_handle() :
+                                                               compressed_header_handle();
+            }
+            break;
+
+        case STREAM_STATE_PATCH_CMD:
+            length = word & DFU_PATCH_CMD_LENGTH_MASK;
+            if ((length == 0) || !IS_WORD_SIZED(length) ||
+                (length > (m_stream_target_size - m_stream_target_len)))
+            {
+                return NRF_ERROR_INVALID_DATA;
+            }
+            m_patch_cmd_len = length;
+
+            switch (word & DFU_PATCH_CMD_TYPE_MASK)
+            {
+                case DFU_PATCH_CMD_COPY:
+                    m_stream_state = STREAM_STATE_PATCH_COPY_OFFSET;
+                    break;
+
+                case DFU_PATCH_CMD_DATA:
+                    m_stream_state = STREAM_STATE_PATCH_DATA;
+                    break;
+
+                default:
+                    return NRF_ERROR_INVALID_DATA;
+            }
+            break;
+
+        case STREAM_STATE_PATCH_COPY_OFFSET:
+            if (!IS_WORD_SIZED(word) || (word > m_stream_header.patch.source_size) ||
+                (m_patch_cmd_len > (m_stream_header.patch.source_size - word)))
+            {
+                return NRF_ERROR_INVALID_DATA;
+            }
+            m_patch_copy_offset = word;
+            m_stream_state      = STREAM_STATE_PATCH_COPY;
+            break;
+
+        case STREAM_STATE_PATCH_DATA:
+            m_stream_page[m_stream_page_len / sizeof(uint32_t)] = word;
+            m_stream_page_len   += sizeof(uint32_t);
+            m_stream_target_len += sizeof(uint32_t);
+            m_patch_cmd_len     -= sizeof(uint32_t);
+            if (m_patch_cmd_len == 0)
+            {
+                stream_cmd_end(STREAM_STATE_PATCH_CMD);
+            }
+            break;
+
+        default:
+            // Data following the end of the patch.
+            return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for copying data of the application in bank 0 to the output buffer.
+ */
+static void patch_copy(void)
+{
+    const uint32_t length = MIN(m_patch_cmd_len, CODE_PAGE_SIZE - m_stream_page_len);
+
+    memcpy(&((uint8_t *)m_stream_page)[m_stream_page_len],
+           (uint8_t *)(DFU_BANK_0_REGION_START + m_patch_copy_offset),
+           length);
+
+    m_patch_copy_offset += length;
+    m_stream_page_len   += length;
+    m_stream_target_len += length;
+    m_patch_cmd_len     -= length;
+    if (m_patch_cmd_len == 0)
+    {
+        stream_cmd_end(STREAM_STATE_PATCH_CMD);
+    }
+}
+
+
+/**@brief   Function for taking bits of the compressed data, most significant bit first.
+ *
+ * @param[in]  count    Number of bits to take, at most 15.
+ * @param[out] p_value  Value of the bits taken.
+ *
+ * @return  true if the bits were available.
+ */
+static bool lz_bits_get(uint32_t count, uint32_t * p_value)
+{
+    if (m_lz_bit_count < count)
+    {
+        return false;
+    }
+
+    m_lz_bit_count -= count;
+    *p_value        = (m_lz_bits >> m_lz_bit_count) & ((1u << count) - 1);
+    m_lz_bits      &= (1u << m_lz_bit_count) - 1;
+
+    return true;
+}
+
+
+/**@brief   Function for decoding the next element of the compressed data.
+ *
+ * @details The compressed data is a heatshrink bit stream: a tag bit 1 followed by a literal
+ *          byte, or a tag bit 0 followed by the back reference index (window_sz2 bits, distance
+ *          minus one) and count (lookahead_sz2 bits, length minus one). The output already produced
+ *          is the window: back references are read from the output buffer and from the flash
+ *          written before, so no window buffer is needed.
+ *
+ * @retval  NRF_SUCCESS             An element has been decoded.
+ * @retval  NRF_ERROR_BUSY          More compressed data is needed.
+ * @retval  NRF_ERROR_INVALID_DATA  The compressed data is not valid.
+ */
+static uint32_t lz_decode(void)
+{
+    uint32_t value;
+
+    switch (m_stream_state)
+    {
+        case STREAM_STATE_LZ_TAG:
+            if (!lz_bits_get(1, &value))
+            {
+                return NRF_ERROR_BUSY;
+            }
+            m_stream_state = (value != 0) ? STREAM_STATE_LZ_LITERAL : STREAM_STATE_LZ_INDEX;
+            break;
+
+        case STREAM_STATE_LZ_LITERAL:
+            if (!lz_bits_get(8, &value))
+            {
+                return NRF_ERROR_BUSY;
+            }
+            stream_byte_put((uint8_t)value);
+            stream_cmd_end(STREAM_STATE_LZ_TAG);
+            break;
+
+        case STREAM_STATE_LZ_INDEX:
+            if (!lz_bits_get(m_stream_header.compressed.window_sz2, &value))
+            {
+                return NRF_ERROR_BUSY;
+            }
+            if (value >= m_stream_target_len)
+            {
+                // Reference to data before the start of the image.
+                return NRF_ERROR_INVALID_DATA;
+            }
+            m_lz_distance  = value + 1;
+            m_stream_state = STREAM_STATE_LZ_COUNT;
+            break;
+
+        case STREAM_STATE_LZ_COUNT:
+            if (!lz_bits_get(m_stream_header.compressed.lookahead_sz2, &value))
+            {
+                return NRF_ERROR_BUSY;
+            }
+            if (value >= (m_stream_target_size - m_stream_target_len))
+            {
+                return NRF_ERROR_INVALID_DATA;
+            }
+            m_lz_count     = value + 1;
+            m_stream_state = STREAM_STATE_LZ_COPY;
+            break;
+
+        default:
+            return NRF_ERROR_BUSY;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for copying data referenced by the compressed data to the output buffer.
+ */
+static void lz_copy(void)
+{
+    uint32_t length = MIN(m_lz_count, CODE_PAGE_SIZE - m_stream_page_len);
+
+    m_lz_count -= length;
+
+    while (length-- != 0)
+    {
+        const uint32_t position = m_stream_target_len - m_lz_distance;
+
+        if (position >= m_stream_written)
+        {
+            stream_byte_put(((uint8_t *)m_stream_page)[position - m_stream_written]);
+        }
+        else
+        {
+            stream_byte_put(((uint8_t *)mp_storage_handle_active->block_id)[position]);
+        }
+    }
+
+    if (m_lz_count == 0)
+    {
+        stream_cmd_end(STREAM_STATE_LZ_TAG);
+    }
+}
+
+
+/**@brief   Function for handling a byte of the compressed data.
+ *
+ * @param[in] byte  Byte of the stream.
+ *
+ * @return  NRF_SUCCESS on success, NRF_ERROR_INVALID_DATA if the stream is not valid.
+ */
+static uint32_t lz_byte_handle(uint8_t byte)
+{
+    if (m_stream_state == STREAM_STATE_DONE)
+    {
+        // Only padding of the compressed data to the word size may follow the end of the image.
+        return (byte == 0) ? NRF_SUCCESS : NRF_ERROR_INVALID_DATA;
+    }
+
+    m_lz_bits       = (m_lz_bits << 8) | byte;
+    m_lz_bit_count += 8;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for applying the queued data packets of the image stream.
+ *
+ * @details The image is produced into the output buffer, from the received data and from the
+ *          application in bank 0 (patch) or the image produced before (compressed image), and
+ *          written to bank 1 one page at a time. While a page is being written, applying the stream
+ *          is suspended and received data packets are queued. A data packet is reported as handled
+ *          (\ref dfu_callback_t) once it has been applied, the final one only once the whole image
+ *          has been written.
+ */
+static void stream_process(void)
+{
+    uint32_t err_code;
+
+    while ((m_stream_state != STREAM_STATE_ERROR) && !m_stream_page_pending)
+    {
+        if ((m_stream_page_len == CODE_PAGE_SIZE) ||
+            ((m_stream_state == STREAM_STATE_DONE) && (m_stream_page_len != 0)))
+        {
+            stream_page_flush();
+            continue;
+        }
+
+        if (m_stream_state == STREAM_STATE_PATCH_COPY)
+        {
+            patch_copy();
+            continue;
+        }
+
+        if (m_stream_state == STREAM_STATE_LZ_COPY)
+        {
+            lz_copy();
+            continue;
+        }
+
+        err_code = lz_decode();
+        if (err_code != NRF_ERROR_BUSY)
+        {
+            if (err_code != NRF_SUCCESS)
+            {
+                stream_error(err_code);
+            }
+            continue;
+        }
+
+        if (m_stream_pkt_count == 0)
+        {
+            return;
+        }
+
+        uint8_t * p_data = (uint8_t *)mp_stream_pkt[m_stream_pkt_first];
+
+        if (m_stream_pkt_offset == m_stream_pkt_len[m_stream_pkt_first])
+        {
+            if ((m_stream_pkt_count == 1)            &&
+                (m_data_received == m_image_size)    &&
+                (m_stream_state != STREAM_STATE_DONE))
+            {
+                // The stream ended before the whole image was produced.
+                stream_error(NRF_ERROR_INVALID_DATA);
+                return;
+            }
+
+            m_stream_pkt_first  = (m_stream_pkt_first + 1) % DFU_STREAM_PKT_QUEUE_SIZE;
+            m_stream_pkt_offset = 0;
+            m_stream_pkt_count--;
+
+            if (m_data_pkt_cb != NULL)
+            {
+                m_data_pkt_cb(DATA_PACKET, NRF_SUCCESS, p_data);
+            }
+            continue;
+        }
+
+        if ((m_stream_state == STREAM_STATE_HEADER) || IS_UPDATING_APP_PATCH(m_start_packet))
+        {
+            err_code = stream_word_handle(*(uint32_t *)&p_data[m_stream_pkt_offset]);
+            m_stream_pkt_offset += sizeof(uint32_t);
+        }
+        else
+        {
+            err_code = lz_byte_handle(p_data[m_stream_pkt_offset++]);
+        }
+
+        if (err_code != NRF_SUCCESS)
+        {
+            stream_error(err_code);
+        }
+    }
+}
+
+
+/**@brief   Function for handling the completion of writing the output buffer to flash.
+ *
+ * @param[in] result  Result of the flash operation.
+ * @param[in] length  Number of bytes written.
+ */
+static void stream_page_stored(uint32_t result, uint32_t length)
+{
+    m_stream_page_pending = false;
+
+    if (result != NRF_SUCCESS)
+    {
+        stream_error(result);
+        return;
+    }
+
+    m_stream_written  += length;
+    m_stream_page_len  = 0;
+    stream_process();
+}
+
+
+/**@brief   Function for queuing a received data packet of the image stream to be applied.
+ *
+ * @param[in] p_data  Pointer to the data packet.
+ * @param[in] length  Length of the data packet in bytes.
+ *
+ * @return  NRF_SUCCESS if the packet has been queued, NRF_ERROR_NO_MEM if the queue is full.
+ */
+static uint32_t stream_pkt_queue(uint32_t * p_data, uint32_t length)
+{
+    if (m_stream_pkt_count == DFU_STREAM_PKT_QUEUE_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    const uint32_t index = (m_stream_pkt_first + m_stream_pkt_count) % DFU_STREAM_PKT_QUEUE_SIZE;
+
+    mp_stream_pkt[index]    = p_data;
+    m_stream_pkt_len[index] = length;
+    m_stream_pkt_count++;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief   Function for resetting the image stream, on start of an update procedure.
+ */
+static void stream_reset(void)
+{
+    m_stream_state        = STREAM_STATE_HEADER;
+    m_stream_header_len   = 0;
+    m_stream_target_len   = 0;
+    m_stream_target_size  = 0;
+    m_stream_written      = 0;
+    m_stream_page_len     = 0;
+    m_stream_page_pending = false;
+    m_stream_pkt_count    = 0;
+    m_stream_pkt_offset   = 0;
+}
+
+
 /**@brief   Function for calculating storage offset for receiving SoftDevice image.
  *
  * @details When a new SoftDevice is received it will be temporary stored in flash before moved to
@@ -346,13 +959,21 @@ uint32_t dfu_start_pkt_handle(dfu_update_packet_t * p_packet)
     // - SoftDevice
     // - Bootloader
     // - SoftDevice with Bootloader
-    if (IS_UPDATING_APP(m_start_packet) && 
+    if (IS_UPDATING_APP(m_start_packet) &&
         (IS_UPDATING_SD(m_start_packet) || IS_UPDATING_BL(m_start_packet)))
     {
         // App update is only supported independently.
         return NRF_ERROR_NOT_SUPPORTED;
     }
 
+    if (IS_RECEIVING_STREAM(m_start_packet) &&
+        (!IS_UPDATING_APP(m_start_packet) ||
+         (IS_UPDATING_APP_PATCH(m_start_packet) && IS_UPDATING_APP_COMPRESSED(m_start_packet))))
+    {
+        // Only the application can be updated with a patch or a compressed image, not both.
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
     if (!(IS_WORD_SIZED(m_start_packet.sd_image_size) &&
           IS_WORD_SIZED(m_start_packet.bl_image_size) &&
           IS_WORD_SIZED(m_start_packet.app_image_size)))
@@ -405,7 +1026,18 @@ uint32_t dfu_start_pkt_handle(dfu_update_packet_t * p_packet)
             err_code = dfu_timer_restart();
             VERIFY_SUCCESS(err_code);
             m_functions.prepare(m_image_size);
+            m_functions.cleared();
+            m_data_digested = 0;
+            dfu_init_digest_reset();
 
+            stream_reset();
+
+            // The bank is erased while the image is received, hence data can be accepted at once.
+            m_dfu_state = DFU_STATE_RDY;
+            if (m_data_pkt_cb != NULL)
+            {
+                m_data_pkt_cb(START_PACKET, NRF_SUCCESS, NULL);
+            }
             break;
 
         default:
@@ -459,13 +1091,34 @@ uint32_t dfu_data_pkt_handle(dfu_update_packet_t * p_packet)
 
             p_data = (uint32_t *)p_packet->params.data_packet.p_data_packet;
 
-            err_code = pstorage_store(mp_storage_handle_active,
-                                          (uint8_t *)p_data,
-                                          data_length,
-                                          m_data_received);
-            VERIFY_SUCCESS(err_code);
+            if (IS_RECEIVING_STREAM(m_start_packet))
+            {
+                // The packet is applied, in order, as flash writes of the image produced complete.
+                if (m_stream_state == STREAM_STATE_ERROR)
+                {
+                    return NRF_ERROR_INVALID_DATA;
+                }
+
+                err_code = stream_pkt_queue(p_data, data_length);
+                VERIFY_SUCCESS(err_code);
 
-            m_data_received += data_length;
+                m_data_received += data_length;
+
+                stream_process();
+            }
+            else
+            {
+                err_code = dfu_bank_erase_ahead(m_data_received + data_length);
+                VERIFY_SUCCESS(err_code);
+
+                err_code = pstorage_store(mp_storage_handle_active,
+                                              (uint8_t *)p_data,
+                                              data_length,
+                                              m_data_received);
+                VERIFY_SUCCESS(err_code);
+
+                m_data_received += data_length;
+            }
 
             if (m_data_received != m_image_size)
             {
@@ -560,6 +1213,40 @@ uint32_t dfu_init_pkt_handle(dfu_update_packet_t * p_packet)
 }
 
 
+/**@brief   Function for validating the received image against the init packet.
+ *
+ * @details The digest computed while the image was written is used when it covers the whole image,
+ *          otherwise the image is read back from flash.
+ *
+ * @param[in] image_size  Size of the image in the active bank.
+ *
+ * @return NRF_SUCCESS if the image is valid. Error code from the dfu_init module otherwise.
+ */
+static uint32_t dfu_image_digest_validate(uint32_t image_size)
+{
+    uint32_t err_code;
+
+    if (m_data_digested == image_size)
+    {
+        err_code = dfu_init_digest_validate(image_size);
+#if DFU_IMAGE_READ_BACK_VALIDATE
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = dfu_init_postvalidate((uint8_t *)mp_storage_handle_active->block_id,
+                                             image_size);
+        }
+#endif
+    }
+    else
+    {
+        err_code = dfu_init_postvalidate((uint8_t *)mp_storage_handle_active->block_id,
+                                         image_size);
+    }
+
+    return err_code;
+}
+
+
 uint32_t dfu_image_validate()
 {
     uint32_t err_code;
@@ -568,10 +1255,13 @@ uint32_t dfu_image_validate()
     {
         case DFU_STATE_RX_DATA_PKT:
             // Check if the application image write has finished.
-            if (m_data_received != m_image_size)
+            if ((m_data_received != m_image_size) ||
+                (IS_RECEIVING_STREAM(m_start_packet) &&
+                 (m_stream_written != m_start_packet.app_image_size)))
             {
                 // Image not yet fully transfered by the peer or the peer has attempted to write
-                // too much data. Hence the validation should fail.
+                // too much data, or the patch or compressed image has not been fully applied.
+                // Hence the validation should fail.
                 err_code = NRF_ERROR_INVALID_STATE;
             }
             else
@@ -582,8 +1272,12 @@ uint32_t dfu_image_validate()
                 err_code = dfu_timer_restart();
                 if (err_code == NRF_SUCCESS)
                 {
-                    err_code = dfu_init_postvalidate((uint8_t *)mp_storage_handle_active->block_id,
-                                                     m_image_size);
+                    // When patching or decompressing, the application image size is the size of
+                    // the image produced.
+                    uint32_t image_size = IS_RECEIVING_STREAM(m_start_packet) ?
+                                          m_start_packet.app_image_size : m_image_size;
+
+                    err_code = dfu_image_digest_validate(image_size);
                     VERIFY_SUCCESS(err_code);
 
                     m_dfu_state = DFU_STATE_WAIT_4_ACTIVATE;
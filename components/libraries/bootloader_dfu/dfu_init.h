@@ -129,6 +129,51 @@ uint32_t dfu_init_prevalidate(uint8_t * p_init_data, uint32_t init_data_len);
  */
 uint32_t dfu_init_postvalidate(uint8_t * p_image, uint32_t image_len);
 
+/**@brief DFU digest reset call for starting the digest of a new image.
+ *
+ * @details  The digest of the image is computed while the image is received, from the data read
+ *           back from flash once written, so that validation after the transfer does not have to
+ *           read the whole image again. This call is made on reception of the start packet.
+ */
+void dfu_init_digest_reset(void);
+
+/**@brief DFU digest update call for adding image data written to flash to the digest.
+ *
+ * @details  Called, in order, for each block of the image once it has been written to flash.
+ *
+ * @param[in] p_data    Pointer to the image data in flash.
+ * @param[in] data_len  Length of the image data.
+ */
+void dfu_init_digest_update(uint8_t * p_data, uint32_t data_len);
+
+/**@brief DFU digest validate call for post-checking the received image using the init packet.
+ *
+ * @details  Performs the same checks as \ref dfu_init_postvalidate, comparing the digest computed
+ *           by \ref dfu_init_digest_update with the init packet instead of reading the image.
+ *
+ * @param[in] image_len  Length of the image data added to the digest.
+ *
+ * @retval NRF_SUCCESS             If the post-validation succeeded.
+ * @retval NRF_ERROR_INVALID_DATA  If the post-validation failed.
+ */
+uint32_t dfu_init_digest_validate(uint32_t image_len);
+
+/**@brief DFU patch source validate call for checking the image a patch is applied to.
+ * @details  When the application is received as a patch (@ref DFU_UPDATE_APP_PATCH), the patch is
+ *           applied to the current application in bank 0. This check verifies that the current
+ *           application is the one the patch has been made against, before the patch is applied.
+ *           The image produced is checked by \ref dfu_init_digest_validate, as a full image.
+ *           In the template, the CRC of the source image follows the CRC of the image in the
+ *           extended data of the init packet.
+ *
+ * @param[in] p_image    Pointer to the image the patch is to be applied to.
+ * @param[in] image_len  Length of the image data.
+ * @retval NRF_SUCCESS             If the image is the one the patch has been made against.
+ * @retval NRF_ERROR_INVALID_DATA  If the image is not the one the patch has been made against, or
+ *                                 if the init packet does not identify a source image.
+ */
+uint32_t dfu_init_patch_source_validate(uint8_t * p_image, uint32_t image_len);
+
 #endif // DFU_INIT_H__
 
 /**@} */
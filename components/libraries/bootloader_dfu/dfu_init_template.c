@@ -52,6 +52,7 @@
 
 static uint8_t m_extended_packet[DFU_INIT_PACKET_EXT_LENGTH_MAX];   //< Data array for storage of the extended data received. The extended data follows the normal init data of type \ref dfu_init_packet_t. Extended data can be used for a CRC, hash, signature, or other data. */
 static uint8_t m_extended_packet_length;                            //< Length of the extended data received with init packet. */
+static uint16_t m_image_crc;                                        //< CRC of the image data written so far. */
 
 
 uint32_t dfu_init_prevalidate(uint8_t * p_init_data, uint32_t init_data_len)
@@ -153,3 +154,56 @@ uint32_t dfu_init_postvalidate(uint8_t * p_image, uint32_t image_len)
     return NRF_SUCCESS;
 }
 
+
+void dfu_init_digest_reset(void)
+{
+    // Initial value of the CRC, as when computed over the whole image.
+    m_image_crc = 0xFFFF;
+}
+
+
+void dfu_init_digest_update(uint8_t * p_data, uint32_t data_len)
+{
+    m_image_crc = crc16_compute(p_data, data_len, &m_image_crc);
+}
+
+
+uint32_t dfu_init_digest_validate(uint32_t image_len)
+{
+    // Decode the received CRC from extended data, and compare it with the CRC computed while the
+    // image was received.
+    if (m_image_crc != uint16_decode((uint8_t *)&m_extended_packet[0]))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t dfu_init_patch_source_validate(uint8_t * p_image, uint32_t image_len)
+{
+    uint16_t image_crc;
+    uint16_t received_crc;
+
+    // The CRC of the source image is expected after the CRC of the image in the extended data.
+    if (m_extended_packet_length < (DFU_INIT_PACKET_EXT_LENGTH_MIN + sizeof(uint16_t)))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    // calculate CRC of the source image.
+    image_crc = crc16_compute(p_image, image_len, NULL);
+
+    // Decode the received CRC from extended data.
+    received_crc = uint16_decode((uint8_t *)&m_extended_packet[DFU_INIT_PACKET_EXT_LENGTH_MIN]);
+
+    // Compare the received and calculated CRC.
+    if (image_crc != received_crc)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+
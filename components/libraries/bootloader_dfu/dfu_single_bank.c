@@ -57,6 +57,15 @@ static void pstorage_callback_handler(pstorage_handle_t * p_handle,
     switch (op_code)
     {
         case PSTORAGE_STORE_OP_CODE:
+            if ((m_dfu_state == DFU_STATE_RX_DATA_PKT) && (result == NRF_SUCCESS))
+            {
+                // The data is added to the image digest as read back from flash, while the
+                // following data is being received.
+                dfu_init_digest_update((uint8_t *)mp_storage_handle_active->block_id + m_data_digested,
+                                       data_len);
+                m_data_digested += data_len;
+            }
+
             if ((m_dfu_state == DFU_STATE_RX_DATA_PKT) && (m_data_pkt_cb != NULL))
             {
                 m_data_pkt_cb(DATA_PACKET, result, p_data);
@@ -311,6 +320,13 @@ uint32_t dfu_start_pkt_handle(dfu_update_packet_t * p_packet)
         return NRF_ERROR_NOT_SUPPORTED;
     }
 
+    if (IS_RECEIVING_STREAM(m_start_packet))
+    {
+        // A patch is applied to the current application, which is overwritten in single bank.
+        // Compressed images are only supported by the dual bank update.
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
     if (!(IS_WORD_SIZED(m_start_packet.sd_image_size) &&
           IS_WORD_SIZED(m_start_packet.bl_image_size) &&
           IS_WORD_SIZED(m_start_packet.app_image_size)))
@@ -353,6 +369,8 @@ uint32_t dfu_start_pkt_handle(dfu_update_packet_t * p_packet)
             // Valid peer activity detected. Hence restart the DFU timer.
             err_code = dfu_timer_restart();
             VERIFY_SUCCESS(err_code);
+            m_data_digested = 0;
+            dfu_init_digest_reset();
             m_functions.prepare(m_image_size);
 
             break;
@@ -509,6 +527,40 @@ uint32_t dfu_init_pkt_handle(dfu_update_packet_t * p_packet)
 }
 
 
+/**@brief   Function for validating the received image against the init packet.
+ *
+ * @details The digest computed while the image was written is used when it covers the whole image,
+ *          otherwise the image is read back from flash.
+ *
+ * @param[in] image_size  Size of the image in the active bank.
+ *
+ * @return NRF_SUCCESS if the image is valid. Error code from the dfu_init module otherwise.
+ */
+static uint32_t dfu_image_digest_validate(uint32_t image_size)
+{
+    uint32_t err_code;
+
+    if (m_data_digested == image_size)
+    {
+        err_code = dfu_init_digest_validate(image_size);
+#if DFU_IMAGE_READ_BACK_VALIDATE
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = dfu_init_postvalidate((uint8_t *)mp_storage_handle_active->block_id,
+                                             image_size);
+        }
+#endif
+    }
+    else
+    {
+        err_code = dfu_init_postvalidate((uint8_t *)mp_storage_handle_active->block_id,
+                                         image_size);
+    }
+
+    return err_code;
+}
+
+
 uint32_t dfu_image_validate()
 {
     uint32_t err_code;
@@ -531,8 +583,7 @@ uint32_t dfu_image_validate()
                 err_code = dfu_timer_restart();
                 if (err_code == NRF_SUCCESS)
                 {
-                    err_code = dfu_init_postvalidate((uint8_t *)mp_storage_handle_active->block_id,
-                                                     m_image_size);
+                    err_code = dfu_image_digest_validate(m_image_size);
                     VERIFY_SUCCESS(err_code);
 
                     m_dfu_state = DFU_STATE_WAIT_4_ACTIVATE;
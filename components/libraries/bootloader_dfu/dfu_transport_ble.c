@@ -31,6 +31,7 @@
 #include "app_timer.h"
 #include "ble_conn_params.h"
 #include "hci_mem_pool.h"
+#include "hci_mem_pool_internal.h"
 #include "bootloader.h"
 #include "dfu_ble_svc_internal.h"
 #include "nrf_delay.h"
@@ -110,15 +111,38 @@ static uint16_t             m_conn_handle            = BLE_CONN_HANDLE_INVALID;
 static bool                 m_is_advertising         = false;                                        /**< Variable to indicate if advertising is ongoing.*/
 static dfu_ble_peer_data_t  m_ble_peer_data;                                                         /**< BLE Peer data exchanged from application on buttonless update mode. */
 static bool                 m_ble_peer_data_valid    = false;                                        /**< True if BLE Peer data has been exchanged from application. */
+static dfu_ble_gatt_cache_t m_gatt_cache;                                                            /**< Handles of the DFU Service in the application, known by the peer. */
+static bool                 m_gatt_cache_valid       = false;                                        /**< True if the GATT cache has been exchanged from application and matches the DFU Service of the bootloader. */
 static uint32_t             m_direct_adv_cnt         = APP_DIRECTED_ADV_TIMEOUT;                     /**< Counter of direct advertisements. */
 static uint8_t            * mp_final_packet;                                                         /**< Pointer to final data packet received. When callback for succesful packet handling is received from dfu bank handling a transfer complete response can be sent to peer. */
+static uint32_t             m_image_size;                                                            /**< Total size of the images to be received, in bytes, as given by the start packet. */
+static uint32_t             m_rx_buffer_length;                                                      /**< Number of bytes of firmware data collected in the RX buffer pointed to by mp_rx_buffer. 0 if no RX buffer is being filled. */
+
+#if (RX_BUF_SIZE % 4) != 0
+#error "RX_BUF_SIZE must be a multiple of the word size, as it is the unit of flash writes."
+#endif
+
+
+/**@brief     Function for checking if the DFU Service of the bootloader is at the handles that the
+ *            peer knows from the application.
+ */
+static bool gatt_cache_matches(void)
+{
+    return (m_gatt_cache.service_handle      == m_dfu.service_handle)
+        && (m_gatt_cache.end_handle          == m_dfu.dfu_rev_handles.value_handle)
+        && (m_gatt_cache.pkt_handle          == m_dfu.dfu_pkt_handles.value_handle)
+        && (m_gatt_cache.ctrl_pt_handle      == m_dfu.dfu_ctrl_pt_handles.value_handle)
+        && (m_gatt_cache.ctrl_pt_cccd_handle == m_dfu.dfu_ctrl_pt_handles.cccd_handle);
+}
 
 
 /**@brief     Function updating Service Changed CCCD and indicate a service change to peer.
  *
  * @details   This function will verify the CCCD setting provided with \ref m_ble_peer_data and
  *            update the system attributes accordingly. If Service Change CCCD is set to indicate
- *            then a service change indication will be send to the peer.
+ *            then a service change indication will be send to the peer, unless the peer knows the
+ *            DFU Service handles from the application (see \ref m_gatt_cache). The DFU Control Point
+ *            notification setting is then restored instead.
  *
  * @retval    NRF_INVALID_STATE if no connection has been established to a central.
  * @return    Any error code returned by SoftDevice function calls.
@@ -146,14 +170,32 @@ static uint32_t service_change_indicate()
                                              BLE_GATTS_SYS_ATTR_FLAG_USR_SRVCS);
         VERIFY_SUCCESS(err_code);
 
-        err_code = sd_ble_gatts_service_changed(m_conn_handle, DFU_SERVICE_HANDLE, BLE_HANDLE_MAX);
-        if ((err_code == BLE_ERROR_INVALID_CONN_HANDLE) ||
-            (err_code == NRF_ERROR_INVALID_STATE) ||
-            (err_code == BLE_ERROR_NO_TX_PACKETS))
+        if (m_gatt_cache_valid)
+        {
+            // The peer uses the DFU Service handles it knows from the application. Restore the
+            // Control Point notification setting instead of indicating a service change, so that
+            // the peer neither discovers nor configures the DFU Service again.
+            ble_gatts_value_t gatts_value;
+
+            gatts_value.len     = sizeof(m_gatt_cache.ctrl_pt_cccd);
+            gatts_value.offset  = 0;
+            gatts_value.p_value = (uint8_t *)&m_gatt_cache.ctrl_pt_cccd;
+
+            err_code = sd_ble_gatts_value_set(m_conn_handle,
+                                              m_dfu.dfu_ctrl_pt_handles.cccd_handle,
+                                              &gatts_value);
+        }
+        else
         {
-            // Those errors can be expected when sending trying to send Service Changed Indication
-            // if the CCCD is not set to indicate. Thus set the returning error code to success.
-            err_code = NRF_SUCCESS;
+            err_code = sd_ble_gatts_service_changed(m_conn_handle, DFU_SERVICE_HANDLE, BLE_HANDLE_MAX);
+            if ((err_code == BLE_ERROR_INVALID_CONN_HANDLE) ||
+                (err_code == NRF_ERROR_INVALID_STATE) ||
+                (err_code == BLE_ERROR_NO_TX_PACKETS))
+            {
+                // Those errors can be expected when sending trying to send Service Changed Indication
+                // if the CCCD is not set to indicate. Thus set the returning error code to success.
+                err_code = NRF_SUCCESS;
+            }
         }
     }
     else
@@ -323,6 +365,10 @@ static void start_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
         start_packet.bl_image_size  = uint32_decode(p_length_data + BL_IMAGE_SIZE_OFFSET);
         start_packet.app_image_size = uint32_decode(p_length_data + APP_IMAGE_SIZE_OFFSET);
 
+        m_image_size = start_packet.sd_image_size +
+                       start_packet.bl_image_size +
+                       start_packet.app_image_size;
+
         err_code = dfu_start_pkt_handle(&update_packet);
         if (err_code != NRF_SUCCESS)
         {
@@ -388,9 +434,82 @@ static void init_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
 }
 
 
+/**@brief     Function for discarding the RX buffer being filled with firmware data, if any.
+ */
+static void rx_buffer_discard(void)
+{
+    uint32_t length;
+
+    if (m_rx_buffer_length != 0)
+    {
+        m_rx_buffer_length = 0;
+
+        // The buffer being filled is the only produced buffer which has not been extracted yet.
+        if (hci_mem_pool_rx_extract(&mp_rx_buffer, &length) == NRF_SUCCESS)
+        {
+            UNUSED_VARIABLE(hci_mem_pool_rx_consume(mp_rx_buffer));
+        }
+    }
+}
+
+
+/**@brief     Function for handing the RX buffer filled with firmware data over to be written to
+ *            flash.
+ *
+ * @details   The buffer is returned to the memory pool when the flash operation has completed, see
+ *            @ref dfu_cb_handler. Until then, further firmware data is collected into the next
+ *            buffer of the memory pool.
+ *
+ * @retval    NRF_SUCCESS               All the expected firmware data has been handed over.
+ * @retval    NRF_ERROR_INVALID_LENGTH  The buffer was handed over, more firmware data is expected.
+ * @return    Any other error code returned by the dfu module. The buffer has been released.
+ */
+static uint32_t rx_buffer_write(void)
+{
+    uint32_t            err_code;
+    uint32_t            length;
+    dfu_update_packet_t dfu_pkt;
+
+    err_code = hci_mem_pool_rx_data_size_set(m_rx_buffer_length);
+    m_rx_buffer_length = 0;
+    VERIFY_SUCCESS(err_code);
+
+    err_code = hci_mem_pool_rx_extract(&mp_rx_buffer, &length);
+    VERIFY_SUCCESS(err_code);
+
+    dfu_pkt.packet_type                      = DATA_PACKET;
+    dfu_pkt.params.data_packet.packet_length = length / sizeof(uint32_t);
+    dfu_pkt.params.data_packet.p_data_packet = (uint32_t *)mp_rx_buffer;
+
+    err_code = dfu_data_pkt_handle(&dfu_pkt);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        // All the expected firmware data has been received and processed successfully.
+        // Response will be sent when flash operation for final packet is completed.
+        mp_final_packet = mp_rx_buffer;
+    }
+    else if (err_code != NRF_ERROR_INVALID_LENGTH)
+    {
+        uint32_t hci_error = hci_mem_pool_rx_consume(mp_rx_buffer);
+        if (hci_error != NRF_SUCCESS)
+        {
+            err_code = hci_error;
+        }
+    }
+
+    return err_code;
+}
+
+
 /**@brief     Function for processing application data written by the peer to the DFU Packet
  *            Characteristic.
  *
+ * @details   Firmware data is collected into RX buffers of RX_BUF_SIZE bytes, and each filled
+ *            buffer is written to flash with a single store operation while the following data
+ *            is received into the next buffer. RX_BUF_QUEUE_SIZE buffers can be pending at the
+ *            same time, so the peer is not stalled by the flash writes.
+ *
  * @param[in] p_dfu     DFU Service Structure.
  * @param[in] p_evt     Pointer to the event received from the S110 SoftDevice.
  */
@@ -408,54 +527,48 @@ static void app_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
         return;
     }
 
-    uint32_t length = p_evt->evt.ble_dfu_pkt_write.len;
-
-    err_code = hci_mem_pool_rx_produce(length, (void **) &mp_rx_buffer);
-    if (err_code != NRF_SUCCESS)
-    {
-        dfu_error_notify(p_dfu, err_code);
-        return;
-    }
-
     uint8_t * p_data_packet = p_evt->evt.ble_dfu_pkt_write.p_data;
-    
-    memcpy(mp_rx_buffer, p_data_packet, length);
+    uint32_t  length        = p_evt->evt.ble_dfu_pkt_write.len;
 
-    err_code = hci_mem_pool_rx_data_size_set(length);
-    if (err_code != NRF_SUCCESS)
-    {
-        dfu_error_notify(p_dfu, err_code);
-        return;
-    }
+    // More firmware data is expected, unless the final RX buffer is handed over below.
+    err_code = NRF_ERROR_INVALID_LENGTH;
 
-    err_code = hci_mem_pool_rx_extract(&mp_rx_buffer, &length);
-    if (err_code != NRF_SUCCESS)
+    while (length != 0)
     {
-        dfu_error_notify(p_dfu, err_code);
-        return;
-    }
-
-    dfu_update_packet_t dfu_pkt;
+        if (m_rx_buffer_length == 0)
+        {
+            err_code = hci_mem_pool_rx_produce(RX_BUF_SIZE, (void **) &mp_rx_buffer);
+            if (err_code != NRF_SUCCESS)
+            {
+                dfu_error_notify(p_dfu, err_code);
+                return;
+            }
+            err_code = NRF_ERROR_INVALID_LENGTH;
+        }
 
-    dfu_pkt.packet_type                      = DATA_PACKET;
-    dfu_pkt.params.data_packet.packet_length = length / sizeof(uint32_t);
-    dfu_pkt.params.data_packet.p_data_packet = (uint32_t *)mp_rx_buffer;
+        // A packet may be split over two RX buffers.
+        uint32_t chunk_length = MIN(length, RX_BUF_SIZE - m_rx_buffer_length);
 
-    err_code = dfu_data_pkt_handle(&dfu_pkt);
+        memcpy(&mp_rx_buffer[m_rx_buffer_length], p_data_packet, chunk_length);
 
-    if (err_code == NRF_SUCCESS)
-    {
-        m_num_of_firmware_bytes_rcvd += p_evt->evt.ble_dfu_pkt_write.len;
+        m_rx_buffer_length           += chunk_length;
+        m_num_of_firmware_bytes_rcvd += chunk_length;
+        p_data_packet                += chunk_length;
+        length                       -= chunk_length;
 
-        // All the expected firmware data has been received and processed successfully.
-        // Response will be sent when flash operation for final packet is completed.
-        mp_final_packet = mp_rx_buffer;
+        if ((m_rx_buffer_length == RX_BUF_SIZE) || (m_num_of_firmware_bytes_rcvd >= m_image_size))
+        {
+            err_code = rx_buffer_write();
+            if (err_code != NRF_ERROR_INVALID_LENGTH)
+            {
+                break;
+            }
+        }
     }
-    else if (err_code == NRF_ERROR_INVALID_LENGTH)
+
+    if (err_code == NRF_ERROR_INVALID_LENGTH)
     {
         // Firmware data packet was handled successfully. And more firmware data is expected.
-        m_num_of_firmware_bytes_rcvd += p_evt->evt.ble_dfu_pkt_write.len;
-
         // Check if a packet receipt notification is needed to be sent.
         if (m_pkt_rcpt_notif_enabled)
         {
@@ -473,14 +586,8 @@ static void app_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
             }
         }
     }
-    else
+    else if (err_code != NRF_SUCCESS)
     {
-        uint32_t hci_error = hci_mem_pool_rx_consume(mp_rx_buffer);
-        if (hci_error != NRF_SUCCESS)
-        {
-            dfu_error_notify(p_dfu, hci_error);
-        }
-
         dfu_error_notify(p_dfu, err_code);
     }
 }
@@ -598,8 +705,13 @@ static void on_dfu_evt(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
             break;
 
         case BLE_DFU_START:
+            // Firmware data of an interrupted procedure is not written to flash.
+            rx_buffer_discard();
+            mp_final_packet              = NULL;
+            m_num_of_firmware_bytes_rcvd = 0;
+
             m_pkt_type    = PKT_TYPE_START;
-            m_update_mode = (uint8_t)p_evt->evt.ble_dfu_pkt_write.p_data[0];
+m_update_mode = (uint8_t)p_evt->evt.ble_dfu_pkt_write.p_data[0];
             break;
 
         case BLE_DFU_RECEIVE_INIT_DATA:
@@ -1050,6 +1162,7 @@ uint32_t dfu_transport_update_start(void)
     if (err_code == NRF_SUCCESS)
     {
         m_ble_peer_data_valid = true;
+        m_gatt_cache_valid    = (dfu_ble_gatt_cache_get(&m_gatt_cache) == NRF_SUCCESS);
     }
     else
     {
@@ -1067,6 +1180,7 @@ uint32_t dfu_transport_update_start(void)
 
     gap_params_init();
     services_init();
+    m_gatt_cache_valid = m_gatt_cache_valid && gatt_cache_matches();
     conn_params_init();
     sec_params_init();
     advertising_start();
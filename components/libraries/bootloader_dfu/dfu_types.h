@@ -98,6 +98,20 @@
 #define DFU_UPDATE_SD                   0x01                                                            /**< Bit field indicating update of SoftDevice is ongoing. */
 #define DFU_UPDATE_BL                   0x02                                                            /**< Bit field indicating update of bootloader is ongoing. */
 #define DFU_UPDATE_APP                  0x04                                                            /**< Bit field indicating update of application is ongoing. */
+#define DFU_UPDATE_APP_PATCH            0x08                                                            /**< Bit field indicating that the application is received as a patch against the application in bank 0. Used together with DFU_UPDATE_APP, the application image size of the start packet is then the size of the patch. */
+
+#define DFU_UPDATE_APP_COMPRESSED       0x10                                                            /**< Bit field indicating that the application is received compressed. Used together with DFU_UPDATE_APP, the application image size of the start packet is then the size of the compressed image. */
+
+#define DFU_PATCH_MAGIC                 0x50554644                                                      /**< Magic number of a patch header, "DFUP". */
+#define DFU_PATCH_CMD_COPY              0x00000000                                                      /**< Patch command copying data from the application in bank 0. The command word is followed by the byte offset of the data in bank 0. */
+#define DFU_PATCH_CMD_DATA              0x80000000                                                      /**< Patch command inserting data. The command word is followed by the data. */
+#define DFU_PATCH_CMD_TYPE_MASK         0xC0000000                                                      /**< Mask of the command type in a patch command word. */
+#define DFU_PATCH_CMD_LENGTH_MASK       0x3FFFFFFF                                                      /**< Mask of the length, in bytes, of the data produced by a patch command. */
+
+#define DFU_COMPRESSED_MAGIC            0x5A554644                                                      /**< Magic number of a compressed image header, "DFUZ". */
+#define DFU_COMPRESSED_WINDOW_SZ2_MIN   4                                                               /**< Minimum number of bits of a back reference index in a compressed image. */
+#define DFU_COMPRESSED_WINDOW_SZ2_MAX   15                                                              /**< Maximum number of bits of a back reference index in a compressed image. */
+#define DFU_COMPRESSED_LOOKAHEAD_SZ2_MIN 3                                                              /**< Minimum number of bits of a back reference count in a compressed image. It must be less than the index bits. */
 
 #define DFU_INIT_RX                     0x00                                                            /**< Op Code identifies for receiving init packet. */
 #define DFU_INIT_COMPLETE               0x01                                                            /**< Op Code identifies for transmission complete of init packet. */
@@ -115,6 +129,40 @@ typedef struct
     uint32_t app_image_size;                                                                            /**< Size of the application image to be transmitted. Zero if no Bootloader image will be transfered. */
 } dfu_start_packet_t;
 
+/**@brief Structure holding the header of an application patch.
+ *
+ * @details A patch is a stream of words: this header, followed by commands producing the new
+ *          application in order. A command is a word holding the command type and the length of the
+ *          data produced, followed by the source offset (copy), or by the data (insert). All sizes,
+ *          lengths and offsets are multiples of the word size.
+ */
+typedef struct
+{
+    uint32_t magic;                                                                                     /**< DFU_PATCH_MAGIC. */
+    uint32_t source_size;                                                                               /**< Size of the application in bank 0 the patch has been made against. Its CRC is given in the init packet. */
+    uint32_t target_size;                                                                               /**< Size of the application produced by the patch. */
+    uint32_t reserved;                                                                                  /**< Reserved for future use, shall be 0. */
+} dfu_patch_header_t;
+
+/**@brief Structure holding the header of a compressed application image.
+ *
+ * @details The header is followed by the image compressed in the heatshrink format, with the
+ *          given window and lookahead sizes and without trailing end marker, padded with zeros to a
+ *          multiple of the word size. The decompressor has no window buffer, it references the
+ *          image already written to flash, so any window size uses the same amount of RAM.
+ */
+typedef struct
+{
+    uint32_t magic;                                                                                     /**< DFU_COMPRESSED_MAGIC. */
+    uint32_t image_size;                                                                                /**< Size of the decompressed application. */
+    uint8_t  window_sz2;                                                                                /**< Number of bits of a back reference index, heatshrink -w parameter. */
+    uint8_t  lookahead_sz2;                                                                             /**< Number of bits of a back reference count, heatshrink -l parameter. */
+    uint16_t reserved_0;                                                                                /**< Reserved for future use, shall be 0. */
+    uint32_t reserved_1;                                                                                /**< Reserved for future use, shall be 0. */
+} dfu_compressed_header_t;
+
+STATIC_ASSERT(sizeof(dfu_compressed_header_t) == sizeof(dfu_patch_header_t));
+
 /**@brief Structure holding a bootloader init/data packet received.
  */
 typedef struct
@@ -44,8 +44,9 @@
 #include <stdint.h>
 #include <string.h>
 #include <dfu_types.h>
-#include "nrf_sec.h"
+#include "nrf_crypto.h"
 #include "nrf_error.h"
+#include "nordic_common.h"
 #include "crc16.h"
 
 // The following is the layout of the extended init packet if using image length and sha256 to validate image
@@ -67,6 +68,7 @@
 
 static uint8_t m_extended_packet[DFU_INIT_PACKET_EXT_LENGTH_MAX];   //< Data array for storage of the extended data received. The extended data follows the normal init data of type \ref dfu_init_packet_t. Extended data can be used for a CRC, hash, signature, or other data. */
 static uint8_t m_extended_packet_length;                            //< Length of the extended data received with init packet. */
+static nrf_crypto_sha256_context_t m_image_hash;                    //< SHA-256 of the image data written so far. */
  
  #define DFU_INIT_PACKET_USES_CRC16 (0)
  #define DFU_INIT_PACKET_USES_HASH  (1)
@@ -78,17 +80,12 @@ static uint8_t Qx[] = { 0x39, 0xb0, 0x58, 0x3d, 0x27, 0x07, 0x91, 0x38, 0x6a, 0x
 static uint8_t Qy[] = { 0x4a, 0x0d, 0xfe, 0xa4, 0x77, 0x50, 0xb1, 0xb5, 0x26, 0xc0, 0x9d, 0xdd, 0xf0, 0x24, 0x90, 0x57, 0x6c, 0x64, 0x3b, 0xd3, 0xdf, 0x92, 0x3b, 0xb3, 0x47, 0x97, 0x83, 0xd4, 0xfc, 0x76, 0xf5, 0x9d };
 /** @snippet [DFU BLE Signing public key curve points] */
 
-static nrf_sec_ecc_point_t Q = {.p_x   = Qx, 
-                                .x_len = sizeof(Qx),
-                                .p_y   = Qy, 
-                                .y_len = sizeof(Qy)};
-
 uint32_t dfu_init_prevalidate(uint8_t * p_init_data, uint32_t init_data_len)
 {
     uint32_t                i = 0;
     static uint32_t         err_code;
-    nrf_sec_data_t          init_data;
-    nrf_sec_ecc_signature_t signature;
+    uint32_t                signed_len;
+    uint8_t                 public_key[NRF_CRYPTO_P256_PK_LEN];
         
     // In order to support encryption then any init packet decryption function / library
     // should be called from here or implemented at this location.
@@ -167,16 +164,17 @@ uint32_t dfu_init_prevalidate(uint8_t * p_init_data, uint32_t init_data_len)
         return NRF_ERROR_INVALID_DATA;
     }
     
-    // init_data consists of the regular init-packet and all the extended packet data excluding the signing key
-    init_data.length = (init_data_len - m_extended_packet_length) + DFU_INIT_PACKET_EXT_LENGTH_SIGNED;
-    init_data.p_data = p_init_data;
+    // The signed data consists of the regular init-packet and all the extended packet data excluding the signing key
+    signed_len = (init_data_len - m_extended_packet_length) + DFU_INIT_PACKET_EXT_LENGTH_SIGNED;
 
-    signature.p_r   = &m_extended_packet[DFU_INIT_PACKET_POS_EXT_INIT_SIGNATURE_R];
-    signature.r_len = DFU_SIGNATURE_R_LENGTH;
-    signature.p_s   = &m_extended_packet[DFU_INIT_PACKET_POS_EXT_INIT_SIGNATURE_S];
-    signature.s_len = DFU_SIGNATURE_S_LENGTH;
+    memcpy(&public_key[0], Qx, sizeof(Qx));
+    memcpy(&public_key[sizeof(Qx)], Qy, sizeof(Qy));
 
-    err_code = nrf_sec_svc_verify(&init_data, &Q ,&signature, NRF_SEC_NIST256_SHA256);
+    // The signature is r followed by s. The ECDSA backend is selected with NRF_CRYPTO_ECDSA_BACKEND.
+    err_code = nrf_crypto_ecdsa_p256_sha256_verify(public_key,
+                                                   p_init_data,
+                                                   signed_len,
+                                                   &m_extended_packet[DFU_INIT_PACKET_POS_EXT_INIT_SIGNATURE_R]);
     return err_code;
 }
 
@@ -185,10 +183,6 @@ uint32_t dfu_init_postvalidate(uint8_t * p_image, uint32_t image_len)
     uint8_t   image_digest[DFU_SHA256_DIGEST_LENGTH];
     uint8_t * received_digest;
     
-    nrf_sec_data_t data = {.p_data = p_image,
-                           .length = image_len};
-    
-    
     // Compare image size received with signed init_packet data
     if(image_len != *(uint32_t*)&m_extended_packet[DFU_INIT_PACKET_POS_EXT_IMAGE_LENGTH])
     {
@@ -196,7 +190,10 @@ uint32_t dfu_init_postvalidate(uint8_t * p_image, uint32_t image_len)
     }
                           
     // Calculate digest from active block.
-    nrf_sec_svc_hash(&data, image_digest, NRF_SEC_SHA256);
+    if (nrf_crypto_sha256_compute(p_image, image_len, image_digest) != NRF_SUCCESS)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
 
     received_digest = &m_extended_packet[DFU_INIT_PACKET_POS_EXT_IMAGE_HASH256];
 
@@ -208,3 +205,49 @@ uint32_t dfu_init_postvalidate(uint8_t * p_image, uint32_t image_len)
 
     return NRF_SUCCESS;
 }
+
+void dfu_init_digest_reset(void)
+{
+    UNUSED_VARIABLE(nrf_crypto_sha256_init(&m_image_hash));
+}
+
+
+void dfu_init_digest_update(uint8_t * p_data, uint32_t data_len)
+{
+    UNUSED_VARIABLE(nrf_crypto_sha256_update(&m_image_hash, p_data, data_len));
+}
+
+
+uint32_t dfu_init_digest_validate(uint32_t image_len)
+{
+    uint8_t image_digest[DFU_SHA256_DIGEST_LENGTH];
+
+    // Compare image size received with signed init_packet data
+    if (image_len != *(uint32_t*)&m_extended_packet[DFU_INIT_PACKET_POS_EXT_IMAGE_LENGTH])
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    if (nrf_crypto_sha256_final(&m_image_hash, image_digest) != NRF_SUCCESS)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    // Compare the received and calculated digests.
+    if (memcmp(&image_digest[0],
+               &m_extended_packet[DFU_INIT_PACKET_POS_EXT_IMAGE_HASH256],
+               DFU_SHA256_DIGEST_LENGTH) != 0)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t dfu_init_patch_source_validate(uint8_t * p_image, uint32_t image_len)
+{
+    // The signed extended init packet does not hold a digest of a source image, hence patch
+    // updates are rejected.
+    return NRF_ERROR_INVALID_DATA;
+}
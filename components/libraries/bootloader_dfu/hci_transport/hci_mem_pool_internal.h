@@ -25,7 +25,7 @@
 #define TX_BUF_SIZE       32u    /**< TX buffer size in bytes. */
 #define RX_BUF_SIZE       600u   /**< RX buffer size in bytes. */
 
-#define RX_BUF_QUEUE_SIZE 2u     /**< RX buffer element size. */
+#define RX_BUF_QUEUE_SIZE 4u     /**< RX buffer element size. */
  
 #endif // MEM_POOL_INTERNAL_H__
  
@@ -16,6 +16,9 @@
 #include "nrf_drv_gpiote.h"
 #include "nrf_assert.h"
 #include "sdk_common.h"
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+#include "app_util_platform.h"
+#endif
 
 static app_button_cfg_t *             mp_buttons = NULL;           /**< Button configuration. */
 static uint8_t                        m_button_count;              /**< Number of configured buttons. */
@@ -23,6 +26,120 @@ static uint32_t                       m_detection_delay;           /**< Delay be
 APP_TIMER_DEF(m_detection_delay_timer_id);  /**< Polling timer id. */
 
 
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+
+static uint32_t      m_pin_mask;        /**< Pins of all buttons. */
+static uint32_t      m_pin_reported;    /**< Pin levels last reported to the button handlers. */
+static uint32_t      m_pin_sample;      /**< Pin levels sampled on the previous timeout. */
+static volatile bool m_polling;         /**< True while the timer samples the pins. */
+
+
+/**@brief Function for enabling or disabling the sensing of all button pins. */
+static void buttons_sense_set(bool enable)
+{
+    uint32_t i;
+    for (i = 0; i < m_button_count; i++)
+    {
+        if (enable)
+        {
+            nrf_drv_gpiote_in_event_enable(mp_buttons[i].pin_no, true);
+        }
+        else
+        {
+            nrf_drv_gpiote_in_event_disable(mp_buttons[i].pin_no);
+        }
+    }
+}
+
+
+/**@brief Function for starting to sample the pins, unless already sampling. */
+static void polling_start(void)
+{
+    uint32_t err_code;
+    bool     start = false;
+
+    CRITICAL_REGION_ENTER();
+    if (!m_polling)
+    {
+        m_polling = true;
+        start     = true;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (start)
+    {
+        // No more PORT events until the levels are stable: the bounces are filtered by sampling.
+        buttons_sense_set(false);
+        m_pin_sample = nrf_gpio_pins_read() & m_pin_mask;
+
+        err_code = app_timer_start(m_detection_delay_timer_id, m_detection_delay, NULL);
+        if (err_code != NRF_SUCCESS)
+        {
+            // The impact in app_button of the app_timer queue running full is losing a button press.
+            // The current implementation ensures that the system will continue working as normal.
+            m_polling = false;
+            buttons_sense_set(true);
+        }
+    }
+}
+
+
+/**@brief Function for handling the debounce timer timeout: samples all buttons at once.
+ *
+ * @param[in]  p_context   Not used.
+ */
+static void detection_delay_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    uint32_t sample = nrf_gpio_pins_read() & m_pin_mask;
+
+    if (sample != m_pin_sample)
+    {
+        // Still bouncing, or changed again: sample for one more period.
+        m_pin_sample = sample;
+        return;
+    }
+
+    uint32_t changed = sample ^ m_pin_reported;
+    uint8_t  i;
+
+    m_pin_reported = sample;
+    for (i = 0; (i < m_button_count) && (changed != 0); i++)
+    {
+        app_button_cfg_t * p_btn = &mp_buttons[i];
+        uint32_t btn_mask = 1UL << p_btn->pin_no;
+
+        if ((changed & btn_mask) && p_btn->button_handler)
+        {
+            bool     pin_is_set = ((sample & btn_mask) != 0);
+            uint32_t transition = !(pin_is_set ^ (p_btn->active_state == APP_BUTTON_ACTIVE_HIGH));
+
+            p_btn->button_handler(p_btn->pin_no, transition);
+        }
+    }
+
+    (void)app_timer_stop(m_detection_delay_timer_id);
+    m_polling = false;
+    buttons_sense_set(true);
+
+    // A change between the last sample and the sense configuration would not be detected.
+    if ((nrf_gpio_pins_read() & m_pin_mask) != m_pin_reported)
+    {
+        polling_start();
+    }
+}
+
+static void gpiote_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    UNUSED_PARAMETER(pin);
+    UNUSED_PARAMETER(action);
+
+    polling_start();
+}
+
+#else
+
 static uint32_t m_pin_state;
 static uint32_t m_pin_transition;
 
@@ -106,6 +223,8 @@ static void gpiote_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t
     }
 }
 
+#endif // APP_BUTTON_PORT_DEBOUNCE_ENABLED
+
 uint32_t app_button_init(app_button_cfg_t *             p_buttons,
                          uint8_t                        button_count,
                          uint32_t                       detection_delay)
@@ -128,13 +247,26 @@ uint32_t app_button_init(app_button_cfg_t *             p_buttons,
     m_button_count      = button_count;
     m_detection_delay   = detection_delay;
 
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+    m_pin_mask = 0;
+    m_polling  = false;
+#else
     m_pin_state      = 0;
     m_pin_transition = 0;
+#endif
     
     while (button_count--)
     {
         app_button_cfg_t * p_btn = &p_buttons[button_count];
 
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+        if (p_btn->pin_no >= 32)
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+        m_pin_mask |= (1UL << p_btn->pin_no);
+#endif
+
         nrf_drv_gpiote_in_config_t config = GPIOTE_CONFIG_IN_SENSE_TOGGLE(false);
         config.pull = p_btn->pull_cfg;
         
@@ -144,7 +276,11 @@ uint32_t app_button_init(app_button_cfg_t *             p_buttons,
 
     // Create polling timer.
     return app_timer_create(&m_detection_delay_timer_id,
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+                            APP_TIMER_MODE_REPEATED,
+#else
                             APP_TIMER_MODE_SINGLE_SHOT,
+#endif
                             detection_delay_timeout_handler);
 }
 
@@ -152,6 +288,10 @@ uint32_t app_button_enable(void)
 {
     ASSERT(mp_buttons);
 
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+    m_pin_reported = nrf_gpio_pins_read() & m_pin_mask;
+#endif
+
     uint32_t i;
     for (i = 0; i < m_button_count; i++)
     {
@@ -173,6 +313,9 @@ uint32_t app_button_disable(void)
     }
 
     // Make sure polling timer is not running.
+#if APP_BUTTON_PORT_DEBOUNCE_ENABLED
+    m_polling = false;
+#endif
     return app_timer_stop(m_detection_delay_timer_id);
 }
 
@@ -24,6 +24,15 @@
  *          the timer expires. If there is a new GPIOTE event while the timer is running, the timer
  *          is restarted.
  *
+ * @details When APP_BUTTON_PORT_DEBOUNCE_ENABLED is 1, all buttons share one debounce pass
+ *          instead: the first GPIOTE PORT event disables the sensing of all button pins and
+ *          starts a repeated timer with the detection delay as period. On each timeout, the IN
+ *          register is sampled once, and the buttons whose pin kept the same level for a whole
+ *          period and differs from the last reported level are reported. When no button is
+ *          changing anymore, the timer is stopped and the pin sensing is enabled again. Contact
+ *          bounces therefore cost no interrupts, and any number of buttons is handled by a single
+ *          timer. The button pins must be in the 0 to 31 range.
+ *
  * @note    The app_button module uses the app_timer module. The user must ensure that the queue in
  *          app_timer is large enough to hold the app_timer_stop() / app_timer_start() operations
  *          which will be executed on each event from GPIOTE module (2 operations), as well as other
@@ -47,6 +56,10 @@
 #define APP_BUTTON_ACTIVE_HIGH 1                               /**< Indicates that a button is active high. */
 #define APP_BUTTON_ACTIVE_LOW  0                               /**< Indicates that a button is active low. */
 
+#ifndef APP_BUTTON_PORT_DEBOUNCE_ENABLED
+#define APP_BUTTON_PORT_DEBOUNCE_ENABLED 0                     /**< Debounce all buttons with one timer sampling the IN register. */
+#endif
+
 /**@brief Button event handler type. */
 typedef void (*app_button_handler_t)(uint8_t pin_no, uint8_t button_action);
 
@@ -16,14 +16,25 @@
  * @{
  * @ingroup hci_transport
  *
- * @brief    This module implements CRC-16-CCITT (polynomial 0x1021) with 0xFFFF initial value.
- *           The data can be passed in multiple blocks.
+ * @brief    This module implements CRC-16-CCITT (polynomial 0x1021) with 0xFFFF initial value,
+ *           and CRC-16-IBM (polynomial 0x8005, reflected) with 0x0000 initial value, as used by
+ *           ANT-FS. The data can be passed in multiple blocks.
  */
  
 #ifndef CRC16_H__
 #define CRC16_H__
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#define CRC16_IMPL_BITWISE      0   /**< Shift and XOR steps for each byte, no table. */
+#define CRC16_IMPL_NIBBLE       1   /**< Two lookups per byte in a 16-entry table (32 bytes). */
+#define CRC16_IMPL_TABLE        2   /**< One lookup per byte in a 256-entry table (512 bytes). */
+#define CRC16_IMPL_SLICE_BY_4   3   /**< Four lookups per four bytes in four 256-entry tables (2 kB). */
+
+#ifndef CRC16_IMPL
+#define CRC16_IMPL CRC16_IMPL_NIBBLE    /**< Implementation of @ref crc16_compute and @ref crc16_ibm_compute, one of the CRC16_IMPL_ values. */
+#endif
 
 /**@brief Function for calculating CRC-16 in blocks.
  *
@@ -39,6 +50,31 @@
  */
 uint16_t crc16_compute(uint8_t const * p_data, uint32_t size, uint16_t const * p_crc);
 
+/**@brief Function for calculating CRC-16-IBM in blocks.
+ *
+ * Feed each consecutive data block into this function, along with the current value of p_crc as
+ * returned by the previous call of this function. The first call of this function should pass NULL
+ * as the initial value of the crc in p_crc.
+ *
+ * @param[in] p_data The input data block for computation.
+ * @param[in] size   The size of the input data block in bytes.
+ * @param[in] p_crc  The previous calculated CRC-16 value or NULL if first call.
+ *
+ * @return The updated CRC-16 value, based on the input supplied.
+ */
+uint16_t crc16_ibm_compute(uint8_t const * p_data, uint32_t size, uint16_t const * p_crc);
+
+/**@brief Function for testing the CRC-16 implementation.
+ *
+ * The check values of "123456789" are verified, and the results of @ref crc16_compute and
+ * @ref crc16_ibm_compute are compared with the bitwise implementations for blocks of different
+ * lengths and alignments.
+ *
+ * @retval true  The implementation is correct.
+ * @retval false The implementation is not correct.
+ */
+bool crc16_self_test(void);
+
 #endif // CRC16_H__
  
 /** @} */
@@ -23,6 +23,16 @@
 #define CRC32_H__
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#define CRC32_IMPL_BITWISE      0   /**< Eight shift and XOR steps per byte, no table. */
+#define CRC32_IMPL_NIBBLE       1   /**< Two lookups per byte in a 16-entry table (64 bytes). */
+#define CRC32_IMPL_TABLE        2   /**< One lookup per byte in a 256-entry table (1 kB). */
+#define CRC32_IMPL_SLICE_BY_4   3   /**< Four lookups per word in four 256-entry tables (4 kB). */
+
+#ifndef CRC32_IMPL
+#define CRC32_IMPL CRC32_IMPL_NIBBLE    /**< Implementation of @ref crc32_compute, one of the CRC32_IMPL_ values. */
+#endif
 
 /**@brief Function for calculating CRC-32 in blocks.
  *
@@ -38,6 +48,16 @@
  */
 uint32_t crc32_compute(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
 
+/**@brief Function for testing the CRC-32 implementation.
+ *
+ * The check value of "123456789" is verified, and the result of @ref crc32_compute is compared
+ * with the bitwise implementation for blocks of different lengths and alignments.
+ *
+ * @retval true  The implementation is correct.
+ * @retval false The implementation is not correct.
+ */
+bool crc32_self_test(void);
+
 #endif // CRC32_H__
  
 /** @} */
@@ -0,0 +1,366 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include "nrf_crypto.h"
+#include "nrf_drv_rng.h"
+#include "nrf_error.h"
+#include "sdk_common.h"
+
+#if defined(MBEDTLS_AES_ENCRYPT_ALT)
+#include "mbedtls/aes.h"
+#endif
+
+#if defined(MBEDTLS_ENTROPY_HARDWARE_ALT)
+#include "mbedtls/entropy_poll.h"
+#endif
+
+#if defined(MBEDTLS_ECDH_GEN_PUBLIC_ALT) || defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT)
+#include "mbedtls/ecdh.h"
+#endif
+
+#if defined(MBEDTLS_ECDSA_VERIFY_ALT)
+#include "mbedtls/ecdsa.h"
+#endif
+
+#define P256_COORD_LEN      32  /**< Length of a P-256 coordinate or scalar, in bytes. */
+#define RNG_POLL_MIN_LEN    4   /**< Number of bytes waited for when the RNG pool is empty. */
+
+
+#if defined(MBEDTLS_ENTROPY_HARDWARE_ALT)
+/**@brief Entropy source of mbed TLS, reading the RNG pool.
+ * @details The bytes in the pool are returned. If the pool is empty, the function waits for a
+ *          few bytes, so that the entropy module does not give up while the pool fills up.
+ */
+int mbedtls_hardware_poll(void * p_data, unsigned char * p_output, size_t len, size_t * p_olen)
+{
+    uint8_t available;
+
+    UNUSED_PARAMETER(p_data);
+    *p_olen = 0;
+
+    if (nrf_drv_rng_bytes_available(&available) != NRF_SUCCESS)
+    {
+        return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+    }
+
+    if (available != 0)
+    {
+        uint8_t length = (uint8_t)MIN(len, available);
+
+        if (nrf_drv_rng_rand(p_output, length) != NRF_SUCCESS)
+        {
+            return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+        }
+        *p_olen = length;
+    }
+    else
+    {
+        uint32_t length = MIN(len, RNG_POLL_MIN_LEN);
+
+        if (nrf_drv_rng_block_rand(p_output, length) != NRF_SUCCESS)
+        {
+            return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+        }
+        *p_olen = length;
+    }
+
+    return 0;
+}
+#endif // MBEDTLS_ENTROPY_HARDWARE_ALT
+
+
+#if defined(MBEDTLS_AES_ENCRYPT_ALT)
+/**@brief AES block encryption of mbed TLS, through the AES backend of @ref nrf_crypto.
+ * @details The first round key of the software key schedule is the key itself, so the key does
+ *          not need to be stored elsewhere in the context. The block is encrypted as the CTR
+ *          keystream of a single counter block, which is the ECB encryption of that block.
+ *          Only 128-bit keys are supported. Decryption stays in software.
+ */
+int mbedtls_internal_aes_encrypt(mbedtls_aes_context * ctx,
+                                 const unsigned char   input[16],
+                                 unsigned char         output[16])
+{
+    static uint8_t const zero[NRF_CRYPTO_AES_KEY_LEN] = {0};
+
+    uint8_t    key[NRF_CRYPTO_AES_KEY_LEN];
+    uint8_t    counter[NRF_CRYPTO_AES_KEY_LEN];
+    ret_code_t err_code;
+
+    if (ctx->nr != 10)
+    {
+        return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+    }
+
+    // The key schedule holds the key as little endian words.
+    for (uint32_t i = 0; i < (NRF_CRYPTO_AES_KEY_LEN / sizeof(uint32_t)); i++)
+    {
+        (void)uint32_encode(ctx->rk[i], &key[i * sizeof(uint32_t)]);
+    }
+    memcpy(counter, input, sizeof(counter));
+
+    err_code = nrf_crypto_aes_ctr_crypt(key, counter, zero, output, NRF_CRYPTO_AES_KEY_LEN);
+    memset(key, 0, sizeof(key));
+
+    return (err_code == NRF_SUCCESS) ? 0 : MBEDTLS_ERR_AES_HW_ACCEL_FAILED;
+}
+#endif // MBEDTLS_AES_ENCRYPT_ALT
+
+
+#if defined(MBEDTLS_ECDH_GEN_PUBLIC_ALT) || defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT) || \
+    defined(MBEDTLS_ECDSA_VERIFY_ALT)
+static void bytes_reverse(uint8_t * p_dst, uint8_t const * p_src)
+{
+    for (uint32_t i = 0; i < P256_COORD_LEN; i++)
+    {
+        p_dst[i] = p_src[P256_COORD_LEN - 1 - i];
+    }
+}
+
+
+/**@brief Function for writing a value as a big endian coordinate. */
+static int mpi_write(mbedtls_mpi const * p_value, uint8_t * p_be)
+{
+    return mbedtls_mpi_write_binary(p_value, p_be, P256_COORD_LEN);
+}
+
+
+/**@brief Function for checking that a point has affine coordinates, as the backends need. */
+static bool point_is_affine(mbedtls_ecp_point const * p_point)
+{
+    return (mbedtls_mpi_cmp_int(&p_point->Z, 1) == 0);
+}
+#endif
+
+
+#if defined(MBEDTLS_ECDH_GEN_PUBLIC_ALT) || defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT)
+/**@brief Function for reading a value from a little endian coordinate of @ref ecc. */
+static int mpi_read_le(mbedtls_mpi * p_value, uint8_t const * p_le)
+{
+    uint8_t be[P256_COORD_LEN];
+
+    bytes_reverse(be, p_le);
+
+    return mbedtls_mpi_read_binary(p_value, be, P256_COORD_LEN);
+}
+
+
+/**@brief Function for writing a value as a little endian coordinate of @ref ecc. */
+static int mpi_write_le(mbedtls_mpi const * p_value, uint8_t * p_le)
+{
+    uint8_t be[P256_COORD_LEN];
+    int     ret = mpi_write(p_value, be);
+
+    if (ret == 0)
+    {
+        bytes_reverse(p_le, be);
+    }
+    memset(be, 0, sizeof(be));
+
+    return ret;
+}
+
+
+static int ecdh_error_convert(ret_code_t err_code)
+{
+    switch (err_code)
+    {
+        case NRF_SUCCESS:
+            return 0;
+
+        case NRF_ERROR_INVALID_DATA:
+            return MBEDTLS_ERR_ECP_INVALID_KEY;
+
+        case NRF_ERROR_NOT_SUPPORTED:
+            return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+
+        default:
+            return MBEDTLS_ERR_ECP_HW_ACCEL_FAILED;
+    }
+}
+#endif
+
+
+#if defined(MBEDTLS_ECDH_GEN_PUBLIC_ALT)
+/**@brief ECDH key pair generation of mbed TLS, through the ECDH backend of @ref nrf_crypto.
+ * @details The random numbers come from @ref nrf_drv_rng, so f_rng is not used.
+ */
+int mbedtls_ecdh_gen_public(mbedtls_ecp_group * grp,
+                            mbedtls_mpi       * d,
+                            mbedtls_ecp_point * Q,
+                            int              (* f_rng)(void *, unsigned char *, size_t),
+                            void              * p_rng)
+{
+    // Words, for the alignment required by the ecc library.
+    uint32_t le_sk[NRF_CRYPTO_P256_SK_LEN / sizeof(uint32_t)];
+    uint32_t le_pk[NRF_CRYPTO_P256_PK_LEN / sizeof(uint32_t)];
+    int      ret;
+
+    UNUSED_PARAMETER(f_rng);
+    UNUSED_PARAMETER(p_rng);
+
+    if (grp->id != MBEDTLS_ECP_DP_SECP256R1)
+    {
+        return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+
+    ret = ecdh_error_convert(nrf_crypto_ecdh_p256_keypair_gen((uint8_t *)le_sk, (uint8_t *)le_pk));
+    if (ret == 0)
+    {
+        ret = mpi_read_le(d, (uint8_t *)le_sk);
+    }
+    if (ret == 0)
+    {
+        ret = mpi_read_le(&Q->X, (uint8_t *)le_pk);
+    }
+    if (ret == 0)
+    {
+        ret = mpi_read_le(&Q->Y, (uint8_t *)&le_pk[P256_COORD_LEN / sizeof(uint32_t)]);
+    }
+    if (ret == 0)
+    {
+        ret = mbedtls_mpi_lset(&Q->Z, 1);
+    }
+
+    memset(le_sk, 0, sizeof(le_sk));
+
+    return ret;
+}
+#endif // MBEDTLS_ECDH_GEN_PUBLIC_ALT
+
+
+#if defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT)
+/**@brief ECDH shared secret computation of mbed TLS, through the ECDH backend of
+ *        @ref nrf_crypto.
+ * @details The backend checks that the public key is on the curve. The random numbers for
+ *          blinding are not used, as the ladder of @ref ecc runs in constant time.
+ */
+int mbedtls_ecdh_compute_shared(mbedtls_ecp_group       * grp,
+                                mbedtls_mpi             * z,
+                                mbedtls_ecp_point const * Q,
+                                mbedtls_mpi const       * d,
+                                int                    (* f_rng)(void *, unsigned char *, size_t),
+                                void                    * p_rng)
+{
+    uint32_t le_sk[NRF_CRYPTO_P256_SK_LEN / sizeof(uint32_t)];
+    uint32_t le_pk[NRF_CRYPTO_P256_PK_LEN / sizeof(uint32_t)];
+    uint32_t le_ss[NRF_CRYPTO_P256_SS_LEN / sizeof(uint32_t)];
+    int      ret;
+
+    UNUSED_PARAMETER(f_rng);
+    UNUSED_PARAMETER(p_rng);
+
+    if (grp->id != MBEDTLS_ECP_DP_SECP256R1)
+    {
+        return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+    if (!point_is_affine(Q))
+    {
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    }
+
+    ret = mbedtls_ecp_check_privkey(grp, d);
+    if (ret == 0)
+    {
+        ret = mpi_write_le(d, (uint8_t *)le_sk);
+    }
+    if (ret == 0)
+    {
+        ret = mpi_write_le(&Q->X, (uint8_t *)le_pk);
+    }
+    if (ret == 0)
+    {
+        ret = mpi_write_le(&Q->Y, (uint8_t *)&le_pk[P256_COORD_LEN / sizeof(uint32_t)]);
+    }
+    if (ret == 0)
+    {
+        ret = ecdh_error_convert(nrf_crypto_ecdh_p256_shared_secret_compute((uint8_t *)le_sk,
+                                                                            (uint8_t *)le_pk,
+                                                                            (uint8_t *)le_ss));
+    }
+    if (ret == 0)
+    {
+        ret = mpi_read_le(z, (uint8_t *)le_ss);
+    }
+
+    memset(le_sk, 0, sizeof(le_sk));
+    memset(le_ss, 0, sizeof(le_ss));
+
+    return ret;
+}
+#endif // MBEDTLS_ECDH_COMPUTE_SHARED_ALT
+
+
+#if defined(MBEDTLS_ECDSA_VERIFY_ALT)
+/**@brief ECDSA signature verification of mbed TLS, through the ECDSA backend of
+ *        @ref nrf_crypto.
+ * @details The hash is truncated or padded to the length of the curve order, as mbed TLS does.
+ */
+int mbedtls_ecdsa_verify(mbedtls_ecp_group       * grp,
+                         unsigned char const     * buf,
+                         size_t                    blen,
+                         mbedtls_ecp_point const * Q,
+                         mbedtls_mpi const       * r,
+                         mbedtls_mpi const       * s)
+{
+    uint8_t    pk[NRF_CRYPTO_P256_PK_LEN];
+    uint8_t    digest[NRF_CRYPTO_SHA256_DIGEST_LEN];
+    uint8_t    sig[NRF_CRYPTO_P256_SIG_LEN];
+    uint32_t   hash_len = MIN(blen, sizeof(digest));
+    ret_code_t err_code;
+
+    if (grp->id != MBEDTLS_ECP_DP_SECP256R1)
+    {
+        return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+    if (!point_is_affine(Q))
+    {
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    }
+
+    if ((mpi_write(&Q->X, pk) != 0) || (mpi_write(&Q->Y, &pk[P256_COORD_LEN]) != 0))
+    {
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    }
+    // Values longer than a coordinate are out of range, so the signature is not valid.
+    if ((mpi_write(r, sig) != 0) || (mpi_write(s, &sig[P256_COORD_LEN]) != 0))
+    {
+        return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    }
+
+    memset(digest, 0, sizeof(digest));
+    memcpy(&digest[sizeof(digest) - hash_len], buf, hash_len);
+
+    err_code = nrf_crypto_ecdsa_p256_verify(pk, digest, sig);
+    switch (err_code)
+    {
+        case NRF_SUCCESS:
+            return 0;
+
+        case NRF_ERROR_INVALID_DATA:
+            return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+
+        case NRF_ERROR_NOT_SUPPORTED:
+            return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+
+        default:
+            return MBEDTLS_ERR_ECP_HW_ACCEL_FAILED;
+    }
+}
+#endif // MBEDTLS_ECDSA_VERIFY_ALT
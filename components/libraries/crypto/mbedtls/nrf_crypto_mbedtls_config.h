@@ -0,0 +1,109 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ * @defgroup nrf_crypto_mbedtls mbed TLS configuration for nRF52
+ * @{
+ * @ingroup nrf_crypto
+ * @brief    mbed TLS 2.x configuration for TLS 1.2 and DTLS 1.2 with ECDHE-ECDSA and AES-128.
+ * @details  Select the file with MBEDTLS_CONFIG_FILE="nrf_crypto_mbedtls_config.h" and link
+ *           nrf_crypto_mbedtls_alt.c. The AES block encryption, the entropy source, P-256 ECDH
+ *           and P-256 ECDSA verification are then routed to @ref nrf_crypto:
+ *           - AES: the ECB peripheral, or sd_ecb_blocks_encrypt when the SoftDevice is enabled.
+ *           - Entropy: the @ref nrf_drv_rng pool.
+ *           - ECDH and ECDSA verification: @ref ecc, whose key generation can use a fixed-base comb
+ *             table in flash, see ECC_P256_COMB_TEETH.
+ *           @ref nrf_crypto_init and @ref nrf_drv_rng_init must be called before mbed TLS is used.
+ *
+ *           The rest of the configuration keeps RAM usage low: only the P-256 curve, a small ECP
+ *           window without a fixed-point table in RAM, AES tables in flash and records of
+ *           @ref MBEDTLS_SSL_MAX_CONTENT_LEN bytes. ECDSA signing stays in software.
+ */
+
+#ifndef NRF_CRYPTO_MBEDTLS_CONFIG_H__
+#define NRF_CRYPTO_MBEDTLS_CONFIG_H__
+
+/* System support. */
+#define MBEDTLS_HAVE_ASM
+#define MBEDTLS_PLATFORM_C
+#define MBEDTLS_PLATFORM_MEMORY
+#define MBEDTLS_NO_PLATFORM_ENTROPY
+
+/* Hardware alternatives, implemented in nrf_crypto_mbedtls_alt.c. Only AES-128 keys can be
+ * used for encryption, which is what the ciphersuites below need. */
+#define MBEDTLS_AES_ENCRYPT_ALT
+#define MBEDTLS_ENTROPY_HARDWARE_ALT
+#define MBEDTLS_ECDH_GEN_PUBLIC_ALT
+#define MBEDTLS_ECDH_COMPUTE_SHARED_ALT
+#define MBEDTLS_ECDSA_VERIFY_ALT
+
+/* Ciphers and hashes. */
+#define MBEDTLS_AES_C
+#define MBEDTLS_AES_ROM_TABLES
+#define MBEDTLS_AES_FEWER_TABLES
+#define MBEDTLS_CCM_C
+#define MBEDTLS_GCM_C
+#define MBEDTLS_CIPHER_C
+#define MBEDTLS_MD_C
+#define MBEDTLS_SHA256_C
+#define MBEDTLS_SHA256_SMALLER
+
+/* Random numbers. */
+#define MBEDTLS_ENTROPY_C
+#define MBEDTLS_CTR_DRBG_C
+#define MBEDTLS_ENTROPY_FORCE_SHA256
+#define MBEDTLS_ENTROPY_MAX_SOURCES     2
+#define MBEDTLS_ENTROPY_MIN_HARDWARE    32
+
+/* Public key cryptography: P-256 only. */
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM
+#define MBEDTLS_ECDH_C
+#define MBEDTLS_ECDSA_C
+#define MBEDTLS_ASN1_PARSE_C
+#define MBEDTLS_ASN1_WRITE_C
+#define MBEDTLS_OID_C
+#define MBEDTLS_PK_C
+#define MBEDTLS_PK_PARSE_C
+#define MBEDTLS_BASE64_C
+#define MBEDTLS_PEM_PARSE_C
+#define MBEDTLS_X509_USE_C
+#define MBEDTLS_X509_CRT_PARSE_C
+
+#define MBEDTLS_MPI_WINDOW_SIZE         1
+#define MBEDTLS_MPI_MAX_SIZE            48
+#define MBEDTLS_ECP_MAX_BITS            256
+#define MBEDTLS_ECP_WINDOW_SIZE         2
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM   0
+
+/* TLS and DTLS. */
+#define MBEDTLS_SSL_TLS_C
+#define MBEDTLS_SSL_CLI_C
+#define MBEDTLS_SSL_PROTO_TLS1_2
+#define MBEDTLS_SSL_PROTO_DTLS
+#define MBEDTLS_SSL_DTLS_ANTI_REPLAY
+#define MBEDTLS_SSL_DTLS_HELLO_VERIFY
+#define MBEDTLS_SSL_SERVER_NAME_INDICATION
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#define MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED
+
+#define MBEDTLS_SSL_MAX_CONTENT_LEN     2048
+#define MBEDTLS_SSL_CIPHERSUITES        MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8, \
+                                        MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256
+
+#include "mbedtls/check_config.h"
+
+#endif // NRF_CRYPTO_MBEDTLS_CONFIG_H__
+
+/** @} */
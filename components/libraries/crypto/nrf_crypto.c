@@ -0,0 +1,350 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "nrf_crypto.h"
+#include <stdint.h>
+#include <stddef.h>
+#include "nrf_error.h"
+#include "nordic_common.h"
+#include "sdk_common.h"
+
+#if (NRF_CRYPTO_ECDH_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC) || \
+    (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+#include "ecc.h"
+#endif
+
+#if (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_NRF_SEC)
+#include "nrf_sec.h"
+#endif
+
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+#include "nrf_drv_aes.h"
+#endif
+
+#if (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC) && \
+    (NRF_CRYPTO_HASH_BACKEND != NRF_CRYPTO_BACKEND_SDK)
+#error "The micro-ecc ECDSA backend requires the SDK hash backend."
+#endif
+
+#define P256_COORD_LEN  32  /**< Length of a P-256 coordinate or scalar, in bytes. */
+
+
+#if (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+/**@brief Function for copying big-endian 32-byte values as little endian, as taken by @ref ecc.
+ *
+ * @param[out] p_le     Little-endian values.
+ * @param[in]  p_be     Big-endian values.
+ * @param[in]  count    Number of 32-byte values.
+ */
+static void coords_reverse(uint8_t * p_le, uint8_t const * p_be, uint32_t count)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; j < P256_COORD_LEN; j++)
+        {
+            p_le[(i * P256_COORD_LEN) + j] = p_be[(i * P256_COORD_LEN) + (P256_COORD_LEN - 1 - j)];
+        }
+    }
+}
+#endif
+
+
+ret_code_t nrf_crypto_init(void)
+{
+#if (NRF_CRYPTO_ECDH_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC) || \
+    (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+    ecc_init();
+#endif
+
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+    // The AES driver may already have been initialized by the application, in blocking mode.
+    if (nrf_drv_aes_init(NULL, NULL) == NRF_ERROR_SOFTDEVICE_NOT_ENABLED)
+    {
+        return NRF_ERROR_SOFTDEVICE_NOT_ENABLED;
+    }
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_crypto_sha256_init(nrf_crypto_sha256_context_t * p_ctx)
+{
+#if (NRF_CRYPTO_HASH_BACKEND == NRF_CRYPTO_BACKEND_SDK)
+    return sha256_init(p_ctx);
+#else
+    UNUSED_PARAMETER(p_ctx);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_sha256_update(nrf_crypto_sha256_context_t * p_ctx,
+                                    uint8_t const               * p_data,
+                                    uint32_t                      len)
+{
+#if (NRF_CRYPTO_HASH_BACKEND == NRF_CRYPTO_BACKEND_SDK)
+    return sha256_update(p_ctx, p_data, len);
+#else
+    UNUSED_PARAMETER(p_ctx);
+    UNUSED_PARAMETER(p_data);
+    UNUSED_PARAMETER(len);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_sha256_final(nrf_crypto_sha256_context_t * p_ctx, uint8_t * p_digest)
+{
+#if (NRF_CRYPTO_HASH_BACKEND == NRF_CRYPTO_BACKEND_SDK)
+    return sha256_final(p_ctx, p_digest);
+#else
+    UNUSED_PARAMETER(p_ctx);
+    UNUSED_PARAMETER(p_digest);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_sha256_compute(uint8_t const * p_data, uint32_t len, uint8_t * p_digest)
+{
+#if (NRF_CRYPTO_HASH_BACKEND == NRF_CRYPTO_BACKEND_SDK)
+    nrf_crypto_sha256_context_t ctx;
+    ret_code_t                  err_code;
+
+    err_code = sha256_init(&ctx);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = sha256_update(&ctx, p_data, len);
+    VERIFY_SUCCESS(err_code);
+
+    return sha256_final(&ctx, p_digest);
+#else
+    UNUSED_PARAMETER(p_data);
+    UNUSED_PARAMETER(len);
+    UNUSED_PARAMETER(p_digest);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_ecdh_p256_keypair_gen(uint8_t * p_le_sk, uint8_t * p_le_pk)
+{
+#if (NRF_CRYPTO_ECDH_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+    return ecc_p256_keypair_gen(p_le_sk, p_le_pk);
+#else
+    UNUSED_PARAMETER(p_le_sk);
+    UNUSED_PARAMETER(p_le_pk);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_ecdh_p256_public_key_compute(uint8_t const * p_le_sk, uint8_t * p_le_pk)
+{
+#if (NRF_CRYPTO_ECDH_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+    return ecc_p256_public_key_compute(p_le_sk, p_le_pk);
+#else
+    UNUSED_PARAMETER(p_le_sk);
+    UNUSED_PARAMETER(p_le_pk);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_ecdh_p256_shared_secret_compute(uint8_t const * p_le_sk,
+                                                      uint8_t const * p_le_pk,
+                                                      uint8_t       * p_le_ss)
+{
+#if (NRF_CRYPTO_ECDH_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+    return ecc_p256_shared_secret_compute(p_le_sk, p_le_pk, p_le_ss);
+#else
+    UNUSED_PARAMETER(p_le_sk);
+    UNUSED_PARAMETER(p_le_pk);
+    UNUSED_PARAMETER(p_le_ss);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_ecdsa_p256_verify(uint8_t const * p_pk,
+                                        uint8_t const * p_digest,
+                                        uint8_t const * p_sig)
+{
+#if (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+    // Words, for the alignment required by the ecc library.
+    uint32_t le_pk[NRF_CRYPTO_P256_PK_LEN / sizeof(uint32_t)];
+    uint32_t le_hash[NRF_CRYPTO_SHA256_DIGEST_LEN / sizeof(uint32_t)];
+    uint32_t le_sig[NRF_CRYPTO_P256_SIG_LEN / sizeof(uint32_t)];
+
+    VERIFY_PARAM_NOT_NULL(p_pk);
+    VERIFY_PARAM_NOT_NULL(p_digest);
+    VERIFY_PARAM_NOT_NULL(p_sig);
+
+    coords_reverse((uint8_t *)le_pk, p_pk, 2);
+    coords_reverse((uint8_t *)le_hash, p_digest, 1);
+    coords_reverse((uint8_t *)le_sig, p_sig, 2);
+
+    return ecc_p256_signature_verify((uint8_t *)le_pk, (uint8_t *)le_hash, (uint8_t *)le_sig);
+#else
+    UNUSED_PARAMETER(p_pk);
+    UNUSED_PARAMETER(p_digest);
+    UNUSED_PARAMETER(p_sig);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_ecdsa_p256_sha256_verify(uint8_t const * p_pk,
+                                               uint8_t const * p_data,
+                                               uint32_t        len,
+                                               uint8_t const * p_sig)
+{
+#if (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_MICRO_ECC)
+    uint8_t    digest[NRF_CRYPTO_SHA256_DIGEST_LEN];
+    ret_code_t err_code;
+
+    err_code = nrf_crypto_sha256_compute(p_data, len, digest);
+    VERIFY_SUCCESS(err_code);
+
+    return nrf_crypto_ecdsa_p256_verify(p_pk, digest, p_sig);
+#elif (NRF_CRYPTO_ECDSA_BACKEND == NRF_CRYPTO_BACKEND_NRF_SEC)
+    // The nRF Security library takes non-const pointers, but does not write through them.
+    nrf_sec_data_t          data;
+    nrf_sec_ecc_point_t     point;
+    nrf_sec_ecc_signature_t signature;
+
+    VERIFY_PARAM_NOT_NULL(p_pk);
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_sig);
+
+    data.p_data     = (uint8_t *)p_data;
+    data.length     = len;
+    point.p_x       = (uint8_t *)p_pk;
+    point.x_len     = P256_COORD_LEN;
+    point.p_y       = (uint8_t *)&p_pk[P256_COORD_LEN];
+    point.y_len     = P256_COORD_LEN;
+    signature.p_r   = (uint8_t *)p_sig;
+    signature.r_len = P256_COORD_LEN;
+    signature.p_s   = (uint8_t *)&p_sig[P256_COORD_LEN];
+    signature.s_len = P256_COORD_LEN;
+
+    return nrf_sec_svc_verify(&data, &point, &signature, NRF_SEC_NIST256_SHA256);
+#else
+    UNUSED_PARAMETER(p_pk);
+    UNUSED_PARAMETER(p_data);
+    UNUSED_PARAMETER(len);
+    UNUSED_PARAMETER(p_sig);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_aes_ctr_crypt(uint8_t const * p_key,
+                                    uint8_t       * p_counter,
+                                    uint8_t const * p_in,
+                                    uint8_t       * p_out,
+                                    uint32_t        len)
+{
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+    return nrf_drv_aes_ctr_crypt(p_key, p_counter, p_in, p_out, len);
+#else
+    UNUSED_PARAMETER(p_key);
+    UNUSED_PARAMETER(p_counter);
+    UNUSED_PARAMETER(p_in);
+    UNUSED_PARAMETER(p_out);
+    UNUSED_PARAMETER(len);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+static void ccm_params_convert(nrf_drv_aes_ccm_params_t          * p_drv,
+                               nrf_crypto_aes_ccm_params_t const * p_params)
+{
+    p_drv->p_key     = p_params->p_key;
+    p_drv->p_nonce   = p_params->p_nonce;
+    p_drv->nonce_len = p_params->nonce_len;
+    p_drv->mic_len   = p_params->mic_len;
+    p_drv->p_adata   = p_params->p_adata;
+    p_drv->adata_len = p_params->adata_len;
+}
+#endif
+
+
+ret_code_t nrf_crypto_aes_ccm_encrypt(nrf_crypto_aes_ccm_params_t const * p_params,
+                                      uint8_t const                     * p_in,
+                                      uint8_t                           * p_out,
+                                      uint32_t                            len,
+                                      uint8_t                           * p_mic)
+{
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+    nrf_drv_aes_ccm_params_t params;
+
+    VERIFY_PARAM_NOT_NULL(p_params);
+    ccm_params_convert(&params, p_params);
+
+    return nrf_drv_aes_ccm_encrypt(&params, p_in, p_out, len, p_mic);
+#else
+    UNUSED_PARAMETER(p_params);
+    UNUSED_PARAMETER(p_in);
+    UNUSED_PARAMETER(p_out);
+    UNUSED_PARAMETER(len);
+    UNUSED_PARAMETER(p_mic);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_aes_ccm_decrypt(nrf_crypto_aes_ccm_params_t const * p_params,
+                                      uint8_t const                     * p_in,
+                                      uint8_t                           * p_out,
+                                      uint32_t                            len,
+                                      uint8_t const                     * p_mic)
+{
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+    nrf_drv_aes_ccm_params_t params;
+
+    VERIFY_PARAM_NOT_NULL(p_params);
+    ccm_params_convert(&params, p_params);
+
+    return nrf_drv_aes_ccm_decrypt(&params, p_in, p_out, len, p_mic);
+#else
+    UNUSED_PARAMETER(p_params);
+    UNUSED_PARAMETER(p_in);
+    UNUSED_PARAMETER(p_out);
+    UNUSED_PARAMETER(len);
+    UNUSED_PARAMETER(p_mic);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+ret_code_t nrf_crypto_aes_cmac(uint8_t const * p_key,
+                               uint8_t const * p_in,
+                               uint32_t        len,
+                               uint8_t       * p_mac)
+{
+#if (NRF_CRYPTO_AES_BACKEND == NRF_CRYPTO_BACKEND_NRF_ECB)
+    return nrf_drv_aes_cmac(p_key, p_in, len, p_mac);
+#else
+    UNUSED_PARAMETER(p_key);
+    UNUSED_PARAMETER(p_in);
+    UNUSED_PARAMETER(len);
+    UNUSED_PARAMETER(p_mac);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
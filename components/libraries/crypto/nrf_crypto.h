@@ -0,0 +1,296 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup nrf_crypto Crypto backend interface
+ * @{
+ * @ingroup app_common
+ *
+ * @brief    Common interface to the hash, ECDH, ECDSA and AES implementations of the SDK.
+ *
+ * @details  Each group of algorithms is served by one backend, selected at build time with
+ *           @ref NRF_CRYPTO_HASH_BACKEND, @ref NRF_CRYPTO_ECDH_BACKEND, @ref NRF_CRYPTO_ECDSA_BACKEND
+ *           and @ref NRF_CRYPTO_AES_BACKEND. Only the selected backends must be linked in. A group
+ *           set to @ref NRF_CRYPTO_BACKEND_NONE has no dependencies, and its functions return
+ *           NRF_ERROR_NOT_SUPPORTED.
+ *
+ *           All functions are blocking. ECDH keys are little endian, as used by BLE LESC and
+ *           @ref ecc. ECDSA keys, hashes and signatures are big endian, as in the DFU init packet.
+ */
+
+#ifndef NRF_CRYPTO_H__
+#define NRF_CRYPTO_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sdk_errors.h"
+#include "nrf_drv_config.h"
+
+#define NRF_CRYPTO_BACKEND_NONE         0   /**< The algorithms are not available. */
+#define NRF_CRYPTO_BACKEND_SDK          1   /**< Software implementation of the SDK: @ref sha256. */
+#define NRF_CRYPTO_BACKEND_MICRO_ECC    2   /**< micro-ecc, through @ref ecc. */
+#define NRF_CRYPTO_BACKEND_NRF_SEC      3   /**< nRF Security library of the bootloader, through SVC calls. Supports only @ref nrf_crypto_ecdsa_p256_sha256_verify. */
+#define NRF_CRYPTO_BACKEND_NRF_ECB      4   /**< AES ECB peripheral, through @ref nrf_drv_aes. */
+
+#ifndef NRF_CRYPTO_HASH_BACKEND
+#define NRF_CRYPTO_HASH_BACKEND     NRF_CRYPTO_BACKEND_SDK          /**< Backend of SHA-256: NONE or SDK. */
+#endif
+
+#ifndef NRF_CRYPTO_ECDH_BACKEND
+#define NRF_CRYPTO_ECDH_BACKEND     NRF_CRYPTO_BACKEND_MICRO_ECC    /**< Backend of P-256 key generation and ECDH: NONE or MICRO_ECC. */
+#endif
+
+#ifndef NRF_CRYPTO_ECDSA_BACKEND
+#define NRF_CRYPTO_ECDSA_BACKEND    NRF_CRYPTO_BACKEND_MICRO_ECC    /**< Backend of P-256 ECDSA verification: NONE, MICRO_ECC (requires the SDK hash backend) or NRF_SEC. */
+#endif
+
+#ifndef NRF_CRYPTO_AES_BACKEND
+#if AES_ENABLED
+#define NRF_CRYPTO_AES_BACKEND      NRF_CRYPTO_BACKEND_NRF_ECB      /**< Backend of AES-128 CTR, CCM and CMAC: NONE or NRF_ECB. Defaults to NRF_ECB if the AES driver is enabled in nrf_drv_config.h. */
+#else
+#define NRF_CRYPTO_AES_BACKEND      NRF_CRYPTO_BACKEND_NONE
+#endif
+#endif
+
+#define NRF_CRYPTO_SHA256_DIGEST_LEN    32  /**< Length of a SHA-256 digest, in bytes. */
+#define NRF_CRYPTO_P256_SK_LEN          32  /**< Length of a P-256 private key, in bytes. */
+#define NRF_CRYPTO_P256_PK_LEN          64  /**< Length of a P-256 public key (x followed by y), in bytes. */
+#define NRF_CRYPTO_P256_SS_LEN          32  /**< Length of a P-256 ECDH shared secret, in bytes. */
+#define NRF_CRYPTO_P256_SIG_LEN         64  /**< Length of a P-256 ECDSA signature (r followed by s), in bytes. */
+#define NRF_CRYPTO_AES_KEY_LEN          16  /**< Length of an AES-128 key and of an AES block, in bytes. */
+
+#if (NRF_CRYPTO_HASH_BACKEND == NRF_CRYPTO_BACKEND_SDK)
+#include "sha256.h"
+
+typedef sha256_context_t nrf_crypto_sha256_context_t;   /**< State of a SHA-256 operation. */
+#else
+/**@brief State of a SHA-256 operation. Unused without a hash backend. */
+typedef struct
+{
+    uint8_t unused;
+} nrf_crypto_sha256_context_t;
+#endif
+
+/**@brief Parameters of an AES-CCM operation, see @ref nrf_crypto_aes_ccm_encrypt. */
+typedef struct
+{
+    uint8_t const * p_key;          /**< Pointer to the 16-byte key. */
+    uint8_t const * p_nonce;        /**< Pointer to the nonce. */
+    uint8_t         nonce_len;      /**< Length of the nonce, 7 to 13 bytes. */
+    uint8_t         mic_len;        /**< Length of the MIC, an even number from 4 to 16. */
+    uint8_t const * p_adata;        /**< Pointer to the additional authenticated data. Can be NULL if adata_len is 0. */
+    uint32_t        adata_len;      /**< Length of the additional authenticated data. */
+} nrf_crypto_aes_ccm_params_t;
+
+
+/**@brief Function for initializing the selected backends.
+ *
+ * @details Sets up @ref ecc for the ECDH and ECDSA backends, which then need @ref nrf_drv_rng to
+ *          be initialized before keys are generated. Initializes @ref nrf_drv_aes in blocking mode
+ *          for the AES backend, unless the application has initialized it already, in which case
+ *          it must be in blocking mode.
+ *
+ * @retval NRF_SUCCESS                       The backends were initialized.
+ * @retval NRF_ERROR_SOFTDEVICE_NOT_ENABLED  The SoftDevice is present, but not enabled.
+ */
+ret_code_t nrf_crypto_init(void);
+
+/**@brief Function for starting a SHA-256 hash.
+ *
+ * @param[out] p_ctx  Context to initialize.
+ *
+ * @retval NRF_SUCCESS              The context was initialized.
+ * @retval NRF_ERROR_NULL           NULL pointer provided.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No hash backend is selected.
+ */
+ret_code_t nrf_crypto_sha256_init(nrf_crypto_sha256_context_t * p_ctx);
+
+/**@brief Function for adding data to a SHA-256 hash.
+ *
+ * @param[in,out] p_ctx   Context, from @ref nrf_crypto_sha256_init.
+ * @param[in]     p_data  Data to hash.
+ * @param[in]     len     Length of the data, in bytes.
+ *
+ * @retval NRF_SUCCESS              The data was added.
+ * @retval NRF_ERROR_NULL           NULL pointer provided.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No hash backend is selected.
+ */
+ret_code_t nrf_crypto_sha256_update(nrf_crypto_sha256_context_t * p_ctx,
+                                    uint8_t const               * p_data,
+                                    uint32_t                      len);
+
+/**@brief Function for completing a SHA-256 hash.
+ *
+ * @param[in,out] p_ctx     Context.
+ * @param[out]    p_digest  Digest, @ref NRF_CRYPTO_SHA256_DIGEST_LEN bytes, big endian.
+ *
+ * @retval NRF_SUCCESS              The digest was written.
+ * @retval NRF_ERROR_NULL           NULL pointer provided.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No hash backend is selected.
+ */
+ret_code_t nrf_crypto_sha256_final(nrf_crypto_sha256_context_t * p_ctx, uint8_t * p_digest);
+
+/**@brief Function for computing the SHA-256 digest of data in one call.
+ *
+ * @param[in]  p_data    Data to hash.
+ * @param[in]  len       Length of the data, in bytes.
+ * @param[out] p_digest  Digest, @ref NRF_CRYPTO_SHA256_DIGEST_LEN bytes, big endian.
+ *
+ * @retval NRF_SUCCESS              The digest was written.
+ * @retval NRF_ERROR_NULL           NULL pointer provided.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No hash backend is selected.
+ */
+ret_code_t nrf_crypto_sha256_compute(uint8_t const * p_data, uint32_t len, uint8_t * p_digest);
+
+/**@brief Function for generating a P-256 key pair.
+ *
+ * @param[out] p_le_sk  Private key. Pointer must be aligned to a 4-byte boundary.
+ * @param[out] p_le_pk  Public key. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval NRF_SUCCESS              The key pair was generated.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No ECDH backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref ecc_p256_keypair_gen.
+ */
+ret_code_t nrf_crypto_ecdh_p256_keypair_gen(uint8_t * p_le_sk, uint8_t * p_le_pk);
+
+/**@brief Function for computing the P-256 public key of a private key.
+ *
+ * @param[in]  p_le_sk  Private key. Pointer must be aligned to a 4-byte boundary.
+ * @param[out] p_le_pk  Public key. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval NRF_SUCCESS              The public key was computed.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No ECDH backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref ecc_p256_public_key_compute.
+ */
+ret_code_t nrf_crypto_ecdh_p256_public_key_compute(uint8_t const * p_le_sk, uint8_t * p_le_pk);
+
+/**@brief Function for computing a P-256 ECDH shared secret.
+ *
+ * @param[in]  p_le_sk  Own private key. Pointer must be aligned to a 4-byte boundary.
+ * @param[in]  p_le_pk  Public key of the peer. Pointer must be aligned to a 4-byte boundary.
+ * @param[out] p_le_ss  Shared secret. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval NRF_SUCCESS              The shared secret was computed.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No ECDH backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref ecc_p256_shared_secret_compute.
+ */
+ret_code_t nrf_crypto_ecdh_p256_shared_secret_compute(uint8_t const * p_le_sk,
+                                                      uint8_t const * p_le_pk,
+                                                      uint8_t       * p_le_ss);
+
+/**@brief Function for verifying a P-256 ECDSA signature of a SHA-256 digest.
+ *
+ * @param[in] p_pk      Public key of the signer.
+ * @param[in] p_digest  SHA-256 digest of the signed data.
+ * @param[in] p_sig     Signature.
+ *
+ * @retval NRF_SUCCESS              The signature is valid.
+ * @retval NRF_ERROR_NULL           NULL pointer provided.
+ * @retval NRF_ERROR_INVALID_DATA   The signature is not valid.
+ * @retval NRF_ERROR_NOT_SUPPORTED  The ECDSA backend does not verify digests.
+ */
+ret_code_t nrf_crypto_ecdsa_p256_verify(uint8_t const * p_pk,
+                                        uint8_t const * p_digest,
+                                        uint8_t const * p_sig);
+
+/**@brief Function for verifying a P-256 ECDSA signature of data, hashed with SHA-256.
+ *
+ * @param[in] p_pk    Public key of the signer.
+ * @param[in] p_data  Signed data.
+ * @param[in] len     Length of the data, in bytes.
+ * @param[in] p_sig   Signature.
+ *
+ * @retval NRF_SUCCESS              The signature is valid.
+ * @retval NRF_ERROR_NULL           NULL pointer provided.
+ * @retval NRF_ERROR_INVALID_DATA   The signature is not valid.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No ECDSA backend is selected.
+ */
+ret_code_t nrf_crypto_ecdsa_p256_sha256_verify(uint8_t const * p_pk,
+                                               uint8_t const * p_data,
+                                               uint32_t        len,
+                                               uint8_t const * p_sig);
+
+/**@brief Function for encrypting or decrypting data with AES-128 in CTR mode.
+ *
+ * @param[in]     p_key      Key.
+ * @param[in,out] p_counter  Initial counter block. Holds the next counter block on return.
+ * @param[in]     p_in       Data.
+ * @param[out]    p_out      Result. Can be the same as p_in.
+ * @param[in]     len        Length of the data, in bytes.
+ *
+ * @retval NRF_SUCCESS              The data was processed.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No AES backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref nrf_drv_aes_ctr_crypt.
+ */
+ret_code_t nrf_crypto_aes_ctr_crypt(uint8_t const * p_key,
+                                    uint8_t       * p_counter,
+                                    uint8_t const * p_in,
+                                    uint8_t       * p_out,
+                                    uint32_t        len);
+
+/**@brief Function for encrypting and authenticating data with AES-128 in CCM mode.
+ *
+ * @param[in]  p_params  Parameters.
+ * @param[in]  p_in      Data.
+ * @param[out] p_out     Encrypted data. Can be the same as p_in.
+ * @param[in]  len       Length of the data, in bytes.
+ * @param[out] p_mic     MIC, p_params->mic_len bytes.
+ *
+ * @retval NRF_SUCCESS              The data was encrypted.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No AES backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref nrf_drv_aes_ccm_encrypt.
+ */
+ret_code_t nrf_crypto_aes_ccm_encrypt(nrf_crypto_aes_ccm_params_t const * p_params,
+                                      uint8_t const                     * p_in,
+                                      uint8_t                           * p_out,
+                                      uint32_t                            len,
+                                      uint8_t                           * p_mic);
+
+/**@brief Function for decrypting and verifying data with AES-128 in CCM mode.
+ *
+ * @param[in]  p_params  Parameters.
+ * @param[in]  p_in      Encrypted data.
+ * @param[out] p_out     Decrypted data. Can be the same as p_in. Cleared if the MIC does not match.
+ * @param[in]  len       Length of the data, in bytes.
+ * @param[in]  p_mic     Received MIC, p_params->mic_len bytes.
+ *
+ * @retval NRF_SUCCESS              The data was decrypted and the MIC matches.
+ * @retval NRF_ERROR_INVALID_DATA   The MIC does not match.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No AES backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref nrf_drv_aes_ccm_decrypt.
+ */
+ret_code_t nrf_crypto_aes_ccm_decrypt(nrf_crypto_aes_ccm_params_t const * p_params,
+                                      uint8_t const                     * p_in,
+                                      uint8_t                           * p_out,
+                                      uint32_t                            len,
+                                      uint8_t const                     * p_mic);
+
+/**@brief Function for computing the AES-128 CMAC of data.
+ *
+ * @param[in]  p_key   Key.
+ * @param[in]  p_in    Data.
+ * @param[in]  len     Length of the data, in bytes.
+ * @param[out] p_mac   MAC, @ref NRF_CRYPTO_AES_KEY_LEN bytes.
+ *
+ * @retval NRF_SUCCESS              The MAC was computed.
+ * @retval NRF_ERROR_NOT_SUPPORTED  No AES backend is selected.
+ * @return Otherwise, the error returned by the backend, see @ref nrf_drv_aes_cmac.
+ */
+ret_code_t nrf_crypto_aes_cmac(uint8_t const * p_key,
+                               uint8_t const * p_in,
+                               uint32_t        len,
+                               uint8_t       * p_mac);
+
+#endif // NRF_CRYPTO_H__
+
+/** @} */
@@ -24,7 +24,31 @@
 #include "nrf_drv_rng.h"
 #include "ecc.h"
 
+#ifndef uECC_ENABLE_VLI_API
+#define uECC_ENABLE_VLI_API 1
+#endif
 #include "uECC.h"
+#include "uECC_vli.h"
+
+#define ECC_WORDS       8               /**< Words in a P-256 coordinate or scalar. */
+#define ECC_COMB_WORDS  ECC_WORDS
+
+#if ECC_P256_COMB_TEETH > 0
+#include "ecc_comb_table.h"
+
+#define ECC_COMB_BITS   (ECC_P256_COMB_TEETH * ECC_COMB_COLUMNS) /**< Bits of the recoded scalar, at least 256. */
+#endif
+
+STATIC_ASSERT(sizeof(uECC_word_t) == sizeof(uint32_t));
+
+/**@brief Types of incremental operations, see @ref ecc_p256_op_t. */
+typedef enum
+{
+    OP_IDLE,                            /**< No operation in progress. */
+    OP_LADDER_PK,                       /**< Public key (x and y) with the ladder. */
+    OP_LADDER_SS,                       /**< Shared secret (x) with the ladder. */
+    OP_COMB_PK,                         /**< Public key (x and y) with the fixed-base comb. */
+} op_type_t;
 
 
 static int ecc_rng(uint8_t *dest, unsigned size)
@@ -41,10 +65,352 @@ void ecc_init(void)
     uECC_set_rng(ecc_rng);
 }
 
-ret_code_t ecc_p256_keypair_gen(uint8_t *p_le_sk, uint8_t *p_le_pk)
+
+/* The point arithmetic below follows micro-ecc: Jacobian coordinates on a = -3 and, for the
+ * ladder, co-Z additions. It is done here so that a scalar multiplication can be split into
+ * steps. */
+
+/* (x, y) -> (x * z^2, y * z^3). */
+static void apply_z(uECC_word_t * x, uECC_word_t * y, uECC_word_t const * z, uECC_Curve curve)
 {
-    const struct uECC_Curve_t * p_curve;
+    uECC_word_t t1[ECC_WORDS];
+
+    uECC_vli_modSquare_fast(t1, z, curve);
+    uECC_vli_modMult_fast(x, x, t1, curve);
+    uECC_vli_modMult_fast(t1, t1, z, curve);
+    uECC_vli_modMult_fast(y, y, t1, curve);
+}
+
+
+/* (x, y, z) -> 2 * (x, y, z), in place. */
+static void double_jacobian(uECC_word_t * x, uECC_word_t * y, uECC_word_t * z, uECC_Curve curve)
+{
+    uECC_word_t const * p = uECC_curve_p(curve);
+    uECC_word_t         t4[ECC_WORDS];
+    uECC_word_t         t5[ECC_WORDS];
+
+    if (uECC_vli_isZero(z, ECC_WORDS))
+    {
+        return;
+    }
+
+    uECC_vli_modSquare_fast(t4, y, curve);          // t4 = y^2
+    uECC_vli_modMult_fast(t5, x, t4, curve);        // t5 = x * y^2 = A
+    uECC_vli_modSquare_fast(t4, t4, curve);         // t4 = y^4
+    uECC_vli_modMult_fast(y, y, z, curve);          // y  = y * z = z3
+    uECC_vli_modSquare_fast(z, z, curve);           // z  = z^2
+
+    uECC_vli_modAdd(x, x, z, p, ECC_WORDS);         // x  = x + z^2
+    uECC_vli_modAdd(z, z, z, p, ECC_WORDS);         // z  = 2 * z^2
+    uECC_vli_modSub(z, x, z, p, ECC_WORDS);         // z  = x - z^2
+    uECC_vli_modMult_fast(x, x, z, curve);          // x  = x^2 - z^4
+
+    uECC_vli_modAdd(z, x, x, p, ECC_WORDS);         // z  = 2 * (x^2 - z^4)
+    uECC_vli_modAdd(x, x, z, p, ECC_WORDS);         // x  = 3 * (x^2 - z^4)
+    if (uECC_vli_testBit(x, 0))
+    {
+        uECC_word_t carry = uECC_vli_add(x, x, p, ECC_WORDS);
+        uECC_vli_rshift1(x, ECC_WORDS);
+        x[ECC_WORDS - 1] |= carry << 31;
+    }
+    else
+    {
+        uECC_vli_rshift1(x, ECC_WORDS);
+    }                                               // x  = 3/2 * (x^2 - z^4) = B
+
+    uECC_vli_modSquare_fast(z, x, curve);           // z  = B^2
+    uECC_vli_modSub(z, z, t5, p, ECC_WORDS);
+    uECC_vli_modSub(z, z, t5, p, ECC_WORDS);        // z  = B^2 - 2A = x3
+    uECC_vli_modSub(t5, t5, z, p, ECC_WORDS);       // t5 = A - x3
+    uECC_vli_modMult_fast(x, x, t5, curve);         // x  = B * (A - x3)
+    uECC_vli_modSub(t4, x, t4, p, ECC_WORDS);       // t4 = B * (A - x3) - y^4 = y3
+
+    uECC_vli_set(x, z, ECC_WORDS);
+    uECC_vli_set(z, y, ECC_WORDS);
+    uECC_vli_set(y, t4, ECC_WORDS);
+}
+
+
+/* P = (x1, y1), Q = (x2, y2) with the same z -> P' = P, Q' = P + Q, with the same new z. */
+static void xycz_add(uECC_word_t * x1,
+                     uECC_word_t * y1,
+                     uECC_word_t * x2,
+                     uECC_word_t * y2,
+                     uECC_Curve    curve)
+{
+    uECC_word_t const * p = uECC_curve_p(curve);
+    uECC_word_t         t5[ECC_WORDS];
+
+    uECC_vli_modSub(t5, x2, x1, p, ECC_WORDS);      // t5 = x2 - x1
+    uECC_vli_modSquare_fast(t5, t5, curve);         // t5 = (x2 - x1)^2 = A
+    uECC_vli_modMult_fast(x1, x1, t5, curve);       // x1 = x1 * A = B
+    uECC_vli_modMult_fast(x2, x2, t5, curve);       // x2 = x2 * A = C
+    uECC_vli_modSub(y2, y2, y1, p, ECC_WORDS);      // y2 = y2 - y1
+    uECC_vli_modSquare_fast(t5, y2, curve);         // t5 = (y2 - y1)^2 = D
+
+    uECC_vli_modSub(t5, t5, x1, p, ECC_WORDS);
+    uECC_vli_modSub(t5, t5, x2, p, ECC_WORDS);      // t5 = D - B - C = x3
+    uECC_vli_modSub(x2, x2, x1, p, ECC_WORDS);      // x2 = C - B
+    uECC_vli_modMult_fast(y1, y1, x2, curve);       // y1 = y1 * (C - B)
+    uECC_vli_modSub(x2, x1, t5, p, ECC_WORDS);      // x2 = B - x3
+    uECC_vli_modMult_fast(y2, y2, x2, curve);       // y2 = (y2 - y1) * (B - x3)
+    uECC_vli_modSub(y2, y2, y1, p, ECC_WORDS);      // y2 = y3
+
+    uECC_vli_set(x2, t5, ECC_WORDS);
+}
+
+
+/* P = (x1, y1), Q = (x2, y2) with the same z -> P' = P - Q, Q' = P + Q, with the same new z. */
+static void xycz_addc(uECC_word_t * x1,
+                      uECC_word_t * y1,
+                      uECC_word_t * x2,
+                      uECC_word_t * y2,
+                      uECC_Curve    curve)
+{
+    uECC_word_t const * p = uECC_curve_p(curve);
+    uECC_word_t         t5[ECC_WORDS];
+    uECC_word_t         t6[ECC_WORDS];
+    uECC_word_t         t7[ECC_WORDS];
+
+    uECC_vli_modSub(t5, x2, x1, p, ECC_WORDS);      // t5 = x2 - x1
+    uECC_vli_modSquare_fast(t5, t5, curve);         // t5 = (x2 - x1)^2 = A
+    uECC_vli_modMult_fast(x1, x1, t5, curve);       // x1 = x1 * A = B
+    uECC_vli_modMult_fast(x2, x2, t5, curve);       // x2 = x2 * A = C
+    uECC_vli_modAdd(t5, y2, y1, p, ECC_WORDS);      // t5 = y2 + y1
+    uECC_vli_modSub(y2, y2, y1, p, ECC_WORDS);      // y2 = y2 - y1
+
+    uECC_vli_modSub(t6, x2, x1, p, ECC_WORDS);      // t6 = C - B
+    uECC_vli_modMult_fast(y1, y1, t6, curve);       // y1 = y1 * (C - B) = E
+    uECC_vli_modAdd(t6, x1, x2, p, ECC_WORDS);      // t6 = B + C
+    uECC_vli_modSquare_fast(x2, y2, curve);         // x2 = (y2 - y1)^2 = D
+    uECC_vli_modSub(x2, x2, t6, p, ECC_WORDS);      // x2 = D - (B + C) = x3
+
+    uECC_vli_modSub(t7, x1, x2, p, ECC_WORDS);      // t7 = B - x3
+    uECC_vli_modMult_fast(y2, y2, t7, curve);       // y2 = (y2 - y1) * (B - x3)
+    uECC_vli_modSub(y2, y2, y1, p, ECC_WORDS);      // y2 = y3
+
+    uECC_vli_modSquare_fast(t7, t5, curve);         // t7 = (y2 + y1)^2 = F
+    uECC_vli_modSub(t7, t7, t6, p, ECC_WORDS);      // t7 = F - (B + C) = x3'
+    uECC_vli_modSub(t6, t7, x1, p, ECC_WORDS);      // t6 = x3' - B
+    uECC_vli_modMult_fast(t6, t6, t5, curve);       // t6 = (y2 + y1) * (x3' - B)
+    uECC_vli_modSub(y1, t6, y1, p, ECC_WORDS);      // y1 = y3'
+
+    uECC_vli_set(x1, t7, ECC_WORDS);
+}
+
+
+static ret_code_t ladder_start(ecc_p256_op_t     * p_op,
+                               uECC_word_t const * p_sk,
+                               uECC_word_t const * p_point,
+                               uECC_Curve          curve)
+{
+    uECC_word_t   k1[ECC_WORDS];
+    uECC_word_t * p_k[2] = {p_op->k, k1};
+    uECC_word_t   carry;
+
+    // As in micro-ecc, k + n or k + 2n, whichever has bit 256 set, so that the ladder always
+    // runs over the same number of bits.
+    carry = uECC_vli_add(p_op->k, p_sk, uECC_curve_n(curve), ECC_WORDS);
+    uECC_vli_add(k1, p_op->k, uECC_curve_n(curve), ECC_WORDS);
+    uECC_vli_set(p_op->k, p_k[!carry], ECC_WORDS);
+    memset(k1, 0, sizeof(k1));
+
+    // Random initial z, against side-channel attacks.
+    if (!uECC_generate_random_int(p_op->z, uECC_curve_p(curve), ECC_WORDS))
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    // R1 = 2P, R0 = P, with the same z.
+    uECC_vli_set(p_op->x[1], p_point, ECC_WORDS);
+    uECC_vli_set(p_op->y[1], p_point + ECC_WORDS, ECC_WORDS);
+    uECC_vli_set(p_op->x[0], p_point, ECC_WORDS);
+    uECC_vli_set(p_op->y[0], p_point + ECC_WORDS, ECC_WORDS);
+    apply_z(p_op->x[1], p_op->y[1], p_op->z, curve);
+    double_jacobian(p_op->x[1], p_op->y[1], p_op->z, curve);
+    apply_z(p_op->x[0], p_op->y[0], p_op->z, curve);
+
+    p_op->p_point = (uint8_t const *) p_point;
+    p_op->step    = 255;                // Bits 255 to 1, then bit 0 in ladder_finish().
+
+    return NRF_SUCCESS;
+}
+
+
+static void ladder_step(ecc_p256_op_t * p_op, uECC_Curve curve)
+{
+    uECC_word_t nb = !uECC_vli_testBit(p_op->k, p_op->step);
+
+    xycz_addc(p_op->x[1 - nb], p_op->y[1 - nb], p_op->x[nb], p_op->y[nb], curve);
+    xycz_add(p_op->x[nb], p_op->y[nb], p_op->x[1 - nb], p_op->y[1 - nb], curve);
+}
 
+
+/* Last bit, and back to affine coordinates in R0 without computing z. */
+static void ladder_finish(ecc_p256_op_t * p_op, uECC_Curve curve)
+{
+    uECC_word_t const * p_point = (uECC_word_t const *) p_op->p_point;
+    uECC_word_t         nb      = !uECC_vli_testBit(p_op->k, 0);
+    uECC_word_t       * z       = p_op->z;
+
+    xycz_addc(p_op->x[1 - nb], p_op->y[1 - nb], p_op->x[nb], p_op->y[nb], curve);
+
+    uECC_vli_modSub(z, p_op->x[1], p_op->x[0], uECC_curve_p(curve), ECC_WORDS); // x1 - x0
+    uECC_vli_modMult_fast(z, z, p_op->y[1 - nb], curve);                        // yb * (x1 - x0)
+    uECC_vli_modMult_fast(z, z, p_point, curve);                                // xP * yb * (x1 - x0)
+    uECC_vli_modInv(z, z, uECC_curve_p(curve), ECC_WORDS);
+    uECC_vli_modMult_fast(z, z, p_point + ECC_WORDS, curve);                    // yP / (xP * yb * (x1 - x0))
+    uECC_vli_modMult_fast(z, z, p_op->x[1 - nb], curve);                        // xb * yP / (xP * yb * (x1 - x0))
+
+    xycz_add(p_op->x[nb], p_op->y[nb], p_op->x[1 - nb], p_op->y[1 - nb], curve);
+    apply_z(p_op->x[0], p_op->y[0], z, curve);
+}
+
+
+#if ECC_P256_COMB_TEETH > 0
+/* y -> p - y if negate is 1, in constant time. */
+static void y_negate_if(uECC_word_t * y, uint32_t negate, uECC_Curve curve)
+{
+    uECC_word_t neg[ECC_WORDS];
+    uECC_word_t mask = 0 - (uECC_word_t) negate;
+
+    uECC_vli_sub(neg, uECC_curve_p(curve), y, ECC_WORDS);
+    for (uint32_t i = 0; i < ECC_WORDS; i++)
+    {
+        y[i] = (y[i] & ~mask) | (neg[i] & mask);
+    }
+}
+
+
+static uint32_t bit_get(uECC_word_t const * p_k, uint32_t bit)
+{
+    return (p_k[bit / 32] >> (bit % 32)) & 1;
+}
+
+
+/* (x, y) = the multiple of G for a column of the recoded scalar. Every bit of the recoded
+ * scalar stands for +1 or -1, so the column is +T[u], or -T[~u] when its top tooth is -1. */
+static void comb_column_get(uECC_word_t const * p_k,
+                            uint32_t            column,
+                            uECC_word_t       * x,
+                            uECC_word_t       * y,
+                            uECC_Curve          curve)
+{
+    uint32_t top = bit_get(p_k, column + (ECC_P256_COMB_TEETH - 1) * ECC_COMB_COLUMNS);
+    uint32_t u   = 0;
+
+    for (uint32_t tooth = 0; tooth < ECC_P256_COMB_TEETH - 1; tooth++)
+    {
+        u |= bit_get(p_k, column + tooth * ECC_COMB_COLUMNS) << tooth;
+    }
+    u ^= (top - 1) & ((1UL << (ECC_P256_COMB_TEETH - 1)) - 1);
+
+    // The table is in flash, which is read without a data cache.
+    uECC_vli_set(x, &m_comb_table[u][0], ECC_WORDS);
+    uECC_vli_set(y, &m_comb_table[u][ECC_WORDS], ECC_WORDS);
+    y_negate_if(y, 1 - top, curve);
+}
+
+
+/* (x1, y1, z1) -> (x1, y1, z1) + (x2, y2), with (x2, y2) affine. */
+static void add_mixed(uECC_word_t       * x1,
+                      uECC_word_t       * y1,
+                      uECC_word_t       * z1,
+                      uECC_word_t const * x2,
+                      uECC_word_t const * y2,
+                      uECC_Curve          curve)
+{
+    uECC_word_t const * p = uECC_curve_p(curve);
+    uECC_word_t         t1[ECC_WORDS];
+    uECC_word_t         t2[ECC_WORDS];
+    uECC_word_t         t3[ECC_WORDS];
+
+    uECC_vli_modSquare_fast(t1, z1, curve);         // t1 = z1^2
+    uECC_vli_modMult_fast(t2, t1, z1, curve);       // t2 = z1^3
+    uECC_vli_modMult_fast(t1, t1, x2, curve);       // t1 = x2 * z1^2
+    uECC_vli_modMult_fast(t2, t2, y2, curve);       // t2 = y2 * z1^3
+    uECC_vli_modSub(t1, t1, x1, p, ECC_WORDS);      // t1 = x2 * z1^2 - x1 = H
+    uECC_vli_modSub(t2, t2, y1, p, ECC_WORDS);      // t2 = y2 * z1^3 - y1 = r
+    uECC_vli_modMult_fast(z1, z1, t1, curve);       // z1 = z1 * H = z3
+    uECC_vli_modSquare_fast(t3, t1, curve);         // t3 = H^2
+    uECC_vli_modMult_fast(t1, t1, t3, curve);       // t1 = H^3
+    uECC_vli_modMult_fast(t3, t3, x1, curve);       // t3 = x1 * H^2 = V
+    uECC_vli_modMult_fast(y1, y1, t1, curve);       // y1 = y1 * H^3
+    uECC_vli_modSquare_fast(x1, t2, curve);         // x1 = r^2
+    uECC_vli_modSub(x1, x1, t1, p, ECC_WORDS);
+    uECC_vli_modSub(x1, x1, t3, p, ECC_WORDS);
+    uECC_vli_modSub(x1, x1, t3, p, ECC_WORDS);      // x1 = r^2 - H^3 - 2V = x3
+    uECC_vli_modSub(t3, t3, x1, p, ECC_WORDS);      // t3 = V - x3
+    uECC_vli_modMult_fast(t3, t3, t2, curve);       // t3 = r * (V - x3)
+    uECC_vli_modSub(y1, t3, y1, p, ECC_WORDS);      // y1 = r * (V - x3) - y1 * H^3 = y3
+}
+
+
+static ret_code_t comb_start(ecc_p256_op_t * p_op, uECC_word_t const * p_sk, uECC_Curve curve)
+{
+    uECC_word_t         neg_k[ECC_WORDS];
+    uECC_word_t const * p_k[2] = {p_sk, neg_k};
+    uECC_word_t         ones[ECC_WORDS + 1];
+
+    // The recoding needs an odd scalar: n - k is odd when k is even, and gives -kG.
+    uECC_vli_sub(neg_k, uECC_curve_n(curve), p_sk, ECC_WORDS);
+    p_op->k_negated = !bit_get(p_sk, 0);
+    uECC_vli_set(p_op->k, p_k[p_op->k_negated], ECC_WORDS);
+    p_op->k[ECC_WORDS] = 0;
+    memset(neg_k, 0, sizeof(neg_k));
+
+    // k' = (k + 2^ECC_COMB_BITS - 1) / 2. Then k = sum of (2 * bit i of k' - 1) * 2^i.
+    for (uint32_t i = 0; i < ECC_WORDS + 1; i++)
+    {
+        ones[i] = (ECC_COMB_BITS >= 32 * (i + 1)) ? 0xFFFFFFFF :
+                  (ECC_COMB_BITS > 32 * i)        ? (1UL << (ECC_COMB_BITS - 32 * i)) - 1 : 0;
+    }
+    uECC_vli_add(p_op->k, p_op->k, ones, ECC_WORDS + 1);
+    uECC_vli_rshift1(p_op->k, ECC_WORDS + 1);
+
+    // Start from the top column, with a random z.
+    if (!uECC_generate_random_int(p_op->z, uECC_curve_p(curve), ECC_WORDS))
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+    comb_column_get(p_op->k, ECC_COMB_COLUMNS - 1, p_op->x[0], p_op->y[0], curve);
+    apply_z(p_op->x[0], p_op->y[0], p_op->z, curve);
+
+    p_op->step = ECC_COMB_COLUMNS - 1;   // Columns ECC_COMB_COLUMNS - 2 to 0, then comb_finish().
+
+    return NRF_SUCCESS;
+}
+
+
+static void comb_step(ecc_p256_op_t * p_op, uECC_Curve curve)
+{
+    comb_column_get(p_op->k, p_op->step - 1, p_op->x[1], p_op->y[1], curve);
+
+    double_jacobian(p_op->x[0], p_op->y[0], p_op->z, curve);
+    add_mixed(p_op->x[0], p_op->y[0], p_op->z, p_op->x[1], p_op->y[1], curve);
+}
+
+
+/* Back to affine coordinates in R0. */
+static void comb_finish(ecc_p256_op_t * p_op, uECC_Curve curve)
+{
+    uECC_vli_modInv(p_op->z, p_op->z, uECC_curve_p(curve), ECC_WORDS);
+    apply_z(p_op->x[0], p_op->y[0], p_op->z, curve);
+    y_negate_if(p_op->y[0], p_op->k_negated, curve);
+}
+
+
+/* Run an operation without a step limit, for the blocking functions. */
+static ret_code_t op_complete(ecc_p256_op_t * p_op)
+{
+    bool done;
+
+    return ecc_p256_op_run(p_op, UINT32_MAX, &done);
+}
+#endif // ECC_P256_COMB_TEETH > 0
+
+ret_code_t ecc_p256_keypair_gen(uint8_t *p_le_sk, uint8_t *p_le_pk)
+{
     if(!p_le_sk || !p_le_pk)
     {
         return NRF_ERROR_NULL;
@@ -55,7 +421,18 @@ ret_code_t ecc_p256_keypair_gen(uint8_t *p_le_sk, uint8_t *p_le_pk)
         return NRF_ERROR_INVALID_ADDR;
     }
 
-    p_curve = uECC_secp256r1();
+#if ECC_P256_COMB_TEETH > 0
+    ecc_p256_op_t op;
+
+    ret_code_t err_code = ecc_p256_keypair_gen_start(&op, p_le_sk, p_le_pk);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    return op_complete(&op);
+#else
+    const struct uECC_Curve_t * p_curve = uECC_secp256r1();
 
     int ret = uECC_make_key((uint8_t *) p_le_pk, (uint8_t *) p_le_sk, p_curve);
     if(!ret)
@@ -64,12 +441,11 @@ ret_code_t ecc_p256_keypair_gen(uint8_t *p_le_sk, uint8_t *p_le_pk)
     }
 
     return NRF_SUCCESS;
+#endif
 }
 
 ret_code_t ecc_p256_public_key_compute(uint8_t const *p_le_sk, uint8_t *p_le_pk)
 {
-    const struct uECC_Curve_t * p_curve;
-
     if(!p_le_sk || !p_le_pk)
     {
         return NRF_ERROR_NULL;
@@ -80,7 +456,18 @@ ret_code_t ecc_p256_public_key_compute(uint8_t const *p_le_sk, uint8_t *p_le_pk)
         return NRF_ERROR_INVALID_ADDR;
     }
 
-    p_curve = uECC_secp256r1();
+#if ECC_P256_COMB_TEETH > 0
+    ecc_p256_op_t op;
+
+    ret_code_t err_code = ecc_p256_public_key_compute_start(&op, p_le_sk, p_le_pk);
+    if (err_code != NRF_SUCCESS)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    return op_complete(&op);
+#else
+    const struct uECC_Curve_t * p_curve = uECC_secp256r1();
     
     NRF_LOG_PRINTF("uECC_compute_public_key\n");
     int ret = uECC_compute_public_key((uint8_t *) p_le_sk, (uint8_t *) p_le_pk, p_curve);
@@ -91,6 +478,7 @@ ret_code_t ecc_p256_public_key_compute(uint8_t const *p_le_sk, uint8_t *p_le_pk)
     
     NRF_LOG_PRINTF("uECC_compute_public_key complete: %d\n", ret);
     return NRF_SUCCESS;
+#endif
 }
 
 ret_code_t ecc_p256_shared_secret_compute(uint8_t const *p_le_sk, uint8_t const *p_le_pk, uint8_t *p_le_ss)
@@ -120,4 +508,198 @@ ret_code_t ecc_p256_shared_secret_compute(uint8_t const *p_le_sk, uint8_t const
     return NRF_SUCCESS;    
 }
 
+ret_code_t ecc_p256_signature_verify(uint8_t const * p_le_pk, uint8_t const * p_le_hash, uint8_t const * p_le_sig)
+{
+    if(!p_le_pk || !p_le_hash || !p_le_sig)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if(!is_word_aligned(p_le_pk) || !is_word_aligned(p_le_sig))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
 
+    if(!uECC_verify(p_le_pk, p_le_hash, ECC_P256_HASH_LEN, p_le_sig, uECC_secp256r1()))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ecc_p256_keypair_gen_start(ecc_p256_op_t * p_op, uint8_t * p_le_sk, uint8_t * p_le_pk)
+{
+    if(!p_op || !p_le_sk || !p_le_pk)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if(!is_word_aligned(p_le_sk) || !is_word_aligned(p_le_pk))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    // A private key in [1, n-1].
+    if (!uECC_generate_random_int((uECC_word_t *) p_le_sk, uECC_curve_n(uECC_secp256r1()), ECC_WORDS))
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    ret_code_t err_code = ecc_p256_public_key_compute_start(p_op, p_le_sk, p_le_pk);
+    if (err_code != NRF_SUCCESS)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ecc_p256_public_key_compute_start(ecc_p256_op_t * p_op, uint8_t const * p_le_sk, uint8_t * p_le_pk)
+{
+    uECC_Curve          curve = uECC_secp256r1();
+    uECC_word_t const * p_sk  = (uECC_word_t const *) p_le_sk;
+    ret_code_t          err_code;
+
+    if(!p_op || !p_le_sk || !p_le_pk)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if(!is_word_aligned(p_le_sk) || !is_word_aligned(p_le_pk))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    if (uECC_vli_isZero(p_sk, ECC_WORDS) || (uECC_vli_cmp(uECC_curve_n(curve), p_sk, ECC_WORDS) != 1))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    memset(p_op, 0, sizeof(ecc_p256_op_t));
+#if ECC_P256_COMB_TEETH > 0
+    p_op->type = OP_COMB_PK;
+    err_code   = comb_start(p_op, p_sk, curve);
+#else
+    p_op->type = OP_LADDER_PK;
+    err_code   = ladder_start(p_op, p_sk, uECC_curve_G(curve), curve);
+#endif
+    if (err_code != NRF_SUCCESS)
+    {
+        memset(p_op, 0, sizeof(ecc_p256_op_t));
+        return err_code;
+    }
+
+    p_op->p_result = p_le_pk;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ecc_p256_shared_secret_compute_start(ecc_p256_op_t * p_op,
+                                                uint8_t const * p_le_sk,
+                                                uint8_t const * p_le_pk,
+                                                uint8_t       * p_le_ss)
+{
+    uECC_Curve curve = uECC_secp256r1();
+    ret_code_t err_code;
+
+    if(!p_op || !p_le_sk || !p_le_pk || !p_le_ss)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if(!is_word_aligned(p_le_sk) || !is_word_aligned(p_le_pk) || !is_word_aligned(p_le_ss))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    if (!uECC_valid_public_key(p_le_pk, curve))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    memset(p_op, 0, sizeof(ecc_p256_op_t));
+    p_op->type = OP_LADDER_SS;
+    err_code   = ladder_start(p_op, (uECC_word_t const *) p_le_sk, (uECC_word_t const *) p_le_pk, curve);
+    if (err_code != NRF_SUCCESS)
+    {
+        memset(p_op, 0, sizeof(ecc_p256_op_t));
+        return err_code;
+    }
+
+    p_op->p_result = p_le_ss;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ecc_p256_op_run(ecc_p256_op_t * p_op, uint32_t steps, bool * p_done)
+{
+    uECC_Curve    curve = uECC_secp256r1();
+    uECC_word_t * p_result;
+    ret_code_t    err_code;
+
+    if(!p_op || !p_done)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_op->type == OP_IDLE)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    *p_done = false;
+
+    for (; (steps > 0) && (p_op->step > 0); steps--)
+    {
+#if ECC_P256_COMB_TEETH > 0
+        if (p_op->type == OP_COMB_PK)
+        {
+            comb_step(p_op, curve);
+        }
+        else
+#endif
+        {
+            ladder_step(p_op, curve);
+        }
+        p_op->step--;
+    }
+
+    if (steps == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+#if ECC_P256_COMB_TEETH > 0
+    if (p_op->type == OP_COMB_PK)
+    {
+        comb_finish(p_op, curve);
+    }
+    else
+#endif
+    {
+        ladder_finish(p_op, curve);
+    }
+
+    err_code = NRF_SUCCESS;
+    if (uECC_vli_isZero(p_op->x[0], ECC_WORDS) && uECC_vli_isZero(p_op->y[0], ECC_WORDS))
+    {
+        err_code = NRF_ERROR_INTERNAL;
+    }
+    else
+    {
+        p_result = (uECC_word_t *) p_op->p_result;
+        uECC_vli_set(p_result, p_op->x[0], ECC_WORDS);
+        if (p_op->type != OP_LADDER_SS)
+        {
+            uECC_vli_set(p_result + ECC_WORDS, p_op->y[0], ECC_WORDS);
+        }
+    }
+
+    memset(p_op, 0, sizeof(ecc_p256_op_t));
+    *p_done = true;
+
+    return err_code;
+}
@@ -12,12 +12,42 @@
  *
  */
 
+#ifndef ECC_H__
+#define ECC_H__
+
 #include <stdint.h>
+#include <stdbool.h>
 #include "nordic_common.h"
 #include "nrf_error.h"
+#include "sdk_errors.h"
 
 #define ECC_P256_SK_LEN 32
 #define ECC_P256_PK_LEN 64
+#define ECC_P256_SS_LEN 32
+#define ECC_P256_HASH_LEN 32
+#define ECC_P256_SIG_LEN 64
+
+#ifndef ECC_P256_COMB_TEETH
+#define ECC_P256_COMB_TEETH 0   /**< Teeth of the fixed-base comb used for key generation and public key computation, 4 to 8, or 0 to use the ladder. The comb table takes 2^(teeth - 1) * 64 bytes of flash and an operation takes ceil(256 / teeth) steps instead of 256. */
+#endif
+
+/**@brief State of an incremental P-256 operation.
+ *
+ * @details The contents are internal to the module. The structure holds intermediate values
+ *          derived from the private key and is cleared when the operation completes.
+ */
+typedef struct
+{
+    uint32_t        x[2][8];
+    uint32_t        y[2][8];
+    uint32_t        z[8];
+    uint32_t        k[9];
+    uint8_t const * p_point;
+    uint8_t       * p_result;
+    uint16_t        step;
+    uint8_t         type;
+    bool            k_negated;
+} ecc_p256_op_t;
 
 /**@brief Initialize the ECC module. */
 void ecc_init(void);
@@ -59,3 +89,92 @@ ret_code_t ecc_p256_public_key_compute(uint8_t const *p_le_sk, uint8_t* p_le_pk)
  */
 ret_code_t ecc_p256_shared_secret_compute(uint8_t const *p_le_sk, uint8_t const * p_le_pk, uint8_t *p_le_ss);
 
+/**@brief Verify an ECDSA signature.
+ *
+ * @details All values are little endian, like the keys: the hash is the digest byte reversed, and
+ *          the signature is r followed by s, each byte reversed.
+ *
+ * @param[in]   p_le_pk     Public key of the signer. Pointer must be aligned to a 4-byte boundary.
+ * @param[in]   p_le_hash   Hash of the signed data, @ref ECC_P256_HASH_LEN bytes.
+ * @param[in]   p_le_sig    Signature, @ref ECC_P256_SIG_LEN bytes. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval     NRF_SUCCESS              The signature is valid.
+ * @retval     NRF_ERROR_NULL           NULL pointer provided.
+ * @retval     NRF_ERROR_INVALID_ADDR   Unaligned pointer provided.
+ * @retval     NRF_ERROR_INVALID_DATA   The signature is not valid.
+ */
+ret_code_t ecc_p256_signature_verify(uint8_t const * p_le_pk, uint8_t const * p_le_hash, uint8_t const * p_le_sig);
+
+/**@brief Start creating a public/private key pair incrementally.
+ *
+ * @details The private key is generated before returning. The public key is computed by
+ *          @ref ecc_p256_op_run. The buffers must stay valid until the operation has completed.
+ *
+ * @param[out]  p_op      Operation state.
+ * @param[out]  p_le_sk   Private key. Pointer must be aligned to a 4-byte boundary.
+ * @param[out]  p_le_pk   Public key. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval     NRF_SUCCESS              Operation started.
+ * @retval     NRF_ERROR_NULL           NULL pointer provided.
+ * @retval     NRF_ERROR_INVALID_ADDR   Unaligned pointer provided.
+ * @retval     NRF_ERROR_INTERNAL       Internal error during key generation.
+ */
+ret_code_t ecc_p256_keypair_gen_start(ecc_p256_op_t * p_op, uint8_t * p_le_sk, uint8_t * p_le_pk);
+
+/**@brief Start creating a public key from a provided private key incrementally.
+ *
+ * @details The buffers must stay valid until the operation has completed.
+ *
+ * @param[out]  p_op      Operation state.
+ * @param[in]   p_le_sk   Private key. Pointer must be aligned to a 4-byte boundary.
+ * @param[out]  p_le_pk   Public key. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval     NRF_SUCCESS              Operation started.
+ * @retval     NRF_ERROR_NULL           NULL pointer provided.
+ * @retval     NRF_ERROR_INVALID_ADDR   Unaligned pointer provided.
+ * @retval     NRF_ERROR_INVALID_DATA   The private key is not in the range [1, n-1].
+ * @retval     NRF_ERROR_INTERNAL       Internal error during key generation.
+ */
+ret_code_t ecc_p256_public_key_compute_start(ecc_p256_op_t * p_op, uint8_t const * p_le_sk, uint8_t * p_le_pk);
+
+/**@brief Start creating a shared secret from a provided public/private key pair incrementally.
+ *
+ * @details The operation always uses the ladder, as the point is not fixed. The buffers must
+ *          stay valid until the operation has completed.
+ *
+ * @param[out]  p_op      Operation state.
+ * @param[in]   p_le_sk   Private key. Pointer must be aligned to a 4-byte boundary.
+ * @param[in]   p_le_pk   Public key. Pointer must be aligned to a 4-byte boundary.
+ * @param[out]  p_le_ss   Shared secret. Pointer must be aligned to a 4-byte boundary.
+ *
+ * @retval     NRF_SUCCESS              Operation started.
+ * @retval     NRF_ERROR_NULL           NULL pointer provided.
+ * @retval     NRF_ERROR_INVALID_ADDR   Unaligned pointer provided.
+ * @retval     NRF_ERROR_INVALID_DATA   The public key is not a point on the curve.
+ * @retval     NRF_ERROR_INTERNAL       Internal error during key generation.
+ */
+ret_code_t ecc_p256_shared_secret_compute_start(ecc_p256_op_t * p_op,
+                                                uint8_t const * p_le_sk,
+                                                uint8_t const * p_le_pk,
+                                                uint8_t       * p_le_ss);
+
+/**@brief Run an incremental operation for a number of steps.
+ *
+ * @details A step processes one bit of the private key with the ladder, or one column with the
+ *          comb, and costs about one point doubling and one point addition; the last step also
+ *          includes a field inversion. The ladder takes 256 steps. Call this function, for example
+ *          from the scheduler, until the operation is done.
+ *
+ * @param[in,out] p_op      Operation state, from one of the start functions.
+ * @param[in]     steps     Maximum number of steps to run.
+ * @param[out]    p_done    Set to true when the operation has completed and the result was written.
+ *
+ * @retval     NRF_SUCCESS              Steps run, or operation completed.
+ * @retval     NRF_ERROR_NULL           NULL pointer provided.
+ * @retval     NRF_ERROR_INVALID_STATE  No operation in progress.
+ * @retval     NRF_ERROR_INTERNAL       The result is the point at infinity.
+ */
+ret_code_t ecc_p256_op_run(ecc_p256_op_t * p_op, uint32_t steps, bool * p_done);
+
+#endif // ECC_H__
+
@@ -0,0 +1,565 @@
+/*
+ * Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is confidential property of Nordic Semiconductor. The use,
+ * copying, transfer or disclosure of such information is prohibited except by express written
+ * agreement with Nordic Semiconductor.
+ *
+ */
+
+/**
+ * @brief Fixed-base comb tables of the P-256 generator.
+ *
+ * @details With t teeth, the scalar is split into ECC_COMB_COLUMNS = ceil(256 / t) columns and
+ *          entry u of the table holds the affine point
+ *          (2^((t-1)*ECC_COMB_COLUMNS) + sum over i < t-1 of (+/-1) * 2^(i*ECC_COMB_COLUMNS)) * G,
+ *          where the sign of term i is + if bit i of u is set. x and y are stored as native
+ *          little-endian words. Only to be included by ecc.c.
+ */
+
+#ifndef ECC_COMB_TABLE_H__
+#define ECC_COMB_TABLE_H__
+
+#include <stdint.h>
+
+#if ECC_P256_COMB_TEETH == 4
+
+#define ECC_COMB_COLUMNS 64
+
+static const uint32_t m_comb_table[8][2 * ECC_COMB_WORDS] =
+{
+    {0x023E0A99, 0x2C147BD3, 0x02D88340, 0xC7DD3079, 0x00C7462E, 0x7A941B31, 0x8411AFB5, 0xDCA74634,
+     0x235F3FB0, 0x47B0D520, 0x0060632C, 0xD170FE41, 0x8E2875B6, 0xEFA230D3, 0x3C6073E0, 0xA378F49C},
+    {0xE0B9010A, 0xF7447E16, 0xD4E6E5C5, 0x24FC081A, 0xA6C75133, 0x87F51BCF, 0x59312390, 0x47B8C15B,
+     0xD7B4B792, 0x5D8A5A16, 0xC2FAA827, 0xC8CB9D1B, 0xD61AA5C0, 0x1DE9C2EA, 0xB27BCED9, 0xEAB69CFC},
+    {0x5B370B39, 0x8DB22150, 0x0FCB47E3, 0x4FCFDE2A, 0x75A52979, 0xAFF955E9, 0xE7A90157, 0x39F2E126,
+     0x865122BA, 0xC13C7A63, 0x481DE5AC, 0x6FDAB9FB, 0x65141B26, 0x034CFC1D, 0x81BAC5C2, 0x2FE3918B},
+    {0x7699E898, 0xDBD40B53, 0xF9021BC1, 0x43726C12, 0x18355237, 0x37B09017, 0x4A1D889B, 0xB98668C6,
+     0x3A913C3D, 0xC894A732, 0x37C48F4E, 0x4EC84765, 0x5DA9F656, 0xC8DAA751, 0xA113F297, 0x04EF5FA9},
+    {0x4C02FAA6, 0x7342E89B, 0xA6C902A9, 0xACCBD9E5, 0xF51B14F0, 0x574AF433, 0xF70660CB, 0x8399D76D,
+     0xE68BA2BA, 0x74C93F9B, 0xC6875872, 0x7A47E013, 0x2016D4C8, 0x58EF27C6, 0x56ECB1CC, 0xA08F6B51},
+    {0x7DB8CAB2, 0xD14F8EAD, 0xE0103C59, 0x0BA6D2F4, 0xA43B83B7, 0x7F8ED508, 0x508FDC2E, 0x61302D5D,
+     0xB01280C1, 0xEBD1782F, 0x46B0F759, 0x70750B1D, 0x23E6DE42, 0x0410B883, 0x2CC4A029, 0x6C584E7F},
+    {0x3CE742EB, 0xE47C247D, 0x1FD9D03D, 0x45E388A8, 0xE81FF10C, 0xB414F9CE, 0xFC931410, 0x8781FBDA,
+     0x082CA20D, 0xA87B2111, 0x9713E7CA, 0xCADA9AD5, 0x0C945128, 0xBFE61EE2, 0xFA6ADA4C, 0x3EB35234},
+    {0x0D1D78E5, 0x9615B511, 0x25C4744B, 0x66B0DE32, 0x6AAF363A, 0x0A4A46FB, 0x84F7A21C, 0xB48E26B4,
+     0x21A01B2D, 0x06EBB0F6, 0x8B7B0F98, 0xC004E404, 0xFED6F668, 0x64131BCD, 0x4D4D3DAB, 0xFAC01540},
+};
+
+#elif ECC_P256_COMB_TEETH == 5
+
+#define ECC_COMB_COLUMNS 52
+
+static const uint32_t m_comb_table[16][2 * ECC_COMB_WORDS] =
+{
+    {0xC7E54BEE, 0xF95276D2, 0x3A22AAD4, 0xF88C60C8, 0x4ACDA0CB, 0xC70C60AD, 0x7FD081C5, 0x8429DFDD,
+     0x53873020, 0xB6E00949, 0x13138832, 0x26D82C6B, 0x20F9FF59, 0x8BAE071E, 0x851897E6, 0xC056E544},
+    {0xEA4B564A, 0xAA44314C, 0x2A566FC8, 0xBD569274, 0x92D81B88, 0x74A95E72, 0xDF5AD6E9, 0x2E8F84BA,
+     0x935C5DAD, 0xD3F6BBE9, 0xB15843F8, 0x411F1CCD, 0xCD482ECA, 0x45DA9165, 0x5438FBAD, 0xD44AC55D},
+    {0x1674DCAB, 0x0E645AC3, 0x36E65EB5, 0x3B086F1F, 0x7DA81DCA, 0xEB662CF0, 0x2AC9CE9F, 0x572D607B,
+     0x25DDA560, 0xDAC5F4C1, 0xE1451F4E, 0x5F6020D9, 0xDD40CE47, 0x1528EB2D, 0x1BCC9455, 0x125EB4AA},
+    {0xBCB70552, 0x41618305, 0xC3DA30BB, 0x7B6D234E, 0x250A6932, 0xBE4FA309, 0x2C06E4EA, 0xA4F9F367,
+     0xF68D981B, 0xB8EBEA26, 0x052A14AE, 0x90097CB6, 0xA5D98E06, 0x5AF9501F, 0x25C442E4, 0xF76F5348},
+    {0x338E58DA, 0xBA9314D9, 0x22BD6911, 0x89AE788C, 0x646DB607, 0x4CFB0E28, 0xCFEF2213, 0x3F0C96E6,
+     0xF3501083, 0xF966D2B0, 0xFD6657FA, 0xDE2E237A, 0x21876FC4, 0x15F3F02B, 0x92CCC35C, 0xDBFB7191},
+    {0xB258FBBA, 0x3E955641, 0xCC8EA358, 0x1065AE57, 0x643966B8, 0xD9FD0DA1, 0xDE55C5ED, 0x7918B03B,
+     0xB6870E88, 0xBC3BAEE5, 0x8E46E993, 0x543B7DD0, 0xCDDB9309, 0xFB2B863E, 0x51EA048B, 0x614AF453},
+    {0x10326611, 0x0A3E3494, 0x9B4AD9FD, 0xC5D15A99, 0x8E9E8BF3, 0x41FBA49E, 0x72B22479, 0xAF21E49C,
+     0x13A4B52A, 0xF9414962, 0x3EA1116A, 0xD143D59D, 0xCF1D4105, 0xD200D6FF, 0xFCAE536C, 0xB0110FE5},
+    {0x994A5B6E, 0xCF042714, 0x86FB8797, 0x0F091A2F, 0xF47BF8EA, 0x98465DD3, 0xC948561B, 0xD5588A0D,
+     0x9BC74903, 0xDE5B9A41, 0x42DDC496, 0x47F5CB7D, 0xC7F7A92F, 0xE9F649DA, 0xA35C551A, 0xDAA94E8F},
+    {0x9C6DE2F0, 0x0968AAA0, 0x4D6E1737, 0xA8EA7589, 0x90E7F7F9, 0x5924F7F0, 0xD86D9BC0, 0x01E0DE74,
+     0x68AF552B, 0x9B06BF92, 0x4A0A4AEF, 0x512267AD, 0x0AA44E5D, 0xDBB4CA96, 0x488B2F0A, 0xDBBD891F},
+    {0x3EF6F4C1, 0xE7DA7A30, 0x98056827, 0xA07EDEC9, 0x79C1A3AB, 0xDB3CD8F0, 0x3BD73679, 0x2B51F09A,
+     0xA45F02E8, 0x6B4BA19F, 0xDFD9FE28, 0x61A524F3, 0x09315057, 0x966B6BD4, 0x332AB912, 0xAD9CE7AB},
+    {0x8545438A, 0x0ABB926B, 0xC00157B9, 0xAE1600AB, 0xC3F5ECEC, 0xD331BCDC, 0x24373A17, 0xEB34F080,
+     0xB1EF8E14, 0x57100075, 0xCF0D91CD, 0xF02CA10A, 0xAADB792E, 0x5FE24BA3, 0xA8F93055, 0x758FE259},
+    {0x320304D1, 0x3B9E5A25, 0x8B3843D5, 0x0C0BF613, 0xDD9EBE66, 0x1AEBF43C, 0x24DA6438, 0xDAB8DDDC,
+     0x08BA5B92, 0xF6541C56, 0x48CA9837, 0x647797C6, 0x8D315EF7, 0x7650EC55, 0x9E4E370C, 0x9EB0EFBF},
+    {0x798F316D, 0x8C3D5202, 0xCAEDDB83, 0xDC8F13BF, 0xE79E07DD, 0x89616CB1, 0x96C4FF9C, 0x52788440,
+     0xA934B669, 0xA20999F6, 0x6C50A1EF, 0x80B866FE, 0xBF2DD834, 0xDED0D15B, 0xA61AE1B4, 0x4D3D5923},
+    {0x9BF174BF, 0xF317D32C, 0xBF0AB911, 0xC29520B8, 0x791551AB, 0x4F5239D9, 0x676984A9, 0x792F29F8,
+     0xA6FB036B, 0x08F267F2, 0x39B96D8B, 0x9AB2FAF2, 0xC9D4B1C1, 0x356FDD6D, 0x3B28E94A, 0xF0D8CE8B},
+    {0x2C2603D7, 0xF1B2FB60, 0xD0746191, 0x1C28A636, 0x69DDABE5, 0xAB7D9007, 0xB6323654, 0xAD7F1B10,
+     0x16BCEB7D, 0x09B9D196, 0xBE181BEA, 0x4A7765A1, 0xFDE4783F, 0x3FACBE89, 0x07BDE255, 0x127F9B5D},
+    {0x5B696527, 0x2E75A266, 0x5A00169C, 0x1A2530B0, 0x4286FB42, 0x76C4C180, 0x8E831D5B, 0x825F0194,
+     0xEF703739, 0xDBF0A11F, 0xCE5B106A, 0x106F9BC4, 0x24111150, 0x61794C4F, 0xBC723A17, 0x435872FE},
+};
+
+#elif ECC_P256_COMB_TEETH == 6
+
+#define ECC_COMB_COLUMNS 43
+
+static const uint32_t m_comb_table[32][2 * ECC_COMB_WORDS] =
+{
+    {0x79F1952D, 0x3BD04BB6, 0x118BE011, 0x767855B4, 0xB59C1AC3, 0x76FDAB0D, 0x0C4B18A4, 0x16E4ABE6,
+     0xD3A5AF5D, 0xC4716379, 0x0FB8F754, 0xC1FB5774, 0xC8C2C216, 0xFB8DB58E, 0x850675E8, 0x2CB99CFC},
+    {0x090D092A, 0xC803D606, 0x1554C3D0, 0xF25F7CBC, 0xC264423C, 0xA5D141BF, 0x634A1D28, 0xF00E4339,
+     0xCC47C9BA, 0x040F0752, 0x14DA4163, 0x899C7CBE, 0x8A559DFB, 0xA6E84F04, 0x7DB3427F, 0x5013E1E0},
+    {0x3E930576, 0x6FBD84F4, 0xB16B5A47, 0xCC67D205, 0xC651C52A, 0x34B5642E, 0x41712315, 0x79E3EB10,
+     0x09F87A59, 0x2DA56B73, 0x41597386, 0x0966C53D, 0x8FA9A873, 0x1122F091, 0x1523534A, 0xC6F8990C},
+    {0x4B2C7CB5, 0xDC52945C, 0x0604881C, 0xF3C4B3B0, 0x9A689EF4, 0x6F854B3D, 0x51FE7B8E, 0x708BB8F8,
+     0xE87C90BC, 0x1CF468FF, 0xD73C1896, 0x6B05EFD1, 0x9B53386C, 0xA7CB53B1, 0x3BCC6C4F, 0x06DA7AEE},
+    {0xCF725D71, 0x1530C239, 0x53A1CABC, 0x34E6EA55, 0x794B5572, 0xE49DA18C, 0xB29C56EF, 0x6B9B3919,
+     0x218E740A, 0x9CD28B3F, 0x5350C88D, 0x0F878D87, 0x903A14AE, 0x6455CE06, 0xC3E2DDFA, 0x87E1F0EE},
+    {0x007264FE, 0x747E9845, 0x5D7AFA38, 0x6E03D130, 0xAF7BC52D, 0x93B364AA, 0xB459F28E, 0xA18ADA01,
+     0x46B59886, 0x2465AD54, 0x768F2811, 0x47BE449A, 0x28CE1EE1, 0xAAA8ABB0, 0x8D26DBEC, 0x159A4CCC},
+    {0x0118E54B, 0xE3AC0EB9, 0x3E5760DC, 0xC84449F2, 0x09E3787C, 0xA235A261, 0xEA79377B, 0x4BAF4DF8,
+     0x787BA563, 0x8D9D8DC4, 0x49F0E8F0, 0x076B245D, 0x44DC9AE3, 0xACFE90EC, 0x908C70B9, 0x721D664A},
+    {0xC2E859FB, 0x23445D3F, 0xDAEA05AC, 0x65E56120, 0xC64D7F36, 0xF969CE2B, 0x1FFF9E25, 0x6F08B186,
+     0xAE30362F, 0xCF51E928, 0x833CDDB0, 0x1D0A0D9F, 0x05CFA50B, 0xC1E31A2F, 0x3CD3DB1A, 0xA9401BB3},
+    {0x7F82440C, 0x6D7C3FA7, 0x124F22D5, 0x5A9A32A5, 0x5D530247, 0x325408E0, 0xCA18B07D, 0xBFB342FD,
+     0x30DC8CCC, 0x9FC58F24, 0x0E7B947C, 0x0B50392D, 0x5B559968, 0xFB0C0637, 0xFB8CA3D7, 0x31975005},
+    {0x8A93CE62, 0xAEE513E1, 0x61DC37F2, 0x8D2056CA, 0xB030547A, 0xD8AEF3EF, 0xA25BD699, 0x70B6C627,
+     0x6C3392EE, 0x5FEE3D43, 0x60FFF409, 0x2ED738C9, 0x2847382D, 0xD4F92CA4, 0x04D1AD9D, 0x81AF1BA4},
+    {0xF9F48DF1, 0x82334B03, 0xDD62EA40, 0x28795FF0, 0xAF2C1F88, 0x0A385130, 0xB099BED7, 0x5E654FC5,
+     0x8A1C8B72, 0x47593AE5, 0x09FCB1B4, 0xF2B75B55, 0x576BCB6E, 0x376C2915, 0xA227182A, 0x54DBDA6E},
+    {0xE2A337E1, 0x6AFCF2A7, 0x57896E0F, 0xF5D26DD4, 0x0527B7DE, 0x0C24F4F3, 0x64B1F103, 0x3B411C8B,
+     0xC91FB8E3, 0xC960A25D, 0x6D98F164, 0x92E49934, 0x4C6BCD96, 0xDFF8533C, 0x302CABBE, 0x3E93F88E},
+    {0xFAE300DA, 0x268A5234, 0x2757E079, 0x1E96954E, 0x8A98D39A, 0x41D320B7, 0x396457E8, 0xC5F3A1C3,
+     0x2F78A0A6, 0x38EDA1F1, 0x4393B5F6, 0xD4169978, 0x5C03DF0F, 0x7EC45AB3, 0x681A2304, 0x69BA87B8},
+    {0x2C6E57CB, 0x216B0E51, 0xC6B4161A, 0x8522F4C8, 0x4E572CE8, 0xEA20BBB6, 0xD1CFCC5D, 0x01078AC1,
+     0xBED01D25, 0x5022D094, 0xD0C6FDD3, 0xF12B2E60, 0x74FA21AC, 0x78183AEC, 0xD0FB0A10, 0xEFF624C7},
+    {0x4C3B39F7, 0xF3060FEF, 0xD9E75B09, 0xB4A67537, 0x5C3ADECC, 0x37F0270C, 0x77071104, 0x451404EC,
+     0x46D65448, 0x0334154A, 0x8F4538B8, 0xE5A19B76, 0x19205542, 0x9E6CB67D, 0x6E2F229D, 0xF8D4CC82},
+    {0x375A54B7, 0x4093A8C3, 0x938D674C, 0xAC0DED40, 0x2AFAB3D5, 0x9C8B3D26, 0xFD9E966B, 0x6939A5E4,
+     0x6252EBAA, 0x8FBBB843, 0x3E04D4A7, 0x3B12335E, 0xA1F400D9, 0x87FDE95C, 0x1AC3E744, 0x0E419D29},
+    {0xD4469BF3, 0xC3AF0F38, 0xC5863618, 0x99B64DFF, 0xCF800026, 0xEE4949FC, 0xE622E0ED, 0x81B0578A,
+     0xA4D6BBAC, 0x16872A5E, 0x0CDBE1C6, 0x8526823C, 0xCF3D90AC, 0xA16CEED7, 0x1DC8E6AC, 0x2847687B},
+    {0xFADADA30, 0x0828C3E6, 0x517FA7C4, 0xD48D9981, 0x4F6A0575, 0x63EB69AD, 0xA11FB4C1, 0xE000BB7F,
+     0xD61FF297, 0xEC53F28A, 0x10E9EF5D, 0x13EA9359, 0x371A45C9, 0x7612C6DC, 0x503114F6, 0x1E2B4202},
+    {0x1A7DB624, 0xD1239E0B, 0x6910B073, 0x945D7C22, 0x502A175D, 0x20BF8225, 0x593E8AD7, 0x3E13E433,
+     0xD780F253, 0x686AB327, 0xBF816623, 0x9CDE5707, 0x96329A64, 0x503055A4, 0x91F915A2, 0x42D5DCB9},
+    {0xF1F79EF8, 0xB90D2042, 0x77F60379, 0xF951C649, 0x819F9606, 0x70288953, 0x8DE81F4A, 0x391CFD55,
+     0x2F8DA33E, 0xB2FD1E0C, 0xC18ED6B7, 0xBF171620, 0xB41CE386, 0x33FB6E66, 0xABD9C54D, 0x3BB2C5BC},
+    {0x131FC711, 0x16C90DC2, 0x2E539339, 0x6A20AD98, 0x6338A496, 0x6E689B1E, 0x21326C8B, 0xEFA51EBA,
+     0x12142137, 0x5073FE67, 0xA27C0098, 0xD5E03BCF, 0xBC79B4AD, 0x1054084B, 0x181431F4, 0xA9BB5340},
+    {0xA0285A0C, 0xA7AB395D, 0xEC00AD80, 0x12737892, 0x6A3EE90B, 0x73CAD5B5, 0xAC2EF483, 0xE80CB386,
+     0x252799F7, 0x9571A01E, 0x88F8E0CF, 0x778AD7D7, 0xD20D4E04, 0xD2A0B7FD, 0x1AF78EE9, 0x505C3B53},
+    {0xAEC193D7, 0x0E47B714, 0x50345B7A, 0x9724B530, 0x8531F855, 0xC0F727DF, 0x94D17C8F, 0x7FE2602B,
+     0xF3A67F01, 0xB59AECF0, 0xD8A94FFC, 0xF4AE3293, 0xEBA6623F, 0xA9C07D7A, 0x8C2C753C, 0x454091A6},
+    {0x37F42A75, 0xBE32211D, 0x4F9FA00F, 0x1F171B12, 0xA62EB032, 0x26815A04, 0x4B6F7157, 0x94356E3B,
+     0xAB655A27, 0x02D26F97, 0xBEFDEA00, 0x80BF3ECB, 0x9C170991, 0x48F4ACCF, 0x3C563375, 0x6298E275},
+    {0xFCBEB801, 0xCBFED9C9, 0xF2544946, 0x7AC36B60, 0xA33F021A, 0x814FCD93, 0x53A5597F, 0x7D02BFC9,
+     0xC4FD70D7, 0x26BFA782, 0x13DA5BFD, 0x5F60C039, 0x64692FF4, 0xDF14622D, 0xEAC5A27A, 0x72027379},
+    {0x3A77DC93, 0x34540DB1, 0x3F05E104, 0x0445CFAF, 0xBDE70338, 0x7AA78326, 0xA48206B5, 0xD2FF073F,
+     0x2E0F2D1D, 0xFBC5DCDC, 0xD2ECB9A0, 0x08C3484A, 0x581DC3C1, 0xAD96D0DA, 0x0F4A3C34, 0xEA970006},
+    {0x06CF3753, 0x20B42347, 0x722487F1, 0x7DD4F86B, 0x8351F08B, 0x639DAF5A, 0x398B5031, 0x9DF63780,
+     0x9CA3C491, 0x264CB81D, 0x5AE027A5, 0x81306944, 0x64D0B637, 0xBA035018, 0xE365A953, 0xCF43DF1A},
+    {0x44A01E3B, 0x5F424707, 0x98786F01, 0x597CD01B, 0x892C3F6C, 0x3B8537D3, 0x6484D513, 0x2E754EED,
+     0x83D91024, 0x4E685D49, 0x0D366D41, 0x21EA9E3A, 0x3A29C81F, 0xA91343BD, 0x2C3C6704, 0x1FF30B96},
+    {0xEF3D0CA4, 0xBF5109C9, 0xEA33D2EC, 0xD6072C6A, 0x3BFD8B59, 0xA590A5BD, 0x5CBF5B11, 0x5308051B,
+     0x32D51985, 0x7FA490A3, 0xA882071B, 0x135F6B27, 0x6094E9F4, 0xA655BCB4, 0x42723907, 0xE4A47608},
+    {0x54540E99, 0x7002DCA5, 0xB56B868C, 0xADD41F38, 0xCDBF9C05, 0x35D6F530, 0x34B96EBD, 0xFEB2ACA2,
+     0xBC22AE1B, 0xD2EFA742, 0x03A4C0EE, 0xE6D8E6D6, 0xF2C6738D, 0x0A166874, 0x6B303E85, 0xFB362C23},
+    {0x9C4025FD, 0xD22E1B90, 0x28BF4E8E, 0x601BD3CC, 0x90C9E34D, 0xD64B821A, 0x4D70BC76, 0xACB41A54,
+     0x92C11C81, 0x8F7F8A86, 0x44004CA8, 0x4843171E, 0x14B273D1, 0x86BA70E6, 0x7B2E62D5, 0x57359923},
+    {0xAFCC2BEF, 0xB9E437F4, 0x3ADA2B53, 0x4F1FB2D6, 0xBB580C9A, 0xE6C0E12D, 0x33C7546D, 0x25183734,
+     0xBFD92FB9, 0xAB12D90F, 0xA185AE46, 0x2CB9B9B3, 0x9CE6F49F, 0x2A0C7A7E, 0xB48F21F2, 0x531F307F},
+};
+
+#elif ECC_P256_COMB_TEETH == 7
+
+#define ECC_COMB_COLUMNS 37
+
+static const uint32_t m_comb_table[64][2 * ECC_COMB_WORDS] =
+{
+    {0x9712ED08, 0xE08F9F98, 0x27EB886E, 0xAD3ADDBD, 0xB42C44A2, 0x4116E1BD, 0x1846EC25, 0x82663FAD,
+     0x14CEE2ED, 0x4AC8DF08, 0x5E8D9E56, 0x82297D3E, 0xA5EFDFD2, 0x30BB54A4, 0x9311891C, 0xCE72EB44},
+    {0xAC781C9F, 0xB8BE0B11, 0xB7B557F3, 0xA6636409, 0x3A847E05, 0x6C16932E, 0x1EBD1275, 0xB6C6E496,
+     0xA6CB085C, 0x46CD50D8, 0xAB0E8F52, 0xA432D8D4, 0xA945E133, 0xD5469FC2, 0xA5D03DF1, 0x1559FA16},
+    {0xC606EEBD, 0xAE4C1DD4, 0x3B9E1A54, 0xD71CBAD6, 0xB9A24EF0, 0x3BF0B4FD, 0x5AD4091B, 0x0C077C41,
+     0xD303A79E, 0xCA0230F1, 0xA65E2340, 0xBD9FD4A4, 0xE68C7313, 0x15AEE750, 0x126CBA7C, 0xB5E9AFE2},
+    {0xBEDD7B51, 0x0676982C, 0x5675735D, 0x51A19CA3, 0x14A2F17E, 0xA85BDD24, 0x0EDDC6B7, 0xE2E5681A,
+     0x9C94D7DE, 0x0DDD825C, 0xF0B5A7A1, 0xC04E7B9C, 0x434AC126, 0xFE303EBD, 0xC454473A, 0x1EC01109},
+    {0x7402C8F9, 0xD26C3307, 0xDBDC048E, 0x4A8773AD, 0x11D5F776, 0x4E491A6F, 0x2577A8D9, 0x0A73A779,
+     0x4C69CD1F, 0x2619422B, 0xA2589ECF, 0xE05306A1, 0x3CC7C3B2, 0x58FC8853, 0x2365E8A2, 0xEBC8310F},
+    {0xF89ED708, 0xA2F59366, 0x34DCE2F3, 0x95EDA849, 0xFCF49B9B, 0xF6ABD1E6, 0x7643FF34, 0x3DFCA564,
+     0x0618A31A, 0x163AC603, 0x263EFA02, 0x802623FA, 0x24C3BE87, 0x0DBA6CF7, 0xD9F7DB18, 0x800DE081},
+    {0x4FBFDF4F, 0xAB6554DA, 0xCB2C5285, 0xCE57D8CD, 0x9AC9BE0C, 0x4DB0B62F, 0xFB5C1056, 0x864641C6,
+     0x9F9981A6, 0xC568E453, 0x5FD622AD, 0x3A56E671, 0x85B5827D, 0x58980A5D, 0x220D6FAA, 0x67D5C321},
+    {0xE196E0C0, 0x52A2FD30, 0x14AC41CA, 0xDC46717C, 0x2AEF2056, 0x8A02B5DF, 0xD690050D, 0x8B5C927E,
+     0xD3D3D8D2, 0xD9758A4D, 0x836FDFA7, 0x002A7FC0, 0x3FF96E82, 0x919DF669, 0xF46A113C, 0x63875900},
+    {0xD8738A05, 0x60EF5251, 0xE6894E07, 0x36D7DCC9, 0x47F61F3B, 0x5CA41B5B, 0x1F0D12F1, 0x91E53B0E,
+     0xA1377CAF, 0xCC9C94E4, 0x26F487C5, 0x304C057E, 0x7001A39C, 0x27D499E4, 0x0C43A5FD, 0xB91D1BE7},
+    {0xF1CA9FDB, 0xCB34315C, 0xC9F998E4, 0xE799C200, 0x18264F5D, 0x8606ADAA, 0xEC1D31B4, 0x2612DE0D,
+     0x7CE3BEE8, 0x2F35EFFB, 0x0EA5E9D1, 0xD791DE23, 0x7079F324, 0x3B3D64CB, 0x96298DC5, 0x8BC94778},
+    {0xE3A0CE28, 0x1B136C0B, 0x7AD69705, 0x83098550, 0x902D905B, 0x701A381B, 0x36EFAC85, 0x78CA6B0F,
+     0x6F74804C, 0xED57F21A, 0x029F1D1C, 0x98D2B9EE, 0x0AD36438, 0xB510BF50, 0x79E1D904, 0xA49AFEEF},
+    {0x46F507ED, 0xE678EB39, 0x248C0ACA, 0xACB4BDA6, 0x42135110, 0x5F4F729E, 0xA09A23E3, 0xA2911BF2,
+     0xD02AD3B8, 0x7A01E603, 0x79987687, 0x084FBFDF, 0x835EB575, 0xE95ABEC1, 0x61FF6E84, 0x0A06F9F1},
+    {0x63FFEB84, 0x2BBFC9CF, 0x49EDB205, 0xAB05E9BF, 0x000FE7F9, 0x3BDF48EA, 0x46BFBCB1, 0x160477D4,
+     0xCA7CE919, 0xF4CB4F5B, 0xC583FE54, 0xD4EE6054, 0xC2A65046, 0xD6F0E008, 0xF162B777, 0x06055A31},
+    {0xA542F2AA, 0x1F6C3EBF, 0xB2447155, 0x9D61261F, 0xF4415371, 0x0630C3F6, 0x6526F87A, 0x60952698,
+     0x2F8EF539, 0xF3D1C82C, 0x31FB3169, 0x6B4AEFB8, 0x07C69581, 0x3C7D325A, 0x972519F8, 0xC2FDD77F},
+    {0x2B9A688C, 0x74BB1916, 0x7789B093, 0x3BEFFC3C, 0xCFA49D3F, 0xCBD89146, 0xDD26B58F, 0x3CA92012,
+     0x0D5D23F4, 0xD2898F75, 0xF7711362, 0x8042A42E, 0x1D7BCE72, 0xAB466092, 0x9AB54656, 0xAA2A8E83},
+    {0x0B32D22F, 0x854691AE, 0x75E42C78, 0xC135FEB9, 0xDFAB8463, 0x7985CC2A, 0xF88488BE, 0x0CB3CED1,
+     0x4B928AC5, 0xD6489127, 0xD70EE48D, 0xADFA344A, 0x6F99B4F5, 0xD9FE3BF6, 0xA20C6218, 0x7191ED1B},
+    {0x228B445F, 0xE61C9C3F, 0x57F1DD80, 0x5DBD8CD5, 0x598F7E77, 0xE9EEB12D, 0xAE44375E, 0xFAF8D295,
+     0x2F6CF87C, 0x51A8C783, 0xDD686109, 0x44AFC930, 0x97E0A7D8, 0xFC5B1DED, 0x193F0F38, 0x178662E3},
+    {0x40D32409, 0x477D52AB, 0xEDB059EE, 0x5F0FFD16, 0xDD66AA49, 0xF37A7EB6, 0xE4922F8C, 0xD3142D5A,
+     0x4F5D8B52, 0x4B2868BF, 0x76F19091, 0x0137BD9B, 0x7483C20C, 0xD72BAF8C, 0xD1989DDB, 0x2E9E5A17},
+    {0x6D05B134, 0x5273EAE6, 0x8F75CBEF, 0x7394CC84, 0xAF0B9307, 0x8A7B9C7E, 0xA5E1E524, 0x7EE7F52D,
+     0x188FC62E, 0x063B2834, 0x939C1194, 0xFA62651F, 0xBDD9813C, 0x8E723B5B, 0xAC73D5BA, 0x87298F2E},
+    {0xFEC21B4D, 0x5A6F0E77, 0xB62A3ED5, 0x34A52AE3, 0x307E58E8, 0xBF8001CE, 0xED7FBA20, 0x78E048F5,
+     0xC7DC024F, 0x60C1415B, 0x9B8BCA2F, 0xB812F0DC, 0xE4C151A4, 0xDB9114D4, 0x34046CF2, 0xCB08AAED},
+    {0x4C68A780, 0x7160047B, 0x3CD9CB7E, 0xAFAD28FD, 0x94CCCE12, 0x90919C6A, 0xA773401F, 0x28DB463E,
+     0x1ACD85DC, 0xBAA06F2B, 0x67C677CF, 0xCF1EC4B9, 0x2609B510, 0x4326ADE0, 0xEABCA028, 0x51DF1A4E},
+    {0x520B9B86, 0x3258104F, 0x72D9F3E2, 0x92C8A904, 0x4DD7B56E, 0xFA5FE09B, 0x1609DAA8, 0x18F602B1,
+     0xF30727EE, 0x5E97138F, 0x5A916F64, 0x4F999A25, 0xE0A2FCF9, 0xF4A1BD08, 0xDE4E861C, 0xFDD81F40},
+    {0xC4AE3F6E, 0x042FEDA9, 0x37BED170, 0x216E9E78, 0x2B161FD1, 0x1A3B6650, 0xC8917412, 0x8B53FBE9,
+     0xCC925292, 0x7EBA1A51, 0x9EAA1D42, 0xA3553E73, 0x1C6E8AB8, 0xE5E42CB8, 0x59F806E7, 0xC77CB725},
+    {0x916AEFFE, 0x285856A6, 0x3BF76696, 0x0762DC4A, 0xDC4D7E45, 0xCE15C7CE, 0x32B0E322, 0x4E4020FB,
+     0x67C4180E, 0xD7471FF5, 0x3EFD3521, 0x732CAF47, 0x786360B4, 0xF894844B, 0x685C4EF8, 0x93A24045},
+    {0x7122ACCA, 0x8675B53E, 0xD616C1D2, 0xC1E9DF32, 0x2D632CEA, 0x0BEA73FD, 0x4BE6651B, 0x982FE389,
+     0x520E09EF, 0x7E9B078E, 0xF8221948, 0xE3C80C6D, 0xD2E55DE2, 0xC464E16F, 0x0C62D7B0, 0xD639E9E6},
+    {0xDAEE9D03, 0x4AF0394C, 0x40A00119, 0xAEA3C32F, 0x39687436, 0x578A2F84, 0xDA9EC60D, 0x7D3F8941,
+     0x6D749CE5, 0x2BBA68C2, 0xBCCAF30F, 0x29BE524D, 0xC44F40E6, 0x9A086E51, 0x1F48F630, 0x4508C3F3},
+    {0xF0B9C541, 0x91E69C0A, 0x06657BAD, 0xF6D0286B, 0x90490A2B, 0x3DBB3D7B, 0x7511EC89, 0x0D8D348B,
+     0x3515553B, 0xC79BDD33, 0x1AD07FC7, 0xF3740449, 0x7AF32CC9, 0x1E75AEE6, 0x9452278B, 0x4734CEFF},
+    {0xF36C68C5, 0x86AFF55C, 0x88A30108, 0x2446CDB4, 0xF113D7E2, 0x577C782F, 0xD920A3FE, 0xD2AB3CAC,
+     0xC8DFD3C6, 0xA371BA8A, 0x2028CAED, 0x440CEB2B, 0x04DE9252, 0x4C2B14B8, 0x6E28538D, 0xBDD2D125},
+    {0x63B2BE64, 0xB13D8542, 0x7A29D5D7, 0xAA2519D8, 0x4D7151A1, 0x76BF41BF, 0x8802D9EE, 0xB90D9E16,
+     0x999852E9, 0x7708B1E7, 0xCF60B475, 0x22B006B7, 0x6C553186, 0x6F9C554F, 0x5844E212, 0xF20519E5},
+    {0xCE65BCA8, 0x4619AB4D, 0xDFA8F25F, 0x642561ED, 0xF996D049, 0xD6BAD5E1, 0x04AA7C8B, 0x7C484C7B,
+     0x0CD2D510, 0xA1FC768A, 0x7C299EAA, 0xC3B51C60, 0xF07BB81D, 0x0659359B, 0xFD77A2C7, 0x2C1AECAB},
+    {0x78A6A80B, 0xB7D8D44D, 0x2E910CBE, 0xE8F1BB72, 0xF37F2DAB, 0x51ADFD37, 0xEF4577FF, 0x5EC70B74,
+     0x43C1AFA7, 0x4854E74A, 0x102CC3D0, 0x575FA31E, 0x48F2B7FE, 0x516949A3, 0x42ED81C1, 0x0FDA3829},
+    {0xAFCEBEB3, 0xF2CC469C, 0xF26F7C31, 0xA7E44A9E, 0x85FF6DBE, 0x8DEB45E4, 0xBA808CB9, 0xCF633DBF,
+     0x641C7D04, 0x11DD4AE0, 0xFF5AD940, 0x16E70EFD, 0x5DAE7C9E, 0x59FFEA8F, 0xFCCBFD93, 0x1416E7E2},
+    {0x297ADDEC, 0x5E310410, 0x3D1A8018, 0xBB3FE1FE, 0xE50D4D56, 0x3799B535, 0x839E7786, 0xC2F2E84F,
+     0xC70CB762, 0x513459D6, 0x75A3F66A, 0xC1D7A7A5, 0xC20E827D, 0x89D12844, 0xBBD1E5E5, 0x4E57A0A9},
+    {0xA74ADBC1, 0x4DEC1AB0, 0x05E0C888, 0x9BD6EC94, 0x1AA498BA, 0xF9E522EF, 0x5B37A16D, 0xBE29AC75,
+     0x20B14A81, 0x0329CDF5, 0x366E3F85, 0xEA7E8C01, 0xBA4B107D, 0x2AB19A6C, 0xA2B7B0C9, 0xE1909BF3},
+    {0xA029F860, 0x2180BC1C, 0xCC04F83F, 0x55356AE1, 0x9A4A4782, 0x936E7DB8, 0x391E6DB7, 0xE797C6D8,
+     0xF9C547AA, 0xFDC3D9BA, 0x1E213290, 0xF8CAD3C4, 0x4C25D253, 0x938FF5E4, 0x4F56B1D4, 0x7C1D66CE},
+    {0xAD3C3AA8, 0x6E3A923D, 0x6D0992D5, 0x262E6000, 0xC13E5BA2, 0x6E1D69BE, 0x2142B7BA, 0x50DCE33F,
+     0x4BFB4000, 0xDD46488B, 0xB7DEB3DC, 0x760D5610, 0xCC9CCDBA, 0x63BEB001, 0xFA711138, 0x1EB46F70},
+    {0x4778F143, 0x1B5AE9C4, 0x14982FF3, 0xEDA2709E, 0xD0135E99, 0x965F2BB4, 0xA1BE1BC5, 0x45088067,
+     0xC9E0E52A, 0x09A0B21B, 0x34E83359, 0xE9C10CAA, 0xD854CD1E, 0x8306CCFD, 0xB5D0FCF2, 0x112EB307},
+    {0x41B530C3, 0x2FA4CC5C, 0xEF6A2AED, 0x7CF1C188, 0xB8A5102B, 0xD662351D, 0x565A50AF, 0x2691458A,
+     0x1E905B79, 0x01B29700, 0x52B102A3, 0x18122B9D, 0x8A9946A9, 0xA2CC2791, 0x60A20735, 0xB2F08EB9},
+    {0x67E5869D, 0x9BC4E7FA, 0xB5FC24F3, 0x8F157254, 0x43110305, 0xF8AF1C64, 0x31DC5176, 0x3A800833,
+     0x5579AACF, 0x824D141E, 0x1B65AB9D, 0xA0FA7E0B, 0xDA84FCCE, 0xAEE08BC0, 0xCB7FC929, 0x83F10947},
+    {0xB6DD33EC, 0xC1DAEAAE, 0xFA1E1224, 0x90D12D30, 0xAD3E603D, 0x9FDE7234, 0xB462A14A, 0x1F6C7C76,
+     0x7D1A9967, 0xF6D7983D, 0x9FEC4BD7, 0xBE6294E8, 0xE2B8A4F2, 0x2D60F40B, 0x81EA2E1C, 0xB5086C4E},
+    {0x5A2B7481, 0x1AD8B19A, 0xE24E58D5, 0x7B5EEFE1, 0x3C2E274D, 0x4CB84C8D, 0x30D675BA, 0xCAD67BAC,
+     0xC7E73012, 0x1E725C85, 0xDBC7E97C, 0xB4CC4A68, 0x34B88F1D, 0x4720FFE1, 0xC35F0477, 0xFC3EC38D},
+    {0x7472C8F6, 0xA9C50846, 0x07E57A1B, 0x6414EEB5, 0x84CB716A, 0x9F61B270, 0x8C29378A, 0x449F45B2,
+     0x6B624A11, 0x9B9A7156, 0x85192C27, 0x9D3F888D, 0x4004DA53, 0x3A29F05D, 0xD7754E26, 0xD0012B67},
+    {0xD0919DF5, 0x22F49D97, 0x40484EFB, 0xB4AA7307, 0x42CBCA49, 0xE349C698, 0xB590D10C, 0x7FFBD40B,
+     0x399CE036, 0x3BD39FA2, 0x528E2F12, 0x7C579DAD, 0xFC21FA1C, 0x84F567D7, 0x20730BE9, 0x9F82BA58},
+    {0x1DB2B92F, 0x4DCA2AE0, 0x849EF550, 0xCDCF4C7B, 0x89B709DF, 0x427885AC, 0x530F9E73, 0xDDEC022E,
+     0xA054B9F0, 0xE5451EBE, 0x78372A42, 0xB732C7B9, 0x8D12381C, 0x971A4C1E, 0xD16016EC, 0x1B31B290},
+    {0xECCE386E, 0x3B773794, 0x8B0A6316, 0xB11710F7, 0x4D0F1369, 0x6B051075, 0x1083B03B, 0x9720DCBB,
+     0x2B8DB00E, 0x77BB1F78, 0x2F6EA3FE, 0xA9FC4F11, 0x6F553979, 0xE197CB48, 0xBD8F319F, 0xC8D06DC6},
+    {0xAB904E96, 0xB7CA7ADD, 0xC285BBDC, 0xDE15B8A4, 0x35C309F1, 0xD25553CB, 0xD0F08EAF, 0xE3B7FDB1,
+     0xC05B2F11, 0xB2F0424C, 0x19F0A270, 0x03C41B95, 0x549DEC06, 0xC17BBDEA, 0x1917949E, 0xD1B17F1E},
+    {0x4DE7008E, 0x17C3C5F2, 0xB7501B50, 0xA43F5931, 0xB29EAF54, 0x467B712A, 0xB1FD1BC6, 0x58AA46FB,
+     0x51AA86D1, 0xF1ABD1C7, 0x8C39C689, 0xFD33D9EB, 0xC4C3C14F, 0x189F4F1E, 0x3705CF0C, 0xEFBAAB0C},
+    {0x2750E96E, 0x36720E77, 0x65BB7562, 0xA4473FEE, 0x0B7B9489, 0x9FB5924D, 0x4FE01525, 0xD33201F8,
+     0x6481D6CE, 0x38460623, 0x7555C147, 0xEA5B438F, 0xF2B6F433, 0xA1E1BAE4, 0x898549F8, 0xA00642DF},
+    {0xC8B111E7, 0x07C1B07B, 0xD79E0945, 0xBBAB9384, 0xE8CEF952, 0x6E1FC162, 0x41BD5958, 0x6DDE6F4E,
+     0xE5304FC2, 0x18393AD5, 0x85754835, 0x315DEF11, 0xFC1800FA, 0xA216A98C, 0x186048D9, 0x909D7200},
+    {0x757C8376, 0x1CD9DF67, 0x8F0AE5F9, 0x9330CFDC, 0xE5A7D268, 0x6AFA2775, 0x9DA2EDAC, 0x5C73C691,
+     0xA406C8DB, 0xF625C886, 0xAD8D2229, 0x2B096FEF, 0xA1B74868, 0x12EA9086, 0x6E366C31, 0x43BCE77F},
+    {0xD5958CE5, 0x9C6B650A, 0xECB1C279, 0xEC50A90F, 0x69F6E557, 0x47100E0D, 0x171CC3D6, 0x01D0C81B,
+     0x1453A9B3, 0xE85BA6DD, 0x6FDC1897, 0x36C9C986, 0xB09719F1, 0x94145373, 0x73804DB2, 0xD47AC0DC},
+    {0x7CE40487, 0x3CA5BBB2, 0x4141EB16, 0xE1BB3F50, 0x7CA7F502, 0x22CC0594, 0x6563EE89, 0x8EFF6DD9,
+     0xB483BDC2, 0x5A164214, 0xBC72EEBD, 0x3882CFE1, 0x09C54CD6, 0x3570B952, 0x0720872D, 0x545DF463},
+    {0x44DEBE58, 0xC6A135ED, 0x888C7252, 0x16C81F08, 0x1283BE76, 0x7A280B7C, 0x1A62C159, 0x2AB4CD56,
+     0x38DBCEEA, 0xBC1BAF5E, 0x3D12F5FB, 0x9A1894D1, 0x73AA24F9, 0xFF1EEC03, 0x9D226C9B, 0x3253534A},
+    {0x5E90C2BD, 0xD220EF98, 0x281B68C5, 0x09ED885E, 0xA0AFAF2B, 0xF2B380F8, 0x8DFEBF3D, 0x98D873DA,
+     0x1267E9E0, 0x9DAFE715, 0x09C50740, 0x9019A8FA, 0xC3A7C9D9, 0xFDAC4701, 0x6D199B9D, 0x2A3A1172},
+    {0x2ED5C1FE, 0xD67018C7, 0x6C42DA1E, 0x01B2AAF2, 0x2B797DCF, 0x7AF1ABAE, 0xC5240C71, 0x1B3D6EB5,
+     0x2F5B439E, 0x6AC6D9EF, 0x5C3A7A53, 0xEB7F0AB8, 0xA3871DC9, 0xDCB21DF0, 0xEDD329CD, 0x835B58C6},
+    {0x2E813FDB, 0x9018B0E6, 0x12E50A43, 0xAFAAC976, 0xF227D196, 0x792A68EB, 0x6B5BAC2E, 0x8FB66E09,
+     0x054EBC10, 0x72C002E1, 0xD7131528, 0x6DB21ED2, 0xAF8F2188, 0x29212970, 0xE3EC3907, 0xD965355A},
+    {0xA3166A64, 0x3F88D4F0, 0x19E0DF8D, 0xF1A11AFB, 0xED5B4E0A, 0x94D98AD3, 0xEA23DF9F, 0x7B1960FB,
+     0xD2D42B77, 0x13660197, 0x5F4D25B6, 0x771CAA0F, 0xA66A6134, 0x4982CD36, 0xAEB6FA62, 0x8F1ED0DE},
+    {0x19256D65, 0x1385FDB5, 0x5E8ECFCB, 0xE7759AE4, 0xF3B29528, 0xEAD12718, 0x2ABEB892, 0x02DD8315,
+     0xD2C206E9, 0x006160AB, 0x9216DB15, 0x52F05598, 0x5DCD6553, 0x0B21BD2D, 0x4731439F, 0x1B516CF5},
+    {0xB3D00E94, 0x37E9CFA8, 0xF1286FAF, 0x0F8663C5, 0xD1CD31AB, 0x12F5007F, 0x76D50C48, 0x024845D4,
+     0xF4D5D9C7, 0x932AB83C, 0x44F1298A, 0xCB0C9611, 0xD60D4E17, 0x3A48995B, 0x380AB451, 0xF7CD21CE},
+    {0x00C68EE8, 0x484DE29B, 0xEEC52093, 0x820419DE, 0xB6B2E3D9, 0x7730F553, 0xD008D977, 0xACEB0852,
+     0x0E4652AC, 0xC796ECE4, 0x142B0533, 0xB0CD4486, 0x5B5F360C, 0xF6C14ACD, 0x48AE5706, 0x4BC2F5FE},
+    {0x1741067E, 0xEDA89DA0, 0xD4B805C5, 0x6D364AC1, 0xA8415E54, 0xBF005BBD, 0xFF275AF1, 0xEB08F147,
+     0x66047021, 0x274C64BF, 0xBAE16862, 0x1BD5135D, 0xCA2B200C, 0x3819DFB9, 0x5A97DF90, 0x8F05C0FC},
+    {0xAA2AB12B, 0xD78AA78A, 0xC487C544, 0x5F06CB85, 0x88AA9F3E, 0xF64F7D8F, 0x59EE7C4D, 0xA4ECED3B,
+     0x46C2297A, 0x555448E9, 0x6BD7A308, 0xE696E9F4, 0x4D07F9E5, 0xFA3073E5, 0x4B8F0C32, 0xCFD73A91},
+    {0xA63DEEAF, 0xBDB5B9C3, 0xC6D76987, 0xF0BC5BB8, 0xE9FAFE8F, 0xD42C1DA3, 0x6A224C01, 0xD59985EC,
+     0x95FEB214, 0x5EF4334A, 0xB5B0C0F2, 0x9FE0301D, 0xF4F846BF, 0x8EDC8478, 0x40584609, 0x93CFC122},
+    {0xF303C9A3, 0xD32EF27D, 0xD7524E61, 0x7A11C23D, 0x6C1E9848, 0x5E02CEC2, 0x60453FB4, 0xD032291F,
+     0x8B6266D9, 0x1BE2DE55, 0x5D2BCF0E, 0x36FBE423, 0xA79976D4, 0xF6820F29, 0xF6E30808, 0x9EDA119E},
+};
+
+#elif ECC_P256_COMB_TEETH == 8
+
+#define ECC_COMB_COLUMNS 32
+
+static const uint32_t m_comb_table[128][2 * ECC_COMB_WORDS] =
+{
+    {0x30810463, 0x3E885368, 0xFAB5361F, 0xBAABCE1A, 0xE30605FB, 0x95D188E3, 0xAF327F4E, 0xBF88979D,
+     0x62C003B6, 0xB0A5B5F6, 0xD10CCC65, 0xE2ACF33D, 0x1B08374C, 0xFA9321A1, 0x343CAA81, 0xA76C72F3},
+    {0xA7E45006, 0xDB59E02D, 0xFF0ACDFF, 0xFFF121CE, 0x00FB2C79, 0x10909270, 0x30F574BF, 0x2AF67054,
+     0xF6604870, 0x386876E0, 0x26DBA041, 0xD7A183D3, 0xF264DA1E, 0x6246CF0F, 0x411B5F74, 0x8C14704C},
+    {0x4ECECF4A, 0x910EED1E, 0x83942B68, 0xE2607867, 0xB7B96C9A, 0x87345691, 0x744DD74B, 0xA79828E7,
+     0x0F3B57DE, 0x88175E79, 0x4E8FD480, 0x0006426E, 0xF69DD96E, 0x86FE7A1E, 0x43EBCEE9, 0xA4C73027},
+    {0xF9FB7610, 0x2FCCC2AB, 0x99425B35, 0x130212D7, 0x19DE4E5A, 0x0DFE9E1E, 0xEEC1D5F5, 0xCFA8EF81,
+     0x7313CE83, 0xF5F8B9BF, 0x5539B82A, 0x27F8068E, 0x48EFCC94, 0x896483A9, 0x44504D26, 0x59D19AE9},
+    {0x8B8B97FF, 0x6E981BFF, 0x3AB1EA50, 0x8A6DCDAD, 0xDD852676, 0x81D230CD, 0xB33CF575, 0xF7C5A7D7,
+     0x12509FC8, 0x834C3A35, 0xEABFBE85, 0x9FAE6A11, 0xD9325254, 0x74095AB3, 0xDF5FAC1B, 0xF927C93D},
+    {0x3A7A6D36, 0xA1EB7B78, 0x38359D9D, 0x3D205D20, 0x67FC8842, 0x0716CCA9, 0x21CC0EC9, 0x4C7E873E,
+     0xE33B0870, 0x586D6FE8, 0x099B3403, 0xE8CED61C, 0xE3538E8C, 0x29E3C390, 0x523F0E0B, 0x68DF5BC1},
+    {0x9B89C11E, 0xF81D05C3, 0x41969C80, 0x96169EC1, 0x70F09B26, 0xFEA38F17, 0xF486E60B, 0xDE9F93EC,
+     0x4DD854B2, 0xD1321B67, 0x6DD6B3DE, 0xEEB62730, 0x4B353F92, 0xC3C28BD1, 0x42DB1EEC, 0x1CE8CFA5},
+    {0x989860C0, 0x0B498061, 0xC53C058B, 0xE753B001, 0xF646D230, 0x52AAA857, 0x63FA8196, 0xE060E0CC,
+     0x7A447439, 0xBC77B0D2, 0xA5E3C7DD, 0x77A8D95F, 0x832FD418, 0x4869EA35, 0x971E3900, 0x26EA2318},
+    {0x6D28B11B, 0x5E36722D, 0x41AF37C3, 0xB04DA378, 0xC2F8D0E9, 0xE7888A2C, 0x73AEAEAA, 0x0C3C9B2F,
+     0x39E158E9, 0x6A09EF9F, 0x232308CF, 0xFD1DDDD3, 0x57028AAA, 0x4CD14330, 0xD8E8341D, 0x9A5FD6D6},
+    {0x991531F7, 0x6810371A, 0x90E22931, 0x93489752, 0x3E253044, 0x26054513, 0xFBEB7700, 0xD1F2372A,
+     0xD1D19CE3, 0x7B58459E, 0x474FC1E1, 0xA30E7F2E, 0xF3C1EE99, 0x2A9817C2, 0x469D06B6, 0xDD414842},
+    {0x1B21060E, 0x98C5B90B, 0x94F3B99C, 0x2E816308, 0xDEBC25AB, 0x036075E7, 0x0B714AED, 0x8850B7B9,
+     0x93F3AB08, 0x59FAAC3B, 0x8DC37235, 0xE0482AC1, 0x497980F2, 0x8F50602D, 0x9373AE32, 0xCFB3180A},
+    {0xAB10D703, 0x59A67FEE, 0x617A623E, 0xE1595622, 0xD22B72DB, 0x73957DE1, 0x90F1A83C, 0xC6DC8694,
+     0x0E40B3BD, 0x1DB17406, 0xF6D3F879, 0x2FFAE5AE, 0x6AF4840E, 0x529AA675, 0x32E19BE4, 0xC1A1B986},
+    {0xBE273B58, 0x46E809CD, 0x43923B05, 0xBCCD116A, 0xF35AA3CB, 0xB031444D, 0xD02EE263, 0xB69150EF,
+     0xC84C56AF, 0x4E8B28E0, 0xECA8D38C, 0x0AB101AB, 0x54BFC0BB, 0xDDB0FDB0, 0x48269202, 0x01990D24},
+    {0x21BEDED6, 0xC0257266, 0xFE905D73, 0x44906953, 0x8032F63C, 0x13A1609D, 0xC43BFF9B, 0x9C569331,
+     0xAA8D82F8, 0xF5FADC51, 0xA35BFBB3, 0x8B318F17, 0xCCCAB37E, 0x7595A650, 0x1B5B8883, 0xB4221E5C},
+    {0x8666C9EE, 0x9C494DE0, 0x72932FC0, 0x84471D16, 0xBF5AF2E6, 0x48AF2E24, 0xFA0CC357, 0xF904A327,
+     0xB81EB170, 0x4148F89B, 0x9A580E21, 0x7583DF85, 0xE74E2F8E, 0xCDF153FC, 0xA18EC088, 0x57092946},
+    {0xC8FA5B1F, 0x7FCF7DDB, 0x8C93EF04, 0x2FBFAEB0, 0xF3A52AC6, 0x351A04C1, 0x661DC3E1, 0xA3794D8B,
+     0x09173385, 0x4C8723D6, 0x91EB935B, 0x405E97FB, 0xAAB0AC33, 0x0BE191EB, 0x894F47C8, 0xD62A9949},
+    {0x71A822B3, 0x2B9363A9, 0x889693E8, 0x450BD60C, 0xE9869036, 0xAE85EC39, 0x212FAC15, 0x5FD6B6CB,
+     0x7C0D73A8, 0x9D534734, 0x7FA80A35, 0xB876AA9C, 0x6D722949, 0xE92A7AAA, 0xBA30F636, 0xE276F2D9},
+    {0xD2364B69, 0x45CCB88F, 0x7CA39273, 0x474DDA2B, 0x0A42AC15, 0x2DFD6199, 0xC7AB99A7, 0x71E57533,
+     0xFCB09DFC, 0x7D74FBBF, 0x99D90935, 0x30F600AA, 0x644439A6, 0x617F7CAE, 0xD7728904, 0xC93F34D0},
+    {0xCD3FF058, 0x6D5273ED, 0x9D08538F, 0xC380EB4E, 0x38EE9FC8, 0xD8699B75, 0xD8CE589E, 0x9DAE4E4E,
+     0xA6BD9E35, 0x435D243A, 0xDE992739, 0x893D6508, 0x57E6D39B, 0xD93BA30F, 0xB22B0543, 0xA860F375},
+    {0xF905D04F, 0xCB3E3204, 0xC28046C8, 0x9CC736C4, 0x72813F87, 0x3ECDF5DA, 0x9E1FE3EA, 0xB2E16B15,
+     0xEDBF33E4, 0x4D4D0855, 0xDD103C65, 0x2894A3B8, 0x4C5468A3, 0xBD2ACBF7, 0xF349EDBB, 0x0D766594},
+    {0x2D28CF76, 0x063B51C8, 0x0E171082, 0xE8E68C5B, 0xF25F8F5C, 0x57DF5676, 0x8EE3DC35, 0xC470E33E,
+     0x0454FE14, 0xDFA04B6A, 0x98622978, 0xF2554725, 0x3360B124, 0x7BB44C8D, 0x90DE1C43, 0xE33ED42C},
+    {0xBE1EE7F6, 0xA585F981, 0xD3408E55, 0x7AF71035, 0xA47BBF19, 0xCBB39E31, 0xDECE4039, 0xBDA7743A,
+     0x068284FF, 0x80B86283, 0xE519A6B3, 0x47614872, 0xC26D0F63, 0x04CF9984, 0x4FC890FC, 0xF617F7BD},
+    {0x1E62937B, 0x23ADBEBA, 0x0B30DC34, 0x26A5E3B2, 0xEF93275F, 0xF61A820C, 0xCD16CE65, 0xE9F446D9,
+     0x75F02D50, 0x4C50C61C, 0x225D5521, 0xFE717CB8, 0x60C5A5DD, 0xB9012661, 0xB706B3CA, 0xC7D358B5},
+    {0xEE987DF8, 0xACFFE264, 0x58C432CC, 0xDF7D7BDE, 0xA73F76F5, 0x0A1E0C84, 0xCCDC45CB, 0x933BD52F,
+     0x8B4BC073, 0x7280165F, 0xC916F5D1, 0xAD037BA5, 0x710C1617, 0x26E8A793, 0x46687E2E, 0x313EDF2F},
+    {0xDD45F0AD, 0x1BEF8351, 0x9E38943F, 0x797BCBAA, 0x12015958, 0x8F3B1CA2, 0xB5C80991, 0x98D11596,
+     0x2E6AB1E7, 0xB74C5A0B, 0x9B4FAC99, 0x23A4AB65, 0x5E901880, 0x825FF76A, 0xA43DA97D, 0xC61BBEC3},
+    {0x448CE6F8, 0xA1B68724, 0xDCE2CC22, 0x9FC2B9A4, 0xDC1F0205, 0xDBA381B3, 0x979A63EF, 0xB39ECF69,
+     0x84B73464, 0xFC2BBC4C, 0xD3BBE3C3, 0x0F369200, 0xC1990F51, 0xF37831B6, 0x6094D4C4, 0x7DD8104C},
+    {0x8E013651, 0x025DA465, 0x72DD2485, 0x17C1FDF4, 0xB03A2BB5, 0x34A7F974, 0xCC1231B7, 0x2FB7C95B,
+     0xD35439A8, 0xA2D663ED, 0x31C4EFE9, 0x077D47E0, 0x3ACCFB00, 0x189BF293, 0x1F81DE43, 0x114EC1E8},
+    {0x87D5854D, 0x115D7C27, 0x83124B3A, 0x0BD041C1, 0x59F30628, 0xB4AE93B3, 0xDA62A23D, 0xAECBB5A8,
+     0x46CDB1F9, 0x4BE33A96, 0x42590B75, 0x84625475, 0x3EAF57EC, 0x3B2B084D, 0x37718CBE, 0x1062FCFF},
+    {0x43752B25, 0xDDA9E454, 0x2B538133, 0xA4F4CFA5, 0x92E1A5E2, 0xB5184147, 0x9B4C0644, 0x6CC5C9D6,
+     0x91885CE3, 0xB94612A7, 0xB56A4894, 0x855AB43C, 0x3AD3F3CD, 0x93D1973F, 0x900896AC, 0x140611B8},
+    {0xFA79503E, 0x4812453D, 0xBA86E5EB, 0x18F38EB4, 0xB7C7397D, 0x8C0F6CB9, 0xCA6E9946, 0x24294457,
+     0x72C6758F, 0x212D3550, 0xC5A9FBAE, 0x75BD3556, 0x178A9DF7, 0x77AA7037, 0xEE9CFFCF, 0x67F8DCCE},
+    {0xF518317D, 0x32A634F1, 0xE8A40323, 0x91182BB7, 0x9BB6319E, 0x98A6A28D, 0xB77854CF, 0x19B6B766,
+     0x7DFD6D0E, 0xEFFE203C, 0xCBA618F4, 0xF8BF7ED4, 0xC5C0F1FE, 0x2D95E107, 0x69FAE7C3, 0x33F1C24C},
+    {0x0FF73730, 0xA761BE48, 0xBA7E3B2C, 0x4AD2246D, 0xC15A85DD, 0x4B8A2798, 0x18005521, 0x04D40665,
+     0x57575FD3, 0x99E05C19, 0xCDB769F0, 0x891352C0, 0x62EB4D96, 0xAD4FA168, 0xA33D8B71, 0x5F7905DB},
+    {0xA7FEFAA1, 0x2837BCCA, 0x1B7152A0, 0xA0903BB3, 0xB4E23B83, 0x89334F2C, 0x7B97B9FC, 0xC298B58B,
+     0x6A370FB8, 0x22521418, 0x0E715A44, 0x84B82888, 0x45779906, 0x84AE7151, 0x33B053F2, 0x541CBD57},
+    {0x105F02BD, 0x71DEB679, 0x24376FF2, 0x3280162A, 0xA67B60F1, 0xED5078FC, 0xDAA831A1, 0x6650EA53,
+     0x50D6DA50, 0x2FEE672B, 0xADE6EB5E, 0x1D188BB8, 0x6C85613B, 0x1A30C94A, 0xCCC9F715, 0x1B98C4FD},
+    {0xAEBDC246, 0x1262FFC7, 0x3533B38D, 0x41C19A73, 0x64C0D2B6, 0xD0235D65, 0x036D4045, 0x6F1E2C6F,
+     0xE7D8F3CF, 0x4C68DA47, 0xC62B8938, 0x06445D71, 0xE493EAD5, 0x6F8DC942, 0x135D09C1, 0x194FD1DD},
+    {0x0E72FC56, 0xDE48868F, 0x23604A41, 0xCF18E6A5, 0xECC1F5F2, 0x3132A5A3, 0x2AAF5F38, 0x5EB71FEF,
+     0x61548BEF, 0x08DCD199, 0x484A0533, 0x6F37A088, 0xA5B1AC50, 0xB491534B, 0xB0035E32, 0x0DF5FB0B},
+    {0xEB3AAEE8, 0xEAEDF3C7, 0xE639D250, 0x10E67B2C, 0x23430BC0, 0x3CD4853E, 0xAFC78C3A, 0x849C9095,
+     0x3D18C18B, 0x701C37EC, 0xBF8C271C, 0xE7E5CB40, 0xC6F91490, 0x2AA28975, 0xE78B2256, 0x8DB4BDAE},
+    {0x89BAB937, 0xBBB5594E, 0xC99C44FD, 0x5E59BA0C, 0x11310F38, 0x0FBA4268, 0x0A3F7BA4, 0xC48C5C58,
+     0xD784DD46, 0xD5BBBECF, 0xC265131F, 0x4D498698, 0xA6CB48E9, 0x9396180C, 0x125EA328, 0xF897D991},
+    {0xAEDB166A, 0x4218ABDB, 0xF2537C71, 0x76340C07, 0xF53E2840, 0x2F19E1BA, 0x598E6F4C, 0xDD5EB92B,
+     0x2E1EC083, 0xC97ECB4C, 0x057DDE4C, 0xDD009751, 0x40BAF5D2, 0x5F99B3AD, 0x67941600, 0x01760A1F},
+    {0x1E9565C0, 0xBC53CC38, 0x191BC530, 0xA5466BA1, 0x6D21129F, 0x83F3BDDF, 0x0AFEB1C5, 0xA7962038,
+     0x9D96510C, 0x570BB0DF, 0x8E7EA70C, 0xCE43F51B, 0xF88E8EA2, 0x8BFEE547, 0x92BC29E0, 0xE2D79BC9},
+    {0x05D1DCA9, 0xA448F699, 0xDFF7F5F1, 0x72FE8D2A, 0xFA443C36, 0xBC7F2D56, 0x828C515A, 0x8719CE3A,
+     0xE565868C, 0xD16CDA68, 0xA469AA1E, 0xA8600C9A, 0xAEF0A60B, 0x9ABE6DED, 0x6178C696, 0x4EC25B9A},
+    {0xF3254ACC, 0xEB899270, 0xB723690A, 0x0AE06626, 0x5E865622, 0x0E8B0E59, 0x18F82CBF, 0x9708FDDC,
+     0x2CC311ED, 0x462A3ACF, 0xE948999A, 0x3827DDC0, 0x7A6B8169, 0xDE985EFA, 0x91B6DE3E, 0xA1545268},
+    {0xB8E0A912, 0x0E6A4041, 0xA4A584A4, 0x30301E3D, 0xBEBDB419, 0xD341CD8B, 0x0E10F3F8, 0xA5754AC0,
+     0xFBE51DF2, 0xCFB2AE96, 0x3AA71442, 0xDF3E6199, 0xA6335B94, 0xFB48EFEA, 0xCB34A1EE, 0xBAC2F4FF},
+    {0x655FA005, 0x03ADE77B, 0x619958E8, 0x773A93F9, 0xF62EEA1C, 0x6A2D744D, 0x9D7B1828, 0xCA2CE743,
+     0xCC02FBB8, 0x75675E02, 0xFEC85A30, 0xAB556E0F, 0xBB4C83ED, 0x6A4748E9, 0xE8CA56C9, 0xAEF908FC},
+    {0x7B4085D9, 0x8EE2756F, 0x7A4739EF, 0x98F6F374, 0x078BF715, 0x20A441D4, 0xFE98EA99, 0xC70C22D5,
+     0xD2C52EF5, 0x418BC76F, 0x20A11B91, 0x1D7E1EAB, 0xB971B2FA, 0x0E6CA783, 0xC9B4CB4F, 0xFF95E590},
+    {0x4496D70F, 0xC0E7A247, 0x00566C58, 0x305C84BA, 0xE761A0E5, 0x100AAD20, 0xB9EED170, 0x6F096DD6,
+     0x2817E3FA, 0xDAC35005, 0xAB591124, 0x6B15AEAA, 0xAA40C40A, 0x5EFF6822, 0x5D7ACED2, 0xC1889EFC},
+    {0xA865C656, 0x49C7D452, 0xBF55AD62, 0xF603CDB2, 0x00756FE9, 0xB008C202, 0x5AA80592, 0x5653437E,
+     0xB758A966, 0x82AFFC40, 0x2B3E8A5D, 0xF703A73F, 0x83793BC2, 0xEB0D4362, 0xEF3AA558, 0x6809C1C8},
+    {0x0DDAC52A, 0xE2D6318E, 0x0CA1F902, 0xEA8922FA, 0x7870FFAD, 0x39A98643, 0x4D4F49BF, 0x7A9A013E,
+     0x6D63B86E, 0xD75A1152, 0x08F2B7FE, 0x338B5C6F, 0x33B669CB, 0x6F4A9DA0, 0x75637623, 0xD948D775},
+    {0x4EF363A5, 0x077AF40E, 0xCADF267B, 0x643B8DF2, 0x72023208, 0xE0D08C73, 0x11BFAD31, 0xC89E6153,
+     0xB5476828, 0x12D258AD, 0xD947E532, 0x25F89C78, 0x9DB7A2E8, 0x14A6BBD9, 0xF3F569C2, 0x6AEAEA5A},
+    {0x228451B7, 0x7983946D, 0x3E0732F3, 0x4DA403FF, 0x87882CD0, 0x8F8C1A20, 0xCA672E9B, 0x11D5DB35,
+     0x23C8723A, 0xCA305C5F, 0x4C4B71F6, 0x16F4B733, 0x7AACA662, 0x79FB6588, 0x0ED62E71, 0xCF22AA4E},
+    {0x5D270E62, 0x59824F87, 0xB68E79C0, 0x226AC1FE, 0x4364F169, 0xD8DF97D7, 0xE02872E9, 0x49AD98D5,
+     0xF2CD4F60, 0x4826527E, 0x75A249D1, 0xFBC4693A, 0x8DE6B155, 0xDBC732A7, 0xFA7F880E, 0xA7063ED9},
+    {0x7EDE495A, 0x6B58C4E8, 0x5A1EE150, 0xBAF09133, 0x11BC88E9, 0x190F6CDD, 0x03A670D9, 0xDADCCEDC,
+     0xC6CFD545, 0x91D5DF62, 0xBBE9FD63, 0xAD8F8256, 0x82BFBD39, 0x932484D1, 0x0BAB47B3, 0xD18C0600},
+    {0x20CBCD38, 0x8D84EACB, 0x6A022AE8, 0x823871C6, 0x7544CF15, 0x79943631, 0x032C0908, 0x0FB8796E,
+     0x72340B31, 0x76DD07BE, 0xC3ECE4BC, 0xFF2E279C, 0x38A65FDC, 0x01066EDA, 0x4A325EC0, 0x4FC6F8DD},
+    {0xACF1F5E2, 0x117AB937, 0xE9505F13, 0x8C301026, 0xE5CB5443, 0xA5985939, 0x542D3228, 0x3C97BF75,
+     0x86905E70, 0xBA893343, 0x80A9553E, 0xCF066BD1, 0x3354D954, 0xC5A5F0DE, 0x8EDD750C, 0xC3ECDB6A},
+    {0x451E7681, 0x0DAFF04C, 0x4EE76F1E, 0xBDC0658B, 0x336AD925, 0x6132919F, 0x9442D925, 0xEC91AB81,
+     0x129F6C0A, 0xA80D0A37, 0x979128A1, 0xF9158CAA, 0xCE173A5B, 0xCED0DF9A, 0xB98CE0EE, 0xFE71C5E0},
+    {0x94F1D51A, 0x86D71660, 0x0769DF94, 0x9DD88156, 0x24C40175, 0x15370672, 0x48F7D815, 0xADB1BD18,
+     0xC6260892, 0x3B74D8A4, 0xFD57F64C, 0xB46170E5, 0xA9485FE8, 0x59B5FD64, 0xF2DDF0EB, 0xF654192D},
+    {0x1C823F8C, 0x645DCF62, 0x80168BBD, 0xCE8D24BE, 0x71F0670F, 0xACD614BB, 0x811996B3, 0xA8C3E7EE,
+     0x56DEC4FE, 0xB47024E7, 0x06CFDE7A, 0xC5767B56, 0xB2BDB804, 0x4BC5C2D8, 0x36472407, 0x6D1CDF05},
+    {0x382578B8, 0x708922AD, 0x2CA915F0, 0xF0DE2E8A, 0xA7DED09F, 0x4DE978A0, 0x953066DF, 0xBCC40ABC,
+     0x68041D55, 0xAE4A4384, 0xB4D2031D, 0x15D16816, 0xC8CF0F7A, 0xC24DC625, 0xC8A4B1AA, 0x063A64E3},
+    {0x76FA3CEE, 0x995F436C, 0x7A772749, 0x2758AA40, 0x0C2814E8, 0x13621E65, 0x3B4DE631, 0x338C55AC,
+     0xD7E927D4, 0x664BB586, 0xEE718269, 0x8FE813E9, 0xF14BCC46, 0x962D532C, 0x8C6569C3, 0x2235525B},
+    {0xA60F203E, 0xC5DC6C3A, 0x5546FA30, 0x1C89C893, 0xD627659C, 0xCE62B7B2, 0xAEC8608F, 0xFC91A3BC,
+     0x167A6470, 0x9A57A4CC, 0x38852935, 0x658C9E48, 0x69A5D813, 0xB45660E2, 0xAD161A4B, 0xA3FCBDC6},
+    {0xD01662A0, 0xB7417932, 0x13FCABD8, 0x05E262D2, 0x0D8DEA41, 0x6A5ACB6B, 0x9B779931, 0xBDBD649B,
+     0xBEECCE1B, 0xA94B4FB0, 0x7276D4CA, 0x738EE01B, 0x718D5CFD, 0xA3D9F816, 0x64CAFCBB, 0x7A2AE158},
+    {0x12751520, 0x56F521A8, 0x68A7135F, 0x56939C43, 0xDFA22FDA, 0x722309A3, 0xC53482F8, 0x81377C3B,
+     0xB5A28650, 0xD884439B, 0xAB5B1D74, 0x02E2A11E, 0xD92C7223, 0xEB3A7570, 0x2ABAB8CB, 0xC080F5E9},
+    {0x41A7BC6F, 0xDA0B906D, 0x63904498, 0x9FF14EA1, 0x861DAFDA, 0x14D779FA, 0x91B63B2D, 0x16AEFE7E,
+     0x01ABAD87, 0xE038CB83, 0xA02A5931, 0xEEC90005, 0xB249207F, 0xF81A674A, 0x1A67E9FC, 0xCBA14E5F},
+    {0xAE4FEA49, 0x90B94412, 0xA08EFB35, 0x169E6E30, 0x253C53D8, 0x59E07746, 0xF1BD7920, 0xBC779F45,
+     0xB561C09C, 0x245B9F4C, 0xCCA98304, 0xE682D527, 0xF12FBB02, 0x18894472, 0x67698D2C, 0x29348E5D},
+    {0x35DF4DDB, 0x57AD17DA, 0x511F139B, 0x0593654E, 0xCDAB1013, 0x78B0F597, 0x5812384D, 0xF1C6E0D8,
+     0xAD5F9646, 0xFEDFE9C5, 0xBA09C21F, 0x572A921E, 0x888418BE, 0xE3AF8152, 0x5FB096CD, 0x01FEC851},
+    {0x620DEFF2, 0x2A0DF328, 0x6EA56F3E, 0xE8979AE7, 0x870DEDC5, 0x052E3315, 0x8DCD881A, 0xFF39D3B6,
+     0xC8470A17, 0xBEBDE3DE, 0xCD907965, 0x0A5927F0, 0x689C0567, 0x1645FDAB, 0xFF2279A8, 0x430234FF},
+    {0x315894D4, 0x8C3A0188, 0x8109D66B, 0x6025D456, 0x69BAE88D, 0xB9D5D4BE, 0x0349BE31, 0xF904F2C9,
+     0x7A3AD3BB, 0x52DAE985, 0x7D66E682, 0x1583468C, 0xBF904C7B, 0x6B0694A8, 0xC0197050, 0x83868745},
+    {0xF8CB03C7, 0x2218AF54, 0x59E28F74, 0xE643BC7B, 0x6242DB32, 0x5A84544F, 0xD1B8465F, 0x690E5462,
+     0x4CADCF66, 0xD594C060, 0x011EAC20, 0x6DF908BE, 0x46F0E716, 0xEC02E2D2, 0x43503E99, 0xF605AE4F},
+    {0xE890094D, 0xA8C803FC, 0x1BFF1D70, 0xB68C30CC, 0xBB3A4E13, 0x1013901C, 0x416BF997, 0x71CD81B4,
+     0x4F0E16B9, 0x83D33C42, 0xCAB29929, 0x46C00F2E, 0xD352C72C, 0x86C89B1E, 0x2CADDE30, 0x7B8DF37F},
+    {0xC7D507AB, 0x5D3D2F35, 0x02C23996, 0x8594BAA3, 0xA584FD94, 0xEB89D72A, 0xD9FF7C51, 0x68A2903B,
+     0x4D3367E0, 0xE17B8256, 0xA093D7EB, 0xC7F7ECA5, 0x4997DDFA, 0x08BBB8C8, 0x0C12D4DD, 0x3E52620B},
+    {0xC135F3F4, 0x074680D1, 0xEB440F42, 0x995EB43C, 0xD5FF01EC, 0xEF6429AB, 0xE20DEC1C, 0xA91947E2,
+     0x2F8D7652, 0xEAC120A6, 0xE6564815, 0x163F4763, 0x58A65268, 0x863E9D14, 0x8984142F, 0x6673CDC9},
+    {0x2A444175, 0xBD2D897E, 0x22355C57, 0xFB792424, 0x7AAF34E8, 0x52C83BCD, 0xA4AB68B8, 0x685990FA,
+     0x6299DAA8, 0x926232C8, 0xCEF5B306, 0xB376085B, 0x02584BDA, 0xC3970EC7, 0xF754BFB0, 0x224C39AB},
+    {0xE09F6504, 0x085CBAE7, 0x5A053838, 0xC630DD9A, 0x765A5C82, 0x6244C0C0, 0x65AD1B83, 0x67CD7424,
+     0xE3B06774, 0x1EF624E3, 0x1DA34BD4, 0x2BC03FE3, 0xDDCC03AF, 0xE28978BF, 0x8AC68EDE, 0x28AC65A4},
+    {0x6EFD7B1A, 0xDE008DE1, 0x98274F68, 0xE4C3BFAC, 0x94C94DC4, 0x4CF71001, 0x9B9F7A57, 0x0376E8C1,
+     0xAFA81234, 0xE9ECC95A, 0x55ECA359, 0x4818AFC7, 0x19ED294F, 0xD04665F2, 0xF6009443, 0x763F906B},
+    {0xF2FAFBBC, 0x8FCB28AD, 0x3070507D, 0x00A52BF8, 0xD0EC97D8, 0x173E9CCC, 0xA6FD70C6, 0xB1E7CB6B,
+     0x511FA535, 0x6028A701, 0xFB438346, 0xC3A47C1E, 0x077A783D, 0x601C5E44, 0x0A4DD599, 0x0614E645},
+    {0x85A7FB20, 0xEF0B2751, 0xD91ABAD8, 0x5CB088D4, 0xCA5C1F59, 0xB9D5478C, 0x48823915, 0x38A270BD,
+     0xD24D4B54, 0x95255BD9, 0x7233F602, 0x9113CE68, 0x70B9812A, 0xC237E4C8, 0x835E2AD5, 0xF3B29170},
+    {0xCB81F6CE, 0x9BDA5D70, 0x4852D9EF, 0xE39FB8DD, 0x54291D47, 0x9A01FB99, 0x075679A8, 0x55B9A9B2,
+     0x733EFAF9, 0xBF6704CD, 0xEBD5BC04, 0x7091802C, 0x928FAF04, 0x775FAEBA, 0x1A6CE878, 0x115FD6D2},
+    {0x5BAB8F2D, 0x9D3F2B90, 0xE5C6576D, 0xE4D0CB15, 0xB8C12D6F, 0x75EFA9AA, 0x7FD14CD0, 0x8F4516BF,
+     0xA8F6F901, 0xB51E803F, 0x5E1E9123, 0xF2125735, 0xE1B532BE, 0xE99C517D, 0x4DB02D5C, 0x7C81F61B},
+    {0xF3A468C0, 0x3B706817, 0xC563795A, 0x60CB18A4, 0x75833200, 0x6BD5AE35, 0x8F2EDFE9, 0xC110AAF7,
+     0x086EC0E8, 0x58857D4C, 0x494955AD, 0x556405CC, 0xE0856A9E, 0x29EF9D3A, 0xB80214C5, 0x35CFA658},
+    {0x2214EC40, 0x60CD7387, 0x90143B1E, 0x7DDEA6F7, 0x69EA97BA, 0x35A280D4, 0x1912CA8C, 0x93E8EDA6,
+     0xAE2D48C5, 0x48A2E6D1, 0x92A66E30, 0xD23ADFA0, 0x777BBAD7, 0x846A0521, 0x8D945A48, 0x39B48A8F},
+    {0x71DBB533, 0x0580757B, 0xEA76DD8A, 0x8224AC98, 0x93EFCBDF, 0x50568B78, 0xB691B1D5, 0xD84EE3AD,
+     0x2A6FD47E, 0x43285F2F, 0xE8F4F883, 0x28CC5DE6, 0x9BD4B519, 0x0C3DD298, 0xE654FE91, 0x37CCCACD},
+    {0x79104E8C, 0x5EC68864, 0x33A30CA2, 0x9E8F2022, 0x98C36583, 0xEBCDBDF6, 0xFA2B2E6D, 0xEFDF47B3,
+     0xB9534354, 0x09DBFA02, 0x6B341368, 0xCA742A27, 0x531EA8B9, 0xF3BBFE77, 0x40EF4926, 0x14024D33},
+    {0x2E0C808C, 0x641C0AC3, 0xBDF6014B, 0xF94E27AE, 0x96B83497, 0xD852D6EE, 0x08ECD22E, 0x29354093,
+     0x86784291, 0xD2E8BC3E, 0xC87719E1, 0x4182EDC4, 0x91E38552, 0x872E0B78, 0xCFD20E55, 0x4370376E},
+    {0x756D57E4, 0xBF7CD8B1, 0x7DC9DE3A, 0x08793BC5, 0x6A0FE12B, 0x6101122B, 0xB22AC685, 0x82C6E882,
+     0x1C1A0017, 0x571D6E99, 0x288AE6CB, 0xBA089B7C, 0x64C2A98B, 0xFC3D98F2, 0x0ACB8078, 0x7B725E73},
+    {0x6CFB8564, 0x93E19FB2, 0x23946860, 0x0F81877F, 0xCA982AFB, 0xBD2AFF1F, 0x01293165, 0xCC74CD68,
+     0x26A5EDB5, 0x219225DE, 0x2AFBD8D9, 0x978C7D95, 0x0BB2438E, 0xB3D6861F, 0xC44975B1, 0x9BEC382A},
+    {0xFDD34A0F, 0xCC9B8742, 0x35FF0A2C, 0xEA60680B, 0x6A024242, 0x1DE07CD3, 0x166506F4, 0xE34CE0B3,
+     0xD9564F39, 0x03D8EA39, 0x0EDAD628, 0x5E2C59E2, 0xBBB4ED3C, 0xFBA58565, 0x76A85B9C, 0x9419F13E},
+    {0x89CA648C, 0x4DF60403, 0x26A13611, 0xF8EC2887, 0x04355DE2, 0xC7B51BE8, 0xB909F42C, 0x622DF8E3,
+     0x44613645, 0x9FC42598, 0x74C3B383, 0xE54F74C1, 0x91D03459, 0xA8661068, 0x13ACEC79, 0xFC53849B},
+    {0xF9F59F55, 0xA3F0F005, 0x1E3FF7F9, 0x2943D0F6, 0x2FB5072E, 0x0F428509, 0xD743140A, 0xFA86CF25,
+     0x0D4A55F9, 0xB02D8C42, 0x912DA312, 0x3E6F7A81, 0xC5CB7E51, 0x4E5FDF1D, 0x0DB84557, 0x0853A220},
+    {0x4C06AC21, 0xBFBB2231, 0xCB61F145, 0x95F26E0A, 0x4B159C90, 0x7C183997, 0x917B6863, 0x55BA0675,
+     0x4C5BBF90, 0xD3754E8F, 0x95F9EB3F, 0xEE2B30A5, 0x3D31FDFC, 0xB1F92EB1, 0x8ACA3606, 0x518581CA},
+    {0x1CE796AF, 0x31D3ADE7, 0x3ED33567, 0x41CC2CF8, 0x7EDB461D, 0xBE171FBC, 0xFDF216C6, 0x861DF0AD,
+     0x344B4679, 0x404B4A44, 0xF1DE860B, 0xD1733EE6, 0xAB727E2C, 0x979F13A0, 0xC8D43BF2, 0x2F9BA179},
+    {0x95AE0B8B, 0xC80F1E04, 0x89E41EAA, 0x36D54686, 0x8C4E0101, 0xA06326E0, 0x6278A505, 0x52EB19E9,
+     0x418B0AA9, 0xDF9F9B73, 0xB30760AF, 0xECA98FD3, 0x7EC82EE3, 0x3FE28A62, 0xC4FA83FA, 0x30522F51},
+    {0xAA6DB9DA, 0x426E8695, 0x07614566, 0x0B99B951, 0xD5B069E0, 0x3D299ECE, 0x8CEED87F, 0xF063C141,
+     0x859305E9, 0x25433B4F, 0xB1068213, 0x6D685F2B, 0xBD9AD3C4, 0x021A0F27, 0x757AA161, 0x5EE2E71A},
+    {0x70B3ABC5, 0xE2267A16, 0x00AB424F, 0xE286646B, 0xDC2A3B52, 0x79AB9B5B, 0x6B316247, 0x0AF570E5,
+     0x923341EF, 0xF4DC2AC4, 0x18249CD6, 0x4DBE9F02, 0x80B3CCF5, 0x00601457, 0x100A4161, 0x29471239},
+    {0xA8BD5A0F, 0x0E8B4D85, 0xDA4104B4, 0x998E87C3, 0x10047893, 0xF0EE93C9, 0xA50EDE45, 0x17A455A2,
+     0x6666B8FA, 0x625C9441, 0x33B5D050, 0x8A568FFC, 0xF3E69D77, 0x1960C596, 0x779C7DD3, 0x4648F0C2},
+    {0xFA380150, 0xC724D4FF, 0x208CA99C, 0x6A75E56E, 0xA866E75E, 0xD277AB4B, 0xC766013C, 0x40E120F9,
+     0xAE903D8A, 0xFBAD89D7, 0xB135BAE2, 0x4F9EC4A6, 0xBFD8882F, 0xC5F9B119, 0x0B4E2C12, 0x62462871},
+    {0x24119ECB, 0x10EC327E, 0x8F61D12A, 0xAE2C83BB, 0xC3A7A5F1, 0x65A7FE6A, 0xCCD27729, 0x39970031,
+     0x1E7CD919, 0xB7ED3EAB, 0x18DA8ABE, 0x1E1FF2E4, 0x1AB64C05, 0xFD8F2C77, 0x17948FDB, 0x4812ACEC},
+    {0xA49E2B2C, 0x32F10AFC, 0xE78084EA, 0x202F2825, 0xEAE70291, 0x437B262F, 0x8E87FF19, 0xDF6E53DB,
+     0x9269F4CF, 0xE31AD22D, 0xCBFDEF98, 0x66859F06, 0xE865382B, 0xDC9817F8, 0xC18C2A31, 0x22BAE74A},
+    {0xE80B3BCA, 0xFDC8CD04, 0x0ECE8739, 0x8E369BA7, 0x9C5902C9, 0x10FC2098, 0xFF2B5C24, 0x82995502,
+     0x32ACE27B, 0xC4DA9105, 0x5863681A, 0x17191E1A, 0x18909862, 0xF75889FC, 0xAD119DB6, 0x436CCDC3},
+    {0x2EEB79DE, 0x8C8B20DF, 0xD05C7CA6, 0x51F0ACFE, 0x10108291, 0xD3D78F2E, 0x2E9BB2F7, 0xAC6981CF,
+     0xBBA02769, 0xD2729FAD, 0x24C7AF63, 0x0A00DEA6, 0x25E95436, 0xB06A47E5, 0x3ABB72A0, 0xE14C2D0A},
+    {0x66ED695A, 0x98E8F87D, 0xE44BB1C4, 0x2F24F451, 0x52362A78, 0xB13D0106, 0xE4BBF8D8, 0xECEE738B,
+     0x6470BE64, 0x10520F17, 0x46885294, 0x4E622F3E, 0x35BD6C78, 0x213AB56C, 0x91F8F848, 0x81981694},
+    {0xAD9704C6, 0xA6B3BF1D, 0xBF4C58E1, 0xC15280A9, 0xFC094361, 0x45678DB4, 0xDA5F55D2, 0x999B17F6,
+     0xF9D097A4, 0x73F2726F, 0xA2C90E62, 0x6BD328E7, 0x60BF458D, 0x9CBA80F0, 0xCEA7D150, 0x594F680B},
+    {0x6E60CDEC, 0xA5C0F951, 0xE7053FE8, 0xA939A829, 0x54790876, 0xA5FB9CE4, 0xAA0BF6DF, 0x38E8412F,
+     0x7C88C8C2, 0x0DBC5E67, 0x17D34996, 0x96FF0943, 0x1177182F, 0xD5C6284E, 0xFAB92F7B, 0x4CCDF0BE},
+    {0x1BF8F537, 0x69C587DC, 0x598C2C3A, 0x437632C3, 0xD24EE157, 0x01FEE95E, 0x006A17E3, 0x18B8200B,
+     0x811C1508, 0x722B6DBE, 0x9A036E19, 0xEB12AAC0, 0xCCB34115, 0x95C71AB6, 0x56BBC1E6, 0x83B527A9},
+    {0x0F1E6861, 0xFE78FDFB, 0xC32A3B95, 0x9B99AC93, 0xE81B9679, 0x8D325B2C, 0x93DA826E, 0x93E2E3DF,
+     0xB3E32A11, 0x0D6C9249, 0x9AD92982, 0x50419EEC, 0x6F3B1935, 0x32AFDF8B, 0x60DD1566, 0xAA775F7D},
+    {0x159130B3, 0x1CE48653, 0xA7B64DB4, 0xF9E22120, 0x7056CAD8, 0x1435CC8A, 0xEE769AA2, 0x2F450B6D,
+     0x7237C3CE, 0x6AD84884, 0xF80BD852, 0x4FBE9DCE, 0x22CA4204, 0x13FBDAA1, 0x0A749D94, 0x06CEDD9D},
+    {0x3AD39F4A, 0x1406979C, 0x20B27BE0, 0x4DDCC282, 0x72349187, 0xEB29D274, 0x2E4D2FB5, 0x03BCD605,
+     0xA6D9E04E, 0xF4A57165, 0x347E2ED7, 0x7CC66C7D, 0x00721327, 0x5A1AE3A3, 0x67C9AE6C, 0xB1A09BBF},
+    {0xA1447C48, 0xB436B836, 0x2C3C3C6C, 0xEF655D2B, 0x585EAB68, 0x3479B5DC, 0xDE851355, 0x836DBA0F,
+     0x9FC6951F, 0xD12AAA2D, 0xCBF50BD1, 0x94C4762A, 0xCCA49131, 0xC8D9A76B, 0x99835F73, 0x9F1496D5},
+    {0x80AA06C9, 0x04C22933, 0x7520E92B, 0x4776AC5F, 0x11D43087, 0x5F5226CF, 0x4BE6C8C8, 0x2A1F0DBF,
+     0x5D4E1A4D, 0xCC003210, 0xA067EE73, 0xAA286A94, 0x3590A381, 0x3280931D, 0xAE7F4BF1, 0x7CE500B2},
+    {0x67BCC60E, 0x4D312ECF, 0x838AE542, 0xF7EDC046, 0x316730CD, 0xDE597447, 0x212D4650, 0x9E91A37E,
+     0xA20CA26C, 0xD74C3ABC, 0xA27EC1FA, 0x0B4F77B2, 0x1AA41E30, 0x352E752C, 0x36073049, 0xB526C6A2},
+    {0xE1927219, 0x9CA0ECF3, 0x4BBEB9B8, 0x40C1A07E, 0x16D2E1E8, 0x565BC2F5, 0x2496B086, 0x06BB1420,
+     0x5EF287A4, 0x6A5A4922, 0xF5C8D394, 0x963F709E, 0xE848979F, 0x13FBCB32, 0xF4772DD2, 0xCE7D8A1A},
+    {0x73F6EC7C, 0xD65827BA, 0x3FB9B450, 0x4B67CF90, 0x28CA9F17, 0xAFA23EA8, 0xBD746B49, 0xDEC835A5,
+     0xEDDD807A, 0xD3011042, 0x1632DF07, 0xE1F098C5, 0xC4ED86E6, 0x51923A45, 0xC5FED216, 0x41E45EB0},
+    {0x4EB7BC8F, 0x905F9524, 0xD6B96BB7, 0x76684EBA, 0x34D0425B, 0x4D6E5F12, 0xD2FED302, 0x27C25927,
+     0x4DCD0E4D, 0xBC261B97, 0x5639DFE4, 0x80F7F098, 0xEAF3D691, 0x29BAD030, 0xAB70E7AC, 0x272F6D25},
+    {0x6754CECA, 0xC74FDE67, 0xB035DC1C, 0x3F60EEBA, 0x35E3E287, 0xBD7A3560, 0x74FCE3B7, 0xB22D94A6,
+     0xF216E507, 0x5B6076C8, 0x5A098BAF, 0xB94C436C, 0xAC7331CA, 0xD4716C5D, 0x9C79167E, 0xA5878984},
+    {0x8033F10F, 0xD6CD0B38, 0xA823F2AF, 0x730F5622, 0xD4B8C0F8, 0xD3B972E6, 0xD8AEDA8A, 0x75AA325E,
+     0xC91A1FCC, 0xF4655F3E, 0x30E69B73, 0x7D607796, 0xF805BCB4, 0x114E0946, 0xCE347AF1, 0xF90A0D71},
+    {0xDAED6BBB, 0x71D1F6A6, 0xD4BDA73D, 0x651E1860, 0x7EC32472, 0xD84AB52A, 0x427A4051, 0xB3C17220,
+     0x8DD08F06, 0xD20F2DB1, 0x7F86EC4D, 0x8C74CD24, 0xAA8E479A, 0xCE9E7728, 0x35AFB9C5, 0x87CAE802},
+    {0xB4B18FF0, 0xD63BD93E, 0x0EF2C71D, 0xDEE0FA6A, 0xF2797CE7, 0x2BB6B15B, 0xC481599A, 0x0AD31DF8,
+     0x14C0EB8C, 0x0055F968, 0x6DB7D788, 0xA53A353C, 0xC7BB92BF, 0xD6676F13, 0xF2533B12, 0xEE614882},
+    {0x62E94E7A, 0x97B897A1, 0x82AD9158, 0xC1E02097, 0xF0DEAE69, 0x2A9BDFBB, 0x2A33F351, 0x6BABAC18,
+     0x9A017A8C, 0x7F0CE83D, 0xCBED1457, 0xB4E1EAB2, 0xA59760C1, 0x7481B3F9, 0xC0467890, 0x902F1ABC},
+    {0xADB310E0, 0x4507935D, 0x38176825, 0x88625569, 0xABA0C8B0, 0x37ECE1F5, 0x95D661D1, 0x217A6F02,
+     0x56641C8C, 0xF205BE76, 0xD04C4DCB, 0xFCE0FF33, 0x30FC6598, 0xC2BCAE31, 0xD561E5DB, 0xDB1B1A7E},
+    {0xF1AABFF4, 0x67A8EBB9, 0xB99D0743, 0x6DA6ECC7, 0xBF8AC481, 0x86FA6839, 0xFFA58847, 0x2757C0D1,
+     0x79C962B5, 0x4A043377, 0xC7F9FC98, 0x3BA1AC9B, 0x4CFB050B, 0xAC414BEB, 0x60BF85D6, 0x2724041A},
+    {0x364A03FE, 0xE6E8D5AB, 0x87E986AB, 0x6E4F836F, 0xE13CA62C, 0x99F03F62, 0xA2618723, 0xE665D189,
+     0x00ACDFE6, 0xB464CAF9, 0xABE01403, 0x37D29F02, 0x17C40C88, 0x4DFA5949, 0xFE53217E, 0x2AF78F3D},
+    {0xD4EB993D, 0x73EF93E3, 0x8AB5C3AE, 0x2BDA48C5, 0xDBCC862A, 0x76D36D78, 0xD1DEB80F, 0xBB3F895E,
+     0xED270D30, 0x4BC81FFF, 0xF38874C5, 0xC054D193, 0xF30BED02, 0xD78969FA, 0xB43165C1, 0x20B48DB6},
+    {0xCBFA21A3, 0x558E80A4, 0xFC097E65, 0xEF941516, 0xA4A11EA7, 0x88C34616, 0xFBB295F1, 0x5D0C2AB7,
+     0xE17EBAF9, 0xD3287C32, 0xE7184791, 0x59B14215, 0xB0340E64, 0x57185301, 0x0453238F, 0x58834A89},
+    {0x71BAB37D, 0x123CA5EC, 0x635DBAB0, 0xF21C043F, 0xC0FCFE88, 0x1A642894, 0xEAC44B2F, 0xBC486B02,
+     0xE758FC03, 0x3BED8CB2, 0x8C848222, 0x5FEF2E51, 0xF194DAE0, 0xEB739FAB, 0xA5ED760C, 0xB2CED007},
+    {0xA52FFAF6, 0x47306424, 0xF2E1F8C8, 0x8CAEA310, 0xCA8CF430, 0x676BE4DD, 0xE230600C, 0xAFF17BFD,
+     0x8070F607, 0xAD3BF6FE, 0x88A8230A, 0x03F2497E, 0x1E98DD70, 0x5E44DAE8, 0xB9D1F7FF, 0x0205F782},
+    {0x04FC6196, 0x2A8E4046, 0xACEC800A, 0x65ADAABC, 0x38254A9A, 0x11F30FB0, 0x40ED99B4, 0x18219378,
+     0xA3886F15, 0x3D17D338, 0xB94AF87A, 0x35E4389A, 0x53127F36, 0xA926234A, 0x0F4F0889, 0xF485AC2F},
+    {0x138A9906, 0xAF020866, 0x233E8696, 0x7D192D27, 0x56F59B85, 0x852260B0, 0x8A945946, 0x62F6627E,
+     0x26806503, 0x2AEDAC30, 0x9D81CD8E, 0x0195C815, 0x86A7C3A3, 0xFA20F0D4, 0xD7206A7A, 0xD6100EF2},
+    {0x6E97CD38, 0xFE5404F6, 0x74F24E06, 0x0DF22834, 0xD1AB6134, 0xE7892F13, 0x29C9D8F1, 0x860A2B04,
+     0xDEF29225, 0x31454383, 0x97290FF5, 0x1080EC90, 0x0294EC66, 0xDE027E23, 0x03F4AC14, 0xC9B4762D},
+    {0x564EFA22, 0x2BE3F5F5, 0x1EE27DEB, 0xC5F4CEF5, 0x0E25BD0D, 0x3B239E56, 0x9BF10706, 0xDAF3F4F1,
+     0x5B919A7D, 0x788294B5, 0xBF83CB15, 0x1BC79C9E, 0x1E312DCB, 0xE0642403, 0x051194CD, 0x7FFA38DF},
+};
+
+#else
+#error "Unsupported ECC_P256_COMB_TEETH, must be 0 or 4 to 8."
+#endif
+
+#endif // ECC_COMB_TABLE_H__
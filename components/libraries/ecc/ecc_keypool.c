@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is confidential property of Nordic Semiconductor. The use,
+ * copying, transfer or disclosure of such information is prohibited except by express written
+ * agreement with Nordic Semiconductor.
+ *
+ */
+
+/**
+ * @brief Pool of pre-generated P-256 key pairs.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nordic_common.h"
+#include "compiler_abstraction.h"
+#include "ecc_keypool.h"
+#if ECC_KEYPOOL_USE_SCHEDULER
+#include "app_scheduler.h"
+#endif
+
+#if ECC_KEYPOOL_SIZE < 1
+#error "ECC_KEYPOOL_SIZE must be at least 1."
+#endif
+
+#define KEYPOOL_N_SLOTS (ECC_KEYPOOL_SIZE + 1) /**< The ready key pairs, and the one in use. */
+
+typedef enum
+{
+    SLOT_EMPTY,
+    SLOT_READY,
+    SLOT_IN_USE,
+} slot_state_t;
+
+static __ALIGN(4) ecc_keypair_t m_keypairs[KEYPOOL_N_SLOTS];
+static slot_state_t             m_states[KEYPOOL_N_SLOTS];
+#if ECC_KEYPOOL_USE_SCHEDULER
+static bool                     m_refill_scheduled;
+#endif
+
+
+static int slot_find(slot_state_t state)
+{
+    for (int i = 0; i < KEYPOOL_N_SLOTS; i++)
+    {
+        if (m_states[i] == state)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+static ret_code_t slot_generate(int slot)
+{
+    ret_code_t err_code = ecc_p256_keypair_gen(m_keypairs[slot].sk, m_keypairs[slot].pk);
+    if (err_code == NRF_SUCCESS)
+    {
+        m_states[slot] = SLOT_READY;
+    }
+    return err_code;
+}
+
+
+#if ECC_KEYPOOL_USE_SCHEDULER
+static void refill_schedule(void);
+
+/* One key pair per call, so other scheduled events run in between. */
+static void refill_sched_handler(void * p_event_data, uint16_t event_size)
+{
+    UNUSED_PARAMETER(p_event_data);
+    UNUSED_PARAMETER(event_size);
+
+    m_refill_scheduled = false;
+
+    if (ecc_keypool_refill() == NRF_SUCCESS)
+    {
+        refill_schedule();
+    }
+}
+
+
+static void refill_schedule(void)
+{
+    if (!m_refill_scheduled && (slot_find(SLOT_EMPTY) >= 0))
+    {
+        m_refill_scheduled = (app_sched_event_put(NULL, 0, refill_sched_handler) == NRF_SUCCESS);
+    }
+}
+#endif
+
+
+void ecc_keypool_init(void)
+{
+    for (int i = 0; i < KEYPOOL_N_SLOTS; i++)
+    {
+        m_states[i] = SLOT_EMPTY;
+    }
+
+#if ECC_KEYPOOL_USE_SCHEDULER
+    m_refill_scheduled = false;
+    refill_schedule();
+#endif
+}
+
+
+ret_code_t ecc_keypool_refill(void)
+{
+    int slot = slot_find(SLOT_EMPTY);
+
+    if (slot < 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    return slot_generate(slot);
+}
+
+
+ret_code_t ecc_keypool_keypair_get(ecc_keypair_t const ** pp_keypair)
+{
+    int slot;
+    int in_use;
+
+    if(!pp_keypair)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    slot = slot_find(SLOT_READY);
+    if (slot < 0)
+    {
+        // The pool has run dry; generate one now. The slot in use is kept until this succeeds.
+        slot = slot_find(SLOT_EMPTY);
+        ret_code_t err_code = slot_generate(slot);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    in_use = slot_find(SLOT_IN_USE);
+    if (in_use >= 0)
+    {
+        m_states[in_use] = SLOT_EMPTY;
+    }
+
+    m_states[slot] = SLOT_IN_USE;
+    *pp_keypair    = &m_keypairs[slot];
+
+#if ECC_KEYPOOL_USE_SCHEDULER
+    refill_schedule();
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ecc_keypool_count_get(void)
+{
+    uint32_t count = 0;
+
+    for (int i = 0; i < KEYPOOL_N_SLOTS; i++)
+    {
+        if (m_states[i] == SLOT_READY)
+        {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is confidential property of Nordic Semiconductor. The use,
+ * copying, transfer or disclosure of such information is prohibited except by express written
+ * agreement with Nordic Semiconductor.
+ *
+ */
+
+/**
+ * @brief Pool of pre-generated P-256 key pairs.
+ *
+ * @details Key pairs are generated ahead of time, one at a time, from the scheduler or from the
+ *          application's idle loop, so that taking a fresh key pair at pairing time does not
+ *          include the cost of generating it.
+ */
+
+#ifndef ECC_KEYPOOL_H__
+#define ECC_KEYPOOL_H__
+
+#include <stdint.h>
+#include "nordic_common.h"
+#include "nrf_error.h"
+#include "sdk_errors.h"
+#include "ecc.h"
+
+#ifndef ECC_KEYPOOL_SIZE
+#define ECC_KEYPOOL_SIZE 2              /**< The number of key pairs kept ready, not counting the one in use. */
+#endif
+
+#ifndef ECC_KEYPOOL_USE_SCHEDULER
+#define ECC_KEYPOOL_USE_SCHEDULER 1     /**< Whether the pool refills itself through @ref app_scheduler. If 0, call @ref ecc_keypool_refill from the idle loop. */
+#endif
+
+/**@brief A P-256 key pair. Key pairs given out by the pool are word aligned. */
+typedef struct
+{
+    uint8_t sk[ECC_P256_SK_LEN]; /**< Private key. */
+    uint8_t pk[ECC_P256_PK_LEN]; /**< Public key. */
+} ecc_keypair_t;
+
+/**@brief Initialize the key pool and start filling it.
+ *
+ * @note @ref ecc_init must have been called. If @ref ECC_KEYPOOL_USE_SCHEDULER is 1, the
+ *       scheduler must be initialized.
+ */
+void ecc_keypool_init(void);
+
+/**@brief Generate one key pair if the pool is not full.
+ *
+ * @details Call from the idle loop when @ref ECC_KEYPOOL_USE_SCHEDULER is 0.
+ *
+ * @retval     NRF_SUCCESS              A key pair was generated.
+ * @retval     NRF_ERROR_NOT_FOUND      The pool is full.
+ * @retval     NRF_ERROR_INTERNAL       Internal error during key generation.
+ */
+ret_code_t ecc_keypool_refill(void);
+
+/**@brief Take a fresh key pair from the pool.
+ *
+ * @details The key pair stays valid until the next call to this function, when its slot is
+ *          regenerated. If the pool is empty, a key pair is generated before returning.
+ *
+ * @param[out]  pp_keypair  The key pair.
+ *
+ * @retval     NRF_SUCCESS              A key pair was returned.
+ * @retval     NRF_ERROR_NULL           NULL pointer provided.
+ * @retval     NRF_ERROR_INTERNAL       Internal error during key generation.
+ */
+ret_code_t ecc_keypool_keypair_get(ecc_keypair_t const ** pp_keypair);
+
+/**@brief Get the number of key pairs ready in the pool.
+ *
+ * @return The number of key pairs that can be taken without generating one.
+ */
+uint32_t ecc_keypool_count_get(void);
+
+#endif // ECC_KEYPOOL_H__
@@ -15,16 +15,27 @@
 #include "fds_internal_defs.h"
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
 #include "fstorage.h"
 #include "app_util.h"
+#include "app_profiler.h"
+#include "app_boot_trace.h"
 #include "nrf_error.h"
 
-#if defined(FDS_CRC_ENABLED)
+#if defined(FDS_CRC_ENABLED) || (FDS_CHECKPOINT_SLOTS > 0)
     #include "crc16.h"
 #endif
 
+#if (FDS_RETAINED_STATE_ENABLED)
+    #include "nrf_retained.h"
+#endif
+
+#if FDS_AUTO_GC_ENABLED && (FDS_AUTO_GC_IDLE_MS > 0)
+    #include "app_timer.h"
+#endif
+
 
 static void fs_event_handler(fs_evt_t const * const evt, fs_ret_t result);
 
@@ -66,6 +77,37 @@ static fds_swap_page_t      m_swap_page;
 // Garbage collection data.
 static fds_gc_data_t        m_gc;
 
+#if (FDS_LAZY_INIT)
+// Whether the initialization is going to promote the swap page to the page m_gc.cur_page.
+static bool                 m_init_promote;
+#endif
+
+#if (FDS_TXN_MAX_RECORDS > 0)
+// The record headers of the transaction being written.
+// Needs to be statically allocated since it will be written to flash.
+static fds_txn_t            m_txn;
+#endif
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+// The RAM record index.
+static fds_index_t          m_index;
+#endif
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+// The checkpoint being written. Needs to be statically allocated since it will be written to flash.
+static fds_checkpoint_t     m_checkpoint;
+#endif
+
+#if (FDS_RETAINED_STATE_ENABLED)
+// The snapshot of the page structures. Must not be cleared at startup.
+static fds_retained_t       m_retained NRF_RETAINED;
+#endif
+
+#if FDS_AUTO_GC_ENABLED && (FDS_AUTO_GC_IDLE_MS > 0)
+// Timer used to start GC once the queue has been idle for FDS_AUTO_GC_IDLE_MS.
+APP_TIMER_DEF(m_gc_idle_timer);
+#endif
+
 
 static void flag_set(fds_flags_t flag)
 {
@@ -89,6 +131,18 @@ static bool flag_is_set(fds_flags_t flag)
 }
 
 
+// Whether operations which write to flash can be queued.
+static bool op_can_be_queued(void)
+{
+#if (FDS_LAZY_INIT)
+    // Operations queued while the module is initializing are executed after the initialization.
+    return (flag_is_set(FDS_FLAG_INITIALIZED) || flag_is_set(FDS_FLAG_INIT_QUEUED));
+#else
+    return flag_is_set(FDS_FLAG_INITIALIZED);
+#endif
+}
+
+
 static void event_send(fds_evt_t const * const p_evt)
 {
     for (uint32_t user = 0; user < FDS_MAX_USERS; user++)
@@ -141,6 +195,22 @@ static void event_prepare(fds_op_t const * const p_op, fds_evt_t * const p_evt)
             p_evt->id = FDS_EVT_GC;
             break;
 
+        case FDS_OP_CHECKPOINT:
+            p_evt->id = FDS_EVT_CHECKPOINT;
+            break;
+
+        case FDS_OP_WRITE_TXN:
+            p_evt->id               = FDS_EVT_WRITE_TXN;
+            p_evt->txn.record_id    = p_op->txn.record_id;
+            p_evt->txn.record_count = p_op->txn.record_count;
+            break;
+
+        case FDS_OP_RING:
+            p_evt->id              = FDS_EVT_RING;
+            p_evt->ring.file_id    = p_op->ring.p_ring->file_id;
+            p_evt->ring.record_key = p_op->ring.p_ring->record_key;
+            break;
+
         default:
             // Should not happen.
             break;
@@ -151,7 +221,24 @@ static void event_prepare(fds_op_t const * const p_op, fds_evt_t * const p_evt)
 static bool header_is_valid(fds_header_t const * const p_header)
 {
     return ((p_header->ic.file_id    != FDS_FILE_ID_INVALID) &&
-            (p_header->tl.record_key != FDS_RECORD_KEY_DIRTY));
+            (p_header->tl.record_key != FDS_RECORD_KEY_DIRTY) &&
+            (p_header->tl.record_key != FDS_RECORD_KEY_TXN));
+}
+
+
+// Returns the number of words from a record header to the one that follows it.
+// The length of a transaction header spans all the records in the transaction. Until the
+// transaction is committed, the records are skipped together with the header. Once it has been
+// committed, only the header is skipped, so that the records which follow it can be found.
+static uint16_t record_stride(fds_header_t const * const p_header)
+{
+    if ((p_header->tl.record_key == FDS_RECORD_KEY_TXN) &&
+        (p_header->ic.file_id    != FDS_FILE_ID_INVALID))
+    {
+        return FDS_HEADER_SIZE;
+    }
+
+    return (FDS_HEADER_SIZE + p_header->tl.length_words);
 }
 
 
@@ -218,7 +305,7 @@ static bool page_has_space(uint16_t page, uint16_t length_words)
 {
     length_words += m_pages[page].write_offset;
     length_words += m_pages[page].words_reserved;
-    return (length_words < FDS_PAGE_SIZE);
+    return (length_words < FDS_PAGE_USABLE_SIZE);
 }
 
 
@@ -248,16 +335,21 @@ static ret_code_t page_from_record(uint16_t * const p_page, uint32_t const * con
 // Scan a page to determine how many words have been written to it.
 // This information is used to set the page write offset during initialization.
 // Additionally, this function updates the latest record ID as it proceeds.
-// If an invalid record header is found, the can_gc argument is set to true.
+// If an invalid record header is found, the can_gc argument is set to true, and the words it
+// occupies are accumulated in words_dirty.
+// The scan starts at scan_offset, which must be the offset of a record header or of the first
+// word not yet written. Records before it are assumed to have been accounted for already.
 static void page_scan(uint32_t const *       p_addr,
+                      uint16_t               scan_offset,
                       uint16_t       * const words_written,
+                      uint16_t       * const words_dirty,
                       bool           * const can_gc)
 {
     uint32_t const * const p_end_addr          = p_addr + FDS_PAGE_SIZE;
     bool                   dirty_record_found  = false;
 
-    p_addr         += FDS_PAGE_TAG_SIZE;
-    *words_written  = FDS_PAGE_TAG_SIZE;
+    p_addr         += scan_offset;
+    *words_written  = scan_offset;
 
     while ((p_addr < p_end_addr) && (*p_addr != FDS_ERASED_WORD))
     {
@@ -267,6 +359,11 @@ static void page_scan(uint32_t const *       p_addr,
         if (!header_is_valid(p_header))
         {
             dirty_record_found = true;
+
+            if (words_dirty != NULL)
+            {
+                *words_dirty += record_stride(p_header);
+            }
         }
         else
         {
@@ -278,8 +375,8 @@ static void page_scan(uint32_t const *       p_addr,
         }
 
         // Jump to the next record.
-        p_addr         += (FDS_HEADER_SIZE + p_header->tl.length_words);
-        *words_written += (FDS_HEADER_SIZE + p_header->tl.length_words);
+        p_addr         += record_stride(p_header);
+        *words_written += record_stride(p_header);
     }
 
     if (can_gc != NULL)
@@ -296,11 +393,35 @@ static void page_offsets_update(fds_page_t * const p_page, uint16_t length_words
 }
 
 
+#if (FDS_ERASE_COUNTERS)
+
+// Returns the erase counter of the virtual page at the given address.
+static uint32_t page_erase_count(uint32_t const * const p_page_addr)
+{
+    for (uint16_t i = 0; i < FDS_MAX_PAGES; i++)
+    {
+        if (m_pages[i].p_addr == p_page_addr)
+        {
+            return m_pages[i].erase_count;
+        }
+    }
+
+    return m_swap_page.erase_count;
+}
+
+#endif
+
+
 // Tags a page as swap, i.e., reserved for GC.
 static ret_code_t page_tag_write_swap()
 {
     // Needs to be statically allocated since it will be written to flash.
+#if (FDS_ERASE_COUNTERS)
+    static uint32_t page_tag_swap[] = {FDS_PAGE_TAG_MAGIC, FDS_PAGE_TAG_SWAP, 0};
+    page_tag_swap[FDS_PAGE_TAG_WORD_2] = m_swap_page.erase_count;
+#else
     static uint32_t const page_tag_swap[] = {FDS_PAGE_TAG_MAGIC, FDS_PAGE_TAG_SWAP};
+#endif
     return fs_store(&fs_config, m_swap_page.p_addr, page_tag_swap, FDS_PAGE_TAG_SIZE);
 }
 
@@ -309,7 +430,13 @@ static ret_code_t page_tag_write_swap()
 static ret_code_t page_tag_write_data(uint32_t const * const p_page_addr)
 {
     // Needs to be statically allocated since it will be written to flash.
+#if (FDS_ERASE_COUNTERS)
+    // When the swap is promoted, the erase counter is written again with the same value.
+    static uint32_t page_tag_data[] = {FDS_PAGE_TAG_MAGIC, FDS_PAGE_TAG_DATA, 0};
+    page_tag_data[FDS_PAGE_TAG_WORD_2] = page_erase_count(p_page_addr);
+#else
     static uint32_t const page_tag_data[] = {FDS_PAGE_TAG_MAGIC, FDS_PAGE_TAG_DATA};
+#endif
     return fs_store(&fs_config, p_page_addr, page_tag_data, FDS_PAGE_TAG_SIZE);
 }
 
@@ -321,7 +448,7 @@ static ret_code_t write_space_reserve(uint16_t length_words, uint16_t * p_page)
     bool           space_reserved  = false;
     uint16_t const total_len_words = length_words + FDS_HEADER_SIZE;
 
-    if (total_len_words >= FDS_PAGE_SIZE - FDS_PAGE_TAG_SIZE)
+    if (total_len_words >= FDS_PAGE_USABLE_SIZE - FDS_PAGE_TAG_SIZE)
     {
         return FDS_ERR_RECORD_TOO_LARGE;
     }
@@ -329,16 +456,44 @@ static ret_code_t write_space_reserve(uint16_t length_words, uint16_t * p_page)
     CRITICAL_SECTION_ENTER();
     for (uint16_t page = 0; page < FDS_MAX_PAGES; page++)
     {
-        if ((m_pages[page].page_type == FDS_PAGE_DATA) &&
+        bool page_is_data = (m_pages[page].page_type == FDS_PAGE_DATA);
+
+#if (FDS_LAZY_INIT)
+        // While the module is initializing, erased pages are going to be tagged as data, except
+        // the one which the swap page is going to be promoted to.
+        if ((m_pages[page].page_type == FDS_PAGE_ERASED) &&
+            (flag_is_set(FDS_FLAG_INIT_QUEUED))          &&
+            !(m_init_promote && (page == m_gc.cur_page)))
+        {
+            page_is_data = true;
+        }
+#endif
+
+        if ((page_is_data) &&
             (page_has_space(page, total_len_words)))
         {
+#if (FDS_ERASE_COUNTERS)
+            // Prefer the least-erased page, since the records written to it will cause it
+            // to be garbage collected, and thus erased, eventually.
+            if ((space_reserved) && (m_pages[page].erase_count >= m_pages[*p_page].erase_count))
+            {
+                continue;
+            }
+
+            space_reserved = true;
+            *p_page        = page;
+#else
             space_reserved = true;
             *p_page        = page;
-
-            m_pages[page].words_reserved += total_len_words;
             break;
+#endif
         }
     }
+
+    if (space_reserved)
+    {
+        m_pages[*p_page].words_reserved += total_len_words;
+    }
     CRITICAL_SECTION_EXIT();
 
     return (space_reserved) ? FDS_SUCCESS : FDS_ERR_NO_SPACE_IN_FLASH;
@@ -376,7 +531,7 @@ static bool record_find_next(uint16_t page, uint32_t const ** p_record)
     if (p_next_rec != NULL)
     {
         p_header    = ((fds_header_t*)p_next_rec);
-        p_next_rec += (FDS_HEADER_SIZE + p_header->tl.length_words);
+        p_next_rec += record_stride(p_header);
     }
     else
     {
@@ -398,7 +553,7 @@ static bool record_find_next(uint16_t page, uint32_t const ** p_record)
         else
         {
             // The record is not valid, jump to the next.
-            p_next_rec += (FDS_HEADER_SIZE + (p_header->tl.length_words));
+            p_next_rec += record_stride(p_header);
         }
     }
 
@@ -407,6 +562,331 @@ static bool record_find_next(uint16_t page, uint32_t const ** p_record)
 }
 
 
+#if (FDS_RECORD_INDEX_SIZE > 0)
+
+// Compares two index entries by file ID, record key, page and offset, in this order.
+static int32_t index_entry_cmp(fds_index_entry_t const * const p_a,
+                               fds_index_entry_t const * const p_b)
+{
+    if (p_a->file_id != p_b->file_id)
+    {
+        return (int32_t)p_a->file_id - (int32_t)p_b->file_id;
+    }
+    if (p_a->record_key != p_b->record_key)
+    {
+        return (int32_t)p_a->record_key - (int32_t)p_b->record_key;
+    }
+    if (p_a->page != p_b->page)
+    {
+        return (int32_t)p_a->page - (int32_t)p_b->page;
+    }
+    return (int32_t)p_a->offset - (int32_t)p_b->offset;
+}
+
+
+// Returns the position of the first entry which does not compare less than p_key.
+static uint16_t index_lower_bound(fds_index_entry_t const * const p_key)
+{
+    uint16_t lo = 0;
+    uint16_t hi = m_index.count;
+
+    while (lo < hi)
+    {
+        uint16_t const mid = lo + ((hi - lo) / 2);
+
+        if (index_entry_cmp(&m_index.entry[mid], p_key) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+// Fills in an index entry for a record stored on the given page.
+static void index_entry_from_record(fds_index_entry_t       * const p_entry,
+                                    uint16_t                        page,
+                                    uint32_t          const * const p_rec)
+{
+    fds_header_t const * const p_header = (fds_header_t*)p_rec;
+
+    p_entry->file_id    = p_header->ic.file_id;
+    p_entry->record_key = p_header->tl.record_key;
+    p_entry->page       = page;
+    p_entry->offset     = (uint16_t)(p_rec - m_pages[page].p_addr);
+}
+
+
+// Adds a record to the index. If the index is full, it is flagged as overflown and
+// searches fall back to scanning flash until the index is rebuilt.
+// NOTE: Must be called from within a critical section.
+static void index_insert(uint16_t page, uint32_t const * const p_rec)
+{
+    fds_index_entry_t entry;
+    uint16_t          pos;
+
+    if (m_index.overflow)
+    {
+        return;
+    }
+
+    if (m_index.count == FDS_RECORD_INDEX_SIZE)
+    {
+        m_index.overflow = true;
+        return;
+    }
+
+    index_entry_from_record(&entry, page, p_rec);
+    pos = index_lower_bound(&entry);
+
+    memmove(&m_index.entry[pos + 1], &m_index.entry[pos],
+            (m_index.count - pos) * sizeof(fds_index_entry_t));
+
+    m_index.entry[pos] = entry;
+    m_index.count++;
+}
+
+
+// Removes a record from the index. The record header must still be valid in flash.
+static void index_remove(uint32_t const * const p_rec)
+{
+    fds_index_entry_t entry;
+    uint16_t          page;
+    uint16_t          pos;
+
+    if (page_from_record(&page, p_rec) != FDS_SUCCESS)
+    {
+        return;
+    }
+
+    CRITICAL_SECTION_ENTER();
+    if (!m_index.overflow)
+    {
+        index_entry_from_record(&entry, page, p_rec);
+        pos = index_lower_bound(&entry);
+
+        if ((pos < m_index.count) && (index_entry_cmp(&m_index.entry[pos], &entry) == 0))
+        {
+            m_index.count--;
+            memmove(&m_index.entry[pos], &m_index.entry[pos + 1],
+                    (m_index.count - pos) * sizeof(fds_index_entry_t));
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Adds all valid records on a page to the index. The page is scanned outside of the critical
+// section: the new entries are staged at the end of the index, past its last entry, where
+// searches don't read. The critical section is only taken to move them into place.
+// NOTE: Other changes to the index are made from the same context, so they can't interleave.
+static void index_page_add(uint16_t page)
+{
+    uint32_t const * p_rec  = NULL;
+    uint16_t         staged = 0;
+
+    if (m_index.overflow)
+    {
+        return;
+    }
+
+    while (record_find_next(page, &p_rec))
+    {
+        if (m_index.count + staged == FDS_RECORD_INDEX_SIZE)
+        {
+            CRITICAL_SECTION_ENTER();
+            m_index.overflow = true;
+            CRITICAL_SECTION_EXIT();
+            return;
+        }
+
+        staged++;
+        index_entry_from_record(&m_index.entry[FDS_RECORD_INDEX_SIZE - staged], page, p_rec);
+    }
+
+    // Take the staged entries starting from the lowest slot. Each one is copied out before the
+    // index grows into its slot, and the index never grows into the remaining ones.
+    CRITICAL_SECTION_ENTER();
+    while (staged != 0)
+    {
+        fds_index_entry_t const entry = m_index.entry[FDS_RECORD_INDEX_SIZE - staged];
+        uint16_t          const pos   = index_lower_bound(&entry);
+
+        staged--;
+
+        memmove(&m_index.entry[pos + 1], &m_index.entry[pos],
+                (m_index.count - pos) * sizeof(fds_index_entry_t));
+
+        m_index.entry[pos] = entry;
+        m_index.count++;
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Removes all entries which refer to a page from the index.
+static void index_page_remove(uint16_t page)
+{
+    uint16_t kept = 0;
+
+    CRITICAL_SECTION_ENTER();
+    for (uint16_t i = 0; i < m_index.count; i++)
+    {
+        if (m_index.entry[i].page != page)
+        {
+            m_index.entry[kept++] = m_index.entry[i];
+        }
+    }
+    m_index.count = kept;
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Rebuilds the index from scratch by scanning all data pages.
+static void index_rebuild(void)
+{
+    CRITICAL_SECTION_ENTER();
+    m_index.count    = 0;
+    m_index.overflow = false;
+    CRITICAL_SECTION_EXIT();
+
+    for (uint16_t page = 0; page < FDS_MAX_PAGES; page++)
+    {
+        if (m_pages[page].page_type == FDS_PAGE_DATA)
+        {
+            index_page_add(page);
+        }
+    }
+}
+
+
+// Stops using the index until it is rebuilt. Used when an operation fails partway,
+// and the index might no longer reflect the contents of flash.
+static void index_invalidate(void)
+{
+    CRITICAL_SECTION_ENTER();
+    m_index.overflow = true;
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Returns true if the entry is located after the position stored in the token. Records are
+// returned in the same order in which record_find() scans flash, so that a search can continue
+// by scanning flash if the index overflows while it is in progress.
+static bool index_entry_is_after(fds_index_entry_t const * const p_entry,
+                                 fds_find_token_t  const * const p_token)
+{
+    if (p_token->p_addr == NULL)
+    {
+        return (p_entry->page >= p_token->page);
+    }
+
+    if (p_entry->page != p_token->page)
+    {
+        return (p_entry->page > p_token->page);
+    }
+
+    return (m_pages[p_entry->page].p_addr + p_entry->offset > p_token->p_addr);
+}
+
+
+// Searches the index for the next matching record after the position stored in the token.
+// Returns FDS_SUCCESS if a record is found, FDS_ERR_NOT_FOUND if there are no more matching
+// records and FDS_ERR_INTERNAL if the index can't be used and flash must be scanned instead.
+static ret_code_t index_find(uint16_t          const * const p_file_id,
+                             uint16_t          const * const p_record_key,
+                             fds_record_desc_t       * const p_desc,
+                             fds_find_token_t        * const p_token)
+{
+    fds_index_entry_t         key   = {0};
+    fds_index_entry_t const * p_hit = NULL;
+    uint16_t                  pos   = 0;
+    ret_code_t                ret   = FDS_ERR_NOT_FOUND;
+
+    CRITICAL_SECTION_ENTER();
+
+    if (m_index.overflow)
+    {
+        CRITICAL_SECTION_EXIT();
+        return FDS_ERR_INTERNAL;
+    }
+
+    // Entries are sorted by file ID then by record key, so only part of the index needs to be
+    // searched when the file ID is known.
+    if (p_file_id != NULL)
+    {
+        key.file_id    = *p_file_id;
+        key.record_key = (p_record_key != NULL) ? *p_record_key : 0;
+        pos            = index_lower_bound(&key);
+    }
+
+    for (; pos < m_index.count; pos++)
+    {
+        fds_index_entry_t const * const p_entry = &m_index.entry[pos];
+
+        if ((p_file_id != NULL) && (p_entry->file_id != *p_file_id))
+        {
+            // No more records in this file.
+            break;
+        }
+
+        if ((p_record_key != NULL) && (p_entry->record_key != *p_record_key))
+        {
+            if (p_file_id != NULL)
+            {
+                // No more records with this key in this file.
+                break;
+            }
+            continue;
+        }
+
+        if (!index_entry_is_after(p_entry, p_token))
+        {
+            continue;
+        }
+
+        // Entries with the same file ID and record key are sorted by location, so the first
+        // hit is the one to return. Otherwise keep looking for the match closest to the token.
+        if ((p_hit == NULL) ||
+            (p_entry->page < p_hit->page) ||
+            ((p_entry->page == p_hit->page) && (p_entry->offset < p_hit->offset)))
+        {
+            p_hit = p_entry;
+        }
+
+        if ((p_file_id != NULL) && (p_record_key != NULL))
+        {
+            break;
+        }
+    }
+
+    if (p_hit != NULL)
+    {
+        uint32_t const * const p_rec = m_pages[p_hit->page].p_addr + p_hit->offset;
+
+        p_token->page        = p_hit->page;
+        p_token->p_addr      = p_rec;
+
+        p_desc->record_id    = ((fds_header_t*)p_rec)->record_id;
+        p_desc->p_record     = p_rec;
+        p_desc->gc_run_count = m_gc.run_count;
+
+        ret = FDS_SUCCESS;
+    }
+
+    CRITICAL_SECTION_EXIT();
+
+    return ret;
+}
+
+#endif // FDS_RECORD_INDEX_SIZE > 0
+
+
 // Find a record given its descriptor and retrive the page in which the record is stored.
 // NOTE: Do not pass NULL as an argument for p_page.
 static bool record_find_by_desc(fds_record_desc_t * const p_desc, uint16_t * const p_page)
@@ -463,6 +943,15 @@ static ret_code_t record_find(uint16_t          const * const p_file_id,
         return FDS_ERR_NULL_ARG;
     }
 
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    // Look the record up in the index first. Only scan flash if the index can't be used.
+    ret_code_t const ret = index_find(p_file_id, p_record_key, p_desc, p_token);
+    if (ret != FDS_ERR_INTERNAL)
+    {
+        return ret;
+    }
+#endif
+
     // Begin (or resume) searching for a record.
     for (; p_token->page < FDS_MAX_PAGES; p_token->page++)
     {
@@ -524,12 +1013,10 @@ static void dirty_records_stat(uint16_t         page,
         if (!header_is_valid(p_header))
         {
             (*p_dirty_records) += 1;
-            (*p_word_count)    += p_header->tl.length_words;
-        }
-        else
-        {
-            p_rec += (FDS_HEADER_SIZE + (p_header->tl.length_words));
+            (*p_word_count)    += record_stride(p_header) - FDS_HEADER_SIZE;
         }
+
+        p_rec += record_stride(p_header);
     }
 }
 
@@ -552,13 +1039,26 @@ static bool queue_advance(void)
 }
 
 
-// Given a pointer to an element in the chunk queue, computes the pointer to
-// the next element in the queue. Handles wrap around.
-void chunk_queue_next(fds_record_chunk_t ** pp_chunk)
+// Moves the operation being executed to the back of the queue, so that the operations queued
+// behind it are executed first. The number of elements in the queue does not change.
+static void queue_requeue(void)
 {
-    if ((*pp_chunk) != &m_chunk_queue.chunk[FDS_CHUNK_QUEUE_SIZE - 1])
-    {
-        (*pp_chunk)++;
+    CRITICAL_SECTION_ENTER();
+    fds_op_t const op = m_op_queue.op[m_op_queue.rp];
+
+    m_op_queue.rp = (m_op_queue.rp + 1) % FDS_OP_QUEUE_SIZE;
+    m_op_queue.op[(m_op_queue.rp + m_op_queue.count - 1) % FDS_OP_QUEUE_SIZE] = op;
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Given a pointer to an element in the chunk queue, computes the pointer to
+// the next element in the queue. Handles wrap around.
+void chunk_queue_next(fds_record_chunk_t ** pp_chunk)
+{
+    if ((*pp_chunk) != &m_chunk_queue.chunk[FDS_CHUNK_QUEUE_SIZE - 1])
+    {
+        (*pp_chunk)++;
         return;
     }
 
@@ -582,12 +1082,46 @@ static void chunk_queue_get_and_advance(fds_record_chunk_t ** pp_chunk)
 
 static void chunk_queue_skip(fds_op_t const * const p_op)
 {
+    uint32_t chunk_count = 0;
+
     if ((p_op->op_code == FDS_OP_WRITE) ||
         (p_op->op_code == FDS_OP_UPDATE))
     {
-        m_chunk_queue.rp    += p_op->write.chunk_count;
-        m_chunk_queue.count -= p_op->write.chunk_count;
+        chunk_count = p_op->write.chunk_count;
+    }
+    else if (p_op->op_code == FDS_OP_WRITE_TXN)
+    {
+        chunk_count = p_op->txn.chunk_count;
     }
+
+    m_chunk_queue.rp     = (m_chunk_queue.rp + chunk_count) % FDS_CHUNK_QUEUE_SIZE;
+    m_chunk_queue.count -= chunk_count;
+}
+
+
+// Copies chunks to the back of the chunk queue.
+// NOTE: Must be called within a critical section, after checking that there is enough space.
+static void chunk_queue_push(uint32_t num_chunks, fds_record_chunk_t const * const p_chunk)
+{
+    uint32_t             idx;
+    fds_record_chunk_t * p_chunk_dst;
+
+    if (num_chunks == 0)
+    {
+        return;
+    }
+
+    idx = (m_chunk_queue.count + m_chunk_queue.rp) % FDS_CHUNK_QUEUE_SIZE;
+
+    p_chunk_dst = &m_chunk_queue.chunk[idx];
+
+    for (uint32_t i = 0; i < num_chunks; i++)
+    {
+        *p_chunk_dst = p_chunk[i];
+        chunk_queue_next(&p_chunk_dst);
+    }
+
+    m_chunk_queue.count += num_chunks;
 }
 
 
@@ -608,20 +1142,48 @@ static bool op_enqueue(fds_op_t           const * const p_op,
         m_op_queue.op[idx] = *p_op;
         m_op_queue.count++;
 
-        if (num_chunks != 0)
-        {
-            idx = (m_chunk_queue.count + m_chunk_queue.rp) % FDS_CHUNK_QUEUE_SIZE;
+#if (FDS_RETAINED_STATE_ENABLED)
+        // The snapshot no longer matches the contents of flash.
+        nrf_retained_invalidate(&m_retained.hdr);
+#endif
 
-            fds_record_chunk_t * p_chunk_dst;
-            p_chunk_dst = &m_chunk_queue.chunk[idx];
+        chunk_queue_push(num_chunks, p_chunk);
 
-            for (uint32_t i = 0; i < num_chunks; i++)
-            {
-                *p_chunk_dst = p_chunk[i];
-                chunk_queue_next(&p_chunk_dst);
-            }
+        ret = true;
+    }
+    CRITICAL_SECTION_EXIT();
+
+    return ret;
+}
+
+
+#if (FDS_TXN_MAX_RECORDS > 0)
+
+// Enqueue a transaction, together with the chunks of all its records.
+static bool op_enqueue_txn(fds_op_t     const * const p_op,
+                           fds_record_t const * const p_records,
+                           uint32_t                   num_chunks)
+{
+    uint32_t idx;
+    bool     ret = false;
 
-            m_chunk_queue.count += num_chunks;
+    CRITICAL_SECTION_ENTER();
+    if  ((m_op_queue.count    <= FDS_OP_QUEUE_SIZE - 1) &&
+         (m_chunk_queue.count <= FDS_CHUNK_QUEUE_SIZE - num_chunks))
+    {
+        idx = (m_op_queue.count + m_op_queue.rp) % FDS_OP_QUEUE_SIZE;
+
+        m_op_queue.op[idx] = *p_op;
+        m_op_queue.count++;
+
+#if (FDS_RETAINED_STATE_ENABLED)
+        // The snapshot no longer matches the contents of flash.
+        nrf_retained_invalidate(&m_retained.hdr);
+#endif
+
+        for (uint32_t i = 0; i < p_op->txn.record_count; i++)
+        {
+            chunk_queue_push(p_records[i].data.num_chunks, p_records[i].data.p_chunks);
         }
 
         ret = true;
@@ -631,6 +1193,186 @@ static bool op_enqueue(fds_op_t           const * const p_op,
     return ret;
 }
 
+#endif
+
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+
+static uint16_t checkpoint_crc_compute(fds_checkpoint_t const * const p_checkpoint)
+{
+    return crc16_compute((uint8_t const *)p_checkpoint, offsetof(fds_checkpoint_t, crc16), NULL);
+}
+
+
+static bool checkpoint_is_valid(fds_checkpoint_t const * const p_checkpoint)
+{
+    if ((p_checkpoint->magic != FDS_CHECKPOINT_MAGIC) ||
+        (p_checkpoint->crc16 != checkpoint_crc_compute(p_checkpoint)))
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < FDS_VIRTUAL_PAGES; i++)
+    {
+        if ((p_checkpoint->write_offset[i] < FDS_PAGE_TAG_SIZE) ||
+            (p_checkpoint->write_offset[i] >= FDS_PAGE_USABLE_SIZE) ||
+            (p_checkpoint->words_dirty[i]  >  p_checkpoint->write_offset[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// Returns the address of the first checkpoint slot on a page.
+static fds_checkpoint_t const * checkpoint_slots(uint32_t const * const p_page_addr)
+{
+    return (fds_checkpoint_t const *)(p_page_addr + FDS_PAGE_USABLE_SIZE);
+}
+
+
+// Finds the latest valid checkpoint. Checkpoints are only written to the swap page, and the swap
+// is erased before it is used to store data again. Therefore, a valid checkpoint on the swap page
+// was taken after the last time any data page was erased, and its offsets are a lower bound for
+// the write offsets of the data pages. Returns NULL if no valid checkpoint is found.
+static fds_checkpoint_t const * checkpoint_find(void)
+{
+    for (uint16_t i = 0; i < FDS_VIRTUAL_PAGES; i++)
+    {
+        uint32_t const * const p_page_addr = fs_config.p_start_addr + (i * FDS_PAGE_SIZE);
+
+        if (page_identify(p_page_addr) == FDS_PAGE_SWAP)
+        {
+            fds_checkpoint_t const * const p_slots  = checkpoint_slots(p_page_addr);
+            fds_checkpoint_t const *       p_latest = NULL;
+
+            // Slots are written in order; the last valid one is the latest.
+            for (uint16_t slot = 0; slot < FDS_CHECKPOINT_SLOTS; slot++)
+            {
+                if (p_slots[slot].magic == FDS_ERASED_WORD)
+                {
+                    break;
+                }
+                if (checkpoint_is_valid(&p_slots[slot]))
+                {
+                    p_latest = &p_slots[slot];
+                }
+            }
+
+            return p_latest;
+        }
+    }
+
+    return NULL;
+}
+
+
+// Writes a checkpoint to the first free slot of the swap page.
+static ret_code_t checkpoint_write(void)
+{
+    fds_checkpoint_t const * const p_slots = checkpoint_slots(m_swap_page.p_addr);
+    fs_ret_t                       ret;
+    uint16_t                       slot;
+
+    for (slot = 0; slot < FDS_CHECKPOINT_SLOTS; slot++)
+    {
+        if (p_slots[slot].magic == FDS_ERASED_WORD)
+        {
+            break;
+        }
+    }
+
+    if (slot == FDS_CHECKPOINT_SLOTS)
+    {
+        // All slots have been used. They will be freed by garbage collection.
+        return FDS_ERR_NO_SPACE_IN_FLASH;
+    }
+
+    memset(&m_checkpoint, 0x00, sizeof(fds_checkpoint_t));
+
+    m_checkpoint.magic         = FDS_CHECKPOINT_MAGIC;
+    m_checkpoint.latest_rec_id = m_latest_rec_id;
+
+    for (uint16_t i = 0; i < FDS_VIRTUAL_PAGES; i++)
+    {
+        m_checkpoint.write_offset[i] = FDS_PAGE_TAG_SIZE;
+    }
+
+    for (uint16_t i = 0; i < FDS_MAX_PAGES; i++)
+    {
+        if (m_pages[i].page_type == FDS_PAGE_DATA)
+        {
+            uint16_t const phy_page = (m_pages[i].p_addr - fs_config.p_start_addr) / FDS_PAGE_SIZE;
+            m_checkpoint.write_offset[phy_page] = m_pages[i].write_offset;
+            m_checkpoint.words_dirty[phy_page]  = m_pages[i].words_dirty;
+        }
+    }
+
+    m_checkpoint.crc16 = checkpoint_crc_compute(&m_checkpoint);
+
+    ret = fs_store(&fs_config, (uint32_t const *)&p_slots[slot],
+                   (uint32_t const *)&m_checkpoint, FDS_CHECKPOINT_SIZE);
+
+    return (ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Returns true if a page contains any dirty records.
+static bool page_has_dirty_records(uint16_t page)
+{
+    bool dirty_record_found = false;
+    uint16_t words_written;
+
+    page_scan(m_pages[page].p_addr, FDS_PAGE_TAG_SIZE, &words_written, NULL, &dirty_record_found);
+
+    return dirty_record_found;
+}
+
+#endif // FDS_CHECKPOINT_SLOTS > 0
+
+
+#if (FDS_RETAINED_STATE_ENABLED)
+
+// Restores the page structures from the retained snapshot. Returns false if there is no valid
+// snapshot, in which case the pages must be scanned.
+static bool retained_restore(void)
+{
+    bool const valid = nrf_retained_is_valid(&m_retained.hdr, FDS_RETAINED_MAGIC,
+                                             sizeof(fds_retained_t)) &&
+                       (m_retained.p_start_addr == fs_config.p_start_addr);
+
+    // A snapshot is only used by the initialization which follows it.
+    nrf_retained_invalidate(&m_retained.hdr);
+
+    if (!valid)
+    {
+        return false;
+    }
+
+    memcpy(m_pages, m_retained.pages, sizeof(m_pages));
+    m_swap_page     = m_retained.swap_page;
+    m_latest_rec_id = m_retained.latest_rec_id;
+    m_gc.run_count  = m_retained.gc_run_count;
+    m_gc.auto_armed = m_retained.gc_auto_armed;
+
+    // Records opened and space reserved before System OFF went away with the application state.
+    for (uint16_t i = 0; i < FDS_MAX_PAGES; i++)
+    {
+        m_pages[i].records_open   = 0;
+        m_pages[i].words_reserved = 0;
+    }
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    m_index = m_retained.index;
+#endif
+
+    return true;
+}
+
+#endif // FDS_RETAINED_STATE_ENABLED
+
 
 // This function is called during initialization to setup the page structure (m_pages) and
 // provide additional information regarding eventual further initialization steps.
@@ -640,6 +1382,24 @@ static fds_init_opts_t pages_init()
     // The index of the page being initialized in m_pages[].
     uint16_t page = 0;
 
+#if (FDS_ERASE_COUNTERS)
+    // The highest erase counter found in a page tag.
+    uint32_t erase_count_max = 0;
+#endif
+
+    // A previous, failed, initialization may have set the swap page.
+    m_swap_page.p_addr = NULL;
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+    // If a checkpoint is available, only scan the data written after it was taken.
+    fds_checkpoint_t const * const p_checkpoint = checkpoint_find();
+
+    if (p_checkpoint != NULL)
+    {
+        m_latest_rec_id = p_checkpoint->latest_rec_id;
+    }
+#endif
+
     for (uint16_t i = 0; i < FDS_VIRTUAL_PAGES; i++)
     {
         uint32_t        const * const p_page_addr = fs_config.p_start_addr + (i * FDS_PAGE_SIZE);
@@ -675,22 +1435,66 @@ static fds_init_opts_t pages_init()
                 break;
 
             case FDS_PAGE_DATA:
+            {
+                uint16_t scan_offset = FDS_PAGE_TAG_SIZE;
+
                 m_pages[page].page_type = FDS_PAGE_DATA;
                 m_pages[page].p_addr    = p_page_addr;
+
+#if (FDS_ERASE_COUNTERS)
+                m_pages[page].erase_count = p_page_addr[FDS_PAGE_TAG_WORD_2];
+                if (m_pages[page].erase_count > erase_count_max)
+                {
+                    erase_count_max = m_pages[page].erase_count;
+                }
+#endif
+
+                m_pages[page].words_dirty = 0;
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+                if (p_checkpoint != NULL)
+                {
+                    // Dirty records found by the scan below are added to those the checkpoint
+                    // accounted for.
+                    scan_offset               = p_checkpoint->write_offset[i];
+                    m_pages[page].words_dirty = p_checkpoint->words_dirty[i];
+                }
+#endif
                 // Scan the page to compute its write offset and determine whether or not the page
                 // can be garbage collected. Additionally, update the latest kwown record ID.
-                page_scan(p_page_addr, &m_pages[page].write_offset, &m_pages[page].can_gc);
+                page_scan(p_page_addr, scan_offset, &m_pages[page].write_offset,
+                          &m_pages[page].words_dirty, &m_pages[page].can_gc);
+
+                if (scan_offset != FDS_PAGE_TAG_SIZE)
+                {
+                    // Records covered by the checkpoint might have been deleted since it was
+                    // taken. Let GC find out whether there is anything to reclaim on this page.
+                    m_pages[page].can_gc = true;
+                }
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+                index_page_add(page);
+#endif
 
                 ret |= PAGE_DATA;
                 page++;
-
-                break;
+            }
+            break;
 
             case FDS_PAGE_SWAP:
                 m_swap_page.p_addr = p_page_addr;
+
+#if (FDS_ERASE_COUNTERS)
+                m_swap_page.erase_count = p_page_addr[FDS_PAGE_TAG_WORD_2];
+                if (m_swap_page.erase_count > erase_count_max)
+                {
+                    erase_count_max = m_swap_page.erase_count;
+                }
+#endif
+
                 // If the swap is promoted, this offset should be kept, otherwise,
                 // it should be set to FDS_PAGE_TAG_SIZE.
-                page_scan(p_page_addr, &m_swap_page.write_offset, NULL);
+                page_scan(p_page_addr, FDS_PAGE_TAG_SIZE, &m_swap_page.write_offset, NULL, NULL);
 
                 ret |= (m_swap_page.write_offset == FDS_PAGE_TAG_SIZE) ?
                         SWAP_EMPTY : SWAP_DIRTY;
@@ -702,6 +1506,23 @@ static fds_init_opts_t pages_init()
         }
     }
 
+#if (FDS_ERASE_COUNTERS)
+    // The counters of erased pages have been lost, for example because the device was reset
+    // before the page was tagged after being erased. Use the highest known counter instead.
+    for (uint16_t i = 0; i < FDS_MAX_PAGES; i++)
+    {
+        if (m_pages[i].page_type == FDS_PAGE_ERASED)
+        {
+            m_pages[i].erase_count = erase_count_max;
+        }
+    }
+
+    if ((m_swap_page.p_addr != NULL) && (page_identify(m_swap_page.p_addr) != FDS_PAGE_SWAP))
+    {
+        m_swap_page.erase_count = erase_count_max;
+    }
+#endif
+
     return (fds_init_opts_t)ret;
 }
 
@@ -750,6 +1571,30 @@ static ret_code_t record_header_write_finalize(fds_op_t * const p_op, uint32_t *
 }
 
 
+// Account for words on the given page which can be reclaimed by garbage collection.
+static void page_words_dirty_add(uint16_t page, uint16_t words)
+{
+    CRITICAL_SECTION_ENTER();
+    // This page can now be garbage collected.
+    m_pages[page].can_gc       = true;
+    m_pages[page].words_dirty += words;
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Account for a record which is being flagged as dirty on the given page.
+static void page_record_dirty(uint16_t page, uint32_t const * const p_record)
+{
+    fds_header_t const * const p_header = (fds_header_t const *)p_record;
+
+    page_words_dirty_add(page, FDS_HEADER_SIZE + p_header->tl.length_words);
+
+    CRITICAL_SECTION_ENTER();
+    m_gc.auto_armed = true;
+    CRITICAL_SECTION_EXIT();
+}
+
+
 static ret_code_t record_header_flag_dirty(uint32_t * const p_record)
 {
     // Flag the record as dirty.
@@ -780,11 +1625,14 @@ static ret_code_t record_find_and_delete(fds_op_t * const p_op)
         p_op->del.file_id    = p_header->ic.file_id;
         p_op->del.record_key = p_header->tl.record_key;
 
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        index_remove(desc.p_record);
+#endif
+
+        page_record_dirty(page, desc.p_record);
+
         // Flag the record as dirty.
         ret = record_header_flag_dirty((uint32_t*)desc.p_record);
-
-        // This page can now be garbage collected.
-        m_pages[page].can_gc = true;
     }
     else
     {
@@ -810,11 +1658,14 @@ static ret_code_t file_find_and_delete(fds_op_t * const p_op)
 
     if (ret == FDS_SUCCESS)
     {
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        index_remove(desc.p_record);
+#endif
+
+        page_record_dirty(tok.page, desc.p_record);
+
          // A record was found: flag it as dirty.
         ret = record_header_flag_dirty((uint32_t*)desc.p_record);
-
-        // This page can now be garbage collected.
-        m_pages[tok.page].can_gc = true;
     }
     else // FDS_ERR_NOT_FOUND
     {
@@ -882,8 +1733,9 @@ static bool crc_verify_success(uint16_t crc, uint16_t len_words, uint32_t const
 static void gc_init(void)
 {
     m_gc.run_count++;
-    m_gc.cur_page = 0;
-    m_gc.resume   = false;
+    m_gc.cur_page      = 0;
+    m_gc.pages_stepped = 0;
+    m_gc.resume        = false;
 
     // Setup which pages to GC. Defer checking for open records and the can_gc flag,
     // as other operations might change those while GC is running.
@@ -900,13 +1752,42 @@ static bool gc_page_next(uint16_t * const p_next_page)
 {
     bool ret = false;
 
-    for (uint16_t i = 0; i < FDS_MAX_PAGES; i++)
+    for (uint16_t n = 0; n < FDS_MAX_PAGES; n++)
     {
+#if (FDS_ERASE_COUNTERS)
+        // Consider the least-erased pages first.
+        uint16_t i = FDS_MAX_PAGES;
+
+        for (uint16_t j = 0; j < FDS_MAX_PAGES; j++)
+        {
+            if ((m_gc.do_gc_page[j]) &&
+                ((i == FDS_MAX_PAGES) || (m_pages[j].erase_count < m_pages[i].erase_count)))
+            {
+                i = j;
+            }
+        }
+
+        if (i == FDS_MAX_PAGES)
+        {
+            break;
+        }
+#else
+        uint16_t const i = n;
+#endif
+
         if (m_gc.do_gc_page[i])
         {
             // Do not attempt to GC this page again.
             m_gc.do_gc_page[i] = false;
 
+#if (FDS_CHECKPOINT_SLOTS > 0)
+            // The can_gc flag of pages initialized from a checkpoint is not accurate.
+            if ((m_pages[i].can_gc) && (!page_has_dirty_records(i)))
+            {
+                m_pages[i].can_gc = false;
+            }
+#endif
+
             // Only GC pages with no open records and with some records which have been deleted.
             if ((m_pages[i].records_open == 0) && (m_pages[i].can_gc == true))
             {
@@ -925,6 +1806,9 @@ static ret_code_t gc_swap_erase(void)
 {
     m_gc.state               = GC_DISCARD_SWAP;
     m_swap_page.write_offset = FDS_PAGE_TAG_SIZE;
+#if (FDS_ERASE_COUNTERS)
+    m_swap_page.erase_count++;
+#endif
 
     return fs_erase(&fs_config, m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE);
 }
@@ -941,6 +1825,9 @@ static ret_code_t gc_page_erase(void)
     {
         ret = fs_erase(&fs_config, m_pages[gc].p_addr, FDS_PHY_PAGES_IN_VPAGE);
         m_gc.state = GC_ERASE_PAGE;
+#if (FDS_ERASE_COUNTERS)
+        m_pages[gc].erase_count++;
+#endif
     }
     else
     {
@@ -1004,26 +1891,67 @@ static ret_code_t gc_tag_new_swap(void)
 }
 
 
-static ret_code_t gc_next_page(void)
+// GC has terminated. Reset the state.
+static ret_code_t gc_complete(void)
 {
-    if (!gc_page_next(&m_gc.cur_page))
-    {
-        // No pages left to GC; GC has terminated. Reset the state.
-        m_gc.state        = GC_BEGIN;
-        m_gc.cur_page     = 0;
-        m_gc.p_record_src = NULL;
+    m_gc.state        = GC_BEGIN;
+    m_gc.cur_page     = 0;
+    m_gc.p_record_src = NULL;
 
-        return FDS_OP_COMPLETED;
+    // Don't start GC automatically again until more records are deleted.
+    m_gc.auto_armed   = false;
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    // Space has been reclaimed; attempt to bring the index back in use.
+    if (m_index.overflow)
+    {
+        index_rebuild();
     }
+#endif
 
-    return gc_record_find_next();
+    return FDS_OP_COMPLETED;
 }
 
 
-// Update the swap page offeset after a record has been successfully copied to it.
-static void gc_update_swap_offset(void)
+#if (FDS_CHECKPOINT_SLOTS > 0)
+
+// Take a checkpoint of the page offsets once all pages have been garbage collected.
+// If the checkpoint can't be written, GC terminates without it.
+static ret_code_t gc_checkpoint_write(void)
 {
-    fds_header_t const * const p_header   = (fds_header_t*)m_gc.p_record_src;
+    m_gc.state = GC_CHECKPOINT;
+
+    if (checkpoint_write() != FDS_SUCCESS)
+    {
+        return gc_complete();
+    }
+
+    return FDS_OP_EXECUTING;
+}
+
+#endif
+
+
+static ret_code_t gc_next_page(void)
+{
+    if (!gc_page_next(&m_gc.cur_page))
+    {
+        // No pages left to GC.
+#if (FDS_CHECKPOINT_SLOTS > 0)
+        return gc_checkpoint_write();
+#else
+        return gc_complete();
+#endif
+    }
+
+    return gc_record_find_next();
+}
+
+
+// Update the swap page offeset after a record has been successfully copied to it.
+static void gc_update_swap_offset(void)
+{
+    fds_header_t const * const p_header   = (fds_header_t*)m_gc.p_record_src;
     uint16_t     const         record_len = FDS_HEADER_SIZE + p_header->tl.length_words;
 
     m_swap_page.write_offset += record_len;
@@ -1039,9 +1967,25 @@ static void gc_swap_pages(void)
     m_swap_page.p_addr            = m_pages[m_gc.cur_page].p_addr;
     m_pages[m_gc.cur_page].p_addr = p_addr;
 
+#if (FDS_ERASE_COUNTERS)
+    uint32_t const erase_count             = m_swap_page.erase_count;
+    m_swap_page.erase_count                = m_pages[m_gc.cur_page].erase_count;
+    m_pages[m_gc.cur_page].erase_count     = erase_count;
+#endif
+
     // Keep the offset for this page, but reset it for the swap.
     m_pages[m_gc.cur_page].write_offset = m_swap_page.write_offset;
     m_swap_page.write_offset            = FDS_PAGE_TAG_SIZE;
+
+    // Only valid records were copied.
+    m_pages[m_gc.cur_page].words_dirty  = 0;
+    m_pages[m_gc.cur_page].can_gc       = false;
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    // The records on this page have been copied to new locations.
+    index_page_remove(m_gc.cur_page);
+    index_page_add(m_gc.cur_page);
+#endif
 }
 
 
@@ -1075,9 +2019,15 @@ static void gc_state_advance(void)
             break;
 
         case GC_TAG_NEW_SWAP:
+            m_gc.pages_stepped++;
             m_gc.state = GC_NEXT_PAGE;
             break;
 
+        // The checkpoint was written.
+        case GC_CHECKPOINT:
+            m_gc.state = GC_COMPLETE;
+            break;
+
         default:
             // Should not happen.
             break;
@@ -1123,6 +2073,7 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
             {
                 flag_set(FDS_FLAG_INITIALIZED);
                 flag_clear(FDS_FLAG_INITIALIZING);
+                APP_BOOT_TRACE("fds_ready");
                 return FDS_OP_COMPLETED;
             }
         }
@@ -1130,6 +2081,9 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
 
         case FDS_OP_INIT_ERASE_SWAP:
             ret = fs_erase(&fs_config, m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE);
+#if (FDS_ERASE_COUNTERS)
+            m_swap_page.erase_count++;
+#endif
             // If the swap is going to be discarded then reset its write_offset.
             m_swap_page.write_offset = FDS_PAGE_TAG_SIZE;
             p_op->init.step          = FDS_OP_INIT_TAG_SWAP;
@@ -1147,12 +2101,23 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
             m_swap_page.p_addr = m_pages[gc].p_addr;
             m_pages[gc].p_addr = p_old_swap;
 
+#if (FDS_ERASE_COUNTERS)
+            uint32_t const old_swap_erase_count = m_swap_page.erase_count;
+            m_swap_page.erase_count = m_pages[gc].erase_count;
+            m_pages[gc].erase_count = old_swap_erase_count;
+#endif
+
             // Copy the offset from the swap to the new page.
             m_pages[gc].write_offset = m_swap_page.write_offset;
             m_swap_page.write_offset = FDS_PAGE_TAG_SIZE;
 
             m_pages[gc].page_type = FDS_PAGE_DATA;
             p_op->init.step       = FDS_OP_INIT_TAG_SWAP;
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+            // The records on the promoted page were not indexed by pages_init().
+            index_page_add(gc);
+#endif
         }
         break;
 
@@ -1179,13 +2144,17 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
     uint32_t   *       p_write_addr;
     fds_page_t * const p_page = &m_pages[p_op->write.page];
 
-    // This must persist across calls.
+    // These must persist across calls.
     static fds_record_desc_t desc = {0};
+    static uint16_t          desc_page;
 
     if (prev_ret != FS_SUCCESS)
     {
         // The previous operation has timed out, update offsets.
         page_offsets_update(p_page, p_op->write.header.tl.length_words);
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        index_invalidate();
+#endif
         return FDS_ERR_OPERATION_TIMEOUT;
     }
 
@@ -1201,11 +2170,10 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
             // If the old copy couldn't be found for any reason then the update should fail.
             // This prevents duplicates when queuing multiple updates of the same record.
 
-            uint16_t page;
             desc.p_record  = NULL;
             desc.record_id = p_op->write.record_to_delete;
 
-            if (!record_find_by_desc(&desc, &page))
+            if (!record_find_by_desc(&desc, &desc_page))
             {
                 return FDS_ERR_NOT_FOUND;
             }
@@ -1230,6 +2198,14 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
             break;
 
         case FDS_OP_WRITE_FLAG_DIRTY:
+#if (FDS_RECORD_INDEX_SIZE > 0)
+            // The new record is complete; replace the old one in the index.
+            CRITICAL_SECTION_ENTER();
+            index_insert(p_op->write.page, p_write_addr);
+            CRITICAL_SECTION_EXIT();
+            index_remove(desc.p_record);
+#endif
+            page_record_dirty(desc_page, desc.p_record);
             ret = record_header_flag_dirty((uint32_t*)desc.p_record);
             p_op->write.step = FDS_OP_WRITE_DONE;
             break;
@@ -1237,6 +2213,15 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
         case FDS_OP_WRITE_DONE:
             ret = FDS_OP_COMPLETED;
 
+#if (FDS_RECORD_INDEX_SIZE > 0)
+            if (p_op->op_code == FDS_OP_WRITE)
+            {
+                CRITICAL_SECTION_ENTER();
+                index_insert(p_op->write.page, p_write_addr);
+                CRITICAL_SECTION_EXIT();
+            }
+#endif
+
 #if defined(FDS_CRC_ENABLED)
             if (flag_is_set(FDS_FLAG_VERIFY_CRC))
             {
@@ -1273,6 +2258,10 @@ static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
 
     if (prev_ret != FS_SUCCESS)
     {
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        // The record was removed from the index, but might not have been flagged as dirty.
+        index_invalidate();
+#endif
         return FDS_ERR_OPERATION_TIMEOUT;
     }
 
@@ -1306,7 +2295,9 @@ static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
 }
 
 
-static ret_code_t gc_execute(uint32_t prev_ret)
+#if (FDS_CHECKPOINT_SLOTS > 0)
+
+static ret_code_t checkpoint_execute(uint32_t prev_ret, fds_op_t * const p_op)
 {
     ret_code_t ret;
 
@@ -1315,541 +2306,1662 @@ static ret_code_t gc_execute(uint32_t prev_ret)
         return FDS_ERR_OPERATION_TIMEOUT;
     }
 
-    if (m_gc.resume)
+    switch (p_op->checkpoint.step)
     {
-        m_gc.resume = false;
+        case FDS_OP_CHECKPOINT_WRITE:
+            ret = checkpoint_write();
+            p_op->checkpoint.step = FDS_OP_CHECKPOINT_DONE;
+            break;
+
+        case FDS_OP_CHECKPOINT_DONE:
+            ret = FDS_OP_COMPLETED;
+            break;
+
+        default:
+            ret = FDS_ERR_INTERNAL;
+            break;
     }
-    else
+
+    return ret;
+}
+
+#endif
+
+
+#if (FDS_TXN_MAX_RECORDS > 0)
+
+// Sets the next step of a transaction, after a record header or chunk has been written.
+static void txn_step_next(fds_op_t * const p_op)
+{
+    if (m_txn.chunk_count[p_op->txn.record] != 0)
     {
-        gc_state_advance();
+        p_op->txn.step = FDS_OP_TXN_RECORD_CHUNKS;
+        return;
     }
 
-    switch (m_gc.state)
-    {
-        case GC_NEXT_PAGE:
-            ret = gc_next_page();
-            break;
+    // The current record has been written.
+    p_op->txn.record++;
 
-        case GC_FIND_NEXT_RECORD:
-            ret = gc_record_find_next();
-            break;
+    p_op->txn.step = (p_op->txn.record < p_op->txn.record_count) ? FDS_OP_TXN_RECORD_HEADER :
+                                                                   FDS_OP_TXN_COMMIT;
+}
 
-        case GC_COPY_RECORD:
-            ret = gc_record_copy();
-            break;
 
-        case GC_ERASE_PAGE:
-            ret = gc_page_erase();
-            break;
+// Verifies the records of a committed transaction and adds them to the index.
+static ret_code_t txn_complete(fds_op_t const * const p_op, uint32_t const * const p_txn_addr)
+{
+    ret_code_t               ret      = FDS_OP_COMPLETED;
+    uint32_t const *         p_record = p_txn_addr + FDS_HEADER_SIZE;
 
-        case GC_PROMOTE_SWAP:
-            ret = gc_swap_promote();
-            break;
+    for (uint8_t i = 0; i < p_op->txn.record_count; i++)
+    {
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        CRITICAL_SECTION_ENTER();
+        index_insert(p_op->txn.page, p_record);
+        CRITICAL_SECTION_EXIT();
+#endif
 
-        case GC_TAG_NEW_SWAP:
-            ret = gc_tag_new_swap();
-            break;
+#if defined(FDS_CRC_ENABLED)
+        if (flag_is_set(FDS_FLAG_VERIFY_CRC))
+        {
+            if (!crc_verify_success(m_txn.record_header[i].ic.crc16,
+                                    m_txn.record_header[i].tl.length_words,
+                                    p_record))
+            {
+                ret = FDS_ERR_CRC_CHECK_FAILED;
+            }
+        }
+#endif
 
-        default:
-            // Should not happen.
-            ret = FDS_ERR_INTERNAL;
-            break;
+        p_record += (FDS_HEADER_SIZE + m_txn.record_header[i].tl.length_words);
     }
 
-    // Either FDS_OP_EXECUTING, FDS_OP_COMPLETED, FDS_ERR_BUSY or FDS_ERR_INTERNAL.
+    // The transaction header is not needed anymore.
+    page_words_dirty_add(p_op->txn.page, FDS_HEADER_SIZE);
+
     return ret;
 }
 
 
-static void queue_process(fs_ret_t result)
+static ret_code_t txn_execute(uint32_t prev_ret, fds_op_t * const p_op)
 {
     ret_code_t         ret;
-    fds_op_t   * const p_op = &m_op_queue.op[m_op_queue.rp];
+    fs_ret_t           fs_ret;
+    uint32_t   *       p_txn_addr;
+    fds_page_t * const p_page = &m_pages[p_op->txn.page];
 
-    switch (p_op->op_code)
+    // Compute the address of the transaction header.
+    p_txn_addr = (uint32_t*)(p_page->p_addr + p_page->write_offset);
+
+    if (prev_ret != FS_SUCCESS)
     {
-        case FDS_OP_INIT:
-            ret = init_execute(result, p_op);
-            break;
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        // The transaction might have been committed, but its records were not indexed.
+        index_invalidate();
+#endif
+        ret = FDS_ERR_OPERATION_TIMEOUT;
+    }
+    else
+    {
+        switch (p_op->txn.step)
+        {
+            case FDS_OP_TXN_HEADER_BEGIN:
+                // The record ID of the transaction header is not used, and is left erased.
+                fs_ret = fs_store(&fs_config, p_txn_addr + FDS_OFFSET_TL,
+                                  (uint32_t*)&m_txn.header.tl, FDS_HEADER_SIZE_TL);
+
+                p_op->txn.offset = FDS_HEADER_SIZE;
+                p_op->txn.step   = FDS_OP_TXN_RECORD_HEADER;
+                ret = (fs_ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+                break;
 
-        case FDS_OP_WRITE:
-        case FDS_OP_UPDATE:
-            ret = write_execute(result, p_op);
-            break;
+            case FDS_OP_TXN_RECORD_HEADER:
+                // The records can't be found until the transaction is committed, so there is
+                // no need to write the file ID last: write the whole header at once.
+                fs_ret = fs_store(&fs_config, p_txn_addr + p_op->txn.offset,
+                                  (uint32_t*)&m_txn.record_header[p_op->txn.record],
+                                  FDS_HEADER_SIZE);
 
-        case FDS_OP_DEL_RECORD:
-        case FDS_OP_DEL_FILE:
-            ret = delete_execute(result, p_op);
-            break;
+                p_op->txn.offset += FDS_HEADER_SIZE;
+                txn_step_next(p_op);
+                ret = (fs_ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+                break;
 
-        case FDS_OP_GC:
-            ret = gc_execute(result);
-            break;
+            case FDS_OP_TXN_RECORD_CHUNKS:
+            {
+                fds_record_chunk_t * p_chunk = NULL;
 
-        default:
-            ret = FDS_ERR_INTERNAL;
-            break;
+                // Retrieve the next chunk to be written.
+                chunk_queue_get_and_advance(&p_chunk);
+
+                fs_ret = fs_store(&fs_config, p_txn_addr + p_op->txn.offset,
+                                  p_chunk->p_data, p_chunk->length_words);
+
+                p_op->txn.offset += p_chunk->length_words;
+                p_op->txn.chunk_count--;
+                m_txn.chunk_count[p_op->txn.record]--;
+
+                txn_step_next(p_op);
+                ret = (fs_ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+            } break;
+
+            case FDS_OP_TXN_COMMIT:
+                // All records have been written. Writing the file ID of the transaction header
+                // makes all of them valid at once.
+                fs_ret = fs_store(&fs_config, p_txn_addr + FDS_OFFSET_IC,
+                                  (uint32_t*)&m_txn.header.ic, FDS_HEADER_SIZE_IC);
+
+                p_op->txn.step = FDS_OP_TXN_DONE;
+                ret = (fs_ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+                break;
+
+            case FDS_OP_TXN_DONE:
+                ret = txn_complete(p_op, p_txn_addr);
+                break;
+
+            default:
+                ret = FDS_ERR_INTERNAL;
+                break;
+        }
     }
 
     if (ret != FDS_OP_EXECUTING)
     {
-        fds_evt_t evt;
-
-        if (ret == FDS_OP_COMPLETED)
+        if ((ret != FDS_OP_COMPLETED) && (ret != FDS_ERR_CRC_CHECK_FAILED))
         {
-            evt.result = FDS_SUCCESS;
+            // The transaction was not committed. Its records will be removed by GC.
+            page_words_dirty_add(p_op->txn.page, FDS_HEADER_SIZE + p_op->txn.length_words);
         }
-        else
-        {
-            // Either FDS_ERR_BUSY, FDS_ERR_OPERATION_TIMEOUT,
-            // FDS_ERR_CRC_CHECK_FAILED or FDS_ERR_NOT_FOUND.
-            evt.result = ret;
 
-            // If this operation had any chunks in the queue, skip them.
-            chunk_queue_skip(p_op);
-        }
+        // There won't be another callback for this operation, so update the page offset now.
+        page_offsets_update(p_page, p_op->txn.length_words);
 
-        event_prepare(p_op, &evt);
-        event_send(&evt);
+        CRITICAL_SECTION_ENTER();
+        m_txn.queued = false;
+        CRITICAL_SECTION_EXIT();
+    }
 
-        // Advance the queue, and if there are any queued operations, process them.
-        if (queue_advance())
+    return ret;
+}
+
+#endif
+
+
+#if (FDS_RING_ENABLED)
+
+// The length of the data of a ring block, in 4-byte words.
+static uint16_t ring_block_length(fds_ring_t const * const p_ring)
+{
+    return (p_ring->slot_words * p_ring->slots_per_block);
+}
+
+
+// Counts the slots that have been written to a block. The first erased slot marks the end.
+static uint16_t ring_block_slot_count(fds_ring_t const * const p_ring,
+                                      uint32_t   const *       p_block,
+                                      uint16_t                 max_slots)
+{
+    uint32_t const * p_slot = p_block + FDS_OFFSET_DATA;
+    uint16_t         count;
+
+    for (count = 0; count < max_slots; count++)
+    {
+        bool slot_is_erased = true;
+
+        for (uint16_t i = 0; i < p_ring->slot_words; i++)
         {
-            queue_process(FS_SUCCESS);
+            if (p_slot[i] != FDS_ERASED_WORD)
+            {
+                slot_is_erased = false;
+                break;
+            }
         }
-        else
+
+        if (slot_is_erased)
         {
-            // No more elements in the queue. Clear the FDS_FLAG_PROCESSING flag,
-            // so that new operation can start processing the queue.
-            flag_clear(FDS_FLAG_PROCESSING);
+            break;
         }
+
+        p_slot += p_ring->slot_words;
     }
+
+    return count;
 }
 
 
-static void queue_start(void)
+// Reserves space for a new block and writes the first part of its header.
+static ret_code_t ring_block_begin(fds_ring_t * const p_ring)
 {
-    if (!flag_is_set(FDS_FLAG_PROCESSING))
+    ret_code_t     ret;
+    uint16_t       page;
+    uint16_t const length_words = ring_block_length(p_ring);
+
+    ret = write_space_reserve(length_words, &page);
+
+    if (ret != FDS_SUCCESS)
     {
-        flag_set(FDS_FLAG_PROCESSING);
-        queue_process(FS_SUCCESS);
+        return ret;
     }
+
+    CRITICAL_SECTION_ENTER();
+    p_ring->page    = page;
+    p_ring->p_block = m_pages[page].p_addr + m_pages[page].write_offset;
+    // The block is filled by several operations. Claim its space on the page right away, so
+    // that other records are written after it.
+    page_offsets_update(&m_pages[page], length_words);
+    // Prevent garbage collection from moving the block while it is being filled.
+    m_pages[page].records_open++;
+    CRITICAL_SECTION_EXIT();
+
+    p_ring->slots_used             = 0;
+    p_ring->header.tl.record_key   = p_ring->record_key;
+    p_ring->header.tl.length_words = length_words;
+    p_ring->header.ic.file_id      = p_ring->file_id;
+    p_ring->header.ic.crc16        = 0;
+    p_ring->header.record_id       = record_id_new();
+
+    ret = fs_store(&fs_config, (uint32_t*)p_ring->p_block + FDS_OFFSET_TL,
+                   (uint32_t*)&p_ring->header.tl, FDS_HEADER_SIZE_TL);
+
+    return (ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
 }
 
 
-static void fs_event_handler(fs_evt_t const * const p_evt, fs_ret_t result)
+static ret_code_t ring_block_write_id(fds_ring_t const * const p_ring)
 {
-    queue_process(result);
+    ret_code_t ret;
+
+    ret = fs_store(&fs_config, (uint32_t*)p_ring->p_block + FDS_OFFSET_ID,
+                   &p_ring->header.record_id, FDS_HEADER_SIZE_ID);
+
+    return (ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
 }
 
 
-// Enqueues write and update operations.
-static ret_code_t write_enqueue(fds_record_desc_t         * const p_desc,
-                                fds_record_t        const * const p_record,
-                                fds_reserve_token_t const * const p_tok,
-                                fds_op_code_t                     op_code)
+// Writes as many slots as fit in the block being filled.
+static ret_code_t ring_slots_write(fds_op_t * const p_op)
 {
-    ret_code_t ret;
-    fds_op_t   op;
-    uint16_t   page;
-    uint16_t   crc          = 0;
-    uint16_t   length_words = 0;
+    ret_code_t         ret;
+    fds_ring_t * const p_ring = p_op->ring.p_ring;
+    uint16_t           slots  = p_ring->slots_per_block - p_ring->slots_used;
 
-    if (!flag_is_set(FDS_FLAG_INITIALIZED))
+    if (slots > p_op->ring.slot_count)
     {
-        return FDS_ERR_NOT_INITIALIZED;
+        slots = p_op->ring.slot_count;
     }
 
-    if (p_record == NULL)
+    ret = fs_store(&fs_config,
+                   (uint32_t*)p_ring->p_block + FDS_OFFSET_DATA +
+                   (p_ring->slots_used * p_ring->slot_words),
+                   p_op->ring.p_data, slots * p_ring->slot_words);
+
+    p_ring->slots_used    += slots;
+    p_op->ring.p_data     += (slots * p_ring->slot_words);
+    p_op->ring.slot_count -= slots;
+
+    p_op->ring.step = (p_ring->slots_used == p_ring->slots_per_block) ? FDS_OP_RING_BLOCK_FINALIZE :
+                                                                        FDS_OP_RING_DONE;
+
+    return (ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Writes the last part of the block header, which makes the block valid.
+static ret_code_t ring_block_finalize(fds_ring_t * const p_ring)
+{
+    ret_code_t ret;
+
+#if defined(FDS_CRC_ENABLED)
+    // The slots have already been written to flash. The unused slots of a flushed block are
+    // erased, and are included in the CRC as such.
+    uint16_t crc;
+    crc = crc16_compute((uint8_t const *)&p_ring->header, 6, NULL);
+    crc = crc16_compute((uint8_t const *)(p_ring->p_block + FDS_OFFSET_ID),
+                        (FDS_HEADER_SIZE_ID + p_ring->header.tl.length_words) * sizeof(uint32_t),
+                        &crc);
+    p_ring->header.ic.crc16 = crc;
+#endif
+
+    ret = fs_store(&fs_config, (uint32_t*)p_ring->p_block + FDS_OFFSET_IC,
+                   (uint32_t*)&p_ring->header.ic, FDS_HEADER_SIZE_IC);
+
+    return (ret == FS_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Stops filling the current block. If the block is not valid, its space is left for GC.
+static void ring_block_close(fds_ring_t * const p_ring, bool block_is_valid)
+{
+    if (p_ring->p_block == NULL)
     {
-        return FDS_ERR_NULL_ARG;
+        return;
     }
 
-    if ((p_record->file_id == FDS_FILE_ID_INVALID) ||
-        (p_record->key     == FDS_RECORD_KEY_DIRTY))
+    CRITICAL_SECTION_ENTER();
+    m_pages[p_ring->page].records_open--;
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    if (block_is_valid)
     {
-        return FDS_ERR_INVALID_ARG;
+        index_insert(p_ring->page, p_ring->p_block);
     }
+#endif
+    CRITICAL_SECTION_EXIT();
 
-    if (!chunk_is_aligned(p_record->data.p_chunks,
-                          p_record->data.num_chunks))
+    if (!block_is_valid)
     {
-        return FDS_ERR_UNALIGNED_ADDR;
+        page_words_dirty_add(p_ring->page, FDS_HEADER_SIZE + p_ring->header.tl.length_words);
     }
 
-    // No space was previously reserved for this operation.
-    if (p_tok == NULL)
-    {
+    p_ring->p_block = NULL;
+}
+
+
+// Deletes the oldest block of a ring file, if it holds more than the maximum number of blocks.
+// Returns true if a block is being deleted.
+static bool ring_block_drop(fds_ring_t const * const p_ring, ret_code_t * const p_ret)
+{
+    fds_find_token_t  tok    = {0};
+    fds_record_desc_t desc   = {0};
+    fds_record_desc_t oldest = {0};
+    uint16_t          page   = 0;
+    uint16_t          blocks = 0;
+
+    while (record_find(&p_ring->file_id, &p_ring->record_key, &desc, &tok) == FDS_SUCCESS)
+    {
+        if ((blocks == 0) || (desc.record_id < oldest.record_id))
+        {
+            oldest = desc;
+            page   = tok.page;
+        }
+
+        blocks++;
+    }
+
+    if (blocks <= p_ring->max_blocks)
+    {
+        return false;
+    }
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    index_remove(oldest.p_record);
+#endif
+
+    page_record_dirty(page, oldest.p_record);
+
+    *p_ret = record_header_flag_dirty((uint32_t*)oldest.p_record);
+
+    return true;
+}
+
+
+static ret_code_t ring_execute(uint32_t prev_ret, fds_op_t * const p_op)
+{
+    ret_code_t         ret;
+    fds_ring_t * const p_ring = p_op->ring.p_ring;
+
+    if (prev_ret != FS_SUCCESS)
+    {
+        // The block being filled might be incomplete. Leave it, and start a new one next time.
+        ring_block_close(p_ring, false);
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        index_invalidate();
+#endif
+        return FDS_ERR_OPERATION_TIMEOUT;
+    }
+
+    switch (p_op->ring.step)
+    {
+        case FDS_OP_RING_BLOCK_BEGIN:
+            if (p_ring->p_block == NULL)
+            {
+                ret = ring_block_begin(p_ring);
+                p_op->ring.step = FDS_OP_RING_BLOCK_ID;
+                break;
+            }
+            // A block is being filled: write the slots to it.
+            // Fallthrough to FDS_OP_RING_SLOTS.
+
+        case FDS_OP_RING_SLOTS:
+            ret = ring_slots_write(p_op);
+            break;
+
+        case FDS_OP_RING_BLOCK_ID:
+            ret = ring_block_write_id(p_ring);
+            p_op->ring.step = FDS_OP_RING_SLOTS;
+            break;
+
+        case FDS_OP_RING_BLOCK_FINALIZE:
+            if (p_ring->p_block == NULL)
+            {
+                // Flushing, but no block is being filled.
+                ret = FDS_OP_COMPLETED;
+                break;
+            }
+            ret = ring_block_finalize(p_ring);
+            p_op->ring.step = FDS_OP_RING_DROP;
+            break;
+
+        case FDS_OP_RING_DROP:
+            // The block is complete.
+            ring_block_close(p_ring, true);
+
+            if (ring_block_drop(p_ring, &ret))
+            {
+                p_op->ring.step = (p_op->ring.slot_count != 0) ? FDS_OP_RING_BLOCK_BEGIN :
+                                                                 FDS_OP_RING_DONE;
+            }
+            else if (p_op->ring.slot_count != 0)
+            {
+                // The slots did not fit in the previous block. Continue in a new one.
+                ret = ring_block_begin(p_ring);
+                p_op->ring.step = FDS_OP_RING_BLOCK_ID;
+            }
+            else
+            {
+                ret = FDS_OP_COMPLETED;
+            }
+            break;
+
+        case FDS_OP_RING_DONE:
+            ret = FDS_OP_COMPLETED;
+            break;
+
+        default:
+            ret = FDS_ERR_INTERNAL;
+            break;
+    }
+
+    return ret;
+}
+
+#endif
+
+
+// Determines whether GC should let other queued operations run before moving on to the next page.
+static bool gc_should_yield(fds_op_t const * const p_op)
+{
+    if ((p_op->gc.max_pages == 0) || (m_gc.pages_stepped < p_op->gc.max_pages))
+    {
+        return false;
+    }
+
+    // Start counting pages for the next step.
+    m_gc.pages_stepped = 0;
+
+    // Only yield if there are operations waiting behind GC.
+    return (m_op_queue.count > 1);
+}
+
+
+static ret_code_t gc_execute(uint32_t prev_ret, fds_op_t const * const p_op)
+{
+    ret_code_t ret;
+
+    if (prev_ret != FS_SUCCESS)
+    {
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        index_invalidate();
+#endif
+        return FDS_ERR_OPERATION_TIMEOUT;
+    }
+
+    if (m_gc.resume)
+    {
+        m_gc.resume = false;
+    }
+    else
+    {
+        gc_state_advance();
+    }
+
+    if ((m_gc.state == GC_NEXT_PAGE) && gc_should_yield(p_op))
+    {
+        // Pick up from the next page when the operation is executed again.
+        m_gc.resume = true;
+        return FDS_OP_YIELD;
+    }
+
+    switch (m_gc.state)
+    {
+        case GC_NEXT_PAGE:
+            ret = gc_next_page();
+            break;
+
+        case GC_FIND_NEXT_RECORD:
+            ret = gc_record_find_next();
+            break;
+
+        case GC_COPY_RECORD:
+            ret = gc_record_copy();
+            break;
+
+        case GC_ERASE_PAGE:
+            ret = gc_page_erase();
+            break;
+
+        case GC_PROMOTE_SWAP:
+            ret = gc_swap_promote();
+            break;
+
+        case GC_TAG_NEW_SWAP:
+            ret = gc_tag_new_swap();
+            break;
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+        case GC_CHECKPOINT:
+            ret = gc_checkpoint_write();
+            break;
+#endif
+
+        case GC_COMPLETE:
+            ret = gc_complete();
+            break;
+
+        default:
+            // Should not happen.
+            ret = FDS_ERR_INTERNAL;
+            break;
+    }
+
+    // Either FDS_OP_EXECUTING, FDS_OP_COMPLETED, FDS_OP_YIELD, FDS_ERR_BUSY or FDS_ERR_INTERNAL.
+    return ret;
+}
+
+
+#if FDS_AUTO_GC_ENABLED
+
+static ret_code_t gc_enqueue(uint16_t max_pages);
+
+
+// Determines whether garbage collection should be started, based on the amount of dirty words
+// and free space on the data pages.
+static fds_gc_auto_t gc_auto_policy(void)
+{
+    uint32_t words_written = 0;
+    uint32_t words_dirty   = 0;
+    uint32_t words_free    = 0;
+
+    if (!m_gc.auto_armed || m_gc.queued)
+    {
+        return GC_AUTO_NONE;
+    }
+
+    for (uint16_t i = 0; i < FDS_MAX_PAGES; i++)
+    {
+        if (m_pages[i].page_type != FDS_PAGE_DATA)
+        {
+            continue;
+        }
+
+        words_written += m_pages[i].write_offset - FDS_PAGE_TAG_SIZE;
+        words_dirty   += m_pages[i].words_dirty;
+        words_free    += FDS_PAGE_USABLE_SIZE - m_pages[i].write_offset - m_pages[i].words_reserved;
+    }
+
+    if (words_dirty == 0)
+    {
+        // There is nothing to reclaim.
+        return GC_AUTO_NONE;
+    }
+
+    if ((FDS_AUTO_GC_FREE_WORDS_MIN > 0) && (words_free < FDS_AUTO_GC_FREE_WORDS_MIN))
+    {
+        return GC_AUTO_NOW;
+    }
+
+    if ((FDS_AUTO_GC_DIRTY_PERCENT > 0) &&
+        (words_dirty * 100 >= words_written * FDS_AUTO_GC_DIRTY_PERCENT))
+    {
+        return (FDS_AUTO_GC_IDLE_MS > 0) ? GC_AUTO_IDLE : GC_AUTO_NOW;
+    }
+
+    return GC_AUTO_NONE;
+}
+
+
+#if (FDS_AUTO_GC_IDLE_MS > 0)
+
+static void gc_idle_timeout_handler(void * p_context)
+{
+    // Only start GC if the queue is still idle. Otherwise, the policy is evaluated again once
+    // the queue is empty.
+    if (!flag_is_set(FDS_FLAG_PROCESSING) && (gc_auto_policy() != GC_AUTO_NONE))
+    {
+        (void)gc_enqueue(FDS_AUTO_GC_PAGES_PER_STEP);
+    }
+}
+
+#endif
+
+
+// Evaluates the GC policy and starts GC if necessary. Called when the queue becomes empty.
+static void gc_auto_start(void)
+{
+    switch (gc_auto_policy())
+    {
+        case GC_AUTO_NOW:
+            (void)gc_enqueue(FDS_AUTO_GC_PAGES_PER_STEP);
+            break;
+
+#if (FDS_AUTO_GC_IDLE_MS > 0)
+        case GC_AUTO_IDLE:
+            // Restart the timer, so that it expires FDS_AUTO_GC_IDLE_MS after the last operation.
+            (void)app_timer_stop(m_gc_idle_timer);
+            (void)app_timer_start(m_gc_idle_timer,
+                                  APP_TIMER_TICKS(FDS_AUTO_GC_IDLE_MS, FDS_AUTO_GC_TIMER_PRESCALER),
+                                  NULL);
+            break;
+#endif
+
+        default:
+            break;
+    }
+}
+
+#endif // FDS_AUTO_GC_ENABLED
+
+
+#if (FDS_LAZY_INIT)
+
+// Fail an operation that was queued behind an initialization which has failed.
+static ret_code_t op_cancel(fds_op_t const * const p_op)
+{
+    if ((p_op->op_code == FDS_OP_WRITE) || (p_op->op_code == FDS_OP_UPDATE))
+    {
+        // Release the space reserved for the record.
+        CRITICAL_SECTION_ENTER();
+        write_space_free(p_op->write.header.tl.length_words, p_op->write.page);
+        CRITICAL_SECTION_EXIT();
+    }
+
+    return FDS_ERR_NOT_INITIALIZED;
+}
+
+#endif
+
+
+static ret_code_t op_execute(fs_ret_t result, fds_op_t * const p_op)
+{
+#if (FDS_LAZY_INIT)
+    if ((p_op->op_code != FDS_OP_INIT) && !flag_is_set(FDS_FLAG_INITIALIZED))
+    {
+        // The operation was queued behind an initialization which has failed.
+        return op_cancel(p_op);
+    }
+#endif
+
+    switch (p_op->op_code)
+    {
+        case FDS_OP_INIT:
+            return init_execute(result, p_op);
+
+        case FDS_OP_WRITE:
+        case FDS_OP_UPDATE:
+            return write_execute(result, p_op);
+
+        case FDS_OP_DEL_RECORD:
+        case FDS_OP_DEL_FILE:
+            return delete_execute(result, p_op);
+
+        case FDS_OP_GC:
+            return gc_execute(result, p_op);
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+        case FDS_OP_CHECKPOINT:
+            return checkpoint_execute(result, p_op);
+#endif
+
+#if (FDS_TXN_MAX_RECORDS > 0)
+        case FDS_OP_WRITE_TXN:
+            return txn_execute(result, p_op);
+#endif
+
+#if (FDS_RING_ENABLED)
+        case FDS_OP_RING:
+            return ring_execute(result, p_op);
+#endif
+
+        default:
+            return FDS_ERR_INTERNAL;
+    }
+}
+
+
+static void queue_process(fs_ret_t result)
+{
+    ret_code_t         ret;
+    fds_op_t   * const p_op = &m_op_queue.op[m_op_queue.rp];
+
+    ret = op_execute(result, p_op);
+
+    if (ret == FDS_OP_YIELD)
+    {
+        // Let the operations queued behind this one run first.
+        queue_requeue();
+        queue_process(FS_SUCCESS);
+    }
+    else if (ret != FDS_OP_EXECUTING)
+    {
+        fds_evt_t evt;
+
+        if (p_op->op_code == FDS_OP_GC)
+        {
+            m_gc.queued = false;
+        }
+
+        if (p_op->op_code == FDS_OP_INIT)
+        {
+            flag_clear(FDS_FLAG_INIT_QUEUED);
+        }
+
+        if (ret == FDS_OP_COMPLETED)
+        {
+            evt.result = FDS_SUCCESS;
+        }
+        else
+        {
+            // Either FDS_ERR_BUSY, FDS_ERR_OPERATION_TIMEOUT,
+            // FDS_ERR_CRC_CHECK_FAILED or FDS_ERR_NOT_FOUND.
+            evt.result = ret;
+
+            // If this operation had any chunks in the queue, skip them.
+            chunk_queue_skip(p_op);
+        }
+
+        event_prepare(p_op, &evt);
+        event_send(&evt);
+
+        // Advance the queue, and if there are any queued operations, process them.
+        if (queue_advance())
+        {
+            queue_process(FS_SUCCESS);
+        }
+        else
+        {
+            // No more elements in the queue. Clear the FDS_FLAG_PROCESSING flag,
+            // so that new operation can start processing the queue.
+            flag_clear(FDS_FLAG_PROCESSING);
+
+#if FDS_AUTO_GC_ENABLED
+            gc_auto_start();
+#endif
+        }
+    }
+}
+
+
+static void queue_start(void)
+{
+    if (!flag_is_set(FDS_FLAG_PROCESSING))
+    {
+        PROFILE_BEGIN(APP_PROFILER_ID_FDS_QUEUE);
+
+        flag_set(FDS_FLAG_PROCESSING);
+        queue_process(FS_SUCCESS);
+
+        PROFILE_END(APP_PROFILER_ID_FDS_QUEUE);
+    }
+}
+
+
+// queue_process() calls itself for every queued operation it completes, so it is profiled from
+// its two entry points rather than from inside.
+static void fs_event_handler(fs_evt_t const * const p_evt, fs_ret_t result)
+{
+    PROFILE_BEGIN(APP_PROFILER_ID_FDS_QUEUE);
+    queue_process(result);
+    PROFILE_END(APP_PROFILER_ID_FDS_QUEUE);
+}
+
+
+// Enqueues write and update operations.
+#if defined(FDS_CRC_ENABLED)
+
+// Computes the CRC of a record from its header, which must be complete except for the CRC
+// field itself, and its data.
+static uint16_t record_crc_compute(fds_header_t const * const p_header,
+                                   fds_record_t const * const p_record)
+{
+    uint16_t crc;
+
+    // First, compute the CRC for the first 6 bytes of the header which contain the
+    // record key, length and file ID, then, compute the CRC of the record ID (4 bytes).
+    crc = crc16_compute((uint8_t*)p_header,             6, NULL);
+    crc = crc16_compute((uint8_t*)&p_header->record_id, 4, &crc);
+
+    for (uint32_t i = 0; i < p_record->data.num_chunks; i++)
+    {
+        // Compute the CRC for the record data.
+        crc = crc16_compute((uint8_t*)p_record->data.p_chunks[i].p_data,
+                            p_record->data.p_chunks[i].length_words * sizeof(uint32_t), &crc);
+    }
+
+    return crc;
+}
+
+#endif
+
+
+static ret_code_t write_enqueue(fds_record_desc_t         * const p_desc,
+                                fds_record_t        const * const p_record,
+                                fds_reserve_token_t const * const p_tok,
+                                fds_op_code_t                     op_code)
+{
+    ret_code_t ret;
+    fds_op_t   op;
+    uint16_t   page;
+    uint16_t   crc          = 0;
+    uint16_t   length_words = 0;
+
+    if (!op_can_be_queued())
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+
+    if (p_record == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if ((p_record->file_id == FDS_FILE_ID_INVALID) ||
+        (p_record->key     == FDS_RECORD_KEY_DIRTY) ||
+        (p_record->key     == FDS_RECORD_KEY_TXN))
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    if (!chunk_is_aligned(p_record->data.p_chunks,
+                          p_record->data.num_chunks))
+    {
+        return FDS_ERR_UNALIGNED_ADDR;
+    }
+
+    // No space was previously reserved for this operation.
+    if (p_tok == NULL)
+    {
         // Compute the total length of the record.
         for (uint32_t i = 0; i < p_record->data.num_chunks; i++)
         {
-            length_words += p_record->data.p_chunks[i].length_words;
-        }
+            length_words += p_record->data.p_chunks[i].length_words;
+        }
+
+        // Find a page where to write data.
+        ret = write_space_reserve(length_words, &page);
+
+        if (ret != FDS_SUCCESS)
+        {
+            // There is either not enough flash space available (FDS_ERR_NO_SPACE_IN_FLASH) or
+            // the record exceeds the virtual page size (FDS_ERR_RECORD_TOO_LARGE).
+#if FDS_AUTO_GC_ENABLED
+            if ((ret == FDS_ERR_NO_SPACE_IN_FLASH) && (FDS_AUTO_GC_FREE_WORDS_MIN > 0))
+            {
+                // Reclaim space, so that the write can be retried once GC has completed.
+                if (gc_auto_policy() != GC_AUTO_NONE)
+                {
+                    (void)gc_enqueue(FDS_AUTO_GC_PAGES_PER_STEP);
+                }
+            }
+#endif
+            return ret;
+        }
+    }
+    else
+    {
+        page         = p_tok->page;
+        length_words = p_tok->length_words;
+    }
+
+    // Initialize the operation.
+    op.op_code                      = op_code;
+    op.write.step                   = FDS_OP_WRITE_HEADER_BEGIN;
+    op.write.page                   = page;
+    op.write.chunk_count            = p_record->data.num_chunks;
+    op.write.chunk_offset           = FDS_OFFSET_DATA;
+    op.write.header.record_id       = record_id_new();
+    op.write.header.ic.file_id      = p_record->file_id;
+    op.write.header.tl.record_key   = p_record->key;
+    op.write.header.tl.length_words = length_words;
+
+    if (op_code == FDS_OP_UPDATE)
+    {
+        op.write.step             = FDS_OP_WRITE_FIND_RECORD;
+        // Save the record ID of the record to be updated.
+        op.write.record_to_delete = p_desc->record_id;
+    }
+
+#if defined (FDS_CRC_ENABLED)
+    crc = record_crc_compute(&op.write.header, p_record);
+#endif
+
+    op.write.header.ic.crc16 = crc;
+
+    // Attempt to enqueue the operation.
+    if (!op_enqueue(&op, p_record->data.num_chunks, p_record->data.p_chunks))
+    {
+        // No space availble in the queues. Cancel the reservation of flash space.
+        CRITICAL_SECTION_ENTER();
+        write_space_free(length_words, page);
+        CRITICAL_SECTION_EXIT();
+
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+     // Initialize the record descriptor, if provided.
+    if (p_desc != NULL)
+    {
+        p_desc->p_record       = NULL;
+        // Don't invoke record_id_new() again !
+        p_desc->record_id      = op.write.header.record_id;
+        p_desc->record_is_open = false;
+        p_desc->gc_run_count   = m_gc.run_count;
+    }
+
+    // Start processing the queue, if necessary.
+    queue_start();
+
+    return FDS_SUCCESS;
+}
+
+
+ret_code_t fds_register(fds_cb_t cb)
+{
+    ret_code_t ret;
+
+    CRITICAL_SECTION_ENTER();
+    if (m_users == FDS_MAX_USERS)
+    {
+        ret = FDS_ERR_USER_LIMIT_REACHED;
+    }
+    else
+    {
+        m_cb_table[m_users] = cb;
+        m_users++;
+
+        ret = FDS_SUCCESS;
+    }
+    CRITICAL_SECTION_EXIT();
+
+    return ret;
+}
+
+
+ret_code_t fds_init(void)
+{
+    fds_evt_t const evt_success = { .id = FDS_EVT_INIT, .result = FDS_SUCCESS };
+
+    // No initialization is necessary. Notify the application immediately.
+    if (flag_is_set(FDS_FLAG_INITIALIZED))
+    {
+        event_send(&evt_success);
+        return FDS_SUCCESS;
+    }
+
+    if (flag_is_set(FDS_FLAG_INITIALIZING))
+    {
+        return FDS_SUCCESS;
+    }
+
+    flag_set(FDS_FLAG_INITIALIZING);
+
+#if FDS_AUTO_GC_ENABLED && (FDS_AUTO_GC_IDLE_MS > 0)
+    (void)app_timer_create(&m_gc_idle_timer, APP_TIMER_MODE_SINGLE_SHOT, gc_idle_timeout_handler);
+#endif
+
+    (void)fs_init();
+
+#if (FDS_RETAINED_STATE_ENABLED)
+    if (retained_restore())
+    {
+        // The file system was installed when the snapshot was taken. No scanning is necessary.
+        flag_set(FDS_FLAG_INITIALIZED);
+        flag_clear(FDS_FLAG_INITIALIZING);
+        APP_BOOT_TRACE("fds_ready");
+
+        event_send(&evt_success);
+        return FDS_SUCCESS;
+    }
+#endif
+
+    // Initialize the page structure (m_pages), and determine which
+    // initialization steps are required given the current state of the filesystem.
+    fds_init_opts_t init_opts = pages_init();
+
+    // Dirty records may have been left by a previous boot. Let the automatic GC policy look at
+    // them, so that the free space trigger works before any record is deleted.
+    m_gc.auto_armed = true;
+
+    if (init_opts == NO_PAGES)
+    {
+        flag_clear(FDS_FLAG_INITIALIZING);
+        return FDS_ERR_NO_PAGES;
+    }
+
+    if (init_opts == ALREADY_INSTALLED)
+    {
+        // No initialization is necessary. Notify the application immediately.
+        flag_set(FDS_FLAG_INITIALIZED);
+        flag_clear(FDS_FLAG_INITIALIZING);
+        APP_BOOT_TRACE("fds_ready");
+
+        event_send(&evt_success);
+        return FDS_SUCCESS;
+    }
+
+    fds_op_t op;
+    op.op_code = FDS_OP_INIT;
+
+    switch (init_opts)
+    {
+        case FRESH_INSTALL:
+        case TAG_SWAP:
+            op.init.step = FDS_OP_INIT_TAG_SWAP;
+            break;
+
+        case PROMOTE_SWAP:
+        case PROMOTE_SWAP_INST:
+            op.init.step = FDS_OP_INIT_PROMOTE_SWAP;
+            break;
+
+        case DISCARD_SWAP:
+            op.init.step = FDS_OP_INIT_ERASE_SWAP;
+            break;
+
+        case TAG_DATA:
+        case TAG_DATA_INST:
+            op.init.step = FDS_OP_INIT_TAG_DATA;
+            break;
+
+        default:
+            // Should not happen.
+            break;
+    }
+
+#if (FDS_LAZY_INIT)
+    m_init_promote = (op.init.step == FDS_OP_INIT_PROMOTE_SWAP);
+#endif
+
+    // This cannot fail since it will be the first operation in the queue.
+    (void)op_enqueue(&op, 0, NULL);
+    flag_set(FDS_FLAG_INIT_QUEUED);
+
+    queue_start();
+
+    return FDS_SUCCESS;
+}
+
+
+ret_code_t fds_record_open(fds_record_desc_t  * const p_desc,
+                           fds_flash_record_t * const p_flash_rec)
+{
+    uint16_t page;
+
+    if ((p_desc == NULL) || (p_flash_rec == NULL))
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    // Find the record if necessary.
+    if (record_find_by_desc(p_desc, &page))
+    {
+        fds_header_t const * const p_header = (fds_header_t*)p_desc->p_record;
+
+#if defined(FDS_CRC_ENABLED)
+        if (!crc_verify_success(p_header->ic.crc16,
+                                p_header->tl.length_words,
+                                p_desc->p_record))
+        {
+            return FDS_ERR_CRC_CHECK_FAILED;
+        }
+#endif
+
+        CRITICAL_SECTION_ENTER();
+        m_pages[page].records_open++;
+        CRITICAL_SECTION_EXIT();
+
+        // Initialize p_flash_rec.
+        p_flash_rec->p_header = p_header;
+        p_flash_rec->p_data   = (p_desc->p_record + FDS_HEADER_SIZE);
+
+        // Set the record as open in the descriptor.
+        p_desc->record_is_open = true;
+
+        return FDS_SUCCESS;
+    }
+
+    // The record could not be found.
+    // It either never existed or it has been deleted.
+    return FDS_ERR_NOT_FOUND;
+}
+
+
+ret_code_t fds_record_close(fds_record_desc_t * const p_desc)
+{
+    ret_code_t ret;
+    uint16_t   page;
+
+    if (p_desc == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if (record_find_by_desc((fds_record_desc_t*)p_desc, &page))
+    {
+        CRITICAL_SECTION_ENTER();
+        if ((m_pages[page].records_open > 0) && (p_desc->record_is_open))
+        {
 
-        // Find a page where to write data.
-        ret = write_space_reserve(length_words, &page);
+            m_pages[page].records_open--;
+            p_desc->record_is_open = false;
 
-        if (ret != FDS_SUCCESS)
+            ret = FDS_SUCCESS;
+        }
+        else
         {
-            // There is either not enough flash space available (FDS_ERR_NO_SPACE_IN_FLASH) or
-            // the record exceeds the virtual page size (FDS_ERR_RECORD_TOO_LARGE).
-            return ret;
+            ret = FDS_ERR_NO_OPEN_RECORDS;
         }
+        CRITICAL_SECTION_EXIT();
     }
     else
     {
-        page         = p_tok->page;
-        length_words = p_tok->length_words;
+        ret = FDS_ERR_NOT_FOUND;
     }
 
-    // Initialize the operation.
-    op.op_code                      = op_code;
-    op.write.step                   = FDS_OP_WRITE_HEADER_BEGIN;
-    op.write.page                   = page;
-    op.write.chunk_count            = p_record->data.num_chunks;
-    op.write.chunk_offset           = FDS_OFFSET_DATA;
-    op.write.header.record_id       = record_id_new();
-    op.write.header.ic.file_id      = p_record->file_id;
-    op.write.header.tl.record_key   = p_record->key;
-    op.write.header.tl.length_words = length_words;
+    return ret;
+}
 
-    if (op_code == FDS_OP_UPDATE)
-    {
-        op.write.step             = FDS_OP_WRITE_FIND_RECORD;
-        // Save the record ID of the record to be updated.
-        op.write.record_to_delete = p_desc->record_id;
-    }
 
-#if defined (FDS_CRC_ENABLED)
-    // First, compute the CRC for the first 6 bytes of the header which contain the
-    // record key, length and file ID, then, compute the CRC of the record ID (4 bytes).
-    crc = crc16_compute((uint8_t*)&op.write.header,           6, NULL);
-    crc = crc16_compute((uint8_t*)&op.write.header.record_id, 4, &crc);
+ret_code_t fds_reserve(fds_reserve_token_t * const p_tok, uint16_t length_words)
+{
+    ret_code_t ret;
+    uint16_t   page;
 
-    for (uint32_t i = 0; i < p_record->data.num_chunks; i++)
+    if (!op_can_be_queued())
     {
-        // Compute the CRC for the record data.
-        crc = crc16_compute((uint8_t*)p_record->data.p_chunks[i].p_data,
-                            p_record->data.p_chunks[i].length_words * sizeof(uint32_t), &crc);
+        return FDS_ERR_NOT_INITIALIZED;
     }
-#endif
-
-    op.write.header.ic.crc16 = crc;
 
-    // Attempt to enqueue the operation.
-    if (!op_enqueue(&op, p_record->data.num_chunks, p_record->data.p_chunks))
+    if (p_tok == NULL)
     {
-        // No space availble in the queues. Cancel the reservation of flash space.
-        CRITICAL_SECTION_ENTER();
-        write_space_free(length_words, page);
-        CRITICAL_SECTION_EXIT();
-
-        return FDS_ERR_NO_SPACE_IN_QUEUES;
+        return FDS_ERR_NULL_ARG;
     }
 
-     // Initialize the record descriptor, if provided.
-    if (p_desc != NULL)
+    ret = write_space_reserve(length_words, &page);
+
+    if (ret == FDS_SUCCESS)
     {
-        p_desc->p_record       = NULL;
-        // Don't invoke record_id_new() again !
-        p_desc->record_id      = op.write.header.record_id;
-        p_desc->record_is_open = false;
-        p_desc->gc_run_count   = m_gc.run_count;
+        p_tok->page         = page;
+        p_tok->length_words = length_words;
     }
 
-    // Start processing the queue, if necessary.
-    queue_start();
-
-    return FDS_SUCCESS;
+    return ret;
 }
 
 
-ret_code_t fds_register(fds_cb_t cb)
+ret_code_t fds_reserve_cancel(fds_reserve_token_t * const p_tok)
 {
     ret_code_t ret;
 
-    CRITICAL_SECTION_ENTER();
-    if (m_users == FDS_MAX_USERS)
+    if (!flag_is_set(FDS_FLAG_INITIALIZED))
     {
-        ret = FDS_ERR_USER_LIMIT_REACHED;
+        return FDS_ERR_NOT_INITIALIZED;
     }
-    else
+
+    if (p_tok == NULL)
     {
-        m_cb_table[m_users] = cb;
-        m_users++;
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if (p_tok->page > FDS_MAX_PAGES)
+    {
+        // The page does not exist. This shouldn't happen.
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    fds_page_t const * const p_page = &m_pages[p_tok->page];
+
+    CRITICAL_SECTION_ENTER();
+    if (p_page->words_reserved - (FDS_HEADER_SIZE + p_tok->length_words) >= 0)
+    {
+        // Free reserved space.
+        write_space_free(p_tok->length_words, p_tok->page);
 
+        // Clean the token.
+        p_tok->page         = 0;
+        p_tok->length_words = 0;
         ret = FDS_SUCCESS;
     }
+    else
+    {
+        // We are trying to cancel a reservation of more words than how many are
+        // currently reserved on the page. Clearly, this shouldn't happen.
+        ret = FDS_ERR_INVALID_ARG;
+    }
     CRITICAL_SECTION_EXIT();
 
     return ret;
 }
 
 
-ret_code_t fds_init(void)
+ret_code_t fds_record_write(fds_record_desc_t       * const p_desc,
+                            fds_record_t      const * const p_record)
 {
-    fds_evt_t const evt_success = { .id = FDS_EVT_INIT, .result = FDS_SUCCESS };
+    return write_enqueue(p_desc, p_record, NULL, FDS_OP_WRITE);
+}
 
-    // No initialization is necessary. Notify the application immediately.
-    if (flag_is_set(FDS_FLAG_INITIALIZED))
+
+ret_code_t fds_record_write_reserved(fds_record_desc_t         * const p_desc,
+                                     fds_record_t        const * const p_record,
+                                     fds_reserve_token_t const * const p_tok)
+{
+    // A NULL token is not allowed when writing to a reserved space.
+    if (p_tok == NULL)
     {
-        event_send(&evt_success);
-        return FDS_SUCCESS;
+        return FDS_ERR_NULL_ARG;
     }
 
-    if (flag_is_set(FDS_FLAG_INITIALIZING))
+    return write_enqueue(p_desc, p_record, p_tok, FDS_OP_WRITE);
+}
+
+
+ret_code_t fds_record_update(fds_record_desc_t       * const p_desc,
+                             fds_record_t      const * const p_record)
+{
+    // A NULL descriptor is not allowed when updating a record.
+    if (p_desc == NULL)
     {
-        return FDS_SUCCESS;
+        return FDS_ERR_NULL_ARG;
     }
 
-    flag_set(FDS_FLAG_INITIALIZING);
+    return write_enqueue(p_desc, p_record, NULL, FDS_OP_UPDATE);
+}
 
-    (void)fs_init();
 
-    // Initialize the page structure (m_pages), and determine which
-    // initialization steps are required given the current state of the filesystem.
-    fds_init_opts_t init_opts = pages_init();
+#if (FDS_TXN_MAX_RECORDS > 0)
 
-    if (init_opts == NO_PAGES)
+ret_code_t fds_record_write_txn(fds_record_desc_t       * const p_descs,
+                                fds_record_t      const * const p_records,
+                                uint8_t                         count)
+{
+    ret_code_t ret;
+    fds_op_t   op;
+    uint16_t   page;
+    uint32_t   record_id;
+    uint32_t   length_words = 0;
+    uint32_t   num_chunks   = 0;
+    bool       txn_queued;
+
+    if (!flag_is_set(FDS_FLAG_INITIALIZED))
     {
-        return FDS_ERR_NO_PAGES;
+        return FDS_ERR_NOT_INITIALIZED;
     }
 
-    if (init_opts == ALREADY_INSTALLED)
+    if (p_records == NULL)
     {
-        // No initialization is necessary. Notify the application immediately.
-        flag_set(FDS_FLAG_INITIALIZED);
-        flag_clear(FDS_FLAG_INITIALIZING);
+        return FDS_ERR_NULL_ARG;
+    }
 
-        event_send(&evt_success);
-        return FDS_SUCCESS;
+    if ((count == 0) || (count > FDS_TXN_MAX_RECORDS))
+    {
+        return FDS_ERR_INVALID_ARG;
     }
 
-    fds_op_t op;
-    op.op_code = FDS_OP_INIT;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        fds_record_t const * const p_record = &p_records[i];
 
-    switch (init_opts)
+        if ((p_record->file_id == FDS_FILE_ID_INVALID) ||
+            (p_record->key     == FDS_RECORD_KEY_DIRTY) ||
+            (p_record->key     == FDS_RECORD_KEY_TXN))
+        {
+            return FDS_ERR_INVALID_ARG;
+        }
+
+        if (!chunk_is_aligned(p_record->data.p_chunks,
+                              p_record->data.num_chunks))
+        {
+            return FDS_ERR_UNALIGNED_ADDR;
+        }
+
+        // Each record is written with its own header.
+        length_words += FDS_HEADER_SIZE;
+
+        for (uint32_t j = 0; j < p_record->data.num_chunks; j++)
+        {
+            length_words += p_record->data.p_chunks[j].length_words;
+        }
+
+        num_chunks += p_record->data.num_chunks;
+    }
+
+    if (length_words >= FDS_PAGE_USABLE_SIZE)
     {
-        case FRESH_INSTALL:
-        case TAG_SWAP:
-            op.init.step = FDS_OP_INIT_TAG_SWAP;
-            break;
+        return FDS_ERR_RECORD_TOO_LARGE;
+    }
 
-        case PROMOTE_SWAP:
-        case PROMOTE_SWAP_INST:
-            op.init.step = FDS_OP_INIT_PROMOTE_SWAP;
-            break;
+    if (num_chunks > FDS_CHUNK_QUEUE_SIZE)
+    {
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
 
-        case DISCARD_SWAP:
-            op.init.step = FDS_OP_INIT_ERASE_SWAP;
-            break;
+    CRITICAL_SECTION_ENTER();
+    txn_queued   = m_txn.queued;
+    m_txn.queued = true;
+    CRITICAL_SECTION_EXIT();
 
-        case TAG_DATA:
-        case TAG_DATA_INST:
-            op.init.step = FDS_OP_INIT_TAG_DATA;
-            break;
+    if (txn_queued)
+    {
+        // The record headers of the queued transaction are still in use.
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    // Find a page where to write all records, together with the transaction header.
+    ret = write_space_reserve(length_words, &page);
+
+    if (ret != FDS_SUCCESS)
+    {
+        m_txn.queued = false;
+        return ret;
+    }
+
+    // Allocate consecutive record IDs.
+    CRITICAL_SECTION_ENTER();
+    record_id        = m_latest_rec_id + 1;
+    m_latest_rec_id += count;
+    CRITICAL_SECTION_EXIT();
+
+    // The file ID is only written to commit the transaction.
+    m_txn.header.tl.record_key   = FDS_RECORD_KEY_TXN;
+    m_txn.header.tl.length_words = length_words;
+    m_txn.header.ic.file_id      = FDS_TXN_FILE_ID;
+    m_txn.header.ic.crc16        = 0;
+    m_txn.header.record_id       = FDS_ERASED_WORD;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        fds_header_t * const p_header = &m_txn.record_header[i];
+
+        p_header->record_id       = record_id + i;
+        p_header->ic.file_id      = p_records[i].file_id;
+        p_header->ic.crc16        = 0;
+        p_header->tl.record_key   = p_records[i].key;
+        p_header->tl.length_words = 0;
+
+        for (uint32_t j = 0; j < p_records[i].data.num_chunks; j++)
+        {
+            p_header->tl.length_words += p_records[i].data.p_chunks[j].length_words;
+        }
+
+#if defined(FDS_CRC_ENABLED)
+        p_header->ic.crc16 = record_crc_compute(p_header, &p_records[i]);
+#endif
+
+        m_txn.chunk_count[i] = p_records[i].data.num_chunks;
+    }
+
+    // Initialize the operation.
+    op.op_code          = FDS_OP_WRITE_TXN;
+    op.txn.step         = FDS_OP_TXN_HEADER_BEGIN;
+    op.txn.page         = page;
+    op.txn.length_words = length_words;
+    op.txn.offset       = 0;
+    op.txn.record       = 0;
+    op.txn.record_count = count;
+    op.txn.chunk_count  = num_chunks;
+    op.txn.record_id    = record_id;
+
+    // Attempt to enqueue the operation.
+    if (!op_enqueue_txn(&op, p_records, num_chunks))
+    {
+        // No space availble in the queues. Cancel the reservation of flash space.
+        CRITICAL_SECTION_ENTER();
+        write_space_free(length_words, page);
+        m_txn.queued = false;
+        CRITICAL_SECTION_EXIT();
 
-        default:
-            // Should not happen.
-            break;
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
     }
 
-    // This cannot fail since it will be the first operation in the queue.
-    (void)op_enqueue(&op, 0, NULL);
+    // Initialize the record descriptors, if provided.
+    if (p_descs != NULL)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            p_descs[i].p_record       = NULL;
+            p_descs[i].record_id      = record_id + i;
+            p_descs[i].record_is_open = false;
+            p_descs[i].gc_run_count   = m_gc.run_count;
+        }
+    }
 
+    // Start processing the queue, if necessary.
     queue_start();
 
     return FDS_SUCCESS;
 }
 
+#endif
+
 
-ret_code_t fds_record_open(fds_record_desc_t  * const p_desc,
-                           fds_flash_record_t * const p_flash_rec)
+ret_code_t fds_record_delete(fds_record_desc_t * const p_desc)
 {
-    uint16_t page;
+    fds_op_t op;
 
-    if ((p_desc == NULL) || (p_flash_rec == NULL))
+    if (!op_can_be_queued())
     {
-        return FDS_ERR_NULL_ARG;
+        return FDS_ERR_NOT_INITIALIZED;
     }
 
-    // Find the record if necessary.
-    if (record_find_by_desc(p_desc, &page))
+    if (p_desc == NULL)
     {
-        fds_header_t const * const p_header = (fds_header_t*)p_desc->p_record;
-
-#if defined(FDS_CRC_ENABLED)
-        if (!crc_verify_success(p_header->ic.crc16,
-                                p_header->tl.length_words,
-                                p_desc->p_record))
-        {
-            return FDS_ERR_CRC_CHECK_FAILED;
-        }
-#endif
-
-        CRITICAL_SECTION_ENTER();
-        m_pages[page].records_open++;
-        CRITICAL_SECTION_EXIT();
-
-        // Initialize p_flash_rec.
-        p_flash_rec->p_header = p_header;
-        p_flash_rec->p_data   = (p_desc->p_record + FDS_HEADER_SIZE);
+        return FDS_ERR_NULL_ARG;
+    }
 
-        // Set the record as open in the descriptor.
-        p_desc->record_is_open = true;
+    op.op_code              = FDS_OP_DEL_RECORD;
+    op.del.step             = FDS_OP_DEL_RECORD_FLAG_DIRTY;
+    op.del.record_to_delete = p_desc->record_id;
 
+    if (op_enqueue(&op, 0, NULL))
+    {
+        queue_start();
         return FDS_SUCCESS;
     }
 
-    // The record could not be found.
-    // It either never existed or it has been deleted.
-    return FDS_ERR_NOT_FOUND;
+   return FDS_ERR_NO_SPACE_IN_QUEUES;
 }
 
 
-ret_code_t fds_record_close(fds_record_desc_t * const p_desc)
+ret_code_t fds_file_delete(uint16_t file_id)
 {
-    ret_code_t ret;
-    uint16_t   page;
+    fds_op_t op;
 
-    if (p_desc == NULL)
+    if (!op_can_be_queued())
     {
-        return FDS_ERR_NULL_ARG;
+        return FDS_ERR_NOT_INITIALIZED;
     }
 
-    if (record_find_by_desc((fds_record_desc_t*)p_desc, &page))
+    if (file_id == FDS_FILE_ID_INVALID)
     {
-        CRITICAL_SECTION_ENTER();
-        if ((m_pages[page].records_open > 0) && (p_desc->record_is_open))
-        {
+        return FDS_ERR_INVALID_ARG;
+    }
 
-            m_pages[page].records_open--;
-            p_desc->record_is_open = false;
+    op.op_code      = FDS_OP_DEL_FILE;
+    op.del.step     = FDS_OP_DEL_FILE_FLAG_DIRTY;
+    op.del.file_id  = file_id;
 
-            ret = FDS_SUCCESS;
-        }
-        else
-        {
-            ret = FDS_ERR_NO_OPEN_RECORDS;
-        }
-        CRITICAL_SECTION_EXIT();
-    }
-    else
+    if (op_enqueue(&op, 0, NULL))
     {
-        ret = FDS_ERR_NOT_FOUND;
+        queue_start();
+        return FDS_SUCCESS;
     }
 
-    return ret;
+    return FDS_ERR_NO_SPACE_IN_QUEUES;
 }
 
 
-ret_code_t fds_reserve(fds_reserve_token_t * const p_tok, uint16_t length_words)
+static ret_code_t gc_enqueue(uint16_t max_pages)
 {
-    ret_code_t ret;
-    uint16_t   page;
+    fds_op_t op;
 
-    if (!flag_is_set(FDS_FLAG_INITIALIZED))
+    if (!op_can_be_queued())
     {
         return FDS_ERR_NOT_INITIALIZED;
     }
 
-    if (p_tok == NULL)
+    if (m_gc.queued)
     {
-        return FDS_ERR_NULL_ARG;
+        // GC is already queued or running; its completion will be reported.
+        return FDS_SUCCESS;
     }
 
-    ret = write_space_reserve(length_words, &page);
+    op.op_code      = FDS_OP_GC;
+    op.gc.max_pages = max_pages;
 
-    if (ret == FDS_SUCCESS)
+    if (op_enqueue(&op, 0, NULL))
     {
-        p_tok->page         = page;
-        p_tok->length_words = length_words;
+        if (m_gc.state != GC_BEGIN)
+        {
+            // Resume GC by retrying the last step.
+            m_gc.resume = true;
+        }
+
+        m_gc.queued = true;
+
+        queue_start();
+        return FDS_SUCCESS;
     }
 
-    return ret;
+    return FDS_ERR_NO_SPACE_IN_QUEUES;
 }
 
 
-ret_code_t fds_reserve_cancel(fds_reserve_token_t * const p_tok)
+ret_code_t fds_gc(void)
 {
-    ret_code_t ret;
+    return gc_enqueue(0);
+}
+
+
+ret_code_t fds_gc_step(uint16_t max_pages)
+{
+    if (max_pages == 0)
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    return gc_enqueue(max_pages);
+}
+
+
+#if (FDS_CHECKPOINT_SLOTS > 0)
+
+ret_code_t fds_checkpoint(void)
+{
+    fds_op_t op;
 
     if (!flag_is_set(FDS_FLAG_INITIALIZED))
     {
         return FDS_ERR_NOT_INITIALIZED;
     }
 
-    if (p_tok == NULL)
+    op.op_code         = FDS_OP_CHECKPOINT;
+    op.checkpoint.step = FDS_OP_CHECKPOINT_WRITE;
+
+    if (op_enqueue(&op, 0, NULL))
     {
-        return FDS_ERR_NULL_ARG;
+        queue_start();
+        return FDS_SUCCESS;
     }
 
-    if (p_tok->page > FDS_MAX_PAGES)
+    return FDS_ERR_NO_SPACE_IN_QUEUES;
+}
+
+#endif
+
+
+#if (FDS_RETAINED_STATE_ENABLED)
+
+ret_code_t fds_retain(void)
+{
+    ret_code_t ret = FDS_SUCCESS;
+
+    if (!flag_is_set(FDS_FLAG_INITIALIZED))
     {
-        // The page does not exist. This shouldn't happen.
-        return FDS_ERR_INVALID_ARG;
+        return FDS_ERR_NOT_INITIALIZED;
     }
 
-    fds_page_t const * const p_page = &m_pages[p_tok->page];
-
     CRITICAL_SECTION_ENTER();
-    if (p_page->words_reserved - (FDS_HEADER_SIZE + p_tok->length_words) >= 0)
+    // Only the state between operations can be restored.
+    if (flag_is_set(FDS_FLAG_PROCESSING) || (m_op_queue.count != 0) || (m_gc.state != GC_BEGIN))
     {
-        // Free reserved space.
-        write_space_free(p_tok->length_words, p_tok->page);
-
-        // Clean the token.
-        p_tok->page         = 0;
-        p_tok->length_words = 0;
-        ret = FDS_SUCCESS;
+        ret = FDS_ERR_BUSY;
     }
     else
     {
-        // We are trying to cancel a reservation of more words than how many are
-        // currently reserved on the page. Clearly, this shouldn't happen.
-        ret = FDS_ERR_INVALID_ARG;
+        memset(&m_retained, 0x00, sizeof(fds_retained_t));
+
+        m_retained.p_start_addr  = fs_config.p_start_addr;
+        m_retained.latest_rec_id = m_latest_rec_id;
+        m_retained.gc_run_count  = m_gc.run_count;
+        m_retained.gc_auto_armed = m_gc.auto_armed;
+        m_retained.swap_page     = m_swap_page;
+        memcpy(m_retained.pages, m_pages, sizeof(m_pages));
+#if (FDS_RECORD_INDEX_SIZE > 0)
+        m_retained.index         = m_index;
+#endif
+
+        nrf_retained_seal(&m_retained.hdr, FDS_RETAINED_MAGIC, sizeof(fds_retained_t));
     }
     CRITICAL_SECTION_EXIT();
 
     return ret;
 }
 
+#endif
 
-ret_code_t fds_record_write(fds_record_desc_t       * const p_desc,
-                            fds_record_t      const * const p_record)
-{
-    return write_enqueue(p_desc, p_record, NULL, FDS_OP_WRITE);
-}
 
+#if (FDS_RING_ENABLED)
 
-ret_code_t fds_record_write_reserved(fds_record_desc_t         * const p_desc,
-                                     fds_record_t        const * const p_record,
-                                     fds_reserve_token_t const * const p_tok)
+ret_code_t fds_ring_init(fds_ring_t * const p_ring,
+                         uint16_t           file_id,
+                         uint16_t           record_key,
+                         uint16_t           slot_words,
+                         uint16_t           slots_per_block,
+                         uint16_t           max_blocks)
 {
-    // A NULL token is not allowed when writing to a reserved space.
-    if (p_tok == NULL)
+    if (p_ring == NULL)
     {
         return FDS_ERR_NULL_ARG;
     }
 
-    return write_enqueue(p_desc, p_record, p_tok, FDS_OP_WRITE);
-}
-
+    if ((file_id    == FDS_FILE_ID_INVALID)  ||
+        (record_key == FDS_RECORD_KEY_DIRTY) ||
+        (record_key == FDS_RECORD_KEY_TXN)   ||
+        (slot_words == 0) || (slots_per_block == 0) || (max_blocks == 0))
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
 
-ret_code_t fds_record_update(fds_record_desc_t       * const p_desc,
-                             fds_record_t      const * const p_record)
-{
-    // A NULL descriptor is not allowed when updating a record.
-    if (p_desc == NULL)
+    if ((uint32_t)slot_words * slots_per_block + FDS_HEADER_SIZE >=
+        FDS_PAGE_USABLE_SIZE - FDS_PAGE_TAG_SIZE)
     {
-        return FDS_ERR_NULL_ARG;
+        return FDS_ERR_RECORD_TOO_LARGE;
     }
 
-    return write_enqueue(p_desc, p_record, NULL, FDS_OP_UPDATE);
+    memset(p_ring, 0x00, sizeof(fds_ring_t));
+
+    p_ring->file_id         = file_id;
+    p_ring->record_key      = record_key;
+    p_ring->slot_words      = slot_words;
+    p_ring->slots_per_block = slots_per_block;
+    p_ring->max_blocks      = max_blocks;
+    p_ring->p_block         = NULL;
+
+    return FDS_SUCCESS;
 }
 
 
-ret_code_t fds_record_delete(fds_record_desc_t * const p_desc)
+ret_code_t fds_ring_append(fds_ring_t       * const p_ring,
+                           void       const * const p_slots,
+                           uint16_t                 slot_count)
 {
     fds_op_t op;
 
@@ -1858,14 +3970,26 @@ ret_code_t fds_record_delete(fds_record_desc_t * const p_desc)
         return FDS_ERR_NOT_INITIALIZED;
     }
 
-    if (p_desc == NULL)
+    if ((p_ring == NULL) || (p_slots == NULL))
     {
         return FDS_ERR_NULL_ARG;
     }
 
-    op.op_code              = FDS_OP_DEL_RECORD;
-    op.del.step             = FDS_OP_DEL_RECORD_FLAG_DIRTY;
-    op.del.record_to_delete = p_desc->record_id;
+    if (slot_count == 0)
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    if (!is_word_aligned(p_slots))
+    {
+        return FDS_ERR_UNALIGNED_ADDR;
+    }
+
+    op.op_code         = FDS_OP_RING;
+    op.ring.step       = FDS_OP_RING_BLOCK_BEGIN;
+    op.ring.p_ring     = p_ring;
+    op.ring.p_data     = (uint32_t const *)p_slots;
+    op.ring.slot_count = slot_count;
 
     if (op_enqueue(&op, 0, NULL))
     {
@@ -1873,11 +3997,11 @@ ret_code_t fds_record_delete(fds_record_desc_t * const p_desc)
         return FDS_SUCCESS;
     }
 
-   return FDS_ERR_NO_SPACE_IN_QUEUES;
+    return FDS_ERR_NO_SPACE_IN_QUEUES;
 }
 
 
-ret_code_t fds_file_delete(uint16_t file_id)
+ret_code_t fds_ring_flush(fds_ring_t * const p_ring)
 {
     fds_op_t op;
 
@@ -1886,14 +4010,16 @@ ret_code_t fds_file_delete(uint16_t file_id)
         return FDS_ERR_NOT_INITIALIZED;
     }
 
-    if (file_id == FDS_FILE_ID_INVALID)
+    if (p_ring == NULL)
     {
-        return FDS_ERR_INVALID_ARG;
+        return FDS_ERR_NULL_ARG;
     }
 
-    op.op_code      = FDS_OP_DEL_FILE;
-    op.del.step     = FDS_OP_DEL_FILE_FLAG_DIRTY;
-    op.del.file_id  = file_id;
+    op.op_code         = FDS_OP_RING;
+    op.ring.step       = FDS_OP_RING_BLOCK_FINALIZE;
+    op.ring.p_ring     = p_ring;
+    op.ring.p_data     = NULL;
+    op.ring.slot_count = 0;
 
     if (op_enqueue(&op, 0, NULL))
     {
@@ -1905,32 +4031,62 @@ ret_code_t fds_file_delete(uint16_t file_id)
 }
 
 
-ret_code_t fds_gc(void)
+ret_code_t fds_ring_read(fds_ring_t       const * const p_ring,
+                         fds_ring_token_t       * const p_token,
+                         void             const **      pp_slots,
+                         uint16_t               * const p_slot_count)
 {
-    fds_op_t op;
+    fds_find_token_t  tok   = {0};
+    fds_record_desc_t desc  = {0};
+    fds_record_desc_t next  = {0};
+    bool              found = false;
 
     if (!flag_is_set(FDS_FLAG_INITIALIZED))
     {
         return FDS_ERR_NOT_INITIALIZED;
     }
 
-    op.op_code = FDS_OP_GC;
+    if ((p_ring == NULL) || (p_token == NULL) || (pp_slots == NULL) || (p_slot_count == NULL))
+    {
+        return FDS_ERR_NULL_ARG;
+    }
 
-    if (op_enqueue(&op, 0, NULL))
+    // Blocks are returned by increasing record ID, which is the order they were written in.
+    while (record_find(&p_ring->file_id, &p_ring->record_key, &desc, &tok) == FDS_SUCCESS)
     {
-        if (m_gc.state != GC_BEGIN)
+        if ((desc.record_id > p_token->record_id) &&
+            ((!found) || (desc.record_id < next.record_id)))
         {
-            // Resume GC by retrying the last step.
-            m_gc.resume = true;
+            next  = desc;
+            found = true;
         }
+    }
 
-        queue_start();
+    if (found)
+    {
+        fds_header_t const * const p_header = (fds_header_t*)next.p_record;
+
+        p_token->record_id = next.record_id;
+        *pp_slots          = next.p_record + FDS_OFFSET_DATA;
+        *p_slot_count      = ring_block_slot_count(p_ring, next.p_record,
+                                                   p_header->tl.length_words / p_ring->slot_words);
         return FDS_SUCCESS;
     }
 
-    return FDS_ERR_NO_SPACE_IN_QUEUES;
+    // The block being filled is not valid yet, and is returned last.
+    if ((p_ring->p_block != NULL) && (p_ring->header.record_id > p_token->record_id))
+    {
+        p_token->record_id = p_ring->header.record_id;
+        *pp_slots          = p_ring->p_block + FDS_OFFSET_DATA;
+        *p_slot_count      = ring_block_slot_count(p_ring, p_ring->p_block, p_ring->slots_used);
+        return FDS_SUCCESS;
+    }
+
+    return FDS_ERR_NOT_FOUND;
 }
 
+#endif
+
 
 ret_code_t fds_record_iterate(fds_record_desc_t * const p_desc,
                               fds_find_token_t  * const p_token)
@@ -1996,7 +4152,7 @@ ret_code_t fds_record_id_from_desc(fds_record_desc_t const * const p_desc,
 
 ret_code_t fds_stat(fds_stat_t * const p_stat)
 {
-    uint16_t const words_in_page = FDS_PAGE_SIZE - FDS_PAGE_TAG_SIZE;
+    uint16_t const words_in_page = FDS_PAGE_USABLE_SIZE - FDS_PAGE_TAG_SIZE;
     // The largest number of free contiguous words on any page.
     uint16_t       contig_words  = 0;
 
@@ -2019,6 +4175,18 @@ ret_code_t fds_stat(fds_stat_t * const p_stat)
 
         p_stat->open_records += m_pages[i].records_open;
         p_stat->words_used   += words_used;
+
+#if (FDS_ERASE_COUNTERS)
+        if ((i == 0) || (m_pages[i].erase_count < p_stat->erase_count_min))
+        {
+            p_stat->erase_count_min = m_pages[i].erase_count;
+        }
+
+        if (m_pages[i].erase_count > p_stat->erase_count_max)
+        {
+            p_stat->erase_count_max = m_pages[i].erase_count;
+        }
+#endif
         contig_words         =  (words_in_page - words_used);
 
         if (contig_words > p_stat->largest_contig)
@@ -2034,6 +4202,19 @@ ret_code_t fds_stat(fds_stat_t * const p_stat)
         dirty_records_stat(i, &p_stat->dirty_records, &p_stat->freeable_words);
     }
 
+#if (FDS_ERASE_COUNTERS)
+    // The swap page is erased as often as the data pages.
+    if (m_swap_page.erase_count < p_stat->erase_count_min)
+    {
+        p_stat->erase_count_min = m_swap_page.erase_count;
+    }
+
+    if (m_swap_page.erase_count > p_stat->erase_count_max)
+    {
+        p_stat->erase_count_max = m_swap_page.erase_count;
+    }
+#endif
+
     return FDS_SUCCESS;
 }
 
@@ -46,6 +46,14 @@
 #define FDS_RECORD_KEY_DIRTY    (0x0000)
 
 
+/**@brief   Record key for transaction headers.
+ *
+ * This key is used internally to group the records written by @ref fds_record_write_txn.
+ * This value must not be used as a record key by the application.
+ */
+#define FDS_RECORD_KEY_TXN      (0xFFFF)
+
+
 /**@brief   FDS return values.
  */
 enum
@@ -186,6 +194,35 @@ typedef struct
 } fds_find_token_t;
 
 
+/**@brief   A ring file, used to log fixed-size samples. See @ref fds_ring_init.
+ *
+ * The application allocates this structure and must keep it in memory while the ring file is in
+ * use. Apart from initializing it with @ref fds_ring_init, do not modify any of its fields.
+ */
+typedef struct
+{
+    uint16_t         file_id;           //!< The ID of the file that the blocks belong to.
+    uint16_t         record_key;        //!< The record key of the blocks.
+    uint16_t         slot_words;        //!< The size of a slot, in 4-byte words.
+    uint16_t         slots_per_block;   //!< The number of slots in one block.
+    uint16_t         max_blocks;        //!< The number of blocks kept before the oldest is dropped.
+    uint16_t         slots_used;        //!< The number of slots written to the current block.
+    uint16_t         page;              //!< The page where the current block is stored.
+    uint32_t const * p_block;           //!< The block being filled, or NULL.
+    fds_header_t     header;            //!< The header of the block being filled.
+} fds_ring_t;
+
+
+/**@brief   A token to keep information about the progress of @ref fds_ring_read.
+ *
+ * @note    Always zero-initialize the token before using it for the first time.
+ */
+typedef struct
+{
+    uint32_t record_id; //!< The record ID of the block that was returned last.
+} fds_ring_token_t;
+
+
 /**@brief   FDS event IDs.
  */
 typedef enum
@@ -195,7 +232,10 @@ typedef enum
     FDS_EVT_UPDATE,     //!< Event for @ref fds_record_update.
     FDS_EVT_DEL_RECORD, //!< Event for @ref fds_record_delete.
     FDS_EVT_DEL_FILE,   //!< Event for @ref fds_file_delete.
-    FDS_EVT_GC          //!< Event for @ref fds_gc.
+    FDS_EVT_GC,         //!< Event for @ref fds_gc.
+    FDS_EVT_CHECKPOINT, //!< Event for @ref fds_checkpoint.
+    FDS_EVT_WRITE_TXN,  //!< Event for @ref fds_record_write_txn.
+    FDS_EVT_RING        //!< Event for @ref fds_ring_append and @ref fds_ring_flush.
 } fds_evt_id_t;
 
 
@@ -236,6 +276,16 @@ typedef struct
             uint16_t records_deleted_count;
         } del; //!< Information for @ref FDS_EVT_DEL_RECORD and @ref FDS_EVT_DEL_FILE events.
         struct
+        {
+            uint32_t record_id;     //!< The record ID of the first record in the transaction.
+            uint16_t record_count;  //!< The number of records in the transaction.
+        } txn; //!< Information for @ref FDS_EVT_WRITE_TXN events.
+        struct
+        {
+            uint16_t file_id;
+            uint16_t record_key;
+        } ring; //!< Information for @ref FDS_EVT_RING events.
+        struct
         {
             /* Currently not used. */
             uint16_t pages_skipped;
@@ -278,6 +328,18 @@ typedef struct
      * records are open while garbage collection is run.
      */
     uint16_t freeable_words;
+
+    /**@brief The lowest number of times a virtual page has been erased.
+     *
+     * Only available if @ref FDS_ERASE_COUNTERS is enabled, zero otherwise.
+     */
+    uint32_t erase_count_min;
+
+    /**@brief The highest number of times a virtual page has been erased.
+     *
+     * Only available if @ref FDS_ERASE_COUNTERS is enabled, zero otherwise.
+     */
+    uint32_t erase_count_max;
 } fds_stat_t;
 
 
@@ -352,6 +414,47 @@ ret_code_t fds_record_write(fds_record_desc_t       * const p_desc,
                             fds_record_t      const * const p_record);
 
 
+/**@brief   Function for writing multiple records to flash in one transaction.
+ *
+ * The records are written one after the other in one operation, and are committed with a single
+ * flash write once all of them have been written. Until then, none of the records can be found.
+ * If the operation fails or the device is reset before the transaction is committed, none of the
+ * records are stored, and the space they occupy is reclaimed by garbage collection.
+ *
+ * The same restrictions as for @ref fds_record_write apply to each record. Additionally, the
+ * records must fit on one virtual page together with one extra record header, and their chunks
+ * must fit in the chunk queue at the same time. Only one transaction can be queued at a time.
+ *
+ * The record IDs of the records are consecutive, in the order in which the records are given.
+ * This function is only available if @ref FDS_TXN_MAX_RECORDS is greater than zero.
+ *
+ * This function is asynchronous. Completion is reported through an @ref FDS_EVT_WRITE_TXN event
+ * that is sent to the registered event handler function.
+ *
+ * @param[out]  p_descs     Array of @p count descriptors of the records that were written.
+ *                          Pass NULL if you do not need the descriptors.
+ * @param[in]   p_records   Array of @p count records to be written to flash.
+ * @param[in]   count       The number of records in the transaction.
+ *
+ * @retval  FDS_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_records is NULL.
+ * @retval  FDS_ERR_INVALID_ARG         If @p count is zero or larger than
+ *                                      @ref FDS_TXN_MAX_RECORDS, or if the file ID or the record
+ *                                      key of a record is invalid.
+ * @retval  FDS_ERR_UNALIGNED_ADDR      If the data of a record is not aligned to a 4 byte boundary.
+ * @retval  FDS_ERR_RECORD_TOO_LARGE    If the records do not fit on one virtual page.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full, if there are more record
+ *                                      chunks than can be buffered, or if another transaction is
+ *                                      already queued.
+ * @retval  FDS_ERR_NO_SPACE_IN_FLASH   If there is not enough free space in flash to store the
+ *                                      records.
+ */
+ret_code_t fds_record_write_txn(fds_record_desc_t       * const p_descs,
+                                fds_record_t      const * const p_records,
+                                uint8_t                         count);
+
+
 /**@brief   Function for reserving space in flash.
  *
  * This function can be used to reserve space in flash memory. To write a record into the reserved
@@ -646,6 +749,8 @@ ret_code_t fds_record_close(fds_record_desc_t * const p_desc);
  * This function is asynchronous. Completion is reported through an event that is sent to the
  * registered event handler function.
  *
+ * @note    If garbage collection is already queued or running, this function has no effect.
+ *
  * @retval  FDS_SUCCESS                 If the operation was queued successfully.
  * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
  * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
@@ -653,6 +758,175 @@ ret_code_t fds_record_close(fds_record_desc_t * const p_desc);
 ret_code_t fds_gc(void);
 
 
+/**@brief   Function for running garbage collection incrementally.
+ *
+ * This function works like @ref fds_gc, but garbage collection stops after every @p max_pages
+ * virtual pages to let operations which were queued after it run first, for example record
+ * writes. Garbage collection then resumes automatically from the next page. If no other
+ * operations are queued, garbage collection continues without stopping.
+ *
+ * Use this function to keep the latency of other operations low while garbage collection is
+ * running, at the cost of a longer total time to complete garbage collection.
+ *
+ * This function is asynchronous. Completion is reported through a single @ref FDS_EVT_GC event
+ * that is sent to the registered event handler function once all pages have been processed.
+ *
+ * @note    If garbage collection is already queued or running, this function has no effect.
+ *
+ * @param[in]   max_pages   The number of pages to garbage collect before letting other queued
+ *                          operations run. Must be greater than zero.
+ *
+ * @retval  FDS_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_INVALID_ARG         If @p max_pages is zero.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ */
+ret_code_t fds_gc_step(uint16_t max_pages);
+
+
+/**@brief   Function for writing a checkpoint of the file system to flash.
+ *
+ * A checkpoint records how much data has been written to each virtual page, so that
+ * @ref fds_init does not have to scan all records on the next boot. A checkpoint is taken
+ * automatically at the end of garbage collection. Call this function before the device is
+ * powered off, for example when handling the power failure warning or before entering
+ * System OFF, so that the records written since the last garbage collection are covered too.
+ *
+ * This function is only available if @ref FDS_CHECKPOINT_SLOTS is greater than zero.
+ *
+ * This function is asynchronous. Completion is reported through an event that is sent to the
+ * registered event handler function. If all checkpoint slots have been used, the event reports
+ * @ref FDS_ERR_NO_SPACE_IN_FLASH; the slots are freed by garbage collection.
+ *
+ * @retval  FDS_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ */
+ret_code_t fds_checkpoint(void);
+
+
+/**@brief   Function for saving the page structures to retained RAM.
+ *
+ * Call this function right before entering System OFF. When the device wakes up, @ref fds_init
+ * uses the snapshot instead of scanning flash, and reports @ref FDS_EVT_INIT immediately. The
+ * snapshot is discarded if an operation is queued after this function has been called.
+ *
+ * This function is only available if @ref FDS_RETAINED_STATE_ENABLED is set to one.
+ *
+ * @retval  FDS_SUCCESS                 If the snapshot was saved.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_BUSY                If operations are queued or garbage collection is in
+ *                                      progress.
+ */
+ret_code_t fds_retain(void);
+
+
+/**@brief   Function for initializing a ring file.
+ *
+ * A ring file stores fixed-size slots, for example sensor samples, in records called blocks.
+ * Each block holds @p slots_per_block slots and has one record header, which is written when the
+ * first slot of the block is appended. Appending a slot only writes the slot itself. A block can
+ * be found once it becomes full or is flushed using @ref fds_ring_flush. When a block
+ * becomes full and the file holds more than @p max_blocks blocks, the oldest block is deleted.
+ *
+ * Slots that have been appended to a block which is neither full nor flushed are lost if the
+ * device is reset. A slot whose words are all 0xFFFFFFFF cannot be told apart from an unused one.
+ *
+ * Blocks can be read with @ref fds_ring_read. Other record functions, such as
+ * @ref fds_file_delete, can be used on the blocks as on any other record.
+ *
+ * This function is only available if @ref FDS_RING_ENABLED is set to one.
+ *
+ * @param[out]  p_ring              The ring file to initialize.
+ * @param[in]   file_id             The ID of the file that the blocks belong to.
+ * @param[in]   record_key          The record key of the blocks.
+ * @param[in]   slot_words          The size of a slot, in 4-byte words.
+ * @param[in]   slots_per_block     The number of slots in one block.
+ * @param[in]   max_blocks          The number of blocks to keep.
+ *
+ * @retval  FDS_SUCCESS                 If the ring file was initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_ring is NULL.
+ * @retval  FDS_ERR_INVALID_ARG         If the file ID or the record key is invalid, or if any of
+ *                                      the sizes is zero.
+ * @retval  FDS_ERR_RECORD_TOO_LARGE    If a block does not fit on a virtual page.
+ */
+ret_code_t fds_ring_init(fds_ring_t * const p_ring,
+                         uint16_t           file_id,
+                         uint16_t           record_key,
+                         uint16_t           slot_words,
+                         uint16_t           slots_per_block,
+                         uint16_t           max_blocks);
+
+
+/**@brief   Function for appending slots to a ring file.
+ *
+ * The slots are written to the current block. If they don't fit, the block is completed and
+ * the remaining slots are written to a new block. The data must be aligned to a 4 byte boundary,
+ * and because it is not buffered internally, it must be kept in memory until the callback for
+ * the operation has been received.
+ *
+ * This function is asynchronous. Completion is reported through an @ref FDS_EVT_RING event that
+ * is sent to the registered event handler function. If there is no space in flash for a new block,
+ * the event reports @ref FDS_ERR_NO_SPACE_IN_FLASH.
+ *
+ * @param[in]   p_ring          The ring file.
+ * @param[in]   p_slots         The slots to append.
+ * @param[in]   slot_count      The number of slots to append.
+ *
+ * @retval  FDS_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_ring or @p p_slots is NULL.
+ * @retval  FDS_ERR_INVALID_ARG         If @p slot_count is zero.
+ * @retval  FDS_ERR_UNALIGNED_ADDR      If @p p_slots is not aligned to a 4 byte boundary.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ */
+ret_code_t fds_ring_append(fds_ring_t       * const p_ring,
+                           void       const * const p_slots,
+                           uint16_t                 slot_count);
+
+
+/**@brief   Function for completing the current block of a ring file.
+ *
+ * Use this function to make the slots that have been appended so far readable after a reset,
+ * for example before the device is powered off. The unused slots in the block are left erased.
+ * The next slot is appended to a new block.
+ *
+ * This function is asynchronous. Completion is reported through an @ref FDS_EVT_RING event that
+ * is sent to the registered event handler function.
+ *
+ * @param[in]   p_ring      The ring file.
+ *
+ * @retval  FDS_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_ring is NULL.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ */
+ret_code_t fds_ring_flush(fds_ring_t * const p_ring);
+
+
+/**@brief   Function for reading the blocks of a ring file, from the oldest to the newest.
+ *
+ * Each call returns the slots of the next block. The block that is currently being filled is
+ * returned last. The slots are read directly from flash: garbage collection must not be run
+ * until they have been read.
+ *
+ * @param[in]       p_ring          The ring file.
+ * @param[in,out]   p_token         A token containing information about the progress
+ *                                  of the operation.
+ * @param[out]      pp_slots        The slots of the block.
+ * @param[out]      p_slot_count    The number of slots in the block.
+ *
+ * @retval  FDS_SUCCESS                 If a block was returned.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If any of the parameters is NULL.
+ * @retval  FDS_ERR_NOT_FOUND           If there are no more blocks.
+ */
+ret_code_t fds_ring_read(fds_ring_t       const * const p_ring,
+                         fds_ring_token_t       * const p_token,
+                         void             const **      pp_slots,
+                         uint16_t               * const p_slot_count);
+
+
 /**@brief   Function for obtaining a descriptor from a record ID.
  *
  * This function can be used to reconstruct a descriptor from a record ID, like the one that is
@@ -17,14 +17,25 @@
 #include <stdbool.h>
 #include "fds_config.h"
 
+#if (FDS_RETAINED_STATE_ENABLED)
+    #include "nrf_retained.h"
+#endif
+
 #if defined (FDS_THREADS)
     #include "nrf_soc.h"
     #include "app_util_platform.h"
 #endif
 
-#define FDS_PAGE_TAG_SIZE       (2) // Page tag size, in 4-byte words.
+#define FDS_AUTO_GC_ENABLED     ((FDS_AUTO_GC_DIRTY_PERCENT > 0) || (FDS_AUTO_GC_FREE_WORDS_MIN > 0))
+
+#if (FDS_ERASE_COUNTERS)
+    #define FDS_PAGE_TAG_SIZE   (3) // Page tag size, in 4-byte words.
+#else
+    #define FDS_PAGE_TAG_SIZE   (2) // Page tag size, in 4-byte words.
+#endif
 #define FDS_PAGE_TAG_WORD_0     (0) // Offset of the first word in the page tag from the page address.
 #define FDS_PAGE_TAG_WORD_1     (1) // Offset of the second word in the page tag from the page address.
+#define FDS_PAGE_TAG_WORD_2     (2) // Offset of the erase counter from the page address.
 
 // Page tag constants
 #define FDS_PAGE_TAG_MAGIC      (0xDEADC0DE)
@@ -33,6 +44,12 @@
 
 #define FDS_ERASED_WORD         (0xFFFFFFFF)
 
+#define FDS_CHECKPOINT_MAGIC    (0xC4EC4000)
+#define FDS_RETAINED_MAGIC      (0xF5DA7E01)
+
+// Written as the file ID of a transaction header to commit the transaction.
+#define FDS_TXN_FILE_ID         (0x0000)
+
 #define FDS_OFFSET_TL           (0) // Offset of TL from the record base address, in 4-byte words.
 #define FDS_OFFSET_IC           (1) // Offset of IC from the record base address, in 4-byte words.
 #define FDS_OFFSET_ID           (2) // Offset of ID from the record base address, in 4-byte words.
@@ -45,6 +62,7 @@
 
 #define FDS_OP_EXECUTING        (FS_SUCCESS)
 #define FDS_OP_COMPLETED        (0x1D1D)
+#define FDS_OP_YIELD            (0x1D1E)    // Move the operation to the back of the queue.
 
 // The size of a physical page, in 4-byte words.
 #if   defined(NRF51)
@@ -66,6 +84,34 @@
 #define FDS_PAGE_SIZE               (FDS_VIRTUAL_PAGE_SIZE)
 
 
+#if (FDS_CHECKPOINT_SLOTS > 0)
+
+// A checkpoint, as stored in flash.
+typedef struct
+{
+    uint32_t magic;                                             // FDS_CHECKPOINT_MAGIC.
+    uint32_t latest_rec_id;                                     // The latest record ID.
+    uint16_t write_offset[(FDS_VIRTUAL_PAGES + 1) & ~0x01];     // Indexed by physical page order.
+    uint16_t words_dirty[(FDS_VIRTUAL_PAGES + 1) & ~0x01];      // Indexed by physical page order.
+    uint32_t crc16;                                             // CRC16 of the fields above.
+} fds_checkpoint_t;
+
+// The size of a checkpoint, in 4-byte words.
+#define FDS_CHECKPOINT_SIZE         (sizeof(fds_checkpoint_t) / sizeof(uint32_t))
+
+// The space reserved for checkpoints at the end of every virtual page, in 4-byte words.
+#define FDS_CHECKPOINT_AREA_SIZE    (FDS_CHECKPOINT_SLOTS * FDS_CHECKPOINT_SIZE)
+
+#else
+
+#define FDS_CHECKPOINT_AREA_SIZE    (0)
+
+#endif
+
+// The number of words on a virtual page which can be used to store records, including the tag.
+#define FDS_PAGE_USABLE_SIZE        (FDS_PAGE_SIZE - FDS_CHECKPOINT_AREA_SIZE)
+
+
 #if (FDS_VIRTUAL_PAGE_SIZE % FDS_PHY_PAGE_SIZE != 0)
     #error "FDS_VIRTUAL_PAGE_SIZE must be a multiple of the size of a physical page."
 #endif
@@ -82,6 +128,7 @@ typedef enum
     FDS_FLAG_INITIALIZED    = (1 << 1),  // The module is initialized.
     FDS_FLAG_PROCESSING     = (1 << 2),  // The queue is being processed.
     FDS_FLAG_VERIFY_CRC     = (1 << 3),  // Verify CRC upon writing a record.
+    FDS_FLAG_INIT_QUEUED    = (1 << 4),  // The initialization operation is in the queue.
 } fds_flags_t;
 
 
@@ -101,8 +148,12 @@ typedef struct
     uint32_t        const * p_addr;         // The address of the page.
     uint16_t                write_offset;   // The page write offset, in 4-byte words.
     uint16_t                words_reserved; // The amount of words reserved by fds_write_reserve().
+    uint16_t                words_dirty;    // The amount of words occupied by dirty records.
     uint16_t                records_open;   // The number of records opened using fds_open().
     bool                    can_gc;         // Indicates that there are some records that have been deleted.
+#if (FDS_ERASE_COUNTERS)
+    uint32_t                erase_count;    // The number of times the page has been erased.
+#endif
 } fds_page_t;
 
 
@@ -110,6 +161,9 @@ typedef struct
 {
     uint32_t const * p_addr;
     uint16_t         write_offset;
+#if (FDS_ERASE_COUNTERS)
+    uint32_t         erase_count;
+#endif
 } fds_swap_page_t;
 
 
@@ -122,7 +176,10 @@ typedef enum
     FDS_OP_UPDATE,      // Update a record.
     FDS_OP_DEL_RECORD,  // Delete a record.
     FDS_OP_DEL_FILE,    // Delete a file.
-    FDS_OP_GC           // Run garbage collection.
+    FDS_OP_GC,          // Run garbage collection.
+    FDS_OP_CHECKPOINT,  // Write a checkpoint.
+    FDS_OP_WRITE_TXN,   // Write multiple records in one transaction.
+    FDS_OP_RING,        // Append slots to a ring file.
 } fds_op_code_t;
 
 
@@ -155,6 +212,48 @@ typedef enum
 } fds_delete_step_t;
 
 
+typedef enum
+{
+    FDS_OP_CHECKPOINT_WRITE,        // Write the checkpoint to the swap page.
+    FDS_OP_CHECKPOINT_DONE,
+} fds_checkpoint_step_t;
+
+
+typedef enum
+{
+    FDS_OP_TXN_HEADER_BEGIN,        // Write the key and length of the transaction header.
+    FDS_OP_TXN_RECORD_HEADER,       // Write the header of a record in the transaction.
+    FDS_OP_TXN_RECORD_CHUNKS,       // Write the data of a record in the transaction.
+    FDS_OP_TXN_COMMIT,              // Write the file ID of the transaction header.
+    FDS_OP_TXN_DONE,
+} fds_txn_step_t;
+
+
+typedef enum
+{
+    FDS_OP_RING_BLOCK_BEGIN,        // Start a new block, unless one is being filled.
+    FDS_OP_RING_SLOTS,              // Write slots to the block being filled.
+    FDS_OP_RING_BLOCK_ID,           // Write the record ID of a new block.
+    FDS_OP_RING_BLOCK_FINALIZE,     // Write the file ID and CRC of the block.
+    FDS_OP_RING_DROP,               // Delete the oldest block, if there are too many.
+    FDS_OP_RING_DONE,
+} fds_ring_step_t;
+
+
+#if (FDS_TXN_MAX_RECORDS > 0)
+
+// The transaction being written. Only one transaction can be queued at a time.
+typedef struct
+{
+    fds_header_t header;                                // The transaction header.
+    fds_header_t record_header[FDS_TXN_MAX_RECORDS];    // The headers of the records.
+    uint8_t      chunk_count[FDS_TXN_MAX_RECORDS];      // Chunks left to write for each record.
+    bool         queued;                                // Whether or not a transaction is queued.
+} fds_txn_t;
+
+#endif
+
+
 #if defined(__CC_ARM)
     #pragma push
     #pragma anon_unions
@@ -189,6 +288,32 @@ typedef struct
             uint16_t          record_key;
             uint32_t          record_to_delete;
         } del;
+        struct
+        {
+            uint16_t max_pages;                 // Pages to GC before yielding. Zero for no limit.
+        } gc;
+        struct
+        {
+            fds_checkpoint_step_t step;
+        } checkpoint;
+        struct
+        {
+            fds_txn_step_t step;
+            uint16_t       page;            // The page the flash space for the records was reserved.
+            uint16_t       length_words;    // The length of all records, including their headers.
+            uint16_t       offset;          // Offset of the next word to write, from the txn header.
+            uint8_t        record;          // The record being written.
+            uint8_t        record_count;    // The number of records in the transaction.
+            uint8_t        chunk_count;     // Number of chunks left to write, for all records.
+            uint32_t       record_id;       // The record ID of the first record.
+        } txn;
+        struct
+        {
+            fds_ring_step_t          step;
+            fds_ring_t             * p_ring;
+            uint32_t         const * p_data;        // The slots left to write.
+            uint16_t                 slot_count;    // The number of slots left to write.
+        } ring;
     };
 } fds_op_t;
 
@@ -272,7 +397,9 @@ typedef enum
     GC_ERASE_PAGE,          // Erase the page being garbage collected.
     GC_DISCARD_SWAP,        // Erase (discard) the swap page.
     GC_PROMOTE_SWAP,        // Tag the swap as valid.
-    GC_TAG_NEW_SWAP         // Tag a freshly erased (GCed) page as swap.
+    GC_TAG_NEW_SWAP,        // Tag a freshly erased (GCed) page as swap.
+    GC_CHECKPOINT,          // Write a checkpoint once all pages have been garbage collected.
+    GC_COMPLETE             // GC has terminated.
 } fds_gc_state_t;
 
 
@@ -283,11 +410,66 @@ typedef struct
     uint16_t         cur_page;                  // The current page being garbage collected.
     uint32_t const * p_record_src;              // The current record being copied to swap.
     uint16_t         run_count;                 // Total number of times GC was run.
+    uint16_t         pages_stepped;             // Pages garbage collected since GC last yielded.
     bool             do_gc_page[FDS_MAX_PAGES]; // Controls which pages to garbage collect.
     bool             resume;                    // Whether or not GC should be resumed.
+    bool             queued;                    // Whether or not a GC operation is queued.
+    bool             auto_armed;                // Records may have been deleted since GC last completed.
 } fds_gc_data_t;
 
 
+// Decisions of the automatic GC policy.
+typedef enum
+{
+    GC_AUTO_NONE,   // GC is not needed.
+    GC_AUTO_IDLE,   // GC should run once the queue has been idle for a while.
+    GC_AUTO_NOW,    // GC should run as soon as possible.
+} fds_gc_auto_t;
+
+
+#if (FDS_RECORD_INDEX_SIZE > 0)
+
+// An entry in the RAM record index.
+typedef struct
+{
+    uint16_t file_id;       // The ID of the file the record belongs to.
+    uint16_t record_key;    // The record key.
+    uint16_t page;          // The logical page (index in m_pages) the record is stored on.
+    uint16_t offset;        // The offset of the record from the page address, in 4-byte words.
+} fds_index_entry_t;
+
+
+// Holds the RAM record index. Entries are sorted by file ID, record key, page and offset.
+typedef struct
+{
+    fds_index_entry_t entry[FDS_RECORD_INDEX_SIZE];
+    uint16_t          count;        // Number of entries in use.
+    bool              overflow;     // The index could not hold all records and must not be used.
+} fds_index_t;
+
+#endif
+
+
+#if (FDS_RETAINED_STATE_ENABLED)
+
+// A snapshot of the page structures, kept in retained RAM across System OFF.
+typedef struct
+{
+    nrf_retained_hdr_t hdr;
+    uint32_t const *   p_start_addr;            // The address of the first page when the snapshot was taken.
+    uint32_t           latest_rec_id;           // The latest record ID.
+    uint16_t           gc_run_count;            // Total number of times GC was run.
+    bool               gc_auto_armed;           // Records were deleted since GC last completed.
+    fds_page_t         pages[FDS_MAX_PAGES];
+    fds_swap_page_t    swap_page;
+#if (FDS_RECORD_INDEX_SIZE > 0)
+    fds_index_t        index;
+#endif
+} fds_retained_t;
+
+#endif
+
+
 // Macros to enable and disable application interrupts.
 #if defined (FDS_THREADS)
 
@@ -47,6 +47,13 @@ static __INLINE void fifo_get(app_fifo_t * p_fifo, uint8_t * p_byte)
 }
 
 
+/**@brief Get the number of contiguous bytes from position 'pos' to the end of the buffer. */
+static __INLINE uint32_t fifo_span_to_end(app_fifo_t * p_fifo, uint32_t pos)
+{
+    return (uint32_t)p_fifo->buf_size_mask + 1 - (pos & p_fifo->buf_size_mask);
+}
+
+
 uint32_t app_fifo_init(app_fifo_t * p_fifo, uint8_t * p_buf, uint16_t buf_size)
 {
     // Check buffer for null pointer.
@@ -138,10 +145,15 @@ uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_byte_array, uint32_t * p
         return NRF_SUCCESS;
     }
 
-    // Fetch bytes from the FIFO.
+    // Fetch bytes from the FIFO, in at most two contiguous parts.
     while (index < read_size)
     {
-        fifo_get(p_fifo, &p_byte_array[index++]);
+        const uint32_t read_pos = p_fifo->read_pos;
+        const uint32_t part     = MIN(read_size - index, fifo_span_to_end(p_fifo, read_pos));
+
+        memcpy(&p_byte_array[index], &p_fifo->p_buf[read_pos & p_fifo->buf_size_mask], part);
+        p_fifo->read_pos = read_pos + part;
+        index           += part;
     }
 
     (*p_size) = read_size;
@@ -174,13 +186,92 @@ uint32_t app_fifo_write(app_fifo_t * p_fifo, uint8_t const * p_byte_array, uint3
         return NRF_SUCCESS;
     }
 
-    //Fetch bytes from the FIFO.
+    // Write bytes to the FIFO, in at most two contiguous parts.
     while (index < write_size)
     {
-        fifo_put(p_fifo, p_byte_array[index++]);
+        const uint32_t write_pos = p_fifo->write_pos;
+        const uint32_t part      = MIN(write_size - index, fifo_span_to_end(p_fifo, write_pos));
+
+        memcpy(&p_fifo->p_buf[write_pos & p_fifo->buf_size_mask], &p_byte_array[index], part);
+        p_fifo->write_pos = write_pos + part;
+        index            += part;
     }
 
     (*p_size) = write_size;
 
     return NRF_SUCCESS;
 }
+
+
+uint32_t app_fifo_read_span_get(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+    VERIFY_PARAM_NOT_NULL(pp_data);
+    VERIFY_PARAM_NOT_NULL(p_size);
+
+    const uint32_t read_pos   = p_fifo->read_pos;
+    const uint32_t byte_count = p_fifo->write_pos - read_pos;
+
+    if (byte_count == 0)
+    {
+        (*p_size) = 0;
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    (*pp_data) = &p_fifo->p_buf[read_pos & p_fifo->buf_size_mask];
+    (*p_size)  = MIN(byte_count, fifo_span_to_end(p_fifo, read_pos));
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_read_span_consume(app_fifo_t * p_fifo, uint32_t size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+
+    if (size > fifo_length(p_fifo))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_fifo->read_pos += size;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_write_span_get(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+    VERIFY_PARAM_NOT_NULL(pp_data);
+    VERIFY_PARAM_NOT_NULL(p_size);
+
+    const uint32_t write_pos       = p_fifo->write_pos;
+    const uint32_t available_count = p_fifo->buf_size_mask - (write_pos - p_fifo->read_pos) + 1;
+
+    if (available_count == 0)
+    {
+        (*p_size) = 0;
+        return NRF_ERROR_NO_MEM;
+    }
+
+    (*pp_data) = &p_fifo->p_buf[write_pos & p_fifo->buf_size_mask];
+    (*p_size)  = MIN(available_count, fifo_span_to_end(p_fifo, write_pos));
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_write_span_commit(app_fifo_t * p_fifo, uint32_t size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+
+    if (size > (p_fifo->buf_size_mask - fifo_length(p_fifo) + 1))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_fifo->write_pos += size;
+
+    return NRF_SUCCESS;
+}
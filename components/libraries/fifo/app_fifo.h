@@ -140,6 +140,61 @@ uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_byte_array, uint32_t * p
  */
 uint32_t app_fifo_write(app_fifo_t * p_fifo, uint8_t const * p_byte_array, uint32_t * p_size);
 
+/**@brief Function for getting the largest contiguous region of bytes that can be read from the FIFO.
+ *
+ * The bytes can be read, or transferred by EasyDMA, directly from the FIFO buffer. They stay in
+ * the FIFO until @ref app_fifo_read_span_consume is called. Because the FIFO is a ring buffer, the
+ * region can be shorter than the number of bytes in the FIFO. After consuming it, call this
+ * function again to get the bytes that wrapped around to the start of the buffer.
+ *
+ * @param[in]  p_fifo   Pointer to the FIFO. Must not be NULL.
+ * @param[out] pp_data  Start of the region.
+ * @param[out] p_size   Number of bytes in the region.
+ *
+ * @retval     NRF_SUCCESS          If a region was returned.
+ * @retval     NRF_ERROR_NULL       If a NULL parameter was passed.
+ * @retval     NRF_ERROR_NOT_FOUND  If the FIFO is empty.
+ */
+uint32_t app_fifo_read_span_get(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size);
+
+/**@brief Function for removing bytes that were read with @ref app_fifo_read_span_get from the FIFO.
+ *
+ * @param[in]  p_fifo   Pointer to the FIFO. Must not be NULL.
+ * @param[in]  size     Number of bytes to remove from the FIFO.
+ *
+ * @retval     NRF_SUCCESS              If the bytes were removed.
+ * @retval     NRF_ERROR_NULL           If a NULL parameter was passed.
+ * @retval     NRF_ERROR_INVALID_LENGTH If size is larger than the number of bytes in the FIFO.
+ */
+uint32_t app_fifo_read_span_consume(app_fifo_t * p_fifo, uint32_t size);
+
+/**@brief Function for getting the largest contiguous free region of the FIFO.
+ *
+ * Bytes can be written, or transferred by EasyDMA, directly into the region. They are added to
+ * the FIFO when @ref app_fifo_write_span_commit is called. The region can be shorter than the free
+ * space in the FIFO if the free space wraps around the end of the buffer.
+ *
+ * @param[in]  p_fifo   Pointer to the FIFO. Must not be NULL.
+ * @param[out] pp_data  Start of the region.
+ * @param[out] p_size   Number of bytes in the region.
+ *
+ * @retval     NRF_SUCCESS       If a region was returned.
+ * @retval     NRF_ERROR_NULL    If a NULL parameter was passed.
+ * @retval     NRF_ERROR_NO_MEM  If the FIFO is full.
+ */
+uint32_t app_fifo_write_span_get(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size);
+
+/**@brief Function for adding bytes that were written with @ref app_fifo_write_span_get to the FIFO.
+ *
+ * @param[in]  p_fifo   Pointer to the FIFO. Must not be NULL.
+ * @param[in]  size     Number of bytes written to the region.
+ *
+ * @retval     NRF_SUCCESS              If the bytes were added.
+ * @retval     NRF_ERROR_NULL           If a NULL parameter was passed.
+ * @retval     NRF_ERROR_INVALID_LENGTH If size is larger than the free space in the FIFO.
+ */
+uint32_t app_fifo_write_span_commit(app_fifo_t * p_fifo, uint32_t size);
+
 #endif // APP_FIFO_H__
 
 /** @} */
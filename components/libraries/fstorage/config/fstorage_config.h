@@ -53,6 +53,59 @@
     #define FS_MAX_WRITE_SIZE_WORDS     (1024)
 #endif
 
+/**@brief   Configures the size of the buffer used to merge store operations, in words.
+ *
+ * @details Store operations which are queued back to back by the same user, and whose
+ *          destinations are adjacent in flash, are copied into this buffer and written
+ *          to flash using a single call to @ref sd_flash_write. This reduces the number
+ *          of flash operations which must be scheduled by the SoftDevice. An event is still
+ *          sent for each call to @ref fs_store. The buffer size is capped at
+ *          @ref FS_MAX_WRITE_SIZE_WORDS.
+ *
+ *          Set to zero to disable merging of store operations. It is disabled by default,
+ *          because the buffer is allocated statically in RAM.
+ */
+#define FS_COALESCE_BUFFER_WORDS    (0)
+
+/**@brief   Enables scheduling of flash operations in between radio events.
+ *
+ * @details If enabled, the application must forward Radio Notification events to fstorage
+ *          using @ref fs_radio_notification_handler, for example by passing it to
+ *          @ref ble_radio_notification_init with @ref NRF_RADIO_NOTIFICATION_TYPE_INT_ON_BOTH.
+ *          fstorage measures the time between the end of a radio event and the start of the next
+ *          one, and only issues flash operations which are expected to complete before the
+ *          radio becomes active again. Long store operations are split to fit. Erase operations
+ *          which cannot fit any gap are issued at the beginning of a gap.
+ *
+ *          This option requires the app_timer module, which must be initialized before
+ *          calling @ref fs_init.
+ *
+ *          Set to one to enable, or to zero to disable.
+ */
+#define FS_RADIO_SYNC_ENABLED           (0)
+
+/**@brief   The prescaler used to initialize the app_timer module.
+ *
+ * @details Only used if @ref FS_RADIO_SYNC_ENABLED is set.
+ */
+#define FS_RADIO_SYNC_TIMER_PRESCALER   (0)
+
+/**@brief   Time reserved for the SoftDevice to start and complete a flash operation, in
+ *          microseconds. It is subtracted from the length of each gap in radio activity.
+ */
+#define FS_RADIO_SYNC_MARGIN_US         (500)
+
+/**@brief   Maximum time needed to write a word to flash, and to erase a flash page,
+ *          in microseconds.
+ */
+#if   defined (NRF51)
+    #define FS_RADIO_SYNC_WRITE_US      (47)
+    #define FS_RADIO_SYNC_ERASE_US      (22300)
+#elif defined (NRF52)
+    #define FS_RADIO_SYNC_WRITE_US      (68)
+    #define FS_RADIO_SYNC_ERASE_US      (85000)
+#endif
+
 /** @} */
 
 #endif // FS_CONFIG_H__
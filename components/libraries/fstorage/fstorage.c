@@ -19,11 +19,30 @@
 #include <stdbool.h>
 #include "nrf_error.h"
 #include "nrf_soc.h"
+#include "nordic_common.h"
+#if (FS_RADIO_SYNC_ENABLED)
+    #include "app_timer.h"
+#endif
 
 
 static uint8_t       m_flags;       // fstorage status flags.
 static fs_op_queue_t m_queue;       // Queue of requested operations.
 static uint8_t       m_retry_count; // Number of times the last flash operation was retried.
+static fs_stats_t    m_stats;       // Statistics.
+
+#if (FS_RADIO_SYNC_ENABLED)
+static fs_radio_t    m_radio;       // Timing of radio activity.
+APP_TIMER_DEF(m_radio_timer);       // Timer used to resume processing after a gap has ended.
+#endif
+
+#if (FS_COALESCE_BUFFER_WORDS > 0)
+// Buffer holding the data of store operations which are written to flash together.
+// Needs to be statically allocated since it will be written to flash.
+static uint32_t      m_coalesce_buf[FS_COALESCE_MAX_WORDS];
+// Number of queued operations being executed by the current flash operation.
+// It is zero if the current operation has not been merged with others.
+static uint32_t      m_coalesce_count;
+#endif
 
 
 // Sends events to the application.
@@ -51,6 +70,40 @@ static void send_event(fs_op_t const * const p_op, fs_ret_t result)
             break;
     }
 
+    m_stats.ops_completed++;
+
+    if (result == FS_SUCCESS)
+    {
+        if (p_op->op_code == FS_OP_STORE)
+        {
+            m_stats.words_written += p_op->store.length_words;
+        }
+        else if (p_op->op_code == FS_OP_ERASE)
+        {
+            m_stats.pages_erased += p_op->erase.pages_to_erase;
+        }
+    }
+    else if (result == FS_ERR_OPERATION_TIMEOUT)
+    {
+        m_stats.ops_timed_out++;
+    }
+
+    if (p_op->retries > m_stats.retries_max)
+    {
+        m_stats.retries_max = p_op->retries;
+    }
+
+#if (FS_RADIO_SYNC_ENABLED)
+    uint32_t ticks;
+    (void)app_timer_cnt_get(&ticks);
+    (void)app_timer_cnt_diff_compute(ticks, p_op->queued_ticks, &m_stats.latency_last);
+
+    if (m_stats.latency_last > m_stats.latency_max)
+    {
+        m_stats.latency_max = m_stats.latency_last;
+    }
+#endif
+
     p_op->p_config->callback(&evt, result);
 }
 
@@ -69,20 +122,106 @@ static bool check_config(fs_config_t const * const config)
 }
 
 
-// Executes a store operation.
-static uint32_t store_execute(fs_op_t const * const p_op)
+#if (FS_COALESCE_BUFFER_WORDS > 0)
+
+// Merges the store operation at the front of the queue with the store operations which follow it,
+// if they belong to the same user and their destinations are adjacent in flash.
+// Returns the number of operations which have been merged, or zero if none were.
+static uint32_t store_coalesce(fs_op_t const * const p_op, uint16_t max_words)
+{
+    uint32_t         count        = 1;
+    uint32_t         length_words = p_op->store.length_words;
+    uint32_t const * p_next_dest  = p_op->store.p_dest + p_op->store.length_words;
+
+    // Only merge operations which have not been partially executed yet.
+    if (max_words > FS_COALESCE_MAX_WORDS)
+    {
+        max_words = FS_COALESCE_MAX_WORDS;
+    }
+
+    if ((p_op->store.offset != 0) || (length_words > max_words))
+    {
+        return 0;
+    }
+
+    while (count < m_queue.count)
+    {
+        fs_op_t const * const p_next = &m_queue.op[(m_queue.rp + count) % FS_QUEUE_SIZE];
+
+        if ((p_next->op_code              != FS_OP_STORE)    ||
+            (p_next->p_config             != p_op->p_config) ||
+            (p_next->store.p_dest         != p_next_dest)    ||
+            (p_next->store.length_words   >  max_words - length_words))
+        {
+            break;
+        }
+
+        length_words += p_next->store.length_words;
+        p_next_dest  += p_next->store.length_words;
+        count++;
+    }
+
+    if (count == 1)
+    {
+        return 0;
+    }
+
+    // Copy the data into the buffer, in the same order it is to be written to flash.
+    length_words = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        fs_op_t const * const p_next = &m_queue.op[(m_queue.rp + i) % FS_QUEUE_SIZE];
+
+        memcpy(&m_coalesce_buf[length_words],
+               p_next->store.p_src,
+               p_next->store.length_words * sizeof(uint32_t));
+
+        length_words += p_next->store.length_words;
+    }
+
+    return count;
+}
+
+#endif
+
+
+// Executes a store operation, writing at most max_words words.
+static uint32_t store_execute(fs_op_t * const p_op, uint16_t max_words)
 {
     uint16_t chunk_len;
 
-    if ((p_op->store.length_words - p_op->store.offset) < FS_MAX_WRITE_SIZE_WORDS)
+#if (FS_COALESCE_BUFFER_WORDS > 0)
+    m_coalesce_count = store_coalesce(p_op, max_words);
+
+    if (m_coalesce_count > 0)
+    {
+        uint32_t length_words = 0;
+
+        for (uint32_t i = 0; i < m_coalesce_count; i++)
+        {
+            length_words += m_queue.op[(m_queue.rp + i) % FS_QUEUE_SIZE].store.length_words;
+        }
+
+        return sd_flash_write((uint32_t*)p_op->store.p_dest, m_coalesce_buf, length_words);
+    }
+#endif
+
+    if (max_words > FS_MAX_WRITE_SIZE_WORDS)
+    {
+        max_words = FS_MAX_WRITE_SIZE_WORDS;
+    }
+
+    if ((p_op->store.length_words - p_op->store.offset) < max_words)
     {
         chunk_len = p_op->store.length_words - p_op->store.offset;
     }
     else
     {
-        chunk_len = FS_MAX_WRITE_SIZE_WORDS;
+        chunk_len = max_words;
     }
 
+    p_op->store.chunk_len = chunk_len;
+
     return sd_flash_write((uint32_t*)p_op->store.p_dest + p_op->store.offset,
                           (uint32_t*)p_op->store.p_src  + p_op->store.offset,
                           chunk_len);
@@ -112,18 +251,123 @@ static void queue_advance(void)
 }
 
 
+#if (FS_RADIO_SYNC_ENABLED)
+
+// Decides whether an operation can be executed without colliding with radio activity.
+// For store operations, max_words is set to the number of words which can be written
+// before the next radio event is expected.
+static bool radio_op_schedule(fs_op_t const * const p_op, uint16_t * const p_max_words)
+{
+    uint32_t ticks;
+    uint32_t elapsed;
+    uint32_t remaining_us;
+    uint32_t gap_us;
+
+    *p_max_words = FS_MAX_WRITE_SIZE_WORDS;
+
+    if (m_radio.active)
+    {
+        return false;
+    }
+
+    if ((!m_radio.gap_started) || (m_radio.gap_ticks == 0))
+    {
+        // There is no information about radio activity.
+        return true;
+    }
+
+    (void)app_timer_cnt_get(&ticks);
+    (void)app_timer_cnt_diff_compute(ticks, m_radio.gap_start, &elapsed);
+
+    if (elapsed >= m_radio.gap_ticks)
+    {
+        // The radio should have become active again, but it has not. It is probably idle.
+        return true;
+    }
+
+    gap_us       = FS_RADIO_TICKS_TO_US(m_radio.gap_ticks);
+    remaining_us = FS_RADIO_TICKS_TO_US(m_radio.gap_ticks - elapsed);
+
+    gap_us       = (gap_us       > FS_RADIO_SYNC_MARGIN_US) ? gap_us - FS_RADIO_SYNC_MARGIN_US       : 0;
+    remaining_us = (remaining_us > FS_RADIO_SYNC_MARGIN_US) ? remaining_us - FS_RADIO_SYNC_MARGIN_US : 0;
+
+    if (p_op->op_code == FS_OP_STORE)
+    {
+        if (remaining_us >= FS_RADIO_SYNC_WRITE_US)
+        {
+            // A long gap allows more words than fit in p_max_words, cap it first.
+            *p_max_words = MIN(remaining_us / FS_RADIO_SYNC_WRITE_US, FS_MAX_WRITE_SIZE_WORDS);
+            return true;
+        }
+
+        // Wait for the next gap, unless no gap is long enough to write a single word.
+        return (gap_us < FS_RADIO_SYNC_WRITE_US);
+    }
+    else
+    {
+        if (remaining_us >= FS_RADIO_SYNC_ERASE_US)
+        {
+            return true;
+        }
+
+        // If no gap is long enough to erase a page, issue the erase at the beginning of a gap
+        // and let the SoftDevice schedule it.
+        return ((gap_us < FS_RADIO_SYNC_ERASE_US) &&
+                (elapsed < FS_RADIO_US_TO_TICKS(FS_RADIO_SYNC_MARGIN_US)));
+    }
+}
+
+
+// Waits for the next gap in radio activity before processing the queue.
+// If the radio does not become active again, the queue is processed when the current gap ends.
+static void radio_wait(void)
+{
+    m_stats.deferrals++;
+
+    m_flags &= ~FS_FLAG_PROCESSING;
+    m_flags |=  FS_FLAG_RADIO_WAIT;
+
+    if (!m_radio.active)
+    {
+        uint32_t ticks;
+        uint32_t elapsed;
+        uint32_t timeout;
+
+        (void)app_timer_cnt_get(&ticks);
+        (void)app_timer_cnt_diff_compute(ticks, m_radio.gap_start, &elapsed);
+
+        timeout = (m_radio.gap_ticks > elapsed) ? (m_radio.gap_ticks - elapsed) : 0;
+        timeout = (timeout > APP_TIMER_MIN_TIMEOUT_TICKS) ? timeout : APP_TIMER_MIN_TIMEOUT_TICKS;
+
+        (void)app_timer_stop(m_radio_timer);
+        (void)app_timer_start(m_radio_timer, timeout, NULL);
+    }
+}
+
+#endif
+
+
 // Processes the current element in the queue. If the queue is empty, does nothing.
 static void queue_process(void)
 {
     uint32_t         ret;
-    fs_op_t  * const p_op = &m_queue.op[m_queue.rp];
+    fs_op_t  * const p_op      = &m_queue.op[m_queue.rp];
+    uint16_t         max_words = FS_MAX_WRITE_SIZE_WORDS;
 
     if (m_queue.count > 0)
     {
+#if (FS_RADIO_SYNC_ENABLED)
+        if (!radio_op_schedule(p_op, &max_words))
+        {
+            radio_wait();
+            return;
+        }
+#endif
+
         switch (p_op->op_code)
         {
             case FS_OP_STORE:
-                ret = store_execute(p_op);
+                ret = store_execute(p_op, max_words);
                 break;
 
             case FS_OP_ERASE:
@@ -162,7 +406,8 @@ static void queue_start(void)
     if (!(m_flags & FS_FLAG_PROCESSING) &&
         !(m_flags & FS_FLAG_FLASH_REQ_PENDING))
     {
-        m_flags |= FS_FLAG_PROCESSING;
+        m_flags &= ~FS_FLAG_RADIO_WAIT;
+        m_flags |=  FS_FLAG_PROCESSING;
         queue_process();
     }
 }
@@ -178,18 +423,24 @@ static void on_operation_success(fs_op_t * const p_op)
     {
         case FS_OP_STORE:
         {
-            uint16_t chunk_len;
-
-            if ((p_op->store.length_words - p_op->store.offset) < FS_MAX_WRITE_SIZE_WORDS)
-            {
-                chunk_len = p_op->store.length_words - p_op->store.offset;
-            }
-            else
+#if (FS_COALESCE_BUFFER_WORDS > 0)
+            if (m_coalesce_count > 0)
             {
-                chunk_len = FS_MAX_WRITE_SIZE_WORDS;
+                // All merged operations have finished.
+                uint32_t const count = m_coalesce_count;
+
+                m_coalesce_count = 0;
+
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    send_event(&m_queue.op[m_queue.rp], FS_SUCCESS);
+                    queue_advance();
+                }
+                break;
             }
+#endif
 
-            p_op->store.offset += chunk_len;
+            p_op->store.offset += p_op->store.chunk_len;
 
             if (p_op->store.offset == p_op->store.length_words)
             {
@@ -222,15 +473,37 @@ static void on_operation_success(fs_op_t * const p_op)
 
 // Flash operation failure callback handler. If the maximum number of retries has
 // been reached, notifies the application and advances the queue.
-static void on_operation_failure(fs_op_t const * const p_op)
+static void on_operation_failure(fs_op_t * const p_op)
 {
     if (++m_retry_count > FS_OP_MAX_RETRIES)
     {
         m_retry_count = 0;
 
+#if (FS_COALESCE_BUFFER_WORDS > 0)
+        if (m_coalesce_count > 0)
+        {
+            // Notify the application about each of the merged operations.
+            uint32_t const count = m_coalesce_count;
+
+            m_coalesce_count = 0;
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                send_event(&m_queue.op[m_queue.rp], FS_ERR_OPERATION_TIMEOUT);
+                queue_advance();
+            }
+            return;
+        }
+#endif
+
         send_event(p_op, FS_ERR_OPERATION_TIMEOUT);
         queue_advance();
     }
+    else
+    {
+        p_op->retries++;
+        m_stats.retries++;
+    }
 }
 
 
@@ -245,8 +518,7 @@ static bool queue_get_next_free(fs_op_t ** p_op)
         return false;
     }
 
-    idx = ((m_queue.rp + m_queue.count) < FS_QUEUE_SIZE) ?
-           (m_queue.rp + m_queue.count) : 0;
+    idx = (m_queue.rp + m_queue.count) % FS_QUEUE_SIZE;
 
     m_queue.count++;
 
@@ -259,6 +531,20 @@ static bool queue_get_next_free(fs_op_t ** p_op)
 }
 
 
+#if (FS_RADIO_SYNC_ENABLED)
+
+// The gap in radio activity has ended, but the radio has not become active.
+static void fs_radio_timeout_handler(void * p_context)
+{
+    if (m_flags & FS_FLAG_RADIO_WAIT)
+    {
+        queue_start();
+    }
+}
+
+#endif
+
+
 fs_ret_t fs_init(void)
 {
     uint32_t const   users         = FS_SECTION_VARS_COUNT;
@@ -271,6 +557,14 @@ fs_ret_t fs_init(void)
         return FS_SUCCESS;
     }
 
+#if (FS_RADIO_SYNC_ENABLED)
+    if (app_timer_create(&m_radio_timer, APP_TIMER_MODE_SINGLE_SHOT,
+                         fs_radio_timeout_handler) != NRF_SUCCESS)
+    {
+        return FS_ERR_INTERNAL;
+    }
+#endif
+
     #if 0
     // Check for configurations with duplicate priority.
     for (uint32_t i = 0; i < users; i++)
@@ -382,6 +676,10 @@ fs_ret_t fs_store(fs_config_t const * const p_config,
     p_op->store.p_dest       = p_dest;
     p_op->store.length_words = length_words;
 
+#if (FS_RADIO_SYNC_ENABLED)
+    (void)app_timer_cnt_get(&p_op->queued_ticks);
+#endif
+
     queue_start();
 
     return FS_SUCCESS;
@@ -438,6 +736,10 @@ fs_ret_t fs_erase(fs_config_t const * const p_config,
     p_op->erase.page           = ((uint32_t)p_page_addr / FS_PAGE_SIZE);
     p_op->erase.pages_to_erase = num_pages;
 
+#if (FS_RADIO_SYNC_ENABLED)
+    (void)app_timer_cnt_get(&p_op->queued_ticks);
+#endif
+
     queue_start();
 
     return FS_SUCCESS;
@@ -457,10 +759,70 @@ fs_ret_t fs_queued_op_count_get(uint32_t * const p_op_count)
 }
 
 
+fs_ret_t fs_stats_get(fs_stats_t * const p_stats)
+{
+    if (p_stats == NULL)
+    {
+        return FS_ERR_NULL_ARG;
+    }
+
+    *p_stats = m_stats;
+
+    return FS_SUCCESS;
+}
+
+
+void fs_stats_reset(void)
+{
+    memset(&m_stats, 0x00, sizeof(fs_stats_t));
+}
+
+
+void fs_radio_notification_handler(bool radio_active)
+{
+#if (FS_RADIO_SYNC_ENABLED)
+    uint32_t ticks;
+
+    (void)app_timer_cnt_get(&ticks);
+
+    if (radio_active)
+    {
+        if (m_radio.gap_started)
+        {
+            (void)app_timer_cnt_diff_compute(ticks, m_radio.gap_start, &m_radio.gap_ticks);
+        }
+
+        m_radio.active = true;
+    }
+    else
+    {
+        m_radio.active      = false;
+        m_radio.gap_started = true;
+        m_radio.gap_start   = ticks;
+
+        if (m_flags & FS_FLAG_RADIO_WAIT)
+        {
+            (void)app_timer_stop(m_radio_timer);
+            queue_start();
+        }
+    }
+#else
+    UNUSED_PARAMETER(radio_active);
+#endif
+}
+
+
 void fs_sys_event_handler(uint32_t sys_evt)
 {
     fs_op_t * const p_op = &m_queue.op[m_queue.rp];
-    
+
+    if ((sys_evt != NRF_EVT_FLASH_OPERATION_SUCCESS) &&
+        (sys_evt != NRF_EVT_FLASH_OPERATION_ERROR))
+    {
+        // Not a flash event.
+        return;
+    }
+
     if (m_flags & FS_FLAG_PROCESSING)
     {
         // A flash operation was initiated by this module. Handle the result.
@@ -489,6 +851,9 @@ void fs_sys_event_handler(uint32_t sys_evt)
     }
 
     // Resume processing the queue, if necessary.
-    queue_process();
+    if (m_flags & FS_FLAG_PROCESSING)
+    {
+        queue_process();
+    }
 }
 
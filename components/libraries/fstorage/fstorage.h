@@ -22,6 +22,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "section_vars.h"
 
 
@@ -94,6 +95,25 @@ typedef struct
 typedef void (*fs_cb_t)(fs_evt_t const * const evt, fs_ret_t result);
 
 
+/**@brief   fstorage statistics. Useful for tuning connection parameters.
+ *
+ * @details Latencies are measured from the time an operation is queued to the time its event is
+ *          sent, in RTC ticks. They are only measured if @ref FS_RADIO_SYNC_ENABLED is set.
+ */
+typedef struct
+{
+    uint32_t ops_completed;     //!< Number of operations which completed, successfully or not.
+    uint32_t ops_timed_out;     //!< Number of operations which failed with @ref FS_ERR_OPERATION_TIMEOUT.
+    uint32_t retries;           //!< Number of times a flash operation was retried.
+    uint32_t retries_max;       //!< Highest number of retries needed by a single operation.
+    uint32_t deferrals;         //!< Number of times an operation was delayed to fit a gap in radio activity.
+    uint32_t latency_last;      //!< Latency of the last operation which completed, in RTC ticks.
+    uint32_t latency_max;       //!< Highest latency of an operation, in RTC ticks.
+    uint32_t words_written;     //!< Number of words written by store operations which succeeded.
+    uint32_t pages_erased;      //!< Number of pages erased by erase operations which succeeded.
+} fs_stats_t;
+
+
 /**@brief   fstorage application-specific configuration.
  *
  * @details Specifies the callback to invoke when an operation completes, the number of flash pages
@@ -220,6 +240,30 @@ fs_ret_t fs_erase(fs_config_t const * const p_config,
 fs_ret_t fs_queued_op_count_get(uint32_t * const p_op_count);
 
 
+/**@brief   Function for retrieving fstorage statistics.
+ *
+ * @param[out]  p_stats     The statistics.
+ *
+ * @retval  FS_SUCCESS          If the statistics were retrieved successfully.
+ * @retval  FS_ERR_NULL_ARG     If @p p_stats is NULL.
+ */
+fs_ret_t fs_stats_get(fs_stats_t * const p_stats);
+
+
+/**@brief   Function for resetting fstorage statistics. */
+void fs_stats_reset(void);
+
+
+/**@brief   Function for handling Radio Notification events.
+ *
+ * @details Only has an effect if @ref FS_RADIO_SYNC_ENABLED is set. The function signature matches
+ *          @ref ble_radio_notification_evt_handler_t.
+ *
+ * @param[in]   radio_active    Whether the radio is about to become active or has become inactive.
+ */
+void fs_radio_notification_handler(bool radio_active);
+
+
 /**@brief   Function for handling system events from the SoftDevice.
  *
  * @details If any of the modules used by the application rely on fstorage, the application should
@@ -20,6 +20,8 @@
 #define FS_FLAG_PROCESSING          (1 << 1)  // The module is processing flash operations.
 // The module is waiting for a flash operation initiated by another module to complete.
 #define FS_FLAG_FLASH_REQ_PENDING   (1 << 2)
+// The module is waiting for a gap in radio activity to execute the next operation.
+#define FS_FLAG_RADIO_WAIT          (1 << 3)
 
 #define FS_ERASED_WORD              (0xFFFFFFFF)
 
@@ -73,6 +75,7 @@ typedef struct
             uint32_t const * p_dest;        // Destination of the data in flash.
             uint16_t         length_words;  // Length of the data to be written, in words.
             uint16_t         offset;        // Write offset.
+            uint16_t         chunk_len;     // Length of the chunk being written, in words.
         } store;
         struct
         {
@@ -81,6 +84,10 @@ typedef struct
             uint16_t pages_to_erase;
         } erase;
     };
+    uint8_t              retries;           // Number of times the operation was retried.
+#if (FS_RADIO_SYNC_ENABLED)
+    uint32_t             queued_ticks;      // RTC counter value when the operation was queued.
+#endif
 } fs_op_t;
 
 #if defined(__CC_ARM)
@@ -104,6 +111,37 @@ typedef struct
 } fs_op_queue_t;
 
 
+// Maximum number of words which can be written by a single merged store operation.
+#if (FS_COALESCE_BUFFER_WORDS < FS_MAX_WRITE_SIZE_WORDS)
+    #define FS_COALESCE_MAX_WORDS   (FS_COALESCE_BUFFER_WORDS)
+#else
+    #define FS_COALESCE_MAX_WORDS   (FS_MAX_WRITE_SIZE_WORDS)
+#endif
+
+
+#if (FS_RADIO_SYNC_ENABLED)
+
+// Converts RTC ticks to microseconds.
+#define FS_RADIO_TICKS_TO_US(ticks) \
+    ((uint32_t)(((uint64_t)(ticks) * 1000000 * (FS_RADIO_SYNC_TIMER_PRESCALER + 1)) / 32768))
+
+// Converts microseconds to RTC ticks, rounding up.
+#define FS_RADIO_US_TO_TICKS(us) \
+    ((uint32_t)((((uint64_t)(us) * 32768) + (1000000 * (FS_RADIO_SYNC_TIMER_PRESCALER + 1)) - 1) / \
+                (1000000 * (FS_RADIO_SYNC_TIMER_PRESCALER + 1))))
+
+// Timing of radio activity, as learned from Radio Notification events.
+typedef struct
+{
+    bool     active;        // The radio is active.
+    bool     gap_started;   // The end of a radio event has been notified.
+    uint32_t gap_start;     // RTC counter value at the end of the last radio event.
+    uint32_t gap_ticks;     // Length of the last gap in radio activity, zero if unknown.
+} fs_radio_t;
+
+#endif
+
+
 // Size of a flash page in bytes.
 #if   defined (NRF51)
     #define FS_PAGE_SIZE    (1024)
@@ -34,29 +34,52 @@ static uint8_t         m_user_count;                  /**< Number of registered
 static gpiote_user_t * mp_users = NULL;               /**< Array of GPIOTE users. */
 static uint32_t        m_pins;                        /**< Mask of initialized pins. */
 static uint32_t        m_last_pins_state;             /**< Most recent state of pins. */
+static uint32_t        m_pin_users[NO_OF_PINS];       /**< For each pin, mask of the enabled users monitoring it. */
 
 #define MODULE_INITIALIZED (mp_users != NULL)
 #include "sdk_macros.h"
 
+/**@brief Returns the index of the lowest set bit in a word.
+ *
+ * @param word  The word to examine. Must be different from 0.
+ */
+static uint32_t lowest_set_bit_get(uint32_t word)
+{
+#if (__CORTEX_M >= 0x03)
+    return __CLZ(__RBIT(word));
+#else
+    uint32_t bit = 0;
+
+    if ((word & 0xFFFF) == 0) { word >>= 16; bit += 16; }
+    if ((word & 0x00FF) == 0) { word >>= 8;  bit += 8;  }
+    if ((word & 0x000F) == 0) { word >>= 4;  bit += 4;  }
+    if ((word & 0x0003) == 0) { word >>= 2;  bit += 2;  }
+    if ((word & 0x0001) == 0) {              bit += 1;  }
+
+    return bit;
+#endif
+}
+
 void gpiote_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
 {
-    int i;
     uint32_t pin_mask = 1 << pin;
     bool hitolo = (m_last_pins_state & pin_mask) ? true : false;
     m_last_pins_state = nrf_gpio_pins_read();
 
-    for (i = 0; i < m_user_count; i++)
+    // Only the enabled users monitoring this pin are visited.
+    uint32_t users = m_pin_users[pin];
+    while (users != 0)
     {
-        if (mp_users[i].enabled && (pin_mask & mp_users[i].pins_mask))
+        gpiote_user_t * p_user = &mp_users[lowest_set_bit_get(users)];
+        users &= (users - 1);
+
+        if ((pin_mask & p_user->pins_high_to_low_mask) && hitolo)
         {
-            if ((pin_mask & mp_users[i].pins_high_to_low_mask) && hitolo)
-            {
-                mp_users[i].event_handler(0,pin_mask);
-            }
-            else if ((pin_mask & mp_users[i].pins_low_to_high_mask) && !hitolo)
-            {
-                mp_users[i].event_handler(pin_mask,0);
-            }
+            p_user->event_handler(0,pin_mask);
+        }
+        else if ((pin_mask & p_user->pins_low_to_high_mask) && !hitolo)
+        {
+            p_user->event_handler(pin_mask,0);
         }
     }
 }
@@ -76,6 +99,11 @@ uint32_t app_gpiote_init(uint8_t max_users, void * p_buffer)
         return NRF_ERROR_INVALID_PARAM;
     }
 
+    if (max_users > APP_GPIOTE_MAX_USERS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
     // Initialize file globals.
     mp_users             = (gpiote_user_t *)p_buffer;
     m_user_array_size    = max_users;
@@ -83,6 +111,7 @@ uint32_t app_gpiote_init(uint8_t max_users, void * p_buffer)
     m_pins              = 0;
 
     memset(mp_users, 0, m_user_array_size * sizeof(gpiote_user_t));
+    memset(m_pin_users, 0, sizeof(m_pin_users));
 
     if (nrf_drv_gpiote_is_init()==false)
     {
@@ -150,34 +179,31 @@ __STATIC_INLINE uint32_t error_check(app_gpiote_user_id_t user_id)
     return NRF_SUCCESS;
 }
 /**
- * @brief Function for enabling event on pin (if not yet enabled) or disabling the event if no other
- *        user requires it.
+ * @brief Function for adding the user to the dispatch mask of a pin, enabling the pin event if no
+ *        other user requires it yet, or for removing the user and disabling the event if no other
+ *        user requires it anymore.
  *
- * @param pin    Pin to enable
- * @param enable If true function will attempt to enable the pin else it will attempt to disable it.
+ * @param pin      Pin to enable
+ * @param user_id  User id.
+ * @param enable   If true function will attempt to enable the pin else it will attempt to disable it.
  */
-static void pin_event_enable(uint32_t pin, bool enable)
+static void pin_event_enable(uint32_t pin, app_gpiote_user_id_t user_id, bool enable)
 {
-    uint32_t i;
-    uint32_t pin_mask = 1UL << pin;
-    bool enabled = false;
-    //search if any user already enabled given pin
-    for (i = 0; i < m_user_count; i++)
-    {
-        if (mp_users[i].enabled && (mp_users[i].pins_mask & pin_mask))
-        {
-            enabled = true;
-            break;
-        }
-    }
-    if (!enabled)
+    uint32_t user_mask = 1UL << user_id;
+
+    if (enable)
     {
-        if (enable)
+        if (m_pin_users[pin] == 0)
         {
             m_last_pins_state = nrf_gpio_pins_read();
             nrf_drv_gpiote_in_event_enable(pin, true);
         }
-        else
+        m_pin_users[pin] |= user_mask;
+    }
+    else
+    {
+        m_pin_users[pin] &= ~user_mask;
+        if (m_pin_users[pin] == 0)
         {
             nrf_drv_gpiote_in_event_disable(pin);
         }
@@ -199,15 +225,11 @@ static uint32_t user_enable(app_gpiote_user_id_t user_id, bool enable)
 
     if (ret_code == NRF_SUCCESS)
     {
-        uint32_t i;
-        uint32_t mask = 1UL;
-        for (i = 0; i < 32; i++)
+        uint32_t pins = mp_users[user_id].pins_mask;
+        while (pins != 0)
         {
-            if (mp_users[user_id].pins_mask & mask)
-            {
-                pin_event_enable(i, enable);
-            }
-            mask <<= 1;
+            pin_event_enable(lowest_set_bit_get(pins), user_id, enable);
+            pins &= (pins - 1);
         }
     }
     return ret_code;
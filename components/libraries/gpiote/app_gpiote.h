@@ -48,6 +48,7 @@
 
 #define GPIOTE_USER_NODE_SIZE   24          /**< Size of app_gpiote.gpiote_user_t (only for use inside APP_GPIOTE_BUF_SIZE()). */
 #define NO_OF_PINS              32          /**< Number of GPIO pins on the \nRFXX chip. */
+#define APP_GPIOTE_MAX_USERS    32          /**< Maximum number of GPIOTE users. */
 
 /**@brief Compute number of bytes required to hold the GPIOTE data structures.
  *
@@ -90,7 +91,8 @@ typedef void (*app_gpiote_input_event_handler_t)(void);
  * @note Normally initialization should be done using the APP_GPIOTE_INIT() macro, as that will
  *       allocate the buffer needed by the GPIOTE module (including aligning the buffer correctly).
  *
- * @param[in]   max_users               Maximum number of GPIOTE users.
+ * @param[in]   max_users               Maximum number of GPIOTE users, up to
+ *                                      @ref APP_GPIOTE_MAX_USERS.
  * @param[in]   p_buffer                Pointer to memory buffer for internal use in the app_gpiote
  *                                      module. The size of the buffer can be computed using the
  *                                      APP_GPIOTE_BUF_SIZE() macro. The buffer must be aligned to 
@@ -98,7 +100,7 @@ typedef void (*app_gpiote_input_event_handler_t)(void);
  *
  * @retval      NRF_SUCCESS             Successful initialization.
  * @retval      NRF_ERROR_INVALID_PARAM Invalid parameter (buffer not aligned to a 4 byte
- *                                      boundary).
+ *                                      boundary, or too many users).
  */
 uint32_t app_gpiote_init(uint8_t max_users, void * p_buffer);
 
@@ -0,0 +1,308 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_gpiote_timestamp.h"
+#include <stddef.h>
+#include "nrf_assert.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+// Edges are counted in the counter timer and read with a software capture
+// to this channel.
+#define COUNTER_CC_CHANNEL NRF_TIMER_CC_CHANNEL0
+
+static app_gpiote_timestamp_t * mp_instances[APP_GPIOTE_TIMESTAMP_MAX_INSTANCES];
+
+
+static app_gpiote_timestamp_t * instance_find(nrf_drv_gpiote_pin_t pin)
+{
+    uint32_t i;
+
+    for (i = 0; i < APP_GPIOTE_TIMESTAMP_MAX_INSTANCES; i++)
+    {
+        if ((mp_instances[i] != NULL) && (mp_instances[i]->config.pin == pin))
+        {
+            return mp_instances[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+static void pin_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    UNUSED_PARAMETER(action);
+
+    app_gpiote_timestamp_t * p_instance = instance_find(pin);
+    if (p_instance == NULL)
+    {
+        return;
+    }
+
+    app_gpiote_timestamp_config_t const * p_config = &p_instance->config;
+
+    uint32_t timestamp = nrf_drv_timer_capture_get(p_config->p_timer,
+                                                   p_config->cc_channel);
+    uint32_t edges     = 1;
+
+    if (p_config->p_counter != NULL)
+    {
+        // The edge counter is read after the timestamp, so an edge occurring
+        // in between is counted as lost and its pending event is ignored in
+        // the next interrupt.
+        uint32_t edge_count = nrf_drv_timer_capture(p_config->p_counter,
+                                                    COUNTER_CC_CHANNEL);
+        edges = edge_count - p_instance->edge_count;
+        p_instance->edge_count = edge_count;
+
+        if (edges == 0)
+        {
+            return;
+        }
+    }
+    p_instance->lost += edges - 1;
+
+    uint32_t write_idx = p_instance->write_idx;
+    uint32_t pending   = write_idx - p_instance->read_idx;
+
+    if (pending < p_config->buffer_size)
+    {
+        p_config->p_buffer[write_idx & (p_config->buffer_size - 1)] = timestamp;
+        p_instance->write_idx = write_idx + 1;
+        ++pending;
+    }
+    else
+    {
+        ++p_instance->lost;
+    }
+
+    if ((p_config->handler != NULL) && (pending >= p_config->threshold))
+    {
+        p_config->handler(p_instance, (uint16_t)pending);
+    }
+}
+
+
+static void counter_event_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+
+// Sets up the following connection:
+// - GPIOTE IN -> time base CAPTURE[cc_channel],
+//   and if the counter timer is used:
+//              -> counter timer COUNT (fork).
+static ret_code_t ppi_channel_setup(app_gpiote_timestamp_t * p_instance)
+{
+    app_gpiote_timestamp_config_t const * p_config = &p_instance->config;
+    ret_code_t err_code;
+
+    err_code = nrf_drv_ppi_channel_assign(p_instance->ppi_channel,
+        nrf_drv_gpiote_in_event_addr_get(p_config->pin),
+        nrf_drv_timer_capture_task_address_get(p_config->p_timer,
+                                               p_config->cc_channel));
+    if ((err_code == NRF_SUCCESS) && (p_config->p_counter != NULL))
+    {
+        err_code = nrf_drv_ppi_channel_fork_assign(p_instance->ppi_channel,
+            nrf_drv_timer_task_address_get(p_config->p_counter,
+                                           NRF_TIMER_TASK_COUNT));
+    }
+
+    return err_code;
+}
+
+
+static ret_code_t hardware_init(app_gpiote_timestamp_t * p_instance)
+{
+    app_gpiote_timestamp_config_t const * p_config = &p_instance->config;
+    ret_code_t err_code;
+
+    if (p_config->p_counter != NULL)
+    {
+        nrf_drv_timer_config_t timer_config;
+
+        timer_config.frequency          = NRF_TIMER_FREQ_16MHz;
+        timer_config.mode               = NRF_TIMER_MODE_COUNTER;
+        timer_config.bit_width          = NRF_TIMER_BIT_WIDTH_32;
+        timer_config.interrupt_priority = APP_IRQ_PRIORITY_LOW;
+        timer_config.p_context          = p_instance;
+        err_code = nrf_drv_timer_init(p_config->p_counter, &timer_config,
+                                      counter_event_handler);
+        VERIFY_SUCCESS(err_code);
+    }
+
+    nrf_drv_gpiote_in_config_t in_config;
+
+    in_config.sense       = p_config->polarity;
+    in_config.pull        = p_config->pull;
+    in_config.is_watcher  = false;
+    in_config.hi_accuracy = true;
+    err_code = nrf_drv_gpiote_in_init(p_config->pin, &in_config, pin_event_handler);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_alloc(&p_instance->ppi_channel);
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = ppi_channel_setup(p_instance);
+            if (err_code == NRF_SUCCESS)
+            {
+                return NRF_SUCCESS;
+            }
+            (void)nrf_drv_ppi_channel_free(p_instance->ppi_channel);
+        }
+        nrf_drv_gpiote_in_uninit(p_config->pin);
+    }
+
+    if (p_config->p_counter != NULL)
+    {
+        nrf_drv_timer_uninit(p_config->p_counter);
+    }
+    return err_code;
+}
+
+
+ret_code_t app_gpiote_timestamp_init(app_gpiote_timestamp_t *              p_instance,
+                                     app_gpiote_timestamp_config_t const * p_config)
+{
+    ASSERT(p_instance != NULL);
+    ASSERT(p_config != NULL);
+    ASSERT(p_config->p_timer != NULL);
+    ASSERT(p_config->p_buffer != NULL);
+
+    uint32_t   slot;
+    ret_code_t err_code;
+
+    if ((p_config->buffer_size == 0) ||
+        ((p_config->buffer_size & (p_config->buffer_size - 1)) != 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (slot = 0; slot < APP_GPIOTE_TIMESTAMP_MAX_INSTANCES; slot++)
+    {
+        if (mp_instances[slot] == NULL)
+        {
+            break;
+        }
+    }
+    if (slot == APP_GPIOTE_TIMESTAMP_MAX_INSTANCES)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    if (!nrf_drv_gpiote_is_init())
+    {
+        err_code = nrf_drv_gpiote_init();
+        VERIFY_SUCCESS(err_code);
+    }
+
+    err_code = nrf_drv_ppi_init();
+    if ((err_code != NRF_SUCCESS) && (err_code != MODULE_ALREADY_INITIALIZED))
+    {
+        return err_code;
+    }
+
+    p_instance->config     = *p_config;
+    p_instance->write_idx  = 0;
+    p_instance->read_idx   = 0;
+    p_instance->edge_count = 0;
+    p_instance->lost       = 0;
+
+    err_code = hardware_init(p_instance);
+    VERIFY_SUCCESS(err_code);
+
+    mp_instances[slot] = p_instance;
+
+    return NRF_SUCCESS;
+}
+
+
+void app_gpiote_timestamp_uninit(app_gpiote_timestamp_t * p_instance)
+{
+    uint32_t i;
+
+    app_gpiote_timestamp_disable(p_instance);
+
+    (void)nrf_drv_ppi_channel_free(p_instance->ppi_channel);
+    nrf_drv_gpiote_in_uninit(p_instance->config.pin);
+    if (p_instance->config.p_counter != NULL)
+    {
+        nrf_drv_timer_uninit(p_instance->config.p_counter);
+    }
+
+    for (i = 0; i < APP_GPIOTE_TIMESTAMP_MAX_INSTANCES; i++)
+    {
+        if (mp_instances[i] == p_instance)
+        {
+            mp_instances[i] = NULL;
+        }
+    }
+}
+
+
+void app_gpiote_timestamp_enable(app_gpiote_timestamp_t * p_instance)
+{
+    if (p_instance->config.p_counter != NULL)
+    {
+        nrf_drv_timer_clear(p_instance->config.p_counter);
+        p_instance->edge_count = 0;
+        nrf_drv_timer_enable(p_instance->config.p_counter);
+    }
+
+    (void)nrf_drv_ppi_channel_enable(p_instance->ppi_channel);
+    nrf_drv_gpiote_in_event_enable(p_instance->config.pin, true);
+}
+
+
+void app_gpiote_timestamp_disable(app_gpiote_timestamp_t * p_instance)
+{
+    nrf_drv_gpiote_in_event_disable(p_instance->config.pin);
+    (void)nrf_drv_ppi_channel_disable(p_instance->ppi_channel);
+
+    if (p_instance->config.p_counter != NULL)
+    {
+        nrf_drv_timer_disable(p_instance->config.p_counter);
+    }
+}
+
+
+uint16_t app_gpiote_timestamp_read(app_gpiote_timestamp_t * p_instance,
+                                   uint32_t *               p_dst,
+                                   uint16_t                 max_count)
+{
+    uint32_t read_idx = p_instance->read_idx;
+    uint32_t count    = p_instance->write_idx - read_idx;
+    uint32_t mask     = p_instance->config.buffer_size - 1;
+    uint32_t i;
+
+    if (count > max_count)
+    {
+        count = max_count;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        p_dst[i] = p_instance->config.p_buffer[(read_idx + i) & mask];
+    }
+    p_instance->read_idx = read_idx + count;
+
+    return (uint16_t)count;
+}
+
+
+uint32_t app_gpiote_timestamp_lost_get(app_gpiote_timestamp_t const * p_instance)
+{
+    return p_instance->lost;
+}
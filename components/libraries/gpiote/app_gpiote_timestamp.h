@@ -0,0 +1,160 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_GPIOTE_TIMESTAMP_H__
+#define APP_GPIOTE_TIMESTAMP_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_drv_gpiote.h"
+#include "nrf_drv_timer.h"
+#include "nrf_drv_ppi.h"
+#include "sdk_errors.h"
+
+/**
+ * @defgroup app_gpiote_timestamp GPIOTE edge timestamping
+ * @{
+ * @ingroup app_gpiote
+ *
+ * @brief Module for recording the time of edges on input pins.
+ *
+ * @details The GPIOTE IN event of the pin is connected through PPI to
+ *          a CAPTURE task of a timer, so the time of each edge is latched by
+ *          hardware, independently of the interrupt latency. The GPIOTE
+ *          interrupt only moves the captured value to a ring buffer, and
+ *          the application is notified once a given number of timestamps is
+ *          collected.
+ *
+ *          The capture register holds one value, so it must be read before
+ *          the next edge occurs. If an optional counter timer is provided,
+ *          edges are also counted by hardware and the timestamps that were
+ *          overwritten before they could be read are detected and counted as
+ *          lost.
+ */
+
+#ifndef APP_GPIOTE_TIMESTAMP_MAX_INSTANCES
+#define APP_GPIOTE_TIMESTAMP_MAX_INSTANCES 4 /**< Maximum number of instances initialized at the same time. */
+#endif
+
+typedef struct app_gpiote_timestamp_s app_gpiote_timestamp_t;
+
+/**
+ * @brief Timestamp handler prototype.
+ *
+ * Called from the GPIOTE interrupt when the number of timestamps in the ring
+ * buffer reaches the configured threshold, and on every following edge until
+ * the timestamps are read with @ref app_gpiote_timestamp_read.
+ *
+ * @param[in] p_instance Pointer to the instance.
+ * @param[in] count      Number of timestamps in the ring buffer.
+ */
+typedef void (* app_gpiote_timestamp_handler_t)(app_gpiote_timestamp_t * p_instance,
+                                                uint16_t                 count);
+
+/**@brief Timestamping configuration. */
+typedef struct
+{
+    nrf_drv_gpiote_pin_t           pin;         /**< Input pin. */
+    nrf_gpiote_polarity_t          polarity;    /**< Edges to be recorded. */
+    nrf_gpio_pin_pull_t            pull;        /**< Pulling mode of the pin. */
+    nrf_drv_timer_t const *        p_timer;     /**< Time base. Must be initialized and enabled by the application; can be shared by several instances that use different capture channels, for example the @ref app_timestamp timer from @ref app_timestamp_timer_get. */
+    nrf_timer_cc_channel_t         cc_channel;  /**< Capture channel of the time base used by this instance. */
+    nrf_drv_timer_t const *        p_counter;   /**< Timer used by this instance to count edges, or NULL if lost timestamps should not be detected. */
+    uint32_t *                     p_buffer;    /**< Ring buffer for timestamps. */
+    uint16_t                       buffer_size; /**< Size of the ring buffer. Must be a power of two. */
+    uint16_t                       threshold;   /**< Number of timestamps after which the handler is called. */
+    app_gpiote_timestamp_handler_t handler;     /**< Timestamp handler. Can be NULL if the buffer is polled. */
+} app_gpiote_timestamp_config_t;
+
+/**@brief Timestamping instance. The content is internal to the module. */
+struct app_gpiote_timestamp_s
+{
+    app_gpiote_timestamp_config_t config;      /**< Configuration. */
+    nrf_ppi_channel_t             ppi_channel; /**< PPI channel connecting the pin to the timers. */
+    volatile uint32_t             write_idx;   /**< Ring buffer write counter. */
+    volatile uint32_t             read_idx;    /**< Ring buffer read counter. */
+    uint32_t                      edge_count;  /**< Edge counter value at the last capture. */
+    volatile uint32_t             lost;        /**< Number of lost timestamps. */
+};
+
+/**
+ * @brief Function for initializing a timestamping instance.
+ *
+ * The GPIOTE and PPI drivers are initialized if needed. The counter timer,
+ * if provided, is initialized by this function.
+ *
+ * @param[out] p_instance Pointer to the instance.
+ * @param[in]  p_config   Pointer to the configuration.
+ *
+ * @retval NRF_SUCCESS             If the instance was initialized.
+ * @retval NRF_ERROR_INVALID_PARAM If the buffer size is not a power of two.
+ * @retval NRF_ERROR_NO_MEM        If there are no free instance slots, GPIOTE
+ *                                 channels or PPI channels.
+ * @return Other errors from the GPIOTE, PPI or timer drivers.
+ */
+ret_code_t app_gpiote_timestamp_init(app_gpiote_timestamp_t *              p_instance,
+                                     app_gpiote_timestamp_config_t const * p_config);
+
+/**
+ * @brief Function for uninitializing a timestamping instance.
+ *
+ * @param[in] p_instance Pointer to the instance.
+ */
+void app_gpiote_timestamp_uninit(app_gpiote_timestamp_t * p_instance);
+
+/**
+ * @brief Function for starting recording of edges.
+ *
+ * @param[in] p_instance Pointer to the instance.
+ */
+void app_gpiote_timestamp_enable(app_gpiote_timestamp_t * p_instance);
+
+/**
+ * @brief Function for stopping recording of edges.
+ *
+ * Timestamps already in the ring buffer can still be read.
+ *
+ * @param[in] p_instance Pointer to the instance.
+ */
+void app_gpiote_timestamp_disable(app_gpiote_timestamp_t * p_instance);
+
+/**
+ * @brief Function for reading timestamps from the ring buffer.
+ *
+ * Can be called from the timestamp handler or the main context.
+ *
+ * @param[in]  p_instance Pointer to the instance.
+ * @param[out] p_dst      Buffer for the timestamps (in time base ticks).
+ * @param[in]  max_count  Maximum number of timestamps to read.
+ *
+ * @return Number of timestamps read.
+ */
+uint16_t app_gpiote_timestamp_read(app_gpiote_timestamp_t * p_instance,
+                                   uint32_t *               p_dst,
+                                   uint16_t                 max_count);
+
+/**
+ * @brief Function for getting the number of lost timestamps.
+ *
+ * A timestamp is lost if it is overwritten in the capture register before it
+ * is read (detected only when the counter timer is used) or if the ring buffer
+ * is full.
+ *
+ * @param[in] p_instance Pointer to the instance.
+ *
+ * @return Number of timestamps lost since the instance was initialized.
+ */
+uint32_t app_gpiote_timestamp_lost_get(app_gpiote_timestamp_t const * p_instance);
+
+/** @} */
+
+#endif // APP_GPIOTE_TIMESTAMP_H__
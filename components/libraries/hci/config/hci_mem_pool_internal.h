@@ -27,6 +27,8 @@
 
 #define RX_BUF_QUEUE_SIZE 4u           /**< RX buffer element size. */
 
+#define TX_BUF_QUEUE_SIZE 1u           /**< Number of TX buffers. Should be at least HCI_TRANSPORT_WINDOW_SIZE to fill the TX window. */
+
 #endif // MEM_POOL_INTERNAL_H__
  
 /** @} */
@@ -15,6 +15,18 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#ifndef TX_BUF_QUEUE_SIZE
+#define TX_BUF_QUEUE_SIZE 1u                                        /**< Number of TX buffers which can be allocated at the same time. */
+#endif
+
+#if (TX_BUF_QUEUE_SIZE < 1)
+#error "TX_BUF_QUEUE_SIZE must be at least 1."
+#endif
+
+#if (RX_BUF_QUEUE_SIZE < 1) || (RX_BUF_QUEUE_SIZE > 32) || ((RX_BUF_QUEUE_SIZE & (RX_BUF_QUEUE_SIZE - 1)) != 0)
+#error "RX_BUF_QUEUE_SIZE must be a power of two, 32 at most."
+#endif
+
 /**@brief RX buffer element instance structure. 
  */
 typedef struct 
@@ -36,14 +48,17 @@ typedef struct
     uint32_t           free_index;                                  /**< Free position index. */                                                                                                                  
 } rx_buffer_queue_t;
 
-static bool              m_is_tx_allocated;                         /**< Boolean value to determine if the TX buffer is allocated. */
+static uint8_t           m_tx_buffer[TX_BUF_QUEUE_SIZE][TX_BUF_SIZE]; /**< TX buffer memory arrays. */
+static uint32_t          m_tx_free_index;                           /**< Index of the oldest allocated TX buffer, the next one to be freed. */
+static uint32_t          m_tx_allocated_count;                      /**< Number of allocated TX buffers. */
 static rx_buffer_elem_t  m_rx_buffer_elem_queue[RX_BUF_QUEUE_SIZE]; /**< RX buffer element instances. */
 static rx_buffer_queue_t m_rx_buffer_queue;                         /**< RX buffer queue element instance. */
 
 
 uint32_t hci_mem_pool_open(void)
 {
-    m_is_tx_allocated                      = false;    
+    m_tx_free_index                        = 0;
+    m_tx_allocated_count                   = 0;
     m_rx_buffer_queue.p_buffer             = m_rx_buffer_elem_queue;
     m_rx_buffer_queue.free_window_count    = RX_BUF_QUEUE_SIZE;
     m_rx_buffer_queue.free_available_count = 0;
@@ -64,8 +79,6 @@ uint32_t hci_mem_pool_close(void)
 
 uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer)
 {
-    static uint8_t tx_buffer[TX_BUF_SIZE];  
-
     uint32_t err_code;
     
     if (pp_buffer == NULL)
@@ -73,11 +86,11 @@ uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer)
         return NRF_ERROR_NULL;
     }
     
-    if (!m_is_tx_allocated)
+    if (m_tx_allocated_count < TX_BUF_QUEUE_SIZE)
     {        
-            m_is_tx_allocated = true;
-            *pp_buffer        = tx_buffer;
-            err_code          = NRF_SUCCESS;
+            *pp_buffer = m_tx_buffer[(m_tx_free_index + m_tx_allocated_count) % TX_BUF_QUEUE_SIZE];
+            ++m_tx_allocated_count;
+            err_code   = NRF_SUCCESS;
     }
     else
     {
@@ -90,7 +103,12 @@ uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer)
 
 uint32_t hci_mem_pool_tx_free(void)
 {
-    m_is_tx_allocated = false;
+    // Buffers are freed in the order they were allocated.
+    if (m_tx_allocated_count != 0)
+    {
+        m_tx_free_index = (m_tx_free_index + 1u) % TX_BUF_QUEUE_SIZE;
+        --m_tx_allocated_count;
+    }
     
     return NRF_SUCCESS;
 }
@@ -170,12 +188,14 @@ uint32_t hci_mem_pool_rx_consume(uint8_t * p_buffer)
         }
         while (consume_index != m_rx_buffer_queue.read_index);
 
-        while (!(m_rx_buffer_queue.free_index & (1 << start_index)) && 
+        // Return the consumed buffers at the start of the free area to the free window. Buffers
+        // consumed out of order stay in the free area until the buffers before them are consumed.
+        while (!(m_rx_buffer_queue.free_index & (1u << start_index)) && 
                 (m_rx_buffer_queue.free_available_count != 0))
         {
             --(m_rx_buffer_queue.free_available_count);
             ++(m_rx_buffer_queue.free_window_count);            
-            start_index = (consume_index + 1u) & (RX_BUF_QUEUE_SIZE - 1u);
+            start_index = (start_index + 1u) & (RX_BUF_QUEUE_SIZE - 1u);
         }
     }
     else
@@ -61,6 +61,8 @@ uint32_t hci_mem_pool_open(void);
 uint32_t hci_mem_pool_close(void);
 
 /**@brief Function for allocating requested amount of TX memory.
+ *
+ * @details Up to TX_BUF_QUEUE_SIZE buffers of TX_BUF_SIZE bytes can be allocated at the same time.
  *
  * @param[out] pp_buffer        Pointer to the allocated memory.
  *
@@ -30,8 +30,17 @@
 #define INITIAL_ACK_NUMBER_EXPECTED     1u                                                                 /**< Initial acknowledge number expected. */
 #define INITIAL_ACK_NUMBER_TX           INITIAL_ACK_NUMBER_EXPECTED                                        /**< Initial acknowledge number transmitted. */
 #define INVALID_PKT_TYPE                0xFFFFFFFFu                                                        /**< Internal invalid packet type value. */
-#define MAX_TRANSMISSION_TIME           (ROUNDED_DIV((MAX_PACKET_SIZE_IN_BITS * 1000u), USED_BAUD_RATE))   /**< Max transmission time of a single application packet over UART in units of mseconds. */      
-#define RETRANSMISSION_TIMEOUT_IN_MS    (3u * MAX_TRANSMISSION_TIME)                                       /**< Retransmission timeout for application packet in units of mseconds. */      
+#define MAX_TRANSMISSION_TIME           (ROUNDED_DIV((MAX_PACKET_SIZE_IN_BITS * 1000u), USED_BAUD_RATE))   /**< Max transmission time of a single application packet over UART in units of mseconds. */
+
+#ifndef HCI_TRANSPORT_WINDOW_SIZE
+#define HCI_TRANSPORT_WINDOW_SIZE       1u                                                                 /**< Max number of application packets written before the first of them is acknowledged (1 to 7). */
+#endif
+
+#if (HCI_TRANSPORT_WINDOW_SIZE < 1) || (HCI_TRANSPORT_WINDOW_SIZE > 7)
+#error "HCI_TRANSPORT_WINDOW_SIZE must be between 1 and 7."
+#endif
+
+#define RETRANSMISSION_TIMEOUT_IN_MS    ((2u + HCI_TRANSPORT_WINDOW_SIZE) * MAX_TRANSMISSION_TIME)          /**< Retransmission timeout for application packet in units of mseconds. A full window has to be transmitted before the last packet of it can be acknowledged. */
 #define APP_TIMER_PRESCALER             0                                                                  /**< Value of the RTC1 PRESCALER register. */
 #define RETRANSMISSION_TIMEOUT_IN_TICKS APP_TIMER_TICKS(RETRANSMISSION_TIMEOUT_IN_MS, APP_TIMER_PRESCALER) /**< Retransmission timeout for application packet in units of timer ticks. */             
 #define MAX_RETRY_COUNT                 5u                                                                 /**< Max retransmission retry count for application packets. */
@@ -40,9 +49,8 @@
 /**@brief States of the TX state machine. */
 typedef enum
 {
-    TX_STATE_IDLE,                                                   /**< State for: no application transmission packet processing in progress. */                                                                                             
-    TX_STATE_PENDING,                                                /**< State for: TX in progress in slip layer and TX-done event is waited for to signal the end of transmission. */
-    TX_STATE_ACTIVE                                                  /**< State for: application packet has been delivered to slip for transmission and peer transport entity acknowledgement packet is waited for. */
+    TX_STATE_IDLE,                                                   /**< State for: no application transmission packet processing in progress. */
+    TX_STATE_ACTIVE                                                  /**< State for: application packets have been written and peer transport entity acknowledgement packet is waited for. Packets of the window are delivered to slip one at a time, on HCI_SLIP_TX_DONE. */
 } tx_state_t;
 
 /**@brief TX state machine events. */
@@ -61,13 +69,15 @@ static hci_transport_tx_done_handler_t m_transport_tx_done_handle;   /**< TX don
 static hci_transport_event_handler_t   m_transport_event_handle;     /**< Event handler callback function. */
 static uint8_t *                       mp_slip_used_rx_buffer;       /**< Reference to RX buffer used by the slip layer. */
 static uint32_t                        m_packet_expected_seq_number; /**< Sequence number counter of the packet expected to be received . */ 
-static uint32_t                        m_packet_transmit_seq_number; /**< Sequence number counter of the transmitted packet for which acknowledgement packet is waited for. */ 
-static uint8_t *                       mp_tx_buffer;                 /**< Pointer to TX application buffer to be transmitted. */
-static uint32_t                        m_tx_buffer_length;           /**< Length of application TX packet data to be transmitted in bytes. */
-static bool                            m_is_slip_decode_ready;       /**< Boolean to determine has slip decode been completed or not. */
+static uint32_t                        m_packet_transmit_seq_number; /**< Sequence number counter of the oldest transmitted packet for which acknowledgement packet is waited for. */
+static uint8_t *                       mp_tx_window_buf[HCI_TRANSPORT_WINDOW_SIZE]; /**< Packets written and not yet acknowledged, in sequence number order from m_tx_window_first. */
+static uint16_t                        m_tx_window_len[HCI_TRANSPORT_WINDOW_SIZE];  /**< Lengths of the packets of the window, including packet header and CRC, in bytes. */
+static uint32_t                        m_tx_window_first;            /**< Index of the oldest packet of the window. */
+static uint32_t                        m_tx_window_count;            /**< Number of packets in the window. */
+static uint32_t                        m_tx_window_sent;             /**< Number of packets of the window delivered to slip since the last (re)transmission of the window started. */
+static uint32_t                        m_slip_decode_ready_count;    /**< Number of slip decoded application packets not yet extracted. */
 APP_TIMER_DEF(m_app_timer_id);                                       /**< Application timer id. */
 static uint32_t                        m_tx_retry_counter;           /**< Application packet retransmission counter. */
-static hci_transport_tx_done_result_t  m_tx_done_result_code;        /**< TX done event callback function result code. */
 static uint8_t                         m_rx_ack_buffer[ACK_BUF_SIZE];/**< RX buffer big enough to hold an acknowledgement packet and which is taken in use upon receiving  HCI_SLIP_RX_OVERFLOW event. */
 
 
@@ -230,6 +240,35 @@ static __INLINE uint32_t packet_type_decode(const uint8_t * p_buffer, uint32_t l
 }
 
 
+/**@brief Function for registering a new RX buffer to the slip layer after a packet was dropped.
+ *
+ * If existing mem pool produced RX buffer exists reuse that one. If existing mem pool produced RX
+ * buffer does not exist try to produce new one, as RX buffers may have been consumed since the
+ * internal acknowledgement buffer was taken in use. If producing fails use the internal
+ * acknowledgement buffer.
+ */
+static void rx_buffer_reset(void)
+{
+    uint32_t err_code;
+
+    if (mp_slip_used_rx_buffer != NULL)
+    {
+        err_code = hci_slip_rx_buffer_register(mp_slip_used_rx_buffer, RX_BUF_SIZE);
+        APP_ERROR_CHECK(err_code);
+    }
+    else
+    {
+        err_code = hci_mem_pool_rx_produce(RX_BUF_SIZE, (void **)&mp_slip_used_rx_buffer);
+        APP_ERROR_CHECK_BOOL((err_code == NRF_SUCCESS) || (err_code == NRF_ERROR_NO_MEM));
+
+        err_code = hci_slip_rx_buffer_register(
+            (err_code == NRF_SUCCESS) ? mp_slip_used_rx_buffer : m_rx_ack_buffer,
+            (err_code == NRF_SUCCESS) ? RX_BUF_SIZE : ACK_BUF_SIZE);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
 /**@brief Function for processing a received vendor specific packet.
  *
  * @param[in] p_buffer Pointer to the packet data. 
@@ -250,7 +289,7 @@ static void rx_vendor_specific_pkt_type_handle(const uint8_t * p_buffer, uint32_
             packet_number_expected_inc();                    
             ack_transmit();                    
 
-            m_is_slip_decode_ready = true;            
+            ++m_slip_decode_ready_count;
             
             err_code = hci_mem_pool_rx_data_size_set(length);
             APP_ERROR_CHECK(err_code);
@@ -275,12 +314,11 @@ static void rx_vendor_specific_pkt_type_handle(const uint8_t * p_buffer, uint32_
         }
         else
         {
-            // RX packet discarded: sequence number not valid, set the same buffer to slip layer in 
-            // order to avoid buffer overrun. 
-            err_code = hci_slip_rx_buffer_register(mp_slip_used_rx_buffer, RX_BUF_SIZE);                            
-            APP_ERROR_CHECK(err_code);                            
-                
-            // As packet did not have expected sequence number: send acknowledgement with the 
+            // RX packet discarded: sequence number not valid, set the same buffer to slip layer in
+            // order to avoid buffer overrun.
+            rx_buffer_reset();
+
+            // As packet did not have expected sequence number: send acknowledgement with the
             // current expected sequence number.
             ack_transmit();
         }
@@ -288,10 +326,9 @@ static void rx_vendor_specific_pkt_type_handle(const uint8_t * p_buffer, uint32_
     else
     {
         // RX packet discarded: reset the same buffer to slip layer in order to avoid buffer
-        // overrun. 
-        err_code = hci_slip_rx_buffer_register(mp_slip_used_rx_buffer, RX_BUF_SIZE);                            
-        APP_ERROR_CHECK(err_code);                                    
-    }            
+        // overrun.
+        rx_buffer_reset();
+    }
 }
 
 
@@ -307,30 +344,17 @@ static __INLINE uint8_t packet_number_to_transmit_get(void)
 }
 
 
-/**@brief Function for getting the expected acknowledgement number.
- *
- * @return expected acknowledgement number.
- */
-static __INLINE uint8_t expected_ack_number_get(void)
-{
-    uint8_t seq_nmbr = packet_number_to_transmit_get(); 
-    ++seq_nmbr;
-    seq_nmbr &= 0x07u;
-    
-    return seq_nmbr;
-}
-
-
 /**@brief Function for processing a received acknowledgement packet.
  *
- * Verifies does the received acknowledgement packet has the expected acknowledgement number and 
- * that the header checksum is correct. 
+ * Verifies that the header checksum of the received acknowledgement packet is correct and that its
+ * acknowledgement number acknowledges packets of the TX window. The acknowledgement number is the
+ * sequence number of the next packet expected by the peer, so it acknowledges all packets before.
  *
- * @param[in] p_buffer Pointer to the packet data. 
+ * @param[in] p_buffer Pointer to the packet data.
  *
- * @return true if valid acknowledgement packet received.
+ * @return Number of TX window packets acknowledged, 0 if none.
  */
-static __INLINE bool rx_ack_pkt_type_handle(const uint8_t * p_buffer)
+static __INLINE uint32_t rx_ack_pkt_type_handle(const uint8_t * p_buffer)
 {
     // @note: no pointer validation check needed as allready checked by calling function.
     
@@ -338,14 +362,15 @@ static __INLINE bool rx_ack_pkt_type_handle(const uint8_t * p_buffer)
     const uint32_t expected_checksum = 
         ((p_buffer[0] + p_buffer[1] + p_buffer[2] + p_buffer[3])) & 0xFFu;
     if (expected_checksum != 0)
-    {    
-        return false;
+    {
+        return 0;
     }
-    
-    const uint8_t ack_number = (p_buffer[0] >> 3u) & 0x07u;
-    
+
+    const uint8_t  ack_number = (p_buffer[0] >> 3u) & 0x07u;
+    const uint32_t acked      = (ack_number - packet_number_to_transmit_get()) & 0x07u;
+
     // Verify expected acknowledgment number.
-    return (ack_number == expected_ack_number_get());
+    return (acked <= m_tx_window_count) ? acked : 0;
 }
 
 
@@ -358,6 +383,60 @@ static __INLINE void packet_number_tx_inc(void)
 }
 
 
+/**@brief Function for delivering the packets of the TX window to the slip layer.
+ *
+ * Packets are delivered in sequence number order until the slip layer is busy; delivery continues
+ * upon HCI_SLIP_TX_DONE event.
+ */
+static void tx_window_transmit(void)
+{
+    while (m_tx_window_sent < m_tx_window_count)
+    {
+        const uint32_t index = (m_tx_window_first + m_tx_window_sent) % HCI_TRANSPORT_WINDOW_SIZE;
+
+        // @note: counter incremented before the write as HCI_SLIP_TX_DONE event can be sent from
+        // within hci_slip_write(...) context.
+        ++m_tx_window_sent;
+        if (hci_slip_write(mp_tx_window_buf[index], m_tx_window_len[index]) != NRF_SUCCESS)
+        {
+            --m_tx_window_sent;
+            return;
+        }
+    }
+}
+
+
+/**@brief Function for removing packets from the start of the TX window.
+ *
+ * TX done event callback function is executed for each removed packet.
+ *
+ * @param[in] count  Number of packets to remove.
+ * @param[in] result TX done event callback function result code.
+ */
+static void tx_window_release(uint32_t count, hci_transport_tx_done_result_t result)
+{
+    while (count-- != 0)
+    {
+        m_tx_window_first = (m_tx_window_first + 1u) % HCI_TRANSPORT_WINDOW_SIZE;
+        --m_tx_window_count;
+        m_tx_window_sent  = (m_tx_window_sent != 0) ? (m_tx_window_sent - 1u) : 0;
+
+        if (result == HCI_TRANSPORT_TX_DONE_SUCCESS)
+        {
+            // Tx sequence number counter incremented as packet transmission acknowledged by peer
+            // transport entity.
+            packet_number_tx_inc();
+        }
+
+        // Send TX-done event if registered handler exists.
+        if (m_transport_tx_done_handle != NULL)
+        {
+            m_transport_tx_done_handle(result);
+        }
+    }
+}
+
+
 /**@brief Function for TX state machine event processing in a state centric manner.
  *
  * @param[in] event Type of event occurred.
@@ -365,84 +444,77 @@ static __INLINE void packet_number_tx_inc(void)
 static void tx_sm_event_handle(tx_event_t event)
 {
     uint32_t err_code;
-    
+
     switch (m_tx_state)
     {
         case TX_STATE_IDLE:
             if (event == TX_EVENT_STATE_ENTRY)
-            {                 
+            {
                 err_code = app_timer_stop(m_app_timer_id);
                 APP_ERROR_CHECK(err_code);
-                
-                // Send TX-done event if registered handler exists.
-                if (m_transport_tx_done_handle != NULL)                
-                {
-                    m_transport_tx_done_handle(m_tx_done_result_code);
-                }                
             }
             break;
-            
-        case TX_STATE_PENDING:
-            if (event == TX_EVENT_SLIP_TX_DONE)
-            {     
-                // @note: this call should always succeed as called from HCI_SLIP_TX_DONE context 
-                // and error cases are managed by dedicated error event from the slip layer.
-                err_code = hci_slip_write(mp_tx_buffer, 
-                                         (m_tx_buffer_length + PKT_HDR_SIZE + PKT_CRC_SIZE));  
-                APP_ERROR_CHECK(err_code);                                                  
-                tx_sm_state_change(TX_STATE_ACTIVE);                                              
-            }        
-            break;
-            
+
         case TX_STATE_ACTIVE:
             switch (event)
             {
-                case TX_EVENT_VALID_RX_ACK:                    
-                    // Tx sequence number counter incremented as packet transmission 
-                    // acknowledged by peer transport entity.
-                    packet_number_tx_inc();                                  
-                    tx_sm_state_change(TX_STATE_IDLE);
+                case TX_EVENT_VALID_RX_ACK:
+                    if (m_tx_window_count == 0)
+                    {
+                        tx_sm_state_change(TX_STATE_IDLE);
+                    }
+                    else
+                    {
+                        // Peer transport entity is making progress: restart the retransmission
+                        // timeout for the remaining packets.
+                        tx_sm_state_change(TX_STATE_ACTIVE);
+                    }
                     break;
-                    
+
                 case TX_EVENT_STATE_ENTRY:
                     m_tx_retry_counter = 0;
-                    err_code = app_timer_start(m_app_timer_id, 
-                                               RETRANSMISSION_TIMEOUT_IN_TICKS, 
+                    err_code = app_timer_stop(m_app_timer_id);
+                    APP_ERROR_CHECK(err_code);
+                    err_code = app_timer_start(m_app_timer_id,
+                                               RETRANSMISSION_TIMEOUT_IN_TICKS,
                                                NULL);
                     APP_ERROR_CHECK(err_code);
+                    tx_window_transmit();
                     break;
-                    
+
+                case TX_EVENT_SLIP_TX_DONE:
+                    tx_window_transmit();
+                    break;
+
                 case TX_EVENT_TIMEOUT:
                     if (m_tx_retry_counter != MAX_RETRY_COUNT)
                     {
                         ++m_tx_retry_counter;
-                        // @note: no return value check done for hci_slip_write(...) call as current 
-                        // system design allows use case where retransmission is not accepted by the 
-                        // slip layer due to existing acknowledgement packet transmission in the 
-                        // slip layer. 
-                        UNUSED_VARIABLE(hci_slip_write(mp_tx_buffer, 
-                                                      (m_tx_buffer_length + 
-                                                      PKT_HDR_SIZE        + 
-                                                      PKT_CRC_SIZE)));                
-                    }    
+                        // Retransmit all packets of the window, starting from the oldest one.
+                        // @note: a retransmission not accepted by the slip layer due to existing
+                        // acknowledgement packet transmission is delivered upon HCI_SLIP_TX_DONE.
+                        m_tx_window_sent = 0;
+                        tx_window_transmit();
+                    }
                     else
                     {
-                        // Application packet retransmission count reached: 
-                        // - set correct TX done event callback function result code
-                        // - execute state change    
+                        // Application packet retransmission count reached:
+                        // - release all packets of the window with failure result code
+                        // - execute state change
                         // @note: m_tx_retry_counter is reset in TX_STATE_ACTIVE state entry.
-                        m_tx_done_result_code = HCI_TRANSPORT_TX_DONE_FAILURE;         
-                        tx_sm_state_change(TX_STATE_IDLE);
-                    }                
+                        tx_window_release(m_tx_window_count, HCI_TRANSPORT_TX_DONE_FAILURE);
+                        tx_sm_state_change((m_tx_window_count == 0) ? TX_STATE_IDLE :
+                                                                      TX_STATE_ACTIVE);
+                    }
                     break;
-                    
+
                 default:
                     // No implementation needed.
                     break;
             }
             break;
-            
-        default:        
+
+        default:
             // No implementation needed.
             break;
     }
@@ -467,8 +539,7 @@ static void tx_sm_state_change(tx_state_t new_state)
 void slip_event_handle(hci_slip_evt_t event)
 {    
     uint32_t return_code;
-    uint32_t err_code;    
-    
+
     switch (event.evt_type)
     {
         case HCI_SLIP_TX_DONE:   
@@ -485,45 +556,29 @@ void slip_event_handle(hci_slip_evt_t event)
                     break;
                     
                 case PKT_TYPE_ACK:
-                    if (rx_ack_pkt_type_handle(event.packet))
+                    return_code = rx_ack_pkt_type_handle(event.packet);
+                    if (return_code != 0)
                     {
-                        // Valid expected acknowledgement packet received: set correct TX done event 
-                        // callback function result code and execute state change.
-                        m_tx_done_result_code = HCI_TRANSPORT_TX_DONE_SUCCESS; 
+                        // Valid acknowledgement packet received: release the acknowledged packets
+                        // and execute state change.
+                        tx_window_release(return_code, HCI_TRANSPORT_TX_DONE_SUCCESS);
                         tx_sm_event_handle(TX_EVENT_VALID_RX_ACK);
                     }
-                
-                /* fall-through */                
+
+                /* fall-through */
                 default:
-                    // RX packet dropped: reset memory buffer to slip in order to avoid RX buffer 
-                    // overflow. 
-                    // If existing mem pool produced RX buffer exists reuse that one. If existing 
-                    // mem pool produced RX buffer does not exist try to produce new one. If 
-                    // producing fails use the internal acknowledgement buffer.                    
-                    if (mp_slip_used_rx_buffer != NULL)
-                    {
-                        err_code = hci_slip_rx_buffer_register(mp_slip_used_rx_buffer, RX_BUF_SIZE);                                                            
-                        APP_ERROR_CHECK(err_code);                                                                
-                    }
-                    else
-                    {
-                        err_code = hci_mem_pool_rx_produce(RX_BUF_SIZE, 
-                                                           (void **)&mp_slip_used_rx_buffer); 
-                        APP_ERROR_CHECK_BOOL((err_code == NRF_SUCCESS) || 
-                                            (err_code == NRF_ERROR_NO_MEM));
-
-                        err_code = hci_slip_rx_buffer_register(
-                            (err_code == NRF_SUCCESS) ? mp_slip_used_rx_buffer : m_rx_ack_buffer, 
-                            (err_code == NRF_SUCCESS) ? RX_BUF_SIZE : ACK_BUF_SIZE);            
-                        APP_ERROR_CHECK(err_code);                                                                
-                    }
+                    // RX packet dropped: reset memory buffer to slip in order to avoid RX buffer
+                    // overflow.
+                    rx_buffer_reset();
                     break;
             }
             break;
 
         case HCI_SLIP_RX_OVERFLOW:
-            err_code = hci_slip_rx_buffer_register(m_rx_ack_buffer, ACK_BUF_SIZE);                                                            
-            APP_ERROR_CHECK(err_code);                                                                
+            // RX packet dropped: too long for the buffer, or received into the internal
+            // acknowledgement buffer as no mem pool RX buffer was free. Without resetting to a mem
+            // pool buffer the following application packets would be dropped as well.
+            rx_buffer_reset();
             break;
         
         case HCI_SLIP_ERROR:
@@ -579,15 +634,15 @@ void hci_transport_timeout_handle(void * p_context)
 
 uint32_t hci_transport_open(void)
 {
-    mp_tx_buffer                 = NULL;
-    m_tx_buffer_length           = 0;
+    m_tx_window_first            = 0;
+    m_tx_window_count            = 0;
+    m_tx_window_sent             = 0;
     m_tx_retry_counter           = 0;
-    m_is_slip_decode_ready       = false;
+    m_slip_decode_ready_count    = 0;
     m_tx_state                   = TX_STATE_IDLE;
     m_packet_expected_seq_number = INITIAL_ACK_NUMBER_EXPECTED;
     m_packet_transmit_seq_number = INITIAL_ACK_NUMBER_TX;
-    m_tx_done_result_code        = HCI_TRANSPORT_TX_DONE_FAILURE;
-    
+
     uint32_t err_code = app_timer_create(&m_app_timer_id, 
                                          APP_TIMER_MODE_REPEATED, 
                                          hci_transport_timeout_handle);
@@ -658,87 +713,85 @@ uint32_t hci_transport_tx_free(void)
 
 
 /**@brief Function for constructing 1st byte of the packet header of the packet to be transmitted.
+ *
+ * @param[in] seq_number Sequence number of the packet.
  *
  * @return 1st byte of the packet header of the packet to be transmitted
  */
-static __INLINE uint8_t tx_packet_byte_zero_construct(void)
+static __INLINE uint8_t tx_packet_byte_zero_construct(uint32_t seq_number)
 {
-    const uint32_t value = DATA_INTEGRITY_MASK                  | 
-                           RELIABLE_PKT_MASK                    | 
-                           (packet_number_expected_get() << 3u) | 
-                           packet_number_to_transmit_get();   
+    const uint32_t value = DATA_INTEGRITY_MASK                  |
+                           RELIABLE_PKT_MASK                    |
+                           (packet_number_expected_get() << 3u) |
+                           seq_number;   
     
     return (uint8_t) value;
 }
 
 
-/**@brief Function for handling the application packet write request in tx-idle state.
+/**@brief Function for handling the application packet write request.
+ *
+ * @param[in] p_buffer Pointer to the packet data, preceded by space for the packet header.
+ * @param[in] length   Length of the packet data in bytes.
  */
-static uint32_t pkt_write_handle(void)
-{   
-    uint32_t err_code;     
-    
-    // Set packet header fields.
+static void pkt_write_handle(uint8_t * p_buffer, uint32_t length)
+{
+    // Set packet header fields. The packet gets the sequence number following the packets already
+    // in the window.
 
-    mp_tx_buffer   -= PKT_HDR_SIZE;
-    mp_tx_buffer[0] = tx_packet_byte_zero_construct();
-                
-    const uint16_t type_and_length_fields = ((m_tx_buffer_length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);            
+    p_buffer   -= PKT_HDR_SIZE;
+    p_buffer[0] = tx_packet_byte_zero_construct(
+                      (packet_number_to_transmit_get() + m_tx_window_count) & 0x07u);
+
+    const uint16_t type_and_length_fields = ((length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
     // @note: no use case for uint16_encode(...) return value.
-    UNUSED_VARIABLE(uint16_encode(type_and_length_fields, &(mp_tx_buffer[1])));
-    mp_tx_buffer[3] = header_checksum_calculate(mp_tx_buffer);
-    
-    // Calculate, append CRC to the packet and write it.
-        
-    const uint16_t crc = crc16_compute(mp_tx_buffer, (PKT_HDR_SIZE + m_tx_buffer_length), NULL);
+    UNUSED_VARIABLE(uint16_encode(type_and_length_fields, &(p_buffer[1])));
+    p_buffer[3] = header_checksum_calculate(p_buffer);
+
+    // Calculate, append CRC to the packet and add it to the window.
+
+    const uint16_t crc = crc16_compute(p_buffer, (PKT_HDR_SIZE + length), NULL);
     // @note: no use case for uint16_encode(...) return value.
-    UNUSED_VARIABLE(uint16_encode(crc, &(mp_tx_buffer[PKT_HDR_SIZE + m_tx_buffer_length])));        
-    err_code = hci_slip_write(mp_tx_buffer, (m_tx_buffer_length + PKT_HDR_SIZE + PKT_CRC_SIZE));        
-    switch (err_code)
+    UNUSED_VARIABLE(uint16_encode(crc, &(p_buffer[PKT_HDR_SIZE + length])));
+
+    const uint32_t index = (m_tx_window_first + m_tx_window_count) % HCI_TRANSPORT_WINDOW_SIZE;
+    mp_tx_window_buf[index] = p_buffer;
+    m_tx_window_len[index]  = (uint16_t)(length + PKT_HDR_SIZE + PKT_CRC_SIZE);
+    ++m_tx_window_count;
+
+    if (m_tx_state == TX_STATE_IDLE)
     {
-        case NRF_SUCCESS:
-            tx_sm_state_change(TX_STATE_ACTIVE);
-            break;
-                
-        case NRF_ERROR_NO_MEM:
-            tx_sm_state_change(TX_STATE_PENDING);            
-            err_code = NRF_SUCCESS;
-            break;
-                
-        default:
-            // No implementation needed.
-            break;
+        tx_sm_state_change(TX_STATE_ACTIVE);
+    }
+    else
+    {
+        tx_window_transmit();
     }
-    
-    return err_code;
 }
 
 
 uint32_t hci_transport_pkt_write(const uint8_t * p_buffer, uint16_t length)
 {
     uint32_t err_code;
-    
+
     if (p_buffer)
-    {          
-        switch (m_tx_state)
+    {
+        if (m_tx_window_count < HCI_TRANSPORT_WINDOW_SIZE)
         {
-            case TX_STATE_IDLE:
-                mp_tx_buffer       = (uint8_t *)p_buffer;
-                m_tx_buffer_length = length;            
-                err_code = pkt_write_handle();
-                break;
-                
-            default:
-                err_code = NRF_ERROR_NO_MEM;
-                break;
+            pkt_write_handle((uint8_t *)p_buffer, length);
+            err_code = NRF_SUCCESS;
+        }
+        else
+        {
+            err_code = NRF_ERROR_NO_MEM;
         }
     }
     else
     {
         err_code = NRF_ERROR_NULL;
     }
-    
-    return err_code;    
+
+    return err_code;
 }
 
 
@@ -750,9 +803,9 @@ uint32_t hci_transport_rx_pkt_extract(uint8_t ** pp_buffer, uint16_t * p_length)
     {
         uint32_t length = 0; 
         
-        if (m_is_slip_decode_ready)
+        if (m_slip_decode_ready_count != 0)
         {
-            m_is_slip_decode_ready = false;
+            --m_slip_decode_ready_count;
             err_code               = hci_mem_pool_rx_extract(pp_buffer, &length);
             length                -= (PKT_HDR_SIZE + PKT_CRC_SIZE);
             
@@ -32,7 +32,8 @@
  * \par Implementation specific behaviour
  * - As Link establishment procedure is not supported following static link configuration parameters
  * are used:
- * + TX window size is 1.
+ * + TX window size is HCI_TRANSPORT_WINDOW_SIZE, 1 by default. Reliable packets are retransmitted
+ * go-back-N: on retransmission timeout all packets of the window are sent again.
  * + 16 bit CCITT-CRC must be used.
  * + Out of frame software flow control not supported.
  * + Parameters specific for resending reliable packets are compile time configurable (clarifed 
@@ -70,6 +71,8 @@
  * The following compile time configuration option is available to configure module specific 
  * behaviour:
  * - MAX_RETRY_COUNT Max retransmission retry count for applicaton packets.
+ * - HCI_TRANSPORT_WINDOW_SIZE Number of reliable packets in flight, 1 to 7. Requires
+ *   TX_BUF_QUEUE_SIZE of the memory pool to be at least the window size.
  */
  
 #ifndef HCI_TRANSPORT_H__
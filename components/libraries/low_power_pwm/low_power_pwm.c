@@ -13,7 +13,18 @@
 #include "low_power_pwm.h"
 #include "nrf_gpio.h"
 #include "app_timer.h"
+#include "app_util_platform.h"
 #include "nrf_assert.h"
+#include "nordic_common.h"
+#if defined(NRF52) && (LOW_POWER_PWM_GROUP_HW_PWM_ENABLED == 1)
+#include "nrf_pwm.h"
+#define HW_PWM_USED 1
+#else
+#define HW_PWM_USED 0
+#endif
+
+#define NO_EDGE         UINT32_MAX      /**< Edge of instances that are not switched off during the period. */
+#define NO_HW_CHANNEL   0xFF            /**< Channel of instances driven by the timer. */
 
 /**
  * @brief Function for turning on LEDs.
@@ -117,6 +128,376 @@ static void pwm_timeout_handler(void * p_context)
 }
 
 
+#if HW_PWM_USED
+static uint16_t          m_hw_values[NRF_PWM_CHANNEL_COUNT];    /**< Sequence played by the PWM peripheral, one value per channel. */
+static low_power_pwm_t * mp_hw_owners[NRF_PWM_CHANNEL_COUNT];   /**< Instance on each PWM channel. */
+static bool              m_hw_running;                          /**< True if the PWM peripheral is playing the sequence. */
+
+
+/**
+ * @brief Function for getting the PWM peripheral value of an instance.
+ *
+ * With the falling edge polarity (bit 15 set), the output is high until the counter reaches the
+ * value, which gives a high pulse of duty_cycle out of period.
+ */
+__STATIC_INLINE uint16_t hw_value_get(low_power_pwm_t const * p_pwm_instance)
+{
+    uint16_t value = p_pwm_instance->duty_cycle;
+
+    if (p_pwm_instance->active_high)
+    {
+        value |= 0x8000;
+    }
+    return value;
+}
+
+
+/**
+ * @brief Function for restarting the PWM peripheral with the current channel owners.
+ *
+ * The peripheral is disabled when no channel is in use, so that it does not keep HFCLK running.
+ */
+static void hw_pwm_update(void)
+{
+    NRF_PWM_Type * p_pwm = LOW_POWER_PWM_GROUP_HW_PWM;
+    uint32_t       pins[NRF_PWM_CHANNEL_COUNT];
+    uint8_t        period = 0;
+    uint32_t       i;
+
+    if (m_hw_running)
+    {
+        // The pins can only be changed when the playback is stopped, which takes up to one period.
+        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_STOPPED);
+        nrf_pwm_task_trigger(p_pwm, NRF_PWM_TASK_STOP);
+        while (!nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_STOPPED))
+        {
+        }
+        nrf_pwm_disable(p_pwm);
+        m_hw_running = false;
+    }
+
+    for (i = 0; i < NRF_PWM_CHANNEL_COUNT; i++)
+    {
+        low_power_pwm_t const * p_owner = mp_hw_owners[i];
+
+        if (p_owner != NULL)
+        {
+            pins[i]        = 31 - __CLZ(p_owner->bit_mask_toggle);
+            m_hw_values[i] = hw_value_get(p_owner);
+            period         = p_owner->period;
+        }
+        else
+        {
+            pins[i]        = NRF_PWM_PIN_NOT_CONNECTED;
+            m_hw_values[i] = 0;
+        }
+    }
+
+    if (period == 0)
+    {
+        return;
+    }
+
+    nrf_pwm_pins_set(p_pwm, pins);
+    nrf_pwm_enable(p_pwm);
+    nrf_pwm_configure(p_pwm, NRF_PWM_CLK_125kHz, NRF_PWM_MODE_UP, period);
+    nrf_pwm_decoder_set(p_pwm, NRF_PWM_LOAD_INDIVIDUAL, NRF_PWM_STEP_AUTO);
+    for (i = 0; i < 2; i++)
+    {
+        nrf_pwm_seq_ptr_set(p_pwm, i, m_hw_values);
+        nrf_pwm_seq_cnt_set(p_pwm, i, NRF_PWM_VALUES_LENGTH(m_hw_values));
+        nrf_pwm_seq_refresh_set(p_pwm, i, 0);
+        nrf_pwm_seq_end_delay_set(p_pwm, i, 0);
+    }
+    // Both sequences play the same values, and looping restarts them forever. The values are
+    // read from RAM on each pass, so duty cycle changes need no register access.
+    nrf_pwm_loop_set(p_pwm, 1);
+    nrf_pwm_shorts_set(p_pwm, NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK);
+    nrf_pwm_task_trigger(p_pwm, NRF_PWM_TASK_SEQSTART0);
+    m_hw_running = true;
+}
+
+
+/**
+ * @brief Function for moving an instance to a free PWM peripheral channel, if possible.
+ *
+ * Only instances driving a single pin, with the same period as the instances already on the
+ * peripheral, are moved.
+ */
+static void hw_channel_assign(low_power_pwm_t * p_pwm_instance)
+{
+    uint32_t mask    = p_pwm_instance->bit_mask_toggle;
+    uint32_t channel = NO_HW_CHANNEL;
+    uint32_t i;
+
+    if ((mask & (mask - 1)) != 0)
+    {
+        return;
+    }
+
+    for (i = 0; i < NRF_PWM_CHANNEL_COUNT; i++)
+    {
+        if (mp_hw_owners[i] == NULL)
+        {
+            if (channel == NO_HW_CHANNEL)
+            {
+                channel = i;
+            }
+        }
+        else if (mp_hw_owners[i]->period != p_pwm_instance->period)
+        {
+            return;
+        }
+    }
+
+    if (channel != NO_HW_CHANNEL)
+    {
+        mp_hw_owners[channel]      = p_pwm_instance;
+        p_pwm_instance->hw_channel = channel;
+        hw_pwm_update();
+    }
+}
+
+
+/**
+ * @brief Function for giving the PWM peripheral channel of an instance back.
+ */
+static void hw_channel_release(low_power_pwm_t * p_pwm_instance)
+{
+    if (p_pwm_instance->hw_channel != NO_HW_CHANNEL)
+    {
+        mp_hw_owners[p_pwm_instance->hw_channel] = NULL;
+        p_pwm_instance->hw_channel = NO_HW_CHANNEL;
+        hw_pwm_update();
+    }
+}
+#endif // HW_PWM_USED
+
+
+/**
+ * @brief Function for setting the next instance to be switched off in the current period.
+ *
+ * @param[in] p_group               Pointer to the group.
+ * @param[in] p_pwm_instance        First candidate in the sorted list, or NULL.
+ */
+__STATIC_INLINE void group_edge_next(low_power_pwm_group_t * p_group, low_power_pwm_t * p_pwm_instance)
+{
+    if ((p_pwm_instance != NULL) && (p_pwm_instance->timeout_ticks != NO_EDGE))
+    {
+        p_group->p_next_edge = p_pwm_instance;
+    }
+    else
+    {
+        p_group->p_next_edge = NULL;
+    }
+}
+
+
+/**
+ * @brief Function for starting a period of a group.
+ *
+ * Calls the user handlers, switches on the instances with a non-zero duty cycle and sorts
+ * the instances by the tick at which they must be switched off.
+ *
+ * @param[in] p_group               Pointer to the group.
+ */
+static void group_period_start(low_power_pwm_group_t * p_group)
+{
+    low_power_pwm_t * p_pwm_instance;
+    low_power_pwm_t * p_next;
+    low_power_pwm_t * p_sorted = NULL;
+
+    // The handlers may change the duty cycles, or stop their instance.
+    for (p_pwm_instance = p_group->p_head; p_pwm_instance != NULL; p_pwm_instance = p_pwm_instance->p_next)
+    {
+        if (p_pwm_instance->handler)
+        {
+            p_pwm_instance->handler(p_pwm_instance);
+        }
+    }
+
+    CRITICAL_REGION_ENTER();
+    p_pwm_instance = p_group->p_head;
+    while (p_pwm_instance != NULL)
+    {
+        uint8_t duty_cycle = p_pwm_instance->duty_cycle;
+
+        p_next = p_pwm_instance->p_next;
+        p_pwm_instance->timeout_ticks = NO_EDGE;
+
+        if (p_pwm_instance->hw_channel != NO_HW_CHANNEL)
+        {
+            // Driven by the PWM peripheral.
+        }
+        else if (duty_cycle == 0)   // Process duty cycle 0%
+        {
+            led_off(p_pwm_instance);
+        }
+        else
+        {
+            led_on(p_pwm_instance);
+            if (duty_cycle != p_group->period)  // Process any other duty cycle than 0 or 100%
+            {
+                p_pwm_instance->timeout_ticks = MAX((duty_cycle * p_group->period) >> 8,
+                                                    APP_TIMER_MIN_TIMEOUT_TICKS);
+            }
+        }
+
+        // Insert into the list sorted by edge.
+        low_power_pwm_t ** pp_pos = &p_sorted;
+        while ((*pp_pos != NULL) && ((*pp_pos)->timeout_ticks <= p_pwm_instance->timeout_ticks))
+        {
+            pp_pos = &(*pp_pos)->p_next;
+        }
+        p_pwm_instance->p_next = *pp_pos;
+        *pp_pos = p_pwm_instance;
+
+        p_pwm_instance = p_next;
+    }
+    p_group->p_head = p_sorted;
+    p_group->tick   = 0;
+    group_edge_next(p_group, p_sorted);
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**
+ * @brief Timer event handler for low-power PWM groups.
+ *
+ * @param[in] p_context             Pointer to the group.
+ */
+static void group_timeout_handler(void * p_context)
+{
+    ret_code_t err_code;
+    uint32_t   next_tick;
+    uint32_t   timeout_ticks;
+
+    low_power_pwm_group_t * p_group = (low_power_pwm_group_t *)p_context;
+
+    if (p_group->p_next_edge == NULL)
+    {
+        group_period_start(p_group);
+    }
+    else
+    {
+        CRITICAL_REGION_ENTER();
+        low_power_pwm_t * p_pwm_instance = p_group->p_next_edge;
+
+        // Edges that were merged with this one are processed too.
+        while ((p_pwm_instance != NULL) && (p_pwm_instance->timeout_ticks <= p_group->tick))
+        {
+            led_off(p_pwm_instance);
+            p_pwm_instance = p_pwm_instance->p_next;
+        }
+        group_edge_next(p_group, p_pwm_instance);
+        CRITICAL_REGION_EXIT();
+    }
+
+    if (!p_group->running)
+    {
+        return;
+    }
+
+    next_tick     = (p_group->p_next_edge != NULL) ? p_group->p_next_edge->timeout_ticks :
+                                                     p_group->period;
+    timeout_ticks = (next_tick > p_group->tick) ? (next_tick - p_group->tick) : 0;
+    timeout_ticks = MAX(timeout_ticks, APP_TIMER_MIN_TIMEOUT_TICKS);
+
+    p_group->tick += timeout_ticks;
+
+    err_code = app_timer_start(*p_group->p_timer_id, timeout_ticks, p_group);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**
+ * @brief Function for adding an instance to the running instances of its group.
+ *
+ * The instance is switched on from the start of the next period.
+ */
+static void group_instance_start(low_power_pwm_t * p_pwm_instance)
+{
+    low_power_pwm_group_t * p_group = p_pwm_instance->p_group;
+    bool                    start;
+
+#if HW_PWM_USED
+    hw_channel_assign(p_pwm_instance);
+#endif
+
+    CRITICAL_REGION_ENTER();
+    p_pwm_instance->timeout_ticks = NO_EDGE;
+    p_pwm_instance->p_next        = p_group->p_head;
+    p_group->p_head               = p_pwm_instance;
+    start                         = !p_group->running;
+    p_group->running              = true;
+    CRITICAL_REGION_EXIT();
+
+    if (start)
+    {
+        group_timeout_handler(p_group);
+    }
+}
+
+
+/**
+ * @brief Function for removing an instance from the running instances of its group.
+ *
+ * @return Values returned by @ref app_timer_stop when the last instance is removed.
+ */
+static ret_code_t group_instance_stop(low_power_pwm_t * p_pwm_instance)
+{
+    low_power_pwm_group_t * p_group = p_pwm_instance->p_group;
+    low_power_pwm_t **      pp_pos  = &p_group->p_head;
+    bool                    stop;
+
+    CRITICAL_REGION_ENTER();
+    while ((*pp_pos != NULL) && (*pp_pos != p_pwm_instance))
+    {
+        pp_pos = &(*pp_pos)->p_next;
+    }
+    if (*pp_pos != NULL)
+    {
+        // The p_next field is kept, so that the group can go on walking the list.
+        *pp_pos = p_pwm_instance->p_next;
+        if (p_group->p_next_edge == p_pwm_instance)
+        {
+            group_edge_next(p_group, p_pwm_instance->p_next);
+        }
+    }
+    stop = (p_group->p_head == NULL);
+    if (stop)
+    {
+        p_group->running     = false;
+        p_group->p_next_edge = NULL;
+    }
+    CRITICAL_REGION_EXIT();
+
+#if HW_PWM_USED
+    hw_channel_release(p_pwm_instance);
+#endif
+
+    return stop ? app_timer_stop(*p_group->p_timer_id) : NRF_SUCCESS;
+}
+
+
+ret_code_t low_power_pwm_group_init(low_power_pwm_group_t *  p_group,
+                                    app_timer_id_t const *   p_timer_id,
+                                    uint8_t                  period)
+{
+    ASSERT(p_group != NULL);
+    ASSERT(period != 0);
+
+    p_group->p_timer_id  = p_timer_id;
+    p_group->p_head      = NULL;
+    p_group->p_next_edge = NULL;
+    p_group->tick        = 0;
+    p_group->period      = period;
+    p_group->running     = false;
+
+    return app_timer_create(p_timer_id, APP_TIMER_MODE_SINGLE_SHOT, group_timeout_handler);
+}
+
+
 ret_code_t low_power_pwm_init(low_power_pwm_t * p_pwm_instance, low_power_pwm_config_t const * p_pwm_config, app_timer_timeout_handler_t handler)
 { 
     ASSERT(p_pwm_instance->pwm_state == NRF_DRV_STATE_UNINITIALIZED);
@@ -136,8 +517,19 @@ ret_code_t low_power_pwm_init(low_power_pwm_t * p_pwm_instance, low_power_pwm_co
     p_pwm_instance->bit_mask_toggle = p_pwm_config->bit_mask;
     p_pwm_instance->period = p_pwm_config->period;
     p_pwm_instance->p_timer_id = p_pwm_config->p_timer_id;
+    p_pwm_instance->p_group = p_pwm_config->p_group;
+    p_pwm_instance->p_next = NULL;
+    p_pwm_instance->hw_channel = NO_HW_CHANNEL;
     
-    err_code = app_timer_create(p_pwm_instance->p_timer_id, APP_TIMER_MODE_SINGLE_SHOT, pwm_timeout_handler);
+    if (p_pwm_instance->p_group != NULL)
+    {
+        ASSERT(p_pwm_config->period == p_pwm_instance->p_group->period);
+        err_code = NRF_SUCCESS;
+    }
+    else
+    {
+        err_code = app_timer_create(p_pwm_instance->p_timer_id, APP_TIMER_MODE_SINGLE_SHOT, pwm_timeout_handler);
+    }
 
     if (err_code != NRF_SUCCESS)
     {
@@ -175,7 +567,15 @@ ret_code_t low_power_pwm_start(low_power_pwm_t * p_pwm_instance,
     
     p_pwm_instance->bit_mask = leds_pin_bit_mask;
     p_pwm_instance->evt_type = LOW_POWER_PWM_EVENT_PERIOD;
-    pwm_timeout_handler(p_pwm_instance);
+
+    if (p_pwm_instance->p_group != NULL)
+    {
+        group_instance_start(p_pwm_instance);
+    }
+    else
+    {
+        pwm_timeout_handler(p_pwm_instance);
+    }
     
     return NRF_SUCCESS;
 }
@@ -187,7 +587,14 @@ ret_code_t low_power_pwm_stop(low_power_pwm_t * p_pwm_instance)
 
     ret_code_t err_code;    
     
-    err_code = app_timer_stop(*p_pwm_instance->p_timer_id);
+    if (p_pwm_instance->p_group != NULL)
+    {
+        err_code = group_instance_stop(p_pwm_instance);
+    }
+    else
+    {
+        err_code = app_timer_stop(*p_pwm_instance->p_timer_id);
+    }
     
     led_off(p_pwm_instance);
 
@@ -212,5 +619,12 @@ ret_code_t low_power_pwm_duty_set(low_power_pwm_t * p_pwm_instance, uint8_t duty
 
     p_pwm_instance->duty_cycle = duty_cycle;
 
+#if HW_PWM_USED
+    if (p_pwm_instance->hw_channel != NO_HW_CHANNEL)
+    {
+        m_hw_values[p_pwm_instance->hw_channel] = hw_value_get(p_pwm_instance);
+    }
+#endif
+
     return NRF_SUCCESS;
 }
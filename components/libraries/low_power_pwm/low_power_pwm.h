@@ -23,6 +23,17 @@
  * Each low-power PWM instance utilizes one app_timer. This means it runs on RTC 
  * and does not require HFCLK to be running. There can be any number of output 
  * channels per instance.
+ *
+ * Instances that share the same period can instead be driven by a group (see
+ * @ref low_power_pwm_group_init), which uses one app_timer for all of them. At the start of
+ * each period, the group switches on all its running instances and sorts them by the end of
+ * their high pulse. The timer then expires once per distinct edge, and all instances ending at
+ * that edge are switched off together. Edges closer than APP_TIMER_MIN_TIMEOUT_TICKS are merged.
+ *
+ * On nRF52, when LOW_POWER_PWM_GROUP_HW_PWM_ENABLED is 1, the group instances driving a single
+ * pin are moved to a free channel of the PWM peripheral @ref LOW_POWER_PWM_GROUP_HW_PWM when they
+ * are started, and back to the timer when the four channels are in use. The PWM peripheral runs
+ * from HFCLK, so this trades current consumption for CPU time.
  */
 
 #ifndef LOW_POWER_PWM_H__
@@ -34,6 +45,16 @@
 #include "nrf_drv_common.h"
 #include "sdk_errors.h"
 
+#ifndef LOW_POWER_PWM_GROUP_HW_PWM_ENABLED
+#define LOW_POWER_PWM_GROUP_HW_PWM_ENABLED  0           /**< Offload group instances to the PWM peripheral on nRF52. */
+#endif
+
+#ifndef LOW_POWER_PWM_GROUP_HW_PWM
+#define LOW_POWER_PWM_GROUP_HW_PWM          NRF_PWM0    /**< PWM peripheral used by the groups. */
+#endif
+
+struct low_power_pwm_group_s;
+
 /**
  * @brief Event types.
  */
@@ -54,7 +75,8 @@ typedef struct
     bool                    active_high;        /**< Activate negative polarity. */
     uint8_t                 period;             /**< Width of the low_power_pwm period. */
     uint32_t                bit_mask;           /**< Pins to be initialized. */
-    app_timer_id_t const *  p_timer_id;         /**< Pointer to the timer ID of low_power_pwm. */
+    app_timer_id_t const *  p_timer_id;         /**< Pointer to the timer ID of low_power_pwm. Not used if p_group is set. */
+    struct low_power_pwm_group_s * p_group;     /**< Group driving the instance, or NULL if the instance uses its own timer. */
 } low_power_pwm_config_t;
 
 
@@ -105,6 +127,22 @@ typedef struct
         low_power_pwm_evt_type_t    evt_type;           /**< Slope that triggered time-out. */
         app_timer_timeout_handler_t handler;            /**< User handler to be called in the time-out handler. */
         app_timer_id_t const *      p_timer_id;         /**< Pointer to the timer ID of low_power_pwm. */
+        struct low_power_pwm_group_s * p_group;         /**< Group driving the instance, or NULL. */
+        struct low_power_pwm_s *    p_next;             /**< Next running instance of the group. */
+        uint8_t                     hw_channel;         /**< PWM peripheral channel, or 0xFF if driven by the timer. */
+    };
+
+    /**
+     * @brief Structure holding parameters of a low-power PWM group.
+     */
+    struct low_power_pwm_group_s
+    {
+        app_timer_id_t const *      p_timer_id;         /**< Pointer to the timer ID of the group. */
+        struct low_power_pwm_s *    p_head;             /**< Running instances, sorted by edge at the start of each period. */
+        struct low_power_pwm_s *    p_next_edge;        /**< Next instance to be switched off in the current period. */
+        uint32_t                    tick;               /**< Position of the current time-out in the period. */
+        uint8_t                     period;             /**< Width of the period of all instances. */
+        bool                        running;            /**< True if the group timer is running. */
     };
 
 /** @} 
@@ -116,6 +154,28 @@ typedef struct
  */
 typedef struct low_power_pwm_s low_power_pwm_t;
 
+/**
+ * @brief Internal structure holding parameters of a low-power PWM group.
+ */
+typedef struct low_power_pwm_group_s low_power_pwm_group_t;
+
+
+/**
+ * @brief   Function for initializing a low-power PWM group.
+ *
+ * The instances of the group are initialized with @ref low_power_pwm_init, with
+ * @p p_group in their configuration and the same period as the group.
+ *
+ * @param[in] p_group                   Pointer to the group.
+ * @param[in] p_timer_id                Pointer to the timer ID of the group.
+ * @param[in] period                    Width of the period of all instances.
+ *
+ * @return Values returned by @ref app_timer_create.
+ */
+ret_code_t low_power_pwm_group_init(low_power_pwm_group_t *  p_group,
+                                    app_timer_id_t const *   p_timer_id,
+                                    uint8_t                  period);
+
     
 /**
  * @brief   Function for initializing a low-power PWM instance.
@@ -153,7 +213,8 @@ ret_code_t low_power_pwm_stop(low_power_pwm_t * p_pwm_instance);
 /**
  * @brief   Function for setting a new high pulse width for a given instance.
  *
- * This function can be called from the timer handler.
+ * This function can be called from the timer handler. The new pulse width is used from the start
+ * of the next period.
  *
  * @param[in] p_pwm_instance            Pointer to the instance to be changed.
  * @param[in] duty_cycle                New high pulse width. 0 means that the LED is always off. 255 means that it is always on.
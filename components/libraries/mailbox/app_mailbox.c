@@ -10,6 +10,7 @@
  *
  */
 #include <stddef.h>
+#include <stdbool.h>
 #include <string.h>
 #include "app_mailbox.h"
 #include "nrf_error.h"
@@ -17,12 +18,66 @@
 #include "app_util.h"
 #include "nrf_assert.h"
 
+#define SLOT_SIZE_MASK     0x0000FFFF  /**< Item size bits of the slot header. */
+#define SLOT_COMMITTED     0x00010000  /**< Slot header flag: the item has been committed by the producer. */
+#define SLOT_RELEASED      0x00020000  /**< Slot header flag: the item has been released by the consumer. */
+
+/**@brief Function for getting the distance between two slots in the pool, in 32-bit words. */
+static __INLINE uint32_t slot_stride(const app_mailbox_t * p_mailbox)
+{
+    return 1 + CEIL_DIV(p_mailbox->item_sz, sizeof(uint32_t));
+}
+
+/**@brief Function for getting the header of the slot 'idx'. The item follows the header. */
+static __INLINE uint32_t * slot_get(const app_mailbox_t * p_mailbox, uint8_t idx)
+{
+    return (uint32_t *)p_mailbox->p_pool + (idx * slot_stride(p_mailbox));
+}
+
+/**@brief Function for getting the index of the slot holding the item 'p_item'.
+ *
+ * @return Slot index, or queue size if p_item is not the item of a slot.
+ */
+static uint8_t slot_idx_get(const app_mailbox_t * p_mailbox, void const * p_item)
+{
+    uint32_t const * p_hdr  = (uint32_t const *)p_item - 1;
+    uint32_t const * p_pool = p_mailbox->p_pool;
+    uint32_t         offset;
+
+    if ((p_hdr < p_pool) || (((uint32_t)p_item & 0x3) != 0))
+    {
+        return p_mailbox->queue_sz;
+    }
+
+    offset = (uint32_t)(p_hdr - p_pool);
+
+    if ((offset % slot_stride(p_mailbox)) != 0)
+    {
+        return p_mailbox->queue_sz;
+    }
+
+    offset /= slot_stride(p_mailbox);
+
+    return (offset < p_mailbox->queue_sz) ? (uint8_t)offset : p_mailbox->queue_sz;
+}
+
+/**@brief Function for advancing index 'idx' by 'n' slots, with wrapping. */
+static __INLINE uint8_t idx_add(uint8_t idx, uint8_t n, uint8_t queue_sz)
+{
+    uint16_t sum = (uint16_t)idx + n;
+
+    return (uint8_t)((sum >= queue_sz) ? (sum - queue_sz) : sum);
+}
+
 ret_code_t app_mailbox_create(const app_mailbox_t * queue_def)
 {
-    queue_def->p_cb->r_idx    = 0;
-    queue_def->p_cb->w_idx    = 0;
-    queue_def->p_cb->len      = 0;
-    queue_def->p_cb->mode     = APP_MAILBOX_MODE_NO_OVERFLOW;
+    queue_def->p_cb->r_idx     = 0;
+    queue_def->p_cb->w_idx     = 0;
+    queue_def->p_cb->len       = 0;
+    queue_def->p_cb->alloc_cnt = 0;
+    queue_def->p_cb->lent_cnt  = 0;
+    queue_def->p_cb->mode      = APP_MAILBOX_MODE_NO_OVERFLOW;
+    queue_def->p_cb->p_sync    = NULL;
 
     return NRF_SUCCESS;
 }
@@ -45,96 +100,271 @@ static __INLINE void enqueue(app_mailbox_cb_t * p_cb, uint8_t queue_sz)
     p_cb->w_idx = (w_idx == queue_sz) ? 0 : w_idx;
 }
 
-ret_code_t app_mailbox_put(const app_mailbox_t * p_mailbox, void * p_item)
+/**@brief Function for moving committed items at the start of the allocated slots to the queue.
+ *
+ * @details Allocated slots directly follow the queued items. Items are queued in allocation order,
+ *          so an item committed out of order waits for the earlier allocations to be committed.
+ *
+ * @note Must be called from a critical region.
+ */
+static void committed_enqueue(const app_mailbox_t * p_mailbox)
 {
-    ASSERT(p_mailbox);
-    return app_mailbox_sized_put(p_mailbox, p_item, p_mailbox->item_sz);
+    app_mailbox_cb_t * p_cb = p_mailbox->p_cb;
+
+    while (p_cb->alloc_cnt > 0)
+    {
+        uint32_t * p_hdr = slot_get(p_mailbox, p_cb->w_idx);
+
+        if ((*p_hdr & SLOT_COMMITTED) == 0)
+        {
+            break;
+        }
+        *p_hdr &= ~SLOT_COMMITTED;
+        p_cb->alloc_cnt--;
+        enqueue(p_cb, p_mailbox->queue_sz);
+    }
 }
 
-ret_code_t app_mailbox_sized_put(const app_mailbox_t * p_mailbox, void * p_item, uint16_t size)
+/**@brief Function for freeing released items at the start of the lent slots.
+ *
+ * @details Lent slots directly precede the queued items. They are freed in the order they were
+ *          taken from the queue, so an item released out of order waits for the earlier ones.
+ *
+ * @note Must be called from a critical region.
+ */
+static void released_free(const app_mailbox_t * p_mailbox)
+{
+    app_mailbox_cb_t * p_cb     = p_mailbox->p_cb;
+    uint8_t            queue_sz = p_mailbox->queue_sz;
+
+    while (p_cb->lent_cnt > 0)
+    {
+        uint32_t * p_hdr = slot_get(p_mailbox, idx_add(p_cb->r_idx, queue_sz - p_cb->lent_cnt, queue_sz));
+
+        if ((*p_hdr & SLOT_RELEASED) == 0)
+        {
+            break;
+        }
+        *p_hdr &= ~SLOT_RELEASED;
+        p_cb->lent_cnt--;
+    }
+}
+
+/**@brief Function for waking up blocked consumers ('item' true) or producers, if blocking hooks are set. */
+static __INLINE void sync_signal(const app_mailbox_t * p_mailbox, bool item)
+{
+    app_mailbox_sync_t const * p_sync = p_mailbox->p_cb->p_sync;
+
+    if (p_sync != NULL)
+    {
+        p_sync->signal(item ? p_sync->p_item_sem : p_sync->p_space_sem);
+    }
+}
+
+ret_code_t app_mailbox_alloc(const app_mailbox_t * p_mailbox, void ** pp_item)
 {
-    ASSERT((uint32_t)p_item>0);
     ASSERT(p_mailbox);
-    uint32_t           err_code  = NRF_ERROR_INTERNAL;
-    uint32_t *         p_dst     = p_mailbox->p_pool;
-    bool               do_put    = true;
-    uint8_t            queue_sz  = p_mailbox->queue_sz;
-    uint16_t           item_sz   = p_mailbox->item_sz;
-    app_mailbox_cb_t * p_cb      = p_mailbox->p_cb;
+    ASSERT(pp_item);
+    ret_code_t         err_code = NRF_SUCCESS;
+    uint8_t            queue_sz = p_mailbox->queue_sz;
+    app_mailbox_cb_t * p_cb     = p_mailbox->p_cb;
+    uint32_t *         p_hdr    = NULL;
 
     CRITICAL_REGION_ENTER();
 
-    if (p_cb->len == queue_sz)
+    if ((p_cb->len + p_cb->alloc_cnt + p_cb->lent_cnt) == queue_sz)
     {
-        if (p_cb->mode == APP_MAILBOX_MODE_NO_OVERFLOW)
-        {
-            do_put = false;
-        }
-        else
+        err_code = NRF_ERROR_NO_MEM;
+
+        // Removing the oldest element only frees its slot if no earlier slot is still lent.
+        if ((p_cb->mode == APP_MAILBOX_MODE_OVERFLOW) && (p_cb->len > 0) && (p_cb->lent_cnt == 0))
         {
             // Remove the oldest element.
             dequeue(p_cb, queue_sz);
         }
-        err_code = NRF_ERROR_NO_MEM;
     }
-    else
+
+    if ((p_cb->len + p_cb->alloc_cnt + p_cb->lent_cnt) < queue_sz)
     {
-        err_code = NRF_SUCCESS;
+        p_hdr  = slot_get(p_mailbox, idx_add(p_cb->w_idx, p_cb->alloc_cnt, queue_sz));
+        *p_hdr = 0;
+        p_cb->alloc_cnt++;
     }
 
-    if (do_put)
+    CRITICAL_REGION_EXIT();
+
+    (*pp_item) = (p_hdr != NULL) ? (p_hdr + 1) : NULL;
+
+    return err_code;
+}
+
+ret_code_t app_mailbox_commit(const app_mailbox_t * p_mailbox, void * p_item, uint16_t size)
+{
+    ASSERT(p_mailbox);
+    uint8_t            idx      = slot_idx_get(p_mailbox, p_item);
+    ret_code_t         err_code = NRF_SUCCESS;
+    app_mailbox_cb_t * p_cb     = p_mailbox->p_cb;
+
+    if (idx == p_mailbox->queue_sz)
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+    if (size > p_mailbox->item_sz)
     {
-        p_dst = (uint32_t *)((uint32_t)p_dst + (p_cb->w_idx * (item_sz + sizeof(uint32_t))));
-        enqueue(p_cb, queue_sz);
+        return NRF_ERROR_INVALID_LENGTH;
+    }
 
-        //Put data in mailbox.
-        *p_dst = (uint32_t)size;
-        p_dst++;
-        memcpy(p_dst, p_item, size);
+    CRITICAL_REGION_ENTER();
+
+    uint32_t * p_hdr = slot_get(p_mailbox, idx);
+
+    // Allocated slots are the 'alloc_cnt' slots starting at the write index.
+    if ((idx_add(idx, p_mailbox->queue_sz - p_cb->w_idx, p_mailbox->queue_sz) >= p_cb->alloc_cnt) ||
+        ((*p_hdr & SLOT_COMMITTED) != 0))
+    {
+        // The slot is not allocated to a producer.
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        *p_hdr = SLOT_COMMITTED | size;
+        committed_enqueue(p_mailbox);
     }
 
     CRITICAL_REGION_EXIT();
 
+    if (err_code == NRF_SUCCESS)
+    {
+        sync_signal(p_mailbox, true);
+    }
+
     return err_code;
 }
 
-ret_code_t app_mailbox_get(const app_mailbox_t * p_mailbox, void * p_item)
+ret_code_t app_mailbox_ptr_get(const app_mailbox_t * p_mailbox, void ** pp_item, uint16_t * p_size)
 {
-    uint16_t size;
-    return app_mailbox_sized_get(p_mailbox, p_item, &size);
+    ASSERT(p_mailbox);
+    ASSERT(pp_item);
+    ASSERT(p_size);
+    uint8_t            queue_sz = p_mailbox->queue_sz;
+    app_mailbox_cb_t * p_cb     = p_mailbox->p_cb;
+    uint32_t *         p_hdr    = NULL;
+
+    CRITICAL_REGION_ENTER();
+
+    if (p_cb->len != 0)
+    {
+        p_hdr = slot_get(p_mailbox, p_cb->r_idx);
+        dequeue(p_cb, queue_sz);
+        p_cb->lent_cnt++;
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    if (p_hdr == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    (*p_size)  = (uint16_t)(*p_hdr & SLOT_SIZE_MASK);
+    (*pp_item) = p_hdr + 1;
+
+    return NRF_SUCCESS;
 }
 
-ret_code_t app_mailbox_sized_get(const app_mailbox_t * p_mailbox, void * p_item, uint16_t * p_size)
+ret_code_t app_mailbox_release(const app_mailbox_t * p_mailbox, void * p_item)
 {
     ASSERT(p_mailbox);
-    ASSERT((uint32_t)p_item>0);
-    uint32_t *         p_src     = p_mailbox->p_pool;
-    ret_code_t         err_code  = NRF_SUCCESS;
-    uint16_t           item_sz   = p_mailbox->item_sz;
-    uint8_t            queue_sz  = p_mailbox->queue_sz;
-    app_mailbox_cb_t * p_cb      = p_mailbox->p_cb;
+    uint8_t            idx      = slot_idx_get(p_mailbox, p_item);
+    uint8_t            queue_sz = p_mailbox->queue_sz;
+    ret_code_t         err_code = NRF_SUCCESS;
+    app_mailbox_cb_t * p_cb     = p_mailbox->p_cb;
+
+    if (idx == queue_sz)
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
 
     CRITICAL_REGION_ENTER();
 
-    if (p_cb->len == 0)
+    uint32_t * p_hdr = slot_get(p_mailbox, idx);
+    uint8_t    age   = idx_add(p_cb->r_idx, queue_sz - idx, queue_sz);
+
+    // Lent slots are the 'lent_cnt' slots preceding the read index.
+    if (age == 0)
     {
-        err_code = NRF_ERROR_NO_MEM;
+        age = queue_sz;
+    }
+
+    if ((age > p_cb->lent_cnt) || ((*p_hdr & SLOT_RELEASED) != 0))
+    {
+        // The slot is not lent to a consumer.
+        err_code = NRF_ERROR_INVALID_STATE;
     }
     else
     {
-        p_src = (void *)((uint32_t)p_src + (p_cb->r_idx * (item_sz + sizeof(uint32_t))));
-        dequeue(p_cb, queue_sz);
+        *p_hdr |= SLOT_RELEASED;
+        released_free(p_mailbox);
     }
 
+    CRITICAL_REGION_EXIT();
+
     if (err_code == NRF_SUCCESS)
     {
-        uint16_t size = (uint16_t)*p_src;
-        *p_size = size;
-        p_src++;
-        memcpy(p_item, p_src, size);
+        sync_signal(p_mailbox, false);
     }
 
-    CRITICAL_REGION_EXIT();
+    return err_code;
+}
+
+ret_code_t app_mailbox_put(const app_mailbox_t * p_mailbox, void * p_item)
+{
+    ASSERT(p_mailbox);
+    return app_mailbox_sized_put(p_mailbox, p_item, p_mailbox->item_sz);
+}
+
+ret_code_t app_mailbox_sized_put(const app_mailbox_t * p_mailbox, void * p_item, uint16_t size)
+{
+    ASSERT((uint32_t)p_item>0);
+    ASSERT(p_mailbox);
+    void *     p_dst;
+    ret_code_t err_code;
+
+    if (size > p_mailbox->item_sz)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    err_code = app_mailbox_alloc(p_mailbox, &p_dst);
+
+    if (p_dst != NULL)
+    {
+        //Put data in mailbox.
+        memcpy(p_dst, p_item, size);
+        (void)app_mailbox_commit(p_mailbox, p_dst, size);
+    }
+
+    return err_code;
+}
+
+ret_code_t app_mailbox_get(const app_mailbox_t * p_mailbox, void * p_item)
+{
+    uint16_t size;
+    return app_mailbox_sized_get(p_mailbox, p_item, &size);
+}
+
+ret_code_t app_mailbox_sized_get(const app_mailbox_t * p_mailbox, void * p_item, uint16_t * p_size)
+{
+    ASSERT(p_mailbox);
+    ASSERT((uint32_t)p_item>0);
+    void *     p_src;
+    ret_code_t err_code = app_mailbox_ptr_get(p_mailbox, &p_src, p_size);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        memcpy(p_item, p_src, *p_size);
+        (void)app_mailbox_release(p_mailbox, p_src);
+    }
 
     return err_code;
 }
@@ -150,3 +380,64 @@ void app_mailbox_mode_set(const app_mailbox_t * p_mailbox, app_mailbox_overflow_
     ASSERT(p_mailbox);
     p_mailbox->p_cb->mode = mode;
 }
+
+ret_code_t app_mailbox_sync_set(const app_mailbox_t * p_mailbox, app_mailbox_sync_t const * p_sync)
+{
+    ASSERT(p_mailbox);
+
+    if ((p_sync != NULL) && ((p_sync->wait == NULL) || (p_sync->signal == NULL)))
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    p_mailbox->p_cb->p_sync = p_sync;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_mailbox_alloc_wait(const app_mailbox_t * p_mailbox, void ** pp_item, uint32_t timeout)
+{
+    ASSERT(p_mailbox);
+    app_mailbox_sync_t const * p_sync = p_mailbox->p_cb->p_sync;
+    ret_code_t                 err_code;
+
+    // In overflow mode, allocation only fails while all slots are allocated or lent.
+    while (((err_code = app_mailbox_alloc(p_mailbox, pp_item)) != NRF_SUCCESS) &&
+           ((*pp_item) == NULL))
+    {
+        if ((p_sync == NULL) || (timeout == 0))
+        {
+            break;
+        }
+        if (p_sync->wait(p_sync->p_space_sem, timeout) != NRF_SUCCESS)
+        {
+            return NRF_ERROR_TIMEOUT;
+        }
+    }
+
+    return err_code;
+}
+
+ret_code_t app_mailbox_ptr_get_wait(const app_mailbox_t * p_mailbox,
+                                    void               ** pp_item,
+                                    uint16_t            * p_size,
+                                    uint32_t              timeout)
+{
+    ASSERT(p_mailbox);
+    app_mailbox_sync_t const * p_sync = p_mailbox->p_cb->p_sync;
+    ret_code_t                 err_code;
+
+    while ((err_code = app_mailbox_ptr_get(p_mailbox, pp_item, p_size)) != NRF_SUCCESS)
+    {
+        if ((p_sync == NULL) || (timeout == 0))
+        {
+            break;
+        }
+        if (p_sync->wait(p_sync->p_item_sem, timeout) != NRF_SUCCESS)
+        {
+            return NRF_ERROR_TIMEOUT;
+        }
+    }
+
+    return err_code;
+}
@@ -18,6 +18,16 @@
  *
  * @brief Mailbox for safely queuing items.
  *
+ * @details Items can be copied into and out of the mailbox with @ref app_mailbox_put and
+ *          @ref app_mailbox_get. To avoid the copies, a producer can instead allocate a slot with
+ *          @ref app_mailbox_alloc, fill it in place and pass it on with @ref app_mailbox_commit.
+ *          A consumer then takes ownership of the slot with @ref app_mailbox_ptr_get and gives it
+ *          back with @ref app_mailbox_release. Items are queued in allocation order, and slots are
+ *          reused in the order they were taken from the queue.
+ *
+ *          In RTOS applications, @ref app_mailbox_sync_set installs hooks to semaphores, so that
+ *          @ref app_mailbox_ptr_get_wait and @ref app_mailbox_alloc_wait can block the calling
+ *          task instead of polling.
  */
 
 #ifndef _APP_MAILBOX_H
@@ -37,6 +47,41 @@ typedef enum
     APP_MAILBOX_MODE_OVERFLOW     //!< If the mailbox is full, the oldest element is lost and a new one is added.
 } app_mailbox_overflow_mode_t;
 
+/**
+ * @brief Function for waiting on a semaphore.
+ *
+ * @param[in] p_sem    Semaphore, as given in @ref app_mailbox_sync_t.
+ * @param[in] timeout  Timeout, in the ticks of the RTOS.
+ *
+ * @retval NRF_SUCCESS        If the semaphore was signaled.
+ * @retval NRF_ERROR_TIMEOUT  If the timeout expired.
+ */
+typedef ret_code_t (*app_mailbox_wait_t)(void * p_sem, uint32_t timeout);
+
+/**
+ * @brief Function for signaling a semaphore. It may be called from interrupt context.
+ *
+ * @param[in] p_sem    Semaphore, as given in @ref app_mailbox_sync_t.
+ */
+typedef void (*app_mailbox_signal_t)(void * p_sem);
+
+/**
+ * @brief Blocking hooks of a mailbox.
+ *
+ * @details The semaphores are used as events. The mailbox signals them after each change and
+ *          rechecks its state after each wait, so binary or counting semaphores can be used. For
+ *          example, in FreeRTOS @p wait can map to xSemaphoreTake() and @p signal to
+ *          xSemaphoreGive(), or xSemaphoreGiveFromISR() in interrupt context. In RTX they can map
+ *          to osSemaphoreWait() and osSemaphoreRelease().
+ */
+typedef struct
+{
+    app_mailbox_wait_t    wait;        /**< Function for waiting on a semaphore. */
+    app_mailbox_signal_t  signal;      /**< Function for signaling a semaphore. */
+    void                * p_item_sem;  /**< Semaphore signaled when an item is queued. */
+    void                * p_space_sem; /**< Semaphore signaled when a slot is freed. */
+} app_mailbox_sync_t;
+
 #include "app_mailbox_local.h"
 
 /**
@@ -95,6 +140,7 @@ ret_code_t app_mailbox_put (const app_mailbox_t * p_mailbox, void * p_item);
  *
  * @retval NRF_SUCCESS              If the item was enqueued.
  * @retval NRF_ERROR_NO_MEM         If the queue is full.
+ * @retval NRF_ERROR_INVALID_LENGTH If size is larger than the item size of the mailbox.
  */
 ret_code_t app_mailbox_sized_put (const app_mailbox_t * p_mailbox, void * p_item, uint16_t size);
 
@@ -121,6 +167,61 @@ ret_code_t app_mailbox_get (const app_mailbox_t * p_mailbox, void * p_item);
  */
 ret_code_t app_mailbox_sized_get (const app_mailbox_t * p_mailbox, void * p_item, uint16_t * p_size);
 
+/**
+ * @brief Function for allocating a slot to be filled in place.
+ *
+ * The slot is owned by the caller until it is passed to @ref app_mailbox_commit.
+ *
+ * @param[in]  p_mailbox   Pointer to the mailbox.
+ * @param[out] pp_item     Pointer to the item memory of the slot, or NULL if no slot is free.
+ *
+ * @retval NRF_SUCCESS              If a slot was allocated.
+ * @retval NRF_ERROR_NO_MEM         If the queue is full. In @ref APP_MAILBOX_MODE_OVERFLOW mode,
+ *                                  the oldest queued item was removed to allocate the slot if
+ *                                  @p pp_item is not NULL.
+ */
+ret_code_t app_mailbox_alloc(const app_mailbox_t * p_mailbox, void ** pp_item);
+
+/**
+ * @brief Function for queuing an item allocated with @ref app_mailbox_alloc.
+ *
+ * @param[in] p_mailbox   Pointer to the mailbox.
+ * @param[in] p_item      Pointer returned by @ref app_mailbox_alloc.
+ * @param[in] size        Size of the item.
+ *
+ * @retval NRF_SUCCESS              If the item was committed.
+ * @retval NRF_ERROR_INVALID_ADDR   If p_item is not the item memory of a slot.
+ * @retval NRF_ERROR_INVALID_LENGTH If size is larger than the item size of the mailbox.
+ * @retval NRF_ERROR_INVALID_STATE  If the slot is not allocated.
+ */
+ret_code_t app_mailbox_commit(const app_mailbox_t * p_mailbox, void * p_item, uint16_t size);
+
+/**
+ * @brief Function for taking the oldest item from the queue without copying it.
+ *
+ * The slot is owned by the caller until it is passed to @ref app_mailbox_release.
+ *
+ * @param[in]  p_mailbox   Pointer to the mailbox.
+ * @param[out] pp_item     Pointer to the item.
+ * @param[out] p_size      Pointer to the item size.
+ *
+ * @retval NRF_SUCCESS              If an item was taken.
+ * @retval NRF_ERROR_NO_MEM         If the queue is empty.
+ */
+ret_code_t app_mailbox_ptr_get(const app_mailbox_t * p_mailbox, void ** pp_item, uint16_t * p_size);
+
+/**
+ * @brief Function for freeing the slot of an item taken with @ref app_mailbox_ptr_get.
+ *
+ * @param[in] p_mailbox   Pointer to the mailbox.
+ * @param[in] p_item      Pointer returned by @ref app_mailbox_ptr_get.
+ *
+ * @retval NRF_SUCCESS              If the slot was released.
+ * @retval NRF_ERROR_INVALID_ADDR   If p_item is not the item memory of a slot.
+ * @retval NRF_ERROR_INVALID_STATE  If the slot is not taken by a consumer.
+ */
+ret_code_t app_mailbox_release(const app_mailbox_t * p_mailbox, void * p_item);
+
 /**
  * @brief Function for getting the current length of the mailbox queue.
  *
@@ -139,5 +240,49 @@ uint32_t app_mailbox_length_get (const app_mailbox_t * p_mailbox);
  */
 void app_mailbox_mode_set(const app_mailbox_t * p_mailbox, app_mailbox_overflow_mode_t mode);
 
+/**
+ * @brief Function for setting the blocking hooks of the mailbox.
+ *
+ * @param[in]  p_mailbox   Pointer to the mailbox.
+ * @param[in]  p_sync      Blocking hooks, or NULL to remove them. The structure must be kept in
+ *                         memory while it is set.
+ *
+ * @retval NRF_SUCCESS              If the hooks were set.
+ * @retval NRF_ERROR_NULL           If a hook function is NULL.
+ */
+ret_code_t app_mailbox_sync_set(const app_mailbox_t * p_mailbox, app_mailbox_sync_t const * p_sync);
+
+/**
+ * @brief Function for allocating a slot, waiting for one to be freed if the queue is full.
+ *
+ * @param[in]  p_mailbox   Pointer to the mailbox.
+ * @param[out] pp_item     Pointer to the item memory of the slot.
+ * @param[in]  timeout     Timeout of each wait. If zero, or if no blocking hooks are set, this
+ *                         function behaves as @ref app_mailbox_alloc.
+ *
+ * @retval NRF_SUCCESS              If a slot was allocated.
+ * @retval NRF_ERROR_NO_MEM         If the queue is full and the function did not wait.
+ * @retval NRF_ERROR_TIMEOUT        If no slot was freed before the timeout expired.
+ */
+ret_code_t app_mailbox_alloc_wait(const app_mailbox_t * p_mailbox, void ** pp_item, uint32_t timeout);
+
+/**
+ * @brief Function for taking the oldest item, waiting for one to be queued if the queue is empty.
+ *
+ * @param[in]  p_mailbox   Pointer to the mailbox.
+ * @param[out] pp_item     Pointer to the item.
+ * @param[out] p_size      Pointer to the item size.
+ * @param[in]  timeout     Timeout of each wait. If zero, or if no blocking hooks are set, this
+ *                         function behaves as @ref app_mailbox_ptr_get.
+ *
+ * @retval NRF_SUCCESS              If an item was taken.
+ * @retval NRF_ERROR_NO_MEM         If the queue is empty and the function did not wait.
+ * @retval NRF_ERROR_TIMEOUT        If no item was queued before the timeout expired.
+ */
+ret_code_t app_mailbox_ptr_get_wait(const app_mailbox_t * p_mailbox,
+                                    void               ** pp_item,
+                                    uint16_t            * p_size,
+                                    uint32_t              timeout);
+
 #endif //_APP_MAILBOX_H
 /** @} */
@@ -32,7 +32,10 @@
         uint8_t                      r_idx;    /**< Read index for the mailbox queue. */
         uint8_t                      w_idx;    /**< Write index for the mailbox queue. */
         uint8_t                      len;      /**< Number of elements currently in the mailbox queue. */
+        uint8_t                      alloc_cnt; /**< Number of slots allocated to producers and not yet queued, starting at the write index. */
+        uint8_t                      lent_cnt; /**< Number of slots taken by consumers and not yet freed, preceding the read index. */
         app_mailbox_overflow_mode_t  mode;     /**< Mode of overflow handling. */
+        app_mailbox_sync_t const   * p_sync;   /**< Blocking hooks, or NULL. */
     } app_mailbox_cb_t;
 
 
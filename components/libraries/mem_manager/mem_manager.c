@@ -11,9 +11,13 @@
  */
 #include "sdk_config.h"
 #include "sdk_common.h"
+#include "nrf.h"
 #include "mem_manager.h"
 #include "app_trace.h"
 #include "nrf_assert.h"
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+#include "app_util_platform.h"
+#endif // MEM_MANAGER_CACHE_SIZE
 
 /**
  * @defgroup mem_manager_log Module's Log Macros
@@ -57,8 +61,14 @@
  *          framework is provided in case need arises to use an alternative architecture.
  * @{
  */
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+#define MM_MUTEX_LOCK()   uint8_t mm_cr_nested = 0;                                                 \
+                          app_util_critical_region_enter(&mm_cr_nested)                             /**< Lock shared pool, caches assume it is used from several contexts. */
+#define MM_MUTEX_UNLOCK() app_util_critical_region_exit(mm_cr_nested)                               /**< Unlock shared pool. */
+#else
 #define MM_MUTEX_LOCK()   SDK_MUTEX_LOCK(m_mm_mutex)                                                /**< Lock module using mutex. */
 #define MM_MUTEX_UNLOCK() SDK_MUTEX_UNLOCK(m_mm_mutex)                                              /**< Unlock module using mutex. */
+#endif // MEM_MANAGER_CACHE_SIZE
 /** @} */
 
 #undef NULL_PARAM_CHECK
@@ -528,6 +538,41 @@ static uint32_t m_block_count[BLOCK_CAT_COUNT] =
 
 #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
 
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+static nrf_mem_stats_t m_block_stats[BLOCK_CAT_COUNT];                                              /**< Runtime statistics for each block category. */
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+
+/**@brief Number of cache contexts, by default one per interrupt priority.
+ *
+ * @note Without MEM_MANAGER_CACHE_CONTEXT_GET(), thread mode has no cache context, so the tasks of
+ *       an RTOS always use the shared pool. Define both macros to give each task its own cache.
+ */
+#ifndef MEM_MANAGER_CACHE_CONTEXT_COUNT
+#define MEM_MANAGER_CACHE_CONTEXT_COUNT (APP_IRQ_PRIORITY_LOWEST + 1)
+#endif // MEM_MANAGER_CACHE_CONTEXT_COUNT
+
+#define CACHE_CONTEXT_NONE             0xFFFFFFFF                                                   /**< Context that bypasses the caches. */
+
+STATIC_ASSERT(TOTAL_BLOCK_COUNT <= 0xFFFF);
+
+/**@brief Cache of blocks freed in one context, for one block category.
+ *
+ * @details Cached blocks stay marked as allocated in the bitmap, so only the owning context can
+ *          hand them out again.
+ */
+typedef struct
+{
+    uint16_t block_index[MEM_MANAGER_CACHE_SIZE];                                                   /**< Cached block numbers, used as a stack. */
+    uint8_t  count;                                                                                 /**< Number of cached blocks. */
+} block_cache_t;
+
+static block_cache_t m_block_cache[MEM_MANAGER_CACHE_CONTEXT_COUNT][BLOCK_CAT_COUNT];               /**< Block caches of each context. */
+static uint8_t       m_block_cached[TOTAL_BLOCK_COUNT];                                             /**< Non-zero if the block is held by a cache. A byte per block, so that contexts never share a read-modify-write. */
+
+#endif // MEM_MANAGER_CACHE_SIZE
+
 SDK_MUTEX_DEFINE(m_mm_mutex)                                                                        /**< Mutex variable. Currently unused, this declaration does not occupy any space in RAM. */
 #if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
 static bool     m_module_initialized = false;                                                       /**< State indicating if module is initialized or not. */
@@ -601,7 +646,9 @@ static __INLINE uint32_t get_block_size(uint32_t block_index)
 }
 
 
-/**@brief Function to free the block identified by block number 'block_index'. */
+#if defined(MEM_MANAGER_ENABLE_DIAGNOSTICS) || defined(MEM_MANAGER_ENABLE_STATISTICS) || \
+    (MEM_MANAGER_CACHE_SIZE > 0)
+/**@brief Function to check if the block identified by block number 'block_index' is free. */
 static bool is_block_free(uint32_t block_index)
 {
     uint32_t x;
@@ -613,6 +660,7 @@ static bool is_block_free(uint32_t block_index)
 
     return IS_SET(m_mem_pool[x], y);
 }
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS || MEM_MANAGER_ENABLE_STATISTICS || MEM_MANAGER_CACHE_SIZE
 
 
 /**@brief Function to allocate the block identified by block number 'block_index'. */
@@ -629,6 +677,192 @@ static void block_allocate(uint32_t block_index)
 }
 
 
+/**@brief Function to find the first free block with block number 'block_index' or higher.
+ *
+ * @details The bitmap is searched a word at a time, and the lowest free block in a word is found
+ *          by counting leading zeros of its lowest set bit. Blocks are ordered by category, so
+ *          the search continues into the larger categories if the requested one is exhausted.
+ *
+ * @return  Block number of the free block, or TOTAL_BLOCK_COUNT if no block is free.
+ */
+static uint32_t free_block_find(uint32_t block_index)
+{
+    uint32_t x;
+    uint32_t y;
+
+    if (block_index >= TOTAL_BLOCK_COUNT)
+    {
+        return TOTAL_BLOCK_COUNT;
+    }
+
+    get_block_coordinates(block_index, &x, &y);
+
+    // Ignore the blocks below 'block_index' in the first word.
+    uint32_t word = m_mem_pool[x] & ~((1UL << y) - 1);
+
+    while (word == 0)
+    {
+        if (++x >= BLOCK_BITMAP_ARRAY_SIZE)
+        {
+            return TOTAL_BLOCK_COUNT;
+        }
+        word = m_mem_pool[x];
+    }
+
+    block_index = (x * BITMAP_SIZE) + (31 - __CLZ(word & (0 - word)));
+
+    return MIN(block_index, TOTAL_BLOCK_COUNT);
+}
+
+
+/**@brief Function to get the memory offset of the block number 'block_index'. */
+static __INLINE uint32_t get_block_mem_index(uint32_t block_index)
+{
+    const uint32_t block_cat = get_block_cat(0, block_index);
+
+    return m_block_mem_start[block_cat] +
+           (block_index - m_block_start[block_cat]) * m_block_size[block_cat];
+}
+
+
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+
+/**@brief Function to update the statistics of category 'block_cat' for a granted block.
+ *
+ * @param[in] block_cat      Category of the granted block.
+ * @param[in] requested_size Size requested by the application.
+ */
+static void stats_allocated_update(uint32_t block_cat, uint32_t requested_size)
+{
+    nrf_mem_stats_t * const p_stats = &m_block_stats[block_cat];
+    const uint32_t          bin     = ((requested_size * NRF_MEM_STATS_HISTOGRAM_BINS) - 1) /
+                                      m_block_size[block_cat];
+
+    p_stats->blocks_in_use++;
+    p_stats->blocks_in_use_max = MAX(p_stats->blocks_in_use_max, p_stats->blocks_in_use);
+    p_stats->requested_bytes  += requested_size;
+    p_stats->granted_bytes    += m_block_size[block_cat];
+    p_stats->size_histogram[bin]++;
+}
+
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+
+
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+
+/**@brief Function to get the cache context of the caller.
+ *
+ * @details By default, each interrupt priority has its own context. Interrupts of the same
+ *          priority cannot preempt each other, so the cache of a context can be used without a
+ *          lock. Thread mode gets no context by default, because tasks of an RTOS preempt each
+ *          other in thread mode. Define MEM_MANAGER_CACHE_CONTEXT_GET() to return a per-task
+ *          context instead, or CACHE_CONTEXT_NONE for callers that must not use a cache.
+ */
+static __INLINE uint32_t cache_context_get(void)
+{
+#ifdef MEM_MANAGER_CACHE_CONTEXT_GET
+    const uint32_t context = MEM_MANAGER_CACHE_CONTEXT_GET();
+#else
+    const uint32_t context = current_int_priority_get();
+#endif // MEM_MANAGER_CACHE_CONTEXT_GET
+
+    return (context < MEM_MANAGER_CACHE_CONTEXT_COUNT) ? context : CACHE_CONTEXT_NONE;
+}
+
+
+/**@brief Function to take a block of category 'block_cat' from the cache of the caller.
+ *
+ * @return  Block number, or TOTAL_BLOCK_COUNT if the cache is empty.
+ */
+static uint32_t cache_block_get(uint32_t block_cat)
+{
+    const uint32_t context = cache_context_get();
+
+    if (context != CACHE_CONTEXT_NONE)
+    {
+        block_cache_t * const p_cache = &m_block_cache[context][block_cat];
+
+        if (p_cache->count > 0)
+        {
+            const uint32_t block_index = p_cache->block_index[--p_cache->count];
+
+            m_block_cached[block_index] = 0;
+            return block_index;
+        }
+    }
+
+    return TOTAL_BLOCK_COUNT;
+}
+
+
+/**@brief Function to put the block number 'block_index' in the cache of the caller.
+ *
+ * @details A block that is already held by a cache has been freed before. It is neither cached
+ *          again nor returned to the pool, either of which would let two allocations share it.
+ *
+ * @return  true if the block was cached or already is, false if it must be returned to the pool.
+ */
+static bool cache_block_put(uint32_t block_index)
+{
+    if (m_block_cached[block_index] != 0)
+    {
+        return true;
+    }
+
+    const uint32_t context = cache_context_get();
+
+    if ((context != CACHE_CONTEXT_NONE) && !is_block_free(block_index))
+    {
+        block_cache_t * const p_cache = &m_block_cache[context][get_block_cat(0, block_index)];
+
+        if (p_cache->count < MEM_MANAGER_CACHE_SIZE)
+        {
+            m_block_cached[block_index]            = 1;
+            p_cache->block_index[p_cache->count++] = block_index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif // MEM_MANAGER_CACHE_SIZE
+
+
+/**@brief Function to get the block number of the memory block pointed to by 'p_mem'.
+ *
+ * @return  Block number, or TOTAL_BLOCK_COUNT if 'p_mem' is not the start of a block.
+ */
+static uint32_t get_block_index(void const * p_mem)
+{
+    const uint32_t memory_index = (uint32_t)((uint8_t const *)p_mem - m_memory);
+
+    if ((uint8_t const *)p_mem < m_memory)
+    {
+        return TOTAL_BLOCK_COUNT;
+    }
+
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        const uint32_t block_count = m_block_end[block_cat] - m_block_start[block_cat];
+        const uint32_t offset      = memory_index - m_block_mem_start[block_cat];
+
+        if ((block_count != 0) &&
+            (memory_index >= m_block_mem_start[block_cat]) &&
+            (offset < block_count * m_block_size[block_cat]))
+        {
+            if ((offset % m_block_size[block_cat]) != 0)
+            {
+                break;
+            }
+            return m_block_start[block_cat] + (offset / m_block_size[block_cat]);
+        }
+    }
+
+    return TOTAL_BLOCK_COUNT;
+}
+
+
 uint32_t nrf_mem_init(void)
 {
     MM_LOG("[MM]: >> nrf_mem_init.\r\n");
@@ -648,6 +882,21 @@ uint32_t nrf_mem_init(void)
     m_module_initialized = true;
 #endif // MEM_MANAGER_DISABLE_API_PARAM_CHECK
 
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+    memset(m_block_cache, 0, sizeof(m_block_cache));
+    memset(m_block_cached, 0, sizeof(m_block_cached));
+#endif // MEM_MANAGER_CACHE_SIZE
+
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+    memset(m_block_stats, 0, sizeof(m_block_stats));
+
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        m_block_stats[block_cat].block_size  = m_block_size[block_cat];
+        m_block_stats[block_cat].block_count = m_block_end[block_cat] - m_block_start[block_cat];
+    }
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+
 #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
         nrf_mem_diagnose();
 #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
@@ -672,45 +921,63 @@ uint32_t nrf_mem_reserve(uint8_t ** pp_buffer, uint32_t * p_size)
 
     MM_LOG("[MM]: >> nrf_mem_reserve, size 0x%04lX.\r\n", requested_size);
 
+    const uint32_t block_cat    = get_block_cat(requested_size, TOTAL_BLOCK_COUNT);
+
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+    const uint32_t cached_index = cache_block_get(block_cat);
+
+    if (cached_index < TOTAL_BLOCK_COUNT)
+    {
+        (*pp_buffer) = &m_memory[get_block_mem_index(cached_index)];
+        (*p_size)    = m_block_size[block_cat];
+
+        MM_LOG("[MM]: << nrf_mem_reserve %p from cache.\r\n", (*pp_buffer));
+
+        return NRF_SUCCESS;
+    }
+#endif // MEM_MANAGER_CACHE_SIZE
+
     MM_MUTEX_LOCK();
 
-    const uint32_t block_cat    = get_block_cat(requested_size, TOTAL_BLOCK_COUNT);
     uint32_t       block_index  = m_block_start[block_cat];
-    uint32_t       memory_index = m_block_mem_start[block_cat];
     uint32_t       err_code     = (NRF_ERROR_NO_MEM | MEMORY_MANAGER_ERR_BASE);
 
     MM_LOG("[MM]: Start index for the pool = 0x%08lX, total block count 0x%08X\r\n",
            block_index,
            TOTAL_BLOCK_COUNT);
 
-    for (; block_index < TOTAL_BLOCK_COUNT; block_index++)
+    block_index = free_block_find(block_index);
+
+    if (block_index < TOTAL_BLOCK_COUNT)
     {
         uint32_t block_size = get_block_size(block_index);
 
-        if (is_block_free(block_index) == true)
-        {
-            MM_LOG("[MM]: Reserving block 0x%08lX\r\n", block_index);
+        MM_LOG("[MM]: Reserving block 0x%08lX\r\n", block_index);
 
-            // Search succeeded, found free block.
-            err_code     = NRF_SUCCESS;
+        // Search succeeded, found free block.
+        err_code     = NRF_SUCCESS;
 
-            // Allocate block.
-            block_allocate(block_index);
+        // Allocate block.
+        block_allocate(block_index);
 
-            (*pp_buffer) = &m_memory[memory_index];
-            (*p_size)    = block_size;
+        (*pp_buffer) = &m_memory[get_block_mem_index(block_index)];
+        (*p_size)    = block_size;
 
-            #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
-                (*p_min_size) = MIN((*p_min_size), requested_size);
-                (*p_max_size) = MAX((*p_max_size), requested_size);
-            #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+        #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+            (*p_min_size) = MIN((*p_min_size), requested_size);
+            (*p_max_size) = MAX((*p_max_size), requested_size);
+        #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
 
-            break;
-        }
-        memory_index += block_size;
+        #ifdef MEM_MANAGER_ENABLE_STATISTICS
+            stats_allocated_update(get_block_cat(0, block_index), requested_size);
+        #endif // MEM_MANAGER_ENABLE_STATISTICS
     }
     if (err_code != NRF_SUCCESS)
     {
+        #ifdef MEM_MANAGER_ENABLE_STATISTICS
+            m_block_stats[block_cat].alloc_failures++;
+        #endif // MEM_MANAGER_ENABLE_STATISTICS
+
         MM_LOG ("[MM]: Memory reservation result %d, memory %p, size %d!",
                 err_code,
                 (*pp_buffer),
@@ -775,21 +1042,32 @@ void nrf_free(void * p_mem)
 
     MM_LOG("[MM]: >> nrf_free %p.\r\n", p_mem);
 
-    MM_MUTEX_LOCK();
+    const uint32_t index = get_block_index(p_mem);
 
-    uint32_t index;
-    uint32_t memory_index = 0;
+#if (MEM_MANAGER_CACHE_SIZE > 0)
+    if ((index < TOTAL_BLOCK_COUNT) && cache_block_put(index))
+    {
+        MM_LOG("[MM]: << nrf_free, block %d cached.\r\n", index);
+        return;
+    }
+#endif // MEM_MANAGER_CACHE_SIZE
+
+    MM_MUTEX_LOCK();
 
-    for (index = 0; index < TOTAL_BLOCK_COUNT; index++)
+    if (index < TOTAL_BLOCK_COUNT)
     {
-        if (&m_memory[memory_index] == p_mem)
+        // Found a free block of memory, assign.
+        MM_LOG("[MM]: << Freeing block %d.\r\n", index);
+
+        #ifdef MEM_MANAGER_ENABLE_STATISTICS
+        // Do not count a double free.
+        if (!is_block_free(index))
         {
-            // Found a free block of memory, assign.
-            MM_LOG("[MM]: << Freeing block %d.\r\n", index);
-            block_init(index);
-            break;
+            m_block_stats[get_block_cat(0, index)].blocks_in_use--;
         }
-        memory_index += get_block_size(index);
+        #endif // MEM_MANAGER_ENABLE_STATISTICS
+
+        block_init(index);
     }
 
     MM_MUTEX_UNLOCK();
@@ -805,6 +1083,51 @@ void * nrf_realloc(void * p_mem, uint32_t size)
 }
 
 
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+
+uint32_t nrf_mem_stats_get(uint32_t block_cat, nrf_mem_stats_t * p_stats)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_stats);
+
+    if (block_cat >= BLOCK_CAT_COUNT)
+    {
+        return (NRF_ERROR_INVALID_PARAM | MEMORY_MANAGER_ERR_BASE);
+    }
+
+    MM_MUTEX_LOCK();
+
+    (*p_stats) = m_block_stats[block_cat];
+
+    MM_MUTEX_UNLOCK();
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_mem_stats_reset(void)
+{
+    VERIFY_MODULE_INITIALIZED_VOID();
+
+    MM_MUTEX_LOCK();
+
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        nrf_mem_stats_t * const p_stats = &m_block_stats[block_cat];
+
+        p_stats->blocks_in_use_max = p_stats->blocks_in_use;
+        p_stats->alloc_failures    = 0;
+        p_stats->requested_bytes   = 0;
+        p_stats->granted_bytes     = 0;
+        memset(p_stats->size_histogram, 0, sizeof(p_stats->size_histogram));
+    }
+
+    MM_MUTEX_UNLOCK();
+}
+
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+
+
 #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
 
 /**@brief Function to format and print information with respect to each block.
@@ -29,6 +29,21 @@
  * To use fewer than seven buffer pools, do not define the count for the unwanted block
  * or explicitly set it to zero. At least one block category must be configured
  * for this module to function as expected.
+ *
+ * Free blocks are tracked in a bitmap that is searched a word at a time, and a freed block is
+ * located directly from its address, so the cost of allocating and freeing does not grow with the
+ * number of blocks in a category.
+ *
+ * When several execution contexts allocate memory, define MEM_MANAGER_CACHE_SIZE to give each
+ * context a cache of up to that many recently freed blocks per block category. Allocations and
+ * frees served by the caller's cache skip the critical region protecting the shared pool. By
+ * default there is one context per interrupt priority, and thread mode always uses the shared
+ * pool, so the tasks of an RTOS get no cache unless the application defines
+ * MEM_MANAGER_CACHE_CONTEXT_COUNT and MEM_MANAGER_CACHE_CONTEXT_GET() to return a per-task index.
+ * At most MEM_MANAGER_CACHE_SIZE blocks of each category are held by each context. Freeing a block
+ * that is already cached has no effect. Cached blocks are reported as in use by
+ * @ref nrf_mem_diagnose and the statistics, and allocations served from a cache are not included
+ * in the statistics.
  */
 
 #ifndef MEM_MANAGER_H__
@@ -36,6 +51,32 @@
 
 #include "sdk_common.h"
 
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+
+#define NRF_MEM_STATS_HISTOGRAM_BINS 4  /**< Number of bins in @ref nrf_mem_stats_t::size_histogram. */
+
+/**@brief Runtime statistics of one block category.
+ *
+ * @details The requested size of each granted block is recorded in @ref size_histogram as a
+ *          fraction of the block size: bin 0 counts requests of up to 1/4 of the block size, and
+ *          bin 3 counts requests of more than 3/4 of the block size. Together with
+ *          @ref requested_bytes and @ref granted_bytes, this shows how much memory is lost by
+ *          rounding requests up to the block size.
+ */
+typedef struct
+{
+    uint32_t block_size;                                  /**< Size of each block in the category. */
+    uint32_t block_count;                                 /**< Number of blocks in the category. */
+    uint32_t blocks_in_use;                               /**< Number of blocks currently allocated. */
+    uint32_t blocks_in_use_max;                           /**< Highest number of blocks allocated at the same time. */
+    uint32_t alloc_failures;                              /**< Number of requests for this category that could not be served. */
+    uint32_t requested_bytes;                             /**< Sum of the sizes requested for the blocks granted from this category. */
+    uint32_t granted_bytes;                               /**< Sum of the sizes of the blocks granted from this category. */
+    uint32_t size_histogram[NRF_MEM_STATS_HISTOGRAM_BINS]; /**< Requested size relative to the block size, see @ref nrf_mem_stats_t. */
+} nrf_mem_stats_t;
+
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+
 
 /**@brief Initializes Memory Manager.
  *
@@ -135,5 +176,37 @@ void nrf_mem_diagnose(void);
 
 #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
 
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+
+/**@brief Function to get runtime statistics of a block category.
+ *
+ * @details Statistics are collected when MEM_MANAGER_ENABLE_STATISTICS is defined. Unlike
+ *          @ref nrf_mem_diagnose, this costs only a few counter updates per allocation and free,
+ *          and does not print anything, so it can be left enabled in production builds to size
+ *          the block counts from field data.
+ *
+ *          A request is counted in the category that its size maps to when it fails, and in the
+ *          category of the block that was granted when it succeeds. These differ when the
+ *          requested category was exhausted and a larger block was used.
+ *
+ * @param[in]  block_cat Block category, from 0 (xxsmall) to 6 (xxlarge).
+ * @param[out] p_stats   Statistics of the category.
+ *
+ * @retval     NRF_SUCCESS             If the statistics were copied to p_stats.
+ * @retval     NRF_ERROR_INVALID_PARAM If block_cat is not a valid category.
+ * @retval     NRF_ERROR_NULL          If p_stats is NULL.
+ */
+uint32_t nrf_mem_stats_get(uint32_t block_cat, nrf_mem_stats_t * p_stats);
+
+
+/**@brief Function to reset the runtime statistics.
+ *
+ * @details Clears the failure counters, byte counts and histograms of all categories, and sets the
+ *          peak usage to the current usage.
+ */
+void nrf_mem_stats_reset(void);
+
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+
 #endif // MEM_MANAGER_H__
 /** @} */
@@ -0,0 +1,318 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_pdm_stream.h"
+#include <stddef.h>
+#include "nrf_assert.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+#if APP_PDM_STREAM_USE_SCHEDULER
+#include "app_scheduler.h"
+#endif
+
+// The ready queue is indexed with free-running counters, so its size must be
+// a power of two.
+#define READY_QUEUE_SIZE  APP_PDM_STREAM_MAX_BUFFERS
+#define READY_QUEUE_MASK  (READY_QUEUE_SIZE - 1)
+STATIC_ASSERT((READY_QUEUE_SIZE & READY_QUEUE_MASK) == 0);
+
+typedef struct
+{
+    app_pdm_stream_config_t config;                         ///< Streaming configuration.
+    volatile uint32_t       free_mask;                      ///< Buffers not used by the PDM interface or waiting for processing.
+    uint8_t                 active_idx;                     ///< Buffer being filled.
+    uint8_t                 next_idx;                       ///< Buffer set up to be filled next.
+    bool                    drop_pending;                   ///< The active buffer is filled again, so its data will be lost.
+    uint8_t                 ready_idx[READY_QUEUE_SIZE];    ///< Filled buffers waiting for processing.
+    uint32_t                ready_seq[READY_QUEUE_SIZE];    ///< Sequence numbers of the filled buffers.
+    volatile uint8_t        ready_write;                    ///< Ready queue write counter.
+    volatile uint8_t        ready_read;                     ///< Ready queue read counter.
+    app_pdm_stream_stats_t  stats;                          ///< Streaming statistics.
+} app_pdm_stream_cb_t;
+
+static app_pdm_stream_cb_t m_cb;
+
+
+static int16_t * buffer_get(uint8_t idx)
+{
+    return m_cb.config.p_buffers + (uint32_t)idx * m_cb.config.buffer_length;
+}
+
+
+static void frames_process(void)
+{
+    while (m_cb.ready_read != m_cb.ready_write)
+    {
+        uint8_t   pos      = m_cb.ready_read & READY_QUEUE_MASK;
+        uint8_t   idx      = m_cb.ready_idx[pos];
+        int16_t * p_frame  = buffer_get(idx);
+        uint16_t  length   = m_cb.config.buffer_length;
+
+        if (m_cb.config.process != NULL)
+        {
+            length = m_cb.config.process(p_frame, length, m_cb.config.p_process_context);
+        }
+        m_cb.config.frame_handler(p_frame, length, m_cb.ready_seq[pos]);
+
+        CRITICAL_REGION_ENTER();
+        m_cb.free_mask |= (1UL << idx);
+        CRITICAL_REGION_EXIT();
+        ++m_cb.ready_read;
+    }
+}
+
+
+#if APP_PDM_STREAM_USE_SCHEDULER
+static void frames_process_evt_handler(void * p_event_data, uint16_t event_size)
+{
+    UNUSED_PARAMETER(p_event_data);
+    UNUSED_PARAMETER(event_size);
+
+    frames_process();
+}
+#else
+void APP_PDM_STREAM_SWI_IRQHandler(void)
+{
+    frames_process();
+}
+#endif
+
+
+static void frames_process_trigger(void)
+{
+#if APP_PDM_STREAM_USE_SCHEDULER
+    // [if the scheduler queue is full, the frames are processed together with
+    //  the next one]
+    (void)app_sched_event_put(NULL, 0, frames_process_evt_handler);
+#else
+    NVIC_SetPendingIRQ(APP_PDM_STREAM_SWI_IRQn);
+#endif
+}
+
+
+// Called from the PDM interrupt when a buffer has started to be filled.
+static int16_t * pdm_buffer_request_handler(void)
+{
+    uint32_t free_mask;
+    uint8_t  idx;
+
+    m_cb.active_idx = m_cb.next_idx;
+
+    CRITICAL_REGION_ENTER();
+    free_mask = m_cb.free_mask;
+    if (free_mask != 0)
+    {
+        idx = (uint8_t)__CLZ(__RBIT(free_mask));
+        m_cb.free_mask = free_mask & ~(1UL << idx);
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (free_mask == 0)
+    {
+        // The active buffer is filled again. Its current content cannot be
+        // passed on, since it would be overwritten during processing.
+        m_cb.drop_pending = true;
+        return NULL;
+    }
+
+    m_cb.next_idx = idx;
+    return buffer_get(idx);
+}
+
+
+// Called from the PDM interrupt when a buffer has been filled.
+static void pdm_event_handler(uint32_t * p_buffer, uint16_t length)
+{
+    UNUSED_PARAMETER(p_buffer);
+    UNUSED_PARAMETER(length);
+
+    uint32_t sequence = m_cb.stats.frames_captured++;
+
+    if (m_cb.drop_pending)
+    {
+        m_cb.drop_pending = false;
+        ++m_cb.stats.frames_dropped;
+        return;
+    }
+
+    uint8_t write   = m_cb.ready_write;
+    uint8_t pos     = write & READY_QUEUE_MASK;
+    uint8_t pending = (uint8_t)(write + 1 - m_cb.ready_read);
+
+    m_cb.ready_idx[pos] = m_cb.active_idx;
+    m_cb.ready_seq[pos] = sequence;
+    m_cb.ready_write    = write + 1;
+
+    if (pending > m_cb.stats.max_pending)
+    {
+        m_cb.stats.max_pending = pending;
+    }
+
+    frames_process_trigger();
+}
+
+
+ret_code_t app_pdm_stream_init(nrf_drv_pdm_config_t const *    p_pdm_config,
+                               app_pdm_stream_config_t const * p_config)
+{
+    ASSERT(p_pdm_config != NULL);
+    ASSERT(p_config != NULL);
+
+    ret_code_t           err_code;
+    nrf_drv_pdm_config_t pdm_config = *p_pdm_config;
+
+    if ((p_config->p_buffers == NULL) || (p_config->frame_handler == NULL) ||
+        (p_config->buffer_length == 0) || (p_config->buffer_count < 2) ||
+        (p_config->buffer_count > APP_PDM_STREAM_MAX_BUFFERS))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_cb.config = *p_config;
+
+    pdm_config.buffer_length = p_config->buffer_length;
+    pdm_config.buffer_a      = buffer_get(0);
+    pdm_config.buffer_b      = buffer_get(1);
+
+    err_code = nrf_drv_pdm_init(&pdm_config, pdm_event_handler);
+    VERIFY_SUCCESS(err_code);
+
+    nrf_drv_pdm_buffer_request_handler_set(pdm_buffer_request_handler);
+
+    m_cb.ready_write = 0;
+    m_cb.ready_read  = 0;
+
+#if !APP_PDM_STREAM_USE_SCHEDULER
+    NVIC_ClearPendingIRQ(APP_PDM_STREAM_SWI_IRQn);
+    NVIC_SetPriority(APP_PDM_STREAM_SWI_IRQn, p_config->irq_priority);
+    NVIC_EnableIRQ(APP_PDM_STREAM_SWI_IRQn);
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+void app_pdm_stream_uninit(void)
+{
+    nrf_drv_pdm_uninit();
+
+#if !APP_PDM_STREAM_USE_SCHEDULER
+    NVIC_DisableIRQ(APP_PDM_STREAM_SWI_IRQn);
+#endif
+}
+
+
+ret_code_t app_pdm_stream_start(void)
+{
+    if (m_cb.ready_read != m_cb.ready_write)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    // The PDM driver always starts with the first buffer.
+    m_cb.free_mask    = ((m_cb.config.buffer_count == 32) ? 0xFFFFFFFFUL :
+                         ((1UL << m_cb.config.buffer_count) - 1)) & ~1UL;
+    m_cb.active_idx   = 0;
+    m_cb.next_idx     = 0;
+    m_cb.drop_pending = false;
+    memset(&m_cb.stats, 0, sizeof(m_cb.stats));
+
+    return nrf_drv_pdm_start();
+}
+
+
+ret_code_t app_pdm_stream_stop(void)
+{
+    return nrf_drv_pdm_stop();
+}
+
+
+void app_pdm_stream_stats_get(app_pdm_stream_stats_t * p_stats)
+{
+    ASSERT(p_stats != NULL);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_cb.stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
+static int16_t saturate_q15(int64_t value)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+
+uint16_t app_pdm_stream_fir_decimate_q15(int16_t * p_samples, uint16_t length, void * p_context)
+{
+    ASSERT(p_context != NULL);
+
+    app_pdm_stream_fir_t * p_fir     = (app_pdm_stream_fir_t *)p_context;
+    int16_t const *        p_coeffs  = p_fir->p_coeffs;
+    int16_t *              p_state   = p_fir->p_state;
+    uint16_t               num_taps  = p_fir->num_taps;
+    uint16_t               state_idx = p_fir->state_idx;
+    uint8_t                phase     = p_fir->phase;
+    uint16_t               out       = 0;
+    uint16_t               in;
+
+    ASSERT((num_taps != 0) && (p_fir->decimation != 0));
+
+    for (in = 0; in < length; ++in)
+    {
+        // [input samples are kept in the delay line, so the outputs can be
+        //  written to the frame - they never overtake the input]
+        p_state[state_idx] = p_samples[in];
+        if (++state_idx == num_taps)
+        {
+            state_idx = 0;
+        }
+
+        if (++phase < p_fir->decimation)
+        {
+            continue;
+        }
+        phase = 0;
+
+        // The oldest sample is at state_idx. Coefficients are time-reversed,
+        // so the first one applies to the oldest sample.
+        int64_t  acc = 0;
+        uint16_t pos = state_idx;
+        uint16_t k;
+
+        for (k = 0; k < num_taps; ++k)
+        {
+            acc += (int32_t)p_coeffs[k] * p_state[pos];
+            if (++pos == num_taps)
+            {
+                pos = 0;
+            }
+        }
+
+        // [Q30 products, Q8.8 gain]
+        acc = (acc * p_fir->gain) >> (15 + 8);
+        p_samples[out++] = saturate_q15(acc);
+    }
+
+    p_fir->state_idx = state_idx;
+    p_fir->phase     = phase;
+
+    return out;
+}
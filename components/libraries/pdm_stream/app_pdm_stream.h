@@ -0,0 +1,187 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_PDM_STREAM_H__
+#define APP_PDM_STREAM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_drv_pdm.h"
+#include "sdk_errors.h"
+
+/**
+ * @defgroup app_pdm_stream PDM streaming
+ * @{
+ * @ingroup app_common
+ *
+ * @brief @tagAPI52 Module for streaming PCM frames from the PDM interface.
+ *
+ * @details Frames are captured into a pool of buffers without copying. Each
+ *          filled frame is passed to an optional processing stage (for example,
+ *          filtering and decimation) and then to the frame handler. Both run in
+ *          a context with lower priority than the PDM interrupt: a software
+ *          interrupt or, if @ref APP_PDM_STREAM_USE_SCHEDULER is set, the main
+ *          loop through the scheduler. The frame is returned to the pool when
+ *          the frame handler returns.
+ */
+
+/**
+ * @brief Process frames through the scheduler instead of a software interrupt.
+ *
+ * The scheduler must be initialized with space for at least one event
+ * without data.
+ */
+#ifndef APP_PDM_STREAM_USE_SCHEDULER
+#define APP_PDM_STREAM_USE_SCHEDULER 0
+#endif
+
+#if !APP_PDM_STREAM_USE_SCHEDULER
+#ifndef APP_PDM_STREAM_SWI_IRQn
+#define APP_PDM_STREAM_SWI_IRQn       SWI3_EGU3_IRQn       /**< Software interrupt used to process frames. */
+#define APP_PDM_STREAM_SWI_IRQHandler SWI3_EGU3_IRQHandler /**< Handler of the software interrupt used to process frames. */
+#endif
+#endif
+
+#define APP_PDM_STREAM_MAX_BUFFERS    32 /**< Maximum number of buffers in the pool. */
+
+/**
+ * @brief Processing stage prototype.
+ *
+ * The stage works in place, so that the output samples replace the input
+ * samples at the beginning of the buffer.
+ *
+ * @param[in,out] p_samples Samples of the frame.
+ * @param         length    Number of samples in the frame.
+ * @param[in]     p_context Context from the configuration.
+ *
+ * @return Number of samples after processing.
+ */
+typedef uint16_t (* app_pdm_stream_process_t)(int16_t * p_samples,
+                                              uint16_t  length,
+                                              void *    p_context);
+
+/**
+ * @brief Frame handler prototype.
+ *
+ * @param[in] p_frame  Processed samples. The buffer is valid until the handler returns.
+ * @param     length   Number of samples.
+ * @param     sequence Sequence number of the frame. Gaps in the numbering mean
+ *                     that frames have been dropped.
+ */
+typedef void (* app_pdm_stream_frame_handler_t)(int16_t const * p_frame,
+                                                uint16_t        length,
+                                                uint32_t        sequence);
+
+/**
+ * @brief Streaming configuration.
+ */
+typedef struct
+{
+    int16_t *                      p_buffers;         ///< Pool memory, buffer_count * buffer_length samples.
+    uint16_t                       buffer_length;     ///< Number of samples in a frame.
+    uint8_t                        buffer_count;      ///< Number of buffers in the pool, from 2 to @ref APP_PDM_STREAM_MAX_BUFFERS.
+    uint8_t                        irq_priority;      ///< Priority of the processing software interrupt. It must be lower than the PDM interrupt priority.
+    app_pdm_stream_process_t       process;           ///< Processing stage, or NULL.
+    void *                         p_process_context; ///< Context passed to the processing stage.
+    app_pdm_stream_frame_handler_t frame_handler;     ///< Frame handler.
+} app_pdm_stream_config_t;
+
+/**
+ * @brief Streaming statistics.
+ */
+typedef struct
+{
+    uint32_t frames_captured; ///< Number of frames captured by the PDM interface, including dropped ones.
+    uint32_t frames_dropped;  ///< Number of frames dropped because no buffer was free.
+    uint8_t  max_pending;     ///< Maximum number of frames waiting for processing.
+} app_pdm_stream_stats_t;
+
+/**
+ * @brief Context of the FIR decimation stage.
+ *
+ * The coefficients are stored in time-reversed order, as for the CMSIS-DSP
+ * FIR functions, so the same arrays can be used with either implementation.
+ */
+typedef struct
+{
+    int16_t const * p_coeffs;   ///< Filter coefficients (Q15), num_taps elements.
+    int16_t *       p_state;    ///< Delay line, num_taps elements, set to zero before use.
+    uint16_t        num_taps;   ///< Number of filter coefficients.
+    uint8_t         decimation; ///< Decimation factor, 1 to disable decimation.
+    int16_t         gain;       ///< Gain applied to the filter output (Q8.8, 256 is 1.0).
+    uint16_t        state_idx;  ///< Position in the delay line. Set to 0 before use.
+    uint8_t         phase;      ///< Position in the decimation period. Set to 0 before use.
+} app_pdm_stream_fir_t;
+
+/**
+ * @brief Processing stage that filters, decimates, and amplifies Q15 samples in place.
+ *
+ * To be used as @ref app_pdm_stream_config_t::process, with a pointer to
+ * @ref app_pdm_stream_fir_t as the context. Input samples are kept in the delay
+ * line, so filter outputs can overwrite the frame. The filter state is preserved
+ * between frames.
+ *
+ * @param[in,out] p_samples Samples of the frame.
+ * @param         length    Number of samples in the frame.
+ * @param[in]     p_context Pointer to @ref app_pdm_stream_fir_t.
+ *
+ * @return Number of output samples.
+ */
+uint16_t app_pdm_stream_fir_decimate_q15(int16_t * p_samples, uint16_t length, void * p_context);
+
+/**
+ * @brief Function for initializing the PDM driver and the streaming module.
+ *
+ * @param[in] p_pdm_config PDM driver configuration. The buffer fields are ignored.
+ * @param[in] p_config     Streaming configuration. It is copied by the module.
+ *
+ * @retval NRF_SUCCESS             If initialization was successful.
+ * @retval NRF_ERROR_INVALID_PARAM If the configuration is invalid.
+ * @return Error code returned by the PDM driver.
+ */
+ret_code_t app_pdm_stream_init(nrf_drv_pdm_config_t const *    p_pdm_config,
+                               app_pdm_stream_config_t const * p_config);
+
+/**
+ * @brief Function for uninitializing the streaming module and the PDM driver.
+ */
+void app_pdm_stream_uninit(void);
+
+/**
+ * @brief Function for starting streaming.
+ *
+ * @retval NRF_SUCCESS    If streaming was started.
+ * @retval NRF_ERROR_BUSY If frames from the previous streaming have not been
+ *                        processed yet, or if the PDM driver is busy.
+ */
+ret_code_t app_pdm_stream_start(void);
+
+/**
+ * @brief Function for stopping streaming.
+ *
+ * The frame being captured is completed and processed.
+ *
+ * @retval NRF_SUCCESS    If streaming was stopped.
+ * @retval NRF_ERROR_BUSY If the PDM driver is busy.
+ */
+ret_code_t app_pdm_stream_stop(void);
+
+/**
+ * @brief Function for getting streaming statistics.
+ *
+ * @param[out] p_stats Statistics since the last start.
+ */
+void app_pdm_stream_stats_get(app_pdm_stream_stats_t * p_stats);
+
+/** @} */
+
+#endif // APP_PDM_STREAM_H__
@@ -34,6 +34,7 @@
 #define APP_PWM_REQUIRED_PPI_CHANNELS_PER_CHANNEL  2
 
 #define UNALLOCATED                                0xFFFFFFFFUL
+#define NOT_STAGED                                 0xFFFFFFFFUL
 #define BUSY_STATE_CHANGING                        0xFE
 #define BUSY_STATE_IDLE                            0xFF
 
@@ -71,6 +72,14 @@ static volatile uint32_t m_pwm_target_value[TIMER_COUNT];
  */
 volatile uint8_t m_pwm_ready_counter[TIMER_COUNT][APP_PWM_CHANNELS_PER_INSTANCE];
 
+/**
+ * @brief Staged duty cycles
+ *
+ * Duty cycles (in ticks) set by @ref app_pwm_channel_duty_ticks_set_async, applied from the
+ * interrupt at the end of a PWM period when the instance is no longer busy, or NOT_STAGED.
+ */
+static volatile uint32_t m_pwm_staged_ticks[TIMER_COUNT][APP_PWM_CHANNELS_PER_INSTANCE];
+
 /**
  * @brief Pointers to instances
  *
@@ -186,6 +195,47 @@ __STATIC_INLINE void pwm_ppi_disable(app_pwm_t const * const p_instance)
 }
 
 
+/**
+ * @brief Function for applying the staged duty cycles that can be applied.
+ *
+ * Only one change can be in progress per instance, so the channels are updated in turn.
+ *
+ * @param[in] timer_instance_id     Timer index.
+ *
+ * @retval    true   If duty cycles are still staged.
+ * @retval    false  If all staged duty cycles were applied.
+ */
+static bool pwm_staged_apply(uint32_t timer_instance_id)
+{
+    app_pwm_t const * p_instance = m_instances[timer_instance_id];
+    bool              pending    = false;
+
+    for (uint8_t channel = 0; channel < APP_PWM_CHANNELS_PER_INSTANCE; ++channel)
+    {
+        uint32_t ticks = NOT_STAGED;
+
+        CRITICAL_REGION_ENTER();
+        if ((m_pwm_staged_ticks[timer_instance_id][channel] != NOT_STAGED) &&
+            !app_pwm_busy_check(p_instance))
+        {
+            ticks = m_pwm_staged_ticks[timer_instance_id][channel];
+            m_pwm_staged_ticks[timer_instance_id][channel] = NOT_STAGED;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (ticks != NOT_STAGED)
+        {
+            (void)app_pwm_channel_duty_ticks_set(p_instance, channel, (uint16_t)ticks);
+        }
+        if (m_pwm_staged_ticks[timer_instance_id][channel] != NOT_STAGED)
+        {
+            pending = true;
+        }
+    }
+    return pending;
+}
+
+
 /**
  * @brief This function is called on interrupt after duty set.
  *
@@ -213,6 +263,11 @@ void pwm_ready_tick(nrf_timer_event_t event_type, void * p_context)
             }
         }
     }
+
+    if (pwm_staged_apply(timer_instance_id))
+    {
+        disable = 0;
+    }
     
     if (disable)
     {
@@ -496,6 +551,8 @@ ret_code_t app_pwm_channel_duty_ticks_set(app_pwm_t const * const p_instance,
     {
         return NRF_ERROR_BUSY;  // PPI channels for synchronization are still in use.
     }
+    // A newer duty cycle replaces the staged one.
+    m_pwm_staged_ticks[p_instance->p_timer->instance_id][channel] = NOT_STAGED;
     
     m_pwm_busy[p_instance->p_timer->instance_id] = BUSY_STATE_CHANGING;
 
@@ -537,6 +594,27 @@ ret_code_t app_pwm_channel_duty_ticks_set(app_pwm_t const * const p_instance,
     return NRF_SUCCESS;
 }
 
+ret_code_t app_pwm_channel_duty_ticks_set_async(app_pwm_t const * const p_instance,
+                                                uint8_t           channel,
+                                                uint16_t          ticks)
+{
+    app_pwm_cb_t * p_cb = p_instance->p_cb;
+
+    ASSERT(channel < APP_PWM_CHANNELS_PER_INSTANCE);
+    ASSERT(p_cb->channels_cb[channel].initialized == APP_PWM_CHANNEL_INITIALIZED);
+
+    if (p_cb->state != NRF_DRV_STATE_POWERED_ON)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // The value is applied by pwm_ready_tick() at the end of the current period.
+    m_pwm_staged_ticks[p_instance->p_timer->instance_id][channel] = ticks;
+    pwm_irq_enable(p_instance);
+
+    return NRF_SUCCESS;
+}
+
 uint16_t app_pwm_channel_duty_ticks_get(app_pwm_t const * const p_instance, uint8_t channel)
 {
     app_pwm_cb_t         * p_cb      = p_instance->p_cb;
@@ -560,6 +638,14 @@ ret_code_t app_pwm_channel_duty_set(app_pwm_t const * const p_instance,
 }
 
 
+ret_code_t app_pwm_channel_duty_set_async(app_pwm_t const * const p_instance,
+                                          uint8_t channel, app_pwm_duty_t duty)
+{
+    uint32_t ticks = ((uint32_t)app_pwm_cycle_ticks_get(p_instance) * (uint32_t)duty) / 100UL;
+    return app_pwm_channel_duty_ticks_set_async(p_instance, channel, ticks);
+}
+
+
 app_pwm_duty_t app_pwm_channel_duty_get(app_pwm_t const * const p_instance, uint8_t channel)
 {
     uint32_t value = ((uint32_t)app_pwm_channel_duty_ticks_get(p_instance, channel) * 100UL) \
@@ -635,6 +721,7 @@ static ret_code_t app_pwm_channel_init(app_pwm_t const * const p_instance, uint8
 
     p_channel_cb->initialized = APP_PWM_CHANNEL_INITIALIZED;
     m_pwm_ready_counter[p_instance->p_timer->instance_id][channel] = 0;
+    m_pwm_staged_ticks[p_instance->p_timer->instance_id][channel] = NOT_STAGED;
 
     return NRF_SUCCESS;
 }
@@ -799,6 +886,7 @@ void app_pwm_enable(app_pwm_t const * const p_instance)
     {
         app_pwm_channel_cb_t * p_ch_cb = &p_cb->channels_cb[channel];
         m_pwm_ready_counter[p_instance->p_timer->instance_id][channel] = 0;
+        m_pwm_staged_ticks[p_instance->p_timer->instance_id][channel] = NOT_STAGED;
         if (p_ch_cb->initialized)
         {
             nrf_drv_gpiote_out_task_force(p_ch_cb->gpio_pin, POLARITY_INACTIVE(p_instance, channel));
@@ -236,6 +236,25 @@ ret_code_t app_pwm_channel_duty_set(app_pwm_t const * const p_instance,
  */
 app_pwm_duty_t app_pwm_channel_duty_get(app_pwm_t const * const p_instance, uint8_t channel);
 
+/**
+ * @brief Function for setting the PWM channel duty cycle in percents without waiting for the
+ *        previous change to finish.
+ *
+ * The new duty cycle is staged and applied from the timer interrupt at the end of a PWM period,
+ * once the changes in progress on the instance are complete. The change itself is then made
+ * in sync with the period by PPI, as with @ref app_pwm_channel_duty_set. A value staged again
+ * before it was applied replaces the previous one. If a ready callback was given to
+ * @ref app_pwm_init, it is called when the new duty cycle has taken effect.
+ *
+ * @param[in] p_instance  PWM instance.
+ * @param[in] channel     Channel number.
+ * @param[in] duty        Duty cycle (0 - 100).
+ * @retval    NRF_SUCCESS If the duty cycle was staged.
+ * @retval    NRF_ERROR_INVALID_STATE If the given instance was not enabled.
+ */
+ret_code_t app_pwm_channel_duty_set_async(app_pwm_t const * const p_instance,
+                                          uint8_t channel, app_pwm_duty_t duty);
+
 
 /**
  * @name Functions accessing values in ticks
@@ -279,6 +298,22 @@ app_pwm_duty_t app_pwm_channel_duty_get(app_pwm_t const * const p_instance, uint
      */
     uint16_t app_pwm_channel_duty_ticks_get(app_pwm_t const * const p_instance, uint8_t channel);
 
+    /**
+     * @brief Function for staging a PWM channel duty cycle in clock ticks.
+     *
+     * See @ref app_pwm_channel_duty_set_async.
+     *
+     * @param[in] p_instance  PWM instance.
+     * @param[in] channel     Channel number.
+     * @param[in] ticks       Number of PWM clock ticks.
+     *
+     * @retval    NRF_SUCCESS If the duty cycle was staged.
+     * @retval    NRF_ERROR_INVALID_STATE If the given instance was not enabled.
+     */
+    ret_code_t app_pwm_channel_duty_ticks_set_async(app_pwm_t const * const p_instance,
+                                                    uint8_t           channel,
+                                                    uint16_t          ticks);
+
     /**
      * @brief Function for returning the number of ticks in a whole cycle.
      *
@@ -14,29 +14,56 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "nrf.h"
 #include "nrf_soc.h"
 #include "nrf_assert.h"
 #include "app_util.h"
 #include "app_util_platform.h"
+#include "app_profiler.h"
+
+#if defined(APP_SCHEDULER_WITH_EXEC_PROFILER) && (__CORTEX_M < 3)
+#error "APP_SCHEDULER_WITH_EXEC_PROFILER requires the DWT cycle counter (Cortex-M3 or later)."
+#endif
+
+#if (__CORTEX_M >= 3)
+#define APP_SCHED_LOCK_FREE 1   /**< Claim queue entries with exclusive accesses instead of a critical region. */
+#else
+#define APP_SCHED_LOCK_FREE 0
+#endif
 
 /**@brief Structure for holding a scheduled event header. */
 typedef struct
 {
     app_sched_event_handler_t handler;          /**< Pointer to event handler to receive the event. */
     uint16_t                  event_data_size;  /**< Size of event data. */
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+    uint32_t                  put_cycles;       /**< Cycle counter value when the event was scheduled. */
+#endif
 } event_header_t;
 
 STATIC_ASSERT(sizeof(event_header_t) <= APP_SCHED_EVENT_HEADER_SIZE);
 
-static event_header_t * m_queue_event_headers;  /**< Array for holding the queue event headers. */
-static uint8_t        * m_queue_event_data;     /**< Array for holding the queue event data. */
-static volatile uint8_t m_queue_start_index;    /**< Index of queue entry at the start of the queue. */
-static volatile uint8_t m_queue_end_index;      /**< Index of queue entry at the end of the queue. */
+/**@brief Structure for holding the state of one event queue. */
+typedef struct
+{
+    event_header_t * p_event_headers;           /**< Array for holding the queue event headers. */
+    uint8_t        * p_event_data;              /**< Array for holding the queue event data. */
+    volatile uint8_t start_index;               /**< Index of queue entry at the start of the queue. */
+    volatile uint8_t end_index;                 /**< Index of queue entry at the end of the queue. */
+#ifdef APP_SCHEDULER_WITH_PROFILER
+    volatile uint16_t max_utilization;          /**< Maximum observed queue utilization. */
+    volatile uint8_t  executing;                /**< Non-zero while the first entry is being executed. */
+#endif
+} event_queue_t;
+
+static event_queue_t    m_queues[APP_SCHEDULER_PRIORITY_LEVELS]; /**< Event queues, in order of decreasing priority. */
 static uint16_t         m_queue_event_size;     /**< Maximum event size in queue. */
-static uint16_t         m_queue_size;           /**< Number of queue entries. */
+static uint16_t         m_queue_event_stride;   /**< Distance between the data of two queue entries (event size rounded up to a word). */
+static uint16_t         m_queue_size;           /**< Number of queue entries, minus one. */
 
-#ifdef APP_SCHEDULER_WITH_PROFILER
-static uint16_t m_max_queue_utilization;    /**< Maximum observed queue utilization. */
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+static app_sched_handler_profile_t m_handler_profiles[APP_SCHEDULER_PROFILER_HANDLERS]; /**< Execution statistics per event handler. */
+static uint32_t                    m_event_put_cycles;  /**< Cycle counter value when the event being executed was scheduled. */
 #endif
 
 /**@brief Function for incrementing a queue index, and handle wrap-around.
@@ -51,29 +78,34 @@ static __INLINE uint8_t next_index(uint8_t index)
 }
 
 
-static __INLINE uint8_t app_sched_queue_full()
+static __INLINE uint8_t app_sched_queue_full(event_queue_t const * p_queue)
 {
-  uint8_t tmp = m_queue_start_index;
-  return next_index(m_queue_end_index) == tmp;
+  uint8_t tmp = p_queue->start_index;
+  return next_index(p_queue->end_index) == tmp;
 }
 
 /**@brief Macro for checking if a queue is full. */
-#define APP_SCHED_QUEUE_FULL() app_sched_queue_full()
+#define APP_SCHED_QUEUE_FULL(p_queue) app_sched_queue_full(p_queue)
 
 
-static __INLINE uint8_t app_sched_queue_empty()
+static __INLINE uint8_t app_sched_queue_empty(event_queue_t const * p_queue)
 {
-  uint8_t tmp = m_queue_start_index;
-  return m_queue_end_index == tmp;
+  uint8_t tmp = p_queue->start_index;
+  return p_queue->end_index == tmp;
 }
 
 /**@brief Macro for checking if a queue is empty. */
-#define APP_SCHED_QUEUE_EMPTY() app_sched_queue_empty()
+#define APP_SCHED_QUEUE_EMPTY(p_queue) app_sched_queue_empty(p_queue)
 
 
 uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
 {
-    uint16_t data_start_index = (queue_size + 1) * sizeof(event_header_t);
+    // Besides the entry that is always kept free to tell a full queue from an empty one, each
+    // queue has an entry for the event being executed, whose data is used in place.
+    uint16_t entry_count  = queue_size + 2;
+    uint16_t headers_size = entry_count * sizeof(event_header_t);
+    uint16_t event_stride = CEIL_DIV(event_size, sizeof(uint32_t)) * sizeof(uint32_t);
+    uint8_t  priority;
 
     // Check that buffer is correctly aligned
     if (!is_word_aligned(p_event_buffer))
@@ -81,16 +113,34 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
         return NRF_ERROR_INVALID_PARAM;
     }
 
-    // Initialize event scheduler
-    m_queue_event_headers = p_event_buffer;
-    m_queue_event_data    = &((uint8_t *)p_event_buffer)[data_start_index];
-    m_queue_end_index     = 0;
-    m_queue_start_index   = 0;
-    m_queue_event_size    = event_size;
-    m_queue_size          = queue_size;
+    // Initialize event scheduler. The headers of all queues are placed first to keep them aligned,
+    // followed by the event data of all queues.
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        event_queue_t * p_queue = &m_queues[priority];
 
+        p_queue->p_event_headers = (event_header_t *)&((uint8_t *)p_event_buffer)[priority * headers_size];
+        p_queue->p_event_data    = &((uint8_t *)p_event_buffer)[APP_SCHEDULER_PRIORITY_LEVELS * headers_size +
+                                                                priority * entry_count * event_stride];
+        p_queue->end_index       = 0;
+        p_queue->start_index     = 0;
 #ifdef APP_SCHEDULER_WITH_PROFILER
-    m_max_queue_utilization = 0;
+        p_queue->max_utilization = 0;
+        p_queue->executing       = 0;
+#endif
+
+        // No entry is committed.
+        memset(p_queue->p_event_headers, 0, headers_size);
+    }
+    m_queue_event_size   = event_size;
+    m_queue_event_stride = event_stride;
+    m_queue_size         = entry_count - 1;
+
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+    memset(m_handler_profiles, 0, sizeof(m_handler_profiles));
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
 #endif
 
     return NRF_SUCCESS;
@@ -98,68 +148,237 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
 
 
 #ifdef APP_SCHEDULER_WITH_PROFILER
-static void queue_utilization_check(void)
+static void queue_utilization_check(event_queue_t * p_queue)
 {
-    uint16_t start = m_queue_start_index;
-    uint16_t end   = m_queue_end_index;
+    uint16_t start = p_queue->start_index;
+    uint16_t end   = p_queue->end_index;
     uint16_t queue_utilization = (end >= start) ? (end - start) :
         (m_queue_size + 1 - start + end);
 
-    if (queue_utilization > m_max_queue_utilization)
+    // The event being executed has an entry of its own.
+    if (p_queue->executing && (queue_utilization > 0))
+    {
+        queue_utilization--;
+    }
+
+#if APP_SCHED_LOCK_FREE
+    uint16_t max_utilization;
+
+    do
+    {
+        max_utilization = __LDREXH(&p_queue->max_utilization);
+        if (queue_utilization <= max_utilization)
+        {
+            __CLREX();
+            break;
+        }
+    } while (__STREXH(queue_utilization, &p_queue->max_utilization) != 0);
+#else
+    if (queue_utilization > p_queue->max_utilization)
     {
-        m_max_queue_utilization = queue_utilization;
+        p_queue->max_utilization = queue_utilization;
     }
+#endif
 }
 
 uint16_t app_sched_queue_utilization_get(void)
 {
-    return m_max_queue_utilization;
+    uint16_t max_utilization = 0;
+    uint8_t  priority;
+
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        if (m_queues[priority].max_utilization > max_utilization)
+        {
+            max_utilization = m_queues[priority].max_utilization;
+        }
+    }
+
+    return max_utilization;
+}
+
+uint16_t app_sched_queue_utilization_prio_get(uint8_t priority)
+{
+    return (priority < APP_SCHEDULER_PRIORITY_LEVELS) ? m_queues[priority].max_utilization : 0;
 }
 #endif
 
 
-uint32_t app_sched_event_put(void                    * p_event_data,
-                             uint16_t                  event_data_size,
-                             app_sched_event_handler_t handler)
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+/**@brief Function for recording the execution of an event handler.
+ *
+ * @details Handlers are assigned a profile entry on their first execution. Handlers executed after
+ *          all entries are taken are not recorded.
+ *
+ * @param[in]   handler   Event handler that was executed.
+ * @param[in]   latency   Number of cycles from scheduling to start of execution.
+ * @param[in]   cycles    Number of cycles spent in the handler.
+ */
+static void handler_profile_update(app_sched_event_handler_t handler,
+                                   uint32_t                  latency,
+                                   uint32_t                  cycles)
 {
-    uint32_t err_code;
+    uint8_t i;
 
-    if (event_data_size <= m_queue_event_size)
+    for (i = 0; i < APP_SCHEDULER_PROFILER_HANDLERS; i++)
     {
-        uint16_t event_index = 0xFFFF;
+        app_sched_handler_profile_t * p_profile = &m_handler_profiles[i];
 
-        CRITICAL_REGION_ENTER();
+        if (p_profile->handler == NULL)
+        {
+            p_profile->handler = handler;
+        }
 
-        if (!APP_SCHED_QUEUE_FULL())
+        if (p_profile->handler == handler)
         {
-            event_index       = m_queue_end_index;
-            m_queue_end_index = next_index(m_queue_end_index);
+            p_profile->exec_count++;
+            p_profile->cycles_total += cycles;
+            if (cycles > p_profile->cycles_max)
+            {
+                p_profile->cycles_max = cycles;
+            }
+            if (latency > p_profile->latency_max)
+            {
+                p_profile->latency_max = latency;
+            }
+            break;
+        }
+    }
+}
 
-        #ifdef APP_SCHEDULER_WITH_PROFILER
-            // This function call must be protected with critical region because
-            // it modifies 'm_max_queue_utilization'.
-            queue_utilization_check();
-        #endif
+
+uint32_t app_sched_handler_profile_get(uint8_t index, app_sched_handler_profile_t * p_profile)
+{
+    if (p_profile == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if ((index >= APP_SCHEDULER_PROFILER_HANDLERS) || (m_handler_profiles[index].handler == NULL))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_profile = m_handler_profiles[index];
+
+    return NRF_SUCCESS;
+}
+#endif
+
+
+/**@brief Function for claiming the entry at the end of an event queue.
+ *
+ * @details Free entries are not committed (no handler), as @ref event_release clears the handler
+ *          before an entry can be claimed again. The claimed entry will therefore not be executed
+ *          before the producer has finished writing it.
+ *
+ *          On Cortex-M3 and later, the end index is advanced with an exclusive load/store pair,
+ *          retried if another producer interrupted in between. Producers at any interrupt level
+ *          can then claim entries without disabling interrupts.
+ *
+ * @param[in]   p_queue           Queue to claim the entry in.
+ * @param[in]   event_data_size   Size of event data to be stored in the entry.
+ *
+ * @return      Index of the claimed entry, or 0xFFFF if the queue is full.
+ */
+static uint16_t event_slot_alloc(event_queue_t * p_queue, uint16_t event_data_size)
+{
+    uint16_t event_index = 0xFFFF;
+
+#if APP_SCHED_LOCK_FREE
+    uint8_t end_index;
+
+    do
+    {
+        end_index = __LDREXB(&p_queue->end_index);
+        if (next_index(end_index) == p_queue->start_index)
+        {
+            // Queue is full.
+            __CLREX();
+            return 0xFFFF;
+        }
+    } while (__STREXB(next_index(end_index), &p_queue->end_index) != 0);
+
+    event_index = end_index;
+
+    p_queue->p_event_headers[event_index].event_data_size = event_data_size;
+
+#ifdef APP_SCHEDULER_WITH_PROFILER
+    queue_utilization_check(p_queue);
+#endif
+#else
+    CRITICAL_REGION_ENTER();
+
+    if (!APP_SCHED_QUEUE_FULL(p_queue))
+    {
+        event_index        = p_queue->end_index;
+        p_queue->end_index = next_index(p_queue->end_index);
+
+        p_queue->p_event_headers[event_index].event_data_size = event_data_size;
+
+    #ifdef APP_SCHEDULER_WITH_PROFILER
+        // This function call must be protected with critical region because
+        // it modifies the maximum queue utilization.
+        queue_utilization_check(p_queue);
+    #endif
+    }
+
+    CRITICAL_REGION_EXIT();
+#endif
+
+    return event_index;
+}
+
+
+/**@brief Function for making a claimed queue entry available for execution.
+ *
+ * @param[in]   p_event_header   Header of the claimed entry.
+ * @param[in]   handler          Event handler to receive the event.
+ */
+static __INLINE void event_slot_commit(event_header_t * p_event_header,
+                                       app_sched_event_handler_t handler)
+{
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+    p_event_header->put_cycles = DWT->CYCCNT;
+#endif
+    p_event_header->handler = handler;
+}
+
+
+uint32_t app_sched_event_put_prio(void                    * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    uint32_t err_code;
+
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
+    {
+        err_code = NRF_ERROR_INVALID_PARAM;
+    }
+    else if (event_data_size <= m_queue_event_size)
+    {
+        event_queue_t * p_queue = &m_queues[priority];
+        uint16_t        event_index;
+
+        if ((p_event_data == NULL) || (event_data_size == 0))
+        {
+            event_data_size = 0;
         }
 
-        CRITICAL_REGION_EXIT();
+        event_index = event_slot_alloc(p_queue, event_data_size);
 
         if (event_index != 0xFFFF)
         {
             // NOTE: This can be done outside the critical region since the event consumer will
             //       always be called from the main loop, and will thus never interrupt this code.
-            m_queue_event_headers[event_index].handler = handler;
-            if ((p_event_data != NULL) && (event_data_size > 0))
+            if (event_data_size > 0)
             {
-                memcpy(&m_queue_event_data[event_index * m_queue_event_size],
+                memcpy(&p_queue->p_event_data[event_index * m_queue_event_stride],
                        p_event_data,
                        event_data_size);
-                m_queue_event_headers[event_index].event_data_size = event_data_size;
-            }
-            else
-            {
-                m_queue_event_headers[event_index].event_data_size = 0;
             }
+            event_slot_commit(&p_queue->p_event_headers[event_index], handler);
 
             err_code = NRF_SUCCESS;
         }
@@ -177,39 +396,171 @@ uint32_t app_sched_event_put(void                    * p_event_data,
 }
 
 
-/**@brief Function for reading the next event from specified event queue.
+uint32_t app_sched_event_put(void                    * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+{
+    return app_sched_event_put_prio(p_event_data,
+                                    event_data_size,
+                                    handler,
+                                    APP_SCHED_PRIORITY_DEFAULT);
+}
+
+
+uint32_t app_sched_event_alloc_prio(uint16_t event_data_size,
+                                    void **  pp_event_data,
+                                    uint8_t  priority)
+{
+    event_queue_t * p_queue;
+    uint16_t        event_index;
+
+    if (pp_event_data == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (event_data_size > m_queue_event_size)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_queue     = &m_queues[priority];
+    event_index = event_slot_alloc(p_queue, event_data_size);
+
+    if (event_index == 0xFFFF)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    *pp_event_data = &p_queue->p_event_data[event_index * m_queue_event_stride];
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_sched_event_alloc(uint16_t event_data_size, void ** pp_event_data)
+{
+    return app_sched_event_alloc_prio(event_data_size, pp_event_data, APP_SCHED_PRIORITY_DEFAULT);
+}
+
+
+uint32_t app_sched_event_commit(void * p_event_data, app_sched_event_handler_t handler)
+{
+    uint8_t priority;
+
+    if (handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    // Find the queue entry from the address of its data.
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        event_queue_t * p_queue = &m_queues[priority];
+        uint32_t        offset  = (uint8_t *)p_event_data - p_queue->p_event_data;
+
+        if ((uint8_t *)p_event_data < p_queue->p_event_data)
+        {
+            continue;
+        }
+
+        if ((m_queue_event_stride != 0) &&
+            (offset < (m_queue_size + 1) * m_queue_event_stride) &&
+            ((offset % m_queue_event_stride) == 0))
+        {
+            event_header_t * p_event_header = &p_queue->p_event_headers[offset / m_queue_event_stride];
+
+            if (p_event_header->handler != NULL)
+            {
+                return NRF_ERROR_INVALID_STATE;
+            }
+
+            event_slot_commit(p_event_header, handler);
+
+            return NRF_SUCCESS;
+        }
+    }
+
+    return NRF_ERROR_INVALID_ADDR;
+}
+
+
+/**@brief Function for finding the next event to execute.
+ *
+ * @details The event is taken from the highest priority queue whose first entry has been
+ *          committed. The entry is not released before @ref event_release is called, so the event
+ *          data can be used in place while the handler executes.
  *
  * @param[out]  pp_event_data       Pointer to pointer to event data.
  * @param[out]  p_event_data_size   Pointer to size of event data.
  * @param[out]  p_event_handler     Pointer to event handler function pointer.
  *
- * @return      NRF_SUCCESS if new event, NRF_ERROR_NOT_FOUND if event queue is empty.
+ * @return      Queue holding the event, or NULL if there is no event to execute.
  */
-static uint32_t app_sched_event_get(void                     ** pp_event_data,
-                                    uint16_t *                  p_event_data_size,
-                                    app_sched_event_handler_t * p_event_handler)
+static event_queue_t * app_sched_event_get(void                     ** pp_event_data,
+                                           uint16_t *                  p_event_data_size,
+                                           app_sched_event_handler_t * p_event_handler)
 {
-    uint32_t err_code = NRF_ERROR_NOT_FOUND;
+    uint8_t priority;
 
-    if (!APP_SCHED_QUEUE_EMPTY())
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
     {
-        uint16_t event_index;
+        event_queue_t * p_queue = &m_queues[priority];
+
+        // NOTE: There is no need for a critical region here, as this function will only be
+        //       called from app_sched_execute() from inside the main loop, so it will never
+        //       interrupt app_sched_event_put().
+        if (!APP_SCHED_QUEUE_EMPTY(p_queue))
+        {
+            uint16_t         event_index    = p_queue->start_index;
+            event_header_t * p_event_header = &p_queue->p_event_headers[event_index];
 
-        // NOTE: There is no need for a critical region here, as this function will only be called
-        //       from app_sched_execute() from inside the main loop, so it will never interrupt
-        //       app_sched_event_put(). Also, updating of (i.e. writing to) the start index will be
-        //       an atomic operation.
-        event_index         = m_queue_start_index;
-        m_queue_start_index = next_index(m_queue_start_index);
+            if (p_event_header->handler == NULL)
+            {
+                // Entry allocated but not committed yet.
+                continue;
+            }
 
-        *pp_event_data     = &m_queue_event_data[event_index * m_queue_event_size];
-        *p_event_data_size = m_queue_event_headers[event_index].event_data_size;
-        *p_event_handler   = m_queue_event_headers[event_index].handler;
+            *pp_event_data     = &p_queue->p_event_data[event_index * m_queue_event_stride];
+            *p_event_data_size = p_event_header->event_data_size;
+            *p_event_handler   = p_event_header->handler;
+        #ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+            m_event_put_cycles = p_event_header->put_cycles;
+        #endif
 
-        err_code = NRF_SUCCESS;
+            return p_queue;
+        }
     }
 
-    return err_code;
+    return NULL;
+}
+
+
+/**@brief Function for releasing the first entry of a queue after its event has been executed.
+ *
+ * @details The handler is cleared before the entry is released, so a producer which claims the
+ *          entry, and is preempted before committing it, never leaves a stale handler behind.
+ *          Updating of (i.e. writing to) the start index is an atomic operation. The queue has an
+ *          extra entry for the executed event, so holding it until now does not reduce the number
+ *          of events that can be put while the handler runs.
+ *
+ * @param[in]   p_queue   Queue holding the executed event.
+ */
+static __INLINE void event_release(event_queue_t * p_queue)
+{
+    p_queue->p_event_headers[p_queue->start_index].handler = NULL;
+
+    // The entry must not become claimable before the cleared handler is visible.
+    __DMB();
+
+    p_queue->start_index = next_index(p_queue->start_index);
+
+#ifdef APP_SCHEDULER_WITH_PROFILER
+    p_queue->executing = 0;
+#endif
 }
 
 
@@ -218,10 +569,30 @@ void app_sched_execute(void)
     void                    * p_event_data;
     uint16_t                  event_data_size;
     app_sched_event_handler_t event_handler;
+    event_queue_t           * p_queue;
 
-    // Get next event (if any), and execute handler
-    while ((app_sched_event_get(&p_event_data, &event_data_size, &event_handler) == NRF_SUCCESS))
+    // Get next event (if any), and execute handler. Higher priority queues are checked again
+    // after every event.
+    while ((p_queue = app_sched_event_get(&p_event_data, &event_data_size, &event_handler)) != NULL)
     {
+        PROFILE_BEGIN(APP_PROFILER_ID_SCHED_EVT);
+
+#ifdef APP_SCHEDULER_WITH_PROFILER
+        p_queue->executing = 1;
+#endif
+
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+        uint32_t start_cycles = DWT->CYCCNT;
+        uint32_t latency      = start_cycles - m_event_put_cycles;
+
+        event_handler(p_event_data, event_data_size);
+
+        handler_profile_update(event_handler, latency, DWT->CYCCNT - start_cycles);
+#else
         event_handler(p_event_data, event_data_size);
+#endif
+
+        PROFILE_END(APP_PROFILER_ID_SCHED_EVT);
+        event_release(p_queue);
     }
 }
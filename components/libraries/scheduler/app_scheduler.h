@@ -38,6 +38,26 @@
  *     with the appropriate data and event handler. This will insert an event into the
  *     scheduler's queue. The app_sched_execute() function will pull this event and call its
  *     handler in the main context.
+ *   - To avoid copying the event data, call app_sched_event_alloc() instead, write the event
+ *     data directly into the returned queue entry, and call app_sched_event_commit().
+ *   - On Cortex-M3 and later (nRF52), queue entries are claimed with exclusive load/store
+ *     instructions, so putting an event does not disable interrupts. On Cortex-M0 (nRF51), a
+ *     critical region is used.
+ *
+ * @subsection app_scheduler_prio Priorities:
+ *
+ *   Define APP_SCHEDULER_PRIORITY_LEVELS to have several event queues. Each level has its own
+ *   queue of QUEUE_SIZE entries, which is selected by passing a priority to
+ *   app_sched_event_put_prio(). app_sched_execute() always executes the oldest event of the
+ *   highest priority (lowest number) non-empty queue, so a slow handler only delays events of its
+ *   own and lower priorities. app_sched_event_put() uses the lowest priority.
+ *
+ * @subsection app_scheduler_profiling Profiling:
+ *
+ *   Define APP_SCHEDULER_WITH_PROFILER to record the maximum utilization of each queue. Define
+ *   APP_SCHEDULER_WITH_EXEC_PROFILER (Cortex-M3 or later) to also record, for each event handler,
+ *   the number of executions, the cycles spent in it and the maximum number of cycles an event
+ *   waited in the queue before execution.
  *
  * @if (PERIPHERAL)
  * For an example usage of the scheduler, see the implementations of
@@ -54,22 +74,54 @@
 #include "app_error.h"
 #include "app_util.h"
 
-#define APP_SCHED_EVENT_HEADER_SIZE 8       /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
+#ifndef APP_SCHEDULER_PRIORITY_LEVELS
+#define APP_SCHEDULER_PRIORITY_LEVELS 1     /**< Number of event queue priority levels. */
+#endif
+
+#define APP_SCHED_PRIORITY_HIGHEST  0                                   /**< Highest event priority. */
+#define APP_SCHED_PRIORITY_DEFAULT  (APP_SCHEDULER_PRIORITY_LEVELS - 1) /**< Priority of events scheduled with app_sched_event_put(). */
+
+#ifndef APP_SCHEDULER_PROFILER_HANDLERS
+#define APP_SCHEDULER_PROFILER_HANDLERS 8   /**< Number of event handlers that APP_SCHEDULER_WITH_EXEC_PROFILER keeps statistics for. */
+#endif
+
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+#define APP_SCHED_EVENT_HEADER_SIZE (sizeof(void *) + 8)   /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). 12 bytes on the target, which has 32-bit pointers. */
+#else
+#define APP_SCHED_EVENT_HEADER_SIZE (2 * sizeof(void *))    /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). 8 bytes on the target. */
+#endif
 
 /**@brief Compute number of bytes required to hold the scheduler buffer.
+ *
+ * @details Each queue has two entries more than QUEUE_SIZE: one that is always kept free, and one
+ *          that holds the event being executed, as its data is passed to the handler in place.
  *
  * @param[in] EVENT_SIZE   Maximum size of events to be passed through the scheduler.
  * @param[in] QUEUE_SIZE   Number of entries in scheduler queue (i.e. the maximum number of events
- *                         that can be scheduled for execution).
+ *                         that can be scheduled for execution), per priority level.
  *
  * @return    Required scheduler buffer size (in bytes).
  */
 #define APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE)                                                 \
-            (((EVENT_SIZE) + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 1))
+            (((CEIL_DIV((EVENT_SIZE), sizeof(uint32_t)) * sizeof(uint32_t))                        \
+              + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 2)                                  \
+             * APP_SCHEDULER_PRIORITY_LEVELS)
             
 /**@brief Scheduler event handler type. */
 typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_size);
 
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+/**@brief Execution statistics of one event handler. */
+typedef struct
+{
+    app_sched_event_handler_t handler;          /**< Event handler the statistics are for. */
+    uint32_t                  exec_count;       /**< Number of times the handler was executed. */
+    uint32_t                  cycles_total;     /**< Total number of CPU cycles spent in the handler. */
+    uint32_t                  cycles_max;       /**< Maximum number of CPU cycles spent in one execution. */
+    uint32_t                  latency_max;      /**< Maximum number of CPU cycles from scheduling an event to executing it. */
+} app_sched_handler_profile_t;
+#endif
+
 /**@brief Macro for initializing the event scheduler.
  *
  * @details It will also handle dimensioning and allocation of the memory buffer required by the
@@ -132,6 +184,72 @@ uint32_t app_sched_event_put(void *                    p_event_data,
                              uint16_t                  event_size,
                              app_sched_event_handler_t handler);
 
+/**@brief Function for scheduling an event with a given priority.
+ *
+ * @details Puts an event into the event queue of the given priority level.
+ *
+ * @param[in]   p_event_data   Pointer to event data to be scheduled.
+ * @param[in]   event_size     Size of event data to be scheduled.
+ * @param[in]   handler        Event handler to receive the event.
+ * @param[in]   priority       Priority of the event, from APP_SCHED_PRIORITY_HIGHEST to
+ *                             APP_SCHEDULER_PRIORITY_LEVELS - 1.
+ *
+ * @retval      NRF_SUCCESS               If the event was scheduled.
+ * @retval      NRF_ERROR_INVALID_PARAM   If the priority is out of range.
+ * @retval      NRF_ERROR_INVALID_LENGTH  If the event is larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM          If the queue of the priority level is full.
+ */
+uint32_t app_sched_event_put_prio(void *                    p_event_data,
+                                  uint16_t                  event_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority);
+
+/**@brief Function for allocating an event in the event queue, to be filled in place.
+ *
+ * @details The returned entry is word aligned and holds up to event_size bytes. It is not
+ *          executed before it has been passed to @ref app_sched_event_commit. Events queued after
+ *          it at the same priority are held back until then, so the commit should follow soon
+ *          after the allocation, in the same context.
+ *
+ * @param[in]   event_size      Size of event data to be scheduled.
+ * @param[out]  pp_event_data   Pointer to the event data in the queue entry.
+ *
+ * @retval      NRF_SUCCESS               If the entry was allocated.
+ * @retval      NRF_ERROR_NULL            If pp_event_data is NULL.
+ * @retval      NRF_ERROR_INVALID_LENGTH  If the event is larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM          If the queue is full.
+ */
+uint32_t app_sched_event_alloc(uint16_t event_size, void ** pp_event_data);
+
+/**@brief Function for allocating an event with a given priority, to be filled in place.
+ *
+ * @details See @ref app_sched_event_alloc.
+ *
+ * @param[in]   event_size      Size of event data to be scheduled.
+ * @param[out]  pp_event_data   Pointer to the event data in the queue entry.
+ * @param[in]   priority        Priority of the event, from APP_SCHED_PRIORITY_HIGHEST to
+ *                              APP_SCHEDULER_PRIORITY_LEVELS - 1.
+ *
+ * @retval      NRF_SUCCESS               If the entry was allocated.
+ * @retval      NRF_ERROR_NULL            If pp_event_data is NULL.
+ * @retval      NRF_ERROR_INVALID_PARAM   If the priority is out of range.
+ * @retval      NRF_ERROR_INVALID_LENGTH  If the event is larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM          If the queue of the priority level is full.
+ */
+uint32_t app_sched_event_alloc_prio(uint16_t event_size, void ** pp_event_data, uint8_t priority);
+
+/**@brief Function for scheduling an event allocated with @ref app_sched_event_alloc.
+ *
+ * @param[in]   p_event_data   Event data pointer returned by the allocation.
+ * @param[in]   handler        Event handler to receive the event.
+ *
+ * @retval      NRF_SUCCESS               If the event was scheduled.
+ * @retval      NRF_ERROR_NULL            If handler is NULL.
+ * @retval      NRF_ERROR_INVALID_ADDR    If p_event_data is not an allocated queue entry.
+ * @retval      NRF_ERROR_INVALID_STATE   If the event has already been committed.
+ */
+uint32_t app_sched_event_commit(void * p_event_data, app_sched_event_handler_t handler);
+
 #ifdef APP_SCHEDULER_WITH_PROFILER
 /**@brief Function for getting the maximum observed queue utilization.
  *
@@ -140,6 +258,29 @@ uint32_t app_sched_event_put(void *                    p_event_data,
  * @return Maximum number of events in queue observed so far.
  */
 uint16_t app_sched_queue_utilization_get(void);
+
+/**@brief Function for getting the maximum observed utilization of the queue of one priority level.
+ *
+ * @param[in]   priority   Priority level of the queue.
+ *
+ * @return Maximum number of events in the queue observed so far.
+ */
+uint16_t app_sched_queue_utilization_prio_get(uint8_t priority);
+#endif
+
+#ifdef APP_SCHEDULER_WITH_EXEC_PROFILER
+/**@brief Function for getting the execution statistics of an event handler.
+ *
+ * @details Handlers are numbered in the order of their first execution.
+ *
+ * @param[in]   index       Index of the handler, from 0 to APP_SCHEDULER_PROFILER_HANDLERS - 1.
+ * @param[out]  p_profile   Statistics of the handler.
+ *
+ * @retval      NRF_SUCCESS           If the statistics were copied.
+ * @retval      NRF_ERROR_NULL        If p_profile is NULL.
+ * @retval      NRF_ERROR_NOT_FOUND   If no handler has been recorded with this index.
+ */
+uint32_t app_sched_handler_profile_get(uint8_t index, app_sched_handler_profile_t * p_profile);
 #endif
 
 #ifdef APP_SCHEDULER_WITH_PAUSE
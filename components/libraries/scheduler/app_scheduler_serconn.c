@@ -18,6 +18,7 @@
 #include "nrf_assert.h"
 #include "app_util.h"
 #include "app_util_platform.h"
+#include "app_profiler.h"
 
 /**@brief Structure for holding a scheduled event header. */
 typedef struct
@@ -28,16 +29,22 @@ typedef struct
 
 STATIC_ASSERT(sizeof (event_header_t) <= APP_SCHED_EVENT_HEADER_SIZE);
 
-static event_header_t * m_queue_event_headers; /**< Array for holding the queue event headers. */
-static uint8_t *        m_queue_event_data;    /**< Array for holding the queue event data. */
-static volatile uint8_t m_queue_start_index;   /**< Index of queue entry at the start of the queue. */
-static volatile uint8_t m_queue_end_index;     /**< Index of queue entry at the end of the queue. */
-static uint16_t         m_queue_event_size;    /**< Maximum event size in queue. */
-static uint16_t         m_queue_size;          /**< Number of queue entries. */
-
+/**@brief Structure for holding the state of one event queue. */
+typedef struct
+{
+    event_header_t * p_event_headers;           /**< Array for holding the queue event headers. */
+    uint8_t        * p_event_data;              /**< Array for holding the queue event data. */
+    volatile uint8_t start_index;               /**< Index of queue entry at the start of the queue. */
+    volatile uint8_t end_index;                 /**< Index of queue entry at the end of the queue. */
 #ifdef APP_SCHEDULER_WITH_PROFILER
-static uint16_t m_max_queue_utilization;    /**< Maximum observed queue utilization. */
+    uint16_t         max_utilization;           /**< Maximum observed queue utilization. */
 #endif
+} event_queue_t;
+
+static event_queue_t    m_queues[APP_SCHEDULER_PRIORITY_LEVELS]; /**< Event queues, in order of decreasing priority. */
+static uint16_t         m_queue_event_size;     /**< Maximum event size in queue. */
+static uint16_t         m_queue_event_stride;   /**< Distance between the data of two queue entries (event size rounded up to a word). */
+static uint16_t         m_queue_size;           /**< Number of queue entries. */
 
 static uint32_t m_scheduler_paused_counter = 0; /**< Counter storing the difference between pausing
                                                      and resuming the scheduler. */
@@ -53,28 +60,30 @@ static __INLINE uint8_t next_index(uint8_t index)
     return (index < m_queue_size) ? (index + 1) : 0;
 }
 
-static __INLINE uint8_t app_sched_queue_full(void)
+static __INLINE uint8_t app_sched_queue_full(event_queue_t const * p_queue)
 {
-  uint8_t tmp = m_queue_start_index;
-  return next_index(m_queue_end_index) == tmp;
+  uint8_t tmp = p_queue->start_index;
+  return next_index(p_queue->end_index) == tmp;
 }
 
 /**@brief Macro for checking if a queue is full. */
-#define APP_SCHED_QUEUE_FULL() app_sched_queue_full()
+#define APP_SCHED_QUEUE_FULL(p_queue) app_sched_queue_full(p_queue)
 
-static __INLINE uint8_t app_sched_queue_empty(void)
+static __INLINE uint8_t app_sched_queue_empty(event_queue_t const * p_queue)
 {
-  uint8_t tmp = m_queue_start_index;
-  return m_queue_end_index == tmp;
+  uint8_t tmp = p_queue->start_index;
+  return p_queue->end_index == tmp;
 }
 
 /**@brief Macro for checking if a queue is empty. */
-#define APP_SCHED_QUEUE_EMPTY() app_sched_queue_empty()
+#define APP_SCHED_QUEUE_EMPTY(p_queue) app_sched_queue_empty(p_queue)
 
 
 uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
 {
-    uint16_t data_start_index = (queue_size + 1) * sizeof (event_header_t);
+    uint16_t headers_size = (queue_size + 1) * sizeof (event_header_t);
+    uint16_t event_stride = CEIL_DIV(event_size, sizeof (uint32_t)) * sizeof (uint32_t);
+    uint8_t  priority;
 
     //Check that buffer is correctly aligned
     if (!is_word_aligned(p_event_buffer))
@@ -82,39 +91,62 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
         return NRF_ERROR_INVALID_PARAM;
     }
 
-    //Initialize event scheduler
-    m_queue_event_headers = p_event_buffer;
-    m_queue_event_data    = &((uint8_t *)p_event_buffer)[data_start_index];
-    m_queue_end_index     = 0;
-    m_queue_start_index   = 0;
-    m_queue_event_size    = event_size;
-    m_queue_size          = queue_size;
+    //Initialize event scheduler. The headers of all queues are placed first, followed by the
+    //event data of all queues.
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        event_queue_t * p_queue = &m_queues[priority];
 
+        p_queue->p_event_headers = (event_header_t *)&((uint8_t *)p_event_buffer)[priority * headers_size];
+        p_queue->p_event_data    = &((uint8_t *)p_event_buffer)[APP_SCHEDULER_PRIORITY_LEVELS * headers_size +
+                                                                priority * (queue_size + 1) * event_stride];
+        p_queue->end_index       = 0;
+        p_queue->start_index     = 0;
 #ifdef APP_SCHEDULER_WITH_PROFILER
-    m_max_queue_utilization = 0;
+        p_queue->max_utilization = 0;
 #endif
+    }
+    m_queue_event_size   = event_size;
+    m_queue_event_stride = event_stride;
+    m_queue_size         = queue_size;
 
     return NRF_SUCCESS;
 }
 
 
 #ifdef APP_SCHEDULER_WITH_PROFILER
-static void check_queue_utilization(void)
+static void check_queue_utilization(event_queue_t * p_queue)
 {
-    uint16_t start = m_queue_start_index;
-    uint16_t end   = m_queue_end_index;
+    uint16_t start = p_queue->start_index;
+    uint16_t end   = p_queue->end_index;
     uint16_t queue_utilization = (end >= start) ? (end - start) :
         (m_queue_size + 1 - start + end);
 
-    if (queue_utilization > m_max_queue_utilization)
+    if (queue_utilization > p_queue->max_utilization)
     {
-        m_max_queue_utilization = queue_utilization;
+        p_queue->max_utilization = queue_utilization;
     }
 }
 
 uint16_t app_sched_queue_utilization_get(void)
 {
-    return m_max_queue_utilization;
+    uint16_t max_utilization = 0;
+    uint8_t  priority;
+
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        if (m_queues[priority].max_utilization > max_utilization)
+        {
+            max_utilization = m_queues[priority].max_utilization;
+        }
+    }
+
+    return max_utilization;
+}
+
+uint16_t app_sched_queue_utilization_prio_get(uint8_t priority)
+{
+    return (priority < APP_SCHEDULER_PRIORITY_LEVELS) ? m_queues[priority].max_utilization : 0;
 }
 #endif
 
@@ -123,7 +155,24 @@ uint32_t app_sched_event_put(void *                    p_event_data,
                              uint16_t                  event_data_size,
                              app_sched_event_handler_t handler)
 {
-    uint32_t err_code;
+    return app_sched_event_put_prio(p_event_data, event_data_size, handler,
+                                    APP_SCHED_PRIORITY_DEFAULT);
+}
+
+
+uint32_t app_sched_event_put_prio(void *                    p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    uint32_t        err_code;
+    event_queue_t * p_queue;
+
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    p_queue = &m_queues[priority];
 
     if (event_data_size <= m_queue_event_size)
     {
@@ -131,10 +180,10 @@ uint32_t app_sched_event_put(void *                    p_event_data,
 
         CRITICAL_REGION_ENTER();
 
-        if (!APP_SCHED_QUEUE_FULL())
+        if (!APP_SCHED_QUEUE_FULL(p_queue))
         {
-            event_index       = m_queue_end_index;
-            m_queue_end_index = next_index(m_queue_end_index);
+            event_index         = p_queue->end_index;
+            p_queue->end_index  = next_index(p_queue->end_index);
         }
 
         CRITICAL_REGION_EXIT();
@@ -143,22 +192,22 @@ uint32_t app_sched_event_put(void *                    p_event_data,
         {
             //NOTE: This can be done outside the critical region since the event consumer will
             //always be called from the main loop, and will thus never interrupt this code.
-            m_queue_event_headers[event_index].handler = handler;
+            p_queue->p_event_headers[event_index].handler = handler;
 
             if ((p_event_data != NULL) && (event_data_size > 0))
             {
-                memcpy(&m_queue_event_data[event_index * m_queue_event_size],
+                memcpy(&p_queue->p_event_data[event_index * m_queue_event_stride],
                        p_event_data,
                        event_data_size);
-                m_queue_event_headers[event_index].event_data_size = event_data_size;
+                p_queue->p_event_headers[event_index].event_data_size = event_data_size;
             }
             else
             {
-                m_queue_event_headers[event_index].event_data_size = 0;
+                p_queue->p_event_headers[event_index].event_data_size = 0;
             }
 
         #ifdef APP_SCHEDULER_WITH_PROFILER
-            check_queue_utilization();
+            check_queue_utilization(p_queue);
         #endif
 
             err_code = NRF_SUCCESS;
@@ -177,39 +226,44 @@ uint32_t app_sched_event_put(void *                    p_event_data,
 }
 
 
-/**@brief Function for reading the next event from specified event queue.
+/**@brief Function for reading the next event from the highest priority non-empty event queue.
  *
  * @param[out]  pp_event_data       Pointer to pointer to event data.
  * @param[out]  p_event_data_size   Pointer to size of event data.
  * @param[out]  p_event_handler     Pointer to event handler function pointer.
  *
- * @return      NRF_SUCCESS if new event, NRF_ERROR_NOT_FOUND if event queue is empty.
+ * @return      NRF_SUCCESS if new event, NRF_ERROR_NOT_FOUND if all event queues are empty.
  */
 static uint32_t app_sched_event_get(void * *                    pp_event_data,
                                     uint16_t *                  p_event_data_size,
                                     app_sched_event_handler_t * p_event_handler)
 {
-    uint32_t err_code = NRF_ERROR_NOT_FOUND;
+    uint8_t priority;
 
-    if (!APP_SCHED_QUEUE_EMPTY())
+    for (priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
     {
-        uint16_t event_index;
+        event_queue_t * p_queue = &m_queues[priority];
+
+        if (!APP_SCHED_QUEUE_EMPTY(p_queue))
+        {
+            uint16_t event_index;
 
-        //NOTE: There is no need for a critical region here, as this function will only be called
-        //from app_sched_execute() from inside the main loop, so it will never interrupt
-        //app_sched_event_put(). Also, updating of (i.e. writing to) the start index will be
-        //an atomic operation.
-        event_index         = m_queue_start_index;
-        m_queue_start_index = next_index(m_queue_start_index);
+            //NOTE: There is no need for a critical region here, as this function will only be called
+            //from app_sched_execute() from inside the main loop, so it will never interrupt
+            //app_sched_event_put(). Also, updating of (i.e. writing to) the start index will be
+            //an atomic operation.
+            event_index          = p_queue->start_index;
+            p_queue->start_index = next_index(p_queue->start_index);
 
-        *pp_event_data     = &m_queue_event_data[event_index * m_queue_event_size];
-        *p_event_data_size = m_queue_event_headers[event_index].event_data_size;
-        *p_event_handler   = m_queue_event_headers[event_index].handler;
+            *pp_event_data     = &p_queue->p_event_data[event_index * m_queue_event_stride];
+            *p_event_data_size = p_queue->p_event_headers[event_index].event_data_size;
+            *p_event_handler   = p_queue->p_event_headers[event_index].handler;
 
-        err_code = NRF_SUCCESS;
+            return NRF_SUCCESS;
+        }
     }
 
-    return err_code;
+    return NRF_ERROR_NOT_FOUND;
 }
 
 
@@ -257,6 +311,8 @@ void app_sched_execute(void)
     while ((!is_app_sched_paused()) &&
            (app_sched_event_get(&p_event_data, &event_data_size, &event_handler) == NRF_SUCCESS))
     {
+        PROFILE_BEGIN(APP_PROFILER_ID_SCHED_EVT);
         event_handler(p_event_data, event_data_size);
+        PROFILE_END(APP_PROFILER_ID_SCHED_EVT);
     }
 }
@@ -0,0 +1,483 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_sensor_codec.h"
+#include <string.h>
+#include "sdk_common.h"
+
+#define FLAG_KEY        0x80    // Key frame.
+#define FLAG_PACKED     0x40    // Packed differences.
+#define WIDTH_MASK      0x1F    // Width of the packed differences.
+
+#define MAX_SET_COUNT   0xFF    // The number of sample sets is stored in one byte.
+
+STATIC_ASSERT(APP_SENSOR_CODEC_MAX_VALUES >= APP_SENSOR_CODEC_MAX_CHANNELS);
+STATIC_ASSERT(APP_SENSOR_CODEC_MAX_FRAME_SIZE <= 0xFFFF);
+
+
+static uint16_t zigzag(int16_t delta)
+{
+    return (uint16_t)(((uint16_t)delta << 1) ^ (uint16_t)(delta >> 15));
+}
+
+
+static int16_t unzigzag(uint16_t value)
+{
+    return (int16_t)((value >> 1) ^ (uint16_t)(-(int16_t)(value & 1)));
+}
+
+
+static uint8_t varint_size(uint16_t value)
+{
+    return (value < 0x80) ? 1 : ((value < 0x4000) ? 2 : 3);
+}
+
+
+static uint8_t bit_width(uint16_t value)
+{
+    uint8_t width = 0;
+
+    while (value != 0)
+    {
+        width++;
+        value >>= 1;
+    }
+    return width;
+}
+
+
+static uint16_t packed_size(uint32_t value_count, uint8_t width)
+{
+    return (uint16_t)((value_count * width + 7) / 8);
+}
+
+
+/**@brief Function for getting the size of a frame with the differences in the shorter form.
+ */
+static uint16_t frame_size(app_sensor_codec_encoder_t const * p_encoder,
+                           uint32_t                           value_count,
+                           uint16_t                           varints,
+                           uint8_t                            width)
+{
+    uint16_t size   = APP_SENSOR_CODEC_HEADER_SIZE;
+    uint16_t packed = packed_size(value_count, width);
+
+    if (p_encoder->key_frame)
+    {
+        size += 2 * p_encoder->config.channels;
+    }
+    return size + MIN(varints, packed);
+}
+
+
+static void frame_emit(app_sensor_codec_encoder_t * p_encoder)
+{
+    uint8_t        frame[APP_SENSOR_CODEC_MAX_FRAME_SIZE];
+    uint16_t       size    = APP_SENSOR_CODEC_HEADER_SIZE;
+    uint8_t const  width   = p_encoder->width;
+    bool const     packed  = packed_size(p_encoder->value_count, width) < p_encoder->varint_size;
+    uint8_t        flags   = packed ? (FLAG_PACKED | width) : 0;
+
+    if (p_encoder->key_frame)
+    {
+        flags |= FLAG_KEY;
+        for (uint32_t ch = 0; ch < p_encoder->config.channels; ch++)
+        {
+            frame[size++] = (uint8_t)p_encoder->key[ch];
+            frame[size++] = (uint8_t)((uint16_t)p_encoder->key[ch] >> 8);
+        }
+    }
+
+    frame[0] = p_encoder->sequence;
+    frame[1] = flags;
+    frame[2] = p_encoder->set_count;
+
+    if (packed)
+    {
+        uint32_t bits  = 0;
+        uint8_t  count = 0;
+
+        for (uint32_t i = 0; i < p_encoder->value_count; i++)
+        {
+            bits  |= (uint32_t)p_encoder->values[i] << count;
+            count += width;
+            while (count >= 8)
+            {
+                frame[size++] = (uint8_t)bits;
+                bits  >>= 8;
+                count  -= 8;
+            }
+        }
+        if (count != 0)
+        {
+            frame[size++] = (uint8_t)bits;
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < p_encoder->value_count; i++)
+        {
+            uint16_t value = p_encoder->values[i];
+
+            while (value >= 0x80)
+            {
+                frame[size++] = (uint8_t)(value | 0x80);
+                value >>= 7;
+            }
+            frame[size++] = (uint8_t)value;
+        }
+    }
+
+    if (p_encoder->config.frame_handler(frame, size, p_encoder->config.p_context) == NRF_SUCCESS)
+    {
+        p_encoder->stats.frames++;
+        p_encoder->stats.bytes += size;
+    }
+    else
+    {
+        // The decoder sees the gap in the sequence numbers and waits for a key frame.
+        p_encoder->stats.frames_dropped++;
+        p_encoder->key_request = true;
+    }
+
+    p_encoder->sequence++;
+    p_encoder->since_key++;
+    p_encoder->set_count   = 0;
+    p_encoder->value_count = 0;
+    p_encoder->varint_size = 0;
+    p_encoder->width       = 0;
+}
+
+
+/**@brief Function for starting a frame with a sample set.
+ */
+static void frame_start(app_sensor_codec_encoder_t * p_encoder, int16_t const * p_set)
+{
+    app_sensor_codec_encoder_config_t const * p_config = &p_encoder->config;
+
+    p_encoder->key_frame = p_encoder->key_request ||
+                           ((p_config->key_interval != 0) &&
+                            (p_encoder->since_key >= p_config->key_interval));
+    if (p_encoder->key_frame)
+    {
+        memcpy(p_encoder->key, p_set, p_config->channels * sizeof(int16_t));
+        memcpy(p_encoder->last, p_set, p_config->channels * sizeof(int16_t));
+        p_encoder->key_request = false;
+        p_encoder->since_key   = 0;
+        p_encoder->set_count   = 1;
+    }
+}
+
+
+/**@brief Function for adding a sample set to the frame if it fits.
+ *
+ * @retval true  If the sample set was added.
+ * @retval false If the frame is full.
+ */
+static bool set_add(app_sensor_codec_encoder_t * p_encoder, int16_t const * p_set)
+{
+    uint8_t const  channels = p_encoder->config.channels;
+    uint16_t       values[APP_SENSOR_CODEC_MAX_CHANNELS];
+    uint16_t       varints  = p_encoder->varint_size;
+    uint8_t        width    = p_encoder->width;
+
+    if ((p_encoder->set_count == MAX_SET_COUNT) ||
+        ((p_encoder->set_count + 1) * channels > APP_SENSOR_CODEC_MAX_VALUES))
+    {
+        return false;
+    }
+
+    for (uint32_t ch = 0; ch < channels; ch++)
+    {
+        // The difference wraps around, so it always fits in 16 bits.
+        values[ch] = zigzag((int16_t)(p_set[ch] - p_encoder->last[ch]));
+        varints   += varint_size(values[ch]);
+        width      = MAX(width, bit_width(values[ch]));
+    }
+
+    if (frame_size(p_encoder, p_encoder->value_count + channels, varints, width) >
+        p_encoder->config.frame_size)
+    {
+        return false;
+    }
+
+    memcpy(&p_encoder->values[p_encoder->value_count], values, channels * sizeof(uint16_t));
+    memcpy(p_encoder->last, p_set, channels * sizeof(int16_t));
+    p_encoder->value_count += channels;
+    p_encoder->varint_size  = varints;
+    p_encoder->width        = width;
+    p_encoder->set_count++;
+
+    return true;
+}
+
+
+ret_code_t app_sensor_codec_encoder_init(app_sensor_codec_encoder_t *              p_encoder,
+                                         app_sensor_codec_encoder_config_t const * p_config)
+{
+    VERIFY_PARAM_NOT_NULL(p_encoder);
+    VERIFY_PARAM_NOT_NULL(p_config);
+    VERIFY_PARAM_NOT_NULL(p_config->frame_handler);
+
+    if ((p_config->channels == 0) ||
+        (p_config->channels > APP_SENSOR_CODEC_MAX_CHANNELS) ||
+        (p_config->frame_size < APP_SENSOR_CODEC_MIN_FRAME_SIZE(p_config->channels)) ||
+        (p_config->frame_size > APP_SENSOR_CODEC_MAX_FRAME_SIZE))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_encoder, 0, sizeof(*p_encoder));
+    p_encoder->config      = *p_config;
+    p_encoder->key_request = true;
+
+    return NRF_SUCCESS;
+}
+
+
+void app_sensor_codec_encode(app_sensor_codec_encoder_t * p_encoder,
+                             int16_t const *              p_samples,
+                             uint32_t                     set_count)
+{
+    uint8_t const channels = p_encoder->config.channels;
+
+    for (uint32_t i = 0; i < set_count; i++, p_samples += channels)
+    {
+        if ((p_encoder->set_count == 0) || !set_add(p_encoder, p_samples))
+        {
+            if (p_encoder->set_count != 0)
+            {
+                frame_emit(p_encoder);
+            }
+            // A key frame starts with the sample set. Otherwise, the sample set always fits in
+            // the empty frame, which the minimum frame size ensures.
+            frame_start(p_encoder, p_samples);
+            if (p_encoder->set_count == 0)
+            {
+                (void)set_add(p_encoder, p_samples);
+            }
+        }
+        p_encoder->stats.sample_sets++;
+    }
+}
+
+
+void app_sensor_codec_encoder_flush(app_sensor_codec_encoder_t * p_encoder)
+{
+    if (p_encoder->set_count != 0)
+    {
+        frame_emit(p_encoder);
+    }
+}
+
+
+void app_sensor_codec_encoder_reset(app_sensor_codec_encoder_t * p_encoder)
+{
+    p_encoder->set_count   = 0;
+    p_encoder->value_count = 0;
+    p_encoder->varint_size = 0;
+    p_encoder->width       = 0;
+    p_encoder->key_request = true;
+}
+
+
+void app_sensor_codec_encoder_stats_get(app_sensor_codec_encoder_t const * p_encoder,
+                                        app_sensor_codec_encoder_stats_t * p_stats)
+{
+    *p_stats = p_encoder->stats;
+}
+
+
+ret_code_t app_sensor_codec_decoder_init(app_sensor_codec_decoder_t * p_decoder, uint8_t channels)
+{
+    VERIFY_PARAM_NOT_NULL(p_decoder);
+
+    if ((channels == 0) || (channels > APP_SENSOR_CODEC_MAX_CHANNELS))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_decoder, 0, sizeof(*p_decoder));
+    p_decoder->channels = channels;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for reading the differences of a frame.
+ *
+ * @retval true  If the differences were read.
+ * @retval false If the differences do not match the frame length.
+ */
+static bool values_read(uint8_t const * p_data,
+                        uint16_t        length,
+                        uint8_t         flags,
+                        uint16_t *      p_values,
+                        uint32_t        value_count)
+{
+    uint16_t pos = 0;
+
+    if (flags & FLAG_PACKED)
+    {
+        uint8_t const  width = flags & WIDTH_MASK;
+        uint32_t const mask  = (1UL << width) - 1;
+        uint32_t       bits  = 0;
+        uint8_t        count = 0;
+
+        if ((width > 16) || (packed_size(value_count, width) != length))
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < value_count; i++)
+        {
+            while (count < width)
+            {
+                bits  |= (uint32_t)p_data[pos++] << count;
+                count += 8;
+            }
+            p_values[i] = (uint16_t)(bits & mask);
+            bits      >>= width;
+            count      -= width;
+        }
+        return true;
+    }
+
+    for (uint32_t i = 0; i < value_count; i++)
+    {
+        uint32_t value = 0;
+        uint8_t  shift = 0;
+        uint8_t  byte;
+
+        do
+        {
+            if ((pos == length) || (shift > 14))
+            {
+                return false;
+            }
+            byte   = p_data[pos++];
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        if (value > 0xFFFF)
+        {
+            return false;
+        }
+        p_values[i] = (uint16_t)value;
+    }
+    return (pos == length);
+}
+
+
+static ret_code_t frame_invalid(app_sensor_codec_decoder_t * p_decoder)
+{
+    p_decoder->stats.frames_invalid++;
+    p_decoder->synchronized = false;
+
+    return NRF_ERROR_INVALID_DATA;
+}
+
+
+ret_code_t app_sensor_codec_decode(app_sensor_codec_decoder_t * p_decoder,
+                                   uint8_t const *              p_frame,
+                                   uint16_t                     length,
+                                   int16_t const **             pp_samples,
+                                   uint16_t *                   p_set_count)
+{
+    uint8_t const channels = p_decoder->channels;
+    int16_t *     p_out    = p_decoder->samples;
+    uint16_t      pos      = APP_SENSOR_CODEC_HEADER_SIZE;
+    uint32_t      first    = 0;
+    uint32_t      set_count;
+    uint8_t       sequence;
+    uint8_t       flags;
+
+    if (length < APP_SENSOR_CODEC_HEADER_SIZE)
+    {
+        return frame_invalid(p_decoder);
+    }
+
+    sequence  = p_frame[0];
+    flags     = p_frame[1];
+    set_count = p_frame[2];
+
+    if (p_decoder->synchronized && (sequence != p_decoder->sequence))
+    {
+        p_decoder->stats.frames_lost += (uint8_t)(sequence - p_decoder->sequence);
+        p_decoder->synchronized       = false;
+    }
+    p_decoder->sequence = sequence + 1;
+
+    if (!p_decoder->synchronized && !(flags & FLAG_KEY))
+    {
+        p_decoder->stats.frames_skipped++;
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if ((set_count == 0) || (set_count * channels > APP_SENSOR_CODEC_MAX_VALUES))
+    {
+        return frame_invalid(p_decoder);
+    }
+
+    if (flags & FLAG_KEY)
+    {
+        if (length < pos + 2 * channels)
+        {
+            return frame_invalid(p_decoder);
+        }
+        for (uint32_t ch = 0; ch < channels; ch++)
+        {
+            p_out[ch] = (int16_t)uint16_decode(&p_frame[pos]);
+            pos      += 2;
+        }
+        first = channels;
+    }
+
+    // The differences are read into the samples array and replaced by the samples in order, so
+    // each difference is added to a sample that is already decoded.
+    uint32_t const value_count = set_count * channels;
+    uint16_t *     p_values    = (uint16_t *)p_out;
+
+    if (!values_read(&p_frame[pos], length - pos, flags, &p_values[first], value_count - first))
+    {
+        return frame_invalid(p_decoder);
+    }
+
+    for (uint32_t i = first; i < value_count; i++)
+    {
+        int16_t const prev = (i < channels) ? p_decoder->last[i] : p_out[i - channels];
+
+        p_out[i] = (int16_t)(prev + unzigzag(p_values[i]));
+    }
+    memcpy(p_decoder->last, &p_out[value_count - channels], channels * sizeof(int16_t));
+
+    p_decoder->synchronized = true;
+    p_decoder->stats.frames++;
+
+    *pp_samples  = p_out;
+    *p_set_count = (uint16_t)set_count;
+
+    return NRF_SUCCESS;
+}
+
+
+void app_sensor_codec_decoder_reset(app_sensor_codec_decoder_t * p_decoder)
+{
+    p_decoder->synchronized = false;
+}
+
+
+void app_sensor_codec_decoder_stats_get(app_sensor_codec_decoder_t const * p_decoder,
+                                        app_sensor_codec_decoder_stats_t * p_stats)
+{
+    *p_stats = p_decoder->stats;
+}
@@ -0,0 +1,256 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_SENSOR_CODEC_H__
+#define APP_SENSOR_CODEC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+
+/**
+ * @defgroup app_sensor_codec Sensor stream codec
+ * @{
+ * @ingroup app_common
+ *
+ * @brief Module for compressing streams of 16-bit sensor samples.
+ *
+ * @details The encoder takes sample sets, one sample for each channel, interleaved as
+ *          in the SAADC scan mode buffers. Each sample is replaced by its difference from
+ *          the previous sample of the same channel, and the zigzag-coded differences are
+ *          stored either as varints or packed with a fixed width, whichever is shorter
+ *          for the frame. As many sample sets are put in a frame as fit in the frame size,
+ *          so a frame can be sent in one notification.
+ *
+ *          Frame format, all fields little endian:
+ *          - Sequence number (1 byte).
+ *          - Flags (1 byte): bit 7 set for a key frame, bit 6 set for packed differences,
+ *            bits 4..0 the packed width in bits.
+ *          - Number of sample sets in the frame (1 byte).
+ *          - Key frame only: the first sample set, 2 bytes for each channel.
+ *          - Differences, channel by channel for each sample set. Varints hold 7 bits in
+ *            each byte, least significant group first. Packed differences fill each byte
+ *            from the least significant bit, and the last byte is padded with zeros.
+ *
+ *          The differences of a frame that is not a key frame follow the last sample of
+ *          the previous frame. When frames are lost, which the decoder detects from the
+ *          sequence numbers, decoding resumes at the next key frame.
+ */
+
+#ifndef APP_SENSOR_CODEC_MAX_CHANNELS
+#define APP_SENSOR_CODEC_MAX_CHANNELS   8   /**< Maximum number of channels in a stream. */
+#endif
+
+#ifndef APP_SENSOR_CODEC_MAX_FRAME_SIZE
+#define APP_SENSOR_CODEC_MAX_FRAME_SIZE 64  /**< Maximum frame size in bytes. */
+#endif
+
+#ifndef APP_SENSOR_CODEC_MAX_VALUES
+#define APP_SENSOR_CODEC_MAX_VALUES     128 /**< Maximum number of samples in a frame, counting all channels. */
+#endif
+
+#define APP_SENSOR_CODEC_HEADER_SIZE    3   /**< Size of the frame header. */
+
+/**@brief Smallest frame size for a number of channels. A frame must hold one sample set with
+ *        the longest varints. */
+#define APP_SENSOR_CODEC_MIN_FRAME_SIZE(channels) (APP_SENSOR_CODEC_HEADER_SIZE + 3 * (channels))
+
+/**
+ * @brief Frame handler prototype.
+ *
+ * @param[in] p_frame   Encoded frame. The buffer is valid until the handler returns.
+ * @param     length    Length of the frame.
+ * @param[in] p_context Context from the configuration.
+ *
+ * @retval NRF_SUCCESS If the frame was accepted. Otherwise, the frame is counted as dropped and
+ *                     the next frame is a key frame.
+ */
+typedef ret_code_t (* app_sensor_codec_frame_handler_t)(uint8_t const * p_frame,
+                                                        uint16_t        length,
+                                                        void *          p_context);
+
+/**
+ * @brief Encoder configuration.
+ */
+typedef struct
+{
+    uint8_t                          channels;      ///< Number of channels, from 1 to @ref APP_SENSOR_CODEC_MAX_CHANNELS.
+    uint16_t                         frame_size;    ///< Maximum frame length, usually the notification payload length.
+    uint16_t                         key_interval;  ///< Number of frames from one key frame to the next, or 0 to send a key frame only at the start and after dropped frames.
+    app_sensor_codec_frame_handler_t frame_handler; ///< Handler called with each encoded frame.
+    void *                           p_context;     ///< Context passed to the frame handler.
+} app_sensor_codec_encoder_config_t;
+
+/**
+ * @brief Encoder statistics.
+ */
+typedef struct
+{
+    uint32_t sample_sets;    ///< Number of sample sets encoded.
+    uint32_t frames;         ///< Number of frames passed to the frame handler.
+    uint32_t frames_dropped; ///< Number of frames not accepted by the frame handler.
+    uint32_t bytes;          ///< Number of bytes in the frames.
+} app_sensor_codec_encoder_stats_t;
+
+/**
+ * @brief Encoder instance. Its content is private to the module.
+ */
+typedef struct
+{
+    app_sensor_codec_encoder_config_t config;
+    int16_t                           last[APP_SENSOR_CODEC_MAX_CHANNELS];   ///< Last sample of each channel.
+    int16_t                           key[APP_SENSOR_CODEC_MAX_CHANNELS];    ///< First sample set of a key frame.
+    uint16_t                          values[APP_SENSOR_CODEC_MAX_VALUES];   ///< Zigzag-coded differences of the frame.
+    uint16_t                          value_count;                           ///< Number of differences in the frame.
+    uint16_t                          varint_size;                           ///< Size of the differences as varints.
+    uint8_t                           width;                                 ///< Width of the largest difference.
+    uint8_t                           set_count;                             ///< Number of sample sets in the frame, 0 if it is empty.
+    bool                              key_frame;                             ///< The frame is a key frame.
+    bool                              key_request;                           ///< The next frame must be a key frame.
+    uint8_t                           sequence;                              ///< Sequence number of the frame.
+    uint16_t                          since_key;                             ///< Number of frames since the last key frame.
+    app_sensor_codec_encoder_stats_t  stats;
+} app_sensor_codec_encoder_t;
+
+/**
+ * @brief Decoder statistics.
+ */
+typedef struct
+{
+    uint32_t frames;         ///< Number of frames decoded.
+    uint32_t frames_lost;    ///< Number of frames missing from the sequence.
+    uint32_t frames_skipped; ///< Number of frames received while waiting for a key frame.
+    uint32_t frames_invalid; ///< Number of malformed frames.
+} app_sensor_codec_decoder_stats_t;
+
+/**
+ * @brief Decoder instance. Its content is private to the module.
+ */
+typedef struct
+{
+    uint8_t                          channels;
+    bool                             synchronized;                          ///< The previous frame was decoded.
+    uint8_t                          sequence;                              ///< Expected sequence number.
+    int16_t                          last[APP_SENSOR_CODEC_MAX_CHANNELS];   ///< Last sample of each channel.
+    int16_t                          samples[APP_SENSOR_CODEC_MAX_VALUES];  ///< Samples of the last decoded frame.
+    app_sensor_codec_decoder_stats_t stats;
+} app_sensor_codec_decoder_t;
+
+/**
+ * @brief Function for initializing an encoder.
+ *
+ * @param[out] p_encoder Encoder instance.
+ * @param[in]  p_config  Encoder configuration. It is copied to the instance.
+ *
+ * @retval NRF_SUCCESS             If the encoder was initialized.
+ * @retval NRF_ERROR_NULL          If a parameter or the frame handler is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If the number of channels or the frame size is out of range.
+ */
+ret_code_t app_sensor_codec_encoder_init(app_sensor_codec_encoder_t *              p_encoder,
+                                         app_sensor_codec_encoder_config_t const * p_config);
+
+/**
+ * @brief Function for encoding sample sets.
+ *
+ * A frame is passed to the frame handler when the next sample set does not fit in it, so the
+ * last sample sets are kept in the encoder until more samples arrive or
+ * @ref app_sensor_codec_encoder_flush is called.
+ *
+ * The function can be used as a processing stage of a sampling pipeline, for example on the
+ * buffers of the SAADC continuous mode, which hold interleaved sample sets.
+ *
+ * @param[in] p_encoder Encoder instance.
+ * @param[in] p_samples Sample sets, channel by channel.
+ * @param     set_count Number of sample sets.
+ */
+void app_sensor_codec_encode(app_sensor_codec_encoder_t * p_encoder,
+                             int16_t const *              p_samples,
+                             uint32_t                     set_count);
+
+/**
+ * @brief Function for passing the frame being filled to the frame handler.
+ *
+ * @param[in] p_encoder Encoder instance.
+ */
+void app_sensor_codec_encoder_flush(app_sensor_codec_encoder_t * p_encoder);
+
+/**
+ * @brief Function for discarding the frame being filled and starting a new stream.
+ *
+ * The next frame is a key frame. Call the function, for example, when the link is reconnected.
+ *
+ * @param[in] p_encoder Encoder instance.
+ */
+void app_sensor_codec_encoder_reset(app_sensor_codec_encoder_t * p_encoder);
+
+/**
+ * @brief Function for getting the encoder statistics.
+ *
+ * @param[in]  p_encoder Encoder instance.
+ * @param[out] p_stats   Statistics.
+ */
+void app_sensor_codec_encoder_stats_get(app_sensor_codec_encoder_t const * p_encoder,
+                                        app_sensor_codec_encoder_stats_t * p_stats);
+
+/**
+ * @brief Function for initializing a decoder.
+ *
+ * @param[out] p_decoder Decoder instance.
+ * @param      channels  Number of channels, as configured in the encoder.
+ *
+ * @retval NRF_SUCCESS             If the decoder was initialized.
+ * @retval NRF_ERROR_NULL          If p_decoder is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If the number of channels is out of range.
+ */
+ret_code_t app_sensor_codec_decoder_init(app_sensor_codec_decoder_t * p_decoder, uint8_t channels);
+
+/**
+ * @brief Function for decoding a frame.
+ *
+ * @param[in]  p_decoder   Decoder instance.
+ * @param[in]  p_frame     Frame.
+ * @param      length      Length of the frame.
+ * @param[out] pp_samples  Decoded sample sets, channel by channel. They are valid until the
+ *                         next frame is decoded.
+ * @param[out] p_set_count Number of decoded sample sets.
+ *
+ * @retval NRF_SUCCESS             If the frame was decoded.
+ * @retval NRF_ERROR_INVALID_STATE If the frame was skipped because frames were lost since the
+ *                                 last key frame.
+ * @retval NRF_ERROR_INVALID_DATA  If the frame is malformed. Decoding resumes at the next key
+ *                                 frame.
+ */
+ret_code_t app_sensor_codec_decode(app_sensor_codec_decoder_t * p_decoder,
+                                   uint8_t const *              p_frame,
+                                   uint16_t                     length,
+                                   int16_t const **             pp_samples,
+                                   uint16_t *                   p_set_count);
+
+/**
+ * @brief Function for waiting for a key frame, for example after reconnecting.
+ *
+ * @param[in] p_decoder Decoder instance.
+ */
+void app_sensor_codec_decoder_reset(app_sensor_codec_decoder_t * p_decoder);
+
+/**
+ * @brief Function for getting the decoder statistics.
+ *
+ * @param[in]  p_decoder Decoder instance.
+ * @param[out] p_stats   Statistics.
+ */
+void app_sensor_codec_decoder_stats_get(app_sensor_codec_decoder_t const * p_decoder,
+                                        app_sensor_codec_decoder_stats_t * p_stats);
+
+/** @} */
+
+#endif // APP_SENSOR_CODEC_H__
@@ -21,13 +21,42 @@
 #define ROTLEFT(a,b) (((a) << (b)) | ((a) >> (32-(b))))
 #define ROTRIGHT(a,b) (((a) >> (b)) | ((a) << (32-(b))))
 
-#define CH(x,y,z) (((x) & (y)) ^ (~(x) & (z)))
-#define MAJ(x,y,z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define CH(x,y,z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x,y,z) (((x) & (y)) | ((z) & ((x) | (y))))
 #define EP0(x) (ROTRIGHT(x,2) ^ ROTRIGHT(x,13) ^ ROTRIGHT(x,22))
 #define EP1(x) (ROTRIGHT(x,6) ^ ROTRIGHT(x,11) ^ ROTRIGHT(x,25))
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
+// Message schedule word i, for the first 16 rounds and, computed in place in the 16 word window
+// of the schedule, for the following rounds.
+#define M_LOAD(i) (m[i])
+#define M_EXPAND(i) (m[(i) & 15] += SIG1(m[((i) - 2) & 15]) + m[((i) - 7) & 15] + SIG0(m[((i) - 15) & 15]))
+
+// Round i. Instead of shifting the working variables, the variables passed in are rotated from one
+// round to the next.
+#define ROUND(a,b,c,d,e,f,g,h,i,M)                          \
+    do                                                      \
+    {                                                       \
+        uint32_t t1 = h + EP1(e) + CH(e,f,g) + k[i] + M(i); \
+        d += t1;                                            \
+        h  = t1 + EP0(a) + MAJ(a,b,c);                      \
+    } while (0)
+
+// Rounds i to i + 7, after which the working variables are back in place.
+#define ROUNDS_8(i,M)                                       \
+    do                                                      \
+    {                                                       \
+        ROUND(a,b,c,d,e,f,g,h,(i) + 0,M);                   \
+        ROUND(h,a,b,c,d,e,f,g,(i) + 1,M);                   \
+        ROUND(g,h,a,b,c,d,e,f,(i) + 2,M);                   \
+        ROUND(f,g,h,a,b,c,d,e,(i) + 3,M);                   \
+        ROUND(e,f,g,h,a,b,c,d,(i) + 4,M);                   \
+        ROUND(d,e,f,g,h,a,b,c,(i) + 5,M);                   \
+        ROUND(c,d,e,f,g,h,a,b,(i) + 6,M);                   \
+        ROUND(b,c,d,e,f,g,h,a,(i) + 7,M);                   \
+    } while (0)
+
 
 static const uint32_t k[64] = {
     0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -41,19 +70,42 @@ static const uint32_t k[64] = {
 };
 
 
+/**@brief Function for loading a big endian word of the data to be hashed.
+ *
+ * @param[in] p_data  Pointer to the word.
+ *
+ * @return The word, in host byte order.
+ */
+static __INLINE uint32_t sha256_word_load(const uint8_t * p_data)
+{
+#ifdef NRF51
+    // Cortex-M0 does not support unaligned word access.
+    if (((uint32_t)p_data & (sizeof(uint32_t) - 1)) == 0)
+    {
+        return __REV(*(const uint32_t *)p_data);
+    }
+    return ((uint32_t)p_data[0] << 24) | ((uint32_t)p_data[1] << 16) |
+           ((uint32_t)p_data[2] << 8)  | ((uint32_t)p_data[3]);
+#else
+    return __REV(*(const uint32_t *)p_data);
+#endif
+}
+
+
 /**@brief Function for calculating the hash of a 64-byte section of data.
+ *
+ * @details The rounds are unrolled by 8, so that the working variables are not shifted, and the
+ *          message schedule is computed in a 16 word window as the rounds need it.
  *
  * @param[in,out] ctx   Hash instance.
  * @param[in]     data  Aray with data to be hashed. Assumed to be 64 bytes long.
  */
 void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
 {
-    uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+    uint32_t a, b, c, d, e, f, g, h, i, m[16];
 
-    for (i = 0, j = 0; i < 16; ++i, j += 4)
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-    for ( ; i < 64; ++i)
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+    for (i = 0; i < 16; ++i)
+        m[i] = sha256_word_load(&data[i * sizeof(uint32_t)]);
 
     a = ctx->state[0];
     b = ctx->state[1];
@@ -64,18 +116,10 @@ void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
     g = ctx->state[6];
     h = ctx->state[7];
 
-    for (i = 0; i < 64; ++i) {
-        t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-        t2 = EP0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
-    }
+    for (i = 0; i < 16; i += 8)
+        ROUNDS_8(i, M_LOAD);
+    for ( ; i < 64; i += 8)
+        ROUNDS_8(i, M_EXPAND);
 
     ctx->state[0] += a;
     ctx->state[1] += b;
@@ -115,11 +159,23 @@ ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, size_t len
         return NRF_ERROR_NULL;
     }
 
-    uint32_t i;
+    while (len > 0) {
+        if ((ctx->datalen == 0) && (len >= 64)) {
+            // Whole blocks are hashed from the data, without copying them to the context.
+            sha256_transform(ctx, data);
+            ctx->bitlen += 512;
+            data        += 64;
+            len         -= 64;
+            continue;
+        }
+
+        size_t length = MIN(len, 64 - ctx->datalen);
+
+        memcpy(&ctx->data[ctx->datalen], data, length);
+        ctx->datalen += length;
+        data         += length;
+        len          -= length;
 
-    for (i = 0; i < len; ++i) {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
         if (ctx->datalen == 64) {
             sha256_transform(ctx, ctx->data);
             ctx->bitlen += 512;
@@ -168,15 +224,11 @@ ret_code_t sha256_final(sha256_context_t *ctx, uint8_t * hash)
 
     // Since this implementation uses little endian uint8_t ordering and SHA uses big endian,
     // reverse all the uint8_ts when copying the final state to the output hash.
-    for (i = 0; i < 4; ++i) {
-        hash[i]      = (ctx->state[0] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 4]  = (ctx->state[1] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 8]  = (ctx->state[2] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 12] = (ctx->state[3] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 16] = (ctx->state[4] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 20] = (ctx->state[5] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 24] = (ctx->state[6] >> (24 - i * 8)) & 0x000000ff;
-        hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
+    for (i = 0; i < 8; ++i) {
+        hash[i * 4]     = (ctx->state[i] >> 24) & 0x000000ff;
+        hash[i * 4 + 1] = (ctx->state[i] >> 16) & 0x000000ff;
+        hash[i * 4 + 2] = (ctx->state[i] >> 8)  & 0x000000ff;
+        hash[i * 4 + 3] = (ctx->state[i])       & 0x000000ff;
     }
 
     return NRF_SUCCESS;
@@ -9,8 +9,9 @@
  * the file.
  *
  */
- 
+
 #include "slip.h"
+#include <string.h>
 #include "nrf_error.h"
 
 #define SLIP_END             0300    /* indicates end of packet */
@@ -18,63 +19,137 @@
 #define SLIP_ESC_END         0334    /* ESC ESC_END means END data byte */
 #define SLIP_ESC_ESC         0335    /* ESC ESC_ESC means ESC data byte */
 
+#define SLIP_IS_SPECIAL(c)   (((c) == SLIP_END) || ((c) == SLIP_ESC))
+
+/* Non-zero if any byte of the 32-bit word equals the given byte value. */
+#define WORD_BYTES(b)              (0x01010101UL * (uint32_t)(b))
+#define WORD_HAS_ZERO_BYTE(w)      (((w) - WORD_BYTES(1)) & ~(w) & WORD_BYTES(0x80))
+#define WORD_HAS_BYTE(w, b)        WORD_HAS_ZERO_BYTE((w) ^ WORD_BYTES(b))
+
+
+/**@brief Function for finding the number of leading bytes which can be passed through as they are.
+ *
+ * @details Once the data pointer is word aligned, four bytes are checked at a time.
+ */
+static uint32_t plain_run_length(uint8_t const * p_data, uint32_t length)
+{
+    uint32_t index = 0;
+
+    while ((index < length) && ((((uint32_t)&p_data[index]) & 0x03) != 0))
+    {
+        if (SLIP_IS_SPECIAL(p_data[index]))
+        {
+            return index;
+        }
+        index++;
+    }
+
+    while ((length - index) >= sizeof(uint32_t))
+    {
+        uint32_t word = *(uint32_t const *)&p_data[index];
+
+        if (WORD_HAS_BYTE(word, SLIP_END) || WORD_HAS_BYTE(word, SLIP_ESC))
+        {
+            break;
+        }
+        index += sizeof(uint32_t);
+    }
+
+    while ((index < length) && !SLIP_IS_SPECIAL(p_data[index]))
+    {
+        index++;
+    }
+
+    return index;
+}
+
 
 uint32_t slip_encode(uint8_t * p_output,  uint8_t * p_input, uint32_t input_length, uint32_t output_buffer_length)
 {
-    uint32_t input_index;
-    uint32_t output_index;
-    
-    for (input_index = 0, output_index = 0; input_index < input_length && output_index < output_buffer_length; input_index++)
+    uint32_t input_index  = 0;
+    uint32_t output_index = 0;
+
+    while (input_index < input_length)
     {
-        switch (p_input[input_index])
+        uint32_t run = plain_run_length(&p_input[input_index], input_length - input_index);
+
+        if (run > 0)
         {
-            case SLIP_END:
-                p_output[output_index++] = SLIP_END;
-                p_output[output_index++] = SLIP_ESC_END;
-                break;
-            
-            case SLIP_ESC:
-                p_output[output_index++] = SLIP_ESC;
-                p_output[output_index++] = SLIP_ESC_ESC;
-                break;
-                
-            default:
-                p_output[output_index++] = p_input[input_index];
+            if (run > output_buffer_length - output_index)
+            {
+                return 0;
+            }
+            memcpy(&p_output[output_index], &p_input[input_index], run);
+            input_index  += run;
+            output_index += run;
+            continue;
         }
+
+        if ((output_buffer_length - output_index) < 2)
+        {
+            return 0;
+        }
+        p_output[output_index++] = SLIP_ESC;
+        p_output[output_index++] = (p_input[input_index++] == SLIP_END) ? SLIP_ESC_END : SLIP_ESC_ESC;
+    }
+
+    if (output_index >= output_buffer_length)
+    {
+        return 0;
     }
     p_output[output_index++] = (uint8_t)SLIP_END;
-    p_output[output_index++] = (uint8_t)SLIP_END; // clarify that the packet has ended.
-    
+
     return output_index;
 }
 
 
+/**@brief Function for storing a decoded byte, checking the size of the packet buffer. */
+static uint32_t decoded_byte_store(uint8_t c, buffer_t * p_buf, slip_state_t * current_state)
+{
+    if (p_buf->current_index >= p_buf->len)
+    {
+        *current_state = SLIP_CLEARING_INVALID_PACKET;
+        return NRF_ERROR_NO_MEM;
+    }
+    p_buf->p_buffer[p_buf->current_index++] = c;
+    p_buf->current_length++;
+    return NRF_ERROR_BUSY;
+}
+
+
 uint32_t slip_decoding_add_char(uint8_t c, buffer_t * p_buf, slip_state_t * current_state)
-{   
+{
     switch (*current_state)
     {
         case SLIP_DECODING:
+        case SLIP_END_RECEIVED:
+            *current_state = SLIP_DECODING;
+
             if (c == SLIP_END)
             {
-                *current_state = SLIP_END_RECEIVED;
+                // empty packets (leading or repeated END) are skipped
+                if (p_buf->current_length > 0)
+                {
+                    return NRF_SUCCESS;
+                }
             }
             else if (c == SLIP_ESC)
             {
-                *current_state = SLIP_END_RECEIVED;
+                *current_state = SLIP_ESC_RECEIVED;
             }
-            else 
+            else
             {
-                p_buf->p_buffer[p_buf->current_index++] = c;
-                p_buf->current_length++;
+                return decoded_byte_store(c, p_buf, current_state);
             }
             break;
-        
+
         case SLIP_ESC_RECEIVED:
-            if (c == SLIP_ESC_ESC)
+            if (c == SLIP_ESC_ESC || c == SLIP_ESC_END)
             {
-                p_buf->p_buffer[p_buf->current_index++] = SLIP_ESC; 
-                p_buf->current_length++;  
-                *current_state = SLIP_DECODING;                
+                *current_state = SLIP_DECODING;
+                return decoded_byte_store((c == SLIP_ESC_ESC) ? SLIP_ESC : SLIP_END,
+                                          p_buf,
+                                          current_state);
             }
             else
             {
@@ -82,31 +157,72 @@ uint32_t slip_decoding_add_char(uint8_t c, buffer_t * p_buf, slip_state_t * curr
                 *current_state = SLIP_CLEARING_INVALID_PACKET;
                 return NRF_ERROR_INVALID_DATA;
             }
-            break;
-            
-        case SLIP_END_RECEIVED:
-            if (c == SLIP_ESC_END)
-            {
-                p_buf->p_buffer[p_buf->current_index++] = SLIP_END;
-                p_buf->current_length++;
-                *current_state = SLIP_DECODING;
-            }
-            else 
-            {
-                // packet is finished
-                *current_state = SLIP_DECODING;                 
-                return NRF_SUCCESS;
-            }
-            break;       
-        
+
         case SLIP_CLEARING_INVALID_PACKET:
             if (c == SLIP_END)
             {
-                *current_state = SLIP_DECODING;        
+                *current_state = SLIP_DECODING;
                 p_buf->current_index = 0;
                 p_buf->current_length = 0;
             }
             break;
-    } 
+    }
     return NRF_ERROR_BUSY;
 }
+
+
+uint32_t slip_decoding_add_buffer(uint8_t const * p_input,
+                                  uint32_t        input_length,
+                                  buffer_t      * p_buf,
+                                  slip_state_t  * current_state,
+                                  uint32_t      * p_consumed)
+{
+    uint32_t index    = 0;
+    uint32_t err_code = NRF_ERROR_BUSY;
+
+    while ((index < input_length) && (err_code == NRF_ERROR_BUSY))
+    {
+        if ((*current_state == SLIP_DECODING) || (*current_state == SLIP_END_RECEIVED))
+        {
+            uint32_t run = plain_run_length(&p_input[index], input_length - index);
+
+            if (run > 0)
+            {
+                if (run > p_buf->len - p_buf->current_index)
+                {
+                    *current_state = SLIP_CLEARING_INVALID_PACKET;
+                    err_code       = NRF_ERROR_NO_MEM;
+                    index         += run;
+                    break;
+                }
+
+                // Source and destination are the same when decoding in place before the first
+                // escaped byte of the packet.
+                if (&p_buf->p_buffer[p_buf->current_index] != &p_input[index])
+                {
+                    memmove(&p_buf->p_buffer[p_buf->current_index], &p_input[index], run);
+                }
+                p_buf->current_index  += run;
+                p_buf->current_length += run;
+                index                 += run;
+                continue;
+            }
+        }
+        else if (*current_state == SLIP_CLEARING_INVALID_PACKET)
+        {
+            uint8_t const * p_end = memchr(&p_input[index], SLIP_END, input_length - index);
+
+            if (p_end == NULL)
+            {
+                index = input_length;
+                break;
+            }
+            index = (uint32_t)(p_end - p_input);
+        }
+
+        err_code = slip_decoding_add_char(p_input[index++], p_buf, current_state);
+    }
+
+    *p_consumed = index;
+    return err_code;
+}
@@ -29,7 +29,7 @@
   
 typedef enum {
     SLIP_DECODING,
-    SLIP_END_RECEIVED,
+    SLIP_END_RECEIVED,              /**< Handled as SLIP_DECODING, kept for compatibility. */
     SLIP_ESC_RECEIVED,
     SLIP_CLEARING_INVALID_PACKET,
 } slip_state_t;
@@ -43,9 +43,12 @@ typedef struct {
   
 /**@brief Encodes a slip packet.
  * 
- * @details Note that the encoded output data will be longer than the input data. 
+ * @details Note that the encoded output data will be longer than the input data. The packet is
+ *          terminated by a single SLIP_END. Runs of bytes which need no escaping are copied as
+ *          they are, checking the input a word at a time.
  *
  * @retval The length of the encoded packet. If it is smaller than the input length, an error has occurred. 
+ *         0 is returned if the encoded packet does not fit in output_buffer_length bytes.
  */
 uint32_t slip_encode(uint8_t * p_output,  uint8_t * p_input, uint32_t input_length, uint32_t output_buffer_length);
 
@@ -57,9 +60,37 @@ uint32_t slip_encode(uint8_t * p_output,  uint8_t * p_input, uint32_t input_leng
  * @retval NRF_ERROR_BUSY when packet is not finished parsing
  * @retval NRF_ERROR_INVALID_DATA when packet is encoded wrong. 
            This moves the decoding to SLIP_CLEARING_INVALID_PACKET, and will stay in this state until SLIP_END is encountered.
+ * @retval NRF_ERROR_NO_MEM when the packet does not fit in p_buf->len bytes. It is then discarded as an invalid one.
  */
 uint32_t slip_decoding_add_char(uint8_t c, buffer_t * p_buf, slip_state_t * current_state);
 
+/**@brief Decodes a buffer of slip encoded data.
+ *
+ * @details Gives the same result as calling @ref slip_decoding_add_char for every byte of the
+ *          input, but runs of bytes without SLIP_END or SLIP_ESC are found a word at a time and
+ *          copied in one go. Decoding stops at the end of the first complete packet, the caller
+ *          then resets p_buf and calls the function again with the remaining input.
+ *
+ *          The packet is decoded in place if p_input points into p_buf->p_buffer, at or after
+ *          p_buf->current_index: decoded data is never longer than the encoded data.
+ *
+ * @param[in]     p_input       Encoded data.
+ * @param[in]     input_length  Number of bytes in p_input.
+ * @param[in,out] p_buf         Buffer of the packet being decoded. p_buf->len is its size.
+ * @param[in,out] current_state Decoder state, as for @ref slip_decoding_add_char.
+ * @param[out]    p_consumed    Number of input bytes processed.
+ *
+ * @retval NRF_SUCCESS when a packet is parsed. The length of the packet can be read out from p_buf->current_index
+ * @retval NRF_ERROR_BUSY when all input has been processed and the packet is not finished
+ * @retval NRF_ERROR_INVALID_DATA when packet is encoded wrong. See @ref slip_decoding_add_char.
+ * @retval NRF_ERROR_NO_MEM when the packet does not fit in p_buf. It is discarded as an invalid one.
+ */
+uint32_t slip_decoding_add_buffer(uint8_t const * p_input,
+                                  uint32_t        input_length,
+                                  buffer_t      * p_buf,
+                                  slip_state_t  * current_state,
+                                  uint32_t      * p_consumed);
+
 
 #endif // SLIP_H__
 
@@ -0,0 +1,689 @@
+/* Copyright (c) 2015 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_spi.h"
+#include "nrf_assert.h"
+#include "nrf_gpio.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+#if APP_SPI_REPEAT_ENABLED
+#include "nrf_drv_gpiote.h"
+#endif
+
+
+// Increase specified queue index and when it goes outside the queue move it
+// on the beginning of the queue.
+#define INCREASE_IDX(idx, p_queue)  \
+    do { \
+        ++idx; \
+        p_queue->idx = (idx > p_queue->size) ? 0 : idx; \
+    } while (0)
+
+
+// The SPI master driver does not pass any context to its event handler, so
+// the manager instance is found by the driver instance index.
+static app_spi_t * mp_instances[SPI_COUNT];
+
+
+static bool queue_put(app_spi_queue_t *             p_queue,
+                      app_spi_transaction_t const * p_transaction)
+{
+    // [use a local variable to avoid using two volatile variables in one
+    //  expression]
+    uint8_t write_idx = p_queue->write_idx;
+
+    // If the queue is already full, we cannot put any more elements into it.
+    if ((write_idx == p_queue->size && p_queue->read_idx == 0) ||
+        write_idx == p_queue->read_idx-1)
+    {
+        return false;
+    }
+
+    // Write the new element on the position specified by the write index.
+    p_queue->p_buffer[write_idx] = p_transaction;
+    // Increase the write index and when it goes outside the queue move it
+    // on the beginning.
+    INCREASE_IDX(write_idx, p_queue);
+
+    return true;
+}
+
+
+static app_spi_transaction_t const * queue_get(app_spi_queue_t * p_queue)
+{
+    // [use a local variable to avoid using two volatile variables in one
+    //  expression]
+    uint8_t read_idx = p_queue->read_idx;
+
+    // If the queue is empty, we cannot return any more elements from it.
+    if (read_idx == p_queue->write_idx)
+    {
+        return NULL;
+    }
+
+    // Read the element from the position specified by the read index.
+    app_spi_transaction_t const * p_transaction = p_queue->p_buffer[read_idx];
+    // Increase the read index and when it goes outside the queue move it
+    // on the beginning.
+    INCREASE_IDX(read_idx, p_queue);
+
+    return p_transaction;
+}
+
+
+static void cs_activate(uint8_t cs_pin)
+{
+    if (cs_pin != NRF_DRV_SPI_PIN_NOT_USED)
+    {
+        // [set the output value before the pin is switched to output to
+        //  avoid a glitch on the line]
+        nrf_gpio_pin_set(cs_pin);
+        nrf_gpio_cfg_output(cs_pin);
+        nrf_gpio_pin_clear(cs_pin);
+    }
+}
+
+
+static void cs_deactivate(uint8_t cs_pin)
+{
+    if (cs_pin != NRF_DRV_SPI_PIN_NOT_USED)
+    {
+        nrf_gpio_pin_set(cs_pin);
+    }
+}
+
+
+static ret_code_t start_transfer(app_spi_t * p_app_spi)
+{
+    ASSERT(p_app_spi != NULL);
+
+    // [use a local variable to avoid using two volatile variables in one
+    //  expression]
+    uint8_t current_transfer_idx = p_app_spi->current_transfer_idx;
+    app_spi_transfer_t const * p_transfer =
+        &p_app_spi->p_current_transaction->p_transfers[current_transfer_idx];
+    ret_code_t result;
+
+    cs_activate(p_transfer->cs_pin);
+
+    result = nrf_drv_spi_transfer(&p_app_spi->spi,
+                                  p_transfer->p_tx_data, p_transfer->tx_length,
+                                  p_transfer->p_rx_data, p_transfer->rx_length);
+    if (result != NRF_SUCCESS)
+    {
+        cs_deactivate(p_transfer->cs_pin);
+    }
+
+    return result;
+}
+
+
+static void signal_end_of_transaction(app_spi_t const * p_app_spi,
+                                      ret_code_t        result)
+{
+    ASSERT(p_app_spi != NULL);
+
+    if (p_app_spi->p_current_transaction->callback)
+    {
+        // [use a local variable to avoid using two volatile variables in one
+        //  expression]
+        void * p_user_data = p_app_spi->p_current_transaction->p_user_data;
+        p_app_spi->p_current_transaction->callback(result, p_user_data);
+    }
+}
+
+
+// This function starts pending transaction if there is no current one or
+// when 'switch_transaction' parameter is set to true. It is important to
+// switch to new transaction without setting 'p_app_spi->p_current_transaction'
+// to NULL in between, since this pointer is used to check idle status - see
+// 'app_spi_is_idle()'.
+static void start_pending_transaction(app_spi_t * p_app_spi,
+                                      bool        switch_transaction)
+{
+    ASSERT(p_app_spi != NULL);
+
+    for (;;)
+    {
+        bool start_transaction = false;
+
+        CRITICAL_REGION_ENTER();
+        if (switch_transaction || app_spi_is_idle(p_app_spi))
+        {
+            p_app_spi->p_current_transaction = queue_get(&p_app_spi->queue);
+            if (p_app_spi->p_current_transaction != NULL)
+            {
+                start_transaction = true;
+            }
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (!start_transaction)
+        {
+            return;
+        }
+        else
+        {
+            ret_code_t result;
+
+            // Try to start first transfer for this new transaction.
+            p_app_spi->current_transfer_idx = 0;
+            result = start_transfer(p_app_spi);
+
+            // If it started successfully there is nothing more to do here now.
+            if (result == NRF_SUCCESS)
+            {
+                return;
+            }
+
+            // Transfer failed to start - notify user that this transaction
+            // cannot be started and try with next one (in next iteration of
+            // the loop).
+            signal_end_of_transaction(p_app_spi, result);
+
+            switch_transaction = true;
+        }
+    }
+}
+
+
+static void spi_event_handler(app_spi_t * p_app_spi,
+                              nrf_drv_spi_evt_t const * p_event)
+{
+    ASSERT(p_event != NULL);
+
+    // This callback should be called only during transaction.
+    ASSERT(p_app_spi->p_current_transaction != NULL);
+
+    ret_code_t result = NRF_SUCCESS;
+
+    // [use a local variable to avoid using two volatile variables in one
+    //  expression]
+    uint8_t current_transfer_idx = p_app_spi->current_transfer_idx;
+    app_spi_transaction_t const * p_transaction = p_app_spi->p_current_transaction;
+    app_spi_transfer_t const * p_transfer = &p_transaction->p_transfers[current_transfer_idx];
+
+    ++current_transfer_idx;
+    if (!(p_transfer->flags & APP_SPI_CS_HOLD) ||
+        current_transfer_idx >= p_transaction->number_of_transfers)
+    {
+        cs_deactivate(p_transfer->cs_pin);
+    }
+
+    // Transfer finished. If there is another one to be performed in the
+    // current transaction, start it now.
+    if (current_transfer_idx < p_transaction->number_of_transfers)
+    {
+        p_app_spi->current_transfer_idx = current_transfer_idx;
+
+        result = start_transfer(p_app_spi);
+
+        if (result == NRF_SUCCESS)
+        {
+            // The current transaction goes on and we've successfully
+            // started its next transfer -> there is nothing more to do.
+            return;
+        }
+
+        // [if the next transfer could not be started due to some error
+        //  we finish the transaction with this error code as the result;
+        //  make sure the chip select line of a held transfer is released]
+        cs_deactivate(p_transfer->cs_pin);
+    }
+
+    // The current transaction has been completed or interrupted by some error.
+    // Notify the user and start next one (if there is any).
+    signal_end_of_transaction(p_app_spi, result);
+    // [we switch transactions here ('p_app_spi->p_current_transaction' is set
+    //  to NULL only if there is nothing more to do) in order to not generate
+    //  spurious idle status (even for a moment)]
+    start_pending_transaction(p_app_spi, true);
+}
+
+
+#define SPI_EVENT_HANDLER_NAME(n) spi##n##_event_handler
+#define SPI_EVENT_HANDLER(n)                                                    \
+    static void SPI_EVENT_HANDLER_NAME(n)(nrf_drv_spi_evt_t const * p_event) \
+    {                                                                           \
+        spi_event_handler(mp_instances[SPI##n##_INSTANCE_INDEX], p_event);      \
+    }
+
+#if SPI0_ENABLED
+    SPI_EVENT_HANDLER(0)
+#endif
+#if SPI1_ENABLED
+    SPI_EVENT_HANDLER(1)
+#endif
+#if SPI2_ENABLED
+    SPI_EVENT_HANDLER(2)
+#endif
+
+static nrf_drv_spi_handler_t const m_event_handlers[SPI_COUNT] = {
+#if SPI0_ENABLED
+    SPI_EVENT_HANDLER_NAME(0),
+#endif
+#if SPI1_ENABLED
+    SPI_EVENT_HANDLER_NAME(1),
+#endif
+#if SPI2_ENABLED
+    SPI_EVENT_HANDLER_NAME(2),
+#endif
+};
+
+
+ret_code_t app_spi_init(app_spi_t *                     p_app_spi,
+                        nrf_drv_spi_config_t const *    p_spi_config,
+                        uint8_t                         queue_size,
+                        app_spi_transaction_t const * * p_queue_buffer)
+{
+    ASSERT(p_app_spi != NULL);
+    ASSERT(queue_size != 0);
+    ASSERT(p_queue_buffer != NULL);
+
+    ret_code_t err_code;
+    uint8_t    inst_idx = p_app_spi->spi.drv_inst_idx;
+
+    mp_instances[inst_idx] = p_app_spi;
+
+    err_code = nrf_drv_spi_init(&p_app_spi->spi,
+                                p_spi_config,
+                                m_event_handlers[inst_idx]);
+    VERIFY_SUCCESS(err_code);
+
+    p_app_spi->queue.p_buffer  = p_queue_buffer;
+    p_app_spi->queue.size      = queue_size;
+    p_app_spi->queue.read_idx  = 0;
+    p_app_spi->queue.write_idx = 0;
+
+    p_app_spi->internal_transaction_in_progress = false;
+    p_app_spi->p_current_transaction            = NULL;
+
+#if APP_SPI_REPEAT_ENABLED
+    p_app_spi->p_repeat     = NULL;
+    p_app_spi->irq_priority = (p_spi_config != NULL) ? p_spi_config->irq_priority :
+                                                       APP_IRQ_PRIORITY_LOW;
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+#if APP_SPI_REPEAT_ENABLED
+static void repeat_release(app_spi_t * p_app_spi)
+{
+    app_spi_repeat_t const * p_repeat = p_app_spi->p_repeat;
+    uint8_t i;
+
+    for (i = 0; i < APP_SPI_REPEAT_PPI_CHANNELS; ++i)
+    {
+        (void)nrf_drv_ppi_channel_disable(p_app_spi->ppi_channels[i]);
+        (void)nrf_drv_ppi_channel_free(p_app_spi->ppi_channels[i]);
+    }
+
+    nrf_drv_timer_uninit(p_repeat->p_interval_timer);
+    nrf_drv_timer_uninit(p_repeat->p_counter_timer);
+
+    if (p_repeat->cs_pin != NRF_DRV_SPI_PIN_NOT_USED)
+    {
+        nrf_drv_gpiote_out_task_disable(p_repeat->cs_pin);
+        nrf_drv_gpiote_out_uninit(p_repeat->cs_pin);
+        nrf_gpio_pin_set(p_repeat->cs_pin);
+        nrf_gpio_cfg_output(p_repeat->cs_pin);
+    }
+
+    p_app_spi->p_repeat = NULL;
+}
+
+
+static void repeat_counter_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    app_spi_t * p_app_spi = (app_spi_t *)p_context;
+
+    if ((event_type == NRF_TIMER_EVENT_COMPARE0) && (p_app_spi->p_repeat != NULL))
+    {
+        // The interval timer has already been stopped through PPI.
+        repeat_release(p_app_spi);
+
+        signal_end_of_transaction(p_app_spi, NRF_SUCCESS);
+        start_pending_transaction(p_app_spi, true);
+    }
+}
+
+
+static void repeat_interval_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+
+// Sets up the following connections:
+// - interval timer COMPARE0 -> SPIM START, CS toggle (activate),
+// - SPIM END                -> counter timer COUNT, CS toggle (deactivate),
+// - counter timer COMPARE0  -> interval timer STOP.
+static ret_code_t repeat_setup(app_spi_t * p_app_spi)
+{
+    app_spi_repeat_t const * p_repeat = p_app_spi->p_repeat;
+    nrf_drv_timer_config_t   timer_config;
+    uint32_t                 cs_task = 0;
+    ret_code_t               err_code;
+    uint8_t                  i;
+
+    err_code = nrf_drv_ppi_init();
+    if ((err_code != NRF_SUCCESS) && (err_code != MODULE_ALREADY_INITIALIZED))
+    {
+        return err_code;
+    }
+
+    if (p_repeat->cs_pin != NRF_DRV_SPI_PIN_NOT_USED)
+    {
+        nrf_drv_gpiote_out_config_t cs_config = GPIOTE_CONFIG_OUT_TASK_TOGGLE(true);
+
+        if (!nrf_drv_gpiote_is_init())
+        {
+            err_code = nrf_drv_gpiote_init();
+            VERIFY_SUCCESS(err_code);
+        }
+
+        err_code = nrf_drv_gpiote_out_init(p_repeat->cs_pin, &cs_config);
+        VERIFY_SUCCESS(err_code);
+
+        nrf_drv_gpiote_out_task_enable(p_repeat->cs_pin);
+        cs_task = nrf_drv_gpiote_out_task_addr_get(p_repeat->cs_pin);
+    }
+
+    timer_config.frequency          = NRF_TIMER_FREQ_1MHz;
+    timer_config.mode               = NRF_TIMER_MODE_TIMER;
+    timer_config.bit_width          = NRF_TIMER_BIT_WIDTH_32;
+    timer_config.interrupt_priority = p_app_spi->irq_priority;
+    timer_config.p_context          = p_app_spi;
+    err_code = nrf_drv_timer_init(p_repeat->p_interval_timer, &timer_config,
+                                  repeat_interval_handler);
+    if (err_code == NRF_SUCCESS)
+    {
+        timer_config.mode = NRF_TIMER_MODE_COUNTER;
+        err_code = nrf_drv_timer_init(p_repeat->p_counter_timer, &timer_config,
+                                      repeat_counter_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            nrf_drv_timer_uninit(p_repeat->p_interval_timer);
+        }
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        if (p_repeat->cs_pin != NRF_DRV_SPI_PIN_NOT_USED)
+        {
+            nrf_drv_gpiote_out_uninit(p_repeat->cs_pin);
+        }
+        return err_code;
+    }
+
+    for (i = 0; i < APP_SPI_REPEAT_PPI_CHANNELS; ++i)
+    {
+        err_code = nrf_drv_ppi_channel_alloc(&p_app_spi->ppi_channels[i]);
+        if (err_code != NRF_SUCCESS)
+        {
+            while (i-- > 0)
+            {
+                (void)nrf_drv_ppi_channel_free(p_app_spi->ppi_channels[i]);
+            }
+            nrf_drv_timer_uninit(p_repeat->p_interval_timer);
+            nrf_drv_timer_uninit(p_repeat->p_counter_timer);
+            if (p_repeat->cs_pin != NRF_DRV_SPI_PIN_NOT_USED)
+            {
+                nrf_drv_gpiote_out_uninit(p_repeat->cs_pin);
+            }
+            return err_code;
+        }
+    }
+
+    nrf_drv_timer_extended_compare(p_repeat->p_interval_timer,
+        NRF_TIMER_CC_CHANNEL0,
+        nrf_drv_timer_us_to_ticks(p_repeat->p_interval_timer, p_repeat->interval_us),
+        NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
+        false);
+    nrf_drv_timer_extended_compare(p_repeat->p_counter_timer,
+        NRF_TIMER_CC_CHANNEL0,
+        p_repeat->count,
+        NRF_TIMER_SHORT_COMPARE0_STOP_MASK,
+        true);
+
+    // [the timers have to be powered on to be uninitialized properly - pause
+    //  the interval timer right away, it is started below when everything is
+    //  connected]
+    nrf_drv_timer_enable(p_repeat->p_interval_timer);
+    nrf_drv_timer_pause(p_repeat->p_interval_timer);
+    nrf_drv_timer_clear(p_repeat->p_interval_timer);
+    nrf_drv_timer_enable(p_repeat->p_counter_timer);
+    nrf_drv_timer_clear(p_repeat->p_counter_timer);
+
+    err_code = nrf_drv_ppi_channel_assign(p_app_spi->ppi_channels[0],
+        nrf_drv_timer_compare_event_address_get(p_repeat->p_interval_timer, 0),
+        nrf_drv_spi_start_task_get(&p_app_spi->spi));
+    if ((err_code == NRF_SUCCESS) && cs_task)
+    {
+        err_code = nrf_drv_ppi_channel_fork_assign(p_app_spi->ppi_channels[0], cs_task);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_assign(p_app_spi->ppi_channels[1],
+            nrf_drv_spi_end_event_get(&p_app_spi->spi),
+            nrf_drv_timer_task_address_get(p_repeat->p_counter_timer, NRF_TIMER_TASK_COUNT));
+    }
+    if ((err_code == NRF_SUCCESS) && cs_task)
+    {
+        err_code = nrf_drv_ppi_channel_fork_assign(p_app_spi->ppi_channels[1], cs_task);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_assign(p_app_spi->ppi_channels[2],
+            nrf_drv_timer_compare_event_address_get(p_repeat->p_counter_timer, 0),
+            nrf_drv_timer_task_address_get(p_repeat->p_interval_timer, NRF_TIMER_TASK_STOP));
+    }
+    for (i = 0; (err_code == NRF_SUCCESS) && (i < APP_SPI_REPEAT_PPI_CHANNELS); ++i)
+    {
+        err_code = nrf_drv_ppi_channel_enable(p_app_spi->ppi_channels[i]);
+    }
+
+    if (err_code != NRF_SUCCESS)
+    {
+        repeat_release(p_app_spi);
+    }
+    return err_code;
+}
+
+
+ret_code_t app_spi_repeat_start(app_spi_t *              p_app_spi,
+                                app_spi_repeat_t const * p_repeat)
+{
+    ASSERT(p_app_spi != NULL);
+    ASSERT(p_repeat != NULL);
+    ASSERT(p_repeat->count != 0);
+    ASSERT(p_repeat->p_interval_timer != NULL);
+    ASSERT(p_repeat->p_counter_timer != NULL);
+
+    ret_code_t result;
+    bool       busy = false;
+
+    // Array list mode is needed to store the data from consecutive transfers.
+#ifdef NRF52_PAN_46
+    bool       list_supported = false;
+#else
+    bool       list_supported = p_app_spi->spi.use_easy_dma;
+#endif
+    if (!list_supported)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    p_app_spi->repeat_transaction.callback            = p_repeat->callback;
+    p_app_spi->repeat_transaction.p_user_data         = p_repeat->p_user_data;
+    p_app_spi->repeat_transaction.p_transfers         = NULL;
+    p_app_spi->repeat_transaction.number_of_transfers = 0;
+
+    // Occupy the bus, so that scheduled transactions wait in the queue.
+    CRITICAL_REGION_ENTER();
+    if (!app_spi_is_idle(p_app_spi))
+    {
+        busy = true;
+    }
+    else
+    {
+        p_app_spi->p_current_transaction = &p_app_spi->repeat_transaction;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    p_app_spi->p_repeat = p_repeat;
+    result = repeat_setup(p_app_spi);
+
+    if (result == NRF_SUCCESS)
+    {
+        nrf_drv_spi_xfer_desc_t xfer_desc =
+            NRF_DRV_SPI_XFER_TRX(p_repeat->p_tx_data, p_repeat->tx_length,
+                                 p_repeat->p_rx_list, p_repeat->rx_length);
+
+        result = nrf_drv_spi_xfer(&p_app_spi->spi, &xfer_desc,
+                                  NRF_DRV_SPI_FLAG_RX_POSTINC         |
+                                  NRF_DRV_SPI_FLAG_HOLD_XFER          |
+                                  NRF_DRV_SPI_FLAG_REPEATED_XFER      |
+                                  NRF_DRV_SPI_FLAG_NO_XFER_EVT_HANDLER);
+        if (result == NRF_SUCCESS)
+        {
+            nrf_drv_timer_resume(p_repeat->p_interval_timer);
+            return NRF_SUCCESS;
+        }
+        repeat_release(p_app_spi);
+    }
+    else
+    {
+        p_app_spi->p_repeat = NULL;
+    }
+
+    // Release the bus and start transactions that were scheduled in the meantime.
+    start_pending_transaction(p_app_spi, true);
+    return result;
+}
+#endif // APP_SPI_REPEAT_ENABLED
+
+
+void app_spi_uninit(app_spi_t * p_app_spi)
+{
+    ASSERT(p_app_spi != NULL);
+
+#if APP_SPI_REPEAT_ENABLED
+    if (p_app_spi->p_repeat != NULL)
+    {
+        repeat_release(p_app_spi);
+    }
+#endif
+
+    nrf_drv_spi_uninit(&(p_app_spi->spi));
+
+    p_app_spi->p_current_transaction = NULL;
+}
+
+
+ret_code_t app_spi_schedule(app_spi_t *                   p_app_spi,
+                            app_spi_transaction_t const * p_transaction)
+{
+    ASSERT(p_app_spi != NULL);
+    ASSERT(p_transaction != NULL);
+    ASSERT(p_transaction->p_transfers != NULL);
+    ASSERT(p_transaction->number_of_transfers != 0);
+
+    ret_code_t result = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (!queue_put(&p_app_spi->queue, p_transaction))
+    {
+        result = NRF_ERROR_BUSY;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (result == NRF_SUCCESS)
+    {
+        // New transaction has been successfully added to queue,
+        // so if we are currently idle it's time to start the job.
+        start_pending_transaction(p_app_spi, false);
+    }
+
+    return result;
+}
+
+
+static void internal_transaction_cb(ret_code_t result, void * p_user_data)
+{
+    app_spi_t * p_app_spi = (app_spi_t *)p_user_data;
+
+    p_app_spi->internal_transaction_result      = result;
+    p_app_spi->internal_transaction_in_progress = false;
+}
+
+
+ret_code_t app_spi_perform(app_spi_t *                p_app_spi,
+                           app_spi_transfer_t const * p_transfers,
+                           uint8_t                    number_of_transfers,
+                           void (* user_function)(void))
+{
+    ASSERT(p_app_spi != NULL);
+    ASSERT(p_transfers != NULL);
+    ASSERT(number_of_transfers != 0);
+
+    bool busy = false;
+
+    CRITICAL_REGION_ENTER();
+    if (p_app_spi->internal_transaction_in_progress)
+    {
+        busy = true;
+    }
+    else
+    {
+        p_app_spi->internal_transaction_in_progress = true;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+    else
+    {
+        app_spi_transaction_t internal_transaction =
+        {
+            .callback            = internal_transaction_cb,
+            .p_user_data         = p_app_spi,
+            .p_transfers         = p_transfers,
+            .number_of_transfers = number_of_transfers,
+        };
+        ret_code_t result = app_spi_schedule(p_app_spi, &internal_transaction);
+        if (result != NRF_SUCCESS)
+        {
+            p_app_spi->internal_transaction_in_progress = false;
+            return result;
+        }
+
+        while (p_app_spi->internal_transaction_in_progress)
+        {
+            if (user_function)
+            {
+                user_function();
+            }
+        }
+
+        return p_app_spi->internal_transaction_result;
+    }
+}
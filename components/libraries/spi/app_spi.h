@@ -0,0 +1,398 @@
+/* Copyright (c) 2015 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_SPI_H__
+#define APP_SPI_H__
+
+#include <stdint.h>
+#include "nrf_drv_spi.h"
+#include "sdk_errors.h"
+
+/**
+ * @brief Enable repeated transfers triggered by TIMER and PPI (SPIM only).
+ *
+ * @ref app_spi_repeat_start uses two TIMER instances, three PPI channels, and
+ * one GPIOTE channel, so the timer, PPI, and GPIOTE drivers must be included in
+ * the project when this option is enabled.
+ */
+#ifndef APP_SPI_REPEAT_ENABLED
+#define APP_SPI_REPEAT_ENABLED 0
+#endif
+
+#if APP_SPI_REPEAT_ENABLED
+#include "nrf_drv_timer.h"
+#include "nrf_drv_ppi.h"
+#endif
+
+/**
+ * @defgroup app_spi SPI transaction manager
+ * @{
+ * @ingroup app_common
+ *
+ * @brief Module for scheduling SPI transactions.
+ */
+
+/**
+ * @brief Flag indicating that the chip select line should stay active
+ *        after a given transfer.
+ *
+ * Use this flag when the slave device requires several transfers to be made
+ * within one chip select period, for example, when the first transfer sends
+ * a command and the second one reads the response. The chip select line is
+ * always deactivated after the last transfer in a transaction.
+ */
+#define APP_SPI_CS_HOLD     0x01
+
+#if APP_SPI_REPEAT_ENABLED
+/**@brief Number of PPI channels occupied by a repeated transfer. */
+#define APP_SPI_REPEAT_PPI_CHANNELS 3
+#endif
+
+/**
+ * @brief Macro for creating a transfer that sends and receives data
+ *        at the same time.
+ *
+ * @param     cs_pin    Chip select pin of the slave device (active low), or
+ *                      @ref NRF_DRV_SPI_PIN_NOT_USED.
+ * @param[in] p_tx_data Pointer to the data to be sent.
+ * @param     tx_length Number of bytes to send.
+ * @param[in] p_rx_data Pointer to the buffer where received data should be placed.
+ * @param     rx_length Number of bytes to receive.
+ * @param     flags     Transfer flags (see @ref APP_SPI_CS_HOLD).
+ */
+#define APP_SPI_TRANSFER(_cs_pin, _p_tx_data, _tx_length, _p_rx_data, _rx_length, _flags) \
+{                                               \
+    .p_tx_data = (uint8_t const *)(_p_tx_data), \
+    .p_rx_data = (uint8_t *)(_p_rx_data),       \
+    .tx_length = _tx_length,                    \
+    .rx_length = _rx_length,                    \
+    .cs_pin    = _cs_pin,                       \
+    .flags     = _flags                         \
+}
+
+/**
+ * @brief Macro for creating a write transfer.
+ *
+ * @param     cs_pin Chip select pin of the slave device.
+ * @param[in] p_data Pointer to the data to be sent.
+ * @param     length Number of bytes to transfer.
+ * @param     flags  Transfer flags (see @ref APP_SPI_CS_HOLD).
+ */
+#define APP_SPI_WRITE(cs_pin, p_data, length, flags) \
+    APP_SPI_TRANSFER(cs_pin, p_data, length, NULL, 0, flags)
+
+/**
+ * @brief Macro for creating a read transfer.
+ *
+ * @param     cs_pin Chip select pin of the slave device.
+ * @param[in] p_data Pointer to the buffer where received data should be placed.
+ * @param     length Number of bytes to transfer.
+ * @param     flags  Transfer flags (see @ref APP_SPI_CS_HOLD).
+ */
+#define APP_SPI_READ(cs_pin, p_data, length, flags) \
+    APP_SPI_TRANSFER(cs_pin, NULL, 0, p_data, length, flags)
+
+/**
+ * @brief SPI transaction callback prototype.
+ *
+ * @param     result      Result of operation (NRF_SUCCESS on success,
+ *                        otherwise a relevant error code).
+ * @param[in] p_user_data Pointer to user data defined in transaction
+ *                        descriptor.
+ */
+typedef void (* app_spi_callback_t)(ret_code_t result, void * p_user_data);
+
+/**
+ * @brief SPI transfer descriptor.
+ */
+typedef struct {
+    uint8_t const * p_tx_data; ///< Pointer to the data to be sent.
+    uint8_t       * p_rx_data; ///< Pointer to the buffer for received data.
+    uint8_t         tx_length; ///< Number of bytes to send.
+    uint8_t         rx_length; ///< Number of bytes to receive.
+    uint8_t         cs_pin;    ///< Chip select pin (active low), or @ref NRF_DRV_SPI_PIN_NOT_USED.
+    uint8_t         flags;     ///< Transfer flags (see @ref APP_SPI_CS_HOLD).
+} app_spi_transfer_t;
+
+/**
+ * @brief SPI transaction descriptor.
+ */
+typedef struct {
+    app_spi_callback_t         callback;
+    ///< User-specified function to be called after the transaction is finished.
+
+    void *                     p_user_data;
+    ///< Pointer to user data to be passed to the callback.
+
+    app_spi_transfer_t const * p_transfers;
+    ///< Pointer to the array of transfers that make up the transaction.
+
+    uint8_t                    number_of_transfers;
+    ///< Number of transfers that make up the transaction.
+} app_spi_transaction_t;
+
+#if APP_SPI_REPEAT_ENABLED
+/**
+ * @brief Descriptor of a sequence of repeated transfers.
+ *
+ * Every transfer sends the same data and stores the received data in the next
+ * element of an array list, so that after the sequence is finished the buffer
+ * holds count * rx_length bytes.
+ */
+typedef struct {
+    app_spi_callback_t      callback;
+    ///< User-specified function to be called after the last transfer.
+
+    void *                  p_user_data;
+    ///< Pointer to user data to be passed to the callback.
+
+    uint8_t const *         p_tx_data;
+    ///< Data sent in every transfer, for example, a register read command.
+
+    uint8_t *               p_rx_list;
+    ///< Buffer for received data, count * rx_length bytes.
+
+    uint8_t                 tx_length;
+    ///< Number of bytes sent in every transfer.
+
+    uint8_t                 rx_length;
+    ///< Number of bytes received in every transfer.
+
+    uint8_t                 cs_pin;
+    ///< Chip select pin (active low), or @ref NRF_DRV_SPI_PIN_NOT_USED.
+
+    uint32_t                count;
+    ///< Number of transfers.
+
+    uint32_t                interval_us;
+    ///< Time between the starts of consecutive transfers.
+
+    nrf_drv_timer_t const * p_interval_timer;
+    ///< Timer instance that triggers the transfers.
+
+    nrf_drv_timer_t const * p_counter_timer;
+    ///< Timer instance that counts finished transfers.
+} app_spi_repeat_t;
+#endif
+
+/**
+ * @brief SPI transaction queue.
+ */
+typedef struct {
+    app_spi_transaction_t const * volatile * p_buffer;
+    uint8_t          size;
+    uint8_t volatile read_idx;
+    uint8_t volatile write_idx;
+} app_spi_queue_t;
+
+/**
+ * @brief SPI transaction manager instance.
+ */
+typedef struct {
+    app_spi_queue_t  queue;
+    ///< Transaction queue.
+
+    uint8_t volatile current_transfer_idx;
+    ///< Index of currently performed transfer (within current transaction).
+
+    bool    volatile internal_transaction_in_progress;
+    ///< Informs that an internal transaction is being performed (by app_spi_perform()).
+
+    ret_code_t volatile internal_transaction_result;
+    ///< Used to pass the result of the internal transaction realized by app_spi_perform().
+
+    app_spi_transaction_t const * volatile p_current_transaction;
+    ///< Currently realized transaction.
+
+#if APP_SPI_REPEAT_ENABLED
+    app_spi_repeat_t const * volatile p_repeat;
+    ///< Currently realized sequence of repeated transfers.
+
+    app_spi_transaction_t repeat_transaction;
+    ///< Transaction that occupies the bus while repeated transfers are performed.
+
+    nrf_ppi_channel_t ppi_channels[APP_SPI_REPEAT_PPI_CHANNELS];
+    ///< PPI channels used by repeated transfers.
+
+    uint8_t irq_priority;
+    ///< Interrupt priority of the SPI master driver instance.
+#endif
+
+    nrf_drv_spi_t const spi;
+    ///< SPI master driver instance.
+} app_spi_t;
+
+/**
+ * @brief Macro for creating an instance of the SPI transaction manager.
+ *
+ * @param[in] spi_idx Index of the SPI master driver instance to be utilized
+ *                    by this manager instance.
+ */
+#define APP_SPI_INSTANCE(spi_idx) \
+{                                        \
+    .spi = NRF_DRV_SPI_INSTANCE(spi_idx) \
+}
+
+/**
+ * @brief Macro that simplifies the initialization of an SPI transaction manager
+ *        instance.
+ *
+ * This macro allocates a static buffer for the transaction queue.
+ * Therefore, it should be used in only one place in the code for a given
+ * instance.
+ *
+ * @param[in]  p_app_spi    Pointer to the instance to be initialized.
+ * @param[in]  p_spi_config Pointer to the SPI master driver configuration.
+ * @param      queue_size   Size of the transaction queue (maximum number
+ *                          of pending transactions).
+ *                          See @ref app_spi_init_note "this note".
+ * @param[out] err_code     The result of the app_spi_init() function call
+ *                          is written to this parameter.
+ */
+#define APP_SPI_INIT(p_app_spi, p_spi_config, queue_size, err_code) \
+    do {                                                                   \
+        static app_spi_transaction_t const * queue_buffer[queue_size + 1]; \
+        err_code = app_spi_init(p_app_spi, p_spi_config,                   \
+                                queue_size, queue_buffer);                 \
+    } while (0)
+
+/**
+ * @brief Function for initializing an SPI transaction manager instance.
+ *
+ * This function initializes the utilized SPI master driver instance and
+ * prepares the transaction queue.
+ *
+ * Chip select lines are controlled by the manager, separately for every
+ * transfer. The Slave Select pin in the driver configuration should therefore
+ * be set to @ref NRF_DRV_SPI_PIN_NOT_USED.
+ *
+ * @anchor app_spi_init_note
+ * @note The queue size is the maximum number of pending transactions
+ *       not counting the one that is currently realized. This means that
+ *       for an empty queue with size of, for example, 4 elements, it is
+ *       possible to schedule up to 5 transactions.
+ *
+ * @param[in] p_app_spi      Pointer to the instance to be initialized.
+ * @param[in] p_spi_config   Pointer to the SPI master driver configuration.
+ * @param     queue_size     Size of the transaction queue (maximum number
+ *                           of pending transactions).
+ * @param[in] p_queue_buffer Pointer to a buffer for queued transactions
+ *                           storage. Due to the queue implementation, the buffer must
+ *                           be big enough to hold queue_size + 1 entries
+ *                           (pointers to transaction descriptors).
+ *
+ * @retval NRF_SUCCESS If initialization was successful. Otherwise, the error code
+ *         returned by the nrf_drv_spi_init() function is returned.
+ */
+ret_code_t app_spi_init(app_spi_t *                     p_app_spi,
+                        nrf_drv_spi_config_t const *    p_spi_config,
+                        uint8_t                         queue_size,
+                        app_spi_transaction_t const * * p_queue_buffer);
+
+/**
+ * @brief Function for uninitializing an SPI transaction manager instance.
+ *
+ * @param[in] p_app_spi Pointer to the instance to be uninitialized.
+ */
+void       app_spi_uninit(app_spi_t * p_app_spi);
+
+/**
+ * @brief Function for scheduling an SPI transaction.
+ *
+ * The transaction is enqueued and started as soon as the SPI bus is
+ * available, thus when all previously scheduled transactions have been
+ * finished (possibly immediately).
+ *
+ * @param[in] p_app_spi     Pointer to the SPI transaction manager instance.
+ * @param[in] p_transaction Pointer to the descriptor of the transaction to be
+ *                          scheduled.
+ *
+ * @retval NRF_SUCCESS    If the transaction has been successfully scheduled.
+ * @retval NRF_ERROR_BUSY If the limit of pending transactions has been reached
+ *                        (the transaction queue is full).
+ */
+ret_code_t app_spi_schedule(app_spi_t *                   p_app_spi,
+                            app_spi_transaction_t const * p_transaction);
+
+/**
+ * @brief Function for scheduling a transaction and waiting until it is finished.
+ *
+ * This function schedules a transaction that consists of one or more transfers
+ * and waits until it is finished.
+ *
+ * @param[in] p_app_spi           Pointer to the SPI transaction manager instance.
+ * @param[in] p_transfers         Pointer to an array of transfers to be performed.
+ * @param     number_of_transfers Number of transfers to be performed.
+ * @param     user_function       User-specified function to be called while
+ *                                waiting. NULL if such functionality
+ *                                is not needed.
+ *
+ * @retval NRF_SUCCESS    If the transfers have been successfully realized.
+ * @retval NRF_ERROR_BUSY If some transfers are already performed (if this function
+ *                        was called from another context).
+ * @retval -              Other error codes mean that the transaction has ended
+ *                        with the error that is specified in the error code.
+ */
+ret_code_t app_spi_perform(app_spi_t *                p_app_spi,
+                           app_spi_transfer_t const * p_transfers,
+                           uint8_t                    number_of_transfers,
+                           void (* user_function)(void));
+
+#if APP_SPI_REPEAT_ENABLED
+/**
+ * @brief Function for starting a sequence of repeated transfers.
+ *
+ * The transfer is set up once, in EasyDMA array list mode for reception, and
+ * then started by the interval timer through PPI. The chip select line is
+ * driven by GPIOTE tasks connected to the same PPI channels. Finished transfers
+ * are counted by the counter timer, which stops the interval timer after the
+ * last one. The CPU is not involved until the whole sequence is finished and
+ * the callback is called.
+ *
+ * The first transfer is started one interval after this function is called.
+ * The interval must be longer than a single transfer.
+ *
+ * Transactions scheduled during the sequence are started after it is finished.
+ *
+ * @param[in] p_app_spi Pointer to the SPI transaction manager instance.
+ * @param[in] p_repeat  Pointer to the descriptor of the sequence. It must stay
+ *                      valid until the callback is called.
+ *
+ * @retval NRF_SUCCESS             If the sequence has been started.
+ * @retval NRF_ERROR_BUSY          If the bus is not idle.
+ * @retval NRF_ERROR_NOT_SUPPORTED If the SPI instance does not use EasyDMA.
+ * @retval -                       Other error codes are returned by the timer, PPI,
+ *                                 GPIOTE, or SPI master driver.
+ */
+ret_code_t app_spi_repeat_start(app_spi_t *              p_app_spi,
+                                app_spi_repeat_t const * p_repeat);
+#endif
+
+/**
+ * @brief Function for getting the current state of an SPI transaction manager
+ *        instance.
+ *
+ * @param[in] p_app_spi Pointer to the SPI transaction manager instance.
+ *
+ * @retval true  If all scheduled transactions have been finished.
+ * @retval false Otherwise.
+ */
+__STATIC_INLINE bool app_spi_is_idle(app_spi_t * p_app_spi)
+{
+    return (p_app_spi->p_current_transaction == NULL);
+}
+
+/**
+ *@}
+ **/
+
+#endif // APP_SPI_H__
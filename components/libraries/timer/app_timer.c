@@ -17,6 +17,8 @@
 #include "app_error.h"
 #include "nrf_delay.h"
 #include "app_util_platform.h"
+#include "app_profiler.h"
+#include "nrf_drv_common.h"
 #include "sdk_common.h"
 
 #define RTC1_IRQ_PRI            APP_IRQ_PRIORITY_LOW                        /**< Priority of the RTC1 interrupt (used for checking for timeouts and executing timeout handlers). */
@@ -45,15 +47,25 @@ STATIC_ASSERT(RTC1_IRQ_PRI == SWI_IRQ_PRI);
 #define SWI_IRQHandler SWI0_EGU0_IRQHandler
 #endif
 
-/**@brief Timer node type. The nodes will be used form a linked list of running timers. */
+/**@brief Timer node type. The nodes will be used form a linked list of running timers.
+ *
+ * @details When APP_TIMER_HEAP_SIZE is defined, the running timers are kept in a binary min-heap
+ *          instead, and ticks_to_expire holds the absolute RTC counter value at timer expiry.
+ */
 typedef struct
 {
-    uint32_t                    ticks_to_expire;                            /**< Number of ticks from previous timer interrupt to timer expiry. */
+    uint32_t                    ticks_to_expire;                            /**< Number of ticks from previous timer interrupt to timer expiry (RTC counter value at expiry when using the heap). */
     uint32_t                    ticks_at_start;                             /**< Current RTC counter value when the timer was started. */
     uint32_t                    ticks_first_interval;                       /**< Number of ticks in the first timer interval. */
     uint32_t                    ticks_periodic_interval;                    /**< Timer period (for repeating timers). */
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    uint32_t                    ticks_slack;                                /**< Number of ticks the timer expiry may be delayed by to share an RTC1 wakeup with other timers. */
+#endif
     bool                        is_running;                                 /**< True if timer is running, False otherwise. */
     app_timer_mode_t            mode;                                       /**< Timer mode. */
+#ifdef APP_TIMER_HEAP_SIZE
+    uint16_t                    heap_index;                                 /**< Position of the node in the heap of running timers. */
+#endif
     app_timer_timeout_handler_t p_timeout_handler;                          /**< Pointer to function to be executed when the timer expires. */
     void *                      p_context;                                  /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
     void *                      next;                                       /**< Pointer to the next node. */
@@ -76,6 +88,9 @@ typedef struct
     uint32_t ticks_at_start;                                                /**< Current RTC counter value when the timer was started. */
     uint32_t ticks_first_interval;                                          /**< Number of ticks in the first timer interval. */
     uint32_t ticks_periodic_interval;                                       /**< Timer period (for repeating timers). */
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    uint32_t ticks_slack;                                                   /**< Allowed delay of each timer expiry. */
+#endif
     void *   p_context;                                                     /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
 } timer_user_op_start_t;
 
@@ -93,6 +108,17 @@ typedef struct
 STATIC_ASSERT(sizeof(timer_user_op_t) <= APP_TIMER_USER_OP_SIZE);
 STATIC_ASSERT(sizeof(timer_user_op_t) % 4 == 0);
 
+/**@brief Function for getting the number of ticks the expiry of a timer may be delayed by. */
+static __INLINE uint32_t timer_slack_get(timer_node_t const * p_timer)
+{
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    return p_timer->ticks_slack;
+#else
+    UNUSED_PARAMETER(p_timer);
+    return 0;
+#endif
+}
+
 /**@brief Structure describing a timer user.
  *
  * @details For each user of the timer module, there will be a timer operations queue. This queue
@@ -125,7 +151,13 @@ typedef uint32_t timer_user_id_t;
 
 static uint8_t                       m_user_array_size;                         /**< Size of timer user array. */
 static timer_user_t *                mp_users = NULL;                           /**< Array of timer users. */
+#ifdef APP_TIMER_HEAP_SIZE
+static timer_node_t *                m_timer_heap[APP_TIMER_HEAP_SIZE];         /**< Binary min-heap of running timers, ordered by expiry. */
+static uint16_t                      m_timer_heap_count;                        /**< Number of timers in the heap. */
+static uint32_t                      m_timer_heap_ref;                          /**< RTC counter value which no running timer expires before. Heap keys are relative to it. */
+#else
 static timer_node_t *                mp_timer_id_head;                          /**< First timer in list of running timers. */
+#endif
 static uint32_t                      m_ticks_latest;                            /**< Last known RTC counter value. */
 static uint32_t                      m_ticks_elapsed[CONTEXT_QUEUE_SIZE_MAX];   /**< Timer internal elapsed ticks queue. */
 static uint8_t                       m_ticks_elapsed_q_read_ind;                /**< Timer internal elapsed ticks queue read index. */
@@ -220,6 +252,237 @@ static __INLINE void rtc1_compare0_set(uint32_t value)
 }
 
 
+#ifdef APP_TIMER_HEAP_SIZE
+/**@brief Function for getting the heap key of a running timer.
+ *
+ * @return     Number of ticks from m_timer_heap_ref to timer expiry.
+ */
+static __INLINE uint32_t heap_key_get(timer_node_t const * p_timer)
+{
+    return ticks_diff_get(p_timer->ticks_to_expire, m_timer_heap_ref);
+}
+
+
+/**@brief Function for placing a timer at a given position in the heap.
+ */
+static __INLINE void heap_node_set(uint16_t index, timer_node_t * p_timer)
+{
+    m_timer_heap[index] = p_timer;
+    p_timer->heap_index = index;
+}
+
+
+/**@brief Function for moving a timer towards the root of the heap until its parent expires first.
+ *
+ * @param[in]  index   Position of the timer in the heap.
+ */
+static void heap_sift_up(uint16_t index)
+{
+    timer_node_t * p_timer = m_timer_heap[index];
+    uint32_t       key     = heap_key_get(p_timer);
+
+    while (index > 0)
+    {
+        uint16_t parent = (index - 1) / 2;
+
+        if (heap_key_get(m_timer_heap[parent]) <= key)
+        {
+            break;
+        }
+
+        heap_node_set(index, m_timer_heap[parent]);
+        index = parent;
+    }
+
+    heap_node_set(index, p_timer);
+}
+
+
+/**@brief Function for moving a timer towards the leaves of the heap until it expires before its children.
+ *
+ * @param[in]  index   Position of the timer in the heap.
+ */
+static void heap_sift_down(uint16_t index)
+{
+    timer_node_t * p_timer = m_timer_heap[index];
+    uint32_t       key     = heap_key_get(p_timer);
+
+    for (;;)
+    {
+        uint32_t child = 2 * (uint32_t)index + 1;
+
+        if (child >= m_timer_heap_count)
+        {
+            break;
+        }
+
+        if ((child + 1 < m_timer_heap_count) &&
+            (heap_key_get(m_timer_heap[child + 1]) < heap_key_get(m_timer_heap[child])))
+        {
+            child++;
+        }
+
+        if (key <= heap_key_get(m_timer_heap[child]))
+        {
+            break;
+        }
+
+        heap_node_set(index, m_timer_heap[child]);
+        index = (uint16_t)child;
+    }
+
+    heap_node_set(index, p_timer);
+}
+
+
+/**@brief Function for removing the timer at a given position from the heap.
+ *
+ * @param[in]  index   Position of the timer in the heap.
+ */
+static void heap_remove(uint16_t index)
+{
+    m_timer_heap_count--;
+
+    if (index < m_timer_heap_count)
+    {
+        timer_node_t * p_last = m_timer_heap[m_timer_heap_count];
+
+        heap_node_set(index, p_last);
+
+        if ((index > 0) && (heap_key_get(p_last) < heap_key_get(m_timer_heap[(index - 1) / 2])))
+        {
+            heap_sift_up(index);
+        }
+        else
+        {
+            heap_sift_down(index);
+        }
+    }
+}
+
+
+/**@brief Function for inserting a timer in the timer heap.
+ *
+ * @param[in]  p_timer   Timer to insert. Its ticks_to_expire is relative to m_ticks_latest.
+ */
+static void timer_list_insert(timer_node_t * p_timer)
+{
+    if (m_timer_heap_count == APP_TIMER_HEAP_SIZE)
+    {
+        // More timers running than APP_TIMER_HEAP_SIZE allows for.
+        APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
+        return;
+    }
+
+    if (m_timer_heap_count == 0)
+    {
+        m_timer_heap_ref = m_ticks_latest;
+    }
+
+    p_timer->ticks_to_expire = (m_ticks_latest + p_timer->ticks_to_expire) & MAX_RTC_COUNTER_VAL;
+
+    heap_node_set(m_timer_heap_count, p_timer);
+    m_timer_heap_count++;
+    heap_sift_up(p_timer->heap_index);
+}
+
+
+/**@brief Function for removing a timer from the timer heap.
+ *
+ * @param[in]  timer_id   Id of timer to remove.
+ *
+ * @return     TRUE if the last timer was removed from the heap, FALSE otherwise.
+ */
+static bool timer_list_remove(timer_node_t * p_timer)
+{
+    uint16_t index = p_timer->heap_index;
+
+    // Timer not in active heap.
+    if ((index >= m_timer_heap_count) || (m_timer_heap[index] != p_timer))
+    {
+        return false;
+    }
+
+    heap_remove(index);
+
+    return (m_timer_heap_count == 0);
+}
+
+
+/**@brief Function for removing all timers from the timer heap, marking them as not running.
+ */
+static void timer_list_clear(void)
+{
+    while (m_timer_heap_count != 0)
+    {
+        m_timer_heap[--m_timer_heap_count]->is_running = false;
+    }
+}
+
+
+/**@brief Function for getting the running timer which expires first.
+ *
+ * @return     Pointer to the timer, or NULL if no timers are running.
+ */
+static __INLINE timer_node_t * timer_head_get(void)
+{
+    return (m_timer_heap_count != 0) ? m_timer_heap[0] : NULL;
+}
+
+
+/**@brief Function for finding the latest wakeup in a subtree of the heap that no timer may be
+ *        delayed beyond.
+ *
+ * @details Subtrees whose root expires at or after the wakeup found so far are skipped, as moving
+ *          the wakeup earlier would not make any of their timers expire in it.
+ *
+ * @param[in]     index       Position of the subtree root in the heap.
+ * @param[in,out] p_wakeup    Number of ticks from m_ticks_latest to the wakeup.
+ */
+static void heap_wakeup_find(uint32_t index, uint32_t * p_wakeup)
+{
+    timer_node_t * p_timer;
+    uint32_t       ticks_to_expire;
+
+    if (index >= m_timer_heap_count)
+    {
+        return;
+    }
+
+    p_timer         = m_timer_heap[index];
+    ticks_to_expire = ticks_diff_get(p_timer->ticks_to_expire, m_ticks_latest);
+
+    if (ticks_to_expire >= *p_wakeup)
+    {
+        return;
+    }
+
+    if (ticks_to_expire + timer_slack_get(p_timer) < *p_wakeup)
+    {
+        *p_wakeup = ticks_to_expire + timer_slack_get(p_timer);
+    }
+
+    heap_wakeup_find(2 * index + 1, p_wakeup);
+    heap_wakeup_find(2 * index + 2, p_wakeup);
+}
+
+
+/**@brief Function for getting the number of ticks from m_ticks_latest to the next RTC1 wakeup.
+ *
+ * @details The wakeup is the earliest expiry plus slack among the running timers. All timers
+ *          expiring before it are handled in the same RTC1 interrupt.
+ */
+static uint32_t timer_wakeup_ticks_get(void)
+{
+    uint32_t wakeup = UINT32_MAX;
+
+    heap_wakeup_find(0, &wakeup);
+
+    return wakeup;
+}
+
+#else // APP_TIMER_HEAP_SIZE
+
 /**@brief Function for inserting a timer in the timer list.
  *
  * @param[in]  timer_id   Id of timer to insert.
@@ -272,8 +535,10 @@ static void timer_list_insert(timer_node_t * p_timer)
 /**@brief Function for removing a timer from the timer queue.
  *
  * @param[in]  timer_id   Id of timer to remove.
+ *
+ * @return     TRUE if the last timer was removed from the list, FALSE otherwise.
  */
-static void timer_list_remove(timer_node_t * p_timer)
+static bool timer_list_remove(timer_node_t * p_timer)
 {
     timer_node_t * p_previous;
     timer_node_t * p_current;
@@ -296,21 +561,13 @@ static void timer_list_remove(timer_node_t * p_timer)
     // Timer not in active list.
     if (p_current == NULL)
     {
-        return;
+        return false;
     }
 
     // Timer is the first in the list
     if (p_previous == p_current)
     {
         mp_timer_id_head = mp_timer_id_head->next;
-
-        // No more timers in the list. Reset RTC1 in case Start timer operations are present in the queue.
-        if (mp_timer_id_head == NULL)
-        {
-            NRF_RTC1->TASKS_CLEAR = 1;
-            m_ticks_latest        = 0;
-            m_rtc1_reset          = true;
-        }
     }
 
     // Remaining timeout between next timeout.
@@ -325,9 +582,70 @@ static void timer_list_remove(timer_node_t * p_timer)
     {
         p_current->ticks_to_expire += timeout;
     }
+
+    return (mp_timer_id_head == NULL);
+}
+
+
+/**@brief Function for removing all timers from the timer list, marking them as not running.
+ */
+static void timer_list_clear(void)
+{
+    while (mp_timer_id_head != NULL)
+    {
+        timer_node_t * p_head = mp_timer_id_head;
+
+        p_head->is_running = false;
+        mp_timer_id_head    = p_head->next;
+    }
 }
 
 
+/**@brief Function for getting the running timer which expires first.
+ *
+ * @return     Pointer to the timer, or NULL if no timers are running.
+ */
+static __INLINE timer_node_t * timer_head_get(void)
+{
+    return mp_timer_id_head;
+}
+
+
+/**@brief Function for getting the number of ticks from m_ticks_latest to the next RTC1 wakeup.
+ *
+ * @details The wakeup is the earliest expiry plus slack among the running timers. All timers
+ *          expiring before it are handled in the same RTC1 interrupt. The list is only traversed
+ *          until a timer expires at or after the wakeup found so far.
+ */
+static uint32_t timer_wakeup_ticks_get(void)
+{
+    timer_node_t * p_timer         = mp_timer_id_head;
+    uint32_t       ticks_to_expire = 0;
+    uint32_t       wakeup          = UINT32_MAX;
+
+    while (p_timer != NULL)
+    {
+        ticks_to_expire += p_timer->ticks_to_expire;
+
+        if (ticks_to_expire >= wakeup)
+        {
+            break;
+        }
+
+        if (ticks_to_expire + timer_slack_get(p_timer) < wakeup)
+        {
+            wakeup = ticks_to_expire + timer_slack_get(p_timer);
+        }
+
+        p_timer = p_timer->next;
+    }
+
+    return wakeup;
+}
+
+#endif // APP_TIMER_HEAP_SIZE
+
+
 /**@brief Function for scheduling a check for timeouts by generating a RTC1 interrupt.
  */
 static void timer_timeouts_check_sched(void)
@@ -363,15 +681,153 @@ static void timeout_handler_exec(timer_node_t * p_timer)
 }
 
 
+#ifdef APP_TIMER_HEAP_SIZE
+/**@brief Function for adding an expired timer to the heap of expired timers pending execution.
+ *
+ * @details The pending heap holds positions in the timer heap, ordered by the expiry of the
+ *          timers at those positions. Timers which have not expired are not added, as none of
+ *          their descendants in the timer heap have expired either.
+ *
+ * @param[in,out] p_pending        Heap of pending timer heap positions.
+ * @param[in,out] p_pending_count  Number of positions in the pending heap.
+ * @param[in]     index            Position of the timer in the timer heap.
+ * @param[in]     ticks_elapsed    Number of ticks elapsed since m_ticks_latest.
+ */
+static void heap_pending_push(uint16_t * p_pending,
+                              uint16_t * p_pending_count,
+                              uint32_t   index,
+                              uint32_t   ticks_elapsed)
+{
+    uint32_t key;
+    uint16_t pos;
+
+    if (index >= m_timer_heap_count)
+    {
+        return;
+    }
+
+    // Do nothing if timer did not expire.
+    if (ticks_elapsed < ticks_diff_get(m_timer_heap[index]->ticks_to_expire, m_ticks_latest))
+    {
+        return;
+    }
+
+    key = heap_key_get(m_timer_heap[index]);
+    pos = (*p_pending_count)++;
+
+    while (pos > 0)
+    {
+        uint16_t parent = (pos - 1) / 2;
+
+        if (heap_key_get(m_timer_heap[p_pending[parent]]) <= key)
+        {
+            break;
+        }
+
+        p_pending[pos] = p_pending[parent];
+        pos            = parent;
+    }
+
+    p_pending[pos] = index;
+}
+
+
+/**@brief Function for removing the earliest expiring timer from the heap of pending timers.
+ *
+ * @param[in,out] p_pending        Heap of pending timer heap positions. Must not be empty.
+ * @param[in,out] p_pending_count  Number of positions in the pending heap.
+ *
+ * @return     Position of the timer in the timer heap.
+ */
+static uint16_t heap_pending_pop(uint16_t * p_pending, uint16_t * p_pending_count)
+{
+    uint16_t root = p_pending[0];
+    uint16_t last = p_pending[--(*p_pending_count)];
+    uint32_t key  = heap_key_get(m_timer_heap[last]);
+    uint16_t pos  = 0;
+
+    for (;;)
+    {
+        uint16_t child = 2 * pos + 1;
+
+        if (child >= *p_pending_count)
+        {
+            break;
+        }
+
+        if ((child + 1 < *p_pending_count) &&
+            (heap_key_get(m_timer_heap[p_pending[child + 1]]) <
+             heap_key_get(m_timer_heap[p_pending[child]])))
+        {
+            child++;
+        }
+
+        if (key <= heap_key_get(m_timer_heap[p_pending[child]]))
+        {
+            break;
+        }
+
+        p_pending[pos] = p_pending[child];
+        pos            = child;
+    }
+
+    p_pending[pos] = last;
+
+    return root;
+}
+
+
+/**@brief Function for executing the timeout handlers of expired timers in order of expiry.
+ *
+ * @details The timer heap is only modified by the timer list handler, which removes and restarts
+ *          the expired timers, so it is left intact here. Instead, the expired timers whose
+ *          handlers have not been executed yet, and whose parents have, are kept in a local heap.
+ *          Its root is popped repeatedly, which yields the expired timers in order of expiry, as
+ *          with the sorted list. The local heap never holds more than APP_TIMER_HEAP_SIZE entries.
+ *
+ * @param[in]  ticks_elapsed   Number of ticks elapsed since m_ticks_latest.
+ *
+ * @return     Largest number of ticks to expiry among the expired timers.
+ */
+static uint32_t heap_timeouts_check(uint32_t ticks_elapsed)
+{
+    uint16_t pending[APP_TIMER_HEAP_SIZE];
+    uint16_t pending_count = 0;
+    uint32_t ticks_expired = 0;
+
+    heap_pending_push(pending, &pending_count, 0, ticks_elapsed);
+
+    while (pending_count != 0)
+    {
+        uint16_t       index   = heap_pending_pop(pending, &pending_count);
+        timer_node_t * p_timer = m_timer_heap[index];
+
+        // Timers are popped in order of expiry, so the last one has the most ticks to expiry.
+        ticks_expired = ticks_diff_get(p_timer->ticks_to_expire, m_ticks_latest);
+
+        // Execute Task.
+        if (p_timer->is_running)
+        {
+            p_timer->is_running = false;
+            timeout_handler_exec(p_timer);
+        }
+
+        heap_pending_push(pending, &pending_count, 2 * index + 1, ticks_elapsed);
+        heap_pending_push(pending, &pending_count, 2 * index + 2, ticks_elapsed);
+    }
+
+    return ticks_expired;
+}
+#endif
+
+
 /**@brief Function for checking for expired timers.
  */
 static void timer_timeouts_check(void)
 {
     // Handle expired of timer 
-    if (mp_timer_id_head != NULL)
+    if (timer_head_get() != NULL)
     {
-        timer_node_t *  p_timer;
-        timer_node_t *  p_previous_timer;
         uint32_t        ticks_elapsed;
         uint32_t        ticks_expired;
 
@@ -381,6 +837,13 @@ static void timer_timeouts_check(void)
         // ticks_elapsed is collected here, job will use it.
         ticks_elapsed = ticks_diff_get(rtc1_counter_get(), m_ticks_latest);
 
+#ifdef APP_TIMER_HEAP_SIZE
+        // Expire all timers within ticks_elapsed and collect ticks_expired.
+        ticks_expired = heap_timeouts_check(ticks_elapsed);
+#else
+        timer_node_t *  p_timer;
+        timer_node_t *  p_previous_timer;
+
         // Auto variable containing the head of timers expiring.
         p_timer = mp_timer_id_head;
 
@@ -408,6 +871,7 @@ static void timer_timeouts_check(void)
                 timeout_handler_exec(p_previous_timer);
             }
         }
+#endif
 
         // Prepare to queue the ticks expired in the m_ticks_elapsed queue.
         if (m_ticks_elapsed_q_read_ind == m_ticks_elapsed_q_write_ind)
@@ -475,9 +939,11 @@ static bool list_deletions_handler(void)
 {
     timer_node_t * p_timer_old_head;
     uint8_t        user_id;
+    bool           list_emptied = false;
+    bool           start_queued = false;
 
     // Remember the old head, so as to decide if new compare needs to be set.
-    p_timer_old_head = mp_timer_id_head;
+    p_timer_old_head = timer_head_get();
 
     user_id = m_user_array_size;
     while (user_id--)
@@ -500,20 +966,21 @@ static bool list_deletions_handler(void)
             {
                 case TIMER_USER_OP_TYPE_STOP:
                     // Delete node if timer is running.
-                    timer_list_remove(p_user_op->p_node);
+                    if (timer_list_remove(p_user_op->p_node))
+                    {
+                        list_emptied = true;
+                    }
                     break;
                     
                 case TIMER_USER_OP_TYPE_STOP_ALL:
                     // Delete list of running timers, and mark all timers as not running.
-                    while (mp_timer_id_head != NULL)
-                    {
-                        timer_node_t * p_head = mp_timer_id_head;
-
-                        p_head->is_running = false;
-                        mp_timer_id_head    = p_head->next;
-                    }
+                    timer_list_clear();
                     break;
                     
+                case TIMER_USER_OP_TYPE_START:
+                    start_queued = true;
+                    break;
+
                 default:
                     // No implementation needed.
                     break;
@@ -521,8 +988,18 @@ static bool list_deletions_handler(void)
         }
     }
 
+    // No more timers in the list. If timers are started in this pass, keep RTC1 counting, as
+    // they are inserted relative to the last known counter value: clearing the counter takes
+    // effect too late for the compare register to be set from it. Otherwise stop and reset
+    // RTC1, in case Start timer operations are queued while the list is handled.
+    if (list_emptied && (timer_head_get() == NULL) && !start_queued)
+    {
+        rtc1_stop();
+        m_rtc1_reset = true;
+    }
+
     // Detect change in head of the list.
-    return (mp_timer_id_head != p_timer_old_head);
+    return (timer_head_get() != p_timer_old_head);
 }
 
 
@@ -536,6 +1013,37 @@ static void expired_timers_handler(uint32_t         ticks_elapsed,
                                    uint32_t         ticks_previous,
                                    timer_node_t **  p_restart_list_head)
 {
+#ifdef APP_TIMER_HEAP_SIZE
+    while (m_timer_heap_count != 0)
+    {
+        timer_node_t * p_timer       = m_timer_heap[0];
+        uint32_t       ticks_expired = ticks_diff_get(p_timer->ticks_to_expire, ticks_previous);
+
+        // Do nothing if timer did not expire.
+        if (ticks_elapsed < ticks_expired)
+        {
+            break;
+        }
+
+        // Remove the expired timer from the heap.
+        heap_remove(0);
+
+        // Timer will be restarted if periodic.
+        if (p_timer->ticks_periodic_interval != 0)
+        {
+            p_timer->ticks_at_start       = p_timer->ticks_to_expire;
+            p_timer->ticks_first_interval = p_timer->ticks_periodic_interval;
+            p_timer->next                 = *p_restart_list_head;
+            *p_restart_list_head          = p_timer;
+        }
+
+        // Timer expired, set ticks_to_expire zero.
+        p_timer->ticks_to_expire = 0;
+    }
+
+    // No remaining timer expires before the latest known RTC counter value.
+    m_timer_heap_ref = m_ticks_latest;
+#else
     uint32_t ticks_expired = 0;
 
     while (mp_timer_id_head != NULL)
@@ -573,6 +1081,7 @@ static void expired_timers_handler(uint32_t         ticks_elapsed,
             *p_restart_list_head          = p_timer_expired;
         }
     }
+#endif
 }
 
 
@@ -584,11 +1093,9 @@ static void expired_timers_handler(uint32_t         ticks_elapsed,
  */
 static bool list_insertions_handler(timer_node_t * p_restart_list_head)
 {
-    timer_node_t * p_timer_id_old_head;
-    uint8_t        user_id;
-
-    // Remember the old head, so as to decide if new compare needs to be set.
-    p_timer_id_old_head = mp_timer_id_head;
+    bool     compare_update = false;
+    uint32_t wakeup         = timer_wakeup_ticks_get();
+    uint8_t  user_id;
 
     user_id = m_user_array_size;
     while (user_id--)
@@ -625,6 +1132,9 @@ static bool list_insertions_handler(timer_node_t * p_restart_list_head)
                 p_timer->ticks_at_start          = p_user_op->params.start.ticks_at_start;
                 p_timer->ticks_first_interval    = p_user_op->params.start.ticks_first_interval;
                 p_timer->ticks_periodic_interval = p_user_op->params.start.ticks_periodic_interval;
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+                p_timer->ticks_slack             = p_user_op->params.start.ticks_slack;
+#endif
                 p_timer->p_context               = p_user_op->params.start.p_context;
 
                 if (m_rtc1_reset)
@@ -663,12 +1173,20 @@ static bool list_insertions_handler(timer_node_t * p_restart_list_head)
             p_timer->is_running           = true;
             p_timer->next                 = NULL;
 
+            // The timer may move the wakeup earlier even when not becoming the new head, if the
+            // timers before it have slack.
+            if (p_timer->ticks_to_expire + timer_slack_get(p_timer) < wakeup)
+            {
+                wakeup         = p_timer->ticks_to_expire + timer_slack_get(p_timer);
+                compare_update = true;
+            }
+
             // Insert into list 
             timer_list_insert(p_timer);
         }
     }
     
-    return (mp_timer_id_head != p_timer_id_old_head);
+    return compare_update;
 }
 
 
@@ -677,9 +1195,9 @@ static bool list_insertions_handler(timer_node_t * p_restart_list_head)
 static void compare_reg_update(timer_node_t * p_timer_id_head_old)
 {
     // Setup the timeout for timers on the head of the list 
-    if (mp_timer_id_head != NULL)
+    if (timer_head_get() != NULL)
     {
-        uint32_t ticks_to_expire = mp_timer_id_head->ticks_to_expire;
+        uint32_t ticks_to_expire = timer_wakeup_ticks_get();
         uint32_t pre_counter_val = rtc1_counter_get();
         uint32_t cc              = m_ticks_latest;
         uint32_t ticks_elapsed   = ticks_diff_get(pre_counter_val, cc) + RTC_COMPARE_OFFSET_MIN;
@@ -732,7 +1250,9 @@ static void timer_list_handler(void)
     bool           ticks_have_elapsed;
     bool           compare_update;
     timer_node_t * p_timer_id_head_old;
-    
+
+    PROFILE_BEGIN(APP_PROFILER_ID_TIMER_LIST);
+
 #ifdef APP_TIMER_WITH_PROFILER
     {
         unsigned int i;
@@ -755,7 +1275,7 @@ static void timer_list_handler(void)
 
     // Back up the previous known tick and previous list head
     ticks_previous    = m_ticks_latest;
-    p_timer_id_head_old = mp_timer_id_head;
+    p_timer_id_head_old = timer_head_get();
     
     // Get number of elapsed ticks
     ticks_have_elapsed = elapsed_ticks_acquire(&ticks_elapsed);
@@ -782,6 +1302,8 @@ static void timer_list_handler(void)
         compare_reg_update(p_timer_id_head_old);
     }
     m_rtc1_reset = false;
+
+    PROFILE_END(APP_PROFILER_ID_TIMER_LIST);
 }
 
 
@@ -827,12 +1349,59 @@ static timer_user_op_t * user_op_alloc(timer_user_t * p_user, uint8_t * p_last_i
 }
 
 
+/**@brief Function for getting the number of free entries in an operations queue.
+ *
+ * @param[in]  p_user   User whose queue to check.
+ *
+ * @return     Number of operations that can be allocated before the queue is full.
+ */
+static uint8_t user_op_free_count(timer_user_t const * p_user)
+{
+    uint8_t first = p_user->first;
+    uint8_t last  = p_user->last;
+
+    return (first > last) ? (first - last - 1) : (p_user->user_op_queue_size - 1 - last + first);
+}
+
+
+/**@brief Function for filling in a Timer Start operation.
+ *
+ * @param[out] p_user_op         Operation to fill in.
+ * @param[in]  p_node            Timer to start.
+ * @param[in]  timeout_initial   Time (in ticks) to first timer expiry.
+ * @param[in]  timeout_periodic  Time (in ticks) between periodic expiries.
+ * @param[in]  slack             Time (in ticks) each expiry may be delayed by.
+ * @param[in]  p_context         General purpose pointer. Will be passed to the timeout handler when
+ *                               the timer expires.
+ */
+static void timer_start_op_set(timer_user_op_t * p_user_op,
+                               timer_node_t *    p_node,
+                               uint32_t          timeout_initial,
+                               uint32_t          timeout_periodic,
+                               uint32_t          slack,
+                               void *            p_context)
+{
+    p_user_op->op_type                              = TIMER_USER_OP_TYPE_START;
+    p_user_op->p_node                               = p_node;
+    p_user_op->params.start.ticks_at_start          = rtc1_counter_get();
+    p_user_op->params.start.ticks_first_interval    = timeout_initial;
+    p_user_op->params.start.ticks_periodic_interval = timeout_periodic;
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    p_user_op->params.start.ticks_slack             = slack;
+#else
+    UNUSED_PARAMETER(slack);
+#endif
+    p_user_op->params.start.p_context               = p_context;
+}
+
+
 /**@brief Function for scheduling a Timer Start operation.
  *
  * @param[in]  user_id           Id of user calling this function.
  * @param[in]  timer_id          Id of timer to start.
  * @param[in]  timeout_initial   Time (in ticks) to first timer expiry.
  * @param[in]  timeout_periodic  Time (in ticks) between periodic expiries.
+ * @param[in]  slack             Time (in ticks) each expiry may be delayed by.
  * @param[in]  p_context         General purpose pointer. Will be passed to the timeout handler when
  *                               the timer expires.
  * @return     NRF_SUCCESS on success, otherwise an error code.
@@ -841,6 +1410,7 @@ static uint32_t timer_start_op_schedule(timer_user_id_t user_id,
                                         timer_node_t * p_node,
                                         uint32_t        timeout_initial,
                                         uint32_t        timeout_periodic,
+                                        uint32_t        slack,
                                         void *          p_context)
 {
     uint8_t last_index;
@@ -851,12 +1421,7 @@ static uint32_t timer_start_op_schedule(timer_user_id_t user_id,
         return NRF_ERROR_NO_MEM;
     }
     
-    p_user_op->op_type                              = TIMER_USER_OP_TYPE_START;
-    p_user_op->p_node                               = p_node;
-    p_user_op->params.start.ticks_at_start          = rtc1_counter_get();
-    p_user_op->params.start.ticks_first_interval    = timeout_initial;
-    p_user_op->params.start.ticks_periodic_interval = timeout_periodic;
-    p_user_op->params.start.p_context               = p_context;
+    timer_start_op_set(p_user_op, p_node, timeout_initial, timeout_periodic, slack, p_context);
     
     user_op_enque(&mp_users[user_id], last_index);    
 
@@ -926,6 +1491,8 @@ static uint32_t timer_stop_all_op_schedule(timer_user_id_t user_id)
  */
 void RTC1_IRQHandler(void)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(RTC1_IRQn);
+
     // Clear all events (also unexpected ones)
     NRF_RTC1->EVENTS_COMPARE[0] = 0;
     NRF_RTC1->EVENTS_COMPARE[1] = 0;
@@ -936,6 +1503,8 @@ void RTC1_IRQHandler(void)
 
     // Check for expired timers
     timer_timeouts_check();
+
+    NRF_DRV_IRQ_MONITOR_EXIT(RTC1_IRQn);
 }
 
 
@@ -945,7 +1514,9 @@ void RTC1_IRQHandler(void)
  */
 void SWI_IRQHandler(void)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(SWI_IRQn);
     timer_list_handler();
+    NRF_DRV_IRQ_MONITOR_EXIT(SWI_IRQn);
 }
 
 
@@ -994,7 +1565,11 @@ uint32_t app_timer_init(uint32_t                      prescaler,
         p_buffer = &((uint8_t *)p_buffer)[op_queues_size * sizeof(timer_user_op_t)];
     }
 
+#ifdef APP_TIMER_HEAP_SIZE
+    m_timer_heap_count           = 0;
+#else
     mp_timer_id_head             = NULL;
+#endif
     m_ticks_elapsed_q_read_ind  = 0;
     m_ticks_elapsed_q_write_ind = 0;
 
@@ -1072,6 +1647,15 @@ static timer_user_id_t user_id_get(void)
 
 
 uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    return app_timer_start_with_slack(timer_id, timeout_ticks, 0, p_context);
+}
+
+
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context)
 {
     uint32_t timeout_periodic;
     timer_node_t * p_node = (timer_node_t*)timer_id;
@@ -1083,7 +1667,7 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
     {
         return NRF_ERROR_INVALID_STATE;
     }
-    if (timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS)
+    if ((timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS) || (slack_ticks > timeout_ticks))
     {
         return NRF_ERROR_INVALID_PARAM;
     }
@@ -1099,6 +1683,7 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
                                    p_node,
                                    timeout_ticks,
                                    timeout_periodic,
+                                   slack_ticks,
                                    p_context);
 }
 
@@ -1129,6 +1714,103 @@ uint32_t app_timer_stop_all(void)
 }
 
 
+uint32_t app_timer_batch_execute(app_timer_batch_op_t const * p_ops, uint8_t op_count)
+{
+    timer_user_t * p_user;
+    uint32_t       entries = 0;
+    uint8_t        last;
+    uint8_t        i;
+
+    // Check state and parameters
+    VERIFY_MODULE_INITIALIZED();
+
+    if ((p_ops == NULL) && (op_count != 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < op_count; i++)
+    {
+        timer_node_t * p_node = (timer_node_t *)p_ops[i].timer_id;
+
+        if ((p_node == NULL) || (p_node->p_timeout_handler == NULL))
+        {
+            return NRF_ERROR_INVALID_STATE;
+        }
+
+        switch (p_ops[i].op_type)
+        {
+            case APP_TIMER_BATCH_OP_RESTART:
+                entries++;
+                // Fall through.
+
+            case APP_TIMER_BATCH_OP_START:
+                if ((p_ops[i].timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS) ||
+                    (p_ops[i].slack_ticks > p_ops[i].timeout_ticks))
+                {
+                    return NRF_ERROR_INVALID_PARAM;
+                }
+                break;
+
+            case APP_TIMER_BATCH_OP_STOP:
+                break;
+
+            default:
+                return NRF_ERROR_INVALID_PARAM;
+        }
+        entries++;
+    }
+
+    p_user = &mp_users[user_id_get()];
+
+    if (entries > user_op_free_count(p_user))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    // Fill in all operations before making them visible to the list handler at once.
+    last = p_user->last;
+    for (i = 0; i < op_count; i++)
+    {
+        timer_node_t * p_node = (timer_node_t *)p_ops[i].timer_id;
+
+        if (p_ops[i].op_type != APP_TIMER_BATCH_OP_START)
+        {
+            timer_user_op_t * p_user_op = &p_user->p_user_op_queue[last];
+
+            p_node->is_running = false;
+            p_user_op->op_type = TIMER_USER_OP_TYPE_STOP;
+            p_user_op->p_node  = p_node;
+
+            last = (last + 1 == p_user->user_op_queue_size) ? 0 : (last + 1);
+        }
+
+        if (p_ops[i].op_type != APP_TIMER_BATCH_OP_STOP)
+        {
+            uint32_t timeout_periodic = (p_node->mode == APP_TIMER_MODE_REPEATED) ?
+                                        p_ops[i].timeout_ticks : 0;
+
+            timer_start_op_set(&p_user->p_user_op_queue[last],
+                               p_node,
+                               p_ops[i].timeout_ticks,
+                               timeout_periodic,
+                               p_ops[i].slack_ticks,
+                               p_ops[i].p_context);
+
+            last = (last + 1 == p_user->user_op_queue_size) ? 0 : (last + 1);
+        }
+    }
+
+    if (entries != 0)
+    {
+        user_op_enque(p_user, last);
+        timer_list_handler_sched();
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 uint32_t app_timer_cnt_get(uint32_t * p_ticks)
 {
     *p_ticks = rtc1_counter_get();
@@ -1145,7 +1827,7 @@ uint32_t app_timer_cnt_diff_compute(uint32_t   ticks_to,
 }
 
 #ifdef APP_TIMER_WITH_PROFILER
-uint8_t app_timer_op_queue_utilization_get(void)
+uint16_t app_timer_op_queue_utilization_get(void)
 {
     return m_max_user_op_queue_utilization;
 }
@@ -35,6 +35,19 @@
  *          @ref app_scheduler should be used or not. Even if the scheduler is 
  *          not used, app_timer.h will include app_scheduler.h, so when
  *          compiling, app_scheduler.h must be available in one of the compiler include paths.
+ *
+ * @details By default, running timers are kept in a sorted linked list, making timer start and
+ *          stop operations O(n) in the number of running timers. Define APP_TIMER_HEAP_SIZE to the
+ *          maximum number of simultaneously running timers to keep them in a binary heap instead,
+ *          making these operations O(log n). The operation queues and the interrupt handling are
+ *          the same for both, but with the heap, the time-out handlers of timers expiring in the
+ *          same RTC1 interrupt are not necessarily called in order of expiry. Starting more timers
+ *          than APP_TIMER_HEAP_SIZE allows for is reported through APP_ERROR_HANDLER.
+ *
+ * @details Define APP_TIMER_CONFIG_SLACK_ENABLED to 1 to let app_timer_start_with_slack() delay
+ *          expiries so that timers expiring close to each other share an RTC1 wakeup. This adds
+ *          4 bytes to each timer and timer operation. When it is 0 (the default), slack_ticks is
+ *          checked but otherwise ignored.
  */
 
 #ifndef APP_TIMER_H__
@@ -50,9 +63,18 @@
 #define APP_TIMER_CLOCK_FREQ         32768                      /**< Clock frequency of the RTC timer used to implement the app timer module. */
 #define APP_TIMER_MIN_TIMEOUT_TICKS  5                          /**< Minimum value of the timeout_ticks parameter of app_timer_start(). */
 
-#define APP_TIMER_NODE_SIZE          32                         /**< Size of app_timer.timer_node_t (used to allocate data). */
-#define APP_TIMER_USER_OP_SIZE       24                         /**< Size of app_timer.timer_user_op_t (only for use inside APP_TIMER_BUF_SIZE()). */
-#define APP_TIMER_USER_SIZE          8                          /**< Size of app_timer.timer_user_t (only for use inside APP_TIMER_BUF_SIZE()). */
+#ifndef APP_TIMER_CONFIG_SLACK_ENABLED
+#define APP_TIMER_CONFIG_SLACK_ENABLED 0                        /**< Set to 1 to support timer slack, see @ref app_timer_start_with_slack. */
+#endif
+
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+#define APP_TIMER_NODE_SIZE          (24 + 3 * sizeof(void *))  /**< Size of app_timer.timer_node_t (used to allocate data). 36 bytes on the target, which has 32-bit pointers. */
+#define APP_TIMER_USER_OP_SIZE       (16 + 3 * sizeof(void *))  /**< Size of app_timer.timer_user_op_t (only for use inside APP_TIMER_BUF_SIZE()). 28 bytes on the target. */
+#else
+#define APP_TIMER_NODE_SIZE          (CEIL_DIV(20, sizeof(void *)) * sizeof(void *) + 3 * sizeof(void *))  /**< Size of app_timer.timer_node_t (used to allocate data). 32 bytes on the target, which has 32-bit pointers. */
+#define APP_TIMER_USER_OP_SIZE       ((CEIL_DIV(12, sizeof(void *)) + 3) * sizeof(void *))                 /**< Size of app_timer.timer_user_op_t (only for use inside APP_TIMER_BUF_SIZE()). 24 bytes on the target. */
+#endif
+#define APP_TIMER_USER_SIZE          (2 * sizeof(void *))       /**< Size of app_timer.timer_user_t (only for use inside APP_TIMER_BUF_SIZE()). 8 bytes on the target. */
 #define APP_TIMER_INT_LEVELS         3                          /**< Number of interrupt levels from where timer operations may be initiated (only for use inside APP_TIMER_BUF_SIZE()). */
 
 /**@brief Compute number of bytes required to hold the application timer data structures.
@@ -123,6 +145,24 @@ typedef enum
     APP_TIMER_MODE_REPEATED                     /**< The timer will restart each time it expires. */
 } app_timer_mode_t;
 
+/**@brief Timer operations that can be part of a batch. */
+typedef enum
+{
+    APP_TIMER_BATCH_OP_START,                   /**< Start the timer, see @ref app_timer_start_with_slack. */
+    APP_TIMER_BATCH_OP_STOP,                    /**< Stop the timer, see @ref app_timer_stop. */
+    APP_TIMER_BATCH_OP_RESTART                  /**< Stop the timer and start it again with new parameters. */
+} app_timer_batch_op_type_t;
+
+/**@brief Timer operation to be executed as part of a batch. */
+typedef struct
+{
+    app_timer_id_t            timer_id;         /**< Timer identifier. */
+    app_timer_batch_op_type_t op_type;          /**< Operation to perform on the timer. */
+    uint32_t                  timeout_ticks;    /**< Number of ticks to time-out event. Ignored when stopping. */
+    uint32_t                  slack_ticks;      /**< Maximum delay of each time-out event. Ignored when stopping. */
+    void *                    p_context;        /**< Context passed to the time-out handler. Ignored when stopping. */
+} app_timer_batch_op_t;
+
 /**@brief Initialize the application timer module.
  *
  * @details This macro handles dimensioning and allocation of the memory buffer required by the timer,
@@ -232,6 +272,35 @@ uint32_t app_timer_create(app_timer_id_t const *      p_timer_id,
  */
 uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
 
+/**@brief Function for starting a timer whose expiry may be delayed to save power.
+ *
+ * @details Works like @ref app_timer_start, but each expiry of the timer may be delayed by up to
+ *          slack_ticks. The module uses this to handle timers expiring close to each other in the
+ *          same RTC1 interrupt, waking the CPU once instead of once per timer. The period of a
+ *          repeated timer is not affected by the delay of an individual expiry.
+ *
+ * @param[in]       timer_id      Timer identifier.
+ * @param[in]       timeout_ticks Number of ticks (of RTC1, including prescaling) to time-out event
+ *                                (minimum 5 ticks).
+ * @param[in]       slack_ticks   Maximum number of ticks each time-out event may be delayed by. Must
+ *                                not be larger than timeout_ticks. Set to 0 for exact time-outs.
+ * @param[in]       p_context     General purpose pointer. Will be passed to the time-out handler when
+ *                                the timer expires.
+ *
+ * @retval     NRF_SUCCESS               If the timer was successfully started.
+ * @retval     NRF_ERROR_INVALID_PARAM   If a parameter was invalid.
+ * @retval     NRF_ERROR_INVALID_STATE   If the application timer module has not been initialized or the timer
+ *                                       has not been created.
+ * @retval     NRF_ERROR_NO_MEM          If the timer operations queue was full.
+ *
+ * @attention slack_ticks is ignored unless APP_TIMER_CONFIG_SLACK_ENABLED is 1, and always by the
+ *            FreeRTOS, RTX and Gazell app_timer implementations.
+ */
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context);
+
 /**@brief Function for stopping the specified timer.
  *
  * @param[in]  timer_id                  Timer identifier.
@@ -252,6 +321,27 @@ uint32_t app_timer_stop(app_timer_id_t timer_id);
  */
 uint32_t app_timer_stop_all(void);
 
+/**@brief Function for executing several timer operations at once.
+ *
+ * @details All operations are queued before the timer list is updated, so the whole batch is
+ *          handled in a single pass of the timer list: first all stops, then all starts. This is
+ *          cheaper than calling @ref app_timer_start and @ref app_timer_stop for each timer. Either
+ *          all operations in the batch are queued, or none of them are.
+ *
+ * @note A restart operation takes two entries in the timer operations queue, the other
+ *       operations take one.
+ *
+ * @param[in]  p_ops                     Array of timer operations.
+ * @param[in]  op_count                  Number of operations in the array.
+ *
+ * @retval     NRF_SUCCESS               If all operations were successfully queued.
+ * @retval     NRF_ERROR_INVALID_PARAM   If a parameter of any operation was invalid.
+ * @retval     NRF_ERROR_INVALID_STATE   If the application timer module has not been initialized or a
+ *                                       timer has not been created.
+ * @retval     NRF_ERROR_NO_MEM          If the timer operations queue cannot hold the batch.
+ */
+uint32_t app_timer_batch_execute(app_timer_batch_op_t const * p_ops, uint8_t op_count);
+
 /**@brief Function for returning the current value of the RTC1 counter.
  *
  * @param[out] p_ticks   Current value of the RTC1 counter.
@@ -24,11 +24,18 @@ static void app_timer_evt_get(void * p_event_data, uint16_t event_size)
 uint32_t app_timer_evt_schedule(app_timer_timeout_handler_t timeout_handler,
                                 void *                      p_context)
 {
-    app_timer_event_t timer_event;
+    app_timer_event_t * p_timer_event;
+    uint32_t            err_code;
 
-    timer_event.timeout_handler = timeout_handler;
-    timer_event.p_context       = p_context;
+    err_code = app_sched_event_alloc(sizeof(app_timer_event_t), (void **)&p_timer_event);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    p_timer_event->timeout_handler = timeout_handler;
+    p_timer_event->p_context       = p_context;
     
-    return app_sched_event_put(&timer_event, sizeof(timer_event), app_timer_evt_get);
+    return app_sched_event_commit(p_timer_event, app_timer_evt_get);
 }
 
@@ -16,6 +16,7 @@
 #include "nrf_soc.h"
 #include "nrf_delay.h"
 #include "app_util_platform.h"
+#include "app_profiler.h"
 #include "sdk_common.h"
 
 #define RTC1_IRQ_PRI            APP_IRQ_PRIORITY_LOW                        /**< Priority of the RTC1 interrupt (used for checking for timeouts and executing timeout handlers). */
@@ -58,7 +59,7 @@ typedef struct
     void *                      next;                                       /**< Pointer to the next node. */
 } timer_node_t;
 
-STATIC_ASSERT(sizeof(timer_node_t) == APP_TIMER_NODE_SIZE);
+STATIC_ASSERT(sizeof(timer_node_t) <= APP_TIMER_NODE_SIZE);
 
 /**@brief Set of available timer operation types. */
 typedef enum
@@ -730,7 +731,9 @@ static void timer_list_handler(void)
     bool           ticks_have_elapsed;
     bool           compare_update;
     timer_node_t * p_timer_id_head_old;
-    
+
+    PROFILE_BEGIN(APP_PROFILER_ID_TIMER_LIST);
+
     // Back up the previous known tick and previous list head
     ticks_previous    = m_ticks_latest;
     p_timer_id_head_old = mp_timer_id_head;
@@ -760,6 +763,8 @@ static void timer_list_handler(void)
         compare_reg_update(p_timer_id_head_old);
     }
     m_rtc1_reset = false;
+
+    PROFILE_END(APP_PROFILER_ID_TIMER_LIST);
 }
 
 
@@ -1077,6 +1082,18 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
 }
 
 
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context)
+{
+    // Expiries are not coalesced by this implementation.
+    UNUSED_PARAMETER(slack_ticks);
+
+    return app_timer_start(timer_id, timeout_ticks, p_context);
+}
+
+
 uint32_t app_timer_stop(app_timer_id_t timer_id)
 {
     timer_node_t * p_node = (timer_node_t*)timer_id;
@@ -1102,6 +1119,36 @@ uint32_t app_timer_stop_all(void)
 }
 
 
+uint32_t app_timer_batch_execute(app_timer_batch_op_t const * p_ops, uint8_t op_count)
+{
+    uint8_t i;
+
+    // Operations are executed one by one by this implementation.
+    for (i = 0; i < op_count; i++)
+    {
+        uint32_t err_code = NRF_SUCCESS;
+
+        if (p_ops[i].op_type != APP_TIMER_BATCH_OP_START)
+        {
+            err_code = app_timer_stop(p_ops[i].timer_id);
+        }
+        if ((err_code == NRF_SUCCESS) && (p_ops[i].op_type != APP_TIMER_BATCH_OP_STOP))
+        {
+            err_code = app_timer_start_with_slack(p_ops[i].timer_id,
+                                                  p_ops[i].timeout_ticks,
+                                                  p_ops[i].slack_ticks,
+                                                  p_ops[i].p_context);
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 uint32_t app_timer_cnt_get(uint32_t * p_ticks)
 {
     *p_ticks = rtc1_counter_get();
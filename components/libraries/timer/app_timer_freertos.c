@@ -199,6 +199,18 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
 }
 
 
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context)
+{
+    // Expiries are not coalesced by this implementation.
+    UNUSED_PARAMETER(slack_ticks);
+
+    return app_timer_start(timer_id, timeout_ticks, p_context);
+}
+
+
 uint32_t app_timer_stop(app_timer_id_t timer_id)
 {
     app_timer_info_t * pinfo = (app_timer_info_t*)(timer_id);
@@ -228,3 +240,33 @@ uint32_t app_timer_stop(app_timer_id_t timer_id)
     pinfo->active = false;
     return NRF_SUCCESS;
 }
+
+
+uint32_t app_timer_batch_execute(app_timer_batch_op_t const * p_ops, uint8_t op_count)
+{
+    uint8_t i;
+
+    // Operations are executed one by one by this implementation.
+    for (i = 0; i < op_count; i++)
+    {
+        uint32_t err_code = NRF_SUCCESS;
+
+        if (p_ops[i].op_type != APP_TIMER_BATCH_OP_START)
+        {
+            err_code = app_timer_stop(p_ops[i].timer_id);
+        }
+        if ((err_code == NRF_SUCCESS) && (p_ops[i].op_type != APP_TIMER_BATCH_OP_STOP))
+        {
+            err_code = app_timer_start_with_slack(p_ops[i].timer_id,
+                                                  p_ops[i].timeout_ticks,
+                                                  p_ops[i].slack_ticks,
+                                                  p_ops[i].p_context);
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,476 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/**@file
+ *
+ * @brief FreeRTOS variant of app_timer driving the RTC directly.
+ *
+ * @details The timers are kept in a list sorted by expiry time, and compare channel 1 of the
+ *          RTC used for the FreeRTOS system tick is set to the first expiry. The RTC interrupt
+ *          only wakes up a timer service task, which calls the timeout handlers at
+ *          @ref APP_TIMER_TASK_PRIORITY. No system tick is needed to run the timers, so they
+ *          work with tickless idle (configUSE_TICKLESS_IDLE): the RTC compare event wakes the
+ *          CPU from its sleep when a timer expires.
+ *
+ *          The FreeRTOS configuration must forward the RTC interrupt to this module:
+ *          @code
+ *          void app_timer_rtc_irq_handler(void);
+ *          #define configRTC_IRQ_HOOK()    app_timer_rtc_irq_handler()
+ *          @endcode
+ *
+ *          The timer resolution is the system tick period. Timers must be started after
+ *          the scheduler, as the RTC is started by the scheduler.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "app_timer.h"
+#include <stdlib.h>
+#include <string.h>
+#include "nrf.h"
+#include "nrf_rtc.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nordic_common.h"
+
+/* Check if RTC FreeRTOS version is used */
+#if configTICK_SOURCE != FREERTOS_USE_RTC
+#error app_timer in FreeRTOS RTC variant have to be used with RTC tick source configuration.
+#endif
+
+/**@brief Priority of the timer service task, which calls the timeout handlers. */
+#ifndef APP_TIMER_TASK_PRIORITY
+#define APP_TIMER_TASK_PRIORITY     (configMAX_PRIORITIES - 1)
+#endif
+
+/**@brief Stack size of the timer service task, in words. The timeout handlers run on it. */
+#ifndef APP_TIMER_TASK_STACK_SIZE
+#define APP_TIMER_TASK_STACK_SIZE   128
+#endif
+
+#define RTC_CC_CHANNEL              1                                       /**< RTC compare channel used by the module. Channel 0 is used by the tickless idle. */
+#define RTC_COUNTER_HALF            ((portNRF_RTC_MAXTICKS + 1) / 2)        /**< Half the RTC counter range. Longest timeout, in RTC ticks. */
+#define RTC_CC_MIN_DISTANCE         2                                       /**< The RTC misses compare values closer than this to the counter. */
+
+/**@brief Timer node, kept in the timer memory allocated with @ref APP_TIMER_DEF. */
+typedef struct timer_node_s
+{
+    struct timer_node_s       * p_next;      /**< Next timer in the list of running timers. */
+    app_timer_timeout_handler_t handler;     /**< Timeout handler. */
+    void                      * p_context;   /**< Context passed to the timeout handler. */
+    uint32_t                    expiry;      /**< RTC counter value at expiry. */
+    uint32_t                    period;      /**< Timer period, in RTC ticks. */
+    app_timer_mode_t            mode;        /**< Timer mode. */
+    bool                        is_running;  /**< The timer is in the list of running timers. */
+} timer_node_t;
+
+STATIC_ASSERT(sizeof(timer_node_t) <= sizeof(app_timer_t));
+
+static TaskHandle_t   m_task;               /**< Timer service task. */
+static timer_node_t * mp_head;              /**< First timer to expire. */
+static uint32_t       m_prescaler;          /**< Prescaler given to @ref app_timer_init, plus one. */
+
+
+/**@brief Function for entering a critical section, from a task or from an interrupt. */
+static UBaseType_t critical_enter(void)
+{
+    if (__get_IPSR() != 0)
+    {
+        return portSET_INTERRUPT_MASK_FROM_ISR();
+    }
+
+    taskENTER_CRITICAL();
+    return 0;
+}
+
+
+/**@brief Function for leaving a critical section entered with @ref critical_enter. */
+static void critical_exit(UBaseType_t state)
+{
+    if (__get_IPSR() != 0)
+    {
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    }
+    else
+    {
+        taskEXIT_CRITICAL();
+    }
+}
+
+
+/**@brief Function for computing the signed distance from one RTC counter value to another. */
+static int32_t rtc_distance(uint32_t to, uint32_t from)
+{
+    return (int32_t)((to - from + RTC_COUNTER_HALF) & portNRF_RTC_MAXTICKS) - (int32_t)RTC_COUNTER_HALF;
+}
+
+
+/**@brief Function for waking up the timer service task. */
+static void task_wakeup(void)
+{
+    if (__get_IPSR() != 0)
+    {
+        BaseType_t yield_req = pdFALSE;
+        vTaskNotifyGiveFromISR(m_task, &yield_req);
+        portYIELD_FROM_ISR(yield_req);
+    }
+    else
+    {
+        (void) xTaskNotifyGive(m_task);
+    }
+}
+
+
+/**@brief Function for setting the RTC compare channel to the first expiry, if any.
+ *
+ * @details If the first timer expires too soon for the RTC compare event, the timer service
+ *          task is woken up at once instead. Must be called in a critical section.
+ */
+static void rtc_compare_update(void)
+{
+    nrf_rtc_int_disable(portNRF_RTC_REG, NRF_RTC_INT_COMPARE1_MASK);
+    nrf_rtc_event_clear(portNRF_RTC_REG, NRF_RTC_EVENT_COMPARE_1);
+
+    if (mp_head == NULL)
+    {
+        return;
+    }
+
+    nrf_rtc_cc_set(portNRF_RTC_REG, RTC_CC_CHANNEL, mp_head->expiry);
+    nrf_rtc_int_enable(portNRF_RTC_REG, NRF_RTC_INT_COMPARE1_MASK);
+
+    // Check after setting the channel, the counter may have moved past the expiry meanwhile.
+    if (rtc_distance(mp_head->expiry, nrf_rtc_counter_get(portNRF_RTC_REG)) < RTC_CC_MIN_DISTANCE)
+    {
+        nrf_rtc_int_disable(portNRF_RTC_REG, NRF_RTC_INT_COMPARE1_MASK);
+        task_wakeup();
+    }
+}
+
+
+/**@brief Function for inserting a timer in the list of running timers, by expiry.
+ *
+ * @details Must be called in a critical section.
+ */
+static void list_insert(timer_node_t * p_node, uint32_t now)
+{
+    timer_node_t ** pp_link  = &mp_head;
+    int32_t         distance = rtc_distance(p_node->expiry, now);
+
+    while ((*pp_link != NULL) && (rtc_distance((*pp_link)->expiry, now) <= distance))
+    {
+        pp_link = &(*pp_link)->p_next;
+    }
+
+    p_node->p_next     = *pp_link;
+    *pp_link           = p_node;
+    p_node->is_running = true;
+}
+
+
+/**@brief Function for removing a timer from the list of running timers.
+ *
+ * @details Must be called in a critical section.
+ */
+static void list_remove(timer_node_t * p_node)
+{
+    timer_node_t ** pp_link = &mp_head;
+
+    while (*pp_link != NULL)
+    {
+        if (*pp_link == p_node)
+        {
+            *pp_link = p_node->p_next;
+            break;
+        }
+        pp_link = &(*pp_link)->p_next;
+    }
+
+    p_node->is_running = false;
+}
+
+
+/**@brief Timer service task, calling the handlers of the expired timers. */
+static void timer_task(void * p_arg)
+{
+    UNUSED_PARAMETER(p_arg);
+
+    for (;;)
+    {
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for (;;)
+        {
+            app_timer_timeout_handler_t handler;
+            void                      * p_context;
+
+            taskENTER_CRITICAL();
+
+            uint32_t       now    = nrf_rtc_counter_get(portNRF_RTC_REG);
+            timer_node_t * p_node = mp_head;
+
+            if ((p_node == NULL) || (rtc_distance(p_node->expiry, now) > 0))
+            {
+                rtc_compare_update();
+                taskEXIT_CRITICAL();
+                break;
+            }
+
+            list_remove(p_node);
+            if (p_node->mode == APP_TIMER_MODE_REPEATED)
+            {
+                p_node->expiry = (p_node->expiry + p_node->period) & portNRF_RTC_MAXTICKS;
+                if (rtc_distance(p_node->expiry, now) <= 0)
+                {
+                    // The handlers fell behind by more than a period: skip the missed expiries.
+                    p_node->expiry = (now + p_node->period) & portNRF_RTC_MAXTICKS;
+                }
+                list_insert(p_node, now);
+            }
+
+            handler   = p_node->handler;
+            p_context = p_node->p_context;
+
+            taskEXIT_CRITICAL();
+
+            handler(p_context);
+        }
+    }
+}
+
+
+void app_timer_rtc_irq_handler(void)
+{
+    if (nrf_rtc_int_is_enabled(portNRF_RTC_REG, NRF_RTC_INT_COMPARE1_MASK)
+     && nrf_rtc_event_pending(portNRF_RTC_REG, NRF_RTC_EVENT_COMPARE_1))
+    {
+        nrf_rtc_event_clear(portNRF_RTC_REG, NRF_RTC_EVENT_COMPARE_1);
+        nrf_rtc_int_disable(portNRF_RTC_REG, NRF_RTC_INT_COMPARE1_MASK);
+        task_wakeup();
+    }
+}
+
+
+uint32_t app_timer_init(uint32_t                      prescaler,
+                        uint8_t                       op_queues_size,
+                        void                        * p_buffer,
+                        app_timer_evt_schedule_func_t evt_schedule_func)
+{
+    UNUSED_PARAMETER(op_queues_size);
+    UNUSED_PARAMETER(p_buffer);
+    UNUSED_PARAMETER(evt_schedule_func);
+
+    m_prescaler = prescaler + 1;
+    mp_head     = NULL;
+
+    if (m_task == NULL)
+    {
+        if (xTaskCreate(timer_task, "TMR", APP_TIMER_TASK_STACK_SIZE, NULL,
+                        APP_TIMER_TASK_PRIORITY, &m_task) != pdPASS)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_create(app_timer_id_t const *      p_timer_id,
+                          app_timer_mode_t            mode,
+                          app_timer_timeout_handler_t timeout_handler)
+{
+    if ((timeout_handler == NULL) || (p_timer_id == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (m_task == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    timer_node_t * p_node = (timer_node_t *)(*p_timer_id);
+
+    if (p_node->is_running)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    memset(p_node, 0, sizeof(timer_node_t));
+    p_node->handler = timeout_handler;
+    p_node->mode    = mode;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    timer_node_t * p_node = (timer_node_t *)timer_id;
+
+    if ((timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS) || (p_node == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if ((m_task == NULL) || (p_node->handler == NULL))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // Convert from the ticks of the application prescaler to the ticks of the system tick.
+    uint32_t rtc_prescaler = portNRF_RTC_REG->PRESCALER + 1;
+    uint64_t rtc_ticks     = ((uint64_t)timeout_ticks * m_prescaler + rtc_prescaler / 2)
+                             / rtc_prescaler;
+
+    if (rtc_ticks >= RTC_COUNTER_HALF)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (rtc_ticks == 0)
+    {
+        rtc_ticks = 1;
+    }
+
+    UBaseType_t state = critical_enter();
+
+    if (!p_node->is_running)
+    {
+        uint32_t now = nrf_rtc_counter_get(portNRF_RTC_REG);
+
+        p_node->p_context = p_context;
+        p_node->period    = (uint32_t)rtc_ticks;
+        p_node->expiry    = (now + p_node->period) & portNRF_RTC_MAXTICKS;
+        list_insert(p_node, now);
+
+        if (mp_head == p_node)
+        {
+            rtc_compare_update();
+        }
+    }
+    // A timer already running is left unchanged, as in the other variants.
+
+    critical_exit(state);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context)
+{
+    // Expiries are not coalesced by this implementation.
+    UNUSED_PARAMETER(slack_ticks);
+
+    return app_timer_start(timer_id, timeout_ticks, p_context);
+}
+
+
+uint32_t app_timer_stop(app_timer_id_t timer_id)
+{
+    timer_node_t * p_node = (timer_node_t *)timer_id;
+
+    if (p_node == NULL)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if ((m_task == NULL) || (p_node->handler == NULL))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    UBaseType_t state = critical_enter();
+
+    if (p_node->is_running)
+    {
+        bool was_head = (mp_head == p_node);
+
+        list_remove(p_node);
+        if (was_head)
+        {
+            rtc_compare_update();
+        }
+    }
+
+    critical_exit(state);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_stop_all(void)
+{
+    if (m_task == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    UBaseType_t state = critical_enter();
+
+    while (mp_head != NULL)
+    {
+        list_remove(mp_head);
+    }
+    rtc_compare_update();
+
+    critical_exit(state);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_batch_execute(app_timer_batch_op_t const * p_ops, uint8_t op_count)
+{
+    uint8_t i;
+
+    // Operations are executed one by one by this implementation.
+    for (i = 0; i < op_count; i++)
+    {
+        uint32_t err_code = NRF_SUCCESS;
+
+        if (p_ops[i].op_type != APP_TIMER_BATCH_OP_START)
+        {
+            err_code = app_timer_stop(p_ops[i].timer_id);
+        }
+        if ((err_code == NRF_SUCCESS) && (p_ops[i].op_type != APP_TIMER_BATCH_OP_STOP))
+        {
+            err_code = app_timer_start_with_slack(p_ops[i].timer_id,
+                                                  p_ops[i].timeout_ticks,
+                                                  p_ops[i].slack_ticks,
+                                                  p_ops[i].p_context);
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_cnt_get(uint32_t * p_ticks)
+{
+    *p_ticks = nrf_rtc_counter_get(portNRF_RTC_REG);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_cnt_diff_compute(uint32_t   ticks_to,
+                                    uint32_t   ticks_from,
+                                    uint32_t * p_ticks_diff)
+{
+    *p_ticks_diff = (ticks_to - ticks_from) & portNRF_RTC_MAXTICKS;
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,439 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_timeslot.h"
+#include <string.h>
+#include "nrf.h"
+#include "nrf_soc.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+/**@brief Whether pass value a is behind pass value b. Pass values wrap around. */
+#define PASS_BEHIND(a, b)   ((int32_t)((a) - (b)) < 0)
+
+/**@brief Client state. */
+typedef struct
+{
+    app_timeslot_client_config_t config;
+    app_timeslot_stats_t         stats;
+    uint32_t                     pass;      /**< Time used by the client, scaled by the inverse of its weight. The active client with the lowest pass gets the next timeslot. */
+    volatile bool                active;    /**< Timeslots are requested for the client. */
+    volatile bool                rejoined;  /**< The client was started again, its pass is brought up to date when selected. */
+} client_t;
+
+static client_t                                 m_clients[APP_TIMESLOT_MAX_CLIENTS];
+static uint8_t                                  m_client_count;
+static app_timeslot_config_t                    m_config;
+static bool                                     m_initialized = false;
+static volatile bool                            m_busy = false;     /**< A timeslot is requested or in progress. */
+static uint8_t                                  m_current;          /**< Client of the timeslot requested or in progress. */
+static uint32_t                                 m_virtual_time;     /**< Pass of the client which got the last timeslot. */
+static uint32_t                                 m_slot_length_us;   /**< Length of the timeslot in progress, including extensions. */
+static uint8_t                                  m_extension_count;  /**< Extensions of the timeslot in progress. */
+static nrf_radio_request_t                      m_request;
+static nrf_radio_signal_callback_return_param_t m_return_param;
+
+
+static void error_report(uint32_t err_code)
+{
+    if (m_config.error_handler != NULL)
+    {
+        m_config.error_handler(err_code);
+    }
+}
+
+
+/**@brief Function for advancing the pass of a client by the time it was granted. */
+static void pass_advance(client_t * p_client, uint32_t time_us)
+{
+    p_client->pass += (time_us * UINT8_MAX) / p_client->config.share;
+}
+
+
+/**@brief Function for selecting the client of the next timeslot.
+ *
+ * @param[out] p_id  The selected client.
+ *
+ * @retval true if a client is active.
+ */
+static bool client_select(uint8_t * p_id)
+{
+    bool found = false;
+
+    for (uint8_t i = 0; i < m_client_count; i++)
+    {
+        client_t * p_client = &m_clients[i];
+
+        if (!p_client->active)
+        {
+            continue;
+        }
+
+        // Time spent inactive is not credited, otherwise a client which was stopped for a while
+        // would take all the timeslots until it caught up.
+        if (p_client->rejoined)
+        {
+            p_client->rejoined = false;
+            if (PASS_BEHIND(p_client->pass, m_virtual_time))
+            {
+                p_client->pass = m_virtual_time;
+            }
+        }
+
+        if (!found || PASS_BEHIND(p_client->pass, m_clients[*p_id].pass))
+        {
+            *p_id = i;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        m_virtual_time = m_clients[*p_id].pass;
+    }
+    return found;
+}
+
+
+/**@brief Function for building the request of the next timeslot of a client.
+ *
+ * @param[in] id        The client.
+ * @param[in] earliest  Request the timeslot as early as possible. Must be set for the first
+ *                      request of the session and after a timeslot was blocked or canceled.
+ */
+static nrf_radio_request_t * request_build(uint8_t id, bool earliest)
+{
+    client_t * p_client = &m_clients[id];
+
+    m_current = id;
+
+    if (earliest || (m_config.duty_cycle_percent == 100))
+    {
+        m_request.request_type               = NRF_RADIO_REQ_TYPE_EARLIEST;
+        m_request.params.earliest.hfclk      = NRF_RADIO_HFCLK_CFG_XTAL_GUARANTEED;
+        m_request.params.earliest.priority   = p_client->config.priority;
+        m_request.params.earliest.length_us  = p_client->config.length_us;
+        m_request.params.earliest.timeout_us = APP_TIMESLOT_EARLIEST_TIMEOUT_US;
+    }
+    else
+    {
+        // The distance is from the start of the previous timeslot, which includes its extensions.
+        uint32_t distance_us = (uint32_t)(((uint64_t)m_slot_length_us * 100) / m_config.duty_cycle_percent);
+
+        m_request.request_type               = NRF_RADIO_REQ_TYPE_NORMAL;
+        m_request.params.normal.hfclk        = NRF_RADIO_HFCLK_CFG_XTAL_GUARANTEED;
+        m_request.params.normal.priority     = p_client->config.priority;
+        m_request.params.normal.distance_us  = MIN(distance_us, NRF_RADIO_DISTANCE_MAX_US);
+        m_request.params.normal.length_us    = p_client->config.length_us;
+    }
+
+    p_client->stats.slots_requested++;
+    p_client->stats.time_requested_us += p_client->config.length_us;
+
+    return &m_request;
+}
+
+
+/**@brief Function for requesting a timeslot as early as possible for the next client, from the
+ *        application context.
+ *
+ * @details Must only be called when no timeslot is requested or in progress.
+ */
+static uint32_t next_slot_request(void)
+{
+    uint32_t err_code;
+    uint8_t  id;
+
+    if (!client_select(&id))
+    {
+        m_busy = false;
+        return NRF_SUCCESS;
+    }
+
+    err_code = sd_radio_request(request_build(id, true));
+    if (err_code != NRF_SUCCESS)
+    {
+        m_busy = false;
+    }
+    return err_code;
+}
+
+
+/**@brief Function for ending the timeslot in progress and requesting the next one.
+ *
+ * @param[in] signal  Send @ref APP_TIMESLOT_SIGNAL_END to the client.
+ */
+static void slot_end(bool signal)
+{
+    uint8_t id;
+
+    if (signal)
+    {
+        (void)m_clients[m_current].config.handler(APP_TIMESLOT_SIGNAL_END);
+    }
+
+    NRF_TIMER0->INTENCLR = TIMER_INTENCLR_COMPARE0_Msk;
+
+    if (client_select(&id))
+    {
+        m_return_param.params.request.p_next = request_build(id, false);
+        m_return_param.callback_action       = NRF_RADIO_SIGNAL_CALLBACK_ACTION_REQUEST_AND_END;
+    }
+    else
+    {
+        // Clients started from now on request the next timeslot themselves.
+        m_busy                         = false;
+        m_return_param.callback_action = NRF_RADIO_SIGNAL_CALLBACK_ACTION_END;
+    }
+}
+
+
+/**@brief Timeslot signal callback, see @ref nrf_radio_signal_callback_t. */
+static nrf_radio_signal_callback_return_param_t * radio_callback(uint8_t signal_type)
+{
+    client_t * p_client = &m_clients[m_current];
+
+    m_return_param.callback_action       = NRF_RADIO_SIGNAL_CALLBACK_ACTION_NONE;
+    m_return_param.params.request.p_next = NULL;
+
+    switch (signal_type)
+    {
+        case NRF_RADIO_CALLBACK_SIGNAL_TYPE_START:
+            m_slot_length_us  = p_client->config.length_us;
+            m_extension_count = 0;
+            p_client->stats.slots_granted++;
+            p_client->stats.time_granted_us += m_slot_length_us;
+            pass_advance(p_client, m_slot_length_us);
+
+            // TIMER0 is cleared and started by the SoftDevice at the start of the timeslot.
+            NRF_TIMER0->EVENTS_COMPARE[0] = 0;
+            NRF_TIMER0->CC[0]             = m_slot_length_us - APP_TIMESLOT_END_MARGIN_US;
+            NRF_TIMER0->INTENSET          = TIMER_INTENSET_COMPARE0_Msk;
+            NVIC_EnableIRQ(TIMER0_IRQn);
+
+            if (p_client->active)
+            {
+                (void)p_client->config.handler(APP_TIMESLOT_SIGNAL_START);
+            }
+            else
+            {
+                // Stopped after the timeslot was requested.
+                slot_end(false);
+            }
+            break;
+
+        case NRF_RADIO_CALLBACK_SIGNAL_TYPE_RADIO:
+            (void)p_client->config.handler(APP_TIMESLOT_SIGNAL_RADIO);
+            break;
+
+        case NRF_RADIO_CALLBACK_SIGNAL_TYPE_TIMER0:
+            if (NRF_TIMER0->EVENTS_COMPARE[0] != 0)
+            {
+                NRF_TIMER0->EVENTS_COMPARE[0] = 0;
+
+                if (p_client->active &&
+                    (m_extension_count < p_client->config.max_extensions) &&
+                    p_client->config.handler(APP_TIMESLOT_SIGNAL_ENDING))
+                {
+                    m_extension_count++;
+                    p_client->stats.extensions_requested++;
+                    m_return_param.params.extend.length_us = p_client->config.extension_us;
+                    m_return_param.callback_action         = NRF_RADIO_SIGNAL_CALLBACK_ACTION_EXTEND;
+                }
+                else
+                {
+                    slot_end(true);
+                }
+            }
+            break;
+
+        case NRF_RADIO_CALLBACK_SIGNAL_TYPE_EXTEND_SUCCEEDED:
+            m_slot_length_us += p_client->config.extension_us;
+            p_client->stats.extensions_granted++;
+            p_client->stats.time_granted_us += p_client->config.extension_us;
+            pass_advance(p_client, p_client->config.extension_us);
+            NRF_TIMER0->CC[0] += p_client->config.extension_us;
+            break;
+
+        case NRF_RADIO_CALLBACK_SIGNAL_TYPE_EXTEND_FAILED:
+            slot_end(true);
+            break;
+
+        default:
+            break;
+    }
+
+    return &m_return_param;
+}
+
+
+ret_code_t app_timeslot_init(app_timeslot_config_t const * p_config)
+{
+    uint32_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_config);
+    VERIFY_TRUE((p_config->duty_cycle_percent > 0) && (p_config->duty_cycle_percent <= 100),
+                NRF_ERROR_INVALID_PARAM);
+    VERIFY_FALSE(m_initialized, NRF_ERROR_INVALID_STATE);
+
+    m_config = *p_config;
+    m_busy   = false;
+
+    err_code = sd_radio_session_open(radio_callback);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    m_initialized = true;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_timeslot_uninit(void)
+{
+    VERIFY_TRUE(m_initialized, NRF_ERROR_INVALID_STATE);
+
+    for (uint8_t i = 0; i < m_client_count; i++)
+    {
+        m_clients[i].active = false;
+    }
+    m_initialized = false;
+
+    return sd_radio_session_close();
+}
+
+
+ret_code_t app_timeslot_client_register(app_timeslot_client_config_t const * p_config,
+                                        app_timeslot_client_id_t           * p_id)
+{
+    VERIFY_PARAM_NOT_NULL(p_config);
+    VERIFY_PARAM_NOT_NULL(p_config->handler);
+    VERIFY_PARAM_NOT_NULL(p_id);
+    VERIFY_TRUE((p_config->length_us >= NRF_RADIO_LENGTH_MIN_US) &&
+                (p_config->length_us <= NRF_RADIO_LENGTH_MAX_US) &&
+                (p_config->length_us >  APP_TIMESLOT_END_MARGIN_US),
+                NRF_ERROR_INVALID_PARAM);
+    VERIFY_TRUE((p_config->max_extensions == 0) ||
+                (p_config->extension_us >= NRF_RADIO_MINIMUM_TIMESLOT_LENGTH_EXTENSION_TIME_US),
+                NRF_ERROR_INVALID_PARAM);
+    VERIFY_TRUE(p_config->share != 0, NRF_ERROR_INVALID_PARAM);
+    VERIFY_TRUE(p_config->priority <= NRF_RADIO_PRIORITY_NORMAL, NRF_ERROR_INVALID_PARAM);
+    VERIFY_TRUE(m_client_count < APP_TIMESLOT_MAX_CLIENTS, NRF_ERROR_NO_MEM);
+
+    memset(&m_clients[m_client_count], 0, sizeof(client_t));
+    m_clients[m_client_count].config = *p_config;
+
+    *p_id = m_client_count++;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_timeslot_client_start(app_timeslot_client_id_t id)
+{
+    bool     request;
+    client_t * p_client;
+
+    VERIFY_TRUE(id < m_client_count, NRF_ERROR_INVALID_PARAM);
+    VERIFY_TRUE(m_initialized, NRF_ERROR_INVALID_STATE);
+
+    p_client = &m_clients[id];
+    if (p_client->active)
+    {
+        return NRF_SUCCESS;
+    }
+
+    // The client is activated before the timeslot state is checked: either the timeslot in
+    // progress sees it when selecting the next client, or the timeslot has already ended without
+    // requesting a new one and the request is made here.
+    p_client->rejoined = true;
+    p_client->active   = true;
+
+    CRITICAL_REGION_ENTER();
+    request = !m_busy;
+    m_busy  = true;
+    CRITICAL_REGION_EXIT();
+
+    if (request)
+    {
+        return next_slot_request();
+    }
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_timeslot_client_stop(app_timeslot_client_id_t id)
+{
+    VERIFY_TRUE(id < m_client_count, NRF_ERROR_INVALID_PARAM);
+
+    m_clients[id].active = false;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_timeslot_stats_get(app_timeslot_client_id_t id,
+                                  app_timeslot_stats_t   * p_stats,
+                                  bool                     clear)
+{
+    VERIFY_PARAM_NOT_NULL(p_stats);
+    VERIFY_TRUE(id < m_client_count, NRF_ERROR_INVALID_PARAM);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_clients[id].stats;
+    if (clear)
+    {
+        memset(&m_clients[id].stats, 0, sizeof(app_timeslot_stats_t));
+    }
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+void app_timeslot_on_sys_evt(uint32_t sys_evt)
+{
+    uint32_t err_code;
+
+    switch (sys_evt)
+    {
+        case NRF_EVT_RADIO_BLOCKED:
+            m_clients[m_current].stats.slots_blocked++;
+            break;
+
+        case NRF_EVT_RADIO_CANCELED:
+            m_clients[m_current].stats.slots_canceled++;
+            break;
+
+        case NRF_EVT_RADIO_SIGNAL_CALLBACK_INVALID_RETURN:
+            error_report(NRF_ERROR_INVALID_STATE);
+            break;
+
+        default:
+            // Session idle and closed events need no action.
+            return;
+    }
+
+    // No timeslot is requested anymore. Request one as early as possible, for the client with
+    // the lowest pass: the one which was blocked, unless another client was started since.
+    if (m_initialized)
+    {
+        err_code = next_slot_request();
+        if (err_code != NRF_SUCCESS)
+        {
+            error_report(err_code);
+        }
+    }
+    else
+    {
+        m_busy = false;
+    }
+}
@@ -0,0 +1,214 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_TIMESLOT_H__
+#define APP_TIMESLOT_H__
+
+/**
+ * @defgroup app_timeslot Radio timeslot arbiter
+ * @ingroup app_common
+ * @{
+ *
+ * @brief Module for sharing the radio between the SoftDevice and proprietary protocols.
+ *
+ * @details The module opens a single SoftDevice radio timeslot session, see
+ *          @ref sd_radio_session_open, and hands out the timeslots it is granted to a number of
+ *          clients, for example an @ref nrf_esb or a Gazell instance, while the SoftDevice keeps
+ *          its own connections running. Each client is given a share of the timeslot time in
+ *          proportion to its configured weight, and can ask for its timeslot to be extended when
+ *          it still has work to do when the timeslot is about to end.
+ *
+ *          All client signals are sent from the timeslot signal callback, which runs at interrupt
+ *          priority 0. SoftDevice functions must not be called from the client handler.
+ *          From @ref APP_TIMESLOT_SIGNAL_START to @ref APP_TIMESLOT_SIGNAL_END, the client owns
+ *          the RADIO peripheral, and any peripheral of its own, but not TIMER0, which is used by
+ *          the module to end the timeslot. The SoftDevice reconfigures the RADIO between
+ *          timeslots, so a client protocol must be initialized again on every
+ *          @ref APP_TIMESLOT_SIGNAL_START, and must be stopped on @ref APP_TIMESLOT_SIGNAL_END.
+ *          The RADIO interrupt is not sent to the application vector table while the SoftDevice
+ *          is enabled: the client forwards @ref APP_TIMESLOT_SIGNAL_RADIO to the radio interrupt
+ *          handler of its protocol instead.
+ *
+ *          The application must forward SoC events to @ref app_timeslot_on_sys_evt.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+
+
+/**@brief Maximum number of clients. */
+#ifndef APP_TIMESLOT_MAX_CLIENTS
+#define APP_TIMESLOT_MAX_CLIENTS        2
+#endif
+
+/**@brief Time, in microseconds, between @ref APP_TIMESLOT_SIGNAL_ENDING and the end of the
+ *        timeslot. The client has this much time to stop its radio activity. */
+#ifndef APP_TIMESLOT_END_MARGIN_US
+#define APP_TIMESLOT_END_MARGIN_US      200
+#endif
+
+/**@brief Longest acceptable delay, in microseconds, until the start of a timeslot requested as
+ *        early as possible. */
+#ifndef APP_TIMESLOT_EARLIEST_TIMEOUT_US
+#define APP_TIMESLOT_EARLIEST_TIMEOUT_US 1000000
+#endif
+
+
+/**@brief Client signals. */
+typedef enum
+{
+    APP_TIMESLOT_SIGNAL_START,      /**< The timeslot of the client has started. The radio can be configured and used. */
+    APP_TIMESLOT_SIGNAL_RADIO,      /**< RADIO interrupt, to be forwarded to the radio interrupt handler of the protocol. */
+    APP_TIMESLOT_SIGNAL_ENDING,     /**< The timeslot ends in @ref APP_TIMESLOT_END_MARGIN_US. Return true to request an extension. Only sent when the timeslot can still be extended. */
+    APP_TIMESLOT_SIGNAL_END,        /**< The timeslot ends now. All radio activity must be stopped before the handler returns. */
+} app_timeslot_signal_t;
+
+/**@brief Client signal handler.
+ *
+ * @param[in] signal  The signal.
+ *
+ * @return For @ref APP_TIMESLOT_SIGNAL_ENDING, true if the client needs the timeslot to be
+ *         extended. Ignored for the other signals.
+ */
+typedef bool (*app_timeslot_handler_t)(app_timeslot_signal_t signal);
+
+/**@brief Error handler, called with the error code of a failed SoftDevice call. */
+typedef void (*app_timeslot_error_handler_t)(uint32_t err_code);
+
+/**@brief Client identifier. */
+typedef uint8_t app_timeslot_client_id_t;
+
+/**@brief Client configuration. */
+typedef struct
+{
+    app_timeslot_handler_t handler;         /**< Signal handler. */
+    uint32_t               length_us;       /**< Length of the timeslots requested for the client, from @ref NRF_RADIO_LENGTH_MIN_US to @ref NRF_RADIO_LENGTH_MAX_US. */
+    uint32_t               extension_us;    /**< Length of each extension, at least @ref NRF_RADIO_MINIMUM_TIMESLOT_LENGTH_EXTENSION_TIME_US. Not used if max_extensions is 0. */
+    uint8_t                max_extensions;  /**< Highest number of extensions of a single timeslot. */
+    uint8_t                share;           /**< Weight of the client, from 1 to 255: the timeslot time is shared between the active clients in proportion to their weights. */
+    uint8_t                priority;        /**< Timeslot priority, see @ref NRF_RADIO_PRIORITY. */
+} app_timeslot_client_config_t;
+
+/**@brief Module configuration. */
+typedef struct
+{
+    /**@brief Highest percentage, from 1 to 100, of the time the clients can have the radio,
+     *        the rest being left to the SoftDevice. With 100, each timeslot is requested as early
+     *        as possible after the previous one.
+     */
+    uint8_t                      duty_cycle_percent;
+    app_timeslot_error_handler_t error_handler;     /**< Error handler. Can be NULL. */
+} app_timeslot_config_t;
+
+/**@brief Client statistics.
+ *
+ * @details Times are in microseconds and include the extensions. The time requested is counted
+ *          each time a timeslot is requested, so a timeslot which is blocked and requested again
+ *          is counted twice.
+ */
+typedef struct
+{
+    uint32_t slots_requested;       /**< Number of timeslots requested. */
+    uint32_t slots_granted;         /**< Number of timeslots started. */
+    uint32_t slots_blocked;         /**< Number of requests which could not be scheduled. */
+    uint32_t slots_canceled;        /**< Number of timeslots canceled by a higher priority SoftDevice activity. */
+    uint32_t extensions_requested;  /**< Number of extensions requested. */
+    uint32_t extensions_granted;    /**< Number of extensions granted. */
+    uint64_t time_requested_us;     /**< Total time requested. */
+    uint64_t time_granted_us;       /**< Total time granted. */
+} app_timeslot_stats_t;
+
+
+/**@brief Function for initializing the module and opening the timeslot session.
+ *
+ * @param[in]  p_config  Module configuration.
+ *
+ * @retval NRF_SUCCESS              The module was initialized.
+ * @retval NRF_ERROR_NULL           p_config is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  The duty cycle is not valid.
+ * @retval NRF_ERROR_INVALID_STATE  The module is already initialized.
+ * @return Error returned by @ref sd_radio_session_open.
+ */
+ret_code_t app_timeslot_init(app_timeslot_config_t const * p_config);
+
+/**@brief Function for closing the timeslot session.
+ *
+ * @details The timeslot in progress, if any, runs to its end. The session is closed when
+ *          @ref NRF_EVT_RADIO_SESSION_CLOSED is received.
+ *
+ * @retval NRF_SUCCESS              The session is being closed.
+ * @retval NRF_ERROR_INVALID_STATE  The module is not initialized.
+ */
+ret_code_t app_timeslot_uninit(void);
+
+/**@brief Function for registering a client.
+ *
+ * @details The client does not get any timeslot until @ref app_timeslot_client_start is called.
+ *
+ * @param[in]  p_config  Client configuration.
+ * @param[out] p_id      Identifier of the client.
+ *
+ * @retval NRF_SUCCESS              The client was registered.
+ * @retval NRF_ERROR_NULL           p_config, its handler or p_id is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  The timeslot length, extension length, weight or priority is
+ *                                  not valid.
+ * @retval NRF_ERROR_NO_MEM         @ref APP_TIMESLOT_MAX_CLIENTS clients are already registered.
+ */
+ret_code_t app_timeslot_client_register(app_timeslot_client_config_t const * p_config,
+                                        app_timeslot_client_id_t           * p_id);
+
+/**@brief Function for starting to request timeslots for a client.
+ *
+ * @param[in]  id  Identifier of the client.
+ *
+ * @retval NRF_SUCCESS              The client is active.
+ * @retval NRF_ERROR_INVALID_PARAM  id is not a registered client.
+ * @retval NRF_ERROR_INVALID_STATE  The module is not initialized.
+ * @return Error returned by @ref sd_radio_request.
+ */
+ret_code_t app_timeslot_client_start(app_timeslot_client_id_t id);
+
+/**@brief Function for stopping to request timeslots for a client.
+ *
+ * @details The timeslot of the client in progress, if any, runs to its end, but is not extended.
+ *
+ * @param[in]  id  Identifier of the client.
+ *
+ * @retval NRF_SUCCESS              The client is inactive.
+ * @retval NRF_ERROR_INVALID_PARAM  id is not a registered client.
+ */
+ret_code_t app_timeslot_client_stop(app_timeslot_client_id_t id);
+
+/**@brief Function for retrieving the statistics of a client.
+ *
+ * @param[in]  id       Identifier of the client.
+ * @param[out] p_stats  The statistics.
+ * @param[in]  clear    Clear the statistics after they are retrieved.
+ *
+ * @retval NRF_SUCCESS              The statistics were retrieved.
+ * @retval NRF_ERROR_NULL           p_stats is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  id is not a registered client.
+ */
+ret_code_t app_timeslot_stats_get(app_timeslot_client_id_t id,
+                                  app_timeslot_stats_t   * p_stats,
+                                  bool                     clear);
+
+/**@brief Function for handling SoC events.
+ *
+ * @param[in]  sys_evt  SoC event, see @ref NRF_SOC_EVTS.
+ */
+void app_timeslot_on_sys_evt(uint32_t sys_evt);
+
+/** @} */
+
+#endif // APP_TIMESLOT_H__
@@ -0,0 +1,280 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_timestamp.h"
+#include <stddef.h>
+#include "nrf_drv_clock.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+#define RTC_COUNTER_BITS    24                                              /**< Width of the RTC counter. */
+#define RTC_HALF_SCALE      (1UL << (RTC_COUNTER_BITS - 1))
+#define TIMER_MASK          ((uint32_t)((1ULL << APP_TIMESTAMP_TIMER_BIT_WIDTH) - 1))
+#define TIMER_HALF_SCALE    (1UL << (APP_TIMESTAMP_TIMER_BIT_WIDTH - 1))
+
+#define READ_CHANNEL        NRF_TIMER_CC_CHANNEL0                           /**< Channel used to read the TIMER counter. */
+#define OVERFLOW_CHANNEL    (NRF_TIMER_CC_CHANNEL_COUNT(APP_TIMESTAMP_TIMER_INSTANCE) - 1) /**< Channel comparing with 0, to count the TIMER overflows. */
+
+#if APP_TIMESTAMP_TIMER_BIT_WIDTH == 32
+#define TIMER_BIT_WIDTH     NRF_TIMER_BIT_WIDTH_32
+#else
+#define TIMER_BIT_WIDTH     NRF_TIMER_BIT_WIDTH_16
+#endif
+
+static const nrf_drv_rtc_t   m_rtc   = NRF_DRV_RTC_INSTANCE(APP_TIMESTAMP_RTC_INSTANCE);
+static const nrf_drv_timer_t m_timer = NRF_DRV_TIMER_INSTANCE(APP_TIMESTAMP_TIMER_INSTANCE);
+
+static volatile uint32_t m_rtc_overflows;   /**< Number of RTC overflows. */
+static volatile uint32_t m_timer_wraps;     /**< Number of TIMER overflows since the TIMER was started. */
+static uint64_t          m_rtc_offset;      /**< Added to the RTC time, so that it continues from the last TIMER time. */
+static uint64_t          m_timer_base;      /**< Timestamp when the TIMER was started. */
+static uint32_t          m_hires_requests;  /**< Number of requests for the high resolution. */
+static uint32_t          m_channels;        /**< Bit mask of the allocated capture channels. */
+static bool              m_initialized;
+
+
+static void rtc_handler(nrf_drv_rtc_int_type_t int_type)
+{
+    if (int_type == NRF_DRV_RTC_INT_OVERFLOW)
+    {
+        m_rtc_overflows++;
+    }
+}
+
+
+static void timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    if (event_type == nrf_timer_compare_event_get(OVERFLOW_CHANNEL))
+    {
+        m_timer_wraps++;
+    }
+}
+
+
+/**@brief Function for getting the RTC time in timestamp units. Call it with interrupts disabled. */
+static uint64_t rtc_time_get(void)
+{
+    uint32_t counter   = nrf_drv_rtc_counter_get(&m_rtc);
+    uint64_t overflows = m_rtc_overflows;
+
+    // The overflow interrupt may be pending. The event is set before the counter is read if the
+    // counter is low.
+    if (nrf_rtc_event_pending(m_rtc.p_reg, NRF_RTC_EVENT_OVERFLOW) && (counter < RTC_HALF_SCALE))
+    {
+        overflows++;
+    }
+
+    uint64_t ticks = (overflows << RTC_COUNTER_BITS) | counter;
+
+    // Split, to not overflow 64 bits when the time is long.
+    return (ticks >> 15) * APP_TIMESTAMP_HZ +
+           (((ticks & (RTC_INPUT_FREQ - 1)) * APP_TIMESTAMP_HZ) >> 15);
+}
+
+
+/**@brief Function for getting the TIMER counter extended with the overflows. Call it with
+ *        interrupts disabled. */
+static uint64_t timer_ticks_get(void)
+{
+    uint32_t counter = nrf_drv_timer_capture(&m_timer, READ_CHANNEL);
+    uint64_t wraps   = m_timer_wraps;
+
+    if (nrf_timer_event_check(m_timer.p_reg, nrf_timer_compare_event_get(OVERFLOW_CHANNEL)) &&
+        (counter < TIMER_HALF_SCALE))
+    {
+        wraps++;
+    }
+
+    return (wraps << APP_TIMESTAMP_TIMER_BIT_WIDTH) | counter;
+}
+
+
+/**@brief Function for getting the timestamp. Call it with interrupts disabled. */
+static uint64_t timestamp_get(void)
+{
+    if (m_hires_requests > 0)
+    {
+        return m_timer_base + timer_ticks_get();
+    }
+    return rtc_time_get() + m_rtc_offset;
+}
+
+
+ret_code_t app_timestamp_init(void)
+{
+    ret_code_t err_code;
+
+    if (m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    nrf_drv_rtc_config_t rtc_config =
+    {
+        .prescaler          = 0,
+        .interrupt_priority = APP_TIMESTAMP_IRQ_PRIORITY,
+        .tick_latency       = 0,
+        .reliable           = false
+    };
+
+    err_code = nrf_drv_rtc_init(&m_rtc, &rtc_config, rtc_handler);
+    VERIFY_SUCCESS(err_code);
+
+    nrf_drv_timer_config_t timer_config =
+    {
+        .frequency          = APP_TIMESTAMP_TIMER_FREQUENCY,
+        .mode               = NRF_TIMER_MODE_TIMER,
+        .bit_width          = TIMER_BIT_WIDTH,
+        .interrupt_priority = APP_TIMESTAMP_IRQ_PRIORITY,
+        .p_context          = NULL
+    };
+
+    err_code = nrf_drv_timer_init(&m_timer, &timer_config, timer_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        nrf_drv_rtc_uninit(&m_rtc);
+        return err_code;
+    }
+    nrf_drv_timer_compare(&m_timer, (nrf_timer_cc_channel_t)OVERFLOW_CHANNEL, 0, true);
+
+    m_rtc_overflows  = 0;
+    m_rtc_offset     = 0;
+    m_hires_requests = 0;
+    m_channels       = 0;
+
+    nrf_drv_clock_lfclk_request(NULL);
+    nrf_drv_rtc_overflow_enable(&m_rtc, true);
+    nrf_drv_rtc_enable(&m_rtc);
+
+    m_initialized = true;
+    return NRF_SUCCESS;
+}
+
+
+void app_timestamp_hires_request(void)
+{
+    bool start = false;
+
+    CRITICAL_REGION_ENTER();
+    if (m_hires_requests++ == 0)
+    {
+        m_timer_base  = rtc_time_get() + m_rtc_offset;
+        m_timer_wraps = 0;
+        nrf_drv_timer_clear(&m_timer);
+        nrf_drv_timer_enable(&m_timer);
+        start = true;
+    }
+    CRITICAL_REGION_EXIT();
+
+    // The clock driver has its own critical regions.
+    if (start)
+    {
+        nrf_drv_clock_hfclk_request(NULL);
+    }
+}
+
+
+void app_timestamp_hires_release(void)
+{
+    bool stop = false;
+
+    CRITICAL_REGION_ENTER();
+    ASSERT(m_hires_requests > 0);
+    if (m_hires_requests == 1)
+    {
+        // Continue from the TIMER time, which may be ahead of the RTC time.
+        m_rtc_offset = m_timer_base + timer_ticks_get() - rtc_time_get();
+        nrf_drv_timer_disable(&m_timer);
+        stop = true;
+    }
+    m_hires_requests--;
+    CRITICAL_REGION_EXIT();
+
+    if (stop)
+    {
+        nrf_drv_clock_hfclk_release();
+    }
+}
+
+
+bool app_timestamp_hires_is_active(void)
+{
+    return (m_hires_requests > 0);
+}
+
+
+uint64_t app_timestamp_get(void)
+{
+    uint64_t timestamp;
+
+    CRITICAL_REGION_ENTER();
+    timestamp = timestamp_get();
+    CRITICAL_REGION_EXIT();
+
+    return timestamp;
+}
+
+
+ret_code_t app_timestamp_capture_channel_alloc(nrf_timer_cc_channel_t * p_channel)
+{
+    ret_code_t err_code = NRF_ERROR_NO_MEM;
+    uint32_t   i;
+
+    VERIFY_PARAM_NOT_NULL(p_channel);
+
+    CRITICAL_REGION_ENTER();
+    for (i = READ_CHANNEL + 1; i < OVERFLOW_CHANNEL; i++)
+    {
+        if ((m_channels & (1UL << i)) == 0)
+        {
+            m_channels |= (1UL << i);
+            *p_channel  = (nrf_timer_cc_channel_t)i;
+            err_code    = NRF_SUCCESS;
+            break;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+
+uint32_t app_timestamp_capture_task_address_get(nrf_timer_cc_channel_t channel)
+{
+    return nrf_drv_timer_capture_task_address_get(&m_timer, channel);
+}
+
+
+uint64_t app_timestamp_capture_get(nrf_timer_cc_channel_t channel)
+{
+    return app_timestamp_from_timer(nrf_drv_timer_capture_get(&m_timer, channel));
+}
+
+
+uint64_t app_timestamp_from_timer(uint32_t ticks)
+{
+    uint64_t timestamp;
+
+    CRITICAL_REGION_ENTER();
+    uint64_t now = timer_ticks_get();
+    // The value is in the past, at most one TIMER period ago.
+    timestamp = m_timer_base + now - (((uint32_t)now - ticks) & TIMER_MASK);
+    CRITICAL_REGION_EXIT();
+
+    return timestamp;
+}
+
+
+nrf_drv_timer_t const * app_timestamp_timer_get(void)
+{
+    return &m_timer;
+}
@@ -0,0 +1,175 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_TIMESTAMP_H__
+#define APP_TIMESTAMP_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_drv_timer.h"
+#include "nrf_drv_rtc.h"
+#include "sdk_errors.h"
+
+/**
+ * @defgroup app_timestamp Timestamp service
+ * @{
+ * @ingroup app_common
+ *
+ * @brief Module providing a monotonic 64-bit timestamp shared by drivers and instrumentation.
+ *
+ * @details The timestamp is counted by an RTC instance, at 32768 Hz, as long as no module needs
+ *          a higher resolution. Modules that do call @ref app_timestamp_hires_request. The
+ *          HFCLK is then requested and a TIMER instance is started, and the timestamp is counted
+ *          by the TIMER until the last module calls @ref app_timestamp_hires_release. The
+ *          timestamp does not go back when the counter changes.
+ *
+ *          Timestamps are in units of @ref APP_TIMESTAMP_HZ in both cases, so that the two
+ *          counters are hidden from the modules. Both counters are extended to 64 bits by their
+ *          overflow interrupts.
+ *
+ *          While the TIMER runs, events of other peripherals can be timestamped by hardware:
+ *          a module allocates a capture channel with @ref app_timestamp_capture_channel_alloc,
+ *          connects the event to the capture task through PPI, and converts the captured value
+ *          with @ref app_timestamp_capture_get. Modules which take a timer instance, such as
+ *          @ref app_gpiote_timestamp, can use @ref app_timestamp_timer_get with an allocated
+ *          channel, and convert their values with @ref app_timestamp_from_timer.
+ *
+ *          The RTC and TIMER instances must be enabled in nrf_drv_config.h. The RTC cannot be
+ *          RTC1 if the app_timer module is used, as app_timer clears its counter. On nRF51,
+ *          RTC0 is used by the SoftDevice, so the module cannot be used together with
+ *          app_timer.
+ */
+
+#ifndef APP_TIMESTAMP_RTC_INSTANCE
+#if defined(NRF52)
+#define APP_TIMESTAMP_RTC_INSTANCE      2                       /**< RTC instance. */
+#else
+#define APP_TIMESTAMP_RTC_INSTANCE      1                       /**< RTC instance. */
+#endif
+#endif
+
+#ifndef APP_TIMESTAMP_TIMER_INSTANCE
+#if defined(NRF52)
+#define APP_TIMESTAMP_TIMER_INSTANCE    3                       /**< TIMER instance. */
+#else
+#define APP_TIMESTAMP_TIMER_INSTANCE    1                       /**< TIMER instance. */
+#endif
+#endif
+
+#ifndef APP_TIMESTAMP_TIMER_FREQUENCY
+#if defined(NRF52)
+#define APP_TIMESTAMP_TIMER_FREQUENCY   NRF_TIMER_FREQ_16MHz    /**< TIMER frequency, which is the unit of the timestamps. */
+#else
+#define APP_TIMESTAMP_TIMER_FREQUENCY   NRF_TIMER_FREQ_1MHz     /**< TIMER frequency, which is the unit of the timestamps. The nRF51 TIMER1 and TIMER2 are 16-bit wide, so a lower frequency gives fewer overflow interrupts. */
+#endif
+#endif
+
+#ifndef APP_TIMESTAMP_TIMER_BIT_WIDTH
+#if defined(NRF52) || (APP_TIMESTAMP_TIMER_INSTANCE == 0)
+#define APP_TIMESTAMP_TIMER_BIT_WIDTH   32                      /**< Width of the TIMER counter, 16 or 32. */
+#else
+#define APP_TIMESTAMP_TIMER_BIT_WIDTH   16                      /**< Width of the TIMER counter, 16 or 32. */
+#endif
+#endif
+
+#ifndef APP_TIMESTAMP_IRQ_PRIORITY
+#define APP_TIMESTAMP_IRQ_PRIORITY      APP_IRQ_PRIORITY_LOW    /**< Priority of the overflow interrupts. */
+#endif
+
+#define APP_TIMESTAMP_HZ                (16000000UL >> APP_TIMESTAMP_TIMER_FREQUENCY)   /**< Frequency of the timestamps. */
+
+/**@brief Macro for converting a timestamp to microseconds. */
+#define APP_TIMESTAMP_TO_US(timestamp)  (((uint64_t)(timestamp) * 1000000) / APP_TIMESTAMP_HZ)
+
+/**
+ * @brief Function for initializing the module and starting the RTC.
+ *
+ * The clock driver must be initialized before, with @ref nrf_drv_clock_init.
+ *
+ * @retval NRF_SUCCESS If the module was initialized.
+ * @return Other errors from the RTC or timer drivers.
+ */
+ret_code_t app_timestamp_init(void);
+
+/**
+ * @brief Function for requesting the high resolution.
+ *
+ * Requests are counted, and the TIMER runs until all of them are released. The first request
+ * requests the HFCLK from the clock driver; the TIMER counts from the start, and is exact once
+ * the crystal oscillator has started.
+ */
+void app_timestamp_hires_request(void);
+
+/**
+ * @brief Function for releasing a request for the high resolution.
+ */
+void app_timestamp_hires_release(void);
+
+/**
+ * @brief Function for checking if the timestamp is counted by the TIMER.
+ */
+bool app_timestamp_hires_is_active(void);
+
+/**
+ * @brief Function for getting the current timestamp.
+ *
+ * Can be called from any context.
+ *
+ * @return Timestamp in units of @ref APP_TIMESTAMP_HZ.
+ */
+uint64_t app_timestamp_get(void);
+
+/**
+ * @brief Function for allocating a capture channel of the TIMER.
+ *
+ * @param[out] p_channel Channel.
+ *
+ * @retval NRF_SUCCESS      If a channel was allocated.
+ * @retval NRF_ERROR_NO_MEM If all channels are allocated.
+ */
+ret_code_t app_timestamp_capture_channel_alloc(nrf_timer_cc_channel_t * p_channel);
+
+/**
+ * @brief Function for getting the address of the capture task of a channel, to be connected to
+ *        an event through PPI.
+ *
+ * @param[in] channel Channel allocated with @ref app_timestamp_capture_channel_alloc.
+ */
+uint32_t app_timestamp_capture_task_address_get(nrf_timer_cc_channel_t channel);
+
+/**
+ * @brief Function for getting the timestamp of the last capture of a channel.
+ *
+ * The capture must have happened while the high resolution was active, and less than one TIMER
+ * period before the call (4 minutes with the nRF52 defaults, 65 ms with the nRF51 defaults).
+ *
+ * @param[in] channel Channel allocated with @ref app_timestamp_capture_channel_alloc.
+ */
+uint64_t app_timestamp_capture_get(nrf_timer_cc_channel_t channel);
+
+/**
+ * @brief Function for converting a value of the TIMER counter to a timestamp.
+ *
+ * The same conditions as for @ref app_timestamp_capture_get apply.
+ *
+ * @param[in] ticks Value of the TIMER counter, for example captured through PPI.
+ */
+uint64_t app_timestamp_from_timer(uint32_t ticks);
+
+/**
+ * @brief Function for getting the TIMER instance, for modules that capture it.
+ */
+nrf_drv_timer_t const * app_timestamp_timer_get(void);
+
+/** @} */
+
+#endif // APP_TIMESTAMP_H__
@@ -14,6 +14,12 @@
 #include "nrf_assert.h"
 #include "app_util_platform.h"
 #include "sdk_common.h"
+#if APP_TWI_REPEAT_ENABLED
+#include "nrf_twim.h"
+#ifndef TWIM_IN_USE
+#error "APP_TWI_REPEAT_ENABLED requires a TWI instance with EasyDMA (TWIM)."
+#endif
+#endif
 
 
 // Increase specified queue index and when it goes outside the queue move it
@@ -193,6 +199,238 @@ static void start_pending_transaction(app_twi_t * p_app_twi,
 }
 
 
+#if APP_TWI_REPEAT_ENABLED
+static void repeat_release(app_twi_t * p_app_twi)
+{
+    app_twi_repeat_t const * p_repeat = p_app_twi->p_repeat;
+    uint8_t i;
+
+    for (i = 0; i < APP_TWI_REPEAT_PPI_CHANNELS; ++i)
+    {
+        (void)nrf_drv_ppi_channel_disable(p_app_twi->ppi_channels[i]);
+        (void)nrf_drv_ppi_channel_free(p_app_twi->ppi_channels[i]);
+    }
+    (void)nrf_drv_ppi_group_free(p_app_twi->ppi_group);
+
+    if (p_repeat->interval_us != 0)
+    {
+        nrf_drv_timer_uninit(p_repeat->p_interval_timer);
+    }
+    nrf_drv_timer_uninit(p_repeat->p_counter_timer);
+
+    p_app_twi->p_repeat = NULL;
+}
+
+
+static void repeat_counter_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    app_twi_t * p_app_twi = (app_twi_t *)p_context;
+
+    if ((event_type == NRF_TIMER_EVENT_COMPARE0) && (p_app_twi->p_repeat != NULL))
+    {
+        // [no more transfers can be started at this point - the interval timer
+        //  or the channel group has already been stopped through PPI]
+        repeat_release(p_app_twi);
+
+        signal_end_of_transaction(p_app_twi, NRF_SUCCESS);
+        start_pending_transaction(p_app_twi, true);
+    }
+}
+
+
+static void repeat_interval_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+
+static ret_code_t repeat_timers_init(app_twi_t * p_app_twi)
+{
+    app_twi_repeat_t const * p_repeat = p_app_twi->p_repeat;
+    nrf_drv_timer_config_t   timer_config;
+    ret_code_t               err_code;
+
+    timer_config.frequency          = NRF_TIMER_FREQ_1MHz;
+    timer_config.mode               = NRF_TIMER_MODE_COUNTER;
+    timer_config.bit_width          = NRF_TIMER_BIT_WIDTH_32;
+    timer_config.interrupt_priority = p_app_twi->irq_priority;
+    timer_config.p_context          = p_app_twi;
+    err_code = nrf_drv_timer_init(p_repeat->p_counter_timer, &timer_config,
+                                  repeat_counter_handler);
+    VERIFY_SUCCESS(err_code);
+
+    if (p_repeat->interval_us != 0)
+    {
+        timer_config.mode = NRF_TIMER_MODE_TIMER;
+        err_code = nrf_drv_timer_init(p_repeat->p_interval_timer, &timer_config,
+                                      repeat_interval_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            nrf_drv_timer_uninit(p_repeat->p_counter_timer);
+        }
+    }
+
+    return err_code;
+}
+
+
+// Sets up the following connections:
+// - TWIM STOPPED            -> counter timer COUNT,
+// - interval timer COMPARE0 -> TWIM START,
+//   or if the interval is 0:
+//   TWIM STOPPED            -> TWIM START (channel in group),
+// - counter timer COMPARE0  -> interval timer STOP,
+//   or if the interval is 0:
+//   counter timer COMPARE1  -> group DISABLE (after the last transfer is started),
+// - TWIM ERROR              -> the same task as above.
+static ret_code_t repeat_setup(app_twi_t * p_app_twi, nrf_drv_twi_xfer_type_t xfer_type)
+{
+    app_twi_repeat_t const * p_repeat = p_app_twi->p_repeat;
+    nrf_drv_timer_t const *  p_counter = p_repeat->p_counter_timer;
+    uint32_t                 stopped_event = nrf_drv_twi_stopped_event_get(&p_app_twi->twi);
+    uint32_t                 start_task = nrf_drv_twi_start_task_get(&p_app_twi->twi, xfer_type);
+    uint32_t                 error_event;
+    uint32_t                 stop_task;
+    ret_code_t               err_code;
+    uint8_t                  i;
+
+    error_event = (uint32_t)nrf_twim_event_address_get(p_app_twi->twi.reg.p_twim,
+                                                       NRF_TWIM_EVENT_ERROR);
+
+    err_code = nrf_drv_ppi_init();
+    if ((err_code != NRF_SUCCESS) && (err_code != MODULE_ALREADY_INITIALIZED))
+    {
+        return err_code;
+    }
+
+    err_code = repeat_timers_init(p_app_twi);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = nrf_drv_ppi_group_alloc(&p_app_twi->ppi_group);
+    for (i = 0; (err_code == NRF_SUCCESS) && (i < APP_TWI_REPEAT_PPI_CHANNELS); ++i)
+    {
+        err_code = nrf_drv_ppi_channel_alloc(&p_app_twi->ppi_channels[i]);
+        if (err_code != NRF_SUCCESS)
+        {
+            while (i-- > 0)
+            {
+                (void)nrf_drv_ppi_channel_free(p_app_twi->ppi_channels[i]);
+            }
+            (void)nrf_drv_ppi_group_free(p_app_twi->ppi_group);
+        }
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        if (p_repeat->interval_us != 0)
+        {
+            nrf_drv_timer_uninit(p_repeat->p_interval_timer);
+        }
+        nrf_drv_timer_uninit(p_counter);
+        return err_code;
+    }
+
+    nrf_drv_timer_extended_compare(p_counter,
+        NRF_TIMER_CC_CHANNEL0,
+        p_repeat->count,
+        NRF_TIMER_SHORT_COMPARE0_STOP_MASK,
+        true);
+    nrf_drv_timer_enable(p_counter);
+    nrf_drv_timer_clear(p_counter);
+
+    err_code = nrf_drv_ppi_channel_assign(p_app_twi->ppi_channels[0], stopped_event,
+        nrf_drv_timer_task_address_get(p_counter, NRF_TIMER_TASK_COUNT));
+
+    if (p_repeat->interval_us != 0)
+    {
+        nrf_drv_timer_t const * p_interval = p_repeat->p_interval_timer;
+
+        nrf_drv_timer_extended_compare(p_interval,
+            NRF_TIMER_CC_CHANNEL0,
+            nrf_drv_timer_us_to_ticks(p_interval, p_repeat->interval_us),
+            NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
+            false);
+        // [the timer has to be powered on to be uninitialized properly - pause
+        //  it right away, it is started when everything is connected]
+        nrf_drv_timer_enable(p_interval);
+        nrf_drv_timer_pause(p_interval);
+        nrf_drv_timer_clear(p_interval);
+
+        stop_task = nrf_drv_timer_task_address_get(p_interval, NRF_TIMER_TASK_STOP);
+
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = nrf_drv_ppi_channel_assign(p_app_twi->ppi_channels[1],
+                nrf_drv_timer_compare_event_address_get(p_interval, 0), start_task);
+        }
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = nrf_drv_ppi_channel_assign(p_app_twi->ppi_channels[2],
+                nrf_drv_timer_compare_event_address_get(p_counter, 0), stop_task);
+        }
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = nrf_drv_ppi_channel_enable(p_app_twi->ppi_channels[1]);
+        }
+    }
+    else
+    {
+        // [the STOPPED event is counted before the next START is triggered by
+        //  the same event, so the compare after count - 1 transfers prevents
+        //  the transfer that would follow the last one]
+        nrf_drv_timer_compare(p_counter, NRF_TIMER_CC_CHANNEL1, p_repeat->count - 1, false);
+
+        stop_task = nrf_drv_ppi_task_addr_group_disable_get(p_app_twi->ppi_group);
+
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = nrf_drv_ppi_channel_assign(p_app_twi->ppi_channels[1],
+                stopped_event, start_task);
+        }
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = nrf_drv_ppi_channel_assign(p_app_twi->ppi_channels[2],
+                nrf_drv_timer_compare_event_address_get(p_counter, 1), stop_task);
+        }
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = nrf_drv_ppi_channel_include_in_group(p_app_twi->ppi_channels[1],
+                                                            p_app_twi->ppi_group);
+        }
+        // [with a single transfer there is nothing to chain]
+        if ((err_code == NRF_SUCCESS) && (p_repeat->count > 1))
+        {
+            err_code = nrf_drv_ppi_group_enable(p_app_twi->ppi_group);
+        }
+    }
+
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_assign(p_app_twi->ppi_channels[3],
+            error_event, stop_task);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_enable(p_app_twi->ppi_channels[0]);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_enable(p_app_twi->ppi_channels[2]);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = nrf_drv_ppi_channel_enable(p_app_twi->ppi_channels[3]);
+    }
+
+    if (err_code != NRF_SUCCESS)
+    {
+        repeat_release(p_app_twi);
+    }
+    return err_code;
+}
+#endif // APP_TWI_REPEAT_ENABLED
+
+
 static void twi_event_handler(nrf_drv_twi_evt_t const * p_event,
                               void *                    p_context)
 {
@@ -204,6 +442,20 @@ static void twi_event_handler(nrf_drv_twi_evt_t const * p_event,
     // This callback should be called only during transaction.
     ASSERT(p_app_twi->p_current_transaction != NULL);
 
+#if APP_TWI_REPEAT_ENABLED
+    if (p_app_twi->p_repeat != NULL)
+    {
+        // [events are suppressed for repeated transfers, so this one reports
+        //  an error - the remaining transfers have already been cancelled
+        //  through PPI]
+        repeat_release(p_app_twi);
+
+        signal_end_of_transaction(p_app_twi, NRF_ERROR_INTERNAL);
+        start_pending_transaction(p_app_twi, true);
+        return;
+    }
+#endif
+
     if (p_event->type == NRF_DRV_TWI_EVT_DONE)
     {
         result = NRF_SUCCESS;
@@ -274,6 +526,12 @@ ret_code_t app_twi_init(app_twi_t *                     p_app_twi,
     p_app_twi->internal_transaction_in_progress = false;
     p_app_twi->p_current_transaction            = NULL;
 
+#if APP_TWI_REPEAT_ENABLED
+    p_app_twi->p_repeat     = NULL;
+    p_app_twi->irq_priority = (p_twi_config != NULL) ? p_twi_config->interrupt_priority :
+                                                       APP_IRQ_PRIORITY_LOW;
+#endif
+
     return NRF_SUCCESS;
 }
 
@@ -282,6 +540,13 @@ void app_twi_uninit(app_twi_t * p_app_twi)
 {
     ASSERT(p_app_twi != NULL);
 
+#if APP_TWI_REPEAT_ENABLED
+    if (p_app_twi->p_repeat != NULL)
+    {
+        repeat_release(p_app_twi);
+    }
+#endif
+
     nrf_drv_twi_uninit(&(p_app_twi->twi));
 
     p_app_twi->p_current_transaction = NULL;
@@ -374,3 +639,100 @@ ret_code_t app_twi_perform(app_twi_t *                p_app_twi,
         return p_app_twi->internal_transaction_result;
     }
 }
+
+
+#if APP_TWI_REPEAT_ENABLED
+ret_code_t app_twi_repeat_start(app_twi_t *              p_app_twi,
+                                app_twi_repeat_t const * p_repeat)
+{
+    ASSERT(p_app_twi != NULL);
+    ASSERT(p_repeat != NULL);
+    ASSERT(p_repeat->count != 0);
+    ASSERT(p_repeat->rx_length != 0);
+    ASSERT((p_repeat->interval_us == 0) || (p_repeat->p_interval_timer != NULL));
+    ASSERT(p_repeat->p_counter_timer != NULL);
+
+    nrf_drv_twi_xfer_desc_t xfer_desc;
+    uint32_t                flags;
+    ret_code_t              result;
+    bool                    busy = false;
+
+    // Array list mode is needed to store the data from consecutive transfers.
+    if (!p_app_twi->twi.use_easy_dma)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    if (p_repeat->tx_length != 0)
+    {
+        xfer_desc = (nrf_drv_twi_xfer_desc_t)NRF_DRV_TWI_XFER_DESC_TXRX(p_repeat->address,
+                                                p_repeat->p_tx_data, p_repeat->tx_length,
+                                                p_repeat->p_rx_list, p_repeat->rx_length);
+    }
+    else
+    {
+        xfer_desc = (nrf_drv_twi_xfer_desc_t)NRF_DRV_TWI_XFER_DESC_RX(p_repeat->address,
+                                                p_repeat->p_rx_list, p_repeat->rx_length);
+    }
+
+    flags = NRF_DRV_TWI_FLAG_RX_POSTINC    |
+            NRF_DRV_TWI_FLAG_REPEATED_XFER |
+            NRF_DRV_TWI_FLAG_NO_XFER_EVT_HANDLER;
+    if (p_repeat->flags & APP_TWI_REPEAT_TX_LIST)
+    {
+        flags |= NRF_DRV_TWI_FLAG_TX_POSTINC;
+    }
+    // [with an interval the first transfer is started by the interval timer]
+    if (p_repeat->interval_us != 0)
+    {
+        flags |= NRF_DRV_TWI_FLAG_HOLD_XFER;
+    }
+
+    p_app_twi->repeat_transaction.callback            = p_repeat->callback;
+    p_app_twi->repeat_transaction.p_user_data         = p_repeat->p_user_data;
+    p_app_twi->repeat_transaction.p_transfers         = NULL;
+    p_app_twi->repeat_transaction.number_of_transfers = 0;
+
+    // Occupy the bus, so that scheduled transactions wait in the queue.
+    CRITICAL_REGION_ENTER();
+    if (!app_twi_is_idle(p_app_twi))
+    {
+        busy = true;
+    }
+    else
+    {
+        p_app_twi->p_current_transaction = &p_app_twi->repeat_transaction;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    p_app_twi->p_repeat = p_repeat;
+    result = repeat_setup(p_app_twi, xfer_desc.type);
+
+    if (result == NRF_SUCCESS)
+    {
+        result = nrf_drv_twi_xfer(&p_app_twi->twi, &xfer_desc, flags);
+        if (result == NRF_SUCCESS)
+        {
+            if (p_repeat->interval_us != 0)
+            {
+                nrf_drv_timer_resume(p_repeat->p_interval_timer);
+            }
+            return NRF_SUCCESS;
+        }
+        repeat_release(p_app_twi);
+    }
+    else
+    {
+        p_app_twi->p_repeat = NULL;
+    }
+
+    // Release the bus and start transactions that were scheduled in the meantime.
+    start_pending_transaction(p_app_twi, true);
+    return result;
+}
+#endif // APP_TWI_REPEAT_ENABLED
@@ -17,6 +17,22 @@
 #include "nrf_drv_twi.h"
 #include "sdk_errors.h"
 
+/**
+ * @brief Enable sequences of transfers chained by PPI (TWIM only).
+ *
+ * @ref app_twi_repeat_start uses one or two TIMER instances, four PPI channels,
+ * and one PPI channel group, so the timer and PPI drivers must be included in
+ * the project when this option is enabled.
+ */
+#ifndef APP_TWI_REPEAT_ENABLED
+#define APP_TWI_REPEAT_ENABLED 0
+#endif
+
+#if APP_TWI_REPEAT_ENABLED
+#include "nrf_drv_timer.h"
+#include "nrf_drv_ppi.h"
+#endif
+
 /**
  * @defgroup app_twi TWI transaction manager
  * @{
@@ -38,6 +54,22 @@
  */
 #define APP_TWI_NO_STOP     0x01
 
+#if APP_TWI_REPEAT_ENABLED
+/**
+ * @brief Flag indicating that every transfer in a sequence of repeated
+ *        transfers should send the next block of the TX buffer.
+ *
+ * Use this flag to read several register blocks of the same length, for
+ * example, from an IMU. The TX buffer then holds one register address block
+ * per transfer. Without this flag the same data is sent in every transfer,
+ * which is suitable for periodic reading of the same registers.
+ */
+#define APP_TWI_REPEAT_TX_LIST  0x01
+
+/**@brief Number of PPI channels occupied by a sequence of repeated transfers. */
+#define APP_TWI_REPEAT_PPI_CHANNELS 4
+#endif
+
 /**
  * @brief Macro for creating a write transfer.
  *
@@ -124,6 +156,55 @@ typedef struct {
     ///< Number of transfers that make up the transaction.
 } app_twi_transaction_t;
 
+#if APP_TWI_REPEAT_ENABLED
+/**
+ * @brief Descriptor of a sequence of repeated transfers.
+ *
+ * Every transfer writes a register address (unless tx_length is 0) and reads
+ * rx_length bytes with a repeated start condition in between. The received
+ * data is stored in the next element of an array list, so that after the
+ * sequence is finished the buffer holds count * rx_length bytes.
+ */
+typedef struct {
+    app_twi_callback_t      callback;
+    ///< User-specified function to be called after the last transfer.
+
+    void *                  p_user_data;
+    ///< Pointer to user data to be passed to the callback.
+
+    uint8_t *               p_tx_data;
+    ///< Data sent in every transfer, or a list of such blocks (see @ref APP_TWI_REPEAT_TX_LIST).
+
+    uint8_t *               p_rx_list;
+    ///< Buffer for received data, count * rx_length bytes.
+
+    uint8_t                 tx_length;
+    ///< Number of bytes sent in every transfer, 0 for read-only transfers.
+
+    uint8_t                 rx_length;
+    ///< Number of bytes received in every transfer.
+
+    uint8_t                 address;
+    ///< Slave address.
+
+    uint8_t                 flags;
+    ///< Sequence flags (see @ref APP_TWI_REPEAT_TX_LIST).
+
+    uint32_t                count;
+    ///< Number of transfers.
+
+    uint32_t                interval_us;
+    ///< Time between the starts of consecutive transfers. 0 means that every
+    ///< transfer is started directly after the previous one has finished.
+
+    nrf_drv_timer_t const * p_interval_timer;
+    ///< Timer instance that triggers the transfers. Not used if interval_us is 0.
+
+    nrf_drv_timer_t const * p_counter_timer;
+    ///< Timer instance that counts finished transfers.
+} app_twi_repeat_t;
+#endif
+
 /**
  * @brief TWI transaction queue.
  */
@@ -153,6 +234,23 @@ typedef struct {
     app_twi_transaction_t const * volatile p_current_transaction;
     ///< Currently realized transaction.
 
+#if APP_TWI_REPEAT_ENABLED
+    app_twi_repeat_t const * volatile p_repeat;
+    ///< Currently realized sequence of repeated transfers.
+
+    app_twi_transaction_t repeat_transaction;
+    ///< Transaction that occupies the bus while repeated transfers are performed.
+
+    nrf_ppi_channel_t ppi_channels[APP_TWI_REPEAT_PPI_CHANNELS];
+    ///< PPI channels used by repeated transfers.
+
+    nrf_ppi_channel_group_t ppi_group;
+    ///< PPI channel group used to stop back-to-back transfers.
+
+    uint8_t irq_priority;
+    ///< Interrupt priority of the TWI master driver instance.
+#endif
+
     nrf_drv_twi_t const twi;
     ///< TWI master driver instance.
 } app_twi_t;
@@ -269,6 +367,41 @@ ret_code_t app_twi_perform(app_twi_t *                p_app_twi,
                            uint8_t                    number_of_transfers,
                            void (* user_function)(void));
 
+#if APP_TWI_REPEAT_ENABLED
+/**
+ * @brief Function for starting a sequence of repeated transfers.
+ *
+ * The transfer is set up once, with the TWIM shortcuts that issue a repeated
+ * start condition between writing the register address and reading the data,
+ * and with EasyDMA array list mode for reception. The consecutive transfers
+ * are then started through PPI, either by the interval timer or, if
+ * the interval is 0, directly by the STOPPED event of the previous transfer.
+ * Finished transfers are counted by the counter timer, which ends the sequence.
+ * The CPU is not involved until the whole sequence is finished and the
+ * callback is called.
+ *
+ * If the interval is not 0, the first transfer is started one interval after
+ * this function is called, and the interval must be longer than a single
+ * transfer. Otherwise, the first transfer is started immediately.
+ *
+ * Transactions scheduled during the sequence are started after it is finished.
+ * If the slave does not acknowledge a transfer, the sequence is ended and the
+ * callback is called with NRF_ERROR_INTERNAL.
+ *
+ * @param[in] p_app_twi Pointer to the TWI transaction manager instance.
+ * @param[in] p_repeat  Pointer to the descriptor of the sequence. It must stay
+ *                      valid until the callback is called.
+ *
+ * @retval NRF_SUCCESS             If the sequence has been started.
+ * @retval NRF_ERROR_BUSY          If the bus is not idle.
+ * @retval NRF_ERROR_NOT_SUPPORTED If the TWI instance does not use EasyDMA.
+ * @retval -                       Other error codes are returned by the timer, PPI,
+ *                                 or TWI master driver.
+ */
+ret_code_t app_twi_repeat_start(app_twi_t *              p_app_twi,
+                                app_twi_repeat_t const * p_repeat);
+#endif
+
 /**
  * @brief Function for getting the current state of a TWI transaction manager
  *        instance.
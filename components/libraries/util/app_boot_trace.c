@@ -0,0 +1,148 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_boot_trace.h"
+
+#if (APP_BOOT_TRACE_ENABLED == 1)
+
+#include <stdbool.h>
+#include "nrf.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+#ifdef NRF52
+#define BOOT_TRACE_TIMER_MASK       0xFFFFFFFFUL                    /**< Timer width. */
+#define BOOT_TRACE_TIMER_BITMODE    TIMER_BITMODE_BITMODE_32Bit
+#define BOOT_TRACE_TIMER_PRESCALER  4                               /**< 1 us ticks. */
+#define BOOT_TRACE_TICKS_TO_US(t)   (t)
+#else
+#define BOOT_TRACE_TIMER_MASK       0xFFFFUL                        /**< Timer width. */
+#define BOOT_TRACE_TIMER_BITMODE    TIMER_BITMODE_BITMODE_16Bit
+#define BOOT_TRACE_TIMER_PRESCALER  9                               /**< 32 us ticks. */
+#define BOOT_TRACE_TICKS_TO_US(t)   ((t) << 5)
+#endif
+
+typedef struct
+{
+    char const * p_name;
+    uint32_t     time_us;
+} boot_trace_mark_t;
+
+static boot_trace_mark_t m_marks[APP_BOOT_TRACE_MARKS];
+static uint32_t          m_mark_count;      // Number of marks, including those which were not kept.
+static uint32_t          m_last_ticks;      // Timer value at the last time reading.
+static uint32_t          m_time_us;         // Time at the last time reading.
+static bool              m_running;
+
+
+// Must be called in a critical region. On nRF51, the 16-bit timer is extended by accumulating
+// the time between readings.
+static uint32_t time_update(void)
+{
+    APP_BOOT_TRACE_TIMER->TASKS_CAPTURE[0] = 1;
+
+    uint32_t const ticks = APP_BOOT_TRACE_TIMER->CC[0];
+
+    m_time_us   += BOOT_TRACE_TICKS_TO_US((ticks - m_last_ticks) & BOOT_TRACE_TIMER_MASK);
+    m_last_ticks = ticks;
+
+    return m_time_us;
+}
+
+
+void app_boot_trace_init(void)
+{
+    APP_BOOT_TRACE_TIMER->TASKS_STOP  = 1;
+    APP_BOOT_TRACE_TIMER->MODE        = TIMER_MODE_MODE_Timer;
+    APP_BOOT_TRACE_TIMER->BITMODE     = BOOT_TRACE_TIMER_BITMODE;
+    APP_BOOT_TRACE_TIMER->PRESCALER   = BOOT_TRACE_TIMER_PRESCALER;
+    APP_BOOT_TRACE_TIMER->INTENCLR    = 0xFFFFFFFF;
+    APP_BOOT_TRACE_TIMER->SHORTS      = 0;
+    APP_BOOT_TRACE_TIMER->TASKS_CLEAR = 1;
+    APP_BOOT_TRACE_TIMER->TASKS_START = 1;
+
+    CRITICAL_REGION_ENTER();
+    m_mark_count = 0;
+    m_last_ticks = 0;
+    m_time_us    = 0;
+    m_running    = true;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void app_boot_trace_mark(char const * p_name)
+{
+    CRITICAL_REGION_ENTER();
+    if (m_running)
+    {
+        if (m_mark_count < APP_BOOT_TRACE_MARKS)
+        {
+            m_marks[m_mark_count].p_name  = p_name;
+            m_marks[m_mark_count].time_us = time_update();
+        }
+        m_mark_count++;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+uint32_t app_boot_trace_time_get(void)
+{
+    uint32_t time_us = 0;
+
+    CRITICAL_REGION_ENTER();
+    if (m_running)
+    {
+        time_us = time_update();
+    }
+    CRITICAL_REGION_EXIT();
+
+    return time_us;
+}
+
+
+void app_boot_trace_dump(void)
+{
+    uint32_t count;
+    uint32_t prev_us = 0;
+
+    CRITICAL_REGION_ENTER();
+    count = m_mark_count;
+    CRITICAL_REGION_EXIT();
+
+    for (uint32_t i = 0; (i < count) && (i < APP_BOOT_TRACE_MARKS); i++)
+    {
+        (void)SEGGER_RTT_printf(APP_BOOT_TRACE_RTT_BUFFER, "BOOT %s t_us=%u delta_us=%u\r\n",
+                                m_marks[i].p_name, m_marks[i].time_us,
+                                m_marks[i].time_us - prev_us);
+        prev_us = m_marks[i].time_us;
+    }
+
+    if (count > APP_BOOT_TRACE_MARKS)
+    {
+        (void)SEGGER_RTT_printf(APP_BOOT_TRACE_RTT_BUFFER, "BOOT dropped=%u\r\n",
+                                count - APP_BOOT_TRACE_MARKS);
+    }
+}
+
+
+void app_boot_trace_stop(void)
+{
+    CRITICAL_REGION_ENTER();
+    m_running = false;
+    CRITICAL_REGION_EXIT();
+
+    APP_BOOT_TRACE_TIMER->TASKS_STOP     = 1;
+    APP_BOOT_TRACE_TIMER->TASKS_SHUTDOWN = 1;
+}
+
+#endif // APP_BOOT_TRACE_ENABLED == 1
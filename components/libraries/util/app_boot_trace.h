@@ -0,0 +1,104 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_BOOT_TRACE_H__
+#define APP_BOOT_TRACE_H__
+
+/**
+ * @defgroup app_boot_trace Boot tracer
+ * @ingroup app_common
+ * @{
+ *
+ * @brief Module for timestamping the initialization phases of an application.
+ *
+ * @details The application calls @ref app_boot_trace_init first thing in main(), and places
+ *          @ref APP_BOOT_TRACE marks after each initialization phase, for example after
+ *          ble_stack_init(), pm_init() and ble_advertising_init(). The SDK places marks when the
+ *          SoftDevice is enabled, when FDS and the Peer Manager are ready, and when advertising
+ *          is first started. @ref app_boot_trace_dump prints the marks over SEGGER RTT, with the
+ *          time since @ref app_boot_trace_init and since the previous mark.
+ *
+ *          The low frequency clock only runs once the SoftDevice is enabled, so the marks are
+ *          timestamped with the TIMER instance @ref APP_BOOT_TRACE_TIMER at 1 MHz on nRF52
+ *          devices. On nRF51 devices, the timer runs in 16-bit mode at 31.25 kHz, and marks must
+ *          be less than 2 seconds apart. The timer keeps the high frequency clock running until
+ *          @ref app_boot_trace_stop is called.
+ *
+ *          When APP_BOOT_TRACE_ENABLED is 0, the marks compile to nothing and app_boot_trace.c is
+ *          not needed.
+ */
+
+#include <stdint.h>
+
+#ifndef APP_BOOT_TRACE_ENABLED
+#define APP_BOOT_TRACE_ENABLED      0                   /**< Enable the boot tracer. */
+#endif
+
+#ifndef APP_BOOT_TRACE_MARKS
+#define APP_BOOT_TRACE_MARKS        16                  /**< Number of marks kept. Later marks are counted but not kept. */
+#endif
+
+#ifndef APP_BOOT_TRACE_TIMER
+#ifdef NRF52
+#define APP_BOOT_TRACE_TIMER        NRF_TIMER3          /**< TIMER instance used as time base. */
+#else
+#define APP_BOOT_TRACE_TIMER        NRF_TIMER1          /**< TIMER instance used as time base. */
+#endif
+#endif
+
+#ifndef APP_BOOT_TRACE_RTT_BUFFER
+#define APP_BOOT_TRACE_RTT_BUFFER   0                   /**< RTT up buffer used by @ref app_boot_trace_dump. */
+#endif
+
+
+#if (APP_BOOT_TRACE_ENABLED == 1)
+
+/**@brief Function for starting the time base. Time 0 of the trace. */
+void app_boot_trace_init(void);
+
+/**@brief Function for recording a mark.
+ *
+ * @details Can be called from any interrupt priority. Marks recorded before
+ *          @ref app_boot_trace_init are ignored.
+ *
+ * @param[in] p_name  Name of the phase which has just ended. Must be a string literal, or stay
+ *                    valid until the marks are dumped.
+ */
+void app_boot_trace_mark(char const * p_name);
+
+/**@brief Function for getting the time since @ref app_boot_trace_init, in microseconds. */
+uint32_t app_boot_trace_time_get(void);
+
+/**@brief Function for writing the marks to the RTT up buffer @ref APP_BOOT_TRACE_RTT_BUFFER.
+ *
+ * @details One line is written per mark. Should be called from the main loop once the device is
+ *          up, for example when the first connection is established.
+ */
+void app_boot_trace_dump(void);
+
+/**@brief Function for stopping the time base, so the high frequency clock can be stopped. Marks
+ *        recorded afterwards are ignored.
+ */
+void app_boot_trace_stop(void);
+
+/**@brief Macro for recording a mark. */
+#define APP_BOOT_TRACE(name)    app_boot_trace_mark(name)
+
+#else
+
+#define APP_BOOT_TRACE(name)
+
+#endif // APP_BOOT_TRACE_ENABLED == 1
+
+/** @} */
+
+#endif // APP_BOOT_TRACE_H__
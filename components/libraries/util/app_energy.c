@@ -0,0 +1,262 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_energy.h"
+
+#if (APP_ENERGY_ENABLED == 1)
+
+#include <string.h>
+#include "nrf_error.h"
+#include "nordic_common.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+#define RTC_FREQUENCY   32768   /**< RTC1 input frequency, in Hz. */
+
+typedef struct
+{
+    char const * p_name;
+    uint32_t     current_ua;
+    uint32_t     on_count;      // Number of nested calls to app_energy_source_on().
+    uint32_t     on_ticks;      // Time on in the current window.
+    uint32_t     period_ticks;  // Time since the source was last turned on.
+} energy_source_t;
+
+static energy_source_t m_sources[APP_ENERGY_SOURCE_COUNT];
+static uint32_t        m_last_tick;         // RTC1 counter at the last time update.
+static uint32_t        m_window_ticks;      // Length of the current window.
+static uint32_t        m_tick_div;          // RTC1 prescaler + 1.
+static uint32_t        m_radio_distance_ticks;
+static bool            m_initialized;
+
+
+// Must be called in a critical region.
+static void time_update(void)
+{
+    uint32_t now;
+    uint32_t elapsed;
+
+    (void)app_timer_cnt_get(&now);
+    (void)app_timer_cnt_diff_compute(now, m_last_tick, &elapsed);
+
+    m_last_tick     = now;
+    m_window_ticks += elapsed;
+
+    for (uint32_t i = 0; i < APP_ENERGY_SOURCE_COUNT; i++)
+    {
+        if (m_sources[i].on_count > 0)
+        {
+            m_sources[i].on_ticks     += elapsed;
+            m_sources[i].period_ticks += elapsed;
+        }
+    }
+}
+
+
+static uint32_t ticks_to_ms(uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * m_tick_div * 1000) / RTC_FREQUENCY);
+}
+
+
+static void source_init(uint32_t source, char const * p_name, uint32_t current_ua)
+{
+    m_sources[source].p_name     = p_name;
+    m_sources[source].current_ua = current_ua;
+}
+
+
+void app_energy_init(uint32_t rtc_prescaler, uint32_t radio_distance_us)
+{
+    CRITICAL_REGION_ENTER();
+    memset(m_sources, 0, sizeof(m_sources));
+
+    m_tick_div             = rtc_prescaler + 1;
+    m_radio_distance_ticks = (uint32_t)(((uint64_t)radio_distance_us * RTC_FREQUENCY)
+                                        / (1000000ULL * m_tick_div));
+    m_window_ticks         = 0;
+    (void)app_timer_cnt_get(&m_last_tick);
+
+    source_init(APP_ENERGY_SOURCE_BASE,  "base",  APP_ENERGY_BASE_UA);
+    source_init(APP_ENERGY_SOURCE_CPU,   "cpu",   APP_ENERGY_CPU_UA);
+    source_init(APP_ENERGY_SOURCE_RADIO, "radio", APP_ENERGY_RADIO_UA);
+    source_init(APP_ENERGY_SOURCE_HFXO,  "hfxo",  APP_ENERGY_HFXO_UA);
+
+    // The base current is always drawn, and the CPU is running.
+    m_sources[APP_ENERGY_SOURCE_BASE].on_count = 1;
+    m_sources[APP_ENERGY_SOURCE_CPU].on_count  = 1;
+
+    m_initialized = true;
+    CRITICAL_REGION_EXIT();
+}
+
+
+ret_code_t app_energy_source_register(uint32_t source, char const * p_name, uint32_t current_ua)
+{
+    if (p_name == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if ((source < APP_ENERGY_SOURCE_USER) || (source >= APP_ENERGY_SOURCE_COUNT))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    source_init(source, p_name, current_ua);
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_energy_source_current_set(uint32_t source, uint32_t current_ua)
+{
+    if (source >= APP_ENERGY_SOURCE_COUNT)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_sources[source].current_ua = current_ua;
+
+    return NRF_SUCCESS;
+}
+
+
+void app_energy_source_on(uint32_t source)
+{
+    if ((source >= APP_ENERGY_SOURCE_COUNT) || !m_initialized)
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    time_update();
+    if (m_sources[source].on_count == 0)
+    {
+        m_sources[source].period_ticks = 0;
+    }
+    m_sources[source].on_count++;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void app_energy_source_off(uint32_t source)
+{
+    if ((source >= APP_ENERGY_SOURCE_COUNT) || !m_initialized)
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (m_sources[source].on_count > 0)
+    {
+        time_update();
+        m_sources[source].on_count--;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+void app_energy_on_radio_evt(bool radio_active)
+{
+    if (radio_active)
+    {
+        app_energy_source_on(APP_ENERGY_SOURCE_RADIO);
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    energy_source_t * const p_radio = &m_sources[APP_ENERGY_SOURCE_RADIO];
+
+    if (p_radio->on_count > 0)
+    {
+        // The Active signal comes radio_distance_us before the radio is turned on.
+        time_update();
+        p_radio->on_ticks -= MIN(m_radio_distance_ticks, p_radio->period_ticks);
+        p_radio->on_count--;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+void app_energy_window_end(app_energy_report_t * p_report)
+{
+    uint32_t window_ticks;
+    uint32_t on_ticks[APP_ENERGY_SOURCE_COUNT];
+    uint32_t current_ua[APP_ENERGY_SOURCE_COUNT];
+
+    CRITICAL_REGION_ENTER();
+    time_update();
+
+    window_ticks   = m_window_ticks;
+    m_window_ticks = 0;
+
+    for (uint32_t i = 0; i < APP_ENERGY_SOURCE_COUNT; i++)
+    {
+        on_ticks[i]            = m_sources[i].on_ticks;
+        current_ua[i]          = m_sources[i].current_ua;
+        m_sources[i].on_ticks  = 0;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (p_report == NULL)
+    {
+        return;
+    }
+
+    memset(p_report, 0, sizeof(app_energy_report_t));
+    p_report->window_ms = ticks_to_ms(window_ticks);
+
+    for (uint32_t i = 0; i < APP_ENERGY_SOURCE_COUNT; i++)
+    {
+        app_energy_source_report_t * const p_source = &p_report->source[i];
+        uint64_t                     const tick_ua  = (uint64_t)on_ticks[i] * current_ua[i];
+
+        p_source->p_name    = m_sources[i].p_name;
+        p_source->on_ms     = ticks_to_ms(on_ticks[i]);
+        p_source->charge_uc = (uint32_t)((tick_ua * m_tick_div) / RTC_FREQUENCY);
+        p_source->avg_na    = (window_ticks > 0) ? (uint32_t)((tick_ua * 1000) / window_ticks) : 0;
+
+        p_report->charge_uc += p_source->charge_uc;
+        p_report->avg_na    += p_source->avg_na;
+    }
+}
+
+
+void app_energy_report_dump(app_energy_report_t const * p_report)
+{
+    (void)SEGGER_RTT_printf(APP_ENERGY_RTT_BUFFER, "ENERGY window_ms=%u charge_uc=%u avg_na=%u\r\n",
+                            p_report->window_ms, p_report->charge_uc, p_report->avg_na);
+
+    for (uint32_t i = 0; i < APP_ENERGY_SOURCE_COUNT; i++)
+    {
+        app_energy_source_report_t const * const p_source = &p_report->source[i];
+
+        if (p_source->p_name == NULL)
+        {
+            continue;
+        }
+
+        uint32_t const share_pm = (p_report->avg_na > 0)
+                                ? (uint32_t)(((uint64_t)p_source->avg_na * 1000) / p_report->avg_na)
+                                : 0;
+
+        (void)SEGGER_RTT_printf(APP_ENERGY_RTT_BUFFER,
+                                "ENERGY %s on_ms=%u charge_uc=%u avg_na=%u share_pm=%u\r\n",
+                                p_source->p_name, p_source->on_ms, p_source->charge_uc,
+                                p_source->avg_na, share_pm);
+    }
+}
+
+#endif // APP_ENERGY_ENABLED == 1
@@ -0,0 +1,200 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_ENERGY_H__
+#define APP_ENERGY_H__
+
+/**
+ * @defgroup app_energy Energy accounting
+ * @ingroup app_common
+ * @{
+ *
+ * @brief Module for estimating the charge drawn by each activity of the device.
+ *
+ * @details The module measures how long each current source is on, and multiplies this time
+ *          by a calibration current to estimate the charge it draws. The sources are:
+ *          - The base current, always on: System ON sleep current with the RTC running.
+ *          - The CPU, on except between @ref APP_ENERGY_IDLE_BEGIN and @ref APP_ENERGY_IDLE_END.
+ *          - The radio, on between the Active and nActive radio notification signals, forwarded
+ *            with @ref app_energy_on_radio_evt. The calibration current includes the HFXO,
+ *            which the SoftDevice runs during radio events.
+ *          - The HFXO, while requested by the application through the clock driver.
+ *          - Application peripherals, see @ref app_energy_source_register.
+ *
+ *          Times are counted in RTC1 ticks with @ref app_timer_cnt_get, so no other clock is
+ *          kept running by the measurement. The app_timer module must be initialized first. A
+ *          window must be ended at least once per RTC1 counter period, 512 seconds with
+ *          prescaler 0. Interrupts executed while the CPU sleeps in sd_app_evt_wait() are
+ *          counted as idle time, CPU on times shorter than one tick are counted statistically.
+ *
+ *          The default calibration currents are typical values from the product specification,
+ *          at 3 V with the DC/DC converter enabled on nRF52 devices. For accurate results, they
+ *          should be measured on the product with each source on, and set with
+ *          @ref app_energy_source_current_set.
+ *
+ *          When APP_ENERGY_ENABLED is 0, the macros compile to nothing and app_energy.c is not
+ *          needed.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+
+#ifndef APP_ENERGY_ENABLED
+#define APP_ENERGY_ENABLED          0                   /**< Enable energy accounting. */
+#endif
+
+#ifndef APP_ENERGY_USER_SOURCES
+#define APP_ENERGY_USER_SOURCES     4                   /**< Number of sources available to the application, from @ref APP_ENERGY_SOURCE_USER. */
+#endif
+
+#ifndef APP_ENERGY_RTT_BUFFER
+#define APP_ENERGY_RTT_BUFFER       0                   /**< RTT up buffer used by @ref app_energy_report_dump. */
+#endif
+
+#ifdef NRF52
+#ifndef APP_ENERGY_BASE_UA
+#define APP_ENERGY_BASE_UA          2                   /**< System ON sleep current with the RTC running, in uA. */
+#endif
+#ifndef APP_ENERGY_CPU_UA
+#define APP_ENERGY_CPU_UA           3700                /**< CPU running from flash, in uA. */
+#endif
+#ifndef APP_ENERGY_RADIO_UA
+#define APP_ENERGY_RADIO_UA         6800                /**< Radio active, average of TX at 0 dBm and RX, in uA. */
+#endif
+#ifndef APP_ENERGY_HFXO_UA
+#define APP_ENERGY_HFXO_UA          250                 /**< HFXO running, in uA. */
+#endif
+#else
+#ifndef APP_ENERGY_BASE_UA
+#define APP_ENERGY_BASE_UA          3                   /**< System ON sleep current with the RTC running, in uA. */
+#endif
+#ifndef APP_ENERGY_CPU_UA
+#define APP_ENERGY_CPU_UA           4400                /**< CPU running from flash, in uA. */
+#endif
+#ifndef APP_ENERGY_RADIO_UA
+#define APP_ENERGY_RADIO_UA         11800               /**< Radio active, average of TX at 0 dBm and RX, in uA. */
+#endif
+#ifndef APP_ENERGY_HFXO_UA
+#define APP_ENERGY_HFXO_UA          470                 /**< HFXO running, in uA. */
+#endif
+#endif
+
+/**@brief Current sources. */
+enum
+{
+    APP_ENERGY_SOURCE_BASE,             /**< Base current, always on. */
+    APP_ENERGY_SOURCE_CPU,              /**< CPU. */
+    APP_ENERGY_SOURCE_RADIO,            /**< Radio. */
+    APP_ENERGY_SOURCE_HFXO,             /**< HFXO requested by the application. */
+    APP_ENERGY_SOURCE_USER,             /**< First source available to the application. */
+    APP_ENERGY_SOURCE_COUNT = APP_ENERGY_SOURCE_USER + APP_ENERGY_USER_SOURCES
+};
+
+/**@brief Charge drawn by a source over a window. */
+typedef struct
+{
+    char const * p_name;        /**< Name of the source, or NULL if it is not registered. */
+    uint32_t     on_ms;         /**< Time the source was on. */
+    uint32_t     charge_uc;     /**< Estimated charge, in uC. */
+    uint32_t     avg_na;        /**< Contribution of the source to the average current, in nA. */
+} app_energy_source_report_t;
+
+/**@brief Charge drawn over a window. */
+typedef struct
+{
+    uint32_t                   window_ms;                       /**< Length of the window. */
+    uint32_t                   charge_uc;                       /**< Estimated charge of all sources, in uC. */
+    uint32_t                   avg_na;                          /**< Estimated average current, in nA. */
+    app_energy_source_report_t source[APP_ENERGY_SOURCE_COUNT]; /**< Charge per source. */
+} app_energy_report_t;
+
+
+#if (APP_ENERGY_ENABLED == 1)
+
+/**@brief Function for starting energy accounting, and its first window.
+ *
+ * @param[in] rtc_prescaler        Prescaler the app_timer module was initialized with.
+ * @param[in] radio_distance_us    Distance passed to ble_radio_notification_init, in us. It is
+ *                                 subtracted from each radio active period.
+ */
+void app_energy_init(uint32_t rtc_prescaler, uint32_t radio_distance_us);
+
+/**@brief Function for registering an application source.
+ *
+ * @param[in] source      Source, from @ref APP_ENERGY_SOURCE_USER.
+ * @param[in] p_name      Name of the source. Must stay valid.
+ * @param[in] current_ua  Current drawn while the source is on, in uA.
+ *
+ * @retval NRF_SUCCESS              If the source was registered.
+ * @retval NRF_ERROR_NULL           If @p p_name is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  If @p source is not an application source.
+ */
+ret_code_t app_energy_source_register(uint32_t source, char const * p_name, uint32_t current_ua);
+
+/**@brief Function for setting the calibration current of a source.
+ *
+ * @retval NRF_SUCCESS              If the current was set.
+ * @retval NRF_ERROR_INVALID_PARAM  If @p source is not valid.
+ */
+ret_code_t app_energy_source_current_set(uint32_t source, uint32_t current_ua);
+
+/**@brief Function for marking a source as on. Calls can be nested, and can be made from any
+ *        interrupt priority.
+ */
+void app_energy_source_on(uint32_t source);
+
+/**@brief Function for marking a source as off, once for each call to @ref app_energy_source_on. */
+void app_energy_source_off(uint32_t source);
+
+/**@brief Radio Notification handler. Register it with ble_radio_notification_init, or call it
+ *        from the application handler.
+ */
+void app_energy_on_radio_evt(bool radio_active);
+
+/**@brief Function for closing the current window and starting the next one.
+ *
+ * @param[out] p_report  Charge drawn over the closed window. Can be NULL.
+ */
+void app_energy_window_end(app_energy_report_t * p_report);
+
+/**@brief Function for writing a report to the RTT up buffer @ref APP_ENERGY_RTT_BUFFER.
+ *
+ * @details One line is written for the window, and one per registered source, with the share
+ *          of the charge in per mille.
+ */
+void app_energy_report_dump(app_energy_report_t const * p_report);
+
+/**@brief Macro for turning a source on. */
+#define APP_ENERGY_SOURCE_ON(source)    app_energy_source_on(source)
+
+/**@brief Macro for turning a source off. */
+#define APP_ENERGY_SOURCE_OFF(source)   app_energy_source_off(source)
+
+/**@brief Macro to be placed before the call to sd_app_evt_wait() in the main loop. */
+#define APP_ENERGY_IDLE_BEGIN()         app_energy_source_off(APP_ENERGY_SOURCE_CPU)
+
+/**@brief Macro to be placed after the call to sd_app_evt_wait() in the main loop. */
+#define APP_ENERGY_IDLE_END()           app_energy_source_on(APP_ENERGY_SOURCE_CPU)
+
+#else
+
+#define APP_ENERGY_SOURCE_ON(source)
+#define APP_ENERGY_SOURCE_OFF(source)
+#define APP_ENERGY_IDLE_BEGIN()
+#define APP_ENERGY_IDLE_END()
+
+#endif // APP_ENERGY_ENABLED == 1
+
+/** @} */
+
+#endif // APP_ENERGY_H__
@@ -0,0 +1,305 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_evt_trace.h"
+
+#if (APP_EVT_TRACE_ENABLED == 1)
+
+#include <stdbool.h>
+#include <string.h>
+#include "nrf.h"
+#include "nrf_error.h"
+#include "nordic_common.h"
+#include "app_timer.h"
+#include "app_profiler.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+#if ((APP_EVT_TRACE_BUFFER_SIZE % 4) != 0)
+#error "APP_EVT_TRACE_BUFFER_SIZE must be a multiple of 4."
+#endif
+
+#define RTC_FREQUENCY       32768           /**< RTC1 input frequency, in Hz. */
+#define RECORD_NONE         0xFFFFFFFF      /**< No record to be ended. */
+
+#if (__CORTEX_M >= 0x03)
+#define TRACE_COUNTER_MASK  0xFFFFFFFF      /**< DWT cycle counter width. */
+#elif (APP_PROFILER_ENABLED == 1)
+#define TRACE_COUNTER_MASK  0xFFFF          /**< Profiler TIMER width. */
+#define TRACE_COUNTER_HZ    16000000        /**< Profiler TIMER frequency. */
+#else
+#define TRACE_COUNTER_MASK  0
+#define TRACE_COUNTER_HZ    0
+#endif
+
+static uint32_t m_ring[APP_EVT_TRACE_BUFFER_SIZE / sizeof(uint32_t)];
+
+// The records are in [m_tail, m_head), or in [m_tail, m_wrap) then [0, m_head) when wrapped.
+static uint32_t m_head;
+static uint32_t m_tail;
+static uint32_t m_wrap;
+static bool     m_wrapped;
+static uint32_t m_last    = RECORD_NONE;    // Offset of the record to be ended.
+static uint32_t m_dropped;                  // Records dropped since the last reset.
+static bool     m_paused;                   // Set while the ring is dumped.
+static uint32_t m_timestamp_hz = RTC_FREQUENCY;
+
+
+static __INLINE uint32_t trace_counter_get(void)
+{
+#if (__CORTEX_M >= 0x03)
+    return DWT->CYCCNT;
+#elif (APP_PROFILER_ENABLED == 1)
+    return app_profiler_counter_get();
+#else
+    return 0;
+#endif
+}
+
+
+static __INLINE app_evt_trace_record_t * record_get(uint32_t offset)
+{
+    return (app_evt_trace_record_t *)((uint8_t *)m_ring + offset);
+}
+
+
+/**@brief Function for reserving room for a record, dropping the oldest records if needed.
+ *
+ * @details Must be called in a critical region.
+ *
+ * @return Offset of the record, or RECORD_NONE if it can never fit in the ring.
+ */
+static uint32_t record_reserve(uint32_t size)
+{
+    uint32_t offset;
+
+    if (size > sizeof(m_ring))
+    {
+        return RECORD_NONE;
+    }
+
+    for (;;)
+    {
+        if (!m_wrapped)
+        {
+            if (m_head + size <= sizeof(m_ring))
+            {
+                break;
+            }
+            if (m_head == m_tail)
+            {
+                // Empty.
+                m_head = 0;
+                m_tail = 0;
+                continue;
+            }
+            m_wrap    = m_head;
+            m_head    = 0;
+            m_wrapped = true;
+        }
+        else
+        {
+            if (m_head + size <= m_tail)
+            {
+                break;
+            }
+            m_tail += APP_EVT_TRACE_RECORD_SIZE(record_get(m_tail)->length);
+            m_dropped++;
+            if (m_tail >= m_wrap)
+            {
+                m_tail    = 0;
+                m_wrapped = false;
+            }
+        }
+    }
+
+    offset  = m_head;
+    m_head += size;
+
+    return offset;
+}
+
+
+/**@brief Function for adding a record to the ring.
+ *
+ * @return Counter value at the end of the copy.
+ */
+static uint32_t record_add(uint8_t type, void const * p_data, uint16_t length)
+{
+    uint32_t timestamp = 0;
+
+    (void)app_timer_cnt_get(&timestamp);
+
+    CRITICAL_REGION_ENTER();
+    uint32_t const offset = m_paused ? RECORD_NONE
+                                     : record_reserve(APP_EVT_TRACE_RECORD_SIZE(length));
+    if (offset == RECORD_NONE)
+    {
+        m_dropped++;
+    }
+    else
+    {
+        app_evt_trace_record_t * const p_record = record_get(offset);
+
+        p_record->timestamp = timestamp;
+        p_record->duration  = 0;
+        p_record->length    = length;
+        p_record->type      = type;
+        p_record->reserved  = 0;
+        memcpy(p_record + 1, p_data, length);
+    }
+    m_last = offset;
+    CRITICAL_REGION_EXIT();
+
+    return trace_counter_get();
+}
+
+
+uint32_t app_evt_trace_ble_record(void const * p_evt, uint16_t length)
+{
+    return record_add(APP_EVT_TRACE_TYPE_BLE, p_evt, length);
+}
+
+
+uint32_t app_evt_trace_soc_record(uint32_t evt_id)
+{
+    return record_add(APP_EVT_TRACE_TYPE_SOC, &evt_id, sizeof(evt_id));
+}
+
+
+void app_evt_trace_end(uint32_t start)
+{
+    uint32_t const duration = (trace_counter_get() - start) & TRACE_COUNTER_MASK;
+
+    CRITICAL_REGION_ENTER();
+    if (m_last != RECORD_NONE)
+    {
+        record_get(m_last)->duration = duration;
+        m_last = RECORD_NONE;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+ret_code_t app_evt_trace_init(uint32_t rtc_prescaler)
+{
+#if (__CORTEX_M >= 0x03)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    m_timestamp_hz = RTC_FREQUENCY / (rtc_prescaler + 1);
+    app_evt_trace_reset();
+
+    return NRF_SUCCESS;
+}
+
+
+void app_evt_trace_reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    m_head    = 0;
+    m_tail    = 0;
+    m_wrap    = 0;
+    m_wrapped = false;
+    m_last    = RECORD_NONE;
+    m_dropped = 0;
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**@brief Function for writing to the RTT up buffer, waiting for room if needed. */
+static void rtt_write(void const * p_data, uint32_t length)
+{
+    uint8_t const * p_byte = p_data;
+
+    while (length > 0)
+    {
+        uint32_t const written = SEGGER_RTT_Write(APP_EVT_TRACE_RTT_BUFFER, p_byte, length);
+
+        p_byte += written;
+        length -= written;
+    }
+}
+
+
+/**@brief Function for dumping the records in [start, end), one write per record. */
+static void records_dump(uint32_t start, uint32_t end)
+{
+    while (start < end)
+    {
+        uint32_t const size = APP_EVT_TRACE_RECORD_SIZE(record_get(start)->length);
+
+        // A record fits in the RTT buffer even if it is in no-block-skip mode.
+        rtt_write(record_get(start), size);
+        start += size;
+    }
+}
+
+
+void app_evt_trace_dump(void)
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t wrap;
+    bool     wrapped;
+
+    CRITICAL_REGION_ENTER();
+    m_paused = true;
+    m_last   = RECORD_NONE;
+    head     = m_head;
+    tail     = m_tail;
+    wrap     = m_wrap;
+    wrapped  = m_wrapped;
+    CRITICAL_REGION_EXIT();
+
+    app_evt_trace_header_t const header =
+    {
+        .magic        = APP_EVT_TRACE_MAGIC,
+        .version      = APP_EVT_TRACE_VERSION,
+        .header_size  = sizeof(app_evt_trace_header_t),
+#if (__CORTEX_M >= 0x03)
+        .cycles_hz    = SystemCoreClock,
+#else
+        .cycles_hz    = TRACE_COUNTER_HZ,
+#endif
+        .timestamp_hz = m_timestamp_hz,
+    };
+    rtt_write(&header, sizeof(header));
+
+    if (wrapped)
+    {
+        records_dump(tail, wrap);
+        tail = 0;
+    }
+    records_dump(tail, head);
+
+    struct
+    {
+        app_evt_trace_record_t record;
+        uint32_t               dropped;
+    } end;
+
+    memset(&end, 0, sizeof(end));
+    (void)app_timer_cnt_get(&end.record.timestamp);
+    end.record.length = sizeof(end.dropped);
+    end.record.type   = APP_EVT_TRACE_TYPE_END;
+
+    CRITICAL_REGION_ENTER();
+    end.dropped = m_dropped;
+    m_paused    = false;
+    CRITICAL_REGION_EXIT();
+
+    rtt_write(&end, sizeof(end));
+}
+
+#endif // APP_EVT_TRACE_ENABLED == 1
@@ -0,0 +1,216 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_EVT_TRACE_H__
+#define APP_EVT_TRACE_H__
+
+/**
+ * @defgroup app_evt_trace SoftDevice event trace
+ * @ingroup app_common
+ * @{
+ *
+ * @brief Module for recording the SoftDevice events dispatched by the SoftDevice handler, and
+ *        for replaying them on a host.
+ *
+ * @details Each BLE and SoC event pulled by the SoftDevice handler is copied to a RAM ring,
+ *          with the RTC1 counter at its arrival and the time spent in its handlers, in CPU
+ *          cycles. When the ring is full, the oldest records are dropped. The ring is written
+ *          in binary over SEGGER RTT by @ref app_evt_trace_dump, and decoded on the host with
+ *          app_evt_trace_decode.py, which can also extract the trace to a file.
+ *
+ *          The trace can be replayed with @ref app_evt_trace_replay, into the same handlers as
+ *          on the target, in a host build of the application modules. SVCALL_AS_NORMAL_FUNCTION
+ *          must then be defined, so that the SoftDevice calls made by the handlers are plain
+ *          functions, to be provided by the host build. The time spent in the handlers for each
+ *          event is measured with a clock of the host build, and reported with the time measured
+ *          on the target.
+ *
+ *          On Cortex-M0 devices, the handlers are timed with the TIMER of @ref app_profiler if
+ *          the profiler is enabled, and not timed otherwise. ANT events are not recorded.
+ *
+ *          When APP_EVT_TRACE_ENABLED is 0, the macros compile to nothing and app_evt_trace.c is
+ *          not needed. app_evt_trace_replay.c does not depend on APP_EVT_TRACE_ENABLED.
+ */
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifndef APP_EVT_TRACE_ENABLED
+#define APP_EVT_TRACE_ENABLED       0                   /**< Enable the event trace recorder. */
+#endif
+
+#ifndef APP_EVT_TRACE_BUFFER_SIZE
+#define APP_EVT_TRACE_BUFFER_SIZE   2048                /**< Size of the RAM ring, in bytes. Must be a multiple of 4, and hold at least the largest BLE event with its record header. */
+#endif
+
+#ifndef APP_EVT_TRACE_RTT_BUFFER
+#define APP_EVT_TRACE_RTT_BUFFER    0                   /**< RTT up buffer used by @ref app_evt_trace_dump. */
+#endif
+
+#define APP_EVT_TRACE_MAGIC         0x52545645          /**< "EVTR", first word of a trace. */
+#define APP_EVT_TRACE_VERSION       1                   /**< Version of the trace format. */
+
+/**@brief Record types. */
+enum
+{
+    APP_EVT_TRACE_TYPE_BLE = 1,     /**< BLE event. The data is the ble_evt_t, of the given length. */
+    APP_EVT_TRACE_TYPE_SOC = 2,     /**< SoC event. The data is the 32-bit event identifier. */
+    APP_EVT_TRACE_TYPE_END = 0xFF,  /**< Last record of a trace. The data is the 32-bit number of dropped records. */
+};
+
+/**@brief Header of a trace, followed by the records from the oldest. */
+typedef struct
+{
+    uint32_t magic;         /**< @ref APP_EVT_TRACE_MAGIC. */
+    uint16_t version;       /**< @ref APP_EVT_TRACE_VERSION. */
+    uint16_t header_size;   /**< Size of this header, in bytes. */
+    uint32_t cycles_hz;     /**< Frequency of the durations, or 0 if the handlers were not timed. */
+    uint32_t timestamp_hz;  /**< Frequency of the timestamps. */
+} app_evt_trace_header_t;
+
+/**@brief Header of a record, followed by its data, padded to a multiple of 4 bytes. */
+typedef struct
+{
+    uint32_t timestamp;     /**< RTC1 counter when the event was pulled from the SoftDevice. */
+    uint32_t duration;      /**< Time spent in the handlers of the event, in CPU cycles. */
+    uint16_t length;        /**< Length of the data, in bytes. */
+    uint8_t  type;          /**< Record type. */
+    uint8_t  reserved;
+} app_evt_trace_record_t;
+
+/**@brief Size of a record with the given data length, in bytes. */
+#define APP_EVT_TRACE_RECORD_SIZE(length) \
+    (sizeof(app_evt_trace_record_t) + ((((uint32_t)(length)) + 3) & ~3UL))
+
+
+#if (APP_EVT_TRACE_ENABLED == 1)
+
+/**@brief Function for recording a BLE event.
+ *
+ * @details Called by @ref APP_EVT_TRACE_BLE.
+ *
+ * @param[in] p_evt   The event.
+ * @param[in] length  Length of the event, in bytes.
+ *
+ * @return Counter value to be passed to @ref app_evt_trace_end.
+ */
+uint32_t app_evt_trace_ble_record(void const * p_evt, uint16_t length);
+
+/**@brief Function for recording a SoC event.
+ *
+ * @details Called by @ref APP_EVT_TRACE_SOC.
+ *
+ * @param[in] evt_id  Event identifier.
+ *
+ * @return Counter value to be passed to @ref app_evt_trace_end.
+ */
+uint32_t app_evt_trace_soc_record(uint32_t evt_id);
+
+/**@brief Function for setting the duration of the last record.
+ *
+ * @param[in] start  Counter value returned when the event was recorded.
+ */
+void app_evt_trace_end(uint32_t start);
+
+/**@brief Macro for recording a BLE event, before it is passed to its handlers.
+ *
+ * @details Declares a local variable holding the start time, for @ref APP_EVT_TRACE_END in the
+ *          same scope. Must only be used in the context dispatching the SoftDevice events.
+ */
+#define APP_EVT_TRACE_BLE(p_evt, length) \
+    uint32_t const evt_trace_start = app_evt_trace_ble_record((p_evt), (length))
+
+/**@brief Macro for recording a SoC event, before it is passed to its handlers. */
+#define APP_EVT_TRACE_SOC(evt_id) \
+    uint32_t const evt_trace_start = app_evt_trace_soc_record(evt_id)
+
+/**@brief Macro for ending the record started in the same scope, after the event handlers. */
+#define APP_EVT_TRACE_END()     app_evt_trace_end(evt_trace_start)
+
+/**@brief Function for initializing the recorder and starting its cycle counter.
+ *
+ * @param[in] rtc_prescaler  Prescaler of the application timer, for the timestamp frequency.
+ *
+ * @retval NRF_SUCCESS  The recorder was initialized.
+ */
+ret_code_t app_evt_trace_init(uint32_t rtc_prescaler);
+
+/**@brief Function for dropping all the records. */
+void app_evt_trace_reset(void);
+
+/**@brief Function for writing the trace to the RTT up buffer @ref APP_EVT_TRACE_RTT_BUFFER.
+ *
+ * @details The trace header, the records from the oldest and an end record are written in
+ *          binary. Recording is paused meanwhile, and the events dispatched are counted as
+ *          dropped. The function does not return until the whole trace is written, so it should
+ *          be called from the main loop, with the RTT host connected. The records are kept.
+ */
+void app_evt_trace_dump(void);
+
+#else
+
+#define APP_EVT_TRACE_BLE(p_evt, length)
+#define APP_EVT_TRACE_SOC(evt_id)
+#define APP_EVT_TRACE_END()
+
+#endif // APP_EVT_TRACE_ENABLED == 1
+
+
+/**@brief Handler of the BLE events of a replayed trace. */
+typedef void (*app_evt_trace_ble_handler_t)(void * p_evt);
+
+/**@brief Handler of the SoC events of a replayed trace. */
+typedef void (*app_evt_trace_soc_handler_t)(uint32_t evt_id);
+
+/**@brief Clock of the host build, used to time the handlers of the replayed events. */
+typedef uint32_t (*app_evt_trace_clock_t)(void);
+
+/**@brief Handler called after the handlers of each replayed event.
+ *
+ * @param[in] p_record  Record of the event, with the duration measured on the target.
+ * @param[in] duration  Duration measured with the clock of the host build.
+ */
+typedef void (*app_evt_trace_result_handler_t)(app_evt_trace_record_t const * p_record,
+                                               uint32_t                       duration);
+
+/**@brief Replay configuration. */
+typedef struct
+{
+    app_evt_trace_ble_handler_t    ble_handler;     /**< Handler of the BLE events, typically the one given to softdevice_ble_evt_handler_set. Can be NULL. */
+    app_evt_trace_soc_handler_t    soc_handler;     /**< Handler of the SoC events. Can be NULL. */
+    app_evt_trace_clock_t          clock;           /**< Clock of the host build. Can be NULL. */
+    app_evt_trace_result_handler_t result_handler;  /**< Handler of the results. Can be NULL. */
+} app_evt_trace_replay_t;
+
+/**@brief Function for replaying a trace written by @ref app_evt_trace_dump.
+ *
+ * @details The events are passed to their handlers in order. Each BLE event is first copied to
+ *          a buffer aligned for ble_evt_t.
+ *
+ * @param[in] p_replay  Replay configuration.
+ * @param[in] p_trace   Trace, from its header.
+ * @param[in] length    Length of the trace, in bytes.
+ *
+ * @retval NRF_SUCCESS              The whole trace was replayed.
+ * @retval NRF_ERROR_NULL           p_replay or p_trace is NULL.
+ * @retval NRF_ERROR_INVALID_DATA   The trace header is not valid, or a record is truncated. The
+ *                                  events before were replayed.
+ * @retval NRF_ERROR_DATA_SIZE      A BLE event does not fit in the replay buffer. The events
+ *                                  before were replayed.
+ */
+ret_code_t app_evt_trace_replay(app_evt_trace_replay_t const * p_replay,
+                                void const *                   p_trace,
+                                uint32_t                       length);
+
+/** @} */
+
+#endif // APP_EVT_TRACE_H__
@@ -0,0 +1,187 @@
+#!/usr/bin/env python
+# Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+#
+# The information contained herein is property of Nordic Semiconductor ASA.
+# Terms and conditions of usage are described in detail in NORDIC
+# SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+#
+# Licensees are granted free, non-transferable use of the information. NO
+# WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+# the file.
+
+"""Decoder for the SoftDevice event traces of app_evt_trace.
+
+The trace written by app_evt_trace_dump() is searched for in the capture of
+the RTT channel, so the capture may hold other output before it. One line is
+printed per event, with its time, name, connection handle and handler
+duration, followed by a summary per event: count, total and longest duration.
+
+Usage:
+    app_evt_trace_decode.py [-o <trace.bin>] [-q] [<capture file>]
+
+The capture is read from the standard input if no file is given. With -o, the
+trace is also written to <trace.bin>, from its header to its end record, as
+expected by app_evt_trace_replay(). With -q, only the summary is printed.
+"""
+
+import getopt
+import struct
+import sys
+
+TRACE_MAGIC = b'EVTR'
+TRACE_VERSION = 1
+TRACE_HEADER = '<IHHII'
+RECORD_HEADER = '<IIHBB'
+
+TYPE_BLE = 1
+TYPE_SOC = 2
+TYPE_END = 0xFF
+
+BLE_EVT_NAMES = {
+    0x01: 'TX_COMPLETE', 0x02: 'USER_MEM_REQUEST', 0x03: 'USER_MEM_RELEASE',
+    0x10: 'GAP_CONNECTED', 0x11: 'GAP_DISCONNECTED', 0x12: 'GAP_CONN_PARAM_UPDATE',
+    0x13: 'GAP_SEC_PARAMS_REQUEST', 0x14: 'GAP_SEC_INFO_REQUEST',
+    0x15: 'GAP_PASSKEY_DISPLAY', 0x16: 'GAP_KEY_PRESSED', 0x17: 'GAP_AUTH_KEY_REQUEST',
+    0x18: 'GAP_LESC_DHKEY_REQUEST', 0x19: 'GAP_AUTH_STATUS', 0x1A: 'GAP_CONN_SEC_UPDATE',
+    0x1B: 'GAP_TIMEOUT', 0x1C: 'GAP_RSSI_CHANGED', 0x1D: 'GAP_ADV_REPORT',
+    0x1E: 'GAP_SEC_REQUEST', 0x1F: 'GAP_CONN_PARAM_UPDATE_REQUEST',
+    0x20: 'GAP_SCAN_REQ_REPORT',
+    0x30: 'GATTC_PRIM_SRVC_DISC_RSP', 0x31: 'GATTC_REL_DISC_RSP',
+    0x32: 'GATTC_CHAR_DISC_RSP', 0x33: 'GATTC_DESC_DISC_RSP',
+    0x34: 'GATTC_ATTR_INFO_DISC_RSP', 0x35: 'GATTC_CHAR_VAL_BY_UUID_READ_RSP',
+    0x36: 'GATTC_READ_RSP', 0x37: 'GATTC_CHAR_VALS_READ_RSP', 0x38: 'GATTC_WRITE_RSP',
+    0x39: 'GATTC_HVX', 0x3A: 'GATTC_TIMEOUT',
+    0x50: 'GATTS_WRITE', 0x51: 'GATTS_RW_AUTHORIZE_REQUEST',
+    0x52: 'GATTS_SYS_ATTR_MISSING', 0x53: 'GATTS_HVC', 0x54: 'GATTS_SC_CONFIRM',
+    0x55: 'GATTS_TIMEOUT',
+}
+
+SOC_EVT_NAMES = [
+    'HFCLKSTARTED', 'POWER_FAILURE_WARNING', 'FLASH_OPERATION_SUCCESS',
+    'FLASH_OPERATION_ERROR', 'RADIO_BLOCKED', 'RADIO_CANCELED',
+    'RADIO_SIGNAL_CALLBACK_INVALID_RETURN', 'RADIO_SESSION_IDLE', 'RADIO_SESSION_CLOSED',
+]
+
+
+class TraceError(Exception):
+    pass
+
+
+def find_trace(data):
+    """Returns the trace header fields and the offset of the first record."""
+    # The last trace of the capture is decoded. A candidate is checked against the header size,
+    # as the magic could also be found in the data of an event.
+    start = data.rfind(TRACE_MAGIC)
+    while start >= 0:
+        if len(data) - start >= struct.calcsize(TRACE_HEADER):
+            magic, version, header_size, cycles_hz, timestamp_hz = \
+                struct.unpack_from(TRACE_HEADER, data, start)
+            if header_size == struct.calcsize(TRACE_HEADER) and timestamp_hz != 0:
+                if version != TRACE_VERSION:
+                    raise TraceError('unsupported trace version %d' % version)
+                return start, start + header_size, cycles_hz, timestamp_hz
+        start = data.rfind(TRACE_MAGIC, 0, start)
+    raise TraceError('no trace found')
+
+
+def records(data, offset):
+    """Yields (offset, timestamp, duration, type, payload) up to the end record included."""
+    size = struct.calcsize(RECORD_HEADER)
+    while len(data) - offset >= size:
+        timestamp, duration, length, rec_type, _ = struct.unpack_from(RECORD_HEADER, data, offset)
+        end = offset + size + ((length + 3) & ~3)
+        if end > len(data):
+            break
+        yield end, timestamp, duration, rec_type, data[offset + size:offset + size + length]
+        if rec_type == TYPE_END:
+            return
+        offset = end
+    raise TraceError('trace truncated, end record missing')
+
+
+def event_name(rec_type, payload):
+    """Returns the name of the event and its connection handle, or None."""
+    if rec_type == TYPE_SOC:
+        (evt_id,) = struct.unpack_from('<I', payload)
+        if evt_id < len(SOC_EVT_NAMES):
+            return 'SOC_' + SOC_EVT_NAMES[evt_id], None
+        return 'SOC_0x%02X' % evt_id, None
+    evt_id, _ = struct.unpack_from('<HH', payload)
+    name = BLE_EVT_NAMES.get(evt_id, 'BLE_0x%02X' % evt_id)
+    conn_handle = None
+    # The events of all modules but the user memory ones start with the connection handle.
+    if len(payload) >= 6 and evt_id not in (0x02, 0x03):
+        (conn_handle,) = struct.unpack_from('<H', payload, 4)
+    return name, conn_handle
+
+
+def decode(data, out, quiet):
+    start, offset, cycles_hz, timestamp_hz = find_trace(data)
+    summary = {}
+    first = None
+    end = offset
+
+    def us(cycles):
+        return cycles * 1000000.0 / cycles_hz if cycles_hz else 0.0
+
+    for end, timestamp, duration, rec_type, payload in records(data, offset):
+        if rec_type == TYPE_END:
+            (dropped,) = struct.unpack_from('<I', payload)
+            break
+        if rec_type not in (TYPE_BLE, TYPE_SOC):
+            continue
+        name, conn_handle = event_name(rec_type, payload)
+        if first is None:
+            first = timestamp
+        if not quiet:
+            elapsed = ((timestamp - first) & 0xFFFFFF) * 1000.0 / timestamp_hz
+            conn = '' if conn_handle is None else ' conn=0x%04X' % conn_handle
+            print('%10.3f ms %-36s%s %8.1f us' % (elapsed, name, conn, us(duration)))
+        entry = summary.setdefault(name, [0, 0, 0])
+        entry[0] += 1
+        entry[1] += duration
+        entry[2] = max(entry[2], duration)
+
+    if out is not None:
+        with open(out, 'wb') as f:
+            f.write(data[start:end])
+
+    print('')
+    print('%-36s %8s %12s %10s %10s' % ('event', 'count', 'total_us', 'avg_us', 'max_us'))
+    for name in sorted(summary, key=lambda n: -summary[n][1]):
+        count, total, longest = summary[name]
+        print('%-36s %8d %12.1f %10.1f %10.1f' %
+              (name, count, us(total), us(total) / count, us(longest)))
+    print('dropped records: %d' % dropped)
+    if not cycles_hz:
+        print('handlers not timed on the target')
+
+
+def main(argv):
+    try:
+        opts, args = getopt.getopt(argv, 'o:q')
+    except getopt.GetoptError as e:
+        sys.stderr.write('%s\n%s' % (e, __doc__))
+        return 2
+    opts = dict(opts)
+    if len(args) > 1:
+        sys.stderr.write(__doc__)
+        return 2
+
+    if args:
+        with open(args[0], 'rb') as f:
+            data = f.read()
+    else:
+        stdin = getattr(sys.stdin, 'buffer', sys.stdin)
+        data = stdin.read()
+
+    try:
+        decode(data, opts.get('-o'), '-q' in opts)
+    except TraceError as e:
+        sys.stderr.write('error: %s\n' % e)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
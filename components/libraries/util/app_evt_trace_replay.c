@@ -0,0 +1,111 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_evt_trace.h"
+#include <stddef.h>
+#include <string.h>
+#include "nrf_error.h"
+
+// A recorded event fits in the ring, so it fits in a buffer of the same size.
+static uint32_t m_evt_buffer[APP_EVT_TRACE_BUFFER_SIZE / sizeof(uint32_t)];
+
+
+static uint32_t replay_clock_get(app_evt_trace_replay_t const * p_replay)
+{
+    return (p_replay->clock != NULL) ? p_replay->clock() : 0;
+}
+
+
+ret_code_t app_evt_trace_replay(app_evt_trace_replay_t const * p_replay,
+                                void const *                   p_trace,
+                                uint32_t                       length)
+{
+    app_evt_trace_header_t header;
+    uint8_t const *        p_byte = p_trace;
+    uint32_t               offset;
+
+    if ((p_replay == NULL) || (p_trace == NULL))
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (length < sizeof(header))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    // The trace may come from an unaligned file buffer: headers are copied before use.
+    memcpy(&header, p_byte, sizeof(header));
+    if ((header.magic != APP_EVT_TRACE_MAGIC)   ||
+        (header.version != APP_EVT_TRACE_VERSION) ||
+        (header.header_size < sizeof(header))   ||
+        (header.header_size > length))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    offset = header.header_size;
+    while (offset < length)
+    {
+        app_evt_trace_record_t record;
+        uint32_t               start;
+
+        if (length - offset < sizeof(record))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+        memcpy(&record, p_byte + offset, sizeof(record));
+        if (length - offset < APP_EVT_TRACE_RECORD_SIZE(record.length))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+        if (record.length > sizeof(m_evt_buffer))
+        {
+            return NRF_ERROR_DATA_SIZE;
+        }
+        memcpy(m_evt_buffer, p_byte + offset + sizeof(record), record.length);
+        offset += APP_EVT_TRACE_RECORD_SIZE(record.length);
+
+        if (record.type == APP_EVT_TRACE_TYPE_END)
+        {
+            break;
+        }
+
+        start = replay_clock_get(p_replay);
+        switch (record.type)
+        {
+            case APP_EVT_TRACE_TYPE_BLE:
+                if (p_replay->ble_handler != NULL)
+                {
+                    p_replay->ble_handler(m_evt_buffer);
+                }
+                break;
+
+            case APP_EVT_TRACE_TYPE_SOC:
+                if ((p_replay->soc_handler != NULL) && (record.length == sizeof(uint32_t)))
+                {
+                    p_replay->soc_handler(m_evt_buffer[0]);
+                }
+                break;
+
+            default:
+                // Unknown records are skipped.
+                break;
+        }
+
+        if (p_replay->result_handler != NULL)
+        {
+            p_replay->result_handler(&record, replay_clock_get(p_replay) - start);
+        }
+    }
+
+    return NRF_SUCCESS;
+}
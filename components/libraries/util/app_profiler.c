@@ -0,0 +1,150 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_profiler.h"
+
+#if (APP_PROFILER_ENABLED == 1)
+
+#include <string.h>
+#include "nrf_error.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+#if (__CORTEX_M >= 0x03)
+#define PROFILER_COUNTER_MASK   0xFFFFFFFF      /**< DWT cycle counter width. */
+#define PROFILER_COUNTER_UNIT   "cycles"
+#else
+#define PROFILER_COUNTER_MASK   0xFFFF          /**< TIMER width. */
+#define PROFILER_COUNTER_UNIT   "16 MHz ticks"
+#endif
+
+static app_profiler_entry_t m_entries[APP_PROFILER_ID_COUNT];   /**< Registry. */
+
+static const char * const m_sdk_id_names[APP_PROFILER_ID_APP_FIRST] =
+{
+    "sd_evt",
+    "sched_evt",
+    "timer_list",
+    "fds_queue",
+    "ser_cmd_write",
+};
+
+
+ret_code_t app_profiler_init(void)
+{
+    app_profiler_reset();
+
+#if (__CORTEX_M >= 0x03)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#else
+    APP_PROFILER_TIMER->TASKS_STOP  = 1;
+    APP_PROFILER_TIMER->MODE        = TIMER_MODE_MODE_Timer;
+    APP_PROFILER_TIMER->BITMODE     = TIMER_BITMODE_BITMODE_16Bit;
+    APP_PROFILER_TIMER->PRESCALER   = 0;
+    APP_PROFILER_TIMER->INTENCLR    = 0xFFFFFFFF;
+    APP_PROFILER_TIMER->SHORTS      = 0;
+    APP_PROFILER_TIMER->TASKS_CLEAR = 1;
+    APP_PROFILER_TIMER->TASKS_START = 1;
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+void app_profiler_reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(m_entries, 0, sizeof(m_entries));
+    CRITICAL_REGION_EXIT();
+}
+
+
+void app_profiler_record(uint32_t id, uint32_t start)
+{
+    uint32_t const time = (app_profiler_counter_get() - start) & PROFILER_COUNTER_MASK;
+
+    if (id >= APP_PROFILER_ID_COUNT)
+    {
+        return;
+    }
+
+    app_profiler_entry_t * const p_entry = &m_entries[id];
+
+    CRITICAL_REGION_ENTER();
+    if ((p_entry->count == 0) || (time < p_entry->min))
+    {
+        p_entry->min = time;
+    }
+    if (time > p_entry->max)
+    {
+        p_entry->max = time;
+    }
+    p_entry->count++;
+    p_entry->total += time;
+    CRITICAL_REGION_EXIT();
+}
+
+
+ret_code_t app_profiler_entry_get(uint32_t id, app_profiler_entry_t * p_entry)
+{
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (id >= APP_PROFILER_ID_COUNT)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    *p_entry = m_entries[id];
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+void app_profiler_dump(void)
+{
+    app_profiler_entry_t entry;
+
+    (void)SEGGER_RTT_printf(APP_PROFILER_RTT_BUFFER,
+                            "PROFILE id count min max avg total_k (" PROFILER_COUNTER_UNIT ")\r\n");
+
+    for (uint32_t id = 0; id < APP_PROFILER_ID_COUNT; id++)
+    {
+        (void)app_profiler_entry_get(id, &entry);
+        if (entry.count == 0)
+        {
+            continue;
+        }
+
+        uint32_t const avg     = (uint32_t)(entry.total / entry.count);
+        uint32_t const total_k = (uint32_t)(entry.total / 1000);
+
+        if (id < APP_PROFILER_ID_APP_FIRST)
+        {
+            (void)SEGGER_RTT_printf(APP_PROFILER_RTT_BUFFER, "PROFILE %s %u %u %u %u %u\r\n",
+                                    m_sdk_id_names[id],
+                                    entry.count, entry.min, entry.max, avg, total_k);
+        }
+        else
+        {
+            (void)SEGGER_RTT_printf(APP_PROFILER_RTT_BUFFER, "PROFILE app%u %u %u %u %u %u\r\n",
+                                    id - APP_PROFILER_ID_APP_FIRST,
+                                    entry.count, entry.min, entry.max, avg, total_k);
+        }
+    }
+}
+
+#endif // APP_PROFILER_ENABLED == 1
@@ -0,0 +1,159 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_PROFILER_H__
+#define APP_PROFILER_H__
+
+/**
+ * @defgroup app_profiler Hot path profiler
+ * @ingroup app_common
+ * @{
+ *
+ * @brief Module for measuring the execution time of code sections.
+ *
+ * @details A code section is measured by placing @ref PROFILE_BEGIN and @ref PROFILE_END, with
+ *          the same identifier, at its start and end, in the same scope. The execution time of
+ *          each pass is added to a registry holding the count, minimum, maximum and total time
+ *          per identifier, which can be read with @ref app_profiler_entry_get or dumped over
+ *          SEGGER RTT with @ref app_profiler_dump.
+ *
+ *          Times are counted in CPU cycles with the DWT cycle counter on Cortex-M4 devices. On
+ *          Cortex-M0 devices, they are counted with the 16-bit TIMER instance
+ *          @ref APP_PROFILER_TIMER at 16 MHz, which limits the measured sections to 4 ms.
+ *
+ *          The SDK hot points are instrumented with the SDK identifiers: SoftDevice event dispatch
+ *          in the SoftDevice handler, event handler execution in the scheduler, the timer list
+ *          handler of the application timer, the FDS operation queue processing and the command
+ *          round trips of the serialization transport.
+ *
+ *          When APP_PROFILER_ENABLED is 0, the macros compile to nothing and app_profiler.c is
+ *          not needed.
+ */
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifndef APP_PROFILER_ENABLED
+#define APP_PROFILER_ENABLED        0                   /**< Enable the profiler. */
+#endif
+
+#ifndef APP_PROFILER_APP_IDS
+#define APP_PROFILER_APP_IDS        8                   /**< Number of identifiers available to the application, from @ref APP_PROFILER_ID_APP_FIRST. */
+#endif
+
+#ifndef APP_PROFILER_TIMER
+#define APP_PROFILER_TIMER          NRF_TIMER2          /**< TIMER instance used on Cortex-M0 devices. Not used on Cortex-M4 devices. */
+#endif
+
+#ifndef APP_PROFILER_RTT_BUFFER
+#define APP_PROFILER_RTT_BUFFER     0                   /**< RTT up buffer used by @ref app_profiler_dump. */
+#endif
+
+
+/**@brief Profiler identifiers. */
+enum
+{
+    APP_PROFILER_ID_SD_EVT,             /**< Dispatch of one SoftDevice event by the SoftDevice handler. */
+    APP_PROFILER_ID_SCHED_EVT,          /**< Execution of one event handler by the scheduler. */
+    APP_PROFILER_ID_TIMER_LIST,         /**< Timer list handler of the application timer. */
+    APP_PROFILER_ID_FDS_QUEUE,          /**< Processing of the FDS operation queue. */
+    APP_PROFILER_ID_SER_CMD_WRITE,      /**< Serialized SoftDevice command, until its response is decoded. */
+    APP_PROFILER_ID_APP_FIRST,          /**< First identifier available to the application. */
+    APP_PROFILER_ID_COUNT = APP_PROFILER_ID_APP_FIRST + APP_PROFILER_APP_IDS
+};
+
+/**@brief Registry entry. */
+typedef struct
+{
+    uint32_t count;     /**< Number of measurements. */
+    uint32_t min;       /**< Shortest measurement. Not valid if count is 0. */
+    uint32_t max;       /**< Longest measurement. */
+    uint64_t total;     /**< Sum of the measurements. */
+} app_profiler_entry_t;
+
+
+#if (APP_PROFILER_ENABLED == 1)
+
+#include "nrf.h"
+
+/**@brief Function for reading the profiler counter. */
+static __INLINE uint32_t app_profiler_counter_get(void)
+{
+#if (__CORTEX_M >= 0x03)
+    return DWT->CYCCNT;
+#else
+    APP_PROFILER_TIMER->TASKS_CAPTURE[0] = 1;
+    return APP_PROFILER_TIMER->CC[0];
+#endif
+}
+
+/**@brief Function for adding a measurement to the registry.
+ *
+ * @details Called by @ref PROFILE_END. Can be called from any interrupt priority.
+ *
+ * @param[in] id     Profiler identifier. Ignored if not valid.
+ * @param[in] start  Counter value at the start of the measurement.
+ */
+void app_profiler_record(uint32_t id, uint32_t start);
+
+/**@brief Macro for starting a measurement.
+ *
+ * @details Declares a local variable holding the start time, so measurements of the same
+ *          identifier can be nested or made concurrently from several interrupt priorities.
+ *
+ * @param[in] id  Profiler identifier, which must be an identifier or a number.
+ */
+#define PROFILE_BEGIN(id)   uint32_t const profile_start_ ## id = app_profiler_counter_get()
+
+/**@brief Macro for ending a measurement started by @ref PROFILE_BEGIN in the same scope.
+ *
+ * @param[in] id  Profiler identifier.
+ */
+#define PROFILE_END(id)     app_profiler_record((id), profile_start_ ## id)
+
+/**@brief Function for initializing the profiler and starting its counter.
+ *
+ * @retval NRF_SUCCESS  The profiler was initialized.
+ */
+ret_code_t app_profiler_init(void);
+
+/**@brief Function for clearing the registry. */
+void app_profiler_reset(void);
+
+/**@brief Function for reading a registry entry.
+ *
+ * @param[in]  id       Profiler identifier.
+ * @param[out] p_entry  The entry.
+ *
+ * @retval NRF_SUCCESS              The entry was read.
+ * @retval NRF_ERROR_NULL           p_entry is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  id is not valid.
+ */
+ret_code_t app_profiler_entry_get(uint32_t id, app_profiler_entry_t * p_entry);
+
+/**@brief Function for writing the registry to the RTT up buffer @ref APP_PROFILER_RTT_BUFFER.
+ *
+ * @details One line is written per identifier with at least one measurement. Should be called
+ *          from the main loop: the RTT output takes much longer than the profiled sections.
+ */
+void app_profiler_dump(void);
+
+#else
+
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+
+#endif // APP_PROFILER_ENABLED == 1
+
+/** @} */
+
+#endif // APP_PROFILER_H__
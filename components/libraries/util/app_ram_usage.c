@@ -0,0 +1,223 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "app_ram_usage.h"
+#include <stddef.h>
+#include "nrf.h"
+#include "nrf_error.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "nrf_log.h"
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+#include "mem_manager.h"
+#endif
+
+#define RAM_START_ADDRESS       0x20000000
+#ifdef NRF52
+#define RAM_TOTAL_SIZE          ((NRF_FICR->INFO.RAM) * 1024)
+#else
+#define RAM_TOTAL_SIZE          ((NRF_FICR->SIZERAMBLOCKS) * (NRF_FICR->NUMRAMBLOCK))
+#endif
+
+#define STACK_FILL_MARGIN       64      /**< Bytes below the stack pointer left untouched by the fill in @ref app_ram_usage_init. */
+#define MEM_CATEGORY_COUNT      7       /**< Number of memory manager block categories. */
+
+#define ALERT_FLAG_STACK        (1UL << 0)
+#define ALERT_FLAG_HEAP         (1UL << 1)
+#define ALERT_FLAG_MEM(cat)     (1UL << (2 + (cat)))
+
+//lint -save -e27 -e10 -e19
+#if defined ( __CC_ARM )
+extern char Image$$RW_IRAM1$$Base;
+extern char Image$$RW_IRAM1$$RW$$Length;
+extern char Image$$RW_IRAM1$$ZI$$Length;
+extern char HEAP$$Length;
+#define APP_RAM_START   ((uint32_t)&Image$$RW_IRAM1$$Base)
+#define DATA_SIZE       ((uint32_t)&Image$$RW_IRAM1$$RW$$Length)
+// The ZI length of the region includes the stack and heap sections.
+#define BSS_SIZE        ((uint32_t)&Image$$RW_IRAM1$$ZI$$Length - HEAP_SIZE - STACK_SIZE)
+#define HEAP_SIZE       ((uint32_t)&HEAP$$Length)
+#define HEAP_USED_MAX   0
+#elif defined ( __ICCARM__ )
+#pragma section = ".data"
+#pragma section = ".bss"
+extern char __ICFEDIT_region_RAM_start__;
+extern char HEAP$$Length;
+#define APP_RAM_START   ((uint32_t)&__ICFEDIT_region_RAM_start__)
+#define DATA_SIZE       ((uint32_t)__section_size(".data"))
+#define BSS_SIZE        ((uint32_t)__section_size(".bss"))
+#define HEAP_SIZE       ((uint32_t)&HEAP$$Length)
+#define HEAP_USED_MAX   0
+#elif defined   ( __GNUC__ )
+extern uint32_t __data_start__;
+extern uint32_t __bss_start__;
+extern uint32_t __bss_end__;
+extern uint32_t __HeapBase;
+extern uint32_t __HeapLimit;
+extern void * _sbrk(int incr);
+#define APP_RAM_START   ((uint32_t)&__data_start__)
+#define DATA_SIZE       ((uint32_t)&__bss_start__ - (uint32_t)&__data_start__)
+#define BSS_SIZE        ((uint32_t)&__bss_end__ - (uint32_t)&__bss_start__)
+#define HEAP_SIZE       ((uint32_t)&__HeapLimit - (uint32_t)&__HeapBase)
+// newlib never returns memory to the system, so the program break is the heap high-water mark.
+#define HEAP_USED_MAX   ((uint32_t)_sbrk(0) - (uint32_t)&__HeapBase)
+#endif
+//lint -restore
+
+#define STACK_SIZE      ((uint32_t)STACK_TOP - (uint32_t)STACK_BASE)
+
+static app_ram_usage_alert_handler_t m_alert_handler;   /**< Alert handler. */
+static uint32_t const *              mp_stack_mark;     /**< Lowest stack word found modified. */
+static uint32_t                      m_alert_flags;     /**< Alerts already reported. */
+
+
+ret_code_t app_ram_usage_init(app_ram_usage_alert_handler_t alert_handler)
+{
+    uint32_t * p_word = (uint32_t *)STACK_BASE;
+
+    m_alert_handler = alert_handler;
+    m_alert_flags   = 0;
+    mp_stack_mark   = (uint32_t const *)STACK_TOP;
+
+    if (*p_word != APP_RAM_USAGE_STACK_FILL_PATTERN)
+    {
+        // The startup file did not fill the stack.
+        CRITICAL_REGION_ENTER();
+        uint32_t const * const p_end = (uint32_t const *)(__get_MSP() - STACK_FILL_MARGIN);
+
+        while (p_word < p_end)
+        {
+            *p_word++ = APP_RAM_USAGE_STACK_FILL_PATTERN;
+        }
+        CRITICAL_REGION_EXIT();
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_ram_usage_stack_used_max(void)
+{
+    uint32_t const * p_word = (uint32_t const *)STACK_BASE;
+
+    // The words from the stack limit up to the first modified word have never been used.
+    while ((p_word < mp_stack_mark) && (*p_word == APP_RAM_USAGE_STACK_FILL_PATTERN))
+    {
+        p_word++;
+    }
+    mp_stack_mark = p_word;
+
+    return (uint32_t)STACK_TOP - (uint32_t)p_word;
+}
+
+
+ret_code_t app_ram_usage_get(app_ram_usage_t * p_usage)
+{
+    if (p_usage == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    p_usage->ram_start      = APP_RAM_START;
+    p_usage->data_size      = DATA_SIZE;
+    p_usage->bss_size       = BSS_SIZE;
+    p_usage->heap_size      = HEAP_SIZE;
+    p_usage->heap_used_max  = HEAP_USED_MAX;
+    p_usage->stack_size     = STACK_SIZE;
+    p_usage->stack_used_max = app_ram_usage_stack_used_max();
+    p_usage->ram_free       = (RAM_START_ADDRESS + RAM_TOTAL_SIZE) - p_usage->ram_start -
+                              p_usage->data_size - p_usage->bss_size -
+                              p_usage->heap_size - p_usage->stack_size;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for calling the alert handler once per alert flag.
+ */
+static void alert_check(uint32_t                   flag,
+                        app_ram_usage_alert_type_t type,
+                        uint32_t                   category,
+                        uint32_t                   used,
+                        uint32_t                   size,
+                        uint32_t                   threshold)
+{
+    if ((m_alert_flags & flag) || ((uint64_t)used * 100 < (uint64_t)size * threshold))
+    {
+        return;
+    }
+    m_alert_flags |= flag;
+
+    if (m_alert_handler != NULL)
+    {
+        app_ram_usage_alert_t const alert =
+        {
+            .type     = type,
+            .category = category,
+            .used     = used,
+            .size     = size
+        };
+        m_alert_handler(&alert);
+    }
+}
+
+
+void app_ram_usage_check(void)
+{
+    alert_check(ALERT_FLAG_STACK, APP_RAM_USAGE_ALERT_STACK, 0,
+                app_ram_usage_stack_used_max(), STACK_SIZE, APP_RAM_USAGE_STACK_THRESHOLD);
+
+    if (HEAP_SIZE != 0)
+    {
+        alert_check(ALERT_FLAG_HEAP, APP_RAM_USAGE_ALERT_HEAP, 0,
+                    HEAP_USED_MAX, HEAP_SIZE, APP_RAM_USAGE_HEAP_THRESHOLD);
+    }
+
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+    for (uint32_t cat = 0; cat < MEM_CATEGORY_COUNT; cat++)
+    {
+        nrf_mem_stats_t stats;
+
+        if ((nrf_mem_stats_get(cat, &stats) == NRF_SUCCESS) && (stats.block_count != 0))
+        {
+            alert_check(ALERT_FLAG_MEM(cat), APP_RAM_USAGE_ALERT_MEM_MANAGER, cat,
+                        stats.blocks_in_use_max, stats.block_count, APP_RAM_USAGE_MEM_THRESHOLD);
+        }
+    }
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+}
+
+
+void app_ram_usage_log(void)
+{
+    app_ram_usage_t usage;
+
+    (void)app_ram_usage_get(&usage);
+
+    NRF_LOG_PRINTF("RAM start 0x%08x, free %u, data %u, bss %u\r\n",
+                   usage.ram_start, usage.ram_free, usage.data_size, usage.bss_size);
+    NRF_LOG_PRINTF("RAM stack %u/%u, heap %u/%u\r\n",
+                   usage.stack_used_max, usage.stack_size, usage.heap_used_max, usage.heap_size);
+
+#ifdef MEM_MANAGER_ENABLE_STATISTICS
+    for (uint32_t cat = 0; cat < MEM_CATEGORY_COUNT; cat++)
+    {
+        nrf_mem_stats_t stats;
+
+        if ((nrf_mem_stats_get(cat, &stats) == NRF_SUCCESS) && (stats.block_count != 0))
+        {
+            NRF_LOG_PRINTF("RAM mem_manager %u: %u/%u blocks of %u bytes\r\n",
+                           cat, stats.blocks_in_use_max, stats.block_count, stats.block_size);
+        }
+    }
+#endif // MEM_MANAGER_ENABLE_STATISTICS
+}
@@ -0,0 +1,132 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef APP_RAM_USAGE_H__
+#define APP_RAM_USAGE_H__
+
+/**
+ * @defgroup app_ram_usage RAM usage monitor
+ * @ingroup app_common
+ * @{
+ *
+ * @brief Module for measuring the RAM usage of the application at runtime.
+ *
+ * @details The module reports the size of the static sections, the stack high-water mark, the
+ *          newlib heap high-water mark and, when MEM_MANAGER_ENABLE_STATISTICS is defined, the
+ *          peak block usage of the memory manager. @ref app_ram_usage_check calls an alert
+ *          handler the first time a usage crosses its threshold.
+ *
+ *          The stack high-water mark is the lowest stack word that no longer holds
+ *          @ref APP_RAM_USAGE_STACK_FILL_PATTERN. The whole stack is filled with the pattern by
+ *          the startup file when it is assembled with __STARTUP_FILL_STACK defined. Otherwise,
+ *          @ref app_ram_usage_init fills the stack below the current stack pointer, and the stack
+ *          used before the call is not measured.
+ *
+ *          The heap usage is only measured in GCC builds, from the program break of newlib. It
+ *          is 0 with other toolchains.
+ */
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifndef APP_RAM_USAGE_STACK_THRESHOLD
+#define APP_RAM_USAGE_STACK_THRESHOLD   80          /**< Stack alert threshold, in percent of the stack size. */
+#endif
+
+#ifndef APP_RAM_USAGE_HEAP_THRESHOLD
+#define APP_RAM_USAGE_HEAP_THRESHOLD    80          /**< Heap alert threshold, in percent of the heap size. */
+#endif
+
+#ifndef APP_RAM_USAGE_MEM_THRESHOLD
+#define APP_RAM_USAGE_MEM_THRESHOLD     90          /**< Memory manager alert threshold, in percent of the blocks of a category. */
+#endif
+
+#define APP_RAM_USAGE_STACK_FILL_PATTERN 0xDEADBEEF /**< Stack fill pattern. Must match the pattern of the startup files. */
+
+/**@brief Alert types. */
+typedef enum
+{
+    APP_RAM_USAGE_ALERT_STACK,          /**< The stack high-water mark crossed @ref APP_RAM_USAGE_STACK_THRESHOLD. */
+    APP_RAM_USAGE_ALERT_HEAP,           /**< The heap high-water mark crossed @ref APP_RAM_USAGE_HEAP_THRESHOLD. */
+    APP_RAM_USAGE_ALERT_MEM_MANAGER     /**< The peak usage of a memory manager category crossed @ref APP_RAM_USAGE_MEM_THRESHOLD. */
+} app_ram_usage_alert_type_t;
+
+/**@brief Alert. */
+typedef struct
+{
+    app_ram_usage_alert_type_t type;    /**< Alert type. */
+    uint32_t                   category;/**< Memory manager block category. Only for @ref APP_RAM_USAGE_ALERT_MEM_MANAGER. */
+    uint32_t                   used;    /**< Peak usage, in bytes, or in blocks for the memory manager. */
+    uint32_t                   size;    /**< Available size, in the same unit. */
+} app_ram_usage_alert_t;
+
+/**@brief RAM usage report. Sizes are in bytes. */
+typedef struct
+{
+    uint32_t ram_start;         /**< Start of the application RAM, which must match the RAM base required by the SoftDevice. */
+    uint32_t ram_free;          /**< RAM not assigned to any section, between the application RAM start and the end of RAM. */
+    uint32_t data_size;         /**< Size of the initialized data sections. */
+    uint32_t bss_size;          /**< Size of the zero-initialized data sections. */
+    uint32_t heap_size;         /**< Size of the heap section. */
+    uint32_t heap_used_max;     /**< Heap high-water mark. 0 if not measured. */
+    uint32_t stack_size;        /**< Size of the stack section. */
+    uint32_t stack_used_max;    /**< Stack high-water mark. */
+} app_ram_usage_t;
+
+/**@brief Alert handler type. */
+typedef void (*app_ram_usage_alert_handler_t)(app_ram_usage_alert_t const * p_alert);
+
+/**@brief Function for initializing the module.
+ *
+ * @details If the stack was not filled by the startup file, the stack below the current stack
+ *          pointer is filled with the pattern. In that case, this function must be called
+ *          before the SoftDevice is enabled, since SoftDevice interrupts are not masked while
+ *          the stack is filled.
+ *
+ * @param[in] alert_handler  Handler called by @ref app_ram_usage_check. Can be NULL.
+ *
+ * @retval NRF_SUCCESS  The module was initialized.
+ */
+ret_code_t app_ram_usage_init(app_ram_usage_alert_handler_t alert_handler);
+
+/**@brief Function for reading the stack high-water mark.
+ *
+ * @details The stack is scanned from its limit up to the previous high-water mark, so the cost
+ *          decreases as the stack usage grows.
+ *
+ * @return Largest number of stack bytes used since startup.
+ */
+uint32_t app_ram_usage_stack_used_max(void);
+
+/**@brief Function for reading the RAM usage report.
+ *
+ * @param[out] p_usage  The report.
+ *
+ * @retval NRF_SUCCESS     The report was read.
+ * @retval NRF_ERROR_NULL  p_usage is NULL.
+ */
+ret_code_t app_ram_usage_get(app_ram_usage_t * p_usage);
+
+/**@brief Function for checking the usages against the thresholds.
+ *
+ * @details The alert handler is called the first time a usage is found above its threshold,
+ *          once per alert type and memory manager category. Should be called periodically from
+ *          the main loop, for example after each event is processed.
+ */
+void app_ram_usage_check(void);
+
+/**@brief Function for writing the RAM usage report to the logger. */
+void app_ram_usage_log(void);
+
+/** @} */
+
+#endif // APP_RAM_USAGE_H__
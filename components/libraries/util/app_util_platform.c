@@ -35,7 +35,9 @@ void app_util_critical_region_enter(uint8_t *p_nested)
     ASSERT(APP_LEVEL_PRIVILEGED == privilege_level_get())
 #endif
 
-#if defined(SOFTDEVICE_PRESENT)
+#if (APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED == 1)
+    *p_nested = app_util_basepri_raise();
+#elif defined(SOFTDEVICE_PRESENT)
     /* return value can be safely ignored */
     (void) sd_nvic_critical_region_enter(p_nested);
 #else
@@ -49,7 +51,9 @@ void app_util_critical_region_exit(uint8_t nested)
     ASSERT(APP_LEVEL_PRIVILEGED == privilege_level_get())
 #endif
 
-#if defined(SOFTDEVICE_PRESENT)
+#if (APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED == 1)
+    __set_BASEPRI(nested);
+#elif defined(SOFTDEVICE_PRESENT)
     /* return value can be safely ignored */
     (void) sd_nvic_critical_region_exit(nested);
 #else
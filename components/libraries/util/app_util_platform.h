@@ -54,6 +54,21 @@
     #error "No platform defined"
 #endif
 
+#ifndef APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED
+#define APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED 0  /**< Implement critical regions by masking the application interrupt priorities with BASEPRI, on nRF52 with a SoftDevice. */
+#endif
+
+#if (APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED == 1)
+#if !defined(NRF52) || !defined(SOFTDEVICE_PRESENT)
+    #error "BASEPRI critical regions are only available on nRF52 with a SoftDevice."
+#endif
+/**@brief BASEPRI value masking the interrupts from APP_IRQ_PRIORITY_HIGH down. The SoftDevice
+ *        priorities _PRIO_SD_HIGH and _PRIO_SD_MID stay unmasked, as they are while an
+ *        APP_IRQ_PRIORITY_HIGH interrupt is running.
+ */
+#define APP_UTIL_CRITICAL_REGION_BASEPRI  (_PRIO_APP_HIGH << (8 - __NVIC_PRIO_BITS))
+#endif
+
 /**@brief The interrupt priorities available to the application while the SoftDevice is active. */
 typedef enum
 {
@@ -89,13 +104,41 @@ typedef enum
 void app_util_critical_region_enter (uint8_t *p_nested);
 void app_util_critical_region_exit (uint8_t nested);
 
+#if (APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED == 1)
+/**@brief Function for masking the application interrupt priorities, unless they are already
+ *        masked.
+ *
+ * @return Previous value of BASEPRI, to be restored when leaving the critical region.
+ */
+static __INLINE uint8_t app_util_basepri_raise(void)
+{
+    uint8_t const basepri = (uint8_t)__get_BASEPRI();
+
+    if ((basepri == 0) || (basepri > APP_UTIL_CRITICAL_REGION_BASEPRI))
+    {
+        __set_BASEPRI(APP_UTIL_CRITICAL_REGION_BASEPRI);
+        __ISB();
+    }
+
+    return basepri;
+}
+#endif
+
 /**@brief Macro for entering a critical region.
  *
  * @note Due to implementation details, there must exist one and only one call to
  *       CRITICAL_REGION_EXIT() for each call to CRITICAL_REGION_ENTER(), and they must be located
  *       in the same scope.
+ *
+ * @note With @ref APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED, the region runs at the level of an
+ *       APP_IRQ_PRIORITY_HIGH interrupt, so SoftDevice API functions must not be called inside it.
+ *       It must also be entered in privileged mode, where BASEPRI can be written.
  */
-#ifdef SOFTDEVICE_PRESENT
+#if (APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED == 1)
+#define CRITICAL_REGION_ENTER()                                                             \
+    {                                                                                       \
+        uint8_t __CR_NESTED = app_util_basepri_raise();
+#elif defined(SOFTDEVICE_PRESENT)
 #define CRITICAL_REGION_ENTER()                                                             \
     {                                                                                       \
         uint8_t __CR_NESTED = 0;                                                            \
@@ -110,7 +153,11 @@ void app_util_critical_region_exit (uint8_t nested);
  *       CRITICAL_REGION_EXIT() for each call to CRITICAL_REGION_ENTER(), and they must be located
  *       in the same scope.
  */
-#ifdef SOFTDEVICE_PRESENT
+#if (APP_UTIL_CRITICAL_REGION_BASEPRI_ENABLED == 1)
+#define CRITICAL_REGION_EXIT()                                                              \
+        __set_BASEPRI(__CR_NESTED);                                                         \
+    }
+#elif defined(SOFTDEVICE_PRESENT)
 #define CRITICAL_REGION_EXIT()                                                              \
         app_util_critical_region_exit(__CR_NESTED);                                         \
     }
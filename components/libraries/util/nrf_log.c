@@ -315,7 +315,7 @@ void log_raw_uart_printf(const char * format_msg, ...)
 
     va_list p_args;
     va_start(p_args, format_msg);
-    sprintf(buffer, format_msg, p_args);
+    (void)vsnprintf(buffer, sizeof(buffer), format_msg, p_args);
     va_end(p_args);
 
     log_raw_uart_write_string(buffer);
@@ -390,6 +390,540 @@ uint32_t log_raw_uart_read_input(char * c)
 
 #endif // NRF_LOG_USES_RAW_UART == 1
 
+#if (NRF_LOG_DEFERRED == 1) && \
+    ((NRF_LOG_USES_RTT == 1) || (NRF_LOG_USES_UART == 1) || (NRF_LOG_USES_RAW_UART == 1))
+
+#include "app_util_platform.h"
+#include "nordic_common.h"
+
+#if (NRF_LOG_DEFERRED_QUEUE_SIZE & (NRF_LOG_DEFERRED_QUEUE_SIZE - 1)) != 0
+#error "NRF_LOG_DEFERRED_QUEUE_SIZE must be a power of 2."
+#endif
+
+#if (NRF_LOG_DEFERRED_MAX_ARGS < 1) || (NRF_LOG_DEFERRED_MAX_ARGS > 6)
+#error "NRF_LOG_DEFERRED_MAX_ARGS must be between 1 and 6."
+#endif
+
+/**@brief Deferred log entry types. */
+typedef enum
+{
+    LOG_ENTRY_PRINTF,       /**< Printf string, with p_format as format and args as arguments. */
+    LOG_ENTRY_STRING,       /**< Strings, p_format followed by the first num_args - 1 args. */
+    LOG_ENTRY_HEX,          /**< Integer logged as HEX value, in args[0]. */
+    LOG_ENTRY_HEX_CHAR,     /**< Character logged as HEX value, in args[0]. */
+} log_entry_type_t;
+
+/**@brief Deferred log entry. */
+typedef struct
+{
+    const char *     p_format;                          /**< Format string, or first string. */
+    uint32_t         timestamp;                         /**< Timestamp, 0 if no timestamp function is set. */
+    uint32_t         args[NRF_LOG_DEFERRED_MAX_ARGS];   /**< Arguments. */
+    uint8_t          type;                              /**< Entry type, see @ref log_entry_type_t. */
+    uint8_t          stream;                            /**< 0 for the normal stream, 1 for the error stream. */
+    uint8_t          num_args;                          /**< Number of arguments, or of strings. */
+    volatile uint8_t ready;                             /**< Set when the entry is completely written. */
+} log_entry_t;
+
+static log_entry_t          m_log_queue[NRF_LOG_DEFERRED_QUEUE_SIZE];
+static volatile uint32_t    m_log_wr_idx;               /**< Index of the next entry to reserve. Only incremented. */
+static volatile uint32_t    m_log_rd_idx;               /**< Index of the next entry to process. Only incremented. */
+static volatile uint32_t    m_log_dropped;              /**< Number of entries dropped because the queue was full. */
+static uint32_t             m_log_dropped_reported;     /**< Value of m_log_dropped when last reported. */
+static log_timestamp_func_t m_log_timestamp_func;
+
+#if (NRF_LOG_BINARY == 1)
+
+/* Binary record, all fields little endian:
+ *   sync      (1 byte)   LOG_BINARY_SYNC.
+ *   flags     (1 byte)   Number of argument words in bits 0-2, LOG_BINARY_FLAG_TIMESTAMP and
+ *                        LOG_BINARY_FLAG_ERROR.
+ *   string id (2 bytes)  Offset of the format string in the nrf_log_strings section, or
+ *                        LOG_BINARY_ID_ADDRESS if the format string is not in the section. The
+ *                        address of the format string is then sent as the first argument word.
+ *   timestamp (4 bytes)  Only if LOG_BINARY_FLAG_TIMESTAMP is set.
+ *   arguments (4 bytes each)
+ */
+#define LOG_BINARY_SYNC             0xA5
+#define LOG_BINARY_FLAG_TIMESTAMP   0x40
+#define LOG_BINARY_FLAG_ERROR       0x80
+#define LOG_BINARY_ID_ADDRESS       0xFFFF
+#define LOG_BINARY_RECORD_MAX_SIZE  (8 + 4 * (NRF_LOG_DEFERRED_MAX_ARGS + 1))
+
+NRF_SECTION_VARS_REGISTER_SECTION(nrf_log_strings);
+NRF_SECTION_VARS_REGISTER_SYMBOLS(char, nrf_log_strings);
+
+// Format strings of the entries which are not queued through LOG_BINARY_PRINTF. They also keep
+// the section symbols defined when no other module logs.
+NRF_SECTION_VARS_ADD(nrf_log_strings, char const m_log_str_string[])   = "%s";
+NRF_SECTION_VARS_ADD(nrf_log_strings, char const m_log_str_hex[])      = "0x%08X";
+NRF_SECTION_VARS_ADD(nrf_log_strings, char const m_log_str_hex_char[]) = "%02X";
+NRF_SECTION_VARS_ADD(nrf_log_strings, char const m_log_str_dropped[])  = "%u log entries dropped\r\n";
+
+#endif // NRF_LOG_BINARY == 1
+
+
+/**@brief Function for reserving a queue entry.
+ *
+ * @details Can be called from any interrupt priority. On Cortex-M3/M4 cores, the write index is
+ *          incremented with exclusive accesses and the interrupts are never disabled. Cortex-M0
+ *          cores do not have exclusive accesses, so a critical region of a few instructions is
+ *          used instead.
+ *
+ * @return The reserved entry, or NULL if the queue was full and the entry was dropped.
+ */
+static log_entry_t * log_entry_alloc(void)
+{
+    uint32_t wr_idx;
+    bool     full;
+
+#if (__CORTEX_M >= 0x03)
+    do
+    {
+        wr_idx = __LDREXW((uint32_t *)&m_log_wr_idx);
+        full   = ((wr_idx - m_log_rd_idx) >= NRF_LOG_DEFERRED_QUEUE_SIZE);
+        if (full)
+        {
+            __CLREX();
+            break;
+        }
+    } while (__STREXW(wr_idx + 1, (uint32_t *)&m_log_wr_idx) != 0);
+
+    if (full)
+    {
+        uint32_t dropped;
+        do
+        {
+            dropped = __LDREXW((uint32_t *)&m_log_dropped);
+        } while (__STREXW(dropped + 1, (uint32_t *)&m_log_dropped) != 0);
+        return NULL;
+    }
+#else
+    CRITICAL_REGION_ENTER();
+    wr_idx = m_log_wr_idx;
+    full   = ((wr_idx - m_log_rd_idx) >= NRF_LOG_DEFERRED_QUEUE_SIZE);
+    if (full)
+    {
+        m_log_dropped++;
+    }
+    else
+    {
+        m_log_wr_idx = wr_idx + 1;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (full)
+    {
+        return NULL;
+    }
+#endif
+
+    log_entry_t * p_entry = &m_log_queue[wr_idx & (NRF_LOG_DEFERRED_QUEUE_SIZE - 1)];
+
+    p_entry->timestamp = (m_log_timestamp_func != NULL) ? m_log_timestamp_func() : 0;
+    return p_entry;
+}
+
+
+/**@brief Function for marking a reserved entry as ready to be processed. */
+static __INLINE void log_entry_commit(log_entry_t * p_entry)
+{
+    __DMB();
+    p_entry->ready = 1;
+}
+
+
+#if (NRF_LOG_BINARY != 1)
+
+/**@brief Function for sending a printf string to the backend.
+ *
+ * @details Unused arguments are passed as 0: printf ignores the arguments it does not consume.
+ */
+static void log_backend_printf(uint8_t stream, const char * p_format, uint32_t const * p_args)
+{
+    uint32_t a[6] = {0};
+
+    memcpy(a, p_args, sizeof(uint32_t) * NRF_LOG_DEFERRED_MAX_ARGS);
+
+#if (NRF_LOG_USES_RTT == 1)
+    log_rtt_printf((stream != 0) ? LOG_TERMINAL_ERROR : LOG_TERMINAL_NORMAL,
+                   (char *)p_format, a[0], a[1], a[2], a[3], a[4], a[5]);
+#elif (NRF_LOG_USES_UART == 1)
+    UNUSED_PARAMETER(stream);
+    log_uart_printf(p_format, a[0], a[1], a[2], a[3], a[4], a[5]);
+#else
+    UNUSED_PARAMETER(stream);
+    log_raw_uart_printf(p_format, a[0], a[1], a[2], a[3], a[4], a[5]);
+#endif
+}
+
+
+/**@brief Function for sending a string to the backend. */
+static void log_backend_write_string(uint8_t stream, const char * p_str)
+{
+#if (NRF_LOG_USES_RTT == 1)
+    log_rtt_write_string((stream != 0) ? LOG_TERMINAL_ERROR : LOG_TERMINAL_NORMAL, 1, p_str);
+#elif (NRF_LOG_USES_UART == 1)
+    UNUSED_PARAMETER(stream);
+    log_uart_write_string(p_str);
+#else
+    UNUSED_PARAMETER(stream);
+    log_raw_uart_write_string(p_str);
+#endif
+}
+
+
+/**@brief Function for sending an integer as HEX value to the backend. */
+static void log_backend_write_hex(uint8_t stream, uint32_t value)
+{
+#if (NRF_LOG_USES_RTT == 1)
+    log_rtt_write_hex((stream != 0) ? LOG_TERMINAL_ERROR : LOG_TERMINAL_NORMAL, value);
+#elif (NRF_LOG_USES_UART == 1)
+    UNUSED_PARAMETER(stream);
+    log_uart_write_hex(value);
+#else
+    UNUSED_PARAMETER(stream);
+    log_raw_uart_write_hex(value);
+#endif
+}
+
+
+/**@brief Function for sending a character as HEX value to the backend. */
+static void log_backend_write_hex_char(uint8_t stream, uint8_t value)
+{
+#if (NRF_LOG_USES_RTT == 1)
+    log_rtt_write_hex_char((stream != 0) ? LOG_TERMINAL_ERROR : LOG_TERMINAL_NORMAL, value);
+#elif (NRF_LOG_USES_UART == 1)
+    UNUSED_PARAMETER(stream);
+    log_uart_write_hex_char(value);
+#else
+    UNUSED_PARAMETER(stream);
+    log_raw_uart_write_hex_char(value);
+#endif
+}
+
+#else
+
+/**@brief Function for sending raw bytes to the backend. */
+static void log_backend_write(uint8_t const * p_data, uint32_t length)
+{
+#if (NRF_LOG_USES_RTT == 1)
+    (void)SEGGER_RTT_Write(LOG_TERMINAL_NORMAL, p_data, length);
+#elif (NRF_LOG_USES_UART == 1)
+    for (uint32_t i = 0; i < length; i++)
+    {
+        (void)app_uart_put(p_data[i]);
+    }
+#else
+    for (uint32_t i = 0; i < length; i++)
+    {
+        log_raw_uart_write_char((char)p_data[i]);
+    }
+#endif
+}
+
+
+/**@brief Function for encoding a binary record and sending it to the backend.
+ *
+ * @param[in] stream         0 for the normal stream, 1 for the error stream.
+ * @param[in] p_format       Format string.
+ * @param[in] has_timestamp  Whether the timestamp is sent.
+ * @param[in] timestamp      Timestamp.
+ * @param[in] p_args         Arguments.
+ * @param[in] num_args       Number of arguments, at most NRF_LOG_DEFERRED_MAX_ARGS.
+ */
+static void log_binary_record_write(uint8_t          stream,
+                                    const char     * p_format,
+                                    bool             has_timestamp,
+                                    uint32_t         timestamp,
+                                    uint32_t const * p_args,
+                                    uint32_t         num_args)
+{
+    uint8_t  record[LOG_BINARY_RECORD_MAX_SIZE];
+    uint32_t len       = 2;
+    uint32_t str_start = NRF_SECTION_VARS_START_ADDR(nrf_log_strings);
+    uint32_t str_addr  = (uint32_t)p_format;
+    uint32_t words     = num_args;
+
+    record[0] = LOG_BINARY_SYNC;
+
+    if ((str_addr >= str_start) &&
+        (str_addr <  NRF_SECTION_VARS_END_ADDR(nrf_log_strings)) &&
+        ((str_addr - str_start) < LOG_BINARY_ID_ADDRESS))
+    {
+        len += uint16_encode((uint16_t)(str_addr - str_start), &record[len]);
+        if (has_timestamp)
+        {
+            len += uint32_encode(timestamp, &record[len]);
+        }
+    }
+    else
+    {
+        len += uint16_encode(LOG_BINARY_ID_ADDRESS, &record[len]);
+        if (has_timestamp)
+        {
+            len += uint32_encode(timestamp, &record[len]);
+        }
+        len += uint32_encode(str_addr, &record[len]);
+        words++;
+    }
+
+    for (uint32_t i = 0; i < num_args; i++)
+    {
+        len += uint32_encode(p_args[i], &record[len]);
+    }
+
+    record[1] = (uint8_t)words;
+    if (has_timestamp)
+    {
+        record[1] |= LOG_BINARY_FLAG_TIMESTAMP;
+    }
+    if (stream != 0)
+    {
+        record[1] |= LOG_BINARY_FLAG_ERROR;
+    }
+
+    log_backend_write(record, len);
+}
+
+
+/**@brief Function for sending a queue entry to the backend as binary records. */
+static void log_binary_entry_write(log_entry_t const * p_entry)
+{
+    bool     has_timestamp = (m_log_timestamp_func != NULL);
+    uint32_t str_addr;
+
+    switch (p_entry->type)
+    {
+        case LOG_ENTRY_PRINTF:
+            log_binary_record_write(p_entry->stream, p_entry->p_format, has_timestamp,
+                                    p_entry->timestamp, p_entry->args, p_entry->num_args);
+            break;
+
+        case LOG_ENTRY_STRING:
+            str_addr = (uint32_t)p_entry->p_format;
+            log_binary_record_write(p_entry->stream, m_log_str_string, has_timestamp,
+                                    p_entry->timestamp, &str_addr, 1);
+            for (uint32_t i = 1; i < p_entry->num_args; i++)
+            {
+                log_binary_record_write(p_entry->stream, m_log_str_string, false, 0,
+                                        &p_entry->args[i - 1], 1);
+            }
+            break;
+
+        case LOG_ENTRY_HEX:
+            log_binary_record_write(p_entry->stream, m_log_str_hex, has_timestamp,
+                                    p_entry->timestamp, p_entry->args, 1);
+            break;
+
+        case LOG_ENTRY_HEX_CHAR:
+            log_binary_record_write(p_entry->stream, m_log_str_hex_char, has_timestamp,
+                                    p_entry->timestamp, p_entry->args, 1);
+            break;
+
+        default:
+            break;
+    }
+}
+
+#endif // NRF_LOG_BINARY == 1
+
+
+uint32_t log_deferred_init(void)
+{
+    m_log_rd_idx           = 0;
+    m_log_wr_idx           = 0;
+    m_log_dropped          = 0;
+    m_log_dropped_reported = 0;
+    memset(m_log_queue, 0, sizeof(m_log_queue));
+
+#if (NRF_LOG_USES_RTT == 1)
+    return log_rtt_init();
+#elif (NRF_LOG_USES_UART == 1)
+    return log_uart_init();
+#else
+    return log_raw_uart_init();
+#endif
+}
+
+
+void log_deferred_timestamp_func_set(log_timestamp_func_t timestamp_func)
+{
+    m_log_timestamp_func = timestamp_func;
+}
+
+
+//lint -save -e530 -e64 -e26 -e10 -e526 -e628
+void log_deferred_printf(uint8_t stream, uint32_t num_args, const char * format_msg, ...)
+{
+    log_entry_t * p_entry = log_entry_alloc();
+    if (p_entry == NULL)
+    {
+        return;
+    }
+
+    va_list p_args;
+    va_start(p_args, format_msg);
+
+    num_args = MIN(num_args, NRF_LOG_DEFERRED_MAX_ARGS);
+    for (uint32_t i = 0; i < NRF_LOG_DEFERRED_MAX_ARGS; i++)
+    {
+        p_entry->args[i] = (i < num_args) ? va_arg(p_args, uint32_t) : 0;
+    }
+    va_end(p_args);
+
+    p_entry->p_format = format_msg;
+    p_entry->type     = LOG_ENTRY_PRINTF;
+    p_entry->stream   = stream;
+    p_entry->num_args = (uint8_t)num_args;
+    log_entry_commit(p_entry);
+}
+
+
+void log_deferred_write_string(uint8_t stream, uint32_t num_args, ...)
+{
+    if (num_args == 0)
+    {
+        return;
+    }
+
+    log_entry_t * p_entry = log_entry_alloc();
+    if (p_entry == NULL)
+    {
+        return;
+    }
+
+    va_list p_args;
+    va_start(p_args, num_args);
+
+    num_args          = MIN(num_args, NRF_LOG_DEFERRED_MAX_ARGS + 1);
+    p_entry->p_format = va_arg(p_args, const char *);
+    for (uint32_t i = 1; i < num_args; i++)
+    {
+        p_entry->args[i - 1] = (uint32_t)va_arg(p_args, const char *);
+    }
+    va_end(p_args);
+
+    p_entry->type     = LOG_ENTRY_STRING;
+    p_entry->stream   = stream;
+    p_entry->num_args = (uint8_t)num_args;
+    log_entry_commit(p_entry);
+}
+//lint -restore
+
+
+void log_deferred_write_hex(uint8_t stream, uint32_t value)
+{
+    log_entry_t * p_entry = log_entry_alloc();
+    if (p_entry == NULL)
+    {
+        return;
+    }
+
+    p_entry->args[0] = value;
+    p_entry->type    = LOG_ENTRY_HEX;
+    p_entry->stream  = stream;
+    log_entry_commit(p_entry);
+}
+
+
+void log_deferred_write_hex_char(uint8_t stream, uint8_t value)
+{
+    log_entry_t * p_entry = log_entry_alloc();
+    if (p_entry == NULL)
+    {
+        return;
+    }
+
+    p_entry->args[0] = value;
+    p_entry->type    = LOG_ENTRY_HEX_CHAR;
+    p_entry->stream  = stream;
+    log_entry_commit(p_entry);
+}
+
+
+bool log_deferred_process(void)
+{
+    uint32_t dropped = m_log_dropped;
+
+    if (dropped != m_log_dropped_reported)
+    {
+        uint32_t args[NRF_LOG_DEFERRED_MAX_ARGS] = {dropped - m_log_dropped_reported};
+
+        m_log_dropped_reported = dropped;
+#if (NRF_LOG_BINARY == 1)
+        log_binary_record_write(1, m_log_str_dropped, false, 0, args, 1);
+#else
+        log_backend_printf(1, "%u log entries dropped\r\n", args);
+#endif
+    }
+
+    uint32_t rd_idx = m_log_rd_idx;
+    if (rd_idx == m_log_wr_idx)
+    {
+        return false;
+    }
+
+    log_entry_t * p_entry = &m_log_queue[rd_idx & (NRF_LOG_DEFERRED_QUEUE_SIZE - 1)];
+    if (!p_entry->ready)
+    {
+        // The entry is reserved, but the context writing it has been preempted.
+        return false;
+    }
+    __DMB();
+
+#if (NRF_LOG_BINARY == 1)
+    log_binary_entry_write(p_entry);
+#else
+    if (m_log_timestamp_func != NULL)
+    {
+        uint32_t args[NRF_LOG_DEFERRED_MAX_ARGS] = {p_entry->timestamp};
+        log_backend_printf(p_entry->stream, "[%u] ", args);
+    }
+
+    switch (p_entry->type)
+    {
+        case LOG_ENTRY_PRINTF:
+            log_backend_printf(p_entry->stream, p_entry->p_format, p_entry->args);
+            break;
+
+        case LOG_ENTRY_STRING:
+            log_backend_write_string(p_entry->stream, p_entry->p_format);
+            for (uint32_t i = 1; i < p_entry->num_args; i++)
+            {
+                log_backend_write_string(p_entry->stream, (const char *)p_entry->args[i - 1]);
+            }
+            break;
+
+        case LOG_ENTRY_HEX:
+            log_backend_write_hex(p_entry->stream, p_entry->args[0]);
+            break;
+
+        case LOG_ENTRY_HEX_CHAR:
+            log_backend_write_hex_char(p_entry->stream, (uint8_t)p_entry->args[0]);
+            break;
+
+        default:
+            break;
+    }
+#endif // NRF_LOG_BINARY == 1
+
+    // Release the entry to the producers.
+    p_entry->ready = 0;
+    __DMB();
+    m_log_rd_idx = rd_idx + 1;
+
+    return (m_log_rd_idx != m_log_wr_idx);
+}
+
+
+uint32_t log_deferred_dropped_count_get(void)
+{
+    return m_log_dropped;
+}
+
+#endif // NRF_LOG_DEFERRED == 1
+
 
 const char* log_hex_char(const char c)
 {
@@ -5,6 +5,7 @@
 
 #include <stdint.h>
 #include <stdarg.h>
+#include <stdbool.h>
 #include <app_util.h>
 
 #ifndef NRF_LOG_USES_RTT
@@ -19,6 +20,30 @@
 #define NRF_LOG_USES_RAW_UART 0
 #endif
 
+#ifndef NRF_LOG_DEFERRED
+#define NRF_LOG_DEFERRED 0
+#endif
+
+#ifndef NRF_LOG_DEFERRED_QUEUE_SIZE
+#define NRF_LOG_DEFERRED_QUEUE_SIZE 16
+#endif
+
+#ifndef NRF_LOG_DEFERRED_MAX_ARGS
+#define NRF_LOG_DEFERRED_MAX_ARGS 4
+#endif
+
+#ifndef NRF_LOG_BINARY
+#define NRF_LOG_BINARY 0
+#endif
+
+#if (NRF_LOG_BINARY == 1) && (NRF_LOG_DEFERRED != 1)
+#error "NRF_LOG_BINARY requires NRF_LOG_DEFERRED."
+#endif
+
+#if (NRF_LOG_BINARY == 1) && defined(__ICCARM__)
+#error "NRF_LOG_BINARY is not supported with IAR."
+#endif
+
 #ifndef NRF_LOG_USES_COLORS
     #define NRF_LOG_USES_COLORS 1
 #endif
@@ -580,10 +605,191 @@ uint32_t log_raw_uart_read_input(char* p_char);
 
 #endif
 
+#if (NRF_LOG_DEFERRED == 1) && \
+    ((NRF_LOG_USES_RTT == 1) || (NRF_LOG_USES_UART == 1) || (NRF_LOG_USES_RAW_UART == 1))
+
+/**@brief Function type for reading the timestamp stored with each deferred log entry. */
+typedef uint32_t (*log_timestamp_func_t)(void);
+
+/**@brief Function for initializing the deferred logging queue and the selected backend.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @retval NRF_SUCCESS  If initialization was successful.
+ * @return Error returned by the backend initialization.
+ */
+uint32_t log_deferred_init(void);
+
+/**@brief Function for setting the function used to timestamp the deferred log entries.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @param[in] timestamp_func  Timestamp function, called from the logging context. NULL to stop
+ *                            timestamping the entries.
+ */
+void log_deferred_timestamp_func_set(log_timestamp_func_t timestamp_func);
+
+/**@brief Function for queuing a printf string.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @details The format string is not processed in the calling context: the format pointer and
+ *          the arguments are stored in the queue and formatted by @ref log_deferred_process.
+ *          Only 32-bit arguments are supported, and at most NRF_LOG_DEFERRED_MAX_ARGS of them.
+ *          The format string, and the strings passed as arguments, must remain valid until
+ *          the entry is processed.
+ *
+ * @param[in] stream      0 for the normal stream, 1 for the error stream.
+ * @param[in] num_args    Number of arguments following the format string.
+ * @param[in] format_msg  Printf format string.
+ * @param[in] ...         Arguments replacing the format specifiers in format_msg.
+ */
+void log_deferred_printf(uint8_t stream, uint32_t num_args, const char * format_msg, ...);
+
+/**@brief Function for queuing null-terminated strings.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @details Only the string pointers are stored in the queue: the strings must remain valid until
+ *          the entry is processed. At most 1 + NRF_LOG_DEFERRED_MAX_ARGS strings are logged.
+ *
+ * @param[in] stream    0 for the normal stream, 1 for the error stream.
+ * @param[in] num_args  Number of strings.
+ * @param[in] ...       Null-terminated strings.
+ */
+void log_deferred_write_string(uint8_t stream, uint32_t num_args, ...);
+
+/**@brief Function for queuing an integer to be logged as HEX value.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @param[in] stream  0 for the normal stream, 1 for the error stream.
+ * @param[in] value   Integer value.
+ */
+void log_deferred_write_hex(uint8_t stream, uint32_t value);
+
+/**@brief Function for queuing a character to be logged as HEX value.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @param[in] stream  0 for the normal stream, 1 for the error stream.
+ * @param[in] value   Character.
+ */
+void log_deferred_write_hex_char(uint8_t stream, uint8_t value);
+
+/**@brief Function for formatting and sending the oldest queued entry to the backend.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @details Must be called from a single context, for example the main loop before sleeping, or
+ *          a low priority software interrupt. If entries were dropped since the last call, the
+ *          number of dropped entries is logged first, to the error stream.
+ *
+ * @retval true   If there are more entries to process.
+ * @retval false  If the queue is empty, or the oldest entry is still being written.
+ */
+bool log_deferred_process(void);
+
+/**@brief Function for getting the number of entries dropped because the queue was full.
+ *
+ * This function is available only when NRF_LOG_DEFERRED is defined as 1.
+ *
+ * @return Number of dropped entries since initialization.
+ */
+uint32_t log_deferred_dropped_count_get(void);
+
+#undef NRF_LOG_INIT
+#undef NRF_LOG
+#undef NRF_LOG_DEBUG
+#undef NRF_LOG_ERROR
+#undef NRF_LOG_PRINTF
+#undef NRF_LOG_PRINTF_DEBUG
+#undef NRF_LOG_PRINTF_ERROR
+#undef NRF_LOG_HEX
+#undef NRF_LOG_HEX_DEBUG
+#undef NRF_LOG_HEX_ERROR
+#undef NRF_LOG_HEX_CHAR
+#undef NRF_LOG_HEX_CHAR_DEBUG
+#undef NRF_LOG_HEX_CHAR_ERROR
+
+#define NRF_LOG_INIT()                  log_deferred_init()                                                     /*!< Initialize the module. */
+
+#define NRF_LOG_PRINTF(...)             log_deferred_printf(0, NUM_VA_ARGS(__VA_ARGS__) - 1, __VA_ARGS__)      /*!< Queue a log message using printf. */
+#define NRF_LOG_PRINTF_DEBUG(...)       log_deferred_printf(0, NUM_VA_ARGS(__VA_ARGS__) - 1, __VA_ARGS__)      /*!< If DEBUG is set, queue a log message using printf. */
+#define NRF_LOG_PRINTF_ERROR(...)       log_deferred_printf(1, NUM_VA_ARGS(__VA_ARGS__) - 1, __VA_ARGS__)      /*!< Queue a log message using printf to the error stream. */
+
+#define NRF_LOG(...)                    log_deferred_write_string(0, NUM_VA_ARGS(__VA_ARGS__), __VA_ARGS__)    /*!< Queue a log message. The input string must be null-terminated. */
+#define NRF_LOG_DEBUG(...)              log_deferred_write_string(0, NUM_VA_ARGS(__VA_ARGS__), __VA_ARGS__)    /*!< If DEBUG is set, queue a log message. The input string must be null-terminated. */
+#define NRF_LOG_ERROR(...)              log_deferred_write_string(1, NUM_VA_ARGS(__VA_ARGS__), __VA_ARGS__)    /*!< Queue a log message to the error stream. The input string must be null-terminated. */
+
+#define NRF_LOG_HEX(val)                log_deferred_write_hex(0, val)                                          /*!< Queue an integer to be logged as HEX value (example output: 0x89ABCDEF). */
+#define NRF_LOG_HEX_DEBUG(val)          log_deferred_write_hex(0, val)                                          /*!< If DEBUG is set, queue an integer to be logged as HEX value. */
+#define NRF_LOG_HEX_ERROR(val)          log_deferred_write_hex(1, val)                                          /*!< Queue an integer to be logged as HEX value to the error stream. */
+
+#define NRF_LOG_HEX_CHAR(val)           log_deferred_write_hex_char(0, val)                                     /*!< Queue a character to be logged as HEX value (example output: AA). */
+#define NRF_LOG_HEX_CHAR_DEBUG(val)     log_deferred_write_hex_char(0, val)                                     /*!< If DEBUG is set, queue a character to be logged as HEX value. */
+#define NRF_LOG_HEX_CHAR_ERROR(val)     log_deferred_write_hex_char(1, val)                                     /*!< Queue a character to be logged as HEX value to the error stream. */
+
+#define NRF_LOG_PROCESS()               log_deferred_process()                                                  /*!< Process the oldest queued entry. */
+#define NRF_LOG_DROPPED_COUNT()         log_deferred_dropped_count_get()                                        /*!< Get the number of dropped entries. */
+
+#if (NRF_LOG_BINARY == 1)
+
+#include "section_vars.h"
+
+/**@brief Macro for queuing a printf string whose format string is placed in the string table.
+ *
+ * @details The string table is the nrf_log_strings section. Only the offset of the format string
+ *          in the table is sent to the host, which reads the string table from the ELF file.
+ *          The format string must be a string literal.
+ */
+#define LOG_BINARY_PRINTF(stream, format_msg, ...)                                                  \
+    do                                                                                              \
+    {                                                                                               \
+        NRF_SECTION_VARS_ADD(nrf_log_strings, char const log_format[]) = format_msg;                \
+        log_deferred_printf(stream, NUM_VA_ARGS(format_msg, ##__VA_ARGS__) - 1, log_format,         \
+                            ##__VA_ARGS__);                                                         \
+    } while (0)
+
+#undef NRF_LOG_PRINTF
+#undef NRF_LOG_PRINTF_DEBUG
+#undef NRF_LOG_PRINTF_ERROR
+
+#define NRF_LOG_PRINTF(...)             LOG_BINARY_PRINTF(0, __VA_ARGS__)                                       /*!< Queue a binary log message. The format string must be a string literal. */
+#define NRF_LOG_PRINTF_DEBUG(...)       LOG_BINARY_PRINTF(0, __VA_ARGS__)                                       /*!< If DEBUG is set, queue a binary log message. */
+#define NRF_LOG_PRINTF_ERROR(...)       LOG_BINARY_PRINTF(1, __VA_ARGS__)                                       /*!< Queue a binary log message to the error stream. */
+
+#endif // NRF_LOG_BINARY == 1
+
+#if !defined(DEBUG) && !defined(DOXYGEN)
+
+#undef NRF_LOG_DEBUG
+#define NRF_LOG_DEBUG(...)
+
+#undef NRF_LOG_PRINTF_DEBUG
+#define NRF_LOG_PRINTF_DEBUG(...)
+
+#undef NRF_LOG_HEX_DEBUG
+#define NRF_LOG_HEX_DEBUG(...)
+
+#undef NRF_LOG_HEX_CHAR_DEBUG
+#define NRF_LOG_HEX_CHAR_DEBUG(...)
+
+#endif // !defined(DEBUG) && !defined(DOXYGEN)
+
+#else
+
+#define NRF_LOG_PROCESS()               false
+#define NRF_LOG_DROPPED_COUNT()         0
+
+#endif // NRF_LOG_DEFERRED == 1
+
 /**@brief Function for writing HEX values.
  *
  * @note This function not thread-safe. It is written for convenience.
  *          If you log from different application contexts, you might get different results.
+ *          The returned string must not be passed to NRF_LOG when NRF_LOG_DEFERRED is set;
+ *          use NRF_LOG_HEX instead.
  *
  * @retval NULL By default.
  */
@@ -617,6 +823,24 @@ const char* log_hex_char(const char value);
  * the macros to have effect. If you choose to not output information, all
  * logging macros can be left in the code without any cost; they will just be
  * ignored.
+ *
+ * Define NRF_LOG_DEFERRED=1 to defer the output: the logging macros then only
+ * store the format string pointer, up to NRF_LOG_DEFERRED_MAX_ARGS 32-bit
+ * arguments and a timestamp in a queue of NRF_LOG_DEFERRED_QUEUE_SIZE entries,
+ * and the formatting and the backend output are done by @ref NRF_LOG_PROCESS,
+ * called from the main loop or a low priority interrupt. Strings passed to the
+ * macros must then remain valid until they are processed. Entries logged while
+ * the queue is full are dropped and counted.
+ *
+ * Define NRF_LOG_BINARY=1, together with NRF_LOG_DEFERRED=1, to send binary
+ * records instead of text. The format strings of NRF_LOG_PRINTF are placed in
+ * the nrf_log_strings section, and each record only holds the offset of the
+ * format string in this section, the timestamp and the raw arguments. Text is
+ * formatted on the host by nrf_log_bin_decode.py, which reads the string table
+ * from the ELF file. Format strings must be string literals, and strings passed
+ * as arguments or to NRF_LOG can only be decoded if they are stored in flash.
+ * The experimental_section_vars directory must be in the include path, and
+ * GCC builds must use a linker script which defines the nrf_log_strings section.
  */
 
 
@@ -694,6 +918,23 @@ int NRF_LOG_HAS_INPUT(void);
  */
 uint32_t NRF_LOG_READ_INPUT(char* p_char);
 
+/**@brief Macro for processing the oldest entry of the deferred logging queue.
+ *
+ * @details Does nothing when NRF_LOG_DEFERRED is not set. Typically called until it returns
+ *          false before the application goes to sleep.
+ *
+ * @retval      true  If there are more entries to process.
+ * @retval      false If the queue is empty.
+ */
+bool NRF_LOG_PROCESS(void);
+
+/**@brief Macro for getting the number of entries dropped because the deferred logging queue
+ *        was full.
+ *
+ * @return      Number of dropped entries, always 0 when NRF_LOG_DEFERRED is not set.
+ */
+uint32_t NRF_LOG_DROPPED_COUNT(void);
+
 /** @} */
 #endif // DOXYGEN
 #endif // NRF_LOG_H_
@@ -0,0 +1,198 @@
+#!/usr/bin/env python
+# Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+#
+# The information contained herein is property of Nordic Semiconductor ASA.
+# Terms and conditions of usage are described in detail in NORDIC
+# SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+#
+# Licensees are granted free, non-transferable use of the information. NO
+# WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+# the file.
+
+"""Decoder for the binary records of nrf_log (NRF_LOG_BINARY=1).
+
+The format strings are read from the nrf_log_strings section of the ELF file
+of the application. Strings passed as %s arguments are read from the ELF file
+as well, so only strings stored in flash can be decoded.
+
+Usage:
+    nrf_log_bin_decode.py <application.elf> [<log file>]
+
+The log file is a capture of the RTT channel or of the UART. Records are read
+from the standard input if no log file is given, for example:
+    cat /dev/ttyACM0 | nrf_log_bin_decode.py _build/nrf52832_xxaa.out
+Records of the error stream are written to the standard error.
+"""
+
+import re
+import struct
+import sys
+
+LOG_BINARY_SYNC = 0xA5
+LOG_BINARY_FLAG_TIMESTAMP = 0x40
+LOG_BINARY_FLAG_ERROR = 0x80
+LOG_BINARY_ARGS_MASK = 0x07
+LOG_BINARY_ID_ADDRESS = 0xFFFF
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+STRINGS_SECTIONS = ('.nrf_log_strings', 'nrf_log_strings')
+
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(\.\d+)?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+class Elf(object):
+    """Minimal little endian ELF32 reader: section contents by name and by address."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        ident = bytearray(self.data[:6])
+        if ident[:4] != bytearray(b'\x7fELF') or ident[4] != 1 or ident[5] != 1:
+            raise ValueError('%s is not a little endian ELF32 file' % path)
+
+        (shoff,) = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+
+        headers = [struct.unpack_from('<IIIIIIIIII', self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        names_offset = headers[shstrndx][4]
+
+        self.sections = []
+        for (name, sh_type, flags, addr, offset, size, _, _, _, _) in headers:
+            end = self.data.index(b'\0', names_offset + name)
+            self.sections.append({'name': self.data[names_offset + name:end].decode('ascii'),
+                                  'type': sh_type,
+                                  'flags': flags,
+                                  'addr': addr,
+                                  'offset': offset,
+                                  'size': size})
+
+    def section(self, names):
+        for s in self.sections:
+            if s['name'] in names:
+                return s
+        return None
+
+    def string_at(self, section, offset):
+        start = section['offset'] + offset
+        end = self.data.index(b'\0', start, section['offset'] + section['size'])
+        return self.data[start:end].decode('latin-1')
+
+    def string_at_address(self, address):
+        for s in self.sections:
+            if ((s['flags'] & SHF_ALLOC) and s['type'] != SHT_NOBITS and
+                    s['addr'] <= address < s['addr'] + s['size']):
+                try:
+                    return self.string_at(s, address - s['addr'])
+                except ValueError:
+                    return None
+        return None
+
+
+def signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_message(elf, fmt, args):
+    """Formats a C printf string with 32-bit arguments."""
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = str(signed(next_arg()))
+        spec = '%' + flags + (width or '') + (precision or '')
+        value = next_arg()
+        if conv in 'di':
+            return (spec + 'd') % signed(value)
+        if conv in 'ouxX':
+            return (spec + conv) % value
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'p':
+            return '0x%08x' % value
+        string = elf.string_at_address(value)
+        if string is None:
+            string = '<string at 0x%08X>' % value
+        return (spec + 's') % string
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def decode(elf, stream):
+    strings = elf.section(STRINGS_SECTIONS)
+    if strings is None:
+        raise ValueError('The ELF file has no nrf_log_strings section')
+
+    buf = b''
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        buf += chunk
+
+        while True:
+            start = buf.find(bytes(bytearray([LOG_BINARY_SYNC])))
+            if start < 0:
+                buf = b''
+                break
+            buf = buf[start:]
+            if len(buf) < 4:
+                break
+
+            flags = bytearray(buf[1:2])[0]
+            (string_id,) = struct.unpack_from('<H', buf, 2)
+            words = flags & LOG_BINARY_ARGS_MASK
+            length = 4 + 4 * words + (4 if flags & LOG_BINARY_FLAG_TIMESTAMP else 0)
+            if (flags & 0x38) or (string_id != LOG_BINARY_ID_ADDRESS and
+                                  string_id >= strings['size']):
+                # Not a record: resynchronize on the next sync byte.
+                buf = buf[1:]
+                continue
+            if len(buf) < length:
+                break
+
+            pos = 4
+            prefix = ''
+            if flags & LOG_BINARY_FLAG_TIMESTAMP:
+                prefix = '[%u] ' % struct.unpack_from('<I', buf, pos)[0]
+                pos += 4
+            args = struct.unpack_from('<%dI' % words, buf, pos)
+            buf = buf[length:]
+
+            if string_id == LOG_BINARY_ID_ADDRESS:
+                fmt = elf.string_at_address(args[0]) if args else None
+                args = args[1:]
+            else:
+                fmt = elf.string_at(strings, string_id)
+            if fmt is None:
+                fmt = '<unknown format string>\n'
+
+            out = sys.stderr if flags & LOG_BINARY_FLAG_ERROR else sys.stdout
+            out.write(prefix + format_message(elf, fmt, args))
+            out.flush()
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write(__doc__)
+        return 1
+
+    elf = Elf(argv[1])
+    if len(argv) == 3:
+        with open(argv[2], 'rb') as stream:
+            decode(elf, stream)
+    else:
+        decode(elf, getattr(sys.stdin, 'buffer', sys.stdin))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
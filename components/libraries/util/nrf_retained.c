@@ -0,0 +1,118 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+#include "nrf_retained.h"
+#include <stddef.h>
+#include "nrf.h"
+#include "crc16.h"
+#include "nrf_error.h"
+#ifdef SOFTDEVICE_PRESENT
+#include "nrf_soc.h"
+#endif
+
+#define RAM_BLOCK_SIZE  0x2000      /**< Size of a RAM block, in bytes. */
+#define NRF_RAM_START   0x20000000  /**< Address of RAM block 0. */
+
+#ifdef NRF51
+#define NRF_RAM_BLOCKS  4           /**< Blocks that can be retained. */
+#else
+#define NRF_RAM_BLOCKS  8           /**< Blocks that can be retained. */
+#endif
+
+#if defined(__GNUC__) && !defined(__CC_ARM)
+extern uint32_t __retained_start__;
+extern uint32_t __retained_end__;
+#define RETAINED_START  ((uint32_t)&__retained_start__)
+#define RETAINED_END    ((uint32_t)&__retained_end__)
+#else
+// The location of the section is only known to the GCC linker scripts. Retain all blocks.
+#define RETAINED_START  (NRF_RAM_START)
+#define RETAINED_END    (NRF_RAM_START + (NRF_RAM_BLOCKS * RAM_BLOCK_SIZE))
+#endif
+
+
+static uint16_t snapshot_crc_compute(nrf_retained_hdr_t const * p_hdr, uint16_t size)
+{
+    return crc16_compute((uint8_t const *)(p_hdr + 1), size - sizeof(nrf_retained_hdr_t), NULL);
+}
+
+
+void nrf_retained_seal(nrf_retained_hdr_t * p_hdr, uint32_t magic, uint16_t size)
+{
+    p_hdr->size  = size;
+    p_hdr->crc16 = snapshot_crc_compute(p_hdr, size);
+    p_hdr->magic = magic;
+}
+
+
+bool nrf_retained_is_valid(nrf_retained_hdr_t const * p_hdr, uint32_t magic, uint16_t size)
+{
+    return (p_hdr->magic == magic)
+           && (p_hdr->size  == size)
+           && (p_hdr->crc16 == snapshot_crc_compute(p_hdr, size));
+}
+
+
+ret_code_t nrf_retained_ram_enable(void)
+{
+    uint32_t first;
+    uint32_t last;
+
+    if (RETAINED_END == RETAINED_START)
+    {
+        // Nothing to retain.
+        return NRF_SUCCESS;
+    }
+
+    first = (RETAINED_START - NRF_RAM_START) / RAM_BLOCK_SIZE;
+    last  = (RETAINED_END - 1 - NRF_RAM_START) / RAM_BLOCK_SIZE;
+
+    if (last >= NRF_RAM_BLOCKS)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+#ifdef NRF51
+    uint32_t ramon  = 0;
+    uint32_t ramonb = 0;
+
+    for (uint32_t block = first; block <= last; block++)
+    {
+        switch (block)
+        {
+            case 0: ramon  |= POWER_RAMON_OFFRAM0_Msk;  break;
+            case 1: ramon  |= POWER_RAMON_OFFRAM1_Msk;  break;
+            case 2: ramonb |= POWER_RAMONB_OFFRAM2_Msk; break;
+            default: ramonb |= POWER_RAMONB_OFFRAM3_Msk; break;
+        }
+    }
+
+#ifdef SOFTDEVICE_PRESENT
+    // RAMON is protected by the SoftDevice.
+    uint32_t err_code = sd_power_ramon_set(ramon);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+#else
+    NRF_POWER->RAMON |= ramon;
+#endif
+    NRF_POWER->RAMONB |= ramonb;
+#else
+    for (uint32_t block = first; block <= last; block++)
+    {
+        NRF_POWER->RAM[block].POWERSET = POWER_RAM_POWERSET_S0RETENTION_Msk
+                                       | POWER_RAM_POWERSET_S1RETENTION_Msk;
+    }
+#endif
+
+    return NRF_SUCCESS;
+}
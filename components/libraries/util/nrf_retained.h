@@ -0,0 +1,105 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup nrf_retained Retained RAM snapshots
+ * @{
+ * @ingroup app_common
+ *
+ * @brief Module for keeping state in RAM across System OFF and soft resets.
+ *
+ * @details Variables declared with @ref NRF_RETAINED are placed in the .retained section, which
+ *          the startup code neither loads nor clears. If the RAM blocks holding the section are
+ *          retained, see @ref nrf_retained_ram_enable, the variables keep their value when the
+ *          device wakes up from System OFF or is reset by software.
+ *
+ *          A module keeps a snapshot of a cache that is expensive to rebuild, for example by
+ *          scanning flash, in a structure that starts with an @ref nrf_retained_hdr_t. The
+ *          snapshot is sealed with @ref nrf_retained_seal before the device goes to System OFF,
+ *          and checked with @ref nrf_retained_is_valid after it wakes up. After a power-on reset,
+ *          the RAM content is random and the check fails, so the module rebuilds its cache as
+ *          usual.
+ *
+ * @note With the GCC toolchain, the .retained section is defined by the common linker scripts.
+ *       With Keil, the scatter file must place the .retained section in an UNINIT region.
+ */
+
+#ifndef NRF_RETAINED_H__
+#define NRF_RETAINED_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_abstraction.h"
+#include "sdk_errors.h"
+
+/**@brief Macro for placing a variable in the retained RAM section. */
+#if defined(__CC_ARM)
+#define NRF_RETAINED    __attribute__((section(".retained"), zero_init))
+#elif defined(__ICCARM__)
+#define NRF_RETAINED    __no_init
+#else
+#define NRF_RETAINED    __attribute__((section(".retained")))
+#endif
+
+/**@brief Header of a retained snapshot. */
+typedef struct
+{
+    uint32_t magic;     /**< Magic number of the snapshot, chosen by its owner. */
+    uint16_t size;      /**< Size of the snapshot, including the header. */
+    uint16_t crc16;     /**< CRC of the snapshot, excluding the header. */
+} nrf_retained_hdr_t;
+
+/**@brief Function for sealing a snapshot after its content has been written.
+ *
+ * @param[out] p_hdr  Header at the start of the snapshot.
+ * @param[in]  magic  Magic number of the snapshot. Change it when the layout of the snapshot
+ *                    changes, so that a snapshot written by another firmware is not used.
+ * @param[in]  size   Size of the snapshot, including the header.
+ */
+void nrf_retained_seal(nrf_retained_hdr_t * p_hdr, uint32_t magic, uint16_t size);
+
+/**@brief Function for checking whether a snapshot is valid.
+ *
+ * @param[in] p_hdr  Header at the start of the snapshot.
+ * @param[in] magic  Magic number of the snapshot.
+ * @param[in] size   Size of the snapshot, including the header.
+ *
+ * @retval true   If the snapshot was sealed with the same magic number and size, and its content
+ *                has not changed since.
+ * @retval false  Otherwise.
+ */
+bool nrf_retained_is_valid(nrf_retained_hdr_t const * p_hdr, uint32_t magic, uint16_t size);
+
+/**@brief Function for invalidating a snapshot, for example once it has been used or when the
+ *        state it holds changes.
+ */
+static __INLINE void nrf_retained_invalidate(nrf_retained_hdr_t * p_hdr)
+{
+    p_hdr->magic = 0;
+}
+
+/**@brief Function for retaining the RAM blocks that hold the .retained section in System OFF.
+ *
+ * @details On nRF51 devices, only RAM blocks 0 to 3 can be retained. With the GCC linker scripts,
+ *          the section follows the .bss section, so it is in one of these blocks unless the
+ *          SoftDevice and the application use more than 32 kB of RAM. With other toolchains, all
+ *          the RAM blocks are retained.
+ *
+ * @retval NRF_SUCCESS              If retention was enabled.
+ * @retval NRF_ERROR_NOT_SUPPORTED  If the section, or a part of it, is in a block that cannot be
+ *                                  retained.
+ */
+ret_code_t nrf_retained_ram_enable(void);
+
+#endif // NRF_RETAINED_H__
+
+/** @} */
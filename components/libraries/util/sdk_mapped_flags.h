@@ -37,11 +37,19 @@
  *
  */
 
-#define SDK_MAPPED_FLAGS_N_KEYS          8       /**< The number of keys to keep flags for. This is also the number of flags in a flag collection. If changing this value, you might also need change the width of the sdk_mapped_flags_t type. */
+#ifndef SDK_MAPPED_FLAGS_N_KEYS
+#define SDK_MAPPED_FLAGS_N_KEYS          8       /**< The number of keys to keep flags for. This is also the number of flags in a flag collection. The width of the sdk_mapped_flags_t type follows this value, up to 32 keys. */
+#endif
 #define SDK_MAPPED_FLAGS_N_KEYS_PER_BYTE 8       /**< The number of flags that fit in one byte. */
 #define SDK_MAPPED_FLAGS_INVALID_INDEX   0xFFFF  /**< A flag index guaranteed to be invalid. */
 
-typedef uint8_t sdk_mapped_flags_t; /**< The bitmap to hold flags. Each flag is one bit, and each bit represents the flag state associated with one key. */
+#if (SDK_MAPPED_FLAGS_N_KEYS <= 8)
+typedef uint8_t sdk_mapped_flags_t;  /**< The bitmap to hold flags. Each flag is one bit, and each bit represents the flag state associated with one key. */
+#elif (SDK_MAPPED_FLAGS_N_KEYS <= 16)
+typedef uint16_t sdk_mapped_flags_t; /**< The bitmap to hold flags. Each flag is one bit, and each bit represents the flag state associated with one key. */
+#else
+typedef uint32_t sdk_mapped_flags_t; /**< The bitmap to hold flags. Each flag is one bit, and each bit represents the flag state associated with one key. */
+#endif
 
 
 // Test whether the flag collection type is large enough to hold all the flags. If this fails,
@@ -15,14 +15,8 @@
 #include "ble_gap.h"
 #include "app_util.h"
 
-/* NFC OOB EP definitions */
-#define NFC_EP_OOB_REC_GAP_ADDR_LEN          BLE_GAP_ADDR_LEN
-#define NFC_EP_OOB_REC_OOB_DATA_LEN_SIZE     2UL
-#define NFC_EP_OOB_REC_PAYLOAD_PREFIX_LEN    (NFC_EP_OOB_REC_GAP_ADDR_LEN + \
-                                             NFC_EP_OOB_REC_OOB_DATA_LEN_SIZE)
-
 /* Record Payload Type for Bluetooth Carrier Configuration EP record */
-static const uint8_t ep_oob_rec_type_field[] =
+const uint8_t nfc_ep_oob_rec_type_field[] =
 {
     'a', 'p', 'p', 'l', 'i', 'c', 'a', 't', 'i', 'o', 'n', '/', 'v', 'n', 'd', '.',
     'b', 'l', 'u', 'e', 't', 'o', 'o', 't', 'h', '.', 'e', 'p', '.', 'o', 'o', 'b'
@@ -173,8 +167,8 @@ nfc_ndef_record_desc_t * nfc_ep_oob_rec_declare(uint8_t                        r
                                       TNF_MEDIA_TYPE,
                                       &payload_id,   // memory for possible ID value
                                       0,             // no ID by default
-                                      (ep_oob_rec_type_field),
-                                      sizeof(ep_oob_rec_type_field),
+                                      (nfc_ep_oob_rec_type_field),
+                                      NFC_EP_OOB_REC_TYPE_LENGTH,
                                       nfc_ep_oob_payload_constructor,
                                       NULL);
 
@@ -27,6 +27,24 @@
 #include "nfc_ndef_record.h"
 #include "ble_advdata.h"
 
+/* NFC OOB EP definitions */
+#define NFC_EP_OOB_REC_GAP_ADDR_LEN          BLE_GAP_ADDR_LEN
+#define NFC_EP_OOB_REC_OOB_DATA_LEN_SIZE     2UL
+#define NFC_EP_OOB_REC_PAYLOAD_PREFIX_LEN    (NFC_EP_OOB_REC_GAP_ADDR_LEN + \
+                                             NFC_EP_OOB_REC_OOB_DATA_LEN_SIZE)  ///< Size of the fields before the AD structures in the record payload.
+
+/**
+ * @brief An external reference to the type field of the Bluetooth Carrier Configuration EP
+ * record, defined in the file @c nfc_ep_oob_rec.c.
+ */
+extern const uint8_t nfc_ep_oob_rec_type_field[];
+
+/**
+ * @brief Size of the type field of the Bluetooth Carrier Configuration EP record, defined in the
+ * file @c nfc_ep_oob_rec.c.
+ */
+#define NFC_EP_OOB_REC_TYPE_LENGTH 32
+
 /** @brief Function for generating a description of an NFC NDEF Bluetooth Carrier Configuration EP record.
  *
  * This function declares and initializes a static instance of an NFC NDEF record description
@@ -15,7 +15,7 @@
 #include "ble_gap.h"
 
 /* Record Payload Type for Bluetooth Carrier Configuration LE record */
-static const uint8_t le_oob_rec_type_field[] =
+const uint8_t nfc_le_oob_rec_type_field[] =
 {
     'a', 'p', 'p', 'l', 'i', 'c', 'a', 't', 'i', 'o', 'n', '/', 'v', 'n', 'd', '.',
     'b', 'l', 'u', 'e', 't', 'o', 'o', 't', 'h', '.', 'l', 'e', '.', 'o', 'o', 'b'
@@ -103,8 +103,8 @@ nfc_ndef_record_desc_t * nfc_le_oob_rec_declare(uint8_t                        r
                                       TNF_MEDIA_TYPE,
                                       &payload_id,   // memory for possible ID value
                                       0,             // no ID by default
-                                      (le_oob_rec_type_field),
-                                      sizeof(le_oob_rec_type_field),
+                                      (nfc_le_oob_rec_type_field),
+                                      NFC_LE_OOB_REC_TYPE_LENGTH,
                                       nfc_le_oob_payload_constructor,
                                       NULL);
 
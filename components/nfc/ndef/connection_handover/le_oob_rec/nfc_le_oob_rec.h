@@ -27,6 +27,18 @@
 #include "nfc_ndef_record.h"
 #include "ble_advdata.h"
 
+/**
+ * @brief An external reference to the type field of the Bluetooth Carrier Configuration LE
+ * record, defined in the file @c nfc_le_oob_rec.c.
+ */
+extern const uint8_t nfc_le_oob_rec_type_field[];
+
+/**
+ * @brief Size of the type field of the Bluetooth Carrier Configuration LE record, defined in the
+ * file @c nfc_le_oob_rec.c.
+ */
+#define NFC_LE_OOB_REC_TYPE_LENGTH 32
+
 /** @brief Function for generating a description of an NFC NDEF Bluetooth Carrier Configuration LE Record.
  *
  * This function declares and initializes a static instance of an NFC NDEF record description
@@ -10,6 +10,7 @@
  *
  */
 
+#include <string.h>
 #include "nfc_ble_pair_msg.h"
 #include "nfc_hs_rec.h"
 #include "nfc_ac_rec.h"
@@ -381,3 +382,118 @@ ret_code_t nfc_ble_pair_default_msg_encode( nfc_ble_pair_type_t            nfc_b
 
     return err_code;
 }
+
+/** @brief Function for finding the TK value in AD structures.
+ *
+ * @param[in]   p_ad_data       Pointer to the AD structures.
+ * @param[in]   ad_len          Length of the AD structures.
+ * @param[out]  p_offset        Offset of the TK value from the start of the AD structures.
+ *
+ * @retval      NRF_SUCCESS           If the TK value was found.
+ * @retval      NRF_ERROR_NOT_FOUND   Otherwise.
+ */
+static ret_code_t ad_tk_value_find(uint8_t const * p_ad_data,
+                                   uint32_t        ad_len,
+                                   uint32_t      * p_offset)
+{
+    uint32_t offset = 0;
+
+    while (offset + ADV_AD_DATA_OFFSET <= ad_len)
+    {
+        uint8_t field_len = p_ad_data[offset];
+
+        if ((field_len == 0) || (field_len + ADV_LENGTH_FIELD_SIZE > ad_len - offset))
+        {
+            break;
+        }
+
+        if ((p_ad_data[offset + ADV_LENGTH_FIELD_SIZE] == BLE_GAP_AD_TYPE_SECURITY_MANAGER_TK_VALUE) &&
+            (field_len == ADV_AD_TYPE_FIELD_SIZE + AD_TYPE_TK_VALUE_DATA_SIZE))
+        {
+            *p_offset = offset + ADV_AD_DATA_OFFSET;
+            return NRF_SUCCESS;
+        }
+
+        offset += field_len + ADV_LENGTH_FIELD_SIZE;
+    }
+
+    return NRF_ERROR_NOT_FOUND;
+}
+ret_code_t nfc_ble_pair_msg_tk_locate( uint8_t                   const * p_buf,
+                                       uint32_t                          len,
+                                       nfc_ble_pair_msg_tk_loc_t       * p_tk_loc)
+{
+    nfc_ndef_record_loc_t record_loc;
+    uint32_t              record_index;
+    uint32_t              ad_offset;
+    uint32_t              tk_offset;
+    ret_code_t            err_code;
+
+    p_tk_loc->tk_count = 0;
+
+    for (record_index = 0; ; record_index++)
+    {
+        err_code = nfc_ndef_msg_record_locate(p_buf, len, record_index, &record_loc);
+        if (err_code == NRF_ERROR_NOT_FOUND)
+        {
+            break;
+        }
+        else if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+
+        if ((record_loc.type_length == NFC_LE_OOB_REC_TYPE_LENGTH) &&
+            (memcmp(&p_buf[record_loc.type_offset],
+                    nfc_le_oob_rec_type_field,
+                    NFC_LE_OOB_REC_TYPE_LENGTH) == 0))
+        {
+            /* LE OOB record payload consists of AD structures only */
+            ad_offset = 0;
+        }
+        else if ((record_loc.type_length == NFC_EP_OOB_REC_TYPE_LENGTH) &&
+                 (memcmp(&p_buf[record_loc.type_offset],
+                         nfc_ep_oob_rec_type_field,
+                         NFC_EP_OOB_REC_TYPE_LENGTH) == 0) &&
+                 (record_loc.payload_length >= NFC_EP_OOB_REC_PAYLOAD_PREFIX_LEN))
+        {
+            /* EP OOB record payload starts with OOB data length and device address */
+            ad_offset = NFC_EP_OOB_REC_PAYLOAD_PREFIX_LEN;
+        }
+        else
+        {
+            continue;
+        }
+
+        err_code = ad_tk_value_find(&p_buf[record_loc.payload_offset + ad_offset],
+                                    record_loc.payload_length - ad_offset,
+                                    &tk_offset);
+
+        if ((err_code == NRF_SUCCESS) && (p_tk_loc->tk_count < NFC_BLE_PAIR_MSG_TK_MAX_COUNT))
+        {
+            p_tk_loc->tk_offset[p_tk_loc->tk_count++] = record_loc.payload_offset + ad_offset +
+                                                        tk_offset;
+        }
+    }
+
+    return (p_tk_loc->tk_count != 0) ? NRF_SUCCESS : NRF_ERROR_NOT_FOUND;
+}
+
+void nfc_ble_pair_msg_tk_update( uint8_t                         * p_buf,
+                                 nfc_ble_pair_msg_tk_loc_t const * p_tk_loc,
+                                 ble_advdata_tk_value_t    const * p_tk_value)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < p_tk_loc->tk_count; i++)
+    {
+        uint8_t * p_tk = &p_buf[p_tk_loc->tk_offset[i]];
+
+        /* TK value is encoded in reverse byte order, as done by adv_data_encode */
+        for (j = 0; j < AD_TYPE_TK_VALUE_DATA_SIZE; j++)
+        {
+            p_tk[j] = p_tk_value->tk[AD_TYPE_TK_VALUE_DATA_SIZE - 1 - j];
+        }
+    }
+}
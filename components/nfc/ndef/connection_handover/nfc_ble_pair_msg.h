@@ -47,6 +47,18 @@ typedef enum
     NFC_BLE_PAIR_MSG_FULL                ///< BLE Handover Select Message.
 } nfc_ble_pair_type_t;
 
+/** @brief Maximum number of TK values in a BLE pairing message: one in each OOB record. */
+#define NFC_BLE_PAIR_MSG_TK_MAX_COUNT 2
+
+/**
+ * @brief Locations of the 'Security Manager TK' values within an encoded BLE pairing message.
+ */
+typedef struct
+{
+    uint32_t tk_offset[NFC_BLE_PAIR_MSG_TK_MAX_COUNT]; ///< Offsets of the TK values from the start of the message.
+    uint8_t  tk_count;                                 ///< Number of TK values in the message.
+} nfc_ble_pair_msg_tk_loc_t;
+
 /** @brief Function for encoding simplified LE OOB messages.
  *
  * This function encodes a simplified LE OOB message into a buffer. The payload of the LE OOB record
@@ -157,5 +169,39 @@ ret_code_t nfc_ble_pair_default_msg_encode( nfc_ble_pair_type_t            nfc_b
                                             uint8_t                *       p_buf,
                                             uint32_t               *       p_len);
 
+/** @brief Function for locating the TK values in an encoded BLE pairing message.
+ *
+ * Together with @ref nfc_ble_pair_msg_tk_update, this function allows a BLE pairing message
+ * to be encoded once, and only the TK values to be written again when a new key is generated
+ * for every pairing, instead of encoding the whole message with the SoftDevice calls it involves.
+ * The TK values are searched for in the AD structures of the LE OOB and EP OOB records of
+ * the message.
+ *
+ * @param[in]   p_buf               Pointer to the encoded message.
+ * @param[in]   len                 Length of the encoded message.
+ * @param[out]  p_tk_loc            Pointer to the locations of the TK values.
+ *
+ * @retval NRF_SUCCESS              If at least one TK value was found.
+ * @retval NRF_ERROR_NOT_FOUND      If the message does not contain any TK value, for example
+ *                                  because it was encoded for Just Works pairing.
+ * @retval NRF_ERROR_INVALID_LENGTH If the message is not correctly encoded.
+ */
+ret_code_t nfc_ble_pair_msg_tk_locate( uint8_t                   const * p_buf,
+                                       uint32_t                          len,
+                                       nfc_ble_pair_msg_tk_loc_t       * p_tk_loc);
+
+/** @brief Function for writing a new TK value into an encoded BLE pairing message.
+ *
+ * Every TK value located with @ref nfc_ble_pair_msg_tk_locate is replaced. The rest of the
+ * message is not modified, so the message buffer can be passed to the NFC library again as is.
+ *
+ * @param[in,out]   p_buf           Pointer to the encoded message.
+ * @param[in]       p_tk_loc        Pointer to the locations of the TK values in the message.
+ * @param[in]       p_tk_value      Pointer to the new TK value.
+ */
+void nfc_ble_pair_msg_tk_update( uint8_t                         * p_buf,
+                                 nfc_ble_pair_msg_tk_loc_t const * p_tk_loc,
+                                 ble_advdata_tk_value_t    const * p_tk_value);
+
 /** @} */
 #endif // NFC_BLE_PAIR_MSG_H__
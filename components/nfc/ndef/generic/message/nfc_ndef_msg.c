@@ -11,6 +11,7 @@
  */
 
 #include "nfc_ndef_msg.h"
+#include "app_util.h"
 #include "nrf.h"
 
 /**
@@ -108,3 +109,76 @@ ret_code_t nfc_ndef_msg_record_add(nfc_ndef_msg_desc_t * const    p_msg,
 }
 
 
+ret_code_t nfc_ndef_msg_record_locate(uint8_t         const * p_msg_buffer,
+                                      uint32_t                msg_len,
+                                      uint32_t                record_index,
+                                      nfc_ndef_record_loc_t * p_record_loc)
+{
+    uint32_t offset = 0;
+    uint32_t index  = 0;
+
+    while (offset < msg_len)
+    {
+        uint8_t  flags       = p_msg_buffer[offset];
+        uint32_t header_len  = 2 * sizeof(uint8_t);
+        uint32_t id_len      = 0;
+        uint32_t payload_len;
+        uint32_t type_len;
+
+        header_len += (flags & NDEF_RECORD_SR_MASK) ? NDEF_RECORD_PAYLOAD_LEN_SHORT_SIZE :
+                                                      NDEF_RECORD_PAYLOAD_LEN_LONG_SIZE;
+        header_len += (flags & NDEF_RECORD_IL_MASK) ? NDEF_RECORD_ID_LEN_SIZE : 0;
+
+        if (header_len > msg_len - offset)
+        {
+            return NRF_ERROR_INVALID_LENGTH;
+        }
+
+        type_len = p_msg_buffer[offset + 1];
+
+        if (flags & NDEF_RECORD_SR_MASK)
+        {
+            payload_len = p_msg_buffer[offset + 2];
+        }
+        else
+        {
+            payload_len = uint32_big_decode(&p_msg_buffer[offset + 2]);
+        }
+
+        if (flags & NDEF_RECORD_IL_MASK)
+        {
+            id_len = p_msg_buffer[offset + header_len - NDEF_RECORD_ID_LEN_SIZE];
+        }
+
+        offset += header_len;
+
+        /* Compared piecewise, so that a corrupted length field cannot overflow the sum. */
+        if ((type_len + id_len > msg_len - offset) ||
+            (payload_len > msg_len - offset - type_len - id_len))
+        {
+            return NRF_ERROR_INVALID_LENGTH;
+        }
+
+        if (index == record_index)
+        {
+            p_record_loc->type_offset    = offset;
+            p_record_loc->type_length    = type_len;
+            p_record_loc->payload_offset = offset + type_len + id_len;
+            p_record_loc->payload_length = payload_len;
+
+            return NRF_SUCCESS;
+        }
+
+        if (flags & NDEF_LAST_RECORD)
+        {
+            break;
+        }
+
+        offset += type_len + id_len + payload_len;
+        index++;
+    }
+
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
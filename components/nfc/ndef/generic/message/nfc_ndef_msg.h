@@ -32,6 +32,19 @@
      uint32_t                  max_record_count; ///< Number of elements in the allocated pp_record array, which defines the maximum number of records within the NDEF message.
      uint32_t                  record_count;     ///< Number of records in the NDEF message.
  } nfc_ndef_msg_desc_t;
+
+/**
+ * @brief Location of a record within an encoded NDEF message.
+ *
+ * Offsets are counted from the start of the encoded message.
+ */
+typedef struct
+{
+    uint32_t type_offset;    ///< Offset of the type field of the record.
+    uint32_t type_length;    ///< Length of the type field of the record.
+    uint32_t payload_offset; ///< Offset of the payload of the record.
+    uint32_t payload_length; ///< Length of the payload of the record.
+} nfc_ndef_record_loc_t;
  
  /**
   * @brief  Function for encoding an NDEF message.
@@ -70,6 +83,29 @@ void nfc_ndef_msg_clear( nfc_ndef_msg_desc_t * p_msg);
 ret_code_t nfc_ndef_msg_record_add( nfc_ndef_msg_desc_t    * const p_msg,
                                     nfc_ndef_record_desc_t * const p_record);
 
+/**
+ * @brief Function for locating a record within an encoded NDEF message.
+ *
+ * This function walks the record headers of a message encoded with @ref nfc_ndef_msg_encode,
+ * or received from a peer, and returns where the type and the payload of a record are placed.
+ * It allows a message to be encoded once and only the bytes of a payload field to be
+ * patched in the buffer when the field changes, instead of encoding the whole message again.
+ * Patching must not change the length of the payload. Nested messages are not entered.
+ *
+ * @param[in]  p_msg_buffer    Pointer to the encoded message.
+ * @param[in]  msg_len         Length of the encoded message.
+ * @param[in]  record_index    Index of the record in the message, from 0.
+ * @param[out] p_record_loc    Pointer to the location of the record.
+ *
+ * @retval NRF_SUCCESS              If the record was found.
+ * @retval NRF_ERROR_NOT_FOUND      If the message has no record with this index.
+ * @retval NRF_ERROR_INVALID_LENGTH If a record header is not consistent with the message length.
+ */
+ret_code_t nfc_ndef_msg_record_locate( uint8_t         const * p_msg_buffer,
+                                       uint32_t                msg_len,
+                                       uint32_t                record_index,
+                                       nfc_ndef_record_loc_t * p_record_loc);
+
                               
 /**@brief Macro for creating and initializing an NFC NDEF message descriptor.
  *
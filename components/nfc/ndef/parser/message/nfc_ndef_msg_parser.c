@@ -40,6 +40,74 @@ ret_code_t ndef_msg_parser(uint8_t  * const p_result_buf,
 }
 
 
+void ndef_msg_iterator_init(ndef_msg_iterator_t * const p_iterator,
+                            uint8_t       const * const p_nfc_data,
+                            uint32_t                    nfc_data_len)
+{
+    p_iterator->p_nfc_data    = p_nfc_data;
+    p_iterator->nfc_data_left = nfc_data_len;
+    p_iterator->record_count  = 0;
+    p_iterator->msg_end       = false;
+}
+
+
+ret_code_t ndef_msg_next_record(ndef_msg_iterator_t         * const p_iterator,
+                                nfc_ndef_record_desc_t      * const p_rec_desc,
+                                nfc_ndef_bin_payload_desc_t * const p_bin_pay_desc)
+{
+    nfc_ndef_record_location_t record_location;
+    ret_code_t                 ret_code;
+    uint32_t                   record_len;
+
+    if (p_iterator->msg_end)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    if (p_iterator->nfc_data_left == 0)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    record_len = p_iterator->nfc_data_left;
+
+    ret_code = ndef_record_parser(p_bin_pay_desc,
+                                  p_rec_desc,
+                                  &record_location,
+                                  p_iterator->p_nfc_data,
+                                  &record_len);
+
+    if (ret_code != NRF_SUCCESS)
+    {
+        return ret_code;
+    }
+
+    // verify the records location flags
+    if (p_iterator->record_count == 0)
+    {
+        if ((record_location != NDEF_FIRST_RECORD) && (record_location != NDEF_LONE_RECORD))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+    }
+    else
+    {
+        if ((record_location != NDEF_MIDDLE_RECORD) && (record_location != NDEF_LAST_RECORD))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+    }
+
+    p_iterator->p_nfc_data    += record_len;
+    p_iterator->nfc_data_left -= record_len;
+    p_iterator->record_count++;
+    p_iterator->msg_end = (record_location == NDEF_LAST_RECORD) ||
+                          (record_location == NDEF_LONE_RECORD);
+
+    return NRF_SUCCESS;
+}
+
+
 void ndef_msg_printout(nfc_ndef_msg_desc_t * const p_msg_desc)
 {
     uint32_t i;
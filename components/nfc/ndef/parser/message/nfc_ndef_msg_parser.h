@@ -30,6 +30,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "nfc_ndef_msg_parser_local.h"
 
 /**
@@ -70,6 +71,53 @@ ret_code_t ndef_msg_parser(uint8_t  * const p_result_buf,
                            uint8_t  * const p_nfc_data,
                            uint32_t * const p_nfc_data_len);
 
+/**
+ * @brief Iterator over the records of raw NDEF message data.
+ *
+ * The fields of this structure are internal to the parser and must not be modified directly.
+ */
+typedef struct
+{
+    uint8_t const * p_nfc_data;    ///< Pointer to the first byte not parsed yet.
+    uint32_t        nfc_data_left; ///< Number of bytes not parsed yet.
+    uint32_t        record_count;  ///< Number of records returned so far.
+    bool            msg_end;       ///< True if the last record of the message was returned.
+} ndef_msg_iterator_t;
+
+/**
+ * @brief Function for initializing an iterator over the records of an NDEF message.
+ *
+ * @param[out] p_iterator      Pointer to the iterator.
+ * @param[in]  p_nfc_data      Pointer to the data to be parsed. The data must stay available
+ *                             as long as the records returned by @ref ndef_msg_next_record are used.
+ * @param[in]  nfc_data_len    Size of the NFC data in the @p p_nfc_data buffer.
+ */
+void ndef_msg_iterator_init(ndef_msg_iterator_t * const p_iterator,
+                            uint8_t       const * const p_nfc_data,
+                            uint32_t                    nfc_data_len);
+
+/**
+ * @brief Function for parsing the next record of an NDEF message.
+ *
+ * Unlike @ref ndef_msg_parser, this function does not need memory that grows with the number of
+ * records: the descriptors are provided by the caller and are overwritten on every call. The type,
+ * ID, and payload pointers of the record descriptor point into the parsed data, which is not copied.
+ * The parsing can be stopped as soon as the record of interest is found.
+ *
+ * @param[in,out] p_iterator      Pointer to the iterator.
+ * @param[out]    p_rec_desc      Pointer to the record descriptor that will be filled with parsed data.
+ * @param[out]    p_bin_pay_desc  Pointer to the binary payload descriptor that will be filled and
+ *                                referenced by the record descriptor.
+ *
+ * @retval NRF_SUCCESS               If a record was parsed.
+ * @retval NRF_ERROR_NOT_FOUND       If the last record of the message was already returned.
+ * @retval NRF_ERROR_INVALID_LENGTH  If the expected record length is bigger than the amount of the provided input data.
+ * @retval NRF_ERROR_INVALID_DATA    If the message is not a valid NDEF message.
+ */
+ret_code_t ndef_msg_next_record(ndef_msg_iterator_t         * const p_iterator,
+                                nfc_ndef_record_desc_t      * const p_rec_desc,
+                                nfc_ndef_bin_payload_desc_t * const p_bin_pay_desc);
+
 /**
  * @brief Function for printing the parsed contents of an NDEF message.
  *
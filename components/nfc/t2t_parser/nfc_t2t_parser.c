@@ -533,6 +533,104 @@ static ret_code_t type_2_tag_tlv_parse(type_2_tag_t * p_type_2_tag,
 }
 
 
+/**
+ * @brief Function for checking if a field of a TLV block was already read from the tag.
+ *
+ * @param[in]     p_type_2_tag  Pointer to the structure that contains the data area size.
+ * @param[in]     raw_data_len  Number of bytes of raw data read from the tag so far.
+ * @param[in]     field_end     Offset of the first byte after the field to check.
+ *
+ * @retval        NRF_SUCCESS               If the field was read.
+ * @retval        NRF_ERROR_INVALID_LENGTH  If more data must be read from the tag.
+ * @retval        NRF_ERROR_INVALID_DATA    If the field exceeds the data area specified in the
+ *                                          Capability Container.
+ *
+ */
+static ret_code_t type_2_tag_field_available_check(type_2_tag_t * p_type_2_tag,
+                                                   uint16_t       raw_data_len,
+                                                   uint32_t       field_end)
+{
+    if (field_end > (uint32_t)(p_type_2_tag->cc.data_area_size + T2T_FIRST_DATA_BLOCK_OFFSET))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    if (field_end > raw_data_len)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**
+ * @brief Function for checking if a whole TLV block was already read from the tag.
+ *
+ * The tag and length fields are checked one after the other, so that no byte is used before
+ * it was read.
+ *
+ * @param[in]     p_type_2_tag  Pointer to the structure that contains the data area size.
+ * @param[in]     p_raw_data    Pointer to the buffer with raw data from the tag.
+ * @param[in]     raw_data_len  Number of bytes of raw data read from the tag so far.
+ * @param[in]     offset        Offset of the TLV block to check.
+ *
+ * @retval        NRF_SUCCESS  If the TLV block was read. Otherwise, an error code is returned
+ *                             by @ref type_2_tag_field_available_check.
+ *
+ */
+static ret_code_t type_2_tag_tlv_available_check(type_2_tag_t * p_type_2_tag,
+                                                 uint8_t      * p_raw_data,
+                                                 uint16_t       raw_data_len,
+                                                 uint16_t       offset)
+{
+    ret_code_t err_code;
+    uint32_t   field_end = offset + TLV_T_LENGTH;
+    uint16_t   length;
+
+    err_code = type_2_tag_field_available_check(p_type_2_tag, raw_data_len, field_end);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    if ((p_raw_data[offset] == TLV_NULL) || (p_raw_data[offset] == TLV_TERMINATOR))
+    {
+        return NRF_SUCCESS;
+    }
+
+    err_code = type_2_tag_field_available_check(p_type_2_tag,
+                                                raw_data_len,
+                                                field_end + TLV_L_SHORT_LENGTH);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    length = p_raw_data[field_end];
+
+    if (length == TLV_L_FORMAT_FLAG)
+    {
+        err_code = type_2_tag_field_available_check(p_type_2_tag,
+                                                    raw_data_len,
+                                                    field_end + TLV_L_LONG_LENGTH);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+
+        length     = uint16_big_decode(&p_raw_data[field_end + 1]);
+        field_end += TLV_L_LONG_LENGTH;
+    }
+    else
+    {
+        field_end += TLV_L_SHORT_LENGTH;
+    }
+
+    return type_2_tag_field_available_check(p_type_2_tag, raw_data_len, field_end + length);
+}
+
+
 void type_2_tag_clear(type_2_tag_t * p_type_2_tag)
 {
     p_type_2_tag->tlv_count = 0;
@@ -541,7 +639,7 @@ void type_2_tag_clear(type_2_tag_t * p_type_2_tag)
 }
 
 
-ret_code_t type_2_tag_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data)
+ret_code_t type_2_tag_header_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data)
 {
     ret_code_t err_code;
 
@@ -564,6 +662,20 @@ ret_code_t type_2_tag_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data)
         return NRF_ERROR_NOT_SUPPORTED;
     }
 
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t type_2_tag_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data)
+{
+    ret_code_t err_code;
+
+    err_code = type_2_tag_header_parse(p_type_2_tag, p_raw_data);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
     uint16_t offset = T2T_FIRST_DATA_BLOCK_OFFSET;
 
     while(offset > 0)
@@ -586,6 +698,54 @@ ret_code_t type_2_tag_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data)
 }
 
 
+ret_code_t type_2_tag_tlv_next(type_2_tag_t * p_type_2_tag,
+                               uint8_t      * p_raw_data,
+                               uint16_t       raw_data_len,
+                               uint16_t     * p_offset,
+                               tlv_block_t  * p_tlv_block)
+{
+    ret_code_t err_code;
+    uint16_t   offset = *p_offset;
+
+    while (offset > 0)
+    {
+        // Check if end of tag is reached (no terminator block was present).
+        if (type_2_tag_is_end_reached(p_type_2_tag, offset))
+        {
+            break;
+        }
+
+        err_code = type_2_tag_tlv_available_check(p_type_2_tag, p_raw_data, raw_data_len, offset);
+        if (err_code != NRF_SUCCESS)
+        {
+            // Keep the NULL blocks skipped so far.
+            *p_offset = offset;
+            return err_code;
+        }
+
+        err_code = type_2_tag_tlv_block_extract(p_type_2_tag, p_raw_data, &offset, p_tlv_block);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+
+        if (!tlv_block_is_data_length_correct(p_tlv_block))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+
+        if ((p_tlv_block->tag != TLV_NULL) && (p_tlv_block->tag != TLV_TERMINATOR))
+        {
+            *p_offset = offset;
+            return NRF_SUCCESS;
+        }
+    }
+
+    *p_offset = 0;
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
 void type_2_tag_printout(type_2_tag_t * p_type_2_tag)
 {
     uint32_t i, j;
@@ -144,6 +144,55 @@ void type_2_tag_clear(type_2_tag_t * p_type_2_tag);
  */
 ret_code_t type_2_tag_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data);
 
+/**
+ * @brief Function for parsing the header of a Type 2 Tag.
+ *
+ * This function parses the internal bytes, the lock bytes, and the Capability Container of a
+ * Type 2 Tag, which are stored in the first @ref T2T_FIRST_DATA_BLOCK_OFFSET bytes of the tag.
+ * The TLV blocks are not parsed: they can then be read one at a time with
+ * @ref type_2_tag_tlv_next, and the TLV block array of the @ref type_2_tag_t structure is
+ * not used.
+ *
+ * @param[out] p_type_2_tag     Pointer to the structure that will be filled with parsed data.
+ * @param[in]  p_raw_data       Pointer to the buffer with raw data from the tag.
+ *
+ * @retval     NRF_SUCCESS              If the header was parsed successfully.
+ * @retval     NRF_ERROR_INVALID_DATA   If the tag does not contain NFC Forum defined data.
+ * @retval     NRF_ERROR_NOT_SUPPORTED  If the version of the tag is not supported.
+ *
+ */
+ret_code_t type_2_tag_header_parse(type_2_tag_t * p_type_2_tag, uint8_t * p_raw_data);
+
+/**
+ * @brief Function for parsing the next TLV block of a Type 2 Tag.
+ *
+ * This function returns the TLV block found at the offset pointed by @p p_offset, skipping
+ * NULL blocks, without copying it. Parsing can start before the whole data area was read from
+ * the tag: if the block is not yet fully contained in the first @p raw_data_len bytes,
+ * the function returns NRF_ERROR_INVALID_LENGTH and can be called again with the same offset when
+ * more pages were read. Parsing can be stopped as soon as the block of interest is found.
+ *
+ * @param[in]     p_type_2_tag  Pointer to the structure filled by @ref type_2_tag_header_parse.
+ * @param[in]     p_raw_data    Pointer to the buffer with raw data from the tag.
+ * @param[in]     raw_data_len  Number of bytes of raw data read from the tag so far.
+ * @param[in,out] p_offset      As input: offset of the TLV block to parse, which must be set to
+ *                              @ref T2T_FIRST_DATA_BLOCK_OFFSET for the first block. As output:
+ *                              offset of the next TLV block, 0 if there are no more blocks.
+ * @param[out]    p_tlv_block   Pointer to the structure that will be filled with the TLV block.
+ *                              Its value field points into @p p_raw_data.
+ *
+ * @retval NRF_SUCCESS               If a TLV block was parsed.
+ * @retval NRF_ERROR_NOT_FOUND       If the terminator block or the end of the data area was reached.
+ * @retval NRF_ERROR_INVALID_LENGTH  If more data must be read from the tag to parse the block.
+ * @retval NRF_ERROR_INVALID_DATA    If the block exceeds the data area or has incorrect format.
+ *
+ */
+ret_code_t type_2_tag_tlv_next(type_2_tag_t * p_type_2_tag,
+                               uint8_t      * p_raw_data,
+                               uint16_t       raw_data_len,
+                               uint16_t     * p_offset,
+                               tlv_block_t  * p_tlv_block);
+
 /**
  * @brief Function for printing parsed contents of the Type 2 Tag.
  *
@@ -30,6 +30,9 @@
 #define RX_WAIT_FOR_ACK_TIMEOUT_US_250KBPS      (250)       /**< 250KBit RX RX wait for ack timout value. */
 #define RX_WAIT_FOR_ACK_TIMEOUT_US_1MBPS_BLE    (64)        /**< 1MBit RX wait for ack timeout (combined with BLE). */
 
+#define RADIO_RAMP_UP_TIME_US                   (130)       /**< Radio ramp-up time, from TXEN or RXEN to READY. */
+#define RADIO_FAST_RAMP_UP_TIME_US              (40)        /**< Radio ramp-up time with the fast ramp-up of nRF52. */
+
 // Interrupt flags
 #define     NRF_ESB_INT_TX_SUCCESS_MSK          0x01        /**< Interrupt mask value for TX success. */
 #define     NRF_ESB_INT_TX_FAILED_MSK           0x02        /**< Interrupt mask value for TX failed*/
@@ -69,6 +72,19 @@ do                                                          \
 }while(0)
 
 
+#define ACK_QUEUE_END       0xFF    /**< Index marking the end of an ACK payload queue. */
+
+#if NRF_ESB_STATS_ENABLED
+#define STATS_INC(pipe, field)      (m_stats.pipes[(pipe)].field++)
+#define STATS_ADD(pipe, field, n)   (m_stats.pipes[(pipe)].field += (n))
+#else
+#define STATS_INC(pipe, field)
+#define STATS_ADD(pipe, field, n)
+#endif
+
+#define RX_PACKET_BUFFER()  (m_rx_fifo.p_slot[m_rx_fifo.entry_point]->packet)   /**< Buffer the radio receives the next packet to. */
+
+
 //Structure holding pipe info PID and CRC and ack payload.
 typedef struct
 {
@@ -78,20 +94,46 @@ typedef struct
 } pipe_info_t;
 
 
+// Entry of the TX and RX queues. The radio transmits from and receives to the packet buffer of the
+// entry directly, so a payload is only copied when it is written or read by the application.
+typedef struct
+{
+    uint8_t     packet[NRF_ESB_MAX_PAYLOAD_LENGTH + 2];     /**< Radio packet: S0 or length field, S1 field and payload data. */
+    uint8_t     length;                                     /**< Length of the payload data. */
+    uint8_t     pipe;                                       /**< Pipe used for this payload. */
+    int8_t      rssi;                                       /**< RSSI for received packet. */
+    uint8_t     noack;                                      /**< Flag indicating that this packet will not be acknowledged. */
+    uint8_t     pid;                                        /**< PID assigned during communication. */
+    uint8_t     next;                                       /**< Index of the next entry in the same ACK payload queue, PRX mode only. */
+} nrf_esb_fifo_slot_t;
+
+
 // First in first out queue of payloads to be transmitted.
 typedef struct
 {
-    nrf_esb_payload_t * p_payload[NRF_ESB_TX_FIFO_SIZE];    /**< Pointer to the actual queue. */
+    nrf_esb_fifo_slot_t * p_slot[NRF_ESB_TX_FIFO_SIZE];     /**< Pointer to the actual queue. */
     uint32_t            entry_point;                        /**< Current start of queue. */
     uint32_t            exit_point;                         /**< Current end of queue. */
     uint32_t            count;                              /**< Current number of elements in the queue. */
 } nrf_esb_payload_tx_fifo_t;
 
 
-// First in first out queue of received payloads.
+// Queue of the ACK payloads of one pipe in PRX mode. The queues are linked lists of the entries of
+// m_tx_fifo_slot, so the ACK payloads of a pipe are not held back by the ones queued for others.
 typedef struct
 {
-    nrf_esb_payload_t * p_payload[NRF_ESB_RX_FIFO_SIZE];    /**< Pointer to the actual queue. */
+    uint8_t     head;                                       /**< Index of the first entry, the ACK payload sent on the next packet. */
+    uint8_t     tail;                                       /**< Index of the last entry. */
+    uint8_t     count;                                      /**< Current number of elements in the queue. */
+    uint8_t     quota;                                      /**< Maximum number of elements in the queue. */
+} nrf_esb_ack_queue_t;
+
+
+// First in first out queue of received payloads. The queue has one entry more than it can hold
+// payloads, the entry at entry_point is always free and is where the radio receives to.
+typedef struct
+{
+    nrf_esb_fifo_slot_t * p_slot[NRF_ESB_RX_FIFO_SIZE + 1]; /**< Pointer to the actual queue. */
     uint32_t            entry_point;                        /**< Current start of queue. */
     uint32_t            exit_point;                         /**< Current end of queue. */
     uint32_t            count;                              /**< Current number of elements in the queue. */
@@ -101,7 +143,7 @@ typedef struct
 // Module state
 static bool                         m_esb_initialized           = false;
 static nrf_esb_mainstate_t          m_nrf_esb_mainstate         = NRF_ESB_STATE_IDLE;
-static nrf_esb_payload_t          * mp_current_payload;
+static nrf_esb_fifo_slot_t        * mp_current_payload;
 
 static nrf_esb_event_handler_t      m_event_handler;
 
@@ -112,16 +154,19 @@ static nrf_esb_address_t            m_esb_addr = NRF_ESB_ADDR_DEFAULT;
 static nrf_esb_config_t             m_config_local;
 
 // TX FIFO
-static nrf_esb_payload_t            m_tx_fifo_payload[NRF_ESB_TX_FIFO_SIZE];
+static nrf_esb_fifo_slot_t          m_tx_fifo_slot[NRF_ESB_TX_FIFO_SIZE];
 static nrf_esb_payload_tx_fifo_t    m_tx_fifo;
 
+// ACK payload queues, sharing the entries of the TX FIFO
+static nrf_esb_ack_queue_t          m_ack_queue[NRF_ESB_PIPE_COUNT];
+static uint8_t                      m_ack_free_head;
+
 // RX FIFO
-static nrf_esb_payload_t            m_rx_fifo_payload[NRF_ESB_RX_FIFO_SIZE];
+static nrf_esb_fifo_slot_t          m_rx_fifo_slot[NRF_ESB_RX_FIFO_SIZE + 1];
 static nrf_esb_payload_rx_fifo_t    m_rx_fifo;
 
-// Payload buffers
-static  uint8_t                     m_tx_payload_buffer[NRF_ESB_MAX_PAYLOAD_LENGTH + 2];
-static  uint8_t                     m_rx_payload_buffer[NRF_ESB_MAX_PAYLOAD_LENGTH + 2];
+// Buffer for acknowledgements without payload
+static  uint8_t                     m_ack_buffer[2];
 
 // Run time variables
 static volatile uint32_t            m_interrupt_flags = 0;
@@ -130,6 +175,31 @@ static pipe_info_t                  m_rx_pipe_info[NRF_ESB_PIPE_COUNT];
 static volatile uint32_t            m_retransmits_remaining;
 static volatile uint32_t            m_last_tx_attempts;
 static volatile uint32_t            m_wait_for_ack_timeout_us;
+static uint32_t                     m_ramp_up_time_us = RADIO_RAMP_UP_TIME_US;
+static uint32_t                     m_rand_state = 1;
+
+#if NRF_ESB_STATS_ENABLED
+// Link statistics
+static nrf_esb_stats_t              m_stats;
+static uint32_t                     m_tx_latency_us;        /**< Latency of the current transaction, up to the last attempt. */
+static uint32_t                     m_tx_retransmit_wait_us;/**< Time from the RX ramp-up to the next attempt. */
+#endif
+
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+// Channel hopping
+typedef struct
+{
+    nrf_esb_channel_stats_t stats;              /**< Statistics of the channel. */
+    uint8_t                 win_attempts;       /**< Transmissions in the current packet error rate window. */
+    uint8_t                 win_failures;       /**< Failed transmissions in the current packet error rate window. */
+} channel_info_t;
+
+static nrf_esb_channel_hopping_config_t m_hop_config;
+static channel_info_t               m_channels[NRF_ESB_CHANNEL_TABLE_MAX_SIZE];
+static uint8_t                      m_channel_index;
+static uint8_t                      m_channel_failures;
+static volatile bool                m_rx_activity;
+#endif
 
 // These function pointers are changed dynamically, depending on protocol configuration and state.
 static void (*on_radio_disabled)(void) = 0;
@@ -173,6 +243,166 @@ static uint32_t addr_conv(uint8_t const* p_addr)
 }
 
 
+// Xorshift pseudo random generator, for the retransmit delays.
+static uint32_t rand_next(void)
+{
+    m_rand_state ^= m_rand_state << 13;
+    m_rand_state ^= m_rand_state >> 17;
+    m_rand_state ^= m_rand_state << 5;
+    return m_rand_state;
+}
+
+
+// Function to compute the delay before the next retransmission, attempt being 1 for the first one.
+static uint32_t retransmit_delay_get(uint32_t attempt)
+{
+    uint32_t delay = m_config_local.retransmit_delay;
+    uint32_t window;
+
+    switch (m_config_local.retransmit_backoff)
+    {
+        case NRF_ESB_RETRANSMIT_BACKOFF_RANDOM:
+            delay += rand_next() % (m_config_local.retransmit_delay + 1);
+            break;
+
+        case NRF_ESB_RETRANSMIT_BACKOFF_EXPONENTIAL:
+            window = (uint32_t)m_config_local.retransmit_delay << MIN(attempt - 1, 4);
+            delay += rand_next() % (window + 1);
+            break;
+
+        default:
+            break;
+    }
+
+    // The system timer is 16-bit
+    return MIN(delay, 0xFFFF);
+}
+
+
+#if NRF_ESB_STATS_ENABLED
+// Function to compute the time on air of a packet, in microseconds.
+static uint32_t tx_air_time_us(uint32_t length)
+{
+    uint32_t bits;
+
+    // Preamble, address, payload and CRC
+    bits = 8 * (1 + m_esb_addr.addr_length + length + m_config_local.crc);
+
+    // Length and S1 fields
+    if (m_config_local.protocol == NRF_ESB_PROTOCOL_ESB_DPL)
+    {
+        bits += (NRF_ESB_MAX_PAYLOAD_LENGTH <= 32) ? (6 + 3) : (8 + 3);
+    }
+    else
+    {
+        bits += 8 + 1;
+    }
+
+    switch (m_config_local.bitrate)
+    {
+        case NRF_ESB_BITRATE_2MBPS:
+            return (bits + 1) / 2;
+
+        case NRF_ESB_BITRATE_250KBPS:
+            return bits * 4;
+
+        default:
+            return bits;
+    }
+}
+
+
+static void latency_record(uint32_t latency_us)
+{
+    uint32_t bin = MIN(latency_us / NRF_ESB_LATENCY_BIN_WIDTH_US, NRF_ESB_LATENCY_HISTOGRAM_BINS - 1);
+
+    m_stats.latency_histogram[bin]++;
+    m_stats.latency_max_us = MAX(m_stats.latency_max_us, latency_us);
+}
+#endif // NRF_ESB_STATS_ENABLED
+
+
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+static void channel_set(uint8_t index)
+{
+    m_channel_index         = index;
+    m_channel_failures      = 0;
+    m_esb_addr.rf_channel   = m_channels[index].stats.channel;
+    NRF_RADIO->FREQUENCY    = m_esb_addr.rf_channel;
+}
+
+
+// Function to move to the next channel of the table which is not skipped.
+static void channel_hop(void)
+{
+    uint8_t count = m_hop_config.channels_count;
+    uint8_t index = m_channel_index;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (m_channels[i].stats.blocked_hops > 0)
+        {
+            m_channels[i].stats.blocked_hops--;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (++index >= count)
+        {
+            index = 0;
+        }
+        if (m_channels[index].stats.blocked_hops == 0)
+        {
+            break;
+        }
+    }
+
+    // If all the channels are skipped, the next one is used anyway.
+    channel_set(index);
+}
+
+
+// Function to update the statistics of the current channel after a transmission in PTX mode.
+static void channel_tx_result(bool acked)
+{
+    channel_info_t * p_info = &m_channels[m_channel_index];
+
+    p_info->stats.tx_attempts++;
+    if (acked)
+    {
+        p_info->stats.tx_acked++;
+    }
+
+    if (m_hop_config.block_window > 0)
+    {
+        p_info->win_attempts++;
+        p_info->win_failures += acked ? 0 : 1;
+        if (p_info->win_attempts >= m_hop_config.block_window)
+        {
+            if ((uint32_t)p_info->win_failures * 100 >=
+                (uint32_t)m_hop_config.per_block_threshold * p_info->win_attempts)
+            {
+                p_info->stats.blocked_hops = NRF_ESB_CHANNEL_BLOCK_HOPS;
+            }
+            p_info->win_attempts = 0;
+            p_info->win_failures = 0;
+        }
+    }
+
+    if (acked)
+    {
+        m_channel_failures = 0;
+    }
+    else if (++m_channel_failures >= m_hop_config.tx_attempts_per_channel ||
+             p_info->stats.blocked_hops > 0)
+    {
+        channel_hop();
+    }
+}
+#endif // NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+
+
 static void update_rf_payload_format_esb_dpl(uint32_t payload_length)
 {
 #if (NRF_ESB_MAX_PAYLOAD_LENGTH <= 32)
@@ -299,8 +529,32 @@ static void update_radio_crc()
 }
 
 
+static void update_radio_ramp_up()
+{
+#ifdef NRF52
+    // The acknowledgement timeouts are counted from READY, and both ends use the same ramp-up time
+    // for the turnaround, so only the retransmit timing depends on the ramp-up time.
+    if (m_config_local.fast_ramp_up)
+    {
+        NRF_RADIO->MODECNF0 = (NRF_RADIO->MODECNF0 & ~RADIO_MODECNF0_RU_Msk) |
+                              (RADIO_MODECNF0_RU_Fast << RADIO_MODECNF0_RU_Pos);
+        m_ramp_up_time_us = RADIO_FAST_RAMP_UP_TIME_US;
+    }
+    else
+    {
+        NRF_RADIO->MODECNF0 = (NRF_RADIO->MODECNF0 & ~RADIO_MODECNF0_RU_Msk) |
+                              (RADIO_MODECNF0_RU_Default << RADIO_MODECNF0_RU_Pos);
+        m_ramp_up_time_us = RADIO_RAMP_UP_TIME_US;
+    }
+#else
+    m_ramp_up_time_us = RADIO_RAMP_UP_TIME_US;
+#endif
+}
+
+
 static void update_radio_parameters()
 {
+    update_radio_ramp_up();
     update_radio_tx_power();
     update_radio_bitrate();
     update_radio_protocol();
@@ -309,12 +563,31 @@ static void update_radio_parameters()
 }
 
 
+static void reset_ack_queues()
+{
+    for (int i = 0; i < NRF_ESB_PIPE_COUNT; i++)
+    {
+        m_ack_queue[i].head  = ACK_QUEUE_END;
+        m_ack_queue[i].tail  = ACK_QUEUE_END;
+        m_ack_queue[i].count = 0;
+    }
+
+    for (int i = 0; i < NRF_ESB_TX_FIFO_SIZE; i++)
+    {
+        m_tx_fifo_slot[i].next = (i + 1 < NRF_ESB_TX_FIFO_SIZE) ? (i + 1) : ACK_QUEUE_END;
+    }
+    m_ack_free_head = 0;
+}
+
+
 static void reset_fifos()
 {
     m_tx_fifo.entry_point = 0;
     m_tx_fifo.exit_point  = 0;
     m_tx_fifo.count       = 0;
 
+    reset_ack_queues();
+
     m_rx_fifo.entry_point = 0;
     m_rx_fifo.exit_point  = 0;
     m_rx_fifo.count       = 0;
@@ -327,13 +600,41 @@ static void initialize_fifos()
 
     for (int i = 0; i < NRF_ESB_TX_FIFO_SIZE; i++)
     {
-        m_tx_fifo.p_payload[i] = &m_tx_fifo_payload[i];
+        m_tx_fifo.p_slot[i] = &m_tx_fifo_slot[i];
+    }
+
+    for (int i = 0; i < NRF_ESB_RX_FIFO_SIZE + 1; i++)
+    {
+        m_rx_fifo.p_slot[i] = &m_rx_fifo_slot[i];
+    }
+
+    for (int i = 0; i < NRF_ESB_PIPE_COUNT; i++)
+    {
+        m_ack_queue[i].quota = NRF_ESB_ACK_PAYLOAD_QUOTA;
     }
+}
+
+
+/** @brief  Function to remove the first ACK payload of a pipe and return its entry to the free list.
+ *
+ *  @note Must be called from the radio interrupt or with the radio interrupt disabled.
+ *
+ *  @param  p_queue Queue of the pipe, must not be empty.
+ */
+static void ack_queue_remove_first(nrf_esb_ack_queue_t * p_queue)
+{
+    uint8_t index = p_queue->head;
 
-    for (int i = 0; i < NRF_ESB_RX_FIFO_SIZE; i++)
+    p_queue->head = m_tx_fifo_slot[index].next;
+    if (p_queue->head == ACK_QUEUE_END)
     {
-        m_rx_fifo.p_payload[i] = &m_rx_fifo_payload[i];
+        p_queue->tail = ACK_QUEUE_END;
     }
+    p_queue->count--;
+
+    m_tx_fifo_slot[index].next = m_ack_free_head;
+    m_ack_free_head = index;
+    m_tx_fifo.count--;
 }
 
 
@@ -353,11 +654,11 @@ static void tx_fifo_remove_last()
     }
 }
 
-/** @brief  Function to push the content of the rx_buffer to the RX FIFO.
+/** @brief  Function to push the received packet to the RX FIFO.
  *
- *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for receiving packets.
- *  After receiving a packet the module will call this function to copy the received data to
- *  the RX FIFO.
+ *  The module points the register NRF_RADIO->PACKETPTR to the free entry of the RX FIFO for
+ *  receiving packets. After receiving a packet the module will call this function to add the
+ *  entry to the queue, which makes the next entry the one the radio receives to.
  *
  *  @param  pipe Pipe number to set for the packet.
  *  @param  pid  Packet ID.
@@ -367,34 +668,33 @@ static void tx_fifo_remove_last()
  */
 static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
 {
+    nrf_esb_fifo_slot_t * p_slot = m_rx_fifo.p_slot[m_rx_fifo.entry_point];
+
     if (m_rx_fifo.count < NRF_ESB_RX_FIFO_SIZE)
     {
         if (m_config_local.protocol == NRF_ESB_PROTOCOL_ESB_DPL)
         {
-            if (m_rx_payload_buffer[0] > NRF_ESB_MAX_PAYLOAD_LENGTH)
+            if (p_slot->packet[0] > NRF_ESB_MAX_PAYLOAD_LENGTH)
             {
                 return false;
             }
 
-            m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length = m_rx_payload_buffer[0];
+            p_slot->length = p_slot->packet[0];
         }
         else if (m_config_local.mode == NRF_ESB_MODE_PTX)
         {
             // Received packet is an acknowledgement
-            m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length = 0;
+            p_slot->length = 0;
         }
         else
         {
-            m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length = m_config_local.payload_length;
+            p_slot->length = m_config_local.payload_length;
         }
 
-        memcpy(m_rx_fifo.p_payload[m_rx_fifo.entry_point]->data, &m_rx_payload_buffer[2],
-               m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length);
-
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->pipe = pipe;
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->rssi = NRF_RADIO->RSSISAMPLE;
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->pid = pid;
-        if (++m_rx_fifo.entry_point >= NRF_ESB_RX_FIFO_SIZE)
+        p_slot->pipe = pipe;
+        p_slot->rssi = NRF_RADIO->RSSISAMPLE;
+        p_slot->pid = pid;
+        if (++m_rx_fifo.entry_point >= NRF_ESB_RX_FIFO_SIZE + 1)
         {
             m_rx_fifo.entry_point = 0;
         }
@@ -437,8 +737,11 @@ static void start_tx_transaction()
     bool ack;
 
     m_last_tx_attempts = 1;
+#if NRF_ESB_STATS_ENABLED
+    m_tx_latency_us = 0;
+#endif
     // Prepare the payload
-    mp_current_payload = m_tx_fifo.p_payload[m_tx_fifo.exit_point];
+    mp_current_payload = m_tx_fifo.p_slot[m_tx_fifo.exit_point];
 
     // Handling ack if noack is set to false or if selctive auto ack is turned turned off
     ack = !mp_current_payload->noack || !m_config_local.selective_auto_ack;
@@ -447,9 +750,8 @@ static void start_tx_transaction()
     {
         case NRF_ESB_PROTOCOL_ESB:
             update_rf_payload_format(mp_current_payload->length);
-            m_tx_payload_buffer[0] = mp_current_payload->pid;
-            m_tx_payload_buffer[1] = 0;
-            memcpy(&m_tx_payload_buffer[2], mp_current_payload->data, mp_current_payload->length);
+            mp_current_payload->packet[0] = mp_current_payload->pid;
+            mp_current_payload->packet[1] = 0;
 
             NRF_RADIO->SHORTS   = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
             NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk | RADIO_INTENSET_READY_Msk;
@@ -461,10 +763,9 @@ static void start_tx_transaction()
             break;
 
         case NRF_ESB_PROTOCOL_ESB_DPL:
-            m_tx_payload_buffer[0] = mp_current_payload->length;
-            m_tx_payload_buffer[1] = mp_current_payload->pid << 1;
-            m_tx_payload_buffer[1] |= ack ? 0x00 : 0x01;
-            memcpy(&m_tx_payload_buffer[2], mp_current_payload->data, mp_current_payload->length);
+            mp_current_payload->packet[0] = mp_current_payload->length;
+            mp_current_payload->packet[1] = mp_current_payload->pid << 1;
+            mp_current_payload->packet[1] |= ack ? 0x00 : 0x01;
 
             if (ack)
             {
@@ -494,7 +795,7 @@ static void start_tx_transaction()
     NRF_RADIO->RXADDRESSES  = 1 << mp_current_payload->pipe;
 
     NRF_RADIO->FREQUENCY    = m_esb_addr.rf_channel;
-    NRF_RADIO->PACKETPTR    = (uint32_t)m_tx_payload_buffer;
+    NRF_RADIO->PACKETPTR    = (uint32_t)mp_current_payload->packet;
 
     NVIC_ClearPendingIRQ(RADIO_IRQn);
     NVIC_EnableIRQ(RADIO_IRQn);
@@ -549,6 +850,7 @@ void RADIO_IRQHandler()
 
 static void on_radio_disabled_tx_noack()
 {
+    STATS_INC(mp_current_payload->pipe, tx_success);
     m_interrupt_flags |= NRF_ESB_INT_TX_SUCCESS_MSK;
     tx_fifo_remove_last();
 
@@ -575,7 +877,13 @@ static void on_radio_disabled_tx()
     // and that it will disable the radio automatically if no packet is
     // received by the time defined in m_wait_for_ack_timeout_us
     NRF_ESB_SYS_TIMER->CC[0]    = m_wait_for_ack_timeout_us;
-    NRF_ESB_SYS_TIMER->CC[1]    = m_config_local.retransmit_delay - 130;
+    NRF_ESB_SYS_TIMER->CC[1]    = retransmit_delay_get(m_config_local.retransmit_count -
+                                                       m_retransmits_remaining + 1) - m_ramp_up_time_us;
+#if NRF_ESB_STATS_ENABLED
+    // TX ramp-up, packet and RX ramp-up, up to the start of the system timer
+    m_tx_latency_us        += 2 * m_ramp_up_time_us + tx_air_time_us(mp_current_payload->length);
+    m_tx_retransmit_wait_us = NRF_ESB_SYS_TIMER->CC[1];
+#endif
     NRF_ESB_SYS_TIMER->TASKS_CLEAR = 1;
     NRF_ESB_SYS_TIMER->EVENTS_COMPARE[0] = 0;
     NRF_ESB_SYS_TIMER->EVENTS_COMPARE[1] = 0;
@@ -591,7 +899,7 @@ static void on_radio_disabled_tx()
         update_rf_payload_format(0);
     }
 
-    NRF_RADIO->PACKETPTR        = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR        = (uint32_t)RX_PACKET_BUFFER();
     on_radio_disabled           = on_radio_disabled_tx_wait_for_ack;
     m_nrf_esb_mainstate         = NRF_ESB_STATE_PTX_RX_ACK;
 }
@@ -609,19 +917,39 @@ static void on_radio_disabled_tx_wait_for_ack()
     // If the radio has received a packet and the CRC status is OK
     if (NRF_RADIO->EVENTS_END && NRF_RADIO->CRCSTATUS != 0)
     {
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+        if (m_hop_config.channels_count > 0)
+        {
+            m_channels[m_channel_index].stats.rx_packets++;
+            channel_tx_result(true);
+        }
+#endif
         NRF_ESB_SYS_TIMER->TASKS_STOP = 1;
         NRF_PPI->CHENCLR = (1 << NRF_ESB_PPI_TX_START);
         m_interrupt_flags |= NRF_ESB_INT_TX_SUCCESS_MSK;
         m_last_tx_attempts = m_config_local.retransmit_count - m_retransmits_remaining + 1;
 
+#if NRF_ESB_STATS_ENABLED
+        // The system timer was stopped by the address of the acknowledgement.
+        NRF_ESB_SYS_TIMER->TASKS_CAPTURE[3] = 1;
+        latency_record(m_tx_latency_us + NRF_ESB_SYS_TIMER->CC[3]);
+#endif
+        STATS_INC(mp_current_payload->pipe, tx_success);
+        STATS_ADD(mp_current_payload->pipe, tx_retransmits, m_last_tx_attempts - 1);
+
         tx_fifo_remove_last();
 
-        if (m_config_local.protocol != NRF_ESB_PROTOCOL_ESB && m_rx_payload_buffer[0] > 0)
+        if (m_config_local.protocol != NRF_ESB_PROTOCOL_ESB && RX_PACKET_BUFFER()[0] > 0)
         {
             if (rx_fifo_push_rfbuf((uint8_t)NRF_RADIO->TXADDRESS, 0))
             {
+                STATS_INC(NRF_RADIO->TXADDRESS, rx_packets);
                 m_interrupt_flags |= NRF_ESB_INT_RX_DATA_RECEIVED_MSK;
             }
+            else if (m_rx_fifo.count >= NRF_ESB_RX_FIFO_SIZE)
+            {
+                STATS_INC(NRF_RADIO->TXADDRESS, rx_fifo_overflows);
+            }
         }
 
         if ((m_tx_fifo.count == 0) || (m_config_local.tx_mode == NRF_ESB_TXMODE_MANUAL))
@@ -637,6 +965,13 @@ static void on_radio_disabled_tx_wait_for_ack()
     }
     else
     {
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+        // The radio is disabled, so the channel can be changed before the next attempt.
+        if (m_hop_config.channels_count > 0)
+        {
+            channel_tx_result(false);
+        }
+#endif
         if (m_retransmits_remaining-- == 0)
         {
             NRF_ESB_SYS_TIMER->TASKS_STOP = 1;
@@ -644,6 +979,8 @@ static void on_radio_disabled_tx_wait_for_ack()
             // All retransmits are expended, and the TX operation is suspended
             m_last_tx_attempts = m_config_local.retransmit_count + 1;
             m_interrupt_flags |= NRF_ESB_INT_TX_FAILED_MSK;
+            STATS_INC(mp_current_payload->pipe, tx_failed);
+            STATS_ADD(mp_current_payload->pipe, tx_retransmits, m_config_local.retransmit_count);
 
             m_nrf_esb_mainstate = NRF_ESB_STATE_IDLE;
             NVIC_SetPendingIRQ(ESB_EVT_IRQ);
@@ -652,9 +989,12 @@ static void on_radio_disabled_tx_wait_for_ack()
         {
             // There are still have more retransmits left, TX mode should be
             // entered again as soon as the system timer reaches CC[1].
+#if NRF_ESB_STATS_ENABLED
+            m_tx_latency_us += m_tx_retransmit_wait_us;
+#endif
             NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
             update_rf_payload_format(mp_current_payload->length);
-            NRF_RADIO->PACKETPTR = (uint32_t)m_tx_payload_buffer;
+            NRF_RADIO->PACKETPTR = (uint32_t)mp_current_payload->packet;
             on_radio_disabled = on_radio_disabled_tx;
             m_nrf_esb_mainstate = NRF_ESB_STATE_PTX_TX_ACK;
             NRF_ESB_SYS_TIMER->TASKS_START = 1;
@@ -671,7 +1011,7 @@ static void clear_events_restart_rx(void)
 {
     NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON;
     update_rf_payload_format(m_config_local.payload_length);
-    NRF_RADIO->PACKETPTR = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = (uint32_t)RX_PACKET_BUFFER();
     NRF_RADIO->EVENTS_DISABLED = 0;
     NRF_RADIO->TASKS_DISABLE = 1;
 
@@ -688,31 +1028,51 @@ static void on_radio_disabled_rx(void)
     bool            retransmit_payload = false;
     bool            send_rx_event      = true;
     pipe_info_t *   p_pipe_info;
+    uint8_t const * p_rx_packet;
+    uint8_t       * p_ack_packet;
 
     if (NRF_RADIO->CRCSTATUS == 0)
     {
+        STATS_INC(NRF_RADIO->RXMATCH, rx_crc_errors);
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+        if (m_hop_config.channels_count > 0)
+        {
+            m_channels[m_channel_index].stats.rx_crc_errors++;
+        }
+#endif
         clear_events_restart_rx();
         return;
     }
 
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    if (m_hop_config.channels_count > 0)
+    {
+        m_channels[m_channel_index].stats.rx_packets++;
+        m_rx_activity = true;
+    }
+#endif
+
     if(m_rx_fifo.count >= NRF_ESB_RX_FIFO_SIZE)
     {
+        STATS_INC(NRF_RADIO->RXMATCH, rx_fifo_overflows);
         clear_events_restart_rx();
         return;
     }
 
+    p_rx_packet = RX_PACKET_BUFFER();
     p_pipe_info = &m_rx_pipe_info[NRF_RADIO->RXMATCH];
-    if (NRF_RADIO->RXCRC             == p_pipe_info->m_crc &&
-       (m_rx_payload_buffer[1] >> 1) == p_pipe_info->m_pid  )
+    if (NRF_RADIO->RXCRC     == p_pipe_info->m_crc &&
+       (p_rx_packet[1] >> 1) == p_pipe_info->m_pid  )
     {
         retransmit_payload = true;
         send_rx_event = false;
+        STATS_INC(NRF_RADIO->RXMATCH, rx_duplicates);
     }
 
-    p_pipe_info->m_pid = m_rx_payload_buffer[1] >> 1;
+    p_pipe_info->m_pid = p_rx_packet[1] >> 1;
     p_pipe_info->m_crc = NRF_RADIO->RXCRC;
 
-    if(m_config_local.selective_auto_ack == false || ((m_rx_payload_buffer[1] & 0x01) == 0))
+    if(m_config_local.selective_auto_ack == false || ((p_rx_packet[1] & 0x01) == 0))
         ack = true;
 
     if(ack)
@@ -723,64 +1083,63 @@ static void on_radio_disabled_rx(void)
         {
             case NRF_ESB_PROTOCOL_ESB_DPL:
                 {
-                    if (m_tx_fifo.count > 0 &&
-                        (m_tx_fifo.p_payload[m_tx_fifo.exit_point]->pipe == NRF_RADIO->RXMATCH))
-                    {
-                        // Pipe stays in ACK with payload until TX fifo is empty
-                        // Do not report TX success on first ack payload or retransmit
-                        if (p_pipe_info->m_ack_payload != 0 && !retransmit_payload)
-                        {
-                            if(++m_tx_fifo.exit_point >= NRF_ESB_TX_FIFO_SIZE)
-                            {
-                                m_tx_fifo.exit_point = 0;
-                            }
+                    nrf_esb_ack_queue_t * p_queue = &m_ack_queue[NRF_RADIO->RXMATCH];
 
-                            m_tx_fifo.count--;
+                    // A new packet means that the ACK payload sent with the previous one was
+                    // received. Do not report TX success on first ack payload or retransmit
+                    if (p_pipe_info->m_ack_payload != 0 && !retransmit_payload)
+                    {
+                        ack_queue_remove_first(p_queue);
+                        STATS_INC(NRF_RADIO->RXMATCH, tx_success);
 
-                            // ACK payloads also require TX_DS
-                            // (page 40 of the 'nRF24LE1_Product_Specification_rev1_6.pdf').
-                            m_interrupt_flags |= NRF_ESB_INT_TX_SUCCESS_MSK;
-                        }
+                        // ACK payloads also require TX_DS
+                        // (page 40 of the 'nRF24LE1_Product_Specification_rev1_6.pdf').
+                        m_interrupt_flags |= NRF_ESB_INT_TX_SUCCESS_MSK;
+                    }
 
+                    // Pipe stays in ACK with payload until its queue is empty. The length field
+                    // of the queued packet was set when it was written.
+                    if (p_queue->count > 0)
+                    {
                         p_pipe_info->m_ack_payload = 1;
 
-                        mp_current_payload = m_tx_fifo.p_payload[m_tx_fifo.exit_point];
+                        mp_current_payload = &m_tx_fifo_slot[p_queue->head];
 
                         update_rf_payload_format(mp_current_payload->length);
-                        m_tx_payload_buffer[0] = mp_current_payload->length;
-                        memcpy(&m_tx_payload_buffer[2],
-                               mp_current_payload->data,
-                               mp_current_payload->length);
+                        p_ack_packet = mp_current_payload->packet;
                     }
                     else
                     {
+                        if (p_pipe_info->m_ack_payload != 0)
+                        {
+                            STATS_INC(NRF_RADIO->RXMATCH, ack_payload_underruns);
+                        }
                         p_pipe_info->m_ack_payload = 0;
                         update_rf_payload_format(0);
-                        m_tx_payload_buffer[0] = 0;
+                        p_ack_packet = m_ack_buffer;
+                        p_ack_packet[0] = 0;
                     }
 
-                    m_tx_payload_buffer[1] = m_rx_payload_buffer[1];
+                    p_ack_packet[1] = p_rx_packet[1];
                 }
                 break;
 
             case NRF_ESB_PROTOCOL_ESB:
+            default:
                 {
                     update_rf_payload_format(0);
-                    m_tx_payload_buffer[0] = m_rx_payload_buffer[0];
-                    m_tx_payload_buffer[1] = 0;
+                    p_ack_packet = m_ack_buffer;
+                    p_ack_packet[0] = p_rx_packet[0];
+                    p_ack_packet[1] = 0;
                 }
                 break;
         }
 
         m_nrf_esb_mainstate = NRF_ESB_STATE_PRX_SEND_ACK;
         NRF_RADIO->TXADDRESS = NRF_RADIO->RXMATCH;
-        NRF_RADIO->PACKETPTR = (uint32_t)m_tx_payload_buffer;
+        NRF_RADIO->PACKETPTR = (uint32_t)p_ack_packet;
         on_radio_disabled = on_radio_disabled_rx_ack;
     }
-    else
-    {
-        clear_events_restart_rx();
-    }
 
     if (send_rx_event)
     {
@@ -788,10 +1147,17 @@ static void on_radio_disabled_rx(void)
         // successful.
         if (rx_fifo_push_rfbuf(NRF_RADIO->RXMATCH, p_pipe_info->m_pid))
         {
+            STATS_INC(NRF_RADIO->RXMATCH, rx_packets);
             m_interrupt_flags |= NRF_ESB_INT_RX_DATA_RECEIVED_MSK;
             NVIC_SetPendingIRQ(ESB_EVT_IRQ);
         }
     }
+
+    if (!ack)
+    {
+        // The packet has been pushed to the RX FIFO, so the radio can receive to the next entry.
+        clear_events_restart_rx();
+    }
 }
 
 
@@ -800,18 +1166,93 @@ static void on_radio_disabled_rx_ack(void)
     NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_TXEN_Msk;
     update_rf_payload_format(m_config_local.payload_length);
 
-    NRF_RADIO->PACKETPTR = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = (uint32_t)RX_PACKET_BUFFER();
     on_radio_disabled = on_radio_disabled_rx;
 
     m_nrf_esb_mainstate = NRF_ESB_STATE_PRX;
 }
 
 
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+static void rx_dwell_timer_start(void)
+{
+    NRF_ESB_SYS_TIMER->TASKS_STOP           = 1;
+    NRF_ESB_SYS_TIMER->TASKS_CLEAR          = 1;
+    NRF_ESB_SYS_TIMER->SHORTS               = TIMER_SHORTS_COMPARE2_CLEAR_Msk;
+    NRF_ESB_SYS_TIMER->CC[2]                = m_hop_config.rx_dwell_time_us;
+    NRF_ESB_SYS_TIMER->EVENTS_COMPARE[2]    = 0;
+    NRF_ESB_SYS_TIMER->INTENSET             = TIMER_INTENSET_COMPARE2_Msk;
+
+    m_rx_activity = false;
+
+    NVIC_SetPriority(NRF_ESB_SYS_TIMER_IRQn, m_config_local.radio_irq_priority & 0x03);
+    NVIC_ClearPendingIRQ(NRF_ESB_SYS_TIMER_IRQn);
+    NVIC_EnableIRQ(NRF_ESB_SYS_TIMER_IRQn);
+
+    NRF_ESB_SYS_TIMER->TASKS_START          = 1;
+}
+
+
+static void rx_dwell_timer_stop(void)
+{
+    NVIC_DisableIRQ(NRF_ESB_SYS_TIMER_IRQn);
+
+    NRF_ESB_SYS_TIMER->TASKS_STOP           = 1;
+    NRF_ESB_SYS_TIMER->INTENCLR             = TIMER_INTENCLR_COMPARE2_Msk;
+    NRF_ESB_SYS_TIMER->EVENTS_COMPARE[2]    = 0;
+
+    sys_timer_init();
+}
+
+
+// Called every rx_dwell_time_us in PRX mode. The interrupt has the priority of the radio interrupt,
+// so it never runs in the middle of the radio event handling.
+void NRF_ESB_SYS_TIMER_IRQ_Handler(void)
+{
+    bool activity;
+
+    if (NRF_ESB_SYS_TIMER->EVENTS_COMPARE[2] == 0)
+    {
+        return;
+    }
+    NRF_ESB_SYS_TIMER->EVENTS_COMPARE[2] = 0;
+
+    // A packet which is being received or acknowledged counts as activity on the channel.
+    activity = m_rx_activity || NRF_RADIO->EVENTS_ADDRESS || NRF_RADIO->EVENTS_DISABLED;
+    NRF_RADIO->EVENTS_ADDRESS = 0;
+    m_rx_activity = false;
+
+    if (activity || m_nrf_esb_mainstate != NRF_ESB_STATE_PRX)
+    {
+        return;
+    }
+
+    // Restart reception on the next channel.
+    NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON;
+    NRF_RADIO->INTENCLR = RADIO_INTENCLR_DISABLED_Msk;
+    NRF_RADIO->EVENTS_DISABLED = 0;
+    NRF_RADIO->TASKS_DISABLE = 1;
+
+    while (NRF_RADIO->EVENTS_DISABLED == 0);
+
+    NRF_RADIO->EVENTS_DISABLED = 0;
+    channel_hop();
+    NRF_RADIO->PACKETPTR = (uint32_t)RX_PACKET_BUFFER();
+    NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_TXEN_Msk;
+    NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk;
+    NRF_RADIO->TASKS_RXEN = 1;
+}
+#endif // NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+
+
 uint32_t nrf_esb_init(nrf_esb_config_t const * p_config)
 {
     uint32_t err_code;
 
     VERIFY_PARAM_NOT_NULL(p_config);
+#ifndef NRF52
+    VERIFY_FALSE(p_config->fast_ramp_up, NRF_ERROR_NOT_SUPPORTED);
+#endif
 
     if(m_esb_initialized)
     {
@@ -831,6 +1272,16 @@ uint32_t nrf_esb_init(nrf_esb_config_t const * p_config)
     memset(m_rx_pipe_info, 0, sizeof(m_rx_pipe_info));
     memset(m_pids, 0, sizeof(m_pids));
 
+    // Devices taking the same decisions must not draw the same random delays.
+    m_rand_state = NRF_FICR->DEVICEID[0] | 1;
+
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    m_hop_config.channels_count = 0;
+#endif
+#if NRF_ESB_STATS_ENABLED
+    memset(&m_stats, 0, sizeof(m_stats));
+#endif
+
     update_radio_parameters();
 
     initialize_fifos();
@@ -876,6 +1327,13 @@ uint32_t nrf_esb_disable(void)
 
     m_nrf_esb_mainstate = NRF_ESB_STATE_IDLE;
 
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    if (m_hop_config.channels_count > 0)
+    {
+        rx_dwell_timer_stop();
+    }
+#endif
+
     reset_fifos();
 
     memset(m_rx_pipe_info, 0, sizeof(m_rx_pipe_info));
@@ -925,11 +1383,68 @@ void ESB_EVT_IRQHandler(void)
     }
 }
 
+/** @brief  Function to add an ACK payload to the queue of its pipe in PRX mode.
+ *
+ *  @param  p_payload Payload to add, already verified.
+ *
+ *  @retval NRF_SUCCESS         Payload was added.
+ *  @retval NRF_ERROR_NO_MEM    The queue of the pipe is full.
+ */
+static uint32_t ack_queue_write(nrf_esb_payload_t const * p_payload)
+{
+    nrf_esb_ack_queue_t * p_queue = &m_ack_queue[p_payload->pipe];
+    nrf_esb_fifo_slot_t * p_slot;
+    uint8_t               index;
+
+    VERIFY_FALSE(p_queue->count >= p_queue->quota, NRF_ERROR_NO_MEM);
+
+    DISABLE_RF_IRQ();
+
+    index = m_ack_free_head;
+    m_ack_free_head = m_tx_fifo_slot[index].next;
+
+    ENABLE_RF_IRQ();
+
+    // The entry is not in any queue yet, so it can be filled in with the radio interrupt enabled.
+    p_slot            = &m_tx_fifo_slot[index];
+    p_slot->length    = p_payload->length;
+    p_slot->pipe      = p_payload->pipe;
+    p_slot->noack     = p_payload->noack;
+    p_slot->next      = ACK_QUEUE_END;
+    p_slot->packet[0] = p_payload->length;
+    memcpy(&p_slot->packet[2], p_payload->data, p_payload->length);
+
+    m_pids[p_payload->pipe] = (m_pids[p_payload->pipe] + 1) % (NRF_ESB_PID_MAX + 1);
+    p_slot->pid = m_pids[p_payload->pipe];
+
+    DISABLE_RF_IRQ();
+
+    if (p_queue->tail == ACK_QUEUE_END)
+    {
+        p_queue->head = index;
+    }
+    else
+    {
+        m_tx_fifo_slot[p_queue->tail].next = index;
+    }
+    p_queue->tail = index;
+    p_queue->count++;
+    m_tx_fifo.count++;
+
+    ENABLE_RF_IRQ();
+
+    return NRF_SUCCESS;
+}
+
+
 uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
 {
+    nrf_esb_fifo_slot_t * p_slot;
+
     VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
     VERIFY_PARAM_NOT_NULL(p_payload);
     VERIFY_PAYLOAD_LENGTH(p_payload);
+    VERIFY_TRUE(p_payload->pipe < 8, NRF_ERROR_INVALID_PARAM);
     VERIFY_FALSE(m_tx_fifo.count >= NRF_ESB_TX_FIFO_SIZE, NRF_ERROR_NO_MEM);
 
     if (m_config_local.mode == NRF_ESB_MODE_PTX &&
@@ -938,12 +1453,22 @@ uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
         return NRF_ERROR_NOT_SUPPORTED;
     }
 
-    DISABLE_RF_IRQ();
+    if (m_config_local.mode == NRF_ESB_MODE_PRX)
+    {
+        return ack_queue_write(p_payload);
+    }
 
-    memcpy(m_tx_fifo.p_payload[m_tx_fifo.entry_point], p_payload, sizeof(nrf_esb_payload_t));
+    // The entry at entry_point is not used by the radio until it is added to the queue.
+    p_slot         = m_tx_fifo.p_slot[m_tx_fifo.entry_point];
+    p_slot->length = p_payload->length;
+    p_slot->pipe   = p_payload->pipe;
+    p_slot->noack  = p_payload->noack;
+    memcpy(&p_slot->packet[2], p_payload->data, p_payload->length);
 
     m_pids[p_payload->pipe] = (m_pids[p_payload->pipe] + 1) % (NRF_ESB_PID_MAX + 1);
-    m_tx_fifo.p_payload[m_tx_fifo.entry_point]->pid = m_pids[p_payload->pipe];
+    p_slot->pid = m_pids[p_payload->pipe];
+
+    DISABLE_RF_IRQ();
 
     if (++m_tx_fifo.entry_point >= NRF_ESB_TX_FIFO_SIZE)
     {
@@ -968,28 +1493,55 @@ uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
 
 uint32_t nrf_esb_read_rx_payload(nrf_esb_payload_t * p_payload)
 {
+    uint32_t count;
+
+    return nrf_esb_read_rx_payloads(p_payload, 1, &count);
+}
+
+
+uint32_t nrf_esb_read_rx_payloads(nrf_esb_payload_t * p_payloads,
+                                  uint32_t            max_count,
+                                  uint32_t          * p_count)
+{
+    uint32_t exit_point;
+    uint32_t count;
+
     VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
-    VERIFY_PARAM_NOT_NULL(p_payload);
+    VERIFY_PARAM_NOT_NULL(p_payloads);
+    VERIFY_PARAM_NOT_NULL(p_count);
 
-    if (m_rx_fifo.count == 0)
+    // The radio only writes to the free entry at entry_point, so the queued entries can be copied
+    // with the radio interrupt enabled. Packets received meanwhile are left for the next call.
+    count = MIN(m_rx_fifo.count, max_count);
+    *p_count = count;
+
+    if (count == 0)
     {
         return NRF_ERROR_NOT_FOUND;
     }
 
-    DISABLE_RF_IRQ();
-
-    p_payload->length = m_rx_fifo.p_payload[m_rx_fifo.exit_point]->length;
-    p_payload->pipe   = m_rx_fifo.p_payload[m_rx_fifo.exit_point]->pipe;
-    p_payload->rssi   = m_rx_fifo.p_payload[m_rx_fifo.exit_point]->rssi;
-    p_payload->pid    = m_rx_fifo.p_payload[m_rx_fifo.exit_point]->pid;
-    memcpy(p_payload->data, m_rx_fifo.p_payload[m_rx_fifo.exit_point]->data, p_payload->length);
+    exit_point = m_rx_fifo.exit_point;
 
-    if (++m_rx_fifo.exit_point >= NRF_ESB_RX_FIFO_SIZE)
+    for (uint32_t i = 0; i < count; i++)
     {
-        m_rx_fifo.exit_point = 0;
+        nrf_esb_fifo_slot_t const * p_slot = m_rx_fifo.p_slot[exit_point];
+
+        p_payloads[i].length = p_slot->length;
+        p_payloads[i].pipe   = p_slot->pipe;
+        p_payloads[i].rssi   = p_slot->rssi;
+        p_payloads[i].pid    = p_slot->pid;
+        memcpy(p_payloads[i].data, &p_slot->packet[2], p_slot->length);
+
+        if (++exit_point >= NRF_ESB_RX_FIFO_SIZE + 1)
+        {
+            exit_point = 0;
+        }
     }
 
-    m_rx_fifo.count--;
+    DISABLE_RF_IRQ();
+
+    m_rx_fifo.exit_point = exit_point;
+    m_rx_fifo.count     -= count;
 
     ENABLE_RF_IRQ();
 
@@ -1026,7 +1578,7 @@ uint32_t nrf_esb_start_rx(void)
 
     NRF_RADIO->RXADDRESSES  = m_esb_addr.rx_pipes_enabled;
     NRF_RADIO->FREQUENCY    = m_esb_addr.rf_channel;
-    NRF_RADIO->PACKETPTR    = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR    = (uint32_t)RX_PACKET_BUFFER();
 
     NVIC_ClearPendingIRQ(RADIO_IRQn);
     NVIC_EnableIRQ(RADIO_IRQn);
@@ -1037,6 +1589,13 @@ uint32_t nrf_esb_start_rx(void)
 
     NRF_RADIO->TASKS_RXEN  = 1;
 
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    if (m_hop_config.channels_count > 0)
+    {
+        rx_dwell_timer_start();
+    }
+#endif
+
     return NRF_SUCCESS;
 }
 
@@ -1045,6 +1604,12 @@ uint32_t nrf_esb_stop_rx(void)
 {
     if (m_nrf_esb_mainstate == NRF_ESB_STATE_PRX)
     {
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+        if (m_hop_config.channels_count > 0)
+        {
+            rx_dwell_timer_stop();
+        }
+#endif
         NRF_RADIO->SHORTS = 0;
         NRF_RADIO->INTENCLR = 0xFFFFFFFF;
         on_radio_disabled = NULL;
@@ -1070,6 +1635,12 @@ uint32_t nrf_esb_flush_tx(void)
     m_tx_fifo.entry_point = 0;
     m_tx_fifo.exit_point = 0;
 
+    reset_ack_queues();
+    for (int i = 0; i < NRF_ESB_PIPE_COUNT; i++)
+    {
+        m_rx_pipe_info[i].m_ack_payload = 0;
+    }
+
     ENABLE_RF_IRQ();
 
     return NRF_SUCCESS;
@@ -1083,11 +1654,27 @@ uint32_t nrf_esb_pop_tx(void)
 
     DISABLE_RF_IRQ();
 
-    if (++m_tx_fifo.entry_point >= NRF_ESB_TX_FIFO_SIZE)
+    if (m_config_local.mode == NRF_ESB_MODE_PRX)
     {
-        m_tx_fifo.entry_point = 0;
+        for (int i = 0; i < NRF_ESB_PIPE_COUNT; i++)
+        {
+            if (m_ack_queue[i].count > 0)
+            {
+                ack_queue_remove_first(&m_ack_queue[i]);
+                m_rx_pipe_info[i].m_ack_payload = 0;
+                break;
+            }
+        }
+    }
+    else
+    {
+        // The first item is the oldest one, the one sent next or which failed last.
+        if (++m_tx_fifo.exit_point >= NRF_ESB_TX_FIFO_SIZE)
+        {
+            m_tx_fifo.exit_point = 0;
+        }
+        m_tx_fifo.count--;
     }
-    m_tx_fifo.count--;
 
     ENABLE_RF_IRQ();
 
@@ -1095,15 +1682,28 @@ uint32_t nrf_esb_pop_tx(void)
 }
 
 
+uint32_t nrf_esb_set_ack_payload_quota(uint8_t pipe, uint8_t quota)
+{
+    VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
+    VERIFY_TRUE(pipe < 8, NRF_ERROR_INVALID_PARAM);
+    VERIFY_TRUE(quota > 0 && quota <= NRF_ESB_TX_FIFO_SIZE, NRF_ERROR_INVALID_PARAM);
+
+    m_ack_queue[pipe].quota = quota;
+
+    return NRF_SUCCESS;
+}
+
+
 uint32_t nrf_esb_flush_rx(void)
 {
     VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
 
     DISABLE_RF_IRQ();
 
+    // The radio may be receiving to the entry at entry_point, so the queue is emptied without
+    // moving it.
     m_rx_fifo.count = 0;
-    m_rx_fifo.entry_point = 0;
-    m_rx_fifo.exit_point = 0;
+    m_rx_fifo.exit_point = m_rx_fifo.entry_point;
 
     memset(m_rx_pipe_info, 0, sizeof(m_rx_pipe_info));
 
@@ -1228,6 +1828,119 @@ uint32_t nrf_esb_get_rf_channel(uint32_t * p_channel)
 }
 
 
+uint32_t nrf_esb_set_channel_hopping(nrf_esb_channel_hopping_config_t const * p_config)
+{
+    VERIFY_PARAM_NOT_NULL(p_config);
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    VERIFY_TRUE(m_nrf_esb_mainstate == NRF_ESB_STATE_IDLE, NRF_ERROR_BUSY);
+    VERIFY_TRUE(p_config->channels_count <= NRF_ESB_CHANNEL_TABLE_MAX_SIZE, NRF_ERROR_INVALID_PARAM);
+
+    if (p_config->channels_count > 0)
+    {
+        VERIFY_PARAM_NOT_NULL(p_config->p_channels);
+        VERIFY_TRUE(p_config->tx_attempts_per_channel > 0, NRF_ERROR_INVALID_PARAM);
+        VERIFY_TRUE(p_config->rx_dwell_time_us > 0, NRF_ERROR_INVALID_PARAM);
+        VERIFY_TRUE(p_config->per_block_threshold <= 100, NRF_ERROR_INVALID_PARAM);
+
+        for (uint8_t i = 0; i < p_config->channels_count; i++)
+        {
+            VERIFY_TRUE(p_config->p_channels[i] <= 125, NRF_ERROR_INVALID_PARAM);
+        }
+    }
+
+    memcpy(&m_hop_config, p_config, sizeof(m_hop_config));
+    memset(m_channels, 0, sizeof(m_channels));
+
+    for (uint8_t i = 0; i < p_config->channels_count; i++)
+    {
+        m_channels[i].stats.channel = p_config->p_channels[i];
+    }
+
+    if (p_config->channels_count > 0)
+    {
+        channel_set(0);
+    }
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t nrf_esb_channel_stats_get(uint8_t index, nrf_esb_channel_stats_t * p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_stats);
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    VERIFY_TRUE(index < m_hop_config.channels_count, NRF_ERROR_INVALID_PARAM);
+
+    DISABLE_RF_IRQ();
+    memcpy(p_stats, &m_channels[index].stats, sizeof(nrf_esb_channel_stats_t));
+    ENABLE_RF_IRQ();
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_INVALID_PARAM;
+#endif
+}
+
+
+uint32_t nrf_esb_channel_stats_clear(void)
+{
+#if NRF_ESB_CHANNEL_TABLE_MAX_SIZE > 0
+    DISABLE_RF_IRQ();
+
+    for (uint8_t i = 0; i < m_hop_config.channels_count; i++)
+    {
+        uint8_t channel = m_channels[i].stats.channel;
+
+        memset(&m_channels[i], 0, sizeof(m_channels[i]));
+        m_channels[i].stats.channel = channel;
+    }
+
+    ENABLE_RF_IRQ();
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_stats_get(nrf_esb_stats_t * p_stats, bool clear)
+{
+    VERIFY_PARAM_NOT_NULL(p_stats);
+#if NRF_ESB_STATS_ENABLED
+    DISABLE_RF_IRQ();
+
+    memcpy(p_stats, &m_stats, sizeof(nrf_esb_stats_t));
+    if (clear)
+    {
+        memset(&m_stats, 0, sizeof(m_stats));
+    }
+
+    ENABLE_RF_IRQ();
+
+    return NRF_SUCCESS;
+#else
+    UNUSED_PARAMETER(clear);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t nrf_esb_stats_clear(void)
+{
+#if NRF_ESB_STATS_ENABLED
+    DISABLE_RF_IRQ();
+    memset(&m_stats, 0, sizeof(m_stats));
+    ENABLE_RF_IRQ();
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
 uint32_t nrf_esb_set_tx_power(nrf_esb_tx_power_t tx_output_power)
 {
     VERIFY_TRUE(m_nrf_esb_mainstate == NRF_ESB_STATE_IDLE, NRF_ERROR_BUSY);
@@ -50,11 +50,38 @@
 #define     NRF_ESB_TX_FIFO_SIZE                8                   /**< The size of the transmission first in first out buffer. */
 #define     NRF_ESB_RX_FIFO_SIZE                8                   /**< The size of the reception first in first out buffer. */
 
+#ifndef NRF_ESB_ACK_PAYLOAD_QUOTA
+#define     NRF_ESB_ACK_PAYLOAD_QUOTA           NRF_ESB_TX_FIFO_SIZE    /**< Default maximum number of ACK payloads queued for one pipe in PRX mode. See @ref nrf_esb_set_ack_payload_quota. */
+#endif
+
+STATIC_ASSERT(NRF_ESB_ACK_PAYLOAD_QUOTA > 0 && NRF_ESB_ACK_PAYLOAD_QUOTA <= NRF_ESB_TX_FIFO_SIZE);
+
 // 252 is the largest possible payload size according to the nRF5x architecture.
 STATIC_ASSERT(NRF_ESB_MAX_PAYLOAD_LENGTH <= 252);
 
 #define     NRF_ESB_SYS_TIMER                   NRF_TIMER2          /**< The timer which will be used by the module. */
 #define     NRF_ESB_SYS_TIMER_IRQ_Handler       TIMER2_IRQHandler   /**< The handler which will be used by NRF_ESB_SYS_TIMER. */
+#define     NRF_ESB_SYS_TIMER_IRQn              TIMER2_IRQn         /**< The interrupt number of NRF_ESB_SYS_TIMER. */
+
+#ifndef NRF_ESB_CHANNEL_TABLE_MAX_SIZE
+#define     NRF_ESB_CHANNEL_TABLE_MAX_SIZE      0                   /**< Maximum number of channels for channel hopping. 0 leaves channel hopping out of the module, and NRF_ESB_SYS_TIMER_IRQ_Handler is only defined by the module when it is not 0. */
+#endif
+
+#ifndef NRF_ESB_STATS_ENABLED
+#define     NRF_ESB_STATS_ENABLED               0                   /**< Enable the link statistics, see @ref nrf_esb_stats_get. */
+#endif
+
+#ifndef NRF_ESB_LATENCY_HISTOGRAM_BINS
+#define     NRF_ESB_LATENCY_HISTOGRAM_BINS      8                   /**< Number of bins of the transaction latency histogram. */
+#endif
+
+#ifndef NRF_ESB_LATENCY_BIN_WIDTH_US
+#define     NRF_ESB_LATENCY_BIN_WIDTH_US        250                 /**< Width of a bin of the transaction latency histogram, in microseconds. */
+#endif
+
+#define     NRF_ESB_CHANNEL_BLOCK_HOPS          16                  /**< Number of channel hops a channel with a poor packet error rate is skipped for. */
+
+STATIC_ASSERT(NRF_ESB_CHANNEL_TABLE_MAX_SIZE <= 32);
 
 #define     NRF_ESB_PPI_TIMER_START             10                  /**< The PPI channel used for timer start. */
 #define     NRF_ESB_PPI_TIMER_STOP              11                  /**< The PPI channel used for timer stop. */
@@ -109,11 +136,13 @@ STATIC_ASSERT(NRF_ESB_MAX_PAYLOAD_LENGTH <= 252);
                                 .tx_output_power        = NRF_ESB_TX_POWER_0DBM,            \
                                 .retransmit_delay       = 250,                              \
                                 .retransmit_count       = 3,                                \
+                                .retransmit_backoff     = NRF_ESB_RETRANSMIT_BACKOFF_NONE,  \
                                 .tx_mode                = NRF_ESB_TXMODE_AUTO,              \
                                 .radio_irq_priority     = 1,                                \
                                 .event_irq_priority     = 2,                                \
                                 .payload_length         = 32,                               \
-                                .selective_auto_ack     = false                             \
+                                .selective_auto_ack     = false,                            \
+                                .fast_ramp_up           = false                             \
 }
 
 
@@ -126,11 +155,13 @@ STATIC_ASSERT(NRF_ESB_MAX_PAYLOAD_LENGTH <= 252);
                                 .tx_output_power        = NRF_ESB_TX_POWER_0DBM,            \
                                 .retransmit_delay       = 600,                              \
                                 .retransmit_count       = 3,                                \
+                                .retransmit_backoff     = NRF_ESB_RETRANSMIT_BACKOFF_NONE,  \
                                 .tx_mode                = NRF_ESB_TXMODE_AUTO,              \
                                 .radio_irq_priority     = 1,                                \
                                 .event_irq_priority     = 2,                                \
                                 .payload_length         = 32,                               \
-                                .selective_auto_ack     = false                             \
+                                .selective_auto_ack     = false,                            \
+                                .fast_ramp_up           = false                             \
 }
 
 
@@ -202,6 +233,14 @@ typedef enum {
 } nrf_esb_tx_mode_t;
 
 
+/**@brief Enhanced ShockBurst retransmit delay modes. */
+typedef enum {
+    NRF_ESB_RETRANSMIT_BACKOFF_NONE,        /**< Every retransmission is sent retransmit_delay after the previous one. */
+    NRF_ESB_RETRANSMIT_BACKOFF_RANDOM,      /**< A random delay from 0 to retransmit_delay is added to each retransmit delay. The generator is seeded from the device ID. */
+    NRF_ESB_RETRANSMIT_BACKOFF_EXPONENTIAL  /**< The upper limit of the random delay doubles with each retransmission, up to 16 times retransmit_delay. */
+} nrf_esb_retransmit_backoff_t;
+
+
 /**@brief Enhanced ShockBurst event id used to indicate the type of the event. */
 typedef enum
 {
@@ -275,6 +314,7 @@ typedef struct
 
     uint16_t                retransmit_delay;       /**< The delay between each retransmission of unacked packets. */
     uint16_t                retransmit_count;       /**< The number of retransmissions attempts before transmission fail. */
+    nrf_esb_retransmit_backoff_t retransmit_backoff; /**< Randomization of the retransmit delay, so that devices which collided do not collide again. */
 
     // Control settings
     nrf_esb_tx_mode_t       tx_mode;                /**< Enhanced ShockBurst transmit mode. */
@@ -284,9 +324,73 @@ typedef struct
     uint8_t                 payload_length;         /**< Length of payload. Maximum length depend on the platform used in each end. */
 
     bool                    selective_auto_ack;     /**< Enable or disable selective auto acknowledgement. */
+    bool                    fast_ramp_up;           /**< Use the fast radio ramp-up of nRF52 (about 40 us instead of 130 us) for every TX and RX start. The PTX and the PRX must use the same setting, the acknowledgement timing depends on it. */
 } nrf_esb_config_t;
 
 
+/**@brief Channel hopping configuration.
+ *
+ * @details The PTX and the PRX must use the same channel table. The PTX moves to the next channel
+ *          in the table after tx_attempts_per_channel failed transmissions, and the PRX moves to
+ *          the next channel when it has not received any packet for rx_dwell_time_us, so the PTX
+ *          finds the PRX again. rx_dwell_time_us should be longer than the time the PTX takes to
+ *          try all the channels: channels_count * tx_attempts_per_channel * retransmit_delay.
+ *
+ *          The PTX skips a channel for @ref NRF_ESB_CHANNEL_BLOCK_HOPS hops when the packet error
+ *          rate of the last block_window transmissions on it is per_block_threshold percent or more.
+ */
+typedef struct
+{
+    uint8_t const * p_channels;                 /**< Pointer to the channels, 0 to 125. */
+    uint8_t         channels_count;             /**< Number of channels, at most @ref NRF_ESB_CHANNEL_TABLE_MAX_SIZE. 0 disables channel hopping. */
+    uint8_t         tx_attempts_per_channel;    /**< PTX: number of failed transmissions before moving to the next channel. */
+    uint16_t        rx_dwell_time_us;           /**< PRX: time without received packets before moving to the next channel, in microseconds. */
+    uint8_t         block_window;               /**< PTX: number of transmissions the packet error rate of a channel is measured over. 0 disables skipping channels. */
+    uint8_t         per_block_threshold;        /**< PTX: packet error rate, in percent, from which a channel is skipped. */
+} nrf_esb_channel_hopping_config_t;
+
+
+/**@brief Statistics of a channel of the channel table. */
+typedef struct
+{
+    uint32_t    tx_attempts;                    /**< PTX: number of transmissions on the channel, retransmissions included. */
+    uint32_t    tx_acked;                       /**< PTX: number of transmissions which were acknowledged. */
+    uint32_t    rx_packets;                     /**< Number of packets received with a valid CRC, acknowledgements included. */
+    uint32_t    rx_crc_errors;                  /**< PRX: number of packets received with a CRC error. */
+    uint8_t     channel;                        /**< Channel the statistics are for. */
+    uint8_t     blocked_hops;                   /**< PTX: number of hops the channel is still skipped for. */
+} nrf_esb_channel_stats_t;
+
+
+/**@brief Link statistics of a pipe. */
+typedef struct
+{
+    uint32_t    tx_success;                     /**< Packets acknowledged, or sent if no acknowledgement was requested. PRX: ACK payloads received by the PTX. */
+    uint32_t    tx_failed;                      /**< PTX: packets for which all the retransmissions failed. */
+    uint32_t    tx_retransmits;                 /**< PTX: retransmissions. */
+    uint32_t    rx_packets;                     /**< Packets added to the RX FIFO, ACK payloads included. */
+    uint32_t    rx_duplicates;                  /**< PRX: retransmissions of packets already received, which were acknowledged but not added to the RX FIFO. */
+    uint32_t    rx_crc_errors;                  /**< PRX: packets received with a CRC error. */
+    uint32_t    rx_fifo_overflows;              /**< Packets dropped because the RX FIFO was full. */
+    uint32_t    ack_payload_underruns;          /**< PRX: times the pipe went back to empty acknowledgements because its ACK payload queue ran empty. */
+} nrf_esb_pipe_stats_t;
+
+
+/**@brief Link statistics.
+ *
+ * @details The latency of a transaction is the time from the start of the first transmission of a
+ *          packet to the reception of the address of its acknowledgement. The wait for the
+ *          acknowledgement is measured with NRF_ESB_SYS_TIMER, and the time on air of the packet,
+ *          the radio ramp-up times and the retransmit delays are added to it.
+ */
+typedef struct
+{
+    nrf_esb_pipe_stats_t    pipes[8];                                       /**< Statistics of each pipe. */
+    uint32_t                latency_histogram[NRF_ESB_LATENCY_HISTOGRAM_BINS]; /**< PTX: acknowledged transactions by latency. Bin i counts the latencies from i * NRF_ESB_LATENCY_BIN_WIDTH_US, the last bin also counts the longer ones. */
+    uint32_t                latency_max_us;                                 /**< PTX: longest latency of an acknowledged transaction, in microseconds. */
+} nrf_esb_stats_t;
+
+
 /**@brief Function for initializing the Enhanced ShockBurst module.
  *
  * @param  p_config     Parameters for initializing the module.
@@ -294,6 +398,7 @@ typedef struct
  * @retval  NRF_SUCCESS             Initialization successful.
  * @retval  NRF_ERROR_NULL          The argument parameters was NULL.
  * @retval  NRF_ERROR_BUSY          Function failed because radio is busy.
+ * @retval  NRF_ERROR_NOT_SUPPORTED Fast ramp-up was requested on a device which does not support it.
  */
 uint32_t nrf_esb_init(nrf_esb_config_t const * p_config);
 
@@ -332,11 +437,18 @@ bool nrf_esb_is_idle(void);
  * payload will be queued for for a regular transmission. When the module is in PRX mode, the payload
  * will be queued for when a packet is received with ack with payload.
  *
+ * In PRX mode, each pipe has its own queue of ACK payloads, so the payloads of a pipe are sent as
+ * soon as that pipe receives a packet, whatever is queued for the other pipes. The queues share the
+ * NRF_ESB_TX_FIFO_SIZE entries of the TX FIFO, and the number of entries one pipe can use is
+ * limited by @ref nrf_esb_set_ack_payload_quota.
+ *
  * @param[in]   p_payload     Pointer to structure containing information and state of payload.
  *
  * @retval  NRF_SUCCESS                     Payload was successfully queued up for writing.
  * @retval  NRF_ERROR_NULL                  Required parameter was NULL.
  * @retval  NRF_INVALID_STATE               Module is not initialized.
+ * @retval  NRF_ERROR_INVALID_PARAM         Invalid pipe number given.
+ * @retval  NRF_ERROR_NO_MEM                The TX FIFO, or in PRX mode the queue of the pipe, is full.
  * @retval  NRF_ERROR_NOT_SUPPORTED         p_payload->noack was false while selective ack was not enabled.
  * @retval  NRF_ERROR_INVALID_LENGTH        Payload length was invalid (zero or larger than max allowed).
  */
@@ -350,10 +462,31 @@ uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload);
  * @retval  NRF_SUCCESS                     Data read successfully.
  * @retval  NRF_ERROR_NULL                  Required parameter was NULL.
  * @retval  NRF_INVALID_STATE               Module is not initialized.
+ * @retval  NRF_ERROR_NOT_FOUND             No payload in the RX FIFO.
  */
 uint32_t nrf_esb_read_rx_payload(nrf_esb_payload_t * p_payload);
 
 
+/**@brief Function to read several RX payloads.
+ *
+ * Function for reading up to max_count payloads from the RX FIFO in one call, for example to read
+ * all the packets received since the last @ref NRF_ESB_EVENT_RX_RECEIVED event. Only the received
+ * data of each payload is copied, and the radio interrupt is only disabled to update the FIFO.
+ *
+ * @param[out]  p_payloads  Pointer to an array of at least max_count payloads.
+ * @param[in]   max_count   Maximum number of payloads to read.
+ * @param[out]  p_count     Number of payloads read.
+ *
+ * @retval  NRF_SUCCESS                     At least one payload was read.
+ * @retval  NRF_ERROR_NULL                  Required parameter was NULL.
+ * @retval  NRF_INVALID_STATE               Module is not initialized.
+ * @retval  NRF_ERROR_NOT_FOUND             No payload in the RX FIFO.
+ */
+uint32_t nrf_esb_read_rx_payloads(nrf_esb_payload_t * p_payloads,
+                                  uint32_t            max_count,
+                                  uint32_t          * p_count);
+
+
 /**@brief Function to start transmitting.
  *
  * @retval  NRF_SUCCESS                     TX started successfully.
@@ -391,6 +524,8 @@ uint32_t nrf_esb_flush_tx(void);
 
 
 /**@brief Function to remove the first items from the TX buffer.
+ *
+ * @note In PRX mode, the first ACK payload of the lowest numbered pipe with queued payloads is removed.
  *
  * @retval  NRF_SUCCESS                     Call was successful.
  * @retval  NRF_INVALID_STATE               Module is not initialized.
@@ -399,6 +534,24 @@ uint32_t nrf_esb_flush_tx(void);
 uint32_t nrf_esb_pop_tx(void);
 
 
+/**@brief Function to set the maximum number of ACK payloads queued for a pipe in PRX mode.
+ *
+ * @details     Limiting the number of entries of the TX FIFO a pipe can use keeps entries available
+ *              for the other pipes, so a pipe with a lot of ACK payload data can not prevent
+ *              payloads from being queued for the others. The quota of each pipe is set to
+ *              @ref NRF_ESB_ACK_PAYLOAD_QUOTA by @ref nrf_esb_init. Payloads already queued are
+ *              not removed if the quota is lowered.
+ *
+ * @param   pipe    Pipe to set the quota for.
+ * @param   quota   Maximum number of queued ACK payloads, from 1 to NRF_ESB_TX_FIFO_SIZE.
+ *
+ * @retval  NRF_SUCCESS                     Call was successful.
+ * @retval  NRF_INVALID_STATE               Module is not initialized.
+ * @retval  NRF_ERROR_INVALID_PARAM         Invalid pipe number or quota given.
+ */
+uint32_t nrf_esb_set_ack_payload_quota(uint8_t pipe, uint8_t quota);
+
+
 /**@brief Function to remove remaining items from the RX buffer.
  *
  * @retval  NRF_SUCCESS                     Pending items in the RX buffer was successfully cleared.
@@ -517,6 +670,70 @@ uint32_t nrf_esb_set_rf_channel(uint32_t channel);
 uint32_t nrf_esb_rf_channel_get(uint32_t * p_channel);
 
 
+/**@brief Function to set the channel hopping table.
+ *
+ * @details The statistics of all the channels are cleared, and the first channel of the table is
+ *          used. Channel hopping is disabled by @ref nrf_esb_init, so this function must be called
+ *          after it.
+ *
+ * @note The module has to be in an idle state to call this function.
+ *
+ * @param[in]   p_config                        Channel hopping configuration.
+ *
+ * @retval  NRF_SUCCESS                         Call was successful.
+ * @retval  NRF_ERROR_NULL                      Required parameter was NULL.
+ * @retval  NRF_ERROR_BUSY                      Module was not in idle state.
+ * @retval  NRF_ERROR_INVALID_PARAM             Invalid channel or parameter given.
+ * @retval  NRF_ERROR_NOT_SUPPORTED             NRF_ESB_CHANNEL_TABLE_MAX_SIZE is 0.
+ */
+uint32_t nrf_esb_set_channel_hopping(nrf_esb_channel_hopping_config_t const * p_config);
+
+
+/**@brief Function to get the statistics of a channel of the channel hopping table.
+ *
+ * @param[in]   index                           Index of the channel in the table.
+ * @param[out]  p_stats                         Pointer to the statistics.
+ *
+ * @retval  NRF_SUCCESS                         Call was successful.
+ * @retval  NRF_ERROR_NULL                      Required parameter was NULL.
+ * @retval  NRF_ERROR_INVALID_PARAM             Index is outside the channel table.
+ */
+uint32_t nrf_esb_channel_stats_get(uint8_t index, nrf_esb_channel_stats_t * p_stats);
+
+
+/**@brief Function to clear the statistics of all the channels of the channel hopping table.
+ *
+ * @details Channels which are skipped are used again.
+ *
+ * @retval  NRF_SUCCESS                         Call was successful.
+ */
+uint32_t nrf_esb_channel_stats_clear(void);
+
+
+/**@brief Function to get the link statistics.
+ *
+ * @details The statistics are counted from @ref nrf_esb_init, or from the last time they were
+ *          cleared. The snapshot and the clearing are done without the radio interrupt in between,
+ *          so no event is lost when clearing.
+ *
+ * @param[out]  p_stats                         Pointer to the statistics.
+ * @param[in]   clear                           True to clear the statistics after reading them.
+ *
+ * @retval  NRF_SUCCESS                         Call was successful.
+ * @retval  NRF_ERROR_NULL                      Required parameter was NULL.
+ * @retval  NRF_ERROR_NOT_SUPPORTED             NRF_ESB_STATS_ENABLED is 0.
+ */
+uint32_t nrf_esb_stats_get(nrf_esb_stats_t * p_stats, bool clear);
+
+
+/**@brief Function to clear the link statistics.
+ *
+ * @retval  NRF_SUCCESS                         Call was successful.
+ * @retval  NRF_ERROR_NOT_SUPPORTED             NRF_ESB_STATS_ENABLED is 0.
+ */
+uint32_t nrf_esb_stats_clear(void);
+
+
 /**@brief Function to set the radio output power.
  *
  * @param[in]   tx_output_power    Output power.
@@ -120,5 +120,13 @@
  */
 #define GZP_MAX_ACK_PAYLOAD_LENGTH 10  
 
+/**
+  Forward the packets of the pipes not used by pairing to nrf_gzll_host_buffer
+  on the Host.
+ */
+#ifndef GZP_HOST_BUFFER_ENABLED
+#define GZP_HOST_BUFFER_ENABLED 0
+#endif
+
 
 #endif 
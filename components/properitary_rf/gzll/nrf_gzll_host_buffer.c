@@ -0,0 +1,331 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "nrf_gzll_host_buffer.h"
+#include <string.h>
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+#define PIPE_COUNT      NRF_GZLL_CONST_PIPE_COUNT
+#define RX_QUEUE_MASK   (NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE - 1)
+#define TX_NONE         0xFF    ///< End of a list of the ACK payload pool.
+
+// The RX queue is indexed with free-running 8-bit counters.
+STATIC_ASSERT((NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE & RX_QUEUE_MASK) == 0);
+STATIC_ASSERT(NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE <= 128);
+STATIC_ASSERT(NRF_GZLL_HOST_BUFFER_TX_POOL_SIZE < TX_NONE);
+STATIC_ASSERT((NRF_GZLL_HOST_BUFFER_TX_FIFO_DEPTH >= 1) &&
+              (NRF_GZLL_HOST_BUFFER_TX_FIFO_DEPTH <= NRF_GZLL_CONST_FIFO_LENGTH));
+
+typedef struct
+{
+    uint8_t next;                                       ///< Next entry of the list.
+    uint8_t length;                                     ///< Length of the payload.
+    uint8_t payload[NRF_GZLL_CONST_MAX_PAYLOAD_LENGTH]; ///< Payload.
+} tx_entry_t;
+
+typedef struct
+{
+    uint32_t                      pipes;                                        ///< Pipes handled by the module.
+    nrf_gzll_host_buffer_packet_t rx_queue[NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE]; ///< Received packets.
+    volatile uint8_t              rx_write;                                     ///< RX queue write counter, written in the Gazell callback.
+    volatile uint8_t              rx_read;                                      ///< RX queue read counter, written by the reader.
+    volatile uint8_t              rx_pipe_in[PIPE_COUNT];                       ///< Packets of each pipe put in the RX queue.
+    volatile uint8_t              rx_pipe_out[PIPE_COUNT];                      ///< Packets of each pipe read from the RX queue.
+    volatile uint8_t              rx_held_mask;                                 ///< Pipes with packets left in the Gazell RX FIFO.
+    tx_entry_t                    tx_pool[NRF_GZLL_HOST_BUFFER_TX_POOL_SIZE];   ///< ACK payloads.
+    uint8_t                       tx_free;                                      ///< First free entry of the pool.
+    uint8_t                       tx_head[PIPE_COUNT];                          ///< First ACK payload of each pipe.
+    uint8_t                       tx_tail[PIPE_COUNT];                          ///< Last ACK payload of each pipe.
+    uint8_t                       tx_count[PIPE_COUNT];                         ///< Number of ACK payloads of each pipe in the pool.
+    nrf_gzll_host_buffer_stats_t  stats[PIPE_COUNT];                            ///< Statistics of each pipe.
+} gzll_host_buffer_t;
+
+static gzll_host_buffer_t m_buffer;
+
+
+static bool pipe_handled(uint32_t pipe)
+{
+    return (pipe < PIPE_COUNT) && ((m_buffer.pipes & (1UL << pipe)) != 0);
+}
+
+
+/**@brief Function for moving packets from the Gazell RX FIFO of a pipe to the RX queue.
+ *
+ * @details Called from the Gazell callback, or by the reader in a critical region.
+ */
+static void rx_fifo_drain(uint32_t pipe)
+{
+    nrf_gzll_host_buffer_stats_t * p_stats = &m_buffer.stats[pipe];
+
+    while (nrf_gzll_get_rx_fifo_packet_count(pipe) > 0)
+    {
+        uint8_t const  write  = m_buffer.rx_write;
+        uint8_t const  queued = (uint8_t)(m_buffer.rx_pipe_in[pipe] - m_buffer.rx_pipe_out[pipe]);
+        uint32_t       length = NRF_GZLL_CONST_MAX_PAYLOAD_LENGTH;
+
+        if (((uint8_t)(write - m_buffer.rx_read) == NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE) ||
+            (queued >= NRF_GZLL_HOST_BUFFER_RX_PIPE_LIMIT))
+        {
+            // The packets wait in the Gazell RX FIFO. When it is full, the Device retransmits.
+            m_buffer.rx_held_mask |= (1UL << pipe);
+            p_stats->rx_held++;
+            return;
+        }
+
+        nrf_gzll_host_buffer_packet_t * p_packet = &m_buffer.rx_queue[write & RX_QUEUE_MASK];
+
+        if (!nrf_gzll_fetch_packet_from_rx_fifo(pipe, p_packet->payload, &length))
+        {
+            break;
+        }
+        p_packet->pipe   = (uint8_t)pipe;
+        p_packet->length = (uint8_t)length;
+        p_packet->rssi   = p_stats->rssi;
+
+        m_buffer.rx_pipe_in[pipe]++;
+        m_buffer.rx_write = write + 1;
+
+        p_stats->rx_packets++;
+        p_stats->rx_bytes += length;
+        if (queued + 1 > p_stats->rx_queued_max)
+        {
+            p_stats->rx_queued_max = queued + 1;
+        }
+    }
+
+    m_buffer.rx_held_mask &= ~(1UL << pipe);
+}
+
+
+/**@brief Function for moving ACK payloads of a pipe from the pool to the Gazell TX FIFO.
+ *
+ * @details Called in a critical region, or from the Gazell callback.
+ */
+static void tx_fifo_refill(uint32_t pipe)
+{
+    while ((m_buffer.tx_head[pipe] != TX_NONE) &&
+           (nrf_gzll_get_tx_fifo_packet_count(pipe) < NRF_GZLL_HOST_BUFFER_TX_FIFO_DEPTH))
+    {
+        uint8_t const      index   = m_buffer.tx_head[pipe];
+        tx_entry_t * const p_entry = &m_buffer.tx_pool[index];
+
+        if (!nrf_gzll_add_packet_to_tx_fifo(pipe, p_entry->payload, p_entry->length))
+        {
+            // No Gazell packets are free. The payload is added after the next packet.
+            break;
+        }
+
+        m_buffer.tx_head[pipe] = p_entry->next;
+        if (m_buffer.tx_head[pipe] == TX_NONE)
+        {
+            m_buffer.tx_tail[pipe] = TX_NONE;
+        }
+        m_buffer.tx_count[pipe]--;
+
+        p_entry->next    = m_buffer.tx_free;
+        m_buffer.tx_free = index;
+    }
+}
+
+
+void nrf_gzll_host_buffer_init(uint32_t pipes)
+{
+    memset(&m_buffer, 0, sizeof(m_buffer));
+    m_buffer.pipes = pipes;
+
+    for (uint32_t i = 0; i < NRF_GZLL_HOST_BUFFER_TX_POOL_SIZE; i++)
+    {
+        m_buffer.tx_pool[i].next = (i + 1 < NRF_GZLL_HOST_BUFFER_TX_POOL_SIZE) ? (i + 1) : TX_NONE;
+    }
+    m_buffer.tx_free = 0;
+
+    for (uint32_t pipe = 0; pipe < PIPE_COUNT; pipe++)
+    {
+        m_buffer.tx_head[pipe] = TX_NONE;
+        m_buffer.tx_tail[pipe] = TX_NONE;
+    }
+}
+
+
+void nrf_gzll_host_buffer_on_rx(uint32_t pipe, nrf_gzll_host_rx_info_t rx_info)
+{
+    if (!pipe_handled(pipe))
+    {
+        return;
+    }
+
+    m_buffer.stats[pipe].rssi = rx_info.rssi;
+    if (rx_info.packet_removed_from_tx_fifo)
+    {
+        m_buffer.stats[pipe].ack_payloads_sent++;
+    }
+
+    rx_fifo_drain(pipe);
+
+    CRITICAL_REGION_ENTER();
+    tx_fifo_refill(pipe);
+    CRITICAL_REGION_EXIT();
+}
+
+
+uint32_t nrf_gzll_host_buffer_read(nrf_gzll_host_buffer_packet_t * p_packets, uint32_t max_count)
+{
+    uint32_t count = 0;
+    uint8_t  read  = m_buffer.rx_read;
+
+    while ((count < max_count) && (read != m_buffer.rx_write))
+    {
+        nrf_gzll_host_buffer_packet_t const * p_packet = &m_buffer.rx_queue[read & RX_QUEUE_MASK];
+
+        p_packets[count++] = *p_packet;
+        m_buffer.rx_pipe_out[p_packet->pipe]++;
+        m_buffer.rx_read = ++read;
+    }
+
+    if ((count != 0) && (m_buffer.rx_held_mask != 0))
+    {
+        // Packets left in the Gazell RX FIFOs are only moved when the next packet arrives, which
+        // may not happen if the FIFO of the Device is full.
+        for (uint32_t pipe = 0; pipe < PIPE_COUNT; pipe++)
+        {
+            if (m_buffer.rx_held_mask & (1UL << pipe))
+            {
+                CRITICAL_REGION_ENTER();
+                rx_fifo_drain(pipe);
+                CRITICAL_REGION_EXIT();
+            }
+        }
+    }
+
+    return count;
+}
+
+
+uint32_t nrf_gzll_host_buffer_rx_count(void)
+{
+    return (uint8_t)(m_buffer.rx_write - m_buffer.rx_read);
+}
+
+
+uint32_t nrf_gzll_host_buffer_ack_payloads_add(uint32_t                              pipe,
+                                               nrf_gzll_host_buffer_packet_t const * p_payloads,
+                                               uint32_t                              count)
+{
+    uint32_t added = 0;
+
+    if (!pipe_handled(pipe))
+    {
+        return 0;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    while ((added < count) &&
+           (m_buffer.tx_free != TX_NONE) &&
+           (p_payloads[added].length <= NRF_GZLL_CONST_MAX_PAYLOAD_LENGTH))
+    {
+        uint8_t const      index   = m_buffer.tx_free;
+        tx_entry_t * const p_entry = &m_buffer.tx_pool[index];
+
+        m_buffer.tx_free = p_entry->next;
+
+        p_entry->next   = TX_NONE;
+        p_entry->length = p_payloads[added].length;
+        memcpy(p_entry->payload, p_payloads[added].payload, p_entry->length);
+
+        if (m_buffer.tx_tail[pipe] == TX_NONE)
+        {
+            m_buffer.tx_head[pipe] = index;
+        }
+        else
+        {
+            m_buffer.tx_pool[m_buffer.tx_tail[pipe]].next = index;
+        }
+        m_buffer.tx_tail[pipe] = index;
+        m_buffer.tx_count[pipe]++;
+        added++;
+    }
+
+    m_buffer.stats[pipe].ack_payloads_lost += count - added;
+    tx_fifo_refill(pipe);
+
+    CRITICAL_REGION_EXIT();
+
+    return added;
+}
+
+
+void nrf_gzll_host_buffer_ack_payloads_flush(uint32_t pipe)
+{
+    if (!pipe_handled(pipe))
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    while (m_buffer.tx_head[pipe] != TX_NONE)
+    {
+        uint8_t const index = m_buffer.tx_head[pipe];
+
+        m_buffer.tx_head[pipe]       = m_buffer.tx_pool[index].next;
+        m_buffer.tx_pool[index].next = m_buffer.tx_free;
+        m_buffer.tx_free             = index;
+    }
+    m_buffer.tx_tail[pipe] = TX_NONE;
+    m_buffer.stats[pipe].ack_payloads_lost += m_buffer.tx_count[pipe];
+    m_buffer.tx_count[pipe] = 0;
+
+    CRITICAL_REGION_EXIT();
+
+    // The Gazell TX FIFO can only be flushed while Gazell is disabled.
+    if (!nrf_gzll_is_enabled())
+    {
+        int32_t const in_fifo = nrf_gzll_get_tx_fifo_packet_count(pipe);
+
+        if ((in_fifo > 0) && nrf_gzll_flush_tx_fifo(pipe))
+        {
+            m_buffer.stats[pipe].ack_payloads_lost += (uint32_t)in_fifo;
+        }
+    }
+}
+
+
+uint32_t nrf_gzll_host_buffer_ack_payloads_count(uint32_t pipe)
+{
+    int32_t in_fifo;
+
+    if (!pipe_handled(pipe))
+    {
+        return 0;
+    }
+
+    in_fifo = nrf_gzll_get_tx_fifo_packet_count(pipe);
+
+    return m_buffer.tx_count[pipe] + ((in_fifo > 0) ? (uint32_t)in_fifo : 0);
+}
+
+
+void nrf_gzll_host_buffer_stats_get(uint32_t pipe, nrf_gzll_host_buffer_stats_t * p_stats)
+{
+    if (pipe < PIPE_COUNT)
+    {
+        *p_stats = m_buffer.stats[pipe];
+    }
+}
+
+
+void nrf_gzll_host_buffer_stats_reset(void)
+{
+    memset(m_buffer.stats, 0, sizeof(m_buffer.stats));
+}
@@ -0,0 +1,167 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef NRF_GZLL_HOST_BUFFER_H__
+#define NRF_GZLL_HOST_BUFFER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_gzll.h"
+#include "nrf_gzll_constants.h"
+
+/**
+ * @defgroup nrf_gzll_host_buffer Gazell Host buffering
+ * @{
+ * @ingroup gzll_02_api
+ *
+ * @brief Module for buffering the packets of many Devices on a Gazell Host.
+ *
+ * @details The Gazell FIFOs hold @ref NRF_GZLL_CONST_FIFO_LENGTH packets per pipe, but all pipes
+ *          share @ref NRF_GZLL_CONST_MAX_TOTAL_PACKETS packets. A Device whose received packets
+ *          are not fetched, or whose ACK payloads fill its TX FIFO, uses packets that the other
+ *          Devices need, so that their transmissions are not acknowledged.
+ *
+ *          The module moves received packets from the Gazell RX FIFOs to a larger queue as soon
+ *          as they arrive. The application reads them in batches. ACK payloads are queued in a
+ *          shared pool, and only @ref NRF_GZLL_HOST_BUFFER_TX_FIFO_DEPTH of them per pipe are
+ *          kept in the Gazell TX FIFO. When a payload has been sent, the next one is added.
+ *
+ *          Each pipe can hold at most @ref NRF_GZLL_HOST_BUFFER_RX_PIPE_LIMIT packets of the RX
+ *          queue, so that a Device sending continuously does not take the space of a keyboard.
+ *          Packets of a pipe that reached the limit stay in the Gazell RX FIFO until the
+ *          application reads the queue. When that FIFO is full, the Host stops acknowledging the
+ *          Device, which retransmits later, so no packet is lost.
+ *
+ *          Call @ref nrf_gzll_host_buffer_on_rx from @ref nrf_gzll_host_rx_data_ready. When
+ *          Gazell Pairing is used on the Host, nrf_gzp_host.c implements the callback, and
+ *          forwards the pipes that it does not use when GZP_HOST_BUFFER_ENABLED is set.
+ */
+
+#ifndef NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE
+#define NRF_GZLL_HOST_BUFFER_RX_QUEUE_SIZE  32  /**< Number of packets in the RX queue, shared by all pipes. Must be a power of two, at most 128. */
+#endif
+
+#ifndef NRF_GZLL_HOST_BUFFER_RX_PIPE_LIMIT
+#define NRF_GZLL_HOST_BUFFER_RX_PIPE_LIMIT  16  /**< Maximum number of packets of one pipe in the RX queue. */
+#endif
+
+#ifndef NRF_GZLL_HOST_BUFFER_TX_POOL_SIZE
+#define NRF_GZLL_HOST_BUFFER_TX_POOL_SIZE   16  /**< Number of ACK payloads that can be queued, shared by all pipes. At most 255. */
+#endif
+
+#ifndef NRF_GZLL_HOST_BUFFER_TX_FIFO_DEPTH
+#define NRF_GZLL_HOST_BUFFER_TX_FIFO_DEPTH  1   /**< Number of queued ACK payloads of a pipe kept in the Gazell TX FIFO, from 1 to @ref NRF_GZLL_CONST_FIFO_LENGTH. */
+#endif
+
+/**
+ * @brief Packet of the RX queue, or ACK payload.
+ */
+typedef struct
+{
+    uint8_t pipe;                                       ///< Pipe of the packet. Not used for ACK payloads.
+    uint8_t length;                                     ///< Length of the payload.
+    int16_t rssi;                                       ///< RSSI of the received packet in dBm, when RSSI is enabled. Not used for ACK payloads.
+    uint8_t payload[NRF_GZLL_CONST_MAX_PAYLOAD_LENGTH]; ///< Payload.
+} nrf_gzll_host_buffer_packet_t;
+
+/**
+ * @brief Statistics of a pipe, that is, of a Device.
+ */
+typedef struct
+{
+    uint32_t rx_packets;        ///< Number of packets received.
+    uint32_t rx_bytes;          ///< Number of payload bytes received.
+    uint32_t rx_held;           ///< Number of times packets were left in the Gazell RX FIFO because the pipe reached its limit or the queue was full.
+    uint32_t ack_payloads_sent; ///< Number of ACK payloads sent.
+    uint32_t ack_payloads_lost; ///< Number of ACK payloads not queued because the pool was full, or flushed.
+    uint16_t rx_queued_max;     ///< Largest number of packets of the pipe in the RX queue.
+    int16_t  rssi;              ///< RSSI of the last packet in dBm, when RSSI is enabled.
+} nrf_gzll_host_buffer_stats_t;
+
+/**
+ * @brief Function for initializing the module.
+ *
+ * Call the function before Gazell is enabled.
+ *
+ * @param pipes Bit mask of the pipes handled by the module.
+ */
+void nrf_gzll_host_buffer_init(uint32_t pipes);
+
+/**
+ * @brief Function for handling a received packet. Call it from @ref nrf_gzll_host_rx_data_ready.
+ *
+ * @param pipe    Pipe of the packet.
+ * @param rx_info Information from Gazell.
+ */
+void nrf_gzll_host_buffer_on_rx(uint32_t pipe, nrf_gzll_host_rx_info_t rx_info);
+
+/**
+ * @brief Function for reading received packets, in the order in which they were received.
+ *
+ * @param[out] p_packets Packets.
+ * @param      max_count Maximum number of packets to read.
+ *
+ * @return Number of packets read.
+ */
+uint32_t nrf_gzll_host_buffer_read(nrf_gzll_host_buffer_packet_t * p_packets, uint32_t max_count);
+
+/**
+ * @brief Function for getting the number of packets in the RX queue.
+ */
+uint32_t nrf_gzll_host_buffer_rx_count(void);
+
+/**
+ * @brief Function for queuing ACK payloads for a pipe.
+ *
+ * The payloads are sent in order, one in each ACK to the Device.
+ *
+ * @param     pipe       Pipe.
+ * @param[in] p_payloads Payloads. Only the length and payload fields are used.
+ * @param     count      Number of payloads.
+ *
+ * @return Number of payloads queued. The rest did not fit in the pool.
+ */
+uint32_t nrf_gzll_host_buffer_ack_payloads_add(uint32_t                              pipe,
+                                               nrf_gzll_host_buffer_packet_t const * p_payloads,
+                                               uint32_t                              count);
+
+/**
+ * @brief Function for discarding the ACK payloads of a pipe, including those in the Gazell TX
+ *        FIFO. Call it, for example, when the Device is paired again.
+ *
+ * @param pipe Pipe.
+ */
+void nrf_gzll_host_buffer_ack_payloads_flush(uint32_t pipe);
+
+/**
+ * @brief Function for getting the number of ACK payloads of a pipe that were not sent yet.
+ *
+ * @param pipe Pipe.
+ */
+uint32_t nrf_gzll_host_buffer_ack_payloads_count(uint32_t pipe);
+
+/**
+ * @brief Function for getting the statistics of a pipe.
+ *
+ * @param      pipe    Pipe.
+ * @param[out] p_stats Statistics.
+ */
+void nrf_gzll_host_buffer_stats_get(uint32_t pipe, nrf_gzll_host_buffer_stats_t * p_stats);
+
+/**
+ * @brief Function for clearing the statistics of all pipes.
+ */
+void nrf_gzll_host_buffer_stats_reset(void);
+
+/** @} */
+
+#endif // NRF_GZLL_HOST_BUFFER_H__
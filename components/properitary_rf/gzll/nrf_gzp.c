@@ -71,6 +71,14 @@ static gzp_key_select_t gzp_key_select;
 static uint8_t gzp_session_token[GZP_SESSION_TOKEN_LENGTH];
 static uint8_t gzp_dyn_key[GZP_DYN_KEY_LENGTH];
 
+/**
+ * Cached keystream block, the session token encrypted with the key of
+ * "gzp_keystream_key_select". Valid until the session token or the dynamic key changes.
+ */
+static uint8_t gzp_keystream[16];
+static gzp_key_select_t gzp_keystream_key_select;
+static bool gzp_keystream_valid = false;
+
 /** @} */
 
 /******************************************************************************/
@@ -196,11 +204,13 @@ void gzp_add_validation_id(uint8_t* dst)
 void gzp_crypt_set_session_token(const uint8_t * token)
 {
     memcpy(gzp_session_token, (void const*)token, GZP_SESSION_TOKEN_LENGTH);
+    gzp_keystream_valid = false;
 }
 
 void gzp_crypt_set_dyn_key(const uint8_t* key)
 {
     memcpy(gzp_dyn_key, (void const*)key, GZP_DYN_KEY_LENGTH); 
+    gzp_keystream_valid = false;
 }
 
 void gzp_crypt_get_session_token(uint8_t * dst_token)
@@ -218,15 +228,25 @@ void gzp_crypt_select_key(gzp_key_select_t key_select)
     gzp_key_select = key_select;
 }
 
-void gzp_crypt(uint8_t* dst, const uint8_t* src, uint8_t length)
+/**
+ * Compute the keystream block for a key-set: the session token, padded with zeros,
+ * encrypted with AES ECB.
+ *
+ * @param key_select Key-set to use.
+ * @param dst Destination to write the 16 byte keystream block to.
+ *
+ * @retval true if the keystream block was computed.
+ * @retval false if key_select is not a valid key-set.
+ */
+static bool gzp_crypt_keystream_compute(gzp_key_select_t key_select, uint8_t* dst)
 {
     uint8_t i;
     uint8_t key[16];
-    uint8_t iv[16];
+    uint8_t* iv = dst;
 
     // Build AES key based on "gzp_key_select"
 
-    switch(gzp_key_select)
+    switch(key_select)
     {
     case GZP_ID_EXCHANGE:
         memcpy(key, (void const*)gzp_secret_key, 16);
@@ -240,7 +260,7 @@ void gzp_crypt(uint8_t* dst, const uint8_t* src, uint8_t length)
         memcpy(key, (void const*)gzp_dyn_key, GZP_DYN_KEY_LENGTH);
         break;
     default:
-        return;
+        return false;
     }  
 
     // Build init vector from "gzp_session_token"
@@ -264,9 +284,45 @@ void gzp_crypt(uint8_t* dst, const uint8_t* src, uint8_t length)
     // Encrypt IV using ECB mode
     (void)nrf_ecb_crypt(iv, iv);
 
-    // Encrypt data by XOR'ing with AES output
-    gzp_xor_cipher(dst, src, iv, length);
+    return true;
+}
+
+void gzp_crypt_prepare(void)
+{
+    // The "key exchange" key-set depends on the Host ID and is only used once per key
+    // update, so it is not cached.
+    if(gzp_key_select == GZP_KEY_EXCHANGE)
+    {
+        return;
+    }
 
+    if(!gzp_keystream_valid || (gzp_keystream_key_select != gzp_key_select))
+    {
+        gzp_keystream_valid = gzp_crypt_keystream_compute(gzp_key_select, gzp_keystream);
+        gzp_keystream_key_select = gzp_key_select;
+    }
+}
+
+void gzp_crypt(uint8_t* dst, const uint8_t* src, uint8_t length)
+{
+    uint8_t pad[16];
+
+    if(gzp_key_select == GZP_KEY_EXCHANGE)
+    {
+        if(gzp_crypt_keystream_compute(gzp_key_select, pad))
+        {
+            gzp_xor_cipher(dst, src, pad, length);
+        }
+        return;
+    }
+
+    // Encrypt data by XOR'ing with AES output, computed only if the session token,
+    // key-set or dynamic key changed since the last call.
+    gzp_crypt_prepare();
+    if(gzp_keystream_valid)
+    {
+        gzp_xor_cipher(dst, src, gzp_keystream, length);
+    }
 }
 
 void gzp_random_numbers_generate(uint8_t * dst, uint8_t n)
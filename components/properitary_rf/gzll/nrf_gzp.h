@@ -288,6 +288,9 @@ void gzp_crypt_select_key(gzp_key_select_t key_select);
  *  AES is a symmetric encryption scheme, this function can be used
  * to perform both encryption and decryption.
  *
+ * The AES output only depends on the session token and the key-set, so it is
+ * computed once and reused until one of them changes, see gzp_crypt_prepare().
+ *
  * @param dst Destination to write encrypted data to. Should be 16 bytes long.
  * @param src Source data to encrypt.
  * @param length Length in bytes of src.
@@ -295,6 +298,16 @@ void gzp_crypt_select_key(gzp_key_select_t key_select);
 void gzp_crypt(uint8_t* dst, const uint8_t* src, uint8_t length);
 
 
+/**
+ * Compute the AES output used by gzp_crypt() for the current session token and
+ * key-set, if it is not computed yet.
+ *
+ * Calling this function when a new session token has been set moves the AES
+ * operation out of the next call to gzp_crypt().
+ */
+void gzp_crypt_prepare(void);
+
+
 /**
  * Compare the *src_id with a pre-defined validation ID.
  *
@@ -511,6 +524,21 @@ gzp_id_req_res_t gzp_id_req_send(void);
 */
 bool gzp_crypt_data_send(const uint8_t *src, uint8_t length);
 
+/**
+  Function for sending several encrypted user data packets to the Host.
+
+  The packets are sent in order as by gzp_crypt_data_send(), but the Gazell
+  Link Layer is only reconfigured for the pairing transactions once for all of
+  them. The sending stops at the first packet which fails.
+
+  @param src is an array of pointers to the data packets to be sent.
+  @param length is an array of the lengths of the data packets to be sent.
+  @param count is the number of data packets to be sent.
+
+  @return Number of data packets successfully transmitted and decrypted by the Host.
+*/
+uint8_t gzp_crypt_data_send_multiple(const uint8_t * const *src, const uint8_t *length, uint8_t count);
+
 
 /**
 @name Host functions
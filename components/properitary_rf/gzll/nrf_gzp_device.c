@@ -91,6 +91,7 @@ static uint8_t gzp_system_address[GZP_SYSTEM_ADDRESS_WIDTH]; ///<
 static uint8_t gzp_host_id[GZP_HOST_ID_LENGTH];              ///<
 static uint8_t dyn_key[GZP_DYN_KEY_LENGTH];
 static bool gzp_id_req_pending = false;
+static bool gzp_tx_rx_session_active = false; ///< Gazell is already set up for pairing transactions, see gzp_crypt_data_send_multiple().
 
 /** @} */
 
@@ -538,6 +539,38 @@ bool gzp_crypt_data_send(const uint8_t *src, uint8_t length)
     }
 }
 
+uint8_t gzp_crypt_data_send_multiple(const uint8_t * const *src, const uint8_t *length, uint8_t count)
+{
+    uint8_t sent;
+    uint32_t temp_lifetime;
+
+    // Set up Gazell for the transactions once for all the packets
+    (void)nrf_gzll_disable();
+    while(nrf_gzll_is_enabled())
+    {}
+    temp_lifetime = nrf_gzll_get_sync_lifetime();
+    (void)nrf_gzll_set_sync_lifetime(GZP_TX_RX_TRANS_DELAY * 3); // 3 = RXPERIOD * 2 + margin
+    (void)nrf_gzll_enable();
+    gzp_tx_rx_session_active = true;
+
+    for(sent = 0; sent < count; sent++)
+    {
+        if(!gzp_crypt_data_send(src[sent], length[sent]))
+        {
+            break;
+        }
+    }
+
+    gzp_tx_rx_session_active = false;
+    (void)nrf_gzll_disable();
+    while(nrf_gzll_is_enabled())
+    {}
+    (void)nrf_gzll_set_sync_lifetime(temp_lifetime);
+    (void)nrf_gzll_enable();
+
+    return sent;
+}
+
 #endif
 /** @} */
 
@@ -573,18 +606,21 @@ static gzp_tx_rx_trans_result_t gzp_tx_rx_transaction(const uint8_t *tx_packet,
     bool tx_packet_success;
     bool fetch_success;
     uint32_t local_rx_length = GZP_MAX_ACK_PAYLOAD_LENGTH;
-    uint32_t temp_lifetime;
+    uint32_t temp_lifetime = 0;
 
     nrf_gzp_flush_rx_fifo(pipe);
 
     retval = GZP_TX_RX_FAILED_TO_SEND;
     
-    (void)nrf_gzll_disable();
-    while(nrf_gzll_is_enabled())
-    {}
-    temp_lifetime = nrf_gzll_get_sync_lifetime();
-    (void)nrf_gzll_set_sync_lifetime(GZP_TX_RX_TRANS_DELAY * 3); // 3 = RXPERIOD * 2 + margin
-    (void)nrf_gzll_enable();
+    if(!gzp_tx_rx_session_active)
+    {
+        (void)nrf_gzll_disable();
+        while(nrf_gzll_is_enabled())
+        {}
+        temp_lifetime = nrf_gzll_get_sync_lifetime();
+        (void)nrf_gzll_set_sync_lifetime(GZP_TX_RX_TRANS_DELAY * 3); // 3 = RXPERIOD * 2 + margin
+        (void)nrf_gzll_enable();
+    }
         
     tx_packet_success = gzp_tx_packet(tx_packet, tx_length, pipe);
     
@@ -627,11 +663,14 @@ static gzp_tx_rx_trans_result_t gzp_tx_rx_transaction(const uint8_t *tx_packet,
         }
     }
     
-    (void)nrf_gzll_disable();
-    while(nrf_gzll_is_enabled())
-    {}
-    (void)nrf_gzll_set_sync_lifetime(temp_lifetime);
-    (void)nrf_gzll_enable();
+    if(!gzp_tx_rx_session_active)
+    {
+        (void)nrf_gzll_disable();
+        while(nrf_gzll_is_enabled())
+        {}
+        (void)nrf_gzll_set_sync_lifetime(temp_lifetime);
+        (void)nrf_gzll_enable();
+    }
     
     return retval;
 }
@@ -679,6 +718,10 @@ static bool gzp_crypt_tx_transaction(const uint8_t *src, uint8_t length)
                 if(!gzp_id_req_pending)
                 {
                     gzp_crypt_set_session_token(&rx_packet[GZP_CMD_ENCRYPTED_USER_DATA_RESP_SESSION_TOKEN]);
+
+                    // The packet has been delivered, compute the AES output for the next
+                    // packet now rather than when it is sent.
+                    gzp_crypt_prepare();
                 }
                 return true;
             }
@@ -29,6 +29,9 @@
 #include "nrf_assert.h"
 #include "nrf_ecb.h"
 #include "nrf_nvmc.h"
+#if GZP_HOST_BUFFER_ENABLED
+#include "nrf_gzll_host_buffer.h"
+#endif
 
 
 //lint -esym(40, GZP_PARAMS_STORAGE_ADR) "Undeclared identifier"
@@ -759,6 +762,12 @@ void nrf_gzll_host_rx_data_ready(uint32_t pipe, nrf_gzll_host_rx_info_t rx_info)
     {
         prev_gzp_rx_info = rx_info;
     }
+#if GZP_HOST_BUFFER_ENABLED
+    else if(pipe != GZP_DATA_PIPE)
+    {
+        nrf_gzll_host_buffer_on_rx(pipe, rx_info);
+    }
+#endif
 }
 
 /** @} */
@@ -0,0 +1,62 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdint.h>
+#include "ble_serialization.h"
+#include "ser_sd_transport.h"
+#include "ser_evt_filter.h"
+#include "conn_evt_filter.h"
+
+
+/**@brief Command response callback function for @ref conn_evt_filter_set. */
+static uint32_t evt_filter_set_rsp_dec(const uint8_t * p_buffer, uint16_t length)
+{
+    uint32_t result_code = NRF_SUCCESS;
+    uint32_t err_code    = ser_ble_cmd_rsp_dec(p_buffer, length, SER_EVT_FILTER_SET, &result_code);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        result_code = NRF_ERROR_INTERNAL;
+    }
+
+    return result_code;
+}
+
+
+uint32_t conn_evt_filter_set(ser_evt_filter_t const * const p_filter)
+{
+    SER_ASSERT_NOT_NULL(p_filter);
+
+    uint32_t  err_code;
+    uint8_t * p_tx_buf   = NULL;
+    uint16_t  tx_buf_len = 0;
+    uint32_t  cmd_len;
+
+    err_code = ser_sd_transport_tx_alloc(&p_tx_buf, &tx_buf_len);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    p_tx_buf[SER_PKT_TYPE_POS] = SER_PKT_TYPE_CMD;
+    cmd_len                    = tx_buf_len - SER_PKT_TYPE_SIZE;
+
+    err_code = ser_evt_filter_set_req_enc(p_filter, &p_tx_buf[SER_PKT_OP_CODE_POS], &cmd_len);
+    if (err_code != NRF_SUCCESS)
+    {
+        (void)ser_sd_transport_tx_free(p_tx_buf);
+        return NRF_ERROR_INTERNAL;
+    }
+
+    return ser_sd_transport_cmd_write(p_tx_buf, (uint16_t)(cmd_len + SER_PKT_TYPE_SIZE),
+                                      evt_filter_set_rsp_dec);
+}
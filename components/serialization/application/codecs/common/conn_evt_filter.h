@@ -0,0 +1,54 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+ 
+#ifndef CONN_EVT_FILTER_H__
+#define CONN_EVT_FILTER_H__
+
+#include <stdint.h>
+#include "ser_evt_filter.h"
+
+/**
+ * @addtogroup ser_codecs Serialization codecs
+ * @ingroup ble_sdk_lib_serialization
+ */
+
+/**
+ * @addtogroup ser_app_common_codecs Application common codecs
+ * @ingroup ser_codecs
+ */
+
+/**@file
+ *
+ * @defgroup conn_evt_filter Connectivity chip event filter command request encoder.
+ * @{
+ * @ingroup  ser_app_common_codecs
+ *
+ * @brief    Connectivity chip event filter command request encoder.
+ */
+
+/**@brief Function for setting the events forwarded by the connectivity chip.
+ *
+ * @details Events that do not pass the filter are dropped by the connectivity chip and never sent
+ *          over the serial link. Before this function is called, all events are forwarded. Use
+ *          @ref ser_evt_filter_init to start from a filter which forwards all events.
+ *
+ * @param[in] p_filter  Filter to apply.
+ *
+ * @retval NRF_SUCCESS               The filter is set.
+ * @retval NRF_ERROR_NULL            NULL pointer supplied.
+ * @retval NRF_ERROR_NOT_SUPPORTED   The connectivity chip does not support event filtering.
+ * @retval NRF_ERROR_INTERNAL        Encoding failure. Transport error.
+ */
+uint32_t conn_evt_filter_set(ser_evt_filter_t const * const p_filter);
+
+/** @} */
+#endif // CONN_EVT_FILTER_H__
@@ -371,10 +371,14 @@ uint32_t sd_ble_gap_adv_data_set(uint8_t const * const p_data,
                                                            &buffer_length);
     APP_ERROR_CHECK(err_code);
 
+#if SER_SD_TRANSPORT_ASYNC_ENABLED
+    return ser_sd_transport_cmd_write_async(p_buffer, (++buffer_length));
+#else
     //@note: Increment buffer length as internally managed packet type field must be included.
     return ser_sd_transport_cmd_write(p_buffer,
                                       (++buffer_length),
                                       gap_adv_data_set_rsp_dec);
+#endif
 }
 
 
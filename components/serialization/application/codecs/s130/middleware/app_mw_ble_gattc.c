@@ -377,6 +377,14 @@ uint32_t sd_ble_gattc_write(uint16_t                               conn_handle,
                                                       &buffer_length);
     APP_ERROR_CHECK(err_code);
 
+#if SER_SD_TRANSPORT_ASYNC_ENABLED
+    if ((p_write_params != NULL) && (p_write_params->write_op == BLE_GATT_OP_WRITE_CMD))
+    {
+        // Write without response.
+        return ser_sd_transport_cmd_write_async(p_buffer, (++buffer_length));
+    }
+#endif
+
     //@note: Increment buffer length as internally managed packet type field must be included.
     return ser_sd_transport_cmd_write(p_buffer,
                                       (++buffer_length),
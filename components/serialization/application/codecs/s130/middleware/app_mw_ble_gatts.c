@@ -117,10 +117,15 @@ uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * c
                                                     &buffer_length);
     APP_ERROR_CHECK(err_code);
 
+#if SER_SD_TRANSPORT_ASYNC_ENABLED
+    //@note: *p_hvx_params->p_len is not updated when the command is sent asynchronously.
+    return ser_sd_transport_cmd_write_async(p_buffer, (++buffer_length));
+#else
     //@note: Increment buffer length as internally managed packet type field must be included.
     return ser_sd_transport_cmd_write(p_buffer,
                                       (++buffer_length),
                                       gatts_hvx_rsp_dec);
+#endif
 }
 
 
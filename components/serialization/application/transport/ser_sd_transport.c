@@ -22,6 +22,7 @@
 #include "ser_app_power_system_off.h"
 
 #include "app_util.h"
+#include "app_profiler.h"
 
 #ifdef ENABLE_DEBUG_LOG_SUPPORT
 #include "app_trace.h"
@@ -54,6 +55,63 @@ static volatile bool m_rsp_wait = false;
 /** SoftDevice call return value decoded by user decoder handler. */
 static uint32_t m_return_value;
 
+/* The sent and received counters wrap at 256. */
+#if (256 % SER_SD_TRANSPORT_ASYNC_MAX_PENDING) != 0
+#error "SER_SD_TRANSPORT_ASYNC_MAX_PENDING must be a power of two."
+#endif
+
+/** Operation codes of the asynchronous commands waiting for their responses, in the order sent. */
+static uint8_t m_async_op_codes[SER_SD_TRANSPORT_ASYNC_MAX_PENDING];
+
+/** Number of asynchronous commands sent. Only written in task context. */
+static volatile uint8_t m_async_sent;
+
+/** Number of asynchronous command responses received. Only written in interrupt context. */
+static volatile uint8_t m_async_received;
+
+/** Handler for failed asynchronous commands. */
+static ser_sd_transport_async_rsp_handler_t m_async_rsp_handler = NULL;
+
+/** Flag indicating that the packets of an aggregate packet are being handled. The RX buffer is
+ *  freed once, after the last of them. */
+static bool m_rx_aggr = false;
+
+/**@brief Function for getting the number of asynchronous commands waiting for their responses. */
+static uint8_t async_pending_count(void)
+{
+    return (uint8_t)(m_async_sent - m_async_received);
+}
+
+/**@brief Function for completing the oldest asynchronous command.
+ *
+ * @param[in]   op_code   Operation code in the response.
+ * @param[in]   err_code  Return value in the response.
+ */
+static void async_rsp_handle(uint8_t op_code, uint32_t err_code)
+{
+    uint8_t expected_op_code =
+        m_async_op_codes[m_async_received % SER_SD_TRANSPORT_ASYNC_MAX_PENDING];
+
+    m_async_received++;
+
+    if (op_code != expected_op_code)
+    {
+        /* Responses are out of step with the commands sent. */
+        APP_ERROR_HANDLER(op_code);
+    }
+
+    if ((err_code != NRF_SUCCESS) && m_async_rsp_handler)
+    {
+        m_async_rsp_handler(expected_op_code, err_code);
+    }
+
+    /* A task may be waiting for a free slot, or for its synchronous response to be next. */
+    if (m_os_rsp_set_handler)
+    {
+        m_os_rsp_set_handler();
+    }
+}
+
 /**@brief Function for handling the rx packets comming from hal_transport.
  *
  * @details
@@ -77,7 +135,17 @@ static void ser_sd_transport_rx_packet_handler(uint8_t * p_data, uint16_t length
             case SER_PKT_TYPE_RESP:
             case SER_PKT_TYPE_DTM_RESP:
 
-                if (m_rsp_wait)
+                if ((packet_type == SER_PKT_TYPE_RESP) && (async_pending_count() > 0)
+                    && (length >= SER_CMD_RSP_HEADER_SIZE))
+                {
+                    /* Asynchronous commands were sent before any pending synchronous one. */
+                    const uint8_t  op_code  = p_data[SER_CMD_OP_CODE_POS];
+                    const uint32_t err_code = uint32_decode(&p_data[SER_CMD_RSP_STATUS_CODE_POS]);
+
+                    (void)ser_sd_transport_rx_free(p_data);
+                    async_rsp_handle(op_code, err_code);
+                }
+                else if (m_rsp_wait)
                 {
                     m_return_value = m_rsp_dec_handler(p_data, length);
                     (void)ser_sd_transport_rx_free(p_data);
@@ -105,6 +173,41 @@ static void ser_sd_transport_rx_packet_handler(uint8_t * p_data, uint16_t length
                 m_evt_handler(p_data, length);
                 break;
 
+            case SER_PKT_TYPE_AGGR:
+            {
+                uint16_t index = 0;
+
+                if (m_rx_aggr)
+                {
+                    /* Aggregate packets do not nest. */
+                    APP_ERROR_HANDLER(packet_type);
+                    break;
+                }
+
+                m_rx_aggr = true;
+                while (index + SER_AGGR_PKT_LEN_SIZE <= length)
+                {
+                    uint16_t pkt_len = uint16_decode(&p_data[index]);
+
+                    index += SER_AGGR_PKT_LEN_SIZE;
+                    if (index + pkt_len > length)
+                    {
+                        break;
+                    }
+                    ser_sd_transport_rx_packet_handler(&p_data[index], pkt_len);
+                    index += pkt_len;
+                }
+                m_rx_aggr = false;
+
+                if (index != length)
+                {
+                    /* Truncated packet. */
+                    APP_ERROR_HANDLER(packet_type);
+                }
+                (void)ser_sd_transport_rx_free(p_data);
+                break;
+            }
+
             default:
                 (void)ser_sd_transport_rx_free(p_data);
                 APP_ERROR_HANDLER(packet_type);
@@ -139,6 +242,12 @@ static void ser_sd_transport_hal_handler(ser_hal_transport_evt_t event)
         break;
     case SER_HAL_TRANSP_EVT_PHY_ERROR:
 
+        while (async_pending_count() > 0)
+        {
+            async_rsp_handle(m_async_op_codes[m_async_received % SER_SD_TRANSPORT_ASYNC_MAX_PENDING],
+                             NRF_ERROR_INTERNAL);
+        }
+
         if (m_rsp_wait)
         {
             m_return_value = NRF_ERROR_INTERNAL;
@@ -196,9 +305,16 @@ uint32_t ser_sd_transport_ot_rsp_wait_handler_set(ser_sd_transport_rsp_wait_hand
     return NRF_SUCCESS;
 }
 
+uint32_t ser_sd_transport_async_rsp_handler_set(ser_sd_transport_async_rsp_handler_t handler)
+{
+    m_async_rsp_handler = handler;
+
+    return NRF_SUCCESS;
+}
+
 bool ser_sd_transport_is_busy(void)
 {
-    return m_rsp_wait;
+    return m_rsp_wait || (async_pending_count() >= SER_SD_TRANSPORT_ASYNC_MAX_PENDING);
 }
 
 uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len)
@@ -223,6 +339,12 @@ uint32_t ser_sd_transport_tx_free(uint8_t * p_data)
 
 uint32_t ser_sd_transport_rx_free(uint8_t * p_data)
 {
+    if (m_rx_aggr)
+    {
+        /* The buffer is freed when the whole aggregate packet has been handled. */
+        return NRF_SUCCESS;
+    }
+
     p_data -= SER_PKT_TYPE_SIZE;
     return ser_hal_transport_rx_pkt_free(p_data);
 }
@@ -233,6 +355,8 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
 {
     uint32_t err_code = NRF_SUCCESS;
 
+    PROFILE_BEGIN(APP_PROFILER_ID_SER_CMD_WRITE);
+
     m_rsp_wait        = true;
     m_rsp_dec_handler = cmd_rsp_decode_callback;
     err_code          = ser_hal_transport_tx_pkt_send(p_buffer, length);
@@ -254,6 +378,35 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
     {
         m_rsp_wait = false;
     }
+
+    PROFILE_END(APP_PROFILER_ID_SER_CMD_WRITE);
+
     APPL_LOG("\r\n[SD_CALL_ID]: 0x%X, err_code= 0x%X\r\n", p_buffer[1], err_code);
     return err_code;
 }
+
+uint32_t ser_sd_transport_cmd_write_async(const uint8_t * p_buffer, uint16_t length)
+{
+    uint32_t err_code;
+
+    /* The command buffer is already allocated, so waiting here does not hold up other senders. */
+    if (async_pending_count() >= SER_SD_TRANSPORT_ASYNC_MAX_PENDING)
+    {
+        m_os_rsp_wait_handler();
+    }
+
+    /* Queued before sending, since the response can arrive before the send call returns. */
+    m_async_op_codes[m_async_sent % SER_SD_TRANSPORT_ASYNC_MAX_PENDING] = p_buffer[SER_PKT_OP_CODE_POS];
+    m_async_sent++;
+
+    err_code = ser_hal_transport_tx_pkt_send(p_buffer, length);
+    if (err_code != NRF_SUCCESS)
+    {
+        /* No response will come for this command. */
+        m_async_sent--;
+    }
+    APP_ERROR_CHECK(err_code);
+
+    APPL_LOG("\r\n[SD_CALL_ID]: 0x%X, async\r\n", p_buffer[1]);
+    return err_code;
+}
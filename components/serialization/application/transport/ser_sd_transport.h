@@ -44,6 +44,22 @@ typedef void (*ser_sd_transport_rx_notification_handler_t)(void);
 
 typedef uint32_t (*ser_sd_transport_rsp_handler_t)(const uint8_t * p_buffer, uint16_t length);
 
+/**@brief Handler called in serial peripheral interrupt context when the response to an
+ *        asynchronous command is received.
+ *
+ * @param[in] op_code   Operation code of the command.
+ * @param[in] err_code  SoftDevice call return value, or NRF_ERROR_INTERNAL on a transport error.
+ */
+typedef void (*ser_sd_transport_async_rsp_handler_t)(uint8_t op_code, uint32_t err_code);
+
+#ifndef SER_SD_TRANSPORT_ASYNC_ENABLED
+#define SER_SD_TRANSPORT_ASYNC_ENABLED 0     /**< Send sd_ble_gatts_hvx, write commands, and sd_ble_gap_adv_data_set without waiting for their responses. */
+#endif
+
+#ifndef SER_SD_TRANSPORT_ASYNC_MAX_PENDING
+#define SER_SD_TRANSPORT_ASYNC_MAX_PENDING 4 /**< The number of asynchronous commands that can wait for their responses. */
+#endif
+
 /**@brief Function for opening the module.
  *
  * @note 'Wait for response' and 'Response set' callbacks can be set in RTOS environment.
@@ -149,5 +165,32 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
                                     uint16_t                       length,
                                     ser_sd_transport_rsp_handler_t cmd_resp_decode_callback);
 
+/**@brief Function for sending a SoftDevice command without waiting for its response.
+ *
+ * @details The connectivity chip answers commands in the order they were sent, so responses are
+ *          matched to pending commands in that order, and checked against their operation codes.
+ *          Only the return value of the SoftDevice call is decoded. It is reported to the handler
+ *          set with @ref ser_sd_transport_async_rsp_handler_set if it is not NRF_SUCCESS.
+ *          A later synchronous command waits until the responses before its own have arrived.
+ *
+ * @note Use only for commands without output parameters.
+ * @note Function blocks task context while @ref SER_SD_TRANSPORT_ASYNC_MAX_PENDING commands are
+ *       waiting for their responses.
+ *
+ * @param[in] p_buffer                 Pointer to command.
+ * @param[in] length                   Pointer to allocated buffer length.
+ *
+ * @retval NRF_SUCCESS          The command was sent.
+ */
+uint32_t ser_sd_transport_cmd_write_async(const uint8_t * p_buffer, uint16_t length);
+
+/**@brief Function for setting the handler for failed asynchronous commands.
+ *
+ * @param[in] handler  The handler, or NULL to ignore failures.
+ *
+ * @retval NRF_SUCCESS          Operation success.
+ */
+uint32_t ser_sd_transport_async_rsp_handler_set(ser_sd_transport_async_rsp_handler_t handler);
+
 #endif /* SER_SD_TRANSPORT_H_ */
 /** @} */
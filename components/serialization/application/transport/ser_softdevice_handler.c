@@ -68,17 +68,21 @@ static void connectivity_reset_high(void)
 
 static void ser_softdevice_evt_handler(uint8_t * p_data, uint16_t length)
 {
-    ser_sd_handler_evt_data_t item;
-    uint32_t                  err_code;
-    uint32_t                  len32 = sizeof (item.evt_data);
+    ser_sd_handler_evt_data_t * p_item;
+    uint32_t                    err_code;
+    uint32_t                    len32 = sizeof (p_item->evt_data);
 
-    err_code = ble_event_dec(p_data, length, (ble_evt_t *)item.evt_data, &len32);
+    /* Decode straight into the mailbox slot, so the event is not copied through the stack. */
+    err_code = app_mailbox_alloc(&sd_ble_evt_mailbox, (void **)&p_item);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = ble_event_dec(p_data, length, (ble_evt_t *)p_item->evt_data, &len32);
     APP_ERROR_CHECK(err_code);
 
     err_code = ser_sd_transport_rx_free(p_data);
     APP_ERROR_CHECK(err_code);
 
-    err_code = app_mailbox_put(&sd_ble_evt_mailbox, &item);
+    err_code = app_mailbox_commit(&sd_ble_evt_mailbox, p_item, sizeof (*p_item));
     APP_ERROR_CHECK(err_code);
 
     ser_app_hal_nrf_evt_pending();
@@ -124,20 +128,26 @@ uint32_t sd_evt_get(uint32_t * p_evt_id)
 
 uint32_t sd_ble_evt_get(uint8_t * p_data, uint16_t * p_len)
 {
-    uint32_t err_code;
+    uint32_t    err_code;
+    ble_evt_t * p_evt;
+    uint16_t    item_len;
 
-    err_code = app_mailbox_get(&sd_ble_evt_mailbox, p_data);
+    err_code = app_mailbox_ptr_get(&sd_ble_evt_mailbox, (void **)&p_evt, &item_len);
 
     if (err_code == NRF_SUCCESS) //if anything in the mailbox
     {
-        if (((ble_evt_t *)p_data)->header.evt_len > *p_len)
+        if (p_evt->header.evt_len > *p_len)
         {
             err_code = NRF_ERROR_DATA_SIZE;
         }
         else
         {
-            *p_len = ((ble_evt_t *)p_data)->header.evt_len;
+            /* Copy only the decoded event, not the whole mailbox slot. */
+            memcpy(p_data, p_evt, MIN(item_len, sizeof (ble_evt_hdr_t) + p_evt->header.evt_len));
+            *p_len = p_evt->header.evt_len;
         }
+
+        (void)app_mailbox_release(&sd_ble_evt_mailbox, p_evt);
     }
     else
     {
@@ -369,7 +369,9 @@ uint32_t cond_len16_cond_data_dec(uint8_t const * const p_buf,
     SER_ASSERT_NOT_NULL(pp_len);
     SER_ASSERT_NOT_NULL(*pp_len);
     SER_ASSERT_NOT_NULL(pp_data);
+#ifndef SER_CONNECTIVITY
     SER_ASSERT_NOT_NULL(*pp_data);
+#endif
 
     SER_ASSERT_LENGTH_LEQ(2, ((int32_t)buf_len - (*p_index)));
     uint8_t is_present = 0;
@@ -471,10 +473,21 @@ uint32_t buf_dec(uint8_t const * const p_buf,
     if (is_present == SER_FIELD_PRESENT)
     {
         SER_ASSERT_NOT_NULL(pp_data);
+#ifndef SER_CONNECTIVITY
         SER_ASSERT_NOT_NULL(*pp_data);
+#endif
         SER_ASSERT_LENGTH_LEQ(dlen, data_len);
         SER_ASSERT_LENGTH_LEQ(dlen, ((int32_t)buf_len - *p_index));
-        memcpy(*pp_data, &p_buf[*p_index], dlen);
+
+        if (*pp_data == NULL)
+        {
+            /* No destination given, point into the command packet instead of copying. */
+            *pp_data = (uint8_t *)&p_buf[*p_index];
+        }
+        else
+        {
+            memcpy(*pp_data, &p_buf[*p_index], dlen);
+        }
         *p_index += dlen;
     }
     else
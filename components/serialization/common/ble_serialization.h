@@ -27,6 +27,7 @@ typedef enum
     SER_PKT_TYPE_DTM_CMD,     /**< DTM Command packet type. */
     SER_PKT_TYPE_DTM_RESP,    /**< DTM Response packet type. */
     SER_PKT_TYPE_RESET_CMD,   /**< System Reset Command packet type. */
+    SER_PKT_TYPE_AGGR,        /**< Aggregate packet type, carrying several packets. */
     SER_PKT_TYPE_MAX          /**< Upper bound. */
 } ser_pkt_type_t;
 
@@ -50,6 +51,10 @@ typedef enum
 /** Position of the Data in a serialized packet buffer. */
 #define SER_PKT_DATA_POS               (SER_PKT_TYPE_SIZE + SER_OP_CODE_SIZE)
 
+/** Size in bytes of the length field preceding each packet in an aggregate packet. An aggregate
+ *  packet is the Packet Type field followed by one or more (length, packet) pairs. */
+#define SER_AGGR_PKT_LEN_SIZE          2
+
 /** Position of the Operation Code field in a command buffer. */
 #define SER_CMD_OP_CODE_POS            0
 /** Position of the Data in a command buffer.*/
@@ -282,8 +287,9 @@ uint32_t len8data_enc(uint8_t const * const p_data,
  * @param[in]      buf_len          Size of buffer.
  * @param[in,out]  p_index          \c in: Index to start of uint8 value in buffer.
  *                                  \c out: Index in buffer to first byte after the decoded value.
- * @param[out]     pp_data          Pointer to pointer to decoded data (p_data is set to NULL in
- *                                  case data is not present in the buffer).
+ * @param[in,out]  pp_data          Pointer to pointer to decoded data (p_data is set to NULL in
+ *                                  case data is not present in the buffer). See @ref buf_dec for
+ *                                  the case of *pp_data being NULL on input.
  * @param[out]     p_len            Decoded length (0-255).
  *
  * @return NRF_SUCCESS              Fields decoded successfully.
@@ -327,7 +333,8 @@ uint32_t len16data_enc(uint8_t const * const p_data,
  * @param[in]      buf_len          Size of buffer.
  * @param[in,out]  p_index          \c in: Index to start of uint8 value in buffer.
  *                                  \c out: Index in buffer to first byte after the decoded data.
- * @param[in]      pp_data          Pointer to pointer to decoded data.
+ * @param[in,out]  pp_data          Pointer to pointer to decoded data. See @ref buf_dec for the
+ *                                  case of *pp_data being NULL on input.
  * @param[in]      p_dlen             data length (16bit).
  *
  * @return NRF_SUCCESS              Fields decoded successfully.
@@ -488,7 +495,10 @@ uint32_t buf_enc(uint8_t const * const p_data,
  * @param[in]      buf_len          Size of buffer.
  * @param[in,out]  p_index          \c in: Index to start of uint8 value in buffer.
  *                                  \c out: Index in buffer to first byte after the decoded data.
- * @param[in]      pp_data          Pointer to pointer to decoded data.
+ * @param[in,out]  pp_data          Pointer to pointer to decoded data. On the connectivity side, if
+ *                                  *pp_data is NULL, it is set to point to the data in @p p_buf
+ *                                  instead of copying it. The data is then only valid as long as
+ *                                  @p p_buf. On the application side *pp_data must not be NULL.
  * @param[in]      data_len         Length of buffer for decoded data (16bit).
  * @param[in]      dlen             Length of data to decode (16bit).
  *
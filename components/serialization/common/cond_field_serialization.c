@@ -1,7 +1,9 @@
 #include "nrf_error.h"
 #include "cond_field_serialization.h"
 #include "ble_serialization.h"
+#include "app_util.h"
 #include <stddef.h>
+#include <string.h>
 
 uint32_t cond_field_enc(void const * const      p_field,
                         uint8_t * const         p_buf,
@@ -60,3 +62,198 @@ uint32_t cond_field_dec(uint8_t const * const   p_buf,
 
     return err_code;
 }
+
+
+static uint32_t field_enc(ser_field_desc_t const * p_field_desc,
+                          void const * const       p_struct,
+                          void const *             p_field,
+                          uint8_t * const          p_buf,
+                          uint32_t                 buf_len,
+                          uint32_t * const         p_index)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    switch (p_field_desc->type)
+    {
+        case SER_FIELD_TYPE_UINT8:
+            SER_ASSERT_LENGTH_LEQ(1, (int32_t)buf_len - *p_index);
+            p_buf[(*p_index)++] = *(uint8_t const *)p_field;
+            break;
+
+        case SER_FIELD_TYPE_UINT16:
+            SER_ASSERT_LENGTH_LEQ(2, (int32_t)buf_len - *p_index);
+            *p_index += uint16_encode(*(uint16_t const *)p_field, &p_buf[*p_index]);
+            break;
+
+        case SER_FIELD_TYPE_UINT32:
+            SER_ASSERT_LENGTH_LEQ(4, (int32_t)buf_len - *p_index);
+            *p_index += uint32_encode(*(uint32_t const *)p_field, &p_buf[*p_index]);
+            break;
+
+        case SER_FIELD_TYPE_BYTES:
+            SER_ASSERT_LENGTH_LEQ(p_field_desc->size, (int32_t)buf_len - *p_index);
+            memcpy(&p_buf[*p_index], p_field, p_field_desc->size);
+            *p_index += p_field_desc->size;
+            break;
+
+        case SER_FIELD_TYPE_STRUCT:
+            err_code = ser_struct_enc((ser_struct_desc_t const *)p_field_desc->p_ref,
+                                      p_field, p_buf, buf_len, p_index);
+            break;
+
+        case SER_FIELD_TYPE_LEN16_DATA:
+            err_code = len16data_enc(*(uint8_t * const *)p_field,
+                                     *(uint16_t const *)((uint8_t const *)p_struct +
+                                                         p_field_desc->len_ref),
+                                     p_buf, buf_len, p_index);
+            break;
+
+        case SER_FIELD_TYPE_CUSTOM:
+            err_code = ((ser_field_codec_t const *)p_field_desc->p_ref)->enc(p_field, p_buf,
+                                                                             buf_len, p_index);
+            break;
+
+        default:
+            err_code = NRF_ERROR_INTERNAL;
+            break;
+    }
+
+    return err_code;
+}
+
+
+static uint32_t field_dec(ser_field_desc_t const * p_field_desc,
+                          void * const             p_struct,
+                          void *                   p_field,
+                          uint8_t const * const    p_buf,
+                          uint32_t                 buf_len,
+                          uint32_t * const         p_index)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    switch (p_field_desc->type)
+    {
+        case SER_FIELD_TYPE_UINT8:
+            SER_ASSERT_LENGTH_LEQ(1, (int32_t)buf_len - *p_index);
+            *(uint8_t *)p_field = p_buf[(*p_index)++];
+            break;
+
+        case SER_FIELD_TYPE_UINT16:
+            SER_ASSERT_LENGTH_LEQ(2, (int32_t)buf_len - *p_index);
+            *(uint16_t *)p_field = uint16_decode(&p_buf[*p_index]);
+            *p_index            += 2;
+            break;
+
+        case SER_FIELD_TYPE_UINT32:
+            SER_ASSERT_LENGTH_LEQ(4, (int32_t)buf_len - *p_index);
+            *(uint32_t *)p_field = uint32_decode(&p_buf[*p_index]);
+            *p_index            += 4;
+            break;
+
+        case SER_FIELD_TYPE_BYTES:
+            SER_ASSERT_LENGTH_LEQ(p_field_desc->size, (int32_t)buf_len - *p_index);
+            memcpy(p_field, &p_buf[*p_index], p_field_desc->size);
+            *p_index += p_field_desc->size;
+            break;
+
+        case SER_FIELD_TYPE_STRUCT:
+            err_code = ser_struct_dec((ser_struct_desc_t const *)p_field_desc->p_ref,
+                                      p_buf, buf_len, p_index, p_field);
+            break;
+
+        case SER_FIELD_TYPE_LEN16_DATA:
+            err_code = len16data_dec(p_buf, buf_len, p_index, (uint8_t * *)p_field,
+                                     (uint16_t *)((uint8_t *)p_struct + p_field_desc->len_ref));
+            break;
+
+        case SER_FIELD_TYPE_CUSTOM:
+            err_code = ((ser_field_codec_t const *)p_field_desc->p_ref)->dec(p_buf, buf_len,
+                                                                             p_index, p_field);
+            break;
+
+        default:
+            err_code = NRF_ERROR_INTERNAL;
+            break;
+    }
+
+    return err_code;
+}
+
+
+uint32_t ser_struct_enc(ser_struct_desc_t const * p_desc,
+                        void const * const        p_struct,
+                        uint8_t * const           p_buf,
+                        uint32_t                  buf_len,
+                        uint32_t * const          p_index)
+{
+    uint32_t err_code = NRF_SUCCESS;
+    uint32_t i;
+
+    SER_ASSERT_NOT_NULL(p_struct);
+
+    for (i = 0; (i < p_desc->count) && (err_code == NRF_SUCCESS); i++)
+    {
+        ser_field_desc_t const * p_field_desc = &p_desc->p_fields[i];
+        void const *             p_field      = (uint8_t const *)p_struct + p_field_desc->offset;
+
+        if (p_field_desc->flags & SER_FIELD_FLAG_COND)
+        {
+            /* The field holds a pointer to the value, encode a presence flag first. */
+            p_field = *(void const * const *)p_field;
+
+            SER_ASSERT_LENGTH_LEQ(1, (int32_t)buf_len - *p_index);
+            p_buf[(*p_index)++] = (p_field == NULL) ? SER_FIELD_NOT_PRESENT : SER_FIELD_PRESENT;
+
+            if (p_field == NULL)
+            {
+                continue;
+            }
+        }
+
+        err_code = field_enc(p_field_desc, p_struct, p_field, p_buf, buf_len, p_index);
+    }
+
+    return err_code;
+}
+
+
+uint32_t ser_struct_dec(ser_struct_desc_t const * p_desc,
+                        uint8_t const * const     p_buf,
+                        uint32_t                  buf_len,
+                        uint32_t * const          p_index,
+                        void * const              p_struct)
+{
+    uint32_t err_code = NRF_SUCCESS;
+    uint32_t i;
+
+    SER_ASSERT_NOT_NULL(p_struct);
+
+    for (i = 0; (i < p_desc->count) && (err_code == NRF_SUCCESS); i++)
+    {
+        ser_field_desc_t const * p_field_desc = &p_desc->p_fields[i];
+        void *                   p_field      = (uint8_t *)p_struct + p_field_desc->offset;
+
+        if (p_field_desc->flags & SER_FIELD_FLAG_COND)
+        {
+            void * * pp_field = (void * *)p_field;
+            uint8_t  is_present;
+
+            SER_ASSERT_LENGTH_LEQ(1, (int32_t)buf_len - *p_index);
+            is_present = p_buf[(*p_index)++];
+
+            if (is_present == SER_FIELD_NOT_PRESENT)
+            {
+                *pp_field = NULL;
+                continue;
+            }
+            SER_ASSERT(is_present == SER_FIELD_PRESENT, NRF_ERROR_INVALID_DATA);
+            SER_ASSERT_NOT_NULL(*pp_field);
+
+            p_field = *pp_field;
+        }
+
+        err_code = field_dec(p_field_desc, p_struct, p_field, p_buf, buf_len, p_index);
+    }
+
+    return err_code;
+}
@@ -10,6 +10,7 @@
  *
  */
 #include <stdint.h>
+#include <stddef.h>
 
 typedef uint32_t (*field_encoder_handler_t)(void const * const p_field,
                                             uint8_t * const    p_buf,
@@ -62,3 +63,115 @@ uint32_t cond_field_dec(uint8_t const * const   p_buf,
                         uint32_t * const        p_index,
                         void * * const          pp_field,
                         field_decoder_handler_t field_parser);
+
+
+/**@brief Field types of a struct descriptor table. */
+typedef enum
+{
+    SER_FIELD_TYPE_UINT8,      /**< uint8_t field. */
+    SER_FIELD_TYPE_UINT16,     /**< uint16_t field, little endian. */
+    SER_FIELD_TYPE_UINT32,     /**< uint32_t field, little endian. */
+    SER_FIELD_TYPE_BYTES,      /**< Fixed size byte array, copied as is. */
+    SER_FIELD_TYPE_STRUCT,     /**< Nested struct described by another table. */
+    SER_FIELD_TYPE_LEN16_DATA, /**< Data pointer with a uint16_t length field, see @ref len16data_enc. */
+    SER_FIELD_TYPE_CUSTOM      /**< Field encoded by hand-written handlers. */
+} ser_field_type_t;
+
+/**@brief Field flag: the field is a pointer, preceded by a presence flag (see @ref cond_field_enc). */
+#define SER_FIELD_FLAG_COND 0x01
+
+/**@brief Hand-written handlers of a @ref SER_FIELD_TYPE_CUSTOM field. */
+typedef struct
+{
+    field_encoder_handler_t enc;
+    field_decoder_handler_t dec;
+} ser_field_codec_t;
+
+/**@brief Descriptor of one struct field. Fields are encoded in table order. */
+typedef struct
+{
+    uint8_t      type;    /**< Field type, see @ref ser_field_type_t. */
+    uint8_t      flags;   /**< Field flags, see @ref SER_FIELD_FLAG_COND. */
+    uint16_t     offset;  /**< Offset of the field in the struct. */
+    uint16_t     size;    /**< Array size for @ref SER_FIELD_TYPE_BYTES. */
+    uint16_t     len_ref; /**< Offset of the length field for @ref SER_FIELD_TYPE_LEN16_DATA. */
+    void const * p_ref;   /**< Struct descriptor or @ref ser_field_codec_t of the field. */
+} ser_field_desc_t;
+
+/**@brief Descriptor of a struct. */
+typedef struct
+{
+    ser_field_desc_t const * p_fields;
+    uint8_t                  count;
+} ser_struct_desc_t;
+
+#define SER_FIELD_UINT8(type, member)  { SER_FIELD_TYPE_UINT8,  0, offsetof(type, member), 0, 0, NULL }
+#define SER_FIELD_UINT16(type, member) { SER_FIELD_TYPE_UINT16, 0, offsetof(type, member), 0, 0, NULL }
+#define SER_FIELD_UINT32(type, member) { SER_FIELD_TYPE_UINT32, 0, offsetof(type, member), 0, 0, NULL }
+
+#define SER_FIELD_BYTES(type, member)                                                  \
+    { SER_FIELD_TYPE_BYTES, 0, offsetof(type, member), sizeof(((type *)0)->member), 0, NULL }
+
+#define SER_FIELD_STRUCT(type, member, desc)                                           \
+    { SER_FIELD_TYPE_STRUCT, 0, offsetof(type, member), 0, 0, &(desc) }
+
+#define SER_FIELD_LEN16_DATA(type, p_member, len_member)                               \
+    { SER_FIELD_TYPE_LEN16_DATA, 0, offsetof(type, p_member), 0, offsetof(type, len_member), NULL }
+
+#define SER_FIELD_COND_STRUCT(type, p_member, desc)                                    \
+    { SER_FIELD_TYPE_STRUCT, SER_FIELD_FLAG_COND, offsetof(type, p_member), 0, 0, &(desc) }
+
+#define SER_FIELD_CUSTOM(type, member, codec)                                          \
+    { SER_FIELD_TYPE_CUSTOM, 0, offsetof(type, member), 0, 0, &(codec) }
+
+#define SER_FIELD_COND_CUSTOM(type, p_member, codec)                                   \
+    { SER_FIELD_TYPE_CUSTOM, SER_FIELD_FLAG_COND, offsetof(type, p_member), 0, 0, &(codec) }
+
+/**@brief Macro for defining a struct descriptor from a list of field descriptors. */
+#define SER_STRUCT_DESC_DEF(name, ...)                                                 \
+    static const ser_field_desc_t name##_fields[] = { __VA_ARGS__ };                   \
+    static const ser_struct_desc_t name =                                              \
+    {                                                                                  \
+        .p_fields = name##_fields,                                                     \
+        .count    = sizeof(name##_fields) / sizeof(name##_fields[0])                   \
+    }
+
+/**@brief Function for encoding a struct described by a descriptor table.
+ *
+ * @param[in]      p_desc           Struct descriptor.
+ * @param[in]      p_struct         Pointer to input struct.
+ * @param[in]      p_buf            Pointer to the beginning of the output buffer.
+ * @param[in]      buf_len          Size of buffer.
+ * @param[in,out]  p_index          \c in: Index to start of the struct in buffer.
+ *                                  \c out: Index in buffer to first byte after the encoded data.
+ *
+ * @return NRF_SUCCESS              Struct encoded successfully.
+ * @retval NRF_ERROR_INVALID_LENGTH Encoding failure. Incorrect buffer length.
+ */
+uint32_t ser_struct_enc(ser_struct_desc_t const * p_desc,
+                        void const * const        p_struct,
+                        uint8_t * const           p_buf,
+                        uint32_t                  buf_len,
+                        uint32_t * const          p_index);
+
+/**@brief Function for decoding a struct described by a descriptor table.
+ *
+ * Pointer fields (@ref SER_FIELD_FLAG_COND and @ref SER_FIELD_TYPE_LEN16_DATA) must point to
+ * memory for the decoded data, as for @ref cond_field_dec and @ref len16data_dec.
+ *
+ * @param[in]      p_desc           Struct descriptor.
+ * @param[in]      p_buf            Pointer to the beginning of the input buffer.
+ * @param[in]      buf_len          Size of buffer.
+ * @param[in,out]  p_index          \c in: Index to start of the struct in buffer.
+ *                                  \c out: Index in buffer to first byte after the decoded data.
+ * @param[out]     p_struct         Pointer to output struct.
+ *
+ * @return NRF_SUCCESS              Struct decoded successfully.
+ * @retval NRF_ERROR_INVALID_LENGTH Decoding failure. Incorrect buffer length.
+ * @retval NRF_ERROR_INVALID_DATA   Decoding failure. Invalid presence flag.
+ */
+uint32_t ser_struct_dec(ser_struct_desc_t const * p_desc,
+                        uint8_t const * const     p_buf,
+                        uint32_t                  buf_len,
+                        uint32_t * const          p_index,
+                        void * const              p_struct);
@@ -38,6 +38,18 @@
 #define SER_HAL_TRANSPORT_APP_TO_CONN_MAX_PKT_SIZE    (uint32_t)(384)
 #define SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE    (uint32_t)(384)
 
+/** Pack consecutive events into one aggregate packet on the connectivity side. Aggregate packets
+ *  are always decoded on both sides. */
+#ifndef SER_EVT_AGGR_ENABLED
+#define SER_EVT_AGGR_ENABLED                          0
+#endif
+
+/** Max number of events in one aggregate packet. The application side decodes all of them at once,
+ *  so this should not exceed the free space of its event mailbox. */
+#ifndef SER_EVT_AGGR_MAX_PKTS
+#define SER_EVT_AGGR_MAX_PKTS                         4
+#endif
+
 #define SER_HAL_TRANSPORT_MAX_PKT_SIZE ((SER_HAL_TRANSPORT_APP_TO_CONN_MAX_PKT_SIZE) >= \
                                         (SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE)    \
                                         ?                                               \
@@ -59,8 +71,21 @@
 
 #define SER_PHY_HEADER_SIZE             2
 
+/** Max number of reliable HCI packets sent before the first of them is acknowledged (1 to 7). The
+ *  window is negotiated down to the peer's value during link establishment. Each packet above one
+ *  takes a copy of the packet in RAM (SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE bytes). */
+#ifndef SER_PHY_HCI_WINDOW_SIZE
+#define SER_PHY_HCI_WINDOW_SIZE         1
+#endif
+
 #define SER_PHY_SPI_FREQUENCY           NRF_DRV_SPI_FREQ_1M
 
+/** Clock of the nRF52 SPI 5W master PHY (SPIM with EasyDMA). Frequencies above 2 Mbps require a
+ *  connectivity chip with a SPIS peripheral which supports them (nRF52). */
+#ifndef SER_PHY_SPI_5W_FREQUENCY
+#define SER_PHY_SPI_5W_FREQUENCY        NRF_DRV_SPI_FREQ_8M
+#endif
+
 /** Max transfer unit for SPI MASTER and SPI SLAVE. */
 #define SER_PHY_SPI_MTU_SIZE            255
 
@@ -69,6 +94,26 @@
 #define SER_PHY_UART_PARITY             true
 #define SER_PHY_UART_BAUDRATE           UART_BAUDRATE_BAUDRATE_Baud1M
 
+/** UARTE (nRF52) SLIP PHY reception buffers. They are filled by EasyDMA in turn, so data in one
+ *  buffer stays valid while the remaining (count - 1) buffers are being received. */
+#ifndef SER_PHY_UARTE_RX_BUF_SIZE
+#define SER_PHY_UARTE_RX_BUF_SIZE       64
+#endif
+
+#ifndef SER_PHY_UARTE_RX_BUF_COUNT
+#define SER_PHY_UARTE_RX_BUF_COUNT      4
+#endif
+
+/** TIMER instances used by the UARTE SLIP PHY to detect the end of reception when a buffer is only
+ *  partly filled. Both must be enabled in nrf_drv_config.h, together with PPI. */
+#ifndef SER_PHY_UARTE_COUNTER_TIMER
+#define SER_PHY_UARTE_COUNTER_TIMER     1
+#endif
+
+#ifndef SER_PHY_UARTE_TIMEOUT_TIMER
+#define SER_PHY_UARTE_TIMEOUT_TIMER     2
+#endif
+
 /** Find UART baudrate value based on chosen register setting. */
 #if (SER_PHY_UART_BAUDRATE == UART_BAUDRATE_BAUDRATE_Baud1200)
     #define SER_PHY_UART_BAUDRATE_VAL 1200uL
@@ -0,0 +1,170 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <string.h>
+#include "ble_serialization.h"
+#include "ble_gap_struct_serialization.h"
+#include "cond_field_serialization.h"
+#include "app_util.h"
+#include "ser_evt_filter.h"
+
+static const ser_field_codec_t ble_gap_addr_codec = { ble_gap_addr_enc, ble_gap_addr_dec };
+
+SER_STRUCT_DESC_DEF(ser_evt_filter_desc,
+                    SER_FIELD_BYTES(ser_evt_filter_t, evt_mask),
+                    SER_FIELD_UINT8(ser_evt_filter_t, adv_rssi_min),
+                    SER_FIELD_UINT8(ser_evt_filter_t, adv_flags),
+                    SER_FIELD_CUSTOM(ser_evt_filter_t, adv_addr, ble_gap_addr_codec),
+                    SER_FIELD_UINT16(ser_evt_filter_t, adv_uuid16));
+
+
+/**@brief Function for checking if advertising data lists a 16-bit service UUID. */
+static bool adv_data_uuid16_find(uint8_t const * p_data, uint8_t dlen, uint16_t uuid)
+{
+    uint32_t index = 0;
+
+    while (index + 1 < dlen)
+    {
+        uint8_t  field_len = p_data[index];
+        uint32_t field_end = index + 1 + field_len;
+
+        if ((field_len == 0) || (field_end > dlen))
+        {
+            break;
+        }
+
+        if ((p_data[index + 1] == BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE) ||
+            (p_data[index + 1] == BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE))
+        {
+            uint32_t uuid_index;
+
+            for (uuid_index = index + 2; uuid_index + sizeof (uint16_t) <= field_end;
+                 uuid_index += sizeof (uint16_t))
+            {
+                if (uint16_decode(&p_data[uuid_index]) == uuid)
+                {
+                    return true;
+                }
+            }
+        }
+
+        index = field_end;
+    }
+
+    return false;
+}
+
+
+/**@brief Function for checking if an advertising report passes the advertising report filter. */
+static bool adv_report_match(ser_evt_filter_t const * const         p_filter,
+                             ble_gap_evt_adv_report_t const * const p_report)
+{
+    if (p_report->rssi < p_filter->adv_rssi_min)
+    {
+        return false;
+    }
+
+    if ((p_filter->adv_flags & SER_EVT_FILTER_ADV_ADDR) &&
+        ((p_report->peer_addr.addr_type != p_filter->adv_addr.addr_type) ||
+         (memcmp(p_report->peer_addr.addr, p_filter->adv_addr.addr, BLE_GAP_ADDR_LEN) != 0)))
+    {
+        return false;
+    }
+
+    if ((p_filter->adv_flags & SER_EVT_FILTER_ADV_UUID16) &&
+        !adv_data_uuid16_find(p_report->data, p_report->dlen, p_filter->adv_uuid16))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+void ser_evt_filter_init(ser_evt_filter_t * const p_filter)
+{
+    memset(p_filter, 0, sizeof (ser_evt_filter_t));
+    memset(p_filter->evt_mask, 0xFF, sizeof (p_filter->evt_mask));
+    p_filter->adv_rssi_min = INT8_MIN;
+}
+
+
+bool ser_evt_filter_match(ser_evt_filter_t const * const p_filter, ble_evt_t const * const p_ble_evt)
+{
+    uint16_t evt_id = p_ble_evt->header.evt_id;
+
+    /* Encoding these events releases connectivity side resources. */
+    if ((evt_id == BLE_GAP_EVT_AUTH_STATUS) || (evt_id == BLE_EVT_USER_MEM_RELEASE))
+    {
+        return true;
+    }
+
+    if (!SER_EVT_FILTER_EVT_IS_SET(p_filter, evt_id))
+    {
+        return false;
+    }
+
+    if (evt_id == BLE_GAP_EVT_ADV_REPORT)
+    {
+        return adv_report_match(p_filter, &p_ble_evt->evt.gap_evt.params.adv_report);
+    }
+
+    return true;
+}
+
+
+uint32_t ser_evt_filter_set_req_enc(ser_evt_filter_t const * const p_filter,
+                                    uint8_t * const                p_buf,
+                                    uint32_t * const               p_buf_len)
+{
+    SER_ASSERT_NOT_NULL(p_filter);
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_buf_len);
+
+    uint32_t index  = 0;
+    uint8_t  opcode = SER_EVT_FILTER_SET;
+    uint32_t err_code;
+
+    err_code = uint8_t_enc(&opcode, p_buf, *p_buf_len, &index);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    err_code = ser_struct_enc(&ser_evt_filter_desc, p_filter, p_buf, *p_buf_len, &index);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    *p_buf_len = index;
+
+    return err_code;
+}
+
+
+uint32_t ser_evt_filter_set_req_dec(uint8_t const * const    p_buf,
+                                    uint32_t                 packet_len,
+                                    ser_evt_filter_t * const p_filter)
+{
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_filter);
+
+    uint32_t index = 0;
+    uint8_t  opcode;
+    uint32_t err_code;
+
+    err_code = uint8_t_dec(p_buf, packet_len, &index, &opcode);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+    SER_ASSERT(opcode == SER_EVT_FILTER_SET, NRF_ERROR_INVALID_PARAM);
+
+    err_code = ser_struct_dec(&ser_evt_filter_desc, p_buf, packet_len, &index, p_filter);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    SER_ASSERT_LENGTH_EQ(index, packet_len);
+
+    return err_code;
+}
@@ -0,0 +1,124 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/**@file
+ *
+ * @defgroup ser_evt_filter Event subscription filter
+ * @{
+ * @ingroup ble_sdk_lib_serialization
+ *
+ * @brief   Event subscription filter shared by the application and the connectivity chip.
+ *
+ * @details The application sends a filter to the connectivity chip with @ref conn_evt_filter_set.
+ *          The connectivity chip then drops the BLE events that the application did not subscribe
+ *          to, and the advertising reports that do not match the advertising report filter,
+ *          before they are encoded and sent over the serial link.
+ */
+
+#ifndef SER_EVT_FILTER_H__
+#define SER_EVT_FILTER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "ble_gap.h"
+
+/** Opcode of the event filter command. It is outside of the SoftDevice SVC ranges. */
+#define SER_EVT_FILTER_SET                 0xF0
+
+/** Number of BLE event IDs covered by the event mask. */
+#define SER_EVT_FILTER_EVT_ID_COUNT        (BLE_L2CAP_EVT_LAST + 1)
+
+/** Size of the event mask in bytes. */
+#define SER_EVT_FILTER_MASK_SIZE           ((SER_EVT_FILTER_EVT_ID_COUNT + 7) / 8)
+
+/**@defgroup SER_EVT_FILTER_ADV_FLAGS Advertising report filter flags
+ * @{ */
+#define SER_EVT_FILTER_ADV_ADDR            0x01 /**< Forward only reports from @ref ser_evt_filter_t::adv_addr. */
+#define SER_EVT_FILTER_ADV_UUID16          0x02 /**< Forward only reports listing @ref ser_evt_filter_t::adv_uuid16. */
+/** @} */
+
+/**@brief Macro for subscribing to an event in a filter. */
+#define SER_EVT_FILTER_EVT_SET(p_filter, evt_id)                                                  \
+    ((p_filter)->evt_mask[(evt_id) >> 3] |= (uint8_t)(1u << ((evt_id) & 0x07)))
+
+/**@brief Macro for unsubscribing from an event in a filter. */
+#define SER_EVT_FILTER_EVT_CLR(p_filter, evt_id)                                                  \
+    ((p_filter)->evt_mask[(evt_id) >> 3] &= (uint8_t)~(1u << ((evt_id) & 0x07)))
+
+/**@brief Macro for checking if a filter is subscribed to an event. */
+#define SER_EVT_FILTER_EVT_IS_SET(p_filter, evt_id)                                               \
+    (((evt_id) < SER_EVT_FILTER_EVT_ID_COUNT) &&                                                  \
+     ((p_filter)->evt_mask[(evt_id) >> 3] & (1u << ((evt_id) & 0x07))))
+
+/**@brief Event subscription filter.
+ *
+ * @note @ref BLE_GAP_EVT_AUTH_STATUS and @ref BLE_EVT_USER_MEM_RELEASE are always forwarded,
+ *       because encoding them releases resources held by the connectivity chip.
+ */
+typedef struct
+{
+    uint8_t        evt_mask[SER_EVT_FILTER_MASK_SIZE]; /**< Bit n set: events with ID n are forwarded. */
+    int8_t         adv_rssi_min;                       /**< Minimum RSSI of forwarded advertising reports, in dBm. */
+    uint8_t        adv_flags;                          /**< Advertising report filter, see @ref SER_EVT_FILTER_ADV_FLAGS. */
+    ble_gap_addr_t adv_addr;                           /**< Address of forwarded advertising reports. */
+    uint16_t       adv_uuid16;                         /**< 16-bit service UUID of forwarded advertising reports. */
+} ser_evt_filter_t;
+
+/**@brief Function for initializing a filter which forwards all events.
+ *
+ * @param[out] p_filter  Filter to initialize.
+ */
+void ser_evt_filter_init(ser_evt_filter_t * const p_filter);
+
+/**@brief Function for checking if an event passes a filter.
+ *
+ * @param[in] p_filter   Filter.
+ * @param[in] p_ble_evt  Event.
+ *
+ * @retval true   The event is to be forwarded.
+ * @retval false  The event is to be dropped.
+ */
+bool ser_evt_filter_match(ser_evt_filter_t const * const p_filter, ble_evt_t const * const p_ble_evt);
+
+/**@brief Function for encoding the event filter command request.
+ *
+ * @param[in]      p_filter   Filter.
+ * @param[in]      p_buf      Pointer to the buffer where the encoded data command will be returned.
+ * @param[in,out]  p_buf_len  \c in: Size of \p p_buf buffer.
+ *                            \c out: Length of encoded command packet.
+ *
+ * @retval NRF_SUCCESS               Encoding success.
+ * @retval NRF_ERROR_NULL            Encoding failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH  Encoding failure. Incorrect buffer length.
+ */
+uint32_t ser_evt_filter_set_req_enc(ser_evt_filter_t const * const p_filter,
+                                    uint8_t * const                p_buf,
+                                    uint32_t * const               p_buf_len);
+
+/**@brief Function for decoding the event filter command request.
+ *
+ * @param[in]  p_buf       Pointer to beginning of command request packet.
+ * @param[in]  packet_len  Length (in bytes) of request packet.
+ * @param[out] p_filter    Decoded filter.
+ *
+ * @retval NRF_SUCCESS               Decoding success.
+ * @retval NRF_ERROR_NULL            Decoding failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH  Decoding failure. Incorrect buffer length.
+ * @retval NRF_ERROR_INVALID_PARAM   Decoding failure. Invalid operation type.
+ */
+uint32_t ser_evt_filter_set_req_dec(uint8_t const * const    p_buf,
+                                    uint32_t                 packet_len,
+                                    ser_evt_filter_t * const p_filter);
+
+/** @} */
+#endif // SER_EVT_FILTER_H__
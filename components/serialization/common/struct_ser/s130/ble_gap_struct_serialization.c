@@ -16,70 +16,79 @@
 #include "app_util.h"
 #include "string.h"
 
-uint32_t ble_gap_irk_enc(void const * const p_data,
+static const ser_field_codec_t ble_gap_enc_info_codec = { ble_gap_enc_info_enc, ble_gap_enc_info_dec };
+static const ser_field_codec_t ble_gap_sign_info_codec = { ble_gap_sign_info_enc, ble_gap_sign_info_dec };
+static const ser_field_codec_t ble_gap_lesc_p256_pk_codec = { ble_gap_lesc_p256_pk_t_enc,
+                                                              ble_gap_lesc_p256_pk_t_dec };
+
+SER_STRUCT_DESC_DEF(ble_gap_irk_desc,
+                    SER_FIELD_BYTES(ble_gap_irk_t, irk));
+
+SER_STRUCT_DESC_DEF(ble_gap_addr_desc,
+                    SER_FIELD_UINT8(ble_gap_addr_t, addr_type),
+                    SER_FIELD_BYTES(ble_gap_addr_t, addr));
+
+SER_STRUCT_DESC_DEF(ble_gap_master_id_desc,
+                    SER_FIELD_UINT16(ble_gap_master_id_t, ediv),
+                    SER_FIELD_BYTES(ble_gap_master_id_t, rand));
+
+SER_STRUCT_DESC_DEF(ble_gap_conn_params_desc,
+                    SER_FIELD_UINT16(ble_gap_conn_params_t, min_conn_interval),
+                    SER_FIELD_UINT16(ble_gap_conn_params_t, max_conn_interval),
+                    SER_FIELD_UINT16(ble_gap_conn_params_t, slave_latency),
+                    SER_FIELD_UINT16(ble_gap_conn_params_t, conn_sup_timeout));
+
+SER_STRUCT_DESC_DEF(ble_gap_evt_disconnected_desc,
+                    SER_FIELD_UINT8(ble_gap_evt_disconnected_t, reason));
+
+SER_STRUCT_DESC_DEF(ble_gap_enc_key_desc,
+                    SER_FIELD_CUSTOM(ble_gap_enc_key_t, enc_info, ble_gap_enc_info_codec),
+                    SER_FIELD_STRUCT(ble_gap_enc_key_t, master_id, ble_gap_master_id_desc));
+
+SER_STRUCT_DESC_DEF(ble_gap_id_key_desc,
+                    SER_FIELD_STRUCT(ble_gap_id_key_t, id_info, ble_gap_irk_desc),
+                    SER_FIELD_STRUCT(ble_gap_id_key_t, id_addr_info, ble_gap_addr_desc));
+
+SER_STRUCT_DESC_DEF(ble_gap_sec_keys_desc,
+                    SER_FIELD_COND_STRUCT(ble_gap_sec_keys_t, p_enc_key, ble_gap_enc_key_desc),
+                    SER_FIELD_COND_STRUCT(ble_gap_sec_keys_t, p_id_key, ble_gap_id_key_desc),
+                    SER_FIELD_COND_CUSTOM(ble_gap_sec_keys_t, p_sign_key, ble_gap_sign_info_codec),
+                    SER_FIELD_COND_CUSTOM(ble_gap_sec_keys_t, p_pk, ble_gap_lesc_p256_pk_codec));
+
+SER_STRUCT_DESC_DEF(ble_gap_sec_keyset_desc,
+                    SER_FIELD_STRUCT(ble_gap_sec_keyset_t, keys_own, ble_gap_sec_keys_desc),
+                    SER_FIELD_STRUCT(ble_gap_sec_keyset_t, keys_peer, ble_gap_sec_keys_desc));
+
+uint32_t ble_gap_irk_enc(void const * const p_void_struct,
                          uint8_t * const    p_buf,
                          uint32_t           buf_len,
                          uint32_t * const   p_index)
 {
-    ble_gap_irk_t * p_gap_irk = (ble_gap_irk_t *)p_data;
-
-    SER_ASSERT_LENGTH_LEQ(BLE_GAP_SEC_KEY_LEN, buf_len - *p_index);
-
-    memcpy(&p_buf[*p_index], p_gap_irk->irk, BLE_GAP_SEC_KEY_LEN);
-
-    *p_index += BLE_GAP_SEC_KEY_LEN;
-
-    return NRF_SUCCESS;
+    return ser_struct_enc(&ble_gap_irk_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_irk_dec(uint8_t const * const p_buf,
                          uint32_t              buf_len,
                          uint32_t * const      p_index,
-                         void * const          p_data)
+                         void * const          p_void_struct)
 {
-    ble_gap_irk_t * p_gap_irk = (ble_gap_irk_t *)p_data;
-
-    SER_ASSERT_LENGTH_LEQ(BLE_GAP_SEC_KEY_LEN, buf_len - *p_index);
-
-    memcpy(p_gap_irk->irk, &p_buf[*p_index], BLE_GAP_SEC_KEY_LEN);
-
-    *p_index += BLE_GAP_SEC_KEY_LEN;
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&ble_gap_irk_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_gap_addr_enc(void const * const p_data,
+uint32_t ble_gap_addr_enc(void const * const p_void_struct,
                           uint8_t * const    p_buf,
                           uint32_t           buf_len,
                           uint32_t * const   p_index)
 {
-    ble_gap_addr_t * p_addr = (ble_gap_addr_t *)p_data;
-
-    SER_ASSERT_LENGTH_LEQ(1 + BLE_GAP_ADDR_LEN, buf_len - *p_index);
-
-    p_buf[*p_index] = p_addr->addr_type;
-    (*p_index)++;
-    memcpy(&p_buf[*p_index], p_addr->addr, BLE_GAP_ADDR_LEN);
-    *p_index += BLE_GAP_ADDR_LEN;
-
-    return NRF_SUCCESS;
+    return ser_struct_enc(&ble_gap_addr_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_addr_dec(uint8_t const * const p_buf,
                           uint32_t              buf_len,
                           uint32_t * const      p_index,
-                          void * const          p_addr)
+                          void * const          p_void_struct)
 {
-    ble_gap_addr_t * p_address = (ble_gap_addr_t *) p_addr;
-
-    SER_ASSERT_LENGTH_LEQ(1 + BLE_GAP_ADDR_LEN, (int32_t)buf_len - *p_index);
-
-    p_address->addr_type = p_buf[*p_index];
-    (*p_index)++;
-    memcpy(p_address->addr, &p_buf[*p_index], BLE_GAP_ADDR_LEN);
-    *p_index += BLE_GAP_ADDR_LEN;
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&ble_gap_addr_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gap_sec_levels_enc(void const * const p_data,
@@ -121,50 +130,20 @@ uint32_t ble_gap_sec_levels_dec(uint8_t const * const p_buf,
 }
 
 
-uint32_t ble_gap_sec_keys_enc(void const * const p_data,
+uint32_t ble_gap_sec_keys_enc(void const * const p_void_struct,
                               uint8_t * const    p_buf,
                               uint32_t           buf_len,
                               uint32_t * const   p_index)
 {
-    ble_gap_sec_keys_t * p_sec_keys = (ble_gap_sec_keys_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = cond_field_enc(p_sec_keys->p_enc_key, p_buf, buf_len, p_index, ble_gap_enc_key_t_enc);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_enc(p_sec_keys->p_id_key, p_buf, buf_len, p_index, ble_gap_id_key_t_enc);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_enc(p_sec_keys->p_sign_key, p_buf, buf_len, p_index, ble_gap_sign_info_enc);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_enc(p_sec_keys->p_pk, p_buf, buf_len, p_index, ble_gap_lesc_p256_pk_t_enc);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_sec_keys_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_sec_keys_dec(uint8_t const * const p_buf,
                               uint32_t              buf_len,
                               uint32_t * const      p_index,
-                              void * const          p_data)
+                              void * const          p_void_struct)
 {
-    ble_gap_sec_keys_t * p_sec_keys = (ble_gap_sec_keys_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = cond_field_dec(p_buf, buf_len, p_index, (void * *)&(p_sec_keys->p_enc_key), ble_gap_enc_key_t_dec);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_dec(p_buf, buf_len, p_index, (void * *)&(p_sec_keys->p_id_key), ble_gap_id_key_t_dec);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_dec(p_buf, buf_len, p_index, (void * *)&(p_sec_keys->p_sign_key), ble_gap_sign_info_dec);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_dec(p_buf, buf_len, p_index, (void * *)&(p_sec_keys->p_pk), ble_gap_lesc_p256_pk_t_dec);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_gap_sec_keys_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gap_enc_info_enc(void const * const p_data,
@@ -612,113 +591,52 @@ uint32_t ble_gap_evt_conn_param_update_request_t_dec(uint8_t const * const p_buf
     return ble_gap_conn_params_t_dec(p_buf, buf_len, p_index, p_void_evt_conn_param_update_request);
 }
 
-uint32_t ble_gap_conn_params_t_enc(void const * const p_void_conn_params,
+uint32_t ble_gap_conn_params_t_enc(void const * const p_void_struct,
                                    uint8_t * const    p_buf,
                                    uint32_t           buf_len,
                                    uint32_t * const   p_index)
 {
-    ble_gap_conn_params_t * p_conn_params = (ble_gap_conn_params_t *)p_void_conn_params;
-    uint32_t                err_code      = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&p_conn_params->min_conn_interval, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_conn_params->max_conn_interval, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_conn_params->slave_latency, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_conn_params->conn_sup_timeout, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_conn_params_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_conn_params_t_dec(uint8_t const * const p_buf,
                                    uint32_t              buf_len,
                                    uint32_t * const      p_index,
-                                   void * const          p_void_conn_params)
+                                   void * const          p_void_struct)
 {
-    ble_gap_conn_params_t * p_conn_params = (ble_gap_conn_params_t *)p_void_conn_params;
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->min_conn_interval);
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->max_conn_interval);
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->slave_latency);
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->conn_sup_timeout);
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&ble_gap_conn_params_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_gap_evt_disconnected_t_enc(void const * const p_void_disconnected,
+uint32_t ble_gap_evt_disconnected_t_enc(void const * const p_void_struct,
                                         uint8_t * const    p_buf,
                                         uint32_t           buf_len,
                                         uint32_t * const   p_index)
 {
-    ble_gap_evt_disconnected_t * p_disconnected = (ble_gap_evt_disconnected_t *)p_void_disconnected;
-    uint32_t                     err_code       = NRF_SUCCESS;
-
-    err_code = uint8_t_enc(&p_disconnected->reason, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_evt_disconnected_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_evt_disconnected_t_dec(uint8_t const * const p_buf,
                                         uint32_t              buf_len,
                                         uint32_t * const      p_index,
-                                        void * const          p_void_disconnected)
+                                        void * const          p_void_struct)
 {
-    ble_gap_evt_disconnected_t * p_disconnected = (ble_gap_evt_disconnected_t *)p_void_disconnected;
-    uint32_t                     err_code       = NRF_SUCCESS;
-
-    SER_ASSERT_LENGTH_LEQ(1, buf_len - *p_index);
-    uint8_dec(p_buf, buf_len, p_index, &p_disconnected->reason);
-
-    return err_code;
+    return ser_struct_dec(&ble_gap_evt_disconnected_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_gap_master_id_t_enc(void const * const p_master_idx,
+uint32_t ble_gap_master_id_t_enc(void const * const p_void_struct,
                                  uint8_t * const    p_buf,
                                  uint32_t           buf_len,
                                  uint32_t * const   p_index)
 {
-    ble_gap_master_id_t * p_master_id = (ble_gap_master_id_t *) p_master_idx;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&(p_master_id->ediv), p_buf, buf_len, p_index);
-
-    SER_ASSERT_LENGTH_LEQ(BLE_GAP_SEC_RAND_LEN, buf_len - *p_index);
-    memcpy(&p_buf[*p_index], p_master_id->rand, BLE_GAP_SEC_RAND_LEN);
-    *p_index += BLE_GAP_SEC_RAND_LEN;
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_master_id_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_master_id_t_dec(uint8_t const * const p_buf,
-                               uint32_t              buf_len,
-                               uint32_t      * const p_index,
-                               void          * const p_master_idx)
+                                 uint32_t              buf_len,
+                                 uint32_t * const      p_index,
+                                 void * const          p_void_struct)
 {
-    ble_gap_master_id_t *p_master_id = (ble_gap_master_id_t *)p_master_idx;
-
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_master_id->ediv));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    SER_ASSERT_LENGTH_LEQ(BLE_GAP_SEC_RAND_LEN, buf_len - *p_index);
-    memcpy(p_master_id->rand, &p_buf[*p_index], BLE_GAP_SEC_RAND_LEN);
-    *p_index += BLE_GAP_SEC_RAND_LEN;
-
-    return err_code;
+    return ser_struct_dec(&ble_gap_master_id_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gap_whitelist_t_enc(void const * const p_data,
@@ -858,123 +776,51 @@ uint32_t ble_gap_scan_params_t_dec(uint8_t const * const p_buf,
     return err_code;
 }
 
-uint32_t ble_gap_enc_key_t_enc(void const * const p_data,
+uint32_t ble_gap_enc_key_t_enc(void const * const p_void_struct,
                                uint8_t * const    p_buf,
                                uint32_t           buf_len,
                                uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_enc_key_t * p_enc_key = (ble_gap_enc_key_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = ble_gap_enc_info_enc(&(p_enc_key->enc_info), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_gap_master_id_t_enc(&(p_enc_key->master_id), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_enc_key_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_enc_key_t_dec(uint8_t const * const p_buf,
                                uint32_t              buf_len,
                                uint32_t * const      p_index,
-                               void * const          p_data)
+                               void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_enc_key_t * p_enc_key = (ble_gap_enc_key_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = ble_gap_enc_info_dec(p_buf, buf_len, p_index, &(p_enc_key->enc_info));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_gap_master_id_t_dec(p_buf, buf_len, p_index, &(p_enc_key->master_id));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_gap_enc_key_desc, p_buf, buf_len, p_index, p_void_struct);
 }
-uint32_t ble_gap_id_key_t_enc(void const * const p_data,
+uint32_t ble_gap_id_key_t_enc(void const * const p_void_struct,
                               uint8_t * const    p_buf,
                               uint32_t           buf_len,
                               uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_id_key_t * p_id_key = (ble_gap_id_key_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = ble_gap_irk_enc(&(p_id_key->id_info), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_gap_addr_enc(&(p_id_key->id_addr_info), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_id_key_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_id_key_t_dec(uint8_t const * const p_buf,
                               uint32_t              buf_len,
                               uint32_t * const      p_index,
-                              void * const          p_data)
+                              void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_id_key_t * p_id_key = (ble_gap_id_key_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = ble_gap_irk_dec(p_buf, buf_len, p_index, &(p_id_key->id_info));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_gap_addr_dec(p_buf, buf_len, p_index, &(p_id_key->id_addr_info));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_gap_id_key_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_gap_sec_keyset_t_enc(void const * const p_data,
+uint32_t ble_gap_sec_keyset_t_enc(void const * const p_void_struct,
                                   uint8_t * const    p_buf,
                                   uint32_t           buf_len,
                                   uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_sec_keyset_t * p_sec_keyset = (ble_gap_sec_keyset_t *) p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = ble_gap_sec_keys_enc(&(p_sec_keyset->keys_own), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_gap_sec_keys_enc(&(p_sec_keyset->keys_peer), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gap_sec_keyset_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_sec_keyset_t_dec(uint8_t const * const p_buf,
                                   uint32_t              buf_len,
                                   uint32_t * const      p_index,
-                                  void * const          p_data)
+                                  void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_sec_keyset_t * p_sec_keyset = (ble_gap_sec_keyset_t *)p_data;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = ble_gap_sec_keys_dec(p_buf, buf_len, p_index, &(p_sec_keyset->keys_own));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_gap_sec_keys_dec(p_buf, buf_len, p_index, &(p_sec_keyset->keys_peer));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_gap_sec_keyset_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gap_evt_sec_request_t_enc(void const * const p_void_struct,
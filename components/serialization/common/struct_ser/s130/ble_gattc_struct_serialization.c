@@ -17,6 +17,27 @@
 #include "cond_field_serialization.h"
 #include <string.h>
 
+static const ser_field_codec_t ble_uuid_codec = { ble_uuid_t_enc, ble_uuid_t_dec };
+
+SER_STRUCT_DESC_DEF(ble_gattc_handle_range_desc,
+                    SER_FIELD_UINT16(ble_gattc_handle_range_t, start_handle),
+                    SER_FIELD_UINT16(ble_gattc_handle_range_t, end_handle));
+
+SER_STRUCT_DESC_DEF(ble_gattc_service_desc,
+                    SER_FIELD_CUSTOM(ble_gattc_service_t, uuid, ble_uuid_codec),
+                    SER_FIELD_STRUCT(ble_gattc_service_t, handle_range, ble_gattc_handle_range_desc));
+
+SER_STRUCT_DESC_DEF(ble_gattc_include_desc,
+                    SER_FIELD_UINT16(ble_gattc_include_t, handle),
+                    SER_FIELD_STRUCT(ble_gattc_include_t, included_srvc, ble_gattc_service_desc));
+
+SER_STRUCT_DESC_DEF(ble_gattc_write_params_desc,
+                    SER_FIELD_UINT8(ble_gattc_write_params_t, write_op),
+                    SER_FIELD_UINT8(ble_gattc_write_params_t, flags),
+                    SER_FIELD_UINT16(ble_gattc_write_params_t, handle),
+                    SER_FIELD_UINT16(ble_gattc_write_params_t, offset),
+                    SER_FIELD_LEN16_DATA(ble_gattc_write_params_t, p_value, len));
+
 uint32_t ble_gattc_evt_char_val_by_uuid_read_rsp_t_enc(void const * const p_void_struct,
                                                        uint8_t * const    p_buf,
                                                        uint32_t           buf_len,
@@ -156,16 +177,7 @@ uint32_t ble_gattc_handle_range_t_enc(void const * const p_void_struct,
                                       uint32_t           buf_len,
                                       uint32_t * const   p_index)
 {
-    ble_gattc_handle_range_t * p_range  = (ble_gattc_handle_range_t *) p_void_struct;
-    uint32_t                   err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&(p_range->start_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&(p_range->end_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gattc_handle_range_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gattc_handle_range_t_dec(uint8_t const * const p_buf,
@@ -173,14 +185,7 @@ uint32_t ble_gattc_handle_range_t_dec(uint8_t const * const p_buf,
                                       uint32_t * const      p_index,
                                       void * const          p_void_struct)
 {
-    ble_gattc_handle_range_t * p_range  = (ble_gattc_handle_range_t *) p_void_struct;
-    uint32_t                   err_code = NRF_SUCCESS;
-
-    SER_ASSERT_LENGTH_LEQ(4, buf_len - *p_index);
-    uint16_dec(p_buf, buf_len, p_index, &(p_range->start_handle));
-    uint16_dec(p_buf, buf_len, p_index, &(p_range->end_handle));
-
-    return err_code;
+    return ser_struct_dec(&ble_gattc_handle_range_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 
@@ -189,15 +194,7 @@ uint32_t ble_gattc_service_t_enc(void const * const p_void_struct,
                                  uint32_t           buf_len,
                                  uint32_t * const   p_index)
 {
-    uint32_t              error_code = NRF_SUCCESS;
-    ble_gattc_service_t * p_service  = (ble_gattc_service_t *) p_void_struct;
-
-    error_code = ble_uuid_t_enc(&(p_service->uuid), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_gattc_handle_range_t_enc(&(p_service->handle_range), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-
-    return error_code;
+    return ser_struct_enc(&ble_gattc_service_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gattc_service_t_dec(uint8_t const * const p_buf,
@@ -205,15 +202,7 @@ uint32_t ble_gattc_service_t_dec(uint8_t const * const p_buf,
                                  uint32_t * const      p_index,
                                  void * const          p_void_struct)
 {
-    uint32_t              error_code = NRF_SUCCESS;
-    ble_gattc_service_t * p_service  = (ble_gattc_service_t *) p_void_struct;
-
-    error_code = ble_uuid_t_dec(p_buf, buf_len, p_index, &(p_service->uuid));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_gattc_handle_range_t_dec(p_buf, buf_len, p_index, &(p_service->handle_range));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-
-    return error_code;
+    return ser_struct_dec(&ble_gattc_service_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gattc_include_t_enc(void const * const p_void_struct,
@@ -221,15 +210,7 @@ uint32_t ble_gattc_include_t_enc(void const * const p_void_struct,
                                  uint32_t           buf_len,
                                  uint32_t * const   p_index)
 {
-    uint32_t              error_code = NRF_SUCCESS;
-    ble_gattc_include_t * p_include  = (ble_gattc_include_t *) p_void_struct;
-
-    error_code = uint16_t_enc(&(p_include->handle), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_gattc_service_t_enc(&(p_include->included_srvc), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-
-    return error_code;
+    return ser_struct_enc(&ble_gattc_include_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gattc_include_t_dec(uint8_t const * const p_buf,
@@ -237,15 +218,7 @@ uint32_t ble_gattc_include_t_dec(uint8_t const * const p_buf,
                                  uint32_t * const      p_index,
                                  void * const          p_void_struct)
 {
-    uint32_t              error_code = NRF_SUCCESS;
-    ble_gattc_include_t * p_include  = (ble_gattc_include_t *) p_void_struct;
-
-    error_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_include->handle));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_gattc_service_t_dec(p_buf, buf_len, p_index, &(p_include->included_srvc));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-
-    return error_code;
+    return ser_struct_dec(&ble_gattc_include_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gattc_evt_rel_disc_rsp_t_enc(void const * const p_void_struct,
@@ -300,66 +273,20 @@ uint32_t ble_gattc_evt_rel_disc_rsp_t_dec(uint8_t const * const p_buf,
     return error_code;
 }
 
-uint32_t ble_gattc_write_params_t_enc(void const * const p_void_write,
+uint32_t ble_gattc_write_params_t_enc(void const * const p_void_struct,
                                       uint8_t * const    p_buf,
                                       uint32_t           buf_len,
                                       uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_void_write);
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    uint32_t err_code = NRF_SUCCESS;
-
-    ble_gattc_write_params_t * p_write = (ble_gattc_write_params_t *)p_void_write;
-
-    err_code = uint8_t_enc(&(p_write->write_op), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&(p_write->flags), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&(p_write->handle), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&(p_write->offset), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = len16data_enc(p_write->p_value, p_write->len, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gattc_write_params_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gattc_write_params_t_dec(uint8_t const * const p_buf,
                                       uint32_t              buf_len,
                                       uint32_t * const      p_index,
-                                      void * const          p_void_write)
+                                      void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_write);
-
-    uint32_t err_code = NRF_SUCCESS;
-
-    ble_gattc_write_params_t * p_write = (ble_gattc_write_params_t *)p_void_write;
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &(p_write->write_op));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &(p_write->flags));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_write->handle));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_write->offset));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = len16data_dec(p_buf, buf_len, p_index, &(p_write->p_value), &(p_write->len));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_gattc_write_params_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gattc_attr_info_t_16_enc(void const * const p_void_struct,
@@ -19,6 +19,12 @@
 #include "cond_field_serialization.h"
 #include <string.h>
 
+SER_STRUCT_DESC_DEF(ble_gatts_char_handles_desc,
+                    SER_FIELD_UINT16(ble_gatts_char_handles_t, value_handle),
+                    SER_FIELD_UINT16(ble_gatts_char_handles_t, user_desc_handle),
+                    SER_FIELD_UINT16(ble_gatts_char_handles_t, cccd_handle),
+                    SER_FIELD_UINT16(ble_gatts_char_handles_t, sccd_handle));
+
 uint32_t ser_ble_gatts_char_pf_dec(uint8_t const * const p_buf,
                                    uint32_t              buf_len,
                                    uint32_t * const      p_index,
@@ -318,43 +324,20 @@ uint32_t ble_gatts_attr_dec(uint8_t const * const p_buf,
     return err_code;
 }
 
-uint32_t ble_gatts_char_handles_enc(void const * const p_void_char_handles,
+uint32_t ble_gatts_char_handles_enc(void const * const p_void_struct,
                                     uint8_t * const    p_buf,
                                     uint32_t           buf_len,
                                     uint32_t * const   p_index)
 {
-    ble_gatts_char_handles_t * p_char_handles = (ble_gatts_char_handles_t *)p_void_char_handles;
-    uint32_t                   err_code       = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&p_char_handles->value_handle, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_char_handles->user_desc_handle, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_char_handles->cccd_handle, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_char_handles->sccd_handle, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_gatts_char_handles_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gatts_char_handles_dec(uint8_t const * const p_buf,
                                     uint32_t              buf_len,
                                     uint32_t * const      p_index,
-                                    void * const          p_void_char_handles)
+                                    void * const          p_void_struct)
 {
-    ble_gatts_char_handles_t * p_char_handles = (ble_gatts_char_handles_t *)p_void_char_handles;
-
-    SER_ASSERT_LENGTH_LEQ(8, buf_len - *p_index);
-    uint16_dec(p_buf, buf_len, p_index, &(p_char_handles->value_handle));
-    uint16_dec(p_buf, buf_len, p_index, &p_char_handles->user_desc_handle);
-    uint16_dec(p_buf, buf_len, p_index, &p_char_handles->cccd_handle);
-    uint16_dec(p_buf, buf_len, p_index, &p_char_handles->sccd_handle);
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&ble_gatts_char_handles_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_gatts_hvx_params_t_enc(void const * const p_void_hvx_params,
@@ -21,112 +21,81 @@
 #include "cond_field_serialization.h"
 #include <string.h>
 
+SER_STRUCT_DESC_DEF(ble_uuid_desc,
+                    SER_FIELD_UINT16(ble_uuid_t, uuid),
+                    SER_FIELD_UINT8(ble_uuid_t, type));
 
-uint32_t ble_uuid_t_enc(void const * const p_void_uuid,
+SER_STRUCT_DESC_DEF(ble_uuid128_desc,
+                    SER_FIELD_BYTES(ble_uuid128_t, uuid128));
+
+SER_STRUCT_DESC_DEF(ble_l2cap_header_desc,
+                    SER_FIELD_UINT16(ble_l2cap_header_t, len),
+                    SER_FIELD_UINT16(ble_l2cap_header_t, cid));
+
+SER_STRUCT_DESC_DEF(ble_conn_bw_desc,
+                    SER_FIELD_UINT8(ble_conn_bw_t, conn_bw_rx),
+                    SER_FIELD_UINT8(ble_conn_bw_t, conn_bw_tx));
+
+SER_STRUCT_DESC_DEF(ble_common_opt_conn_bw_desc,
+                    SER_FIELD_UINT8(ble_common_opt_conn_bw_t, role),
+                    SER_FIELD_STRUCT(ble_common_opt_conn_bw_t, conn_bw, ble_conn_bw_desc));
+
+SER_STRUCT_DESC_DEF(ble_conn_bw_count_desc,
+                    SER_FIELD_UINT8(ble_conn_bw_count_t, high_count),
+                    SER_FIELD_UINT8(ble_conn_bw_count_t, mid_count),
+                    SER_FIELD_UINT8(ble_conn_bw_count_t, low_count));
+
+SER_STRUCT_DESC_DEF(ble_conn_bw_counts_desc,
+                    SER_FIELD_STRUCT(ble_conn_bw_counts_t, tx_counts, ble_conn_bw_count_desc),
+                    SER_FIELD_STRUCT(ble_conn_bw_counts_t, rx_counts, ble_conn_bw_count_desc));
+
+
+uint32_t ble_uuid_t_enc(void const * const p_void_struct,
                         uint8_t * const    p_buf,
                         uint32_t           buf_len,
                         uint32_t * const   p_index)
 {
-    ble_uuid_t * p_uuid   = (ble_uuid_t *)p_void_uuid;
-    uint32_t     err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&p_uuid->uuid, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_uuid->type, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_uuid_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_uuid_t_dec(uint8_t const * const p_buf,
                         uint32_t              buf_len,
                         uint32_t * const      p_index,
-                        void * const          p_void_uuid)
+                        void * const          p_void_struct)
 {
-    ble_uuid_t * p_uuid = (ble_uuid_t *)p_void_uuid;
-
-    SER_ASSERT_LENGTH_LEQ(3, buf_len - *p_index);
-    uint16_dec(p_buf, buf_len, p_index, &p_uuid->uuid);
-    uint8_dec(p_buf, buf_len, p_index, &p_uuid->type);
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&ble_uuid_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_uuid128_t_enc(void const * const p_void_uuid,
+uint32_t ble_uuid128_t_enc(void const * const p_void_struct,
                            uint8_t * const    p_buf,
                            uint32_t           buf_len,
                            uint32_t * const   p_index)
 {
-    ble_uuid128_t * p_uuid   = (ble_uuid128_t *)p_void_uuid;
-    uint32_t        err_code = NRF_SUCCESS;
-
-    SER_ASSERT_LENGTH_LEQ(16, buf_len - *p_index);
-
-    memcpy(&p_buf[*p_index], p_uuid->uuid128, sizeof (p_uuid->uuid128));
-
-    *p_index += sizeof (p_uuid->uuid128);
-
-    return err_code;
+    return ser_struct_enc(&ble_uuid128_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_uuid128_t_dec(uint8_t const * const p_buf,
                            uint32_t              buf_len,
                            uint32_t * const      p_index,
-                           void * const          p_void_uuid)
+                           void * const          p_void_struct)
 {
-    ble_uuid128_t * p_uuid   = (ble_uuid128_t *)p_void_uuid;
-    uint32_t        err_code = NRF_SUCCESS;
-
-    SER_ASSERT_LENGTH_LEQ(16, buf_len - *p_index);
-
-    memcpy(p_uuid->uuid128, &p_buf[*p_index], sizeof (p_uuid->uuid128));
-
-    *p_index += sizeof (p_uuid->uuid128);
-
-    return err_code;
+    return ser_struct_dec(&ble_uuid128_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_l2cap_header_t_enc(void const * const p_void_header,
+uint32_t ble_l2cap_header_t_enc(void const * const p_void_struct,
                                 uint8_t * const    p_buf,
                                 uint32_t           buf_len,
                                 uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_header);
-
-    ble_l2cap_header_t * p_header = (ble_l2cap_header_t *)p_void_header;
-    uint32_t             err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&(p_header->len), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&(p_header->cid), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_l2cap_header_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_l2cap_header_t_dec(uint8_t const * const p_buf,
                                 uint32_t              buf_len,
                                 uint32_t * const      p_index,
-                                void * const          p_void_header)
+                                void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_header);
-
-    ble_l2cap_header_t * p_header = (ble_l2cap_header_t *)p_void_header;
-    uint32_t             err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_header->len));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_header->cid));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_l2cap_header_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_l2cap_evt_rx_t_enc(void const * const p_void_evt_rx,
@@ -241,180 +210,68 @@ uint32_t ble_enable_params_t_dec(uint8_t const * const p_buf,
     return err_code;
 }
 
-uint32_t ble_conn_bw_t_enc(void const * const p_void_conn_bw,
+uint32_t ble_conn_bw_t_enc(void const * const p_void_struct,
                            uint8_t * const    p_buf,
                            uint32_t           buf_len,
                            uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_conn_bw);
-
-    ble_conn_bw_t * p_conn_bw = (ble_conn_bw_t *)p_void_conn_bw;
-    uint32_t        err_code  = NRF_SUCCESS;
-
-    err_code = uint8_t_enc(&p_conn_bw->conn_bw_rx, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_conn_bw->conn_bw_tx, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_conn_bw_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_conn_bw_t_dec(uint8_t const * const p_buf,
                            uint32_t              buf_len,
                            uint32_t * const      p_index,
-                           void * const          p_void_conn_bw)
+                           void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_conn_bw);
-
-    ble_conn_bw_t * p_conn_bw = (ble_conn_bw_t *)p_void_conn_bw;
-    uint32_t        err_code  = NRF_SUCCESS;
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &p_conn_bw->conn_bw_rx);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &p_conn_bw->conn_bw_tx);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_conn_bw_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_common_opt_conn_bw_t_enc(void const * const p_void_opt_conn_bw,
+uint32_t ble_common_opt_conn_bw_t_enc(void const * const p_void_struct,
                                       uint8_t * const    p_buf,
                                       uint32_t           buf_len,
                                       uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_opt_conn_bw);
-
-    ble_common_opt_conn_bw_t * p_conn_bw = (ble_common_opt_conn_bw_t *)p_void_opt_conn_bw;
-    uint32_t            err_code  = NRF_SUCCESS;
-    uint8_t             byte;
-
-    byte = p_conn_bw->role;
-    err_code = uint8_t_enc(&byte, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_conn_bw_t_enc(&p_conn_bw->conn_bw, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_common_opt_conn_bw_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_common_opt_conn_bw_t_dec(uint8_t const * const p_buf,
                                       uint32_t              buf_len,
                                       uint32_t * const      p_index,
-                                      void * const          p_void_opt_conn_bw)
+                                      void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_opt_conn_bw);
-
-    ble_common_opt_conn_bw_t * p_conn_bw = (ble_common_opt_conn_bw_t *)p_void_opt_conn_bw;
-    uint32_t            err_code  = NRF_SUCCESS;
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &p_conn_bw->role);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_conn_bw_t_dec(p_buf, buf_len, p_index, &p_conn_bw->conn_bw);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_common_opt_conn_bw_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_conn_bw_count_t_enc(void const * const p_void_conn_bw_count,
+uint32_t ble_conn_bw_count_t_enc(void const * const p_void_struct,
                                  uint8_t * const    p_buf,
                                  uint32_t           buf_len,
                                  uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_conn_bw_count);
-
-    ble_conn_bw_count_t * p_conn_bw_count = (ble_conn_bw_count_t *)p_void_conn_bw_count;
-    uint32_t              err_code        = NRF_SUCCESS;
-
-    err_code = uint8_t_enc(&p_conn_bw_count->high_count, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_conn_bw_count->mid_count, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_conn_bw_count->low_count, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_conn_bw_count_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_conn_bw_count_t_dec(uint8_t const * const p_buf,
                                  uint32_t              buf_len,
                                  uint32_t * const      p_index,
-                                 void * const          p_void_conn_bw_count)
+                                 void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_conn_bw_count);
-
-    ble_conn_bw_count_t * p_conn_bw_count = (ble_conn_bw_count_t *)p_void_conn_bw_count;
-    uint32_t              err_code        = NRF_SUCCESS;
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &p_conn_bw_count->high_count);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &p_conn_bw_count->mid_count);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &p_conn_bw_count->low_count);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_conn_bw_count_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
-uint32_t ble_conn_bw_counts_t_enc(void const * const p_void_conn_bw_counts,
+uint32_t ble_conn_bw_counts_t_enc(void const * const p_void_struct,
                                   uint8_t * const    p_buf,
                                   uint32_t           buf_len,
                                   uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_conn_bw_counts);
-
-    ble_conn_bw_counts_t * p_conn_bw_counts = (ble_conn_bw_counts_t *)p_void_conn_bw_counts;
-    uint32_t              err_code        = NRF_SUCCESS;
-
-    err_code = ble_conn_bw_count_t_enc(&p_conn_bw_counts->tx_counts, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_conn_bw_count_t_enc(&p_conn_bw_counts->rx_counts, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_conn_bw_counts_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_conn_bw_counts_t_dec(uint8_t const * const p_buf,
                                   uint32_t              buf_len,
                                   uint32_t * const      p_index,
-                                  void * const          p_void_conn_bw_counts)
+                                  void * const          p_void_struct)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-    SER_ASSERT_NOT_NULL(p_void_conn_bw_counts);
-
-    ble_conn_bw_counts_t * p_conn_bw_counts = (ble_conn_bw_counts_t *)p_void_conn_bw_counts;
-    uint32_t              err_code        = NRF_SUCCESS;
-
-    err_code = ble_conn_bw_count_t_dec(p_buf, buf_len, p_index, &p_conn_bw_counts->tx_counts);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = ble_conn_bw_count_t_dec(p_buf, buf_len, p_index, &p_conn_bw_counts->rx_counts);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&ble_conn_bw_counts_desc, p_buf, buf_len, p_index, p_void_struct);
 }
 
 uint32_t ble_common_enable_params_t_enc(void const * const p_void_common_enable_params,
@@ -55,7 +55,8 @@
 #define HCI_PKT_SYNC_RSP    0x7D02u                                                    /**< Link Control Packet: type SYNC RESPONSE */
 #define HCI_PKT_CONFIG      0xFC03u                                                    /**< Link Control Packet: type CONFIG */
 #define HCI_PKT_CONFIG_RSP  0x7B04u                                                    /**< Link Control Packet: type CONFIG RESPONSE */
-#define HCI_CONFIG_FIELD    0x11u                                                      /**< Configuration field of CONFIG and CONFIG_RSP packet */
+#define HCI_CONFIG_FIELD    (0x10u | SER_PHY_HCI_WINDOW_SIZE)                          /**< Configuration field of CONFIG packet */
+#define HCI_CONFIG_WINDOW_MASK 0x07u                                                   /**< Sliding Window Size bits of the configuration field */
 #define HCI_PKT_SYNC_SIZE   6u                                                         /**< Size of SYNC and SYNC_RSP packet */
 #define HCI_PKT_CONFIG_SIZE 7u                                                         /**< Size of CONFIG and CONFIG_RSP packet */
 #define HCI_LINK_CONTROL_PKT_INVALID 0xFFFFu                                           /**< Size of CONFIG and CONFIG_RSP packet */
@@ -70,6 +71,10 @@
                                                          APP_TIMER_PRESCALER)) /**< Retransmission timeout for application packet in units of timer ticks. */
 #define MAX_RETRY_COUNT                 5                                      /**< Max retransmission retry count for application packets. */
 
+#if (SER_PHY_HCI_WINDOW_SIZE < 1) || (SER_PHY_HCI_WINDOW_SIZE > 7)
+#error "SER_PHY_HCI_WINDOW_SIZE must be between 1 and 7."
+#endif
+
 #if   (defined(HCI_TIMER0))
 #define HCI_TIMER            NRF_TIMER0
 #define HCI_TIMER_IRQn       TIMER0_IRQn
@@ -172,6 +177,19 @@ _static uint32_t m_packet_seq_number; // Sequence number counter of the transmit
 
 _static uint32_t m_tx_retry_count;
 
+_static uint8_t  m_tx_window_size = SER_PHY_HCI_WINDOW_SIZE; // Number of packets which may wait for acknowledgement, as agreed with the peer
+
+#if (SER_PHY_HCI_WINDOW_SIZE > 1)
+_static uint8_t  m_tx_window_buf[SER_PHY_HCI_WINDOW_SIZE][SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE]; // Copies of the packets waiting for acknowledgement
+_static uint16_t m_tx_window_len[SER_PHY_HCI_WINDOW_SIZE];
+_static uint32_t m_tx_window_first;          // Slot of the oldest packet, the one with m_packet_seq_number
+_static uint32_t m_tx_window_count;          // Number of packets waiting for acknowledgement
+_static uint32_t m_tx_window_sent;           // Number of those packets sent since the last retransmission timeout
+_static bool     m_tx_window_slip_busy;      // A packet is being sent by the SLIP layer
+_static bool     m_tx_window_timer_running;  // The retransmission timer is running
+_static bool     m_tx_window_payload_queued; // The packet from the upper layer is in the window but not released yet
+#endif
+
 
 // _static uint32_t m_tx_retx_counter = 0;
 // _static uint32_t m_rx_drop_counter = 0;
@@ -414,13 +432,15 @@ static __INLINE uint8_t packet_seq_nmbr_extract(const uint8_t * p_buffer)
 
 
 /**@brief Function for constructing 1st byte of the packet header of the packet to be transmitted.
+ *
+ * @param[in] seq_number Sequence number of the packet.
  *
  * @return 1st byte of the packet header of the packet to be transmitted
  */
-static __INLINE uint8_t tx_packet_byte_zero_construct(void)
+static __INLINE uint8_t tx_packet_byte_zero_construct(uint8_t seq_number)
 {
     const uint32_t value = DATA_INTEGRITY_MASK | RELIABLE_PKT_MASK |
-                           (packet_ack_get() << 3u) | packet_seq_get();
+                           (packet_ack_get() << 3u) | seq_number;
 
     return (uint8_t) value;
 }
@@ -478,6 +498,7 @@ static __INLINE uint8_t next_expected_ack_number_get(void)
 }
 
 
+#if (SER_PHY_HCI_WINDOW_SIZE == 1)
 /**@brief Function for processing a received acknowledgement packet.
  *
  * Verifies does the received acknowledgement packet has the expected acknowledgement number and
@@ -507,6 +528,7 @@ static bool rx_ack_pkt_valid(const uint8_t * p_buffer)
     return ( (ack_number == expected_ack_number_get()) ||
              (ack_number == next_expected_ack_number_get()) );
 }
+#endif
 
 
 /**@brief Function for decoding a packet type field.
@@ -581,12 +603,14 @@ static uint16_t link_control_packet_decode(const uint8_t * p_buffer, uint32_t le
         {
             packet_type = HCI_LINK_CONTROL_PKT_INVALID;
         }
-        // Verify configuration field (0x11):
-        // - Sliding Window Size       == 1,
+        // Verify configuration field (0x11 to 0x17):
+        // - Sliding Window Size       != 0,
         // - OOF Flow Control          == 0,
         // - Data Integrity Check Type == 1,
         // - Version Number            == 0
-        if (p_buffer[HCI_PKT_CONFIG_SIZE - 1] != HCI_CONFIG_FIELD)
+        if (((p_buffer[HCI_PKT_CONFIG_SIZE - 1] & ~HCI_CONFIG_WINDOW_MASK) !=
+             (HCI_CONFIG_FIELD & ~HCI_CONFIG_WINDOW_MASK)) ||
+            ((p_buffer[HCI_PKT_CONFIG_SIZE - 1] & HCI_CONFIG_WINDOW_MASK) == 0))
         {
             packet_type = HCI_LINK_CONTROL_PKT_INVALID;
         }
@@ -821,16 +845,16 @@ static void hci_slip_event_handler(ser_phy_hci_slip_evt_t * p_event)
 }
 
 
-static void hci_pkt_send(void)
+static void hci_pkt_send(uint8_t seq_number, uint8_t * p_payload, uint16_t payload_length)
 {
     uint32_t err_code;
 
-    m_tx_packet_header[0] = tx_packet_byte_zero_construct();
-    uint16_t type_and_length_fields = ((m_tx_payload_length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
+    m_tx_packet_header[0] = tx_packet_byte_zero_construct(seq_number);
+    uint16_t type_and_length_fields = ((payload_length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
     (void)uint16_encode(type_and_length_fields, &(m_tx_packet_header[1]));
     m_tx_packet_header[3] = header_checksum_calculate(m_tx_packet_header);
     uint16_t crc = crc16_compute(m_tx_packet_header, PKT_HDR_SIZE, NULL);
-    crc = crc16_compute(m_p_tx_payload, m_tx_payload_length, &crc);
+    crc = crc16_compute(p_payload, payload_length, &crc);
     (void)uint16_encode(crc, m_tx_packet_crc);
 
     ser_phy_hci_pkt_params_t pkt_header;
@@ -839,8 +863,8 @@ static void hci_pkt_send(void)
 
     pkt_header.p_buffer      = m_tx_packet_header;
     pkt_header.num_of_bytes  = PKT_HDR_SIZE;
-    pkt_payload.p_buffer     = m_p_tx_payload;
-    pkt_payload.num_of_bytes = m_tx_payload_length;
+    pkt_payload.p_buffer     = p_payload;
+    pkt_payload.num_of_bytes = payload_length;
     pkt_crc.p_buffer         = m_tx_packet_crc;
     pkt_crc.num_of_bytes     = PKT_CRC_SIZE;
     DEBUG_EVT_SLIP_PACKET_TX(0);
@@ -877,7 +901,8 @@ static void hci_link_control_pkt_send(void)
     {
         link_control_payload_len = HCI_PKT_CONFIG_SIZE - PKT_HDR_SIZE;
         (void)uint16_encode(HCI_PKT_CONFIG_RSP, m_tx_link_control_payload);
-        m_tx_link_control_payload[2] = HCI_CONFIG_FIELD;
+        m_tx_link_control_payload[2] = (HCI_CONFIG_FIELD & ~HCI_CONFIG_WINDOW_MASK) |
+                                       m_tx_window_size;
     }
     uint16_t type_and_length_fields = ((link_control_payload_len << 4u) | PKT_TYPE_LINK_CONTROL);
     (void)uint16_encode(type_and_length_fields, &(m_tx_link_control_header[1]));
@@ -901,6 +926,7 @@ static void hci_link_control_pkt_send(void)
 }
 #endif /* HCI_LINK_CONTROL */
 
+#if (SER_PHY_HCI_WINDOW_SIZE == 1)
 static void hci_pkt_sent_upcall(void)
 {
     m_packet_seq_number++; // incoming ACK is valid, increment SEQ
@@ -910,6 +936,7 @@ static void hci_pkt_sent_upcall(void)
 
     return;
 }
+#endif
 
 
 static void hci_release_ack_buffer(hci_evt_t * p_event)
@@ -924,6 +951,7 @@ static void hci_release_ack_buffer(hci_evt_t * p_event)
 }
 
 
+#if (SER_PHY_HCI_WINDOW_SIZE == 1)
 static void hci_process_orphaned_ack(hci_evt_t * p_event)
 {
     hci_release_ack_buffer(p_event);
@@ -941,7 +969,7 @@ static void hci_tx_fsm_event_process(hci_evt_t * p_event)
             if ((p_event->evt_source == HCI_SER_PHY_EVT) &&
                 (p_event->evt.ser_phy_evt.evt_type == HCI_SER_PHY_TX_REQUEST))
             {
-                hci_pkt_send();
+                hci_pkt_send(packet_seq_get(), m_p_tx_payload, m_tx_payload_length);
                 hci_timeout_setup(0);
                 m_tx_retry_count   = MAX_RETRY_COUNT;
                 m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_FIRST_TX_END;
@@ -1008,7 +1036,7 @@ static void hci_tx_fsm_event_process(hci_evt_t * p_event)
                 // m_tx_retx_counter++; // global retransmissions counter
                 if (m_tx_retry_count)
                 {
-                    hci_pkt_send();
+                    hci_pkt_send(packet_seq_get(), m_p_tx_payload, m_tx_payload_length);
                     DEBUG_HCI_RETX(0);
                     m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END;
                 }
@@ -1052,6 +1080,161 @@ static void hci_tx_fsm_event_process(hci_evt_t * p_event)
     }
 }
 
+#else
+
+/**@brief Function for sending the next packet of the window which has not been sent yet. */
+static void hci_window_pkt_send(void)
+{
+    if (!m_tx_window_slip_busy && (m_tx_window_sent < m_tx_window_count))
+    {
+        uint32_t slot = (m_tx_window_first + m_tx_window_sent) % SER_PHY_HCI_WINDOW_SIZE;
+
+        hci_pkt_send((m_packet_seq_number + m_tx_window_sent) & 0x07u,
+                     m_tx_window_buf[slot],
+                     m_tx_window_len[slot]);
+        m_tx_window_slip_busy = true;
+        m_tx_window_sent++;
+    }
+}
+
+
+/**@brief Function for handing the upper layer packet back once it is copied to the window and
+ *        there is room for the next one.
+ */
+static void hci_window_payload_release(void)
+{
+    if (m_tx_window_payload_queued && (m_tx_window_count < m_tx_window_size))
+    {
+        m_tx_window_payload_queued = false;
+        m_p_tx_payload             = NULL;
+        packet_transmitted_callback();
+    }
+}
+
+
+/**@brief Function for processing a received acknowledgement packet.
+ *
+ * An acknowledgement number acknowledges every packet sent before the packet with that sequence
+ * number. An acknowledgement that does not move the window, e.g. a repeated one, is ignored.
+ */
+static void hci_window_ack_process(const uint8_t * p_buffer)
+{
+    const uint32_t expected_checksum =
+        ((p_buffer[0] + p_buffer[1] + p_buffer[2] + p_buffer[3])) & 0xFFu;
+    const uint32_t acked = (((p_buffer[0] >> 3u) & 0x07u) - m_packet_seq_number) & 0x07u;
+
+    if ((expected_checksum != 0) || (acked == 0) || (acked > m_tx_window_count))
+    {
+        return;
+    }
+
+    m_packet_seq_number = (m_packet_seq_number + acked) & 0x07u;
+    m_tx_window_first   = (m_tx_window_first + acked) % SER_PHY_HCI_WINDOW_SIZE;
+    m_tx_window_count  -= acked;
+    m_tx_window_sent    = (m_tx_window_sent > acked) ? (m_tx_window_sent - acked) : 0;
+    m_tx_retry_count    = MAX_RETRY_COUNT;
+
+    // Restart the timer for the oldest packet still waiting, if any.
+    hci_timeout_setup(0);
+    m_tx_window_timer_running = (m_tx_window_sent > 0);
+    if (m_tx_window_timer_running)
+    {
+        hci_timeout_setup(1);
+    }
+
+    hci_window_payload_release();
+    hci_window_pkt_send();
+}
+
+
+/* main tx fsm, sliding window variant */
+static void hci_tx_fsm_event_process(hci_evt_t * p_event)
+{
+    switch (m_hci_tx_fsm_state)
+    {
+        case HCI_TX_STATE_SEND:
+
+            if ((p_event->evt_source == HCI_SER_PHY_EVT) &&
+                (p_event->evt.ser_phy_evt.evt_type == HCI_SER_PHY_TX_REQUEST))
+            {
+                // The upper layer only sends when the window has room, see hci_window_payload_release().
+                uint32_t slot = (m_tx_window_first + m_tx_window_count) % SER_PHY_HCI_WINDOW_SIZE;
+
+                memcpy(m_tx_window_buf[slot], m_p_tx_payload, m_tx_payload_length);
+                m_tx_window_len[slot] = m_tx_payload_length;
+
+                if (m_tx_window_count == 0)
+                {
+                    m_tx_retry_count = MAX_RETRY_COUNT;
+                }
+                m_tx_window_count++;
+                m_tx_window_payload_queued = true;
+                hci_window_pkt_send();
+            }
+            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
+            {
+                m_tx_window_slip_busy = false;
+
+                if (!m_tx_window_timer_running && (m_tx_window_count > 0))
+                {
+                    hci_timeout_setup(1);
+                    m_tx_window_timer_running = true;
+                }
+                hci_window_payload_release();
+                hci_window_pkt_send();
+            }
+            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+            {
+                hci_window_ack_process(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer);
+                hci_release_ack_buffer(p_event);
+            }
+            else if (p_event->evt_source == HCI_TIMER_EVT)
+            {
+                m_tx_window_timer_running = false;
+
+                if (m_tx_window_count == 0)
+                {
+                    break;
+                }
+
+                m_tx_retry_count--;
+                if (m_tx_retry_count)
+                {
+                    // Go back to the oldest packet which is not acknowledged.
+                    m_tx_window_sent = 0;
+                    DEBUG_HCI_RETX(0);
+                    hci_window_pkt_send();
+                }
+                else
+                {
+                    error_callback();
+                    m_tx_window_count          = 0;
+                    m_tx_window_sent           = 0;
+                    m_tx_window_payload_queued = false;
+                    m_p_tx_payload             = NULL;
+                }
+            }
+            break;
+
+#ifdef HCI_LINK_CONTROL
+        case HCI_TX_STATE_DISABLE:
+            /* This case should not happen if HCI is in ACTIVE mode */
+            if (m_hci_mode == HCI_MODE_ACTIVE)
+            {
+                ser_phy_hci_assert(false);
+            }
+            break;
+#endif /* HCI_LINK_CONTROL */
+
+        default:
+            ser_phy_hci_assert(false);
+            break;
+    }
+}
+#endif /* SER_PHY_HCI_WINDOW_SIZE */
+
 
 static void hci_mem_request(hci_evt_t * p_event)
 {
@@ -1337,6 +1520,20 @@ static void hci_rx_event_handler(hci_evt_t * p_event)
 }
 
 #ifdef HCI_LINK_CONTROL
+/**@brief Function for taking the sliding window size from a received CONFIG or CONFIG_RSP packet.
+ *
+ * The window is the smaller of the local one and the one of the peer.
+ */
+static void hci_window_size_set(hci_evt_t * p_event)
+{
+    uint8_t peer_window_size =
+        p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer[HCI_PKT_CONFIG_SIZE - 1] &
+        HCI_CONFIG_WINDOW_MASK;
+
+    m_tx_window_size = MIN(SER_PHY_HCI_WINDOW_SIZE, peer_window_size);
+}
+
+
 /* Link control event handler - used only for Link Control packets */
 /* This handler will be called only in 2 cases:
    - when SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED event is received 
@@ -1366,6 +1563,12 @@ static void hci_link_control_event_handler(hci_evt_t * p_event)
                         m_hci_tx_fsm_state  = HCI_TX_STATE_DISABLE;
                         m_hci_rx_fsm_state  = HCI_RX_STATE_DISABLE;
                         m_hci_other_side_active = false;
+#if (SER_PHY_HCI_WINDOW_SIZE > 1)
+                        m_tx_window_count       = 0;
+                        m_tx_window_sent        = 0;
+                        m_tx_window_slip_busy   = false;
+                        m_tx_window_timer_running = false;
+#endif
                     }
                     hci_link_control_pkt_send();
                     hci_timeout_setup(HCI_LINK_CONTROL_TIMEOUT); // Need to trigger transmitting SYNC messages
@@ -1380,6 +1583,7 @@ static void hci_link_control_event_handler(hci_evt_t * p_event)
                 case HCI_PKT_CONFIG:
                     if (m_hci_mode != HCI_MODE_UNINITIALIZED)
                     {
+                        hci_window_size_set(p_event);
                         m_hci_link_control_next_pkt = HCI_PKT_CONFIG_RSP;
                         hci_link_control_pkt_send();
                         m_hci_other_side_active = true;
@@ -1388,6 +1592,7 @@ static void hci_link_control_event_handler(hci_evt_t * p_event)
                 case HCI_PKT_CONFIG_RSP:
                     if (m_hci_mode == HCI_MODE_INITIALIZED)
                     {
+                        hci_window_size_set(p_event);
                         m_hci_mode          = HCI_MODE_ACTIVE;
                         m_hci_tx_fsm_state  = HCI_TX_STATE_SEND;
                         m_hci_rx_fsm_state  = HCI_RX_STATE_RECEIVE;                        
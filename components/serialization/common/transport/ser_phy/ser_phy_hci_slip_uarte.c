@@ -0,0 +1,535 @@
+
+/* Copyright (c) Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of other
+ * contributors to this software may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * 4. This software must only be used in a processor manufactured by Nordic
+ * Semiconductor ASA, or in a processor manufactured by a third party that
+ * is used in combination with a processor manufactured by Nordic Semiconductor.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**@file
+ *
+ * @brief SLIP layer of the HCI PHY (see @ref ser_phy_hci.h) for the nRF52 UARTE.
+ *
+ * This is a drop-in replacement for ser_phy_hci_slip.c. Whole SLIP frames are encoded into RAM
+ * and sent in a single EasyDMA transfer, and reception runs continuously over rotating EasyDMA
+ * buffers (@ref nrf_drv_uart_rx_stream_start), which are decoded a buffer at a time. The CPU is
+ * no longer interrupted for every byte, so the link can run at 1 Mbaud with hardware flow
+ * control.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nrf_error.h"
+#include "nrf_drv_uart.h"
+#include "nrf_drv_timer.h"
+#include "app_uart.h"
+#include "ser_phy_hci.h"
+#include "app_util_platform.h"
+
+#ifdef SER_CONNECTIVITY
+#include "ser_phy_config_conn_nrf51.h"
+#else
+#include "ser_phy_config_app_nrf51.h"
+#endif /* SER_CONNECTIVITY */
+
+#include "ser_config.h"
+
+#if (UART_RX_STREAM_SUPPORT != 1)
+#error "UARTE SLIP PHY requires UART_RX_STREAM_SUPPORT in nrf_drv_config.h"
+#endif
+
+#define APP_SLIP_END     0xC0 /**< SLIP code for identifying the beginning and end of a packet frame.. */
+#define APP_SLIP_ESC     0xDB /**< SLIP escape code. This code is used to specify that the following character is specially encoded. */
+#define APP_SLIP_ESC_END 0xDC /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xC0.. */
+#define APP_SLIP_ESC_ESC 0xDD /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xDB. */
+
+#define HDR_SIZE 4
+#define CRC_SIZE 2
+#define PKT_SIZE (SER_HAL_TRANSPORT_MAX_PKT_SIZE + HDR_SIZE + CRC_SIZE)
+
+/** Worst case SLIP frame: every byte escaped, plus the start and end codes. */
+#define SLIP_FRAME_SIZE (2 * PKT_SIZE + 2)
+
+/** Line idle time after which a partly filled reception buffer is decoded (10 characters). */
+#ifndef SER_PHY_UARTE_RX_TIMEOUT_US
+#define SER_PHY_UARTE_RX_TIMEOUT_US ((100uL * 1000000uL) / SER_PHY_UART_BAUDRATE_VAL + 1)
+#endif
+
+static const nrf_drv_uart_config_t m_uart_config =
+{
+    .pseltxd            = SER_PHY_UART_TX,
+    .pselrxd            = SER_PHY_UART_RX,
+    .pselcts            = SER_PHY_UART_CTS,
+    .pselrts            = SER_PHY_UART_RTS,
+    .p_context          = NULL,
+    // Below values are defined in ser_config.h common for application and connectivity
+    .hwfc               = (SER_PHY_UART_FLOW_CTRL == APP_UART_FLOW_CONTROL_ENABLED) ?
+                          NRF_UART_HWFC_ENABLED : NRF_UART_HWFC_DISABLED,
+    .parity             = SER_PHY_UART_PARITY ? NRF_UART_PARITY_INCLUDED : NRF_UART_PARITY_EXCLUDED,
+    .baudrate           = (nrf_uart_baudrate_t)SER_PHY_UART_BAUDRATE,
+    .interrupt_priority = UART_IRQ_PRIORITY,
+    .use_easy_dma       = true
+};
+
+static const nrf_drv_timer_t m_counter_timer = NRF_DRV_TIMER_INSTANCE(SER_PHY_UARTE_COUNTER_TIMER);
+static const nrf_drv_timer_t m_timeout_timer = NRF_DRV_TIMER_INSTANCE(SER_PHY_UARTE_TIMEOUT_TIMER);
+
+static uint8_t m_rx_dma_buffer[SER_PHY_UARTE_RX_BUF_COUNT * SER_PHY_UARTE_RX_BUF_SIZE];
+static uint8_t m_tx_buffer[SLIP_FRAME_SIZE];
+
+static uint8_t m_small_buffer[HDR_SIZE];
+static uint8_t m_big_buffer[PKT_SIZE];
+
+static uint8_t * mp_small_buffer = NULL;
+static uint8_t * mp_big_buffer   = NULL;
+static uint8_t * mp_buffer       = NULL;
+
+static ser_phy_hci_pkt_params_t m_header_pending;
+static ser_phy_hci_pkt_params_t m_payload_pending;
+static ser_phy_hci_pkt_params_t m_crc_pending;
+
+static ser_phy_hci_slip_evt_t           m_ser_phy_hci_slip_event;
+static ser_phy_hci_slip_event_handler_t m_ser_phy_hci_slip_event_handler; /**< Event handler for upper layer */
+
+static bool m_rx_sync   = false; /**< Flag indicating that the start of a frame has been found */
+static bool m_rx_escape = false;
+
+static bool m_tx_busy = false; /**< Flag indicating that currently some transmission is ongoing */
+static bool m_tx_ack  = false; /**< Flag indicating that the ongoing transmission is an ACK */
+
+static uint32_t m_rx_index;
+// ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__STATIC_INLINE void callback_hw_error(uint32_t error_src)
+{
+    m_ser_phy_hci_slip_event.evt_type = SER_PHY_HCI_SLIP_EVT_HW_ERROR;
+
+    // Pass error source to upper layer
+    m_ser_phy_hci_slip_event.evt_params.hw_error.error_code = error_src;
+    m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
+}
+
+
+static uint32_t slip_encode(uint8_t * p_dst, const ser_phy_hci_pkt_params_t * p_src)
+{
+    uint32_t len = 0;
+    uint32_t i;
+
+    if (p_src == NULL || p_src->p_buffer == NULL)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < p_src->num_of_bytes; i++)
+    {
+        switch (p_src->p_buffer[i])
+        {
+            case APP_SLIP_END:
+                p_dst[len++] = APP_SLIP_ESC;
+                p_dst[len++] = APP_SLIP_ESC_END;
+                break;
+
+            case APP_SLIP_ESC:
+                p_dst[len++] = APP_SLIP_ESC;
+                p_dst[len++] = APP_SLIP_ESC_ESC;
+                break;
+
+            default:
+                p_dst[len++] = p_src->p_buffer[i];
+                break;
+        }
+    }
+
+    return len;
+}
+
+
+/* Encodes the whole frame into the DMA buffer and starts its transmission. */
+static void tx_frame_start(const ser_phy_hci_pkt_params_t * p_header,
+                           const ser_phy_hci_pkt_params_t * p_payload,
+                           const ser_phy_hci_pkt_params_t * p_crc)
+{
+    uint32_t len = 0;
+
+    m_tx_ack = (p_payload == NULL) || (p_payload->p_buffer == NULL);
+
+    m_tx_buffer[len++] = APP_SLIP_END;
+    len += slip_encode(&m_tx_buffer[len], p_header);
+
+    if (!m_tx_ack)
+    {
+        len += slip_encode(&m_tx_buffer[len], p_payload);
+        len += slip_encode(&m_tx_buffer[len], p_crc);
+    }
+    m_tx_buffer[len++] = APP_SLIP_END;
+
+    (void)nrf_drv_uart_tx(m_tx_buffer, len);
+}
+
+
+static void tx_done_handle(void)
+{
+    m_ser_phy_hci_slip_event.evt_type = m_tx_ack ? SER_PHY_HCI_SLIP_EVT_ACK_SENT :
+                                                   SER_PHY_HCI_SLIP_EVT_PKT_SENT;
+
+    if (m_header_pending.p_buffer != NULL)
+    {
+        tx_frame_start(&m_header_pending, &m_payload_pending, &m_crc_pending);
+
+        m_header_pending.p_buffer      = NULL;
+        m_header_pending.num_of_bytes  = 0;
+        m_payload_pending.p_buffer     = NULL;
+        m_payload_pending.num_of_bytes = 0;
+        m_crc_pending.p_buffer         = NULL;
+        m_crc_pending.num_of_bytes     = 0;
+    }
+    else
+    {
+        m_tx_busy = false;
+    }
+
+    /* Report end of ACK or packet transmission*/
+    m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
+}
+
+
+uint32_t ser_phy_hci_slip_tx_pkt_send(const ser_phy_hci_pkt_params_t * p_header,
+                                      const ser_phy_hci_pkt_params_t * p_payload,
+                                      const ser_phy_hci_pkt_params_t * p_crc)
+{
+    if (p_header == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    /* Start packet transmission only if no other tx is ongoing */
+    if (!m_tx_busy)
+    {
+        m_tx_busy = true;
+        tx_frame_start(p_header, p_payload, p_crc);
+    }
+    /* Tx is ongoing, schedule transmission as pending */
+    else
+    {
+        if (p_crc != NULL)
+        {
+            m_crc_pending = *p_crc;
+        }
+
+        if (p_payload != NULL)
+        {
+            m_payload_pending = *p_payload;
+        }
+
+        m_header_pending = *p_header;
+    }
+
+    CRITICAL_REGION_EXIT();
+    return NRF_SUCCESS;
+}
+
+
+/* Appends decoded bytes to the packet being received. Returns false when the packet cannot be
+ * stored, in which case it is dropped. */
+static bool rx_bytes_store(const uint8_t * p_data, uint32_t length)
+{
+    if (m_rx_index == 0)
+    {
+        /* Start with small (ACK) buffer if available*/
+        mp_buffer = (mp_small_buffer != NULL) ? mp_small_buffer : mp_big_buffer;
+
+        if (mp_buffer == NULL)
+        {
+            /* Both buffers are not available - cannot continue reception*/
+            return false;
+        }
+    }
+
+    /* Check if switch between small and big buffer is needed*/
+    if ((mp_buffer == m_small_buffer) && (m_rx_index + length > HDR_SIZE))
+    {
+        if (mp_big_buffer == NULL)
+        {
+            /* Small buffer is too small and big buffer not available - cannot continue reception*/
+            return false;
+        }
+        memcpy(m_big_buffer, m_small_buffer, m_rx_index);
+        mp_buffer = m_big_buffer;
+    }
+
+    if (m_rx_index + length > PKT_SIZE)
+    {
+        /* Do not notify upper layer - the packet is too big and cannot be handled by slip */
+        return false;
+    }
+
+    memcpy(&mp_buffer[m_rx_index], p_data, length);
+    m_rx_index += length;
+
+    return true;
+}
+
+
+static void rx_pkt_end(void)
+{
+    /* Reset pointers to signalise buffers are locked waiting for upper layer */
+    if (mp_buffer == m_small_buffer)
+    {
+        mp_small_buffer = NULL;
+    }
+    else
+    {
+        mp_big_buffer = NULL;
+    }
+
+    /* Report packet reception end*/
+    m_ser_phy_hci_slip_event.evt_type = SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED;
+    m_ser_phy_hci_slip_event.evt_params.received_pkt.p_buffer     = mp_buffer;
+    m_ser_phy_hci_slip_event.evt_params.received_pkt.num_of_bytes = m_rx_index;
+    m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
+
+    m_rx_index = 0;
+}
+
+
+/* Decodes a chunk of received data. Runs of plain bytes are copied at once. */
+static void rx_data_process(const uint8_t * p_data, uint32_t length)
+{
+    const uint8_t * p_end = p_data + length;
+
+    while (p_data < p_end)
+    {
+        if (!m_rx_sync)
+        {
+            /* Wait for SLIP packet start: 0xC0*/
+            p_data = memchr(p_data, APP_SLIP_END, (size_t)(p_end - p_data));
+            if (p_data == NULL)
+            {
+                return;
+            }
+            p_data++;
+
+            m_rx_sync   = true;
+            m_rx_escape = false;
+            m_rx_index  = 0;
+        }
+        else if (m_rx_escape)
+        {
+            uint8_t byte = *p_data++;
+
+            m_rx_escape = false;
+
+            if (byte == APP_SLIP_ESC_END)
+            {
+                byte = APP_SLIP_END;
+            }
+            else if (byte == APP_SLIP_ESC_ESC)
+            {
+                byte = APP_SLIP_ESC;
+            }
+            else
+            {
+                /* Invalid escape sequence - drop the packet*/
+                m_rx_sync = false;
+                continue;
+            }
+
+            m_rx_sync = rx_bytes_store(&byte, 1);
+        }
+        else if (*p_data == APP_SLIP_END)
+        {
+            p_data++;
+
+            /* End of packet. Empty frames come from back-to-back 0xC0 codes*/
+            if (m_rx_index != 0)
+            {
+                rx_pkt_end();
+
+                /* Skip any noise up to the start of the next packet*/
+                m_rx_sync = false;
+            }
+        }
+        else if (*p_data == APP_SLIP_ESC)
+        {
+            p_data++;
+            m_rx_escape = true;
+        }
+        else
+        {
+            const uint8_t * p_run = p_data;
+
+            while ((p_data < p_end) && (*p_data != APP_SLIP_END) && (*p_data != APP_SLIP_ESC))
+            {
+                p_data++;
+            }
+
+            m_rx_sync = rx_bytes_store(p_run, (uint32_t)(p_data - p_run));
+        }
+
+        if (!m_rx_sync)
+        {
+            m_rx_index = 0;
+        }
+    }
+}
+
+
+uint32_t ser_phy_hci_slip_rx_buf_free(uint8_t * p_buffer)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (p_buffer == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if (p_buffer == m_small_buffer)
+    {
+        /* Free small buffer*/
+        if (mp_small_buffer == NULL)
+        {
+            mp_small_buffer = m_small_buffer;
+        }
+        else
+        {
+            err_code = NRF_ERROR_INVALID_STATE;
+        }
+    }
+    else if (p_buffer == m_big_buffer)
+    {
+        /* Free big buffer*/
+        if (mp_big_buffer == NULL)
+        {
+            mp_big_buffer = m_big_buffer;
+        }
+        else
+        {
+            err_code = NRF_ERROR_INVALID_STATE;
+        }
+    }
+
+    return err_code;
+}
+
+
+static void uart_evt_handler(nrf_drv_uart_event_t * p_event, void * p_context)
+{
+    switch (p_event->type)
+    {
+        case NRF_DRV_UART_EVT_ERROR:
+
+            // Process error only if this is parity or overrun error.
+            // Break and framing error is always present when app side is not active
+            if (p_event->data.error.error_mask &
+                (NRF_UART_ERROR_PARITY_MASK | NRF_UART_ERROR_OVERRUN_MASK))
+            {
+                callback_hw_error(p_event->data.error.error_mask);
+            }
+            break;
+
+        case NRF_DRV_UART_EVT_TX_DONE:
+            tx_done_handle();
+            break;
+
+        case NRF_DRV_UART_EVT_RX_DATA:
+            rx_data_process(p_event->data.rxtx.p_data, p_event->data.rxtx.bytes);
+            break;
+
+        case NRF_DRV_UART_EVT_RX_DONE:
+            // Reception stopped on close
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+uint32_t ser_phy_hci_slip_open(ser_phy_hci_slip_event_handler_t events_handler)
+{
+    uint32_t err_code;
+
+    const nrf_drv_uart_rx_stream_config_t stream_config =
+    {
+        .p_buffer        = m_rx_dma_buffer,
+        .buffer_size     = SER_PHY_UARTE_RX_BUF_SIZE,
+        .buffer_count    = SER_PHY_UARTE_RX_BUF_COUNT,
+        .timeout_us      = SER_PHY_UARTE_RX_TIMEOUT_US,
+        .p_counter_timer = &m_counter_timer,
+        .p_timeout_timer = &m_timeout_timer
+    };
+
+    if (events_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    // Check if function was not called before
+    if (m_ser_phy_hci_slip_event_handler != NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    mp_small_buffer = m_small_buffer;
+    mp_big_buffer   = m_big_buffer;
+    m_rx_sync       = false;
+    m_tx_busy       = false;
+
+    m_header_pending.p_buffer = NULL;
+
+    m_ser_phy_hci_slip_event_handler = events_handler;
+
+    err_code = nrf_drv_uart_init(&m_uart_config, uart_evt_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        m_ser_phy_hci_slip_event_handler = NULL;
+        return err_code;
+    }
+
+    err_code = nrf_drv_uart_rx_stream_start(&stream_config);
+    if (err_code != NRF_SUCCESS)
+    {
+        m_ser_phy_hci_slip_event_handler = NULL;
+        nrf_drv_uart_uninit();
+    }
+
+    return err_code;
+}
+
+
+void ser_phy_hci_slip_close(void)
+{
+    nrf_drv_uart_rx_stream_stop();
+    nrf_drv_uart_uninit();
+    m_ser_phy_hci_slip_event_handler = NULL;
+}
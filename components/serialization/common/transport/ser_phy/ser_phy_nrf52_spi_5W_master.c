@@ -0,0 +1,866 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/**@file
+ *
+ * @defgroup ser_phy_spi_5W_phy_driver_master_easydma ser_phy_nrf52_spi_5W_master.c
+ * @{
+ * @ingroup ser_phy_spi_5W_phy_driver_master
+ *
+ * @brief SPI_5W_RAW PHY master driver for nRF52, using SPIM with EasyDMA.
+ *
+ * @details Wire compatible with @ref ser_phy_spi_5W_phy_driver_slave. Every header and payload
+ *          frame is clocked as a single EasyDMA transaction, so the CPU is interrupted once per
+ *          frame instead of once per byte. The guard byte sent by the slave as the first byte of
+ *          every transaction is checked when the transaction is completed; a transaction ignored
+ *          by the slave (guard different from 0) is repeated as a whole. The selected SPI
+ *          instance must have SPIx_USE_EASY_DMA set in nrf_drv_config.h.
+ */
+
+#include <stdio.h>
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "boards.h"
+#include "nrf_error.h"
+#include "nrf_gpio.h"
+#include "nrf_drv_gpiote.h"
+#include "ser_config.h"
+#include "ser_config_5W_app.h"
+#include "ser_phy.h"
+#include "ser_phy_config_app_nrf51.h"
+#include "nrf_drv_spi.h"
+#include "ser_phy_debug_app.h"
+#include "app_error.h"
+#define notUSE_PendSV
+
+#define _SPI_5W_
+
+#ifdef USE_PendSV
+#define SW_IRQn              PendSV_IRQn
+#define SW_IRQ_Handler()     PendSV_Handler()
+#define SET_Pend_SW_IRQ()    SCB->ICSR = SCB->ICSR | SCB_ICSR_PENDSVSET_Msk //NVIC_SetPendingIRQ(PendSV_IRQn) -  PendSV_IRQn is a negative - does not work with CMSIS
+#elif defined NRF52
+#define SW_IRQn              SWI3_EGU3_IRQn
+#define SW_IRQ_Handler()     SWI3_EGU3_IRQHandler()
+#define SET_Pend_SW_IRQ()    NVIC_SetPendingIRQ(SWI3_EGU3_IRQn)
+#else
+#define SW_IRQn              SWI3_IRQn
+#define SW_IRQ_Handler()     SWI3_IRQHandler()
+#define SET_Pend_SW_IRQ()    NVIC_SetPendingIRQ(SWI3_IRQn)
+#endif
+
+#define SER_PHY_SPI_5W_MTU_SIZE SER_PHY_SPI_MTU_SIZE
+
+#define SER_PHY_SPI_5W_GUARD    0x00 //first byte clocked out by a slave which has set its buffers
+
+typedef enum
+{
+    SER_PHY_STATE_IDLE = 0,
+    SER_PHY_STATE_TX_HEADER,
+    SER_PHY_STATE_TX_WAIT_FOR_RDY,
+    SER_PHY_STATE_TX_PAYLOAD,
+    SER_PHY_STATE_RX_WAIT_FOR_RDY,
+    SER_PHY_STATE_TX_ZERO_HEADER,
+    SER_PHY_STATE_RX_HEADER,
+    SER_PHY_STATE_MEMORY_REQUEST,
+    SER_PHY_STATE_RX_PAYLOAD,
+    SER_PHY_STATE_DISABLED
+} ser_phy_spi_master_state_t;
+
+typedef enum
+{
+    SER_PHY_EVT_GPIO_RDY = 0,
+    SER_PHY_EVT_GPIO_REQ,
+    SER_PHY_EVT_SPI_TRANSFER_DONE,
+    SER_PHY_EVT_TX_API_CALL,
+    SER_PHY_EVT_RX_API_CALL
+} ser_phy_event_source_t;
+
+#define _static static
+
+_static uint8_t * mp_tx_buffer = NULL;
+_static uint16_t  m_tx_buf_len = 0;
+
+_static uint8_t * mp_rx_buffer = NULL;
+_static uint16_t  m_rx_buf_len = 0;
+_static uint8_t   m_recv_buffer[SER_PHY_SPI_5W_MTU_SIZE];
+_static uint8_t   m_len_buffer[SER_PHY_HEADER_SIZE + 1] = { 0 }; //len is asymmetric for 5W, there is a 1 byte guard when receiving
+
+_static uint16_t m_tx_packet_length             = 0;
+_static uint16_t m_accumulated_tx_packet_length = 0;
+_static uint16_t m_current_tx_packet_length     = 0;
+
+_static uint16_t m_rx_packet_length             = 0;
+_static uint16_t m_accumulated_rx_packet_length = 0;
+_static uint16_t m_current_rx_packet_length     = 0;
+
+_static volatile bool m_pend_req_flag    = 0;
+_static volatile bool m_pend_rdy_flag    = 0;
+_static volatile bool m_pend_xfer_flag   = 0;
+_static volatile bool m_pend_rx_api_flag = 0;
+_static volatile bool m_pend_tx_api_flag = 0;
+
+_static volatile bool m_slave_ready_flag   = false;
+_static volatile bool m_slave_request_flag = false;
+
+
+_static ser_phy_events_handler_t   m_callback_events_handler = NULL;
+_static ser_phy_spi_master_state_t m_spi_master_state        = SER_PHY_STATE_DISABLED;
+
+_static const nrf_drv_spi_t m_spi_master = SER_PHY_SPI_MASTER_INSTANCE;
+
+/* Last started transaction, kept to repeat it when the slave has not been ready for it */
+_static uint8_t * mp_xfer_tx_buffer = NULL;
+_static uint8_t   m_xfer_tx_length  = 0;
+_static uint8_t * mp_xfer_rx_buffer = NULL;
+_static uint8_t   m_xfer_rx_length  = 0;
+_static uint8_t   m_xfer_guard      = 0; //receives the guard of transactions without RX data
+
+static void ser_phy_switch_state(ser_phy_event_source_t evt_src);
+
+static void spi_master_raw_assert(bool cond)
+{
+    APP_ERROR_CHECK_BOOL(cond);
+}
+
+void SW_IRQ_Handler()
+{
+    if (m_pend_req_flag)
+    {
+        m_pend_req_flag = false;
+        DEBUG_EVT_SPI_MASTER_RAW_REQUEST(0);
+        ser_phy_switch_state(SER_PHY_EVT_GPIO_REQ);
+    }
+
+    if (m_pend_rdy_flag)
+    {
+        m_pend_rdy_flag = false;
+        DEBUG_EVT_SPI_MASTER_RAW_READY(0);
+        ser_phy_switch_state(SER_PHY_EVT_GPIO_RDY);
+    }
+
+    if (m_pend_xfer_flag)
+    {
+        m_pend_xfer_flag = false;
+        DEBUG_EVT_SPI_MASTER_RAW_XFER_DONE(0);
+        ser_phy_switch_state(SER_PHY_EVT_SPI_TRANSFER_DONE);
+    }
+
+    if (m_pend_rx_api_flag)
+    {
+        m_pend_rx_api_flag = false;
+        DEBUG_EVT_SPI_MASTER_RAW_API_CALL(0);
+        ser_phy_switch_state(SER_PHY_EVT_RX_API_CALL);
+    }
+
+    if (m_pend_tx_api_flag)
+    {
+        m_pend_tx_api_flag = false;
+        DEBUG_EVT_SPI_MASTER_RAW_API_CALL(0);
+        ser_phy_switch_state(SER_PHY_EVT_TX_API_CALL);
+    }
+
+}
+
+void ser_phy_spi_master_ready(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+
+#ifdef _SPI_5W_
+      //For 5W slave is considered to be always READY
+      m_slave_ready_flag = true;
+      m_pend_rdy_flag  = false;
+ #else
+      if (nrf_gpio_pin_read(SER_PHY_SPI_MASTER_PIN_SLAVE_READY) == 0)
+      {
+          m_slave_ready_flag = true;
+          m_pend_rdy_flag    = true;
+      }
+      else
+      {
+          m_slave_ready_flag = false;
+      }
+
+      DEBUG_EVT_SPI_MASTER_RAW_READY_EDGE((uint32_t) !m_slave_ready_flag);
+#endif
+
+}
+
+void ser_phy_spi_master_request(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    if (nrf_gpio_pin_read(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST) == 0)
+    {
+        m_slave_request_flag = true;
+        m_pend_req_flag      = true;
+    }
+    else
+    {
+        m_slave_request_flag = false;
+    }
+
+    DEBUG_EVT_SPI_MASTER_RAW_REQUEST_EDGE((uint32_t) !m_slave_request_flag);
+    SET_Pend_SW_IRQ();
+}
+
+/* Send event SER_PHY_EVT_TX_PKT_SENT */
+static __INLINE void callback_packet_sent()
+{
+    ser_phy_evt_t event;
+
+    event.evt_type = SER_PHY_EVT_TX_PKT_SENT;
+    m_callback_events_handler(event);
+}
+
+/* Send event SER_PHY_EVT_RX_PKT_DROPPED */
+static __INLINE void callback_packet_dropped()
+{
+    ser_phy_evt_t event;
+
+    event.evt_type = SER_PHY_EVT_RX_PKT_DROPPED;
+    m_callback_events_handler(event);
+}
+
+/* Send event SER_PHY_EVT_RX_PKT_RECEIVED */
+static __INLINE void callback_packet_received()
+{
+    ser_phy_evt_t event;
+
+    event.evt_type = SER_PHY_EVT_RX_PKT_RECEIVED;
+    event.evt_params.rx_pkt_received.p_buffer     = mp_rx_buffer;
+    event.evt_params.rx_pkt_received.num_of_bytes = m_rx_buf_len;
+    m_callback_events_handler(event);
+}
+
+/* Send event SER_PHY_EVT_RX_BUF_REQUEST */
+static __INLINE void callback_mem_request()
+{
+    ser_phy_evt_t event;
+
+    event.evt_type                               = SER_PHY_EVT_RX_BUF_REQUEST;
+    event.evt_params.rx_buf_request.num_of_bytes = m_rx_buf_len;
+    m_callback_events_handler(event);
+}
+
+static __INLINE void copy_buff(uint8_t * const p_dest, uint8_t const * const p_src, uint16_t len)
+{
+    uint16_t index;
+
+    for (index = 0; index < len; index++)
+    {
+        p_dest[index] = p_src[index];
+    }
+    return;
+}
+
+static __INLINE void buffer_release(uint8_t * * const pp_buffer, uint16_t * const p_buf_len)
+{
+    *pp_buffer = NULL;
+    *p_buf_len = 0;
+}
+
+static uint16_t compute_current_packet_length(const uint16_t packet_length,
+                                              const uint16_t accumulated_packet_length)
+{
+    uint16_t current_packet_length = packet_length - accumulated_packet_length;
+
+    if (current_packet_length > SER_PHY_SPI_5W_MTU_SIZE)
+    {
+        current_packet_length = SER_PHY_SPI_5W_MTU_SIZE;
+    }
+
+    return current_packet_length;
+}
+
+static __INLINE uint32_t xfer_start(void)
+{
+    DEBUG_EVT_SPI_MASTER_RAW_XFER_GUARDED(0);
+    return nrf_drv_spi_transfer(&m_spi_master,
+                                mp_xfer_tx_buffer,
+                                m_xfer_tx_length,
+                                mp_xfer_rx_buffer,
+                                m_xfer_rx_length);
+}
+
+static uint32_t xfer(uint8_t * const p_tx_buf, const uint16_t tx_buf_len,
+                     uint8_t * const p_rx_buf, const uint16_t rx_buf_len)
+{
+    spi_master_raw_assert((tx_buf_len <= SER_PHY_SPI_5W_MTU_SIZE) &&
+                          (rx_buf_len <= SER_PHY_SPI_5W_MTU_SIZE));
+
+    mp_xfer_tx_buffer = p_tx_buf;
+    m_xfer_tx_length  = (uint8_t)tx_buf_len;
+
+    if (p_rx_buf != NULL)
+    {
+        mp_xfer_rx_buffer = p_rx_buf;
+        m_xfer_rx_length  = (uint8_t)rx_buf_len;
+    }
+    else
+    {
+        //the guard has to be received even when nothing else is read from the slave
+        mp_xfer_rx_buffer = &m_xfer_guard;
+        m_xfer_rx_length  = 1;
+    }
+
+    return xfer_start();
+}
+
+static __INLINE uint32_t header_send(const uint16_t length)
+{
+    uint16_t buf_len_size = uint16_encode(length, m_len_buffer);
+
+    return xfer(m_len_buffer, buf_len_size, NULL, 0);
+}
+
+static __INLINE uint32_t frame_send()
+{
+    uint32_t err_code;
+
+    m_current_tx_packet_length = compute_current_packet_length(m_tx_packet_length,
+                                                               m_accumulated_tx_packet_length);
+    err_code                   =
+        xfer(&mp_tx_buffer[m_accumulated_tx_packet_length],
+             m_current_tx_packet_length,
+             NULL,
+             0);
+    m_accumulated_tx_packet_length += m_current_tx_packet_length;
+    return err_code;
+}
+
+static __INLINE uint32_t header_get()
+{
+    return xfer(NULL, 0, m_len_buffer, SER_PHY_HEADER_SIZE + 1); //add 0 byte guard when receiving
+}
+
+static __INLINE uint32_t frame_get()
+{
+    uint32_t err_code;
+
+    m_current_rx_packet_length = compute_current_packet_length(m_rx_packet_length,
+                                                               m_accumulated_rx_packet_length);
+
+    if (m_current_rx_packet_length < SER_PHY_SPI_5W_MTU_SIZE)
+    {
+        m_current_rx_packet_length++; //take into account guard byte when receiving
+    }
+    err_code = xfer(NULL,
+                    0,
+                    m_recv_buffer,
+                    m_current_rx_packet_length);
+    return err_code;
+}
+
+/**
+ * \brief Master driver main state machine
+ * Executed only in the context of PendSV_Handler()
+ * For UML graph, please refer to SDK documentation
+*/
+
+static void ser_phy_switch_state(ser_phy_event_source_t evt_src)
+{
+    uint32_t    err_code           = NRF_SUCCESS;
+    static bool m_waitForReadyFlag = false; //local scheduling flag to defer RDY events
+
+    switch (m_spi_master_state)
+    {
+
+        case SER_PHY_STATE_IDLE:
+
+            if (evt_src == SER_PHY_EVT_GPIO_REQ)
+            {
+                m_waitForReadyFlag = false;
+
+                if (m_slave_ready_flag)
+                {
+                    m_spi_master_state = SER_PHY_STATE_TX_ZERO_HEADER;
+                    err_code           = header_send(0);
+                }
+                else
+                {
+                    m_spi_master_state = SER_PHY_STATE_RX_WAIT_FOR_RDY;
+                }
+            }
+            else if (evt_src == SER_PHY_EVT_TX_API_CALL)
+            {
+                spi_master_raw_assert(mp_tx_buffer != NULL); //api event with tx_buffer == NULL has no sense
+                m_waitForReadyFlag = false;
+
+                if (m_slave_ready_flag)
+                {
+                    m_spi_master_state = SER_PHY_STATE_TX_HEADER;
+                    err_code           = header_send(m_tx_buf_len);
+                }
+                else
+                {
+                    m_spi_master_state = SER_PHY_STATE_TX_WAIT_FOR_RDY;
+                }
+            }
+            break;
+
+        case SER_PHY_STATE_TX_WAIT_FOR_RDY:
+
+            if (evt_src == SER_PHY_EVT_GPIO_RDY)
+            {
+                m_spi_master_state = SER_PHY_STATE_TX_HEADER;
+                err_code           = header_send(m_tx_buf_len);
+            }
+            break;
+
+        case SER_PHY_STATE_RX_WAIT_FOR_RDY:
+
+            if (evt_src == SER_PHY_EVT_GPIO_RDY)
+            {
+                m_spi_master_state = SER_PHY_STATE_TX_ZERO_HEADER;
+                err_code           = header_send(0);
+
+            }
+            break;
+
+        case SER_PHY_STATE_TX_HEADER:
+
+            if (evt_src == SER_PHY_EVT_SPI_TRANSFER_DONE)
+            {
+                m_tx_packet_length             = m_tx_buf_len;
+                m_accumulated_tx_packet_length = 0;
+
+                if (m_slave_ready_flag)
+                {
+                    m_spi_master_state = SER_PHY_STATE_TX_PAYLOAD;
+                    err_code           = frame_send();
+
+                }
+                else
+                {
+                    m_waitForReadyFlag = true;
+                }
+            }
+            else if ((evt_src == SER_PHY_EVT_GPIO_RDY) && m_waitForReadyFlag)
+            {
+                m_waitForReadyFlag = false;
+                m_spi_master_state = SER_PHY_STATE_TX_PAYLOAD;
+                err_code           = frame_send();
+            }
+
+            break;
+
+        case SER_PHY_STATE_TX_PAYLOAD:
+
+            if (evt_src == SER_PHY_EVT_SPI_TRANSFER_DONE)
+            {
+                if (m_accumulated_tx_packet_length < m_tx_packet_length)
+                {
+                    if (m_slave_ready_flag)
+                    {
+                        err_code = frame_send();
+                    }
+                    else
+                    {
+                        m_waitForReadyFlag = true;
+                    }
+                }
+                else
+                {
+                    spi_master_raw_assert(m_accumulated_tx_packet_length == m_tx_packet_length);
+                    //Release TX buffer
+                    buffer_release(&mp_tx_buffer, &m_tx_buf_len);
+                    callback_packet_sent();
+
+                    if ( m_slave_request_flag)
+                    {
+                        if (m_slave_ready_flag)
+                        {
+                            m_spi_master_state = SER_PHY_STATE_TX_ZERO_HEADER;
+                            err_code           = header_send(0);
+                        }
+                        else
+                        {
+                            m_spi_master_state = SER_PHY_STATE_RX_WAIT_FOR_RDY;
+                        }
+                    }
+                    else
+                    {
+                        m_spi_master_state = SER_PHY_STATE_IDLE; //m_Tx_buffer is NULL - have to wait for API event
+                    }
+                }
+            }
+            else if ((evt_src == SER_PHY_EVT_GPIO_RDY) && m_waitForReadyFlag )
+            {
+                m_waitForReadyFlag = false;
+                err_code           = frame_send();
+            }
+
+            break;
+
+        case SER_PHY_STATE_TX_ZERO_HEADER:
+
+            if (evt_src == SER_PHY_EVT_SPI_TRANSFER_DONE)
+            {
+                if (m_slave_ready_flag)
+                {
+                    m_spi_master_state = SER_PHY_STATE_RX_HEADER;
+                    err_code           = header_get();
+                }
+                else
+                {
+                    m_waitForReadyFlag = true;
+                }
+            }
+            else if ( (evt_src == SER_PHY_EVT_GPIO_RDY) && m_waitForReadyFlag)
+            {
+                m_waitForReadyFlag = false;
+                m_spi_master_state = SER_PHY_STATE_RX_HEADER;
+                err_code           = header_get();
+            }
+            break;
+
+        case SER_PHY_STATE_RX_HEADER:
+
+            if (evt_src == SER_PHY_EVT_SPI_TRANSFER_DONE)
+            {
+                m_spi_master_state = SER_PHY_STATE_MEMORY_REQUEST;
+                m_rx_buf_len       = uint16_decode(&(m_len_buffer[1])); //skip guard when receiving
+                m_rx_packet_length = m_rx_buf_len;
+                callback_mem_request();
+            }
+            break;
+
+        case SER_PHY_STATE_MEMORY_REQUEST:
+
+            if (evt_src == SER_PHY_EVT_RX_API_CALL)
+            {
+                m_accumulated_rx_packet_length = 0;
+
+                if (m_slave_ready_flag)
+                {
+                    m_spi_master_state = SER_PHY_STATE_RX_PAYLOAD;
+                    err_code           = frame_get();
+                }
+                else
+                {
+                    m_waitForReadyFlag = true;
+                }
+            }
+            else if ((evt_src == SER_PHY_EVT_GPIO_RDY) && m_waitForReadyFlag)
+            {
+                m_waitForReadyFlag = false;
+                m_spi_master_state = SER_PHY_STATE_RX_PAYLOAD;
+                err_code           = frame_get();
+            }
+            break;
+
+        case SER_PHY_STATE_RX_PAYLOAD:
+
+            if (evt_src == SER_PHY_EVT_SPI_TRANSFER_DONE)
+            {
+                if (mp_rx_buffer)
+                {
+                    copy_buff(&(mp_rx_buffer[m_accumulated_rx_packet_length]),
+                              &(m_recv_buffer[1]),
+                              m_current_rx_packet_length - 1); //skip guard byte when receiving
+                }
+                m_accumulated_rx_packet_length += (m_current_rx_packet_length - 1);
+
+                if (m_accumulated_rx_packet_length < m_rx_packet_length)
+                {
+                    if (m_slave_ready_flag)
+                    {
+                        err_code = frame_get();
+                    }
+                    else
+                    {
+                        m_waitForReadyFlag = true;
+                    }
+                }
+                else
+                {
+                    spi_master_raw_assert(m_accumulated_rx_packet_length == m_rx_packet_length);
+
+                    if (mp_rx_buffer == NULL)
+                    {
+                        callback_packet_dropped();
+                    }
+                    else
+                    {
+                        callback_packet_received();
+                    }
+                    //Release RX buffer
+                    buffer_release(&mp_rx_buffer, &m_rx_buf_len);
+
+                    if ((mp_tx_buffer != NULL)) //mp_tx_buffer !=NULL, this means that API_EVT was scheduled
+                    {
+                        if (m_slave_ready_flag )
+                        {
+                            err_code           = header_send(m_tx_buf_len);
+                            m_spi_master_state = SER_PHY_STATE_TX_HEADER;
+                        }
+                        else
+                        {
+                            m_spi_master_state = SER_PHY_STATE_TX_WAIT_FOR_RDY;
+                        }
+                    }
+                    else if (m_slave_request_flag)
+                    {
+                        if (m_slave_ready_flag)
+                        {
+                            m_spi_master_state = SER_PHY_STATE_TX_ZERO_HEADER;
+                            err_code           = header_send(0);
+                        }
+                        else
+                        {
+                            m_spi_master_state = SER_PHY_STATE_RX_WAIT_FOR_RDY;
+                        }
+                    }
+                    else
+                    {
+                        m_spi_master_state = SER_PHY_STATE_IDLE;
+                    }
+                }
+            }
+            else if ( evt_src == SER_PHY_EVT_GPIO_RDY && m_waitForReadyFlag)
+            {
+                m_waitForReadyFlag = false;
+                err_code           = frame_get();
+            }
+
+
+            break;
+
+        default:
+            break;
+    }
+
+
+    if (err_code != NRF_SUCCESS)
+    {
+        (void)err_code;
+    }
+}
+
+/* SPI master event handler */
+static void ser_phy_spi_master_event_handler(nrf_drv_spi_evt_t const * p_event)
+{
+    switch (p_event->type)
+    {
+        case NRF_DRV_SPI_EVENT_DONE:
+
+            if (mp_xfer_rx_buffer[0] != SER_PHY_SPI_5W_GUARD)
+            {
+                //slave has ignored the transaction, nothing was exchanged - repeat it
+                DEBUG_EVT_SPI_MASTER_RAW_XFER_RESTARTED(0);
+                (void)xfer_start();
+                break;
+            }
+            DEBUG_EVT_SPI_MASTER_RAW_XFER_PASSED(0);
+
+            /* Switch state */
+            m_pend_xfer_flag = true;
+            SET_Pend_SW_IRQ();
+
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Initialize GPIO */
+static __INLINE void ser_phy_init_gpio()
+{
+    nrf_gpio_cfg_input(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST, NRF_GPIO_PIN_PULLUP);
+    nrf_gpio_cfg_input(SER_PHY_SPI_MASTER_PIN_SLAVE_READY, NRF_GPIO_PIN_PULLUP);
+}
+
+/* Initialize GPIO */
+static __INLINE void ser_phy_init_pendSV()
+{
+    NVIC_SetPriority(SW_IRQn, APP_IRQ_PRIORITY_MID);
+    NVIC_EnableIRQ(SW_IRQn);
+}
+
+/* Initialize GPIOTE */
+static __INLINE void ser_phy_init_gpiote()
+{
+    if (!nrf_drv_gpiote_is_init())
+    {
+        (void)nrf_drv_gpiote_init();
+    }
+    m_slave_request_flag = !(nrf_gpio_pin_read(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST));
+
+    nrf_drv_gpiote_in_config_t config = GPIOTE_CONFIG_IN_SENSE_TOGGLE(true);
+    (void)nrf_drv_gpiote_in_init(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST, &config, ser_phy_spi_master_request);
+    nrf_drv_gpiote_in_event_enable(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST,true);
+    m_slave_request_flag = !(nrf_gpio_pin_read(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST));
+
+
+#ifdef _SPI_5W_
+    m_slave_ready_flag     = true;
+
+#else
+    m_slave_ready_flag   = !(nrf_gpio_pin_read(SER_PHY_SPI_MASTER_PIN_SLAVE_READY));
+    (void)nrf_drv_gpiote_in_init(SER_PHY_SPI_MASTER_PIN_SLAVE_READY, &config, ser_phy_spi_master_ready);
+
+    nrf_drv_gpiote_in_event_enable(SER_PHY_SPI_MASTER_PIN_SLAVE_READY,true);
+#endif
+
+    NVIC_ClearPendingIRQ(SW_IRQn);
+}
+
+static __INLINE void ser_phy_deinit_gpiote()
+{
+    nrf_drv_gpiote_in_uninit(SER_PHY_SPI_MASTER_PIN_SLAVE_REQUEST);
+#ifndef _SPI_5W_
+    nrf_drv_gpiote_in_uninit(SER_PHY_SPI_MASTER_PIN_SLAVE_READY);
+#endif
+
+
+}
+
+/* ser_phy API function */
+uint32_t ser_phy_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of_bytes)
+{
+    if (p_buffer == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (num_of_bytes == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (mp_tx_buffer != NULL)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    ser_phy_interrupts_disable();
+    mp_tx_buffer       = (uint8_t *)p_buffer;
+    m_tx_buf_len       = num_of_bytes;
+    m_pend_tx_api_flag = true;
+    SET_Pend_SW_IRQ();
+    ser_phy_interrupts_enable();
+    return NRF_SUCCESS;
+}
+
+/* ser_phy API function */
+uint32_t ser_phy_rx_buf_set(uint8_t * p_buffer)
+{
+    if (m_spi_master_state != SER_PHY_STATE_MEMORY_REQUEST)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    ser_phy_interrupts_disable();
+    mp_rx_buffer       = p_buffer;
+    m_pend_rx_api_flag = true;
+    SET_Pend_SW_IRQ();
+    ser_phy_interrupts_enable();
+    return NRF_SUCCESS;
+}
+
+/* ser_phy API function */
+uint32_t ser_phy_open(ser_phy_events_handler_t events_handler)
+{
+
+    if (m_spi_master_state != SER_PHY_STATE_DISABLED)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (events_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    uint32_t err_code = NRF_SUCCESS;
+    ser_phy_init_gpio();
+    m_spi_master_state        = SER_PHY_STATE_IDLE;
+    m_callback_events_handler = events_handler;
+    ser_phy_init_gpiote();
+
+    /* Configure SPI Master driver */
+    nrf_drv_spi_config_t spi_master_config = {
+        .sck_pin      = SER_PHY_SPI_MASTER_PIN_SCK,
+        .mosi_pin     = SER_PHY_SPI_MASTER_PIN_MOSI,
+        .miso_pin     = SER_PHY_SPI_MASTER_PIN_MISO,
+        .ss_pin       = SER_PHY_SPI_MASTER_PIN_SLAVE_SELECT,
+        .irq_priority = APP_IRQ_PRIORITY_MID,
+        .orc          = 0,
+        .frequency    = SER_PHY_SPI_5W_FREQUENCY,
+        .mode         = NRF_DRV_SPI_MODE_0,
+        .bit_order    = NRF_DRV_SPI_BIT_ORDER_LSB_FIRST,
+    };
+
+    err_code = nrf_drv_spi_init(&m_spi_master, &spi_master_config,
+                                ser_phy_spi_master_event_handler);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+    ser_phy_init_pendSV();
+
+    return err_code;
+}
+
+/* ser_phy API function */
+void ser_phy_close(void)
+{
+    m_spi_master_state = SER_PHY_STATE_DISABLED;
+
+    m_callback_events_handler = NULL;
+
+    buffer_release(&mp_tx_buffer, &m_tx_buf_len);
+    buffer_release(&mp_rx_buffer, &m_rx_buf_len);
+    m_tx_packet_length             = 0;
+    m_accumulated_tx_packet_length = 0;
+    m_current_tx_packet_length     = 0;
+    m_rx_packet_length             = 0;
+    m_accumulated_rx_packet_length = 0;
+    m_current_rx_packet_length     = 0;
+    ser_phy_deinit_gpiote();
+    nrf_drv_spi_uninit(&m_spi_master);
+}
+
+/* ser_phy API function */
+void ser_phy_interrupts_enable(void)
+{
+    NVIC_EnableIRQ(SW_IRQn);
+}
+
+/* ser_phy API function */
+void ser_phy_interrupts_disable(void)
+{
+    NVIC_DisableIRQ(SW_IRQn);
+}
+
+
+#ifdef SER_PHY_DEBUG_APP_ENABLE
+
+static spi_master_raw_callback_t m_spi_master_raw_evt_callback;
+
+void debug_evt(spi_master_raw_evt_type_t evt, uint32_t data)
+{
+    if (m_spi_master_raw_evt_callback)
+    {
+        spi_master_raw_evt_t e;
+        e.evt  = evt;
+        e.data = data;
+        m_spi_master_raw_evt_callback(e);
+    }
+}
+
+void debug_init(spi_master_raw_callback_t spi_master_raw_evt_callback)
+{
+    m_spi_master_raw_evt_callback = spi_master_raw_evt_callback;
+}
+
+#endif
+/** @} */
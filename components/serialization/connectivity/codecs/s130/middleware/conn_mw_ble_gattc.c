@@ -241,13 +241,12 @@ uint32_t conn_mw_ble_gattc_write(uint8_t const * const p_rx_buf,
     uint16_t   conn_handle;
     uint16_t * p_conn_handle = &conn_handle;
 
-    uint8_t value[BLE_GATTC_WRITE_P_VALUE_LEN_MAX];
-
     ble_gattc_write_params_t   write_params   = {0};
     ble_gattc_write_params_t * p_write_params = &write_params;
 
+    /* The value is decoded by reference, it is used directly from p_rx_buf. */
     p_write_params->len     = BLE_GATTC_WRITE_P_VALUE_LEN_MAX;
-    p_write_params->p_value = value;
+    p_write_params->p_value = NULL;
 
     uint32_t err_code = NRF_SUCCESS;
     uint32_t sd_err_code;
@@ -252,9 +252,8 @@ uint32_t conn_mw_ble_gatts_hvx(uint8_t const * const p_rx_buf,
     SER_ASSERT_NOT_NULL(p_tx_buf_len);
 
     uint16_t   conn_handle;
-    uint8_t    data[BLE_GATTS_VAR_ATTR_LEN_MAX];
-    uint8_t *  p_data = data;
-    uint16_t   len    = sizeof data;
+    uint8_t *  p_data = NULL; /* Decoded by reference, the data is used from p_rx_buf. */
+    uint16_t   len    = BLE_GATTS_VAR_ATTR_LEN_MAX;
     uint16_t * p_len  = &len;
 
     ble_gatts_hvx_params_t   hvx_params;
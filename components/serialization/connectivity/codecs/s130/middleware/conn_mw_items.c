@@ -4,6 +4,8 @@
 #include "conn_mw_ble_gap.h"
 #include "conn_mw_ble_gatts.h"
 #include "conn_mw_ble_gattc.h"
+#include "ser_evt_filter.h"
+#include "ser_conn_evt_filter.h"
 
 /**@brief Connectivity middleware handlers table. */
 static const conn_mw_item_t conn_mw_item[] = {
@@ -80,4 +82,6 @@ static const conn_mw_item_t conn_mw_item[] = {
     {SD_BLE_GATTS_RW_AUTHORIZE_REPLY, conn_mw_ble_gatts_rw_authorize_reply},
     {SD_BLE_GATTS_SYS_ATTR_SET, conn_mw_ble_gatts_sys_attr_set},
     {SD_BLE_GATTS_SYS_ATTR_GET, conn_mw_ble_gatts_sys_attr_get},
+    //Serialization commands
+    {SER_EVT_FILTER_SET, conn_mw_ser_evt_filter_set},
 };
@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include "app_error.h"
 #include "app_scheduler.h"
+#include "app_util.h"
 #include "ble_conn.h"
 #include "ble_serialization.h"
 #include "ser_config.h"
@@ -21,6 +22,115 @@
 #include "ser_conn_event_encoder.h"
 
 
+#if SER_EVT_AGGR_ENABLED
+/** TX buffer holding the aggregate packet being built, NULL if none. */
+static uint8_t * mp_aggr_buf = NULL;
+
+/** Size of the TX buffer holding the aggregate packet. */
+static uint16_t m_aggr_size;
+
+/** Number of bytes used in the aggregate packet. */
+static uint16_t m_aggr_len;
+
+/** Number of events in the aggregate packet. */
+static uint8_t m_aggr_count;
+#endif
+
+
+/**@brief Function for sending a packet from a buffer allocated in the HAL Transport layer. */
+static void pkt_send(uint8_t * p_tx_buf, uint16_t tx_buf_len)
+{
+    uint32_t err_code = ser_hal_transport_tx_pkt_send(p_tx_buf, tx_buf_len);
+    APP_ERROR_CHECK(err_code);
+    /* TX buffer is going to be freed automatically in the HAL Transport layer.
+     * Scheduler must be paused because this function returns before a packet is physically sent
+     * by transport layer. This can cause start processing of a next event from the application
+     * scheduler queue. In result the next event reserves the TX buffer before the current
+     * packet is sent. If in meantime a command arrives a command response cannot be sent in
+     * result. Pausing the scheduler temporary prevents processing a next event. */
+    app_sched_pause();
+}
+
+
+/**@brief Function for allocating a TX buffer. Loops until a buffer is available. */
+static uint8_t * tx_buf_alloc(uint32_t * p_tx_buf_len)
+{
+    uint32_t  err_code;
+    uint8_t * p_tx_buf = NULL;
+
+    do
+    {
+        err_code = ser_hal_transport_tx_pkt_alloc(&p_tx_buf, (uint16_t *)p_tx_buf_len);
+    }
+    while (err_code == NRF_ERROR_NO_MEM);
+    APP_ERROR_CHECK(err_code);
+
+    return p_tx_buf;
+}
+
+
+#if SER_EVT_AGGR_ENABLED
+void ser_conn_ble_event_flush(void)
+{
+    if (mp_aggr_buf == NULL)
+    {
+        return;
+    }
+
+    if (m_aggr_count == 1)
+    {
+        /* Nothing to aggregate, send the event as a plain packet. */
+        uint16_t pkt_len = uint16_decode(&mp_aggr_buf[SER_PKT_TYPE_SIZE]);
+
+        memmove(mp_aggr_buf, &mp_aggr_buf[SER_PKT_TYPE_SIZE + SER_AGGR_PKT_LEN_SIZE], pkt_len);
+        m_aggr_len = pkt_len;
+    }
+
+    pkt_send(mp_aggr_buf, m_aggr_len);
+    mp_aggr_buf = NULL;
+}
+
+
+/**@brief Function for encoding an event into the aggregate packet.
+ *
+ * @retval NRF_SUCCESS              If the event was added.
+ * @retval NRF_ERROR_NOT_SUPPORTED  If the event is not serialized.
+ * @retval NRF_ERROR_NO_MEM         If the event does not fit in the aggregate packet.
+ */
+static uint32_t aggr_event_add(ble_evt_t * p_ble_evt)
+{
+    uint32_t  err_code;
+    uint8_t * p_pkt     = &mp_aggr_buf[m_aggr_len + SER_AGGR_PKT_LEN_SIZE];
+    uint32_t  event_len = m_aggr_size - m_aggr_len - SER_AGGR_PKT_LEN_SIZE - SER_PKT_TYPE_SIZE;
+
+    if ((m_aggr_size < m_aggr_len + SER_AGGR_PKT_LEN_SIZE + SER_PKT_TYPE_SIZE + SER_EVT_HEADER_SIZE)
+        || (m_aggr_count >= SER_EVT_AGGR_MAX_PKTS))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_pkt[SER_PKT_TYPE_POS] = SER_PKT_TYPE_EVT;
+
+    err_code = ble_event_enc(p_ble_evt, 0, &p_pkt[SER_PKT_OP_CODE_POS], &event_len);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        event_len  += SER_PKT_TYPE_SIZE;
+        m_aggr_len += uint16_encode((uint16_t)event_len, &mp_aggr_buf[m_aggr_len]);
+        m_aggr_len += event_len;
+        m_aggr_count++;
+    }
+    else if ((err_code != NRF_ERROR_NOT_SUPPORTED) && (m_aggr_count > 0))
+    {
+        /* Out of space in the aggregate; a fresh packet is tried before giving up. */
+        err_code = NRF_ERROR_NO_MEM;
+    }
+
+    return err_code;
+}
+#endif
+
+
 void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
 {
     if (NULL == p_event_data)
@@ -34,14 +144,45 @@ void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
     uint32_t    tx_buf_len = 0;
     ble_evt_t * p_ble_evt  = (ble_evt_t *)p_event_data;
 
-    /* Allocate a memory buffer from HAL Transport layer for transmitting an event.
-     * Loop until a buffer is available. */
-    do
+#if SER_EVT_AGGR_ENABLED
+    if (mp_aggr_buf != NULL)
     {
-        err_code = ser_hal_transport_tx_pkt_alloc(&p_tx_buf, (uint16_t *)&tx_buf_len);
+        err_code = aggr_event_add(p_ble_evt);
+        if (NRF_ERROR_NOT_SUPPORTED == err_code)
+        {
+            APP_ERROR_CHECK(SER_WARNING_CODE);
+            return;
+        }
+        else if (NRF_ERROR_NO_MEM != err_code)
+        {
+            APP_ERROR_CHECK(err_code);
+            return;
+        }
+
+        /* The TX buffer is sent and the event goes into a new aggregate packet. */
+        ser_conn_ble_event_flush();
     }
-    while (err_code == NRF_ERROR_NO_MEM);
-    APP_ERROR_CHECK(err_code);
+
+    /* The packet is sent by ser_conn_ble_event_flush() once no more events are pending. */
+    mp_aggr_buf                     = tx_buf_alloc(&tx_buf_len);
+    mp_aggr_buf[SER_PKT_TYPE_POS]   = SER_PKT_TYPE_AGGR;
+    m_aggr_size                     = (uint16_t)tx_buf_len;
+    m_aggr_len                      = SER_PKT_TYPE_SIZE;
+    m_aggr_count                    = 0;
+
+    if (NRF_SUCCESS == aggr_event_add(p_ble_evt))
+    {
+        return;
+    }
+
+    /* The event is not serialized or it is too big to be aggregated, so it is handled as a plain
+     * packet. */
+    p_tx_buf    = mp_aggr_buf;
+    mp_aggr_buf = NULL;
+#else
+    /* Allocate a memory buffer from HAL Transport layer for transmitting an event. */
+    p_tx_buf = tx_buf_alloc(&tx_buf_len);
+#endif
 
     /* Create a new packet. */
     p_tx_buf[SER_PKT_TYPE_POS] = SER_PKT_TYPE_EVT;
@@ -54,15 +195,7 @@ void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
     {
         APP_ERROR_CHECK(err_code);
         tx_buf_len += SER_PKT_TYPE_SIZE;
-        err_code    = ser_hal_transport_tx_pkt_send(p_tx_buf, (uint16_t)tx_buf_len);
-        APP_ERROR_CHECK(err_code);
-        /* TX buffer is going to be freed automatically in the HAL Transport layer.
-         * Scheduler must be paused because this function returns before a packet is physically sent
-         * by transport layer. This can cause start processing of a next event from the application
-         * scheduler queue. In result the next event reserves the TX buffer before the current
-         * packet is sent. If in meantime a command arrives a command response cannot be sent in
-         * result. Pausing the scheduler temporary prevents processing a next event. */
-        app_sched_pause();
+        pkt_send(p_tx_buf, (uint16_t)tx_buf_len);
     }
     else
     {
@@ -72,4 +205,3 @@ void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
         APP_ERROR_CHECK(SER_WARNING_CODE);
     }
 }
-
@@ -31,6 +31,7 @@
 #define SER_CONN_EVENT_ENCODER_H__
 
 #include <stdint.h>
+#include "ser_config.h"
 
 /**@brief A function for encoding a @ref ble_evt_t. The function passes the serialized byte stream
  *        to the transport layer after encoding.
@@ -45,6 +46,19 @@
  */
 void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size);
 
+/**@brief A function for sending the events waiting in an aggregate packet.
+ *
+ * @details When @ref SER_EVT_AGGR_ENABLED is set, @ref ser_conn_ble_event_encoder packs
+ *          consecutive events into one aggregate packet, which is sent when it is full or when
+ *          this function is called. Call it once the application scheduler queue has been
+ *          processed, and before processing a received packet.
+ */
+#if SER_EVT_AGGR_ENABLED
+void ser_conn_ble_event_flush(void);
+#else
+#define ser_conn_ble_event_flush()
+#endif
+
 #endif /* SER_CONN_EVENT_ENCODER_H__ */
 
 /** @} */
@@ -0,0 +1,56 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ble_serialization.h"
+#include "ser_evt_filter.h"
+#include "ser_conn_evt_filter.h"
+
+/** Filter set by the application. */
+static ser_evt_filter_t m_filter;
+
+/** Indicator of filter set by the application. */
+static bool m_filter_set = false;
+
+
+bool ser_conn_evt_filter_pass(ble_evt_t const * const p_ble_evt)
+{
+    return !m_filter_set || ser_evt_filter_match(&m_filter, p_ble_evt);
+}
+
+
+uint32_t conn_mw_ser_evt_filter_set(uint8_t const * const p_rx_buf,
+                                    uint32_t              rx_buf_len,
+                                    uint8_t * const       p_tx_buf,
+                                    uint32_t * const      p_tx_buf_len)
+{
+    SER_ASSERT_NOT_NULL(p_rx_buf);
+    SER_ASSERT_NOT_NULL(p_tx_buf);
+    SER_ASSERT_NOT_NULL(p_tx_buf_len);
+
+    ser_evt_filter_t filter;
+    uint32_t         err_code;
+
+    err_code = ser_evt_filter_set_req_dec(p_rx_buf, rx_buf_len, &filter);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    /* Events already in the scheduler queue are sent with the previous filter. */
+    m_filter     = filter;
+    m_filter_set = true;
+
+    err_code = ser_ble_cmd_rsp_status_code_enc(SER_EVT_FILTER_SET, NRF_SUCCESS,
+                                               p_tx_buf, p_tx_buf_len);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    return err_code;
+}
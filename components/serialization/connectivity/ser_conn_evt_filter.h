@@ -0,0 +1,57 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup ser_conn_evt_filter Event subscription filter in the connectivity chip
+ * @{
+ * @ingroup ser_conn
+ *
+ * @brief   Drops the BLE events the application did not subscribe to.
+ *
+ * @details The filter is set by the application with the @ref SER_EVT_FILTER_SET command. Until
+ *          then all events are forwarded.
+ */
+
+#ifndef SER_CONN_EVT_FILTER_H__
+#define SER_CONN_EVT_FILTER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+
+/**@brief Function for checking if a BLE event is to be sent to the application.
+ *
+ * @param[in] p_ble_evt  A pointer to a BLE event.
+ *
+ * @retval true   The event is to be sent.
+ * @retval false  The event is to be dropped.
+ */
+bool ser_conn_evt_filter_pass(ble_evt_t const * const p_ble_evt);
+
+/**@brief Connectivity middleware handler of the @ref SER_EVT_FILTER_SET command.
+ *
+ * @param[in]      p_rx_buf      Pointer to the received command.
+ * @param[in]      rx_buf_len    Length of the received command.
+ * @param[out]     p_tx_buf      Pointer to the buffer for the command response.
+ * @param[in,out]  p_tx_buf_len  \c in: Size of \p p_tx_buf buffer.
+ *                               \c out: Length of the encoded command response.
+ *
+ * @retval NRF_SUCCESS  The filter was decoded and the response encoded.
+ */
+uint32_t conn_mw_ser_evt_filter_set(uint8_t const * const p_rx_buf,
+                                    uint32_t              rx_buf_len,
+                                    uint8_t * const       p_tx_buf,
+                                    uint32_t * const      p_tx_buf_len);
+
+/** @} */
+#endif // SER_CONN_EVT_FILTER_H__
@@ -18,6 +18,7 @@
 #include "ser_conn_event_encoder.h"
 #include "ser_conn_pkt_decoder.h"
 #include "ser_conn_dtm_cmd_decoder.h"
+#include "ser_conn_evt_filter.h"
 
 
 /** @file
@@ -38,6 +39,21 @@ static ser_hal_transport_evt_rx_pkt_received_params_t m_rx_pkt_received_params;
 /** Indicator of received packet that should be process. */
 static bool m_rx_pkt_to_process = false;
 
+/** Counters of BLE events that were not sent to the application. */
+static ser_conn_evt_stats_t m_evt_stats;
+
+
+/**@brief Function for checking if a BLE event is a scan event.
+ *
+ * @details Scan events are queued behind connection and data events and are dropped when their
+ *          queue is full.
+ */
+static bool is_scan_evt(ble_evt_t const * p_ble_evt)
+{
+    return (p_ble_evt->header.evt_id == BLE_GAP_EVT_ADV_REPORT) ||
+           (p_ble_evt->header.evt_id == BLE_GAP_EVT_SCAN_REQ_REPORT);
+}
+
 
 void ser_conn_hal_transport_event_handle(ser_hal_transport_evt_t event)
 {
@@ -115,15 +131,40 @@ uint32_t ser_conn_rx_process(void)
 void ser_conn_ble_event_handle(ble_evt_t * p_ble_evt)
 {
     uint32_t err_code = NRF_SUCCESS;
+    bool     scan_evt = is_scan_evt(p_ble_evt);
+
+    /* Events the application did not subscribe to are dropped before they take up space in the
+     * scheduler queue and on the serial link. */
+    if (!ser_conn_evt_filter_pass(p_ble_evt))
+    {
+        m_evt_stats.evt_filtered++;
+        return;
+    }
 
     /* We can NOT encode and send BLE events here. SoftDevice handler implemented in
      * softdevice_handler.c pull all available BLE events at once but we need to reschedule between
      * encoding and sending every BLE event because sending a response on received packet has higher
      * priority than sending a BLE event. Solution for that is to put BLE events into application
      * scheduler queue to be processed at a later time. */
-    err_code = app_sched_event_put(p_ble_evt, sizeof (ble_evt_hdr_t) + p_ble_evt->header.evt_len,
-                                   ser_conn_ble_event_encoder);
+    err_code = app_sched_event_put_prio(p_ble_evt, sizeof (ble_evt_hdr_t) + p_ble_evt->header.evt_len,
+                                        ser_conn_ble_event_encoder,
+                                        scan_evt ? SER_CONN_SCHED_PRIORITY_SCAN :
+                                                   SER_CONN_SCHED_PRIORITY_CONN);
+
+    /* Scan reports are not worth stalling the SoftDevice for; they are dropped and counted when
+     * the application cannot keep up with them. */
+    if (scan_evt && (NRF_ERROR_NO_MEM == err_code))
+    {
+        m_evt_stats.scan_evt_dropped++;
+        return;
+    }
     APP_ERROR_CHECK(err_code);
 }
 
+
+void ser_conn_evt_stats_get(ser_conn_evt_stats_t * p_stats)
+{
+    *p_stats = m_evt_stats;
+}
+
 /** @} */
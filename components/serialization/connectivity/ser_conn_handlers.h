@@ -39,11 +39,20 @@
 #include "ant_stack_handler_types.h"
 #include "softdevice_handler.h"
 #include "ble.h"
+#include "app_scheduler.h"
 #include "ser_hal_transport.h"
 
-/** Maximum number of events in the application scheduler queue. */
+/** Maximum number of events in the application scheduler queue, per priority level. */
 #define SER_CONN_SCHED_QUEUE_SIZE             16u
 
+/** Scheduler priority of connection and data events. */
+#define SER_CONN_SCHED_PRIORITY_CONN          APP_SCHED_PRIORITY_HIGHEST
+
+/** Scheduler priority of scan events (advertising and scan request reports). With
+ *  APP_SCHEDULER_PRIORITY_LEVELS set to 2 or more, they have a queue of their own and a flood of
+ *  them does not delay connection and data events. */
+#define SER_CONN_SCHED_PRIORITY_SCAN          APP_SCHED_PRIORITY_DEFAULT
+
 /** Maximum size of events data in the application scheduler queue aligned to 32 bits - this is
  *  size of the buffer created in the SOFTDEVICE_HANDLER_INIT macro, which stores events pulled
  *  from the SoftDevice. */
@@ -56,6 +65,14 @@
                                                sizeof(uint32_t))
 
 
+/**@brief Counters of BLE events that were not sent to the application. */
+typedef struct
+{
+    uint32_t scan_evt_dropped; /**< Scan events dropped because their scheduler queue was full. */
+    uint32_t evt_filtered;     /**< Events dropped by the event subscription filter. */
+} ser_conn_evt_stats_t;
+
+
 /**@brief A function for processing the HAL Transport layer events.
  *
  * @param[in] event    HAL Transport layer event.
@@ -80,5 +97,12 @@ uint32_t ser_conn_rx_process(void);
  */
 void ser_conn_ble_event_handle(ble_evt_t * p_ble_evt);
 
+
+/**@brief A function for reading the counters of BLE events that were not sent to the application.
+ *
+ * @param[out] p_stats    Counters.
+ */
+void ser_conn_evt_stats_get(ser_conn_evt_stats_t * p_stats);
+
 #endif /* SER_CONN_HANDLERS_H__ */
 /** @} */
@@ -10,9 +10,11 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include "nordic_common.h"
+#include "app_util.h"
 #include "app_error.h"
 #include "softdevice_handler.h"
 #include "ble_serialization.h"
@@ -24,43 +26,83 @@
 #include "ser_conn_reset_cmd_decoder.h"
 
 
-uint32_t ser_conn_received_pkt_process(
-    ser_hal_transport_evt_rx_pkt_received_params_t * p_rx_pkt_params)
+/**@brief Function for processing a single packet.
+ *
+ * @param[in]  p_pkt      Pointer to the packet, starting with the Packet Type field.
+ * @param[in]  pkt_len    Length of the packet.
+ * @param[in]  aggr_ok    True if the packet may be an aggregate packet.
+ */
+static uint32_t pkt_process(uint8_t * p_pkt, uint16_t pkt_len, bool aggr_ok)
 {
     uint32_t err_code = NRF_SUCCESS;
 
-    if (NULL != p_rx_pkt_params)
+    SER_ASSERT_LENGTH_LEQ(SER_PKT_TYPE_SIZE, pkt_len);
+
+    /* For further processing pass only command (opcode + data).  */
+    uint8_t * p_command   = &p_pkt[SER_PKT_OP_CODE_POS];
+    uint16_t  command_len = pkt_len - SER_PKT_TYPE_SIZE;
+
+    switch (p_pkt[SER_PKT_TYPE_POS])
     {
-        /* For further processing pass only command (opcode + data).  */
-        uint8_t * p_command   = &p_rx_pkt_params->p_buffer[SER_PKT_OP_CODE_POS];
-        uint16_t  command_len = p_rx_pkt_params->num_of_bytes - SER_PKT_TYPE_SIZE;
+        case SER_PKT_TYPE_CMD:
+        {
+            err_code = ser_conn_command_process(p_command, command_len);
+            break;
+        }
 
-        switch (p_rx_pkt_params->p_buffer[SER_PKT_TYPE_POS])
+        case SER_PKT_TYPE_DTM_CMD:
         {
-            case SER_PKT_TYPE_CMD:
-            {
-                err_code = ser_conn_command_process(p_command, command_len);
-                break;
-            }
+            err_code = ser_conn_dtm_command_process(p_command, command_len);
+            break;
+        }
 
-            case SER_PKT_TYPE_DTM_CMD:
-            {
-                err_code = ser_conn_dtm_command_process(p_command, command_len);
-                break;
-            }
-            
-            case SER_PKT_TYPE_RESET_CMD:
-            {
-                ser_conn_reset_command_process();
-                break;
-            }
+        case SER_PKT_TYPE_RESET_CMD:
+        {
+            ser_conn_reset_command_process();
+            break;
+        }
+
+        case SER_PKT_TYPE_AGGR:
+        {
+            uint16_t index = SER_PKT_TYPE_SIZE;
 
-            default:
+            /* Aggregate packets do not nest. */
+            SER_ASSERT(aggr_ok, NRF_ERROR_INVALID_DATA);
+
+            while ((NRF_SUCCESS == err_code) && (index < pkt_len))
             {
-                APP_ERROR_CHECK(SER_WARNING_CODE);
-                break;
+                uint16_t sub_pkt_len;
+
+                SER_ASSERT_LENGTH_LEQ(index + SER_AGGR_PKT_LEN_SIZE, pkt_len);
+                sub_pkt_len = uint16_decode(&p_pkt[index]);
+                index      += SER_AGGR_PKT_LEN_SIZE;
+                SER_ASSERT_LENGTH_LEQ(index + sub_pkt_len, pkt_len);
+
+                err_code = pkt_process(&p_pkt[index], sub_pkt_len, false);
+                index   += sub_pkt_len;
             }
+            break;
+        }
+
+        default:
+        {
+            APP_ERROR_CHECK(SER_WARNING_CODE);
+            break;
         }
+    }
+
+    return err_code;
+}
+
+
+uint32_t ser_conn_received_pkt_process(
+    ser_hal_transport_evt_rx_pkt_received_params_t * p_rx_pkt_params)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (NULL != p_rx_pkt_params)
+    {
+        err_code = pkt_process(p_rx_pkt_params->p_buffer, p_rx_pkt_params->num_of_bytes, true);
 
         if (NRF_SUCCESS == err_code)
         {
@@ -25,10 +25,15 @@
 #ifdef ANT_STACK_SUPPORT_REQD
 
 #include <stdlib.h>
+#include <stdbool.h>
 
 #define ANT_STACK_EVT_MSG_BUF_SIZE      32                                                /**< Size of ANT event message buffer. This will be provided to the SoftDevice while fetching an event. */
 #define ANT_STACK_EVT_STRUCT_SIZE       (sizeof(ant_evt_t))                               /**< Size of the @ref ant_evt_t structure. This will be used by the @ref softdevice_handler to internal event buffer size needed. */
 
+#ifndef ANT_STACK_EVT_BATCH_SIZE
+#define ANT_STACK_EVT_BATCH_SIZE        1                                                 /**< Highest number of ANT events fetched in a row, before System (SOC) and BLE events are fetched again. Raise it for receivers of many channels or of a background scanning channel. */
+#endif
+
 /**@brief ANT stack event type. */
 typedef struct
 {
@@ -44,6 +49,12 @@ typedef struct
 /**@brief Application ANT stack event handler type. */
 typedef void (*ant_evt_handler_t) (ant_evt_t * p_ant_evt);
 
+/**@brief Application ANT stack event filter type.
+ *
+ * @return True if the event is to be passed to the ANT stack event handler, false to drop it.
+ */
+typedef bool (*ant_evt_filter_t) (ant_evt_t const * p_ant_evt);
+
 /**@brief     Function for registering for ANT events.
  *
  * @details   The application should use this function to register for receiving ANT events from
@@ -60,6 +71,22 @@ typedef void (*ant_evt_handler_t) (ant_evt_t * p_ant_evt);
  */
 uint32_t softdevice_ant_evt_handler_set(ant_evt_handler_t ant_evt_handler);
 
+/**@brief     Function for registering a filter for ANT events.
+ *
+ * @details   The filter is called for each ANT event fetched from the SoftDevice, before the ANT
+ *            stack event handler, so that messages which are of no interest to the application,
+ *            for example the messages of other devices received on a background scanning channel,
+ *            are dropped before they are dispatched to the channels and profiles. The filter
+ *            should be quick, as it is called in the SoftDevice event interrupt (or in the
+ *            scheduler) for every event.
+ *
+ * @param[in] ant_evt_filter Function to be called for each fetched ANT event, or NULL to pass all
+ *                           events to the ANT stack event handler.
+ *
+ * @retval    NRF_SUCCESS     Successful registration.
+ */
+uint32_t softdevice_ant_evt_filter_set(ant_evt_filter_t ant_evt_filter);
+
 #else
 
 // The ANT Stack support is not required.
@@ -0,0 +1,282 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "softdevice_evt_demux.h"
+#include <string.h>
+#include <stddef.h>
+#include "nrf_error.h"
+#include "nordic_common.h"
+#include "app_util_platform.h"
+
+/**@brief Route. */
+typedef struct
+{
+    softdevice_evt_demux_queue_t * p_queue;         /**< Destination queue. */
+    uint32_t                       evt_id_first;    /**< First event ID. */
+    uint32_t                       evt_id_last;     /**< Last event ID. */
+    uint16_t                       conn_handle;     /**< Connection handle, BLE routes only. */
+    uint8_t                        type;            /**< Event type, see @ref softdevice_evt_demux_type_t. */
+} demux_route_t;
+
+static demux_route_t                  m_routes[SOFTDEVICE_EVT_DEMUX_ROUTES_MAX];    /**< Routes, in the order they were added. */
+static uint32_t                       m_route_count;                                /**< Number of routes. */
+static softdevice_evt_demux_queue_t * mp_default_queue;                             /**< Queue of the events matching no route. */
+static uint32_t                       m_unrouted_count;                             /**< Events dropped because they matched no route. */
+
+
+ret_code_t softdevice_evt_demux_queue_init(softdevice_evt_demux_queue_t * p_queue,
+                                           void                         * p_os_queue,
+                                           softdevice_evt_demux_slot_t  * p_slots,
+                                           uint32_t                       slot_count)
+{
+    if ((p_queue == NULL) || (p_os_queue == NULL) || (p_slots == NULL))
+    {
+        return NRF_ERROR_NULL;
+    }
+    if ((slot_count == 0) || (slot_count > SOFTDEVICE_EVT_DEMUX_SLOTS_MAX))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_queue, 0, sizeof(*p_queue));
+    p_queue->p_os_queue = p_os_queue;
+    p_queue->p_slots    = p_slots;
+    p_queue->slot_count = slot_count;
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t route_add(softdevice_evt_demux_queue_t * p_queue,
+                            softdevice_evt_demux_type_t    type,
+                            uint16_t                       conn_handle,
+                            uint32_t                       evt_id_first,
+                            uint32_t                       evt_id_last)
+{
+    if (p_queue == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (m_route_count >= SOFTDEVICE_EVT_DEMUX_ROUTES_MAX)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    demux_route_t * p_route = &m_routes[m_route_count];
+
+    p_route->p_queue      = p_queue;
+    p_route->evt_id_first = evt_id_first;
+    p_route->evt_id_last  = evt_id_last;
+    p_route->conn_handle  = conn_handle;
+    p_route->type         = (uint8_t)type;
+
+    // Routes are read from the SoftDevice event context: count the route only once it is set.
+    CRITICAL_REGION_ENTER();
+    m_route_count++;
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t softdevice_evt_demux_ble_route_add(softdevice_evt_demux_queue_t * p_queue,
+                                              uint16_t                       conn_handle,
+                                              uint16_t                       evt_id_first,
+                                              uint16_t                       evt_id_last)
+{
+    return route_add(p_queue, SOFTDEVICE_EVT_DEMUX_TYPE_BLE, conn_handle, evt_id_first, evt_id_last);
+}
+
+
+ret_code_t softdevice_evt_demux_soc_route_add(softdevice_evt_demux_queue_t * p_queue,
+                                              uint32_t                       evt_id_first,
+                                              uint32_t                       evt_id_last)
+{
+    return route_add(p_queue, SOFTDEVICE_EVT_DEMUX_TYPE_SOC, BLE_CONN_HANDLE_ALL,
+                     evt_id_first, evt_id_last);
+}
+
+
+void softdevice_evt_demux_default_set(softdevice_evt_demux_queue_t * p_queue)
+{
+    mp_default_queue = p_queue;
+}
+
+
+/**@brief Function for finding the queue of an event.
+ *
+ * @return The queue, or NULL if the event must be dropped.
+ */
+static softdevice_evt_demux_queue_t * queue_find(softdevice_evt_demux_type_t type,
+                                                 uint32_t                    evt_id,
+                                                 uint16_t                    conn_handle)
+{
+    for (uint32_t i = 0; i < m_route_count; i++)
+    {
+        demux_route_t const * p_route = &m_routes[i];
+
+        if (   (p_route->type == type)
+            && (p_route->evt_id_first <= evt_id)
+            && (p_route->evt_id_last  >= evt_id)
+            && (   (p_route->conn_handle == BLE_CONN_HANDLE_ALL)
+                || (p_route->conn_handle == conn_handle)))
+        {
+            return p_route->p_queue;
+        }
+    }
+
+    if (mp_default_queue == NULL)
+    {
+        m_unrouted_count++;
+    }
+    return mp_default_queue;
+}
+
+
+/**@brief Function for allocating a slot.
+ *
+ * @return The slot, or NULL if all slots of the queue are in use.
+ */
+static softdevice_evt_demux_slot_t * slot_alloc(softdevice_evt_demux_queue_t * p_queue)
+{
+    softdevice_evt_demux_slot_t * p_slot = NULL;
+
+    CRITICAL_REGION_ENTER();
+    for (uint32_t i = 0; i < p_queue->slot_count; i++)
+    {
+        if ((p_queue->used_mask & (1UL << i)) == 0)
+        {
+            p_queue->used_mask |= (1UL << i);
+            p_queue->in_use++;
+            if (p_queue->in_use > p_queue->stats.in_use_max)
+            {
+                p_queue->stats.in_use_max = p_queue->in_use;
+            }
+            p_slot = &p_queue->p_slots[i];
+            break;
+        }
+    }
+    if (p_slot == NULL)
+    {
+        p_queue->stats.dropped++;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return p_slot;
+}
+
+
+void softdevice_evt_demux_free(softdevice_evt_demux_queue_t * p_queue,
+                               softdevice_evt_demux_slot_t  * p_slot)
+{
+    uint32_t const index = (uint32_t)(p_slot - p_queue->p_slots);
+
+    if (index >= p_queue->slot_count)
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (p_queue->used_mask & (1UL << index))
+    {
+        p_queue->used_mask &= ~(1UL << index);
+        p_queue->in_use--;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+static void slot_post(softdevice_evt_demux_queue_t * p_queue, softdevice_evt_demux_slot_t * p_slot)
+{
+    if (softdevice_evt_demux_port_post(p_queue->p_os_queue, p_slot))
+    {
+        CRITICAL_REGION_ENTER();
+        p_queue->stats.posted++;
+        CRITICAL_REGION_EXIT();
+    }
+    else
+    {
+        softdevice_evt_demux_free(p_queue, p_slot);
+
+        CRITICAL_REGION_ENTER();
+        p_queue->stats.dropped++;
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+void softdevice_evt_demux_on_ble_evt(ble_evt_t * p_ble_evt)
+{
+    // All BLE event structures start with the connection handle.
+    uint16_t const conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+
+    softdevice_evt_demux_queue_t * p_queue = queue_find(SOFTDEVICE_EVT_DEMUX_TYPE_BLE,
+                                                        p_ble_evt->header.evt_id,
+                                                        conn_handle);
+    if (p_queue == NULL)
+    {
+        return;
+    }
+
+    softdevice_evt_demux_slot_t * p_slot = slot_alloc(p_queue);
+    if (p_slot == NULL)
+    {
+        return;
+    }
+
+    // Only the received part of the event is copied.
+    uint32_t const len = MIN(sizeof(ble_evt_hdr_t) + p_ble_evt->header.evt_len,
+                             sizeof(p_slot->evt.ble_evt_buf));
+
+    p_slot->type = SOFTDEVICE_EVT_DEMUX_TYPE_BLE;
+    memcpy(p_slot->evt.ble_evt_buf, p_ble_evt, len);
+
+    slot_post(p_queue, p_slot);
+}
+
+
+void softdevice_evt_demux_on_soc_evt(uint32_t evt_id)
+{
+    softdevice_evt_demux_queue_t * p_queue = queue_find(SOFTDEVICE_EVT_DEMUX_TYPE_SOC,
+                                                        evt_id,
+                                                        BLE_CONN_HANDLE_INVALID);
+    if (p_queue == NULL)
+    {
+        return;
+    }
+
+    softdevice_evt_demux_slot_t * p_slot = slot_alloc(p_queue);
+    if (p_slot == NULL)
+    {
+        return;
+    }
+
+    p_slot->type        = SOFTDEVICE_EVT_DEMUX_TYPE_SOC;
+    p_slot->evt.soc_evt = evt_id;
+
+    slot_post(p_queue, p_slot);
+}
+
+
+void softdevice_evt_demux_stats_get(softdevice_evt_demux_queue_t const * p_queue,
+                                    softdevice_evt_demux_stats_t       * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = p_queue->stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
+uint32_t softdevice_evt_demux_unrouted_count_get(void)
+{
+    return m_unrouted_count;
+}
@@ -0,0 +1,204 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup softdevice_evt_demux SoftDevice event demultiplexer
+ * @{
+ * @ingroup  softdevice_handler
+ * @brief    Module for routing SoftDevice events to RTOS task queues.
+ *
+ * @details  The demultiplexer is registered as the BLE and System (SOC) event handler of the
+ *           SoftDevice handler. Each event is matched against the routes, in the order they were
+ *           added, and is copied into a slot of the queue of the first matching route. The task
+ *           owning the queue receives a pointer to the slot with @ref softdevice_evt_demux_receive,
+ *           handles the event in place and returns the slot with @ref softdevice_evt_demux_free.
+ *           A slow handler therefore only delays the events routed to its own task.
+ *
+ *           BLE events are routed by connection handle and event ID range, for example all GATTS
+ *           events of one connection to one task. SOC events are routed by event ID range. Events
+ *           that match no route are sent to the default queue, or dropped if there is none.
+ *
+ *           The RTOS message queues are created by the application, with room for one pointer
+ *           per slot, and passed to @ref softdevice_evt_demux_queue_init. The RTOS specific part
+ *           is implemented in softdevice_evt_demux_freertos.c (FreeRTOS queues) and
+ *           softdevice_evt_demux_rtx.c (RTX message queues); exactly one of them must be
+ *           compiled. The events can be delivered from the SoftDevice event interrupt
+ *           or from a task calling intern_softdevice_events_execute().
+ */
+
+#ifndef SOFTDEVICE_EVT_DEMUX_H__
+#define SOFTDEVICE_EVT_DEMUX_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+#include "ble.h"
+#include "ble_stack_handler_types.h"
+
+#ifndef SOFTDEVICE_EVT_DEMUX_ROUTES_MAX
+#define SOFTDEVICE_EVT_DEMUX_ROUTES_MAX     8           /**< Maximum number of BLE and SOC routes. */
+#endif
+
+#define SOFTDEVICE_EVT_DEMUX_SLOTS_MAX      32          /**< Maximum number of slots of a queue. */
+
+#define SOFTDEVICE_EVT_DEMUX_WAIT_FOREVER   0xFFFFFFFF  /**< Timeout of @ref softdevice_evt_demux_receive for waiting until an event is received. */
+
+/**@brief Event types. */
+typedef enum
+{
+    SOFTDEVICE_EVT_DEMUX_TYPE_BLE,      /**< BLE event, in softdevice_evt_demux_slot_t::evt.ble_evt. */
+    SOFTDEVICE_EVT_DEMUX_TYPE_SOC       /**< System (SOC) event, in softdevice_evt_demux_slot_t::evt.soc_evt. */
+} softdevice_evt_demux_type_t;
+
+/**@brief Queue slot, holding one event. */
+typedef struct
+{
+    uint32_t type;                                      /**< Event type, see @ref softdevice_evt_demux_type_t. */
+    union
+    {
+        uint32_t  soc_evt;                              /**< System (SOC) event ID. */
+        ble_evt_t ble_evt;                              /**< BLE event. */
+        uint8_t   ble_evt_buf[BLE_STACK_EVT_MSG_BUF_SIZE];   /**< Room for the largest BLE event. */
+    } evt;                                              /**< Event. */
+} softdevice_evt_demux_slot_t;
+
+/**@brief Queue statistics. */
+typedef struct
+{
+    uint32_t posted;        /**< Number of events posted to the queue. */
+    uint32_t dropped;       /**< Number of events dropped because all slots were in use or the RTOS queue was full. */
+    uint32_t in_use_max;    /**< Highest number of slots in use at the same time. */
+} softdevice_evt_demux_stats_t;
+
+/**@brief Queue. The fields are internal to the module. */
+typedef struct
+{
+    void                         * p_os_queue;  /**< RTOS message queue. */
+    softdevice_evt_demux_slot_t  * p_slots;     /**< Slots. */
+    uint32_t                       slot_count;  /**< Number of slots. */
+    uint32_t                       used_mask;   /**< Slots in use. */
+    uint32_t                       in_use;      /**< Number of slots in use. */
+    softdevice_evt_demux_stats_t   stats;       /**< Statistics. */
+} softdevice_evt_demux_queue_t;
+
+
+/**@brief Function for initializing a queue.
+ *
+ * @param[out] p_queue     Queue.
+ * @param[in]  p_os_queue  RTOS message queue, with room for slot_count pointers:
+ *                         a QueueHandle_t with FreeRTOS, or an osMessageQId with RTX.
+ * @param[in]  p_slots     Slot array.
+ * @param[in]  slot_count  Number of slots in the array.
+ *
+ * @retval NRF_SUCCESS              If the queue was initialized.
+ * @retval NRF_ERROR_NULL           If a pointer is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  If slot_count is 0 or larger than @ref SOFTDEVICE_EVT_DEMUX_SLOTS_MAX.
+ */
+ret_code_t softdevice_evt_demux_queue_init(softdevice_evt_demux_queue_t * p_queue,
+                                           void                         * p_os_queue,
+                                           softdevice_evt_demux_slot_t  * p_slots,
+                                           uint32_t                       slot_count);
+
+/**@brief Function for routing BLE events to a queue.
+ *
+ * @details The connection handle is read from the event structure of all BLE events, where it
+ *          is the first field. Events not related to a connection have the connection handle
+ *          BLE_CONN_HANDLE_INVALID.
+ *
+ * @param[in] p_queue       Queue.
+ * @param[in] conn_handle   Connection handle, or BLE_CONN_HANDLE_ALL for events of any connection.
+ * @param[in] evt_id_first  First event ID of the route, for example BLE_GATTS_EVT_BASE.
+ * @param[in] evt_id_last   Last event ID of the route, for example BLE_GATTS_EVT_LAST.
+ *
+ * @retval NRF_SUCCESS      If the route was added.
+ * @retval NRF_ERROR_NULL   If p_queue is NULL.
+ * @retval NRF_ERROR_NO_MEM If @ref SOFTDEVICE_EVT_DEMUX_ROUTES_MAX routes were already added.
+ */
+ret_code_t softdevice_evt_demux_ble_route_add(softdevice_evt_demux_queue_t * p_queue,
+                                              uint16_t                       conn_handle,
+                                              uint16_t                       evt_id_first,
+                                              uint16_t                       evt_id_last);
+
+/**@brief Function for routing System (SOC) events to a queue.
+ *
+ * @param[in] p_queue       Queue.
+ * @param[in] evt_id_first  First event ID of the route.
+ * @param[in] evt_id_last   Last event ID of the route.
+ *
+ * @retval NRF_SUCCESS      If the route was added.
+ * @retval NRF_ERROR_NULL   If p_queue is NULL.
+ * @retval NRF_ERROR_NO_MEM If @ref SOFTDEVICE_EVT_DEMUX_ROUTES_MAX routes were already added.
+ */
+ret_code_t softdevice_evt_demux_soc_route_add(softdevice_evt_demux_queue_t * p_queue,
+                                              uint32_t                       evt_id_first,
+                                              uint32_t                       evt_id_last);
+
+/**@brief Function for setting the queue of the events that match no route.
+ *
+ * @param[in] p_queue  Queue, or NULL to drop these events.
+ */
+void softdevice_evt_demux_default_set(softdevice_evt_demux_queue_t * p_queue);
+
+/**@brief BLE event handler, to be registered with softdevice_ble_evt_handler_set(). */
+void softdevice_evt_demux_on_ble_evt(ble_evt_t * p_ble_evt);
+
+/**@brief System (SOC) event handler, to be registered with softdevice_sys_evt_handler_set(). */
+void softdevice_evt_demux_on_soc_evt(uint32_t evt_id);
+
+/**@brief Function for receiving an event from a queue.
+ *
+ * @details Implemented by the RTOS port. Must be called from the task owning the queue.
+ *
+ * @param[in] p_queue     Queue.
+ * @param[in] timeout_ms  Timeout, in milliseconds, or @ref SOFTDEVICE_EVT_DEMUX_WAIT_FOREVER.
+ *
+ * @return The slot holding the event, which must be returned with @ref softdevice_evt_demux_free,
+ *         or NULL if no event was received before the timeout.
+ */
+softdevice_evt_demux_slot_t * softdevice_evt_demux_receive(softdevice_evt_demux_queue_t * p_queue,
+                                                           uint32_t                       timeout_ms);
+
+/**@brief Function for returning a slot to its queue after the event was handled.
+ *
+ * @param[in] p_queue  Queue.
+ * @param[in] p_slot   Slot received from the queue.
+ */
+void softdevice_evt_demux_free(softdevice_evt_demux_queue_t * p_queue,
+                               softdevice_evt_demux_slot_t  * p_slot);
+
+/**@brief Function for reading the statistics of a queue.
+ *
+ * @param[in]  p_queue  Queue.
+ * @param[out] p_stats  Statistics.
+ */
+void softdevice_evt_demux_stats_get(softdevice_evt_demux_queue_t const * p_queue,
+                                    softdevice_evt_demux_stats_t       * p_stats);
+
+/**@brief Function for reading the number of events dropped because they matched no route and
+ *        no default queue was set.
+ */
+uint32_t softdevice_evt_demux_unrouted_count_get(void);
+
+/**@brief Function for posting a slot pointer to an RTOS message queue.
+ *
+ * @details Implemented by the RTOS port, for use by the demultiplexer only. Must not block, and
+ *          must be callable from an interrupt.
+ *
+ * @retval true  If the pointer was posted.
+ * @retval false If the RTOS queue was full.
+ */
+bool softdevice_evt_demux_port_post(void * p_os_queue, softdevice_evt_demux_slot_t * p_slot);
+
+#endif // SOFTDEVICE_EVT_DEMUX_H__
+
+/** @} */
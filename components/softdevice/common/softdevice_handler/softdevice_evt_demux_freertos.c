@@ -0,0 +1,52 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "softdevice_evt_demux.h"
+#include "nrf.h"
+
+bool softdevice_evt_demux_port_post(void * p_os_queue, softdevice_evt_demux_slot_t * p_slot)
+{
+    QueueHandle_t queue = (QueueHandle_t)p_os_queue;
+
+    if (__get_IPSR() != 0)
+    {
+        BaseType_t yield_req = pdFALSE;
+
+        if (xQueueSendToBackFromISR(queue, &p_slot, &yield_req) != pdPASS)
+        {
+            return false;
+        }
+        portYIELD_FROM_ISR(yield_req);
+        return true;
+    }
+
+    return (xQueueSendToBack(queue, &p_slot, 0) == pdPASS);
+}
+
+
+softdevice_evt_demux_slot_t * softdevice_evt_demux_receive(softdevice_evt_demux_queue_t * p_queue,
+                                                           uint32_t                       timeout_ms)
+{
+    softdevice_evt_demux_slot_t * p_slot;
+    // Rounded up, since the tick period is not always a whole number of milliseconds.
+    TickType_t const ticks = (timeout_ms == SOFTDEVICE_EVT_DEMUX_WAIT_FOREVER) ? portMAX_DELAY :
+        (TickType_t)(((uint64_t)timeout_ms * configTICK_RATE_HZ + 999) / 1000);
+
+    if (xQueueReceive((QueueHandle_t)p_queue->p_os_queue, &p_slot, ticks) != pdPASS)
+    {
+        return NULL;
+    }
+    return p_slot;
+}
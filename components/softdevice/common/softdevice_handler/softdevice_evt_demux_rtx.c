@@ -0,0 +1,35 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "cmsis_os.h"
+
+#include "softdevice_evt_demux.h"
+
+bool softdevice_evt_demux_port_post(void * p_os_queue, softdevice_evt_demux_slot_t * p_slot)
+{
+    // A zero timeout makes the call valid from interrupts.
+    return (osMessagePut((osMessageQId)p_os_queue, (uint32_t)p_slot, 0) == osOK);
+}
+
+
+softdevice_evt_demux_slot_t * softdevice_evt_demux_receive(softdevice_evt_demux_queue_t * p_queue,
+                                                           uint32_t                       timeout_ms)
+{
+    // SOFTDEVICE_EVT_DEMUX_WAIT_FOREVER is the value of osWaitForever.
+    osEvent const evt = osMessageGet((osMessageQId)p_queue->p_os_queue, timeout_ms);
+
+    if (evt.status != osEventMessage)
+    {
+        return NULL;
+    }
+    return (softdevice_evt_demux_slot_t *)evt.value.p;
+}
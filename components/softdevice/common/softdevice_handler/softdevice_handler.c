@@ -17,12 +17,17 @@
 #include <string.h>
 #include "nordic_common.h"
 #include "app_error.h"
+#include "app_util_platform.h"
 #include "nrf_assert.h"
 #include "nrf_nvic.h"
 #include "nrf.h"
 #include "nrf_log.h"
+#include "app_profiler.h"
+#include "app_evt_trace.h"
+#include "app_boot_trace.h"
 #include "sdk_common.h"
 #include "nrf_drv_config.h"
+#include "nrf_drv_common.h"
 #if CLOCK_ENABLED
 #include "nrf_drv_clock.h"
 #endif
@@ -82,10 +87,84 @@ static ble_evt_handler_t              m_ble_evt_handler;                /**< App
 // The following two definition is needed only if ANT events are needed to be pulled from the stack.
 static ant_evt_t                      m_ant_evt_buffer;                 /**< Buffer for receiving ANT events from the SoftDevice. */
 static ant_evt_handler_t              m_ant_evt_handler;                /**< Application event handler for handling ANT events.  */
+static ant_evt_filter_t               m_ant_evt_filter;                 /**< Application event filter for ANT events. */
 #endif
 
 static sys_evt_handler_t              m_sys_evt_handler;                /**< Application event handler for handling System (SOC) events.  */
 
+#if (SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED == 1)
+static softdevice_handler_drain_stats_t m_drain_stats;                  /**< Statistics of the passes of the event handler. */
+#endif
+
+#if (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
+// Each section holds one observer with an empty event range, so that the section (and its start
+// and end symbols) exists on all toolchains even if no module registers an observer.
+#ifdef BLE_STACK_SUPPORT_REQD
+NRF_SECTION_VARS_REGISTER_SECTION(sdh_ble_observers);
+NRF_SECTION_VARS_REGISTER_SYMBOLS(softdevice_ble_observer_t, sdh_ble_observers);
+SOFTDEVICE_BLE_OBSERVER_REGISTER(m_ble_observer_placeholder, 1, 0, 0, NULL);
+#endif
+
+NRF_SECTION_VARS_REGISTER_SECTION(sdh_soc_observers);
+NRF_SECTION_VARS_REGISTER_SYMBOLS(softdevice_soc_observer_t, sdh_soc_observers);
+SOFTDEVICE_SOC_OBSERVER_REGISTER(m_soc_observer_placeholder, 1, 0, 0, NULL);
+
+
+#ifdef BLE_STACK_SUPPORT_REQD
+/**@brief Function for passing a BLE event to the registered observers interested in it.
+ *
+ * @param[in] p_ble_evt  Event received from the SoftDevice.
+ */
+static void ble_observers_notify(ble_evt_t * p_ble_evt)
+{
+    uint32_t const count = NRF_SECTION_VARS_COUNT(softdevice_ble_observer_t, sdh_ble_observers);
+    uint16_t const evt_id = p_ble_evt->header.evt_id;
+
+    for (uint32_t prio = 0; prio < SOFTDEVICE_OBSERVER_PRIO_LEVELS; prio++)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            softdevice_ble_observer_t const * p_observer =
+                NRF_SECTION_VARS_GET(i, softdevice_ble_observer_t const, sdh_ble_observers);
+
+            if (   (p_observer->priority     == prio)
+                && (p_observer->evt_id_first <= evt_id)
+                && (p_observer->evt_id_last  >= evt_id))
+            {
+                p_observer->handler(p_ble_evt);
+            }
+        }
+    }
+}
+#endif
+
+
+/**@brief Function for passing a System (SOC) event to the registered observers interested in it.
+ *
+ * @param[in] evt_id  Event received from the SoftDevice.
+ */
+static void soc_observers_notify(uint32_t evt_id)
+{
+    uint32_t const count = NRF_SECTION_VARS_COUNT(softdevice_soc_observer_t, sdh_soc_observers);
+
+    for (uint32_t prio = 0; prio < SOFTDEVICE_OBSERVER_PRIO_LEVELS; prio++)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            softdevice_soc_observer_t const * p_observer =
+                NRF_SECTION_VARS_GET(i, softdevice_soc_observer_t const, sdh_soc_observers);
+
+            if (   (p_observer->priority     == prio)
+                && (p_observer->evt_id_first <= evt_id)
+                && (p_observer->evt_id_last  >= evt_id))
+            {
+                p_observer->handler(evt_id);
+            }
+        }
+    }
+}
+#endif // SOFTDEVICE_HANDLER_OBSERVERS_ENABLED
+
 
 /**@brief       Callback function for asserts in the SoftDevice.
  *
@@ -106,6 +185,32 @@ void softdevice_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
 }
 
 
+#if (SOFTDEVICE_HANDLER_EVT_BUDGET > 0)
+/**@brief Function for requesting a new pass of the event handler, when events were left by the
+ *        previous pass.
+ */
+static void events_execute_resume(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (m_evt_schedule_func != NULL)
+    {
+        err_code = m_evt_schedule_func();
+    }
+    else
+    {
+#ifdef SOFTDEVICE_PRESENT
+        err_code = sd_nvic_SetPendingIRQ((IRQn_Type)SOFTDEVICE_EVT_IRQ);
+#else
+        NVIC_SetPendingIRQ(SOFTDEVICE_EVT_IRQ);
+#endif
+    }
+
+    APP_ERROR_CHECK(err_code);
+}
+#endif
+
+
 void intern_softdevice_events_execute(void)
 {
     if (!m_softdevice_enabled)
@@ -115,17 +220,23 @@ void intern_softdevice_events_execute(void)
 
         return;
     }
-#if CLOCK_ENABLED
+#if CLOCK_ENABLED || (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
     bool no_more_soc_evts = false;
 #else
     bool no_more_soc_evts = (m_sys_evt_handler == NULL);
 #endif
 #ifdef BLE_STACK_SUPPORT_REQD
+#if (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
+    bool no_more_ble_evts = false;
+#else
     bool no_more_ble_evts = (m_ble_evt_handler == NULL);
 #endif
+#endif
 #ifdef ANT_STACK_SUPPORT_REQD
     bool no_more_ant_evts = (m_ant_evt_handler == NULL);
 #endif
+    uint32_t evt_count   = 0;
+    bool     budget_used = false;
 
     for (;;)
     {
@@ -148,9 +259,17 @@ void intern_softdevice_events_execute(void)
             }
             else
             {
+                APP_EVT_TRACE_SOC(evt_id);
+                PROFILE_BEGIN(APP_PROFILER_ID_SD_EVT);
+
                 // Call application's SOC event handler.
 #if CLOCK_ENABLED
                 nrf_drv_clock_on_soc_event(evt_id);
+#endif
+#if (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
+                soc_observers_notify(evt_id);
+#endif
+#if CLOCK_ENABLED || (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
                 if (m_sys_evt_handler)
                 {
                     m_sys_evt_handler(evt_id);
@@ -158,6 +277,10 @@ void intern_softdevice_events_execute(void)
 #else
                 m_sys_evt_handler(evt_id);
 #endif
+
+                PROFILE_END(APP_PROFILER_ID_SD_EVT);
+                APP_EVT_TRACE_END();
+                evt_count++;
             }
         }
 
@@ -179,15 +302,30 @@ void intern_softdevice_events_execute(void)
             }
             else
             {
+                APP_EVT_TRACE_BLE(mp_ble_evt_buffer, evt_len);
+                PROFILE_BEGIN(APP_PROFILER_ID_SD_EVT);
+
                 // Call application's BLE stack event handler.
+#if (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
+                ble_observers_notify((ble_evt_t *)mp_ble_evt_buffer);
+                if (m_ble_evt_handler)
+                {
+                    m_ble_evt_handler((ble_evt_t *)mp_ble_evt_buffer);
+                }
+#else
                 m_ble_evt_handler((ble_evt_t *)mp_ble_evt_buffer);
+#endif
+
+                PROFILE_END(APP_PROFILER_ID_SD_EVT);
+                APP_EVT_TRACE_END();
+                evt_count++;
             }
         }
 #endif
 
 #ifdef ANT_STACK_SUPPORT_REQD
-        // Fetch ANT Events.
-        if (!no_more_ant_evts)
+        // Fetch ANT Events, up to ANT_STACK_EVT_BATCH_SIZE in a row.
+        for (uint32_t i = 0; (i < ANT_STACK_EVT_BATCH_SIZE) && !no_more_ant_evts; i++)
         {
             // Pull event from stack
             err_code = sd_ant_event_get(&m_ant_evt_buffer.channel,
@@ -201,10 +339,15 @@ void intern_softdevice_events_execute(void)
             {
                 APP_ERROR_HANDLER(err_code);
             }
-            else
+            else if ((m_ant_evt_filter == NULL) || m_ant_evt_filter(&m_ant_evt_buffer))
             {
+                PROFILE_BEGIN(APP_PROFILER_ID_SD_EVT);
+
                 // Call application's ANT stack event handler.
                 m_ant_evt_handler(&m_ant_evt_buffer);
+
+                PROFILE_END(APP_PROFILER_ID_SD_EVT);
+                evt_count++;
             }
         }
 #endif
@@ -236,7 +379,35 @@ void intern_softdevice_events_execute(void)
             break;
 #endif
         }
+
+#if (SOFTDEVICE_HANDLER_EVT_BUDGET > 0)
+        // The budget is checked after each round of pulls, so that no source is starved.
+        if (evt_count >= SOFTDEVICE_HANDLER_EVT_BUDGET)
+        {
+            budget_used = true;
+            break;
+        }
+#endif
+    }
+
+#if (SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED == 1)
+    CRITICAL_REGION_ENTER();
+    m_drain_stats.passes++;
+    m_drain_stats.events += evt_count;
+    m_drain_stats.budget_hits += budget_used ? 1 : 0;
+    m_drain_stats.max_pass_events = MAX(m_drain_stats.max_pass_events, evt_count);
+    CRITICAL_REGION_EXIT();
+#endif
+
+#if (SOFTDEVICE_HANDLER_EVT_BUDGET > 0)
+    if (budget_used)
+    {
+        events_execute_resume();
     }
+#endif
+
+    UNUSED_VARIABLE(evt_count);
+    UNUSED_VARIABLE(budget_used);
 }
 
 bool softdevice_handler_isEnabled(void)
@@ -290,6 +461,7 @@ uint32_t softdevice_handler_init(nrf_clock_lf_cfg_t	*           p_clock_lf_cfg,
     }
 
     m_softdevice_enabled = true;
+    APP_BOOT_TRACE("sd_enable");
 
     // Enable BLE event interrupt (interrupt priority has already been set by the stack).
 #ifdef SOFTDEVICE_PRESENT
@@ -333,6 +505,14 @@ uint32_t softdevice_ant_evt_handler_set(ant_evt_handler_t ant_evt_handler)
 
     return NRF_SUCCESS;
 }
+
+
+uint32_t softdevice_ant_evt_filter_set(ant_evt_filter_t ant_evt_filter)
+{
+    m_ant_evt_filter = ant_evt_filter;
+
+    return NRF_SUCCESS;
+}
 #endif
 
 
@@ -346,12 +526,32 @@ uint32_t softdevice_sys_evt_handler_set(sys_evt_handler_t sys_evt_handler)
 }
 
 
+#if (SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED == 1)
+void softdevice_handler_drain_stats_get(softdevice_handler_drain_stats_t * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_drain_stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void softdevice_handler_drain_stats_reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(&m_drain_stats, 0, sizeof(m_drain_stats));
+    CRITICAL_REGION_EXIT();
+}
+#endif
+
+
 /**@brief   Function for handling the Application's BLE Stack events interrupt.
  *
  * @details This function is called whenever an event is ready to be pulled.
  */
 void SOFTDEVICE_EVT_IRQHandler(void)
 {
+    NRF_DRV_IRQ_MONITOR_ENTER(SOFTDEVICE_EVT_IRQ);
+
     if (m_evt_schedule_func != NULL)
     {
         uint32_t err_code = m_evt_schedule_func();
@@ -361,6 +561,8 @@ void SOFTDEVICE_EVT_IRQHandler(void)
     {
         intern_softdevice_events_execute();
     }
+
+    NRF_DRV_IRQ_MONITOR_EXIT(SOFTDEVICE_EVT_IRQ);
 }
 
 #if defined(BLE_STACK_SUPPORT_REQD)
@@ -479,6 +681,10 @@ uint32_t softdevice_enable(ble_enable_params_t * p_ble_enable_params)
         while(1);
     }
 #endif   // NRF_LOG_USES_RTT
+    if (err_code == NRF_SUCCESS)
+    {
+        APP_BOOT_TRACE("ble_enable");
+    }
     return err_code;
 #else
     return NRF_SUCCESS;
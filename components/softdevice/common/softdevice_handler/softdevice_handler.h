@@ -43,6 +43,23 @@
     #include "ble.h"
 #endif
 #include "app_ram_base.h"
+
+#ifndef SOFTDEVICE_HANDLER_OBSERVERS_ENABLED
+#define SOFTDEVICE_HANDLER_OBSERVERS_ENABLED 0                                            /**< Enable link-time registration of BLE and System (SOC) event observers, see @ref SOFTDEVICE_BLE_OBSERVER_REGISTER. */
+#endif
+
+#if (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
+#include "section_vars.h"
+#endif
+
+#ifndef SOFTDEVICE_HANDLER_EVT_BUDGET
+#define SOFTDEVICE_HANDLER_EVT_BUDGET         0                                           /**< Highest number of events dispatched in one pass of the event handler. The remaining events are left for a new pass, queued behind the other scheduler events. 0 for no limit. */
+#endif
+
+#ifndef SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED
+#define SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED 0                                          /**< Enable counting of the events dispatched per pass, see @ref softdevice_handler_drain_stats_get. */
+#endif
+
 #define SOFTDEVICE_SCHED_EVT_SIZE       0                                                 /**< Size of button events being passed through the scheduler (is to be used for computing the maximum size of scheduler events). For SoftDevice events, this size is 0, since the events are being pulled in the event handler. */
 #define SYS_EVT_MSG_BUF_SIZE            sizeof(uint32_t)                                  /**< Size of System (SOC) event message buffer. */
 
@@ -73,6 +90,85 @@ typedef uint32_t (*softdevice_evt_schedule_func_t) (void);
 typedef void (*sys_evt_handler_t) (uint32_t evt_id);
 
 
+#if (SOFTDEVICE_HANDLER_OBSERVERS_ENABLED == 1)
+
+#define SOFTDEVICE_OBSERVER_PRIO_LEVELS 4                                                 /**< Number of observer priority levels. Level 0 is dispatched first. */
+
+#if defined(BLE_STACK_SUPPORT_REQD)
+/**@brief BLE event observer, placed in the sdh_ble_observers section.
+ *
+ * @details The handler is called for every BLE event with an ID in the range
+ *          [evt_id_first, evt_id_last].
+ */
+typedef struct
+{
+    ble_evt_handler_t handler;      /**< Function to be called for each matching BLE event. */
+    uint16_t          evt_id_first; /**< First BLE event ID the observer is interested in. */
+    uint16_t          evt_id_last;  /**< Last BLE event ID the observer is interested in. */
+    uint32_t          priority;     /**< Priority level, lower than @ref SOFTDEVICE_OBSERVER_PRIO_LEVELS. */
+} softdevice_ble_observer_t;
+#endif // BLE_STACK_SUPPORT_REQD
+
+/**@brief System (SOC) event observer, placed in the sdh_soc_observers section. */
+typedef struct
+{
+    sys_evt_handler_t handler;      /**< Function to be called for each matching System (SOC) event. */
+    uint16_t          evt_id_first; /**< First System (SOC) event ID the observer is interested in. */
+    uint16_t          evt_id_last;  /**< Last System (SOC) event ID the observer is interested in. */
+    uint32_t          priority;     /**< Priority level, lower than @ref SOFTDEVICE_OBSERVER_PRIO_LEVELS. */
+} softdevice_soc_observer_t;
+
+
+#if defined(BLE_STACK_SUPPORT_REQD)
+/**@brief     Macro for registering a BLE event observer at link time.
+ *
+ * @details   The observer is called from the SoftDevice handler for each BLE event in the given
+ *            ID range, before the handler set with @ref softdevice_ble_evt_handler_set. Observers
+ *            are called in increasing order of priority level; the order between observers of the
+ *            same level is given by the linker.
+ *
+ * @note      A module that registers an observer must not also be dispatched to by the
+ *            application, or it will receive every event twice.
+ *
+ * @param[in] NAME      Name of the observer variable.
+ * @param[in] FIRST     First BLE event ID of interest (for example BLE_GAP_EVT_BASE).
+ * @param[in] LAST      Last BLE event ID of interest (for example BLE_GAP_EVT_LAST).
+ * @param[in] PRIO      Priority level of the observer.
+ * @param[in] HANDLER   Function to be called for each matching event.
+ */
+#define SOFTDEVICE_BLE_OBSERVER_REGISTER(NAME, FIRST, LAST, PRIO, HANDLER)                         \
+    NRF_SECTION_VARS_ADD(sdh_ble_observers, softdevice_ble_observer_t const NAME) =                \
+    {                                                                                              \
+        .handler      = (HANDLER),                                                                 \
+        .evt_id_first = (FIRST),                                                                   \
+        .evt_id_last  = (LAST),                                                                    \
+        .priority     = (PRIO)                                                                     \
+    }
+#endif // BLE_STACK_SUPPORT_REQD
+
+/**@brief     Macro for registering a System (SOC) event observer at link time.
+ *
+ * @details   See @ref SOFTDEVICE_BLE_OBSERVER_REGISTER. The observer is called before the
+ *            handler set with @ref softdevice_sys_evt_handler_set.
+ *
+ * @param[in] NAME      Name of the observer variable.
+ * @param[in] FIRST     First System (SOC) event ID of interest.
+ * @param[in] LAST      Last System (SOC) event ID of interest.
+ * @param[in] PRIO      Priority level of the observer.
+ * @param[in] HANDLER   Function to be called for each matching event.
+ */
+#define SOFTDEVICE_SOC_OBSERVER_REGISTER(NAME, FIRST, LAST, PRIO, HANDLER)                         \
+    NRF_SECTION_VARS_ADD(sdh_soc_observers, softdevice_soc_observer_t const NAME) =                \
+    {                                                                                              \
+        .handler      = (HANDLER),                                                                 \
+        .evt_id_first = (FIRST),                                                                   \
+        .evt_id_last  = (LAST),                                                                    \
+        .priority     = (PRIO)                                                                     \
+    }
+
+#endif // SOFTDEVICE_HANDLER_OBSERVERS_ENABLED
+
+
 /**@brief     Macro for initializing the stack event handler.
  *
  * @details   It will handle dimensioning and allocation of the memory buffer required for reading
@@ -167,6 +263,26 @@ uint32_t softdevice_handler_sd_disable(void);
  */
 uint32_t softdevice_sys_evt_handler_set(sys_evt_handler_t sys_evt_handler);
 
+#if (SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED == 1)
+/**@brief Statistics of the passes of the event handler. */
+typedef struct
+{
+    uint32_t passes;            /**< Number of passes. */
+    uint32_t events;            /**< Number of events dispatched. */
+    uint32_t budget_hits;       /**< Number of passes ended by @ref SOFTDEVICE_HANDLER_EVT_BUDGET with events left. */
+    uint32_t max_pass_events;   /**< Highest number of events dispatched in one pass. */
+} softdevice_handler_drain_stats_t;
+
+/**@brief     Function for reading the statistics of the event handler.
+ *
+ * @param[out] p_stats  Statistics since initialization or the last reset.
+ */
+void softdevice_handler_drain_stats_get(softdevice_handler_drain_stats_t * p_stats);
+
+/**@brief     Function for resetting the statistics of the event handler. */
+void softdevice_handler_drain_stats_reset(void);
+#endif // SOFTDEVICE_HANDLER_DRAIN_STATS_ENABLED
+
 #if defined(BLE_STACK_SUPPORT_REQD)
 /**@brief     Function for fetching the default enable parameters for the SoftDevice.
  *
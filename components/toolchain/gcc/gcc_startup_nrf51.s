@@ -143,6 +143,27 @@ Reset_Handler:
     ORRS    R2, R1
     STR     R2, [R0]
 
+/* Fill the stack with a pattern, so that the stack high-water mark can be measured at runtime
+ * (see app_ram_usage.h). Define __STARTUP_FILL_STACK to enable it.
+ *
+ * The stack is located between __StackLimit and the initial stack pointer.
+ */
+#ifdef __STARTUP_FILL_STACK
+    ldr r0, =0xDEADBEEF
+    ldr r1, =__StackLimit
+    mov r2, sp
+
+    subs r2, r1
+    ble .L_loop_fill_done
+
+.L_loop_fill:
+    subs r2, #4
+    str r0, [r1, r2]
+    bgt .L_loop_fill
+
+.L_loop_fill_done:
+#endif /* __STARTUP_FILL_STACK */
+
 /* Loop to copy data from read only memory to RAM. 
  * The ranges of copy from/to are specified by following symbols:
  *      __etext: LMA of start of the section to copy from. Usually end of text
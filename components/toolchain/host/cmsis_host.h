@@ -0,0 +1,110 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef CMSIS_HOST_H__
+#define CMSIS_HOST_H__
+
+/* Host versions of the CMSIS core intrinsics, included by the host core_cm0.h and core_cm4.h
+ * instead of cmsis_gcc.h. The interrupt and sleep intrinsics are implemented by the
+ * simulation. The SIMD intrinsics are not available. */
+
+#define __CMSIS_GCC_H       // The GCC intrinsics are ARM assembly.
+
+#include <stdint.h>
+#include "nrf_sim.h"
+
+static inline void     __enable_irq(void)                  { nrf_sim_irq_enable(); }
+static inline void     __disable_irq(void)                 { nrf_sim_irq_disable(); }
+static inline uint32_t __get_PRIMASK(void)                 { return nrf_sim_primask_get(); }
+static inline void     __set_PRIMASK(uint32_t primask)
+{
+    if (primask & 1)
+    {
+        nrf_sim_irq_disable();
+    }
+    else
+    {
+        nrf_sim_irq_enable();
+    }
+}
+static inline uint32_t __get_IPSR(void)                    { return nrf_sim_ipsr_get(); }
+static inline uint32_t __get_xPSR(void)                    { return nrf_sim_ipsr_get(); }
+static inline uint32_t __get_APSR(void)                    { return 0; }
+static inline uint32_t __get_CONTROL(void)                 { return 0; }
+static inline void     __set_CONTROL(uint32_t control)     { (void)control; }
+static inline uint32_t __get_BASEPRI(void)                 { return nrf_sim_basepri_get(); }
+static inline void     __set_BASEPRI(uint32_t value)       { nrf_sim_basepri_set(value); }
+static inline void     __set_BASEPRI_MAX(uint32_t value)
+{
+    uint32_t const basepri = nrf_sim_basepri_get();
+
+    if ((value != 0) && ((basepri == 0) || (value < basepri)))
+    {
+        nrf_sim_basepri_set(value);
+    }
+}
+static inline uint32_t __get_FAULTMASK(void)               { return 0; }
+static inline void     __set_FAULTMASK(uint32_t mask)      { (void)mask; }
+static inline uint32_t __get_FPSCR(void)                   { return 0; }
+static inline void     __set_FPSCR(uint32_t fpscr)         { (void)fpscr; }
+
+static inline void     __NOP(void)                         { nrf_sim_nop(); }
+static inline void     __WFI(void)                         { nrf_sim_wfe(); }
+static inline void     __WFE(void)                         { nrf_sim_wfe(); }
+static inline void     __SEV(void)                         { nrf_sim_sev(); }
+static inline void     __ISB(void)                         { __sync_synchronize(); }
+static inline void     __DSB(void)                         { __sync_synchronize(); }
+static inline void     __DMB(void)                         { __sync_synchronize(); }
+
+static inline uint32_t __REV(uint32_t value)               { return __builtin_bswap32(value); }
+static inline uint32_t __REV16(uint32_t value)
+{
+    return ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);
+}
+static inline int32_t  __REVSH(int32_t value)              { return (int16_t)__builtin_bswap16((uint16_t)value); }
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+    op2 &= 31;
+    return (op2 == 0) ? op1 : ((op1 >> op2) | (op1 << (32 - op2)));
+}
+static inline uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+#define __CLZ(value)        (((value) == 0) ? 32U : (uint8_t)__builtin_clz(value))
+#define __BKPT(value)       __builtin_trap()
+
+// Exclusive accesses always succeed: the simulation has a single thread.
+static inline uint8_t  __LDREXB(volatile uint8_t * addr)   { return *addr; }
+static inline uint16_t __LDREXH(volatile uint16_t * addr)  { return *addr; }
+static inline uint32_t __LDREXW(volatile uint32_t * addr)  { return *addr; }
+static inline uint32_t __STREXB(uint8_t value, volatile uint8_t * addr)   { *addr = value; return 0; }
+static inline uint32_t __STREXH(uint16_t value, volatile uint16_t * addr) { *addr = value; return 0; }
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t * addr) { *addr = value; return 0; }
+static inline void     __CLREX(void)                       { }
+
+#define __SSAT(value, sat)                                                          \
+    ((int32_t)(value) > ((1L << ((sat) - 1)) - 1) ? ((1L << ((sat) - 1)) - 1) :     \
+     (int32_t)(value) < -(1L << ((sat) - 1))      ? -(1L << ((sat) - 1))      :     \
+     (int32_t)(value))
+#define __USAT(value, sat)                                                          \
+    ((int32_t)(value) < 0                         ? 0UL                       :     \
+     (uint32_t)(value) > ((1UL << (sat)) - 1)     ? ((1UL << (sat)) - 1)      :     \
+     (uint32_t)(value))
+
+#endif // CMSIS_HOST_H__
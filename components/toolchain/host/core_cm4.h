@@ -0,0 +1,18 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/* Host build of the Cortex-M4 core header: the CMSIS header, with the intrinsics and the NVIC
+ * functions of the simulation. This directory must come before the CMSIS include directory. */
+
+#include "cmsis_host.h"
+#include_next "core_cm4.h"
+#include "nvic_host.h"
@@ -0,0 +1,31 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef _NRF_DELAY_H
+#define _NRF_DELAY_H
+
+/* Host build of the delay functions: the simulated time passes instead of the CPU spinning. */
+
+#include <stdint.h>
+#include "nrf_sim.h"
+
+static inline void nrf_delay_us(uint32_t volatile number_of_us)
+{
+    nrf_sim_time_advance(number_of_us);
+}
+
+static inline void nrf_delay_ms(uint32_t volatile number_of_ms)
+{
+    nrf_sim_time_advance(number_of_ms * 1000);
+}
+
+#endif // _NRF_DELAY_H
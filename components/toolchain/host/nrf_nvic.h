@@ -0,0 +1,28 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/* Host build of the SoftDevice NVIC header. The NVIC functions of the SoftDevice use the NVIC
+ * functions of the simulation, except the critical region functions, which access the NVIC
+ * registers directly and are replaced. */
+
+#ifndef NRF_NVIC_HOST_H__
+#define NRF_NVIC_HOST_H__
+
+#include_next "nrf_nvic.h"
+
+uint32_t nrf_sim_critical_region_enter(uint8_t * p_is_nested_critical_region);
+uint32_t nrf_sim_critical_region_exit(uint8_t is_nested_critical_region);
+
+#define sd_nvic_critical_region_enter(p_is_nested)  nrf_sim_critical_region_enter(p_is_nested)
+#define sd_nvic_critical_region_exit(is_nested)     nrf_sim_critical_region_exit(is_nested)
+
+#endif // NRF_NVIC_HOST_H__
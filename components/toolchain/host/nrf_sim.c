@@ -0,0 +1,538 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "nrf.h"
+#include "nrf_error.h"
+#include "nrf_nvic.h"
+#include "nrf_sim.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE     0x100000    // Treated as a hint by kernels older than 4.17.
+#endif
+
+#define RAM_BASE                0x20000000UL
+#define APB_BASE                0x40000000UL
+#define APB_SIZE                0x40000UL
+#define AHB_BASE                0x50000000UL
+#define AHB_SIZE                0x1000UL
+#define PPB_BASE                0xE0000000UL
+#define PPB_SIZE                0x100000UL
+#define INFO_SIZE               0x1000UL
+
+#define IRQ_COUNT               64          // Device interrupts handled by the emulated NVIC.
+#define THREAD_PRIORITY         0x100       // Execution priority of thread mode, below all interrupts.
+#define IPSR_IRQ_OFFSET         16          // Exception number of IRQ 0.
+
+#define RESET_EXIT_STATUS       3           // Exit status of the simulation on a system reset.
+
+#if defined(NRF52)
+uint32_t SystemCoreClock = 64000000;
+#else
+uint32_t SystemCoreClock = 16000000;
+#endif
+
+static uint64_t m_time;                     // Simulated time, in microseconds.
+static uint64_t m_irq_enabled;
+static uint64_t m_irq_pending;
+static uint64_t m_irq_active;
+static uint8_t  m_irq_priority[IRQ_COUNT];
+static uint32_t m_irq_taken;                // Number of interrupt handlers run.
+static uint32_t m_exec_priority = THREAD_PRIORITY;
+static uint32_t m_ipsr;
+static bool     m_primask;
+static uint32_t m_basepri;
+static bool     m_critical_region;          // Set in a SoftDevice critical region.
+static bool     m_event;                    // Event register of WFE.
+
+static ucontext_t m_host_context;
+static ucontext_t m_app_context;
+static int        m_argc;
+static char **    m_argv;
+static int        m_exit_status;
+
+
+/**@brief Default interrupt handler. The target would be stuck in an infinite loop. */
+void nrf_sim_default_handler(void)
+{
+    fprintf(stderr, "nrf_sim: unhandled exception %u\n", (unsigned)m_ipsr);
+    exit(EXIT_FAILURE);
+}
+
+#define SIM_IRQ_HANDLER(name) \
+    void name(void) __attribute__((weak, alias("nrf_sim_default_handler")))
+
+#if defined(NRF52)
+SIM_IRQ_HANDLER(POWER_CLOCK_IRQHandler);
+SIM_IRQ_HANDLER(RADIO_IRQHandler);
+SIM_IRQ_HANDLER(UARTE0_UART0_IRQHandler);
+SIM_IRQ_HANDLER(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler);
+SIM_IRQ_HANDLER(SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler);
+SIM_IRQ_HANDLER(NFCT_IRQHandler);
+SIM_IRQ_HANDLER(GPIOTE_IRQHandler);
+SIM_IRQ_HANDLER(SAADC_IRQHandler);
+SIM_IRQ_HANDLER(TIMER0_IRQHandler);
+SIM_IRQ_HANDLER(TIMER1_IRQHandler);
+SIM_IRQ_HANDLER(TIMER2_IRQHandler);
+SIM_IRQ_HANDLER(RTC0_IRQHandler);
+SIM_IRQ_HANDLER(TEMP_IRQHandler);
+SIM_IRQ_HANDLER(RNG_IRQHandler);
+SIM_IRQ_HANDLER(ECB_IRQHandler);
+SIM_IRQ_HANDLER(CCM_AAR_IRQHandler);
+SIM_IRQ_HANDLER(WDT_IRQHandler);
+SIM_IRQ_HANDLER(RTC1_IRQHandler);
+SIM_IRQ_HANDLER(QDEC_IRQHandler);
+SIM_IRQ_HANDLER(COMP_LPCOMP_IRQHandler);
+SIM_IRQ_HANDLER(SWI0_EGU0_IRQHandler);
+SIM_IRQ_HANDLER(SWI1_EGU1_IRQHandler);
+SIM_IRQ_HANDLER(SWI2_EGU2_IRQHandler);
+SIM_IRQ_HANDLER(SWI3_EGU3_IRQHandler);
+SIM_IRQ_HANDLER(SWI4_EGU4_IRQHandler);
+SIM_IRQ_HANDLER(SWI5_EGU5_IRQHandler);
+SIM_IRQ_HANDLER(TIMER3_IRQHandler);
+SIM_IRQ_HANDLER(TIMER4_IRQHandler);
+SIM_IRQ_HANDLER(PWM0_IRQHandler);
+SIM_IRQ_HANDLER(PDM_IRQHandler);
+SIM_IRQ_HANDLER(MWU_IRQHandler);
+SIM_IRQ_HANDLER(PWM1_IRQHandler);
+SIM_IRQ_HANDLER(PWM2_IRQHandler);
+SIM_IRQ_HANDLER(SPIM2_SPIS2_SPI2_IRQHandler);
+SIM_IRQ_HANDLER(RTC2_IRQHandler);
+SIM_IRQ_HANDLER(I2S_IRQHandler);
+SIM_IRQ_HANDLER(FPU_IRQHandler);
+
+static void (* const m_irq_handlers[IRQ_COUNT])(void) =
+{
+    POWER_CLOCK_IRQHandler, RADIO_IRQHandler, UARTE0_UART0_IRQHandler,
+    SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler, SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler,
+    NFCT_IRQHandler, GPIOTE_IRQHandler, SAADC_IRQHandler, TIMER0_IRQHandler, TIMER1_IRQHandler,
+    TIMER2_IRQHandler, RTC0_IRQHandler, TEMP_IRQHandler, RNG_IRQHandler, ECB_IRQHandler,
+    CCM_AAR_IRQHandler, WDT_IRQHandler, RTC1_IRQHandler, QDEC_IRQHandler, COMP_LPCOMP_IRQHandler,
+    SWI0_EGU0_IRQHandler, SWI1_EGU1_IRQHandler, SWI2_EGU2_IRQHandler, SWI3_EGU3_IRQHandler,
+    SWI4_EGU4_IRQHandler, SWI5_EGU5_IRQHandler, TIMER3_IRQHandler, TIMER4_IRQHandler,
+    PWM0_IRQHandler, PDM_IRQHandler, NULL, NULL, MWU_IRQHandler, PWM1_IRQHandler,
+    PWM2_IRQHandler, SPIM2_SPIS2_SPI2_IRQHandler, RTC2_IRQHandler, I2S_IRQHandler, FPU_IRQHandler,
+};
+#else
+SIM_IRQ_HANDLER(POWER_CLOCK_IRQHandler);
+SIM_IRQ_HANDLER(RADIO_IRQHandler);
+SIM_IRQ_HANDLER(UART0_IRQHandler);
+SIM_IRQ_HANDLER(SPI0_TWI0_IRQHandler);
+SIM_IRQ_HANDLER(SPI1_TWI1_IRQHandler);
+SIM_IRQ_HANDLER(GPIOTE_IRQHandler);
+SIM_IRQ_HANDLER(ADC_IRQHandler);
+SIM_IRQ_HANDLER(TIMER0_IRQHandler);
+SIM_IRQ_HANDLER(TIMER1_IRQHandler);
+SIM_IRQ_HANDLER(TIMER2_IRQHandler);
+SIM_IRQ_HANDLER(RTC0_IRQHandler);
+SIM_IRQ_HANDLER(TEMP_IRQHandler);
+SIM_IRQ_HANDLER(RNG_IRQHandler);
+SIM_IRQ_HANDLER(ECB_IRQHandler);
+SIM_IRQ_HANDLER(CCM_AAR_IRQHandler);
+SIM_IRQ_HANDLER(WDT_IRQHandler);
+SIM_IRQ_HANDLER(RTC1_IRQHandler);
+SIM_IRQ_HANDLER(QDEC_IRQHandler);
+SIM_IRQ_HANDLER(LPCOMP_IRQHandler);
+SIM_IRQ_HANDLER(SWI0_IRQHandler);
+SIM_IRQ_HANDLER(SWI1_IRQHandler);
+SIM_IRQ_HANDLER(SWI2_IRQHandler);
+SIM_IRQ_HANDLER(SWI3_IRQHandler);
+SIM_IRQ_HANDLER(SWI4_IRQHandler);
+SIM_IRQ_HANDLER(SWI5_IRQHandler);
+
+static void (* const m_irq_handlers[IRQ_COUNT])(void) =
+{
+    POWER_CLOCK_IRQHandler, RADIO_IRQHandler, UART0_IRQHandler, SPI0_TWI0_IRQHandler,
+    SPI1_TWI1_IRQHandler, NULL, GPIOTE_IRQHandler, ADC_IRQHandler, TIMER0_IRQHandler,
+    TIMER1_IRQHandler, TIMER2_IRQHandler, RTC0_IRQHandler, TEMP_IRQHandler, RNG_IRQHandler,
+    ECB_IRQHandler, CCM_AAR_IRQHandler, WDT_IRQHandler, RTC1_IRQHandler, QDEC_IRQHandler,
+    LPCOMP_IRQHandler, SWI0_IRQHandler, SWI1_IRQHandler, SWI2_IRQHandler, SWI3_IRQHandler,
+    SWI4_IRQHandler, SWI5_IRQHandler,
+};
+#endif
+
+
+static bool irq_valid(int32_t irqn)
+{
+    return (irqn >= 0) && (irqn < IRQ_COUNT) && (m_irq_handlers[irqn] != NULL);
+}
+
+
+static uint64_t irq_mask(int32_t irqn)
+{
+    return 1ULL << irqn;
+}
+
+
+void nrf_sim_nvic_enable(int32_t irqn)
+{
+    if (irq_valid(irqn))
+    {
+        m_irq_enabled |= irq_mask(irqn);
+        nrf_sim_irq_process();
+    }
+}
+
+
+void nrf_sim_nvic_disable(int32_t irqn)
+{
+    if (irq_valid(irqn))
+    {
+        m_irq_enabled &= ~irq_mask(irqn);
+    }
+}
+
+
+void nrf_sim_nvic_pend(int32_t irqn)
+{
+    if (irq_valid(irqn))
+    {
+        m_irq_pending |= irq_mask(irqn);
+    }
+}
+
+
+void nrf_sim_nvic_set_pending(int32_t irqn)
+{
+    // As on the target, the interrupt is taken before the next instruction if its priority
+    // allows it.
+    nrf_sim_nvic_pend(irqn);
+    nrf_sim_irq_process();
+}
+
+
+bool nrf_sim_nvic_pending_get(int32_t irqn)
+{
+    return irq_valid(irqn) && ((m_irq_pending & irq_mask(irqn)) != 0);
+}
+
+
+void nrf_sim_nvic_pending_clear(int32_t irqn)
+{
+    if (irq_valid(irqn))
+    {
+        m_irq_pending &= ~irq_mask(irqn);
+    }
+}
+
+
+bool nrf_sim_nvic_active_get(int32_t irqn)
+{
+    return irq_valid(irqn) && ((m_irq_active & irq_mask(irqn)) != 0);
+}
+
+
+void nrf_sim_nvic_priority_set(int32_t irqn, uint32_t priority)
+{
+    // The priorities of the system exceptions are not simulated.
+    if (irq_valid(irqn))
+    {
+        m_irq_priority[irqn] = (uint8_t)(priority & ((1UL << __NVIC_PRIO_BITS) - 1));
+    }
+}
+
+
+uint32_t nrf_sim_nvic_priority_get(int32_t irqn)
+{
+    return irq_valid(irqn) ? m_irq_priority[irqn] : 0;
+}
+
+
+void nrf_sim_system_reset(void)
+{
+    fflush(stdout);
+    fprintf(stderr, "nrf_sim: system reset at %llu us\n", (unsigned long long)m_time);
+    exit(RESET_EXIT_STATUS);
+}
+
+
+void nrf_sim_irq_process(void)
+{
+    for (;;)
+    {
+        uint32_t limit = m_exec_priority;
+        int32_t  irqn  = -1;
+
+        if (m_primask || m_critical_region)
+        {
+            return;
+        }
+        if (m_basepri != 0)
+        {
+            uint32_t const basepri_level = m_basepri >> (8 - __NVIC_PRIO_BITS);
+
+            limit = (basepri_level < limit) ? basepri_level : limit;
+        }
+
+        uint64_t const candidates = m_irq_pending & m_irq_enabled;
+        for (int32_t i = 0; i < IRQ_COUNT; i++)
+        {
+            if (((candidates & irq_mask(i)) != 0) && (m_irq_priority[i] < limit))
+            {
+                irqn  = i;
+                limit = m_irq_priority[i];
+            }
+        }
+        if (irqn < 0)
+        {
+            return;
+        }
+
+        uint32_t const exec_priority = m_exec_priority;
+        uint32_t const ipsr          = m_ipsr;
+
+        m_irq_pending   &= ~irq_mask(irqn);
+        m_irq_active    |= irq_mask(irqn);
+        m_exec_priority  = m_irq_priority[irqn];
+        m_ipsr           = (uint32_t)irqn + IPSR_IRQ_OFFSET;
+        m_event          = true;
+        m_irq_taken++;
+
+        m_irq_handlers[irqn]();
+
+        m_irq_active    &= ~irq_mask(irqn);
+        m_exec_priority  = exec_priority;
+        m_ipsr           = ipsr;
+
+        // The event lines of the peripherals are levels: raise again those still active.
+        nrf_sim_rtc_update(m_time);
+    }
+}
+
+
+void nrf_sim_irq_disable(void)
+{
+    m_primask = true;
+}
+
+
+void nrf_sim_irq_enable(void)
+{
+    m_primask = false;
+    nrf_sim_irq_process();
+}
+
+
+uint32_t nrf_sim_primask_get(void)
+{
+    return m_primask ? 1 : 0;
+}
+
+
+uint32_t nrf_sim_basepri_get(void)
+{
+    return m_basepri;
+}
+
+
+void nrf_sim_basepri_set(uint32_t basepri)
+{
+    m_basepri = basepri & 0xFF;
+    nrf_sim_irq_process();
+}
+
+
+uint32_t nrf_sim_ipsr_get(void)
+{
+    return m_ipsr;
+}
+
+
+uint32_t nrf_sim_critical_region_enter(uint8_t * p_is_nested_critical_region)
+{
+    *p_is_nested_critical_region = m_critical_region ? 1 : 0;
+    m_critical_region = true;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_sim_critical_region_exit(uint8_t is_nested_critical_region)
+{
+    if (m_critical_region && (is_nested_critical_region == 0))
+    {
+        m_critical_region = false;
+        nrf_sim_irq_process();
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for updating the models at the current time and taking the interrupts. */
+static void models_update(void)
+{
+    nrf_sim_rtc_update(m_time);
+    nrf_sim_nvmc_update(m_time);
+    nrf_sim_irq_process();
+}
+
+
+static uint64_t next_event_get(void)
+{
+    uint64_t const rtc  = nrf_sim_rtc_next_event(m_time);
+    uint64_t const nvmc = nrf_sim_nvmc_next_event();
+
+    return (rtc < nvmc) ? rtc : nvmc;
+}
+
+
+uint64_t nrf_sim_time_get(void)
+{
+    return m_time;
+}
+
+
+void nrf_sim_time_advance(uint32_t us)
+{
+    uint64_t const target = m_time + us;
+
+    for (;;)
+    {
+        models_update();
+        if (m_time >= target)
+        {
+            break;
+        }
+
+        uint64_t const next = next_event_get();
+        m_time = (next < target) ? next : target;
+    }
+}
+
+
+bool nrf_sim_wait(void)
+{
+    uint32_t const irq_taken = m_irq_taken;
+
+    for (;;)
+    {
+        models_update();
+        // A pending interrupt wakes the CPU up even if it is masked.
+        if ((m_irq_taken != irq_taken) || ((m_irq_pending & m_irq_enabled) != 0))
+        {
+            return true;
+        }
+
+        uint64_t const next = next_event_get();
+        if (next == NRF_SIM_TIME_NEVER)
+        {
+            return false;
+        }
+        m_time = next;
+    }
+}
+
+
+void nrf_sim_wfe(void)
+{
+    if (!m_event && !nrf_sim_wait())
+    {
+        fflush(stdout);
+        fprintf(stderr, "nrf_sim: waiting with no event scheduled at %llu us\n",
+                (unsigned long long)m_time);
+        exit(EXIT_FAILURE);
+    }
+    m_event = false;
+}
+
+
+void nrf_sim_sev(void)
+{
+    m_event = true;
+}
+
+
+void nrf_sim_nop(void)
+{
+}
+
+
+static void region_map(uintptr_t address, size_t size)
+{
+    void * const p_region = mmap((void *)address, size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p_region != (void *)address)
+    {
+        fprintf(stderr, "nrf_sim: cannot map 0x%08lx\n", (unsigned long)address);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+/**@brief Macro for setting a read-only FICR register. */
+#define FICR_SET(reg, value)    (*(uint32_t volatile *)&NRF_FICR->reg = (value))
+
+
+static void memory_init(void)
+{
+    region_map(NRF_FICR_BASE, INFO_SIZE);
+    region_map(NRF_UICR_BASE, INFO_SIZE);
+    region_map(RAM_BASE, NRF_SIM_RAM_SIZE);
+    region_map(APB_BASE, APB_SIZE);
+    region_map(AHB_BASE, AHB_SIZE);
+    region_map(PPB_BASE, PPB_SIZE);
+
+    memset((void *)NRF_UICR_BASE, 0xFF, INFO_SIZE);
+    memset((void *)NRF_FICR_BASE, 0xFF, INFO_SIZE);
+    FICR_SET(CODEPAGESIZE,  NRF_SIM_FLASH_PAGE_SIZE);
+    FICR_SET(CODESIZE,      NRF_SIM_FLASH_PAGES);
+    FICR_SET(DEVICEID[0],   0x5EED0001);
+    FICR_SET(DEVICEID[1],   0x5EED0002);
+    FICR_SET(DEVICEADDR[0], 0x5EED0003);
+    FICR_SET(DEVICEADDR[1], 0xFFFFC0DE);
+}
+
+
+static void app_main(void)
+{
+    int __real_main(int argc, char ** argv);
+
+    m_exit_status = __real_main(m_argc, m_argv);
+}
+
+
+/**@brief Function for starting the simulation, and running the application main on a stack in
+ *        the simulated RAM. The application is linked with -Wl,--wrap=main.
+ */
+int __wrap_main(int argc, char ** argv)
+{
+    memory_init();
+    nrf_sim_nvmc_init();
+    nrf_sim_rtc_init();
+
+    m_argc = argc;
+    m_argv = argv;
+
+    if (getcontext(&m_app_context) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    m_app_context.uc_stack.ss_sp   = (void *)RAM_BASE;
+    m_app_context.uc_stack.ss_size = NRF_SIM_RAM_SIZE;
+    m_app_context.uc_link          = &m_host_context;
+    makecontext(&m_app_context, app_main, 0);
+
+    if (swapcontext(&m_host_context, &m_app_context) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    fflush(stdout);
+    return m_exit_status;
+}
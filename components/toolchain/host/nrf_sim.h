@@ -0,0 +1,159 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef NRF_SIM_H__
+#define NRF_SIM_H__
+
+/**
+ * @defgroup nrf_sim Host simulation
+ * @{
+ * @brief Native (x86 Linux) build of the SDK libraries, with simulated time, RTC and flash.
+ *
+ * @details The simulation replaces the startup code, the CMSIS core intrinsics and the
+ *          SoftDevice, so that libraries such as fds, fstorage, app_timer, app_scheduler,
+ *          app_fifo, mem_manager, crc16, crc32, sha256 and the NDEF modules build unmodified
+ *          with the host compiler. The application main is linked with -Wl,--wrap=main.
+ *
+ *          - The memory map of the device is mapped at its real addresses: flash, FICR, UICR,
+ *            RAM, peripherals and the Cortex-M private peripherals. RAM holds the stack of the
+ *            application, so that addresses fit in 32 bits as on the target. The flash is read
+ *            only for the application, and is kept in the file given by the NRF_SIM_FLASH
+ *            environment variable, if set.
+ *          - Time only passes when the application waits: in sd_app_evt_wait, __WFE,
+ *            nrf_delay_us or @ref nrf_sim_time_advance. Runs are deterministic.
+ *          - The NVIC is emulated, with priorities and preemption. Pending interrupts are taken
+ *            when time passes, when an interrupt is enabled or pended by software, when a
+ *            critical region is exited or when interrupts are enabled, and run to completion
+ *            in the host thread. The events of the peripheral models only raise interrupts
+ *            when time passes.
+ *          - The RTC instances count at 32768 Hz, with compare and overflow events.
+ *          - The SoftDevice flash API writes and erases with the timing of the NVMC, and
+ *            reports the result with a SoC event. A write only clears bits: the bits written
+ *            as 1 keep their value.
+ *          - NVIC_SystemReset ends the simulation.
+ *
+ *          Other peripherals are plain memory: their registers can be written and read, but
+ *          have no effect.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(NRF52)
+#define NRF_SIM_FLASH_PAGE_SIZE     4096        /**< Flash page size, in bytes. */
+#define NRF_SIM_FLASH_PAGES         128         /**< Number of flash pages. */
+#define NRF_SIM_RAM_SIZE            0x10000     /**< RAM size, in bytes. */
+#else
+#define NRF_SIM_FLASH_PAGE_SIZE     1024
+#define NRF_SIM_FLASH_PAGES         256
+#define NRF_SIM_RAM_SIZE            0x8000
+#endif
+
+#ifndef NRF_SIM_NVMC_WRITE_US
+#if defined(NRF52)
+#define NRF_SIM_NVMC_WRITE_US       41          /**< Time to write one word, in microseconds. */
+#else
+#define NRF_SIM_NVMC_WRITE_US       46
+#endif
+#endif
+
+#ifndef NRF_SIM_NVMC_ERASE_US
+#if defined(NRF52)
+#define NRF_SIM_NVMC_ERASE_US       85000       /**< Time to erase one page, in microseconds. */
+#else
+#define NRF_SIM_NVMC_ERASE_US       22000
+#endif
+#endif
+
+#define NRF_SIM_NVMC_WRITES_MAX     2           /**< Number of writes of a word allowed between two erases of its page. */
+
+/**@brief Flash statistics. */
+typedef struct
+{
+    uint32_t words_written;     /**< Words written. */
+    uint32_t pages_erased;      /**< Pages erased. */
+    uint64_t busy_us;           /**< Time spent writing and erasing. */
+    uint32_t overwrites;        /**< Words written more than @ref NRF_SIM_NVMC_WRITES_MAX times between two erases. */
+} nrf_sim_nvmc_stats_t;
+
+
+/**@brief Function for reading the simulated time, in microseconds. */
+uint64_t nrf_sim_time_get(void);
+
+/**@brief Function for letting time pass, taking the interrupts raised meanwhile.
+ *
+ * @param[in] us  Time to pass, in microseconds.
+ */
+void nrf_sim_time_advance(uint32_t us);
+
+/**@brief Function for waiting for the next event, like sd_app_evt_wait.
+ *
+ * @details Pending interrupts are taken. If there are none, time passes until the next RTC
+ *          event or the end of the flash operation, whichever comes first.
+ *
+ * @retval true   An interrupt was taken.
+ * @retval false  No event is scheduled: the device would sleep forever.
+ */
+bool nrf_sim_wait(void);
+
+/**@brief Function for taking the pending interrupts of higher priority than the current one. */
+void nrf_sim_irq_process(void);
+
+/**@brief Function for reading the flash statistics. */
+void nrf_sim_nvmc_stats_get(nrf_sim_nvmc_stats_t * p_stats);
+
+/**@brief Function for clearing the flash statistics and the erase counts. */
+void nrf_sim_nvmc_stats_reset(void);
+
+/**@brief Function for reading the number of erases of a flash page since the last reset. */
+uint32_t nrf_sim_nvmc_erase_count_get(uint32_t page);
+
+
+/** @cond Internal interface of the simulation models. */
+
+#define NRF_SIM_TIME_NEVER          UINT64_MAX
+
+void     nrf_sim_nvic_pend(int32_t irqn);
+void     nrf_sim_nvic_set_pending(int32_t irqn);
+void     nrf_sim_nvic_enable(int32_t irqn);
+void     nrf_sim_nvic_disable(int32_t irqn);
+bool     nrf_sim_nvic_pending_get(int32_t irqn);
+void     nrf_sim_nvic_pending_clear(int32_t irqn);
+void     nrf_sim_nvic_priority_set(int32_t irqn, uint32_t priority);
+uint32_t nrf_sim_nvic_priority_get(int32_t irqn);
+bool     nrf_sim_nvic_active_get(int32_t irqn);
+void     nrf_sim_system_reset(void);
+
+void     nrf_sim_irq_disable(void);
+void     nrf_sim_irq_enable(void);
+uint32_t nrf_sim_primask_get(void);
+uint32_t nrf_sim_basepri_get(void);
+void     nrf_sim_basepri_set(uint32_t basepri);
+uint32_t nrf_sim_ipsr_get(void);
+void     nrf_sim_wfe(void);
+void     nrf_sim_sev(void);
+void     nrf_sim_nop(void);
+
+void     nrf_sim_rtc_init(void);
+void     nrf_sim_rtc_update(uint64_t now);
+uint64_t nrf_sim_rtc_next_event(uint64_t now);
+
+void     nrf_sim_nvmc_init(void);
+void     nrf_sim_nvmc_update(uint64_t now);
+uint64_t nrf_sim_nvmc_next_event(void);
+uint32_t nrf_sim_soc_evt_push(uint32_t evt_id);
+
+/** @endcond */
+
+/** @} */
+
+#endif // NRF_SIM_H__
@@ -0,0 +1,230 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "nrf.h"
+#include "nrf_soc.h"
+#include "nrf_error.h"
+#include "nrf_sim.h"
+
+/* Flash model: flash operations of the SoftDevice API, executed by the NVMC. One operation can
+ * be in progress. Its data is written when it ends, and its result is reported with a SoC
+ * event. The flash can only be read by the application: the SoftDevice writes through a second,
+ * writable mapping of the same memory. */
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE     0x100000
+#endif
+
+#define FLASH_SIZE              (NRF_SIM_FLASH_PAGE_SIZE * NRF_SIM_FLASH_PAGES)
+#define FLASH_WORDS             (FLASH_SIZE / sizeof(uint32_t))
+#define FLASH_UNMAPPED          0x10000     // Below the lowest address the host lets a process map.
+#define WRITE_MAX_WORDS         (NRF_SIM_FLASH_PAGE_SIZE / sizeof(uint32_t))
+
+typedef struct
+{
+    bool             busy;
+    bool             erase;
+    uint32_t         index;     // Word index of the destination, or page number.
+    uint32_t const * p_src;
+    uint32_t         words;
+    uint64_t         end;       // Time at which the operation ends.
+} flash_op_t;
+
+static uint32_t *           mp_flash;                       // Writable mapping.
+static uint8_t              m_write_counts[FLASH_WORDS];    // Writes since the last erase, per word.
+static uint32_t             m_erase_counts[NRF_SIM_FLASH_PAGES];
+static flash_op_t           m_op;
+static nrf_sim_nvmc_stats_t m_stats;
+
+
+static int backing_open(void)
+{
+    char const * const p_path = getenv("NRF_SIM_FLASH");
+    struct stat        st;
+    int                fd;
+
+    if (p_path == NULL)
+    {
+        return memfd_create("nrf_sim_flash", 0);
+    }
+
+    fd = open(p_path, O_RDWR | O_CREAT, 0644);
+    if ((fd >= 0) && (fstat(fd, &st) == 0) && (st.st_size != FLASH_SIZE))
+    {
+        // New or resized file: the flash is erased.
+        if (ftruncate(fd, 0) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+
+void nrf_sim_nvmc_init(void)
+{
+    int         fd = backing_open();
+    struct stat st;
+    void *      p_view;
+
+    if ((fd < 0) || (fstat(fd, &st) != 0))
+    {
+        fprintf(stderr, "nrf_sim: cannot open the flash backing\n");
+        exit(EXIT_FAILURE);
+    }
+    bool const erased = (st.st_size != FLASH_SIZE);
+    if (erased && (ftruncate(fd, FLASH_SIZE) != 0))
+    {
+        fprintf(stderr, "nrf_sim: cannot size the flash backing\n");
+        exit(EXIT_FAILURE);
+    }
+
+    mp_flash = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    p_view   = mmap((void *)FLASH_UNMAPPED, FLASH_SIZE - FLASH_UNMAPPED, PROT_READ,
+                    MAP_SHARED | MAP_FIXED_NOREPLACE, fd, FLASH_UNMAPPED);
+    close(fd);
+    if ((mp_flash == MAP_FAILED) || (p_view != (void *)FLASH_UNMAPPED))
+    {
+        fprintf(stderr, "nrf_sim: cannot map the flash\n");
+        exit(EXIT_FAILURE);
+    }
+    if (erased)
+    {
+        memset(mp_flash, 0xFF, FLASH_SIZE);
+    }
+
+    *(uint32_t volatile *)&NRF_NVMC->READY = NVMC_READY_READY_Ready;
+    nrf_sim_nvmc_stats_reset();
+}
+
+
+void nrf_sim_nvmc_update(uint64_t now)
+{
+    if (!m_op.busy || (now < m_op.end))
+    {
+        return;
+    }
+
+    if (m_op.erase)
+    {
+        memset(&mp_flash[m_op.index * WRITE_MAX_WORDS], 0xFF, NRF_SIM_FLASH_PAGE_SIZE);
+        memset(&m_write_counts[m_op.index * WRITE_MAX_WORDS], 0, WRITE_MAX_WORDS);
+        m_erase_counts[m_op.index]++;
+        m_stats.pages_erased++;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < m_op.words; i++)
+        {
+            uint32_t const index = m_op.index + i;
+
+            if (++m_write_counts[index] > NRF_SIM_NVMC_WRITES_MAX)
+            {
+                m_stats.overwrites++;
+                m_write_counts[index] = NRF_SIM_NVMC_WRITES_MAX + 1;
+            }
+            mp_flash[index] &= m_op.p_src[i];
+        }
+        m_stats.words_written += m_op.words;
+    }
+
+    m_op.busy = false;
+    (void)nrf_sim_soc_evt_push(NRF_EVT_FLASH_OPERATION_SUCCESS);
+}
+
+
+uint64_t nrf_sim_nvmc_next_event(void)
+{
+    return m_op.busy ? m_op.end : NRF_SIM_TIME_NEVER;
+}
+
+
+uint32_t sd_flash_write(uint32_t * const p_dst, uint32_t const * const p_src, uint32_t size)
+{
+    uintptr_t const dst = (uintptr_t)p_dst;
+
+    if (m_op.busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+    if ((size == 0) || (size > WRITE_MAX_WORDS))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    if (((dst & 0x03) != 0) || ((uintptr_t)p_src & 0x03) ||
+        (dst < FLASH_UNMAPPED) || (dst + size * sizeof(uint32_t) > FLASH_SIZE))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    m_op.busy   = true;
+    m_op.erase  = false;
+    m_op.index  = (uint32_t)(dst / sizeof(uint32_t));
+    m_op.p_src  = p_src;
+    m_op.words  = size;
+    m_op.end    = nrf_sim_time_get() + (uint64_t)size * NRF_SIM_NVMC_WRITE_US;
+
+    m_stats.busy_us += (uint64_t)size * NRF_SIM_NVMC_WRITE_US;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_flash_page_erase(uint32_t page_number)
+{
+    if (m_op.busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+    if ((page_number >= NRF_SIM_FLASH_PAGES) ||
+        (page_number * NRF_SIM_FLASH_PAGE_SIZE < FLASH_UNMAPPED))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    m_op.busy   = true;
+    m_op.erase  = true;
+    m_op.index  = page_number;
+    m_op.end    = nrf_sim_time_get() + NRF_SIM_NVMC_ERASE_US;
+
+    m_stats.busy_us += NRF_SIM_NVMC_ERASE_US;
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_sim_nvmc_stats_get(nrf_sim_nvmc_stats_t * p_stats)
+{
+    *p_stats = m_stats;
+}
+
+
+void nrf_sim_nvmc_stats_reset(void)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+    memset(m_erase_counts, 0, sizeof(m_erase_counts));
+}
+
+
+uint32_t nrf_sim_nvmc_erase_count_get(uint32_t page)
+{
+    return (page < NRF_SIM_FLASH_PAGES) ? m_erase_counts[page] : 0;
+}
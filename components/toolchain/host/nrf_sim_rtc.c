@@ -0,0 +1,229 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <string.h>
+#include "nrf.h"
+#include "nrf_sim.h"
+
+/* RTC model. The tasks, the INTENSET/INTENCLR and EVTENSET/EVTENCLR registers are read when
+ * the model is updated, as the writes to the registers cannot be trapped: INTENCLR and EVTENCLR
+ * read as 0 between updates, and INTENSET and EVTENSET as the enabled events. */
+
+#define LFCLK_HZ            32768
+#define COUNTER_MASK        0xFFFFFF
+
+typedef struct
+{
+    NRF_RTC_Type * p_reg;
+    int32_t        irqn;
+    uint32_t       cc_count;
+    bool           running;
+    uint64_t       base_tick;       // LFCLK tick of the last start or clear.
+    uint32_t       base_counter;    // Counter at base_tick.
+    uint32_t       prescaler;       // Prescaler latched at the start.
+    uint32_t       counter;         // Counter at the last update.
+    uint32_t       inten;
+    uint32_t       evten;
+} rtc_t;
+
+static rtc_t m_rtcs[] =
+{
+    { .p_reg = NRF_RTC0, .irqn = RTC0_IRQn, .cc_count = 3 },
+    { .p_reg = NRF_RTC1, .irqn = RTC1_IRQn, .cc_count = 4 },
+#if defined(NRF52)
+    { .p_reg = NRF_RTC2, .irqn = RTC2_IRQn, .cc_count = 4 },
+#endif
+};
+
+
+static uint64_t lfclk_tick(uint64_t us)
+{
+    return (us * LFCLK_HZ) / 1000000;
+}
+
+
+static uint64_t tick_time(uint64_t tick)
+{
+    // First microsecond at which the tick count is reached.
+    return (tick * 1000000 + LFCLK_HZ - 1) / LFCLK_HZ;
+}
+
+
+static uint32_t counter_at(rtc_t const * p_rtc, uint64_t now)
+{
+    if (!p_rtc->running)
+    {
+        return p_rtc->counter;
+    }
+    return (uint32_t)(p_rtc->base_counter
+                      + (lfclk_tick(now) - p_rtc->base_tick) / (p_rtc->prescaler + 1))
+           & COUNTER_MASK;
+}
+
+
+static bool crossed(uint32_t from, uint32_t to, uint32_t value)
+{
+    // True if value is in (from, to], modulo the counter width.
+    uint32_t const span = (to - from) & COUNTER_MASK;
+
+    return (span != 0) && (((value - from - 1) & COUNTER_MASK) < span);
+}
+
+
+static void registers_read(rtc_t * p_rtc, uint64_t now)
+{
+    NRF_RTC_Type * const p_reg = p_rtc->p_reg;
+
+    p_rtc->inten |= p_reg->INTENSET;
+    p_rtc->inten &= ~p_reg->INTENCLR;
+    p_rtc->evten |= p_reg->EVTENSET;
+    p_rtc->evten &= ~p_reg->EVTENCLR;
+    p_reg->INTENSET = p_rtc->inten;
+    p_reg->INTENCLR = 0;
+    p_reg->EVTENSET = p_rtc->evten;
+    p_reg->EVTENCLR = 0;
+    p_reg->EVTEN    = p_rtc->evten;
+
+    if (p_reg->TASKS_STOP)
+    {
+        p_reg->TASKS_STOP = 0;
+        p_rtc->counter    = counter_at(p_rtc, now);
+        p_rtc->running    = false;
+    }
+    if (p_reg->TASKS_CLEAR)
+    {
+        p_reg->TASKS_CLEAR  = 0;
+        p_rtc->base_tick    = lfclk_tick(now);
+        p_rtc->base_counter = 0;
+        p_rtc->counter      = 0;
+    }
+    if (p_reg->TASKS_START)
+    {
+        p_reg->TASKS_START = 0;
+        if (!p_rtc->running)
+        {
+            p_rtc->running      = true;
+            p_rtc->base_tick    = lfclk_tick(now);
+            p_rtc->base_counter = p_rtc->counter;
+            p_rtc->prescaler    = p_reg->PRESCALER & 0xFFF;
+        }
+    }
+    if (p_reg->TASKS_TRIGOVRFLW)
+    {
+        p_reg->TASKS_TRIGOVRFLW = 0;
+        p_rtc->base_tick        = lfclk_tick(now);
+        p_rtc->base_counter     = 0xFFFFF0;
+        p_rtc->counter          = 0xFFFFF0;
+    }
+}
+
+
+void nrf_sim_rtc_init(void)
+{
+    for (uint32_t i = 0; i < sizeof(m_rtcs) / sizeof(m_rtcs[0]); i++)
+    {
+        m_rtcs[i].running = false;
+        m_rtcs[i].counter = 0;
+        m_rtcs[i].inten   = 0;
+        m_rtcs[i].evten   = 0;
+    }
+}
+
+
+void nrf_sim_rtc_update(uint64_t now)
+{
+    for (uint32_t i = 0; i < sizeof(m_rtcs) / sizeof(m_rtcs[0]); i++)
+    {
+        rtc_t * const        p_rtc = &m_rtcs[i];
+        NRF_RTC_Type * const p_reg = p_rtc->p_reg;
+
+        registers_read(p_rtc, now);
+
+        uint32_t const from = p_rtc->counter;
+        uint32_t const to   = counter_at(p_rtc, now);
+
+        for (uint32_t cc = 0; cc < p_rtc->cc_count; cc++)
+        {
+            uint32_t const mask = RTC_EVTEN_COMPARE0_Msk << cc;
+
+            if (((p_rtc->inten | p_rtc->evten) & mask) && crossed(from, to, p_reg->CC[cc]))
+            {
+                p_reg->EVENTS_COMPARE[cc] = 1;
+            }
+        }
+        if (to < from)
+        {
+            p_reg->EVENTS_OVRFLW = 1;
+        }
+        p_rtc->counter = to;
+        *(uint32_t volatile *)&p_reg->COUNTER = to;
+
+        // The interrupt line is the logical OR of the enabled events.
+        uint32_t events = p_reg->EVENTS_OVRFLW ? RTC_INTENSET_OVRFLW_Msk : 0;
+        for (uint32_t cc = 0; cc < p_rtc->cc_count; cc++)
+        {
+            events |= p_reg->EVENTS_COMPARE[cc] ? (RTC_INTENSET_COMPARE0_Msk << cc) : 0;
+        }
+        if ((events & p_rtc->inten) && !nrf_sim_nvic_active_get(p_rtc->irqn))
+        {
+            nrf_sim_nvic_pend(p_rtc->irqn);
+        }
+    }
+}
+
+
+uint64_t nrf_sim_rtc_next_event(uint64_t now)
+{
+    uint64_t next = NRF_SIM_TIME_NEVER;
+
+    for (uint32_t i = 0; i < sizeof(m_rtcs) / sizeof(m_rtcs[0]); i++)
+    {
+        rtc_t const * const p_rtc = &m_rtcs[i];
+        uint32_t            steps = 0;
+
+        if (!p_rtc->running || (p_rtc->inten == 0))
+        {
+            continue;
+        }
+
+        // Number of counter steps to the nearest enabled compare value or overflow.
+        uint32_t const counter = counter_at(p_rtc, now);
+        for (uint32_t cc = 0; cc < p_rtc->cc_count; cc++)
+        {
+            if (p_rtc->inten & (RTC_INTENSET_COMPARE0_Msk << cc))
+            {
+                uint32_t delta = (p_rtc->p_reg->CC[cc] - counter) & COUNTER_MASK;
+
+                delta = (delta == 0) ? (COUNTER_MASK + 1) : delta;
+                steps = ((steps == 0) || (delta < steps)) ? delta : steps;
+            }
+        }
+        if (p_rtc->inten & RTC_INTENSET_OVRFLW_Msk)
+        {
+            uint32_t const delta = (COUNTER_MASK + 1) - counter;
+
+            steps = ((steps == 0) || (delta < steps)) ? delta : steps;
+        }
+        if (steps == 0)
+        {
+            continue;
+        }
+
+        uint64_t const elapsed = (lfclk_tick(now) - p_rtc->base_tick) / (p_rtc->prescaler + 1);
+        uint64_t const tick    = p_rtc->base_tick + (elapsed + steps) * (p_rtc->prescaler + 1);
+        uint64_t const time    = tick_time(tick);
+
+        next = (time < next) ? time : next;
+    }
+
+    return next;
+}
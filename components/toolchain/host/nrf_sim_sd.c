@@ -0,0 +1,212 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nrf.h"
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+#include "nrf_error.h"
+#include "app_util_platform.h"
+#include "nrf_sim.h"
+
+/* SoftDevice model: enabling, the SoC event queue, waiting for events and AES-128 encryption.
+ * The flash functions are in nrf_sim_nvmc.c. The BLE and ANT stacks are not simulated. */
+
+#define SOC_EVT_QUEUE_SIZE      8           // Must be a power of two.
+
+static bool     m_enabled;
+static uint32_t m_soc_evts[SOC_EVT_QUEUE_SIZE];
+static uint32_t m_soc_evt_head;
+static uint32_t m_soc_evt_tail;
+
+static uint8_t const m_aes_sbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+
+static uint8_t aes_xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+
+// AES-128 encryption of one block, as done by the ECB peripheral.
+static void aes128_encrypt(uint8_t const key[16], uint8_t const in[16], uint8_t out[16])
+{
+    uint8_t round_key[16];
+    uint8_t state[16];
+    uint8_t rcon = 0x01;
+
+    memcpy(round_key, key, sizeof(round_key));
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        state[i] = in[i] ^ round_key[i];
+    }
+
+    for (uint32_t round = 1; round <= 10; round++)
+    {
+        uint8_t tmp[16];
+
+        // SubBytes and ShiftRows. The state is stored column by column.
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            tmp[i] = m_aes_sbox[state[(i + 4 * (i % 4)) % 16]];
+        }
+
+        // MixColumns, except in the last round.
+        for (uint32_t c = 0; c < 16; c += 4)
+        {
+            uint8_t const a0 = tmp[c], a1 = tmp[c + 1], a2 = tmp[c + 2], a3 = tmp[c + 3];
+            uint8_t const all = a0 ^ a1 ^ a2 ^ a3;
+
+            if (round == 10)
+            {
+                break;
+            }
+            tmp[c]     = a0 ^ all ^ aes_xtime(a0 ^ a1);
+            tmp[c + 1] = a1 ^ all ^ aes_xtime(a1 ^ a2);
+            tmp[c + 2] = a2 ^ all ^ aes_xtime(a2 ^ a3);
+            tmp[c + 3] = a3 ^ all ^ aes_xtime(a3 ^ a0);
+        }
+
+        // Next round key.
+        round_key[0] ^= m_aes_sbox[round_key[13]] ^ rcon;
+        round_key[1] ^= m_aes_sbox[round_key[14]];
+        round_key[2] ^= m_aes_sbox[round_key[15]];
+        round_key[3] ^= m_aes_sbox[round_key[12]];
+        for (uint32_t i = 4; i < 16; i++)
+        {
+            round_key[i] ^= round_key[i - 4];
+        }
+        rcon = aes_xtime(rcon);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            state[i] = tmp[i] ^ round_key[i];
+        }
+    }
+
+    memcpy(out, state, 16);
+}
+
+
+uint32_t nrf_sim_soc_evt_push(uint32_t evt_id)
+{
+    if ((m_soc_evt_head - m_soc_evt_tail) == SOC_EVT_QUEUE_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    m_soc_evts[m_soc_evt_head++ & (SOC_EVT_QUEUE_SIZE - 1)] = evt_id;
+    if (m_enabled)
+    {
+        nrf_sim_nvic_pend(SD_EVT_IRQn);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_evt_get(uint32_t * p_evt_id)
+{
+    if (m_soc_evt_head == m_soc_evt_tail)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_evt_id = m_soc_evts[m_soc_evt_tail++ & (SOC_EVT_QUEUE_SIZE - 1)];
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_app_evt_wait(void)
+{
+    nrf_sim_wfe();
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_softdevice_enable(nrf_clock_lf_cfg_t const * p_clock_lf_cfg,
+                              nrf_fault_handler_t        fault_handler)
+{
+    (void)p_clock_lf_cfg;
+    (void)fault_handler;
+
+    if (m_enabled)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // The SoftDevice reserves the priorities above APP_IRQ_PRIORITY_HIGH, and sets the priority
+    // of the event interrupt for the application.
+    nrf_sim_nvic_priority_set(SD_EVT_IRQn, APP_IRQ_PRIORITY_LOW);
+    m_enabled = true;
+
+    if (m_soc_evt_head != m_soc_evt_tail)
+    {
+        nrf_sim_nvic_pend(SD_EVT_IRQn);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_softdevice_disable(void)
+{
+    m_enabled = false;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_softdevice_is_enabled(uint8_t * p_softdevice_enabled)
+{
+    *p_softdevice_enabled = m_enabled ? 1 : 0;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_softdevice_vector_table_base_set(uint32_t address)
+{
+    (void)address;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ecb_block_encrypt(nrf_ecb_hal_data_t * p_ecb_data)
+{
+    aes128_encrypt(p_ecb_data->key, p_ecb_data->cleartext, p_ecb_data->ciphertext);
+
+    return NRF_SUCCESS;
+}
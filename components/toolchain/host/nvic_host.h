@@ -0,0 +1,31 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef NVIC_HOST_H__
+#define NVIC_HOST_H__
+
+/* Included by the host core_cm0.h and core_cm4.h after the CMSIS core header. The NVIC
+ * registers are plain memory in the simulation, so the NVIC functions of the CMSIS core header
+ * are replaced by the emulated NVIC. */
+
+#define NVIC_EnableIRQ(irqn)                nrf_sim_nvic_enable((int32_t)(irqn))
+#define NVIC_DisableIRQ(irqn)               nrf_sim_nvic_disable((int32_t)(irqn))
+#define NVIC_GetPendingIRQ(irqn)            ((uint32_t)nrf_sim_nvic_pending_get((int32_t)(irqn)))
+#define NVIC_SetPendingIRQ(irqn)            nrf_sim_nvic_set_pending((int32_t)(irqn))
+#define NVIC_ClearPendingIRQ(irqn)          nrf_sim_nvic_pending_clear((int32_t)(irqn))
+#define NVIC_GetActive(irqn)                ((uint32_t)nrf_sim_nvic_active_get((int32_t)(irqn)))
+#define NVIC_SetPriority(irqn, priority)    nrf_sim_nvic_priority_set((int32_t)(irqn), (priority))
+#define NVIC_GetPriority(irqn)              nrf_sim_nvic_priority_get((int32_t)(irqn))
+#define NVIC_SystemReset()                  nrf_sim_system_reset()
+#define SysTick_Config(ticks)               (1UL)   // SysTick is not simulated.
+
+#endif // NVIC_HOST_H__
@@ -137,6 +137,21 @@ Reset_Handler
         ORRS    R2, R2, R1
         STR     R2, [R0]
 
+#ifdef __STARTUP_FILL_STACK
+        ; Fill the stack with a pattern, so that the stack high-water mark can
+        ; be measured at runtime (see app_ram_usage.h).
+        LDR     R0, =0xDEADBEEF
+        LDR     R1, =sfb(CSTACK)
+        MOV     R2, SP
+        SUBS    R2, R2, R1
+        BLE     Fill_Stack_Done
+Fill_Stack_Loop
+        SUBS    R2, R2, #4
+        STR     R0, [R1, R2]
+        BGT     Fill_Stack_Loop
+Fill_Stack_Done
+#endif
+
         LDR     R0, =SystemInit
         BLX     R0
         LDR     R0, =__iar_program_start
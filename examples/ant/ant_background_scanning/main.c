@@ -35,6 +35,7 @@ All rights reserved.
 #include "ant_stack_config.h"
 #include "ant_channel_config.h"
 #include "ant_search_config.h"
+#include "ant_rx_filter.h"
 #include "app_trace.h"
 #include "app_timer.h"
 #include "softdevice_handler.h"
@@ -69,6 +70,19 @@ static uint8_t m_last_rssi       = 0;
 static uint16_t m_last_device_id = 0;
 static uint8_t m_recieved        = 0;
 
+/**< Channel IDs accepted on the background scanning channel. Add device numbers to only receive
+ *   the messages of known devices. */
+static const ant_rx_filter_id_t m_bs_filter_ids[] =
+{
+    {
+        .device_number     = ANT_RX_FILTER_DEVICE_NUMBER_ANY,
+        .device_type       = ANT_DEVICE_TYPE,
+        .transmission_type = ANT_TRANSMISSION_TYPE,
+    },
+};
+
+static ant_rx_filter_t m_bs_filter;                                     /**< Background scanning channel filter. */
+
 /**< Derive from device serial number. */
 static uint16_t ant_ms_dev_num_get(void)
 {
@@ -101,6 +115,18 @@ void ant_evt_dispatch(ant_evt_t * p_ant_evt)
 }
 
 
+/**@brief Function for filtering ANT stack events before they are dispatched.
+ *
+ * @param[in] p_ant_evt  ANT stack event.
+ *
+ * @return True if the event is to be dispatched.
+ */
+static bool ant_evt_filter(ant_evt_t const * p_ant_evt)
+{
+    return ant_rx_filter_check(&m_bs_filter, p_ant_evt);
+}
+
+
 /**@brief Initialize application.
  */
 static void application_initialize()
@@ -157,6 +183,12 @@ static void application_initialize()
     err_code = ant_search_init(&bs_search_config);
     APP_ERROR_CHECK(err_code);
 
+    err_code = ant_rx_filter_init(&m_bs_filter,
+                                  ANT_BS_CHANNEL_NUMBER,
+                                  m_bs_filter_ids,
+                                  sizeof(m_bs_filter_ids) / sizeof(m_bs_filter_ids[0]));
+    APP_ERROR_CHECK(err_code);
+
     // Fill tx buffer for the first frame
     ant_message_send();
 
@@ -197,6 +229,9 @@ static void softdevice_setup(void)
     err_code = softdevice_ant_evt_handler_set(ant_evt_dispatch);
     APP_ERROR_CHECK(err_code);
 
+    err_code = softdevice_ant_evt_filter_set(ant_evt_filter);
+    APP_ERROR_CHECK(err_code);
+
     err_code = softdevice_handler_init(&clock_lf_cfg, NULL, 0, NULL);
     APP_ERROR_CHECK(err_code);
 
@@ -233,7 +268,12 @@ void background_scanner_process(ant_evt_t * p_ant_evt)
 
             app_trace_log("Message number %d\n\r", m_recieved);
             app_trace_log("Device ID:     %d\n\r", m_last_device_id);
-            app_trace_log("RSSI:          %d\n\r\n\r", m_last_rssi);
+            app_trace_log("RSSI:          %d\n\r", m_last_rssi);
+            app_trace_log("Dropped:       %d\n\r\n\r",
+                          m_bs_filter.stats.dropped_device_number
+                          + m_bs_filter.stats.dropped_device_type
+                          + m_bs_filter.stats.dropped_trans_type
+                          + m_bs_filter.stats.dropped_no_channel_id);
 
             m_recieved++;
             break;
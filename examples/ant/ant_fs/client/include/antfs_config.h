@@ -20,5 +20,6 @@
 #define ANTFS_AUTH_TYPE_PASSKEY       	/**< Use passkey authentication. */
 #define ANTFS_AUTH_TYPE_PASSTHROUGH     /**< Allow host to bypass authentication. */
 #define ANTFS_INCLUDE_UPLOAD            /**< Support upload operation. */
+#define ANTFS_DOWNLOAD_PIPELINED        /**< Read the next download block while the current one is sent. */
 
 #endif //ANTFS_CONFIG_H__
@@ -196,14 +196,19 @@ static void event_download_request_handle(const antfs_event_return_t * p_event)
 static void event_download_data_handle(const antfs_event_return_t * p_event)
 {
     // This example does not interact with a file system, and it does not account for latency for 
-    // reading or writing a file from EEPROM/flash. Prefetching the file might be useful to feed the 
-    // data to download in order to maintain the burst timing.           
+    // reading or writing a file from EEPROM/flash. With ANTFS_DOWNLOAD_PIPELINED, the next block is 
+    // read while the previous one is sent, which helps to maintain the burst timing. Files which are 
+    // memory mapped can instead be downloaded with antfs_download_req_resp_prepare_mapped.
     if (m_file_index == p_event->file_index)     
     {
         // Only send data for a file index matching the download request.
 
-        // Burst data block size * 8 bytes per burst packet.
-        uint8_t buffer[ANTFS_BURST_BLOCK_SIZE * 8]; 
+        // Burst data block size * 8 bytes per burst packet, two blocks as the previous block can 
+        // still be in use by the burst handler.
+        static uint8_t buffers[2][ANTFS_BURST_BLOCK_SIZE * 8]; 
+        static uint8_t buffer_index; 
+        uint8_t      * buffer = buffers[buffer_index]; 
+        buffer_index ^= 1u; 
         // Offset specified by client.        
         const uint32_t offset     = p_event->offset;    
         // Size of requested block of data.        
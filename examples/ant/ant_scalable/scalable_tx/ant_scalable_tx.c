@@ -84,15 +84,11 @@ void ant_scaleable_channel_tx_broadcast_setup(void)
 
     for (i = 0; i < ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED; i++)
     {
-        // Configure channel
+        // Configure channel and schedule its opening, spread over the channel period
         channel_config.channel_number = i;
         channel_config.device_number  = i+1;
 
-        err_code = ant_channel_init(&channel_config);
-        APP_ERROR_CHECK(err_code);
-
-        // Open channel
-        err_code = sd_ant_channel_open(i);
+        err_code = ant_channel_sched_open(&channel_config);
         APP_ERROR_CHECK(err_code);
 
         m_num_open_channels++;
@@ -105,6 +101,8 @@ void ant_scaleable_event_handler(ant_evt_t * p_ant_evt)
 {
     uint32_t err_code;
 
+    ant_channel_sched_evt_handler(p_ant_evt);
+
     switch (p_ant_evt->event)
     {
         // ANT broadcast success.
@@ -16,5 +16,6 @@
 #define ANT_CONFIG_TOTAL_CHANNELS_ALLOCATED 15
 #define ANT_CONFIG_ENCRYPTED_CHANNELS 0
 #define ANT_CONFIG_BURST_QUEUE_SIZE 64
+#define ANT_CONFIG_CHANNEL_SCHED_ENABLED 1
 
 #endif // ANT_STACK_CONFIG_DEFS_H__
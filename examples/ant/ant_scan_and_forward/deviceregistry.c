@@ -18,10 +18,11 @@ All rights reserved.
 
 #include "deviceregistry.h"
 #include "commands.h"
+#include "ant_node_registry.h"
+#include "nordic_common.h"
 
-#define NODE_ID_TO_INDEX_CONVERT(node_id) (node_id % MAX_DEVICES)   /**< Hash function */
-
-static deviceregistry_t device_registry;                            /**< Device resistry of all nodes */
+ANT_NODE_REGISTRY_DEF(m_node_registry, MAX_DEVICES);                /**< Slots of the registered nodes */
+static device_t m_devices[MAX_DEVICES];                             /**< Devices, indexed by the slot of their node */
 
 /** @brief Initializes entries in the device registry to invalid
  *
@@ -38,135 +39,99 @@ static void dr_init_device(device_t * p_device)
 
 void dr_init(void)
 {
-    device_registry.count = 0;
+    ant_node_registry_init(&m_node_registry);
 
     for (int i = 0; i < MAX_DEVICES; i++)
     {
-        dr_init_device(&device_registry.devices[i]);
+        dr_init_device(&m_devices[i]);
     }
 }
 
 
 bool dr_device_add(uint8_t node_id)
 {
-    uint8_t index = MAX_DEVICES;                       // Specifed maximum total number in the array
-    uint8_t start = NODE_ID_TO_INDEX_CONVERT(node_id); // Start index of the array
-
-    uint8_t id;
+    uint16_t index;
 
-    for (int i = 0; i < MAX_DEVICES; i++ )
+    if (node_id == NODE_ID_INVALID)
     {
-        id = device_registry.devices[(start + i) % MAX_DEVICES].node_id;
-
-        if (id == node_id) // If this node already exists, return false.
-        {
-            return false;
-        }
-
-        if (id == NODE_ID_INVALID) // If we found a place to put it
-        {   // Find the best place to put this node (the place closest to the hash function result)
-            index = (start + i) % MAX_DEVICES;
-            break;
-        }
+        return false;
     }
 
-    if (index == MAX_DEVICES)
+    if (ant_node_registry_add(&m_node_registry, node_id, &index) != NRF_SUCCESS)
     {
         return false;
     }
 
-    device_registry.devices[index].node_id = node_id;
-    device_registry.count++;
+    m_devices[index].node_id = node_id;
     return true;
 }
 
 
 bool dr_device_remove(uint8_t node_id)
 {
-    uint8_t index = NODE_ID_TO_INDEX_CONVERT(node_id);
-    uint8_t start = index;
+    uint16_t index = ant_node_registry_find(&m_node_registry, node_id);
 
-    for (int i = 0; i < MAX_DEVICES; i++ )
+    if (index == ANT_NODE_REGISTRY_INDEX_INVALID)
     {
-        if (device_registry.devices[(start + i) % MAX_DEVICES].node_id == node_id)
-        {
-            // Remove the device
-            dr_init_device(&device_registry.devices[index]);
-            device_registry.count--;
-            return true;
-        }
-        else
-            index++;
+        return false;
     }
-    return false;
+
+    UNUSED_RETURN_VALUE(ant_node_registry_remove(&m_node_registry, node_id));
+    dr_init_device(&m_devices[index]);
+    return true;
 }
 
 
 bool dr_is_full(void)
 {
-    return (device_registry.count >= MAX_DEVICES);
+    return (m_node_registry.count >= MAX_DEVICES);
 }
 
 
 device_t * dr_device_get(uint8_t node_id)
 {
-    uint8_t index = NODE_ID_TO_INDEX_CONVERT(node_id);
-    uint8_t start = index;
+    uint16_t index = ant_node_registry_find(&m_node_registry, node_id);
 
-    for (int i = 0; i < MAX_DEVICES; i++ )
+    if (index == ANT_NODE_REGISTRY_INDEX_INVALID)
     {
-        if (device_registry.devices[(start + i) % MAX_DEVICES].node_id == node_id)
-        {
-            return &(device_registry.devices[(start + i) % MAX_DEVICES]);
-        }
-        else
-        {
-            index++;
-        }
+        return NULL; // Doesnt exist
     }
-    return NULL; // Doesnt exist
+
+    return &m_devices[index];
 }
 
 
-device_t * dr_device_at_index_get(uint8_t index)
+device_t * dr_device_at_index_get(uint16_t index)
 {
-    return &(device_registry.devices[index]);
+    return &m_devices[index];
 }
 
 
 bool dr_device_exists(uint8_t node_id)
 {
-    uint8_t start = NODE_ID_TO_INDEX_CONVERT(node_id);
+    return (ant_node_registry_find(&m_node_registry, node_id) != ANT_NODE_REGISTRY_INDEX_INVALID);
+}
 
-    for (int i = 0; i < MAX_DEVICES; i++ )
-    {
-        if (device_registry.devices[(start + i) % MAX_DEVICES].node_id == node_id)
-        {
-            return true;
-        }
-    }
-    return false;
+
+bool dr_device_at_index_exists(uint16_t index)
+{
+    return ant_node_registry_is_used(&m_node_registry, index);
 }
 
 
-bool dr_device_at_index_exists(uint8_t index)
+uint16_t dr_index_of_node_get(uint8_t node_id)
 {
-    return (device_registry.devices[index].node_id != NODE_ID_INVALID ? true : false);
+    uint16_t index = ant_node_registry_find(&m_node_registry, node_id);
+
+    return (index == ANT_NODE_REGISTRY_INDEX_INVALID) ? 0 : index;
 }
 
 
-uint8_t dr_index_of_node_get(uint8_t node_id)
+uint16_t dr_next_index_get(uint16_t index)
 {
-    uint8_t start = NODE_ID_TO_INDEX_CONVERT(node_id);
+    index = ant_node_registry_next(&m_node_registry, index);
 
-    for (int i = 0; i < MAX_DEVICES; i++ )
-    {
-        if (device_registry.devices[(start + i) % MAX_DEVICES].node_id == node_id)
-        {
-            return (start + i) % MAX_DEVICES;
-        }
-    }
-    return 0;
+    return (index == ANT_NODE_REGISTRY_INDEX_INVALID) ? MAX_DEVICES : index;
 }
 
 
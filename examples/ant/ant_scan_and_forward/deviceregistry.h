@@ -25,7 +25,9 @@ All rights reserved.
 #include <stdbool.h>
 
 // Public Definitions
-#define MAX_DEVICES                 ((uint8_t) 16)              /**< Maximum number of devices in that can be registered */
+#ifndef MAX_DEVICES
+#define MAX_DEVICES                 16                          /**< Maximum number of devices in that can be registered. Must be a power of two, up to 256 since node identifiers are 8-bit. */
+#endif
 #define NODE_ID_INVALID             ((uint8_t) 0xFF)            /**< Invalid node identifier */
 #define ANT_CHANNEL_NOT_CONNECTED   ((uint8_t) 0xFF)            /**< Not directly connected to a particular device */
 #define ANT_CHANNEL_SELF            ((uint8_t) 0xFE)            /**< Local node */
@@ -43,13 +45,6 @@ typedef struct
 
 /**@brief Data structure for device list
  */
-typedef struct
-{
-    uint8_t  count;                /**< Total number of registered devices */
-    device_t devices[MAX_DEVICES]; /**< List of registered devices */
-} deviceregistry_t;
-
-
 /** @brief Initializes the device registry
  */
 void dr_init(void);
@@ -88,7 +83,7 @@ device_t * dr_device_get(uint8_t node_id);
  * @param[in] index The id of the node to get
  * @returns Pointer the the device
  */
-device_t * dr_device_at_index_get(uint8_t index);
+device_t * dr_device_at_index_get(uint16_t index);
 
 /** @brief Checks if a device already exists in the device table
  *
@@ -102,7 +97,7 @@ bool dr_device_exists(uint8_t node_id);
  * @param[in] index The index at which to check
  * @returns True if device exists, false otherwise
  */
-bool dr_device_at_index_exists(uint8_t index);
+bool dr_device_at_index_exists(uint16_t index);
 
 /** @brief Gets the device index with specified node id
  *
@@ -111,7 +106,15 @@ bool dr_device_at_index_exists(uint8_t index);
  * @returns The index of the device with node_id.
  * @returns 0 if it doesnt exist
  */
-uint8_t dr_index_of_node_get(uint8_t node_id);
+uint16_t dr_index_of_node_get(uint8_t node_id);
+
+/** @brief Gets the index of the next registered device, wrapping around the end of the registry
+ *
+ * @param[in] index Index to start after
+ *
+ * @return Index of the next registered device, or MAX_DEVICES if the registry is empty
+ */
+uint16_t dr_next_index_get(uint16_t index);
 
 
 #endif
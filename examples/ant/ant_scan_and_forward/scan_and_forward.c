@@ -19,7 +19,7 @@ All rights reserved.
 #include "scan_and_forward.h"
 #include "deviceregistry.h"
 #include "ant_parameters.h"
-#include "message_cache.h"
+#include "ant_message_cache.h"
 #include "commands.h"
 #include "boards.h"
 #include "app_button.h"
@@ -47,12 +47,14 @@ All rights reserved.
 #define ANT_MAX_NODES_IN_NETWORK    MAX_DEVICES         /**< Max number of nodes in network. Must be <= MAX_DEVICES in device registry */
 
 #define ANT_MAX_CACHE_SIZE              255             /**< Max size of the received message buffer */
+#define ANT_CACHE_HASH_SIZE             256             /**< Number of hash chains of the received message buffer. Must be a power of two */
 #define ANT_CACHE_TIMEOUT_IN_SEC        10              /**< Max duration cached messages will be saved */
+#define ANT_CACHE_IGNORE_MASK           0x0C            /**< Payload bytes 2 and 3 are reserved and not compared */
 
 #define ANT_DEFAULT_CMD_PG_INTLV_PCT    30              /**< Default percentage internal command pages should be transmitted */
 
 static uint8_t m_node_address;                                          /**< Unique address of node within the network */
-static uint8_t m_counter = 0;                                           /**< Index of next device */
+static uint16_t m_counter = 0;                                          /**< Index of next device */
 static uint8_t m_tx_buffer[ANT_STANDARD_DATA_PAYLOAD_SIZE];             /**< Primary data transmit buffer. */
 static uint8_t m_cmd_tx_buffer[ANT_STANDARD_DATA_PAYLOAD_SIZE];         /**< Command data transmit buffer. */
 static uint8_t m_tx_page_counter        = 0;                            /**< Transmitted page counter. */
@@ -61,15 +63,12 @@ static uint8_t m_cmd_pg_intlv_pct       = ANT_DEFAULT_CMD_PG_INTLV_PCT; /**< Per
 static bool    m_flag_hi_pri_cmd        = false;                        /**< Flag to indicate this is a new command. */
 
 static bool             enable_optimized_command_page_priority = true;  /**< Flag to enable/disable command page pattern optimizations */
-static sf_message_t     buffer[ANT_MAX_CACHE_SIZE];                     /**< Received message cache buffer. */
-static message_cache_t  m_rcvd_messages =                               /**< Received message cache. */
-{
-    0,
-    0,
-    0,
-    ANT_MAX_CACHE_SIZE,
-    buffer
-};
+
+ANT_MESSAGE_CACHE_DEF(m_rcvd_messages,                                  /**< Received message cache. */
+                      ANT_MAX_CACHE_SIZE,
+                      ANT_CACHE_HASH_SIZE,
+                      ANT_CACHE_TIMEOUT_IN_SEC,
+                      ANT_CACHE_IGNORE_MASK);
 
 
 /**@brief DEVICE_STATUS_PAGE message is queued to send.
@@ -152,6 +151,7 @@ static void sf_ant_channels_setup(void)
 void sf_init(void)
 {
     dr_init();
+    ant_message_cache_init(&m_rcvd_messages);
 
     // Get the node address from the switches instead of serial number
 #if defined(NODE_ID_FROM_SWITCHES)
@@ -258,7 +258,7 @@ void sf_background_scanner_process(ant_evt_t * p_ant_evt)
                         p_device = dr_device_get(node);
                         p_device->last_message_sequence_received = sequence_number;
                         p_device->application_state              = device_state;
-                        m_tx_page_counter                        = dr_index_of_node_get(node) - 1; // Small optimization to send the new device info first
+                        m_tx_page_counter                        = (uint8_t)(dr_index_of_node_get(node) - 1); // Small optimization to send the new device info first
                     }
                 }
                 // First message received from this device.
@@ -350,18 +350,7 @@ static void sf_master_beacon_message_send(void)
         m_flag_hi_pri_cmd = false;
 
         // Cycle through available device numbers until we get to a registered device.
-        do
-        {
-            if (m_counter < (MAX_DEVICES - 1))
-            {
-                m_counter++;
-            }
-            else
-            {
-                m_counter = 0;
-            }
-        }
-        while (!dr_device_at_index_exists(m_counter));
+        m_counter = dr_next_index_get(m_counter);
 
         p_device = dr_device_at_index_get(m_counter);
 
@@ -376,7 +365,7 @@ static void sf_master_beacon_message_send(void)
         m_tx_buffer[DEVICE_STATUS_STATE_IND] = p_device->application_state;
 
         // Add the message we are transmitting to the cache
-        mc_add(&m_rcvd_messages, m_tx_buffer);
+        ant_message_cache_add(&m_rcvd_messages, m_tx_buffer);
 
         err_code = sd_ant_broadcast_message_tx(SF_ANT_MS_CHANNEL_NUMBER,
                                                ANT_STANDARD_DATA_PAYLOAD_SIZE,
@@ -387,7 +376,7 @@ static void sf_master_beacon_message_send(void)
     else
     {
         // Add the message we are transmitting to the cache
-        mc_add(&m_rcvd_messages, m_cmd_tx_buffer);
+        ant_message_cache_add(&m_rcvd_messages, m_cmd_tx_buffer);
 
         err_code = sd_ant_broadcast_message_tx(SF_ANT_MS_CHANNEL_NUMBER,
                                                ANT_STANDARD_DATA_PAYLOAD_SIZE,
@@ -402,7 +391,7 @@ static void sf_master_beacon_message_send(void)
     // Piggy back off of the channel period to provide 1 second ticks for cache cleanup
     if (m_cache_tick_tx_counter % msg_tx_freq == 0)
     {
-        mc_cleanup(&m_rcvd_messages, ANT_CACHE_TIMEOUT_IN_SEC);
+        ant_message_cache_tick(&m_rcvd_messages);
     }
 }
 
@@ -433,13 +422,13 @@ void sf_master_beacon_process(ant_evt_t * p_ant_evt)
 
 static bool msg_already_received(uint8_t * p_buffer)
 {
-    if (mc_is_in_cache(&m_rcvd_messages, p_buffer))
+    if (ant_message_cache_find(&m_rcvd_messages, p_buffer))
     {
         return true;
     }
 
     // New message, store for future comparisons
-    mc_add(&m_rcvd_messages, p_buffer);
+    ant_message_cache_add(&m_rcvd_messages, p_buffer);
 
     return false;
 }
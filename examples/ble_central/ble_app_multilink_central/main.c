@@ -33,6 +33,8 @@
 #include "ble_db_discovery.h"
 #include "ble_lbs_c.h"
 #include "ble_conn_state.h"
+#include "ble_conn_sched.h"
+#include "ble_scan_filter.h"
 #include "nrf_log.h"
 
 #define CENTRAL_LINK_COUNT        8                                          /**< Number of central links used by the application. When changing this number remember to adjust the RAM settings*/
@@ -44,7 +46,7 @@
 #define CENTRAL_CONNECTED_LED     BSP_LED_1_MASK
 
 #define APP_TIMER_PRESCALER       0                                          /**< Value of the RTC1 PRESCALER register. */
-#define APP_TIMER_MAX_TIMERS      (2+BSP_APP_TIMERS_NUMBER)                  /**< Maximum number of timers used by the application. */
+#define APP_TIMER_MAX_TIMERS      (3+BSP_APP_TIMERS_NUMBER)                  /**< Maximum number of timers used by the application. */
 #define APP_TIMER_OP_QUEUE_SIZE   2                                          /**< Size of timer operation queues. */
 
 #define SCAN_INTERVAL             0x00A0                                     /**< Determines scan interval in units of 0.625 millisecond. */
@@ -53,11 +55,14 @@
 #define SCAN_REQUEST              0                                          /**< Active scannin is not set. */
 #define SCAN_WHITELIST_ONLY       0                                          /**< We will not ignore unknown devices. */
                                                                              
-#define MIN_CONNECTION_INTERVAL   MSEC_TO_UNITS(7.5, UNIT_1_25_MS)           /**< Determines minimum connection interval in milliseconds. */
-#define MAX_CONNECTION_INTERVAL   MSEC_TO_UNITS(30, UNIT_1_25_MS)            /**< Determines maximum connection interval in milliseconds. */
+#define MAX_CONNECTION_INTERVAL   MSEC_TO_UNITS(30, UNIT_1_25_MS)            /**< Determines maximum connection interval in milliseconds. The links are packed in the shortest interval that fits them. */
 #define SLAVE_LATENCY             0                                          /**< Determines slave latency in terms of connection events. */
 #define SUPERVISION_TIMEOUT       MSEC_TO_UNITS(4000, UNIT_10_MS)            /**< Determines supervision time-out in units of 10 milliseconds. */
 
+#define THROUGHPUT_REPORT_INTERVAL APP_TIMER_TICKS(5000, APP_TIMER_PRESCALER) /**< Interval between two throughput reports (in number of timer ticks). */
+
+#define SCAN_DEDUP_TIMEOUT        APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER) /**< Time the reports of a device are ignored after a connection request to it (in number of timer ticks). */
+
 #define UUID16_SIZE               2                                          /**< Size of a UUID, in bytes. */
 
 #define LEDBUTTON_LED             BSP_LED_2_MASK                             /**< LED to indicate a change of state of the the Button characteristic on the peer. */
@@ -79,18 +84,12 @@ static const ble_gap_scan_params_t m_scan_param =
     SCAN_TIMEOUT
 };
 
-/**@brief Connection parameters requested for connection. */
-static const ble_gap_conn_params_t m_connection_param =
-{
-    (uint16_t)MIN_CONNECTION_INTERVAL,
-    (uint16_t)MAX_CONNECTION_INTERVAL,
-    (uint16_t)SLAVE_LATENCY,
-    (uint16_t)SUPERVISION_TIMEOUT
-};
+APP_TIMER_DEF(m_throughput_timer_id);                              /**< Throughput report timer. */
 
 static ble_lbs_c_t        m_ble_lbs_c[TOTAL_LINK_COUNT];           /**< Main structures used by the LED Button client module. */
 static uint8_t            m_ble_lbs_c_count;                       /**< Keeps track of how many instances of LED Button client module have been initialized. >*/
 static ble_db_discovery_t m_ble_db_discovery[TOTAL_LINK_COUNT];    /**< list of DB structures used by the database discovery module. */
+static ble_scan_filter_t  m_scan_filter;                           /**< Filter of the advertising reports. */
 
 /**@brief Function to handle asserts in the SoftDevice.
  *
@@ -120,42 +119,6 @@ static void leds_init(void)
 }
 
 
-/**
- * @brief Parses advertisement data, providing length and location of the field in case
- *        matching data is found.
- *
- * @param[in]  type       Type of data to be looked for in advertisement data.
- * @param[in]  p_advdata  Advertisement report length and pointer to report.
- * @param[out] p_typedata If data type requested is found in the data report, type data length and
- *                        pointer to data will be populated here.
- *
- * @retval NRF_SUCCESS if the data type is found in the report.
- * @retval NRF_ERROR_NOT_FOUND if the data type could not be found.
- */
-static uint32_t adv_report_parse(uint8_t type, uint8_array_t * p_advdata, uint8_array_t * p_typedata)
-{
-    uint32_t  index = 0;
-    uint8_t * p_data;
-
-    p_data = p_advdata->p_data;
-
-    while (index < p_advdata->size)
-    {
-        uint8_t field_length = p_data[index];
-        uint8_t field_type   = p_data[index + 1];
-
-        if (field_type == type)
-        {
-            p_typedata->p_data = &p_data[index + 2];
-            p_typedata->size   = field_length - 1;
-            return NRF_SUCCESS;
-        }
-        index += field_length + 1;
-    }
-    return NRF_ERROR_NOT_FOUND;
-}
-
-
 /**@brief Function to start scanning.
  */
 static void scan_start(void)
@@ -228,62 +191,23 @@ static void lbs_c_evt_handler(ble_lbs_c_t * p_lbs_c, ble_lbs_c_evt_t * p_lbs_c_e
  */
 static void on_adv_report(const ble_evt_t * const p_ble_evt)
 {
-    uint32_t      err_code;
-    uint8_array_t adv_data;
-    uint8_array_t dev_name;
-    bool          do_connect = false;
+    uint32_t err_code;
 
     // For readibility.
-    const ble_gap_evt_t * const p_gap_evt    = &p_ble_evt->evt.gap_evt;
-    const ble_gap_addr_t  * const peer_addr  = &p_gap_evt->params.adv_report.peer_addr;
-
-    // Initialize advertisement report for parsing
-    adv_data.p_data = (uint8_t *)p_gap_evt->params.adv_report.data;
-    adv_data.size   = p_gap_evt->params.adv_report.dlen;
-
+    const ble_gap_evt_t * const p_gap_evt = &p_ble_evt->evt.gap_evt;
 
-    //search for advertising names
-    bool found_name = false;
-    err_code = adv_report_parse(BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME,
-                                &adv_data,
-                                &dev_name);
-    if (err_code != NRF_SUCCESS)
+    // Most reports are from other devices, and are rejected without parsing their data.
+    if (!ble_scan_filter_match(&m_scan_filter, &p_gap_evt->params.adv_report))
     {
-        // Look for the short local name if it was not found as complete
-        err_code = adv_report_parse(BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME, &adv_data, &dev_name);
-        if (err_code != NRF_SUCCESS)
-        {
-            // If we can't parse the data, then exit
-            return;
-        }
-        else
-        {
-            found_name = true;
-        }
-    }
-    else
-    {
-        found_name = true;
-    }
-    if (found_name)
-    {
-        if (strlen(m_target_periph_name) != 0)
-        {
-            if(memcmp(m_target_periph_name, dev_name.p_data, dev_name.size) == 0)
-            {
-                do_connect = true;
-            }
-        }
+        return;
     }
 
-    if (do_connect)
+    // Initiate connection. Connections are established one at a time, the device is reported
+    // again after the dedup timeout if another connection is being established.
+    err_code = ble_conn_sched_connect(&p_gap_evt->params.adv_report.peer_addr, &m_scan_param);
+    if ((err_code != NRF_SUCCESS) && (err_code != NRF_ERROR_BUSY))
     {
-        // Initiate connection.
-        err_code = sd_ble_gap_connect(peer_addr, &m_scan_param, &m_connection_param);
-        if (err_code != NRF_SUCCESS)
-        {
-            APPL_LOG("[APPL]: Connection Request Failed, reason %d\r\n", err_code);
-        }
+        APPL_LOG("[APPL]: Connection Request Failed, reason %d\r\n", err_code);
     }
 }
 
@@ -381,15 +305,6 @@ static void on_ble_evt(const ble_evt_t * const p_ble_evt)
             }
         } break; // BLE_GAP_EVT_TIMEOUT
 
-        case BLE_GAP_EVT_CONN_PARAM_UPDATE_REQUEST:
-        {
-            // Accept parameters requested by peer.
-            ret_code_t err_code;
-            err_code = sd_ble_gap_conn_param_update(p_gap_evt->conn_handle,
-                                        &p_gap_evt->params.conn_param_update_request.conn_params);
-            APP_ERROR_CHECK(err_code);
-        } break; // BLE_GAP_EVT_CONN_PARAM_UPDATE_REQUEST
-
         default:
             // No implementation needed.
             break;
@@ -410,6 +325,7 @@ static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
     conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
 
     ble_conn_state_on_ble_evt(p_ble_evt);
+    ble_conn_sched_on_ble_evt(p_ble_evt);
     on_ble_evt(p_ble_evt);
 
     // Make sure taht an invalid connection handle are not passed since
@@ -463,6 +379,17 @@ static void ble_stack_init(void)
     // specific UUID is already in the table thus to be able to call sd_ble_uuid_vs_add several
     // times with the same entry, vs_uuid_count has to be 1 bigger than what is actually needed.
     ble_enable_params.common_enable_params.vs_uuid_count = 2;
+
+    // Pack the central links: pick their bandwidth and connection interval.
+    ble_conn_sched_init_t conn_sched_init;
+
+    conn_sched_init.link_count        = CENTRAL_LINK_COUNT;
+    conn_sched_init.max_conn_interval = MAX_CONNECTION_INTERVAL;
+    conn_sched_init.slave_latency     = SLAVE_LATENCY;
+    conn_sched_init.conn_sup_timeout  = SUPERVISION_TIMEOUT;
+
+    err_code = ble_conn_sched_init(&conn_sched_init, &ble_enable_params);
+    APP_ERROR_CHECK(err_code);
     
     // Check the ram settings against the used number of links
     CHECK_RAM_START_ADDR(CENTRAL_LINK_COUNT,PERIPHERAL_LINK_COUNT);
@@ -471,6 +398,9 @@ static void ble_stack_init(void)
     err_code = softdevice_enable(&ble_enable_params);
     APP_ERROR_CHECK(err_code);
 
+    err_code = ble_conn_sched_bw_set();
+    APP_ERROR_CHECK(err_code);
+
     // Register with the SoftDevice handler module for BLE events.
     err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
     APP_ERROR_CHECK(err_code);
@@ -566,6 +496,81 @@ static void db_disc_handler(ble_db_discovery_evt_t * p_evt)
 }
 
 
+/**@brief Function for logging the notification throughput of each link.
+ *
+ * @param[in] p_context  Unused.
+ */
+static void throughput_report_handler(void * p_context)
+{
+    uint32_t total_bps = 0;
+
+    UNUSED_PARAMETER(p_context);
+
+    for (uint16_t conn_handle = 0; conn_handle < CENTRAL_LINK_COUNT; conn_handle++)
+    {
+        ble_conn_sched_stats_t stats;
+        uint32_t               ms;
+        uint32_t               bps;
+
+        if ((ble_conn_state_status(conn_handle) != BLE_CONN_STATUS_CONNECTED)
+            || (ble_conn_sched_stats_get(conn_handle, &stats, true) != NRF_SUCCESS))
+        {
+            continue;
+        }
+
+        ms = (stats.ticks * 1000) / (APP_TIMER_CLOCK_FREQ / (APP_TIMER_PRESCALER + 1));
+        if (ms == 0)
+        {
+            continue;
+        }
+        bps        = (stats.rx_bytes * 8 * 1000) / ms;
+        total_bps += bps;
+
+        NRF_LOG_PRINTF("[APP]: link 0x%x: %d notifications, %d bps\r\n",
+                       conn_handle,
+                       stats.rx_count,
+                       bps);
+    }
+    NRF_LOG_PRINTF("[APP]: total: %d bps\r\n", total_bps);
+}
+
+
+/**@brief Function for starting the throughput report timer.
+ */
+static void throughput_report_init(void)
+{
+    ret_code_t err_code;
+
+    err_code = app_timer_create(&m_throughput_timer_id,
+                                APP_TIMER_MODE_REPEATED,
+                                throughput_report_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_throughput_timer_id, THROUGHPUT_REPORT_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for initializing the filter of the advertising reports.
+ *
+ * @details Only the devices with the target name are reported, once per dedup timeout, so a
+ *          device is not sent a new connection request while one is pending.
+ */
+static void scan_filter_init(void)
+{
+    ret_code_t             err_code;
+    ble_scan_filter_init_t init;
+
+    memset(&init, 0, sizeof(init));
+    init.rssi_min      = BLE_SCAN_FILTER_RSSI_ANY;
+    init.p_name_prefix = m_target_periph_name;
+    init.dedup_timeout = SCAN_DEDUP_TIMEOUT;
+
+    err_code = ble_scan_filter_init(&m_scan_filter, &init);
+    APP_ERROR_CHECK(err_code);
+}
+
+
 /** @brief Database discovery initialization.
  */
 static void db_discovery_init(void)
@@ -599,6 +604,8 @@ int main(void)
 
     db_discovery_init();
     lbs_c_init();
+    scan_filter_init();
+    throughput_report_init();
 
     // Start scanning for peripherals and initiate connection to devices which
     // advertise.
@@ -0,0 +1,609 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_app_dfu_gateway_main main.c
+ * @{
+ * @ingroup ble_sdk_app_dfu_gateway
+ * @brief DFU gateway application main file.
+ *
+ * This application updates the firmware of up to @ref CENTRAL_LINK_COUNT peripherals at the same
+ * time. It scans for devices in DFU mode, that is running the BLE bootloader and advertising the
+ * DFU Service, connects to them and sends the same image to all of them with the
+ * @ref ble_sdk_srv_dfu_c module. Scanning goes on while updates are in progress, until all links
+ * are in use.
+ *
+ * The image is read from the flash of the gateway at @ref IMAGE_ADDRESS, where it must have been
+ * programmed beforehand with a @ref gateway_image_header_t, followed by the init packet and then by
+ * the firmware, that is the .bin files of the SoftDevice, the bootloader and the application, in
+ * this order. To read the image from another source, such as an external flash, replace
+ * image_read().
+ *
+ * Every second, a line is printed over RTT for each update in progress, with the acknowledged
+ * bytes, the throughput since the start of the update, and how often the link ran out of TX
+ * buffers or waited for a Packet Receipt Notification. A target whose progress stops for
+ * @ref PROGRESS_TIMEOUT_S seconds is disconnected, and updated again when it is found by the scan.
+ * Every line starts with "DFU" so that a test script can collect them.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_hci.h"
+#include "ble_db_discovery.h"
+#include "ble_dfu_c.h"
+#include "softdevice_handler.h"
+#include "boards.h"
+#include "nrf_log.h"
+
+#define CENTRAL_LINK_COUNT          8                                   /**< Number of central links used by the application, and of peripherals updated at the same time. When changing this number remember to adjust the RAM settings*/
+#define PERIPHERAL_LINK_COUNT       0                                   /**< Number of peripheral links used by the application. When changing this number remember to adjust the RAM settings*/
+
+#define APP_TIMER_PRESCALER         0                                   /**< Value of the RTC1 PRESCALER register. */
+#define APP_TIMER_OP_QUEUE_SIZE     2                                   /**< Size of timer operation queues. */
+#define APP_TIMER_FREQ              32768                               /**< Frequency of the RTC1 counter, in Hz. */
+
+#define SCAN_INTERVAL               0x00A0                              /**< Determines scan interval in units of 0.625 millisecond. */
+#define SCAN_WINDOW                 0x0050                              /**< Determines scan window in units of 0.625 millisecond. */
+
+#define MIN_CONNECTION_INTERVAL     MSEC_TO_UNITS(7.5, UNIT_1_25_MS)    /**< Determines minimum connection interval in milliseconds. */
+#define MAX_CONNECTION_INTERVAL     MSEC_TO_UNITS(30, UNIT_1_25_MS)     /**< Determines maximum connection interval in milliseconds. */
+#define SLAVE_LATENCY               0                                   /**< Determines slave latency in terms of connection events. */
+#define SUPERVISION_TIMEOUT         MSEC_TO_UNITS(4000, UNIT_10_MS)     /**< Determines supervision time-out in units of 10 millisecond. */
+
+#define UUID128_SIZE                16                                  /**< Size of 128 bit UUID */
+
+#define DFU_PRN                     10                                  /**< Packets per Packet Receipt Notification. */
+#define DFU_PRN_WINDOW              4                                   /**< Packet Receipt Notification intervals in flight. The bootloader buffers 4 kB of firmware data. */
+
+#define IMAGE_ADDRESS               0x30000                             /**< Address of the image in flash, after the application. */
+#define IMAGE_MAX_SIZE              0x10000                             /**< Size of the flash region of the image. */
+#define IMAGE_MAGIC                 0x47554644                          /**< Value of @ref gateway_image_header_t::magic, "DFUG". */
+
+#define REPORT_INTERVAL             APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)  /**< Interval at which the progress of the updates is printed. */
+#define PROGRESS_TIMEOUT_S          10                                  /**< Seconds without progress after which a target is disconnected. */
+
+/**@brief Header of the image in flash. */
+typedef struct
+{
+    uint32_t magic;                         /**< @ref IMAGE_MAGIC. */
+    uint8_t  update_mode;                   /**< Content of the image, see @ref BLE_DFU_C_UPDATE_APP. */
+    uint8_t  reserved;
+    uint16_t init_data_len;                 /**< Length of the init packet, which follows the header. */
+    uint32_t sd_size;                       /**< Size of the SoftDevice. */
+    uint32_t bl_size;                       /**< Size of the bootloader. */
+    uint32_t app_size;                      /**< Size of the application. */
+} gateway_image_header_t;
+
+/**@brief Update of a target, indexed by connection handle. */
+typedef struct
+{
+    bool     connected;                     /**< A target is connected on this link. */
+    uint32_t start_ticks;                   /**< RTC1 counter value at the start of the update. */
+    uint32_t elapsed_ticks;                 /**< RTC1 ticks since the start of the update. */
+    uint32_t last_acked;                    /**< Acknowledged bytes at the previous report. */
+    uint32_t idle_s;                        /**< Seconds without progress. */
+} gateway_target_t;
+
+/**
+ * @brief Parameters used when scanning.
+ */
+static const ble_gap_scan_params_t m_scan_params =
+  {
+    .active      = 0,
+    .selective   = 0,
+    .p_whitelist = NULL,
+    .interval    = SCAN_INTERVAL,
+    .window      = SCAN_WINDOW,
+    .timeout     = 0
+  };
+
+/**@brief Connection parameters requested for connection. */
+static const ble_gap_conn_params_t m_connection_param =
+  {
+    .min_conn_interval = (uint16_t)MIN_CONNECTION_INTERVAL,
+    .max_conn_interval = (uint16_t)MAX_CONNECTION_INTERVAL,
+    .slave_latency     = SLAVE_LATENCY,
+    .conn_sup_timeout  = (uint16_t)SUPERVISION_TIMEOUT
+  };
+
+APP_TIMER_DEF(m_report_timer_id);                                       /**< Progress report timer. */
+
+static ble_dfu_c_t        m_ble_dfu_c[CENTRAL_LINK_COUNT];              /**< DFU Client instances, indexed by connection handle. */
+static ble_db_discovery_t m_ble_db_discovery[CENTRAL_LINK_COUNT];       /**< Database discovery instances, indexed by connection handle. */
+static gateway_target_t   m_targets[CENTRAL_LINK_COUNT];                /**< Updates, indexed by connection handle. */
+static ble_dfu_c_image_t  m_image;                                      /**< Image sent to all targets. */
+static uint32_t           m_firmware_address;                           /**< Address of the firmware data in flash. */
+static uint32_t           m_link_count;                                 /**< Number of connected targets. */
+static bool               m_connecting;                                 /**< A connection is being established. */
+static bool               m_scanning;                                   /**< Scanning for targets. */
+static uint32_t           m_updated_count;                              /**< Number of targets updated. */
+
+
+/**@brief Function for asserts in the SoftDevice.
+ *
+ * @param[in] line_num     Line number of the failing ASSERT call.
+ * @param[in] p_file_name  File name of the failing ASSERT call.
+ */
+void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
+{
+    app_error_handler(0xDEADBEEF, line_num, p_file_name);
+}
+
+
+/**@brief Function for reading firmware data from the image in flash.
+ *
+ * @details All targets read the same image, each at its own offset.
+ */
+static uint32_t image_read(uint32_t offset, uint8_t * p_data, uint16_t length)
+{
+    memcpy(p_data, (uint8_t const *)(m_firmware_address + offset), length);
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for checking the image header and setting up the image descriptor.
+ *
+ * @retval true  If a valid image was found at @ref IMAGE_ADDRESS.
+ */
+static bool image_init(void)
+{
+    gateway_image_header_t const * p_header = (gateway_image_header_t const *)IMAGE_ADDRESS;
+    uint32_t                       size;
+
+    if (p_header->magic != IMAGE_MAGIC)
+    {
+        return false;
+    }
+
+    size = sizeof(gateway_image_header_t) + p_header->init_data_len
+         + p_header->sd_size + p_header->bl_size + p_header->app_size;
+    if (size > IMAGE_MAX_SIZE)
+    {
+        return false;
+    }
+
+    m_image.update_mode   = p_header->update_mode;
+    m_image.sd_size       = p_header->sd_size;
+    m_image.bl_size       = p_header->bl_size;
+    m_image.app_size      = p_header->app_size;
+    m_image.p_init_data   = (uint8_t const *)(IMAGE_ADDRESS + sizeof(gateway_image_header_t));
+    m_image.init_data_len = p_header->init_data_len;
+    m_image.read          = image_read;
+
+    m_firmware_address = IMAGE_ADDRESS + sizeof(gateway_image_header_t) + p_header->init_data_len;
+
+    return true;
+}
+
+
+/**@brief Function for scanning for targets, if a link is available. */
+static void scan_start(void)
+{
+    uint32_t err_code;
+
+    if (m_scanning || m_connecting || (m_link_count >= CENTRAL_LINK_COUNT))
+    {
+        return;
+    }
+
+    err_code = sd_ble_gap_scan_start(&m_scan_params);
+    APP_ERROR_CHECK(err_code);
+
+    m_scanning = true;
+}
+
+
+/**@brief Function for getting the time since the start of an update, in milliseconds. */
+static uint32_t target_elapsed_ms(gateway_target_t const * p_target)
+{
+    return (uint32_t)(((uint64_t)p_target->elapsed_ticks * 1000) / APP_TIMER_FREQ);
+}
+
+
+/**@brief Function for printing the progress of an update. */
+static void target_print(uint16_t conn_handle, char const * p_status)
+{
+    ble_dfu_c_stats_t stats;
+    uint32_t          ms = MAX(target_elapsed_ms(&m_targets[conn_handle]), 1);
+
+    ble_dfu_c_stats_get(&m_ble_dfu_c[conn_handle], &stats);
+
+    NRF_LOG_PRINTF("DFU target=%u status=%s bytes=%u/%u percent=%u ms=%u kbps=%u stalls=%u windows=%u\r\n",
+                   conn_handle, p_status, stats.bytes_acked, stats.bytes_total,
+                   (stats.bytes_total != 0) ? (stats.bytes_acked * 100) / stats.bytes_total : 0,
+                   ms, (uint32_t)(((uint64_t)stats.bytes_acked * 8) / ms),
+                   stats.stall_count, stats.window_count);
+}
+
+
+/**@brief Function for printing the progress of the updates, and disconnecting the targets which
+ *        have stopped making progress.
+ */
+static void report_timer_handler(void * p_context)
+{
+    uint32_t err_code;
+    uint32_t now;
+
+    UNUSED_PARAMETER(p_context);
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&now));
+
+    for (uint16_t conn_handle = 0; conn_handle < CENTRAL_LINK_COUNT; conn_handle++)
+    {
+        gateway_target_t * p_target = &m_targets[conn_handle];
+        ble_dfu_c_stats_t  stats;
+
+        if (!p_target->connected || (m_ble_dfu_c[conn_handle].state == BLE_DFU_C_STATE_COMPLETE))
+        {
+            continue;
+        }
+
+        UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(now, p_target->start_ticks, &p_target->elapsed_ticks));
+        target_print(conn_handle, "progress");
+
+        ble_dfu_c_stats_get(&m_ble_dfu_c[conn_handle], &stats);
+        if (stats.bytes_acked != p_target->last_acked)
+        {
+            p_target->last_acked = stats.bytes_acked;
+            p_target->idle_s     = 0;
+        }
+        else if (++p_target->idle_s >= PROGRESS_TIMEOUT_S)
+        {
+            NRF_LOG_PRINTF("DFU target=%u status=timeout state=%u\r\n",
+                           conn_handle, m_ble_dfu_c[conn_handle].state);
+            p_target->idle_s = 0;
+            err_code = sd_ble_gap_disconnect(conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+            if (err_code != NRF_ERROR_INVALID_STATE)
+            {
+                APP_ERROR_CHECK(err_code);
+            }
+        }
+    }
+}
+
+
+/**@brief Function for handling database discovery events.
+ *
+ * @param[in] p_event  Pointer to the database discovery event.
+ */
+static void db_disc_handler(ble_db_discovery_evt_t * p_evt)
+{
+    if (p_evt->conn_handle < CENTRAL_LINK_COUNT)
+    {
+        ble_dfu_c_on_db_disc_evt(&m_ble_dfu_c[p_evt->conn_handle], p_evt);
+    }
+}
+
+
+/**@brief Callback handling DFU Client events.
+ *
+ * @param[in] p_ble_dfu_c DFU Client instance.
+ * @param[in] p_evt       Pointer to the DFU Client event.
+ */
+static void ble_dfu_c_evt_handler(ble_dfu_c_t * p_ble_dfu_c, ble_dfu_c_evt_t const * p_evt)
+{
+    uint32_t err_code;
+
+    switch (p_evt->evt_type)
+    {
+        case BLE_DFU_C_EVT_DISCOVERY_COMPLETE:
+            err_code = ble_dfu_c_handles_assign(p_ble_dfu_c, p_evt->conn_handle, &p_evt->handles);
+            APP_ERROR_CHECK(err_code);
+
+            UNUSED_RETURN_VALUE(app_timer_cnt_get(&m_targets[p_evt->conn_handle].start_ticks));
+
+            err_code = ble_dfu_c_start(p_ble_dfu_c, &m_image);
+            if (err_code != NRF_SUCCESS)
+            {
+                NRF_LOG_PRINTF("DFU target=%u status=error start err_code=0x%x\r\n",
+                               p_evt->conn_handle, err_code);
+                UNUSED_RETURN_VALUE(sd_ble_gap_disconnect(p_evt->conn_handle,
+                                                          BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION));
+            }
+            break;
+
+        case BLE_DFU_C_EVT_PROGRESS:
+            // Printed by the report timer.
+            break;
+
+        case BLE_DFU_C_EVT_COMPLETE:
+        {
+            uint32_t now;
+
+            UNUSED_RETURN_VALUE(app_timer_cnt_get(&now));
+            UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(now,
+                                                           m_targets[p_evt->conn_handle].start_ticks,
+                                                           &m_targets[p_evt->conn_handle].elapsed_ticks));
+            m_updated_count++;
+            target_print(p_evt->conn_handle, "complete");
+            NRF_LOG_PRINTF("DFU updated=%u\r\n", m_updated_count);
+            break;
+        }
+
+        case BLE_DFU_C_EVT_ERROR:
+            NRF_LOG_PRINTF("DFU target=%u status=error state=%u error=0x%x\r\n",
+                           p_evt->conn_handle, p_evt->state, p_evt->error);
+            UNUSED_RETURN_VALUE(sd_ble_gap_disconnect(p_evt->conn_handle,
+                                                      BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION));
+            break;
+
+        case BLE_DFU_C_EVT_DISCONNECTED:
+            // Handled in on_ble_evt.
+            break;
+    }
+}
+
+
+/**@brief Reads an advertising report and checks if a 128-bit UUID is present in the service
+ *        list.
+ *
+ * @param[in]   p_target_uuid The uuid to search for.
+ * @param[in]   p_adv_report  Pointer to the advertisement report.
+ *
+ * @retval      true if the UUID is present in the advertisement report. Otherwise false
+ */
+static bool is_uuid_present(const ble_uuid_t *p_target_uuid,
+                            const ble_gap_evt_adv_report_t *p_adv_report)
+{
+    uint32_t   err_code;
+    uint32_t   index  = 0;
+    uint8_t  * p_data = (uint8_t *)p_adv_report->data;
+    ble_uuid_t extracted_uuid;
+
+    while (index + 1 < p_adv_report->dlen)
+    {
+        uint8_t field_length = p_data[index];
+        uint8_t field_type   = p_data[index + 1];
+
+        if ( (field_length == UUID128_SIZE + 1)
+           && ( (field_type == BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE)
+             || (field_type == BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE)))
+        {
+            err_code = sd_ble_uuid_decode(UUID128_SIZE,
+                                          &p_data[index + 2],
+                                          &extracted_uuid);
+            if ((err_code == NRF_SUCCESS)
+                && (extracted_uuid.uuid == p_target_uuid->uuid)
+                && (extracted_uuid.type == p_target_uuid->type))
+            {
+                return true;
+            }
+        }
+        index += field_length + 1;
+    }
+    return false;
+}
+
+
+/**@brief Function for handling the Application's BLE Stack events.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void on_ble_evt(ble_evt_t * p_ble_evt)
+{
+    uint32_t              err_code;
+    const ble_gap_evt_t * p_gap_evt = &p_ble_evt->evt.gap_evt;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_ADV_REPORT:
+        {
+            const ble_uuid_t dfu_uuid = { .uuid = BLE_DFU_SERVICE_UUID, .type = m_ble_dfu_c[0].uuid_type };
+
+            if (!m_connecting && is_uuid_present(&dfu_uuid, &p_gap_evt->params.adv_report))
+            {
+                // Scanning is stopped by the connection.
+                err_code = sd_ble_gap_connect(&p_gap_evt->params.adv_report.peer_addr,
+                                              &m_scan_params,
+                                              &m_connection_param);
+                if (err_code == NRF_SUCCESS)
+                {
+                    m_connecting = true;
+                    m_scanning   = false;
+                }
+            }
+            break;
+        }
+
+        case BLE_GAP_EVT_CONNECTED:
+            APP_ERROR_CHECK_BOOL(p_gap_evt->conn_handle < CENTRAL_LINK_COUNT);
+
+            memset(&m_targets[p_gap_evt->conn_handle], 0, sizeof(gateway_target_t));
+            m_targets[p_gap_evt->conn_handle].connected = true;
+            m_link_count++;
+            m_connecting = false;
+
+            err_code = ble_dfu_c_handles_assign(&m_ble_dfu_c[p_gap_evt->conn_handle],
+                                                p_gap_evt->conn_handle,
+                                                NULL);
+            APP_ERROR_CHECK(err_code);
+
+            // The DFU Client waits for a discovery result.
+            err_code = ble_db_discovery_start(&m_ble_db_discovery[p_gap_evt->conn_handle],
+                                              p_gap_evt->conn_handle);
+            APP_ERROR_CHECK(err_code);
+
+            scan_start();
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if (m_targets[p_gap_evt->conn_handle].connected)
+            {
+                m_targets[p_gap_evt->conn_handle].connected = false;
+                m_link_count--;
+            }
+            scan_start();
+            break;
+
+        case BLE_GAP_EVT_TIMEOUT:
+            if (p_gap_evt->params.timeout.src == BLE_GAP_TIMEOUT_SRC_CONN)
+            {
+                // Connection request timed out, scan again.
+                m_connecting = false;
+                scan_start();
+            }
+            break;
+
+        case BLE_GAP_EVT_SEC_PARAMS_REQUEST:
+            // Pairing not supported
+            err_code = sd_ble_gap_sec_params_reply(p_gap_evt->conn_handle, BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP, NULL, NULL);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE_REQUEST:
+            // Accept parameters requested by peer.
+            err_code = sd_ble_gap_conn_param_update(p_gap_evt->conn_handle,
+                                        &p_gap_evt->params.conn_param_update_request.conn_params);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief Function for dispatching a BLE stack event to all modules with a BLE stack event handler.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+{
+    uint16_t conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+
+    on_ble_evt(p_ble_evt);
+
+    // Our array of modules is bound to CENTRAL_LINK_COUNT.
+    if (conn_handle < CENTRAL_LINK_COUNT)
+    {
+        ble_db_discovery_on_ble_evt(&m_ble_db_discovery[conn_handle], p_ble_evt);
+        ble_dfu_c_on_ble_evt(&m_ble_dfu_c[conn_handle], p_ble_evt);
+    }
+}
+
+
+/**@brief Function for initializing the BLE stack.
+ */
+static void ble_stack_init(void)
+{
+    uint32_t err_code;
+
+    nrf_clock_lf_cfg_t clock_lf_cfg = NRF_CLOCK_LFCLKSRC;
+
+    // Initialize the SoftDevice handler module.
+    SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
+
+    ble_enable_params_t ble_enable_params;
+    err_code = softdevice_enable_get_default_config(CENTRAL_LINK_COUNT,
+                                                    PERIPHERAL_LINK_COUNT,
+                                                    &ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Check the ram settings against the used number of links
+    CHECK_RAM_START_ADDR(CENTRAL_LINK_COUNT, PERIPHERAL_LINK_COUNT);
+
+    // Enable BLE stack.
+    err_code = softdevice_enable(&ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Register with the SoftDevice handler module for BLE events.
+    err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for initializing one DFU Client instance per link.
+ */
+static void dfu_c_init(void)
+{
+    uint32_t         err_code;
+    ble_dfu_c_init_t dfu_c_init_obj;
+
+    dfu_c_init_obj.evt_handler = ble_dfu_c_evt_handler;
+    dfu_c_init_obj.prn         = DFU_PRN;
+    dfu_c_init_obj.prn_window  = DFU_PRN_WINDOW;
+
+    for (uint32_t i = 0; i < CENTRAL_LINK_COUNT; i++)
+    {
+        err_code = ble_dfu_c_init(&m_ble_dfu_c[i], &dfu_c_init_obj);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/** @brief Function for initializing the Database Discovery Module.
+ */
+static void db_discovery_init(void)
+{
+    uint32_t err_code = ble_db_discovery_init(db_disc_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for starting the progress report timer. */
+static void timers_init(void)
+{
+    uint32_t err_code;
+
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
+
+    err_code = app_timer_create(&m_report_timer_id, APP_TIMER_MODE_REPEATED, report_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_report_timer_id, REPORT_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+int main(void)
+{
+    uint32_t err_code;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    if (!image_init())
+    {
+        NRF_LOG_PRINTF("DFU no image at 0x%x\r\n", IMAGE_ADDRESS);
+        for (;;)
+        {
+            __WFE();
+        }
+    }
+
+    timers_init();
+    db_discovery_init();
+    ble_stack_init();
+    dfu_c_init();
+
+    NRF_LOG_PRINTF("DFU START targets=%u bytes=%u prn=%u window=%u\r\n",
+                   CENTRAL_LINK_COUNT, m_image.sd_size + m_image.bl_size + m_image.app_size,
+                   DFU_PRN, DFU_PRN_WINDOW);
+    scan_start();
+
+    for (;;)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,723 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_app_throughput_c_main main.c
+ * @{
+ * @ingroup ble_sdk_app_throughput_c
+ * @brief Throughput benchmark central application main file.
+ *
+ * This application is the central side of the throughput benchmark, and runs against the
+ * @ref ble_sdk_app_throughput peripheral. For each entry of its test table, it sets the bandwidth
+ * configuration, connects to the peripheral with the connection interval and slave latency of the
+ * test, discovers the Nordic UART Service and runs two phases of @ref BENCH_PHASE_MS each:
+ *  - notify: notifications are enabled and the received bytes are counted,
+ *  - write: notifications are disabled and the stream buffer of @ref ble_nus_c_stream_write is
+ *    kept full.
+ *
+ * It then disconnects and moves on to the next test. At the end of each phase, a result line is
+ * printed over RTT with the throughput, the ratio of writes that had to wait for a free TX buffer
+ * and the CPU load. The peripheral prints the same measurements for its side. Every result line
+ * starts with "BENCH" so that a test script can collect them; "BENCH DONE" is printed last.
+ *
+ * @note The ATT MTU is fixed to @ref GATT_MTU_SIZE_DEFAULT by this SoftDevice version, so it is
+ *       not part of the test table. The number of TX buffers of a connection follows from its
+ *       bandwidth configuration, and is printed for each test.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_gattc.h"
+#include "ble_hci.h"
+#include "ble_db_discovery.h"
+#include "ble_nus_c.h"
+#include "softdevice_handler.h"
+#include "boards.h"
+#include "nrf_log.h"
+
+#if (__CORTEX_M < 3)
+#error "The benchmark uses the DWT cycle counter (Cortex-M3 or later)."
+#endif
+
+#if !BLE_NUS_C_STREAM_ENABLED
+#error "The benchmark uses the streaming API of the NUS Client (BLE_NUS_C_STREAM_ENABLED)."
+#endif
+
+#define CENTRAL_LINK_COUNT          1                                   /**< Number of central links used by the application. When changing this number remember to adjust the RAM settings*/
+#define PERIPHERAL_LINK_COUNT       0                                   /**< Number of peripheral links used by the application. When changing this number remember to adjust the RAM settings*/
+
+#define APP_TIMER_PRESCALER         0                                   /**< Value of the RTC1 PRESCALER register. */
+#define APP_TIMER_OP_QUEUE_SIZE     4                                   /**< Size of timer operation queues. */
+#define APP_TIMER_FREQ              32768                               /**< Frequency of the RTC1 counter, in Hz. */
+
+#define SCAN_INTERVAL               0x00A0                              /**< Determines scan interval in units of 0.625 millisecond. */
+#define SCAN_WINDOW                 0x0050                              /**< Determines scan window in units of 0.625 millisecond. */
+#define SUPERVISION_TIMEOUT         MSEC_TO_UNITS(4000, UNIT_10_MS)     /**< Determines supervision time-out in units of 10 millisecond. */
+
+#define UUID128_SIZE                16                                  /**< Size of 128 bit UUID */
+
+#define BENCH_PHASE_MS              5000                                /**< Duration of each phase of a test. */
+#define BENCH_STREAM_BUFFER_SIZE    1024                                /**< Size of the stream buffer. Must be a power of two. */
+#define BENCH_TEST_COUNT            (sizeof (m_tests) / sizeof (m_tests[0]))   /**< Number of tests. */
+#define BENCH_LOAD_INTERVAL         APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)  /**< Interval at which the CPU load is sampled. Keeps the RTC1 counter running. */
+
+/**@brief Parameters of a test. */
+typedef struct
+{
+    uint16_t interval;                      /**< Connection interval, in units of 1.25 ms. */
+    uint16_t latency;                       /**< Slave latency, in connection events. */
+    uint8_t  bw;                            /**< Bandwidth configuration of the central, see @ref BLE_CONN_BWS. */
+} bench_test_t;
+
+/**@brief Phases of a test. */
+typedef enum
+{
+    BENCH_PHASE_IDLE,                       /**< Connecting, discovering or disconnecting. */
+    BENCH_PHASE_NOTIFY,                     /**< Receiving notifications from the peripheral. */
+    BENCH_PHASE_NOTIFY_STOP,                /**< Waiting for the response to the write disabling notifications. */
+    BENCH_PHASE_WRITE,                      /**< Streaming write commands to the peripheral. */
+    BENCH_PHASE_DONE                        /**< All tests are done. */
+} bench_phase_t;
+
+/**@brief CPU load accumulated over a phase. */
+typedef struct
+{
+    uint32_t last_cycles;                   /**< Cycle counter value at the last sample. */
+    uint32_t last_ticks;                    /**< RTC1 counter value at the last sample. */
+    uint64_t busy_cycles;                   /**< Cycles the CPU was running since the start of the phase. */
+    uint64_t elapsed_ticks;                 /**< RTC1 ticks since the start of the phase. */
+} bench_load_t;
+
+/**@brief Tests run by the benchmark: connection intervals of 7.5, 15, 30, 50 and 100 ms, with and
+ *        without slave latency, for each bandwidth configuration.
+ */
+static const bench_test_t m_tests[] =
+{
+#define BENCH_TESTS_BW(INTERVAL, LATENCY)                   \
+    { (INTERVAL), (LATENCY), BLE_CONN_BW_LOW },             \
+    { (INTERVAL), (LATENCY), BLE_CONN_BW_MID },             \
+    { (INTERVAL), (LATENCY), BLE_CONN_BW_HIGH }
+    BENCH_TESTS_BW(6,  0), BENCH_TESTS_BW(6,  4),
+    BENCH_TESTS_BW(12, 0), BENCH_TESTS_BW(12, 4),
+    BENCH_TESTS_BW(24, 0), BENCH_TESTS_BW(24, 4),
+    BENCH_TESTS_BW(40, 0), BENCH_TESTS_BW(40, 4),
+    BENCH_TESTS_BW(80, 0), BENCH_TESTS_BW(80, 4)
+#undef BENCH_TESTS_BW
+};
+
+static char const * const m_bw_names[] = { "none", "low", "mid", "high" };  /**< Names of the bandwidth configurations, indexed by @ref BLE_CONN_BWS. */
+
+/**
+ * @brief Parameters used when scanning.
+ */
+static const ble_gap_scan_params_t m_scan_params =
+  {
+    .active      = 0,
+    .selective   = 0,
+    .p_whitelist = NULL,
+    .interval    = SCAN_INTERVAL,
+    .window      = SCAN_WINDOW,
+    .timeout     = 0
+  };
+
+APP_TIMER_DEF(m_load_timer_id);                                         /**< CPU load sampling timer. */
+APP_TIMER_DEF(m_phase_timer_id);                                        /**< Timer ending the current phase. */
+
+static ble_nus_c_t              m_ble_nus_c;                            /**< Instance of NUS service. Must be passed to all NUS_C API calls. */
+static ble_db_discovery_t       m_ble_db_discovery;                     /**< Instance of database discovery module. Must be passed to all db_discovert API calls */
+static uint8_t                  m_stream_buffer[BENCH_STREAM_BUFFER_SIZE];  /**< Stream buffer of the NUS Client. */
+static uint8_t                  m_data[BLE_NUS_MAX_DATA_LEN];           /**< Payload written to the stream. */
+static ble_conn_bw_counts_t     m_conn_bw_counts =                      /**< Memory pools for the highest bandwidth configuration of the test table. */
+{
+    .tx_counts = { .high_count = CENTRAL_LINK_COUNT, .mid_count = 0, .low_count = 0 },
+    .rx_counts = { .high_count = CENTRAL_LINK_COUNT, .mid_count = 0, .low_count = 0 }
+};
+
+static uint32_t                 m_test;                                 /**< Index of the current test. */
+static ble_gap_conn_params_t    m_conn_params;                          /**< Connection parameters of the current test. */
+static uint8_t                  m_tx_buffers;                           /**< TX buffers of the current connection. */
+static bench_phase_t            m_phase = BENCH_PHASE_IDLE;             /**< Current phase. */
+static volatile bool            m_phase_expired;                        /**< The current phase has run for @ref BENCH_PHASE_MS. */
+static bench_load_t             m_load;                                 /**< CPU load of the current phase. */
+static ble_nus_c_stream_stats_t m_stats_start;                          /**< Streaming statistics at the start of the write phase. */
+static uint32_t                 m_rx_bytes;                             /**< Bytes received in the notify phase. */
+static uint32_t                 m_rx_packets;                           /**< Notifications received in the notify phase. */
+
+
+/**@brief Function for asserts in the SoftDevice.
+ *
+ * @param[in] line_num     Line number of the failing ASSERT call.
+ * @param[in] p_file_name  File name of the failing ASSERT call.
+ */
+void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
+{
+    app_error_handler(0xDEADBEEF, line_num, p_file_name);
+}
+
+
+/**@brief Function for starting the DWT cycle counter. */
+static void cycle_counter_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/**@brief Function for adding the cycles and ticks since the last sample to the CPU load.
+ *
+ * @details The cycle counter does not count while the CPU sleeps in sd_app_evt_wait(), so the
+ *          cycles it counts are the time spent in the application and in the SoftDevice.
+ */
+static void load_sample(void)
+{
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t ticks;
+    uint32_t diff;
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&ticks));
+    UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(ticks, m_load.last_ticks, &diff));
+
+    m_load.busy_cycles   += cycles - m_load.last_cycles;
+    m_load.elapsed_ticks += diff;
+    m_load.last_cycles    = cycles;
+    m_load.last_ticks     = ticks;
+}
+
+
+static void load_reset(void)
+{
+    load_sample();
+    m_load.busy_cycles   = 0;
+    m_load.elapsed_ticks = 0;
+}
+
+
+/**@brief Function for getting the time since the start of the phase, in milliseconds. */
+static uint32_t load_elapsed_ms(void)
+{
+    return (uint32_t)((m_load.elapsed_ticks * 1000) / APP_TIMER_FREQ);
+}
+
+
+/**@brief Function for getting the CPU load since the start of the phase, in per mille. */
+static uint32_t load_permille(void)
+{
+    if (m_load.elapsed_ticks == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)((m_load.busy_cycles * APP_TIMER_FREQ * 1000)
+                      / (m_load.elapsed_ticks * SystemCoreClock));
+}
+
+
+static void load_timer_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+    load_sample();
+}
+
+
+static void phase_timer_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+    m_phase_expired = true;
+}
+
+
+/**@brief Function for printing the result of a phase. */
+static void phase_print(char const * p_dir, uint32_t bytes, uint32_t packets, uint32_t stalls)
+{
+    bench_test_t const * p_test = &m_tests[m_test];
+    uint32_t             ms;
+
+    load_sample();
+    ms = MAX(load_elapsed_ms(), 1);
+
+    NRF_LOG_PRINTF("BENCH side=central dir=%s interval=%u latency=%u bw=%s tx_buffers=%u bytes=%u ms=%u kbps=%u stall_permille=%u cpu_permille=%u\r\n",
+                   p_dir, m_conn_params.max_conn_interval, m_conn_params.slave_latency,
+                   m_bw_names[p_test->bw], m_tx_buffers,
+                   bytes, ms, (uint32_t)(((uint64_t)bytes * 8) / ms),
+                   (packets != 0) ? (stalls * 1000) / packets : 0,
+                   load_permille());
+}
+
+
+static void phase_start(bench_phase_t phase)
+{
+    uint32_t err_code;
+
+    load_reset();
+    m_phase_expired = false;
+    m_phase         = phase;
+
+    err_code = app_timer_start(m_phase_timer_id,
+                               APP_TIMER_TICKS(BENCH_PHASE_MS, APP_TIMER_PRESCALER),
+                               NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for starting the notify phase, once the NUS has been discovered. */
+static void notify_phase_start(void)
+{
+    uint32_t err_code;
+
+    m_rx_bytes   = 0;
+    m_rx_packets = 0;
+
+    err_code = ble_nus_c_rx_notif_enable(&m_ble_nus_c);
+    APP_ERROR_CHECK(err_code);
+
+    phase_start(BENCH_PHASE_NOTIFY);
+}
+
+
+/**@brief Function for disabling notifications, which tells the peripheral that its notify phase
+ *        is over.
+ *
+ * @details The write phase starts once the write is acknowledged, since write commands cannot be
+ *          queued while the write request is in progress.
+ */
+static void notif_disable(void)
+{
+    static uint8_t           cccd_value[2] = { 0, 0 };
+    ble_gattc_write_params_t params;
+    uint32_t                 err_code;
+
+    memset(&params, 0, sizeof (params));
+    params.write_op = BLE_GATT_OP_WRITE_REQ;
+    params.handle   = m_ble_nus_c.handles.nus_rx_cccd_handle;
+    params.len      = sizeof (cccd_value);
+    params.p_value  = cccd_value;
+
+    err_code = sd_ble_gattc_write(m_ble_nus_c.conn_handle, &params);
+    APP_ERROR_CHECK(err_code);
+
+    m_phase = BENCH_PHASE_NOTIFY_STOP;
+}
+
+
+static void write_phase_start(void)
+{
+    ble_nus_c_stream_stats_get(&m_ble_nus_c, &m_stats_start);
+    phase_start(BENCH_PHASE_WRITE);
+}
+
+
+/**@brief Function for ending the current phase, once it has run for @ref BENCH_PHASE_MS. */
+static void phase_end(void)
+{
+    uint32_t err_code;
+
+    m_phase_expired = false;
+
+    if (m_phase == BENCH_PHASE_NOTIFY)
+    {
+        // Notifications are not acknowledged, the receiving side does not stall.
+        phase_print("notify", m_rx_bytes, m_rx_packets, 0);
+        notif_disable();
+    }
+    else if (m_phase == BENCH_PHASE_WRITE)
+    {
+        ble_nus_c_stream_stats_t stats;
+        uint32_t                 bytes;
+
+        ble_nus_c_stream_stats_get(&m_ble_nus_c, &stats);
+        bytes = stats.bytes_sent - m_stats_start.bytes_sent;
+
+        phase_print("write",
+                    bytes,
+                    CEIL_DIV(bytes, BLE_NUS_MAX_DATA_LEN),
+                    stats.stall_count - m_stats_start.stall_count);
+
+        m_phase  = BENCH_PHASE_IDLE;
+        err_code = sd_ble_gap_disconnect(m_ble_nus_c.conn_handle,
+                                         BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for keeping the stream buffer full during the write phase. */
+static void stream_fill(void)
+{
+    uint32_t err_code;
+
+    while (m_phase == BENCH_PHASE_WRITE)
+    {
+        uint32_t len = sizeof (m_data);
+
+        err_code = ble_nus_c_stream_write(&m_ble_nus_c, m_data, &len);
+        if (err_code == NRF_ERROR_NO_MEM)
+        {
+            return;
+        }
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for setting up the bandwidth and the connection parameters of the current
+ *        test, and scanning for the peripheral.
+ */
+static void test_start(void)
+{
+    bench_test_t const * p_test = &m_tests[m_test];
+    ble_opt_t            opt;
+    uint32_t             err_code;
+
+    memset(&opt, 0, sizeof (opt));
+    opt.common_opt.conn_bw.role               = BLE_GAP_ROLE_CENTRAL;
+    opt.common_opt.conn_bw.conn_bw.conn_bw_tx = p_test->bw;
+    opt.common_opt.conn_bw.conn_bw.conn_bw_rx = p_test->bw;
+
+    err_code = sd_ble_opt_set(BLE_COMMON_OPT_CONN_BW, &opt);
+    APP_ERROR_CHECK(err_code);
+
+    m_conn_params.min_conn_interval = p_test->interval;
+    m_conn_params.max_conn_interval = p_test->interval;
+    m_conn_params.slave_latency     = p_test->latency;
+    m_conn_params.conn_sup_timeout  = SUPERVISION_TIMEOUT;
+
+    err_code = sd_ble_gap_scan_start(&m_scan_params);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for moving on to the next test, or ending the benchmark. */
+static void test_next(void)
+{
+    m_test++;
+    if (m_test < BENCH_TEST_COUNT)
+    {
+        test_start();
+    }
+    else
+    {
+        m_phase = BENCH_PHASE_DONE;
+        NRF_LOG_PRINTF("BENCH DONE\r\n");
+    }
+}
+
+
+/**@brief Function for handling database discovery events.
+ *
+ * @param[in] p_event  Pointer to the database discovery event.
+ */
+static void db_disc_handler(ble_db_discovery_evt_t * p_evt)
+{
+    ble_nus_c_on_db_disc_evt(&m_ble_nus_c, p_evt);
+}
+
+
+/**@brief Callback handling NUS Client events.
+ *
+ * @param[in]   p_ble_nus_c   NUS Client Handle. This identifies the NUS client
+ * @param[in]   p_ble_nus_evt Pointer to the NUS Client event.
+ */
+static void ble_nus_c_evt_handler(ble_nus_c_t * p_ble_nus_c, const ble_nus_c_evt_t * p_ble_nus_evt)
+{
+    uint32_t err_code;
+
+    switch (p_ble_nus_evt->evt_type)
+    {
+        case BLE_NUS_C_EVT_DISCOVERY_COMPLETE:
+            err_code = ble_nus_c_handles_assign(p_ble_nus_c, p_ble_nus_evt->conn_handle, &p_ble_nus_evt->handles);
+            APP_ERROR_CHECK(err_code);
+
+            err_code = sd_ble_tx_packet_count_get(p_ble_nus_evt->conn_handle, &m_tx_buffers);
+            APP_ERROR_CHECK(err_code);
+
+            notify_phase_start();
+            break;
+
+        case BLE_NUS_C_EVT_NUS_RX_EVT:
+            if (m_phase == BENCH_PHASE_NOTIFY)
+            {
+                m_rx_bytes += p_ble_nus_evt->data_len;
+                m_rx_packets++;
+            }
+            break;
+
+        case BLE_NUS_C_EVT_DISCONNECTED:
+            // Handled in on_ble_evt.
+            break;
+    }
+}
+
+
+/**@brief Reads an advertising report and checks if a 128-bit UUID is present in the service
+ *        list.
+ *
+ * @param[in]   p_target_uuid The uuid to search for.
+ * @param[in]   p_adv_report  Pointer to the advertisement report.
+ *
+ * @retval      true if the UUID is present in the advertisement report. Otherwise false
+ */
+static bool is_uuid_present(const ble_uuid_t *p_target_uuid,
+                            const ble_gap_evt_adv_report_t *p_adv_report)
+{
+    uint32_t   err_code;
+    uint32_t   index  = 0;
+    uint8_t  * p_data = (uint8_t *)p_adv_report->data;
+    ble_uuid_t extracted_uuid;
+
+    while (index + 1 < p_adv_report->dlen)
+    {
+        uint8_t field_length = p_data[index];
+        uint8_t field_type   = p_data[index + 1];
+
+        if ( (field_length == UUID128_SIZE + 1)
+           && ( (field_type == BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE)
+             || (field_type == BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE)))
+        {
+            err_code = sd_ble_uuid_decode(UUID128_SIZE,
+                                          &p_data[index + 2],
+                                          &extracted_uuid);
+            if ((err_code == NRF_SUCCESS)
+                && (extracted_uuid.uuid == p_target_uuid->uuid)
+                && (extracted_uuid.type == p_target_uuid->type))
+            {
+                return true;
+            }
+        }
+        index += field_length + 1;
+    }
+    return false;
+}
+
+
+/**@brief Function for handling the Application's BLE Stack events.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void on_ble_evt(ble_evt_t * p_ble_evt)
+{
+    uint32_t              err_code;
+    const ble_gap_evt_t * p_gap_evt = &p_ble_evt->evt.gap_evt;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_ADV_REPORT:
+        {
+            const ble_uuid_t nus_uuid = { .uuid = BLE_UUID_NUS_SERVICE, .type = m_ble_nus_c.uuid_type };
+
+            if (is_uuid_present(&nus_uuid, &p_gap_evt->params.adv_report))
+            {
+                // Scanning is stopped by the connection. Reports that were already queued are
+                // rejected by the SoftDevice.
+                UNUSED_RETURN_VALUE(sd_ble_gap_connect(&p_gap_evt->params.adv_report.peer_addr,
+                                                       &m_scan_params,
+                                                       &m_conn_params));
+            }
+            break;
+        }
+
+        case BLE_GAP_EVT_CONNECTED:
+            m_conn_params = p_gap_evt->params.connected.conn_params;
+
+            // Start discovery of services. The NUS Client waits for a discovery result.
+            err_code = ble_db_discovery_start(&m_ble_db_discovery, p_gap_evt->conn_handle);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GATTC_EVT_WRITE_RSP:
+            if ((m_phase == BENCH_PHASE_NOTIFY_STOP)
+                && (p_ble_evt->evt.gattc_evt.params.write_rsp.handle == m_ble_nus_c.handles.nus_rx_cccd_handle))
+            {
+                write_phase_start();
+            }
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if (m_phase != BENCH_PHASE_IDLE)
+            {
+                NRF_LOG_PRINTF("BENCH side=central test=%u disconnected before the end, reason=0x%x\r\n",
+                               m_test, p_gap_evt->params.disconnected.reason);
+                UNUSED_RETURN_VALUE(app_timer_stop(m_phase_timer_id));
+                m_phase_expired = false;
+                m_phase         = BENCH_PHASE_IDLE;
+            }
+            test_next();
+            break;
+
+        case BLE_GAP_EVT_TIMEOUT:
+            if (p_gap_evt->params.timeout.src == BLE_GAP_TIMEOUT_SRC_CONN)
+            {
+                // Connection request timed out, scan again.
+                test_start();
+            }
+            break;
+
+        case BLE_GAP_EVT_SEC_PARAMS_REQUEST:
+            // Pairing not supported
+            err_code = sd_ble_gap_sec_params_reply(p_gap_evt->conn_handle, BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP, NULL, NULL);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE_REQUEST:
+            // Keep the parameters of the test.
+            err_code = sd_ble_gap_conn_param_update(p_gap_evt->conn_handle, &m_conn_params);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE:
+            m_conn_params = p_gap_evt->params.conn_param_update.conn_params;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief Function for dispatching a BLE stack event to all modules with a BLE stack event handler.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+{
+    on_ble_evt(p_ble_evt);
+    ble_db_discovery_on_ble_evt(&m_ble_db_discovery, p_ble_evt);
+    ble_nus_c_on_ble_evt(&m_ble_nus_c, p_ble_evt);
+}
+
+
+/**@brief Function for initializing the BLE stack.
+ *
+ * @details The memory pools are configured for the highest bandwidth of the test table. The
+ *          bandwidth of each connection is then set with @ref BLE_COMMON_OPT_CONN_BW.
+ */
+static void ble_stack_init(void)
+{
+    uint32_t err_code;
+
+    nrf_clock_lf_cfg_t clock_lf_cfg = NRF_CLOCK_LFCLKSRC;
+
+    // Initialize the SoftDevice handler module.
+    SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
+
+    ble_enable_params_t ble_enable_params;
+    err_code = softdevice_enable_get_default_config(CENTRAL_LINK_COUNT,
+                                                    PERIPHERAL_LINK_COUNT,
+                                                    &ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    ble_enable_params.common_enable_params.p_conn_bw_counts = &m_conn_bw_counts;
+
+    // Check the ram settings against the used number of links
+    CHECK_RAM_START_ADDR(CENTRAL_LINK_COUNT, PERIPHERAL_LINK_COUNT);
+
+    // Enable BLE stack.
+    err_code = softdevice_enable(&ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Register with the SoftDevice handler module for BLE events.
+    err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for initializing the NUS Client with a stream buffer.
+ */
+static void nus_c_init(void)
+{
+    uint32_t         err_code;
+    ble_nus_c_init_t nus_c_init_t;
+
+    memset(&nus_c_init_t, 0, sizeof (nus_c_init_t));
+
+    nus_c_init_t.evt_handler        = ble_nus_c_evt_handler;
+    nus_c_init_t.p_stream_buffer    = m_stream_buffer;
+    nus_c_init_t.stream_buffer_size = sizeof (m_stream_buffer);
+
+    err_code = ble_nus_c_init(&m_ble_nus_c, &nus_c_init_t);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/** @brief Function for initializing the Database Discovery Module.
+ */
+static void db_discovery_init(void)
+{
+    uint32_t err_code = ble_db_discovery_init(db_disc_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for creating the phase timer and starting the CPU load sampling timer. */
+static void timers_init(void)
+{
+    uint32_t err_code;
+
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
+
+    err_code = app_timer_create(&m_phase_timer_id, APP_TIMER_MODE_SINGLE_SHOT, phase_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_create(&m_load_timer_id, APP_TIMER_MODE_REPEATED, load_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_load_timer_id, BENCH_LOAD_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+int main(void)
+{
+    uint32_t err_code;
+    uint32_t i;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    for (i = 0; i < sizeof (m_data); i++)
+    {
+        m_data[i] = (uint8_t)i;
+    }
+
+    cycle_counter_start();
+    timers_init();
+    db_discovery_init();
+    ble_stack_init();
+    nus_c_init();
+
+    NRF_LOG_PRINTF("BENCH START side=central tests=%u phase_ms=%u\r\n",
+                   BENCH_TEST_COUNT, BENCH_PHASE_MS);
+    test_start();
+
+    for (;;)
+    {
+        if (m_phase_expired)
+        {
+            phase_end();
+        }
+        stream_fill();
+
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/**
+ * @}
+ */
@@ -27,6 +27,7 @@
 #include "softdevice_handler.h"
 #include "ser_hal_transport.h"
 #include "ser_conn_handlers.h"
+#include "ser_conn_event_encoder.h"
 #include "boards.h"
 
 #include "ser_phy_debug_comm.h"
@@ -66,6 +67,9 @@ int main(void)
         /* Process SoftDevice events. */
         app_sched_execute();
 
+        /* Send the events packed into an aggregate packet, if any. */
+        ser_conn_ble_event_flush();
+
         /* Process received packets.
          * We can NOT add received packets as events to the application scheduler queue because
          * received packets have to be processed before SoftDevice events but the scheduler queue
@@ -45,7 +45,7 @@
 #include "nrf_log.h"
 #include "fstorage.h"
 #include "fds.h"
-#include "ecc.h"
+#include "nrf_crypto.h"
 
 #define LESC_DEBUG_MODE 0 /**< Set to 1 to use LESC debug keys, allows you to use a sniffer to inspect traffic. */
 #define LESC_MITM_NC 1    /**< Use MITM (Numeric Comparison). */ 
@@ -602,7 +602,7 @@ static void on_ble_evt(uint16_t conn_handle, ble_evt_t * p_ble_evt)
             break;
         case BLE_GAP_EVT_LESC_DHKEY_REQUEST:
             NRF_LOG_PRINTF("BLE_GAP_EVT_LESC_DHKEY_REQUEST\n");
-            err_code = ecc_p256_shared_secret_compute(&m_lesc_sk.sk[0], &p_ble_evt->evt.gap_evt.params.lesc_dhkey_request.p_pk_peer->pk[0], &m_lesc_dhkey.key[0]);
+            err_code = nrf_crypto_ecdh_p256_shared_secret_compute(&m_lesc_sk.sk[0], &p_ble_evt->evt.gap_evt.params.lesc_dhkey_request.p_pk_peer->pk[0], &m_lesc_dhkey.key[0]);
             APP_ERROR_CHECK(err_code);
             m_dhkey_req = 1;
             break;
@@ -1019,14 +1019,15 @@ static void peer_manager_init(bool erase_bonds)
     err_code = fds_register(fds_evt_handler);
     APP_ERROR_CHECK(err_code);
     
-    ecc_init();
+    err_code = nrf_crypto_init();
+    APP_ERROR_CHECK(err_code);
     
 #if LESC_DEBUG_MODE
     memcpy(m_lesc_sk.sk, m_debug_lesc_sk.sk, BLE_GAP_LESC_P256_SK_LEN);
-    err_code = ecc_p256_public_key_compute((uint8_t *) m_lesc_sk.sk, m_lesc_pk.pk);
+    err_code = nrf_crypto_ecdh_p256_public_key_compute((uint8_t *) m_lesc_sk.sk, m_lesc_pk.pk);
     APP_ERROR_CHECK(err_code);
 #else
-    err_code = ecc_p256_keypair_gen(m_lesc_sk.sk, m_lesc_pk.pk);
+    err_code = nrf_crypto_ecdh_p256_keypair_gen(m_lesc_sk.sk, m_lesc_pk.pk);
     APP_ERROR_CHECK(err_code);
 #endif
 
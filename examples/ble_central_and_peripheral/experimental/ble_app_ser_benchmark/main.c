@@ -0,0 +1,540 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_app_ser_benchmark_main main.c
+ * @{
+ * @ingroup ble_sdk_app_ser_benchmark
+ * @brief Serialization benchmark application main file.
+ *
+ * This application runs on the application chip of a serialized setup, against the unmodified
+ * @ref ble_sdk_app_connectivity firmware on the connectivity chip. It measures:
+ *  - the round-trip latency of commands that do not go over the air, as a histogram, together with
+ *    the number of commands per second and the payload throughput through the serial link,
+ *  - once a peer has connected and enabled notifications, the throughput of
+ *    sd_ble_gatts_hvx() notifications and, if @ref BENCH_PEER_WRITE_HANDLE is set, of
+ *    sd_ble_gattc_write() write commands to the peer.
+ *
+ * Results are printed over RTT. Every result line starts with "BENCH" so that a test script can
+ * collect them; "BENCH DONE" is printed last.
+ *
+ * The serial link is selected by the project (UART, HCI UART or SPI), so the same application
+ * compares PHY variants as well as codec changes.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_gatts.h"
+#include "ble_gattc.h"
+#include "ble_hci.h"
+#include "softdevice_handler.h"
+#include "boards.h"
+#include "nrf_log.h"
+
+#if (__CORTEX_M < 3)
+#error "The benchmark uses the DWT cycle counter (Cortex-M3 or later)."
+#endif
+
+#define CENTRAL_LINK_COUNT          0                                   /**< Number of central links used by the application. */
+#define PERIPHERAL_LINK_COUNT       1                                   /**< Number of peripheral links used by the application. */
+
+#define DEVICE_NAME                 "Ser_Bench"                         /**< Name of device. Will be included in the advertising data. */
+#define APP_ADV_INTERVAL            64                                  /**< The advertising interval (in units of 0.625 ms). */
+#define APP_ADV_TIMEOUT_IN_SECONDS  0                                   /**< Advertise until a peer connects. */
+
+#define BENCH_UUID_SERVICE          0xFFF0                              /**< 16-bit UUID of the benchmark service. */
+#define BENCH_UUID_CHAR             0xFFF1                              /**< 16-bit UUID of the benchmark characteristic. */
+
+#define BENCH_ITERATIONS            1000                                /**< Number of commands per latency measurement. */
+#define BENCH_VALUE_MAX_LEN         256                                 /**< Maximum length of the benchmark characteristic value. */
+#define BENCH_HVX_LEN               (GATT_MTU_SIZE_DEFAULT - 3)         /**< Payload size of notifications and write commands. */
+#define BENCH_THROUGHPUT_MS         10000                               /**< Duration of each throughput measurement. */
+#define BENCH_HIST_BUCKETS          16                                  /**< Latency histogram buckets. Bucket n counts latencies from 2^n to 2^(n+1) - 1 microseconds. */
+
+#ifndef BENCH_PEER_WRITE_HANDLE
+#define BENCH_PEER_WRITE_HANDLE     0                                   /**< Handle of a peer attribute accepting write commands, 0 to skip the sd_ble_gattc_write() measurement. */
+#endif
+
+#define CYCLES_PER_US               (SystemCoreClock / 1000000)         /**< DWT cycles per microsecond. */
+
+/**@brief Latency statistics of one measurement. */
+typedef struct
+{
+    uint32_t count;                         /**< Number of samples. */
+    uint32_t min_us;                        /**< Minimum latency. */
+    uint32_t max_us;                        /**< Maximum latency. */
+    uint32_t total_us;                      /**< Sum of all latencies. */
+    uint32_t bucket[BENCH_HIST_BUCKETS];    /**< Latency histogram. */
+} bench_hist_t;
+
+/**@brief Command under test. Sends one command with a payload of the given length. */
+typedef uint32_t (*bench_cmd_t)(uint16_t len);
+
+/**@brief States of the throughput measurement. */
+typedef enum
+{
+    BENCH_TP_IDLE,                          /**< Not connected, or notifications not enabled. */
+    BENCH_TP_HVX,                           /**< Measuring sd_ble_gatts_hvx(). */
+    BENCH_TP_GATTC_WRITE,                   /**< Measuring sd_ble_gattc_write(). */
+    BENCH_TP_DONE                           /**< All measurements are done. */
+} bench_tp_state_t;
+
+static uint16_t                 m_conn_handle = BLE_CONN_HANDLE_INVALID;    /**< Handle of the current connection. */
+static ble_gatts_char_handles_t m_char_handles;                             /**< Handles of the benchmark characteristic. */
+static uint8_t                  m_value[BENCH_VALUE_MAX_LEN];               /**< Payload sent by the benchmark. */
+static bench_hist_t             m_hist;                                     /**< Statistics of the current latency measurement. */
+
+static volatile bench_tp_state_t m_tp_state = BENCH_TP_IDLE;                /**< Current throughput measurement. */
+static uint32_t                  m_tp_start;                                /**< Cycle counter value at the start of the throughput measurement. */
+static uint32_t                  m_tp_packets;                              /**< Packets sent over the air in the throughput measurement. */
+
+
+/**@brief Callback function for asserts in the SoftDevice.
+ *
+ * @param[in] line_num   Line number of the failing ASSERT call.
+ * @param[in] file_name  File name of the failing ASSERT call.
+ */
+void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
+{
+    app_error_handler(0xDEADBEEF, line_num, p_file_name);
+}
+
+
+/**@brief Function for starting the DWT cycle counter. */
+static void cycle_counter_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/**@brief Function for getting the time since a cycle counter value, in microseconds. */
+static uint32_t us_since(uint32_t start)
+{
+    return (DWT->CYCCNT - start) / CYCLES_PER_US;
+}
+
+
+static void hist_add(bench_hist_t * p_hist, uint32_t us)
+{
+    uint32_t bucket = 0;
+
+    while ((bucket < BENCH_HIST_BUCKETS - 1) && ((us >> (bucket + 1)) != 0))
+    {
+        bucket++;
+    }
+
+    p_hist->bucket[bucket]++;
+    p_hist->total_us += us;
+    p_hist->min_us    = MIN(p_hist->min_us, us);
+    p_hist->max_us    = MAX(p_hist->max_us, us);
+    p_hist->count++;
+}
+
+
+static void hist_print(char const * p_name, uint16_t len, bench_hist_t const * p_hist)
+{
+    uint32_t i;
+    uint32_t avg_us = p_hist->total_us / p_hist->count;
+
+    NRF_LOG_PRINTF("BENCH %s len=%u n=%u min_us=%u avg_us=%u max_us=%u cmd_per_s=%u payload_Bps=%u\r\n",
+                   p_name, len, p_hist->count, p_hist->min_us, avg_us, p_hist->max_us,
+                   1000000 / avg_us, (uint32_t)((1000000ull * len) / avg_us));
+
+    for (i = 0; i < BENCH_HIST_BUCKETS; i++)
+    {
+        if (p_hist->bucket[i] != 0)
+        {
+            NRF_LOG_PRINTF("BENCH %s len=%u hist_us=%u..%u count=%u\r\n",
+                           p_name, len, (1u << i) & ~1u, (2u << i) - 1, p_hist->bucket[i]);
+        }
+    }
+}
+
+
+/**@brief Function for measuring the round-trip latency of a command. */
+static void bench_latency(char const * p_name, bench_cmd_t cmd, uint16_t len)
+{
+    uint32_t i;
+
+    memset(&m_hist, 0, sizeof (m_hist));
+    m_hist.min_us = UINT32_MAX;
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t start    = DWT->CYCCNT;
+        uint32_t err_code = cmd(len);
+
+        hist_add(&m_hist, us_since(start));
+        APP_ERROR_CHECK(err_code);
+    }
+
+    hist_print(p_name, len, &m_hist);
+}
+
+
+static uint32_t cmd_version_get(uint16_t len)
+{
+    ble_version_t version;
+
+    UNUSED_PARAMETER(len);
+    return sd_ble_version_get(&version);
+}
+
+
+static uint32_t cmd_value_set(uint16_t len)
+{
+    ble_gatts_value_t value = { .len = len, .offset = 0, .p_value = m_value };
+
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID, m_char_handles.value_handle, &value);
+}
+
+
+static uint32_t cmd_value_get(uint16_t len)
+{
+    ble_gatts_value_t value = { .len = len, .offset = 0, .p_value = m_value };
+
+    return sd_ble_gatts_value_get(BLE_CONN_HANDLE_INVALID, m_char_handles.value_handle, &value);
+}
+
+
+/**@brief Function for running the measurements that do not need a connection. */
+static void bench_latency_run(void)
+{
+    static const uint16_t lengths[] = { 1, 20, 64, 128, BENCH_VALUE_MAX_LEN };
+    uint32_t              i;
+
+    bench_latency("version_get", cmd_version_get, 0);
+
+    for (i = 0; i < sizeof (lengths) / sizeof (lengths[0]); i++)
+    {
+        bench_latency("gatts_value_set", cmd_value_set, lengths[i]);
+    }
+
+    for (i = 0; i < sizeof (lengths) / sizeof (lengths[0]); i++)
+    {
+        bench_latency("gatts_value_get", cmd_value_get, lengths[i]);
+    }
+}
+
+
+/**@brief Function for queuing packets for the current throughput measurement until the
+ *        SoftDevice runs out of TX buffers.
+ */
+static void tp_fill(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    while (err_code == NRF_SUCCESS)
+    {
+        if (m_tp_state == BENCH_TP_HVX)
+        {
+            uint16_t               len    = BENCH_HVX_LEN;
+            ble_gatts_hvx_params_t params =
+            {
+                .handle = m_char_handles.value_handle,
+                .type   = BLE_GATT_HVX_NOTIFICATION,
+                .offset = 0,
+                .p_len  = &len,
+                .p_data = m_value
+            };
+
+            err_code = sd_ble_gatts_hvx(m_conn_handle, &params);
+        }
+        else if (m_tp_state == BENCH_TP_GATTC_WRITE)
+        {
+            ble_gattc_write_params_t params =
+            {
+                .write_op = BLE_GATT_OP_WRITE_CMD,
+                .flags    = 0,
+                .handle   = BENCH_PEER_WRITE_HANDLE,
+                .offset   = 0,
+                .len      = BENCH_HVX_LEN,
+                .p_value  = m_value
+            };
+
+            err_code = sd_ble_gattc_write(m_conn_handle, &params);
+        }
+        else
+        {
+            return;
+        }
+    }
+
+    if (err_code != BLE_ERROR_NO_TX_PACKETS)
+    {
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+static void tp_start(bench_tp_state_t state)
+{
+    m_tp_state   = state;
+    m_tp_packets = 0;
+    m_tp_start   = DWT->CYCCNT;
+    tp_fill();
+}
+
+
+/**@brief Function for counting sent packets and moving on to the next throughput measurement
+ *        once the current one has run for @ref BENCH_THROUGHPUT_MS.
+ */
+static void tp_tx_complete(uint8_t count)
+{
+    uint32_t elapsed_us;
+
+    m_tp_packets += count;
+    elapsed_us    = us_since(m_tp_start);
+
+    if (elapsed_us < BENCH_THROUGHPUT_MS * 1000ul)
+    {
+        tp_fill();
+        return;
+    }
+
+    NRF_LOG_PRINTF("BENCH %s len=%u packets=%u ms=%u pkt_per_s=%u payload_Bps=%u\r\n",
+                   (m_tp_state == BENCH_TP_HVX) ? "hvx" : "gattc_write", BENCH_HVX_LEN,
+                   m_tp_packets, elapsed_us / 1000,
+                   (uint32_t)((1000000ull * m_tp_packets) / elapsed_us),
+                   (uint32_t)((1000000ull * m_tp_packets * BENCH_HVX_LEN) / elapsed_us));
+
+    if ((m_tp_state == BENCH_TP_HVX) && (BENCH_PEER_WRITE_HANDLE != 0))
+    {
+        tp_start(BENCH_TP_GATTC_WRITE);
+    }
+    else
+    {
+        m_tp_state = BENCH_TP_DONE;
+        NRF_LOG_PRINTF("BENCH DONE\r\n");
+    }
+}
+
+
+/**@brief Function for dispatching a BLE stack event.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+{
+    uint32_t err_code;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            if (m_tp_state != BENCH_TP_DONE)
+            {
+                NRF_LOG_PRINTF("BENCH disconnected before the throughput measurements completed\r\n");
+                m_tp_state = BENCH_TP_IDLE;
+            }
+            break;
+
+        case BLE_GATTS_EVT_WRITE:
+        {
+            ble_gatts_evt_write_t * p_write = &p_ble_evt->evt.gatts_evt.params.write;
+
+            if ((p_write->handle == m_char_handles.cccd_handle) && (p_write->len == 2) &&
+                (m_tp_state == BENCH_TP_IDLE) && (p_write->data[0] & BLE_GATT_HVX_NOTIFICATION))
+            {
+                tp_start(BENCH_TP_HVX);
+            }
+            break;
+        }
+
+        case BLE_GATTS_EVT_SYS_ATTR_MISSING:
+            err_code = sd_ble_gatts_sys_attr_set(m_conn_handle, NULL, 0, 0);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_SEC_PARAMS_REQUEST:
+            err_code = sd_ble_gap_sec_params_reply(m_conn_handle,
+                                                   BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP,
+                                                   NULL,
+                                                   NULL);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_EVT_TX_COMPLETE:
+            if ((m_tp_state == BENCH_TP_HVX) || (m_tp_state == BENCH_TP_GATTC_WRITE))
+            {
+                tp_tx_complete(p_ble_evt->evt.common_evt.params.tx_complete.count);
+            }
+            break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
+
+
+/**@brief Function for initializing the BLE stack. */
+static void ble_stack_init(void)
+{
+    uint32_t err_code;
+
+    nrf_clock_lf_cfg_t clock_lf_cfg = NRF_CLOCK_LFCLKSRC;
+
+    // Initialize the SoftDevice handler module.
+    SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
+
+    ble_enable_params_t ble_enable_params;
+    err_code = softdevice_enable_get_default_config(CENTRAL_LINK_COUNT,
+                                                    PERIPHERAL_LINK_COUNT,
+                                                    &ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Check the ram settings against the used number of links
+    CHECK_RAM_START_ADDR(CENTRAL_LINK_COUNT, PERIPHERAL_LINK_COUNT);
+
+    // Enable BLE stack.
+    err_code = softdevice_enable(&ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Register with the SoftDevice handler module for BLE events.
+    err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for adding the benchmark service with one characteristic, which can be read,
+ *        written without response and notified.
+ */
+static void service_init(void)
+{
+    uint32_t              err_code;
+    uint16_t              service_handle;
+    ble_uuid_t            uuid;
+    ble_gatts_char_md_t   char_md;
+    ble_gatts_attr_md_t   cccd_md;
+    ble_gatts_attr_md_t   attr_md;
+    ble_gatts_attr_t      attr_char_value;
+
+    BLE_UUID_BLE_ASSIGN(uuid, BENCH_UUID_SERVICE);
+    err_code = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY, &uuid, &service_handle);
+    APP_ERROR_CHECK(err_code);
+
+    memset(&cccd_md, 0, sizeof (cccd_md));
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.write_perm);
+    cccd_md.vloc = BLE_GATTS_VLOC_STACK;
+
+    memset(&char_md, 0, sizeof (char_md));
+    char_md.char_props.read          = 1;
+    char_md.char_props.write_wo_resp = 1;
+    char_md.char_props.notify        = 1;
+    char_md.p_cccd_md                = &cccd_md;
+
+    memset(&attr_md, 0, sizeof (attr_md));
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.write_perm);
+    attr_md.vloc    = BLE_GATTS_VLOC_STACK;
+    attr_md.vlen    = 1;
+
+    BLE_UUID_BLE_ASSIGN(uuid, BENCH_UUID_CHAR);
+    memset(&attr_char_value, 0, sizeof (attr_char_value));
+    attr_char_value.p_uuid    = &uuid;
+    attr_char_value.p_attr_md = &attr_md;
+    attr_char_value.init_len  = 1;
+    attr_char_value.max_len   = BENCH_VALUE_MAX_LEN;
+    attr_char_value.p_value   = m_value;
+
+    err_code = sd_ble_gatts_characteristic_add(service_handle, &char_md, &attr_char_value,
+                                               &m_char_handles);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for setting the device name and starting advertising. */
+static void advertising_start(void)
+{
+    uint32_t                err_code;
+    ble_gap_conn_sec_mode_t sec_mode;
+    ble_gap_adv_params_t    adv_params;
+    uint8_t                 adv_data[3 + 2 + sizeof (DEVICE_NAME) - 1];
+    uint8_t                 index = 0;
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&sec_mode);
+    err_code = sd_ble_gap_device_name_set(&sec_mode,
+                                          (const uint8_t *)DEVICE_NAME,
+                                          strlen(DEVICE_NAME));
+    APP_ERROR_CHECK(err_code);
+
+    adv_data[index++] = 2;
+    adv_data[index++] = BLE_GAP_AD_TYPE_FLAGS;
+    adv_data[index++] = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    adv_data[index++] = sizeof (DEVICE_NAME);
+    adv_data[index++] = BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME;
+    memcpy(&adv_data[index], DEVICE_NAME, sizeof (DEVICE_NAME) - 1);
+    index += sizeof (DEVICE_NAME) - 1;
+
+    err_code = sd_ble_gap_adv_data_set(adv_data, index, NULL, 0);
+    APP_ERROR_CHECK(err_code);
+
+    memset(&adv_params, 0, sizeof (adv_params));
+    adv_params.type        = BLE_GAP_ADV_TYPE_ADV_IND;
+    adv_params.fp          = BLE_GAP_ADV_FP_ANY;
+    adv_params.interval    = APP_ADV_INTERVAL;
+    adv_params.timeout     = APP_ADV_TIMEOUT_IN_SECONDS;
+
+    err_code = sd_ble_gap_adv_start(&adv_params);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for the application main entry. */
+int main(void)
+{
+    uint32_t err_code;
+    uint32_t i;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    for (i = 0; i < sizeof (m_value); i++)
+    {
+        m_value[i] = (uint8_t)i;
+    }
+
+    cycle_counter_start();
+    ble_stack_init();
+    service_init();
+
+    NRF_LOG_PRINTF("BENCH START iterations=%u\r\n", BENCH_ITERATIONS);
+    bench_latency_run();
+
+    NRF_LOG_PRINTF("BENCH advertising as " DEVICE_NAME ", enable notifications to measure throughput\r\n");
+    advertising_start();
+
+    for (;;)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/**
+ * @}
+ */
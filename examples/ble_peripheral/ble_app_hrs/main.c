@@ -367,7 +367,7 @@ static void app_context_load(dm_handle_t const * p_handle)
     if (err_code == NRF_SUCCESS)
     {
         // Send Service Changed Indication if ATT table has changed.
-        if ((context_data & (DFU_APP_ATT_TABLE_CHANGED << DFU_APP_ATT_TABLE_POS)) != 0)
+        if (dfu_app_att_table_changed(context_data))
         {
             err_code = sd_ble_gatts_service_changed(m_conn_handle, APP_SERVICE_HANDLE_START, BLE_HANDLE_MAX);
             if ((err_code != NRF_SUCCESS) &&
@@ -431,7 +431,7 @@ static void reset_prepare(void)
 
 /**@brief Function for initializing services that will be used by the application.
  *
- * @details Initialize the Heart Rate, Battery and Device Information services.
+ * @details Initialize the Device Firmware Update, Heart Rate, Battery and Device Information services.
  */
 static void services_init(void)
 {
@@ -441,6 +441,27 @@ static void services_init(void)
     ble_dis_init_t dis_init;
     uint8_t        body_sensor_location;
 
+#ifdef BLE_DFU_APP_SUPPORT
+    /** @snippet [DFU BLE Service initialization] */
+    ble_dfu_init_t   dfus_init;
+
+    // Initialize the Device Firmware Update Service first, at the handles of the DFU Service in
+    // the bootloader, so that the peer keeps its handles when entering DFU mode.
+    memset(&dfus_init, 0, sizeof(dfus_init));
+
+    dfus_init.evt_handler   = dfu_app_on_dfu_evt;
+    dfus_init.error_handler = NULL;
+    dfus_init.evt_handler   = dfu_app_on_dfu_evt;
+    dfus_init.revision      = DFU_REVISION;
+
+    err_code = ble_dfu_init(&m_dfus, &dfus_init);
+    APP_ERROR_CHECK(err_code);
+
+    dfu_app_reset_prepare_set(reset_prepare);
+    dfu_app_dm_appl_instance_set(m_app_handle);
+    /** @snippet [DFU BLE Service initialization] */
+#endif // BLE_DFU_APP_SUPPORT
+
     // Initialize Heart Rate Service.
     body_sensor_location = BLE_HRS_BODY_SENSOR_LOCATION_FINGER;
 
@@ -489,26 +510,6 @@ static void services_init(void)
 
     err_code = ble_dis_init(&dis_init);
     APP_ERROR_CHECK(err_code);
-
-#ifdef BLE_DFU_APP_SUPPORT
-    /** @snippet [DFU BLE Service initialization] */
-    ble_dfu_init_t   dfus_init;
-
-    // Initialize the Device Firmware Update Service.
-    memset(&dfus_init, 0, sizeof(dfus_init));
-
-    dfus_init.evt_handler   = dfu_app_on_dfu_evt;
-    dfus_init.error_handler = NULL;
-    dfus_init.evt_handler   = dfu_app_on_dfu_evt;
-    dfus_init.revision      = DFU_REVISION;
-
-    err_code = ble_dfu_init(&m_dfus, &dfus_init);
-    APP_ERROR_CHECK(err_code);
-
-    dfu_app_reset_prepare_set(reset_prepare);
-    dfu_app_dm_appl_instance_set(m_app_handle);
-    /** @snippet [DFU BLE Service initialization] */
-#endif // BLE_DFU_APP_SUPPORT
 }
 
 
@@ -218,6 +218,10 @@ standard names - or at least those used in the unmodified vector table. */
         #error "This port requires __NVIC_PRIO_BITS to be defined"
     #endif
 
+    /* The app_timer FreeRTOS RTC variant uses the same RTC as the system tick */
+    void app_timer_rtc_irq_handler(void);
+    #define configRTC_IRQ_HOOK()    app_timer_rtc_irq_handler()
+
     /* Access to current system core clock is required only if we are ticking the system by systimer */
     #if (configTICK_SOURCE == FREERTOS_USE_SYSTICK)
         #include <stdint.h>
@@ -38,6 +38,11 @@
 #include "softdevice_handler.h"
 #include "app_timer.h"
 #include "bsp.h"
+#include "app_energy.h"
+#if (APP_ENERGY_ENABLED == 1)
+#include "app_util_platform.h"
+#include "ble_radio_notification.h"
+#endif
 
 #define IS_SRVC_CHANGED_CHARACT_PRESENT     0                                       /**< Include or not the service_changed characteristic. if not enabled, the server's database cannot be changed for the lifetime of the device*/
 
@@ -112,6 +117,10 @@
 #define LOCAL_SERVICE_UUID            0x1523                                        /**< Proprietary UUID for local service. */
 #define LOCAL_CHAR_UUID               0x1524                                        /**< Proprietary UUID for local characteristic. */
 
+#define ENERGY_REPORT_INTERVAL        10000                                         /**< Interval between two energy reports over RTT (in milli seconds). Only used if APP_ENERGY_ENABLED is 1. */
+#define ENERGY_RADIO_DISTANCE_US      800                                           /**< Radio notification distance (in micro seconds). Must match ENERGY_RADIO_DISTANCE. */
+#define ENERGY_RADIO_DISTANCE         NRF_RADIO_NOTIFICATION_DISTANCE_800US         /**< Radio notification distance. */
+
 #define DEAD_BEEF                     0xDEADBEEF                                    /**< Value used as error code on stack dump, can be used to identify stack location on stack unwind. */
 
 /**@brief 128-bit UUID base List. */
@@ -132,6 +141,9 @@ static uint16_t                 m_service_handle;
 static bool                     m_is_notifying_enabled = false;                     /**< Variable to indicate whether the notification is enabled by the peer.*/
 APP_TIMER_DEF(m_conn_int_timer_id);                                                 /**< Connection interval timer. */
 APP_TIMER_DEF(m_notif_timer_id);                                                    /**< Notification timer. */
+#if (APP_ENERGY_ENABLED == 1)
+APP_TIMER_DEF(m_energy_timer_id);                                                   /**< Energy report timer. */
+#endif
 
 
 /**@brief Callback function for asserts in the SoftDevice.
@@ -414,6 +426,26 @@ static void connection_interval_timeout_handler(void * p_context)
 }
 
 
+#if (APP_ENERGY_ENABLED == 1)
+/**@brief Function for handling the energy report timeout.
+ *
+ * @details Closes the energy accounting window and writes its report over RTT.
+ *
+ * @param[in]   p_context   Pointer used for passing some arbitrary information (context) from the
+ *                          app_start_timer() call to the timeout handler.
+ */
+static void energy_report_timeout_handler(void * p_context)
+{
+    app_energy_report_t report;
+
+    UNUSED_PARAMETER(p_context);
+
+    app_energy_window_end(&report);
+    app_energy_report_dump(&report);
+}
+#endif
+
+
 /**@brief Function for starting application timers.
  *
  * @details This function will be start two timers - one for the time duration for which 
@@ -482,6 +514,13 @@ static void timers_init(void)
                                 APP_TIMER_MODE_SINGLE_SHOT,
                                 notif_timeout_handler);
     APP_ERROR_CHECK(err_code);
+
+#if (APP_ENERGY_ENABLED == 1)
+    err_code = app_timer_create(&m_energy_timer_id,
+                                APP_TIMER_MODE_REPEATED,
+                                energy_report_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+#endif
 }
 
 
@@ -626,6 +665,14 @@ static void ble_stack_init(void)
     // Register with the SoftDevice handler module for BLE events.
     err_code = softdevice_sys_evt_handler_set(sys_evt_dispatch);
     APP_ERROR_CHECK(err_code);
+
+#if (APP_ENERGY_ENABLED == 1)
+    // Account radio time with the Radio Notification signals.
+    err_code = ble_radio_notification_init(APP_IRQ_PRIORITY_LOW,
+                                           ENERGY_RADIO_DISTANCE,
+                                           app_energy_on_radio_evt);
+    APP_ERROR_CHECK(err_code);
+#endif
 }
 
 
@@ -633,7 +680,9 @@ static void ble_stack_init(void)
  */
 static void power_manage(void)
 {
+    APP_ENERGY_IDLE_BEGIN();
     uint32_t err_code = sd_app_evt_wait();
+    APP_ENERGY_IDLE_END();
     APP_ERROR_CHECK(err_code);
 }
 
@@ -698,6 +747,15 @@ int main(void)
     }
     
     advertising_data_init();
+
+#if (APP_ENERGY_ENABLED == 1)
+    app_energy_init(APP_TIMER_PRESCALER, ENERGY_RADIO_DISTANCE_US);
+    err_code = app_timer_start(m_energy_timer_id,
+                               APP_TIMER_TICKS(ENERGY_REPORT_INTERVAL, APP_TIMER_PRESCALER),
+                               NULL);
+    APP_ERROR_CHECK(err_code);
+#endif
+
     advertising_start();
 
     // Enter main loop.
@@ -0,0 +1,501 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_app_throughput_main main.c
+ * @{
+ * @ingroup ble_sdk_app_throughput
+ * @brief Throughput benchmark peripheral application main file.
+ *
+ * This application is the peripheral side of the throughput benchmark. The central side,
+ * @ref ble_sdk_app_throughput_c, connects once for each combination of connection interval,
+ * slave latency and bandwidth configuration of its test table, and runs two phases on each
+ * connection:
+ *  - notify: while the central has notifications of the Nordic UART Service enabled, this
+ *    application keeps the stream buffer of @ref ble_nus_stream_write full,
+ *  - write: once the central disables notifications, it streams write commands and this
+ *    application counts the received bytes, until the central disconnects.
+ *
+ * At the end of each phase, a result line is printed over RTT with the throughput, the ratio of
+ * notifications that had to wait for a free TX buffer and the CPU load. Every result line starts
+ * with "BENCH" so that a test script can collect them.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_hci.h"
+#include "ble_nus.h"
+#include "softdevice_handler.h"
+#include "boards.h"
+#include "nrf_log.h"
+
+#if (__CORTEX_M < 3)
+#error "The benchmark uses the DWT cycle counter (Cortex-M3 or later)."
+#endif
+
+#if !BLE_NUS_STREAM_ENABLED
+#error "The benchmark uses the streaming API of the Nordic UART Service (BLE_NUS_STREAM_ENABLED)."
+#endif
+
+#define CENTRAL_LINK_COUNT          0                                   /**< Number of central links used by the application. */
+#define PERIPHERAL_LINK_COUNT       1                                   /**< Number of peripheral links used by the application. */
+
+#define DEVICE_NAME                 "NUS_Bench"                         /**< Name of device. Will be included in the scan response data. */
+#define NUS_SERVICE_UUID_TYPE       BLE_UUID_TYPE_VENDOR_BEGIN          /**< UUID type for the Nordic UART Service (vendor specific). */
+#define APP_ADV_INTERVAL            64                                  /**< The advertising interval (in units of 0.625 ms). */
+#define APP_ADV_TIMEOUT_IN_SECONDS  0                                   /**< Advertise until a peer connects. */
+
+#define APP_TIMER_PRESCALER         0                                   /**< Value of the RTC1 PRESCALER register. */
+#define APP_TIMER_OP_QUEUE_SIZE     2                                   /**< Size of timer operation queues. */
+#define APP_TIMER_FREQ              32768                               /**< Frequency of the RTC1 counter, in Hz. */
+
+#define BENCH_STREAM_BUFFER_SIZE    1024                                /**< Size of the stream buffer. Must be a power of two. */
+#define BENCH_LOAD_INTERVAL         APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)  /**< Interval at which the CPU load is sampled. Keeps the RTC1 counter running. */
+
+/**@brief Phases of a benchmark connection. */
+typedef enum
+{
+    BENCH_PHASE_IDLE,                       /**< Not connected, or waiting for the central. */
+    BENCH_PHASE_NOTIFY,                     /**< Streaming notifications to the central. */
+    BENCH_PHASE_WRITE                       /**< Receiving write commands from the central. */
+} bench_phase_t;
+
+/**@brief CPU load accumulated over a phase. */
+typedef struct
+{
+    uint32_t last_cycles;                   /**< Cycle counter value at the last sample. */
+    uint32_t last_ticks;                    /**< RTC1 counter value at the last sample. */
+    uint64_t busy_cycles;                   /**< Cycles the CPU was running since the start of the phase. */
+    uint64_t elapsed_ticks;                 /**< RTC1 ticks since the start of the phase. */
+} bench_load_t;
+
+APP_TIMER_DEF(m_load_timer_id);                                         /**< CPU load sampling timer. */
+
+static ble_nus_t              m_nus;                                    /**< Structure to identify the Nordic UART Service. */
+static uint16_t               m_conn_handle = BLE_CONN_HANDLE_INVALID;  /**< Handle of the current connection. */
+static ble_gap_conn_params_t  m_conn_params;                            /**< Parameters of the current connection. */
+static uint8_t                m_stream_buffer[BENCH_STREAM_BUFFER_SIZE];/**< Stream buffer of the Nordic UART Service. */
+static uint8_t                m_data[BLE_NUS_MAX_DATA_LEN];             /**< Payload written to the stream. */
+
+static bench_phase_t          m_phase = BENCH_PHASE_IDLE;               /**< Current phase. */
+static bench_load_t           m_load;                                   /**< CPU load of the current phase. */
+static ble_nus_stream_stats_t m_stats_start;                            /**< Streaming statistics at the start of the notify phase. */
+static uint32_t               m_rx_bytes;                               /**< Bytes received in the write phase. */
+static uint32_t               m_rx_packets;                             /**< Write commands received in the write phase. */
+
+
+/**@brief Callback function for asserts in the SoftDevice.
+ *
+ * @param[in] line_num   Line number of the failing ASSERT call.
+ * @param[in] file_name  File name of the failing ASSERT call.
+ */
+void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
+{
+    app_error_handler(0xDEADBEEF, line_num, p_file_name);
+}
+
+
+/**@brief Function for starting the DWT cycle counter. */
+static void cycle_counter_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/**@brief Function for adding the cycles and ticks since the last sample to the CPU load.
+ *
+ * @details The cycle counter does not count while the CPU sleeps in sd_app_evt_wait(), so the
+ *          cycles it counts are the time spent in the application and in the SoftDevice.
+ */
+static void load_sample(void)
+{
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t ticks;
+    uint32_t diff;
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&ticks));
+    UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(ticks, m_load.last_ticks, &diff));
+
+    m_load.busy_cycles   += cycles - m_load.last_cycles;
+    m_load.elapsed_ticks += diff;
+    m_load.last_cycles    = cycles;
+    m_load.last_ticks     = ticks;
+}
+
+
+static void load_reset(void)
+{
+    load_sample();
+    m_load.busy_cycles   = 0;
+    m_load.elapsed_ticks = 0;
+}
+
+
+/**@brief Function for getting the time since the start of the phase, in milliseconds. */
+static uint32_t load_elapsed_ms(void)
+{
+    return (uint32_t)((m_load.elapsed_ticks * 1000) / APP_TIMER_FREQ);
+}
+
+
+/**@brief Function for getting the CPU load since the start of the phase, in per mille. */
+static uint32_t load_permille(void)
+{
+    if (m_load.elapsed_ticks == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)((m_load.busy_cycles * APP_TIMER_FREQ * 1000)
+                      / (m_load.elapsed_ticks * SystemCoreClock));
+}
+
+
+static void load_timer_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+    load_sample();
+}
+
+
+/**@brief Function for printing the result of a phase. */
+static void phase_print(char const * p_dir, uint32_t bytes, uint32_t packets, uint32_t stalls)
+{
+    uint32_t ms;
+
+    load_sample();
+    ms = MAX(load_elapsed_ms(), 1);
+
+    NRF_LOG_PRINTF("BENCH side=periph dir=%s interval=%u latency=%u bytes=%u ms=%u kbps=%u stall_permille=%u cpu_permille=%u\r\n",
+                   p_dir, m_conn_params.max_conn_interval, m_conn_params.slave_latency,
+                   bytes, ms, (uint32_t)(((uint64_t)bytes * 8) / ms),
+                   (packets != 0) ? (stalls * 1000) / packets : 0,
+                   load_permille());
+}
+
+
+static void notify_phase_start(void)
+{
+    ble_nus_stream_stats_get(&m_nus, &m_stats_start);
+    load_reset();
+    m_phase = BENCH_PHASE_NOTIFY;
+}
+
+
+static void notify_phase_end(void)
+{
+    ble_nus_stream_stats_t stats;
+    uint32_t               bytes;
+
+    ble_nus_stream_stats_get(&m_nus, &stats);
+    bytes = stats.bytes_sent - m_stats_start.bytes_sent;
+
+    phase_print("notify",
+                bytes,
+                CEIL_DIV(bytes, BLE_NUS_MAX_DATA_LEN),
+                stats.stall_count - m_stats_start.stall_count);
+    m_phase = BENCH_PHASE_IDLE;
+}
+
+
+static void write_phase_start(void)
+{
+    m_rx_bytes   = 0;
+    m_rx_packets = 0;
+    load_reset();
+    m_phase = BENCH_PHASE_WRITE;
+}
+
+
+static void write_phase_end(void)
+{
+    // Write commands are not acknowledged, the receiving side does not stall.
+    phase_print("write", m_rx_bytes, m_rx_packets, 0);
+    m_phase = BENCH_PHASE_IDLE;
+}
+
+
+/**@brief Function for keeping the stream buffer full during the notify phase. */
+static void stream_fill(void)
+{
+    uint32_t err_code;
+
+    while (m_phase == BENCH_PHASE_NOTIFY)
+    {
+        uint32_t len = sizeof (m_data);
+
+        err_code = ble_nus_stream_write(&m_nus, m_data, &len);
+        if (err_code == NRF_ERROR_NO_MEM)
+        {
+            return;
+        }
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for counting the data received from the central. */
+static void nus_data_handler(ble_nus_t * p_nus, uint8_t * p_data, uint16_t length)
+{
+    UNUSED_PARAMETER(p_nus);
+    UNUSED_PARAMETER(p_data);
+
+    if (m_phase == BENCH_PHASE_WRITE)
+    {
+        m_rx_bytes += length;
+        m_rx_packets++;
+    }
+}
+
+
+/**@brief Function for setting the device name and starting advertising with the UUID of the
+ *        Nordic UART Service.
+ */
+static void advertising_start(void)
+{
+    uint32_t             err_code;
+    ble_uuid_t           uuid = { .uuid = BLE_UUID_NUS_SERVICE, .type = NUS_SERVICE_UUID_TYPE };
+    ble_gap_adv_params_t adv_params;
+    uint8_t              adv_data[3 + 2 + 16];
+    uint8_t              sr_data[2 + sizeof (DEVICE_NAME) - 1];
+    uint8_t              uuid_len;
+    uint8_t              index = 0;
+
+    adv_data[index++] = 2;
+    adv_data[index++] = BLE_GAP_AD_TYPE_FLAGS;
+    adv_data[index++] = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+
+    err_code = sd_ble_uuid_encode(&uuid, &uuid_len, &adv_data[index + 2]);
+    APP_ERROR_CHECK(err_code);
+    adv_data[index++] = uuid_len + 1;
+    adv_data[index++] = BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE;
+    index += uuid_len;
+
+    sr_data[0] = sizeof (DEVICE_NAME);
+    sr_data[1] = BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME;
+    memcpy(&sr_data[2], DEVICE_NAME, sizeof (DEVICE_NAME) - 1);
+
+    err_code = sd_ble_gap_adv_data_set(adv_data, index, sr_data, sizeof (sr_data));
+    APP_ERROR_CHECK(err_code);
+
+    memset(&adv_params, 0, sizeof (adv_params));
+    adv_params.type        = BLE_GAP_ADV_TYPE_ADV_IND;
+    adv_params.fp          = BLE_GAP_ADV_FP_ANY;
+    adv_params.interval    = APP_ADV_INTERVAL;
+    adv_params.timeout     = APP_ADV_TIMEOUT_IN_SECONDS;
+
+    err_code = sd_ble_gap_adv_start(&adv_params);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for handling the Application's BLE Stack events.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void on_ble_evt(ble_evt_t * p_ble_evt)
+{
+    uint32_t err_code;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+        {
+            uint8_t tx_count = 0;
+
+            m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            m_conn_params = p_ble_evt->evt.gap_evt.params.connected.conn_params;
+
+            err_code = sd_ble_tx_packet_count_get(m_conn_handle, &tx_count);
+            APP_ERROR_CHECK(err_code);
+
+            NRF_LOG_PRINTF("BENCH side=periph connected interval=%u latency=%u tx_buffers=%u\r\n",
+                           m_conn_params.max_conn_interval, m_conn_params.slave_latency, tx_count);
+            break;
+        }
+
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE:
+            m_conn_params = p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if (m_phase == BENCH_PHASE_NOTIFY)
+            {
+                notify_phase_end();
+            }
+            else if (m_phase == BENCH_PHASE_WRITE)
+            {
+                write_phase_end();
+            }
+            m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            advertising_start();
+            break;
+
+        case BLE_GATTS_EVT_WRITE:
+        {
+            ble_gatts_evt_write_t * p_write = &p_ble_evt->evt.gatts_evt.params.write;
+
+            if ((p_write->handle == m_nus.rx_handles.cccd_handle) && (p_write->len == 2))
+            {
+                if (ble_srv_is_notification_enabled(p_write->data))
+                {
+                    notify_phase_start();
+                }
+                else if (m_phase == BENCH_PHASE_NOTIFY)
+                {
+                    notify_phase_end();
+                    write_phase_start();
+                }
+            }
+            break;
+        }
+
+        case BLE_GATTS_EVT_SYS_ATTR_MISSING:
+            err_code = sd_ble_gatts_sys_attr_set(m_conn_handle, NULL, 0, 0);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_SEC_PARAMS_REQUEST:
+            err_code = sd_ble_gap_sec_params_reply(m_conn_handle,
+                                                   BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP,
+                                                   NULL,
+                                                   NULL);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
+
+
+/**@brief Function for dispatching a BLE stack event to all modules with a BLE stack event handler.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+{
+    ble_nus_on_ble_evt(&m_nus, p_ble_evt);
+    on_ble_evt(p_ble_evt);
+}
+
+
+/**@brief Function for initializing the BLE stack.
+ *
+ * @details The peripheral keeps the default bandwidth configuration of the SoftDevice, which is
+ *          the highest one for peripheral links, so that the central side of the benchmark sets
+ *          the bandwidth of each test.
+ */
+static void ble_stack_init(void)
+{
+    uint32_t err_code;
+
+    nrf_clock_lf_cfg_t clock_lf_cfg = NRF_CLOCK_LFCLKSRC;
+
+    // Initialize the SoftDevice handler module.
+    SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
+
+    ble_enable_params_t ble_enable_params;
+    err_code = softdevice_enable_get_default_config(CENTRAL_LINK_COUNT,
+                                                    PERIPHERAL_LINK_COUNT,
+                                                    &ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Check the ram settings against the used number of links
+    CHECK_RAM_START_ADDR(CENTRAL_LINK_COUNT, PERIPHERAL_LINK_COUNT);
+
+    // Enable BLE stack.
+    err_code = softdevice_enable(&ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Register with the SoftDevice handler module for BLE events.
+    err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for initializing the Nordic UART Service with a stream buffer. */
+static void services_init(void)
+{
+    uint32_t       err_code;
+    ble_nus_init_t nus_init;
+
+    memset(&nus_init, 0, sizeof(nus_init));
+
+    nus_init.data_handler       = nus_data_handler;
+    nus_init.p_stream_buffer    = m_stream_buffer;
+    nus_init.stream_buffer_size = sizeof (m_stream_buffer);
+
+    err_code = ble_nus_init(&m_nus, &nus_init);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for starting the CPU load sampling timer. */
+static void timers_init(void)
+{
+    uint32_t err_code;
+
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
+
+    err_code = app_timer_create(&m_load_timer_id, APP_TIMER_MODE_REPEATED, load_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_load_timer_id, BENCH_LOAD_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for the application main entry. */
+int main(void)
+{
+    uint32_t err_code;
+    uint32_t i;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    for (i = 0; i < sizeof (m_data); i++)
+    {
+        m_data[i] = (uint8_t)i;
+    }
+
+    cycle_counter_start();
+    timers_init();
+    ble_stack_init();
+    services_init();
+
+    NRF_LOG_PRINTF("BENCH START side=periph name=" DEVICE_NAME "\r\n");
+    advertising_start();
+
+    for (;;)
+    {
+        stream_fill();
+
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/**
+ * @}
+ */
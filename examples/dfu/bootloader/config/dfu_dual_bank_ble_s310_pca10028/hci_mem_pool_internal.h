@@ -23,9 +23,9 @@
 #define MEM_POOL_INTERNAL_H__
 
 #define TX_BUF_SIZE       4u    /**< TX buffer size in bytes. */
-#define RX_BUF_SIZE       32u   /**< RX buffer size in bytes. */
+#define RX_BUF_SIZE       1024u /**< RX buffer size in bytes. Firmware data is written to flash in units of this size, one flash page on nRF51. */
 
-#define RX_BUF_QUEUE_SIZE 8u    /**< RX buffer element size. */
+#define RX_BUF_QUEUE_SIZE 4u    /**< RX buffer element size. Number of RX buffers being received into or written to flash at the same time. */
 
 #endif // MEM_POOL_INTERNAL_H__
  
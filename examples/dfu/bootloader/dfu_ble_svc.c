@@ -16,33 +16,34 @@
 #include "crc16.h"
 
 #if defined ( __CC_ARM )
-static dfu_ble_peer_data_t m_peer_data __attribute__((section("NoInit"), zero_init));            /**< This variable should be placed in a non initialized RAM section in order to be valid upon soft reset from application into bootloader. */
-static uint16_t            m_peer_data_crc __attribute__((section("NoInit"), zero_init));        /**< CRC variable to ensure the integrity of the peer data provided. */
+static dfu_ble_peer_data_t  m_peer_data __attribute__((section("NoInit"), zero_init));            /**< This variable should be placed in a non initialized RAM section in order to be valid upon soft reset from application into bootloader. */
+static uint16_t             m_peer_data_crc __attribute__((section("NoInit"), zero_init));        /**< CRC variable to ensure the integrity of the peer data provided. */
+static dfu_ble_gatt_cache_t m_gatt_cache __attribute__((section("NoInit"), zero_init));           /**< GATT cache provided by the application, in a non initialized RAM section like the peer data. */
+static uint16_t             m_gatt_cache_crc __attribute__((section("NoInit"), zero_init));       /**< CRC variable to ensure the integrity of the GATT cache provided. */
 #elif defined ( __GNUC__ )
-__attribute__((section(".noinit"))) static dfu_ble_peer_data_t m_peer_data;                      /**< This variable should be placed in a non initialized RAM section in order to be valid upon soft reset from application into bootloader. */
-__attribute__((section(".noinit"))) static uint16_t            m_peer_data_crc;                  /**< CRC variable to ensure the integrity of the peer data provided. */
+__attribute__((section(".noinit"))) static dfu_ble_peer_data_t  m_peer_data;                      /**< This variable should be placed in a non initialized RAM section in order to be valid upon soft reset from application into bootloader. */
+__attribute__((section(".noinit"))) static uint16_t             m_peer_data_crc;                  /**< CRC variable to ensure the integrity of the peer data provided. */
+__attribute__((section(".noinit"))) static dfu_ble_gatt_cache_t m_gatt_cache;                     /**< GATT cache provided by the application, in a non initialized RAM section like the peer data. */
+__attribute__((section(".noinit"))) static uint16_t             m_gatt_cache_crc;                 /**< CRC variable to ensure the integrity of the GATT cache provided. */
 #elif defined ( __ICCARM__ )
-__no_init static dfu_ble_peer_data_t m_peer_data     @ 0x20003F80;                               /**< This variable should be placed in a non initialized RAM section in order to be valid upon soft reset from application into bootloader. */
-__no_init static uint16_t            m_peer_data_crc @ 0x20003F80 + sizeof(dfu_ble_peer_data_t); /**< CRC variable to ensure the integrity of the peer data provided. */
+__no_init static dfu_ble_peer_data_t  m_peer_data      @ 0x20003F80;                                /**< This variable should be placed in a non initialized RAM section in order to be valid upon soft reset from application into bootloader. */
+__no_init static uint16_t             m_peer_data_crc  @ 0x20003F80 + sizeof(dfu_ble_peer_data_t);  /**< CRC variable to ensure the integrity of the peer data provided. */
+__no_init static dfu_ble_gatt_cache_t m_gatt_cache     @ 0x20003FC0;                                /**< GATT cache provided by the application, in a non initialized RAM section like the peer data. */
+__no_init static uint16_t             m_gatt_cache_crc @ 0x20003FC0 + sizeof(dfu_ble_gatt_cache_t); /**< CRC variable to ensure the integrity of the GATT cache provided. */
 #endif
 
 
-/**@brief Function for setting the peer data from application in bootloader before reset.
+/**@brief Function for copying data from application into a non initialized RAM variable.
  *
- * @param[in] p_peer_data  Pointer to the peer data containing keys for the connection.
+ * @details The data of the application may reside where the variables of the bootloader are
+ *          placed, so the copy handles overlapping source and destination.
  *
- * @retval NRF_SUCCES      The data was set succesfully.
- * @retval NRF_ERROR_NULL  If a null pointer was passed as argument.
+ * @param[in] dst  Address of the bootloader variable.
+ * @param[in] src  Address of the data from application.
+ * @param[in] size Size of the data.
  */
-static uint32_t dfu_ble_peer_data_set(dfu_ble_peer_data_t * p_peer_data)
+static void noinit_copy(uint32_t dst, uint32_t src, uint32_t size)
 {
-    if (p_peer_data == NULL)
-    {
-        return NRF_ERROR_NULL;
-    }
-
-    uint32_t src = (uint32_t)p_peer_data;
-    uint32_t dst = (uint32_t)&m_peer_data;
     // Calculating length in order to check if destination is residing inside source.
     // Source inside the the destination (calculation underflow) is safe a source is read before 
     // written to destination so that when destination grows into source, the source data is no 
@@ -51,28 +52,74 @@ static uint32_t dfu_ble_peer_data_set(dfu_ble_peer_data_t * p_peer_data)
 
     if (src == dst)
     {
-        // Do nothing as source and destination are identical, just calculate crc below.
+        // Do nothing as source and destination are identical.
     }
-    else if (len < sizeof(dfu_ble_peer_data_t))
+    else if (len < size)
     {
         uint32_t i = 0;
 
-        dst += sizeof(dfu_ble_peer_data_t);
-        src += sizeof(dfu_ble_peer_data_t);
+        dst += size;
+        src += size;
 
         // Copy byte wise backwards when facing overlapping structures.
-        while (i++ <= sizeof(dfu_ble_peer_data_t))
+        while (i++ <= size)
         {
             *((uint8_t *)dst--) = *((uint8_t *)src--);
         }
     }
     else
     {
-        memcpy((void *)dst, (void *)src, sizeof(dfu_ble_peer_data_t));
+        memcpy((void *)dst, (void *)src, size);
     }
+}
+
+
+/**@brief Function for setting the peer data from application in bootloader before reset.
+ *
+ * @details A GATT cache set before belongs to an earlier handoff, and is invalidated.
+ *
+ * @param[in] p_peer_data  Pointer to the peer data containing keys for the connection.
+ *
+ * @retval NRF_SUCCES      The data was set succesfully.
+ * @retval NRF_ERROR_NULL  If a null pointer was passed as argument.
+ */
+static uint32_t dfu_ble_peer_data_set(dfu_ble_peer_data_t * p_peer_data)
+{
+    if (p_peer_data == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    noinit_copy((uint32_t)&m_peer_data, (uint32_t)p_peer_data, sizeof(dfu_ble_peer_data_t));
 
     m_peer_data_crc = crc16_compute((uint8_t *)&m_peer_data, sizeof(m_peer_data), NULL);
 
+    m_gatt_cache_crc = crc16_compute((uint8_t *)&m_gatt_cache, sizeof(m_gatt_cache), NULL) + 1;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for setting the GATT cache from application in bootloader before reset.
+ *
+ * @details The GATT cache must be set after the peer data.
+ *
+ * @param[in] p_gatt_cache Pointer to the handles of the DFU Service in the application.
+ *
+ * @retval NRF_SUCCES      The data was set succesfully.
+ * @retval NRF_ERROR_NULL  If a null pointer was passed as argument.
+ */
+static uint32_t dfu_ble_gatt_cache_set(dfu_ble_gatt_cache_t * p_gatt_cache)
+{
+    if (p_gatt_cache == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    noinit_copy((uint32_t)&m_gatt_cache, (uint32_t)p_gatt_cache, sizeof(dfu_ble_gatt_cache_t));
+
+    m_gatt_cache_crc = crc16_compute((uint8_t *)&m_gatt_cache, sizeof(m_gatt_cache), NULL);
+
     return NRF_SUCCESS;
 }
 
@@ -97,6 +144,10 @@ void C_SVC_Handler(uint8_t svc_num, uint32_t * p_svc_args)
             p_svc_args[0] = dfu_ble_peer_data_set((dfu_ble_peer_data_t *)p_svc_args[0]);
             break;
 
+        case DFU_BLE_SVC_GATT_CACHE_SET:
+            p_svc_args[0] = dfu_ble_gatt_cache_set((dfu_ble_gatt_cache_t *)p_svc_args[0]);
+            break;
+
         default:
             p_svc_args[0] = NRF_ERROR_SVC_HANDLER_MISSING;
             break;
@@ -203,3 +254,27 @@ uint32_t dfu_ble_peer_data_get(dfu_ble_peer_data_t * p_peer_data)
 
     return NRF_SUCCESS;
 }
+
+
+uint32_t dfu_ble_gatt_cache_get(dfu_ble_gatt_cache_t * p_gatt_cache)
+{
+    uint16_t crc;
+
+    if (p_gatt_cache == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    crc = crc16_compute((uint8_t *)&m_gatt_cache, sizeof(m_gatt_cache), NULL);
+    if (crc != m_gatt_cache_crc)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    *p_gatt_cache = m_gatt_cache;
+
+    // corrupt CRC to invalidate shared information.
+    m_gatt_cache_crc++;
+
+    return NRF_SUCCESS;
+}
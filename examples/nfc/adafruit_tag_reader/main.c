@@ -25,10 +25,12 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "nrf_delay.h"
 #include "app_error.h"
 #include "app_trace.h"
+#include "nordic_common.h"
 #include "bsp.h"
 
 #include "adafruit_pn532.h"
@@ -45,6 +47,12 @@
 #define TAG_TYPE_2_DATA_AREA_SIZE_OFFSET    T2T_CC_BLOCK_OFFSET + 2 /// Offset of the byte with Tag's Data size.
 #define TAG_TYPE_2_DATA_AREA_MULTIPLICATOR  8                       /// Multiplicator for a value stored in the Tag's Data size byte.
 
+#define TAG_TYPE_2_READ_SIZE                16                      /// Number of bytes returned by a READ command.
+
+#ifndef TAG_TYPE_2_FAST_READ_ENABLED
+#define TAG_TYPE_2_FAST_READ_ENABLED        0                       /// Read the data area with FAST_READ commands. Only NTAG21x tags support them.
+#endif
+
 
 /**
  * @brief Function for initializations not directly related to Adafruit.
@@ -58,10 +66,11 @@ void utils_setup(void)
 
 
 /**
- * @brief Function for reading data from a Tag.
+ * @brief Function for reading the header of a Tag.
  *
- * This function waits for a Tag to appear in the field. When a Tag is detected, all of the pages
- * within a Tag are read.
+ * This function waits for a Tag to appear in the field. When a Tag is detected, the pages
+ * holding the Tag header are read. The pages of the data area are read later, while they are
+ * parsed.
  */
 ret_code_t tag_data_read(uint8_t * buffer, uint32_t buffer_size)
 {
@@ -115,18 +124,50 @@ ret_code_t tag_data_read(uint8_t * buffer, uint32_t buffer_size)
         return NRF_ERROR_NO_MEM;
     }
 
-    uint8_t pages_to_read = data_bytes_in_tag / T2T_BLOCK_SIZE;
-    for (i = 0; i < pages_to_read; i++)
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Function for reading the next pages of a Tag.
+ *
+ * This function reads as many pages as a single command can return: 4 pages with READ, or
+ * up to @ref NTAG2XX_FAST_READ_MAX_PAGES pages with FAST_READ.
+ *
+ * @param[in]     buffer        Pointer to the buffer for data from a Tag.
+ * @param[in]     data_end      Offset of the end of the Tag data area.
+ * @param[in,out] p_bytes_read  Number of bytes read from the Tag so far.
+ */
+ret_code_t tag_pages_read(uint8_t * buffer, uint16_t data_end, uint16_t * p_bytes_read)
+{
+    ret_code_t err_code;
+    uint8_t    page       = *p_bytes_read / T2T_BLOCK_SIZE;
+    uint16_t   bytes_left = data_end - *p_bytes_read;
+    uint16_t   length;
+
+#if TAG_TYPE_2_FAST_READ_ENABLED
+    length = MIN(bytes_left, NTAG2XX_FAST_READ_MAX_PAGES * T2T_BLOCK_SIZE);
+
+    err_code = adafruit_pn532_ntag2xx_fast_read(page,
+                                                page + length / T2T_BLOCK_SIZE - 1,
+                                                buffer + *p_bytes_read);
+#else
+    uint8_t read_buf[TAG_TYPE_2_READ_SIZE];
+
+    // READ always returns 4 pages, which may not all fit before the end of the data area.
+    length = MIN(bytes_left, TAG_TYPE_2_READ_SIZE);
+
+    err_code = adafruit_pn532_tag2_read(page, read_buf);
+    memcpy(buffer + *p_bytes_read, read_buf, length);
+#endif
+
+    if (err_code)
     {
-        uint16_t offset_for_page = T2T_FIRST_DATA_BLOCK_OFFSET + 4*i;
-        err_code = adafruit_pn532_ntag2xx_read_page(i + 4, buffer + offset_for_page);
-        if (err_code)
-        {
-            app_trace_log("Failed to read page %d\r\n", i + 4);
-            return NRF_ERROR_INTERNAL;
-        }
+        app_trace_log("Failed to read page %d\r\n", page);
+        return NRF_ERROR_INTERNAL;
     }
 
+    *p_bytes_read += length;
+
     return NRF_SUCCESS;
 }
 
@@ -165,37 +206,61 @@ void ndef_data_analyze(tlv_block_t * p_tlv_block)
 /**
  * @brief Function for analyzing data from a Tag.
  *
- * This function parses content of a Tag and prints it out.
+ * This function parses the TLV blocks of a Tag while its pages are read, and prints out
+ * the first NDEF message found. The rest of the Tag is not read.
  */
 void tag_data_analyze(uint8_t * buffer)
 {
-    ret_code_t err_code;
-
-    // Static declaration of Type 2 Tag structure. Maximum of 10 TLV blocks can be read.
-    NFC_TYPE_2_TAG_DESC_DEF(test_1, 10);
+    ret_code_t  err_code;
+    tlv_block_t tlv_block;
+    uint16_t    offset     = T2T_FIRST_DATA_BLOCK_OFFSET;
+    uint16_t    bytes_read = T2T_FIRST_DATA_BLOCK_OFFSET;
+    uint16_t    data_end;
+
+    // Static declaration of Type 2 Tag structure. The TLV block array is not used when the
+    // TLV blocks are parsed one at a time.
+    NFC_TYPE_2_TAG_DESC_DEF(test_1, 1);
     type_2_tag_t * test_type_2_tag = &NFC_TYPE_2_TAG_DESC(test_1);
 
-    err_code = type_2_tag_parse(test_type_2_tag, buffer);
-    if (err_code == NRF_ERROR_NO_MEM)
-    {
-        app_trace_log("Not enough memory to read whole tag. Printing what've been read.\r\n");
-    }
-    else if (err_code != NRF_SUCCESS)
+    err_code = type_2_tag_header_parse(test_type_2_tag, buffer);
+    if (err_code != NRF_SUCCESS)
     {
-        app_trace_log("Error during parsing a tag. Printing what could've been read.\r\n");
+        app_trace_log("Error during parsing a tag header.\r\n");
+        return;
     }
 
-    app_trace_log("\r\n");
-    type_2_tag_printout(test_type_2_tag);
-    app_trace_log("\r\n");
-    
-    tlv_block_t * p_tlv_block = test_type_2_tag->p_tlv_block_array;
-    uint32_t i;
-    
-    for (i = 0; i < test_type_2_tag->tlv_count; i++)
+    // The size of the data area was checked against the buffer size by tag_data_read.
+    data_end = T2T_FIRST_DATA_BLOCK_OFFSET + test_type_2_tag->cc.data_area_size;
+
+    for (;;)
     {
-        ndef_data_analyze(p_tlv_block);
-        p_tlv_block++;
+        err_code = type_2_tag_tlv_next(test_type_2_tag, buffer, bytes_read, &offset, &tlv_block);
+
+        if (err_code == NRF_ERROR_INVALID_LENGTH)
+        {
+            // The block is not read completely yet, read the next pages. The parser never asks
+            // for data beyond the data area.
+            err_code = tag_pages_read(buffer, data_end, &bytes_read);
+            if (err_code != NRF_SUCCESS)
+            {
+                return;
+            }
+        }
+        else if (err_code == NRF_ERROR_NOT_FOUND)
+        {
+            app_trace_log("No NDEF message found.\r\n");
+            return;
+        }
+        else if (err_code != NRF_SUCCESS)
+        {
+            app_trace_log("Error during parsing a tag.\r\n");
+            return;
+        }
+        else if (tlv_block.tag == TLV_NDEF_MESSAGE)
+        {
+            ndef_data_analyze(&tlv_block);
+            return;
+        }
     }
 }
 
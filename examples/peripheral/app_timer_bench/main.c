@@ -0,0 +1,387 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ * @defgroup app_timer_bench_example_main main.c
+ * @{
+ * @ingroup app_timer_bench_example
+ * @brief Application timer stress benchmark application main file.
+ *
+ * This application runs @ref app_timer with 8 to 64 timers of mixed periods. Most timers are
+ * repeated; every third one is single shot and is started again from its timeout handler, which
+ * queues timer operations from the RTC1 interrupt. For each number of timers, it measures:
+ *  - the expiry jitter: for repeated timers, the difference between the time from one timeout to
+ *    the next and the period; for single shot timers, the difference between the time from the
+ *    start to the timeout and the timeout. Times are read from TIMER1, free-running at 1 MHz from
+ *    the HFXO. The RTC runs at 32768 Hz, so jitter within one RTC tick (31 us) is expected.
+ *  - the time spent in the RTC1 and SWI interrupt handlers of the module, and the latency from the
+ *    RTC1 compare event to the RTC1 handler, with the interrupt monitor of @ref nrf_drv_common,
+ *  - the peak utilization of the timer operation queues, with
+ *    @ref app_timer_op_queue_utilization_get.
+ *
+ * When built with APP_TIMER_BENCH_SCHEDULER=1, timeouts are passed through @ref app_timer_appsh to
+ * @ref app_scheduler and run in the main loop, so the jitter is the end-to-end latency from the RTC
+ * event to the handler, and the peak utilization of the scheduler queue is reported as well. Build
+ * with APP_TIMER_HEAP_SIZE defined to measure the heap backend of the module.
+ *
+ * Results are printed over RTT. Every result line starts with "BENCH" so that a test script can
+ * collect them, and fields are printed as key=value pairs; "BENCH DONE" is printed last.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "app_timer.h"
+#include "nrf_drv_common.h"
+#include "nrf_drv_ppi.h"
+#include "nrf_log.h"
+#if APP_TIMER_BENCH_SCHEDULER
+#include "app_scheduler.h"
+#include "app_timer_appsh.h"
+#endif
+
+#ifndef APP_TIMER_BENCH_SCHEDULER
+#define APP_TIMER_BENCH_SCHEDULER   0                                   /**< Pass timeouts through the scheduler. */
+#endif
+
+#if !NRF_DRV_IRQ_MONITOR_ENABLED
+#error "The benchmark needs the interrupt monitor (NRF_DRV_IRQ_MONITOR_ENABLED)."
+#endif
+
+#ifndef APP_TIMER_WITH_PROFILER
+#error "The benchmark needs the operation queue profiler of app_timer (APP_TIMER_WITH_PROFILER)."
+#endif
+
+#define BENCH_TIMERS_MAX            64                                  /**< Largest number of timers. */
+#define BENCH_RUN_MS                5000                                /**< Duration of a run. */
+#define BENCH_SINGLE_SHOT_EVERY     3                                   /**< One timer out of this many is single shot. */
+
+#define APP_TIMER_PRESCALER         0                                   /**< Value of the RTC1 PRESCALER register. */
+#define APP_TIMER_OP_QUEUE_SIZE     BENCH_TIMERS_MAX                    /**< Size of timer operation queues. All single shot timers can expire at once. */
+
+#define SCHED_MAX_EVENT_DATA_SIZE   APP_TIMER_SCHED_EVT_SIZE            /**< Maximum size of scheduler events. */
+#define SCHED_QUEUE_SIZE            BENCH_TIMERS_MAX                    /**< Maximum number of events in the scheduler queue. */
+
+#define BENCH_TIMER                 NRF_TIMER1                          /**< Free-running reference timer. TIMER2 is used by the interrupt monitor. */
+#define BENCH_TIMER_PRESCALER       4                                   /**< 16 MHz / 2^4 = 1 MHz. */
+
+#ifdef NRF52
+#define BENCH_SWI_IRQn              SWI0_EGU0_IRQn                      /**< SWI interrupt used by app_timer. */
+#else
+#define BENCH_SWI_IRQn              SWI0_IRQn                           /**< SWI interrupt used by app_timer. */
+#endif
+
+/**@brief Timer under test. */
+typedef struct
+{
+    app_timer_t       node;                 /**< Timer memory, see @ref APP_TIMER_DEF. */
+    app_timer_id_t    id;                   /**< Timer identifier, pointing to node. */
+    app_timer_mode_t  mode;                 /**< Timer mode. */
+    uint32_t          ticks;                /**< Period or timeout, in RTC ticks. */
+    uint32_t          last_us;              /**< Time of the last timeout, or of the start of a single shot timer. */
+    bool              started;              /**< last_us is valid. */
+} bench_timer_t;
+
+/**@brief Jitter statistics of a run. */
+typedef struct
+{
+    uint32_t count;                         /**< Number of measured timeouts. */
+    int32_t  min_us;                        /**< Earliest timeout. */
+    int32_t  max_us;                        /**< Latest timeout. */
+    uint64_t abs_total_us;                  /**< Sum of the absolute jitters. */
+} bench_jitter_t;
+
+/**@brief Periods of the timers, in milliseconds. Timer i uses entry i modulo the table size. */
+static const uint16_t m_periods_ms[] = { 5, 8, 13, 20, 50, 100, 250, 1000 };
+
+/**@brief Numbers of timers of the runs. */
+static const uint8_t m_timer_counts[] = { 8, 16, 32, 64 };
+
+#define BENCH_PERIOD_COUNT          (sizeof (m_periods_ms) / sizeof (m_periods_ms[0]))      /**< Number of timer periods. */
+#define BENCH_RUN_COUNT             (sizeof (m_timer_counts) / sizeof (m_timer_counts[0]))  /**< Number of runs. */
+
+static bench_timer_t           m_timers[BENCH_TIMERS_MAX];              /**< Timers under test. */
+static bench_jitter_t          m_jitter;                                /**< Jitter statistics of the current run. */
+static volatile uint32_t       m_start_errors;                          /**< Single shot timers that could not be started again. */
+static volatile bool           m_running;                               /**< A run is in progress. Timeouts after the run are ignored. */
+
+
+/**@brief Function for starting the crystal oscillators. The RTC runs from the LFXO, and the
+ *        reference timer from the HFXO.
+ */
+static void clocks_start(void)
+{
+    NRF_CLOCK->EVENTS_HFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_HFCLKSTART    = 1;
+    while (NRF_CLOCK->EVENTS_HFCLKSTARTED == 0)
+    {
+        // Do nothing.
+    }
+
+    NRF_CLOCK->LFCLKSRC            = (CLOCK_LFCLKSRC_SRC_Xtal << CLOCK_LFCLKSRC_SRC_Pos);
+    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_LFCLKSTART    = 1;
+    while (NRF_CLOCK->EVENTS_LFCLKSTARTED == 0)
+    {
+        // Do nothing.
+    }
+}
+
+
+/**@brief Function for starting the reference timer. */
+static void ref_timer_start(void)
+{
+    BENCH_TIMER->MODE        = TIMER_MODE_MODE_Timer;
+    BENCH_TIMER->BITMODE     = TIMER_BITMODE_BITMODE_32Bit;
+    BENCH_TIMER->PRESCALER   = BENCH_TIMER_PRESCALER;
+    BENCH_TIMER->TASKS_CLEAR = 1;
+    BENCH_TIMER->TASKS_START = 1;
+}
+
+
+/**@brief Function for reading the reference timer, in microseconds.
+ *
+ * @details Called from the timeout handlers and from the main loop. The capture registers are
+ *          different, so the main loop can be interrupted while reading the timer.
+ */
+static __INLINE uint32_t ref_time_get(uint8_t cc)
+{
+    BENCH_TIMER->TASKS_CAPTURE[cc] = 1;
+    return BENCH_TIMER->CC[cc];
+}
+
+
+/**@brief Function for converting RTC ticks to microseconds. */
+static uint32_t ticks_to_us(uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * 1000000 * (APP_TIMER_PRESCALER + 1)) / APP_TIMER_CLOCK_FREQ);
+}
+
+
+/**@brief Function for adding a jitter measurement.
+ *
+ * @param[in] elapsed_us  Time since the last timeout or start.
+ * @param[in] ticks       Period or timeout of the timer.
+ */
+static void jitter_add(uint32_t elapsed_us, uint32_t ticks)
+{
+    int32_t jitter = (int32_t)(elapsed_us - ticks_to_us(ticks));
+
+    if ((m_jitter.count == 0) || (jitter < m_jitter.min_us))
+    {
+        m_jitter.min_us = jitter;
+    }
+    if ((m_jitter.count == 0) || (jitter > m_jitter.max_us))
+    {
+        m_jitter.max_us = jitter;
+    }
+    m_jitter.abs_total_us += (uint32_t)((jitter < 0) ? -jitter : jitter);
+    m_jitter.count++;
+}
+
+
+/**@brief Function for handling the timeout of a timer under test.
+ *
+ * @param[in] p_context  Timer under test.
+ */
+static void bench_timeout_handler(void * p_context)
+{
+    bench_timer_t * p_timer = (bench_timer_t *)p_context;
+    uint32_t        now     = ref_time_get(0);
+
+    if (!m_running)
+    {
+        return;
+    }
+
+    if (p_timer->started)
+    {
+        jitter_add(now - p_timer->last_us, p_timer->ticks);
+    }
+
+    p_timer->last_us = now;
+    p_timer->started = true;
+
+    if (p_timer->mode == APP_TIMER_MODE_SINGLE_SHOT)
+    {
+        if (app_timer_start(p_timer->id, p_timer->ticks, p_timer) != NRF_SUCCESS)
+        {
+            m_start_errors++;
+            p_timer->started = false;
+        }
+    }
+}
+
+
+/**@brief Function for initializing the timer module, and the scheduler if it is used.
+ *
+ * @details Called before each run, so the peak queue utilizations are those of the run.
+ */
+static void modules_init(void)
+{
+#if APP_TIMER_BENCH_SCHEDULER
+    APP_SCHED_INIT(SCHED_MAX_EVENT_DATA_SIZE, SCHED_QUEUE_SIZE);
+    APP_TIMER_APPSH_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, true);
+#else
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
+#endif
+}
+
+
+/**@brief Function for creating and starting the timers of a run. */
+static void timers_start(uint8_t count)
+{
+    uint32_t err_code;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        bench_timer_t * p_timer = &m_timers[i];
+
+        memset(p_timer, 0, sizeof(bench_timer_t));
+        p_timer->id    = &p_timer->node;
+        p_timer->mode  = ((i % BENCH_SINGLE_SHOT_EVERY) == (BENCH_SINGLE_SHOT_EVERY - 1))
+                         ? APP_TIMER_MODE_SINGLE_SHOT : APP_TIMER_MODE_REPEATED;
+        p_timer->ticks = APP_TIMER_TICKS(m_periods_ms[i % BENCH_PERIOD_COUNT],
+                                         APP_TIMER_PRESCALER);
+
+        err_code = app_timer_create(&p_timer->id, p_timer->mode, bench_timeout_handler);
+        APP_ERROR_CHECK(err_code);
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        bench_timer_t * p_timer = &m_timers[i];
+
+        // Single shot timers are measured from their start.
+        if (p_timer->mode == APP_TIMER_MODE_SINGLE_SHOT)
+        {
+            p_timer->last_us = ref_time_get(1);
+            p_timer->started = true;
+        }
+        err_code = app_timer_start(p_timer->id, p_timer->ticks, p_timer);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for waiting for an event, in the main loop. */
+static void idle_wait(void)
+{
+#if APP_TIMER_BENCH_SCHEDULER
+    app_sched_execute();
+#endif
+    NRF_DRV_IRQ_MONITOR_IDLE_BEGIN();
+    __WFE();
+    NRF_DRV_IRQ_MONITOR_IDLE_END();
+}
+
+
+/**@brief Function for running the timers for @ref BENCH_RUN_MS and printing the results. */
+static void run(uint8_t count)
+{
+    uint32_t             err_code;
+    uint32_t             start;
+    nrf_drv_irq_window_t window;
+    nrf_drv_irq_stats_t  rtc_stats;
+    nrf_drv_irq_stats_t  swi_stats;
+    uint16_t             op_queue_peak;
+
+    modules_init();
+    memset(&m_jitter, 0, sizeof(m_jitter));
+    m_start_errors = 0;
+    m_running      = true;
+
+    nrf_drv_irq_monitor_window_end(NULL);
+    timers_start(count);
+
+    start = ref_time_get(1);
+    while ((ref_time_get(1) - start) < (BENCH_RUN_MS * 1000UL))
+    {
+        idle_wait();
+    }
+
+    // Timeouts still in the scheduler queue must not start their timer again.
+    m_running = false;
+    err_code  = app_timer_stop_all();
+    APP_ERROR_CHECK(err_code);
+#if APP_TIMER_BENCH_SCHEDULER
+    app_sched_execute();
+#endif
+
+    nrf_drv_irq_monitor_window_end(&window);
+    UNUSED_RETURN_VALUE(nrf_drv_irq_monitor_stats_get(RTC1_IRQn, &rtc_stats));
+    UNUSED_RETURN_VALUE(nrf_drv_irq_monitor_stats_get(BENCH_SWI_IRQn, &swi_stats));
+    op_queue_peak = app_timer_op_queue_utilization_get();
+
+    NRF_LOG_PRINTF("BENCH timers=%u timeouts=%u jitter_min_us=%d jitter_avg_abs_us=%u jitter_max_us=%d "
+                   "start_errors=%u\r\n",
+                   count, m_jitter.count, m_jitter.min_us,
+                   (m_jitter.count != 0) ? (uint32_t)(m_jitter.abs_total_us / m_jitter.count) : 0,
+                   m_jitter.max_us, m_start_errors);
+    NRF_LOG_PRINTF("BENCH timers=%u rtc1_n=%u rtc1_us=%u rtc1_max_us=%u rtc1_latency_max_us=%u "
+                   "swi_n=%u swi_us=%u swi_max_us=%u cpu_permille=%u op_queue_peak=%u\r\n",
+                   count, rtc_stats.count, rtc_stats.exec_us, rtc_stats.exec_max_us,
+                   rtc_stats.latency_max_us, swi_stats.count, swi_stats.exec_us,
+                   swi_stats.exec_max_us, window.cpu_load, op_queue_peak);
+#if APP_TIMER_BENCH_SCHEDULER && defined(APP_SCHEDULER_WITH_PROFILER)
+    NRF_LOG_PRINTF("BENCH timers=%u sched_queue_peak=%u\r\n",
+                   count, app_sched_queue_utilization_get());
+#endif
+}
+
+
+/**@brief Function for application main entry.
+ */
+int main(void)
+{
+    uint32_t err_code;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    clocks_start();
+    ref_timer_start();
+
+    err_code = nrf_drv_ppi_init();
+    APP_ERROR_CHECK(err_code);
+
+    nrf_drv_irq_monitor_init();
+    err_code = nrf_drv_irq_monitor_latency_source_set(RTC1_IRQn,
+                                                      (uint32_t)&NRF_RTC1->EVENTS_COMPARE[0]);
+    APP_ERROR_CHECK(err_code);
+
+#ifdef APP_TIMER_HEAP_SIZE
+    NRF_LOG_PRINTF("BENCH CONFIG backend=heap heap_size=%u scheduler=%u run_ms=%u\r\n",
+                   APP_TIMER_HEAP_SIZE, APP_TIMER_BENCH_SCHEDULER, BENCH_RUN_MS);
+#else
+    NRF_LOG_PRINTF("BENCH CONFIG backend=list scheduler=%u run_ms=%u\r\n",
+                   APP_TIMER_BENCH_SCHEDULER, BENCH_RUN_MS);
+#endif
+
+    for (uint32_t i = 0; i < BENCH_RUN_COUNT; i++)
+    {
+        run(m_timer_counts[i]);
+    }
+
+    NRF_LOG_PRINTF("BENCH DONE\r\n");
+
+    for (;;)
+    {
+        __WFE();
+    }
+}
+
+/** @} */
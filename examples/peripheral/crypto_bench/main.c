@@ -0,0 +1,469 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ * @defgroup crypto_bench_example_main main.c
+ * @{
+ * @ingroup crypto_bench_example
+ * @brief Crypto and checksum benchmark application main file.
+ *
+ * This application measures the cost of the checksum and crypto modules of the SDK, in CPU cycles
+ * per operation and per byte:
+ *  - @ref crc16 and @ref crc32,
+ *  - @ref sha256,
+ *  - the AES ECB peripheral through @ref nrf_ecb and through @ref nrf_drv_aes (CTR, CCM, CMAC),
+ *  - @ref ecc (micro-ecc), both for complete operations and for each step of an incremental
+ *    operation.
+ *
+ * Cycles are counted with the DWT cycle counter on Cortex-M4. The Cortex-M0 has no DWT cycle
+ * counter, so TIMER0 is used instead: it runs at 16 MHz, the core clock of nRF51, and so counts
+ * CPU cycles as well. The cost of reading the counter is measured first and subtracted.
+ *
+ * Results are printed over RTT. Every result line starts with "BENCH" so that a test script can
+ * collect them, and fields are printed as key=value pairs; "BENCH DONE" is printed last. The
+ * "BENCH CONFIG" line gives the implementations selected at build time (see @ref CRC16_IMPL,
+ * @ref CRC32_IMPL and @ref ECC_P256_COMB_TEETH), so the results of several builds can be compared.
+ * The micro-ecc library is built separately, with assembly multiplication by default; rebuild it with
+ * MICRO_ECC_ASM=0 to measure the portable C implementation.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nrf_log.h"
+#include "crc16.h"
+#include "crc32.h"
+#include "sha256.h"
+#include "nrf_ecb.h"
+#include "nrf_drv_aes.h"
+#include "nrf_drv_rng.h"
+#include "ecc.h"
+
+#define BENCH_MAX_LEN               4096                                /**< Largest data length measured. */
+#define BENCH_BYTES_PER_MEASUREMENT 16384                               /**< Data processed by each measurement. Sets the number of operations for each length. */
+#define BENCH_ECC_ITERATIONS        4                                   /**< Number of operations per ECC measurement. */
+#define BENCH_OVERHEAD_ITERATIONS   16                                  /**< Number of measurements of an empty operation, to find the cost of the measurement itself. */
+
+#define BENCH_CCM_NONCE_LEN         13                                  /**< Length of the CCM nonce. */
+#define BENCH_CCM_MIC_LEN           8                                   /**< Length of the CCM MIC. */
+
+#if (__CORTEX_M >= 3)
+#define BENCH_COUNTER_NAME          "dwt"                               /**< Name of the cycle counter, printed in the configuration line. */
+#else
+#define BENCH_COUNTER_NAME          "timer0"                            /**< Name of the cycle counter, printed in the configuration line. */
+#define BENCH_TIMER                 NRF_TIMER0                          /**< Timer used as cycle counter. */
+#endif
+
+/**@brief Cycle statistics of one measurement. */
+typedef struct
+{
+    uint32_t count;                         /**< Number of operations. */
+    uint32_t min;                           /**< Fewest cycles of an operation. */
+    uint32_t max;                           /**< Most cycles of an operation. */
+    uint64_t total;                         /**< Sum of the cycles of all operations. */
+} bench_stats_t;
+
+/**@brief Operation under test. Processes len bytes of @ref m_in. */
+typedef void (*bench_op_t)(uint32_t len);
+
+static const uint16_t m_lengths[] = { 16, 64, 256, 1024, BENCH_MAX_LEN };   /**< Data lengths measured. */
+
+static const uint8_t m_key[NRF_DRV_AES_BLOCK_SIZE] =                        /**< AES key. */
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static uint8_t  m_in[BENCH_MAX_LEN];                                        /**< Input data. */
+static uint8_t  m_out[BENCH_MAX_LEN];                                       /**< Output data. */
+static uint8_t  m_counter[NRF_DRV_AES_BLOCK_SIZE];                          /**< CTR counter block. */
+static uint8_t  m_tag[NRF_DRV_AES_BLOCK_SIZE];                              /**< CCM MIC and CMAC tag. */
+static uint32_t m_overhead;                                                 /**< Cycles taken by the measurement of an empty operation. */
+
+static uint32_t       m_sk[ECC_P256_SK_LEN / sizeof(uint32_t)];             /**< Own private key. Words for alignment. */
+static uint32_t       m_pk[ECC_P256_PK_LEN / sizeof(uint32_t)];             /**< Own public key. */
+static uint32_t       m_peer_sk[ECC_P256_SK_LEN / sizeof(uint32_t)];        /**< Peer private key. */
+static uint32_t       m_peer_pk[ECC_P256_PK_LEN / sizeof(uint32_t)];        /**< Peer public key. */
+static uint32_t       m_ss[ECC_P256_SS_LEN / sizeof(uint32_t)];             /**< Shared secret. */
+static ecc_p256_op_t  m_ecc_op;                                             /**< State of the incremental ECC operation. */
+
+
+#if (__CORTEX_M >= 3)
+
+/**@brief Function for starting the DWT cycle counter. */
+static void cycle_counter_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/**@brief Function for reading the cycle counter. */
+static __INLINE uint32_t cycles_get(void)
+{
+    return DWT->CYCCNT;
+}
+
+#else
+
+/**@brief Function for starting TIMER0 as a 32-bit counter at the 16 MHz core clock. */
+static void cycle_counter_start(void)
+{
+    BENCH_TIMER->MODE        = TIMER_MODE_MODE_Timer;
+    BENCH_TIMER->BITMODE     = TIMER_BITMODE_BITMODE_32Bit;
+    BENCH_TIMER->PRESCALER   = 0;
+    BENCH_TIMER->TASKS_CLEAR = 1;
+    BENCH_TIMER->TASKS_START = 1;
+}
+
+
+/**@brief Function for reading the cycle counter. */
+static __INLINE uint32_t cycles_get(void)
+{
+    BENCH_TIMER->TASKS_CAPTURE[0] = 1;
+    return BENCH_TIMER->CC[0];
+}
+
+#endif // (__CORTEX_M >= 3)
+
+
+static void stats_init(bench_stats_t * p_stats)
+{
+    memset(p_stats, 0, sizeof(*p_stats));
+    p_stats->min = UINT32_MAX;
+}
+
+
+static void stats_add(bench_stats_t * p_stats, uint32_t cycles)
+{
+    cycles = (cycles > m_overhead) ? (cycles - m_overhead) : 0;
+
+    p_stats->count++;
+    p_stats->total += cycles;
+    p_stats->min    = MIN(p_stats->min, cycles);
+    p_stats->max    = MAX(p_stats->max, cycles);
+}
+
+
+/**@brief Function for printing the result of a measurement.
+ *
+ * @details Cycles per byte are printed multiplied by 100, since the printf of RTT has no floating
+ *          point support.
+ *
+ * @param[in] p_name   Name of the operation.
+ * @param[in] len      Data length of each operation, 0 if the operation does not process data.
+ * @param[in] p_stats  Statistics of the measurement.
+ */
+static void stats_print(char const * p_name, uint32_t len, bench_stats_t const * p_stats)
+{
+    uint32_t avg = (uint32_t)(p_stats->total / p_stats->count);
+
+    if (len == 0)
+    {
+        NRF_LOG_PRINTF("BENCH %s n=%u cycles_min=%u cycles_avg=%u cycles_max=%u\r\n",
+                       p_name, p_stats->count, p_stats->min, avg, p_stats->max);
+    }
+    else
+    {
+        uint32_t cpb_x100 = (uint32_t)((p_stats->total * 100) / ((uint64_t)p_stats->count * len));
+
+        NRF_LOG_PRINTF("BENCH %s len=%u n=%u cycles_min=%u cycles_avg=%u cycles_max=%u "
+                       "cycles_per_byte_x100=%u\r\n",
+                       p_name, len, p_stats->count, p_stats->min, avg, p_stats->max, cpb_x100);
+    }
+}
+
+
+/**@brief Function for measuring an operation.
+ *
+ * @param[in] op          Operation.
+ * @param[in] len         Data length passed to the operation.
+ * @param[in] iterations  Number of operations.
+ * @param[out] p_stats    Statistics of the measurement.
+ */
+static void bench_measure(bench_op_t op, uint32_t len, uint32_t iterations, bench_stats_t * p_stats)
+{
+    uint32_t i;
+
+    stats_init(p_stats);
+
+    for (i = 0; i < iterations; i++)
+    {
+        uint32_t start = cycles_get();
+        op(len);
+        stats_add(p_stats, cycles_get() - start);
+    }
+}
+
+
+/**@brief Function for measuring an operation for all the data lengths and printing the results. */
+static void bench_run_lengths(char const * p_name, bench_op_t op)
+{
+    bench_stats_t stats;
+    uint32_t      i;
+
+    for (i = 0; i < sizeof(m_lengths) / sizeof(m_lengths[0]); i++)
+    {
+        uint32_t len = m_lengths[i];
+
+        bench_measure(op, len, MAX(BENCH_BYTES_PER_MEASUREMENT / len, 1), &stats);
+        stats_print(p_name, len, &stats);
+    }
+}
+
+
+static void nop_op(uint32_t len)
+{
+    UNUSED_PARAMETER(len);
+}
+
+
+static void crc16_op(uint32_t len)
+{
+    (void)crc16_compute(m_in, len, NULL);
+}
+
+
+static void crc16_ibm_op(uint32_t len)
+{
+    (void)crc16_ibm_compute(m_in, len, NULL);
+}
+
+
+static void crc32_op(uint32_t len)
+{
+    (void)crc32_compute(m_in, len, NULL);
+}
+
+
+static void sha256_op(uint32_t len)
+{
+    sha256_context_t ctx;
+    ret_code_t       err_code;
+
+    err_code = sha256_init(&ctx);
+    APP_ERROR_CHECK(err_code);
+    err_code = sha256_update(&ctx, m_in, len);
+    APP_ERROR_CHECK(err_code);
+    err_code = sha256_final(&ctx, m_out);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void ecb_op(uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i += NRF_DRV_AES_BLOCK_SIZE)
+    {
+        if (!nrf_ecb_crypt(&m_out[i], &m_in[i]))
+        {
+            APP_ERROR_CHECK(NRF_ERROR_INTERNAL);
+        }
+    }
+}
+
+
+static void aes_ctr_op(uint32_t len)
+{
+    ret_code_t err_code = nrf_drv_aes_ctr_crypt(m_key, m_counter, m_in, m_out, len);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void aes_ccm_op(uint32_t len)
+{
+    static const uint8_t nonce[BENCH_CCM_NONCE_LEN] = { 0 };
+
+    nrf_drv_aes_ccm_params_t params =
+    {
+        .p_key     = m_key,
+        .p_nonce   = nonce,
+        .nonce_len = BENCH_CCM_NONCE_LEN,
+        .mic_len   = BENCH_CCM_MIC_LEN,
+        .p_adata   = NULL,
+        .adata_len = 0,
+    };
+
+    ret_code_t err_code = nrf_drv_aes_ccm_encrypt(&params, m_in, m_out, len, m_tag);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void aes_cmac_op(uint32_t len)
+{
+    ret_code_t err_code = nrf_drv_aes_cmac(m_key, m_in, len, m_tag);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void ecc_public_key_op(uint32_t len)
+{
+    UNUSED_PARAMETER(len);
+
+    ret_code_t err_code = ecc_p256_public_key_compute((uint8_t *)m_sk, (uint8_t *)m_pk);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void ecc_shared_secret_op(uint32_t len)
+{
+    UNUSED_PARAMETER(len);
+
+    ret_code_t err_code = ecc_p256_shared_secret_compute((uint8_t *)m_sk,
+                                                         (uint8_t *)m_peer_pk,
+                                                         (uint8_t *)m_ss);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for measuring each step of the started incremental ECC operation.
+ *
+ * @details The largest step bounds the time the operation blocks the application when it is run
+ *          one step at a time.
+ */
+static void bench_ecc_steps(char const * p_name)
+{
+    bench_stats_t stats;
+    bool          done = false;
+
+    stats_init(&stats);
+
+    while (!done)
+    {
+        uint32_t   start    = cycles_get();
+        ret_code_t err_code = ecc_p256_op_run(&m_ecc_op, 1, &done);
+        stats_add(&stats, cycles_get() - start);
+        APP_ERROR_CHECK(err_code);
+    }
+
+    stats_print(p_name, 0, &stats);
+}
+
+
+static void bench_checksums(void)
+{
+    bench_run_lengths("crc16", crc16_op);
+    bench_run_lengths("crc16_ibm", crc16_ibm_op);
+    bench_run_lengths("crc32", crc32_op);
+    bench_run_lengths("sha256", sha256_op);
+}
+
+
+static void bench_aes(void)
+{
+    ret_code_t err_code;
+
+    // The ECB HAL and the AES driver share the peripheral, the driver is initialized afterwards.
+    if (!nrf_ecb_init())
+    {
+        APP_ERROR_CHECK(NRF_ERROR_INTERNAL);
+    }
+    nrf_ecb_set_key(m_key);
+    bench_run_lengths("ecb", ecb_op);
+
+    err_code = nrf_drv_aes_init(NULL, NULL);
+    APP_ERROR_CHECK(err_code);
+
+    bench_run_lengths("aes_ctr", aes_ctr_op);
+    bench_run_lengths("aes_ccm", aes_ccm_op);
+    bench_run_lengths("aes_cmac", aes_cmac_op);
+
+    nrf_drv_aes_uninit();
+}
+
+
+static void bench_ecc(void)
+{
+    bench_stats_t stats;
+    ret_code_t    err_code;
+
+    err_code = nrf_drv_rng_init(NULL);
+    APP_ERROR_CHECK(err_code);
+    ecc_init();
+
+    // Key generation waits for random numbers, so it is not measured.
+    err_code = ecc_p256_keypair_gen((uint8_t *)m_sk, (uint8_t *)m_pk);
+    APP_ERROR_CHECK(err_code);
+    err_code = ecc_p256_keypair_gen((uint8_t *)m_peer_sk, (uint8_t *)m_peer_pk);
+    APP_ERROR_CHECK(err_code);
+
+    bench_measure(ecc_public_key_op, 0, BENCH_ECC_ITERATIONS, &stats);
+    stats_print("ecc_public_key", 0, &stats);
+
+    bench_measure(ecc_shared_secret_op, 0, BENCH_ECC_ITERATIONS, &stats);
+    stats_print("ecc_shared_secret", 0, &stats);
+
+    err_code = ecc_p256_public_key_compute_start(&m_ecc_op, (uint8_t *)m_sk, (uint8_t *)m_pk);
+    APP_ERROR_CHECK(err_code);
+    bench_ecc_steps("ecc_public_key_step");
+
+    err_code = ecc_p256_shared_secret_compute_start(&m_ecc_op,
+                                                    (uint8_t *)m_sk,
+                                                    (uint8_t *)m_peer_pk,
+                                                    (uint8_t *)m_ss);
+    APP_ERROR_CHECK(err_code);
+    bench_ecc_steps("ecc_shared_secret_step");
+}
+
+
+/**@brief Function for measuring the cost of the measurement itself. */
+static void overhead_measure(void)
+{
+    bench_stats_t stats;
+
+    m_overhead = 0;
+    bench_measure(nop_op, 0, BENCH_OVERHEAD_ITERATIONS, &stats);
+    m_overhead = stats.min;
+}
+
+
+/**@brief Function for application main entry.
+ */
+int main(void)
+{
+    uint32_t err_code;
+    uint32_t i;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    for (i = 0; i < sizeof(m_in); i++)
+    {
+        m_in[i] = (uint8_t)i;
+    }
+
+    cycle_counter_start();
+    overhead_measure();
+
+    NRF_LOG_PRINTF("BENCH CONFIG cpu=cortex-m%u core_hz=%u counter=%s overhead=%u "
+                   "crc16_impl=%u crc32_impl=%u ecc_comb_teeth=%u\r\n",
+                   __CORTEX_M, SystemCoreClock, BENCH_COUNTER_NAME, m_overhead,
+                   CRC16_IMPL, CRC32_IMPL, ECC_P256_COMB_TEETH);
+    NRF_LOG_PRINTF("BENCH SELFTEST crc16=%u crc32=%u\r\n", crc16_self_test(), crc32_self_test());
+
+    bench_checksums();
+    bench_aes();
+    bench_ecc();
+
+    NRF_LOG_PRINTF("BENCH DONE\r\n");
+
+    for (;;)
+    {
+        __WFE();
+    }
+}
+
+/** @} */
@@ -0,0 +1,668 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup fds_bench_example_main main.c
+ * @{
+ * @ingroup fds_bench_example
+ * @brief Flash Data Storage benchmark application main file.
+ *
+ * This application measures @ref fds_record_write, @ref fds_record_update,
+ * @ref fds_record_find and @ref fds_gc over a set of workloads, each with its own distribution of
+ * record sizes and number of files and keys. For each workload, it:
+ *  - deletes the files of the benchmark and collects garbage, so that all workloads start from
+ *    the same state,
+ *  - writes one record for each file and key,
+ *  - updates random records with new random sizes, collecting garbage when flash is full,
+ *  - finds random records,
+ *  - collects garbage.
+ *
+ * The workloads are run once with the SoftDevice enabled but no radio activity, then again once a
+ * central has connected, so that flash operations have to share the time with connection events.
+ *
+ * For each operation, a result line gives the latency percentiles. Writes, updates and garbage
+ * collections are timed from the call to the FDS event with the RTC, in microseconds, and finds
+ * with the DWT cycle counter, in CPU cycles. For each workload, a summary line gives the number
+ * of words written to flash per 100 words of record data (write amplification) and the number of
+ * pages erased, as counted by fstorage. Results are printed over RTT. Every result line starts
+ * with "BENCH" so that a test script can collect them; "BENCH DONE" is printed last.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_hci.h"
+#include "fds.h"
+#include "fds_config.h"
+#include "fstorage.h"
+#include "softdevice_handler.h"
+#include "boards.h"
+#include "nrf_log.h"
+
+#define CENTRAL_LINK_COUNT          0                                   /**< Number of central links used by the application. */
+#define PERIPHERAL_LINK_COUNT       1                                   /**< Number of peripheral links used by the application. */
+
+#define DEVICE_NAME                 "FDS_Bench"                         /**< Name of device. Will be included in the advertising data. */
+#define APP_ADV_INTERVAL            64                                  /**< The advertising interval (in units of 0.625 ms). */
+#define APP_ADV_TIMEOUT_IN_SECONDS  0                                   /**< Advertise until a peer connects. */
+
+#define APP_TIMER_PRESCALER         0                                   /**< Value of the RTC1 PRESCALER register. */
+#define APP_TIMER_OP_QUEUE_SIZE     2                                   /**< Size of timer operation queues. */
+#define APP_TIMER_FREQ              32768                               /**< Frequency of the RTC1 counter, in Hz. */
+#define BENCH_CLOCK_INTERVAL        APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)  /**< Interval of the timer that keeps the RTC1 counter running. */
+
+#define BENCH_FILE_ID_FIRST         0x1000                              /**< File ID of the first file of the benchmark. */
+#define BENCH_KEY_FIRST             0x0001                              /**< First record key of the benchmark. */
+#define BENCH_RECORDS_MAX           32                                  /**< Largest number of files times keys of a workload. */
+#define BENCH_RECORD_MAX_WORDS      256                                 /**< Largest record size of a workload, in words. */
+#define BENCH_SAMPLES_MAX           256                                 /**< Largest number of latency samples kept for an operation. */
+#define BENCH_RANDOM_SEED           0x2545F491                          /**< Seed of the record size and key generator, so that all runs are the same. */
+
+/**@brief A workload of the benchmark.
+ *
+ * @details Record sizes are drawn uniformly from 1 to @p small_max_words words, or, with a
+ *          probability of @p large_percent, from @p small_max_words + 1 to @p large_max_words words.
+ */
+typedef struct
+{
+    char const * p_name;                    /**< Name of the workload. */
+    uint16_t     small_max_words;           /**< Largest size of a small record. */
+    uint16_t     large_max_words;           /**< Largest size of a large record. */
+    uint8_t      large_percent;             /**< Percentage of large records. */
+    uint8_t      files;                     /**< Number of files. */
+    uint8_t      keys;                      /**< Number of record keys per file. */
+    uint16_t     updates;                   /**< Number of record updates. */
+    uint16_t     finds;                     /**< Number of record searches. */
+} bench_workload_t;
+
+/**@brief A record of the current workload. */
+typedef struct
+{
+    fds_record_desc_t desc;                 /**< Descriptor of the record. */
+    bool              written;              /**< The record has been written. */
+} bench_record_t;
+
+/**@brief Latency samples of an operation. */
+typedef struct
+{
+    uint32_t count;                         /**< Number of operations, including those whose sample was not kept. */
+    uint32_t sample[BENCH_SAMPLES_MAX];     /**< Latencies. */
+} bench_samples_t;
+
+/**@brief Workloads of the benchmark. */
+static const bench_workload_t m_workloads[] =
+{
+    // Small settings records, such as those of the Peer Manager.
+    { "small", 4,  4,   0,  2, 16, 256, 256 },
+    // Mostly small records, with some larger ones.
+    { "mixed", 8,  64,  25, 4, 8,  192, 256 },
+    // Large records, such as logs or images, in few keys.
+    { "large", 64, 256, 50, 1, 4,  48,  64  },
+};
+
+#define BENCH_WORKLOAD_COUNT        (sizeof (m_workloads) / sizeof (m_workloads[0]))   /**< Number of workloads. */
+
+APP_TIMER_DEF(m_clock_timer_id);                                        /**< Timer that keeps the RTC1 counter running. */
+
+static uint16_t                m_conn_handle = BLE_CONN_HANDLE_INVALID; /**< Handle of the current connection. */
+static ble_gap_conn_params_t   m_conn_params;                           /**< Parameters of the current connection. */
+static volatile bool           m_connected;                             /**< A central is connected. */
+
+static volatile bool           m_op_pending;                            /**< An FDS operation is waiting for its event. */
+static volatile ret_code_t     m_op_result;                             /**< Result of the last FDS operation. */
+static volatile uint32_t       m_op_ticks;                              /**< Latency of the last FDS operation, in RTC ticks. */
+static uint32_t                m_op_start;                              /**< RTC1 counter value when the last FDS operation was queued. */
+
+static uint32_t                m_data[BENCH_RECORD_MAX_WORDS];          /**< Record data. */
+static bench_record_t          m_records[BENCH_RECORDS_MAX];            /**< Records of the current workload. */
+static uint32_t                m_seed;                                  /**< State of the random generator. */
+static uint32_t                m_logical_words;                         /**< Words of record data written in the current workload. */
+static uint32_t                m_no_space;                              /**< Writes which failed because flash was full, even after garbage collection. */
+
+static bench_samples_t         m_write_samples;                         /**< Latencies of fds_record_write(). */
+static bench_samples_t         m_update_samples;                        /**< Latencies of fds_record_update(). */
+static bench_samples_t         m_find_samples;                          /**< Latencies of fds_record_find(). */
+static bench_samples_t         m_gc_samples;                            /**< Latencies of fds_gc(). */
+
+
+/**@brief Callback function for asserts in the SoftDevice.
+ *
+ * @param[in] line_num   Line number of the failing ASSERT call.
+ * @param[in] file_name  File name of the failing ASSERT call.
+ */
+void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
+{
+    app_error_handler(0xDEADBEEF, line_num, p_file_name);
+}
+
+
+/**@brief Function for starting the DWT cycle counter. */
+static void cycle_counter_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/**@brief Function for getting a pseudo-random number. */
+static uint32_t random_get(void)
+{
+    m_seed = (m_seed * 1664525) + 1013904223;
+    return m_seed >> 8;
+}
+
+
+static void samples_reset(bench_samples_t * p_samples)
+{
+    p_samples->count = 0;
+}
+
+
+static void samples_add(bench_samples_t * p_samples, uint32_t value)
+{
+    if (p_samples->count < BENCH_SAMPLES_MAX)
+    {
+        p_samples->sample[p_samples->count] = value;
+    }
+    p_samples->count++;
+}
+
+
+/**@brief Function for sorting the samples and printing their percentiles. */
+static void samples_print(char const            * p_workload,
+                          char const            * p_op,
+                          char const            * p_unit,
+                          bench_samples_t       * p_samples)
+{
+    uint32_t   n = MIN(p_samples->count, BENCH_SAMPLES_MAX);
+    uint32_t * s = p_samples->sample;
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    // Insertion sort, there are few samples.
+    for (uint32_t i = 1; i < n; i++)
+    {
+        uint32_t value = s[i];
+        uint32_t j     = i;
+
+        while ((j > 0) && (s[j - 1] > value))
+        {
+            s[j] = s[j - 1];
+            j--;
+        }
+        s[j] = value;
+    }
+
+    NRF_LOG_PRINTF("BENCH workload=%s ble=%s op=%s n=%u unit=%s p50=%u p90=%u p99=%u max=%u\r\n",
+                   p_workload, m_connected ? "connected" : "idle", p_op, p_samples->count, p_unit,
+                   s[((n - 1) * 50) / 100], s[((n - 1) * 90) / 100], s[((n - 1) * 99) / 100], s[n - 1]);
+}
+
+
+/**@brief Function for handling FDS events. */
+static void fds_evt_handler(fds_evt_t const * const p_evt)
+{
+    uint32_t ticks;
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&ticks));
+    UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(ticks, m_op_start, (uint32_t *)&m_op_ticks));
+
+    m_op_result  = p_evt->result;
+    m_op_pending = false;
+}
+
+
+/**@brief Function for marking the start of an FDS operation. */
+static void op_start(void)
+{
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&m_op_start));
+    m_op_pending = true;
+}
+
+
+/**@brief Function for waiting for the event of an FDS operation.
+ *
+ * @param[in] err_code  Return value of the function that queued the operation. If it is not
+ *                      FDS_SUCCESS, no event is waited for.
+ *
+ * @return The result of the operation.
+ */
+static ret_code_t op_wait(ret_code_t err_code)
+{
+    if (err_code != FDS_SUCCESS)
+    {
+        m_op_pending = false;
+        return err_code;
+    }
+
+    while (m_op_pending)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+
+    return m_op_result;
+}
+
+
+/**@brief Function for getting the latency of the last FDS operation, in microseconds. */
+static uint32_t op_latency_us(void)
+{
+    return (uint32_t)(((uint64_t)m_op_ticks * 1000000) / APP_TIMER_FREQ);
+}
+
+
+/**@brief Function for collecting garbage. */
+static void gc_run(void)
+{
+    ret_code_t err_code;
+
+    op_start();
+    err_code = op_wait(fds_gc());
+    APP_ERROR_CHECK(err_code);
+
+    samples_add(&m_gc_samples, op_latency_us());
+}
+
+
+/**@brief Function for getting a random record size for a workload, in words. */
+static uint16_t record_size_get(bench_workload_t const * p_workload)
+{
+    if ((random_get() % 100) < p_workload->large_percent)
+    {
+        return p_workload->small_max_words + 1
+               + (random_get() % (p_workload->large_max_words - p_workload->small_max_words));
+    }
+    return 1 + (random_get() % p_workload->small_max_words);
+}
+
+
+/**@brief Function for writing or updating a record.
+ *
+ * @details If flash is full, garbage is collected and the operation is tried again once.
+ */
+static void record_store(bench_workload_t const * p_workload, uint32_t index)
+{
+    bench_record_t   * p_rec = &m_records[index];
+    fds_record_chunk_t chunk;
+    fds_record_t       record;
+    ret_code_t         err_code;
+
+    chunk.p_data       = m_data;
+    chunk.length_words = record_size_get(p_workload);
+
+    record.file_id         = BENCH_FILE_ID_FIRST + (index / p_workload->keys);
+    record.key             = BENCH_KEY_FIRST + (index % p_workload->keys);
+    record.data.p_chunks   = &chunk;
+    record.data.num_chunks = 1;
+
+    m_data[0] = random_get();
+
+    for (uint32_t attempt = 0; attempt < 2; attempt++)
+    {
+        op_start();
+        if (p_rec->written)
+        {
+            err_code = op_wait(fds_record_update(&p_rec->desc, &record));
+        }
+        else
+        {
+            err_code = op_wait(fds_record_write(&p_rec->desc, &record));
+        }
+
+        if (err_code != FDS_ERR_NO_SPACE_IN_FLASH)
+        {
+            break;
+        }
+        gc_run();
+    }
+
+    if (err_code == FDS_ERR_NO_SPACE_IN_FLASH)
+    {
+        m_no_space++;
+        return;
+    }
+    APP_ERROR_CHECK(err_code);
+
+    samples_add(p_rec->written ? &m_update_samples : &m_write_samples, op_latency_us());
+    m_logical_words += chunk.length_words;
+    p_rec->written   = true;
+}
+
+
+/**@brief Function for finding a record, timed in CPU cycles. */
+static void record_find(bench_workload_t const * p_workload, uint32_t index)
+{
+    fds_record_desc_t desc;
+    fds_find_token_t  token;
+    ret_code_t        err_code;
+    uint32_t          start;
+
+    memset(&token, 0x00, sizeof(token));
+
+    start    = DWT->CYCCNT;
+    err_code = fds_record_find(BENCH_FILE_ID_FIRST + (index / p_workload->keys),
+                               BENCH_KEY_FIRST + (index % p_workload->keys),
+                               &desc,
+                               &token);
+    samples_add(&m_find_samples, DWT->CYCCNT - start);
+
+    if ((err_code != FDS_ERR_NOT_FOUND) || m_records[index].written)
+    {
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for deleting the files of the benchmark and collecting garbage, so that the
+ *        workload starts from the same state as the others.
+ */
+static void workload_clean(void)
+{
+    ret_code_t err_code;
+
+    for (uint16_t file = 0; file < BENCH_RECORDS_MAX; file++)
+    {
+        op_start();
+        err_code = op_wait(fds_file_delete(BENCH_FILE_ID_FIRST + file));
+        APP_ERROR_CHECK(err_code);
+    }
+
+    op_start();
+    err_code = op_wait(fds_gc());
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for running a workload and printing its results. */
+static void workload_run(bench_workload_t const * p_workload)
+{
+    uint32_t   count = p_workload->files * p_workload->keys;
+    fs_stats_t stats;
+    fds_stat_t fds_stats;
+
+    APP_ERROR_CHECK_BOOL(count <= BENCH_RECORDS_MAX);
+    APP_ERROR_CHECK_BOOL(p_workload->large_max_words <= BENCH_RECORD_MAX_WORDS);
+
+    workload_clean();
+
+    memset(m_records, 0x00, sizeof(m_records));
+    samples_reset(&m_write_samples);
+    samples_reset(&m_update_samples);
+    samples_reset(&m_find_samples);
+    samples_reset(&m_gc_samples);
+    m_seed          = BENCH_RANDOM_SEED;
+    m_logical_words = 0;
+    m_no_space      = 0;
+    fs_stats_reset();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        record_store(p_workload, i);
+    }
+
+    for (uint32_t i = 0; i < p_workload->updates; i++)
+    {
+        record_store(p_workload, random_get() % count);
+    }
+
+    for (uint32_t i = 0; i < p_workload->finds; i++)
+    {
+        record_find(p_workload, random_get() % count);
+    }
+
+    gc_run();
+
+    UNUSED_RETURN_VALUE(fs_stats_get(&stats));
+    UNUSED_RETURN_VALUE(fds_stat(&fds_stats));
+
+    samples_print(p_workload->p_name, "write",  "us",     &m_write_samples);
+    samples_print(p_workload->p_name, "update", "us",     &m_update_samples);
+    samples_print(p_workload->p_name, "find",   "cycles", &m_find_samples);
+    samples_print(p_workload->p_name, "gc",     "us",     &m_gc_samples);
+
+    NRF_LOG_PRINTF("BENCH workload=%s ble=%s logical_words=%u words_written=%u wa_x100=%u pages_erased=%u no_space=%u erase_count_min=%u erase_count_max=%u\r\n",
+                   p_workload->p_name, m_connected ? "connected" : "idle",
+                   m_logical_words, stats.words_written,
+                   (m_logical_words != 0) ? (stats.words_written * 100) / m_logical_words : 0,
+                   stats.pages_erased, m_no_space,
+                   fds_stats.erase_count_min, fds_stats.erase_count_max);
+}
+
+
+static void workloads_run(void)
+{
+    for (uint32_t i = 0; i < BENCH_WORKLOAD_COUNT; i++)
+    {
+        workload_run(&m_workloads[i]);
+    }
+}
+
+
+/**@brief Function for setting the device name and starting advertising. */
+static void advertising_start(void)
+{
+    uint32_t                err_code;
+    ble_gap_conn_sec_mode_t sec_mode;
+    ble_gap_adv_params_t    adv_params;
+    uint8_t                 adv_data[3 + 2 + sizeof (DEVICE_NAME) - 1];
+    uint8_t                 index = 0;
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&sec_mode);
+    err_code = sd_ble_gap_device_name_set(&sec_mode,
+                                          (const uint8_t *)DEVICE_NAME,
+                                          strlen(DEVICE_NAME));
+    APP_ERROR_CHECK(err_code);
+
+    adv_data[index++] = 2;
+    adv_data[index++] = BLE_GAP_AD_TYPE_FLAGS;
+    adv_data[index++] = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    adv_data[index++] = sizeof (DEVICE_NAME);
+    adv_data[index++] = BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME;
+    memcpy(&adv_data[index], DEVICE_NAME, sizeof (DEVICE_NAME) - 1);
+    index += sizeof (DEVICE_NAME) - 1;
+
+    err_code = sd_ble_gap_adv_data_set(adv_data, index, NULL, 0);
+    APP_ERROR_CHECK(err_code);
+
+    memset(&adv_params, 0, sizeof (adv_params));
+    adv_params.type        = BLE_GAP_ADV_TYPE_ADV_IND;
+    adv_params.fp          = BLE_GAP_ADV_FP_ANY;
+    adv_params.interval    = APP_ADV_INTERVAL;
+    adv_params.timeout     = APP_ADV_TIMEOUT_IN_SECONDS;
+
+    err_code = sd_ble_gap_adv_start(&adv_params);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for dispatching a BLE stack event.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+{
+    uint32_t err_code;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            m_conn_params = p_ble_evt->evt.gap_evt.params.connected.conn_params;
+            m_connected   = true;
+            break;
+
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE:
+            m_conn_params = p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            NRF_LOG_PRINTF("BENCH disconnected, reason=0x%x\r\n",
+                           p_ble_evt->evt.gap_evt.params.disconnected.reason);
+            m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            break;
+
+        case BLE_GATTS_EVT_SYS_ATTR_MISSING:
+            err_code = sd_ble_gatts_sys_attr_set(m_conn_handle, NULL, 0, 0);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_SEC_PARAMS_REQUEST:
+            err_code = sd_ble_gap_sec_params_reply(m_conn_handle,
+                                                   BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP,
+                                                   NULL,
+                                                   NULL);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        default:
+            // No implementation needed.
+            break;
+    }
+}
+
+
+/**@brief Function for dispatching a system event to fstorage.
+ *
+ * @param[in] sys_evt  System stack event.
+ */
+static void sys_evt_dispatch(uint32_t sys_evt)
+{
+    fs_sys_event_handler(sys_evt);
+}
+
+
+/**@brief Function for initializing the BLE stack. */
+static void ble_stack_init(void)
+{
+    uint32_t err_code;
+
+    nrf_clock_lf_cfg_t clock_lf_cfg = NRF_CLOCK_LFCLKSRC;
+
+    // Initialize the SoftDevice handler module.
+    SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
+
+    ble_enable_params_t ble_enable_params;
+    err_code = softdevice_enable_get_default_config(CENTRAL_LINK_COUNT,
+                                                    PERIPHERAL_LINK_COUNT,
+                                                    &ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Check the ram settings against the used number of links
+    CHECK_RAM_START_ADDR(CENTRAL_LINK_COUNT, PERIPHERAL_LINK_COUNT);
+
+    // Enable BLE stack.
+    err_code = softdevice_enable(&ble_enable_params);
+    APP_ERROR_CHECK(err_code);
+
+    // Register with the SoftDevice handler module for BLE events.
+    err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+
+    // Register with the SoftDevice handler module for system events.
+    err_code = softdevice_sys_evt_handler_set(sys_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for handling the timeout of the clock timer. Nothing to do, the timer only
+ *        keeps the RTC1 counter running.
+ */
+static void clock_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+}
+
+
+/**@brief Function for starting the timer that keeps the RTC1 counter running, which is used to
+ *        time flash operations.
+ */
+static void timers_init(void)
+{
+    uint32_t err_code;
+
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
+
+    err_code = app_timer_create(&m_clock_timer_id, APP_TIMER_MODE_REPEATED, clock_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_clock_timer_id, BENCH_CLOCK_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void fds_bench_init(void)
+{
+    ret_code_t err_code;
+
+    err_code = fds_register(fds_evt_handler);
+    APP_ERROR_CHECK(err_code);
+
+    op_start();
+    err_code = op_wait(fds_init());
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for the application main entry. */
+int main(void)
+{
+    uint32_t err_code;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    cycle_counter_start();
+    timers_init();
+    ble_stack_init();
+    fds_bench_init();
+
+    NRF_LOG_PRINTF("BENCH START workloads=%u virtual_pages=%u page_words=%u\r\n",
+                   BENCH_WORKLOAD_COUNT, FDS_VIRTUAL_PAGES, FDS_VIRTUAL_PAGE_SIZE);
+    workloads_run();
+
+    NRF_LOG_PRINTF("BENCH advertising as " DEVICE_NAME ", connect to run the workloads during a connection\r\n");
+    advertising_start();
+
+    while (!m_connected)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+
+    NRF_LOG_PRINTF("BENCH connected interval=%u latency=%u\r\n",
+                   m_conn_params.max_conn_interval, m_conn_params.slave_latency);
+    workloads_run();
+
+    NRF_LOG_PRINTF("BENCH DONE\r\n");
+
+    for (;;)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,186 @@
+/* Copyright (c) 2015 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef FDS_CONFIG_H__
+#define FDS_CONFIG_H__
+
+ /**
+ * @file fds_config.h
+ *
+ * @defgroup flash_data_storage_config Configuration options
+ * @ingroup flash_data_storage
+ * @{
+ * @brief   Configuration options for FDS.
+ */
+
+/**@brief   Configures the size of the internal queue. */
+#define FDS_OP_QUEUE_SIZE           (4)
+
+/**@brief   Determines how many @ref fds_record_chunk_t structures can be buffered at any time. */
+#define FDS_CHUNK_QUEUE_SIZE        (8)
+
+/**@brief   Configures the maximum number of callbacks that can be registered. */
+#define FDS_MAX_USERS               (3)
+
+/**@brief   Configures the number of virtual flash pages to use.
+ *
+ * The total amount of flash memory that is used by FDS amounts to
+ * @ref FDS_VIRTUAL_PAGES * @ref FDS_VIRTUAL_PAGE_SIZE * 4 bytes.
+ * On nRF51 ICs, this defaults to 3 * 256 * 4 bytes = 3072 bytes.
+ * On nRF52 ICs, it defaults to 3 * 1024 * 4 bytes = 12288 bytes.
+ *
+ * One of the virtual pages is reserved by the system for garbage collection. Therefore, the
+ * minimum is two virtual pages: one page to store data and one page to be used by the system for
+ * garbage collection.
+ */
+#define FDS_VIRTUAL_PAGES           (3)
+
+/**@brief   Configures the size of a virtual page of flash memory, expressed in number of
+ *          4-byte words.
+ *
+ * By default, a virtual page is the same size as a physical page. Therefore, the default size
+ * is 1024 bytes for nRF51 ICs and 4096 bytes for nRF52 ICs.
+ *
+ * The size of a virtual page must be a multiple of the size of a physical page.
+ */
+#if   defined(NRF51)
+    #define FDS_VIRTUAL_PAGE_SIZE   (256)
+#elif defined(NRF52)
+    #define FDS_VIRTUAL_PAGE_SIZE   (1024)
+#endif
+
+/**@brief   Configures the number of entries in the RAM record index.
+ *
+ * The record index maps a file ID and record key to the location of a record in flash, so that
+ * @ref fds_record_find, @ref fds_record_find_by_key and @ref fds_record_find_in_file do not need
+ * to scan flash. Each entry takes 8 bytes of RAM. If there are more valid records than entries,
+ * searches fall back to scanning flash until the index can be rebuilt after garbage collection.
+ *
+ * Set to zero to disable the index.
+ */
+#define FDS_RECORD_INDEX_SIZE       (0)
+
+/**@brief   Configures the number of checkpoint slots kept at the end of the swap page.
+ *
+ * A checkpoint holds the write offset and the amount of dirty data of every virtual page, and
+ * the latest record ID. When a valid checkpoint is found, @ref fds_init only scans the part of
+ * each page which was written after the checkpoint was taken. A checkpoint is taken at the end
+ * of garbage collection and whenever @ref fds_checkpoint is called, for example before the
+ * device is powered off.
+ *
+ * The checkpoint slots are reserved at the end of every virtual page, which reduces the space
+ * available for records by a few words per slot. The checkpoint is protected by a CRC computed
+ * using the crc16 module, which must be included in the build.
+ *
+ * Set to zero to disable checkpoints.
+ */
+#define FDS_CHECKPOINT_SLOTS        (0)
+
+/**@brief   Enables keeping the page structures in retained RAM across System OFF.
+ *
+ * If enabled, @ref fds_retain saves the write offsets of the pages, the latest record ID and the
+ * record index to a snapshot in the .retained RAM section. When the device wakes up from
+ * System OFF, @ref fds_init restores them from the snapshot instead of scanning flash, and
+ * completes immediately. A snapshot is used by the next call to @ref fds_init only, and is
+ * discarded as soon as a new operation is queued.
+ *
+ * The RAM blocks holding the .retained section must be retained in System OFF, see
+ * @ref nrf_retained_ram_enable. The nrf_retained and crc16 modules must be included in the build.
+ *
+ * Set to one to enable, or to zero to disable.
+ */
+#define FDS_RETAINED_STATE_ENABLED  (1)
+
+/**@brief   Configures the maximum number of records that can be written in one transaction
+ *          using @ref fds_record_write_txn.
+ *
+ * The record headers of one transaction are buffered internally, which takes 13 bytes of RAM per
+ * record. Set to zero to disable transactions.
+ */
+#define FDS_TXN_MAX_RECORDS         (0)
+
+/**@brief   Enables ring files, see @ref fds_ring_init.
+ *
+ * Set to one to enable, or to zero to disable.
+ */
+#define FDS_RING_ENABLED            (0)
+
+/**@brief   Enables per-page erase counters and wear-aware page selection.
+ *
+ * If enabled, the number of times each virtual page has been erased is stored in its page tag.
+ * Records are written to the least-erased page that has room for them, garbage collection
+ * processes the least-erased pages first, and the counters are reported by @ref fds_stat.
+ *
+ * This setting changes the layout of the page tag. When changing it, the flash pages used by FDS
+ * must be erased.
+ *
+ * Set to one to enable, or to zero to disable.
+ */
+#define FDS_ERASE_COUNTERS          (0)
+
+/**@brief   Enables queueing operations while the module is initializing.
+ *
+ * If enabled, @ref fds_record_write, @ref fds_record_update, @ref fds_record_delete,
+ * @ref fds_file_delete, @ref fds_reserve and @ref fds_gc can be called as soon as @ref fds_init
+ * has returned, before @ref FDS_EVT_INIT is received. The operations are executed once the
+ * initialization has completed, so that the application does not have to wait for it to start,
+ * for example, advertising. If the initialization fails, the queued operations complete with
+ * @ref FDS_ERR_NOT_INITIALIZED. Functions that read from flash, such as @ref fds_record_find,
+ * still require the module to be initialized.
+ *
+ * Set to one to enable, or to zero to disable.
+ */
+#define FDS_LAZY_INIT               (0)
+
+/**@brief   Configures automatic garbage collection based on the amount of deleted data.
+ *
+ * Garbage collection is started automatically when the words occupied by deleted ("dirty")
+ * records reach this percentage of the words written to the data pages. Garbage collection is
+ * started once no operations have been queued for @ref FDS_AUTO_GC_IDLE_MS milliseconds.
+ *
+ * Set to zero to disable.
+ */
+#define FDS_AUTO_GC_DIRTY_PERCENT   (0)
+
+/**@brief   Configures automatic garbage collection based on the free space left in flash.
+ *
+ * Garbage collection is started automatically, as soon as the queue is empty, when fewer than
+ * this many words are free across all data pages and there are deleted records to reclaim.
+ * Garbage collection is also started when a write fails with @ref FDS_ERR_NO_SPACE_IN_FLASH.
+ *
+ * Set to zero to disable.
+ */
+#define FDS_AUTO_GC_FREE_WORDS_MIN  (0)
+
+/**@brief   Configures for how long, in milliseconds, no operations must have been queued before
+ *          garbage collection is started because of @ref FDS_AUTO_GC_DIRTY_PERCENT.
+ *
+ * If non-zero, FDS uses a timer from the app_timer module, which must be initialized before
+ * @ref fds_init is called and included in the build. Set to zero to start garbage collection as
+ * soon as the queue is empty.
+ */
+#define FDS_AUTO_GC_IDLE_MS         (0)
+
+/**@brief   The RTC1 prescaler that the app_timer module was initialized with.
+ *
+ * Only used if @ref FDS_AUTO_GC_IDLE_MS is non-zero.
+ */
+#define FDS_AUTO_GC_TIMER_PRESCALER (0)
+
+/**@brief   The number of pages garbage collected before automatic garbage collection lets other
+ *          queued operations run. See @ref fds_gc_step.
+ */
+#define FDS_AUTO_GC_PAGES_PER_STEP  (1)
+
+/** @} */
+
+#endif // FDS_CONFIG_H__
@@ -0,0 +1,29 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef SDK_CONFIG_H__
+#define SDK_CONFIG_H__
+
+/* Memory Manager pools of the host benchmark. */
+#define MEMORY_MANAGER_SMALL_BLOCK_COUNT    8
+#define MEMORY_MANAGER_SMALL_BLOCK_SIZE     32
+#define MEMORY_MANAGER_MEDIUM_BLOCK_COUNT   8
+#define MEMORY_MANAGER_MEDIUM_BLOCK_SIZE    128
+#define MEMORY_MANAGER_LARGE_BLOCK_COUNT    8
+#define MEMORY_MANAGER_LARGE_BLOCK_SIZE     256
+
+/* The benchmark runs in thread mode only, so it uses a single Memory Manager cache context. */
+#define MEM_MANAGER_CACHE_SIZE              4
+#define MEM_MANAGER_CACHE_CONTEXT_COUNT     1
+#define MEM_MANAGER_CACHE_CONTEXT_GET()     0
+
+#endif // SDK_CONFIG_H__
@@ -0,0 +1,919 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ *
+ * @defgroup host_bench_example_main main.c
+ * @{
+ * @ingroup host_bench_example
+ * @brief Host benchmark application main file.
+ *
+ * This application runs on the host, with the simulation of @ref nrf_sim, and benchmarks:
+ *  - FDS: record writes, updates and garbage collection. Latencies are measured in simulated
+ *    time, with the write and erase timing of the NVMC. The flash statistics give the write
+ *    amplification, the number of erases and the largest erase count of a page, and check
+ *    that words are not written more often than allowed between two erases. The page structures
+ *    are then saved to retained RAM, see @ref FDS_RETAINED_STATE_ENABLED.
+ *  - app_timer: lateness of the timeouts of a repeated timer, of single shot timers and of a
+ *    timer restarted with @ref app_timer_batch_execute while no other timer runs, in RTC ticks of
+ *    simulated time. The restarted timer must not be late.
+ *  - app_scheduler, app_fifo, mem_manager, crc16, crc32, sha256, the Eddystone ephemeral ID and the
+ *    NDEF Text record encoder and message parser: throughput, in nanoseconds of host time per
+ *    operation. The ephemeral IDs rotated to from precomputed ones are checked against computed
+ *    ones.
+ *
+ * Results in simulated time are the same on every run. Results in host time vary with the host;
+ * for deterministic profiles, run the application under valgrind --tool=callgrind or perf.
+ * Every result line starts with "BENCH" so that a test script can collect them; "BENCH DONE" is
+ * printed last. The exit status is non-zero if an error occurred.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_fifo.h"
+#include "app_scheduler.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "ble_eddystone_eid.h"
+#include "crc16.h"
+#include "crc32.h"
+#include "fds.h"
+#include "fds_config.h"
+#include "fstorage.h"
+#include "mem_manager.h"
+#include "nrf_delay.h"
+#include "nfc_ndef_msg.h"
+#include "nfc_ndef_msg_parser.h"
+#include "nfc_text_rec.h"
+#include "sha256.h"
+#include "softdevice_handler.h"
+#include "boards.h"
+#include "nrf_sim.h"
+
+#define APP_TIMER_PRESCALER         0                                   /**< Value of the RTC1 PRESCALER register. */
+#define APP_TIMER_OP_QUEUE_SIZE     8                                   /**< Size of timer operation queues. */
+
+#define BENCH_FILE_ID               0x1000                              /**< File ID of the records of the benchmark. */
+#define BENCH_KEY_FIRST             0x0001                              /**< First record key of the benchmark. */
+#define BENCH_RECORDS               24                                  /**< Number of records of the FDS benchmark. */
+#define BENCH_RECORD_MAX_WORDS      64                                  /**< Largest record size of the FDS benchmark, in words. */
+#define BENCH_UPDATES               600                                 /**< Number of record updates of the FDS benchmark. */
+#define BENCH_SAMPLES_MAX           BENCH_UPDATES                       /**< Largest number of latency samples kept for an operation. */
+#define BENCH_RANDOM_SEED           0x2545F491                          /**< Seed of the pseudo-random generator, so that all runs are the same. */
+
+#define BENCH_COUNTER_MASK          0x00FFFFFF                          /**< Mask of the RTC1 counter value. */
+#define BENCH_TIMER_INTERVAL        APP_TIMER_TICKS(10, APP_TIMER_PRESCALER)   /**< Interval of the repeated timer. */
+#define BENCH_TIMER_TIMEOUTS        1000                                /**< Number of timeouts of the repeated timer. */
+#define BENCH_SINGLE_SHOT_TIMERS    4                                   /**< Number of single shot timers. */
+#define BENCH_SINGLE_SHOT_ROUNDS    250                                 /**< Number of times each single shot timer is started. */
+#define BENCH_RESTART_ROUNDS        100                                 /**< Number of times the only running timer is restarted in a batch. */
+#define BENCH_RESTART_TIMEOUT       1000                                /**< Time-out of the timer before it is restarted, in RTC ticks. */
+#define BENCH_TICKS_TO_US(TICKS)    (((uint64_t)(TICKS) * 1000000) / APP_TIMER_CLOCK_FREQ)  /**< Converts RTC ticks to microseconds. */
+#define BENCH_US_TO_TICKS(US)       (((uint64_t)(US) * APP_TIMER_CLOCK_FREQ) / 1000000)     /**< Converts microseconds to RTC ticks. */
+#define BENCH_RESTART_LATE_MAX      2                                   /**< Largest allowed lateness of the restarted timer, in RTC ticks. */
+
+#define BENCH_SCHED_EVENTS          16                                  /**< Size of the scheduler queue. */
+#define BENCH_DATA_SIZE             4096                                /**< Size of the data of the throughput benchmarks, in bytes. */
+#define BENCH_ITERATIONS            2000                                /**< Number of iterations of the throughput benchmarks. */
+#define BENCH_EID_K                 10                                  /**< Rotation period exponent of the ephemeral ID. */
+
+/**@brief Latency samples of an operation. */
+typedef struct
+{
+    uint32_t count;                         /**< Number of operations, including those whose sample was not kept. */
+    uint32_t sample[BENCH_SAMPLES_MAX];     /**< Latencies. */
+} bench_samples_t;
+
+/**@brief Record of the FDS benchmark. */
+typedef struct
+{
+    fds_record_desc_t desc;                 /**< Descriptor of the record. */
+    bool              written;              /**< The record has been written. */
+} bench_record_t;
+
+APP_TIMER_DEF(m_repeated_timer_id);                                     /**< Repeated timer of the timer benchmark. */
+APP_TIMER_DEF(m_restart_timer_id);                                      /**< Timer restarted in a batch. */
+APP_TIMER_DEF(m_single_shot_timer_id_0);                                /**< Single shot timers of the timer benchmark. */
+APP_TIMER_DEF(m_single_shot_timer_id_1);
+APP_TIMER_DEF(m_single_shot_timer_id_2);
+APP_TIMER_DEF(m_single_shot_timer_id_3);
+
+static app_timer_id_t const * const m_single_shot_timer_ids[BENCH_SINGLE_SHOT_TIMERS] =
+{
+    &m_single_shot_timer_id_0, &m_single_shot_timer_id_1,
+    &m_single_shot_timer_id_2, &m_single_shot_timer_id_3,
+};
+
+static volatile bool       m_op_pending;                                /**< An FDS operation is waiting for its event. */
+static volatile ret_code_t m_op_result;                                 /**< Result of the last FDS operation. */
+static uint64_t            m_op_start;                                  /**< Simulated time when the last FDS operation was queued. */
+static uint64_t            m_op_end;                                    /**< Simulated time of the event of the last FDS operation. */
+
+static uint32_t            m_data[BENCH_RECORD_MAX_WORDS];              /**< Record data. */
+static bench_record_t      m_records[BENCH_RECORDS];                    /**< Records of the FDS benchmark. */
+static uint32_t            m_seed = BENCH_RANDOM_SEED;                  /**< State of the random generator. */
+static bench_samples_t     m_samples;                                   /**< Latency samples of the current benchmark. */
+
+static volatile uint32_t   m_timeouts;                                  /**< Number of timeouts of the current timer benchmark. */
+static uint32_t            m_expected[BENCH_SINGLE_SHOT_TIMERS];        /**< RTC1 counter value at which each timer should expire. */
+static volatile bool       m_expired[BENCH_SINGLE_SHOT_TIMERS];         /**< The single shot timer has expired and can be started again. */
+static uint64_t            m_restart_expected_us;                       /**< Simulated time at which the restarted timer should expire. */
+
+static uint8_t             m_buffer[BENCH_DATA_SIZE];                   /**< Data of the throughput benchmarks. */
+static volatile uint32_t   m_sink;                                      /**< Results of the throughput benchmarks, so that they are not optimized away. */
+
+
+/**@brief Function for handling fatal errors: the error is printed, and the simulation ends. */
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    error_info_t const * p_info = (error_info_t const *)(uintptr_t)info;
+
+    fflush(stdout);
+    if (id == NRF_FAULT_ID_SDK_ERROR)
+    {
+        fprintf(stderr, "BENCH ERROR 0x%x at %s:%u\n", (unsigned)p_info->err_code,
+                (p_info->p_file_name != NULL) ? (char const *)p_info->p_file_name : "?",
+                (unsigned)p_info->line_num);
+    }
+    else
+    {
+        fprintf(stderr, "BENCH ERROR fault 0x%x pc 0x%x info 0x%x\n",
+                (unsigned)id, (unsigned)pc, (unsigned)info);
+    }
+    exit(EXIT_FAILURE);
+}
+
+
+/**@brief Function for getting a pseudo-random number. */
+static uint32_t random_get(void)
+{
+    m_seed = (m_seed * 1664525) + 1013904223;
+    return m_seed >> 8;
+}
+
+
+/**@brief Function for reading the host time, in nanoseconds. */
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+
+static void samples_reset(void)
+{
+    m_samples.count = 0;
+}
+
+
+static void samples_add(uint32_t value)
+{
+    if (m_samples.count < BENCH_SAMPLES_MAX)
+    {
+        m_samples.sample[m_samples.count] = value;
+    }
+    m_samples.count++;
+}
+
+
+static int samples_compare(void const * p_a, void const * p_b)
+{
+    uint32_t const a = *(uint32_t const *)p_a;
+    uint32_t const b = *(uint32_t const *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+
+/**@brief Function for sorting the samples and printing their percentiles. */
+static void samples_print(char const * p_bench, char const * p_op, char const * p_unit)
+{
+    uint32_t   n = MIN(m_samples.count, BENCH_SAMPLES_MAX);
+    uint32_t * s = m_samples.sample;
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    qsort(s, n, sizeof(s[0]), samples_compare);
+
+    printf("BENCH bench=%s op=%s n=%u unit=%s p50=%u p90=%u p99=%u max=%u\n",
+           p_bench, p_op, (unsigned)m_samples.count, p_unit,
+           (unsigned)s[((n - 1) * 50) / 100], (unsigned)s[((n - 1) * 90) / 100],
+           (unsigned)s[((n - 1) * 99) / 100], (unsigned)s[n - 1]);
+}
+
+
+/**@brief Function for getting the largest sample. The samples must have been printed. */
+static uint32_t samples_max_get(void)
+{
+    uint32_t n = MIN(m_samples.count, BENCH_SAMPLES_MAX);
+
+    return (n == 0) ? 0 : m_samples.sample[n - 1];
+}
+
+
+/**@brief Function for printing the result of a throughput benchmark. */
+static void throughput_print(char const * p_bench, uint32_t ops, uint32_t bytes, uint64_t ns)
+{
+    printf("BENCH bench=%s ops=%u bytes=%u ns_per_op=%u\n",
+           p_bench, (unsigned)ops, (unsigned)bytes, (unsigned)(ns / ops));
+}
+
+
+/**@brief Function for handling FDS events. */
+static void fds_evt_handler(fds_evt_t const * const p_evt)
+{
+    m_op_end     = nrf_sim_time_get();
+    m_op_result  = p_evt->result;
+    m_op_pending = false;
+}
+
+
+/**@brief Function for marking the start of an FDS operation. */
+static void op_start(void)
+{
+    m_op_start   = nrf_sim_time_get();
+    m_op_pending = true;
+}
+
+
+/**@brief Function for waiting for the event of an FDS operation.
+ *
+ * @param[in] err_code  Return value of the function that queued the operation. If it is not
+ *                      FDS_SUCCESS, no event is waited for.
+ *
+ * @return The result of the operation.
+ */
+static ret_code_t op_wait(ret_code_t err_code)
+{
+    if (err_code != FDS_SUCCESS)
+    {
+        m_op_pending = false;
+        return err_code;
+    }
+
+    while (m_op_pending)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+
+    return m_op_result;
+}
+
+
+/**@brief Function for getting the latency of the last FDS operation, in microseconds. */
+static uint32_t op_latency_us(void)
+{
+    return (uint32_t)(m_op_end - m_op_start);
+}
+
+
+/**@brief Function for writing or updating a record, collecting garbage if flash is full.
+ *
+ * @return The number of garbage collections.
+ */
+static uint32_t record_store(uint32_t index)
+{
+    bench_record_t   * p_rec = &m_records[index];
+    fds_record_chunk_t chunk;
+    fds_record_t       record;
+    ret_code_t         err_code;
+    uint32_t           gc_count = 0;
+
+    chunk.p_data       = m_data;
+    chunk.length_words = (uint16_t)(1 + (random_get() % BENCH_RECORD_MAX_WORDS));
+
+    record.file_id         = BENCH_FILE_ID;
+    record.key             = (uint16_t)(BENCH_KEY_FIRST + index);
+    record.data.p_chunks   = &chunk;
+    record.data.num_chunks = 1;
+
+    m_data[0] = random_get();
+
+    for (;;)
+    {
+        op_start();
+        if (p_rec->written)
+        {
+            err_code = op_wait(fds_record_update(&p_rec->desc, &record));
+        }
+        else
+        {
+            err_code = op_wait(fds_record_write(&p_rec->desc, &record));
+        }
+        if ((err_code != FDS_ERR_NO_SPACE_IN_FLASH) || (gc_count != 0))
+        {
+            break;
+        }
+
+        op_start();
+        err_code = op_wait(fds_gc());
+        APP_ERROR_CHECK(err_code);
+        gc_count++;
+    }
+    APP_ERROR_CHECK(err_code);
+
+    if (p_rec->written)
+    {
+        samples_add(op_latency_us());
+    }
+    p_rec->written = true;
+
+    return gc_count;
+}
+
+
+/**@brief Function for benchmarking FDS on the simulated flash. */
+static void fds_bench(void)
+{
+    nrf_sim_nvmc_stats_t stats;
+    ret_code_t           err_code;
+    uint32_t             live_words    = 0;
+    uint32_t             gc_count      = 0;
+    uint32_t             erase_max     = 0;
+    uint64_t             start;
+
+    err_code = fds_register(fds_evt_handler);
+    APP_ERROR_CHECK(err_code);
+
+    op_start();
+    err_code = op_wait(fds_init());
+    APP_ERROR_CHECK(err_code);
+
+    // Start from the same state on every run, also with a flash backing file.
+    op_start();
+    err_code = op_wait(fds_file_delete(BENCH_FILE_ID));
+    APP_ERROR_CHECK(err_code);
+    op_start();
+    err_code = op_wait(fds_gc());
+    APP_ERROR_CHECK(err_code);
+
+    nrf_sim_nvmc_stats_reset();
+    samples_reset();
+    start = nrf_sim_time_get();
+
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++)
+    {
+        gc_count += record_store(i);
+    }
+    for (uint32_t i = 0; i < BENCH_UPDATES; i++)
+    {
+        gc_count += record_store(random_get() % BENCH_RECORDS);
+    }
+    samples_print("fds", "update", "us");
+
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++)
+    {
+        fds_flash_record_t flash_record;
+
+        err_code = fds_record_open(&m_records[i].desc, &flash_record);
+        APP_ERROR_CHECK(err_code);
+        live_words += flash_record.p_header->tl.length_words;
+        err_code = fds_record_close(&m_records[i].desc);
+        APP_ERROR_CHECK(err_code);
+    }
+
+    samples_reset();
+    op_start();
+    err_code = op_wait(fds_gc());
+    APP_ERROR_CHECK(err_code);
+    samples_add(op_latency_us());
+    samples_print("fds", "gc", "us");
+
+    nrf_sim_nvmc_stats_get(&stats);
+    for (uint32_t page = 0; page < NRF_SIM_FLASH_PAGES; page++)
+    {
+        erase_max = MAX(erase_max, nrf_sim_nvmc_erase_count_get(page));
+    }
+
+    printf("BENCH bench=fds sim_ms=%u live_words=%u words_written=%u pages_erased=%u gc=%u "
+           "erase_count_max=%u flash_busy_ms=%u overwrites=%u\n",
+           (unsigned)((nrf_sim_time_get() - start) / 1000), (unsigned)live_words,
+           (unsigned)stats.words_written, (unsigned)stats.pages_erased, (unsigned)(gc_count + 1),
+           (unsigned)erase_max, (unsigned)(stats.busy_us / 1000),
+           (unsigned)stats.overwrites);
+
+    // Writing a word too many times between two erases could corrupt it on the target.
+    APP_ERROR_CHECK_BOOL(stats.overwrites == 0);
+
+    // Save the page structures, as before entering System OFF. The snapshot was checked, and
+    // found invalid, by fds_init.
+    err_code = fds_retain();
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for recording the lateness of a timeout, in RTC ticks. */
+static void timeout_record(uint32_t expected)
+{
+    uint32_t ticks;
+    uint32_t late;
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&ticks));
+    UNUSED_RETURN_VALUE(app_timer_cnt_diff_compute(ticks, expected, &late));
+    samples_add(late);
+    m_timeouts++;
+}
+
+
+static void repeated_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    timeout_record(m_expected[0]);
+    m_expected[0] = (m_expected[0] + BENCH_TIMER_INTERVAL) & BENCH_COUNTER_MASK;
+}
+
+
+static void single_shot_timeout_handler(void * p_context)
+{
+    uint32_t const index = (uint32_t)(uintptr_t)p_context;
+
+    timeout_record(m_expected[index]);
+    m_expired[index] = true;
+}
+
+
+/**@brief Function for starting a single shot timer with a random timeout. */
+static void single_shot_start(uint32_t index)
+{
+    uint32_t const timeout = APP_TIMER_MIN_TIMEOUT_TICKS + (random_get() % 1000);
+    uint32_t       ticks;
+    uint32_t       err_code;
+
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&ticks));
+    m_expected[index] = (ticks + timeout) & BENCH_COUNTER_MASK;
+
+    err_code = app_timer_start(*m_single_shot_timer_ids[index], timeout, (void *)(uintptr_t)index);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+static void restart_timeout_handler(void * p_context)
+{
+    uint64_t const now = nrf_sim_time_get();
+
+    UNUSED_PARAMETER(p_context);
+
+    // The RTC1 counter may be cleared while the timer runs, so lateness is measured in
+    // simulated time. It may expire up to a tick early, as the timer starts on a tick.
+    APP_ERROR_CHECK_BOOL(now + BENCH_TICKS_TO_US(1) >= m_restart_expected_us);
+    samples_add((now > m_restart_expected_us) ?
+                (uint32_t)BENCH_US_TO_TICKS(now - m_restart_expected_us) : 0);
+    m_timeouts++;
+}
+
+
+/**@brief Function for restarting the restart timer in one batch, with a random timeout.
+ *
+ * @details The stop and the start are handled in the same pass of the timer list handler. The
+ *          timer list becomes empty in between if no other timer runs.
+ */
+static void restart_timer_restart(void)
+{
+    app_timer_batch_op_t op =
+    {
+        .op_type       = APP_TIMER_BATCH_OP_RESTART,
+        .timer_id      = m_restart_timer_id,
+        .timeout_ticks = APP_TIMER_MIN_TIMEOUT_TICKS + (random_get() % 1000),
+        .slack_ticks   = 0,
+        .p_context     = NULL,
+    };
+    uint32_t err_code;
+
+    m_restart_expected_us = nrf_sim_time_get() + BENCH_TICKS_TO_US(op.timeout_ticks);
+
+    err_code = app_timer_batch_execute(&op, 1);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for benchmarking the timeouts of app_timer in simulated time. */
+static void timer_bench(void)
+{
+    uint32_t err_code;
+    uint32_t ticks;
+    uint32_t rounds[BENCH_SINGLE_SHOT_TIMERS] = {0};
+    uint64_t start;
+
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
+
+    err_code = app_timer_create(&m_repeated_timer_id, APP_TIMER_MODE_REPEATED,
+                                repeated_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+    err_code = app_timer_create(&m_restart_timer_id, APP_TIMER_MODE_SINGLE_SHOT,
+                                restart_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+    for (uint32_t i = 0; i < BENCH_SINGLE_SHOT_TIMERS; i++)
+    {
+        err_code = app_timer_create(m_single_shot_timer_ids[i], APP_TIMER_MODE_SINGLE_SHOT,
+                                    single_shot_timeout_handler);
+        APP_ERROR_CHECK(err_code);
+    }
+
+    // Repeated timer.
+    samples_reset();
+    m_timeouts = 0;
+    start      = host_ns();
+    UNUSED_RETURN_VALUE(app_timer_cnt_get(&ticks));
+    m_expected[0] = (ticks + BENCH_TIMER_INTERVAL) & BENCH_COUNTER_MASK;
+    err_code = app_timer_start(m_repeated_timer_id, BENCH_TIMER_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+
+    while (m_timeouts < BENCH_TIMER_TIMEOUTS)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+    }
+    err_code = app_timer_stop(m_repeated_timer_id);
+    APP_ERROR_CHECK(err_code);
+    samples_print("app_timer", "repeated", "ticks");
+    throughput_print("app_timer_timeout", m_timeouts, 0, host_ns() - start);
+
+    // Single shot timers, started again with random timeouts when they expire.
+    samples_reset();
+    m_timeouts = 0;
+    for (uint32_t i = 0; i < BENCH_SINGLE_SHOT_TIMERS; i++)
+    {
+        single_shot_start(i);
+    }
+    while (m_timeouts < BENCH_SINGLE_SHOT_TIMERS * BENCH_SINGLE_SHOT_ROUNDS)
+    {
+        err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+
+        for (uint32_t i = 0; i < BENCH_SINGLE_SHOT_TIMERS; i++)
+        {
+            if (m_expired[i] && (++rounds[i] < BENCH_SINGLE_SHOT_ROUNDS))
+            {
+                single_shot_start(i);
+            }
+            m_expired[i] = false;
+        }
+    }
+    samples_print("app_timer", "single_shot", "ticks");
+
+    // A timer restarted in a batch while it is the only running timer.
+    samples_reset();
+    m_timeouts = 0;
+    for (uint32_t i = 0; i < BENCH_RESTART_ROUNDS; i++)
+    {
+        uint32_t const delay_ticks = 1 + (random_get() % (BENCH_RESTART_TIMEOUT - 1));
+
+        err_code = app_timer_start(m_restart_timer_id, BENCH_RESTART_TIMEOUT, NULL);
+        APP_ERROR_CHECK(err_code);
+
+        // Let RTC1 count for a while before restarting the timer.
+        nrf_delay_us((uint32_t)BENCH_TICKS_TO_US(delay_ticks));
+        APP_ERROR_CHECK_BOOL(m_timeouts == i);
+
+        restart_timer_restart();
+        while (m_timeouts == i)
+        {
+            err_code = sd_app_evt_wait();
+            APP_ERROR_CHECK(err_code);
+        }
+    }
+    samples_print("app_timer", "batch_restart", "ticks");
+    APP_ERROR_CHECK_BOOL(samples_max_get() <= BENCH_RESTART_LATE_MAX);
+}
+
+
+static void sched_event_handler(void * p_event_data, uint16_t event_size)
+{
+    UNUSED_PARAMETER(event_size);
+
+    m_sink += *(uint32_t *)p_event_data;
+}
+
+
+/**@brief Function for filling the scheduler queue from a handler, which must not take a slot. */
+static void sched_fill_handler(void * p_event_data, uint16_t event_size)
+{
+    uint32_t err_code;
+
+    UNUSED_PARAMETER(p_event_data);
+    UNUSED_PARAMETER(event_size);
+
+    for (uint32_t j = 0; j < BENCH_SCHED_EVENTS; j++)
+    {
+        err_code = app_sched_event_put(&j, sizeof(j), sched_event_handler);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for benchmarking app_scheduler: events are queued, then executed. */
+static void scheduler_bench(void)
+{
+    uint32_t err_code;
+    uint64_t start;
+
+    APP_SCHED_INIT(sizeof(uint32_t), BENCH_SCHED_EVENTS);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        for (uint32_t j = 0; j < BENCH_SCHED_EVENTS; j++)
+        {
+            err_code = app_sched_event_put(&j, sizeof(j), sched_event_handler);
+            APP_ERROR_CHECK(err_code);
+        }
+        app_sched_execute();
+    }
+    throughput_print("app_scheduler", BENCH_ITERATIONS * BENCH_SCHED_EVENTS, 0, host_ns() - start);
+
+    // The whole queue is available to a handler while it executes.
+    err_code = app_sched_event_put(NULL, 0, sched_fill_handler);
+    APP_ERROR_CHECK(err_code);
+    app_sched_execute();
+}
+
+
+/**@brief Function for benchmarking app_fifo, byte by byte and in blocks. */
+static void fifo_bench(void)
+{
+    static uint8_t fifo_buffer[256];
+    app_fifo_t     fifo;
+    uint32_t       err_code;
+    uint64_t       start;
+    uint8_t        byte;
+
+    err_code = app_fifo_init(&fifo, fifo_buffer, sizeof(fifo_buffer));
+    APP_ERROR_CHECK(err_code);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        for (uint32_t j = 0; j < sizeof(fifo_buffer); j++)
+        {
+            err_code = app_fifo_put(&fifo, (uint8_t)j);
+            APP_ERROR_CHECK(err_code);
+        }
+        for (uint32_t j = 0; j < sizeof(fifo_buffer); j++)
+        {
+            err_code = app_fifo_get(&fifo, &byte);
+            APP_ERROR_CHECK(err_code);
+            m_sink += byte;
+        }
+    }
+    throughput_print("app_fifo_byte", BENCH_ITERATIONS * sizeof(fifo_buffer), 1, host_ns() - start);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t size = sizeof(fifo_buffer);
+
+        err_code = app_fifo_write(&fifo, m_buffer, &size);
+        APP_ERROR_CHECK(err_code);
+        size = sizeof(fifo_buffer);
+        err_code = app_fifo_read(&fifo, m_buffer, &size);
+        APP_ERROR_CHECK(err_code);
+    }
+    throughput_print("app_fifo_block", BENCH_ITERATIONS, sizeof(fifo_buffer), host_ns() - start);
+}
+
+
+/**@brief Function for benchmarking mem_manager with allocations of random sizes. */
+static void mem_manager_bench(void)
+{
+    void *   p_blocks[8];
+    uint32_t err_code;
+    uint64_t start;
+
+    err_code = nrf_mem_init();
+    APP_ERROR_CHECK(err_code);
+
+    // A block freed twice must not be handed out twice.
+    p_blocks[0] = nrf_malloc(1);
+    APP_ERROR_CHECK_BOOL(p_blocks[0] != NULL);
+    nrf_free(p_blocks[0]);
+    nrf_free(p_blocks[0]);
+
+    p_blocks[0] = nrf_malloc(1);
+    p_blocks[1] = nrf_malloc(1);
+    APP_ERROR_CHECK_BOOL((p_blocks[0] != NULL) && (p_blocks[1] != NULL));
+    APP_ERROR_CHECK_BOOL(p_blocks[0] != p_blocks[1]);
+    nrf_free(p_blocks[0]);
+    nrf_free(p_blocks[1]);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        for (uint32_t j = 0; j < (sizeof(p_blocks) / sizeof(p_blocks[0])); j++)
+        {
+            p_blocks[j] = nrf_malloc(1 + (random_get() % 256));
+            APP_ERROR_CHECK_BOOL(p_blocks[j] != NULL);
+        }
+        for (uint32_t j = 0; j < (sizeof(p_blocks) / sizeof(p_blocks[0])); j++)
+        {
+            nrf_free(p_blocks[j]);
+        }
+    }
+    throughput_print("mem_manager", BENCH_ITERATIONS * (sizeof(p_blocks) / sizeof(p_blocks[0])), 0, host_ns() - start);
+}
+
+
+/**@brief Function for benchmarking the checksum and hash modules. */
+static void checksum_bench(void)
+{
+    sha256_context_t ctx;
+    uint8_t          hash[32];
+    uint64_t         start;
+
+    for (uint32_t i = 0; i < sizeof(m_buffer); i++)
+    {
+        m_buffer[i] = (uint8_t)random_get();
+    }
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_sink += crc16_compute(m_buffer, sizeof(m_buffer), NULL);
+    }
+    throughput_print("crc16", BENCH_ITERATIONS, sizeof(m_buffer), host_ns() - start);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_sink += crc32_compute(m_buffer, sizeof(m_buffer), NULL);
+    }
+    throughput_print("crc32", BENCH_ITERATIONS, sizeof(m_buffer), host_ns() - start);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS / 10; i++)
+    {
+        APP_ERROR_CHECK(sha256_init(&ctx));
+        APP_ERROR_CHECK(sha256_update(&ctx, m_buffer, sizeof(m_buffer)));
+        APP_ERROR_CHECK(sha256_final(&ctx, hash));
+        m_sink += hash[0];
+    }
+    throughput_print("sha256", BENCH_ITERATIONS / 10, sizeof(m_buffer), host_ns() - start);
+}
+
+
+/**@brief Function for benchmarking the encoding and parsing of an NDEF message with two Text
+ *        records.
+ */
+static void eid_bench(void)
+{
+    ble_eddystone_eid_t eid;
+    ble_eddystone_eid_t eid_ref;
+    uint8_t             identity_key[BLE_EDDYSTONE_EID_KEY_LEN];
+    uint32_t            time = random_get();
+    uint64_t            rotate_ns = 0;
+    uint64_t            start;
+    bool                changed;
+
+    for (uint32_t i = 0; i < sizeof(identity_key); i++)
+    {
+        identity_key[i] = (uint8_t)random_get();
+    }
+
+    APP_ERROR_CHECK(ble_eddystone_eid_init(&eid, identity_key, BENCH_EID_K, time));
+
+    // Rotation to a precomputed EID, crossing temporary key periods.
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        APP_ERROR_CHECK(ble_eddystone_eid_precompute(&eid));
+        time = ble_eddystone_eid_next_rotation_get(&eid);
+
+        start = host_ns();
+        APP_ERROR_CHECK(ble_eddystone_eid_update(&eid, time, &changed));
+        rotate_ns += host_ns() - start;
+
+        APP_ERROR_CHECK(ble_eddystone_eid_init(&eid_ref, identity_key, BENCH_EID_K, time));
+        APP_ERROR_CHECK_BOOL(changed);
+        APP_ERROR_CHECK_BOOL(memcmp(ble_eddystone_eid_get(&eid), ble_eddystone_eid_get(&eid_ref),
+                                    BLE_EDDYSTONE_EID_LEN) == 0);
+    }
+    throughput_print("eddystone_eid_rotate", BENCH_ITERATIONS, 0, rotate_ns);
+
+    // Computing the EID and its temporary key, as on a rotation that was not precomputed.
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        APP_ERROR_CHECK(ble_eddystone_eid_init(&eid_ref, identity_key, BENCH_EID_K, time));
+        m_sink += ble_eddystone_eid_get(&eid_ref)[0];
+    }
+    throughput_print("eddystone_eid_compute", BENCH_ITERATIONS, 0, host_ns() - start);
+}
+
+
+static void ndef_bench(void)
+{
+    static uint8_t const en_code[]    = {'e', 'n'};
+    static uint8_t const en_payload[] = "Hello World from the host benchmark!";
+    static uint8_t const no_code[]    = {'N', 'O'};
+    static uint8_t const no_payload[] = "Hallo Verden fra vertsmaskinen!";
+
+    static uint8_t msg_buffer[256];
+    static uint8_t parser_buffer[NFC_NDEF_PARSER_REQIRED_MEMO_SIZE_CALC(2)];
+
+    ret_code_t err_code;
+    uint32_t   msg_len;
+    uint64_t   start;
+
+    NFC_NDEF_MSG_DEF(text_msg, 2);
+    NFC_NDEF_TEXT_RECORD_DESC_DEF(en_text_rec, UTF_8, en_code, sizeof(en_code),
+                                  en_payload, sizeof(en_payload) - 1);
+    NFC_NDEF_TEXT_RECORD_DESC_DEF(no_text_rec, UTF_8, no_code, sizeof(no_code),
+                                  no_payload, sizeof(no_payload) - 1);
+
+    err_code = nfc_ndef_msg_record_add(&NFC_NDEF_MSG(text_msg), &NFC_NDEF_TEXT_RECORD_DESC(en_text_rec));
+    APP_ERROR_CHECK(err_code);
+    err_code = nfc_ndef_msg_record_add(&NFC_NDEF_MSG(text_msg), &NFC_NDEF_TEXT_RECORD_DESC(no_text_rec));
+    APP_ERROR_CHECK(err_code);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        msg_len  = sizeof(msg_buffer);
+        err_code = nfc_ndef_msg_encode(&NFC_NDEF_MSG(text_msg), msg_buffer, &msg_len);
+        APP_ERROR_CHECK(err_code);
+    }
+    throughput_print("ndef_encode", BENCH_ITERATIONS, msg_len, host_ns() - start);
+
+    start = host_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t parser_len = sizeof(parser_buffer);
+        uint32_t data_len   = msg_len;
+
+        err_code = ndef_msg_parser(parser_buffer, &parser_len, msg_buffer, &data_len);
+        APP_ERROR_CHECK(err_code);
+        APP_ERROR_CHECK_BOOL(((nfc_ndef_msg_desc_t *)parser_buffer)->record_count == 2);
+    }
+    throughput_print("ndef_parse", BENCH_ITERATIONS, msg_len, host_ns() - start);
+}
+
+
+/**@brief Function for dispatching a system event to fstorage.
+ *
+ * @param[in] sys_evt  System stack event.
+ */
+static void sys_evt_dispatch(uint32_t sys_evt)
+{
+    fs_sys_event_handler(sys_evt);
+}
+
+
+/**@brief Function for enabling the simulated SoftDevice, which executes the flash operations. */
+static void softdevice_init(void)
+{
+    uint32_t err_code;
+
+    nrf_clock_lf_cfg_t clock_lf_cfg = NRF_CLOCK_LFCLKSRC;
+
+    SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
+
+    err_code = softdevice_sys_evt_handler_set(sys_evt_dispatch);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for the application main entry. */
+int main(void)
+{
+    softdevice_init();
+
+    printf("BENCH START page_size=%u write_us=%u erase_us=%u\n",
+           NRF_SIM_FLASH_PAGE_SIZE, NRF_SIM_NVMC_WRITE_US, NRF_SIM_NVMC_ERASE_US);
+
+    timer_bench();
+    fds_bench();
+    scheduler_bench();
+    fifo_bench();
+    mem_manager_bench();
+    checksum_bench();
+    eid_bench();
+    ndef_bench();
+
+    printf("BENCH DONE\n");
+
+    return 0;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,596 @@
+/* Copyright (c) 2016 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ */
+
+/** @file
+ * @defgroup radio_bench_example_main main.c
+ * @{
+ * @ingroup radio_bench_example
+ * @brief Radio throughput and packet error rate benchmark application main file.
+ *
+ * This application measures the link performance of @ref nrf_esb between two boards, one built as
+ * PTX (the default) and one built as PRX (BENCH_ROLE_PRX defined, make ROLE=prx). The PTX runs a
+ * sweep of tests over:
+ *  - the bitrate: 2 Mbit, 1 Mbit, 1 Mbit with the Bluetooth low energy radio parameters and, on
+ *    nRF51, 250 kbit,
+ *  - the payload length,
+ *  - acknowledgements on or off,
+ *  - with acknowledgements, the number of retransmissions and the retransmit delay.
+ *
+ * Before each test, the PTX tells the PRX the index of the test on a fixed control link. Both
+ * boards then switch to the test configuration and the PTX sends @ref BENCH_PACKETS_PER_TEST
+ * packets as fast as it can, keeping the TX FIFO full. Both boards then return to the control
+ * link, where the PTX collects the number of packets received by the PRX in an ACK payload.
+ * The link counters and the latency histogram of the PTX come from @ref nrf_esb_stats_get.
+ *
+ * Results are printed by the PTX over RTT. Every result line starts with "BENCH" so that a test
+ * script can collect them, and fields are printed as key=value pairs; "BENCH DONE" is printed
+ * last. Packet error rates are in hundredths of a percent. For each test, "BENCH TEST" gives the results and "BENCH LATENCY" the latency histogram
+ * of the acknowledged packets, from the start of the first transmission of a packet to the
+ * reception of its acknowledgement.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf.h"
+#include "nrf_esb.h"
+#include "nrf_error.h"
+#include "nrf_delay.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nrf_log.h"
+
+#if !NRF_ESB_STATS_ENABLED
+#error "The benchmark uses the ESB link statistics, build with NRF_ESB_STATS_ENABLED=1."
+#endif
+
+#define BENCH_PACKETS_PER_TEST      1000                                /**< Number of packets sent by each test. */
+#define BENCH_RF_CHANNEL            40                                  /**< RF channel of the control link and of the tests. */
+#define BENCH_CONTROL_TIMEOUT_US    2000000                             /**< Time the PTX tries to reach the PRX on the control link before giving up a test. */
+#define BENCH_CONTROL_RETRY_US      5000                                /**< Delay between two control packets of the PTX. */
+#define BENCH_SWITCH_DELAY_US       2000                                /**< Time for the PRX to switch to the test configuration after it acknowledged the start packet. */
+#define BENCH_RX_IDLE_TIMEOUT_US    100000                              /**< Time without packets after which the PRX ends a test, if it missed the last packets. */
+#define BENCH_TEST_TIMEOUT_US       30000000                            /**< Longest duration of a test. */
+
+#define BENCH_PKT_START             0x01                                /**< Control packet: start the test of index data[1]. */
+#define BENCH_PKT_REPORT_REQ        0x02                                /**< Control packet: request the results of the last test. */
+#define BENCH_PKT_REPORT            0x03                                /**< ACK payload of the PRX with the results of the last test. */
+#define BENCH_PKT_DATA              0x04                                /**< Test packet, data[1..2] is the sequence number. */
+
+#define BENCH_DATA_HEADER_LEN       4                                   /**< Packet type, sequence number and test index. */
+#define BENCH_REPORT_LEN            10                                  /**< Packet type, test index, packets received and CRC errors. */
+
+#define BENCH_TIMER                 NRF_TIMER0                          /**< Timer used as microsecond clock. NRF_ESB_SYS_TIMER is TIMER2. */
+
+/**@brief Configuration of a test. */
+typedef struct
+{
+    nrf_esb_bitrate_t bitrate;              /**< Bitrate. */
+    char const *      p_bitrate_name;       /**< Name of the bitrate, for the results. */
+    uint8_t           length;               /**< Payload length. */
+    bool              ack;                  /**< Packets are acknowledged. */
+    uint8_t           retransmit_count;     /**< Number of retransmissions, if acknowledged. */
+    uint16_t          retransmit_delay;     /**< Retransmit delay, in microseconds, if acknowledged. */
+} bench_test_t;
+
+/**@brief Retransmit setting of the tests with acknowledgements. */
+typedef struct
+{
+    uint8_t  count;                         /**< Number of retransmissions. */
+    uint16_t extra_delay_us;                /**< Time added to the shortest retransmit delay for the bitrate and payload length. */
+} bench_retransmit_t;
+
+static const nrf_esb_bitrate_t m_bitrates[] =                               /**< Bitrates tested. */
+{
+    NRF_ESB_BITRATE_2MBPS,
+    NRF_ESB_BITRATE_1MBPS,
+    NRF_ESB_BITRATE_1MBPS_BLE,
+#ifdef NRF51
+    NRF_ESB_BITRATE_250KBPS,
+#endif
+};
+
+static char const * const m_bitrate_names[] =                               /**< Names of the bitrates tested. */
+{
+    "2M",
+    "1M",
+    "1M_BLE",
+#ifdef NRF51
+    "250K",
+#endif
+};
+
+static const uint8_t m_lengths[] = { BENCH_DATA_HEADER_LEN, 8, 16, NRF_ESB_MAX_PAYLOAD_LENGTH };   /**< Payload lengths tested. */
+
+static const bench_retransmit_t m_retransmits[] = { { 0, 0 }, { 3, 0 }, { 15, 250 } };       /**< Retransmit settings tested. */
+
+#define BENCH_BITRATE_COUNT         (sizeof(m_bitrates) / sizeof(m_bitrates[0]))           /**< Number of bitrates tested. */
+#define BENCH_LENGTH_COUNT          (sizeof(m_lengths) / sizeof(m_lengths[0]))             /**< Number of payload lengths tested. */
+
+/** Number of tests for each bitrate and payload length: one without acknowledgements, and one for
+ *  each retransmit setting. */
+#define BENCH_TESTS_PER_LENGTH      (1 + (sizeof(m_retransmits) / sizeof(m_retransmits[0])))
+
+static nrf_esb_payload_t m_tx_payload;                                      /**< Packet being written. */
+static nrf_esb_payload_t m_rx_payload;                                      /**< Packet read. */
+
+
+/**@brief Function for starting BENCH_TIMER as a 32-bit microsecond counter. */
+static void clock_start(void)
+{
+    NRF_CLOCK->EVENTS_HFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_HFCLKSTART    = 1;
+    while (NRF_CLOCK->EVENTS_HFCLKSTARTED == 0)
+    {
+        // Do nothing.
+    }
+
+    BENCH_TIMER->MODE        = TIMER_MODE_MODE_Timer;
+    BENCH_TIMER->BITMODE     = TIMER_BITMODE_BITMODE_32Bit;
+    BENCH_TIMER->PRESCALER   = 4;
+    BENCH_TIMER->TASKS_CLEAR = 1;
+    BENCH_TIMER->TASKS_START = 1;
+}
+
+
+/**@brief Function for reading the microsecond counter. */
+static uint32_t time_us_get(void)
+{
+    BENCH_TIMER->TASKS_CAPTURE[0] = 1;
+    return BENCH_TIMER->CC[0];
+}
+
+
+/**@brief Function for computing the shortest retransmit delay for a bitrate and payload length.
+ *
+ * @details The delay covers the packet and its acknowledgement on air, the radio ramp-up before
+ *          each of them and the time the PTX waits for the acknowledgement.
+ */
+static uint16_t retransmit_delay_min_us(nrf_esb_bitrate_t bitrate, uint8_t length)
+{
+    // Preamble, 5-byte address, length and S1 fields, and 2-byte CRC.
+    uint32_t overhead_bits = 8 * (1 + 5 + 2) + 9;
+    uint32_t kbps;
+    uint32_t air_us;
+
+    switch (bitrate)
+    {
+        case NRF_ESB_BITRATE_2MBPS:
+            kbps = 2000;
+            break;
+#ifdef NRF51
+        case NRF_ESB_BITRATE_250KBPS:
+            kbps = 250;
+            break;
+#endif
+        default:
+            kbps = 1000;
+            break;
+    }
+
+    air_us = ((2 * overhead_bits + 8 * length) * 1000) / kbps;
+    return (uint16_t)MAX(250, air_us + 2 * 130 + ((kbps == 250) ? 250 : 64) + 100);
+}
+
+
+/**@brief Function for getting the configuration of a test.
+ *
+ * @param[in]  index   Index of the test.
+ * @param[out] p_test  Configuration of the test.
+ *
+ * @retval true if index is a valid test.
+ */
+static bool test_get(uint32_t index, bench_test_t * p_test)
+{
+    uint32_t bitrate_index = index / (BENCH_LENGTH_COUNT * BENCH_TESTS_PER_LENGTH);
+    uint32_t length_index  = (index / BENCH_TESTS_PER_LENGTH) % BENCH_LENGTH_COUNT;
+    uint32_t ack_index     = index % BENCH_TESTS_PER_LENGTH;
+
+    if (bitrate_index >= BENCH_BITRATE_COUNT)
+    {
+        return false;
+    }
+
+    p_test->bitrate          = m_bitrates[bitrate_index];
+    p_test->p_bitrate_name   = m_bitrate_names[bitrate_index];
+    p_test->length           = m_lengths[length_index];
+    p_test->ack              = (ack_index != 0);
+    p_test->retransmit_count = 0;
+    p_test->retransmit_delay = retransmit_delay_min_us(p_test->bitrate, p_test->length);
+
+    if (p_test->ack)
+    {
+        p_test->retransmit_count  = m_retransmits[ack_index - 1].count;
+        p_test->retransmit_delay += m_retransmits[ack_index - 1].extra_delay_us;
+    }
+    return true;
+}
+
+
+/**@brief Function for configuring ESB for the control link or for a test.
+ *
+ * @param[in] p_test         Configuration of the test, or NULL for the control link.
+ * @param[in] mode           PTX or PRX.
+ * @param[in] event_handler  ESB event handler.
+ */
+static uint32_t esb_configure(bench_test_t const * p_test, nrf_esb_mode_t mode, nrf_esb_event_handler_t event_handler)
+{
+    uint32_t         err_code;
+    nrf_esb_config_t config = NRF_ESB_DEFAULT_CONFIG;
+
+    config.mode               = mode;
+    config.event_handler      = event_handler;
+    config.selective_auto_ack = true;
+    config.retransmit_count   = 15;
+    config.retransmit_delay   = 600;
+
+    if (p_test != NULL)
+    {
+        config.bitrate          = p_test->bitrate;
+        config.retransmit_count = p_test->retransmit_count;
+        config.retransmit_delay = p_test->retransmit_delay;
+    }
+
+    err_code = nrf_esb_init(&config);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = nrf_esb_set_rf_channel(BENCH_RF_CHANNEL);
+    VERIFY_SUCCESS(err_code);
+
+    if (mode == NRF_ESB_MODE_PRX)
+    {
+        err_code = nrf_esb_start_rx();
+    }
+    return err_code;
+}
+
+
+#ifndef BENCH_ROLE_PRX
+
+static volatile bool m_tx_done;                                             /**< A control packet was acknowledged. */
+static volatile bool m_tx_failed;                                           /**< A control packet was not acknowledged. */
+static volatile bool m_report_received;                                     /**< A report was received from the PRX. */
+static uint8_t       m_report[BENCH_REPORT_LEN];                            /**< Last report received. */
+static bool          m_test_running;                                        /**< A test is in progress, as opposed to the control link. */
+
+
+/**@brief ESB event handler of the PTX. */
+static void ptx_event_handler(nrf_esb_evt_t const * p_event)
+{
+    switch (p_event->evt_id)
+    {
+        case NRF_ESB_EVENT_TX_SUCCESS:
+            m_tx_done = true;
+            break;
+
+        case NRF_ESB_EVENT_TX_FAILED:
+            // Drop the packet which failed and carry on with the next one. The failure is counted
+            // by the ESB statistics.
+            (void)nrf_esb_pop_tx();
+            if (m_test_running)
+            {
+                (void)nrf_esb_start_tx();
+            }
+            m_tx_failed = true;
+            break;
+
+        case NRF_ESB_EVENT_RX_RECEIVED:
+            while (nrf_esb_read_rx_payload(&m_rx_payload) == NRF_SUCCESS)
+            {
+                if ((m_rx_payload.length == BENCH_REPORT_LEN) && (m_rx_payload.data[0] == BENCH_PKT_REPORT))
+                {
+                    memcpy(m_report, m_rx_payload.data, BENCH_REPORT_LEN);
+                    m_report_received = true;
+                }
+            }
+            break;
+    }
+}
+
+
+/**@brief Function for sending control packets to the PRX until one is acknowledged.
+ *
+ * @param[in] type    Packet type.
+ * @param[in] index   Test index.
+ * @param[in] report  Keep sending until the report of the test is received.
+ *
+ * @retval true if the PRX acknowledged the packet, and sent the report if requested.
+ */
+static bool control_send(uint8_t type, uint8_t index, bool report)
+{
+    uint32_t start = time_us_get();
+
+    APP_ERROR_CHECK(esb_configure(NULL, NRF_ESB_MODE_PTX, ptx_event_handler));
+    m_test_running    = false;
+    m_report_received = false;
+
+    m_tx_payload.pipe    = 0;
+    m_tx_payload.noack   = false;
+    m_tx_payload.length  = 2;
+    m_tx_payload.data[0] = type;
+    m_tx_payload.data[1] = index;
+
+    while ((time_us_get() - start) < BENCH_CONTROL_TIMEOUT_US)
+    {
+        m_tx_done   = false;
+        m_tx_failed = false;
+
+        if (nrf_esb_write_payload(&m_tx_payload) == NRF_SUCCESS)
+        {
+            while (!m_tx_done && !m_tx_failed)
+            {
+                __WFE();
+            }
+
+            if (m_tx_done && (!report || (m_report_received && (m_report[1] == index))))
+            {
+                return true;
+            }
+        }
+
+        nrf_delay_us(BENCH_CONTROL_RETRY_US);
+    }
+    return false;
+}
+
+
+/**@brief Function for running a test and printing its results. */
+static void ptx_test_run(uint32_t index, bench_test_t const * p_test)
+{
+    nrf_esb_stats_t       stats;
+    nrf_esb_pipe_stats_t const * p_pipe = &stats.pipes[0];
+    uint32_t              queued = 0;
+    uint32_t              start;
+    uint32_t              duration;
+    uint32_t              delivered;
+    uint32_t              attempts;
+    uint32_t              rx_count;
+    uint32_t              rx_crc_errors;
+    uint32_t              i;
+
+    if (!control_send(BENCH_PKT_START, (uint8_t)index, false))
+    {
+        NRF_LOG_PRINTF("BENCH TEST index=%u error=no_peer\r\n", index);
+        return;
+    }
+
+    APP_ERROR_CHECK(esb_configure(p_test, NRF_ESB_MODE_PTX, ptx_event_handler));
+    m_test_running = true;
+    nrf_delay_us(BENCH_SWITCH_DELAY_US);
+
+    m_tx_payload.pipe    = 0;
+    m_tx_payload.noack   = !p_test->ack;
+    m_tx_payload.length  = p_test->length;
+    m_tx_payload.data[0] = BENCH_PKT_DATA;
+    m_tx_payload.data[3] = (uint8_t)index;
+    for (i = BENCH_DATA_HEADER_LEN; i < p_test->length; i++)
+    {
+        m_tx_payload.data[i] = (uint8_t)i;
+    }
+
+    // Keep the TX FIFO full until all the packets are written, then wait for them to be sent.
+    start = time_us_get();
+    do
+    {
+        while (queued < BENCH_PACKETS_PER_TEST)
+        {
+            m_tx_payload.data[1] = (uint8_t)queued;
+            m_tx_payload.data[2] = (uint8_t)(queued >> 8);
+            if (nrf_esb_write_payload(&m_tx_payload) != NRF_SUCCESS)
+            {
+                break;
+            }
+            queued++;
+        }
+
+        APP_ERROR_CHECK(nrf_esb_stats_get(&stats, false));
+        duration = time_us_get() - start;
+    } while (((p_pipe->tx_success + p_pipe->tx_failed) < BENCH_PACKETS_PER_TEST) &&
+             (duration < BENCH_TEST_TIMEOUT_US));
+
+    m_test_running = false;
+
+    if (!control_send(BENCH_PKT_REPORT_REQ, (uint8_t)index, true))
+    {
+        NRF_LOG_PRINTF("BENCH TEST index=%u error=no_report\r\n", index);
+        return;
+    }
+    rx_count      = uint32_decode(&m_report[2]);
+    rx_crc_errors = uint32_decode(&m_report[6]);
+
+    // Without acknowledgements, the PTX does not know which packets arrived.
+    delivered = p_test->ack ? p_pipe->tx_success : MIN(rx_count, BENCH_PACKETS_PER_TEST);
+    attempts  = p_pipe->tx_success + p_pipe->tx_failed + p_pipe->tx_retransmits;
+
+    NRF_LOG_PRINTF("BENCH TEST index=%u bitrate=%s len=%u ack=%u retransmits=%u delay_us=%u "
+                   "sent=%u delivered=%u rx=%u rx_crc_errors=%u attempts=%u duration_us=%u "
+                   "kbps=%u per=%u raw_per=%u\r\n",
+                   index, p_test->p_bitrate_name, p_test->length, p_test->ack,
+                   p_test->retransmit_count, p_test->retransmit_delay,
+                   BENCH_PACKETS_PER_TEST, delivered, rx_count, rx_crc_errors, attempts, duration,
+                   (uint32_t)(((uint64_t)delivered * p_test->length * 8 * 1000) / MAX(duration, 1)),
+                   ((BENCH_PACKETS_PER_TEST - delivered) * 10000) / BENCH_PACKETS_PER_TEST,
+                   p_test->ack ? ((attempts - p_pipe->tx_success) * 10000) / MAX(attempts, 1) : 0);
+
+    if (p_test->ack)
+    {
+        NRF_LOG_PRINTF("BENCH LATENCY index=%u bin_width_us=%u max_us=%u bins=",
+                       index, NRF_ESB_LATENCY_BIN_WIDTH_US, stats.latency_max_us);
+        for (i = 0; i < NRF_ESB_LATENCY_HISTOGRAM_BINS; i++)
+        {
+            NRF_LOG_PRINTF((i == 0) ? "%u" : ",%u", stats.latency_histogram[i]);
+        }
+        NRF_LOG_PRINTF("\r\n");
+    }
+}
+
+
+/**@brief Function for running all the tests. */
+static void bench_run(void)
+{
+    bench_test_t test;
+    uint32_t     index;
+
+    NRF_LOG_PRINTF("BENCH CONFIG role=ptx packets=%u channel=%u max_payload=%u\r\n",
+                   BENCH_PACKETS_PER_TEST, BENCH_RF_CHANNEL, NRF_ESB_MAX_PAYLOAD_LENGTH);
+
+    for (index = 0; test_get(index, &test); index++)
+    {
+        ptx_test_run(index, &test);
+    }
+
+    NRF_LOG_PRINTF("BENCH DONE\r\n");
+}
+
+#else // BENCH_ROLE_PRX
+
+static volatile bool     m_start_received;                                  /**< A start packet was received on the control link. */
+static volatile bool     m_report_requested;                                /**< A report request was received on the control link. */
+static volatile uint8_t  m_test_index;                                      /**< Index of the test to start or in progress. */
+static volatile bool     m_test_running;                                    /**< A test is in progress, as opposed to the control link. */
+static volatile uint32_t m_rx_count;                                        /**< Test packets received. */
+static volatile bool     m_last_received;                                   /**< The last packet of the test was received. */
+static volatile uint32_t m_last_rx_time;                                    /**< Time of the last packet received in the test, or of its start. */
+
+
+/**@brief ESB event handler of the PRX. */
+static void prx_event_handler(nrf_esb_evt_t const * p_event)
+{
+    if (p_event->evt_id != NRF_ESB_EVENT_RX_RECEIVED)
+    {
+        return;
+    }
+
+    while (nrf_esb_read_rx_payload(&m_rx_payload) == NRF_SUCCESS)
+    {
+        uint8_t const * p_data = m_rx_payload.data;
+
+        if (m_test_running)
+        {
+            if ((m_rx_payload.length >= BENCH_DATA_HEADER_LEN) &&
+                (p_data[0] == BENCH_PKT_DATA) && (p_data[3] == m_test_index))
+            {
+                m_rx_count++;
+                m_last_rx_time  = time_us_get();
+                m_last_received = (uint16_decode(&p_data[1]) == (BENCH_PACKETS_PER_TEST - 1));
+            }
+        }
+        else if (m_rx_payload.length == 2)
+        {
+            if (p_data[0] == BENCH_PKT_START)
+            {
+                m_test_index     = p_data[1];
+                m_start_received = true;
+            }
+            else if (p_data[0] == BENCH_PKT_REPORT_REQ)
+            {
+                m_report_requested = true;
+            }
+        }
+    }
+}
+
+
+/**@brief Function for queueing the report of the last test as ACK payload.
+ *
+ * @details The report is queued again after each request, in case the acknowledgement carrying it
+ *          was lost.
+ */
+static void report_write(uint32_t rx_crc_errors)
+{
+    (void)nrf_esb_flush_tx();
+
+    m_tx_payload.pipe    = 0;
+    m_tx_payload.length  = BENCH_REPORT_LEN;
+    m_tx_payload.data[0] = BENCH_PKT_REPORT;
+    m_tx_payload.data[1] = m_test_index;
+    (void)uint32_encode(m_rx_count, &m_tx_payload.data[2]);
+    (void)uint32_encode(rx_crc_errors, &m_tx_payload.data[6]);
+    APP_ERROR_CHECK(nrf_esb_write_payload(&m_tx_payload));
+}
+
+
+/**@brief Function for following the tests of the PTX. */
+static void bench_run(void)
+{
+    nrf_esb_stats_t stats;
+    bench_test_t    test;
+    uint32_t        rx_crc_errors = 0;
+
+    NRF_LOG_PRINTF("BENCH CONFIG role=prx channel=%u\r\n", BENCH_RF_CHANNEL);
+
+    APP_ERROR_CHECK(esb_configure(NULL, NRF_ESB_MODE_PRX, prx_event_handler));
+
+    for (;;)
+    {
+        if (m_start_received && test_get(m_test_index, &test))
+        {
+            // Let the acknowledgement of the start packet go out first.
+            nrf_delay_us(BENCH_SWITCH_DELAY_US / 4);
+
+            m_start_received = false;
+            m_rx_count       = 0;
+            m_last_received  = false;
+            m_last_rx_time   = time_us_get();
+            m_test_running   = true;
+            APP_ERROR_CHECK(esb_configure(&test, NRF_ESB_MODE_PRX, prx_event_handler));
+        }
+
+        if (m_test_running &&
+            (m_last_received || ((time_us_get() - m_last_rx_time) > BENCH_RX_IDLE_TIMEOUT_US)))
+        {
+            APP_ERROR_CHECK(nrf_esb_stats_get(&stats, false));
+            rx_crc_errors  = stats.pipes[0].rx_crc_errors;
+            m_test_running = false;
+
+            APP_ERROR_CHECK(esb_configure(NULL, NRF_ESB_MODE_PRX, prx_event_handler));
+            report_write(rx_crc_errors);
+
+            NRF_LOG_PRINTF("BENCH RX index=%u rx=%u rx_crc_errors=%u\r\n",
+                           m_test_index, m_rx_count, rx_crc_errors);
+        }
+
+        if (m_report_requested)
+        {
+            m_report_requested = false;
+            report_write(rx_crc_errors);
+        }
+
+        // The idle timeout of a test is polled, no event may come.
+        if (!m_test_running)
+        {
+            __WFE();
+        }
+    }
+}
+
+#endif // BENCH_ROLE_PRX
+
+
+int main(void)
+{
+    uint32_t err_code;
+
+    err_code = NRF_LOG_INIT();
+    APP_ERROR_CHECK(err_code);
+
+    clock_start();
+
+    bench_run();
+
+    for (;;)
+    {
+        __WFE();
+    }
+}
+
+/** @} */
@@ -133,6 +133,10 @@ typedef unsigned long UBaseType_t;
 #define portNRF_RTC_PRESCALER  ( (uint32_t) (ROUNDED_DIV(configSYSTICK_CLOCK_HZ, configTICK_RATE_HZ) - 1) )
 /* Maximum RTC ticks */
 #define portNRF_RTC_MAXTICKS   ((1U<<24)-1U)
+/* Called first in the RTC interrupt handler, for the users of the other compare channels of the RTC */
+#ifndef configRTC_IRQ_HOOK
+#define configRTC_IRQ_HOOK()
+#endif
 /*-----------------------------------------------------------*/
 
 /* Internal auxiliary macro */
@@ -145,12 +145,25 @@ void vPortSetupTimerInterrupt( void )
 
 #include "nrf_rtc.h"
 #include "nrf_drv_clock.h"
+#ifdef SOFTDEVICE_PRESENT
+#include "nrf_soc.h"
+#endif
+
 
+#if configUSE_TICKLESS_IDLE == 1
+/* RTC counter value up to which the RTOS tick count has been updated. */
+static uint32_t ulLastTickRtcCount = 0;
+
+/* Set while the ticks are accounted for by vPortSuppressTicksAndSleep(). */
+static volatile BaseType_t xTicklessIdle = pdFALSE;
+#endif
 
 /*-----------------------------------------------------------*/
 
 void xPortSysTickHandler( void )
 {
+    configRTC_IRQ_HOOK();
+
     nrf_rtc_event_clear(portNRF_RTC_REG, NRF_RTC_EVENT_TICK);
 #if configUSE_TICKLESS_IDLE == 1
     nrf_rtc_event_clear(portNRF_RTC_REG, NRF_RTC_EVENT_COMPARE_0);
@@ -161,23 +174,35 @@ void xPortSysTickHandler( void )
     save and then restore the interrupt mask value as its value is already
     known. */
     ( void ) portSET_INTERRUPT_MASK_FROM_ISR();
-    do{
+    {
 #if configUSE_TICKLESS_IDLE == 1
-        TickType_t diff;
-        TickType_t actualTicks = xTaskGetTickCountFromISR();
-        TickType_t hwTicks     = nrf_rtc_counter_get(portNRF_RTC_REG);
-
-        diff = (hwTicks - actualTicks) & portNRF_RTC_MAXTICKS;
-        if(diff <= 0)
+        /* Ticks elapsed while sleeping are accounted for when the idle task wakes up. */
+        if( xTicklessIdle == pdFALSE )
         {
-            break;
+            BaseType_t xSwitchRequired = pdFALSE;
+            uint32_t   ulRtcCount      = nrf_rtc_counter_get(portNRF_RTC_REG);
+            uint32_t   ulTicks         = (ulRtcCount - ulLastTickRtcCount) & portNRF_RTC_MAXTICKS;
+
+            /* Increment the RTOS tick once per RTC tick since the last update, the interrupt
+            may have been delayed by a higher priority one or by a critical region. */
+            ulLastTickRtcCount = ulRtcCount;
+            while( ulTicks-- > 0 )
+            {
+                if( xTaskIncrementTick() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+            }
+
+            if( xSwitchRequired != pdFALSE )
+            {
+                /* A context switch is required.  Context switching is performed in
+                the PendSV interrupt.  Pend the PendSV interrupt. */
+                SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+                __SEV();
+            }
         }
-
-        if(diff > 2) // Correct internat ticks
-        {
-            vTaskStepTick(diff - 1);
-        }
-#endif
+#else
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
@@ -186,7 +211,8 @@ void xPortSysTickHandler( void )
             SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
             __SEV();
         }
-    }while(0);
+#endif
+    }
     portCLEAR_INTERRUPT_MASK_FROM_ISR( 0 );
 }
 
@@ -204,6 +230,9 @@ void vPortSetupTimerInterrupt( void )
     nrf_rtc_int_enable   (portNRF_RTC_REG, RTC_INTENSET_TICK_Msk);
     nrf_rtc_task_trigger (portNRF_RTC_REG, NRF_RTC_TASK_CLEAR);
     nrf_rtc_task_trigger (portNRF_RTC_REG, NRF_RTC_TASK_START);
+#if configUSE_TICKLESS_IDLE == 1
+    ulLastTickRtcCount = 0;
+#endif
 
     NVIC_SetPriority(portNRF_RTC_IRQn, configKERNEL_INTERRUPT_PRIORITY);
     NVIC_EnableIRQ(portNRF_RTC_IRQn);
@@ -213,7 +242,8 @@ void vPortSetupTimerInterrupt( void )
 
 void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
 {
-    TickType_t wakeupTime;
+    uint32_t wakeupTime;
+    uint32_t elapsedTicks;
 
     /* Make sure the SysTick reload value does not overflow the counter. */
     if( xExpectedIdleTime > portNRF_RTC_MAXTICKS - configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
@@ -225,19 +255,21 @@ void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
 
     /* Stop tick events */
     nrf_rtc_int_disable(portNRF_RTC_REG, NRF_RTC_INT_TICK_MASK);
+    xTicklessIdle = pdTRUE;
 
-    /* Configure CTC interrupt */
-    wakeupTime = nrf_rtc_counter_get(portNRF_RTC_REG) + xExpectedIdleTime;
+    /* Configure CTC interrupt. The idle time is counted from the last tick that was processed,
+    not from the current value of the counter. */
+    wakeupTime = ulLastTickRtcCount + xExpectedIdleTime;
     wakeupTime &= portNRF_RTC_MAXTICKS;
     nrf_rtc_cc_set(portNRF_RTC_REG, 0, wakeupTime);
     nrf_rtc_event_clear(portNRF_RTC_REG, NRF_RTC_EVENT_COMPARE_0);
     nrf_rtc_int_enable(portNRF_RTC_REG, NRF_RTC_INT_COMPARE0_MASK);
 
-    if( eTaskConfirmSleepModeStatus() == eAbortSleep )
-    {
-        portENABLE_INTERRUPTS();
-    }
-    else
+    /* The COMPARE event is not generated if the counter is less than 2 ticks from the
+    compare value when it is written, so do not sleep in that case. */
+    elapsedTicks = (nrf_rtc_counter_get(portNRF_RTC_REG) - ulLastTickRtcCount) & portNRF_RTC_MAXTICKS;
+
+    if( ( eTaskConfirmSleepModeStatus() != eAbortSleep ) && ( elapsedTicks + 2 < xExpectedIdleTime ) )
     {
         TickType_t xModifiableIdleTime = xExpectedIdleTime;
         configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
@@ -250,6 +282,7 @@ void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
              * sd_app_evt_wait function. */
             portENABLE_INTERRUPTS();
             sd_app_evt_wait();
+            portDISABLE_INTERRUPTS();
 #else
             /* No SD -  we would just block interrupts globally.
              * BASEPRI cannot be used for that because it would prevent WFE from wake up.
@@ -260,15 +293,37 @@ void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
                 __WFE();
             } while(0 == (NVIC->ISPR[0] | NVIC->ISPR[1]));
             __enable_irq();
+            portDISABLE_INTERRUPTS();
 #endif
         }
         configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
-        portENABLE_INTERRUPTS();
     }
     // We can do operations below safely, because when we are inside vPortSuppressTicksAndSleep
     // scheduler is already suspended.
     nrf_rtc_int_disable(portNRF_RTC_REG, NRF_RTC_INT_COMPARE0_MASK);
+
+    /* Step the tick count over the ticks elapsed while sleeping. The last tick of the expected
+    idle time is left to the tick interrupt, so that the tasks to be unblocked at that tick are
+    processed by xTaskIncrementTick(). */
+    elapsedTicks = (nrf_rtc_counter_get(portNRF_RTC_REG) - ulLastTickRtcCount) & portNRF_RTC_MAXTICKS;
+    if( elapsedTicks >= xExpectedIdleTime )
+    {
+        elapsedTicks = xExpectedIdleTime - 1;
+    }
+    if( elapsedTicks > 0 )
+    {
+        vTaskStepTick( elapsedTicks );
+        ulLastTickRtcCount = (ulLastTickRtcCount + elapsedTicks) & portNRF_RTC_MAXTICKS;
+    }
+    xTicklessIdle = pdFALSE;
+
     nrf_rtc_int_enable (portNRF_RTC_REG, NRF_RTC_INT_TICK_MASK);
+    if( nrf_rtc_counter_get(portNRF_RTC_REG) != ulLastTickRtcCount )
+    {
+        /* Process the remaining ticks without waiting for the next TICK event. */
+        NVIC_SetPendingIRQ(portNRF_RTC_IRQn);
+    }
+    portENABLE_INTERRUPTS();
 }
 
 #endif // configUSE_TICKLESS_IDLE
@@ -715,6 +715,70 @@ ret_code_t adafruit_pn532_ntag2xx_read_page(uint8_t page, uint8_t * p_buffer)
     return NRF_SUCCESS;
 }
 
+ret_code_t adafruit_pn532_tag2_read(uint8_t page, uint8_t * p_buffer)
+{
+    PN532_LOG("Trying to read pages %u-%u\r\n", page, page + 3);
+
+    ret_code_t err_code;
+
+    uint8_t cmd_buf[2];
+    uint8_t response_len = MIFARE_MAX_DATA_EXCHANGE;
+
+    cmd_buf[0] = MIFARE_CMD_READ;
+    cmd_buf[1] = page;
+
+    err_code = adafruit_pn532_in_data_exchange(cmd_buf, 2, p_buffer, &response_len);
+    if (err_code != NRF_SUCCESS)
+    {
+        PN532_LOG("Failed to read pages %d-%d\r\n", page, page + 3);
+        return err_code;
+    }
+
+    if (response_len != MIFARE_MAX_DATA_EXCHANGE)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t adafruit_pn532_ntag2xx_fast_read(uint8_t start_page, uint8_t end_page, uint8_t * p_buffer)
+{
+    if ( (end_page < start_page) ||
+         (end_page - start_page + 1 > NTAG2XX_FAST_READ_MAX_PAGES) ||
+         (end_page > NTAG2XX_MAX_READ_PAGE_NUMBER) )
+    {
+        PN532_LOG("Page range out of range, pages = %d-%d\r\n", start_page, end_page);
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    PN532_LOG("Trying to fast read pages %u-%u\r\n", start_page, end_page);
+
+    ret_code_t err_code;
+
+    uint8_t cmd_buf[3];
+    uint8_t expected_len = (end_page - start_page + 1) * MIFARE_PAGE_SIZE;
+    uint8_t response_len = expected_len;
+
+    cmd_buf[0] = NTAG2XX_CMD_FAST_READ;
+    cmd_buf[1] = start_page;
+    cmd_buf[2] = end_page;
+
+    err_code = adafruit_pn532_in_data_exchange(cmd_buf, 3, p_buffer, &response_len);
+    if (err_code != NRF_SUCCESS)
+    {
+        PN532_LOG("Failed to fast read pages %d-%d\r\n", start_page, end_page);
+        return err_code;
+    }
+
+    if (response_len != expected_len)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    return NRF_SUCCESS;
+}
+
 ret_code_t adafruit_pn532_ntag2xx_write_page(uint8_t page, uint8_t * p_data)
 {
     if ( (page < NTAG2XX_MIN_WRITE_PAGE_NUMBER) || 
@@ -178,6 +178,7 @@
 #define MIFARE_CMD_INCREMENT                (0xC1)
 #define MIFARE_CMD_STORE                    (0xC2)
 #define MIFARE_ULTRALIGHT_CMD_WRITE         (0xA2)
+#define NTAG2XX_CMD_FAST_READ               (0x3A)
 /** @} */
 
 
@@ -188,7 +189,13 @@
 #define PN532_I2C_ADDRESS                   (0x48 >> 1)
 
 /// Size of the buffer used for sending commands and storing responses.
+#ifndef PN532_PACKBUFFSIZ
 #define PN532_PACKBUFFSIZ                   (64)
+#endif
+
+/// Maximum number of pages read by @ref adafruit_pn532_ntag2xx_fast_read, limited by the size
+/// of the InDataExchange response that fits into the buffer of @ref PN532_PACKBUFFSIZ bytes.
+#define NTAG2XX_FAST_READ_MAX_PAGES         ((PN532_PACKBUFFSIZ - PN532_FRAME_OVERHEAD - 3) / 4)
 
 /**
  * @brief Information about the communication between the host and the Adafruit PN532 Shield.
@@ -389,6 +396,39 @@ ret_code_t adafruit_pn532_set_passive_activation_retries(uint8_t max_retries);
  */
 ret_code_t adafruit_pn532_ntag2xx_read_page(uint8_t page, uint8_t * p_buffer);
 
+/**  @brief Function for reading four 4-byte pages starting at the specified address.
+ *
+ *   This function reads 16 bytes with a single READ command, which returns four pages on every
+ *   Type 2 Tag. It needs a quarter of the exchanges of @ref adafruit_pn532_ntag2xx_read_page
+ *   to read a tag. Pages after the last page of the tag are read from the first pages again.
+ *
+ *   @param[in]     page                  The number of the first page to read.
+ *   @param[out]    p_buffer              Pointer to the uint8_t array that will
+ *                                        hold the retrieved data (16 bytes).
+ *
+ *   @retval        NRF_SUCCESS           If the data was read successfully. Otherwise,
+ *                                        an error code is returned.
+ */
+ret_code_t adafruit_pn532_tag2_read(uint8_t page, uint8_t * p_buffer);
+
+/**  @brief Function for reading a range of 4-byte pages with a single FAST_READ command.
+ *
+ *   FAST_READ is supported by NTAG21x tags only. Other tags answer with a NAK and must be
+ *   selected again with @ref adafruit_pn532_read_passive_target_id before the next command.
+ *
+ *   @param[in]     start_page            The number of the first page to read.
+ *   @param[in]     end_page              The number of the last page to read. At most
+ *                                        @ref NTAG2XX_FAST_READ_MAX_PAGES pages can be read.
+ *   @param[out]    p_buffer              Pointer to the uint8_t array that will
+ *                                        hold the retrieved data (4 bytes per page).
+ *
+ *   @retval        NRF_SUCCESS              If the data was read successfully.
+ *   @retval        NRF_ERROR_INVALID_PARAM  If the page range is not valid or too long.
+ *   @retval        NRF_ERROR_INVALID_LENGTH If the tag returned less data than requested.
+ *   @retval        Other                    If an error occurred during the exchange.
+ */
+ret_code_t adafruit_pn532_ntag2xx_fast_read(uint8_t start_page, uint8_t end_page, uint8_t * p_buffer);
+
 /**  @brief Function for writing an entire 4-byte page at the specified block address.
  *
  *   This function writes a 4-byte sequence to the specified page.
@@ -20,6 +20,8 @@
 #ifndef H_BLE_LL_SCHED_
 #define H_BLE_LL_SCHED_
 
+#include "nimble/nimble_opt.h"
+
 /* Time per BLE scheduler slot */
 #define BLE_LL_SCHED_USECS_PER_SLOT (1250)
 
@@ -46,15 +48,27 @@
 struct ble_ll_sched_item;
 typedef int (*sched_cb_func)(struct ble_ll_sched_item *sch);
 
+/*
+ * Schedule item. The start and end times of an item must not be changed
+ * while it is enqueued: with NIMBLE_OPT_LL_SCHED_TREE, the schedule is kept
+ * in a search tree ordered by start time.
+ */
 struct ble_ll_sched_item
 {
     uint8_t         sched_type;
     uint8_t         enqueued;
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+    uint8_t         tree_height;
+#endif
     uint32_t        start_time;
     uint32_t        end_time;
     void            *cb_arg;
     sched_cb_func   sched_cb;
     TAILQ_ENTRY(ble_ll_sched_item) link;
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+    struct ble_ll_sched_item *tree_left;
+    struct ble_ll_sched_item *tree_right;
+#endif
 };
 
 /* Initialize the scheduler */
@@ -49,9 +49,16 @@
  * receive a scan response from? Implement this.
  */
 
-/* Dont allow more than 255 of these entries */
-#if NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS > 255
-    #error "Cannot have more than 255 duplicate entries!"
+/* The duplicate advertiser table is indexed by a hash of the address */
+#if (NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS & (NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS - 1))
+    #error "Number of duplicate entries must be a power of 2!"
+#endif
+#if NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS > 256
+    #error "Cannot have more than 256 duplicate entries!"
+#endif
+#if (NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES == 0) || \
+    (NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES > NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS)
+    #error "Duplicate probes must be between 1 and the number of entries!"
 #endif
 #if NIMBLE_OPT_LL_NUM_SCAN_RSP_ADVS > 255
     #error "Cannot have more than 255 scan response entries!"
@@ -81,9 +88,26 @@ static uint8_t g_ble_ll_scan_num_rsp_advs;
 struct ble_ll_scan_advertisers
 g_ble_ll_scan_rsp_advs[NIMBLE_OPT_LL_NUM_SCAN_RSP_ADVS];
 
+/*
+ * Structure used to filter duplicate advertising events to the host. The
+ * entries form an open-addressed hash table: an advertiser is stored in one
+ * of the NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES entries following the hash of its
+ * address. Entries are never removed while scanning, so an entry with no
+ * flags set ends the search. When all the probed entries are used, the least
+ * recently seen advertiser is replaced.
+ */
+struct ble_ll_scan_dup_adv
+{
+    uint8_t             sc_adv_flags;
+    uint16_t            sc_lru;
+    struct ble_dev_addr adv_addr;
+};
+
+#define BLE_LL_SCAN_DUP_ADV_MASK    (NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS - 1)
+
 /* Used to filter duplicate advertising events to host */
-static uint8_t g_ble_ll_scan_num_dup_advs;
-struct ble_ll_scan_advertisers
+static uint16_t g_ble_ll_scan_dup_adv_clock;
+struct ble_ll_scan_dup_adv
 g_ble_ll_scan_dup_advs[NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS];
 
 /* See Vol 6 Part B Section 4.4.3.2. Active scanning backoff */
@@ -189,47 +213,81 @@ ble_ll_scan_req_pdu_make(struct ble_ll_scan_sm *scansm, uint8_t *adv_addr,
     memcpy(dptr + BLE_DEV_ADDR_LEN, adv_addr, BLE_DEV_ADDR_LEN);
 }
 
+/**
+ * Computes the index of the first entry of the duplicate advertiser table in
+ * which an address may be stored.
+ *
+ * @param addr Pointer to address
+ * @param txadd TxAdd bit. 0: public; random otherwise
+ *
+ * @return uint8_t Index of the first entry to probe
+ */
+static uint8_t
+ble_ll_scan_dup_adv_hash(uint8_t *addr, uint8_t txadd)
+{
+    uint32_t hash;
+
+    hash = ((uint32_t)addr[0] | ((uint32_t)addr[1] << 8) |
+            ((uint32_t)addr[2] << 16) | ((uint32_t)addr[3] << 24)) ^
+           ((uint32_t)addr[4] << 5) ^ ((uint32_t)addr[5] << 13) ^ txadd;
+
+    /* Fibonacci hashing: the top bits are the best mixed */
+    hash *= 0x9E3779B1UL;
+
+    return (uint8_t)((hash >> 24) & BLE_LL_SCAN_DUP_ADV_MASK);
+}
+
 /**
  * Checks to see if an advertiser is on the duplicate address list.
  *
+ * NOTE: this function does not modify the table and only probes a bounded
+ * number of entries, so it can be called from interrupt context.
+ *
  * @param addr Pointer to address
  * @param txadd TxAdd bit. 0: public; random otherwise
  *
- * @return uint8_t 0: not on list; any other value is
+ * @return struct ble_ll_scan_dup_adv * NULL: not on list, entry otherwise
  */
-static struct ble_ll_scan_advertisers *
+static struct ble_ll_scan_dup_adv *
 ble_ll_scan_find_dup_adv(uint8_t *addr, uint8_t txadd)
 {
-    uint8_t num_advs;
-    struct ble_ll_scan_advertisers *adv;
-
-    /* Do we have an address match? Must match address type */
-    adv = &g_ble_ll_scan_dup_advs[0];
-    num_advs = g_ble_ll_scan_num_dup_advs;
-    while (num_advs) {
-        if (!memcmp(&adv->adv_addr, addr, BLE_DEV_ADDR_LEN)) {
-            /* Address type must match */
-            if (txadd) {
-                if ((adv->sc_adv_flags & BLE_LL_SC_ADV_F_RANDOM_ADDR) == 0) {
-                    goto next_dup_adv;
-                }
-            } else {
-                if (adv->sc_adv_flags & BLE_LL_SC_ADV_F_RANDOM_ADDR) {
-                    goto next_dup_adv;
-                }
-            }
+    uint8_t i;
+    uint8_t idx;
+    uint8_t addr_flag;
+    struct ble_ll_scan_dup_adv *adv;
+
+    addr_flag = txadd ? BLE_LL_SC_ADV_F_RANDOM_ADDR : 0;
+    idx = ble_ll_scan_dup_adv_hash(addr, txadd);
+    for (i = 0; i < NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES; ++i) {
+        adv = &g_ble_ll_scan_dup_advs[(idx + i) & BLE_LL_SCAN_DUP_ADV_MASK];
+
+        /* Unused entry: the advertiser is not on the list */
+        if (adv->sc_adv_flags == 0) {
+            break;
+        }
 
+        /* Address and address type must match */
+        if (((adv->sc_adv_flags & BLE_LL_SC_ADV_F_RANDOM_ADDR) == addr_flag) &&
+            !memcmp(&adv->adv_addr, addr, BLE_DEV_ADDR_LEN)) {
             return adv;
         }
-
-next_dup_adv:
-        ++adv;
-        --num_advs;
     }
 
     return NULL;
 }
 
+/**
+ * Marks a duplicate advertiser entry as the most recently seen one.
+ *
+ * @param adv Pointer to entry
+ */
+static void
+ble_ll_scan_dup_adv_touch(struct ble_ll_scan_dup_adv *adv)
+{
+    ++g_ble_ll_scan_dup_adv_clock;
+    adv->sc_lru = g_ble_ll_scan_dup_adv_clock;
+}
+
 /**
  * Check if a packet is a duplicate advertising packet.
  *
@@ -241,19 +299,22 @@ next_dup_adv:
 int
 ble_ll_scan_is_dup_adv(uint8_t pdu_type, uint8_t txadd, uint8_t *addr)
 {
-    struct ble_ll_scan_advertisers *adv;
+    uint8_t flag;
+    struct ble_ll_scan_dup_adv *adv;
 
     adv = ble_ll_scan_find_dup_adv(addr, txadd);
     if (adv) {
         /* Check appropriate flag (based on type of PDU) */
         if (pdu_type == BLE_ADV_PDU_TYPE_ADV_DIRECT_IND) {
-            if (adv->sc_adv_flags & BLE_LL_SC_ADV_F_DIRECT_RPT_SENT) {
-                return 1;
-            }
+            flag = BLE_LL_SC_ADV_F_DIRECT_RPT_SENT;
         } else {
-            if (adv->sc_adv_flags & BLE_LL_SC_ADV_F_ADV_RPT_SENT) {
-                return 1;
-            }
+            flag = BLE_LL_SC_ADV_F_ADV_RPT_SENT;
+        }
+
+        if (adv->sc_adv_flags & flag) {
+            /* Keep advertisers that are still heard from in the table */
+            ble_ll_scan_dup_adv_touch(adv);
+            return 1;
         }
     }
 
@@ -263,7 +324,8 @@ ble_ll_scan_is_dup_adv(uint8_t pdu_type, uint8_t txadd, uint8_t *addr)
 /**
  * Add an advertiser the list of duplicate advertisers. An address gets added to
  * the list of duplicate addresses when the controller sends an advertising
- * report to the host.
+ * report to the host. If the probed entries are all used, the least recently
+ * seen advertiser is replaced; a report may then be sent again for it.
  *
  * @param addr   Pointer to advertisers address or identity address
  * @param Txadd. TxAdd bit (0 public, random otherwise)
@@ -272,23 +334,35 @@ ble_ll_scan_is_dup_adv(uint8_t pdu_type, uint8_t txadd, uint8_t *addr)
 void
 ble_ll_scan_add_dup_adv(uint8_t *addr, uint8_t txadd, uint8_t subev)
 {
-    uint8_t num_advs;
-    struct ble_ll_scan_advertisers *adv;
+    uint8_t i;
+    uint8_t idx;
+    uint16_t age;
+    uint16_t oldest_age;
+    struct ble_ll_scan_dup_adv *adv;
+    struct ble_ll_scan_dup_adv *entry;
 
     /* Check to see if on list. */
     adv = ble_ll_scan_find_dup_adv(addr, txadd);
     if (!adv) {
-        /* XXX: for now, if we dont have room, just leave */
-        num_advs = g_ble_ll_scan_num_dup_advs;
-        if (num_advs == NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS) {
-            return;
+        /* Use the first unused entry, or else the least recently seen one */
+        idx = ble_ll_scan_dup_adv_hash(addr, txadd);
+        oldest_age = 0;
+        for (i = 0; i < NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES; ++i) {
+            entry = &g_ble_ll_scan_dup_advs[(idx + i) & BLE_LL_SCAN_DUP_ADV_MASK];
+            if (entry->sc_adv_flags == 0) {
+                adv = entry;
+                break;
+            }
+
+            age = (uint16_t)(g_ble_ll_scan_dup_adv_clock - entry->sc_lru);
+            if (!adv || (age > oldest_age)) {
+                adv = entry;
+                oldest_age = age;
+            }
         }
 
-        /* Add the advertiser to the array */
-        adv = &g_ble_ll_scan_dup_advs[num_advs];
+        /* Add the advertiser to the table */
         memcpy(&adv->adv_addr, addr, BLE_DEV_ADDR_LEN);
-        ++g_ble_ll_scan_num_dup_advs;
-
         adv->sc_adv_flags = 0;
         if (txadd) {
             adv->sc_adv_flags |= BLE_LL_SC_ADV_F_RANDOM_ADDR;
@@ -300,6 +374,7 @@ ble_ll_scan_add_dup_adv(uint8_t *addr, uint8_t txadd, uint8_t subev)
     } else {
         adv->sc_adv_flags |= BLE_LL_SC_ADV_F_ADV_RPT_SENT;
     }
+    ble_ll_scan_dup_adv_touch(adv);
 }
 
 /**
@@ -724,7 +799,7 @@ ble_ll_scan_sm_start(struct ble_ll_scan_sm *scansm)
 
     /* Forget filtered advertisers from previous scan. */
     g_ble_ll_scan_num_rsp_advs = 0;
-    g_ble_ll_scan_num_dup_advs = 0;
+    memset(&g_ble_ll_scan_dup_advs[0], 0, sizeof(g_ble_ll_scan_dup_advs));
 
     /* XXX: align to current or next slot???. */
     /* Schedule start time now */
@@ -1449,7 +1524,7 @@ ble_ll_scan_reset(void)
     g_ble_ll_scan_num_rsp_advs = 0;
     memset(&g_ble_ll_scan_rsp_advs[0], 0, sizeof(g_ble_ll_scan_rsp_advs));
 
-    g_ble_ll_scan_num_dup_advs = 0;
+    g_ble_ll_scan_dup_adv_clock = 0;
     memset(&g_ble_ll_scan_dup_advs[0], 0, sizeof(g_ble_ll_scan_dup_advs));
 
     /* Call the init function again */
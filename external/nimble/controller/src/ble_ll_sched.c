@@ -51,6 +51,244 @@ int32_t g_ble_ll_sched_max_late;
 /* Queue for timers */
 TAILQ_HEAD(ll_sched_qhead, ble_ll_sched_item) g_ble_ll_sched_q;
 
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+/*
+ * Search tree of the schedule queue. The queue keeps the items in time order
+ * for walking from an item to the next; the tree, an AVL tree ordered by
+ * start time, finds where to start the walk in logarithmic time. As items in
+ * the schedule never overlap, their end times are in the same order as their
+ * start times.
+ */
+static struct ble_ll_sched_item *g_ble_ll_sched_tree;
+
+#define BLE_LL_SCHED_TREE_HEIGHT(n) ((n) ? (n)->tree_height : 0)
+
+/**
+ * Compares the position of two schedule items in the tree. Items that start
+ * at the same time are ordered by address.
+ *
+ * @return int < 0: s1 before s2; 0: same item; > 0: s1 after s2
+ */
+static int
+ble_ll_sched_tree_cmp(struct ble_ll_sched_item *s1,
+                      struct ble_ll_sched_item *s2)
+{
+    int32_t dt;
+
+    dt = (int32_t)(s1->start_time - s2->start_time);
+    if (dt != 0) {
+        return (dt < 0) ? -1 : 1;
+    }
+    if (s1 == s2) {
+        return 0;
+    }
+    return ((uintptr_t)s1 < (uintptr_t)s2) ? -1 : 1;
+}
+
+static void
+ble_ll_sched_tree_fix_height(struct ble_ll_sched_item *node)
+{
+    uint8_t hl;
+    uint8_t hr;
+
+    hl = BLE_LL_SCHED_TREE_HEIGHT(node->tree_left);
+    hr = BLE_LL_SCHED_TREE_HEIGHT(node->tree_right);
+    node->tree_height = ((hl > hr) ? hl : hr) + 1;
+}
+
+static struct ble_ll_sched_item *
+ble_ll_sched_tree_rotate_right(struct ble_ll_sched_item *node)
+{
+    struct ble_ll_sched_item *left;
+
+    left = node->tree_left;
+    node->tree_left = left->tree_right;
+    left->tree_right = node;
+    ble_ll_sched_tree_fix_height(node);
+    ble_ll_sched_tree_fix_height(left);
+    return left;
+}
+
+static struct ble_ll_sched_item *
+ble_ll_sched_tree_rotate_left(struct ble_ll_sched_item *node)
+{
+    struct ble_ll_sched_item *right;
+
+    right = node->tree_right;
+    node->tree_right = right->tree_left;
+    right->tree_left = node;
+    ble_ll_sched_tree_fix_height(node);
+    ble_ll_sched_tree_fix_height(right);
+    return right;
+}
+
+/**
+ * Restores the balance of a subtree after an insertion or a removal in one
+ * of its children.
+ *
+ * @return struct ble_ll_sched_item * New root of the subtree
+ */
+static struct ble_ll_sched_item *
+ble_ll_sched_tree_balance(struct ble_ll_sched_item *node)
+{
+    int bf;
+    struct ble_ll_sched_item *child;
+
+    ble_ll_sched_tree_fix_height(node);
+    bf = BLE_LL_SCHED_TREE_HEIGHT(node->tree_left) -
+         BLE_LL_SCHED_TREE_HEIGHT(node->tree_right);
+    if (bf > 1) {
+        child = node->tree_left;
+        if (BLE_LL_SCHED_TREE_HEIGHT(child->tree_left) <
+            BLE_LL_SCHED_TREE_HEIGHT(child->tree_right)) {
+            node->tree_left = ble_ll_sched_tree_rotate_left(child);
+        }
+        return ble_ll_sched_tree_rotate_right(node);
+    }
+    if (bf < -1) {
+        child = node->tree_right;
+        if (BLE_LL_SCHED_TREE_HEIGHT(child->tree_right) <
+            BLE_LL_SCHED_TREE_HEIGHT(child->tree_left)) {
+            node->tree_right = ble_ll_sched_tree_rotate_right(child);
+        }
+        return ble_ll_sched_tree_rotate_left(node);
+    }
+    return node;
+}
+
+static struct ble_ll_sched_item *
+ble_ll_sched_tree_insert(struct ble_ll_sched_item *root,
+                         struct ble_ll_sched_item *sch)
+{
+    if (!root) {
+        sch->tree_left = NULL;
+        sch->tree_right = NULL;
+        sch->tree_height = 1;
+        return sch;
+    }
+
+    if (ble_ll_sched_tree_cmp(sch, root) < 0) {
+        root->tree_left = ble_ll_sched_tree_insert(root->tree_left, sch);
+    } else {
+        root->tree_right = ble_ll_sched_tree_insert(root->tree_right, sch);
+    }
+    return ble_ll_sched_tree_balance(root);
+}
+
+static struct ble_ll_sched_item *
+ble_ll_sched_tree_remove_min(struct ble_ll_sched_item *root,
+                             struct ble_ll_sched_item **min)
+{
+    if (!root->tree_left) {
+        *min = root;
+        return root->tree_right;
+    }
+    root->tree_left = ble_ll_sched_tree_remove_min(root->tree_left, min);
+    return ble_ll_sched_tree_balance(root);
+}
+
+static struct ble_ll_sched_item *
+ble_ll_sched_tree_remove(struct ble_ll_sched_item *root,
+                         struct ble_ll_sched_item *sch)
+{
+    int cmp;
+    struct ble_ll_sched_item *min;
+    struct ble_ll_sched_item *right;
+
+    if (!root) {
+        return NULL;
+    }
+
+    cmp = ble_ll_sched_tree_cmp(sch, root);
+    if (cmp < 0) {
+        root->tree_left = ble_ll_sched_tree_remove(root->tree_left, sch);
+    } else if (cmp > 0) {
+        root->tree_right = ble_ll_sched_tree_remove(root->tree_right, sch);
+    } else {
+        /* Replace the item with the first item of its right subtree */
+        if (!root->tree_right) {
+            return root->tree_left;
+        }
+        right = ble_ll_sched_tree_remove_min(root->tree_right, &min);
+        min->tree_left = root->tree_left;
+        min->tree_right = right;
+        root = min;
+    }
+    return ble_ll_sched_tree_balance(root);
+}
+#endif
+
+/**
+ * Inserts a schedule item in the schedule queue.
+ *
+ * @param entry Item to insert before. NULL: insert at tail
+ * @param sch   Item to insert
+ */
+static void
+ble_ll_sched_q_insert(struct ble_ll_sched_item *entry,
+                      struct ble_ll_sched_item *sch)
+{
+    if (entry) {
+        TAILQ_INSERT_BEFORE(entry, sch, link);
+    } else {
+        TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
+    }
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+    g_ble_ll_sched_tree = ble_ll_sched_tree_insert(g_ble_ll_sched_tree, sch);
+#endif
+}
+
+static void
+ble_ll_sched_q_remove(struct ble_ll_sched_item *sch)
+{
+    TAILQ_REMOVE(&g_ble_ll_sched_q, sch, link);
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+    g_ble_ll_sched_tree = ble_ll_sched_tree_remove(g_ble_ll_sched_tree, sch);
+#endif
+}
+
+/**
+ * Finds the first schedule item that ends after a given time. Items before
+ * it cannot overlap an item that starts at this time.
+ *
+ * @param start_time Start time of the item to schedule
+ *
+ * @return struct ble_ll_sched_item * First item that ends after start_time;
+ * NULL if there is none.
+ */
+static struct ble_ll_sched_item *
+ble_ll_sched_find_start(uint32_t start_time)
+{
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+    struct ble_ll_sched_item *node;
+    struct ble_ll_sched_item *prev;
+
+    /* Find the last item that starts at or before start_time */
+    prev = NULL;
+    node = g_ble_ll_sched_tree;
+    while (node) {
+        if ((int32_t)(node->start_time - start_time) <= 0) {
+            prev = node;
+            node = node->tree_right;
+        } else {
+            node = node->tree_left;
+        }
+    }
+
+    if (!prev) {
+        return TAILQ_FIRST(&g_ble_ll_sched_q);
+    }
+    if ((int32_t)(prev->end_time - start_time) > 0) {
+        return prev;
+    }
+    return TAILQ_NEXT(prev, link);
+#else
+    /* Walk the whole queue: cheaper than a tree for a few items */
+    (void)start_time;
+    return TAILQ_FIRST(&g_ble_ll_sched_q);
+#endif
+}
+
 /**
  * Checks if two events in the schedule will overlap in time. NOTE: consecutive
  * schedule items can end and start at the same time.
@@ -112,7 +350,7 @@ ble_ll_sched_conn_overlap(struct ble_ll_sched_item *entry)
     if (entry->sched_type == BLE_LL_SCHED_TYPE_CONN) {
         connsm = (struct ble_ll_conn_sm *)entry->cb_arg;
         entry->enqueued = 0;
-        TAILQ_REMOVE(&g_ble_ll_sched_q, entry, link);
+        ble_ll_sched_q_remove(entry);
         ble_ll_event_send(&connsm->conn_ev_end);
         rc = 0;
     } else {
@@ -129,7 +367,7 @@ ble_ll_sched_insert_if_empty(struct ble_ll_sched_item *sch)
 
     entry = TAILQ_FIRST(&g_ble_ll_sched_q);
     if (!entry) {
-        TAILQ_INSERT_HEAD(&g_ble_ll_sched_q, sch, link);
+        ble_ll_sched_q_insert(NULL, sch);
         sch->enqueued = 1;
     }
     return entry;
@@ -179,7 +417,8 @@ ble_ll_sched_conn_reschedule(struct ble_ll_conn_sm *connsm)
     start_overlap = NULL;
     end_overlap = NULL;
     rc = 0;
-    TAILQ_FOREACH(entry, &g_ble_ll_sched_q, link) {
+    for (entry = ble_ll_sched_find_start(sch->start_time); entry;
+         entry = TAILQ_NEXT(entry, link)) {
         if (ble_ll_sched_is_overlap(sch, entry)) {
             /* Only insert if this element is older than all that we overlap */
             if ((entry->sched_type == BLE_LL_SCHED_TYPE_ADV) ||
@@ -196,18 +435,15 @@ ble_ll_sched_conn_reschedule(struct ble_ll_conn_sm *connsm)
                 end_overlap = entry;
             }
         } else {
-            if ((int32_t)(sch->end_time - entry->start_time) < 0) {
+            if ((int32_t)(sch->end_time - entry->start_time) <= 0) {
                 rc = 0;
-                TAILQ_INSERT_BEFORE(entry, sch, link);
                 break;
             }
         }
     }
 
     if (!rc) {
-        if (!entry) {
-            TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
-        }
+        ble_ll_sched_q_insert(entry, sch);
         sch->enqueued = 1;
     }
 
@@ -220,7 +456,7 @@ ble_ll_sched_conn_reschedule(struct ble_ll_conn_sm *connsm)
             ble_ll_event_send(&tmp->conn_ev_end);
         }
 
-        TAILQ_REMOVE(&g_ble_ll_sched_q, entry, link);
+        ble_ll_sched_q_remove(entry);
         entry->enqueued = 0;
 
         if (entry == end_overlap) {
@@ -302,6 +538,8 @@ ble_ll_sched_master_new(struct ble_ll_conn_sm *connsm, uint32_t adv_rxend,
         earliest_end = earliest_start + dur;
     }
     initial_start = earliest_start;
+    sch->start_time = earliest_start;
+    sch->end_time = earliest_end;
 
     if (!ble_ll_sched_insert_if_empty(sch)) {
         /* Nothing in schedule. Schedule as soon as possible */
@@ -309,16 +547,17 @@ ble_ll_sched_master_new(struct ble_ll_conn_sm *connsm, uint32_t adv_rxend,
         connsm->tx_win_off = 0;
     } else {
         cputime_timer_stop(&g_ble_ll_sched_timer);
-        TAILQ_FOREACH(entry, &g_ble_ll_sched_q, link) {
+        for (entry = ble_ll_sched_find_start(earliest_start); entry;
+             entry = TAILQ_NEXT(entry, link)) {
             /* Set these because overlap function needs them to be set */
             sch->start_time = earliest_start;
             sch->end_time = earliest_end;
 
             /* We can insert if before entry in list */
-            if ((int32_t)(sch->end_time - entry->start_time) < 0) {
+            if ((int32_t)(sch->end_time - entry->start_time) <= 0) {
                 if ((earliest_start - initial_start) <= itvl_t) {
                     rc = 0;
-                    TAILQ_INSERT_BEFORE(entry, sch, link);
+                    ble_ll_sched_q_insert(entry, sch);
                 }
                 break;
             }
@@ -334,7 +573,9 @@ ble_ll_sched_master_new(struct ble_ll_conn_sm *connsm, uint32_t adv_rxend,
         if (!entry) {
             if ((earliest_start - initial_start) <= itvl_t) {
                 rc = 0;
-                TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
+                sch->start_time = earliest_start;
+                sch->end_time = earliest_end;
+                ble_ll_sched_q_insert(NULL, sch);
             }
         }
 
@@ -398,12 +639,20 @@ ble_ll_sched_slave_new(struct ble_ll_conn_sm *connsm)
         rc = 0;
     } else {
         cputime_timer_stop(&g_ble_ll_sched_timer);
+        entry = ble_ll_sched_find_start(sch->start_time);
         while (1) {
-            next_sch = entry->link.tqe_next;
+            /* Insert at tail if none left to check */
+            if (!entry) {
+                rc = 0;
+                ble_ll_sched_q_insert(NULL, sch);
+                break;
+            }
+
+            next_sch = TAILQ_NEXT(entry, link);
             /* Insert if event ends before next starts */
-            if ((int32_t)(sch->end_time - entry->start_time) < 0) {
+            if ((int32_t)(sch->end_time - entry->start_time) <= 0) {
                 rc = 0;
-                TAILQ_INSERT_BEFORE(entry, sch, link);
+                ble_ll_sched_q_insert(entry, sch);
                 break;
             }
 
@@ -416,13 +665,6 @@ ble_ll_sched_slave_new(struct ble_ll_conn_sm *connsm)
 
             /* Move to next entry */
             entry = next_sch;
-
-            /* Insert at tail if none left to check */
-            if (!entry) {
-                rc = 0;
-                TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
-                break;
-            }
         }
 
         if (!rc) {
@@ -474,11 +716,12 @@ ble_ll_sched_adv_new(struct ble_ll_sched_item *sch)
         adv_start = sch->start_time;
     } else {
         cputime_timer_stop(&g_ble_ll_sched_timer);
-        TAILQ_FOREACH(entry, &g_ble_ll_sched_q, link) {
+        for (entry = ble_ll_sched_find_start(sch->start_time); entry;
+             entry = TAILQ_NEXT(entry, link)) {
             /* We can insert if before entry in list */
-            if ((int32_t)(sch->end_time - entry->start_time) < 0) {
+            if ((int32_t)(sch->end_time - entry->start_time) <= 0) {
                 rc = 0;
-                TAILQ_INSERT_BEFORE(entry, sch, link);
+                ble_ll_sched_q_insert(entry, sch);
                 break;
             }
 
@@ -492,7 +735,7 @@ ble_ll_sched_adv_new(struct ble_ll_sched_item *sch)
 
         if (!entry) {
             rc = 0;
-            TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
+            ble_ll_sched_q_insert(NULL, sch);
         }
         adv_start = sch->start_time;
 
@@ -539,12 +782,20 @@ ble_ll_sched_adv_reschedule(struct ble_ll_sched_item *sch)
     entry = ble_ll_sched_insert_if_empty(sch);
     if (entry) {
         cputime_timer_stop(&g_ble_ll_sched_timer);
+        entry = ble_ll_sched_find_start(sch->start_time);
         while (1) {
+            /* Insert at tail if none left to check */
+            if (!entry) {
+                rc = 0;
+                ble_ll_sched_q_insert(NULL, sch);
+                break;
+            }
+
             /* Insert before if adv event is before this event */
-            next_sch = entry->link.tqe_next;
-            if ((int32_t)(sch->end_time - entry->start_time) < 0) {
+            next_sch = TAILQ_NEXT(entry, link);
+            if ((int32_t)(sch->end_time - entry->start_time) <= 0) {
                 rc = 0;
-                TAILQ_INSERT_BEFORE(entry, sch, link);
+                ble_ll_sched_q_insert(entry, sch);
                 break;
             }
 
@@ -556,13 +807,6 @@ ble_ll_sched_adv_reschedule(struct ble_ll_sched_item *sch)
 
             /* Move to next entry */
             entry = next_sch;
-
-            /* Insert at tail if none left to check */
-            if (!entry) {
-                rc = 0;
-                TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
-                break;
-            }
         }
 
         if (!rc) {
@@ -603,7 +847,7 @@ ble_ll_sched_rmv_elem(struct ble_ll_sched_item *sch)
             cputime_timer_stop(&g_ble_ll_sched_timer);
         }
 
-        TAILQ_REMOVE(&g_ble_ll_sched_q, sch, link);
+        ble_ll_sched_q_remove(sch);
         sch->enqueued = 0;
 
         if (first == sch) {
@@ -682,7 +926,7 @@ ble_ll_sched_run(void *arg)
             }
 #endif
             /* Remove schedule item and execute the callback */
-            TAILQ_REMOVE(&g_ble_ll_sched_q, sch, link);
+            ble_ll_sched_q_remove(sch);
             sch->enqueued = 0;
             ble_ll_sched_execute_item(sch);
         } else {
@@ -743,5 +987,11 @@ ble_ll_sched_init(void)
 {
     /* Initialize cputimer for the scheduler */
     cputime_timer_init(&g_ble_ll_sched_timer, ble_ll_sched_run, NULL);
+
+    /* Initialize the (empty) schedule queue */
+    TAILQ_INIT(&g_ble_ll_sched_q);
+#if (NIMBLE_OPT_LL_SCHED_TREE == 1)
+    g_ble_ll_sched_tree = NULL;
+#endif
     return 0;
 }
@@ -440,6 +440,7 @@ int ble_gatts_count_cfg(const struct ble_gatt_svc_def *defs,
                         struct ble_hs_cfg *cfg);
 
 void ble_gatts_chr_updated(uint16_t chr_def_handle);
+uint32_t ble_gatts_db_hash(void);
 
 int ble_gatts_find_svc(const void *uuid128, uint16_t *out_handle);
 int ble_gatts_find_chr(const void *svc_uuid128, const void *chr_uuid128,
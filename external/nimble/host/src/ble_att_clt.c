@@ -866,7 +866,7 @@ ble_att_clt_tx_write_req_or_cmd(uint16_t conn_handle,
 {
     int rc;
 
-    txom = os_mbuf_prepend_pullup(txom, BLE_ATT_WRITE_REQ_BASE_SZ);
+    txom = ble_hs_mbuf_prepend_hdr(txom, BLE_ATT_WRITE_REQ_BASE_SZ);
     if (txom == NULL) {
         return BLE_HS_ENOMEM;
     }
@@ -973,7 +973,7 @@ ble_att_clt_tx_prep_write(uint16_t conn_handle,
         goto err;
     }
 
-    txom = os_mbuf_prepend_pullup(txom, BLE_ATT_PREP_WRITE_CMD_BASE_SZ);
+    txom = ble_hs_mbuf_prepend_hdr(txom, BLE_ATT_PREP_WRITE_CMD_BASE_SZ);
     if (txom == NULL) {
         rc = BLE_HS_ENOMEM;
         goto err;
@@ -1105,7 +1105,7 @@ ble_att_clt_tx_notify(uint16_t conn_handle,
         goto err;
     }
 
-    txom = os_mbuf_prepend_pullup(txom, BLE_ATT_NOTIFY_REQ_BASE_SZ);
+    txom = ble_hs_mbuf_prepend_hdr(txom, BLE_ATT_NOTIFY_REQ_BASE_SZ);
     if (txom == NULL) {
         rc = BLE_HS_ENOMEM;
         goto err;
@@ -1147,7 +1147,7 @@ ble_att_clt_tx_indicate(uint16_t conn_handle,
         goto err;
     }
 
-    txom = os_mbuf_prepend_pullup(txom, BLE_ATT_INDICATE_REQ_BASE_SZ);
+    txom = ble_hs_mbuf_prepend_hdr(txom, BLE_ATT_INDICATE_REQ_BASE_SZ);
     if (txom == NULL) {
         rc = BLE_HS_ENOMEM;
         goto err;
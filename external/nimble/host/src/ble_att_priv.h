@@ -145,9 +145,30 @@ int ble_att_svr_register_uuid16(uint16_t uuid16, uint8_t flags,
                                 uint16_t *handle_id, ble_att_svr_access_fn *cb,
                                 void *cb_arg);
 
+/**
+ * The number of buckets in the UUID index of the attribute table.  Must be a
+ * power of two.
+ */
+#ifndef BLE_ATT_SVR_UUID_BUCKETS
+#define BLE_ATT_SVR_UUID_BUCKETS    32
+#endif
+
+/**
+ * If nonzero, the attribute table is a static array of this many entries,
+ * indexed by handle, instead of a pool of g_ble_hs_cfg.max_attrs entries
+ * allocated at init.  Registration then allocates nothing, and max_attrs is
+ * ignored.
+ */
+#ifndef BLE_ATT_SVR_STATIC_ATTRS
+#define BLE_ATT_SVR_STATIC_ATTRS    0
+#endif
+
 struct ble_att_svr_entry {
     struct list_head ha_node;
 
+    /* Next attribute in the same UUID index bucket, in handle order. */
+    struct ble_att_svr_entry *ha_uuid_next;
+
     uint8_t ha_uuid[16];
     uint8_t ha_flags;
     uint8_t ha_pad1;
@@ -182,6 +203,7 @@ ble_att_svr_find_by_uuid(struct ble_att_svr_entry *start_at,
                          const uint8_t *uuid,
                          uint16_t end_handle);
 uint16_t ble_att_svr_prev_handle(void);
+int ble_att_svr_db_hash(uint32_t *out_hash);
 int ble_att_svr_rx_mtu(uint16_t conn_handle, struct os_mbuf **rxom);
 struct ble_att_svr_entry *ble_att_svr_find_by_handle(uint16_t handle_id);
 int ble_att_svr_rx_find_info(uint16_t conn_handle, struct os_mbuf **rxom);
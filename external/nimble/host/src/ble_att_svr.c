@@ -32,9 +32,33 @@ static struct ble_att_svr_entry_list ble_att_svr_list;
 
 static uint16_t ble_att_svr_id;
 
+#if BLE_ATT_SVR_STATIC_ATTRS
+/**
+ * Handles are assigned consecutively from 1, so the entry of handle h is
+ * ble_att_svr_entries[h - 1].  Registration takes the next slot; nothing is
+ * allocated.
+ */
+static struct ble_att_svr_entry ble_att_svr_entries[BLE_ATT_SVR_STATIC_ATTRS];
+#else
 static void *ble_att_svr_entry_mem = NULL;
 static struct os_mempool ble_att_svr_entry_pool;
 
+/**
+ * Handles are assigned consecutively from 1, so the entry of handle h is at
+ * index h - 1.
+ */
+static struct ble_att_svr_entry **ble_att_svr_entry_tbl = NULL;
+#endif
+
+/**
+ * UUID index: the attributes of each bucket are chained in handle order
+ * through ha_uuid_next.
+ */
+static struct ble_att_svr_entry *
+    ble_att_svr_uuid_head[BLE_ATT_SVR_UUID_BUCKETS];
+static struct ble_att_svr_entry *
+    ble_att_svr_uuid_tail[BLE_ATT_SVR_UUID_BUCKETS];
+
 static void *ble_att_svr_prep_entry_mem;
 static struct os_mempool ble_att_svr_prep_entry_pool;
 
@@ -43,14 +67,52 @@ ble_att_svr_entry_alloc(void)
 {
     struct ble_att_svr_entry *entry;
 
+#if BLE_ATT_SVR_STATIC_ATTRS
+    if (ble_att_svr_id >= BLE_ATT_SVR_STATIC_ATTRS) {
+        return NULL;
+    }
+    entry = ble_att_svr_entries + ble_att_svr_id;
+#else
     entry = os_memblock_get(&ble_att_svr_entry_pool);
-    if (entry != NULL) {
-        memset(entry, 0, sizeof *entry);
+    if (entry == NULL) {
+        return NULL;
     }
+#endif
 
+    memset(entry, 0, sizeof *entry);
     return entry;
 }
 
+#define BLE_ATT_SVR_FNV_OFFSET  2166136261UL
+
+static uint32_t
+ble_att_svr_fnv(uint32_t hash, const void *data, int len)
+{
+    const uint8_t *u8p;
+    int i;
+
+    /* FNV-1a. */
+    u8p = data;
+    for (i = 0; i < len; i++) {
+        hash ^= u8p[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+static int
+ble_att_svr_uuid_bucket(const uint8_t *uuid)
+{
+    uint32_t hash;
+
+    /* 16-bit UUIDs only differ from each other in two bytes, so all of the
+     * UUID is hashed.
+     */
+    hash = ble_att_svr_fnv(BLE_ATT_SVR_FNV_OFFSET, uuid, 16);
+    return hash & (BLE_ATT_SVR_UUID_BUCKETS - 1);
+}
+
 /**
  * Allocate the next handle id and return it.
  *
@@ -80,6 +142,7 @@ ble_att_svr_register(const uint8_t *uuid, uint8_t flags, uint16_t *handle_id,
                      ble_att_svr_access_fn *cb, void *cb_arg)
 {
     struct ble_att_svr_entry *entry;
+    int bucket;
 
     entry = ble_att_svr_entry_alloc();
     if (entry == NULL) {
@@ -94,6 +157,21 @@ ble_att_svr_register(const uint8_t *uuid, uint8_t flags, uint16_t *handle_id,
 
     list_add_tail(&entry->ha_node, &ble_att_svr_list.svr_hdr);
 
+#if !BLE_ATT_SVR_STATIC_ATTRS
+    /* The entry pool holds max_attrs entries, so the handle fits in the
+     * table.
+     */
+    ble_att_svr_entry_tbl[entry->ha_handle_id - 1] = entry;
+#endif
+
+    bucket = ble_att_svr_uuid_bucket(entry->ha_uuid);
+    if (ble_att_svr_uuid_tail[bucket] == NULL) {
+        ble_att_svr_uuid_head[bucket] = entry;
+    } else {
+        ble_att_svr_uuid_tail[bucket]->ha_uuid_next = entry;
+    }
+    ble_att_svr_uuid_tail[bucket] = entry;
+
     if (handle_id != NULL) {
         *handle_id = entry->ha_handle_id;
     }
@@ -132,28 +210,46 @@ ble_att_svr_prev_handle(void)
  * Find a host attribute by handle id.
  *
  * @param handle_id             The handle_id to search for
- * @param ha_ptr                On input: Indicates the starting point of the
- *                                  walk; null means start at the beginning of
- *                                  the list, non-null means start at the
- *                                  following entry.
- *                              On output: Indicates the last ble_att element
- *                                  processed, or NULL if the entire list has
- *                                  been processed.
  *
- * @return                      0 on success; BLE_HS_ENOENT on not found.
+ * @return                      The attribute on success; NULL on not found.
  */
 struct ble_att_svr_entry *
 ble_att_svr_find_by_handle(uint16_t handle_id)
 {
-    struct ble_att_svr_entry *entry;
+    if (handle_id == 0 || handle_id > ble_att_svr_id) {
+        return NULL;
+    }
 
-    list_for_each_entry(entry, &ble_att_svr_list.svr_hdr, ha_node) {
-        if (entry->ha_handle_id == handle_id) {
-            return entry;
-        }
+#if BLE_ATT_SVR_STATIC_ATTRS
+    return ble_att_svr_entries + handle_id - 1;
+#else
+    return ble_att_svr_entry_tbl[handle_id - 1];
+#endif
+}
+
+/**
+ * Find the starting point of a walk over the attributes whose handles are at
+ * least start_handle, for use with list_for_each_entry_continue().
+ *
+ * @param start_handle          The first handle of the walk.
+ *
+ * @return                      The attribute preceding start_handle, or the
+ *                                  list head.
+ */
+static struct ble_att_svr_entry *
+ble_att_svr_walk_start(uint16_t start_handle)
+{
+    if (start_handle <= 1) {
+        return list_entry(&ble_att_svr_list.svr_hdr,
+                          struct ble_att_svr_entry, ha_node);
     }
 
-    return NULL;
+    if (start_handle > ble_att_svr_id) {
+        return list_entry(ble_att_svr_list.svr_hdr.prev,
+                          struct ble_att_svr_entry, ha_node);
+    }
+
+    return ble_att_svr_find_by_handle(start_handle - 1);
 }
 
 /**
@@ -176,16 +272,15 @@ ble_att_svr_find_by_uuid(struct ble_att_svr_entry *prev, const uint8_t *uuid,
 {
     struct ble_att_svr_entry *entry;
 
+    /* Only the attributes in the bucket of the UUID are visited. */
     if (prev == NULL) {
-        entry = list_entry(&ble_att_svr_list.svr_hdr,
-                           struct ble_att_svr_entry, ha_node);
+        entry = ble_att_svr_uuid_head[ble_att_svr_uuid_bucket(uuid)];
     } else {
-        entry = list_entry(&prev->ha_node, struct ble_att_svr_entry, ha_node);
+        entry = prev->ha_uuid_next;
     }
 
-    list_for_each_entry_continue(entry, &ble_att_svr_list.svr_hdr, ha_node) {
-
-        if (entry->ha_handle_id <= end_handle) {
+    for (; entry != NULL; entry = entry->ha_uuid_next) {
+        if (entry->ha_handle_id > end_handle) {
             break;
         }
 
@@ -732,7 +827,8 @@ ble_att_svr_fill_info(struct ble_att_find_info_req *req, struct os_mbuf *om,
     num_entries = 0;
     rc = BLE_HS_ENONE;
 
-    list_for_each_entry(ha, &ble_att_svr_list.svr_hdr, ha_node) {
+    ha = ble_att_svr_walk_start(req->bafq_start_handle);
+    list_for_each_entry_continue(ha, &ble_att_svr_list.svr_hdr, ha_node) {
         if (ha->ha_handle_id > req->bafq_end_handle) {
             rc = BLE_HS_ENONE;
             goto done;
@@ -1060,7 +1156,8 @@ ble_att_svr_fill_type_value(uint16_t conn_handle,
      * matching group.  For each attribute entry, determine if data needs to be
      * written to the response.
      */
-    list_for_each_entry(ha, &ble_att_svr_list.svr_hdr, ha_node) {
+    ha = ble_att_svr_walk_start(req->bavq_start_handle);
+    list_for_each_entry_continue(ha, &ble_att_svr_list.svr_hdr, ha_node) {
         match = FALSE;
 
         if (ha->ha_handle_id > req->bavq_end_handle) {
@@ -1234,13 +1331,12 @@ ble_att_svr_build_read_type_rsp(uint16_t conn_handle,
     struct ble_att_read_type_rsp rsp;
     struct ble_att_svr_entry *entry;
     struct os_mbuf *txom;
-    uint16_t attr_len;
     uint16_t mtu;
-    uint8_t buf[19];
     uint8_t *dptr;
     int entry_written;
-    int txomlen;
     int prev_attr_len;
+    int attr_len;
+    int rec_off;
     int rc;
 
     *att_err = BLE_ATT_ERR_NONE;    /* Silence unnecessary warning. */
@@ -1280,38 +1376,40 @@ ble_att_svr_build_read_type_rsp(uint16_t conn_handle,
         }
 
         if (entry->ha_handle_id >= req->batq_start_handle) {
-            rc = ble_att_svr_read_flat(conn_handle, entry, 0, sizeof buf, buf,
-                                       &attr_len, att_err);
+            /* Read the value straight into the response, after the handle.
+             * The record is trimmed off again if it does not fit.
+             */
+            rec_off = OS_MBUF_PKTLEN(txom);
+            dptr = os_mbuf_extend(txom, 2);
+            if (dptr == NULL) {
+                *att_err = BLE_ATT_ERR_INSUFFICIENT_RES;
+                *err_handle = entry->ha_handle_id;
+                rc = BLE_HS_ENOMEM;
+                goto done;
+            }
+            htole16(dptr, entry->ha_handle_id);
+
+            rc = ble_att_svr_read(conn_handle, entry, 0, txom, att_err);
             if (rc != BLE_HS_ENONE) {
+                os_mbuf_adj(txom, rec_off - OS_MBUF_PKTLEN(txom));
                 *err_handle = entry->ha_handle_id;
                 goto done;
             }
 
+            attr_len = OS_MBUF_PKTLEN(txom) - rec_off - 2;
             if (attr_len > mtu - 4) {
+                os_mbuf_adj(txom, mtu - 4 - attr_len);
                 attr_len = mtu - 4;
             }
 
-            if (prev_attr_len == 0) {
-                prev_attr_len = attr_len;
-            } else if (prev_attr_len != attr_len) {
-                break;
-            }
+            if ((prev_attr_len != 0 && prev_attr_len != attr_len) ||
+                OS_MBUF_PKTLEN(txom) > mtu) {
 
-            txomlen = OS_MBUF_PKTHDR(txom)->omp_len + 2 + attr_len;
-            if (txomlen > mtu) {
+                os_mbuf_adj(txom, rec_off - OS_MBUF_PKTLEN(txom));
                 break;
             }
 
-            dptr = os_mbuf_extend(txom, 2 + attr_len);
-            if (dptr == NULL) {
-                *att_err = BLE_ATT_ERR_INSUFFICIENT_RES;
-                *err_handle = entry->ha_handle_id;
-                rc = BLE_HS_ENOMEM;
-                goto done;
-            }
-
-            htole16(dptr + 0, entry->ha_handle_id);
-            memcpy(dptr + 2, buf, attr_len);
+            prev_attr_len = attr_len;
             entry_written = 1;
         }
     }
@@ -1780,7 +1878,8 @@ ble_att_svr_build_read_group_type_rsp(uint16_t conn_handle,
 
     start_group_handle = 0;
     rsp.bagp_length = 0;
-    list_for_each_entry(entry, &ble_att_svr_list.svr_hdr, ha_node) {
+    entry = ble_att_svr_walk_start(req->bagq_start_handle);
+    list_for_each_entry_continue(entry, &ble_att_svr_list.svr_hdr, ha_node) {
         if (entry->ha_handle_id < req->bagq_start_handle) {
             continue;
         }
@@ -2670,13 +2769,104 @@ done:
     return rc;
 }
 
+/**
+ * Computes a hash of the attribute database, for detecting that it has
+ * changed.  The same attributes and fields as the Database Hash of the
+ * Bluetooth Core Specification (v5.1, Vol 3, Part G, 7.3) are covered:
+ * handle, type and value of the service, include, characteristic and
+ * extended properties declarations; handle and type of the other
+ * characteristic descriptors defined by GATT.  Other attributes are left out.
+ * As in the specification, the hash is meant to be computed once the
+ * database has been registered.
+ *
+ * @param out_hash              On success, the hash is written here.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int
+ble_att_svr_db_hash(uint32_t *out_hash)
+{
+    struct ble_att_svr_entry *entry;
+    struct os_mbuf *om;
+    uint16_t uuid16;
+    uint32_t hash;
+    uint8_t buf[16];
+    uint8_t hdr[4];
+    int with_value;
+    int off;
+    int len;
+    int rc;
+
+    hash = BLE_ATT_SVR_FNV_OFFSET;
+
+    list_for_each_entry(entry, &ble_att_svr_list.svr_hdr, ha_node) {
+        uuid16 = ble_uuid_128_to_16(entry->ha_uuid);
+        switch (uuid16) {
+        case BLE_ATT_UUID_PRIMARY_SERVICE:
+        case BLE_ATT_UUID_SECONDARY_SERVICE:
+        case BLE_ATT_UUID_INCLUDE:
+        case BLE_ATT_UUID_CHARACTERISTIC:
+        case 0x2900: /* Characteristic Extended Properties. */
+            with_value = 1;
+            break;
+
+        case 0x2901: /* Characteristic User Description. */
+        case 0x2902: /* Client Characteristic Configuration. */
+        case 0x2903: /* Server Characteristic Configuration. */
+        case 0x2904: /* Characteristic Presentation Format. */
+        case 0x2905: /* Characteristic Aggregate Format. */
+            with_value = 0;
+            break;
+
+        default:
+            continue;
+        }
+
+        htole16(hdr + 0, entry->ha_handle_id);
+        htole16(hdr + 2, uuid16);
+        hash = ble_att_svr_fnv(hash, hdr, sizeof hdr);
+
+        if (!with_value) {
+            continue;
+        }
+
+        om = ble_hs_mbuf_bare_pkt();
+        if (om == NULL) {
+            return BLE_HS_ENOMEM;
+        }
+
+        rc = ble_att_svr_read(BLE_HS_CONN_HANDLE_NONE, entry, 0, om, NULL);
+        if (rc != 0) {
+            os_mbuf_free_chain(om);
+            return rc;
+        }
+
+        for (off = 0; off < OS_MBUF_PKTLEN(om); off += len) {
+            len = min(OS_MBUF_PKTLEN(om) - off, (int)sizeof buf);
+            os_mbuf_copydata(om, off, len, buf);
+            hash = ble_att_svr_fnv(hash, buf, len);
+        }
+        os_mbuf_free_chain(om);
+    }
+
+    *out_hash = hash;
+    return 0;
+}
+
 static void
 ble_att_svr_free_mem(void)
 {
+#if !BLE_ATT_SVR_STATIC_ATTRS
     if (ble_att_svr_entry_mem) {
         os_free(ble_att_svr_entry_mem);
         ble_att_svr_entry_mem = NULL;
     }
+
+    if (ble_att_svr_entry_tbl) {
+        os_free(ble_att_svr_entry_tbl);
+        ble_att_svr_entry_tbl = NULL;
+    }
+#endif
 }
 
 int
@@ -2686,6 +2876,7 @@ ble_att_svr_init(void)
 
     ble_att_svr_free_mem();
 
+#if !BLE_ATT_SVR_STATIC_ATTRS
     if (g_ble_hs_cfg.max_attrs > 0) {
         ble_att_svr_entry_mem = os_malloc(
             OS_MEMPOOL_BYTES(g_ble_hs_cfg.max_attrs,
@@ -2702,7 +2893,15 @@ ble_att_svr_init(void)
             rc = BLE_HS_EOS;
             goto err;
         }
+
+        ble_att_svr_entry_tbl = os_malloc(
+            g_ble_hs_cfg.max_attrs * sizeof *ble_att_svr_entry_tbl);
+        if (ble_att_svr_entry_tbl == NULL) {
+            rc = BLE_HS_ENOMEM;
+            goto err;
+        }
     }
+#endif
 
     if (g_ble_hs_cfg.max_prep_entries > 0) {
         ble_att_svr_prep_entry_mem = os_malloc(
@@ -2725,6 +2924,8 @@ ble_att_svr_init(void)
     }
 
     INIT_LIST_HEAD(&ble_att_svr_list.svr_hdr);
+    memset(ble_att_svr_uuid_head, 0, sizeof ble_att_svr_uuid_head);
+    memset(ble_att_svr_uuid_tail, 0, sizeof ble_att_svr_uuid_tail);
 
     ble_att_svr_id = 0;
 
@@ -95,6 +95,14 @@ struct ble_gatts_conn {
     uint16_t indicate_val_handle;
 };
 
+/**
+ * The number of lists over which the active GATT client procedures are spread,
+ * by connection handle.  Must be a power of two.
+ */
+#ifndef BLE_GATTC_PROC_BUCKETS
+#define BLE_GATTC_PROC_BUCKETS      8
+#endif
+
 /*** @client. */
 int ble_gattc_locked_by_cur_task(void);
 void ble_gatts_indicate_fail_notconn(uint16_t conn_handle);
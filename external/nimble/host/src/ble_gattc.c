@@ -36,13 +36,13 @@
  * Notes on thread-safety:
  * 1. The ble_hs mutex must never be locked when an application callback is
  *    executed.  A callback is free to initiate additional host procedures.
- * 2. The only resource protected by the mutex is the list of active procedures
- *    (ble_gattc_procs).  Thread-safety is achieved by locking the mutex during
- *    removal and insertion operations.  Procedure objects are only modified
- *    while they are not in the list.  This is sufficient, as the host parent
- *    task is the only task which inspects or modifies individual procedure
- *    entries.  Tasks have the following permissions regarding procedure
- *    entries:
+ * 2. The only resources protected by the mutex are the lists of active
+ *    procedures (ble_gattc_procs and ble_gattc_proc_exp).  Thread-safety is
+ *    achieved by locking the mutex during removal and insertion operations.
+ *    Procedure objects are only modified while they are not in the lists.
+ *    This is sufficient, as the host parent task is the only task which
+ *    inspects or modifies individual procedure entries.  Tasks have the
+ *    following permissions regarding procedure entries:
  *
  *                | insert  | remove    | inspect   | modify
  *    ------------+---------+-----------|-----------|---------
@@ -86,7 +86,10 @@
 
 /** Represents an in-progress GATT procedure. */
 struct ble_gattc_proc {
-    STAILQ_ENTRY(ble_gattc_proc) next;
+    /** In the bucket of its connection handle, or in a temporary list. */
+    struct list_head node;
+    /** In the list of active procedures, by expiration time. */
+    struct list_head exp_node;
 
     uint32_t exp_os_ticks;
     uint16_t conn_handle;
@@ -318,10 +321,21 @@ static const struct ble_gattc_rx_exec_entry {
     { BLE_GATT_OP_WRITE_RELIABLE,   ble_gattc_write_reliable_rx_exec },
 };
 
-/* Maintains the list of active GATT client procedures. */
+#if (BLE_GATTC_PROC_BUCKETS & (BLE_GATTC_PROC_BUCKETS - 1))
+#error "BLE_GATTC_PROC_BUCKETS must be a power of two"
+#endif
+
+/*
+ * Maintains the lists of active GATT client procedures.  Each procedure is in
+ * the bucket of its connection handle, so that an incoming response is only
+ * matched against the procedures of a few connections.  All procedures are
+ * also in ble_gattc_proc_exp, ordered by expiration time, so that the timer
+ * sweep only looks at the procedures that have expired.
+ */
 static void *ble_gattc_proc_mem = NULL;
 static struct os_mempool ble_gattc_proc_pool;
-static struct ble_gattc_proc_list ble_gattc_procs;
+static struct ble_gattc_proc_list ble_gattc_procs[BLE_GATTC_PROC_BUCKETS];
+static struct list_head ble_gattc_proc_exp;
 
 /* Statistics. */
 struct stats_ble_gattc_stats STATS_VARIABLE(ble_gattc_stats);
@@ -375,7 +389,7 @@ ble_gattc_dbg_assert_proc_not_inserted(struct ble_gattc_proc *proc)
 
     ble_hs_lock();
 
-    STAILQ_FOREACH(cur, &ble_gattc_procs, next) {
+    list_for_each_entry(cur, &ble_gattc_proc_exp, exp_node) {
         BLE_HS_DBG_ASSERT(cur != proc);
     }
 
@@ -576,6 +590,34 @@ ble_gattc_rx_entry_find(uint8_t op, const void *rx_entries, int num_entries)
     return NULL;
 }
 
+/**
+ * Computes the set of op codes handled by an array of rx entries.
+ *
+ * @return                      A mask with bit (1 << op) set for each op;
+ *                                  tested in constant time for each
+ *                                  candidate procedure.
+ */
+static uint32_t
+ble_gattc_rx_entry_ops(const void *rx_entries, int num_entries)
+{
+    struct gen_entry {
+        uint8_t op;
+        void (*cb)(void);
+    };
+
+    const struct gen_entry *entries;
+    uint32_t ops;
+    int i;
+
+    entries = rx_entries;
+    ops = 0;
+    for (i = 0; i < num_entries; i++) {
+        ops |= 1UL << entries[i].op;
+    }
+
+    return ops;
+}
+
 /*****************************************************************************
  * $proc                                                                    *
  *****************************************************************************/
@@ -630,13 +672,50 @@ ble_gattc_proc_free(struct ble_gattc_proc *proc)
     }
 }
 
+/**
+ * Retrieves the list holding the procedures of the specified connection.
+ */
+static struct ble_gattc_proc_list *
+ble_gattc_proc_bucket(uint16_t conn_handle)
+{
+    return ble_gattc_procs + (conn_handle & (BLE_GATTC_PROC_BUCKETS - 1));
+}
+
+/**
+ * Removes a procedure from the lists of active procedures.  The mutex must be
+ * locked.
+ */
+static void
+ble_gattc_proc_remove(struct ble_gattc_proc *proc)
+{
+    list_del(&proc->node);
+    list_del(&proc->exp_node);
+}
+
 static void
 ble_gattc_proc_insert(struct ble_gattc_proc *proc)
 {
+    struct ble_gattc_proc_list *bucket;
+    struct ble_gattc_proc *cur;
+
     ble_gattc_dbg_assert_proc_not_inserted(proc);
 
+    bucket = ble_gattc_proc_bucket(proc->conn_handle);
+
     ble_hs_lock();
-    STAILQ_INSERT_TAIL(&ble_gattc_procs, proc, next);
+
+    list_add_tail(&proc->node, &bucket->proc_hdr);
+
+    /* All procedures get the same timeout, so the new one almost always
+     * expires last; look for its place from the end of the list.
+     */
+    list_for_each_entry_reverse(cur, &ble_gattc_proc_exp, exp_node) {
+        if ((int32_t)(proc->exp_os_ticks - cur->exp_os_ticks) >= 0) {
+            break;
+        }
+    }
+    list_add(&proc->exp_node, &cur->exp_node);
+
     ble_hs_unlock();
 }
 
@@ -699,30 +778,26 @@ ble_gattc_proc_matches(struct ble_gattc_proc *proc, uint16_t conn_handle,
 static struct ble_gattc_proc *
 ble_gattc_extract(uint16_t conn_handle, uint8_t op)
 {
+    struct ble_gattc_proc_list *bucket;
     struct ble_gattc_proc *proc;
-    struct ble_gattc_proc *prev;
 
     /* Only the parent task is allowed to remove entries from the list. */
     BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
+    bucket = ble_gattc_proc_bucket(conn_handle);
+
     ble_hs_lock();
 
-    prev = NULL;
-    STAILQ_FOREACH(proc, &ble_gattc_procs, next) {
+    list_for_each_entry(proc, &bucket->proc_hdr, node) {
         if (ble_gattc_proc_matches(proc, conn_handle, op)) {
-            if (prev == NULL) {
-                STAILQ_REMOVE_HEAD(&ble_gattc_procs, next);
-            } else {
-                STAILQ_REMOVE_AFTER(&ble_gattc_procs, prev, next);
-            }
+            ble_gattc_proc_remove(proc);
             break;
         }
-        prev = proc;
     }
 
     ble_hs_unlock();
 
-    return proc;
+    return (&proc->node == &bucket->proc_hdr) ? NULL : proc;
 }
 
 static int
@@ -746,45 +821,51 @@ static void
 ble_gattc_extract_by_conn_op(uint16_t conn_handle, uint8_t op,
                              struct ble_gattc_proc_list *dst_list)
 {
+    struct ble_gattc_proc_list *bucket;
     struct ble_gattc_proc *proc;
-    struct ble_gattc_proc *prev;
-    struct ble_gattc_proc *next;
+    struct ble_gattc_proc *tmp;
 
     /* Only the parent task is allowed to remove entries from the list. */
     BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
-    STAILQ_INIT(dst_list);
+    INIT_LIST_HEAD(&dst_list->proc_hdr);
 
     ble_hs_lock();
 
-    prev = NULL;
-    proc = STAILQ_FIRST(&ble_gattc_procs);
-    while (proc != NULL) {
-        next = STAILQ_NEXT(proc, next);
-
-        if (ble_gattc_conn_op_matches(proc, conn_handle, op)) {
-            if (prev == NULL) {
-                STAILQ_REMOVE_HEAD(&ble_gattc_procs, next);
-            } else {
-                STAILQ_REMOVE_AFTER(&ble_gattc_procs, prev, next);
+    if (conn_handle == BLE_HS_CONN_HANDLE_NONE) {
+        /* The expiration list holds the procedures of all connections. */
+        list_for_each_entry_safe(proc, tmp, &ble_gattc_proc_exp, exp_node) {
+            if (ble_gattc_conn_op_matches(proc, conn_handle, op)) {
+                list_del(&proc->exp_node);
+                list_move_tail(&proc->node, &dst_list->proc_hdr);
+            }
+        }
+    } else {
+        bucket = ble_gattc_proc_bucket(conn_handle);
+        list_for_each_entry_safe(proc, tmp, &bucket->proc_hdr, node) {
+            if (ble_gattc_conn_op_matches(proc, conn_handle, op)) {
+                list_del(&proc->exp_node);
+                list_move_tail(&proc->node, &dst_list->proc_hdr);
             }
-            STAILQ_INSERT_TAIL(dst_list, proc, next);
-        } else {
-            prev = proc;
         }
-
-        proc = next;
     }
 
     ble_hs_unlock();
 }
 
-static void
+/**
+ * Removes the expired procedures from the lists of active procedures.
+ *
+ * @param dst_list              The list to move the expired procedures to.
+ *
+ * @return                      The number of ticks until the next procedure
+ *                                  expires; BLE_HS_FOREVER if there are no
+ *                                  more active procedures.
+ */
+static int32_t
 ble_gattc_extract_expired(struct ble_gattc_proc_list *dst_list)
 {
     struct ble_gattc_proc *proc;
-    struct ble_gattc_proc *prev;
-    struct ble_gattc_proc *next;
     uint32_t now;
     int32_t time_diff;
 
@@ -792,30 +873,26 @@ ble_gattc_extract_expired(struct ble_gattc_proc_list *dst_list)
     BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
     now = os_time_get();
-    STAILQ_INIT(dst_list);
+    INIT_LIST_HEAD(&dst_list->proc_hdr);
 
     ble_hs_lock();
 
-    prev = NULL;
-    proc = STAILQ_FIRST(&ble_gattc_procs);
-    while (proc != NULL) {
-        next = STAILQ_NEXT(proc, next);
-
+    time_diff = 0;
+    while (!list_empty(&ble_gattc_proc_exp)) {
+        proc = list_first_entry(&ble_gattc_proc_exp, struct ble_gattc_proc,
+                                exp_node);
         time_diff = now - proc->exp_os_ticks;
-        if (time_diff >= 0) {
-            if (prev == NULL) {
-                STAILQ_REMOVE_HEAD(&ble_gattc_procs, next);
-            } else {
-                STAILQ_REMOVE_AFTER(&ble_gattc_procs, prev, next);
-            }
-            STAILQ_INSERT_TAIL(dst_list, proc, next);
+        if (time_diff < 0) {
+            break;
         }
 
-        prev = proc;
-        proc = next;
+        list_del(&proc->exp_node);
+        list_move_tail(&proc->node, &dst_list->proc_hdr);
     }
 
     ble_hs_unlock();
+
+    return (time_diff < 0) ? -time_diff : BLE_HS_FOREVER;
 }
 
 static struct ble_gattc_proc *
@@ -823,38 +900,30 @@ ble_gattc_extract_with_rx_entry(uint16_t conn_handle,
                                 const void *rx_entries, int num_entries,
                                 const void **out_rx_entry)
 {
+    struct ble_gattc_proc_list *bucket;
     struct ble_gattc_proc *proc;
-    struct ble_gattc_proc *prev;
-    const void *rx_entry;
+    uint32_t ops;
 
     /* Only the parent task is allowed to remove entries from the list. */
     BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
+    bucket = ble_gattc_proc_bucket(conn_handle);
+    ops = ble_gattc_rx_entry_ops(rx_entries, num_entries);
+
     ble_hs_lock();
 
-    prev = NULL;
-    STAILQ_FOREACH(proc, &ble_gattc_procs, next) {
-        if (proc->conn_handle == conn_handle) {
-            rx_entry = ble_gattc_rx_entry_find(proc->op, rx_entries,
-                                               num_entries);
-            if (rx_entry != NULL) {
-                if (prev == NULL) {
-                    STAILQ_REMOVE_HEAD(&ble_gattc_procs, next);
-                } else {
-                    STAILQ_REMOVE_AFTER(&ble_gattc_procs, prev, next);
-                }
-
-                *out_rx_entry = rx_entry;
-                break;
-            }
+    list_for_each_entry(proc, &bucket->proc_hdr, node) {
+        if (proc->conn_handle == conn_handle && (ops & (1UL << proc->op))) {
+            ble_gattc_proc_remove(proc);
+            *out_rx_entry = ble_gattc_rx_entry_find(proc->op, rx_entries,
+                                                    num_entries);
+            break;
         }
-
-        prev = proc;
     }
 
     ble_hs_unlock();
 
-    return proc;
+    return (&proc->node == &bucket->proc_hdr) ? NULL : proc;
 }
 
 /**
@@ -897,11 +966,13 @@ ble_gattc_fail_procs(uint16_t conn_handle, uint8_t op, int status)
     /* Notify application of failed procedures and free the corresponding proc
      * entries.
      */
-    while ((proc = STAILQ_FIRST(&temp_list)) != NULL) {
+    while (!list_empty(&temp_list.proc_hdr)) {
+        proc = list_first_entry(&temp_list.proc_hdr, struct ble_gattc_proc,
+                                node);
         err_cb = ble_gattc_err_dispatch_get(proc->op);
         err_cb(proc, status, 0);
 
-        STAILQ_REMOVE_HEAD(&temp_list, next);
+        list_del(&proc->node);
         ble_gattc_proc_free(proc);
     }
 }
@@ -915,31 +986,34 @@ ble_gattc_fail_procs(uint16_t conn_handle, uint8_t op, int status)
  * Called by the heartbeat timer; executed at least once a second.
  *
  * @return                      The number of ticks until this function should
- *                                  be called again; currently always
- *                                  UINT32_MAX.
+ *                                  be called again: when the next procedure
+ *                                  expires, or BLE_HS_FOREVER if there are no
+ *                                  active procedures.
  */
 int32_t
 ble_gattc_heartbeat(void)
 {
     struct ble_gattc_proc_list exp_list;
     struct ble_gattc_proc *proc;
+    struct ble_gattc_proc *tmp;
+    int32_t ticks_until_exp;
 
     /* Remove timed-out procedures from the main list and insert them into a
      * temporary list.  For any stalled procedures, set their pending bit so
      * they can be retried.
      */
-    ble_gattc_extract_expired(&exp_list);
+    ticks_until_exp = ble_gattc_extract_expired(&exp_list);
 
     /* Terminate the connection associated with each timed-out procedure. */
-    while ((proc = STAILQ_FIRST(&exp_list)) != NULL) {
+    list_for_each_entry_safe(proc, tmp, &exp_list.proc_hdr, node) {
         STATS_INC(ble_gattc_stats, proc_timeout);
         ble_gap_terminate(proc->conn_handle, BLE_ERR_REM_USER_CONN_TERM);
 
-        STAILQ_REMOVE_HEAD(&exp_list, next);
+        list_del(&proc->node);
         ble_gattc_proc_free(proc);
     }
 
-    return BLE_HS_FOREVER;
+    return ticks_until_exp;
 }
 
 /**
@@ -4558,20 +4632,24 @@ ble_gattc_connection_broken(uint16_t conn_handle)
 int
 ble_gattc_any_jobs(void)
 {
-    return !STAILQ_EMPTY(&ble_gattc_procs);
+    return !list_empty(&ble_gattc_proc_exp);
 }
 
 int
 ble_gattc_init(void)
 {
     int rc;
+    int i;
 
     if (ble_gattc_proc_mem) {
         os_free(ble_gattc_proc_mem);
         ble_gattc_proc_mem = NULL;
     }
 
-    INIT_LIST_HEAD(&ble_gattc_procs.proc_hdr);
+    for (i = 0; i < BLE_GATTC_PROC_BUCKETS; i++) {
+        INIT_LIST_HEAD(&ble_gattc_procs[i].proc_hdr);
+    }
+    INIT_LIST_HEAD(&ble_gattc_proc_exp);
 
     if (g_ble_hs_cfg.max_gattc_procs > 0) {
         ble_gattc_proc_mem = os_malloc(
@@ -53,6 +53,9 @@ struct ble_gatts_clt_cfg {
 static struct ble_gatts_clt_cfg *ble_gatts_clt_cfgs;
 static int ble_gatts_num_cfgable_chrs;
 
+/** Hash of the attribute database, computed when the server is started. */
+static uint32_t ble_gatts_db_hash_val;
+
 struct stats_ble_gatts_stats STATS_VARIABLE(ble_gatts_stats);
 struct stats_name_map STATS_NAME_MAP_NAME(ble_gatts_stats)[] = {
     STATS_NAME(ble_gatts_stats, svcs)
@@ -1121,6 +1124,12 @@ ble_gatts_start(void)
     int idx;
     int rc;
 
+    /* The database does not change once the server is started. */
+    rc = ble_att_svr_db_hash(&ble_gatts_db_hash_val);
+    if (rc != 0) {
+        return rc;
+    }
+
     if (ble_gatts_num_cfgable_chrs == 0) {
         return 0;
     }
@@ -1163,6 +1172,20 @@ ble_gatts_start(void)
     return 0;
 }
 
+/**
+ * Retrieves the hash of the attribute database.  Two databases with the same
+ * services, characteristics and descriptors, registered in the same order,
+ * have the same hash, so a client can compare it to the hash of the database
+ * it discovered to know whether it must discover it again.
+ *
+ * @return                      The hash computed when the host was started.
+ */
+uint32_t
+ble_gatts_db_hash(void)
+{
+    return ble_gatts_db_hash_val;
+}
+
 int
 ble_gatts_conn_can_alloc(void)
 {
@@ -2048,6 +2071,7 @@ ble_gatts_init(void)
     ble_gatts_free_mem();
     ble_gatts_num_cfgable_chrs = 0;
     ble_gatts_clt_cfgs = NULL;
+    ble_gatts_db_hash_val = 0;
 
     if (g_ble_hs_cfg.max_client_configs > 0) {
         ble_gatts_clt_cfg_mem = malloc(
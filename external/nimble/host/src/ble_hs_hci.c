@@ -407,19 +407,12 @@ ble_hs_hci_acl_hdr_prepend(struct os_mbuf *om, uint16_t handle,
                            uint8_t pb_flag)
 {
     struct hci_data_hdr hci_hdr;
-    struct os_mbuf *om2;
 
     hci_hdr.hdh_handle_pb_bc =
         ble_hs_hci_util_handle_pb_bc_join(handle, pb_flag, 0);
     htole16(&hci_hdr.hdh_len, OS_MBUF_PKTHDR(om)->omp_len);
 
-    om2 = os_mbuf_prepend(om, sizeof hci_hdr);
-    if (om2 == NULL) {
-        return NULL;
-    }
-
-    om = om2;
-    om = os_mbuf_pullup(om, sizeof hci_hdr);
+    om = ble_hs_mbuf_prepend_hdr(om, sizeof hci_hdr);
     if (om == NULL) {
         return NULL;
     }
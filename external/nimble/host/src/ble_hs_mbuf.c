@@ -105,6 +105,44 @@ ble_hs_mbuf_att_pkt(void)
                                 BLE_ATT_PREP_WRITE_CMD_BASE_SZ);
 }
 
+/**
+ * Prepends a header of the specified length to an outgoing packet.  The
+ * header is contiguous and the packet data is never moved: if the first mbuf
+ * of the chain does not have enough leading space, a new mbuf is placed in
+ * front of the chain.  The new mbuf also has room for the L2CAP and ACL data
+ * headers, so the layers below can prepend theirs without allocating.
+ *
+ * The supplied mbuf chain is freed on failure.
+ *
+ * @param om                    The packet to prepend to.
+ * @param len                   The length of the header.
+ *
+ * @return                      The new head of the packet on success;
+ *                              NULL on memory exhaustion.
+ */
+struct os_mbuf *
+ble_hs_mbuf_prepend_hdr(struct os_mbuf *om, uint16_t len)
+{
+    struct os_mbuf *hdr;
+
+    if (OS_MBUF_LEADINGSPACE(om) < len) {
+        /* Don't split the header between the existing head and a new one;
+         * making it contiguous would then take a third buffer and a copy.
+         */
+        hdr = ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_L2CAP_HDR_SZ +
+                                  len);
+        if (hdr == NULL) {
+            os_mbuf_free_chain(om);
+            return NULL;
+        }
+
+        os_mbuf_concat(hdr, om);
+        om = hdr;
+    }
+
+    return os_mbuf_prepend(om, len);
+}
+
 /**
  * Allocates a an mbuf and fills it with the contents of the specified flat
  * buffer.
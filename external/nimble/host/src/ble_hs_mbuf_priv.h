@@ -1,11 +1,14 @@
 #ifndef H_BLE_HS_MBUF_PRIV_
 #define H_BLE_HS_MBUF_PRIV_
 
+#include <inttypes.h>
+
 struct os_mbuf;
 
 struct os_mbuf *ble_hs_mbuf_bare_pkt(void);
 struct os_mbuf *ble_hs_mbuf_acm_pkt(void);
 struct os_mbuf *ble_hs_mbuf_l2cap_pkt(void);
+struct os_mbuf *ble_hs_mbuf_prepend_hdr(struct os_mbuf *om, uint16_t len);
 int ble_hs_mbuf_pullup_base(struct os_mbuf **om, int base_len);
 
 #endif
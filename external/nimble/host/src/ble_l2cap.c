@@ -123,7 +123,7 @@ ble_l2cap_prepend_hdr(struct os_mbuf *om, uint16_t cid, uint16_t len)
     htole16(&hdr.blh_len, len);
     htole16(&hdr.blh_cid, cid);
 
-    om = os_mbuf_prepend_pullup(om, sizeof hdr);
+    om = ble_hs_mbuf_prepend_hdr(om, sizeof hdr);
     if (om != NULL) {
         memcpy(om->om_data, &hdr, sizeof hdr);
     }
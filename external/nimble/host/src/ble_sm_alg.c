@@ -20,19 +20,35 @@
 
 #include <inttypes.h>
 #include <string.h>
+#include "nimble/ble.h"
+#include "nimble/nimble_opt.h"
+#if !NIMBLE_OPT(SM_ALG_ECB)
 #include "mbedtls/aes.h"
 #include "tinycrypt/aes.h"
-#include "tinycrypt/constants.h"
 #include "tinycrypt/utils.h"
 #include "tinycrypt/cmac_mode.h"
+#endif
+#if !NIMBLE_OPT(SM_ALG_ECB) || !NIMBLE_OPT(SM_ALG_ECC)
+#include "tinycrypt/constants.h"
+#endif
+#if !NIMBLE_OPT(SM_ALG_ECC)
 #include "tinycrypt/ecc_dh.h"
-#include "nimble/ble.h"
-#include "nimble/nimble_opt.h"
+#endif
+#if NIMBLE_OPT(SM_ALG_ECB) && defined(SOFTDEVICE_PRESENT)
+#include "nrf_soc.h"
+#elif NIMBLE_OPT(SM_ALG_ECB)
+#include "controller/ble_hw.h"
+#endif
+#if NIMBLE_OPT(SM_ALG_ECC)
+#include "ecc.h"
+#endif
 #include "ble_hs_priv.h"
 
 #if NIMBLE_OPT(SM)
 
+#if !NIMBLE_OPT(SM_ALG_ECB)
 static mbedtls_aes_context ble_sm_alg_ctxt;
+#endif
 
 /* based on Core Specification 4.2 Vol 3. Part H 2.3.5.6.1 */
 static const uint32_t ble_sm_alg_dbg_priv_key[8] = {
@@ -58,33 +74,113 @@ ble_sm_alg_xor_128(uint8_t *p, uint8_t *q, uint8_t *r)
     }
 }
 
+/**
+ * AES-128 encryption of a single block.  All buffers are big-endian, and
+ * the output may overlap the input.
+ */
 static int
-ble_sm_alg_encrypt(uint8_t *key, uint8_t *plaintext, uint8_t *enc_data)
+ble_sm_alg_aes_block(const uint8_t *key, const uint8_t *in, uint8_t *out)
 {
-    mbedtls_aes_init(&ble_sm_alg_ctxt);
-    uint8_t tmp[16];
+#if NIMBLE_OPT(SM_ALG_ECB)
+#ifdef SOFTDEVICE_PRESENT
+    nrf_ecb_hal_data_t ecb;
+
+    memcpy(ecb.key, key, 16);
+    memcpy(ecb.cleartext, in, 16);
+
+    if (sd_ecb_block_encrypt(&ecb) != NRF_SUCCESS) {
+        return BLE_HS_EUNKNOWN;
+    }
+
+    memcpy(out, ecb.ciphertext, 16);
+#else
+    struct ble_encryption_block ecb;
+    os_sr_t sr;
     int rc;
 
-    swap_buf(tmp, key, 16);
+    memcpy(ecb.key, key, 16);
+    memcpy(ecb.plain_text, in, 16);
 
-    rc = mbedtls_aes_setkey_enc(&ble_sm_alg_ctxt, tmp, 128);
+    /* The controller also uses the ECB, from its task and from interrupts;
+     * a block takes a few tens of microseconds.
+     */
+    OS_ENTER_CRITICAL(sr);
+    rc = ble_hw_encrypt_block(&ecb);
+    OS_EXIT_CRITICAL(sr);
     if (rc != 0) {
         return BLE_HS_EUNKNOWN;
     }
 
-    swap_buf(tmp, plaintext, 16);
+    memcpy(out, ecb.cipher_text, 16);
+#endif
+#else
+    int rc;
+
+    mbedtls_aes_init(&ble_sm_alg_ctxt);
+
+    rc = mbedtls_aes_setkey_enc(&ble_sm_alg_ctxt, key, 128);
+    if (rc != 0) {
+        return BLE_HS_EUNKNOWN;
+    }
 
     rc = mbedtls_aes_crypt_ecb(&ble_sm_alg_ctxt, MBEDTLS_AES_ENCRYPT,
-                               tmp, enc_data);
+                               in, out);
     if (rc != 0) {
         return BLE_HS_EUNKNOWN;
     }
+#endif
+
+    return BLE_HS_ENONE;
+}
+
+static int
+ble_sm_alg_encrypt(uint8_t *key, uint8_t *plaintext, uint8_t *enc_data)
+{
+    uint8_t tmp_key[16];
+    uint8_t tmp[16];
+    int rc;
+
+    swap_buf(tmp_key, key, 16);
+    swap_buf(tmp, plaintext, 16);
+
+    rc = ble_sm_alg_aes_block(tmp_key, tmp, enc_data);
+    if (rc != 0) {
+        return rc;
+    }
 
     swap_in_place(enc_data, 16);
 
     return BLE_HS_ENONE;
 }
 
+#if NIMBLE_OPT(SM_ALG_ECB)
+
+/**
+ * Multiplication by x in GF(2^128), for the CMAC subkeys (RFC 4493).
+ */
+static void
+ble_sm_alg_cmac_dbl(uint8_t *out, const uint8_t *in)
+{
+    uint8_t carry;
+    uint8_t msb;
+    uint8_t next;
+    int i;
+
+    msb = in[0] & 0x80;
+    carry = 0;
+    for (i = 15; i >= 0; i--) {
+        next = in[i] >> 7;
+        out[i] = (in[i] << 1) | carry;
+        carry = next;
+    }
+
+    if (msb) {
+        out[15] ^= 0x87;
+    }
+}
+
+#endif
+
 /**
  * Cypher based Message Authentication Code (CMAC) with AES 128 bit
  *
@@ -97,6 +193,55 @@ static int
 ble_sm_alg_aes_cmac(const uint8_t *key, const uint8_t *in, size_t len,
                     uint8_t *out)
 {
+#if NIMBLE_OPT(SM_ALG_ECB)
+    uint8_t subkey[16];
+    uint8_t x[16];
+    size_t num_blocks;
+    size_t rem;
+    size_t i;
+    int rc;
+
+    /* K1 = L * x, K2 = L * x^2, where L = AES(K, 0). */
+    memset(x, 0, sizeof x);
+    rc = ble_sm_alg_aes_block(key, x, subkey);
+    if (rc != 0) {
+        return rc;
+    }
+    ble_sm_alg_cmac_dbl(subkey, subkey);
+
+    num_blocks = (len + 15) / 16;
+    if (num_blocks == 0) {
+        num_blocks = 1;
+    }
+    rem = len - (num_blocks - 1) * 16;
+    if (rem < 16) {
+        ble_sm_alg_cmac_dbl(subkey, subkey);
+    }
+
+    for (; num_blocks > 1; num_blocks--) {
+        for (i = 0; i < 16; i++) {
+            x[i] ^= *in++;
+        }
+
+        rc = ble_sm_alg_aes_block(key, x, x);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    /* The last block is padded with 10...0 if incomplete. */
+    for (i = 0; i < rem; i++) {
+        x[i] ^= in[i];
+    }
+    if (rem < 16) {
+        x[rem] ^= 0x80;
+    }
+    for (i = 0; i < 16; i++) {
+        x[i] ^= subkey[i];
+    }
+
+    return ble_sm_alg_aes_block(key, x, out);
+#else
     struct tc_aes_key_sched_struct sched;
     struct tc_cmac_struct state;
 
@@ -113,6 +258,7 @@ ble_sm_alg_aes_cmac(const uint8_t *key, const uint8_t *in, size_t len,
     }
 
     return BLE_HS_ENONE;
+#endif
 }
 
 int
@@ -418,6 +564,20 @@ int
 ble_sm_alg_gen_dhkey(uint8_t *peer_pub_key_x, uint8_t *peer_pub_key_y,
                      uint32_t *our_priv_key, void *out_dhkey)
 {
+#if NIMBLE_OPT(SM_ALG_ECC)
+    uint32_t dh[8];
+    uint32_t pk[16];
+
+    /* Both libraries use little-endian coordinates. */
+    memcpy(pk, peer_pub_key_x, 32);
+    memcpy(pk + 8, peer_pub_key_y, 32);
+
+    if (ecc_p256_shared_secret_compute((uint8_t *)our_priv_key,
+                                       (uint8_t *)pk,
+                                       (uint8_t *)dh) != NRF_SUCCESS) {
+        return BLE_HS_EUNKNOWN;
+    }
+#else
     uint32_t dh[8];
     EccPoint pk;
 
@@ -431,6 +591,7 @@ ble_sm_alg_gen_dhkey(uint8_t *peer_pub_key_x, uint8_t *peer_pub_key_y,
     if (ecdh_shared_secret(dh, &pk, our_priv_key) == TC_FAIL) {
         return BLE_HS_EUNKNOWN;
     }
+#endif
 
     memcpy(out_dhkey, dh, 32);
 
@@ -444,6 +605,20 @@ ble_sm_alg_gen_dhkey(uint8_t *peer_pub_key_x, uint8_t *peer_pub_key_y,
 int
 ble_sm_alg_gen_key_pair(void *pub, uint32_t *priv)
 {
+#if NIMBLE_OPT(SM_ALG_ECC)
+    uint32_t pk[16];
+
+    do {
+        if (ecc_p256_keypair_gen((uint8_t *)priv,
+                                 (uint8_t *)pk) != NRF_SUCCESS) {
+            return BLE_HS_EUNKNOWN;
+        }
+
+        /* Make sure generated key isn't debug key. */
+    } while (memcmp(priv, ble_sm_alg_dbg_priv_key, 32) == 0);
+
+    memcpy(pub, pk, 64);
+#else
     uint32_t random[16];
     EccPoint pkey;
     int rc;
@@ -464,6 +639,7 @@ ble_sm_alg_gen_key_pair(void *pub, uint32_t *priv)
 
     memcpy(pub + 0, pkey.x, 32);
     memcpy(pub + 32, pkey.y, 32);
+#endif
 
     return BLE_HS_ENONE;
 }
@@ -1864,6 +1864,45 @@ TEST_CASE(ble_att_svr_test_read_type)
     ble_att_svr_test_misc_read_type(128);
 }
 
+TEST_CASE(ble_att_svr_test_read_type_long)
+{
+    struct ble_att_read_type_req req;
+    uint16_t conn_handle;
+    uint16_t attr_handle;
+    uint8_t buf[BLE_ATT_READ_TYPE_REQ_SZ_128];
+    uint8_t uuid[16] = {2};
+    int rc;
+
+    conn_handle = ble_att_svr_test_misc_init(0);
+
+    /*** Value longer than the response; truncated to ATT_MTU - 4. */
+    ble_att_svr_test_attr_r_1 =
+        (uint8_t[]){0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,
+                    22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39};
+    ble_att_svr_test_attr_r_1_len = 40;
+    rc = ble_att_svr_register(uuid, HA_FLAG_PERM_RW, &attr_handle,
+                              ble_att_svr_test_misc_attr_fn_r_1, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    req.batq_start_handle = 1;
+    req.batq_end_handle = 0xffff;
+
+    ble_att_read_type_req_write(buf, sizeof buf, &req);
+    memcpy(buf + BLE_ATT_READ_TYPE_REQ_BASE_SZ, uuid, sizeof uuid);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, BLE_L2CAP_CID_ATT,
+                                                buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+    ble_att_svr_test_misc_verify_tx_read_type_rsp(
+        ((struct ble_att_svr_test_type_entry[]) { {
+            .handle = attr_handle,
+            .value = ble_att_svr_test_attr_r_1,
+            .value_len = BLE_ATT_MTU_DFLT - 4,
+        }, {
+            .handle = 0,
+        } }));
+}
+
 TEST_CASE(ble_att_svr_test_read_group_type)
 {
     struct ble_att_read_group_type_req req;
@@ -2240,6 +2279,56 @@ TEST_CASE(ble_att_svr_test_indicate)
 
 }
 
+TEST_CASE(ble_att_svr_test_lookup)
+{
+    struct ble_att_svr_entry *entry;
+    uint8_t uuid128[16];
+    uint16_t prev;
+    int count;
+    int rc;
+    int i;
+
+    ble_att_svr_test_misc_init(0);
+
+    /* Every third attribute is a characteristic declaration. */
+    for (i = 1; i <= 48; i++) {
+        ble_att_svr_test_misc_register_uuid16(
+            i % 3 == 0 ? BLE_ATT_UUID_CHARACTERISTIC : 0x4000 + i,
+            HA_FLAG_PERM_RW, i, ble_att_svr_test_misc_attr_fn_r_group);
+    }
+
+    /*** Lookup by handle. */
+    for (i = 1; i <= 48; i++) {
+        entry = ble_att_svr_find_by_handle(i);
+        TEST_ASSERT_FATAL(entry != NULL);
+        TEST_ASSERT(entry->ha_handle_id == i);
+    }
+    TEST_ASSERT(ble_att_svr_find_by_handle(0) == NULL);
+    TEST_ASSERT(ble_att_svr_find_by_handle(49) == NULL);
+
+    /*** Lookup by UUID, in handle order, up to the end handle. */
+    rc = ble_uuid_16_to_128(BLE_ATT_UUID_CHARACTERISTIC, uuid128);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    count = 0;
+    prev = 0;
+    entry = NULL;
+    while ((entry = ble_att_svr_find_by_uuid(entry, uuid128, 30)) != NULL) {
+        TEST_ASSERT(entry->ha_handle_id > prev);
+        TEST_ASSERT(entry->ha_handle_id % 3 == 0);
+        prev = entry->ha_handle_id;
+        count++;
+    }
+    TEST_ASSERT(count == 10);
+
+    rc = ble_uuid_16_to_128(0x4000 + 47, uuid128);
+    TEST_ASSERT_FATAL(rc == 0);
+    entry = ble_att_svr_find_by_uuid(NULL, uuid128, 0xffff);
+    TEST_ASSERT_FATAL(entry != NULL);
+    TEST_ASSERT(entry->ha_handle_id == 47);
+    TEST_ASSERT(ble_att_svr_find_by_uuid(entry, uuid128, 0xffff) == NULL);
+}
+
 TEST_SUITE(ble_att_svr_suite)
 {
     /* When checking for mbuf leaks, ensure no stale prep entries. */
@@ -2259,10 +2348,12 @@ TEST_SUITE(ble_att_svr_suite)
     ble_att_svr_test_find_info();
     ble_att_svr_test_find_type_value();
     ble_att_svr_test_read_type();
+    ble_att_svr_test_read_type_long();
     ble_att_svr_test_read_group_type();
     ble_att_svr_test_prep_write();
     ble_att_svr_test_notify();
     ble_att_svr_test_indicate();
+    ble_att_svr_test_lookup();
 }
 
 int
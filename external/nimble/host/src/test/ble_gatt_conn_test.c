@@ -517,11 +517,61 @@ TEST_CASE(ble_gatt_conn_test_disconnect)
     TEST_ASSERT(write_rel_arg.called == 1);
 }
 
+TEST_CASE(ble_gatt_conn_test_shared_bucket)
+{
+    struct ble_gatt_conn_test_cb_arg mtu_arg1 = { 0 };
+    struct ble_gatt_conn_test_cb_arg mtu_arg2 = { 0 };
+    uint16_t conn_handle2;
+    int32_t ticks;
+    int rc;
+
+    ble_hs_test_util_init();
+
+    /* Use two connections whose procedures are kept in the same list. */
+    conn_handle2 = 1 + BLE_GATTC_PROC_BUCKETS;
+    ble_hs_test_util_create_conn(1, ((uint8_t[]){1,2,3,4,5,6,7,8}),
+                                 NULL, NULL);
+    ble_hs_test_util_create_conn(conn_handle2,
+                                 ((uint8_t[]){2,3,4,5,6,7,8,9}),
+                                 NULL, NULL);
+
+    /* No procedures; nothing to expire. */
+    TEST_ASSERT(ble_gattc_heartbeat() == BLE_HS_FOREVER);
+
+    mtu_arg1.exp_conn_handle = 1;
+    rc = ble_gattc_exchange_mtu(1, ble_gatt_conn_test_mtu_cb, &mtu_arg1);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    mtu_arg2.exp_conn_handle = conn_handle2;
+    rc = ble_gattc_exchange_mtu(conn_handle2, ble_gatt_conn_test_mtu_cb,
+                                &mtu_arg2);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_hs_test_util_tx_all();
+
+    /* The heartbeat is due when the first procedure times out. */
+    ticks = ble_gattc_heartbeat();
+    TEST_ASSERT(ticks > 0 && ticks <= 30 * OS_TICKS_PER_SEC);
+
+    /* Only the procedure of the broken connection fails. */
+    ble_gattc_connection_broken(conn_handle2);
+    TEST_ASSERT(mtu_arg1.called == 0);
+    TEST_ASSERT(mtu_arg2.called == 1);
+    TEST_ASSERT(ble_gattc_any_jobs());
+
+    ble_gattc_connection_broken(1);
+    TEST_ASSERT(mtu_arg1.called == 1);
+    TEST_ASSERT(mtu_arg2.called == 1);
+    TEST_ASSERT(!ble_gattc_any_jobs());
+    TEST_ASSERT(ble_gattc_heartbeat() == BLE_HS_FOREVER);
+}
+
 TEST_SUITE(ble_gatt_break_suite)
 {
     tu_suite_set_post_test_cb(ble_hs_test_util_post_test, NULL);
 
     ble_gatt_conn_test_disconnect();
+    ble_gatt_conn_test_shared_bucket();
 }
 
 int
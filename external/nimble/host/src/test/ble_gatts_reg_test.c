@@ -696,6 +696,65 @@ TEST_CASE(ble_gatts_reg_test_dsc_cb)
     } });
 }
 
+static const struct ble_gatt_svc_def ble_gatts_reg_test_hash_svcs[] = { {
+    .type = BLE_GATT_SVC_TYPE_PRIMARY,
+    .uuid128 = BLE_UUID16(0x1234),
+    .characteristics = (struct ble_gatt_chr_def[]) { {
+        .uuid128 = BLE_UUID16(0x1111),
+        .access_cb = ble_gatts_reg_test_misc_dummy_access,
+        .flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
+    }, {
+        0
+    } },
+}, {
+    0
+} };
+
+static const struct ble_gatt_svc_def ble_gatts_reg_test_hash_svcs2[] = { {
+    .type = BLE_GATT_SVC_TYPE_SECONDARY,
+    .uuid128 = BLE_UUID16(0x5678),
+}, {
+    0
+} };
+
+static uint32_t
+ble_gatts_reg_test_misc_hash(int num_defs)
+{
+    uint32_t hash;
+    int rc;
+
+    ble_gatts_reg_test_init();
+
+    rc = ble_gatts_register_svcs(ble_gatts_reg_test_hash_svcs, NULL, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    if (num_defs > 1) {
+        rc = ble_gatts_register_svcs(ble_gatts_reg_test_hash_svcs2, NULL,
+                                     NULL);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+
+    rc = ble_att_svr_db_hash(&hash);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    return hash;
+}
+
+TEST_CASE(ble_gatts_reg_test_db_hash)
+{
+    uint32_t hash1;
+    uint32_t hash2;
+
+    /*** Same database; same hash. */
+    hash1 = ble_gatts_reg_test_misc_hash(1);
+    hash2 = ble_gatts_reg_test_misc_hash(1);
+    TEST_ASSERT(hash1 == hash2);
+
+    /*** Additional service; different hash. */
+    hash2 = ble_gatts_reg_test_misc_hash(2);
+    TEST_ASSERT(hash1 != hash2);
+}
+
 TEST_SUITE(ble_gatts_reg_suite)
 {
     tu_suite_set_post_test_cb(ble_hs_test_util_post_test, NULL);
@@ -707,6 +766,8 @@ TEST_SUITE(ble_gatts_reg_suite)
     ble_gatts_reg_test_svc_cb();
     ble_gatts_reg_test_chr_cb();
     ble_gatts_reg_test_dsc_cb();
+
+    ble_gatts_reg_test_db_hash();
 }
 
 int
@@ -0,0 +1,609 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * Host CPU cost of common operations, measured with the unit test utilities:
+ * the controller is replaced by the test HCI transport, so only host
+ * processing is timed.  Building the received packets and draining the
+ * transmitted ones are left out of the measurements.
+ *
+ * On Cortex-M3/M4 targets, costs are in DWT cycles.  On Cortex-M0 targets,
+ * which have no cycle counter, they are in OS ticks and only meaningful over
+ * many iterations.  Natively, they are in nanoseconds.
+ *
+ * Each benchmark has a regression threshold, BLE_HS_BENCH_MAX_<name>, which
+ * the mean cost of an operation must not exceed.  The thresholds depend on
+ * the platform, so they are 0 (not checked) unless set for the build.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include "testutil/testutil.h"
+#include "nimble/ble.h"
+#include "nimble/hci_common.h"
+#include "host/ble_hs_test.h"
+#include "host/ble_uuid.h"
+#include "ble_hs_test_util.h"
+
+#ifndef BLE_HS_BENCH_ITERS
+#define BLE_HS_BENCH_ITERS              1000
+#endif
+
+/** Iterations of the elliptic curve benchmarks, which are much slower. */
+#ifndef BLE_HS_BENCH_ECC_ITERS
+#define BLE_HS_BENCH_ECC_ITERS          10
+#endif
+
+/** Services in the database of the discovery benchmark. */
+#ifndef BLE_HS_BENCH_NUM_SVCS
+#define BLE_HS_BENCH_NUM_SVCS           16
+#endif
+
+/** Length of the ATT Write Command of the L2CAP reassembly benchmark. */
+#ifndef BLE_HS_BENCH_L2CAP_LEN
+#define BLE_HS_BENCH_L2CAP_LEN          200
+#endif
+
+/** Data in each ACL fragment, as with a 27-byte controller buffer. */
+#define BLE_HS_BENCH_ACL_LEN            27
+
+#define BLE_HS_BENCH_ATTR_LEN           20
+
+#ifndef BLE_HS_BENCH_MAX_ATT_READ
+#define BLE_HS_BENCH_MAX_ATT_READ       0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_ATT_WRITE
+#define BLE_HS_BENCH_MAX_ATT_WRITE      0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_NOTIFY
+#define BLE_HS_BENCH_MAX_NOTIFY         0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_DISC_SVCS
+#define BLE_HS_BENCH_MAX_DISC_SVCS      0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_L2CAP_RX
+#define BLE_HS_BENCH_MAX_L2CAP_RX       0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_SM_C1
+#define BLE_HS_BENCH_MAX_SM_C1          0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_SM_F4
+#define BLE_HS_BENCH_MAX_SM_F4          0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_SM_F5
+#define BLE_HS_BENCH_MAX_SM_F5          0
+#endif
+
+#ifndef BLE_HS_BENCH_MAX_SM_DHKEY
+#define BLE_HS_BENCH_MAX_SM_DHKEY       0
+#endif
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+
+#define BLE_HS_BENCH_UNIT               "cycles"
+
+#define BLE_HS_BENCH_DEMCR              (*(volatile uint32_t *)0xe000edfc)
+#define BLE_HS_BENCH_DWT_CTRL           (*(volatile uint32_t *)0xe0001000)
+#define BLE_HS_BENCH_DWT_CYCCNT         (*(volatile uint32_t *)0xe0001004)
+
+static void
+ble_hs_bench_clock_init(void)
+{
+    BLE_HS_BENCH_DEMCR |= 1 << 24;      /* TRCENA */
+    BLE_HS_BENCH_DWT_CYCCNT = 0;
+    BLE_HS_BENCH_DWT_CTRL |= 1;         /* CYCCNTENA */
+}
+
+static uint32_t
+ble_hs_bench_clock(void)
+{
+    return BLE_HS_BENCH_DWT_CYCCNT;
+}
+
+#elif defined(__arm__)
+
+#define BLE_HS_BENCH_UNIT               "ticks"
+
+static void
+ble_hs_bench_clock_init(void)
+{
+}
+
+static uint32_t
+ble_hs_bench_clock(void)
+{
+    return os_time_get();
+}
+
+#else
+
+#include <time.h>
+
+#define BLE_HS_BENCH_UNIT               "ns"
+
+static void
+ble_hs_bench_clock_init(void)
+{
+}
+
+static uint32_t
+ble_hs_bench_clock(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    /* Only differences are used, so wrapping is harmless. */
+    return (uint32_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+#endif
+
+struct ble_hs_bench_stats {
+    uint64_t total;
+    uint32_t min;
+    uint32_t count;
+};
+
+static struct ble_hs_bench_stats ble_hs_bench_stats;
+
+static uint8_t ble_hs_bench_attr[BLE_HS_BENCH_ATTR_LEN];
+
+static uint8_t ble_hs_bench_svc_uuids[BLE_HS_BENCH_NUM_SVCS][16];
+static uint8_t ble_hs_bench_chr_uuid[16];
+static struct ble_gatt_chr_def ble_hs_bench_chrs[BLE_HS_BENCH_NUM_SVCS][2];
+static struct ble_gatt_svc_def ble_hs_bench_svcs[BLE_HS_BENCH_NUM_SVCS + 1];
+
+static void
+ble_hs_bench_start(void)
+{
+    memset(&ble_hs_bench_stats, 0, sizeof ble_hs_bench_stats);
+    ble_hs_bench_stats.min = UINT32_MAX;
+}
+
+static void
+ble_hs_bench_add_cost(uint32_t cost)
+{
+    ble_hs_bench_stats.total += cost;
+    ble_hs_bench_stats.count++;
+    if (cost < ble_hs_bench_stats.min) {
+        ble_hs_bench_stats.min = cost;
+    }
+}
+
+static void
+ble_hs_bench_add(uint32_t start)
+{
+    ble_hs_bench_add_cost(ble_hs_bench_clock() - start);
+}
+
+/**
+ * Reports the cost of the operations measured since ble_hs_bench_start(),
+ * and checks it against the threshold of the benchmark.
+ */
+static void
+ble_hs_bench_report(const char *name, uint32_t max_cost)
+{
+    uint32_t mean;
+
+    TEST_ASSERT_FATAL(ble_hs_bench_stats.count > 0);
+
+    mean = ble_hs_bench_stats.total / ble_hs_bench_stats.count;
+    BLE_HS_LOG(INFO, "bench %s: n=%u mean=%u min=%u max_allowed=%u %s\n",
+               name, (unsigned)ble_hs_bench_stats.count, (unsigned)mean,
+               (unsigned)ble_hs_bench_stats.min, (unsigned)max_cost,
+               BLE_HS_BENCH_UNIT);
+
+    if (max_cost != 0) {
+        TEST_ASSERT(mean <= max_cost);
+    }
+}
+
+static int
+ble_hs_bench_access(uint16_t conn_handle, uint16_t attr_handle, uint8_t op,
+                    uint16_t offset, struct os_mbuf **om, void *arg)
+{
+    switch (op) {
+    case BLE_ATT_ACCESS_OP_READ:
+        if (os_mbuf_append(*om, ble_hs_bench_attr + offset,
+                           BLE_HS_BENCH_ATTR_LEN - offset) != 0) {
+            return BLE_ATT_ERR_INSUFFICIENT_RES;
+        }
+        return 0;
+
+    case BLE_ATT_ACCESS_OP_WRITE:
+        /* Only the cost of receiving the value is of interest. */
+        return 0;
+
+    default:
+        return BLE_ATT_ERR_UNLIKELY;
+    }
+}
+
+static int
+ble_hs_bench_gatt_access(uint16_t conn_handle, uint16_t attr_handle,
+                         struct ble_gatt_access_ctxt *ctxt, void *arg)
+{
+    return 0;
+}
+
+static uint16_t
+ble_hs_bench_init(void)
+{
+    uint16_t attr_handle;
+    int rc;
+
+    ble_hs_test_util_init();
+    ble_hs_bench_clock_init();
+
+    ble_hs_test_util_create_conn(2, ((uint8_t[]){2,3,4,5,6,7,8,9}),
+                                 NULL, NULL);
+
+    rc = ble_att_svr_register_uuid16(0x1234,
+                                     BLE_ATT_F_READ | BLE_ATT_F_WRITE,
+                                     &attr_handle, ble_hs_bench_access, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    return attr_handle;
+}
+
+TEST_CASE(ble_hs_bench_att_read)
+{
+    struct ble_att_read_req req;
+    uint8_t buf[BLE_ATT_READ_REQ_SZ];
+    uint32_t start;
+    int rc;
+    int i;
+
+    req.barq_handle = ble_hs_bench_init();
+    ble_att_read_req_write(buf, sizeof buf, &req);
+
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS; i++) {
+        start = ble_hs_bench_clock();
+        rc = ble_hs_test_util_l2cap_rx_payload_flat(2, BLE_L2CAP_CID_ATT,
+                                                    buf, sizeof buf);
+        ble_hs_test_util_tx_all();
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+
+        ble_hs_test_util_prev_tx_queue_clear();
+    }
+    ble_hs_bench_report("att_read", BLE_HS_BENCH_MAX_ATT_READ);
+}
+
+TEST_CASE(ble_hs_bench_att_write)
+{
+    struct ble_att_write_req req;
+    uint8_t buf[BLE_ATT_WRITE_REQ_BASE_SZ + BLE_HS_BENCH_ATTR_LEN];
+    uint32_t start;
+    int rc;
+    int i;
+
+    req.bawq_handle = ble_hs_bench_init();
+    ble_att_write_req_write(buf, sizeof buf, &req);
+    memset(buf + BLE_ATT_WRITE_REQ_BASE_SZ, 0xa5, BLE_HS_BENCH_ATTR_LEN);
+
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS; i++) {
+        start = ble_hs_bench_clock();
+        rc = ble_hs_test_util_l2cap_rx_payload_flat(2, BLE_L2CAP_CID_ATT,
+                                                    buf, sizeof buf);
+        ble_hs_test_util_tx_all();
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+
+        ble_hs_test_util_prev_tx_queue_clear();
+    }
+    ble_hs_bench_report("att_write", BLE_HS_BENCH_MAX_ATT_WRITE);
+}
+
+TEST_CASE(ble_hs_bench_notify)
+{
+    struct os_mbuf *om;
+    uint16_t attr_handle;
+    uint32_t start;
+    int rc;
+    int i;
+
+    attr_handle = ble_hs_bench_init();
+
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS; i++) {
+        om = ble_hs_test_util_om_from_flat(ble_hs_bench_attr,
+                                           BLE_HS_BENCH_ATTR_LEN);
+        TEST_ASSERT_FATAL(om != NULL);
+
+        start = ble_hs_bench_clock();
+        rc = ble_gattc_notify_custom(2, attr_handle, om);
+        ble_hs_test_util_tx_all();
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+
+        ble_hs_test_util_prev_tx_queue_clear();
+    }
+    ble_hs_bench_report("notify", BLE_HS_BENCH_MAX_NOTIFY);
+}
+
+/**
+ * Serves a discovery of all primary services by the peer, with one Read by
+ * Group Type Request per response, until the end of the database.
+ *
+ * @param out_cost              On return, the summed cost of the requests.
+ *
+ * @return                      The number of services discovered.
+ */
+static int
+ble_hs_bench_disc_svcs_once(uint32_t *out_cost)
+{
+    struct ble_att_read_group_type_req req;
+    uint8_t buf[BLE_ATT_READ_GROUP_TYPE_REQ_SZ_16];
+    struct os_mbuf *om;
+    uint32_t start;
+    uint8_t entry_len;
+    int num_svcs;
+    int rc;
+
+    *out_cost = 0;
+    num_svcs = 0;
+    req.bagq_start_handle = 1;
+    req.bagq_end_handle = 0xffff;
+
+    while (1) {
+        ble_att_read_group_type_req_write(buf, sizeof buf, &req);
+        htole16(buf + BLE_ATT_READ_GROUP_TYPE_REQ_BASE_SZ,
+                BLE_ATT_UUID_PRIMARY_SERVICE);
+
+        start = ble_hs_bench_clock();
+        rc = ble_hs_test_util_l2cap_rx_payload_flat(2, BLE_L2CAP_CID_ATT,
+                                                    buf, sizeof buf);
+        ble_hs_test_util_tx_all();
+        *out_cost += ble_hs_bench_clock() - start;
+        TEST_ASSERT_FATAL(rc == 0);
+
+        om = ble_hs_test_util_prev_tx_dequeue_pullup();
+        TEST_ASSERT_FATAL(om != NULL);
+        if (om->om_data[0] != BLE_ATT_OP_READ_GROUP_TYPE_RSP) {
+            /* Attribute Not Found; the discovery is complete. */
+            TEST_ASSERT_FATAL(om->om_data[0] == BLE_ATT_OP_ERROR_RSP);
+            break;
+        }
+
+        entry_len = om->om_data[1];
+        num_svcs += (om->om_len - BLE_ATT_READ_GROUP_TYPE_RSP_BASE_SZ) /
+                    entry_len;
+
+        /* Continue after the end of the last service. */
+        req.bagq_start_handle = le16toh(om->om_data + om->om_len -
+                                        entry_len + 2) + 1;
+        if (req.bagq_start_handle == 0) {
+            break;
+        }
+    }
+
+    ble_hs_test_util_prev_tx_queue_clear();
+
+    return num_svcs;
+}
+
+TEST_CASE(ble_hs_bench_disc_svcs)
+{
+    uint32_t cost;
+    int rc;
+    int i;
+
+    ble_hs_bench_init();
+
+    rc = ble_uuid_16_to_128(0xb000, ble_hs_bench_chr_uuid);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    memset(ble_hs_bench_svcs, 0, sizeof ble_hs_bench_svcs);
+    memset(ble_hs_bench_chrs, 0, sizeof ble_hs_bench_chrs);
+    for (i = 0; i < BLE_HS_BENCH_NUM_SVCS; i++) {
+        rc = ble_uuid_16_to_128(0xa000 + i, ble_hs_bench_svc_uuids[i]);
+        TEST_ASSERT_FATAL(rc == 0);
+
+        ble_hs_bench_chrs[i][0].uuid128 = ble_hs_bench_chr_uuid;
+        ble_hs_bench_chrs[i][0].access_cb = ble_hs_bench_gatt_access;
+        ble_hs_bench_chrs[i][0].flags = BLE_GATT_CHR_F_READ;
+
+        ble_hs_bench_svcs[i].type = BLE_GATT_SVC_TYPE_PRIMARY;
+        ble_hs_bench_svcs[i].uuid128 = ble_hs_bench_svc_uuids[i];
+        ble_hs_bench_svcs[i].characteristics = ble_hs_bench_chrs[i];
+    }
+
+    rc = ble_gatts_register_svcs(ble_hs_bench_svcs, NULL, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* One operation is a full discovery. */
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS / 10; i++) {
+        rc = ble_hs_bench_disc_svcs_once(&cost);
+        ble_hs_bench_add_cost(cost);
+        TEST_ASSERT_FATAL(rc == BLE_HS_BENCH_NUM_SVCS);
+    }
+    ble_hs_bench_report("disc_svcs", BLE_HS_BENCH_MAX_DISC_SVCS);
+}
+
+TEST_CASE(ble_hs_bench_l2cap_rx)
+{
+    struct ble_att_write_req req;
+    struct hci_data_hdr hci_hdr;
+    struct os_mbuf *frags[BLE_HS_BENCH_L2CAP_LEN / BLE_HS_BENCH_ACL_LEN + 2];
+    struct os_mbuf *om;
+    uint8_t buf[BLE_HS_BENCH_L2CAP_LEN];
+    uint32_t start;
+    int num_frags;
+    int off;
+    int len;
+    int rc;
+    int i;
+    int j;
+
+    req.bawq_handle = ble_hs_bench_init();
+    ble_att_write_cmd_write(buf, sizeof buf, &req);
+    memset(buf + BLE_ATT_WRITE_REQ_BASE_SZ, 0x5a,
+           sizeof buf - BLE_ATT_WRITE_REQ_BASE_SZ);
+
+    /* Allow the write command in a single ATT PDU. */
+    ble_hs_test_util_rx_att_mtu_cmd(2, 1, BLE_ATT_MTU_PREFERRED_DFLT);
+    ble_hs_test_util_prev_tx_queue_clear();
+
+    /* One operation is an ACL fragment. */
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS / 10; i++) {
+        /* Fragment the ATT PDU as a controller would deliver it. */
+        num_frags = 0;
+        for (off = 0; off < (int)sizeof buf; off += len) {
+            om = ble_hs_mbuf_l2cap_pkt();
+            TEST_ASSERT_FATAL(om != NULL);
+
+            len = BLE_HS_BENCH_ACL_LEN;
+            if (off == 0) {
+                len -= BLE_L2CAP_HDR_SZ;
+            }
+            len = min(len, (int)sizeof buf - off);
+
+            rc = os_mbuf_append(om, buf + off, len);
+            TEST_ASSERT_FATAL(rc == 0);
+
+            if (off == 0) {
+                om = ble_l2cap_prepend_hdr(om, BLE_L2CAP_CID_ATT, sizeof buf);
+                TEST_ASSERT_FATAL(om != NULL);
+            }
+            frags[num_frags++] = om;
+        }
+
+        for (j = 0; j < num_frags; j++) {
+            hci_hdr = BLE_HS_TEST_UTIL_L2CAP_HCI_HDR(
+                2, j == 0 ? BLE_HCI_PB_FIRST_FLUSH : BLE_HCI_PB_MIDDLE,
+                OS_MBUF_PKTLEN(frags[j]));
+
+            start = ble_hs_bench_clock();
+            rc = ble_hs_test_util_l2cap_rx(2, &hci_hdr, frags[j]);
+            ble_hs_bench_add(start);
+            TEST_ASSERT_FATAL(rc == 0);
+        }
+
+        ble_hs_test_util_prev_tx_queue_clear();
+    }
+    ble_hs_bench_report("l2cap_rx", BLE_HS_BENCH_MAX_L2CAP_RX);
+}
+
+TEST_CASE(ble_hs_bench_sm_alg)
+{
+    uint8_t pub[64];
+    uint8_t peer_pub[64];
+    uint32_t priv[8];
+    uint32_t peer_priv[8];
+    uint8_t dhkey[32];
+    uint8_t mackey[16];
+    uint8_t k[16];
+    uint8_t r[16];
+    uint8_t preq[7];
+    uint8_t pres[7];
+    uint8_t ia[6];
+    uint8_t ra[6];
+    uint8_t out[16];
+    uint32_t start;
+    int rc;
+    int i;
+
+    ble_hs_test_util_init();
+    ble_hs_bench_clock_init();
+
+    memset(k, 0x11, sizeof k);
+    memset(r, 0x22, sizeof r);
+    memset(preq, 0x33, sizeof preq);
+    memset(pres, 0x44, sizeof pres);
+    memset(ia, 0x55, sizeof ia);
+    memset(ra, 0x66, sizeof ra);
+
+    /*** Legacy pairing confirm value. */
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS; i++) {
+        start = ble_hs_bench_clock();
+        rc = ble_sm_alg_c1(k, r, preq, pres, 0, 1, ia, ra, out);
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    ble_hs_bench_report("sm_c1", BLE_HS_BENCH_MAX_SM_C1);
+
+    rc = ble_sm_alg_gen_key_pair(pub, priv);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_sm_alg_gen_key_pair(peer_pub, peer_priv);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /*** Secure connections confirm value. */
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS; i++) {
+        start = ble_hs_bench_clock();
+        rc = ble_sm_alg_f4(pub, peer_pub, r, 0, out);
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    ble_hs_bench_report("sm_f4", BLE_HS_BENCH_MAX_SM_F4);
+
+    /*** Shared secret. */
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ECC_ITERS; i++) {
+        start = ble_hs_bench_clock();
+        rc = ble_sm_alg_gen_dhkey(peer_pub, peer_pub + 32, priv, dhkey);
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    ble_hs_bench_report("sm_dhkey", BLE_HS_BENCH_MAX_SM_DHKEY);
+
+    /*** Key derivation. */
+    ble_hs_bench_start();
+    for (i = 0; i < BLE_HS_BENCH_ITERS; i++) {
+        start = ble_hs_bench_clock();
+        rc = ble_sm_alg_f5(dhkey, r, k, 0, ia, 1, ra, mackey, out);
+        ble_hs_bench_add(start);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    ble_hs_bench_report("sm_f5", BLE_HS_BENCH_MAX_SM_F5);
+}
+
+TEST_SUITE(ble_hs_bench_suite)
+{
+    tu_suite_set_post_test_cb(ble_hs_test_util_post_test, NULL);
+
+    ble_hs_bench_att_read();
+    ble_hs_bench_att_write();
+    ble_hs_bench_notify();
+    ble_hs_bench_disc_svcs();
+    ble_hs_bench_l2cap_rx();
+    ble_hs_bench_sm_alg();
+}
+
+int
+ble_hs_bench_all(void)
+{
+    ble_hs_bench_suite();
+
+    return tu_any_failed;
+}
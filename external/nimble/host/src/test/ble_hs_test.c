@@ -23,6 +23,11 @@
 #include "testutil/testutil.h"
 #include "ble_hs_test_util.h"
 
+/** Also run the host benchmarks of ble_hs_bench.c. */
+#ifndef BLE_HS_TEST_BENCH
+#define BLE_HS_TEST_BENCH   0
+#endif
+
 #ifdef MYNEWT_SELFTEST
 
 int
@@ -54,6 +59,10 @@ main(int argc, char **argv)
     ble_sm_test_all();
     ble_uuid_test_all();
 
+#if BLE_HS_TEST_BENCH
+    ble_hs_bench_all();
+#endif
+
     return tu_any_failed;
 }
 
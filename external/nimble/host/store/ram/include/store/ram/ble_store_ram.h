@@ -20,11 +20,59 @@
 #ifndef H_BLE_STORE_RAM_
 #define H_BLE_STORE_RAM_
 
+/** Maximum number of security entries for keys we distributed. */
+#ifndef BLE_STORE_RAM_MAX_OUR_SECS
+#define BLE_STORE_RAM_MAX_OUR_SECS      4
+#endif
+
+/** Maximum number of security entries for keys our peers distributed. */
+#ifndef BLE_STORE_RAM_MAX_PEER_SECS
+#define BLE_STORE_RAM_MAX_PEER_SECS     4
+#endif
+
+/** Maximum number of CCCD entries. */
+#ifndef BLE_STORE_RAM_MAX_CCCDS
+#define BLE_STORE_RAM_MAX_CCCDS         16
+#endif
+
+/**
+ * Number of slots in each lookup index.  Must be a power of two, and larger
+ * than each of the maximums above; twice the largest keeps probes short.
+ */
+#ifndef BLE_STORE_RAM_INDEX_SZ
+#define BLE_STORE_RAM_INDEX_SZ          32
+#endif
+
+/**
+ * Persists the database to flash with the SDK's flash data storage (FDS)
+ * module, and loads it back in ble_store_ram_init().
+ */
+#ifndef BLE_STORE_RAM_FDS
+#define BLE_STORE_RAM_FDS               0
+#endif
+
+/** FDS file that holds the records of the database. */
+#ifndef BLE_STORE_RAM_FDS_FILE_ID
+#define BLE_STORE_RAM_FDS_FILE_ID       0xb1e0
+#endif
+
+/**
+ * Delay between a change and its write to flash, in milliseconds.  Changes
+ * made during the delay are written together, one record per entry.
+ */
+#ifndef BLE_STORE_RAM_FDS_FLUSH_MS
+#define BLE_STORE_RAM_FDS_FLUSH_MS      1000
+#endif
+
+struct os_eventq;
 union ble_store_key;
 union ble_store_value;
 
+int ble_store_ram_init(struct os_eventq *evq);
 int ble_store_ram_read(int obj_type, union ble_store_key *key,
                        union ble_store_value *value);
 int ble_store_ram_write(int obj_type, union ble_store_value *val);
+int ble_store_ram_delete(int obj_type, union ble_store_key *key);
+void ble_store_ram_flush(void);
 
 #endif
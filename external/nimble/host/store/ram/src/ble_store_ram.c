@@ -19,8 +19,14 @@
 
 /**
  * This file implements a simple in-RAM key database for BLE host security
- * material and CCCDs.  As this database is only ble_store_ramd in RAM, its
- * contents are lost when the application terminates.
+ * material and CCCDs.  Unless BLE_STORE_RAM_FDS is enabled, the database is
+ * only kept in RAM, and its contents are lost when the application
+ * terminates.
+ *
+ * Each table is indexed by open-addressed hashes of its lookup keys.  Entries
+ * are only appended, and the indexes are rebuilt when an entry is deleted, so
+ * the matches of a key are found in the order of the table; a lookup that
+ * skips key->idx matches returns the same entry as a scan of the table.
  */
 
 #include <inttypes.h>
@@ -28,20 +34,138 @@
 
 #include "host/ble_hs.h"
 #include "store/ram/ble_store_ram.h"
+#if BLE_STORE_RAM_FDS
+#include "fds.h"
+#endif
+
+#define STORE_MAX_SLV_LTKS   BLE_STORE_RAM_MAX_OUR_SECS
+#define STORE_MAX_MST_LTKS   BLE_STORE_RAM_MAX_PEER_SECS
+#define STORE_MAX_CCCDS      BLE_STORE_RAM_MAX_CCCDS
+
+#if (BLE_STORE_RAM_INDEX_SZ & (BLE_STORE_RAM_INDEX_SZ - 1)) != 0
+#error "BLE_STORE_RAM_INDEX_SZ must be a power of two"
+#endif
+
+#if BLE_STORE_RAM_INDEX_SZ <= STORE_MAX_SLV_LTKS || \
+    BLE_STORE_RAM_INDEX_SZ <= STORE_MAX_MST_LTKS || \
+    BLE_STORE_RAM_INDEX_SZ <= STORE_MAX_CCCDS     || \
+    BLE_STORE_RAM_INDEX_SZ > 256
+#error "BLE_STORE_RAM_INDEX_SZ must be larger than the table sizes"
+#endif
+
+#define BLE_STORE_RAM_INDEX_MASK    (BLE_STORE_RAM_INDEX_SZ - 1)
 
-/* XXX: This should be configurable. */
-#define STORE_MAX_SLV_LTKS   4
-#define STORE_MAX_MST_LTKS   4
-#define STORE_MAX_CCCDS      16
+/**
+ * Open-addressed hash index of a table.  A slot holds the position of an
+ * entry plus one; zero marks an empty slot.
+ */
+struct ble_store_ram_index {
+    uint8_t slots[BLE_STORE_RAM_INDEX_SZ];
+};
 
 static struct ble_store_value_sec ble_store_ram_our_secs[STORE_MAX_SLV_LTKS];
 static int ble_store_ram_num_our_secs;
+static struct ble_store_ram_index ble_store_ram_our_secs_by_addr;
+static struct ble_store_ram_index ble_store_ram_our_secs_by_ediv_rand;
 
 static struct ble_store_value_sec ble_store_ram_peer_secs[STORE_MAX_MST_LTKS];
 static int ble_store_ram_num_peer_secs;
+static struct ble_store_ram_index ble_store_ram_peer_secs_by_addr;
+static struct ble_store_ram_index ble_store_ram_peer_secs_by_ediv_rand;
 
 static struct ble_store_value_cccd ble_store_ram_cccds[STORE_MAX_CCCDS];
 static int ble_store_ram_num_cccds;
+static struct ble_store_ram_index ble_store_ram_cccds_by_peer;
+static struct ble_store_ram_index ble_store_ram_cccds_by_chr;
+
+#if BLE_STORE_RAM_FDS
+static void ble_store_ram_fds_mark(int obj_type, int idx);
+static void ble_store_ram_fds_remove(int obj_type, int idx);
+#endif
+
+/*****************************************************************************
+ * $index                                                                    *
+ *****************************************************************************/
+
+static uint32_t
+ble_store_ram_hash_bytes(uint32_t hash, const void *data, int len)
+{
+    const uint8_t *u8p;
+    int i;
+
+    /* FNV-1a. */
+    u8p = data;
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ u8p[i]) * 16777619;
+    }
+
+    return hash;
+}
+
+static uint32_t
+ble_store_ram_hash_addr(uint8_t addr_type, const uint8_t *addr)
+{
+    uint32_t hash;
+
+    hash = ble_store_ram_hash_bytes(2166136261UL, &addr_type, 1);
+    hash = ble_store_ram_hash_bytes(hash, addr, 6);
+
+    return hash;
+}
+
+static uint32_t
+ble_store_ram_hash_ediv_rand(uint16_t ediv, uint64_t rand_num)
+{
+    uint32_t hash;
+
+    hash = ble_store_ram_hash_bytes(2166136261UL, &ediv, sizeof ediv);
+    hash = ble_store_ram_hash_bytes(hash, &rand_num, sizeof rand_num);
+
+    return hash;
+}
+
+static uint32_t
+ble_store_ram_hash_chr(uint8_t addr_type, const uint8_t *addr,
+                       uint16_t chr_val_handle)
+{
+    uint32_t hash;
+
+    hash = ble_store_ram_hash_addr(addr_type, addr);
+    hash = ble_store_ram_hash_bytes(hash, &chr_val_handle,
+                                    sizeof chr_val_handle);
+
+    return hash;
+}
+
+static void
+ble_store_ram_index_add(struct ble_store_ram_index *index, uint32_t hash,
+                        int idx)
+{
+    int i;
+
+    /* The index is larger than the table, so there is always a free slot. */
+    i = hash & BLE_STORE_RAM_INDEX_MASK;
+    while (index->slots[i] != 0) {
+        i = (i + 1) & BLE_STORE_RAM_INDEX_MASK;
+    }
+
+    index->slots[i] = idx + 1;
+}
+
+/**
+ * Removes the entry at the specified position from a table, keeping the
+ * order of the remaining entries.
+ */
+static void
+ble_store_ram_remove(void *values, int value_sz, int *num_values, int idx)
+{
+    uint8_t *u8p;
+
+    u8p = values;
+    memmove(u8p + idx * value_sz, u8p + (idx + 1) * value_sz,
+            (*num_values - idx - 1) * value_sz);
+    (*num_values)--;
+}
 
 /*****************************************************************************
  * $sec                                                                      *
@@ -86,37 +210,101 @@ ble_store_ram_print_key_sec(struct ble_store_key_sec *key_sec)
 }
 
 static int
-ble_store_ram_find_sec(struct ble_store_key_sec *key_sec,
-                   struct ble_store_value_sec *value_secs, int num_value_secs)
+ble_store_ram_sec_matches(struct ble_store_key_sec *key_sec,
+                          struct ble_store_value_sec *cur)
+{
+    if (key_sec->peer_addr_type != BLE_STORE_ADDR_TYPE_NONE) {
+        if (cur->peer_addr_type != key_sec->peer_addr_type) {
+            return 0;
+        }
+
+        if (memcmp(cur->peer_addr, key_sec->peer_addr,
+                   sizeof cur->peer_addr) != 0) {
+            return 0;
+        }
+    }
+
+    if (key_sec->ediv_rand_present) {
+        if (cur->ediv != key_sec->ediv) {
+            return 0;
+        }
+
+        if (cur->rand_num != key_sec->rand_num) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static void
+ble_store_ram_index_sec(struct ble_store_value_sec *value_sec, int idx,
+                        struct ble_store_ram_index *by_addr,
+                        struct ble_store_ram_index *by_ediv_rand)
+{
+    ble_store_ram_index_add(by_addr,
+                            ble_store_ram_hash_addr(value_sec->peer_addr_type,
+                                                    value_sec->peer_addr),
+                            idx);
+    ble_store_ram_index_add(by_ediv_rand,
+                            ble_store_ram_hash_ediv_rand(value_sec->ediv,
+                                                         value_sec->rand_num),
+                            idx);
+}
+
+static void
+ble_store_ram_reindex_secs(struct ble_store_value_sec *value_secs,
+                           int num_value_secs,
+                           struct ble_store_ram_index *by_addr,
+                           struct ble_store_ram_index *by_ediv_rand)
 {
-    struct ble_store_value_sec *cur;
-    int skipped;
     int i;
 
-    skipped = 0;
+    memset(by_addr, 0, sizeof *by_addr);
+    memset(by_ediv_rand, 0, sizeof *by_ediv_rand);
 
     for (i = 0; i < num_value_secs; i++) {
-        cur = value_secs + i;
+        ble_store_ram_index_sec(value_secs + i, i, by_addr, by_ediv_rand);
+    }
+}
 
-        if (key_sec->peer_addr_type != BLE_STORE_ADDR_TYPE_NONE) {
-            if (cur->peer_addr_type != key_sec->peer_addr_type) {
-                continue;
-            }
+static int
+ble_store_ram_find_sec(struct ble_store_key_sec *key_sec,
+                   struct ble_store_value_sec *value_secs, int num_value_secs,
+                   struct ble_store_ram_index *by_addr,
+                   struct ble_store_ram_index *by_ediv_rand)
+{
+    struct ble_store_ram_index *index;
+    uint32_t hash;
+    int skipped;
+    int idx;
+    int i;
 
-            if (memcmp(cur->peer_addr, key_sec->peer_addr,
-                       sizeof cur->peer_addr) != 0) {
-                continue;
-            }
+    skipped = 0;
+
+    if (key_sec->peer_addr_type != BLE_STORE_ADDR_TYPE_NONE) {
+        index = by_addr;
+        hash = ble_store_ram_hash_addr(key_sec->peer_addr_type,
+                                       key_sec->peer_addr);
+    } else if (key_sec->ediv_rand_present) {
+        index = by_ediv_rand;
+        hash = ble_store_ram_hash_ediv_rand(key_sec->ediv,
+                                            key_sec->rand_num);
+    } else {
+        /* Wildcard; every entry matches. */
+        if (key_sec->idx < num_value_secs) {
+            return key_sec->idx;
         }
+        return -1;
+    }
 
-        if (key_sec->ediv_rand_present) {
-            if (cur->ediv != key_sec->ediv) {
-                continue;
-            }
+    for (i = hash & BLE_STORE_RAM_INDEX_MASK;
+         index->slots[i] != 0;
+         i = (i + 1) & BLE_STORE_RAM_INDEX_MASK) {
 
-            if (cur->rand_num != key_sec->rand_num) {
-                continue;
-            }
+        idx = index->slots[i] - 1;
+        if (!ble_store_ram_sec_matches(key_sec, value_secs + idx)) {
+            continue;
         }
 
         if (key_sec->idx > skipped) {
@@ -124,7 +312,7 @@ ble_store_ram_find_sec(struct ble_store_key_sec *key_sec,
             continue;
         }
 
-        return i;
+        return idx;
     }
 
     return -1;
@@ -137,7 +325,9 @@ ble_store_ram_read_our_sec(struct ble_store_key_sec *key_sec,
     int idx;
 
     idx = ble_store_ram_find_sec(key_sec, ble_store_ram_our_secs,
-                                 ble_store_ram_num_our_secs);
+                                 ble_store_ram_num_our_secs,
+                                 &ble_store_ram_our_secs_by_addr,
+                                 &ble_store_ram_our_secs_by_ediv_rand);
     if (idx == -1) {
         return BLE_HS_ENOENT;
     }
@@ -157,7 +347,9 @@ ble_store_ram_write_our_sec(struct ble_store_value_sec *value_sec)
 
     ble_store_key_from_value_sec(&key_sec, value_sec);
     idx = ble_store_ram_find_sec(&key_sec, ble_store_ram_our_secs,
-                             ble_store_ram_num_our_secs);
+                             ble_store_ram_num_our_secs,
+                             &ble_store_ram_our_secs_by_addr,
+                             &ble_store_ram_our_secs_by_ediv_rand);
     if (idx == -1) {
         if (ble_store_ram_num_our_secs >= STORE_MAX_SLV_LTKS) {
             BLE_HS_LOG(DEBUG, "error persisting our sec; too many entries "
@@ -167,9 +359,41 @@ ble_store_ram_write_our_sec(struct ble_store_value_sec *value_sec)
 
         idx = ble_store_ram_num_our_secs;
         ble_store_ram_num_our_secs++;
+        ble_store_ram_index_sec(value_sec, idx,
+                                &ble_store_ram_our_secs_by_addr,
+                                &ble_store_ram_our_secs_by_ediv_rand);
     }
 
     ble_store_ram_our_secs[idx] = *value_sec;
+#if BLE_STORE_RAM_FDS
+    ble_store_ram_fds_mark(BLE_STORE_OBJ_TYPE_OUR_SEC, idx);
+#endif
+    return 0;
+}
+
+static int
+ble_store_ram_delete_our_sec(struct ble_store_key_sec *key_sec)
+{
+    int idx;
+
+    idx = ble_store_ram_find_sec(key_sec, ble_store_ram_our_secs,
+                                 ble_store_ram_num_our_secs,
+                                 &ble_store_ram_our_secs_by_addr,
+                                 &ble_store_ram_our_secs_by_ediv_rand);
+    if (idx == -1) {
+        return BLE_HS_ENOENT;
+    }
+
+#if BLE_STORE_RAM_FDS
+    ble_store_ram_fds_remove(BLE_STORE_OBJ_TYPE_OUR_SEC, idx);
+#endif
+    ble_store_ram_remove(ble_store_ram_our_secs,
+                         sizeof ble_store_ram_our_secs[0],
+                         &ble_store_ram_num_our_secs, idx);
+    ble_store_ram_reindex_secs(ble_store_ram_our_secs,
+                               ble_store_ram_num_our_secs,
+                               &ble_store_ram_our_secs_by_addr,
+                               &ble_store_ram_our_secs_by_ediv_rand);
     return 0;
 }
 
@@ -180,7 +404,9 @@ ble_store_ram_read_peer_sec(struct ble_store_key_sec *key_sec,
     int idx;
 
     idx = ble_store_ram_find_sec(key_sec, ble_store_ram_peer_secs,
-                             ble_store_ram_num_peer_secs);
+                             ble_store_ram_num_peer_secs,
+                             &ble_store_ram_peer_secs_by_addr,
+                             &ble_store_ram_peer_secs_by_ediv_rand);
     if (idx == -1) {
         return BLE_HS_ENOENT;
     }
@@ -200,7 +426,9 @@ ble_store_ram_write_peer_sec(struct ble_store_value_sec *value_sec)
 
     ble_store_key_from_value_sec(&key_sec, value_sec);
     idx = ble_store_ram_find_sec(&key_sec, ble_store_ram_peer_secs,
-                             ble_store_ram_num_peer_secs);
+                             ble_store_ram_num_peer_secs,
+                             &ble_store_ram_peer_secs_by_addr,
+                             &ble_store_ram_peer_secs_by_ediv_rand);
     if (idx == -1) {
         if (ble_store_ram_num_peer_secs >= STORE_MAX_MST_LTKS) {
             BLE_HS_LOG(DEBUG, "error persisting peer sec; too many entries "
@@ -210,9 +438,41 @@ ble_store_ram_write_peer_sec(struct ble_store_value_sec *value_sec)
 
         idx = ble_store_ram_num_peer_secs;
         ble_store_ram_num_peer_secs++;
+        ble_store_ram_index_sec(value_sec, idx,
+                                &ble_store_ram_peer_secs_by_addr,
+                                &ble_store_ram_peer_secs_by_ediv_rand);
     }
 
     ble_store_ram_peer_secs[idx] = *value_sec;
+#if BLE_STORE_RAM_FDS
+    ble_store_ram_fds_mark(BLE_STORE_OBJ_TYPE_PEER_SEC, idx);
+#endif
+    return 0;
+}
+
+static int
+ble_store_ram_delete_peer_sec(struct ble_store_key_sec *key_sec)
+{
+    int idx;
+
+    idx = ble_store_ram_find_sec(key_sec, ble_store_ram_peer_secs,
+                                 ble_store_ram_num_peer_secs,
+                                 &ble_store_ram_peer_secs_by_addr,
+                                 &ble_store_ram_peer_secs_by_ediv_rand);
+    if (idx == -1) {
+        return BLE_HS_ENOENT;
+    }
+
+#if BLE_STORE_RAM_FDS
+    ble_store_ram_fds_remove(BLE_STORE_OBJ_TYPE_PEER_SEC, idx);
+#endif
+    ble_store_ram_remove(ble_store_ram_peer_secs,
+                         sizeof ble_store_ram_peer_secs[0],
+                         &ble_store_ram_num_peer_secs, idx);
+    ble_store_ram_reindex_secs(ble_store_ram_peer_secs,
+                               ble_store_ram_num_peer_secs,
+                               &ble_store_ram_peer_secs_by_addr,
+                               &ble_store_ram_peer_secs_by_ediv_rand);
     return 0;
 }
 
@@ -221,30 +481,101 @@ ble_store_ram_write_peer_sec(struct ble_store_value_sec *value_sec)
  *****************************************************************************/
 
 static int
-ble_store_ram_find_cccd(struct ble_store_key_cccd *key)
+ble_store_ram_cccd_matches(struct ble_store_key_cccd *key,
+                           struct ble_store_value_cccd *cccd)
+{
+    if (key->peer_addr_type != BLE_STORE_ADDR_TYPE_NONE) {
+        if (cccd->peer_addr_type != key->peer_addr_type) {
+            return 0;
+        }
+
+        if (memcmp(cccd->peer_addr, key->peer_addr, 6) != 0) {
+            return 0;
+        }
+    }
+
+    if (key->chr_val_handle != 0) {
+        if (cccd->chr_val_handle != key->chr_val_handle) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static void
+ble_store_ram_index_cccd(struct ble_store_value_cccd *cccd, int idx)
+{
+    ble_store_ram_index_add(&ble_store_ram_cccds_by_peer,
+                            ble_store_ram_hash_addr(cccd->peer_addr_type,
+                                                    cccd->peer_addr),
+                            idx);
+    ble_store_ram_index_add(&ble_store_ram_cccds_by_chr,
+                            ble_store_ram_hash_chr(cccd->peer_addr_type,
+                                                   cccd->peer_addr,
+                                                   cccd->chr_val_handle),
+                            idx);
+}
+
+static void
+ble_store_ram_reindex_cccds(void)
 {
-    struct ble_store_value_cccd *cccd;
-    int skipped;
     int i;
 
-    skipped = 0;
+    memset(&ble_store_ram_cccds_by_peer, 0,
+           sizeof ble_store_ram_cccds_by_peer);
+    memset(&ble_store_ram_cccds_by_chr, 0, sizeof ble_store_ram_cccds_by_chr);
+
     for (i = 0; i < ble_store_ram_num_cccds; i++) {
-        cccd = ble_store_ram_cccds + i;
+        ble_store_ram_index_cccd(ble_store_ram_cccds + i, i);
+    }
+}
 
-        if (key->peer_addr_type != BLE_STORE_ADDR_TYPE_NONE) {
-            if (cccd->peer_addr_type != key->peer_addr_type) {
+static int
+ble_store_ram_find_cccd(struct ble_store_key_cccd *key)
+{
+    struct ble_store_ram_index *index;
+    uint32_t hash;
+    int skipped;
+    int idx;
+    int i;
+
+    if (key->peer_addr_type == BLE_STORE_ADDR_TYPE_NONE) {
+        /* Not keyed by peer; scan the table. */
+        skipped = 0;
+        for (i = 0; i < ble_store_ram_num_cccds; i++) {
+            if (!ble_store_ram_cccd_matches(key, ble_store_ram_cccds + i)) {
                 continue;
             }
 
-            if (memcmp(cccd->peer_addr, key->peer_addr, 6) != 0) {
+            if (key->idx > skipped) {
+                skipped++;
                 continue;
             }
+
+            return i;
         }
 
-        if (key->chr_val_handle != 0) {
-            if (cccd->chr_val_handle != key->chr_val_handle) {
-                continue;
-            }
+        return -1;
+    }
+
+    if (key->chr_val_handle != 0) {
+        index = &ble_store_ram_cccds_by_chr;
+        hash = ble_store_ram_hash_chr(key->peer_addr_type, key->peer_addr,
+                                      key->chr_val_handle);
+    } else {
+        index = &ble_store_ram_cccds_by_peer;
+        hash = ble_store_ram_hash_addr(key->peer_addr_type, key->peer_addr);
+    }
+
+    skipped = 0;
+    for (i = hash & BLE_STORE_RAM_INDEX_MASK;
+         index->slots[i] != 0;
+         i = (i + 1) & BLE_STORE_RAM_INDEX_MASK) {
+
+        idx = index->slots[i] - 1;
+        if (!ble_store_ram_cccd_matches(key, ble_store_ram_cccds + idx)) {
+            continue;
         }
 
         if (key->idx > skipped) {
@@ -252,7 +583,7 @@ ble_store_ram_find_cccd(struct ble_store_key_cccd *key)
             continue;
         }
 
-        return i;
+        return idx;
     }
 
     return -1;
@@ -282,7 +613,7 @@ ble_store_ram_write_cccd(struct ble_store_value_cccd *value_cccd)
     ble_store_key_from_value_cccd(&key_cccd, value_cccd);
     idx = ble_store_ram_find_cccd(&key_cccd);
     if (idx == -1) {
-        if (ble_store_ram_num_cccds >= STORE_MAX_SLV_LTKS) {
+        if (ble_store_ram_num_cccds >= STORE_MAX_CCCDS) {
             BLE_HS_LOG(DEBUG, "error persisting cccd; too many entries (%d)\n",
                        ble_store_ram_num_cccds);
             return BLE_HS_ENOMEM;
@@ -290,16 +621,387 @@ ble_store_ram_write_cccd(struct ble_store_value_cccd *value_cccd)
 
         idx = ble_store_ram_num_cccds;
         ble_store_ram_num_cccds++;
+        ble_store_ram_index_cccd(value_cccd, idx);
     }
 
     ble_store_ram_cccds[idx] = *value_cccd;
+#if BLE_STORE_RAM_FDS
+    ble_store_ram_fds_mark(BLE_STORE_OBJ_TYPE_CCCD, idx);
+#endif
+    return 0;
+}
+
+static int
+ble_store_ram_delete_cccd(struct ble_store_key_cccd *key_cccd)
+{
+    int idx;
+
+    idx = ble_store_ram_find_cccd(key_cccd);
+    if (idx == -1) {
+        return BLE_HS_ENOENT;
+    }
+
+#if BLE_STORE_RAM_FDS
+    ble_store_ram_fds_remove(BLE_STORE_OBJ_TYPE_CCCD, idx);
+#endif
+    ble_store_ram_remove(ble_store_ram_cccds, sizeof ble_store_ram_cccds[0],
+                         &ble_store_ram_num_cccds, idx);
+    ble_store_ram_reindex_cccds();
+    return 0;
+}
+
+#if BLE_STORE_RAM_FDS
+
+/*****************************************************************************
+ * $fds                                                                      *
+ *****************************************************************************/
+
+/**
+ * Each entry is stored as one FDS record, keyed by its object type.  Changed
+ * entries are marked dirty and written by a flush, which runs
+ * BLE_STORE_RAM_FDS_FLUSH_MS after the first change; an entry that changes
+ * several times before the flush is written once.  The flush writes one
+ * record at a time from a staging buffer, and continues when FDS reports
+ * the write, so the entries can change while the write is in progress.
+ */
+
+#define BLE_STORE_RAM_FDS_WORDS(sz)    (((sz) + 3) / 4)
+
+#define BLE_STORE_RAM_FDS_IDLE          0
+#define BLE_STORE_RAM_FDS_WRITING       1
+#define BLE_STORE_RAM_FDS_GC            2
+
+struct ble_store_ram_rec {
+    fds_record_desc_t desc;
+    uint8_t in_flash:1;
+    uint8_t dirty:1;
+};
+
+struct ble_store_ram_fds_table {
+    uint16_t obj_type;
+    uint16_t value_sz;
+    void *values;
+    int *num_values;
+    int max_values;
+    struct ble_store_ram_rec *recs;
+};
+
+static struct ble_store_ram_rec ble_store_ram_our_sec_recs[STORE_MAX_SLV_LTKS];
+static struct ble_store_ram_rec ble_store_ram_peer_sec_recs[STORE_MAX_MST_LTKS];
+static struct ble_store_ram_rec ble_store_ram_cccd_recs[STORE_MAX_CCCDS];
+
+static const struct ble_store_ram_fds_table ble_store_ram_fds_tables[] = {
+    {
+        .obj_type = BLE_STORE_OBJ_TYPE_OUR_SEC,
+        .value_sz = sizeof ble_store_ram_our_secs[0],
+        .values = ble_store_ram_our_secs,
+        .num_values = &ble_store_ram_num_our_secs,
+        .max_values = STORE_MAX_SLV_LTKS,
+        .recs = ble_store_ram_our_sec_recs,
+    },
+    {
+        .obj_type = BLE_STORE_OBJ_TYPE_PEER_SEC,
+        .value_sz = sizeof ble_store_ram_peer_secs[0],
+        .values = ble_store_ram_peer_secs,
+        .num_values = &ble_store_ram_num_peer_secs,
+        .max_values = STORE_MAX_MST_LTKS,
+        .recs = ble_store_ram_peer_sec_recs,
+    },
+    {
+        .obj_type = BLE_STORE_OBJ_TYPE_CCCD,
+        .value_sz = sizeof ble_store_ram_cccds[0],
+        .values = ble_store_ram_cccds,
+        .num_values = &ble_store_ram_num_cccds,
+        .max_values = STORE_MAX_CCCDS,
+        .recs = ble_store_ram_cccd_recs,
+    },
+};
+
+#define BLE_STORE_RAM_FDS_NUM_TABLES                    \
+    ((int)(sizeof ble_store_ram_fds_tables /            \
+           sizeof ble_store_ram_fds_tables[0]))
+
+static uint32_t ble_store_ram_fds_buf[
+    BLE_STORE_RAM_FDS_WORDS(sizeof (union ble_store_value))];
+static struct os_callout_func ble_store_ram_fds_flush_timer;
+static volatile uint8_t ble_store_ram_fds_state;
+static uint8_t ble_store_ram_fds_registered;
+
+static const struct ble_store_ram_fds_table *
+ble_store_ram_fds_table(int obj_type)
+{
+    int i;
+
+    for (i = 0; i < BLE_STORE_RAM_FDS_NUM_TABLES; i++) {
+        if (ble_store_ram_fds_tables[i].obj_type == obj_type) {
+            return ble_store_ram_fds_tables + i;
+        }
+    }
+
+    return NULL;
+}
+
+static void
+ble_store_ram_fds_mark(int obj_type, int idx)
+{
+    const struct ble_store_ram_fds_table *table;
+    uint32_t ticks;
+
+    table = ble_store_ram_fds_table(obj_type);
+    table->recs[idx].dirty = 1;
+
+    /* Later changes are written by the flush that is already pending. */
+    if (!os_callout_queued(&ble_store_ram_fds_flush_timer.cf_c)) {
+        ticks = BLE_STORE_RAM_FDS_FLUSH_MS * OS_TICKS_PER_SEC / 1000;
+        os_callout_reset(&ble_store_ram_fds_flush_timer.cf_c, ticks);
+    }
+}
+
+static void
+ble_store_ram_fds_remove(int obj_type, int idx)
+{
+    const struct ble_store_ram_fds_table *table;
+    ret_code_t rc;
+    int num_recs;
+
+    table = ble_store_ram_fds_table(obj_type);
+    if (table->recs[idx].in_flash) {
+        rc = fds_record_delete(&table->recs[idx].desc);
+        if (rc != FDS_SUCCESS) {
+            BLE_HS_LOG(DEBUG, "error deleting store record; rc=%d\n",
+                       (int)rc);
+        }
+    }
+
+    /* The entry itself is removed by the caller. */
+    num_recs = *table->num_values;
+    ble_store_ram_remove(table->recs, sizeof table->recs[0], &num_recs, idx);
+    memset(table->recs + num_recs, 0, sizeof table->recs[0]);
+}
+
+static void
+ble_store_ram_fds_flush(void *unused)
+{
+    const struct ble_store_ram_fds_table *table;
+    struct ble_store_ram_rec *rec;
+    fds_record_chunk_t chunk;
+    fds_record_t record;
+    ret_code_t rc;
+    int i;
+    int j;
+
+    if (ble_store_ram_fds_state != BLE_STORE_RAM_FDS_IDLE) {
+        return;
+    }
+
+    for (i = 0; i < BLE_STORE_RAM_FDS_NUM_TABLES; i++) {
+        table = ble_store_ram_fds_tables + i;
+        for (j = 0; j < *table->num_values; j++) {
+            rec = table->recs + j;
+            if (!rec->dirty) {
+                continue;
+            }
+
+            memcpy(ble_store_ram_fds_buf,
+                   (uint8_t *)table->values + j * table->value_sz,
+                   table->value_sz);
+
+            chunk.p_data = ble_store_ram_fds_buf;
+            chunk.length_words = BLE_STORE_RAM_FDS_WORDS(table->value_sz);
+            record.file_id = BLE_STORE_RAM_FDS_FILE_ID;
+            record.key = table->obj_type;
+            record.data.p_chunks = &chunk;
+            record.data.num_chunks = 1;
+
+            ble_store_ram_fds_state = BLE_STORE_RAM_FDS_WRITING;
+            if (rec->in_flash) {
+                rc = fds_record_update(&rec->desc, &record);
+            } else {
+                rc = fds_record_write(&rec->desc, &record);
+            }
+
+            switch (rc) {
+            case FDS_SUCCESS:
+                rec->in_flash = 1;
+                rec->dirty = 0;
+                break;
+
+            case FDS_ERR_NO_SPACE_IN_FLASH:
+                /* Reclaim the space of the records we replaced; the flush
+                 * resumes when garbage collection is done.
+                 */
+                ble_store_ram_fds_state = BLE_STORE_RAM_FDS_GC;
+                if (fds_gc() != FDS_SUCCESS) {
+                    ble_store_ram_fds_state = BLE_STORE_RAM_FDS_IDLE;
+                }
+                break;
+
+            default:
+                /* The FDS queue is full; retry later. */
+                BLE_HS_LOG(DEBUG, "error writing store record; rc=%d\n",
+                           (int)rc);
+                ble_store_ram_fds_state = BLE_STORE_RAM_FDS_IDLE;
+                os_callout_reset(&ble_store_ram_fds_flush_timer.cf_c,
+                                 BLE_STORE_RAM_FDS_FLUSH_MS *
+                                 OS_TICKS_PER_SEC / 1000);
+                break;
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * Marks the entry of a failed write dirty again, so that the next flush
+ * writes it.
+ */
+static void
+ble_store_ram_fds_rewrite(uint32_t record_id)
+{
+    const struct ble_store_ram_fds_table *table;
+    int i;
+    int j;
+
+    for (i = 0; i < BLE_STORE_RAM_FDS_NUM_TABLES; i++) {
+        table = ble_store_ram_fds_tables + i;
+        for (j = 0; j < *table->num_values; j++) {
+            if (table->recs[j].desc.record_id == record_id) {
+                table->recs[j].in_flash = 0;
+                table->recs[j].dirty = 1;
+                return;
+            }
+        }
+    }
+}
+
+static void
+ble_store_ram_fds_evt(fds_evt_t const * const evt)
+{
+    switch (evt->id) {
+    case FDS_EVT_WRITE:
+    case FDS_EVT_UPDATE:
+        if (evt->write.file_id != BLE_STORE_RAM_FDS_FILE_ID ||
+            ble_store_ram_fds_state != BLE_STORE_RAM_FDS_WRITING) {
+            return;
+        }
+        if (evt->result != FDS_SUCCESS) {
+            ble_store_ram_fds_rewrite(evt->write.record_id);
+        }
+        break;
+
+    case FDS_EVT_GC:
+        if (ble_store_ram_fds_state != BLE_STORE_RAM_FDS_GC) {
+            return;
+        }
+        break;
+
+    default:
+        return;
+    }
+
+    /* Write the next dirty entry from the host's task. */
+    ble_store_ram_fds_state = BLE_STORE_RAM_FDS_IDLE;
+    os_callout_reset(&ble_store_ram_fds_flush_timer.cf_c, 0);
+}
+
+static int
+ble_store_ram_fds_load(void)
+{
+    const struct ble_store_ram_fds_table *table;
+    fds_flash_record_t flash_rec;
+    fds_record_desc_t desc;
+    fds_find_token_t token;
+    int idx;
+
+    memset(&token, 0, sizeof token);
+    while (fds_record_find_in_file(BLE_STORE_RAM_FDS_FILE_ID, &desc,
+                                   &token) == FDS_SUCCESS) {
+
+        if (fds_record_open(&desc, &flash_rec) != FDS_SUCCESS) {
+            continue;
+        }
+
+        idx = -1;
+        table = ble_store_ram_fds_table(flash_rec.p_header->tl.record_key);
+        if (table != NULL &&
+            flash_rec.p_header->tl.length_words ==
+                BLE_STORE_RAM_FDS_WORDS(table->value_sz) &&
+            *table->num_values < table->max_values) {
+
+            idx = (*table->num_values)++;
+            memcpy((uint8_t *)table->values + idx * table->value_sz,
+                   flash_rec.p_data, table->value_sz);
+            table->recs[idx].in_flash = 1;
+            table->recs[idx].dirty = 0;
+        } else {
+            BLE_HS_LOG(DEBUG, "ignoring store record; key=%d\n",
+                       flash_rec.p_header->tl.record_key);
+        }
+
+        if (fds_record_close(&desc) != FDS_SUCCESS) {
+            return BLE_HS_EOS;
+        }
+        if (idx != -1) {
+            table->recs[idx].desc = desc;
+        }
+    }
+
     return 0;
 }
 
+#endif
+
 /*****************************************************************************
  * $api                                                                      *
  *****************************************************************************/
 
+/**
+ * Clears the database.  With BLE_STORE_RAM_FDS, loads the entries stored in
+ * flash; FDS must be initialized, and the host callbacks and the flushes run
+ * from the specified event queue, usually the one given to ble_hs_init().
+ *
+ * @return                      0 on success; BLE_HS_EOS if FDS failed.
+ */
+int
+ble_store_ram_init(struct os_eventq *evq)
+{
+    int rc;
+
+    ble_store_ram_num_our_secs = 0;
+    ble_store_ram_num_peer_secs = 0;
+    ble_store_ram_num_cccds = 0;
+    rc = 0;
+
+#if BLE_STORE_RAM_FDS
+    os_callout_func_init(&ble_store_ram_fds_flush_timer, evq,
+                         ble_store_ram_fds_flush, NULL);
+    ble_store_ram_fds_state = BLE_STORE_RAM_FDS_IDLE;
+
+    if (!ble_store_ram_fds_registered) {
+        if (fds_register(ble_store_ram_fds_evt) != FDS_SUCCESS) {
+            return BLE_HS_EOS;
+        }
+        ble_store_ram_fds_registered = 1;
+    }
+
+    rc = ble_store_ram_fds_load();
+#else
+    (void)evq;
+#endif
+
+    ble_store_ram_reindex_secs(ble_store_ram_our_secs,
+                               ble_store_ram_num_our_secs,
+                               &ble_store_ram_our_secs_by_addr,
+                               &ble_store_ram_our_secs_by_ediv_rand);
+    ble_store_ram_reindex_secs(ble_store_ram_peer_secs,
+                               ble_store_ram_num_peer_secs,
+                               &ble_store_ram_peer_secs_by_addr,
+                               &ble_store_ram_peer_secs_by_ediv_rand);
+    ble_store_ram_reindex_cccds();
+
+    return rc;
+}
+
 /**
  * Searches the database for an object matching the specified criteria.
  *
@@ -371,3 +1073,46 @@ ble_store_ram_write(int obj_type, union ble_store_value *val)
         return BLE_HS_ENOTSUP;
     }
 }
+
+/**
+ * Deletes the first object matching the specified criteria.
+ *
+ * @return                      0 if an object was deleted; else
+ *                                  BLE_HS_ENOENT.
+ */
+int
+ble_store_ram_delete(int obj_type, union ble_store_key *key)
+{
+    int rc;
+
+    switch (obj_type) {
+    case BLE_STORE_OBJ_TYPE_PEER_SEC:
+        rc = ble_store_ram_delete_peer_sec(&key->sec);
+        return rc;
+
+    case BLE_STORE_OBJ_TYPE_OUR_SEC:
+        rc = ble_store_ram_delete_our_sec(&key->sec);
+        return rc;
+
+    case BLE_STORE_OBJ_TYPE_CCCD:
+        rc = ble_store_ram_delete_cccd(&key->cccd);
+        return rc;
+
+    default:
+        return BLE_HS_ENOTSUP;
+    }
+}
+
+/**
+ * Starts writing the changed entries to flash without waiting for the flush
+ * delay, e.g., before the system is reset.  Has no effect unless
+ * BLE_STORE_RAM_FDS is enabled.
+ */
+void
+ble_store_ram_flush(void)
+{
+#if BLE_STORE_RAM_FDS
+    os_callout_stop(&ble_store_ram_fds_flush_timer.cf_c);
+    ble_store_ram_fds_flush(NULL);
+#endif
+}
@@ -64,6 +64,24 @@
 #define NIMBLE_OPT_SM_SC                        0
 #endif
 
+/**
+ * HOST: Security manager crypto backends for nRF5 targets.  Both disabled by
+ * default.
+ *     o SM_ALG_ECB: AES and AES-CMAC run on the ECB peripheral, through
+ *       sd_ecb_block_encrypt() when a SoftDevice is present, or else through
+ *       the controller's ble_hw_encrypt_block().
+ *     o SM_ALG_ECC: P-256 key generation and DH keys use the SDK's ecc
+ *       library; ecc_init() must have been called.
+ */
+
+#ifndef NIMBLE_OPT_SM_ALG_ECB
+#define NIMBLE_OPT_SM_ALG_ECB                   0
+#endif
+
+#ifndef NIMBLE_OPT_SM_ALG_ECC
+#define NIMBLE_OPT_SM_ALG_ECC                   0
+#endif
+
 /**
  * HOST: Supported GATT procedures.  By default:
  *     o Notify and indicate are enabled;
@@ -267,12 +285,22 @@
 
 /*
  * Configuration items for the number of duplicate advertisers and the
- * number of advertisers from which we have heard a scan response.
+ * number of advertisers from which we have heard a scan response. The
+ * duplicate advertisers are kept in a hash table: its size must be a power
+ * of 2, and an advertiser is stored in one of the
+ * NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES entries following the hash of its
+ * address. A larger number of probes makes the table hold more advertisers
+ * before the least recently seen one is replaced, at the cost of a longer
+ * lookup for each advertising packet.
  */
 #ifndef NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS
 #define NIMBLE_OPT_LL_NUM_SCAN_DUP_ADVS         (8)
 #endif
 
+#ifndef NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES
+#define NIMBLE_OPT_LL_SCAN_DUP_ADV_PROBES       (4)
+#endif
+
 #ifndef NIMBLE_OPT_LL_NUM_SCAN_RSP_ADVS
 #define NIMBLE_OPT_LL_NUM_SCAN_RSP_ADVS         (8)
 #endif
@@ -317,6 +345,16 @@
 #define NIMBLE_OPT_LL_RNG_BUFSIZE               (32)
 #endif
 
+/*
+ * Keep the link layer schedule in a search tree, so that inserting an item
+ * does not walk the items scheduled before it. This costs code, 8 bytes of
+ * RAM per schedule item, and some time for each insertion and removal; it
+ * only pays off with a large number of connections (about 40 or more).
+ */
+#ifndef NIMBLE_OPT_LL_SCHED_TREE
+#define NIMBLE_OPT_LL_SCHED_TREE                (0)
+#endif
+
 /*
  * Configuration for LL supported features.
  *
@@ -1,6 +1,49 @@
 #ifndef H_BLE_HCI_UART_
 #define H_BLE_HCI_UART_
 
+/**
+ * Set to 1 to drive the UART with the nRF52 UARTE EasyDMA driver
+ * (nrf_drv_uart) instead of the byte-oriented HAL.  Received data is framed
+ * a block at a time, and queued packets are sent back to back in a single
+ * DMA transfer.  Requires UART_RX_STREAM_SUPPORT and the two TIMER instances
+ * below to be enabled in nrf_drv_config.h; pins are taken from there too.
+ */
+#ifndef BLE_HCI_UART_DMA
+#define BLE_HCI_UART_DMA                0
+#endif
+
+#if BLE_HCI_UART_DMA
+
+/** Size of each RX DMA buffer; at most 255. */
+#ifndef BLE_HCI_UART_DMA_RX_BUF_SZ
+#define BLE_HCI_UART_DMA_RX_BUF_SZ      64
+#endif
+
+/** Number of RX DMA buffers the receiver rotates through; at least 2. */
+#ifndef BLE_HCI_UART_DMA_RX_BUF_CNT
+#define BLE_HCI_UART_DMA_RX_BUF_CNT     4
+#endif
+
+/** Line idle time after which a partly filled RX buffer is processed. */
+#ifndef BLE_HCI_UART_DMA_RX_TIMEOUT_US
+#define BLE_HCI_UART_DMA_RX_TIMEOUT_US  40
+#endif
+
+/** Size of the TX DMA buffer that queued packets are packed into. */
+#ifndef BLE_HCI_UART_DMA_TX_BUF_SZ
+#define BLE_HCI_UART_DMA_TX_BUF_SZ      256
+#endif
+
+/** TIMER instances used for the RX idle timeout. */
+#ifndef BLE_HCI_UART_DMA_COUNTER_TIMER
+#define BLE_HCI_UART_DMA_COUNTER_TIMER  1
+#endif
+#ifndef BLE_HCI_UART_DMA_TIMEOUT_TIMER
+#define BLE_HCI_UART_DMA_TIMEOUT_TIMER  2
+#endif
+
+#endif
+
 struct ble_hci_uart_cfg {
     uint32_t baud;
     uint16_t num_evt_bufs;
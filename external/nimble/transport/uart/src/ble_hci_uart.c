@@ -24,9 +24,13 @@
 #include "bsp/bsp.h"
 #include "os/os.h"
 #include "util/mem.h"
+#include "transport/uart/ble_hci_uart.h"
 #include "hal/hal_gpio.h"
 #include "hal/hal_cputime.h"
 #include "hal/hal_uart.h"
+#if BLE_HCI_UART_DMA
+#include "nrf_drv_uart.h"
+#endif
 
 /* BLE */
 #include "nimble/ble.h"
@@ -34,8 +38,6 @@
 #include "nimble/hci_common.h"
 #include "nimble/ble_hci_trans.h"
 
-#include "transport/uart/ble_hci_uart.h"
-
 /***
  * NOTE:
  * The UART HCI transport doesn't use event buffer priorities.  All incoming
@@ -119,6 +121,8 @@ static struct {
 
 static struct ble_hci_uart_cfg ble_hci_uart_cfg;
 
+static void ble_hci_uart_start_tx(void);
+
 static int
 ble_hci_uart_acl_tx(struct os_mbuf *om)
 {
@@ -138,7 +142,7 @@ ble_hci_uart_acl_tx(struct os_mbuf *om)
     STAILQ_INSERT_TAIL(&ble_hci_uart_state.tx_pkts, pkt, next);
     OS_EXIT_CRITICAL(sr);
 
-    hal_uart_start_tx(ble_hci_uart_cfg.uart_port);
+    ble_hci_uart_start_tx();
 
     return 0;
 }
@@ -162,7 +166,7 @@ ble_hci_uart_cmdevt_tx(uint8_t *hci_ev, uint8_t h4_type)
     STAILQ_INSERT_TAIL(&ble_hci_uart_state.tx_pkts, pkt, next);
     OS_EXIT_CRITICAL(sr);
 
-    hal_uart_start_tx(ble_hci_uart_cfg.uart_port);
+    ble_hci_uart_start_tx();
 
     return 0;
 }
@@ -224,40 +228,74 @@ ble_hci_uart_tx_pkt_type(void)
 }
 
 /**
- * @return                      The byte to transmit on success;
- *                              -1 if there is nothing to send.
+ * Copies as much queued data as fits into the specified buffer.  Packets
+ * follow one another without a gap, each preceded by its H4 packet type.
+ *
+ * @param buf                   The buffer to fill.
+ * @param max_len               The size of the buffer.
+ *
+ * @return                      The number of bytes written; 0 if there is
+ *                                  nothing to send.
  */
 static int
-ble_hci_uart_tx_char(void *arg)
+ble_hci_uart_tx_fill(uint8_t *buf, int max_len)
 {
-    int rc = -1;
-
-    switch (ble_hci_uart_state.tx_type) {
-    case BLE_HCI_UART_H4_NONE: /* No pending packet, pick one from the queue */
-        rc = ble_hci_uart_tx_pkt_type();
-        break;
-
-    case BLE_HCI_UART_H4_CMD:
-    case BLE_HCI_UART_H4_EVT:
-        rc = ble_hci_uart_state.tx_cmd.data[ble_hci_uart_state.tx_cmd.cur++];
-
-        if (ble_hci_uart_state.tx_cmd.cur == ble_hci_uart_state.tx_cmd.len) {
-            ble_hci_trans_buf_free(ble_hci_uart_state.tx_cmd.data);
-            ble_hci_uart_state.tx_type = BLE_HCI_UART_H4_NONE;
-        }
-        break;
+    struct ble_hci_uart_cmd *cmd;
+    int copy_len;
+    int len;
+    int rc;
 
-    case BLE_HCI_UART_H4_ACL:
-        rc = *OS_MBUF_DATA(ble_hci_uart_state.tx_acl, uint8_t *);
-        os_mbuf_adj(ble_hci_uart_state.tx_acl, 1);
-        if (!OS_MBUF_PKTLEN(ble_hci_uart_state.tx_acl)) {
-            os_mbuf_free_chain(ble_hci_uart_state.tx_acl);
-            ble_hci_uart_state.tx_type = BLE_HCI_UART_H4_NONE;
+    cmd = &ble_hci_uart_state.tx_cmd;
+    len = 0;
+
+    while (len < max_len) {
+        copy_len = max_len - len;
+
+        switch (ble_hci_uart_state.tx_type) {
+        case BLE_HCI_UART_H4_NONE:
+            /* No pending packet, pick one from the queue. */
+            rc = ble_hci_uart_tx_pkt_type();
+            if (rc == -1) {
+                return len;
+            }
+            buf[len++] = rc;
+            break;
+
+        case BLE_HCI_UART_H4_CMD:
+        case BLE_HCI_UART_H4_EVT:
+            if (copy_len > cmd->len - cmd->cur) {
+                copy_len = cmd->len - cmd->cur;
+            }
+            memcpy(buf + len, cmd->data + cmd->cur, copy_len);
+            cmd->cur += copy_len;
+            len += copy_len;
+
+            if (cmd->cur == cmd->len) {
+                ble_hci_trans_buf_free(cmd->data);
+                ble_hci_uart_state.tx_type = BLE_HCI_UART_H4_NONE;
+            }
+            break;
+
+        case BLE_HCI_UART_H4_ACL:
+            if (copy_len > OS_MBUF_PKTLEN(ble_hci_uart_state.tx_acl)) {
+                copy_len = OS_MBUF_PKTLEN(ble_hci_uart_state.tx_acl);
+            }
+            os_mbuf_copydata(ble_hci_uart_state.tx_acl, 0, copy_len, buf + len);
+            os_mbuf_adj(ble_hci_uart_state.tx_acl, copy_len);
+            len += copy_len;
+
+            if (!OS_MBUF_PKTLEN(ble_hci_uart_state.tx_acl)) {
+                os_mbuf_free_chain(ble_hci_uart_state.tx_acl);
+                ble_hci_uart_state.tx_type = BLE_HCI_UART_H4_NONE;
+            }
+            break;
+
+        default:
+            return len;
         }
-        break;
     }
 
-    return rc;
+    return len;
 }
 
 /**
@@ -311,71 +349,87 @@ ble_hci_uart_rx_pkt_type(uint8_t data)
     return 0;
 }
 
-static void
-ble_hci_uart_rx_cmd(uint8_t data)
+/**
+ * Copies received bytes into the pending command or event.  Once the header
+ * is complete, the rest of the packet is copied in one go.
+ *
+ * @param data                  The received bytes.
+ * @param len                   The number of received bytes.
+ * @param hdr_len               The length of the packet header.
+ * @param len_off               The offset of the parameter length in the
+ *                                  header.
+ *
+ * @return                      The number of bytes consumed.
+ */
+static int
+ble_hci_uart_rx_cmdevt(const uint8_t *data, int len, int hdr_len, int len_off)
 {
+    struct ble_hci_uart_cmd *cmd;
+    int copy_len;
     int rc;
 
-    ble_hci_uart_state.rx_cmd.data[ble_hci_uart_state.rx_cmd.cur++] = data;
-
-    if (ble_hci_uart_state.rx_cmd.cur < BLE_HCI_CMD_HDR_LEN) {
-        return;
-    }
+    cmd = &ble_hci_uart_state.rx_cmd;
 
-    if (ble_hci_uart_state.rx_cmd.cur == BLE_HCI_CMD_HDR_LEN) {
-        ble_hci_uart_state.rx_cmd.len = ble_hci_uart_state.rx_cmd.data[2] +
-                                         BLE_HCI_CMD_HDR_LEN;
+    if (cmd->cur < hdr_len) {
+        copy_len = hdr_len - cmd->cur;
+    } else {
+        copy_len = cmd->len - cmd->cur;
     }
-
-    if (ble_hci_uart_state.rx_cmd.cur == ble_hci_uart_state.rx_cmd.len) {
-        assert(ble_hci_uart_rx_cmd_cb != NULL);
-        rc = ble_hci_uart_rx_cmd_cb(ble_hci_uart_state.rx_cmd.data,
-                                    ble_hci_uart_rx_cmd_arg);
-        if (rc != 0) {
-            ble_hci_trans_buf_free(ble_hci_uart_state.rx_cmd.data);
-        }
-        ble_hci_uart_state.rx_type = BLE_HCI_UART_H4_NONE;
+    if (copy_len > len) {
+        copy_len = len;
     }
-}
-
-static void
-ble_hci_uart_rx_evt(uint8_t data)
-{
-    int rc;
 
-    ble_hci_uart_state.rx_cmd.data[ble_hci_uart_state.rx_cmd.cur++] = data;
+    memcpy(cmd->data + cmd->cur, data, copy_len);
+    cmd->cur += copy_len;
 
-    if (ble_hci_uart_state.rx_cmd.cur < BLE_HCI_EVENT_HDR_LEN) {
-        return;
+    if (cmd->cur < hdr_len) {
+        return copy_len;
     }
 
-    if (ble_hci_uart_state.rx_cmd.cur == BLE_HCI_EVENT_HDR_LEN) {
-        ble_hci_uart_state.rx_cmd.len = ble_hci_uart_state.rx_cmd.data[1] +
-                                        BLE_HCI_EVENT_HDR_LEN;
+    if (cmd->cur == hdr_len) {
+        cmd->len = cmd->data[len_off] + hdr_len;
     }
 
-    if (ble_hci_uart_state.rx_cmd.cur == ble_hci_uart_state.rx_cmd.len) {
+    if (cmd->cur == cmd->len) {
         assert(ble_hci_uart_rx_cmd_cb != NULL);
-        rc = ble_hci_uart_rx_cmd_cb(ble_hci_uart_state.rx_cmd.data,
-                                    ble_hci_uart_rx_cmd_arg);
+        rc = ble_hci_uart_rx_cmd_cb(cmd->data, ble_hci_uart_rx_cmd_arg);
         if (rc != 0) {
-            ble_hci_trans_buf_free(ble_hci_uart_state.rx_cmd.data);
+            ble_hci_trans_buf_free(cmd->data);
         }
         ble_hci_uart_state.rx_type = BLE_HCI_UART_H4_NONE;
     }
+
+    return copy_len;
 }
 
-static void
-ble_hci_uart_rx_acl(uint8_t data)
+/**
+ * Appends received bytes to the pending ACL data packet.  Once the header is
+ * complete, the rest of the packet is appended in one go.
+ *
+ * @return                      The number of bytes consumed.
+ */
+static int
+ble_hci_uart_rx_acl(const uint8_t *data, int len)
 {
     uint16_t pktlen;
-
-    os_mbuf_append(ble_hci_uart_state.rx_acl.buf, &data, 1);
+    int copy_len;
 
     pktlen = OS_MBUF_PKTLEN(ble_hci_uart_state.rx_acl.buf);
 
     if (pktlen < BLE_HCI_DATA_HDR_SZ) {
-        return;
+        copy_len = BLE_HCI_DATA_HDR_SZ - pktlen;
+    } else {
+        copy_len = ble_hci_uart_state.rx_acl.len - pktlen;
+    }
+    if (copy_len > len) {
+        copy_len = len;
+    }
+
+    os_mbuf_append(ble_hci_uart_state.rx_acl.buf, data, copy_len);
+    pktlen += copy_len;
+
+    if (pktlen < BLE_HCI_DATA_HDR_SZ) {
+        return copy_len;
     }
 
     if (pktlen == BLE_HCI_DATA_HDR_SZ) {
@@ -387,33 +441,256 @@ ble_hci_uart_rx_acl(uint8_t data)
     }
 
     if (pktlen == ble_hci_uart_state.rx_acl.len) {
-        assert(ble_hci_uart_rx_cmd_cb != NULL);
+        assert(ble_hci_uart_rx_acl_cb != NULL);
         ble_hci_uart_rx_acl_cb(ble_hci_uart_state.rx_acl.buf,
                                ble_hci_uart_rx_acl_arg);
         ble_hci_uart_state.rx_type = BLE_HCI_UART_H4_NONE;
     }
+
+    return copy_len;
 }
 
+/**
+ * Processes a block of bytes received over the UART.
+ *
+ * @return                      0 on success;
+ *                              -1 if a byte that does not start a valid
+ *                                  packet was received and skipped.
+ */
 static int
-ble_hci_uart_rx_char(void *arg, uint8_t data)
+ble_hci_uart_rx_bytes(const uint8_t *data, int len)
 {
-    switch (ble_hci_uart_state.rx_type) {
-    case BLE_HCI_UART_H4_NONE:
-        return ble_hci_uart_rx_pkt_type(data);
-    case BLE_HCI_UART_H4_CMD:
-        ble_hci_uart_rx_cmd(data);
-        return 0;
-    case BLE_HCI_UART_H4_EVT:
-        ble_hci_uart_rx_evt(data);
-        return 0;
-    case BLE_HCI_UART_H4_ACL:
-        ble_hci_uart_rx_acl(data);
-        return 0;
+    int consumed;
+    int rc;
+
+    rc = 0;
+    while (len > 0) {
+        switch (ble_hci_uart_state.rx_type) {
+        case BLE_HCI_UART_H4_NONE:
+            if (ble_hci_uart_rx_pkt_type(*data) != 0) {
+                rc = -1;
+            }
+            consumed = 1;
+            break;
+        case BLE_HCI_UART_H4_CMD:
+            consumed = ble_hci_uart_rx_cmdevt(data, len, BLE_HCI_CMD_HDR_LEN,
+                                              2);
+            break;
+        case BLE_HCI_UART_H4_EVT:
+            consumed = ble_hci_uart_rx_cmdevt(data, len, BLE_HCI_EVENT_HDR_LEN,
+                                              1);
+            break;
+        case BLE_HCI_UART_H4_ACL:
+            consumed = ble_hci_uart_rx_acl(data, len);
+            break;
+        default:
+            return -1;
+        }
+
+        data += consumed;
+        len -= consumed;
+    }
+
+    return rc;
+}
+
+#if BLE_HCI_UART_DMA
+
+static uint8_t ble_hci_uart_dma_rx_buf[BLE_HCI_UART_DMA_RX_BUF_CNT *
+                                       BLE_HCI_UART_DMA_RX_BUF_SZ];
+static uint8_t ble_hci_uart_dma_tx_buf[BLE_HCI_UART_DMA_TX_BUF_SZ];
+static volatile uint8_t ble_hci_uart_dma_tx_busy;
+static uint8_t ble_hci_uart_dma_started;
+
+static const nrf_drv_timer_t ble_hci_uart_dma_counter_timer =
+    NRF_DRV_TIMER_INSTANCE(BLE_HCI_UART_DMA_COUNTER_TIMER);
+static const nrf_drv_timer_t ble_hci_uart_dma_timeout_timer =
+    NRF_DRV_TIMER_INSTANCE(BLE_HCI_UART_DMA_TIMEOUT_TIMER);
+
+/**
+ * Starts a DMA transfer of the queued packets unless one is in progress.
+ * Called when a packet is queued, and from the UART interrupt when a transfer
+ * completes.
+ */
+static void
+ble_hci_uart_start_tx(void)
+{
+    os_sr_t sr;
+    int len;
+
+    OS_ENTER_CRITICAL(sr);
+    if (ble_hci_uart_dma_tx_busy ||
+        (ble_hci_uart_state.tx_type == BLE_HCI_UART_H4_NONE &&
+         STAILQ_EMPTY(&ble_hci_uart_state.tx_pkts))) {
+
+        OS_EXIT_CRITICAL(sr);
+        return;
+    }
+    ble_hci_uart_dma_tx_busy = 1;
+    OS_EXIT_CRITICAL(sr);
+
+    len = ble_hci_uart_tx_fill(ble_hci_uart_dma_tx_buf,
+                               sizeof ble_hci_uart_dma_tx_buf);
+    if (len == 0 ||
+        nrf_drv_uart_tx(ble_hci_uart_dma_tx_buf, len) != NRF_SUCCESS) {
+
+        ble_hci_uart_dma_tx_busy = 0;
+    }
+}
+
+static void
+ble_hci_uart_dma_evt(nrf_drv_uart_event_t *event, void *arg)
+{
+    switch (event->type) {
+    case NRF_DRV_UART_EVT_RX_DATA:
+        ble_hci_uart_rx_bytes(event->data.rxtx.p_data,
+                              event->data.rxtx.bytes);
+        break;
+
+    case NRF_DRV_UART_EVT_TX_DONE:
+        ble_hci_uart_dma_tx_busy = 0;
+        ble_hci_uart_start_tx();
+        break;
+
     default:
+        /* Line errors; reception continues. */
+        break;
+    }
+}
+
+static int
+ble_hci_uart_dma_baud(uint32_t baud, nrf_uart_baudrate_t *out_baud)
+{
+    switch (baud) {
+    case 9600:      *out_baud = NRF_UART_BAUDRATE_9600;     return 0;
+    case 19200:     *out_baud = NRF_UART_BAUDRATE_19200;    return 0;
+    case 38400:     *out_baud = NRF_UART_BAUDRATE_38400;    return 0;
+    case 57600:     *out_baud = NRF_UART_BAUDRATE_57600;    return 0;
+    case 115200:    *out_baud = NRF_UART_BAUDRATE_115200;   return 0;
+    case 230400:    *out_baud = NRF_UART_BAUDRATE_230400;   return 0;
+    case 460800:    *out_baud = NRF_UART_BAUDRATE_460800;   return 0;
+    case 921600:    *out_baud = NRF_UART_BAUDRATE_921600;   return 0;
+    case 1000000:   *out_baud = NRF_UART_BAUDRATE_1000000;  return 0;
+    default:        return -1;
+    }
+}
+
+/**
+ * Configures the UARTE and starts streaming reception.  The driver keeps
+ * running across transport resets, so this only takes effect the first time
+ * it is called.  Pins come from nrf_drv_config.h.
+ */
+static int
+ble_hci_uart_config(void)
+{
+    nrf_drv_uart_config_t uart_cfg = NRF_DRV_UART_DEFAULT_CONFIG;
+    nrf_drv_uart_rx_stream_config_t stream_cfg;
+    int rc;
+
+    if (ble_hci_uart_dma_started) {
+        return 0;
+    }
+
+    /* The UARTE supports even parity only. */
+    if (ble_hci_uart_cfg.data_bits != 8 || ble_hci_uart_cfg.stop_bits != 1 ||
+        (ble_hci_uart_cfg.parity != HAL_UART_PARITY_NONE &&
+         ble_hci_uart_cfg.parity != HAL_UART_PARITY_EVEN)) {
+
+        return BLE_ERR_UNSUPPORTED;
+    }
+
+    rc = ble_hci_uart_dma_baud(ble_hci_uart_cfg.baud, &uart_cfg.baudrate);
+    if (rc != 0) {
+        return BLE_ERR_UNSUPPORTED;
+    }
+
+    if (ble_hci_uart_cfg.flow_ctrl == HAL_UART_FLOW_CTL_RTS_CTS) {
+        uart_cfg.hwfc = NRF_UART_HWFC_ENABLED;
+    } else {
+        uart_cfg.hwfc = NRF_UART_HWFC_DISABLED;
+    }
+    if (ble_hci_uart_cfg.parity == HAL_UART_PARITY_NONE) {
+        uart_cfg.parity = NRF_UART_PARITY_EXCLUDED;
+    } else {
+        uart_cfg.parity = NRF_UART_PARITY_INCLUDED;
+    }
+    uart_cfg.use_easy_dma = true;
+
+    rc = nrf_drv_uart_init(&uart_cfg, ble_hci_uart_dma_evt);
+    if (rc != NRF_SUCCESS) {
+        return BLE_ERR_HW_FAIL;
+    }
+
+    stream_cfg.p_buffer = ble_hci_uart_dma_rx_buf;
+    stream_cfg.buffer_size = BLE_HCI_UART_DMA_RX_BUF_SZ;
+    stream_cfg.buffer_count = BLE_HCI_UART_DMA_RX_BUF_CNT;
+    stream_cfg.timeout_us = BLE_HCI_UART_DMA_RX_TIMEOUT_US;
+    stream_cfg.p_counter_timer = &ble_hci_uart_dma_counter_timer;
+    stream_cfg.p_timeout_timer = &ble_hci_uart_dma_timeout_timer;
+
+    rc = nrf_drv_uart_rx_stream_start(&stream_cfg);
+    if (rc != NRF_SUCCESS) {
+        nrf_drv_uart_uninit();
+        return BLE_ERR_HW_FAIL;
+    }
+
+    ble_hci_uart_dma_started = 1;
+    return 0;
+}
+
+#else
+
+static int
+ble_hci_uart_tx_char(void *arg)
+{
+    uint8_t data;
+
+    if (ble_hci_uart_tx_fill(&data, 1) == 0) {
         return -1;
     }
+
+    return data;
+}
+
+static int
+ble_hci_uart_rx_char(void *arg, uint8_t data)
+{
+    return ble_hci_uart_rx_bytes(&data, 1);
+}
+
+static void
+ble_hci_uart_start_tx(void)
+{
+    hal_uart_start_tx(ble_hci_uart_cfg.uart_port);
+}
+
+static int
+ble_hci_uart_config(void)
+{
+    int rc;
+
+    rc = hal_uart_init_cbs(ble_hci_uart_cfg.uart_port,
+                           ble_hci_uart_tx_char, NULL,
+                           ble_hci_uart_rx_char, NULL);
+    if (rc != 0) {
+        return BLE_ERR_UNSPECIFIED;
+    }
+
+    rc = hal_uart_config(ble_hci_uart_cfg.uart_port,
+                         ble_hci_uart_cfg.baud,
+                         ble_hci_uart_cfg.data_bits,
+                         ble_hci_uart_cfg.stop_bits,
+                         ble_hci_uart_cfg.parity,
+                         ble_hci_uart_cfg.flow_ctrl);
+    if (rc != 0) {
+        return BLE_ERR_HW_FAIL;
+    }
+
+    return 0;
 }
 
+#endif
+
 static void
 ble_hci_uart_set_rx_cbs(ble_hci_trans_rx_cmd_fn *cmd_cb,
                         void *cmd_arg,
@@ -458,31 +735,6 @@ ble_hci_uart_free_mem(void)
     ble_hci_uart_pkt_buf = NULL;
 }
 
-static int
-ble_hci_uart_config(void)
-{
-    int rc;
-
-    rc = hal_uart_init_cbs(ble_hci_uart_cfg.uart_port,
-                           ble_hci_uart_tx_char, NULL,
-                           ble_hci_uart_rx_char, NULL);
-    if (rc != 0) {
-        return BLE_ERR_UNSPECIFIED;
-    }
-
-    rc = hal_uart_config(ble_hci_uart_cfg.uart_port,
-                         ble_hci_uart_cfg.baud,
-                         ble_hci_uart_cfg.data_bits,
-                         ble_hci_uart_cfg.stop_bits,
-                         ble_hci_uart_cfg.parity,
-                         ble_hci_uart_cfg.flow_ctrl);
-    if (rc != 0) {
-        return BLE_ERR_HW_FAIL;
-    }
-
-    return 0;
-}
-
 /**
  * Sends an HCI event from the controller to the host.
  *
@@ -653,13 +905,23 @@ int
 ble_hci_trans_reset(void)
 {
     struct ble_hci_uart_pkt *pkt;
+#if BLE_HCI_UART_DMA
+    os_sr_t sr;
+#endif
     int rc;
 
+#if BLE_HCI_UART_DMA
+    /* The UARTE keeps running; hold off its interrupt while the buffers are
+     * freed.  A transfer in progress sends from its own copy of the data.
+     */
+    OS_ENTER_CRITICAL(sr);
+#else
     /* Close the UART to prevent race conditions as the buffers are freed. */
     rc = hal_uart_close(ble_hci_uart_cfg.uart_port);
     if (rc != 0) {
         return BLE_ERR_HW_FAIL;
     }
+#endif
 
     ble_hci_uart_free_pkt(ble_hci_uart_state.rx_type,
                           ble_hci_uart_state.rx_cmd.data,
@@ -678,6 +940,10 @@ ble_hci_trans_reset(void)
         os_memblock_put(&ble_hci_uart_pkt_pool, pkt);
     }
 
+#if BLE_HCI_UART_DMA
+    OS_EXIT_CRITICAL(sr);
+#endif
+
     /* Reopen the UART. */
     rc = ble_hci_uart_config();
     if (rc != 0) {
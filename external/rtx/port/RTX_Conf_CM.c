@@ -34,6 +34,10 @@
 
 #include "cmsis_os.h"
 #include "nrf.h"
+#ifdef SOFTDEVICE_PRESENT
+#include "nrf_soc.h"
+#include "softdevice_handler.h"
+#endif
 
 /*----------------------------------------------------------------------------
  *      RTX User configuration part BEGIN
@@ -231,28 +235,44 @@ void os_idle_demon (void)
 
         if (expected_time > 2)
         {
-            prev_time       = NRF_RTC1->COUNTER;
-            expected_time  += prev_time;
-            NRF_RTC1->CC[0] =
-                (expected_time > TIMER_MASK) ? expected_time - TIMER_MASK : expected_time;
-            NRF_RTC1->INTENCLR = RTC_INTENSET_TICK_Msk;
-
-            NVIC_EnableIRQ(RTC1_IRQn);
-            __disable_irq();
-
-            if (rtos_suspend)
+            // The RTC1 interrupt is disabled by os_suspend(), so the COMPARE event only pends it
+            // and wakes up the CPU. The tick handler must not run for the COMPARE event, because
+            // the time slept is passed to os_resume().
+            prev_time                   = NRF_RTC1->COUNTER;
+            NRF_RTC1->CC[0]             = (prev_time + expected_time) & TIMER_MASK;
+            NRF_RTC1->EVENTS_COMPARE[0] = 0;
+            NRF_RTC1->INTENCLR          = RTC_INTENSET_TICK_Msk;
+            NRF_RTC1->INTENSET          = RTC_INTENSET_COMPARE0_Msk;
+
+#ifdef SOFTDEVICE_PRESENT
+            if (softdevice_handler_isEnabled())
             {
-                NRF_RTC1->INTENSET = RTC_INTENSET_COMPARE0_Msk;
-                __WFI();
-                NRF_RTC1->EVENTS_COMPARE[0] = 0;
-                NRF_RTC1->INTENCLR          = RTC_INTENSET_COMPARE0_Msk;
+                // Pended interrupts wake up sd_app_evt_wait() only if SEVONPEND is set.
+                SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
+                if (rtos_suspend)
+                {
+                    (void)sd_app_evt_wait();
+                }
             }
-            __enable_irq();
-            NRF_RTC1->INTENSET = RTC_INTENSET_TICK_Msk;
+            else
+#endif
+            {
+                __disable_irq();
+                NVIC_EnableIRQ(RTC1_IRQn);
+                if (rtos_suspend)
+                {
+                    __WFI();
+                }
+                NVIC_DisableIRQ(RTC1_IRQn);
+                __enable_irq();
+            }
+
+            NRF_RTC1->INTENCLR          = RTC_INTENSET_COMPARE0_Msk;
+            NRF_RTC1->EVENTS_COMPARE[0] = 0;
+            NVIC_ClearPendingIRQ(RTC1_IRQn);
+            NRF_RTC1->INTENSET          = RTC_INTENSET_TICK_Msk;
 
-            expected_time = NRF_RTC1->COUNTER;
-            expected_time = (expected_time >= prev_time)
-                            ? expected_time - prev_time : TIMER_MASK - prev_time + expected_time;
+            expected_time = (NRF_RTC1->COUNTER - prev_time) & TIMER_MASK;
         }
         os_resume(expected_time);
     }